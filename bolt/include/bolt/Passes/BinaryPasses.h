@@ -16,9 +16,11 @@
 #include "bolt/Core/BinaryContext.h"
 #include "bolt/Core/BinaryFunction.h"
 #include "bolt/Core/DynoStats.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Support/CommandLine.h"
 #include <atomic>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
 #include <unordered_set>
@@ -107,6 +109,7 @@ public:
 /// filled with nops and they are used for alignment.
 class EliminateUnreachableBlocks : public BinaryFunctionPass {
   std::unordered_set<const BinaryFunction *> Modified;
+  std::mutex ModifiedMutex;
   std::atomic<unsigned> DeletedBlocks{0};
   std::atomic<uint64_t> DeletedBytes{0};
   void runOnFunction(BinaryFunction &Function);
@@ -157,6 +160,29 @@ private:
   bool modifyFunctionLayout(BinaryFunction &Function, LayoutType Type,
                             bool MinBranchClusters) const;
 
+  /// Block layout and profile of a function saved by a previous run.
+  struct SavedLayout {
+    /// Execution counts of the blocks in input order.
+    std::vector<uint64_t> Counts;
+    /// Input offsets of the blocks in layout order.
+    std::vector<uint32_t> Offsets;
+  };
+
+  /// Layouts read from -reuse-block-layout, keyed by function name.
+  StringMap<SavedLayout> SavedLayouts;
+
+  /// Read the layouts saved with -save-block-layout.
+  void readSavedLayouts();
+
+  /// Write the layouts of all reordered functions for -save-block-layout.
+  void saveLayouts(BinaryContext &BC) const;
+
+  /// Apply the saved layout of \p BF if its control flow graph is unchanged
+  /// and its profile is close enough to the saved one. Returns `true` if the
+  /// saved layout was used, and sets \p LayoutChanged if the order of blocks
+  /// was changed.
+  bool reuseSavedLayout(BinaryFunction &BF, bool &LayoutChanged) const;
+
 public:
   explicit ReorderBasicBlocks(const cl::opt<bool> &PrintPass)
       : BinaryFunctionPass(PrintPass) {}
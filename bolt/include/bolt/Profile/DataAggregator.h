@@ -15,9 +15,11 @@
 #define BOLT_PROFILE_DATA_AGGREGATOR_H
 
 #include "bolt/Profile/DataReader.h"
+#include "bolt/Profile/PerfDataReader.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/Program.h"
+#include <map>
 #include <unordered_map>
 
 namespace llvm {
@@ -45,6 +47,10 @@ class BoltAddressTranslation;
 /// instruction map with original addresses we rely on to validate the traces
 /// found in the LBR.
 ///
+/// With -native-perf-data, LBR samples and the events needed to filter them
+/// are decoded directly from perf.data instead, and shards of samples are
+/// aggregated in parallel.
+///
 /// The last step is to write the aggregated data to disk in the output file
 /// specified by the user.
 class DataAggregator : public DataReader {
@@ -135,6 +141,24 @@ private:
   std::unordered_map<uint64_t, uint64_t> BasicSamples;
   std::vector<PerfMemSample> MemSamples;
 
+  /// Branch profile pre-aggregated from a sequence of LBR samples. Profiles
+  /// of consecutive parts of the input can be aggregated independently and
+  /// merged in order.
+  struct LBRAggregate {
+    std::unordered_map<Trace, BranchInfo, TraceHash> BranchLBRs;
+    std::unordered_map<Trace, FTInfo, TraceHash> FallthroughLBRs;
+    std::unordered_map<uint64_t, uint64_t> BasicSamples;
+    uint64_t NumSamples{0};
+    uint64_t NumSamplesNoLBR{0};
+    uint64_t NumEntries{0};
+    uint64_t NumTraces{0};
+    uint64_t NumInvalidTraces{0};
+    uint64_t NumLongRangeTraces{0};
+
+    /// Add the counts of \p Other to this aggregate.
+    void merge(LBRAggregate &&Other);
+  };
+
   template <typename T> void clear(T &Container) {
     T TempContainer;
     TempContainer.swap(Container);
@@ -157,6 +181,9 @@ private:
   PerfProcessInfo MMapEventsPPI;
   PerfProcessInfo TaskEventsPPI;
 
+  /// Reader used instead of perf script jobs with -native-perf-data.
+  std::unique_ptr<PerfDataReader> NativeReader;
+
   /// Kernel VM starts at fixed based address
   /// https://www.kernel.org/doc/Documentation/x86/x86_64/mm.txt
   static constexpr uint64_t KernelBaseAddr = 0xffff800000000000;
@@ -321,6 +348,25 @@ private:
   /// Parse and pre-aggregate branch events.
   std::error_code parseBranchEvents();
 
+  /// Decode and pre-aggregate branch events with NativeReader.
+  std::error_code parseNativeBranchEvents();
+
+  /// Convert a sample decoded from perf.data the same way parseBranchSample()
+  /// converts a line of perf script output. Return false if the sample does
+  /// not belong to the input binary.
+  bool convertBranchSample(const PerfDataReader::BranchSample &In,
+                           PerfBranchSample &Out) const;
+
+  /// Pre-aggregate a single branch \p Sample into \p Agg. If
+  /// \p NeedsSkylakeFix is set, the last two branches of the sample are
+  /// dropped.
+  void aggregateBranchSample(const PerfBranchSample &Sample,
+                             bool NeedsSkylakeFix, LBRAggregate &Agg) const;
+
+  /// Take the pre-aggregated profile of all \p NumTotalSamples branch samples
+  /// and report statistics about it.
+  void finishBranchEvents(LBRAggregate &&Agg, uint64_t NumTotalSamples);
+
   /// Process all branch events.
   void processBranchEvents();
 
@@ -356,10 +402,29 @@ private:
   /// all PIDs.
   std::error_code parseMMapEvents();
 
+  /// Record the first mapping of \p FileName for each PID in
+  /// \p GlobalMMapInfo.
+  void addMMapInfo(std::multimap<StringRef, MMapInfo> &GlobalMMapInfo,
+                   StringRef FileName, const MMapInfo &Info) const;
+
+  /// Select the mappings of the input binary from \p GlobalMMapInfo to
+  /// populate BinaryMMapInfo.
+  std::error_code
+  matchBinaryMMapInfo(std::multimap<StringRef, MMapInfo> &GlobalMMapInfo);
+
   /// Parse output of `perf script --show-task-events`, and forked processes
   /// to the set of tracked PIDs.
   std::error_code parseTaskEvents();
 
+  /// Stop tracking a forked process \p PID that called exec.
+  void handleCommExec(int32_t PID);
+
+  /// Track the child of a fork of a tracked process.
+  void handleFork(const ForkInfo &FI);
+
+  /// Collect mmap and task events with NativeReader.
+  std::error_code parseNativeTaskEvents();
+
   /// Parse a single pair of binary full path and associated build-id
   Optional<std::pair<StringRef, StringRef>> parseNameBuildIDPair();
 
@@ -0,0 +1,142 @@
+//===- bolt/Profile/PerfDataReader.h - perf.data file reader ----*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Reader for the binary file format written by perf record. It decodes the
+// records needed to aggregate an LBR profile without running perf script.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef BOLT_PROFILE_PERF_DATA_READER_H
+#define BOLT_PROFILE_PERF_DATA_READER_H
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/STLFunctionalExtras.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace llvm {
+namespace bolt {
+
+/// Reads a perf.data file in place. The file is mapped into memory and the
+/// data section is walked once by scan() to collect the events describing
+/// the address space of the profiled processes. Samples are not decoded
+/// during the scan. Instead, the data section is split into chunks of whole
+/// records that can be decoded independently, and concurrently, with
+/// forEachBranchSample().
+///
+/// Only files written in the regular (non-pipe) mode on a little-endian host
+/// with uncompressed records are supported.
+class PerfDataReader {
+public:
+  /// PERF_RECORD_MMAP2 event.
+  struct MMapEvent {
+    int32_t PID;
+    uint64_t Time; /// Time in nano seconds, 0 if not recorded.
+    uint64_t Address;
+    uint64_t Size;
+    uint64_t Offset;
+    StringRef FileName;
+  };
+
+  /// PERF_RECORD_COMM event of a process calling exec, or PERF_RECORD_FORK.
+  struct TaskEvent {
+    enum EventKind : uint8_t { CommExec, Fork } Kind;
+    int32_t PID;
+    int32_t ParentPID; /// Only set for fork events.
+    uint64_t Time;     /// Time in nano seconds, only set for fork events.
+  };
+
+  /// PERF_RECORD_SAMPLE event with its branch stack, if one was recorded.
+  /// Branch entries are stored in reverse execution order.
+  class BranchSample {
+    const char *Entries;
+
+  public:
+    int32_t PID;
+    uint64_t PC;
+    uint64_t NumEntries;
+
+    BranchSample(int32_t PID, uint64_t PC, const char *Entries,
+                 uint64_t NumEntries)
+        : Entries(Entries), PID(PID), PC(PC), NumEntries(NumEntries) {}
+
+    uint64_t getFrom(uint64_t I) const { return read(I, 0); }
+    uint64_t getTo(uint64_t I) const { return read(I, 1); }
+    bool isMispredicted(uint64_t I) const { return read(I, 2) & 1; }
+
+  private:
+    uint64_t read(uint64_t I, unsigned Field) const {
+      return support::endian::read64le(Entries + (I * 3 + Field) * 8);
+    }
+  };
+
+  /// Open \p FileName and validate its header and event attributes.
+  static Expected<std::unique_ptr<PerfDataReader>> create(StringRef FileName);
+
+  /// Walk the data section, collect mmap and task events, and split the first
+  /// \p MaxSamples samples into chunks of about \p ChunkSize bytes.
+  Error scan(uint64_t MaxSamples, uint64_t ChunkSize = 16 << 20);
+
+  ArrayRef<MMapEvent> getMMapEvents() const { return MMapEvents; }
+  ArrayRef<TaskEvent> getTaskEvents() const { return TaskEvents; }
+  ArrayRef<StringRef> getSampleChunks() const { return SampleChunks; }
+
+  /// Number of samples covered by the chunks.
+  uint64_t getNumSamples() const { return NumSamples; }
+
+  /// Decode every sample in \p Chunk and pass it to \p Callback. Safe to call
+  /// from multiple threads at the same time.
+  Error
+  forEachBranchSample(StringRef Chunk,
+                      function_ref<void(const BranchSample &)> Callback) const;
+
+private:
+  /// The parts of perf_event_attr that determine the layout of records.
+  struct EventAttr {
+    uint64_t SampleType;
+    uint64_t ReadFormat;
+    uint64_t BranchSampleType;
+    bool SampleIDAll;
+  };
+
+  explicit PerfDataReader(std::unique_ptr<MemoryBuffer> Buffer)
+      : Buffer(std::move(Buffer)) {}
+
+  Error readHeader();
+
+  /// Return the attributes of the event that produced a record of \p Type
+  /// with the given \p Body, or nullptr if it cannot be identified.
+  const EventAttr *getAttr(uint32_t Type, StringRef Body) const;
+
+  /// Return the time stored in the sample_id trailer of a non-sample record.
+  uint64_t getSampleIDTime(const EventAttr &Attr, StringRef Body) const;
+
+  std::unique_ptr<MemoryBuffer> Buffer;
+  StringRef Data;
+
+  std::vector<EventAttr> Attrs;
+  DenseMap<uint64_t, unsigned> AttrIDs;
+  /// All events share the same record layout.
+  bool UniformAttrs{true};
+
+  std::vector<MMapEvent> MMapEvents;
+  std::vector<TaskEvent> TaskEvents;
+  std::vector<StringRef> SampleChunks;
+  uint64_t NumSamples{0};
+};
+
+} // namespace bolt
+} // namespace llvm
+
+#endif
@@ -13,8 +13,11 @@
 #include "bolt/Core/ParallelUtilities.h"
 #include "bolt/Core/BinaryContext.h"
 #include "bolt/Core/BinaryFunction.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/Timer.h"
+#include <atomic>
+#include <chrono>
 #include <mutex>
 #include <shared_mutex>
 
@@ -22,6 +25,7 @@
 
 namespace opts {
 extern cl::OptionCategory BoltCategory;
+extern cl::opt<bool> TimeOpts;
 
 cl::opt<unsigned>
 ThreadCount("thread-count",
@@ -99,6 +103,50 @@ inline unsigned estimateTotalCost(const BinaryContext &BC,
   return TotalCost;
 }
 
+/// Measures how well a parallel run kept the thread pool busy. Only active
+/// with -time-opts.
+class UtilizationTracker {
+  using Clock = std::chrono::steady_clock;
+  const bool Enabled;
+  Clock::time_point Start;
+  std::atomic<uint64_t> BusyNs{0};
+  std::atomic<unsigned> NumTasks{0};
+
+public:
+  UtilizationTracker() : Enabled(opts::TimeOpts) {
+    if (Enabled)
+      Start = Clock::now();
+  }
+
+  /// Run \p Task and account its duration as busy time.
+  template <typename TaskTy> void track(TaskTy Task) {
+    if (!Enabled) {
+      Task();
+      return;
+    }
+    const Clock::time_point TaskStart = Clock::now();
+    Task();
+    BusyNs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  Clock::now() - TaskStart)
+                  .count();
+    ++NumTasks;
+  }
+
+  void report(StringRef LogName, unsigned NumThreads) const {
+    if (!Enabled)
+      return;
+    const double Wall =
+        std::chrono::duration<double>(Clock::now() - Start).count();
+    const double Busy = BusyNs.load() / 1e9;
+    const double Utilization =
+        Wall > 0 ? 100.0 * Busy / (Wall * NumThreads) : 100.0;
+    outs() << "BOLT-INFO: " << LogName << ": "
+           << format("%.4lf s wall, %.4lf s busy in %u task(s) on %u "
+                     "thread(s), %.1lf%% utilization\n",
+                     Wall, Busy, NumTasks.load(), NumThreads, Utilization);
+  }
+};
+
 } // namespace
 
 ThreadPool &getThreadPool() {
@@ -117,23 +165,27 @@ void runOnEachFunction(BinaryContext &BC, SchedulingPolicy SchedPolicy,
   if (BC.getBinaryFunctions().size() == 0)
     return;
 
+  UtilizationTracker Utilization;
   auto runBlock = [&](std::map<uint64_t, BinaryFunction>::iterator BlockBegin,
                       std::map<uint64_t, BinaryFunction>::iterator BlockEnd) {
     Timer T(LogName, LogName);
     LLVM_DEBUG(T.startTimer());
 
-    for (auto It = BlockBegin; It != BlockEnd; ++It) {
-      BinaryFunction &BF = It->second;
-      if (SkipPredicate && SkipPredicate(BF))
-        continue;
+    Utilization.track([&] {
+      for (auto It = BlockBegin; It != BlockEnd; ++It) {
+        BinaryFunction &BF = It->second;
+        if (SkipPredicate && SkipPredicate(BF))
+          continue;
 
-      WorkFunction(BF);
-    }
+        WorkFunction(BF);
+      }
+    });
     LLVM_DEBUG(T.stopTimer());
   };
 
   if (opts::NoThreads || ForceSequential) {
     runBlock(BC.getBinaryFunctions().begin(), BC.getBinaryFunctions().end());
+    Utilization.report(LogName, 1);
     return;
   }
 
@@ -161,6 +213,7 @@ void runOnEachFunction(BinaryContext &BC, SchedulingPolicy SchedPolicy,
   }
   Pool.async(runBlock, BlockBegin, BC.getBinaryFunctions().end());
   Pool.wait();
+  Utilization.report(LogName, Pool.getThreadCount());
 }
 
 void runOnEachFunctionWithUniqueAllocId(
@@ -171,24 +224,28 @@ void runOnEachFunctionWithUniqueAllocId(
     return;
 
   std::shared_timed_mutex MainLock;
+  UtilizationTracker Utilization;
   auto runBlock = [&](std::map<uint64_t, BinaryFunction>::iterator BlockBegin,
                       std::map<uint64_t, BinaryFunction>::iterator BlockEnd,
                       MCPlusBuilder::AllocatorIdTy AllocId) {
     Timer T(LogName, LogName);
     LLVM_DEBUG(T.startTimer());
     std::shared_lock<std::shared_timed_mutex> Lock(MainLock);
-    for (auto It = BlockBegin; It != BlockEnd; ++It) {
-      BinaryFunction &BF = It->second;
-      if (SkipPredicate && SkipPredicate(BF))
-        continue;
+    Utilization.track([&] {
+      for (auto It = BlockBegin; It != BlockEnd; ++It) {
+        BinaryFunction &BF = It->second;
+        if (SkipPredicate && SkipPredicate(BF))
+          continue;
 
-      WorkFunction(BF, AllocId);
-    }
+        WorkFunction(BF, AllocId);
+      }
+    });
     LLVM_DEBUG(T.stopTimer());
   };
 
   if (opts::NoThreads || ForceSequential) {
     runBlock(BC.getBinaryFunctions().begin(), BC.getBinaryFunctions().end(), 0);
+    Utilization.report(LogName, 1);
     return;
   }
   // This lock is used to postpone task execution
@@ -234,6 +291,7 @@ void runOnEachFunctionWithUniqueAllocId(
   Pool.async(runBlock, BlockBegin, BC.getBinaryFunctions().end(), AllocId);
   Lock.unlock();
   Pool.wait();
+  Utilization.report(LogName, Pool.getThreadCount());
 }
 
 } // namespace ParallelUtilities
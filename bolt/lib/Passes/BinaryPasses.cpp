@@ -15,8 +15,10 @@
 #include "bolt/Core/ParallelUtilities.h"
 #include "bolt/Passes/ReorderAlgorithm.h"
 #include "bolt/Passes/ReorderFunctions.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/Support/CommandLine.h"
 #include <atomic>
+#include <fstream>
 #include <mutex>
 #include <numeric>
 #include <vector>
@@ -184,6 +186,25 @@ cl::opt<bolt::ReorderBasicBlocks::LayoutType> ReorderBlocks(
       }
     }));
 
+static cl::opt<std::string> ReuseBlockLayout(
+    "reuse-block-layout",
+    cl::desc("reuse the basic block layouts saved with -save-block-layout by "
+             "a previous run for functions whose profile did not change "
+             "significantly"),
+    cl::cat(BoltOptCategory));
+
+static cl::opt<unsigned> ReuseBlockLayoutThreshold(
+    "reuse-block-layout-threshold",
+    cl::desc("minimum similarity, in percent, between the block profile of a "
+             "function and its saved profile to reuse the saved layout"),
+    cl::init(95), cl::cat(BoltOptCategory));
+
+static cl::opt<std::string> SaveBlockLayout(
+    "save-block-layout",
+    cl::desc("file to save the basic block layout of reordered functions to "
+             "for use with -reuse-block-layout"),
+    cl::cat(BoltOptCategory));
+
 static cl::opt<unsigned> ReportBadLayout(
     "report-bad-layout",
     cl::desc("print top <uint> functions with suboptimal code layout on input"),
@@ -352,7 +373,10 @@ void EliminateUnreachableBlocks::runOnFunction(BinaryFunction &Function) {
     DeletedBlocks += Count;
     DeletedBytes += Bytes;
     if (Count) {
-      Modified.insert(&Function);
+      {
+        std::lock_guard<std::mutex> Lock(ModifiedMutex);
+        Modified.insert(&Function);
+      }
       if (opts::Verbosity > 0)
         outs() << "BOLT-INFO: Removed " << Count
                << " dead basic block(s) accounting for " << Bytes
@@ -362,11 +386,13 @@ void EliminateUnreachableBlocks::runOnFunction(BinaryFunction &Function) {
 }
 
 void EliminateUnreachableBlocks::runOnFunctions(BinaryContext &BC) {
-  for (auto &It : BC.getBinaryFunctions()) {
-    BinaryFunction &Function = It.second;
-    if (shouldOptimize(Function))
-      runOnFunction(Function);
-  }
+  // Keep the per-function messages in address order.
+  const bool ForceSequential = opts::Verbosity > 0;
+  ParallelUtilities::runOnEachFunction(
+      BC, ParallelUtilities::SchedulingPolicy::SP_BB_LINEAR,
+      [&](BinaryFunction &BF) { runOnFunction(BF); },
+      [&](const BinaryFunction &BF) { return !shouldOptimize(BF); },
+      "EliminateUnreachableBlocks", ForceSequential);
 
   outs() << "BOLT-INFO: UCE removed " << DeletedBlocks << " blocks and "
          << DeletedBytes << " bytes of code.\n";
@@ -390,16 +416,24 @@ void ReorderBasicBlocks::runOnFunctions(BinaryContext &BC) {
     return;
 
   std::atomic_uint64_t ModifiedFuncCount(0);
+  std::atomic_uint64_t ReusedFuncCount(0);
   std::mutex FunctionEditDistanceMutex;
   DenseMap<const BinaryFunction *, uint64_t> FunctionEditDistance;
 
+  if (!opts::ReuseBlockLayout.empty())
+    readSavedLayouts();
+
   ParallelUtilities::WorkFuncTy WorkFun = [&](BinaryFunction &BF) {
     SmallVector<const BinaryBasicBlock *, 0> OldBlockOrder;
     if (opts::PrintFuncStat > 0)
       llvm::copy(BF.getLayout().blocks(), std::back_inserter(OldBlockOrder));
 
-    const bool LayoutChanged =
-        modifyFunctionLayout(BF, opts::ReorderBlocks, opts::MinBranchClusters);
+    bool LayoutChanged = false;
+    if (reuseSavedLayout(BF, LayoutChanged))
+      ReusedFuncCount.fetch_add(1, std::memory_order_relaxed);
+    else
+      LayoutChanged = modifyFunctionLayout(BF, opts::ReorderBlocks,
+                                           opts::MinBranchClusters);
     if (LayoutChanged) {
       ModifiedFuncCount.fetch_add(1, std::memory_order_relaxed);
       if (opts::PrintFuncStat > 0) {
@@ -428,6 +462,14 @@ void ReorderBasicBlocks::runOnFunctions(BinaryContext &BC) {
                    100.0 * ModifiedFuncCount.load(std::memory_order_relaxed) /
                        BC.getBinaryFunctions().size());
 
+  if (!opts::ReuseBlockLayout.empty())
+    outs() << "BOLT-INFO: reused saved block layout of "
+           << ReusedFuncCount.load(std::memory_order_relaxed) << " out of "
+           << SavedLayouts.size() << " functions\n";
+
+  if (!opts::SaveBlockLayout.empty())
+    saveLayouts(BC);
+
   if (opts::PrintFuncStat > 0) {
     raw_ostream &OS = outs();
     // Copy all the values into vector in order to sort them
@@ -522,6 +564,133 @@ bool ReorderBasicBlocks::modifyFunctionLayout(BinaryFunction &BF,
   return BF.getLayout().update(NewLayout);
 }
 
+void ReorderBasicBlocks::readSavedLayouts() {
+  std::ifstream LayoutFile(opts::ReuseBlockLayout, std::ios::in);
+  if (!LayoutFile) {
+    errs() << "BOLT-ERROR: block layout file \"" << opts::ReuseBlockLayout
+           << "\" can't be opened.\n";
+    exit(1);
+  }
+
+  // Each line has the block counts in input order, the input offsets of the
+  // blocks in layout order, and the function name, separated by spaces.
+  std::string Line;
+  while (std::getline(LayoutFile, Line)) {
+    StringRef CountsStr, OffsetsStr, Name;
+    std::tie(CountsStr, Name) = StringRef(Line).split(' ');
+    std::tie(OffsetsStr, Name) = Name.split(' ');
+
+    SavedLayout Layout;
+    SmallVector<StringRef, 16> Fields;
+    bool IsValid = !Name.empty();
+    CountsStr.split(Fields, ',');
+    for (StringRef Field : Fields) {
+      uint64_t Count;
+      IsValid &= !Field.getAsInteger(10, Count);
+      Layout.Counts.push_back(Count);
+    }
+    Fields.clear();
+    OffsetsStr.split(Fields, ',');
+    for (StringRef Field : Fields) {
+      uint32_t Offset;
+      IsValid &= !Field.getAsInteger(16, Offset);
+      Layout.Offsets.push_back(Offset);
+    }
+    if (!IsValid || Layout.Counts.size() != Layout.Offsets.size()) {
+      errs() << "BOLT-WARNING: ignoring malformed line in block layout file: "
+             << Line << '\n';
+      continue;
+    }
+    SavedLayouts[Name] = std::move(Layout);
+  }
+}
+
+void ReorderBasicBlocks::saveLayouts(BinaryContext &BC) const {
+  std::ofstream LayoutFile(opts::SaveBlockLayout, std::ios::out);
+  if (!LayoutFile) {
+    errs() << "BOLT-ERROR: block layout file \"" << opts::SaveBlockLayout
+           << "\" can't be opened.\n";
+    exit(1);
+  }
+
+  uint64_t NumSaved = 0;
+  for (auto &BFI : BC.getBinaryFunctions()) {
+    const BinaryFunction &BF = BFI.second;
+    if (!shouldOptimize(BF) || !BF.hasValidProfile() || BF.empty())
+      continue;
+
+    std::string Str;
+    raw_string_ostream OS(Str);
+    ListSeparator CountSep(",");
+    for (const BinaryBasicBlock &BB : BF)
+      OS << CountSep << BB.getKnownExecutionCount();
+    OS << ' ';
+    ListSeparator OffsetSep(",");
+    for (const BinaryBasicBlock *BB : BF.getLayout().blocks())
+      OS << OffsetSep << Twine::utohexstr(BB->getInputOffset());
+    OS << ' ' << BF.getOneName() << '\n';
+    LayoutFile << OS.str();
+    ++NumSaved;
+  }
+
+  outs() << "BOLT-INFO: saved block layout of " << NumSaved
+         << " functions to " << opts::SaveBlockLayout << '\n';
+}
+
+bool ReorderBasicBlocks::reuseSavedLayout(BinaryFunction &BF,
+                                          bool &LayoutChanged) const {
+  if (SavedLayouts.empty() || !BF.hasValidProfile())
+    return false;
+
+  auto It = SavedLayouts.find(BF.getOneName());
+  if (It == SavedLayouts.end())
+    return false;
+  const SavedLayout &Saved = It->second;
+  if (Saved.Counts.size() != BF.size())
+    return false;
+
+  // The saved offsets have to match the blocks of the function one-to-one.
+  DenseMap<uint32_t, BinaryBasicBlock *> BlockAtOffset;
+  for (BinaryBasicBlock &BB : BF)
+    BlockAtOffset[BB.getInputOffset()] = &BB;
+  if (BlockAtOffset.size() != BF.size())
+    return false;
+
+  BinaryFunction::BasicBlockOrderType NewLayout;
+  for (uint32_t Offset : Saved.Offsets) {
+    BinaryBasicBlock *BB = BlockAtOffset.lookup(Offset);
+    if (!BB)
+      return false;
+    NewLayout.push_back(BB);
+    BlockAtOffset.erase(Offset);
+  }
+  if (NewLayout.empty() || NewLayout.front() != &*BF.begin())
+    return false;
+
+  // Compare the normalized block profiles: the similarity is the share of
+  // the execution counts the two profiles have in common.
+  uint64_t OldTotal = 0;
+  uint64_t NewTotal = 0;
+  for (const BinaryBasicBlock &BB : BF)
+    NewTotal += BB.getKnownExecutionCount();
+  for (uint64_t Count : Saved.Counts)
+    OldTotal += Count;
+  if (!OldTotal || !NewTotal)
+    return false;
+
+  double Difference = 0.0;
+  unsigned Index = 0;
+  for (const BinaryBasicBlock &BB : BF)
+    Difference += std::abs(double(BB.getKnownExecutionCount()) / NewTotal -
+                           double(Saved.Counts[Index++]) / OldTotal);
+  const double Similarity = 100.0 * (1.0 - Difference / 2);
+  if (Similarity < opts::ReuseBlockLayoutThreshold)
+    return false;
+
+  LayoutChanged = BF.getLayout().update(NewLayout);
+  return true;
+}
+
 void FixupBranches::runOnFunctions(BinaryContext &BC) {
   for (auto &It : BC.getBinaryFunctions()) {
     BinaryFunction &Function = It.second;
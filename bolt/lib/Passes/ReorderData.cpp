@@ -17,6 +17,7 @@
 
 #include "bolt/Passes/ReorderData.h"
 #include <algorithm>
+#include <unordered_set>
 
 #undef  DEBUG_TYPE
 #define DEBUG_TYPE "reorder-data"
@@ -90,6 +91,12 @@ static cl::opt<bool> ReorderInplace("reorder-data-inplace",
                                     cl::desc("reorder data sections in place"),
 
                                     cl::cat(BoltOptCategory));
+
+static cl::opt<bool> ReorderDataAvoidLineSplits(
+    "reorder-data-avoid-line-splits",
+    cl::desc("do not let hot data objects that fit in a cache line straddle "
+             "two cache lines"),
+    cl::init(true), cl::cat(BoltOptCategory));
 }
 
 namespace llvm {
@@ -98,6 +105,8 @@ namespace bolt {
 namespace {
 
 static constexpr uint16_t MinAlignment = 16;
+static constexpr uint64_t CacheLineSize = 64;
+static constexpr uint64_t PageSize = 4096;
 
 bool isSupported(const BinarySection &BS) { return BS.isData() && !BS.isTLS(); }
 
@@ -128,6 +137,22 @@ bool filterSymbol(const BinaryData *BD) {
   return IsValid;
 }
 
+/// Return the number of distinct \p BlockSize blocks touched by \p Ranges,
+/// a list of [start, size) pairs.
+uint64_t
+countBlocks(const std::vector<std::pair<uint64_t, uint64_t>> &Ranges,
+            uint64_t BlockSize) {
+  std::unordered_set<uint64_t> Blocks;
+  for (const std::pair<uint64_t, uint64_t> &Range : Ranges) {
+    if (!Range.second)
+      continue;
+    const uint64_t Last = (Range.first + Range.second - 1) / BlockSize;
+    for (uint64_t Block = Range.first / BlockSize; Block <= Last; ++Block)
+      Blocks.insert(Block);
+  }
+  return Blocks.size();
+}
+
 } // namespace
 
 using DataOrder = ReorderData::DataOrder;
@@ -337,6 +362,10 @@ void ReorderData::setSectionOrder(BinaryContext &BC,
   uint64_t Offset = 0;
   uint64_t Count = 0;
 
+  // Ranges occupied by hot objects before and after reordering.
+  std::vector<std::pair<uint64_t, uint64_t>> OldHotRanges;
+  std::vector<std::pair<uint64_t, uint64_t>> NewHotRanges;
+
   // Get the total count just for stats
   uint64_t TotalCount = 0;
   for (auto Itr = Begin; Itr != End; ++Itr)
@@ -363,6 +392,12 @@ void ReorderData::setSectionOrder(BinaryContext &BC,
     uint16_t Alignment = std::max(BD->getAlignment(), MinAlignment);
     Offset = alignTo(Offset, Alignment);
 
+    // An object that fits in a cache line should not need two of them.
+    if (opts::ReorderDataAvoidLineSplits && BD->getSize() <= CacheLineSize &&
+        Offset / CacheLineSize !=
+            (Offset + BD->getSize() - 1) / CacheLineSize)
+      Offset = alignTo(Offset, CacheLineSize);
+
     if ((Offset + BD->getSize()) > opts::ReorderDataMaxBytes) {
       if (!NewOrder.empty())
         LLVM_DEBUG(dbgs() << "BOLT-DEBUG: processing ending on symbol "
@@ -387,6 +422,11 @@ void ReorderData::setSectionOrder(BinaryContext &BC,
       }
     }
 
+    if (Begin->second) {
+      OldHotRanges.emplace_back(BD->getAddress(), BD->getSize());
+      NewHotRanges.emplace_back(Offset, BD->getSize());
+    }
+
     Offset += BD->getSize();
     Count += Begin->second;
     NewOrder.push_back(BD);
@@ -397,6 +437,15 @@ void ReorderData::setSectionOrder(BinaryContext &BC,
   outs() << "BOLT-INFO: reorder-data: " << Count << "/" << TotalCount
          << format(" (%.1f%%)", 100.0 * Count / TotalCount) << " events, "
          << Offset << " hot bytes\n";
+
+  // Estimate the D-cache and D-TLB footprint of the hot objects, assuming the
+  // output section starts at a page boundary.
+  if (!NewHotRanges.empty())
+    outs() << "BOLT-INFO: reorder-data: hot objects span "
+           << countBlocks(NewHotRanges, CacheLineSize) << " cache lines and "
+           << countBlocks(NewHotRanges, PageSize) << " pages (was "
+           << countBlocks(OldHotRanges, CacheLineSize) << " cache lines and "
+           << countBlocks(OldHotRanges, PageSize) << " pages)\n";
 }
 
 bool ReorderData::markUnmoveableSymbols(BinaryContext &BC,
@@ -411,6 +460,13 @@ bool ReorderData::markUnmoveableSymbols(BinaryContext &BC,
   };
   auto Range = BC.getBinaryDataForSection(Section);
   bool FoundUnmoveable = false;
+
+  // Dynamic relocations are not updated when data moves, e.g. the relative
+  // relocations against vtables in .data.rel.ro of a PIE.
+  for (const Relocation &Rel : Section.dynamicRelocations())
+    if (BinaryData *BD = BC.getBinaryDataContainingAddress(
+            Section.getAddress() + Rel.Offset))
+      BD->getAtomicRoot()->setIsMoveable(false);
   for (auto Itr = Range.begin(); Itr != Range.end(); ++Itr) {
     if (Itr->second->getName().startswith("PG.")) {
       BinaryData *Prev =
@@ -435,7 +491,8 @@ bool ReorderData::markUnmoveableSymbols(BinaryContext &BC,
 }
 
 void ReorderData::runOnFunctions(BinaryContext &BC) {
-  static const char *DefaultSections[] = {".rodata", ".data", ".bss", nullptr};
+  static const char *DefaultSections[] = {".rodata", ".data.rel.ro", ".data",
+                                         ".bss", nullptr};
 
   if (!BC.HasRelocations || opts::ReorderData.empty())
     return;
@@ -14,6 +14,7 @@
 #include "bolt/Profile/DataAggregator.h"
 #include "bolt/Core/BinaryContext.h"
 #include "bolt/Core/BinaryFunction.h"
+#include "bolt/Core/ParallelUtilities.h"
 #include "bolt/Profile/BoltAddressTranslation.h"
 #include "bolt/Profile/Heatmap.h"
 #include "bolt/Utils/CommandLineOpts.h"
@@ -27,8 +28,11 @@
 #include "llvm/Support/Process.h"
 #include "llvm/Support/Program.h"
 #include "llvm/Support/Regex.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/Timer.h"
 #include "llvm/Support/raw_ostream.h"
+#include <deque>
+#include <future>
 #include <map>
 #include <unordered_map>
 #include <utility>
@@ -78,6 +82,12 @@ MaxSamples("max-samples",
   cl::Hidden,
   cl::cat(AggregatorCategory));
 
+static cl::opt<bool> NativePerfData(
+    "native-perf-data",
+    cl::desc("read LBR samples directly from perf.data instead of running "
+             "perf script, and aggregate them in parallel"),
+    cl::cat(AggregatorCategory));
+
 extern cl::opt<opts::ProfileFormatKind> ProfileFormat;
 
 cl::opt<bool> ReadPreAggregated(
@@ -162,6 +172,22 @@ void DataAggregator::start() {
 
   findPerfExecutable();
 
+  if (opts::NativePerfData) {
+    if (opts::BasicAggregation || opts::HeatmapMode || opts::LinuxKernelMode) {
+      errs() << "PERF2BOLT-WARNING: -native-perf-data only supports LBR "
+                "profiles of user-space binaries, using perf script\n";
+    } else if (Expected<std::unique_ptr<PerfDataReader>> ReaderOrErr =
+                   PerfDataReader::create(Filename)) {
+      NativeReader = std::move(*ReaderOrErr);
+      outs() << "PERF2BOLT: reading events directly from " << Filename
+             << '\n';
+      return;
+    } else {
+      errs() << "PERF2BOLT-WARNING: " << toString(ReaderOrErr.takeError())
+             << ", using perf script\n";
+    }
+  }
+
   if (opts::BasicAggregation)
     launchPerfProcess("events without LBR",
                       MainEventsPPI,
@@ -198,10 +224,12 @@ void DataAggregator::abort() {
   std::string Error;
 
   // Kill subprocesses in case they are not finished
-  sys::Wait(TaskEventsPPI.PI, 1, false, &Error);
-  sys::Wait(MMapEventsPPI.PI, 1, false, &Error);
-  sys::Wait(MainEventsPPI.PI, 1, false, &Error);
-  sys::Wait(MemEventsPPI.PI, 1, false, &Error);
+  if (!NativeReader) {
+    sys::Wait(TaskEventsPPI.PI, 1, false, &Error);
+    sys::Wait(MMapEventsPPI.PI, 1, false, &Error);
+    sys::Wait(MainEventsPPI.PI, 1, false, &Error);
+    sys::Wait(MemEventsPPI.PI, 1, false, &Error);
+  }
 
   deleteTempFiles();
 
@@ -513,6 +541,27 @@ Error DataAggregator::preprocessProfile(BinaryContext &BC) {
     Line = 1;
   };
 
+  if (NativeReader) {
+    // Memory events are not decoded from perf.data.
+    if (parseNativeTaskEvents())
+      errs() << "PERF2BOLT: failed to parse mmap and task events\n";
+    filterBinaryMMapInfo();
+    if (parseNativeBranchEvents())
+      errs() << "PERF2BOLT: failed to parse samples\n";
+
+    if (opts::WriteAutoFDOData) {
+      if (std::error_code EC = writeAutoFDOData(opts::OutputFilename))
+        errs() << "Error writing autofdo data to file: " << EC.message()
+               << "\n";
+
+      deleteTempFiles();
+      exit(0);
+    }
+
+    deleteTempFiles();
+    return Error::success();
+  }
+
   if (opts::LinuxKernelMode) {
     // Current MMap parsing logic does not work with linux kernel.
     // MMap entries for linux kernel uses PERF_RECORD_MMAP
@@ -1392,11 +1441,8 @@ std::error_code DataAggregator::parseBranchEvents() {
                      TimerGroupDesc, opts::TimeAggregator);
 
   uint64_t NumTotalSamples = 0;
-  uint64_t NumEntries = 0;
-  uint64_t NumSamples = 0;
-  uint64_t NumSamplesNoLBR = 0;
-  uint64_t NumTraces = 0;
   bool NeedsSkylakeFix = false;
+  LBRAggregate Agg;
 
   while (hasData() && NumTotalSamples < opts::MaxSamples) {
     ++NumTotalSamples;
@@ -1407,97 +1453,147 @@ std::error_code DataAggregator::parseBranchEvents() {
         continue;
       return EC;
     }
-    ++NumSamples;
 
     PerfBranchSample &Sample = SampleRes.get();
-    if (opts::WriteAutoFDOData)
-      ++BasicSamples[Sample.PC];
-
-    if (Sample.LBR.empty()) {
-      ++NumSamplesNoLBR;
-      continue;
-    }
-
-    NumEntries += Sample.LBR.size();
     if (BAT && Sample.LBR.size() == 32 && !NeedsSkylakeFix) {
       errs() << "PERF2BOLT-WARNING: using Intel Skylake bug workaround\n";
       NeedsSkylakeFix = true;
     }
 
-    // LBRs are stored in reverse execution order. NextPC refers to the next
-    // recorded executed PC.
-    uint64_t NextPC = opts::UseEventPC ? Sample.PC : 0;
-    uint32_t NumEntry = 0;
-    for (const LBREntry &LBR : Sample.LBR) {
-      ++NumEntry;
-      // Hardware bug workaround: Intel Skylake (which has 32 LBR entries)
-      // sometimes record entry 32 as an exact copy of entry 31. This will cause
-      // us to likely record an invalid trace and generate a stale function for
-      // BAT mode (non BAT disassembles the function and is able to ignore this
-      // trace at aggregation time). Drop first 2 entries (last two, in
-      // chronological order)
-      if (NeedsSkylakeFix && NumEntry <= 2)
-        continue;
-      if (NextPC) {
-        // Record fall-through trace.
-        const uint64_t TraceFrom = LBR.To;
-        const uint64_t TraceTo = NextPC;
-        const BinaryFunction *TraceBF =
-            getBinaryFunctionContainingAddress(TraceFrom);
-        if (TraceBF && TraceBF->containsAddress(TraceTo)) {
-          FTInfo &Info = FallthroughLBRs[Trace(TraceFrom, TraceTo)];
-          if (TraceBF->containsAddress(LBR.From))
-            ++Info.InternCount;
-          else
-            ++Info.ExternCount;
+    aggregateBranchSample(Sample, NeedsSkylakeFix, Agg);
+  }
+
+  finishBranchEvents(std::move(Agg), NumTotalSamples);
+  return std::error_code();
+}
+
+void DataAggregator::aggregateBranchSample(const PerfBranchSample &Sample,
+                                           bool NeedsSkylakeFix,
+                                           LBRAggregate &Agg) const {
+  ++Agg.NumSamples;
+  if (opts::WriteAutoFDOData)
+    ++Agg.BasicSamples[Sample.PC];
+
+  if (Sample.LBR.empty()) {
+    ++Agg.NumSamplesNoLBR;
+    return;
+  }
+
+  Agg.NumEntries += Sample.LBR.size();
+
+  // LBRs are stored in reverse execution order. NextPC refers to the next
+  // recorded executed PC.
+  uint64_t NextPC = opts::UseEventPC ? Sample.PC : 0;
+  uint32_t NumEntry = 0;
+  for (const LBREntry &LBR : Sample.LBR) {
+    ++NumEntry;
+    // Hardware bug workaround: Intel Skylake (which has 32 LBR entries)
+    // sometimes record entry 32 as an exact copy of entry 31. This will cause
+    // us to likely record an invalid trace and generate a stale function for
+    // BAT mode (non BAT disassembles the function and is able to ignore this
+    // trace at aggregation time). Drop first 2 entries (last two, in
+    // chronological order)
+    if (NeedsSkylakeFix && NumEntry <= 2)
+      continue;
+    if (NextPC) {
+      // Record fall-through trace.
+      const uint64_t TraceFrom = LBR.To;
+      const uint64_t TraceTo = NextPC;
+      const BinaryFunction *TraceBF =
+          getBinaryFunctionContainingAddress(TraceFrom);
+      if (TraceBF && TraceBF->containsAddress(TraceTo)) {
+        FTInfo &Info = Agg.FallthroughLBRs[Trace(TraceFrom, TraceTo)];
+        if (TraceBF->containsAddress(LBR.From))
+          ++Info.InternCount;
+        else
+          ++Info.ExternCount;
+      } else {
+        if (TraceBF && getBinaryFunctionContainingAddress(TraceTo)) {
+          LLVM_DEBUG(dbgs()
+                     << "Invalid trace starting in "
+                     << TraceBF->getPrintName() << " @ "
+                     << Twine::utohexstr(TraceFrom - TraceBF->getAddress())
+                     << " and ending @ " << Twine::utohexstr(TraceTo)
+                     << '\n');
+          ++Agg.NumInvalidTraces;
         } else {
-          if (TraceBF && getBinaryFunctionContainingAddress(TraceTo)) {
-            LLVM_DEBUG(dbgs()
-                       << "Invalid trace starting in "
-                       << TraceBF->getPrintName() << " @ "
-                       << Twine::utohexstr(TraceFrom - TraceBF->getAddress())
-                       << " and ending @ " << Twine::utohexstr(TraceTo)
-                       << '\n');
-            ++NumInvalidTraces;
-          } else {
-            LLVM_DEBUG(dbgs()
-                       << "Out of range trace starting in "
-                       << (TraceBF ? TraceBF->getPrintName() : "None") << " @ "
-                       << Twine::utohexstr(
-                              TraceFrom - (TraceBF ? TraceBF->getAddress() : 0))
-                       << " and ending in "
-                       << (getBinaryFunctionContainingAddress(TraceTo)
-                               ? getBinaryFunctionContainingAddress(TraceTo)
-                                     ->getPrintName()
-                               : "None")
-                       << " @ "
-                       << Twine::utohexstr(
-                              TraceTo -
-                              (getBinaryFunctionContainingAddress(TraceTo)
-                                   ? getBinaryFunctionContainingAddress(TraceTo)
-                                         ->getAddress()
-                                   : 0))
-                       << '\n');
-            ++NumLongRangeTraces;
-          }
+          LLVM_DEBUG(dbgs()
+                     << "Out of range trace starting in "
+                     << (TraceBF ? TraceBF->getPrintName() : "None") << " @ "
+                     << Twine::utohexstr(
+                            TraceFrom - (TraceBF ? TraceBF->getAddress() : 0))
+                     << " and ending in "
+                     << (getBinaryFunctionContainingAddress(TraceTo)
+                             ? getBinaryFunctionContainingAddress(TraceTo)
+                                   ->getPrintName()
+                             : "None")
+                     << " @ "
+                     << Twine::utohexstr(
+                            TraceTo -
+                            (getBinaryFunctionContainingAddress(TraceTo)
+                                 ? getBinaryFunctionContainingAddress(TraceTo)
+                                       ->getAddress()
+                                 : 0))
+                     << '\n');
+          ++Agg.NumLongRangeTraces;
         }
-        ++NumTraces;
       }
-      NextPC = LBR.From;
-
-      uint64_t From = LBR.From;
-      if (!getBinaryFunctionContainingAddress(From))
-        From = 0;
-      uint64_t To = LBR.To;
-      if (!getBinaryFunctionContainingAddress(To))
-        To = 0;
-      if (!From && !To)
-        continue;
-      BranchInfo &Info = BranchLBRs[Trace(From, To)];
-      ++Info.TakenCount;
-      Info.MispredCount += LBR.Mispred;
+      ++Agg.NumTraces;
     }
+    NextPC = LBR.From;
+
+    uint64_t From = LBR.From;
+    if (!getBinaryFunctionContainingAddress(From))
+      From = 0;
+    uint64_t To = LBR.To;
+    if (!getBinaryFunctionContainingAddress(To))
+      To = 0;
+    if (!From && !To)
+      continue;
+    BranchInfo &Info = Agg.BranchLBRs[Trace(From, To)];
+    ++Info.TakenCount;
+    Info.MispredCount += LBR.Mispred;
   }
+}
+
+void DataAggregator::LBRAggregate::merge(LBRAggregate &&Other) {
+  if (BranchLBRs.empty() && FallthroughLBRs.empty() && BasicSamples.empty()) {
+    BranchLBRs = std::move(Other.BranchLBRs);
+    FallthroughLBRs = std::move(Other.FallthroughLBRs);
+    BasicSamples = std::move(Other.BasicSamples);
+  } else {
+    for (const auto &LBR : Other.BranchLBRs) {
+      BranchInfo &Info = BranchLBRs[LBR.first];
+      Info.TakenCount += LBR.second.TakenCount;
+      Info.MispredCount += LBR.second.MispredCount;
+    }
+    for (const auto &LBR : Other.FallthroughLBRs) {
+      FTInfo &Info = FallthroughLBRs[LBR.first];
+      Info.InternCount += LBR.second.InternCount;
+      Info.ExternCount += LBR.second.ExternCount;
+    }
+    for (const auto &Sample : Other.BasicSamples)
+      BasicSamples[Sample.first] += Sample.second;
+  }
+  NumSamples += Other.NumSamples;
+  NumSamplesNoLBR += Other.NumSamplesNoLBR;
+  NumEntries += Other.NumEntries;
+  NumTraces += Other.NumTraces;
+  NumInvalidTraces += Other.NumInvalidTraces;
+  NumLongRangeTraces += Other.NumLongRangeTraces;
+}
+
+void DataAggregator::finishBranchEvents(LBRAggregate &&Agg,
+                                        uint64_t NumTotalSamples) {
+  BranchLBRs = std::move(Agg.BranchLBRs);
+  FallthroughLBRs = std::move(Agg.FallthroughLBRs);
+  BasicSamples = std::move(Agg.BasicSamples);
+  NumInvalidTraces += Agg.NumInvalidTraces;
+  NumLongRangeTraces += Agg.NumLongRangeTraces;
+  const uint64_t NumSamples = Agg.NumSamples;
+  const uint64_t NumSamplesNoLBR = Agg.NumSamplesNoLBR;
+  const uint64_t NumEntries = Agg.NumEntries;
+  const uint64_t NumTraces = Agg.NumTraces;
 
   for (const auto &LBR : BranchLBRs) {
     const Trace &Trace = LBR.first;
@@ -1575,7 +1671,108 @@ std::error_code DataAggregator::parseBranchEvents() {
              "likely used bad data or your service observed a large shift in "
              "profile. You may want to audit this.\n";
   }
+}
+
+bool DataAggregator::convertBranchSample(const PerfDataReader::BranchSample &In,
+                                         PerfBranchSample &Out) const {
+  auto MMapInfoIter = BinaryMMapInfo.find(In.PID);
+  if (MMapInfoIter == BinaryMMapInfo.end())
+    return false;
+
+  Out.PC = In.PC;
+  Out.LBR.clear();
+  for (uint64_t I = 0; I < In.NumEntries; ++I) {
+    LBREntry LBR{In.getFrom(I), In.getTo(I), In.isMispredicted(I)};
+    if (ignoreKernelInterrupt(LBR))
+      continue;
+    if (!BC->HasFixedLoadAddress)
+      adjustLBR(LBR, MMapInfoIter->second);
+    Out.LBR.push_back(LBR);
+  }
+  return true;
+}
+
+std::error_code DataAggregator::parseNativeBranchEvents() {
+  outs() << "PERF2BOLT: parse branch events...\n";
+  NamedRegionTimer T("parseBranch", "Parsing branch events", TimerGroupName,
+                     TimerGroupDesc, opts::TimeAggregator);
+
+  ArrayRef<StringRef> Chunks = NativeReader->getSampleChunks();
+  ThreadPool &Pool = ParallelUtilities::getThreadPool();
+  std::vector<std::string> ChunkErrors(Chunks.size());
+
+  // The Skylake workaround applies to all samples following the first one
+  // with 32 entries. Find the chunks with such samples first, so that every
+  // chunk knows if it starts with the workaround enabled.
+  std::vector<char> StartsWithSkylakeFix(Chunks.size(), false);
+  if (BAT) {
+    std::vector<char> HasFullLBR(Chunks.size(), false);
+    for (size_t I = 0; I < Chunks.size(); ++I) {
+      Pool.async([&, I] {
+        PerfBranchSample Sample;
+        Error E = NativeReader->forEachBranchSample(
+            Chunks[I], [&](const PerfDataReader::BranchSample &In) {
+              if (convertBranchSample(In, Sample) && Sample.LBR.size() == 32)
+                HasFullLBR[I] = true;
+            });
+        consumeError(std::move(E));
+      });
+    }
+    Pool.wait();
+    for (size_t I = 1; I < Chunks.size(); ++I)
+      StartsWithSkylakeFix[I] =
+          StartsWithSkylakeFix[I - 1] || HasFullLBR[I - 1];
+    if (llvm::is_contained(HasFullLBR, true))
+      errs() << "PERF2BOLT-WARNING: using Intel Skylake bug workaround\n";
+  }
+
+  auto aggregateChunk = [&](size_t I, LBRAggregate &Agg) {
+    bool NeedsSkylakeFix = StartsWithSkylakeFix[I];
+    PerfBranchSample Sample;
+    Error E = NativeReader->forEachBranchSample(
+        Chunks[I], [&](const PerfDataReader::BranchSample &In) {
+          if (!convertBranchSample(In, Sample))
+            return;
+          if (BAT && Sample.LBR.size() == 32)
+            NeedsSkylakeFix = true;
+          aggregateBranchSample(Sample, NeedsSkylakeFix, Agg);
+        });
+    if (E)
+      ChunkErrors[I] = toString(std::move(E));
+  };
+
+  // Chunks are merged in order as they complete, which keeps the result
+  // independent of the number of threads while bounding the number of
+  // partial aggregates alive at the same time.
+  LBRAggregate Total;
+  using PendingAggregate =
+      std::pair<std::shared_future<void>, std::unique_ptr<LBRAggregate>>;
+  std::deque<PendingAggregate> InFlight;
+  const size_t MaxInFlight = 2 * Pool.getThreadCount();
+  auto mergeOldest = [&] {
+    InFlight.front().first.wait();
+    Total.merge(std::move(*InFlight.front().second));
+    InFlight.pop_front();
+  };
+  for (size_t I = 0; I < Chunks.size(); ++I) {
+    auto Agg = std::make_unique<LBRAggregate>();
+    LBRAggregate *Part = Agg.get();
+    InFlight.emplace_back(
+        Pool.async([&, I, Part] { aggregateChunk(I, *Part); }), std::move(Agg));
+    if (InFlight.size() >= MaxInFlight)
+      mergeOldest();
+  }
+  while (!InFlight.empty())
+    mergeOldest();
+
+  for (const std::string &Error : ChunkErrors) {
+    if (!Error.empty()) {
+      errs() << "PERF2BOLT-ERROR: " << Error << '\n';
+      return make_error_code(errc::io_error);
+    }
+  }
 
+  finishBranchEvents(std::move(Total), NativeReader->getNumSamples());
   return std::error_code();
 }
 
@@ -1994,21 +2191,26 @@ std::error_code DataAggregator::parseMMapEvents() {
     if (FileMMapInfo.second.PID == -1)
       continue;
 
-    // Consider only the first mapping of the file for any given PID
-    bool PIDExists = false;
-    auto Range = GlobalMMapInfo.equal_range(FileMMapInfo.first);
-    for (auto MI = Range.first; MI != Range.second; ++MI) {
-      if (MI->second.PID == FileMMapInfo.second.PID) {
-        PIDExists = true;
-        break;
-      }
-    }
-    if (PIDExists)
-      continue;
-
-    GlobalMMapInfo.insert(FileMMapInfo);
+    addMMapInfo(GlobalMMapInfo, FileMMapInfo.first, FileMMapInfo.second);
   }
 
+  return matchBinaryMMapInfo(GlobalMMapInfo);
+}
+
+void DataAggregator::addMMapInfo(
+    std::multimap<StringRef, MMapInfo> &GlobalMMapInfo, StringRef FileName,
+    const MMapInfo &Info) const {
+  // Consider only the first mapping of the file for any given PID
+  auto Range = GlobalMMapInfo.equal_range(FileName);
+  for (auto MI = Range.first; MI != Range.second; ++MI)
+    if (MI->second.PID == Info.PID)
+      return;
+
+  GlobalMMapInfo.insert(std::make_pair(FileName, Info));
+}
+
+std::error_code DataAggregator::matchBinaryMMapInfo(
+    std::multimap<StringRef, MMapInfo> &GlobalMMapInfo) {
   LLVM_DEBUG({
     dbgs() << "FileName -> mmap info:\n";
     for (const std::pair<const StringRef, MMapInfo> &Pair : GlobalMMapInfo)
@@ -2096,35 +2298,13 @@ std::error_code DataAggregator::parseTaskEvents() {
 
   while (hasData()) {
     if (Optional<int32_t> CommInfo = parseCommExecEvent()) {
-      // Remove forked child that ran execve
-      auto MMapInfoIter = BinaryMMapInfo.find(*CommInfo);
-      if (MMapInfoIter != BinaryMMapInfo.end() && MMapInfoIter->second.Forked)
-        BinaryMMapInfo.erase(MMapInfoIter);
+      handleCommExec(*CommInfo);
       consumeRestOfLine();
       continue;
     }
 
-    Optional<ForkInfo> ForkInfo = parseForkEvent();
-    if (!ForkInfo)
-      continue;
-
-    if (ForkInfo->ParentPID == ForkInfo->ChildPID)
-      continue;
-
-    if (ForkInfo->Time == 0) {
-      // Process was forked and mmaped before perf ran. In this case the child
-      // should have its own mmap entry unless it was execve'd.
-      continue;
-    }
-
-    auto MMapInfoIter = BinaryMMapInfo.find(ForkInfo->ParentPID);
-    if (MMapInfoIter == BinaryMMapInfo.end())
-      continue;
-
-    MMapInfo MMapInfo = MMapInfoIter->second;
-    MMapInfo.PID = ForkInfo->ChildPID;
-    MMapInfo.Forked = true;
-    BinaryMMapInfo.insert(std::make_pair(MMapInfo.PID, MMapInfo));
+    if (Optional<ForkInfo> ForkInfo = parseForkEvent())
+      handleFork(*ForkInfo);
   }
 
   outs() << "PERF2BOLT: input binary is associated with "
@@ -2140,6 +2320,80 @@ std::error_code DataAggregator::parseTaskEvents() {
   return std::error_code();
 }
 
+void DataAggregator::handleCommExec(int32_t PID) {
+  // Remove forked child that ran execve
+  auto MMapInfoIter = BinaryMMapInfo.find(PID);
+  if (MMapInfoIter != BinaryMMapInfo.end() && MMapInfoIter->second.Forked)
+    BinaryMMapInfo.erase(MMapInfoIter);
+}
+
+void DataAggregator::handleFork(const ForkInfo &FI) {
+  if (FI.ParentPID == FI.ChildPID)
+    return;
+
+  if (FI.Time == 0) {
+    // Process was forked and mmaped before perf ran. In this case the child
+    // should have its own mmap entry unless it was execve'd.
+    return;
+  }
+
+  auto MMapInfoIter = BinaryMMapInfo.find(FI.ParentPID);
+  if (MMapInfoIter == BinaryMMapInfo.end())
+    return;
+
+  MMapInfo MMapInfo = MMapInfoIter->second;
+  MMapInfo.PID = FI.ChildPID;
+  MMapInfo.Forked = true;
+  BinaryMMapInfo.insert(std::make_pair(MMapInfo.PID, MMapInfo));
+}
+
+std::error_code DataAggregator::parseNativeTaskEvents() {
+  outs() << "PERF2BOLT: reading mmap and task events from perf.data\n";
+  NamedRegionTimer T("parseNativeTaskEvents", "Reading mmap and task events",
+                     TimerGroupName, TimerGroupDesc, opts::TimeAggregator);
+
+  if (Error E = NativeReader->scan(opts::MaxSamples)) {
+    errs() << "PERF2BOLT-ERROR: " << toString(std::move(E)) << '\n';
+    deleteTempFiles();
+    exit(1);
+  }
+
+  // Same filtering as done for perf script output in parseMMapEvent().
+  std::multimap<StringRef, MMapInfo> GlobalMMapInfo;
+  for (const PerfDataReader::MMapEvent &Event :
+       NativeReader->getMMapEvents()) {
+    if (Event.FileName.startswith("//") || Event.FileName.startswith("["))
+      continue;
+    MMapInfo Info;
+    Info.PID = Event.PID;
+    Info.MMapAddress = Event.Address;
+    Info.Size = Event.Size;
+    Info.Offset = Event.Offset;
+    Info.Time = Event.Time / 1000;
+    addMMapInfo(GlobalMMapInfo, sys::path::filename(Event.FileName), Info);
+  }
+  if (std::error_code EC = matchBinaryMMapInfo(GlobalMMapInfo))
+    return EC;
+
+  for (const PerfDataReader::TaskEvent &Event :
+       NativeReader->getTaskEvents()) {
+    if (Event.Kind == PerfDataReader::TaskEvent::CommExec) {
+      handleCommExec(Event.PID);
+      continue;
+    }
+    ForkInfo FI;
+    FI.ParentPID = Event.ParentPID;
+    FI.ChildPID = Event.PID;
+    FI.Time = Event.Time / 1000;
+    handleFork(FI);
+  }
+
+  outs() << "PERF2BOLT: input binary is associated with "
+         << BinaryMMapInfo.size() << " PID(s)\n";
+
+  return std::error_code();
+}
+
 Optional<std::pair<StringRef, StringRef>>
 DataAggregator::parseNameBuildIDPair() {
   while (checkAndConsumeFS()) {
@@ -0,0 +1,436 @@
+//===- bolt/Profile/PerfDataReader.cpp - perf.data file reader ------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Decoding of the perf.data file format. The layout of the file and of the
+// records is described in tools/perf/Documentation/perf.data-file-format.txt
+// and include/uapi/linux/perf_event.h in the Linux source tree.
+//
+//===----------------------------------------------------------------------===//
+
+#include "bolt/Profile/PerfDataReader.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/Support/Errc.h"
+#include "llvm/Support/MathExtras.h"
+#include <cstring>
+
+using namespace llvm;
+using namespace bolt;
+using namespace llvm::support::endian;
+
+namespace {
+
+// "PERFILE2" read as a little-endian number.
+constexpr uint64_t PerfMagic = 0x32454c4946524550ULL;
+
+// Size of perf_file_header with the feature bitmap.
+constexpr uint64_t PerfFileHeaderSize = 104;
+
+// Size of perf_event_attr up to and including branch_sample_type.
+constexpr uint64_t PerfAttrSizeVer2 = 80;
+
+enum : uint32_t {
+  PERF_RECORD_COMM = 3,
+  PERF_RECORD_FORK = 7,
+  PERF_RECORD_SAMPLE = 9,
+  PERF_RECORD_MMAP2 = 10,
+  PERF_RECORD_AUXTRACE = 71,
+  PERF_RECORD_COMPRESSED = 81,
+};
+
+enum : uint16_t { PERF_RECORD_MISC_COMM_EXEC = 1 << 13 };
+
+enum : uint64_t {
+  PERF_SAMPLE_IP = 1U << 0,
+  PERF_SAMPLE_TID = 1U << 1,
+  PERF_SAMPLE_TIME = 1U << 2,
+  PERF_SAMPLE_ADDR = 1U << 3,
+  PERF_SAMPLE_READ = 1U << 4,
+  PERF_SAMPLE_CALLCHAIN = 1U << 5,
+  PERF_SAMPLE_ID = 1U << 6,
+  PERF_SAMPLE_CPU = 1U << 7,
+  PERF_SAMPLE_PERIOD = 1U << 8,
+  PERF_SAMPLE_STREAM_ID = 1U << 9,
+  PERF_SAMPLE_RAW = 1U << 10,
+  PERF_SAMPLE_BRANCH_STACK = 1U << 11,
+  PERF_SAMPLE_IDENTIFIER = 1U << 16,
+};
+
+enum : uint64_t {
+  PERF_FORMAT_TOTAL_TIME_ENABLED = 1U << 0,
+  PERF_FORMAT_TOTAL_TIME_RUNNING = 1U << 1,
+  PERF_FORMAT_ID = 1U << 2,
+  PERF_FORMAT_GROUP = 1U << 3,
+  PERF_FORMAT_LOST = 1U << 4,
+};
+
+enum : uint64_t { PERF_SAMPLE_BRANCH_HW_INDEX = 1U << 17 };
+
+// perf_event_attr::sample_id_all
+constexpr uint64_t AttrFlagSampleIDAll = 1ULL << 18;
+
+Error malformed(const Twine &Msg) {
+  return createStringError(errc::illegal_byte_sequence,
+                           "malformed perf.data: " + Msg);
+}
+
+/// Sequential reader of the fixed-size fields of a record body.
+class FieldReader {
+  StringRef Data;
+  bool Failed{false};
+
+public:
+  explicit FieldReader(StringRef Data) : Data(Data) {}
+
+  bool failed() const { return Failed; }
+  const char *data() const { return Data.data(); }
+
+  void skip(uint64_t Size) {
+    if (Size > Data.size()) {
+      Failed = true;
+      Size = Data.size();
+    }
+    Data = Data.drop_front(Size);
+  }
+
+  void skipArray(uint64_t Num, uint64_t EltSize) {
+    if (Num > Data.size() / EltSize)
+      Failed = true;
+    skip(Failed ? Data.size() : Num * EltSize);
+  }
+
+  uint64_t read64() {
+    if (Data.size() < 8) {
+      Failed = true;
+      return 0;
+    }
+    const uint64_t Value = read64le(Data.data());
+    Data = Data.drop_front(8);
+    return Value;
+  }
+
+  uint32_t read32() {
+    if (Data.size() < 4) {
+      Failed = true;
+      return 0;
+    }
+    const uint32_t Value = read32le(Data.data());
+    Data = Data.drop_front(4);
+    return Value;
+  }
+};
+
+/// Invoke \p Callback with the type, misc field and body of every record in
+/// \p Data.
+template <typename CallbackTy>
+Error forEachRecord(StringRef Data, CallbackTy Callback) {
+  while (!Data.empty()) {
+    if (Data.size() < 8)
+      return malformed("truncated record header");
+    const uint32_t Type = read32le(Data.data());
+    const uint16_t Misc = read16le(Data.data() + 4);
+    const uint16_t Size = read16le(Data.data() + 6);
+    if (Size < 8 || Size > Data.size())
+      return malformed("invalid record size");
+
+    if (Type == PERF_RECORD_COMPRESSED)
+      return createStringError(errc::not_supported,
+                               "compressed perf.data is not supported");
+
+    // Auxiliary trace data directly follows its record.
+    uint64_t RecordSize = Size;
+    if (Type == PERF_RECORD_AUXTRACE) {
+      if (Size < 16)
+        return malformed("invalid auxtrace record");
+      const uint64_t AuxSize = read64le(Data.data() + 8);
+      if (AuxSize > Data.size() - Size)
+        return malformed("truncated auxtrace data");
+      RecordSize += AuxSize;
+    }
+
+    if (Error E = Callback(Type, Misc, Data.substr(8, Size - 8)))
+      return E;
+    Data = Data.drop_front(RecordSize);
+  }
+  return Error::success();
+}
+
+} // namespace
+
+Expected<std::unique_ptr<PerfDataReader>>
+PerfDataReader::create(StringRef FileName) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> MB =
+      MemoryBuffer::getFile(FileName, /*IsText=*/false,
+                            /*RequiresNullTerminator=*/false);
+  if (std::error_code EC = MB.getError())
+    return createStringError(EC, "cannot open " + FileName + ": " +
+                                     EC.message());
+
+  std::unique_ptr<PerfDataReader> Reader(new PerfDataReader(std::move(*MB)));
+  if (Error E = Reader->readHeader())
+    return std::move(E);
+  return std::move(Reader);
+}
+
+Error PerfDataReader::readHeader() {
+  const StringRef File = Buffer->getBuffer();
+  if (File.size() < 16)
+    return malformed("truncated file header");
+
+  const uint64_t Magic = read64le(File.data());
+  if (Magic == ByteSwap_64(PerfMagic))
+    return createStringError(errc::not_supported,
+                             "big-endian perf.data is not supported");
+  if (Magic != PerfMagic)
+    return createStringError(errc::invalid_argument, "not a perf.data file");
+
+  if (read64le(File.data() + 8) < PerfFileHeaderSize)
+    return createStringError(errc::not_supported,
+                             "perf.data written in pipe mode is not supported");
+  if (File.size() < PerfFileHeaderSize)
+    return malformed("truncated file header");
+
+  const uint64_t AttrSize = read64le(File.data() + 16);
+  const uint64_t AttrsOffset = read64le(File.data() + 24);
+  const uint64_t AttrsSize = read64le(File.data() + 32);
+  const uint64_t DataOffset = read64le(File.data() + 40);
+  const uint64_t DataSize = read64le(File.data() + 48);
+
+  // Each perf_file_attr is a perf_event_attr followed by the section with the
+  // IDs of the event.
+  if (AttrSize < PerfAttrSizeVer2 + 16)
+    return createStringError(errc::not_supported,
+                             "perf.data event attributes are too old");
+  if (AttrsOffset > File.size() || AttrsSize > File.size() - AttrsOffset ||
+      AttrsSize % AttrSize != 0 || AttrsSize == 0)
+    return malformed("invalid attribute section");
+  if (DataOffset > File.size() || DataSize > File.size() - DataOffset)
+    return malformed("invalid data section");
+
+  for (uint64_t Offset = 0; Offset < AttrsSize; Offset += AttrSize) {
+    const char *Attr = File.data() + AttrsOffset + Offset;
+    EventAttr EA;
+    EA.SampleType = read64le(Attr + 24);
+    EA.ReadFormat = read64le(Attr + 32);
+    EA.SampleIDAll = read64le(Attr + 40) & AttrFlagSampleIDAll;
+    EA.BranchSampleType = read64le(Attr + 72);
+
+    if (!(EA.SampleType & PERF_SAMPLE_IP) || !(EA.SampleType & PERF_SAMPLE_TID))
+      return createStringError(errc::not_supported,
+                               "samples do not record the IP and PID");
+
+    if (!Attrs.empty())
+      UniformAttrs &= Attrs[0].SampleType == EA.SampleType &&
+                      Attrs[0].ReadFormat == EA.ReadFormat &&
+                      Attrs[0].BranchSampleType == EA.BranchSampleType &&
+                      Attrs[0].SampleIDAll == EA.SampleIDAll;
+
+    const uint64_t IDsOffset = read64le(Attr + AttrSize - 16);
+    const uint64_t IDsSize = read64le(Attr + AttrSize - 8);
+    if (IDsOffset > File.size() || IDsSize > File.size() - IDsOffset)
+      return malformed("invalid event ID section");
+    for (uint64_t I = 0; I + 8 <= IDsSize; I += 8)
+      AttrIDs[read64le(File.data() + IDsOffset + I)] = Attrs.size();
+
+    Attrs.push_back(EA);
+  }
+
+  // Records of events with different layouts can only be told apart by the
+  // identifier at a fixed position.
+  if (!UniformAttrs && llvm::any_of(Attrs, [](const EventAttr &EA) {
+        return !(EA.SampleType & PERF_SAMPLE_IDENTIFIER);
+      }))
+    return createStringError(errc::not_supported,
+                             "events with different sample formats were "
+                             "recorded without PERF_SAMPLE_IDENTIFIER");
+
+  Data = File.substr(DataOffset, DataSize);
+  return Error::success();
+}
+
+const PerfDataReader::EventAttr *
+PerfDataReader::getAttr(uint32_t Type, StringRef Body) const {
+  if (UniformAttrs)
+    return &Attrs[0];
+
+  // The identifier is the first field of a sample and the last field of the
+  // sample_id trailer of other records.
+  if (Body.size() < 8)
+    return nullptr;
+  const uint64_t ID = Type == PERF_RECORD_SAMPLE
+                          ? read64le(Body.data())
+                          : read64le(Body.end() - 8);
+  auto It = AttrIDs.find(ID);
+  if (It == AttrIDs.end())
+    return nullptr;
+  return &Attrs[It->second];
+}
+
+uint64_t PerfDataReader::getSampleIDTime(const EventAttr &Attr,
+                                         StringRef Body) const {
+  if (!Attr.SampleIDAll || !(Attr.SampleType & PERF_SAMPLE_TIME))
+    return 0;
+
+  const uint64_t TrailerFields = PERF_SAMPLE_TID | PERF_SAMPLE_TIME |
+                                 PERF_SAMPLE_ID | PERF_SAMPLE_STREAM_ID |
+                                 PERF_SAMPLE_CPU | PERF_SAMPLE_IDENTIFIER;
+  const uint64_t TrailerSize = 8 * countPopulation(Attr.SampleType &
+                                                   TrailerFields);
+  if (Body.size() < TrailerSize)
+    return 0;
+  const uint64_t TimeOffset = Body.size() - TrailerSize +
+                              (Attr.SampleType & PERF_SAMPLE_TID ? 8 : 0);
+  return read64le(Body.data() + TimeOffset);
+}
+
+Error PerfDataReader::scan(uint64_t MaxSamples, uint64_t ChunkSize) {
+  MMapEvents.clear();
+  TaskEvents.clear();
+  SampleChunks.clear();
+  NumSamples = 0;
+
+  const char *ChunkBegin = nullptr;
+  bool ChunksDone = MaxSamples == 0;
+
+  Error E = forEachRecord(Data, [&](uint32_t Type, uint16_t Misc,
+                                    StringRef Body) -> Error {
+    switch (Type) {
+    case PERF_RECORD_SAMPLE: {
+      if (ChunksDone)
+        return Error::success();
+      const char *RecordBegin = Body.data() - 8;
+      if (!ChunkBegin) {
+        ChunkBegin = RecordBegin;
+      } else if (uint64_t(RecordBegin - ChunkBegin) >= ChunkSize) {
+        SampleChunks.emplace_back(ChunkBegin, RecordBegin - ChunkBegin);
+        ChunkBegin = RecordBegin;
+      }
+      if (++NumSamples == MaxSamples) {
+        SampleChunks.emplace_back(ChunkBegin, Body.end() - ChunkBegin);
+        ChunkBegin = nullptr;
+        ChunksDone = true;
+      }
+      return Error::success();
+    }
+    case PERF_RECORD_MMAP2: {
+      if (Body.size() <= 64)
+        return malformed("truncated mmap2 record");
+      MMapEvent Event;
+      Event.PID = read32le(Body.data());
+      Event.Address = read64le(Body.data() + 8);
+      Event.Size = read64le(Body.data() + 16);
+      Event.Offset = read64le(Body.data() + 24);
+      const char *Name = Body.data() + 64;
+      Event.FileName = StringRef(Name, strnlen(Name, Body.size() - 64));
+      const EventAttr *Attr = getAttr(Type, Body);
+      Event.Time = Attr ? getSampleIDTime(*Attr, Body) : 0;
+      MMapEvents.push_back(Event);
+      return Error::success();
+    }
+    case PERF_RECORD_COMM: {
+      if (!(Misc & PERF_RECORD_MISC_COMM_EXEC))
+        return Error::success();
+      if (Body.size() < 8)
+        return malformed("truncated comm record");
+      TaskEvent Event;
+      Event.Kind = TaskEvent::CommExec;
+      Event.PID = read32le(Body.data());
+      Event.ParentPID = -1;
+      Event.Time = 0;
+      TaskEvents.push_back(Event);
+      return Error::success();
+    }
+    case PERF_RECORD_FORK: {
+      if (Body.size() < 24)
+        return malformed("truncated fork record");
+      TaskEvent Event;
+      Event.Kind = TaskEvent::Fork;
+      Event.PID = read32le(Body.data());
+      Event.ParentPID = read32le(Body.data() + 4);
+      Event.Time = read64le(Body.data() + 16);
+      TaskEvents.push_back(Event);
+      return Error::success();
+    }
+    default:
+      return Error::success();
+    }
+  });
+  if (E)
+    return E;
+
+  if (ChunkBegin)
+    SampleChunks.emplace_back(ChunkBegin, Data.end() - ChunkBegin);
+
+  return Error::success();
+}
+
+Error PerfDataReader::forEachBranchSample(
+    StringRef Chunk, function_ref<void(const BranchSample &)> Callback) const {
+  return forEachRecord(Chunk, [&](uint32_t Type, uint16_t,
+                                  StringRef Body) -> Error {
+    if (Type != PERF_RECORD_SAMPLE)
+      return Error::success();
+
+    const EventAttr *Attr = getAttr(Type, Body);
+    if (!Attr)
+      return malformed("sample of an unknown event");
+    const uint64_t SampleType = Attr->SampleType;
+
+    FieldReader R(Body);
+    if (SampleType & PERF_SAMPLE_IDENTIFIER)
+      R.skip(8);
+    const uint64_t PC = R.read64();
+    const int32_t PID = R.read32();
+    R.skip(4); // TID
+    if (SampleType & PERF_SAMPLE_TIME)
+      R.skip(8);
+    if (SampleType & PERF_SAMPLE_ADDR)
+      R.skip(8);
+    if (SampleType & PERF_SAMPLE_ID)
+      R.skip(8);
+    if (SampleType & PERF_SAMPLE_STREAM_ID)
+      R.skip(8);
+    if (SampleType & PERF_SAMPLE_CPU)
+      R.skip(8);
+    if (SampleType & PERF_SAMPLE_PERIOD)
+      R.skip(8);
+    if (SampleType & PERF_SAMPLE_READ) {
+      const uint64_t ReadFormat = Attr->ReadFormat;
+      const uint64_t TimeSize =
+          (ReadFormat & PERF_FORMAT_TOTAL_TIME_ENABLED ? 8 : 0) +
+          (ReadFormat & PERF_FORMAT_TOTAL_TIME_RUNNING ? 8 : 0);
+      const uint64_t ValueSize = 8 + (ReadFormat & PERF_FORMAT_ID ? 8 : 0) +
+                                 (ReadFormat & PERF_FORMAT_LOST ? 8 : 0);
+      if (ReadFormat & PERF_FORMAT_GROUP) {
+        const uint64_t NumValues = R.read64();
+        R.skip(TimeSize);
+        R.skipArray(NumValues, ValueSize);
+      } else {
+        R.skip(TimeSize + ValueSize);
+      }
+    }
+    if (SampleType & PERF_SAMPLE_CALLCHAIN)
+      R.skipArray(R.read64(), 8);
+    if (SampleType & PERF_SAMPLE_RAW)
+      R.skip(R.read32());
+
+    uint64_t NumEntries = 0;
+    const char *Entries = nullptr;
+    if (SampleType & PERF_SAMPLE_BRANCH_STACK) {
+      NumEntries = R.read64();
+      if (Attr->BranchSampleType & PERF_SAMPLE_BRANCH_HW_INDEX)
+        R.skip(8);
+      Entries = R.data();
+      R.skipArray(NumEntries, 24);
+    }
+    if (R.failed())
+      return malformed("truncated sample record");
+
+    Callback(BranchSample(PID, PC, Entries, NumEntries));
+    return Error::success();
+  });
+}
@@ -40,7 +40,10 @@
 #include "clang/Tooling/ReplacementsYaml.h"
 #include "clang/Tooling/Tooling.h"
 #include "llvm/Support/Process.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
 #include <algorithm>
+#include <mutex>
 #include <utility>
 
 #if CLANG_TIDY_ENABLE_STATIC_ANALYZER
@@ -503,13 +506,77 @@ getCheckOptions(const ClangTidyOptions &Options,
   return Factory.getCheckOptions();
 }
 
+namespace {
+/// Answers option queries of a worker context from the context of the whole
+/// run, so that configuration files are only read and cached once.
+class SharedOptionsProvider : public ClangTidyOptionsProvider {
+public:
+  SharedOptionsProvider(const ClangTidyContext &Context, std::mutex &Lock)
+      : Context(Context), Lock(Lock) {}
+
+  const ClangTidyGlobalOptions &getGlobalOptions() override {
+    return Context.getGlobalOptions();
+  }
+
+  std::vector<OptionsSource> getRawOptions(StringRef FileName) override {
+    std::lock_guard<std::mutex> Guard(Lock);
+    return {OptionsSource(Context.getOptionsForFile(FileName),
+                          "shared options")};
+  }
+
+private:
+  const ClangTidyContext &Context;
+  std::mutex &Lock;
+};
+} // namespace
+
+/// Runs clang-tidy on every file of \p InputFiles in a separate task with its
+/// own context and diagnostic consumer, and merges the results.
+static std::vector<ClangTidyError>
+runClangTidyInParallel(ClangTidyContext &Context,
+                       const CompilationDatabase &Compilations,
+                       ArrayRef<std::string> InputFiles, bool ApplyAnyFix,
+                       bool EnableCheckProfile,
+                       llvm::StringRef StoreCheckProfile, unsigned Jobs) {
+  ClangTidyDiagnosticConsumer DiagConsumer(Context, nullptr, true, ApplyAnyFix);
+  std::mutex Lock;
+  llvm::ThreadPool Pool(llvm::hardware_concurrency(Jobs));
+  for (const std::string &File : InputFiles) {
+    Pool.async([&, File] {
+      ClangTidyContext FileContext(
+          std::make_unique<SharedOptionsProvider>(Context, Lock),
+          Context.canEnableAnalyzerAlphaCheckers());
+      IntrusiveRefCntPtr<llvm::vfs::OverlayFileSystem> FileFS(
+          new llvm::vfs::OverlayFileSystem(
+              llvm::vfs::createPhysicalFileSystem()));
+      std::vector<ClangTidyError> Errors = runClangTidy(
+          FileContext, Compilations, File, std::move(FileFS), ApplyAnyFix,
+          EnableCheckProfile, StoreCheckProfile);
+      std::lock_guard<std::mutex> Guard(Lock);
+      DiagConsumer.addErrors(std::move(Errors), FileContext.getStats());
+    });
+  }
+  Pool.wait();
+  return DiagConsumer.take();
+}
+
 std::vector<ClangTidyError>
 runClangTidy(clang::tidy::ClangTidyContext &Context,
              const CompilationDatabase &Compilations,
              ArrayRef<std::string> InputFiles,
              llvm::IntrusiveRefCntPtr<llvm::vfs::OverlayFileSystem> BaseFS,
              bool ApplyAnyFix, bool EnableCheckProfile,
-             llvm::StringRef StoreCheckProfile) {
+             llvm::StringRef StoreCheckProfile, unsigned Jobs) {
+  // ClangTool changes the working directory of its file system for every
+  // compile command, which is process-wide for the real file system. Each
+  // worker gets its own physical file system instead, so this is only done
+  // when BaseFS contains nothing but the real file system.
+  if (Jobs != 1 && InputFiles.size() > 1 &&
+      std::distance(BaseFS->overlays_begin(), BaseFS->overlays_end()) == 1)
+    return runClangTidyInParallel(Context, Compilations, InputFiles,
+                                  ApplyAnyFix, EnableCheckProfile,
+                                  StoreCheckProfile, Jobs);
+
   ClangTool Tool(Compilations, InputFiles,
                  std::make_shared<PCHContainerOperations>(), BaseFS);
 
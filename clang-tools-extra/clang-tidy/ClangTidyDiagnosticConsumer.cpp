@@ -724,8 +724,19 @@ struct EqualClangTidyError {
 };
 } // end anonymous namespace
 
+void ClangTidyDiagnosticConsumer::addErrors(
+    std::vector<ClangTidyError> OtherErrors, const ClangTidyStats &OtherStats) {
+  AddedErrors.insert(AddedErrors.end(),
+                     std::make_move_iterator(OtherErrors.begin()),
+                     std::make_move_iterator(OtherErrors.end()));
+  Context.Stats += OtherStats;
+}
+
 std::vector<ClangTidyError> ClangTidyDiagnosticConsumer::take() {
   finalizeLastError();
+  Errors.insert(Errors.end(), std::make_move_iterator(AddedErrors.begin()),
+                std::make_move_iterator(AddedErrors.end()));
+  AddedErrors.clear();
 
   llvm::stable_sort(Errors, LessClangTidyError());
   Errors.erase(std::unique(Errors.begin(), Errors.end(), EqualClangTidyError()),
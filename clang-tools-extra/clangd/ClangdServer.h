@@ -171,6 +171,10 @@ public:
     // If true, parse emplace-like functions in the preamble.
     bool PreambleParseForwardingFunctions = false;
 
+    /// If not empty, built preambles are stored in this directory and reused
+    /// by all clangd instances pointing at it.
+    std::string PreambleCacheDir;
+
     explicit operator TUScheduler::Options() const;
   };
   // Sensible default options for use in tests.
@@ -434,6 +438,8 @@ private:
 
   bool PreambleParseForwardingFunctions = false;
 
+  std::string PreambleCacheDir;
+
   // GUARDED_BY(CachedCompletionFuzzyFindRequestMutex)
   llvm::StringMap<llvm::Optional<FuzzyFindRequest>>
       CachedCompletionFuzzyFindRequestByFile;
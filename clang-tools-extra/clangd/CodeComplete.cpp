@@ -1248,7 +1248,14 @@ bool semaCodeComplete(std::unique_ptr<CodeCompleteConsumer> Consumer,
   trace::Span Tracer("Sema completion");
 
   IgnoreDiagnostics IgnoreDiags;
-  auto CI = buildCompilerInvocation(Input.ParseInput, IgnoreDiags);
+  // Running the driver is a noticeable part of the latency of a completion
+  // request. Reuse the invocation of the preamble if the command is the same.
+  std::unique_ptr<CompilerInvocation> CI;
+  if (Input.Preamble.Invocation &&
+      Input.Preamble.CompileCommand == Input.ParseInput.CompileCommand)
+    CI = std::make_unique<CompilerInvocation>(*Input.Preamble.Invocation);
+  else
+    CI = buildCompilerInvocation(Input.ParseInput, IgnoreDiags);
   if (!CI) {
     elog("Couldn't create CompilerInvocation");
     return false;
@@ -40,6 +40,9 @@ public:
 // Options to run clang e.g. when parsing AST.
 struct ParseOptions {
   bool PreambleParseForwardingFunctions = false;
+  // If not empty, preambles are shared with other clangd instances through
+  // this directory, see PreambleCache.
+  std::string PreambleCacheDir;
 };
 
 /// Information required to run clang, e.g. to parse AST or do code completion.
@@ -61,6 +61,105 @@ void closeBrackets(std::string &Code, const format::FormatStyle &Style) {
   Code.append(Brackets.rbegin(), Brackets.rend());
 }
 
+/// Returns the start of a line before \p Offset from which \p Code can be
+/// formatted as if the file began there, or 0 if there is none.
+/// This is the last line that follows a blank line and the end of a
+/// declaration or preprocessor directive, outside of brackets and
+/// preprocessor conditionals. Namespaces are looked through if they do not
+/// indent their contents.
+/// Format-on-type only changes code around the cursor, this saves lexing,
+/// parsing and annotating the rest of a large file on every keystroke.
+unsigned findRestartOffset(llvm::StringRef Code, unsigned Offset,
+                           const format::FormatStyle &Style) {
+  // These make formatting depend on lines across blank lines.
+  if (Style.DerivePointerAlignment ||
+      Style.AlignConsecutiveMacros.AcrossEmptyLines ||
+      Style.AlignConsecutiveAssignments.AcrossEmptyLines ||
+      Style.AlignConsecutiveBitFields.AcrossEmptyLines ||
+      Style.AlignConsecutiveDeclarations.AcrossEmptyLines)
+    return 0;
+
+  SourceManagerForFile FileSM("mock_file.cpp", Code);
+  auto &SM = FileSM.get();
+  FileID FID = SM.getMainFileID();
+  LangOptions LangOpts = format::getFormattingLangOpts(Style);
+  Lexer Lex(FID, SM.getBufferOrFake(FID), SM, LangOpts);
+  Lex.SetCommentRetentionState(true);
+  Token Tok;
+  // For each open bracket, whether it is the brace of a namespace.
+  std::vector<bool> Brackets;
+  unsigned Restart = 0, PrevEnd = 0, ConditionalDepth = 0;
+  bool InDirective = false, AfterHash = false, SawNamespace = false;
+  // Whether the last token outside of comments ended a declaration.
+  bool AtDeclarationEnd = true;
+  while (!Lex.LexFromRawLexer(Tok)) {
+    unsigned TokOffset = SM.getFileOffset(Tok.getLocation());
+    if (TokOffset >= Offset)
+      break;
+    if (Tok.isAtStartOfLine()) {
+      if (InDirective)
+        AtDeclarationEnd = true;
+      InDirective = Tok.is(tok::hash);
+      llvm::StringRef Gap = Code.slice(PrevEnd, TokOffset);
+      size_t LastNewline = Gap.rfind('\n');
+      bool AfterBlankLine = LastNewline != llvm::StringRef::npos &&
+                            Gap.take_front(LastNewline).contains('\n');
+      bool OnlyNamespaces =
+          Brackets.empty() ||
+          (Style.NamespaceIndentation == format::FormatStyle::NI_None &&
+           llvm::all_of(Brackets, [](bool IsNS) { return IsNS; }));
+      if (!InDirective && AfterBlankLine && AtDeclarationEnd &&
+          ConditionalDepth == 0 && OnlyNamespaces &&
+          Code.slice(TokOffset, Offset).contains('\n'))
+        Restart = PrevEnd + LastNewline + 1;
+    }
+    PrevEnd = TokOffset + Tok.getLength();
+
+    if (InDirective) {
+      if (AfterHash && Tok.is(tok::raw_identifier)) {
+        llvm::StringRef Name = Tok.getRawIdentifier();
+        if (Name == "if" || Name == "ifdef" || Name == "ifndef")
+          ++ConditionalDepth;
+        else if (Name == "endif" && ConditionalDepth > 0)
+          --ConditionalDepth;
+      }
+      AfterHash = Tok.is(tok::hash);
+      continue;
+    }
+    if (Tok.is(tok::comment))
+      continue;
+    AtDeclarationEnd = Tok.isOneOf(tok::semi, tok::l_brace, tok::r_brace);
+    switch (Tok.getKind()) {
+    case tok::raw_identifier:
+      if (Tok.getRawIdentifier() == "namespace")
+        SawNamespace = true;
+      break;
+    case tok::l_brace:
+      Brackets.push_back(SawNamespace);
+      SawNamespace = false;
+      break;
+    case tok::l_paren:
+    case tok::l_square:
+      Brackets.push_back(false);
+      SawNamespace = false;
+      break;
+    case tok::r_paren:
+    case tok::r_brace:
+    case tok::r_square:
+      if (!Brackets.empty())
+        Brackets.pop_back();
+      break;
+    case tok::semi:
+    case tok::equal:
+      SawNamespace = false;
+      break;
+    default:
+      break;
+    }
+  }
+  return Restart;
+}
+
 static StringRef commentMarker(llvm::StringRef Line) {
   for (StringRef Marker : {"///", "//"}){
     auto I = Line.rfind(Marker);
@@ -294,36 +393,50 @@ formatIncremental(llvm::StringRef OriginalCode, unsigned OriginalCursor,
   for (tooling::Range &R : Incremental.FormatRanges)
     FormatLimit = std::max(FormatLimit, R.getOffset() + R.getLength());
   CodeToFormat.resize(FormatLimit);
-  // 3) Insert a placeholder for the cursor.
-  CodeToFormat.insert(Cursor, Incremental.CursorPlaceholder);
-  // 4) Append brackets after FormatLimit so the code is well-formed.
+  // 3) Drop code before the last point where formatting can restart, it is
+  //    not going to change.
+  unsigned FormatStart = Cursor;
+  for (tooling::Range &R : Incremental.FormatRanges)
+    FormatStart = std::min(FormatStart, R.getOffset());
+  unsigned RestartOffset = findRestartOffset(CodeToFormat, FormatStart, Style);
+  unsigned RestartLine =
+      llvm::StringRef(CodeToFormat).take_front(RestartOffset).count('\n');
+  CodeToFormat.erase(0, RestartOffset);
+  // 4) Insert a placeholder for the cursor.
+  CodeToFormat.insert(Cursor - RestartOffset, Incremental.CursorPlaceholder);
+  // 5) Append brackets after FormatLimit so the code is well-formed.
   closeBrackets(CodeToFormat, Style);
 
-  // Determine the ranges to format:
-  std::vector<tooling::Range> RangesToFormat = Incremental.FormatRanges;
-  // Ranges after the cursor need to be adjusted for the placeholder.
-  for (auto &R : RangesToFormat) {
+  // Determine the ranges to format, relative to CodeToFormat:
+  std::vector<tooling::Range> RangesToFormat;
+  for (const tooling::Range &R : Incremental.FormatRanges) {
+    unsigned Offset = R.getOffset() - RestartOffset;
+    // Ranges after the cursor need to be adjusted for the placeholder.
     if (R.getOffset() > Cursor)
-      R = tooling::Range(R.getOffset() + Incremental.CursorPlaceholder.size(),
-                         R.getLength());
+      Offset += Incremental.CursorPlaceholder.size();
+    RangesToFormat.push_back(tooling::Range(Offset, R.getLength()));
   }
   // We also format the cursor.
-  RangesToFormat.push_back(
-      tooling::Range(Cursor, Incremental.CursorPlaceholder.size()));
+  RangesToFormat.push_back(tooling::Range(
+      Cursor - RestartOffset, Incremental.CursorPlaceholder.size()));
   // Also update FormatLimit for the placeholder, we'll use this later.
-  FormatLimit += Incremental.CursorPlaceholder.size();
+  FormatLimit =
+      FormatLimit - RestartOffset + Incremental.CursorPlaceholder.size();
 
-  // Run clang-format, and truncate changes at FormatLimit.
+  // Run clang-format, and truncate changes at FormatLimit. The changes are
+  // shifted back to apply to the code before step 3.
   tooling::Replacements FormattingChanges;
   format::FormattingAttemptStatus Status;
   for (const tooling::Replacement &R : format::reformat(
            Style, CodeToFormat, RangesToFormat, Filename, &Status)) {
     if (R.getOffset() + R.getLength() <= FormatLimit) // Before limit.
-      cantFail(FormattingChanges.add(R));
+      cantFail(FormattingChanges.add(
+          tooling::Replacement(Filename, R.getOffset() + RestartOffset,
+                               R.getLength(), R.getReplacementText())));
     else if(R.getOffset() < FormatLimit) { // Overlaps limit.
       if (R.getReplacementText().empty()) // Deletions are easy to handle.
         cantFail(FormattingChanges.add(tooling::Replacement(Filename,
-            R.getOffset(), FormatLimit - R.getOffset(), "")));
+            R.getOffset() + RestartOffset, FormatLimit - R.getOffset(), "")));
       else
         // Hopefully won't happen in practice?
         elog("Incremental clang-format edit overlapping cursor @ {0}!\n{1}",
@@ -331,7 +444,8 @@ formatIncremental(llvm::StringRef OriginalCode, unsigned OriginalCursor,
     }
   }
   if (!Status.FormatComplete)
-    vlog("Incremental format incomplete at line {0}", Status.Line);
+    vlog("Incremental format incomplete at line {0}",
+         RestartLine + Status.Line);
 
   // Now we are ready to compose the changes relative to OriginalCode.
   //   edits -> insert placeholder -> format -> remove placeholder.
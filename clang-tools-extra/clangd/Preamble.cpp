@@ -10,6 +10,7 @@
 #include "Compiler.h"
 #include "Config.h"
 #include "Headers.h"
+#include "PreambleCache.h"
 #include "SourceCode.h"
 #include "support/Logger.h"
 #include "support/ThreadsafeFS.h"
@@ -39,6 +40,7 @@
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/LockFileManager.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/VirtualFileSystem.h"
@@ -460,6 +462,76 @@ private:
   WallTimer Timer;
 };
 
+// Restores a preamble from the preamble cache. Only the PCH is cached, the
+// rest of PreambleData is recomputed by running the preprocessor over the
+// preamble section, which is much cheaper than parsing it.
+std::shared_ptr<const PreambleData> loadCachedPreamble(
+    const PreambleCache &Cache, llvm::StringRef Key, PathRef FileName,
+    const CompilerInvocation &CI, const ParseInputs &Inputs,
+    const llvm::MemoryBuffer &ContentsBuffer, PreambleBounds Bounds,
+    bool StoreInMemory,
+    std::function<void(CompilerInstance &)> BeforeExecuteCallback) {
+  auto VFS = Inputs.TFS->view(Inputs.CompileCommand.Directory);
+  llvm::SmallString<32> AbsFileName(FileName);
+  VFS->makeAbsolute(AbsFileName);
+  auto StatCache = std::make_unique<PreambleFileStatusCache>(AbsFileName);
+  auto StatCacheFS = StatCache->getProducingFS(VFS);
+
+  auto Preamble =
+      Cache.load(Key, CI, ContentsBuffer, *StatCacheFS, StoreInMemory);
+  if (!Preamble)
+    return nullptr;
+
+  trace::Span Tracer("ScanCachedPreamble");
+  // The preamble callback needs an AST, so it doesn't run for cached
+  // preambles.
+  CppFilePreambleCallbacks CapturedInfo(
+      FileName, /*ParsedCallback=*/nullptr, /*Stats=*/nullptr,
+      Inputs.Opts.PreambleParseForwardingFunctions,
+      std::move(BeforeExecuteCallback));
+  IgnoringDiagConsumer IgnoreDiags;
+  auto PPInvocation = std::make_unique<CompilerInvocation>(CI);
+  // Preprocess the preamble section exactly like the preamble build did.
+  PPInvocation->getPreprocessorOpts().GeneratePreamble = true;
+  auto Clang = prepareCompilerInstance(
+      std::move(PPInvocation), nullptr,
+      llvm::MemoryBuffer::getMemBufferCopy(
+          ContentsBuffer.getBuffer().take_front(Bounds.Size), FileName),
+      StatCacheFS, IgnoreDiags);
+  if (!Clang || Clang->getFrontendOpts().Inputs.empty())
+    return nullptr;
+  PreprocessOnlyAction Action;
+  if (!Action.BeginSourceFile(*Clang, Clang->getFrontendOpts().Inputs[0]))
+    return nullptr;
+  CapturedInfo.BeforeExecute(*Clang);
+  Preprocessor &PP = Clang->getPreprocessor();
+  PP.addPPCallbacks(CapturedInfo.createPPCallbacks());
+  if (CommentHandler *Handler = CapturedInfo.getCommentHandler())
+    PP.addCommentHandler(Handler);
+  if (llvm::Error Err = Action.Execute()) {
+    elog("Failed to scan cached preamble for {0}: {1}", FileName,
+         std::move(Err));
+    return nullptr;
+  }
+  CapturedInfo.AfterExecute(*Clang);
+  Action.EndSourceFile();
+
+  log("Loaded cached preamble of size {0} for file {1} version {2}",
+      Preamble->getSize(), FileName, Inputs.Version);
+  auto Result = std::make_shared<PreambleData>(std::move(*Preamble));
+  Result->Version = Inputs.Version;
+  Result->CompileCommand = Inputs.CompileCommand;
+  Result->Invocation = std::make_shared<const CompilerInvocation>(CI);
+  // Only preambles without diagnostics are cached, see buildPreamble().
+  Result->Includes = CapturedInfo.takeIncludes();
+  Result->Macros = CapturedInfo.takeMacros();
+  Result->Marks = CapturedInfo.takeMarks();
+  Result->CanonIncludes = CapturedInfo.takeCanonicalIncludes();
+  Result->StatCache = std::move(StatCache);
+  Result->MainIsIncludeGuarded = CapturedInfo.isMainFileIncludeGuarded();
+  return Result;
+}
+
 } // namespace
 
 std::shared_ptr<const PreambleData>
@@ -511,6 +583,44 @@ buildPreamble(PathRef FileName, CompilerInvocation CI,
     return DiagLevel;
   });
 
+  auto BeforeExecuteCallback = [&ASTListeners](CompilerInstance &CI) {
+    for (const auto &L : ASTListeners)
+      L->beforeExecute(CI);
+  };
+
+  // Another clangd sharing the cache directory may have built this preamble
+  // already, or may be building it right now.
+  llvm::Optional<PreambleCache> Cache;
+  std::string CacheKey;
+  std::unique_ptr<llvm::LockFileManager> CacheLock;
+  if (!Inputs.Opts.PreambleCacheDir.empty()) {
+    Cache.emplace(Inputs.Opts.PreambleCacheDir);
+    CacheKey = PreambleCache::computeKey(
+        Inputs.CompileCommand,
+        llvm::StringRef(Inputs.Contents).take_front(Bounds.Size));
+    auto LoadCached = [&] {
+      WallTimer LoadTimer;
+      LoadTimer.startTimer();
+      auto Cached = loadCachedPreamble(*Cache, CacheKey, FileName, CI, Inputs,
+                                       *ContentsBuffer, Bounds, StoreInMemory,
+                                       BeforeExecuteCallback);
+      LoadTimer.stopTimer();
+      if (Cached && Stats) {
+        Stats->TotalBuildTime = LoadTimer.getTime();
+        Stats->FileSystemTime = 0;
+        Stats->BuildSize = 0;
+        Stats->SerializedSize = Cached->Preamble.getSize();
+      }
+      return Cached;
+    };
+    if (auto Cached = LoadCached())
+      return Cached;
+    CacheLock = Cache->lock(CacheKey);
+    if (auto Cached = LoadCached())
+      return Cached;
+  }
+
+  auto Invocation = std::make_shared<const CompilerInvocation>(CI);
   // Skip function bodies when building the preamble to speed up building
   // the preamble and make it smaller.
   assert(!CI.getFrontendOpts().SkipFunctionBodies);
@@ -521,11 +631,7 @@ buildPreamble(PathRef FileName, CompilerInvocation CI,
 
   CppFilePreambleCallbacks CapturedInfo(
       FileName, PreambleCallback, Stats,
-      Inputs.Opts.PreambleParseForwardingFunctions,
-      [&ASTListeners](CompilerInstance &CI) {
-        for (const auto &L : ASTListeners)
-          L->beforeExecute(CI);
-      });
+      Inputs.Opts.PreambleParseForwardingFunctions, BeforeExecuteCallback);
   auto VFS = Inputs.TFS->view(Inputs.CompileCommand.Directory);
   llvm::SmallString<32> AbsFileName(FileName);
   VFS->makeAbsolute(AbsFileName);
@@ -559,6 +665,7 @@ buildPreamble(PathRef FileName, CompilerInvocation CI,
     auto Result = std::make_shared<PreambleData>(std::move(*BuiltPreamble));
     Result->Version = Inputs.Version;
     Result->CompileCommand = Inputs.CompileCommand;
+    Result->Invocation = std::move(Invocation);
     Result->Diags = std::move(Diags);
     Result->Includes = CapturedInfo.takeIncludes();
     Result->Macros = CapturedInfo.takeMacros();
@@ -566,6 +673,12 @@ buildPreamble(PathRef FileName, CompilerInvocation CI,
     Result->CanonIncludes = CapturedInfo.takeCanonicalIncludes();
     Result->StatCache = std::move(StatCache);
     Result->MainIsIncludeGuarded = CapturedInfo.isMainFileIncludeGuarded();
+    // Diagnostics are not part of the cache entry, so preambles that have
+    // any are not shared. The first header is the main file, its preamble
+    // section is already part of the key.
+    if (Cache && Result->Diags.empty())
+      Cache->store(CacheKey, Result->Preamble,
+                   Result->Includes.allHeaders().drop_front(), *VFS);
     return Result;
   }
 
@@ -52,6 +52,10 @@ struct PreambleData {
   // Version of the ParseInputs this preamble was built from.
   std::string Version;
   tooling::CompileCommand CompileCommand;
+  // The invocation built from CompileCommand, before any preamble-specific
+  // adjustments. Code completion copies it rather than running the driver
+  // again on every request. May be null.
+  std::shared_ptr<const CompilerInvocation> Invocation;
   PrecompiledPreamble Preamble;
   std::vector<Diag> Diags;
   // Processes like code completions and go-to-definitions will need #include
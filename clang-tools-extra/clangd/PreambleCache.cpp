@@ -0,0 +1,198 @@
+//===--- PreambleCache.cpp - Preambles shared across clangd instances -----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "PreambleCache.h"
+#include "SourceCode.h"
+#include "support/Logger.h"
+#include "support/Trace.h"
+#include "clang/Basic/Version.h"
+#include "clang/Frontend/CompilerInvocation.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/FileUtilities.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SHA1.h"
+#include "llvm/Support/raw_ostream.h"
+
+namespace clang {
+namespace clangd {
+namespace {
+
+// Bump this whenever the entry layout changes.
+constexpr llvm::StringLiteral EntryMagic = "CLANGDPC1";
+
+// How long to wait for another clangd to build the same preamble.
+constexpr unsigned LockTimeoutSeconds = 10 * 60;
+
+} // namespace
+
+std::string PreambleCache::computeKey(const tooling::CompileCommand &Cmd,
+                                      llvm::StringRef PreambleContents) {
+  llvm::SHA1 Hasher;
+  // Separate the fields so that moving bytes between them changes the key.
+  auto Add = [&](llvm::StringRef S) {
+    Hasher.update(S);
+    Hasher.update(llvm::StringRef("\0", 1));
+  };
+  Add(EntryMagic);
+  // The PCH is not validated against the compiler that reads it.
+  Add(getClangFullRepositoryVersion());
+  // We don't hash Output, it should not matter to clangd.
+  Add(Cmd.Directory);
+  Add(Cmd.Filename);
+  for (const std::string &Arg : Cmd.CommandLine)
+    Add(Arg);
+  Add(PreambleContents);
+  return llvm::toHex(Hasher.final(), /*LowerCase=*/true);
+}
+
+std::string PreambleCache::entryPath(llvm::StringRef Key) const {
+  llvm::SmallString<128> Path(Dir);
+  llvm::sys::path::append(Path, Key + ".preamble");
+  return std::string(Path.str());
+}
+
+llvm::Optional<PrecompiledPreamble>
+PreambleCache::load(llvm::StringRef Key, const CompilerInvocation &CI,
+                    const llvm::MemoryBuffer &MainFile,
+                    llvm::vfs::FileSystem &FS, bool StoreInMemory) const {
+  trace::Span Tracer("LoadCachedPreamble");
+  auto Buffer = llvm::MemoryBuffer::getFile(entryPath(Key));
+  if (!Buffer)
+    return llvm::None;
+  llvm::StringRef Data = (*Buffer)->getBuffer();
+
+  auto Malformed = [&] {
+    elog("Malformed preamble cache entry {0}", entryPath(Key));
+    return llvm::None;
+  };
+  if (!Data.consume_front(EntryMagic) || Data.size() < sizeof(uint32_t))
+    return Malformed();
+  uint32_t NumHeaders = llvm::support::endian::read32le(Data.data());
+  Data = Data.drop_front(sizeof(uint32_t));
+
+  // Check the headers before deserializing, that copies the whole PCH.
+  for (uint32_t I = 0; I < NumHeaders; ++I) {
+    if (Data.size() < sizeof(uint32_t))
+      return Malformed();
+    uint32_t PathSize = llvm::support::endian::read32le(Data.data());
+    Data = Data.drop_front(sizeof(uint32_t));
+    FileDigest Digest;
+    if (Data.size() < PathSize + Digest.size())
+      return Malformed();
+    llvm::StringRef Path = Data.take_front(PathSize);
+    Data = Data.drop_front(PathSize);
+    std::copy_n(Data.bytes_begin(), Digest.size(), Digest.begin());
+    Data = Data.drop_front(Digest.size());
+
+    auto Contents = FS.getBufferForFile(Path);
+    if (!Contents || digest((*Contents)->getBuffer()) != Digest) {
+      vlog("Cached preamble {0} is stale: {1} changed", Key, Path);
+      return llvm::None;
+    }
+  }
+
+  auto Preamble = PrecompiledPreamble::deserialize(Data, StoreInMemory);
+  if (!Preamble) {
+    elog("Failed to load cached preamble {0}: {1}", entryPath(Key),
+         Preamble.getError().message());
+    return llvm::None;
+  }
+  // This also catches headers that the preamble looked for and didn't find,
+  // but which exist now.
+  auto Bounds = ComputePreambleBounds(*CI.getLangOpts(), MainFile, 0);
+  if (!Preamble->CanReuse(CI, MainFile, Bounds, FS)) {
+    vlog("Cached preamble {0} can't be reused", Key);
+    return llvm::None;
+  }
+  return std::move(*Preamble);
+}
+
+void PreambleCache::store(llvm::StringRef Key,
+                          const PrecompiledPreamble &Preamble,
+                          llvm::ArrayRef<std::string> Headers,
+                          llvm::vfs::FileSystem &FS) const {
+  trace::Span Tracer("StoreCachedPreamble");
+  std::vector<std::pair<llvm::StringRef, FileDigest>> Digests;
+  for (const std::string &Header : Headers) {
+    if (Header.empty())
+      continue;
+    auto Contents = FS.getBufferForFile(Header);
+    if (!Contents) {
+      vlog("Not caching preamble {0}: can't read {1}", Key, Header);
+      return;
+    }
+    Digests.emplace_back(Header, digest((*Contents)->getBuffer()));
+  }
+
+  if (std::error_code EC = llvm::sys::fs::create_directories(Dir)) {
+    elog("Failed to create preamble cache directory {0}: {1}", Dir,
+         EC.message());
+    return;
+  }
+  // Readers never see a partially written entry.
+  std::string Path = entryPath(Key);
+  llvm::Error Err = llvm::writeFileAtomically(
+      Path + ".tmp.%%%%%%%%", Path,
+      [&](llvm::raw_ostream &OS) -> llvm::Error {
+        llvm::support::endian::Writer W(OS, llvm::support::little);
+        OS << EntryMagic;
+        W.write<uint32_t>(Digests.size());
+        for (const auto &D : Digests) {
+          W.write<uint32_t>(D.first.size());
+          OS << D.first;
+          OS.write(reinterpret_cast<const char *>(D.second.data()),
+                   D.second.size());
+        }
+        if (std::error_code EC = Preamble.serialize(OS))
+          return llvm::errorCodeToError(EC);
+        return llvm::Error::success();
+      });
+  if (Err) {
+    elog("Failed to write preamble cache entry {0}: {1}", Path,
+         std::move(Err));
+    return;
+  }
+  log("Stored preamble of size {0} as {1} in the preamble cache",
+      Preamble.getSize(), Key);
+}
+
+std::unique_ptr<llvm::LockFileManager>
+PreambleCache::lock(llvm::StringRef Key) const {
+  if (std::error_code EC = llvm::sys::fs::create_directories(Dir)) {
+    elog("Failed to create preamble cache directory {0}: {1}", Dir,
+         EC.message());
+    return nullptr;
+  }
+  auto Lock = std::make_unique<llvm::LockFileManager>(entryPath(Key));
+  switch (Lock->getState()) {
+  case llvm::LockFileManager::LFS_Owned:
+    return Lock;
+  case llvm::LockFileManager::LFS_Shared: {
+    trace::Span Tracer("WaitForCachedPreamble");
+    vlog("Waiting for another clangd to build preamble {0}", Key);
+    if (Lock->waitForUnlock(LockTimeoutSeconds) ==
+        llvm::LockFileManager::Res_Timeout)
+      vlog("Timed out waiting for preamble {0}", Key);
+    return nullptr;
+  }
+  case llvm::LockFileManager::LFS_Error:
+    elog("Failed to lock preamble cache entry {0}: {1}", Key,
+         Lock->getErrorMessage());
+    return nullptr;
+  }
+  llvm_unreachable("unhandled LockFileState");
+}
+
+} // namespace clangd
+} // namespace clang
@@ -0,0 +1,77 @@
+//===--- PreambleCache.h - Preambles shared across clangd instances -*- C++-*-//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Building the preamble of a file that includes heavy headers can take
+// minutes, and every clangd process used to do it from scratch. The
+// PreambleCache keeps serialized preambles in a directory that any number of
+// clangd instances can share, so that only the first one pays for the build.
+//
+// Entries are content-addressed: the key covers the compiler version, the
+// compile command and the preamble section of the main file. Each entry also
+// records a digest of every header the preamble read, and is only used if all
+// of them still match.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_TOOLS_EXTRA_CLANGD_PREAMBLECACHE_H
+#define LLVM_CLANG_TOOLS_EXTRA_CLANGD_PREAMBLECACHE_H
+
+#include "clang/Frontend/PrecompiledPreamble.h"
+#include "clang/Tooling/CompilationDatabase.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/Optional.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/LockFileManager.h"
+#include "llvm/Support/VirtualFileSystem.h"
+#include <memory>
+#include <string>
+
+namespace clang {
+class CompilerInvocation;
+namespace clangd {
+
+class PreambleCache {
+public:
+  /// \p Dir is created on first use if it doesn't exist.
+  explicit PreambleCache(llvm::StringRef Dir) : Dir(Dir) {}
+
+  /// Returns the key of the preamble for \p PreambleContents, the first
+  /// PreambleBounds::Size bytes of the main file, compiled with \p Cmd.
+  static std::string computeKey(const tooling::CompileCommand &Cmd,
+                                llvm::StringRef PreambleContents);
+
+  /// Returns the preamble stored under \p Key, or None if there is none or
+  /// any of the files it depends on has changed in \p FS.
+  llvm::Optional<PrecompiledPreamble>
+  load(llvm::StringRef Key, const CompilerInvocation &CI,
+       const llvm::MemoryBuffer &MainFile, llvm::vfs::FileSystem &FS,
+       bool StoreInMemory) const;
+
+  /// Stores \p Preamble under \p Key. \p Headers are the files the preamble
+  /// read, their current contents in \p FS are recorded in the entry.
+  /// Failures are logged and otherwise ignored.
+  void store(llvm::StringRef Key, const PrecompiledPreamble &Preamble,
+             llvm::ArrayRef<std::string> Headers,
+             llvm::vfs::FileSystem &FS) const;
+
+  /// Used to avoid building the same preamble in several clangd instances at
+  /// once. If another instance is building the entry for \p Key, waits for it
+  /// to finish and returns null, and the caller should retry load().
+  /// Otherwise returns a lock that should be held until the entry was stored.
+  std::unique_ptr<llvm::LockFileManager> lock(llvm::StringRef Key) const;
+
+private:
+  std::string entryPath(llvm::StringRef Key) const;
+
+  std::string Dir;
+};
+
+} // namespace clangd
+} // namespace clang
+
+#endif // LLVM_CLANG_TOOLS_EXTRA_CLANGD_PREAMBLECACHE_H
@@ -0,0 +1,153 @@
+//===--- CodeCompleteBenchmark.cpp - Clangd completion benchmarks -*- C++ -*-=//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "../CodeComplete.h"
+#include "../Compiler.h"
+#include "../Preamble.h"
+#include "../Protocol.h"
+#include "../support/ThreadsafeFS.h"
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include <string>
+#include <vector>
+
+const char *SessionsFilename;
+
+namespace clang {
+namespace clangd {
+namespace {
+
+// A file that was edited in a recorded session, and the positions at which
+// completion was requested. Unless a completion carries its own contents, the
+// file is read from disk.
+struct CompletionSession {
+  std::string File;
+  tooling::CompileCommand Command;
+  std::string Contents;
+  std::vector<std::pair<std::string, Position>> Completions;
+};
+
+[[noreturn]] void fail(const llvm::Twine &Message) {
+  llvm::errs() << "Error in sessions file " << SessionsFilename << ": "
+               << Message << "\n";
+  exit(1);
+}
+
+// Reads a JSON array of sessions of the form:
+//   {"file": "/abs/path.cpp", "directory": "/abs", "command": ["clang", ...],
+//    "completions": [{"position": {"line": 3, "character": 7},
+//                     "contents": "optional draft"}, ...]}
+std::vector<CompletionSession> readSessions() {
+  auto Buffer = llvm::MemoryBuffer::getFile(SessionsFilename);
+  if (!Buffer)
+    fail(Buffer.getError().message());
+  auto JSON = llvm::json::parse(Buffer.get()->getBuffer());
+  if (!JSON)
+    fail(llvm::toString(JSON.takeError()));
+  const llvm::json::Array *Items = JSON->getAsArray();
+  if (!Items)
+    fail("top-level value is not a JSON array");
+
+  std::vector<CompletionSession> Sessions;
+  for (const llvm::json::Value &Item : *Items) {
+    const llvm::json::Object *Obj = Item.getAsObject();
+    if (!Obj)
+      fail("session is not an object");
+    CompletionSession S;
+    llvm::json::Path::Root Root("CompletionSession");
+    llvm::json::ObjectMapper O(Item, Root);
+    if (!O || !O.map("file", S.File) ||
+        !O.map("directory", S.Command.Directory) ||
+        !O.map("command", S.Command.CommandLine))
+      fail(llvm::toString(Root.getError()));
+    S.Command.Filename = S.File;
+    auto Contents = llvm::MemoryBuffer::getFile(S.File);
+    if (!Contents)
+      fail(S.File + ": " + Contents.getError().message());
+    S.Contents = Contents.get()->getBuffer().str();
+
+    if (const llvm::json::Array *Completions = Obj->getArray("completions")) {
+      for (const llvm::json::Value &C : *Completions) {
+        Position Pos;
+        std::string Draft = S.Contents;
+        llvm::json::ObjectMapper CO(C, Root);
+        if (!CO || !CO.map("position", Pos) ||
+            !CO.mapOptional("contents", Draft))
+          fail(llvm::toString(Root.getError()));
+        S.Completions.emplace_back(std::move(Draft), Pos);
+      }
+    }
+    Sessions.push_back(std::move(S));
+  }
+  return Sessions;
+}
+
+// Replays every completion request of the recorded sessions against a
+// preamble built once per file, as clangd does while the user is typing.
+static void completeSessions(benchmark::State &State) {
+  const auto Sessions = readSessions();
+  RealThreadsafeFS TFS;
+  std::vector<std::shared_ptr<const PreambleData>> Preambles;
+  for (const CompletionSession &S : Sessions) {
+    ParseInputs Inputs;
+    Inputs.CompileCommand = S.Command;
+    Inputs.TFS = &TFS;
+    Inputs.Contents = S.Contents;
+    IgnoreDiagnostics IgnoreDiags;
+    auto CI = buildCompilerInvocation(Inputs, IgnoreDiags);
+    if (!CI)
+      fail("cannot build compiler invocation for " + S.File);
+    auto Preamble = buildPreamble(S.File, *CI, Inputs,
+                                  /*StoreInMemory=*/true, nullptr);
+    if (!Preamble)
+      fail("cannot build preamble for " + S.File);
+    Preambles.push_back(std::move(Preamble));
+  }
+
+  CodeCompleteOptions Opts;
+  size_t Requests = 0;
+  for (auto _ : State) {
+    for (size_t I = 0; I < Sessions.size(); ++I) {
+      ParseInputs Inputs;
+      Inputs.CompileCommand = Sessions[I].Command;
+      Inputs.TFS = &TFS;
+      for (const auto &Completion : Sessions[I].Completions) {
+        Inputs.Contents = Completion.first;
+        benchmark::DoNotOptimize(codeComplete(
+            Sessions[I].File, Completion.second, Preambles[I].get(), Inputs,
+            Opts));
+        ++Requests;
+      }
+    }
+  }
+  State.counters["Requests"] =
+      benchmark::Counter(Requests, benchmark::Counter::kIsRate);
+}
+BENCHMARK(completeSessions)->Unit(benchmark::kMillisecond);
+
+} // namespace
+} // namespace clangd
+} // namespace clang
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    llvm::errs() << "Usage: " << argv[0]
+                 << " completion-sessions.json BENCHMARK_OPTIONS...\n";
+    return -1;
+  }
+  SessionsFilename = argv[1];
+  // Trim the first argument of the benchmark invocation and pretend no
+  // arguments were passed in the first place.
+  argv[1] = argv[0];
+  argv += 1;
+  argc -= 1;
+  ::benchmark::Initialize(&argc, argv);
+  ::benchmark::RunSpecifiedBenchmarks();
+}
@@ -0,0 +1,86 @@
+//===--- PostingListBenchmark.cpp - Dex posting list benchmarks -*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "../index/dex/Iterator.h"
+#include "../index/dex/PostingList.h"
+#include "benchmark/benchmark.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace clang {
+namespace clangd {
+namespace dex {
+namespace {
+
+// Sorted DocIDs from [0, Universe), each present with probability 1/Stride.
+std::vector<DocID> generateDocs(DocID Universe, unsigned Stride,
+                                unsigned Seed) {
+  std::mt19937 Generator(Seed);
+  std::uniform_int_distribution<unsigned> Coin(1, Stride);
+  std::vector<DocID> Docs;
+  for (DocID D = 0; D < Universe; ++D)
+    if (Coin(Generator) == 1)
+      Docs.push_back(D);
+  return Docs;
+}
+
+// Decompressed chunks of a posting list, paired with an ID to search for in
+// each of them.
+std::vector<std::pair<std::vector<DocID>, DocID>> generateSearches() {
+  std::mt19937 Generator(42);
+  std::vector<std::pair<std::vector<DocID>, DocID>> Searches;
+  std::vector<DocID> Docs = generateDocs(1 << 20, 8, 42);
+  for (const Chunk &C : PostingList(Docs).chunks()) {
+    auto Decompressed = C.decompress();
+    std::uniform_int_distribution<DocID> Needle(Decompressed.front(),
+                                                Decompressed.back());
+    Searches.emplace_back(
+        std::vector<DocID>(Decompressed.begin(), Decompressed.end()),
+        Needle(Generator));
+  }
+  return Searches;
+}
+
+template <size_t (*CountLessThan)(llvm::ArrayRef<DocID>, DocID)>
+void searchChunk(benchmark::State &State) {
+  const auto Searches = generateSearches();
+  for (auto _ : State)
+    for (const auto &S : Searches)
+      benchmark::DoNotOptimize(CountLessThan(S.first, S.second));
+  State.SetItemsProcessed(State.iterations() * Searches.size());
+}
+static void searchChunkSIMD(benchmark::State &State) {
+  searchChunk<countLessThan>(State);
+}
+BENCHMARK(searchChunkSIMD);
+static void searchChunkScalar(benchmark::State &State) {
+  searchChunk<countLessThanScalar>(State);
+}
+BENCHMARK(searchChunkScalar);
+
+// Intersects a dense list with one that has 1/Stride of its density, as a
+// trigram AND tree does with a common and a rare trigram.
+static void intersect(benchmark::State &State) {
+  constexpr DocID Universe = 1 << 20;
+  const PostingList Dense(generateDocs(Universe, 4, 1));
+  const PostingList Sparse(generateDocs(Universe, 4 * State.range(0), 2));
+  Corpus C(Universe);
+  for (auto _ : State) {
+    auto Root = C.intersect(Dense.iterator(), Sparse.iterator());
+    benchmark::DoNotOptimize(consume(*Root));
+  }
+}
+BENCHMARK(intersect)->RangeMultiplier(8)->Range(1, 1 << 9);
+
+} // namespace
+} // namespace dex
+} // namespace clangd
+} // namespace clang
+
+BENCHMARK_MAIN();
@@ -36,6 +36,7 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Threading.h"
@@ -397,21 +398,48 @@ BackgroundIndex::loadProject(std::vector<std::string> MainFiles) {
   Rebuilder.doneLoading();
 
   auto FS = TFS.view(/*CWD=*/llvm::None);
-  llvm::DenseSet<PathRef> TUsToIndex;
-  // We'll accept data from stale shards, but ensure the files get reindexed
-  // soon.
+  llvm::StringMap<const LoadedShard *> ShardsByPath;
+  std::vector<const LoadedShard *> StaleShards;
   for (auto &LS : Result) {
-    if (!shardIsStale(LS, FS.get()))
-      continue;
-    PathRef TUForFile = LS.DependentTU;
-    assert(!TUForFile.empty() && "File without a TU!");
+    ShardsByPath[LS.AbsolutePath] = &LS;
+    // We'll accept data from stale shards, but ensure the files get reindexed
+    // soon.
+    if (shardIsStale(LS, FS.get()))
+      StaleShards.push_back(&LS);
+  }
 
-    // FIXME: Currently, we simply schedule indexing on a TU whenever any of
-    // its dependencies needs re-indexing. We might do it smarter by figuring
-    // out a minimal set of TUs that will cover all the stale dependencies.
+  // A header only needs to be reindexed through one of the TUs including it.
+  // Schedule the TUs that changed themselves first, then add a TU for each
+  // stale header that none of the scheduled TUs reaches.
+  llvm::DenseSet<PathRef> TUsToIndex;
+  llvm::StringSet<> Covered;
+  auto Schedule = [&](PathRef TU) {
+    if (!TUsToIndex.insert(TU).second)
+      return;
+    std::vector<PathRef> ToVisit = {TU};
+    while (!ToVisit.empty()) {
+      PathRef File = ToVisit.back();
+      ToVisit.pop_back();
+      if (!Covered.insert(File).second)
+        continue;
+      auto It = ShardsByPath.find(File);
+      if (It != ShardsByPath.end())
+        for (const Path &Include : It->getValue()->DirectIncludes)
+          ToVisit.push_back(Include);
+    }
+  };
+  for (const LoadedShard *LS : StaleShards)
+    if (LS->AbsolutePath == LS->DependentTU)
+      Schedule(LS->DependentTU);
+  for (const LoadedShard *LS : StaleShards) {
+    if (Covered.count(LS->AbsolutePath))
+      continue;
+    assert(!LS->DependentTU.empty() && "File without a TU!");
+    // FIXME: Prefer the includer that is cheapest to parse, rather than the
+    // first one that reached this file.
     // FIXME: Try looking at other TUs if no compile commands are available
     // for this TU, i.e TU was deleted after we performed indexing.
-    TUsToIndex.insert(TUForFile);
+    Schedule(LS->DependentTU);
   }
 
   return {TUsToIndex.begin(), TUsToIndex.end()};
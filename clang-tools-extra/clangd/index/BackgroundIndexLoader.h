@@ -32,6 +32,9 @@ struct LoadedShard {
   bool HadErrors = false;
   /// Path to a TU that is depending on this shard.
   Path DependentTU;
+  /// Absolute paths of the files directly included by this file, as recorded
+  /// in the shard.
+  std::vector<Path> DirectIncludes;
   /// Will be nullptr when index storage couldn't provide a valid shard for
   /// AbsolutePath.
   std::unique_ptr<IndexFileIn> Shard;
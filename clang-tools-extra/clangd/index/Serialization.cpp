@@ -21,8 +21,12 @@
 #include "llvm/Support/Compression.h"
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/Error.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/SwapByteOrder.h"
 #include "llvm/Support/raw_ostream.h"
 #include <cstdint>
+#include <tuple>
 #include <vector>
 
 namespace clang {
@@ -443,6 +447,93 @@ readCompileCommand(Reader CmdReader, llvm::ArrayRef<llvm::StringRef> Strings) {
   return Cmd;
 }
 
+// DEX INDEX ENCODING
+// The posting lists of a Dex are stored in the form it queries them:
+//   - NumSymbols : uint32
+//   - SymbolIDs  : raw SymbolID[NumSymbols], in DocID order
+//   - NumLists   : varint
+//   - Lists      : (TokenKind : uint8, TokenData : string, NumChunks : varint)
+//                  [NumLists]
+//   - Padding    : zero bytes, to align the chunks in the file
+//   - Chunks     : dex::Chunk[sum of NumChunks], Head little-endian
+// In a file that is little-endian and aligned in memory, the chunks are used
+// in place. Otherwise they are not read, and Dex builds its own.
+
+using TokenKind = dex::Token::Kind;
+
+void writeDexIndex(
+    const dex::Dex &Index,
+    llvm::ArrayRef<std::tuple<TokenKind, llvm::StringRef,
+                              llvm::ArrayRef<dex::Chunk>>>
+        Lists,
+    const StringTableOut &Strings, size_t FileOffset, llvm::raw_ostream &OS) {
+  write32(Index.symbols().size(), OS);
+  for (const Symbol *Sym : Index.symbols())
+    OS << Sym->ID.raw();
+  writeVar(Lists.size(), OS);
+  for (const auto &List : Lists) {
+    OS.write(static_cast<uint8_t>(std::get<0>(List)));
+    writeVar(Strings.index(std::get<1>(List)), OS);
+    writeVar(std::get<2>(List).size(), OS);
+  }
+  size_t Offset = FileOffset + OS.tell();
+  OS.write_zeros(llvm::alignTo(Offset, alignof(dex::Chunk)) - Offset);
+  for (const auto &List : Lists)
+    for (const dex::Chunk &C : std::get<2>(List)) {
+      write32(C.Head, OS);
+      OS.write(reinterpret_cast<const char *>(C.Payload.data()),
+               C.Payload.size());
+    }
+}
+
+llvm::Expected<llvm::Optional<dex::PrecomputedIndex>>
+readDexIndex(llvm::StringRef Data, llvm::ArrayRef<llvm::StringRef> Strings) {
+  Reader DexReader(Data);
+  dex::PrecomputedIndex Result;
+  uint32_t NumSymbols = DexReader.consume32();
+  if (NumSymbols > DexReader.rest().size() / SymbolID::RawSize)
+    return error("malformed or truncated dex index");
+  Result.SymbolIDs = DexReader.consume(NumSymbols * SymbolID::RawSize);
+
+  uint32_t NumLists = DexReader.consumeVar();
+  // Each list takes at least three bytes.
+  if (NumLists > DexReader.rest().size() / 3)
+    return error("malformed or truncated dex index");
+  std::vector<std::pair<dex::Token, uint32_t>> Lists;
+  Lists.reserve(NumLists);
+  uint64_t NumChunks = 0;
+  for (uint32_t I = 0; I < NumLists && !DexReader.err(); ++I) {
+    uint8_t Kind = DexReader.consume8();
+    llvm::StringRef TokenData = DexReader.consumeString(Strings);
+    uint32_t Size = DexReader.consumeVar();
+    if (Kind > static_cast<uint8_t>(TokenKind::Sentinel))
+      return error("malformed dex index: bad token kind {0}", Kind);
+    Lists.emplace_back(dex::Token(static_cast<TokenKind>(Kind), TokenData),
+                       Size);
+    NumChunks += Size;
+  }
+  llvm::StringRef Rest = DexReader.rest();
+  if (DexReader.err() || Rest.size() < NumChunks * sizeof(dex::Chunk) ||
+      Rest.size() - NumChunks * sizeof(dex::Chunk) >= alignof(dex::Chunk))
+    return error("malformed or truncated dex index");
+
+  const char *Chunks = Rest.end() - NumChunks * sizeof(dex::Chunk);
+  if (llvm::sys::IsBigEndianHost ||
+      reinterpret_cast<uintptr_t>(Chunks) % alignof(dex::Chunk)) {
+    vlog("Dex index can't be used in place, ignoring it");
+    return llvm::None;
+  }
+  Result.PostingLists.reserve(Lists.size());
+  for (auto &List : Lists) {
+    Result.PostingLists.emplace_back(
+        std::move(List.first),
+        llvm::makeArrayRef(reinterpret_cast<const dex::Chunk *>(Chunks),
+                           List.second));
+    Chunks += List.second * sizeof(dex::Chunk);
+  }
+  return std::move(Result);
+}
+
 // FILE ENCODING
 // A file is a RIFF chunk with type 'CdIx'.
 // It contains the sections:
@@ -451,6 +542,8 @@ readCompileCommand(Reader CmdReader, llvm::ArrayRef<llvm::StringRef> Strings) {
 //   - stri: string table
 //   - symb: symbols
 //   - refs: references to symbols
+//   - dex : optional Dex posting lists, written last so that their chunks can
+//           be aligned in the file and used in place when it is mapped.
 
 // The current versioning scheme is simple - non-current versions are rejected.
 // If you make a breaking change, bump this version number to invalidate stored
@@ -533,6 +626,12 @@ llvm::Expected<IndexFileIn> readRIFF(llvm::StringRef Data,
       return error("malformed or truncated relations");
     Result.Relations = std::move(Relations).build();
   }
+  if (Chunks.count("dex ")) {
+    auto DexIndex = readDexIndex(Chunks.lookup("dex "), Strings->Strings);
+    if (!DexIndex)
+      return DexIndex.takeError();
+    Result.DexIndex = std::move(*DexIndex);
+  }
   if (Chunks.count("cmdl")) {
     Reader CmdReader(Chunks.lookup("cmdl"));
     InternedCompileCommand Cmd =
@@ -613,6 +712,26 @@ void writeRIFF(const IndexFileOut &Data, llvm::raw_ostream &OS) {
     }
   }
 
+  // The token data must be interned before the string table is finalized.
+  llvm::Optional<dex::Dex> Index;
+  std::vector<
+      std::tuple<TokenKind, llvm::StringRef, llvm::ArrayRef<dex::Chunk>>>
+      PostingLists;
+  if (Data.DexIndex) {
+    Index.emplace(*Data.Symbols, RefSlab(), RelationSlab());
+    for (const auto &TokenAndList : Index->postingLists())
+      PostingLists.emplace_back(TokenAndList.first.kind(),
+                                TokenAndList.first.data(),
+                                TokenAndList.second.chunks());
+    // DenseMap order depends on the hash seed, sort for reproducible output.
+    llvm::sort(PostingLists, [](const auto &L, const auto &R) {
+      return std::tie(std::get<0>(L), std::get<1>(L)) <
+             std::tie(std::get<0>(R), std::get<1>(R));
+    });
+    for (auto &List : PostingLists)
+      Strings.intern(std::get<1>(List));
+  }
+
   std::string StringSection;
   {
     llvm::raw_string_ostream StringOS(StringSection);
@@ -667,6 +786,21 @@ void writeRIFF(const IndexFileOut &Data, llvm::raw_ostream &OS) {
     RIFF.Chunks.push_back({riff::fourCC("cmdl"), CmdlSection});
   }
 
+  std::string DexSection;
+  if (Data.DexIndex) {
+    // Offset of the section data in the file: the RIFF header and file type,
+    // the preceding chunks, and the header of this chunk.
+    size_t Offset = 12;
+    for (const auto &C : RIFF.Chunks)
+      Offset += 8 + C.Data.size() + C.Data.size() % 2;
+    Offset += 8;
+    {
+      llvm::raw_string_ostream DexOS(DexSection);
+      writeDexIndex(*Index, PostingLists, Strings, Offset, DexOS);
+    }
+    RIFF.Chunks.push_back({riff::fourCC("dex "), DexSection});
+  }
+
   OS << RIFF;
 }
 
@@ -713,6 +847,7 @@ std::unique_ptr<SymbolIndex> loadIndex(llvm::StringRef SymbolFilename,
   SymbolSlab Symbols;
   RefSlab Refs;
   RelationSlab Relations;
+  llvm::Optional<dex::PrecomputedIndex> DexIndex;
   {
     trace::Span Tracer("ParseIndex");
     if (auto I = readIndexFile(Buffer->get()->getBuffer(), Origin)) {
@@ -722,6 +857,7 @@ std::unique_ptr<SymbolIndex> loadIndex(llvm::StringRef SymbolFilename,
         Refs = std::move(*I->Refs);
       if (I->Relations)
         Relations = std::move(*I->Relations);
+      DexIndex = std::move(I->DexIndex);
     } else {
       elog("Bad index file: {0}", I.takeError());
       return nullptr;
@@ -733,10 +869,22 @@ std::unique_ptr<SymbolIndex> loadIndex(llvm::StringRef SymbolFilename,
   size_t NumRelations = Relations.size();
 
   trace::Span Tracer("BuildIndex");
-  auto Index = UseDex ? dex::Dex::build(std::move(Symbols), std::move(Refs),
-                                        std::move(Relations))
-                      : MemIndex::build(std::move(Symbols), std::move(Refs),
-                                        std::move(Relations));
+  std::unique_ptr<SymbolIndex> Index;
+  if (UseDex && DexIndex) {
+    // The posting lists point into the buffer, which is usually mapped.
+    std::shared_ptr<llvm::MemoryBuffer> Storage = std::move(*Buffer);
+    Index = dex::Dex::build(std::move(Symbols), std::move(Refs),
+                            std::move(Relations), *DexIndex, Storage);
+    if (!Index) {
+      elog("Bad index file: dex index doesn't match the symbols");
+      return nullptr;
+    }
+  } else {
+    Index = UseDex ? dex::Dex::build(std::move(Symbols), std::move(Refs),
+                                     std::move(Relations))
+                   : MemIndex::build(std::move(Symbols), std::move(Refs),
+                                     std::move(Relations));
+  }
   vlog("Loaded {0} from {1} with estimated memory usage {2} bytes\n"
        "  - number of symbols: {3}\n"
        "  - number of refs: {4}\n"
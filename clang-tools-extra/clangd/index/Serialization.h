@@ -27,6 +27,7 @@
 #include "Headers.h"
 #include "index/Index.h"
 #include "index/Symbol.h"
+#include "index/dex/Dex.h"
 #include "clang/Tooling/CompilationDatabase.h"
 #include "llvm/Support/Error.h"
 
@@ -47,6 +48,9 @@ struct IndexFileIn {
   llvm::Optional<IncludeGraph> Sources;
   // This contains only the Directory and CommandLine.
   llvm::Optional<tooling::CompileCommand> Cmd;
+  // Posting lists of a Dex over Symbols. They refer to the data that was read
+  // rather than copying it.
+  llvm::Optional<dex::PrecomputedIndex> DexIndex;
 };
 // Parse an index file. The input must be a RIFF or YAML file.
 llvm::Expected<IndexFileIn> readIndexFile(llvm::StringRef, SymbolOrigin);
@@ -58,7 +62,9 @@ struct IndexFileOut {
   const RelationSlab *Relations = nullptr;
   // Keys are URIs of the source files.
   const IncludeGraph *Sources = nullptr;
-  // TODO: Support serializing Dex posting lists.
+  // Also write the posting lists of a Dex over Symbols, so that loadIndex()
+  // can use them in place instead of building them. Only supported for RIFF.
+  bool DexIndex = false;
   IndexFileFormat Format = IndexFileFormat::RIFF;
   const tooling::CompileCommand *Cmd = nullptr;
 
@@ -24,6 +24,7 @@
 #include "llvm/Support/ScopedPrinter.h"
 #include <algorithm>
 #include <queue>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -41,6 +42,36 @@ std::unique_ptr<SymbolIndex> Dex::build(SymbolSlab Symbols, RefSlab Refs,
                                 Size);
 }
 
+std::unique_ptr<SymbolIndex> Dex::build(SymbolSlab Symbols, RefSlab Refs,
+                                        RelationSlab Rels,
+                                        const PrecomputedIndex &Index,
+                                        std::shared_ptr<void> IndexStorage) {
+  if (Index.SymbolIDs.size() != Symbols.size() * SymbolID::RawSize)
+    return nullptr;
+  std::vector<const Symbol *> Ordered;
+  Ordered.reserve(Symbols.size());
+  for (size_t I = 0; I < Index.SymbolIDs.size(); I += SymbolID::RawSize) {
+    auto It = Symbols.find(
+        SymbolID::fromRaw(Index.SymbolIDs.substr(I, SymbolID::RawSize)));
+    if (It == Symbols.end())
+      return nullptr;
+    Ordered.push_back(&*It);
+  }
+  auto Size = Symbols.bytes() + Refs.bytes();
+  // Counted although the pages of a mapped file are shared.
+  for (const auto &TokenAndChunks : Index.PostingLists)
+    Size += TokenAndChunks.second.size() * sizeof(Chunk);
+
+  auto Data = std::make_tuple(std::move(Symbols), std::move(Refs),
+                              std::move(IndexStorage));
+  // Symbols are added by adoptIndex(), this doesn't build posting lists.
+  auto Result = std::make_unique<Dex>(llvm::ArrayRef<Symbol>(),
+                                      std::get<1>(Data), Rels,
+                                      std::move(Data), Size);
+  Result->adoptIndex(std::move(Ordered), Index);
+  return Result;
+}
+
 namespace {
 
 // Mark symbols which are can be used for code completion.
@@ -148,6 +179,22 @@ void Dex::buildIndex() {
   InvertedIndex = std::move(Builder).build();
 }
 
+void Dex::adoptIndex(std::vector<const Symbol *> Symbols,
+                     const PrecomputedIndex &Index) {
+  this->Symbols = std::move(Symbols);
+  this->Corpus = dex::Corpus(this->Symbols.size());
+  SymbolQuality.resize(this->Symbols.size());
+  for (size_t I = 0; I < this->Symbols.size(); ++I) {
+    const Symbol *Sym = this->Symbols[I];
+    LookupTable[Sym->ID] = Sym;
+    SymbolQuality[I] = quality(*Sym);
+  }
+  InvertedIndex.reserve(Index.PostingLists.size());
+  for (const auto &TokenAndChunks : Index.PostingLists)
+    InvertedIndex.try_emplace(TokenAndChunks.first,
+                              PostingList::fromChunks(TokenAndChunks.second));
+}
+
 std::unique_ptr<Iterator> Dex::iterator(const Token &Tok) const {
   auto It = InvertedIndex.find(Tok);
   return It == InvertedIndex.end() ? Corpus.none()
@@ -266,6 +313,10 @@ bool Dex::fuzzyFind(const FuzzyFindRequest &Req,
       Req.Limit ? *Req.Limit : std::numeric_limits<size_t>::max(), Compare);
   for (const auto &IDAndScore : IDAndScores) {
     const DocID SymbolDocID = IDAndScore.first;
+    // Adopted posting lists are not validated upfront, as that would page in
+    // all of them. A corrupt list must not make us read past the symbols.
+    if (LLVM_UNLIKELY(SymbolDocID >= Symbols.size()))
+      continue;
     const auto *Sym = Symbols[SymbolDocID];
     const llvm::Optional<float> Score = Filter.match(Sym->Name);
     if (!Score)
@@ -31,6 +31,15 @@ namespace clang {
 namespace clangd {
 namespace dex {
 
+/// The inverted index of a Dex in the form it is queried in, as read from an
+/// index file. A Dex built from it for the same symbols refers to it instead
+/// of computing posting lists, so the storage must outlive the index.
+struct PrecomputedIndex {
+  /// Raw SymbolIDs of the indexed symbols, in DocID order.
+  llvm::StringRef SymbolIDs;
+  std::vector<std::pair<Token, llvm::ArrayRef<Chunk>>> PostingLists;
+};
+
 /// In-memory Dex trigram-based index implementation.
 class Dex : public SymbolIndex {
 public:
@@ -74,6 +83,14 @@ public:
 
   /// Builds an index from slabs. The index takes ownership of the slab.
   static std::unique_ptr<SymbolIndex> build(SymbolSlab, RefSlab, RelationSlab);
+  /// Builds an index from slabs, adopting the posting lists of \p Index. The
+  /// index takes ownership of the slabs and of \p IndexStorage, which should
+  /// keep the data of \p Index alive. Returns null if \p Index doesn't
+  /// describe \p Symbols.
+  static std::unique_ptr<SymbolIndex> build(SymbolSlab Symbols, RefSlab,
+                                            RelationSlab,
+                                            const PrecomputedIndex &Index,
+                                            std::shared_ptr<void> IndexStorage);
 
   bool
   fuzzyFind(const FuzzyFindRequest &Req,
@@ -94,8 +111,17 @@ public:
 
   size_t estimateMemoryUsage() const override;
 
+  /// The symbols in DocID order and the posting lists of the index, used to
+  /// serialize it.
+  llvm::ArrayRef<const Symbol *> symbols() const { return Symbols; }
+  const llvm::DenseMap<Token, PostingList> &postingLists() const {
+    return InvertedIndex;
+  }
+
 private:
   void buildIndex();
+  void adoptIndex(std::vector<const Symbol *> Symbols,
+                  const PrecomputedIndex &Index);
   std::unique_ptr<Iterator> iterator(const Token &Tok) const;
   std::unique_ptr<Iterator>
   createFileProximityIterator(llvm::ArrayRef<std::string> ProximityPaths) const;
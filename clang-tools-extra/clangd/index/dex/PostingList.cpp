@@ -11,6 +11,12 @@
 #include "index/dex/Token.h"
 #include "llvm/Support/MathExtras.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 namespace clang {
 namespace clangd {
 namespace dex {
@@ -24,7 +30,7 @@ public:
   explicit ChunkIterator(const Token *Tok, llvm::ArrayRef<Chunk> Chunks)
       : Tok(Tok), Chunks(Chunks), CurrentChunk(Chunks.begin()) {
     if (!Chunks.empty()) {
-      DecompressedChunk = CurrentChunk->decompress();
+      CurrentChunk->decompress(DecompressedChunk);
       CurrentID = DecompressedChunk.begin();
     }
   }
@@ -39,8 +45,9 @@ public:
     normalizeCursor();
   }
 
-  /// Applies binary search to advance cursor to the next item with DocID
-  /// equal or higher than the given one.
+  /// Advances cursor to the next item with DocID equal or higher than the
+  /// given one: gallops to the chunk which might contain it, then searches the
+  /// decompressed chunk.
   void advanceTo(DocID ID) override {
     assert(!reachedEnd() &&
            "Posting List iterator can't advance() at the end.");
@@ -48,8 +55,8 @@ public:
       return;
     advanceToChunk(ID);
     // Try to find ID within current chunk.
-    CurrentID = std::partition_point(CurrentID, DecompressedChunk.end(),
-                                     [&](const DocID D) { return D < ID; });
+    CurrentID += countLessThan(
+        llvm::makeArrayRef(CurrentID, DecompressedChunk.end()), ID);
     normalizeCursor();
   }
 
@@ -92,19 +99,30 @@ private:
     ++CurrentChunk;
     if (CurrentChunk == Chunks.end()) // Reached the end of PostingList.
       return;
-    DecompressedChunk = CurrentChunk->decompress();
+    CurrentChunk->decompress(DecompressedChunk);
     CurrentID = DecompressedChunk.begin();
   }
 
-  /// Advances CurrentChunk to the chunk which might contain ID.
+  /// Advances CurrentChunk to the last chunk with Head <= ID, which is the one
+  /// that might contain ID.
   void advanceToChunk(DocID ID) {
     if ((CurrentChunk != Chunks.end() - 1) &&
         ((CurrentChunk + 1)->Head <= ID)) {
+      // Inside AND iterators the target is usually close, so gallop from the
+      // current chunk rather than bisecting the rest of the list.
+      auto Low = CurrentChunk + 1; // Low->Head <= ID
+      size_t Step = 1;
+      while (Step < static_cast<size_t>(Chunks.end() - Low) &&
+             Low[Step].Head <= ID) {
+        Low += Step;
+        Step *= 2;
+      }
+      auto High = Low + std::min<size_t>(Step, Chunks.end() - Low);
       CurrentChunk =
-          std::partition_point(CurrentChunk + 1, Chunks.end(),
-                               [&](const Chunk &C) { return C.Head < ID; });
-      --CurrentChunk;
-      DecompressedChunk = CurrentChunk->decompress();
+          std::partition_point(Low + 1, High,
+                               [&](const Chunk &C) { return C.Head <= ID; }) -
+          1;
+      CurrentChunk->decompress(DecompressedChunk);
       CurrentID = DecompressedChunk.begin();
     }
   }
@@ -201,7 +219,14 @@ llvm::Optional<DocID> readVByte(llvm::ArrayRef<uint8_t> &Bytes) {
 } // namespace
 
 llvm::SmallVector<DocID, Chunk::PayloadSize + 1> Chunk::decompress() const {
-  llvm::SmallVector<DocID, Chunk::PayloadSize + 1> Result{Head};
+  llvm::SmallVector<DocID, Chunk::PayloadSize + 1> Result;
+  decompress(Result);
+  return Result;
+}
+
+void Chunk::decompress(llvm::SmallVectorImpl<DocID> &Out) const {
+  Out.clear();
+  Out.push_back(Head);
   llvm::ArrayRef<uint8_t> Bytes(Payload);
   DocID Delta;
   for (DocID Current = Head; !Bytes.empty(); Current += Delta) {
@@ -209,13 +234,49 @@ llvm::SmallVector<DocID, Chunk::PayloadSize + 1> Chunk::decompress() const {
     if (!MaybeDelta)
       break;
     Delta = *MaybeDelta;
-    Result.push_back(Current + Delta);
+    Out.push_back(Current + Delta);
+  }
+}
+
+size_t countLessThanScalar(llvm::ArrayRef<DocID> Sorted, DocID ID) {
+  return std::partition_point(Sorted.begin(), Sorted.end(),
+                              [&](const DocID D) { return D < ID; }) -
+         Sorted.begin();
+}
+
+size_t countLessThan(llvm::ArrayRef<DocID> Sorted, DocID ID) {
+  // A decompressed chunk has at most 29 elements, comparing all of them
+  // linearly beats the unpredictable branches of a binary search.
+  size_t I = 0;
+#if defined(__SSE2__)
+  // SSE2 only compares signed integers, flip the sign bits to compare them as
+  // unsigned.
+  const __m128i Bias = _mm_set1_epi32(static_cast<int>(0x80000000u));
+  const __m128i Needle =
+      _mm_xor_si128(_mm_set1_epi32(static_cast<int>(ID)), Bias);
+  for (; I + 4 <= Sorted.size(); I += 4) {
+    __m128i Docs = _mm_xor_si128(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(&Sorted[I])), Bias);
+    unsigned Less =
+        _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(Needle, Docs)));
+    if (Less != 0xf)
+      return I + llvm::countTrailingOnes(Less);
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  const uint32x4_t Needle = vdupq_n_u32(ID);
+  for (; I + 4 <= Sorted.size(); I += 4) {
+    // Each lane is either all ones or zero.
+    uint32x4_t Less = vcltq_u32(vld1q_u32(&Sorted[I]), Needle);
+    unsigned NumLess = vaddvq_u32(vshrq_n_u32(Less, 31));
+    if (NumLess != 4)
+      return I + NumLess;
   }
-  return llvm::SmallVector<DocID, Chunk::PayloadSize + 1>{Result};
+#endif
+  return I + countLessThanScalar(Sorted.drop_front(I), ID);
 }
 
 PostingList::PostingList(llvm::ArrayRef<DocID> Documents)
-    : Chunks(encodeStream(Documents)) {}
+    : Storage(encodeStream(Documents)), Chunks(Storage) {}
 
 std::unique_ptr<Iterator> PostingList::iterator(const Token *Tok) const {
   return std::make_unique<ChunkIterator>(Tok, Chunks);
@@ -39,11 +39,17 @@ class Token;
 /// Chunk is a fixed-width piece of PostingList which contains the first DocID
 /// in uncompressed format (Head) and delta-encoded Payload. It can be
 /// decompressed upon request.
+///
+/// Chunks are also written to index files as they are laid out in memory, so
+/// changing their layout requires bumping the index file version.
 struct Chunk {
   /// Keep sizeof(Chunk) == 32.
   static constexpr size_t PayloadSize = 32 - sizeof(DocID);
 
   llvm::SmallVector<DocID, PayloadSize + 1> decompress() const;
+  /// Decompresses into \p Out, replacing its contents. Avoids the copies of
+  /// decompress() when a buffer is reused.
+  void decompress(llvm::SmallVectorImpl<DocID> &Out) const;
 
   /// The first element of decompressed Chunk.
   DocID Head;
@@ -52,6 +58,15 @@ struct Chunk {
 };
 static_assert(sizeof(Chunk) == 32, "Chunk should take 32 bytes of memory.");
 
+/// NOTE: This is an implementation detail, exposed for tests and benchmarks.
+///
+/// Returns the number of elements of \p Sorted, usually a decompressed Chunk,
+/// which are less than \p ID. Compares four DocIDs at a time with SSE2 or
+/// NEON where they are available.
+size_t countLessThan(llvm::ArrayRef<DocID> Sorted, DocID ID);
+/// The portable implementation of countLessThan().
+size_t countLessThanScalar(llvm::ArrayRef<DocID> Sorted, DocID ID);
+
 /// PostingList is the storage of DocIDs which can be inserted to the Query
 /// Tree as a leaf by constructing Iterator over the PostingList object. DocIDs
 /// are stored in underlying chunks. Compression saves memory at a small cost
@@ -59,17 +74,34 @@ static_assert(sizeof(Chunk) == 32, "Chunk should take 32 bytes of memory.");
 class PostingList {
 public:
   explicit PostingList(llvm::ArrayRef<DocID> Documents);
+  /// Refers to already encoded \p Chunks, e.g. in a memory-mapped index file.
+  /// They must outlive the PostingList.
+  static PostingList fromChunks(llvm::ArrayRef<Chunk> Chunks) {
+    return PostingList(Chunks);
+  }
+
+  PostingList(PostingList &&) = default;
+  PostingList &operator=(PostingList &&) = default;
 
   /// Constructs DocumentIterator over given posting list. DocumentIterator will
   /// go through the chunks and decompress them on-the-fly when necessary.
   /// If given, Tok is only used for the string representation.
   std::unique_ptr<Iterator> iterator(const Token *Tok = nullptr) const;
 
-  /// Returns in-memory size of external storage.
-  size_t bytes() const { return Chunks.capacity() * sizeof(Chunk); }
+  /// Returns in-memory size of external storage. Chunks the list doesn't own
+  /// are not counted.
+  size_t bytes() const { return Storage.capacity() * sizeof(Chunk); }
+
+  /// The encoded contents of the list, used to serialize it.
+  llvm::ArrayRef<Chunk> chunks() const { return Chunks; }
 
 private:
-  const std::vector<Chunk> Chunks;
+  explicit PostingList(llvm::ArrayRef<Chunk> Chunks) : Chunks(Chunks) {}
+
+  /// Owned chunks, if the list was built from documents. Moving the vector
+  /// doesn't move its elements, so Chunks stays valid.
+  std::vector<Chunk> Storage;
+  llvm::ArrayRef<Chunk> Chunks;
 };
 
 } // namespace dex
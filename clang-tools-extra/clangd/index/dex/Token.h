@@ -71,6 +71,9 @@ public:
   Token(Kind TokenKind, llvm::StringRef Data)
       : Data(Data), TokenKind(TokenKind) {}
 
+  Kind kind() const { return TokenKind; }
+  llvm::StringRef data() const { return Data; }
+
   bool operator==(const Token &Other) const {
     return TokenKind == Other.TokenKind && Data == Other.Data;
   }
@@ -162,6 +162,8 @@ int main(int argc, const char **argv) {
   // Emit collected data.
   clang::clangd::IndexFileOut Out(Data);
   Out.Format = clang::clangd::Format;
+  // Static indexes are loaded into Dex, let it map the posting lists.
+  Out.DexIndex = true;
   llvm::outs() << Out;
   return 0;
 }
@@ -455,6 +455,49 @@ TEST_F(BackgroundIndexTest, ShardStorageLoad) {
               Contains(AllOf(named("f_b"), declared(), defined())));
 }
 
+TEST_F(BackgroundIndexTest, StaleHeaderIndexedOnce) {
+  MockFS FS;
+  FS.Files[testPath("root/A.h")] = "void common();";
+  FS.Files[testPath("root/A.cc")] = "#include \"A.h\"";
+  FS.Files[testPath("root/B.cc")] = "#include \"A.h\"";
+
+  llvm::StringMap<std::string> Storage;
+  size_t CacheHits = 0;
+  MemoryShardStorage MSS(Storage, CacheHits);
+  OverlayCDB CDB(/*Base=*/nullptr);
+  for (const char *File : {"A.cc", "B.cc"}) {
+    tooling::CompileCommand Cmd;
+    Cmd.Filename = testPath("root/" + std::string(File));
+    Cmd.Directory = testPath("root");
+    Cmd.CommandLine = {"clang++", Cmd.Filename};
+    CDB.setCompileCommand(Cmd.Filename, Cmd);
+  }
+  std::vector<std::string> MainFiles = {testPath("root/A.cc"),
+                                        testPath("root/B.cc")};
+  {
+    BackgroundIndex Idx(FS, CDB, [&](llvm::StringRef) { return &MSS; },
+                        /*Opts=*/{});
+    Idx.enqueue(MainFiles);
+    ASSERT_TRUE(Idx.blockUntilIdleForTest());
+  }
+
+  // Both A.h and B.cc are stale now. Indexing B.cc also updates A.h, so there
+  // is no need to index A.cc.
+  FS.Files[testPath("root/A.h")] = "void common(); void added();";
+  FS.Files[testPath("root/B.cc")] = "#include \"A.h\"\nvoid b();";
+  BackgroundIndex::Options Opts;
+  std::atomic<unsigned> Enqueued(0);
+  Opts.OnProgress = [&](BackgroundQueue::Stats S) { Enqueued = S.Enqueued; };
+  BackgroundIndex Idx(FS, CDB, [&](llvm::StringRef) { return &MSS; },
+                      std::move(Opts));
+  Idx.enqueue(MainFiles);
+  ASSERT_TRUE(Idx.blockUntilIdleForTest());
+  // One task loading the shards, and one indexing B.cc.
+  EXPECT_EQ(Enqueued, 2U);
+  EXPECT_THAT(runFuzzyFind(Idx, "added"), ElementsAre(named("added")));
+  EXPECT_THAT(runFuzzyFind(Idx, "b"), Contains(named("b")));
+}
+
 TEST_F(BackgroundIndexTest, ShardStorageEmptyFile) {
   MockFS FS;
   FS.Files[testPath("root/A.h")] = R"cpp(
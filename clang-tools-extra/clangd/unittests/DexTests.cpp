@@ -65,6 +65,38 @@ TEST(DexIterators, DocumentIterator) {
   EXPECT_TRUE(DocIterator->reachedEnd());
 }
 
+TEST(DexIterators, DocumentIteratorLongList) {
+  // Spans enough chunks to gallop over several of them.
+  std::vector<DocID> Docs;
+  for (DocID D = 0; D < 100000; D += 3)
+    Docs.push_back(D);
+  const PostingList L(Docs);
+  auto DocIterator = L.iterator();
+  for (DocID Target : {1u, 2u, 3u, 1000u, 1001u, 50000u, 99996u, 99998u}) {
+    DocIterator->advanceTo(Target);
+    ASSERT_FALSE(DocIterator->reachedEnd());
+    EXPECT_EQ(DocIterator->peek(), (Target + 2) / 3 * 3);
+  }
+  DocIterator->advanceTo(100000);
+  EXPECT_TRUE(DocIterator->reachedEnd());
+}
+
+TEST(DexIterators, CountLessThan) {
+  // Values with the sign bit set check that comparisons are unsigned.
+  const std::vector<DocID> Sorted = {
+      0, 1, 5, 9, 10, 100, 101, 0x7fffffff, 0x80000000, 0xffffffff};
+  for (DocID ID : {0u, 1u, 2u, 9u, 10u, 11u, 101u, 102u, 0x7fffffffu,
+                   0x80000000u, 0x80000001u, 0xffffffffu}) {
+    for (size_t Size = 0; Size <= Sorted.size(); ++Size) {
+      auto Prefix = llvm::makeArrayRef(Sorted).take_front(Size);
+      size_t Expected = llvm::count_if(Prefix, [&](DocID D) { return D < ID; });
+      EXPECT_EQ(countLessThan(Prefix, ID), Expected) << ID << " " << Size;
+      EXPECT_EQ(countLessThanScalar(Prefix, ID), Expected)
+          << ID << " " << Size;
+    }
+  }
+}
+
 TEST(DexIterators, AndTwoLists) {
   Corpus C{10000};
   const PostingList L0({0, 5, 7, 10, 42, 320, 9000});
@@ -303,6 +303,53 @@ class x{
 )cpp");
 }
 
+TEST(FormatIncremental, RestartAfterBlankLine) {
+  // Code before the last blank line at namespace scope is not passed to
+  // clang-format. The result must not change.
+  auto Style = format::getLLVMStyle();
+  expectAfterNewline(R"cpp(
+namespace ns {
+int  untouched ;
+
+void foo() {
+  if (bar)
+^
+)cpp",
+                     R"cpp(
+namespace ns {
+int  untouched ;
+
+void foo() {
+  if (bar)
+    ^
+)cpp",
+                     Style);
+
+  expectAfterNewline(R"cpp(
+#if X
+int  untouched ;
+
+#endif
+void foo() {
+  int x;
+
+  bar(baz(
+^
+)cpp",
+                     R"cpp(
+#if X
+int  untouched ;
+
+#endif
+void foo() {
+  int x;
+
+  bar(baz(
+      ^
+)cpp",
+                     Style);
+}
+
 TEST(FormatIncremental, FormatBrace) {
   expectAfter("}", R"cpp(
 vector<int> x= {
@@ -18,8 +18,10 @@
 #include "clang/Format/Format.h"
 #include "clang/Frontend/FrontendActions.h"
 #include "clang/Frontend/PrecompiledPreamble.h"
+#include "llvm/ADT/ScopeExit.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Error.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/VirtualFileSystem.h"
 #include "gmock/gmock.h"
@@ -189,6 +191,55 @@ TEST(PreamblePatchTest, PatchesPreambleIncludes) {
                                 Field(&Inclusion::Resolved, testPath("a.h")))));
 }
 
+TEST(PreambleCacheTest, SharesPreambles) {
+  llvm::SmallString<128> CacheDir;
+  ASSERT_FALSE(
+      llvm::sys::fs::createUniqueDirectory("clangd-preamble-cache", CacheDir));
+  auto Cleanup = llvm::make_scope_exit(
+      [&] { llvm::sys::fs::remove_directories(CacheDir); });
+
+  MockFS FS;
+  IgnoreDiagnostics Diags;
+  auto TU = TestTU::withCode(R"cpp(
+    #include "a.h"
+    #define MAIN_MACRO
+    int x = header_decl;
+  )cpp");
+  TU.AdditionalFiles["a.h"] = "int header_decl;";
+  auto Build = [&](bool &Parsed) {
+    auto PI = TU.inputs(FS);
+    PI.Opts.PreambleCacheDir = std::string(CacheDir);
+    Parsed = false;
+    return buildPreamble(testPath(TU.Filename),
+                         *buildCompilerInvocation(PI, Diags), PI,
+                         /*StoreInMemory=*/true,
+                         [&](ASTContext &, Preprocessor &,
+                             const CanonicalIncludes &) { Parsed = true; });
+  };
+
+  bool Parsed;
+  ASSERT_TRUE(Build(Parsed));
+  EXPECT_TRUE(Parsed);
+
+  // The second build is served from the cache, so the preamble is not parsed.
+  auto Cached = Build(Parsed);
+  ASSERT_TRUE(Cached);
+  EXPECT_FALSE(Parsed);
+  EXPECT_THAT(Cached->Includes.MainFileIncludes,
+              ElementsAre(Field(&Inclusion::Written, "\"a.h\"")));
+  EXPECT_TRUE(Cached->Macros.Names.contains("MAIN_MACRO"));
+  auto PI = TU.inputs(FS);
+  auto AST = ParsedAST::build(testPath(TU.Filename), PI,
+                              buildCompilerInvocation(PI, Diags), {}, Cached);
+  ASSERT_TRUE(AST);
+  EXPECT_THAT(*AST->getDiagnostics(), testing::IsEmpty());
+
+  // Changing an included header invalidates the entry.
+  TU.AdditionalFiles["a.h"] = "int header_decl = 1;";
+  ASSERT_TRUE(Build(Parsed));
+  EXPECT_TRUE(Parsed);
+}
+
 llvm::Optional<ParsedAST> createPatchedAST(llvm::StringRef Baseline,
                                            llvm::StringRef Modified) {
   auto BaselinePreamble = TestTU::withCode(Baseline).preamble();
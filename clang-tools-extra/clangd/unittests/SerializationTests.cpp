@@ -236,6 +236,50 @@ TEST(SerializationTest, BinaryConversions) {
               UnorderedElementsAreArray(yamlFromRelations(*In->Relations)));
 }
 
+TEST(SerializationTest, DexIndex) {
+  auto In = readIndexFile(YAML);
+  ASSERT_TRUE(bool(In)) << In.takeError();
+
+  IndexFileOut Out(*In);
+  Out.Format = IndexFileFormat::RIFF;
+  Out.DexIndex = true;
+  std::string Serialized = llvm::to_string(Out);
+
+  auto In2 = readIndexFile(Serialized);
+  ASSERT_TRUE(bool(In2)) << In2.takeError();
+  ASSERT_TRUE(In2->Symbols);
+  ASSERT_TRUE(In2->DexIndex);
+  EXPECT_EQ(In2->DexIndex->SymbolIDs.size(),
+            In2->Symbols->size() * SymbolID::RawSize);
+  EXPECT_FALSE(In2->DexIndex->PostingLists.empty());
+
+  auto Index = dex::Dex::build(std::move(*In2->Symbols), RefSlab(),
+                               RelationSlab(), *In2->DexIndex, nullptr);
+  ASSERT_TRUE(Index);
+  FuzzyFindRequest Req;
+  Req.Query = "Foo";
+  Req.AnyScope = true;
+  std::vector<std::string> Found;
+  Index->fuzzyFind(Req, [&](const Symbol &Sym) {
+    Found.push_back((Sym.Scope + Sym.Name).str());
+  });
+  EXPECT_THAT(Found, UnorderedElementsAre("clang::Foo1", "clang::Foo2"));
+  Req.RestrictForCodeCompletion = true;
+  Found.clear();
+  Index->fuzzyFind(Req, [&](const Symbol &Sym) {
+    Found.push_back((Sym.Scope + Sym.Name).str());
+  });
+  EXPECT_THAT(Found, ElementsAre("clang::Foo1"));
+
+  // Posting lists that don't match the symbols are rejected.
+  auto In3 = readIndexFile(Serialized);
+  ASSERT_TRUE(bool(In3)) << In3.takeError();
+  SymbolSlab::Builder Fewer;
+  Fewer.insert(*In3->Symbols->begin());
+  EXPECT_FALSE(dex::Dex::build(std::move(Fewer).build(), RefSlab(),
+                               RelationSlab(), *In3->DexIndex, nullptr));
+}
+
 TEST(SerializationTest, SrcsTest) {
   auto In = readIndexFile(YAML);
   EXPECT_TRUE(bool(In)) << In.takeError();
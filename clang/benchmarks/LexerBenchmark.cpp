@@ -0,0 +1,79 @@
+//===--- LexerBenchmark.cpp - Raw lexer throughput ------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures how fast the lexer gets through a corpus in raw mode, which covers
+// the scanning loops without the cost of the preprocessor. A concatenation of
+// the headers of a large project makes a representative corpus:
+//
+//   LexerBenchmark $(find /usr/include/c++ -name '*.h') --benchmark_repetitions=5
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Basic/LangOptions.h"
+#include "clang/Basic/SourceLocation.h"
+#include "clang/Lex/Lexer.h"
+#include "clang/Lex/Token.h"
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+#include <string>
+#include <vector>
+
+using namespace clang;
+
+static std::string Corpus;
+
+static void lexCorpus(benchmark::State &State, const LangOptions &LangOpts) {
+  size_t NumTokens = 0;
+  for (auto _ : State) {
+    Lexer L(SourceLocation(), LangOpts, Corpus.data(), Corpus.data(),
+            Corpus.data() + Corpus.size());
+    Token Tok;
+    while (!L.LexFromRawLexer(Tok))
+      ++NumTokens;
+    benchmark::DoNotOptimize(NumTokens);
+  }
+  State.SetBytesProcessed(State.iterations() * Corpus.size());
+  State.counters["tokens"] =
+      benchmark::Counter(NumTokens, benchmark::Counter::kIsRate);
+}
+
+static void lexCXX(benchmark::State &State) {
+  LangOptions LangOpts;
+  LangOpts.CPlusPlus = LangOpts.CPlusPlus11 = LangOpts.CPlusPlus17 = true;
+  LangOpts.LineComment = true;
+  lexCorpus(State, LangOpts);
+}
+BENCHMARK(lexCXX);
+
+int main(int argc, char *argv[]) {
+  // Files come first, then the options of the benchmark library.
+  int FirstOption = 1;
+  for (; FirstOption < argc &&
+         !llvm::StringRef(argv[FirstOption]).startswith("--");
+       ++FirstOption) {
+    auto Buffer = llvm::MemoryBuffer::getFile(argv[FirstOption]);
+    if (!Buffer) {
+      llvm::errs() << "Error: can't read " << argv[FirstOption] << ": "
+                   << Buffer.getError().message() << "\n";
+      return 1;
+    }
+    Corpus += (*Buffer)->getBuffer();
+    Corpus += '\n';
+  }
+  if (Corpus.empty()) {
+    llvm::errs() << "Usage: " << argv[0] << " file... BENCHMARK_OPTIONS...\n";
+    return 1;
+  }
+  argv[FirstOption - 1] = argv[0];
+  argc -= FirstOption - 1;
+  argv += FirstOption - 1;
+  ::benchmark::Initialize(&argc, argv);
+  ::benchmark::RunSpecifiedBenchmarks();
+}
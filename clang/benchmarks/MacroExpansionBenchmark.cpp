@@ -0,0 +1,144 @@
+//===--- MacroExpansionBenchmark.cpp - Function-like macro expansion ------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures how fast the preprocessor expands function-like macros, which is
+// dominated by collecting and pre-expanding macro arguments. Without inputs,
+// this preprocesses a generated file in the style of Boost.Preprocessor:
+// repetition macros that forward their arguments through several layers of
+// helper macros. The tests of Boost.Preprocessor make a good real-world
+// corpus:
+//
+//   MacroExpansionBenchmark -I$BOOST $BOOST/libs/preprocessor/test/*.cxx
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Basic/Diagnostic.h"
+#include "clang/Basic/DiagnosticOptions.h"
+#include "clang/Basic/FileManager.h"
+#include "clang/Basic/LangOptions.h"
+#include "clang/Basic/SourceManager.h"
+#include "clang/Basic/TargetInfo.h"
+#include "clang/Basic/TargetOptions.h"
+#include "clang/Lex/HeaderSearch.h"
+#include "clang/Lex/HeaderSearchOptions.h"
+#include "clang/Lex/ModuleLoader.h"
+#include "clang/Lex/Preprocessor.h"
+#include "clang/Lex/PreprocessorOptions.h"
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+#include <string>
+#include <vector>
+
+using namespace clang;
+
+static std::vector<std::string> IncludeDirs;
+static std::vector<std::string> Inputs;
+
+/// Generates a file that expands REPEAT(N, M, D) a number of times, where
+/// REPEAT_N(M, D) expands to REPEAT_{N-1}(M, D) M(N-1, D).
+static std::string generateStressTest() {
+  std::string Source;
+  llvm::raw_string_ostream OS(Source);
+  const unsigned Depth = 64, Uses = 64;
+  OS << "#define CAT(a, b) CAT_I(a, b)\n"
+     << "#define CAT_I(a, b) a ## b\n"
+     << "#define IDENT(x) x\n"
+     << "#define FIRST(a, b) a\n"
+     << "#define FIELD(n, d) FIRST(IDENT(d), ~) CAT(field_, n);\n"
+     << "#define REPEAT(n, m, d) CAT(REPEAT_, n)(m, d)\n"
+     << "#define REPEAT_0(m, d)\n";
+  for (unsigned I = 1; I <= Depth; ++I)
+    OS << "#define REPEAT_" << I << "(m, d) REPEAT_" << I - 1 << "(m, d) m("
+       << I - 1 << ", d)\n";
+  for (unsigned I = 0; I < Uses; ++I)
+    OS << "struct S" << I << " { REPEAT(" << Depth
+       << ", FIELD, IDENT(IDENT(unsigned int))) };\n";
+  return OS.str();
+}
+
+static void expandMacros(benchmark::State &State) {
+  std::vector<std::unique_ptr<llvm::MemoryBuffer>> Buffers;
+  if (Inputs.empty()) {
+    Buffers.push_back(llvm::MemoryBuffer::getMemBufferCopy(
+        generateStressTest(), "<stress>"));
+  } else {
+    for (const std::string &Input : Inputs) {
+      auto Buffer = llvm::MemoryBuffer::getFile(Input);
+      if (!Buffer) {
+        State.SkipWithError(("can't read " + Input).c_str());
+        return;
+      }
+      Buffers.push_back(std::move(*Buffer));
+    }
+  }
+
+  FileSystemOptions FileMgrOpts;
+  FileManager FileMgr(FileMgrOpts);
+  DiagnosticsEngine Diags(new DiagnosticIDs(), new DiagnosticOptions,
+                          new IgnoringDiagConsumer());
+  auto TargetOpts = std::make_shared<TargetOptions>();
+  TargetOpts->Triple = "x86_64-unknown-linux-gnu";
+  IntrusiveRefCntPtr<TargetInfo> Target =
+      TargetInfo::CreateTargetInfo(Diags, TargetOpts);
+  LangOptions LangOpts;
+  LangOpts.CPlusPlus = LangOpts.CPlusPlus11 = LangOpts.CPlusPlus17 = true;
+  LangOpts.LineComment = true;
+
+  size_t NumTokens = 0;
+  for (auto _ : State) {
+    for (const auto &Buffer : Buffers) {
+      SourceManager SourceMgr(Diags, FileMgr);
+      SourceMgr.setMainFileID(
+          SourceMgr.createFileID(llvm::MemoryBufferRef(*Buffer)));
+      TrivialModuleLoader ModLoader;
+      HeaderSearch HeaderInfo(std::make_shared<HeaderSearchOptions>(),
+                              SourceMgr, Diags, LangOpts, Target.get());
+      for (const std::string &Dir : IncludeDirs)
+        if (auto DirEntry = FileMgr.getOptionalDirectoryRef(Dir))
+          HeaderInfo.AddSearchPath(
+              DirectoryLookup(*DirEntry, SrcMgr::C_User, /*isFramework=*/false),
+              /*isAngled=*/true);
+      Preprocessor PP(std::make_shared<PreprocessorOptions>(), Diags, LangOpts,
+                      SourceMgr, HeaderInfo, ModLoader,
+                      /*IILookup=*/nullptr, /*OwnsHeaderSearch=*/false);
+      PP.Initialize(*Target);
+      PP.EnterMainSourceFile();
+      Token Tok;
+      do {
+        PP.Lex(Tok);
+        ++NumTokens;
+      } while (Tok.isNot(tok::eof));
+    }
+    benchmark::DoNotOptimize(NumTokens);
+  }
+  State.counters["tokens"] =
+      benchmark::Counter(NumTokens, benchmark::Counter::kIsRate);
+}
+BENCHMARK(expandMacros)->Unit(benchmark::kMillisecond);
+
+int main(int argc, char *argv[]) {
+  // Include directories and files come first, then the options of the
+  // benchmark library.
+  int FirstOption = 1;
+  for (; FirstOption < argc &&
+         !llvm::StringRef(argv[FirstOption]).startswith("--");
+       ++FirstOption) {
+    llvm::StringRef Arg = argv[FirstOption];
+    if (Arg.consume_front("-I"))
+      IncludeDirs.push_back(Arg.str());
+    else
+      Inputs.push_back(Arg.str());
+  }
+  argv[FirstOption - 1] = argv[0];
+  argc -= FirstOption - 1;
+  argv += FirstOption - 1;
+  ::benchmark::Initialize(&argc, argv);
+  ::benchmark::RunSpecifiedBenchmarks();
+}
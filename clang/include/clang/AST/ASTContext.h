@@ -763,6 +763,10 @@ public:
     return BumpAlloc.getTotalMemory();
   }
 
+  /// Return the number of bytes requested so far for AST nodes and type
+  /// information, without the unused tail of the allocator's slabs.
+  size_t getASTAllocatedBytes() const { return BumpAlloc.getBytesAllocated(); }
+
   /// Return the total memory used for various side tables.
   size_t getSideTableAllocatedMemory() const;
 
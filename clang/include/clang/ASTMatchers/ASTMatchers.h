@@ -3859,21 +3859,21 @@ AST_MATCHER_P(CallExpr, callee, internal::Matcher<Stmt>,
 ///   ...
 ///   [I foo]
 /// \endcode
-AST_POLYMORPHIC_MATCHER_P_OVERLOAD(
-    callee, AST_POLYMORPHIC_SUPPORTED_TYPES(ObjCMessageExpr, CallExpr),
-    internal::Matcher<Decl>, InnerMatcher, 1) {
-  if (const auto *CallNode = dyn_cast<CallExpr>(&Node))
-    return callExpr(hasDeclaration(InnerMatcher))
-        .matches(Node, Finder, Builder);
-  else {
-    // The dynamic cast below is guaranteed to succeed as there are only 2
-    // supported return types.
-    const auto *MsgNode = cast<ObjCMessageExpr>(&Node);
-    const Decl *DeclNode = MsgNode->getMethodDecl();
-    return (DeclNode != nullptr &&
-            InnerMatcher.matches(*DeclNode, Finder, Builder));
-  }
-}
+inline internal::PolymorphicMatcher<
+    internal::CalleeDeclMatcher,
+    AST_POLYMORPHIC_SUPPORTED_TYPES(ObjCMessageExpr, CallExpr),
+    internal::Matcher<Decl>>
+callee(const internal::Matcher<Decl> &InnerMatcher) {
+  return internal::PolymorphicMatcher<
+      internal::CalleeDeclMatcher,
+      AST_POLYMORPHIC_SUPPORTED_TYPES(ObjCMessageExpr, CallExpr),
+      internal::Matcher<Decl>>(InnerMatcher);
+}
+typedef internal::PolymorphicMatcher<
+    internal::CalleeDeclMatcher,
+    AST_POLYMORPHIC_SUPPORTED_TYPES(ObjCMessageExpr, CallExpr),
+    internal::Matcher<Decl>> (&callee_Type1)(
+    const internal::Matcher<Decl> &InnerMatcher);
 
 /// Matches if the expression's or declaration's type matches a type
 /// matcher.
@@ -354,6 +354,18 @@ public:
   virtual llvm::Optional<clang::TraversalKind> TraversalKind() const {
     return llvm::None;
   }
+
+  /// Appends to \p Names the unqualified names one of which a node must
+  /// carry for this matcher to match it, and returns true, if such a set is
+  /// known. The name of a \c NamedDecl is its identifier, the name of a
+  /// \c CallExpr is the identifier of its callee declaration. Operands with
+  /// their own traversal kind do not contribute, as they may be matched
+  /// against a different node.
+  ///
+  /// Used by \c MatchFinder to skip matchers that cannot match a node.
+  virtual bool collectRequiredNames(std::vector<StringRef> &Names) const {
+    return false;
+  }
 };
 
 /// Generic interface for matchers on an AST node of type T.
@@ -460,6 +472,11 @@ public:
   /// return \c true.
   bool canMatchNodesOfKind(ASTNodeKind Kind) const;
 
+  /// See \c DynMatcherInterface::collectRequiredNames.
+  bool collectRequiredNames(std::vector<StringRef> &Names) const {
+    return Implementation->collectRequiredNames(Names);
+  }
+
   /// Return a matcher that points to the same implementation, but
   ///   restricts the node types for \p Kind.
   DynTypedMatcher dynCastTo(const ASTNodeKind Kind) const;
@@ -947,6 +964,9 @@ class HasNameMatcher : public SingleNodeMatcherInterface<NamedDecl> {
 
   bool matchesNode(const NamedDecl &Node) const override;
 
+  bool
+  collectRequiredNames(std::vector<StringRef> &RequiredNames) const override;
+
 private:
   /// Unqualified match routine.
   ///
@@ -1002,6 +1022,12 @@ public:
     return matchesSpecialized(Node, Finder, Builder);
   }
 
+  bool collectRequiredNames(std::vector<StringRef> &Names) const override {
+    // The name of a call is the name of its callee declaration.
+    return std::is_same<T, CallExpr>::value &&
+           InnerMatcher.collectRequiredNames(Names);
+  }
+
 private:
   /// Forwards to matching on the underlying type of the QualType.
   bool matchesSpecialized(const QualType &Node, ASTMatchFinder *Finder,
@@ -1161,6 +1187,51 @@ private:
   }
 };
 
+/// Matches the callee declaration of a \c CallExpr, or the method declaration
+/// of an \c ObjCMessageExpr.
+///
+/// See \c callee() in ASTMatchers.h for details.
+template <typename T, typename DeclMatcherT>
+class CalleeDeclMatcher : public MatcherInterface<T> {
+  static_assert(std::is_same<DeclMatcherT, Matcher<Decl>>::value,
+                "instantiated with wrong types");
+
+  DynTypedMatcher InnerMatcher;
+
+public:
+  explicit CalleeDeclMatcher(const Matcher<Decl> &InnerMatcher)
+      : InnerMatcher(InnerMatcher) {}
+
+  bool matches(const T &Node, ASTMatchFinder *Finder,
+               BoundNodesTreeBuilder *Builder) const override {
+    return matchesSpecialized(Node, Finder, Builder);
+  }
+
+  bool collectRequiredNames(std::vector<StringRef> &Names) const override {
+    return std::is_same<T, CallExpr>::value &&
+           InnerMatcher.collectRequiredNames(Names);
+  }
+
+private:
+  bool matchesSpecialized(const CallExpr &Node, ASTMatchFinder *Finder,
+                          BoundNodesTreeBuilder *Builder) const {
+    const Decl *DeclNode = Node.getCalleeDecl();
+    return DeclNode != nullptr &&
+           !(Finder->isTraversalIgnoringImplicitNodes() &&
+             DeclNode->isImplicit()) &&
+           InnerMatcher.matches(DynTypedNode::create(*DeclNode), Finder,
+                                Builder);
+  }
+
+  bool matchesSpecialized(const ObjCMessageExpr &Node, ASTMatchFinder *Finder,
+                          BoundNodesTreeBuilder *Builder) const {
+    const Decl *DeclNode = Node.getMethodDecl();
+    return DeclNode != nullptr &&
+           InnerMatcher.matches(DynTypedNode::create(*DeclNode), Finder,
+                                Builder);
+  }
+};
+
 /// IsBaseType<T>::value is true if T is a "base" type in the AST
 /// node class hierarchies.
 template <typename T>
@@ -1521,6 +1592,10 @@ public:
       return NestedKind;
     return Traversal;
   }
+
+  bool collectRequiredNames(std::vector<StringRef> &Names) const override {
+    return this->InnerMatcher.collectRequiredNames(Names);
+  }
 };
 
 template <typename MatcherType> class TraversalWrapper {
@@ -58,6 +58,7 @@ public:
     NoLibrary,         // Don't use any vector library.
     Accelerate,        // Use the Accelerate framework.
     LIBMVEC,           // GLIBC vector math library.
+    LLVMLIBC,          // LLVM libc vector math functions.
     MASSV,             // IBM MASS vector library.
     SVML,              // Intel short vector math library.
     Darwin_libsystem_m // Use Darwin's libsytem_m vector functions.
@@ -286,6 +287,12 @@ public:
   /// are offloading binaries containing device images and metadata.
   std::vector<std::string> OffloadObjects;
 
+  /// Object files passed with -fparallel-codegen-output. If not empty, the
+  /// module is split into one more partition than there are files, code for
+  /// the partitions is generated in parallel, and the first partition goes to
+  /// the main output.
+  std::vector<std::string> ParallelCodeGenOutputs;
+
   /// The name of the file to which the backend should save YAML optimization
   /// records.
   std::string OptRecordFile;
@@ -214,8 +214,7 @@ private:
                                                      StringRef IndexName,
                                                      bool DisplayCTUProgress);
   template <typename T>
-  const T *findDefInDeclContext(const DeclContext *DC,
-                                StringRef LookupName);
+  const T *findDefInUnit(ASTUnit *Unit, StringRef LookupName);
   template <typename T>
   llvm::Expected<const T *> importDefinitionImpl(const T *D, ASTUnit *Unit);
 
@@ -224,6 +223,14 @@ private:
 
   ImporterMapTy ASTUnitImporterMap;
 
+  /// The function and variable definitions of a loaded unit, by lookup name.
+  using DefinitionMapTy = llvm::StringMap<const Decl *>;
+  void collectDefinitions(const DeclContext *DC, DefinitionMapTy &Defs);
+
+  /// Built on the first lookup in each unit, so that later lookups do not
+  /// have to walk the whole unit and compute the USR of every definition.
+  llvm::DenseMap<ASTUnit *, DefinitionMapTy> UnitDefinitions;
+
   ASTContext &Context;
   std::shared_ptr<ASTImporterSharedState> ImporterSharedSt;
 
@@ -283,6 +283,9 @@ public:
   /// Output time trace profile.
   unsigned TimeTrace : 1;
 
+  /// Attribute the memory allocated by the ASTContext to time trace events.
+  unsigned TimeTraceMemory : 1;
+
   /// Show the -version text.
   unsigned ShowVersion : 1;
 
@@ -311,6 +314,10 @@ public:
   /// Whether we can generate the global module index if needed.
   unsigned GenerateGlobalModuleIndex : 1;
 
+  /// Whether to build filters over the identifier tables of loaded modules on
+  /// background threads.
+  unsigned PrefetchModuleIdentifierTables : 1;
+
   /// Whether we include declaration dumps in AST dumps.
   unsigned ASTDumpDecls : 1;
 
@@ -509,11 +516,13 @@ public:
 public:
   FrontendOptions()
       : DisableFree(false), RelocatablePCH(false), ShowHelp(false),
-        ShowStats(false), TimeTrace(false), ShowVersion(false),
+        ShowStats(false), TimeTrace(false), TimeTraceMemory(false),
+        ShowVersion(false),
         FixWhatYouCan(false), FixOnlyWarnings(false), FixAndRecompile(false),
         FixToTemporaries(false), ARCMTMigrateEmitARCErrors(false),
         SkipFunctionBodies(false), UseGlobalModuleIndex(true),
-        GenerateGlobalModuleIndex(true), ASTDumpDecls(false),
+        GenerateGlobalModuleIndex(true),
+        PrefetchModuleIdentifierTables(false), ASTDumpDecls(false),
         ASTDumpLookups(false), BuildingImplicitModule(false),
         BuildingImplicitModuleUsesLock(true), ModulesEmbedAllFiles(false),
         IncludeTimestamps(true), UseTemporary(true),
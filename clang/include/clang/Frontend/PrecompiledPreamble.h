@@ -26,6 +26,7 @@
 namespace llvm {
 class MemoryBuffer;
 class MemoryBufferRef;
+class raw_ostream;
 namespace vfs {
 class FileSystem;
 }
@@ -127,6 +128,16 @@ public:
                         IntrusiveRefCntPtr<llvm::vfs::FileSystem> &VFS,
                         llvm::MemoryBuffer *MainFileBuffer) const;
 
+  /// Writes the PCH together with everything CanReuse() needs to \p OS, so
+  /// that the preamble can be restored by another process with deserialize().
+  std::error_code serialize(llvm::raw_ostream &OS) const;
+
+  /// Restores a preamble written by serialize(). \p StoreInMemory has the
+  /// same meaning as for Build(). The result must still be checked with
+  /// CanReuse() before it is used.
+  static llvm::ErrorOr<PrecompiledPreamble> deserialize(llvm::StringRef Data,
+                                                        bool StoreInMemory);
+
 private:
   PrecompiledPreamble(std::unique_ptr<PCHStorage> Storage,
                       std::vector<char> PreambleBytes,
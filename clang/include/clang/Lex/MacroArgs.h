@@ -16,6 +16,7 @@
 #include "clang/Basic/LLVM.h"
 #include "clang/Lex/Token.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/TrailingObjects.h"
 #include <vector>
 
@@ -43,10 +44,19 @@ class MacroArgs final
   /// is false.
   bool VarargsElided;
 
-  /// PreExpArgTokens - Pre-expanded tokens for arguments that need them.  Empty
-  /// if not yet computed.  This includes the EOF marker at the end of the
-  /// stream.
-  std::vector<std::vector<Token> > PreExpArgTokens;
+  /// PreExpArgTokens - The range of pre-expanded tokens for arguments that
+  /// need them, in the preprocessor's PreExpandedArgTokens.  Empty if not yet
+  /// computed.  This includes the EOF marker at the end of the stream.
+  ///
+  /// The pre-expanded arguments are only needed while the expansion of the
+  /// macro is built, so the preprocessor keeps them in a stack that is popped
+  /// by discardPreExpArguments.
+  SmallVector<std::pair<unsigned, unsigned>, 4> PreExpArgTokens;
+
+  /// PreExpArgTokensStart - The size of the preprocessor's stack of
+  /// pre-expanded arguments before the first argument of this invocation was
+  /// pre-expanded, or ~0U if none has been.
+  unsigned PreExpArgTokensStart;
 
   /// ArgCache - This is a linked list of MacroArgs objects that the
   /// Preprocessor owns which we use to avoid thrashing malloc/free.
@@ -57,7 +67,7 @@ class MacroArgs final
 
   MacroArgs(unsigned NumToks, bool varargsElided, unsigned MacroArgs)
       : NumUnexpArgTokens(NumToks), VarargsElided(varargsElided),
-        ArgCache(nullptr), NumMacroArgs(MacroArgs) {}
+        PreExpArgTokensStart(~0U), ArgCache(nullptr), NumMacroArgs(MacroArgs) {}
   ~MacroArgs() = default;
 
 public:
@@ -86,9 +96,13 @@ public:
   static unsigned getArgLength(const Token *ArgPtr);
 
   /// getPreExpArgument - Return the pre-expanded form of the specified
-  /// argument.
-  const std::vector<Token> &
-    getPreExpArgument(unsigned Arg, Preprocessor &PP);
+  /// argument.  The tokens are only valid until another argument is
+  /// pre-expanded, or until discardPreExpArguments is called.
+  ArrayRef<Token> getPreExpArgument(unsigned Arg, Preprocessor &PP);
+
+  /// discardPreExpArguments - Release the pre-expanded arguments of this
+  /// invocation, once the expansion of the macro has been built.
+  void discardPreExpArguments(Preprocessor &PP);
 
   /// getNumMacroArguments - Return the number of arguments the invoked macro
   /// expects.
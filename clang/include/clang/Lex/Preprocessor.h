@@ -929,6 +929,14 @@ private:
   /// reused for quick allocation.
   MacroArgs *MacroArgCache = nullptr;
 
+  /// The pre-expanded arguments of the function-like macros whose expansions
+  /// are being built, see MacroArgs::getPreExpArgument.
+  ///
+  /// Works like a stack; the expansion of a macro in an argument happens while
+  /// the argument is pre-expanded, and it pops its own arguments off the end
+  /// before the outer argument is complete.
+  SmallVector<Token, 256> PreExpandedArgTokens;
+
   /// For each IdentifierInfo used in a \#pragma push_macro directive,
   /// we keep a MacroInfo stack used to restore the previous macro value.
   llvm::DenseMap<IdentifierInfo *, std::vector<MacroInfo *>>
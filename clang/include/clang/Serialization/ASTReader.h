@@ -62,6 +62,12 @@
 #include <utility>
 #include <vector>
 
+namespace llvm {
+
+class ThreadPool;
+
+} // namespace llvm
+
 namespace clang {
 
 class ASTConsumer;
@@ -957,6 +963,13 @@ private:
   /// Whether we have tried loading the global module index yet.
   bool TriedLoadingGlobalIndex = false;
 
+  /// Whether to build the identifier filters of newly loaded modules on
+  /// background threads.
+  bool PrefetchIdentifierTables = false;
+
+  /// The threads that build identifier filters, created on first use.
+  std::unique_ptr<llvm::ThreadPool> PrefetchPool;
+
   ///Whether we are currently processing update records.
   bool ProcessingUpdateRecords = false;
 
@@ -1345,6 +1358,8 @@ private:
                                bool ValidateDiagnosticOptions);
 
   llvm::Error ReadASTBlock(ModuleFile &F, unsigned ClientLoadCapabilities);
+  /// Start building the identifier filter of \p F in the background.
+  void prefetchIdentifierTable(ModuleFile &F);
   llvm::Error ReadExtensionBlock(ModuleFile &F);
   void ReadModuleOffsetMap(ModuleFile &F) const;
   void ParseLineTable(ModuleFile &F, const RecordData &Record);
@@ -1690,6 +1705,15 @@ public:
   /// e.g., because it is out-of-date or does not exist.
   bool isGlobalIndexUnavailable() const;
 
+  /// Build a filter over the identifiers of each module file loaded from now
+  /// on, on background threads, so that identifier lookups can skip the
+  /// module files that don't contain the identifier without probing their
+  /// on-disk tables. Lookup results don't depend on whether or when the
+  /// filters become available.
+  void setPrefetchIdentifierTables(bool Prefetch) {
+    PrefetchIdentifierTables = Prefetch;
+  }
+
   /// Initializes the ASTContext
   void InitializeContext();
 
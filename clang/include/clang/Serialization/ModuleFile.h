@@ -28,6 +28,7 @@
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Bitstream/BitstreamReader.h"
 #include "llvm/Support/Endian.h"
+#include <atomic>
 #include <cassert>
 #include <cstdint>
 #include <memory>
@@ -309,6 +310,13 @@ public:
   /// IdentifierTableData.
   std::vector<unsigned> PreloadIdentifierOffsets;
 
+  /// A filter over the hashes of the identifiers in IdentifierLookupTable,
+  /// built on a background thread if the AST reader prefetches identifier
+  /// tables. A clear bit means that an identifier is not in this module. Only
+  /// valid once IdentifierFilterReady is set.
+  llvm::BitVector IdentifierFilter;
+  std::atomic<bool> IdentifierFilterReady{false};
+
   // === Macros ===
 
   /// The cursor to the start of the preprocessor block, which stores
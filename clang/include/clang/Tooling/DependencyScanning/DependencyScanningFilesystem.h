@@ -12,6 +12,7 @@
 #include "clang/Basic/LLVM.h"
 #include "clang/Lex/DependencyDirectivesScanner.h"
 #include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/STLFunctionalExtras.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/ErrorOr.h"
@@ -22,6 +23,8 @@ namespace clang {
 namespace tooling {
 namespace dependencies {
 
+class DependencyScanningPersistentCache;
+
 using DependencyDirectivesTy =
     SmallVector<dependency_directives_scan::Directive, 20>;
 
@@ -202,9 +205,26 @@ public:
   CacheShard &getShardForFilename(StringRef Filename) const;
   CacheShard &getShardForUID(llvm::sys::fs::UniqueID UID) const;
 
+  /// Calls \p Fn on every cached file that has contents.
+  void forEachEntryWithContents(
+      llvm::function_ref<void(const CachedFileSystemEntry &)> Fn) const;
+
+  /// Sets the on-disk cache that is consulted before scanning a file for
+  /// directives. Must be called before any worker uses this cache.
+  void
+  setPersistentCache(const DependencyScanningPersistentCache *PersistentCache) {
+    this->PersistentCache = PersistentCache;
+  }
+
+  const DependencyScanningPersistentCache *getPersistentCache() const {
+    return PersistentCache;
+  }
+
 private:
   std::unique_ptr<CacheShard[]> CacheShards;
   unsigned NumShards;
+  /// The optional on-disk cache, not owned.
+  const DependencyScanningPersistentCache *PersistentCache = nullptr;
 };
 
 /// This class is a local cache, that caches the 'stat' and 'open' calls to the
@@ -0,0 +1,78 @@
+//===- DependencyScanningPersistentCache.h - clang-scan-deps cache -*- C++ -*-//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_TOOLING_DEPENDENCYSCANNING_DEPENDENCYSCANNINGPERSISTENTCACHE_H
+#define LLVM_CLANG_TOOLING_DEPENDENCYSCANNING_DEPENDENCYSCANNINGPERSISTENTCACHE_H
+
+#include "clang/Basic/LLVM.h"
+#include "clang/Lex/DependencyDirectivesScanner.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/VirtualFileSystem.h"
+#include <memory>
+#include <string>
+
+namespace clang {
+namespace tooling {
+namespace dependencies {
+
+class DependencyScanningFilesystemSharedCache;
+
+/// An on-disk cache of the preprocessor directives scanned from source files,
+/// that can be shared by subsequent clang-scan-deps processes.
+///
+/// Entries are keyed by the unique ID of the file and validated against its
+/// modification time, size and a hash of its contents, so a stale entry is
+/// never used. The cache file is mapped read-only and lookups are done in
+/// place; only the tokens of the files that are hits are copied out.
+///
+/// Stat results are not taken from the cache: the key of an entry comes from
+/// a real stat of the file, which the filesystem cache still performs once per
+/// process.
+class DependencyScanningPersistentCache {
+public:
+  /// Opens the cache stored at \p Path. If the file does not exist or is not a
+  /// valid cache, the returned cache is empty and save() will create it.
+  static std::unique_ptr<DependencyScanningPersistentCache>
+  open(StringRef Path);
+
+  /// Looks up the directives of the file with status \p Stat and contents
+  /// \p Contents. On a hit, fills \p Tokens and \p Directives like
+  /// \c scanSourceForDependencyDirectives() would and returns true.
+  bool
+  lookup(const llvm::vfs::Status &Stat, StringRef Contents,
+         SmallVectorImpl<dependency_directives_scan::Token> &Tokens,
+         SmallVectorImpl<dependency_directives_scan::Directive> &Directives)
+      const;
+
+  /// Writes the directives scanned so far in \p SharedCache to the cache file,
+  /// together with the entries of the existing file that were not seen by
+  /// this process. The file is replaced atomically, so concurrent processes
+  /// sharing the cache never see a partially written file.
+  llvm::Error save(const DependencyScanningFilesystemSharedCache &SharedCache);
+
+  StringRef getPath() const { return Path; }
+
+  /// \returns The number of entries in the cache file that was opened.
+  size_t size() const;
+
+private:
+  DependencyScanningPersistentCache(std::string Path,
+                                    std::unique_ptr<llvm::MemoryBuffer> Buffer)
+      : Path(std::move(Path)), Buffer(std::move(Buffer)) {}
+
+  std::string Path;
+  /// The mapped cache file, null if there was no valid one.
+  std::unique_ptr<llvm::MemoryBuffer> Buffer;
+};
+
+} // end namespace dependencies
+} // end namespace tooling
+} // end namespace clang
+
+#endif // LLVM_CLANG_TOOLING_DEPENDENCYSCANNING_DEPENDENCYSCANNINGPERSISTENTCACHE_H
@@ -136,6 +136,66 @@ private:
   llvm::yaml::Stream YAMLStream;
 };
 
+/// A JSON compilation database that only parses the entries it is queried
+/// for.
+///
+/// Loading a JSONCompilationDatabase parses the whole file, which dominates
+/// the startup time of tools on very large databases. This database keeps a
+/// side index instead, which maps each file to the byte ranges of its entries
+/// in the JSON file. The index is memory mapped, and a query only reads and
+/// parses the entries of the file it asks for.
+///
+/// The index is rebuilt when the JSON file changes. Entries whose text did not
+/// change are taken from the previous index without being parsed again.
+class IndexedJSONCompilationDatabase : public CompilationDatabase {
+public:
+  /// Loads the JSON compilation database in \p FilePath using the side index
+  /// in \p IndexPath, which is created or updated as needed.
+  ///
+  /// Returns NULL and sets ErrorMessage if the database could not be
+  /// loaded from the given file. Failing to write the index is not an error.
+  static std::unique_ptr<IndexedJSONCompilationDatabase>
+  loadFromFile(StringRef FilePath, StringRef IndexPath,
+               std::string &ErrorMessage, JSONCommandLineSyntax Syntax);
+
+  /// Returns all compile commands in which the specified file was
+  /// compiled.
+  std::vector<CompileCommand>
+  getCompileCommands(StringRef FilePath) const override;
+
+  /// Returns the list of all files available in the compilation database.
+  std::vector<std::string> getAllFiles() const override;
+
+  /// Returns all compile commands for all the files in the compilation
+  /// database.
+  std::vector<CompileCommand> getAllCompileCommands() const override;
+
+private:
+  IndexedJSONCompilationDatabase(StringRef FilePath,
+                                 std::unique_ptr<llvm::MemoryBuffer> Index,
+                                 JSONCommandLineSyntax Syntax);
+
+  /// Returns the positions in the sorted index of the entries for the
+  /// native path \p File.
+  std::pair<uint32_t, uint32_t> findEntries(StringRef File) const;
+
+  /// Returns the file of the entry at position \p I in the sorted index.
+  StringRef getSortedFile(uint32_t I) const;
+
+  /// Parses the entry with index \p Entry, given the text of the JSON file,
+  /// into Commands.
+  void getCommand(uint32_t Entry, StringRef JSON,
+                  std::vector<CompileCommand> &Commands) const;
+
+  std::string FilePath;
+  std::unique_ptr<llvm::MemoryBuffer> Index;
+  JSONCommandLineSyntax Syntax;
+
+  /// Matches paths which are not in the index verbatim. Built on the first
+  /// lookup that needs it.
+  mutable std::unique_ptr<FileMatchTrie> MatchTrie;
+};
+
 } // namespace tooling
 } // namespace clang
 
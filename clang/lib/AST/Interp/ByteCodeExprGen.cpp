@@ -1069,19 +1069,7 @@ Record *ByteCodeExprGen<Emitter>::getRecord(const RecordDecl *RD) {
 
 template <class Emitter>
 const Function *ByteCodeExprGen<Emitter>::getFunction(const FunctionDecl *FD) {
-  assert(FD);
-  const Function *Func = P.getFunction(FD);
-
-  if (!Func) {
-    if (auto R = ByteCodeStmtGen<ByteCodeEmitter>(Ctx, P).compileFunc(FD))
-      Func = *R;
-    else {
-      llvm::consumeError(R.takeError());
-      return nullptr;
-    }
-  }
-
-  return Func;
+  return Ctx.getOrCreateFunction(FD);
 }
 
 template <class Emitter>
@@ -1139,16 +1127,33 @@ bool ByteCodeExprGen<Emitter>::VisitCallExpr(const CallExpr *E) {
 
   const Decl *Callee = E->getCalleeDecl();
   if (const auto *FuncDecl = dyn_cast_or_null<FunctionDecl>(Callee)) {
-    const Function *Func = getFunction(FuncDecl);
-    if (!Func)
-      return false;
-    // If the function is being compiled right now, this is a recursive call.
-    // In that case, the function can't be valid yet, even though it will be
-    // later.
-    // If the function is already fully compiled but not constexpr, it was
-    // found to be faulty earlier on, so bail out.
-    if (Func->isFullyCompiled() && !Func->isConstexpr())
-      return false;
+    // Calls to virtual functions are dispatched at runtime, unless the callee
+    // is named with a qualifier. The function called statically might be pure
+    // and not have a definition, so it is not compiled here.
+    const auto *MD = dyn_cast<CXXMethodDecl>(FuncDecl);
+    if (MD && MD->isVirtual()) {
+      const auto *ME = dyn_cast<MemberExpr>(E->getCallee()->IgnoreParens());
+      if (!ME || ME->hasQualifier())
+        MD = nullptr;
+      else if (MD->isVariadic())
+        return this->bail(E);
+    } else {
+      MD = nullptr;
+    }
+
+    const Function *Func = nullptr;
+    if (!MD) {
+      Func = getFunction(FuncDecl);
+      if (!Func)
+        return false;
+      // If the function is being compiled right now, this is a recursive
+      // call. In that case, the function can't be valid yet, even though it
+      // will be later.
+      // If the function is already fully compiled but not constexpr, it was
+      // found to be faulty earlier on, so bail out.
+      if (Func->isFullyCompiled() && !Func->isConstexpr())
+        return false;
+    }
 
     // Put arguments on the stack.
     for (const auto *Arg : E->arguments()) {
@@ -1159,8 +1164,16 @@ bool ByteCodeExprGen<Emitter>::VisitCallExpr(const CallExpr *E) {
     // In any case call the function. The return value will end up on the stack and
     // if the function has RVO, we already have the pointer on the stack to write
     // the result into.
-    if (!this->emitCall(Func, E))
+    if (MD) {
+      // Arguments are laid out like the parameters of the compiled function.
+      unsigned ThisOffset = align(primSize(PT_Ptr));
+      for (const ParmVarDecl *PD : MD->parameters())
+        ThisOffset += align(primSize(classify(PD->getType()).value_or(PT_Ptr)));
+      if (!this->emitCallVirt(MD, ThisOffset, E))
+        return false;
+    } else if (!this->emitCall(Func, E)) {
       return false;
+    }
 
     QualType ReturnType = E->getCallReturnType(Ctx.getASTContext());
     if (DiscardResult && !ReturnType->isVoidType()) {
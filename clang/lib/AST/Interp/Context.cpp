@@ -123,6 +123,18 @@ unsigned Context::getCharBit() const {
   return Ctx.getTargetInfo().getCharWidth();
 }
 
+Function *Context::getOrCreateFunction(const FunctionDecl *FD) {
+  assert(FD);
+  if (Function *Func = P->getFunction(FD))
+    return Func;
+
+  if (auto R = ByteCodeStmtGen<ByteCodeEmitter>(*this, *P).compileFunc(FD))
+    return *R;
+  else
+    llvm::consumeError(R.takeError());
+  return nullptr;
+}
+
 bool Context::Run(State &Parent, Function *Func, APValue &Result) {
   InterpState State(Parent, *P, Stk, *this);
   State.Current = new InterpFrame(State, Func, nullptr, {}, {});
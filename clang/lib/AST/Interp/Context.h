@@ -61,6 +61,10 @@ public:
   /// Classifies an expression.
   llvm::Optional<PrimType> classify(QualType T) const;
 
+  /// Returns the bytecode of a function, compiling it on first use.
+  /// Returns null if the function is not defined or cannot be compiled.
+  Function *getOrCreateFunction(const FunctionDecl *FD);
+
 private:
   /// Runs a function.
   bool Run(State &Parent, Function *Func, APValue &Result);
@@ -373,6 +373,74 @@ bool CheckCallable(InterpState &S, CodePtr OpPC, Function *F) {
   return true;
 }
 
+Function *getVirtualOverrider(InterpState &S, CodePtr OpPC,
+                              const CXXMethodDecl *MD, Pointer &This) {
+  if (!CheckInvoke(S, OpPC, This))
+    return nullptr;
+
+  // While a constructor or destructor runs, the dynamic type of the object is
+  // the class of the constructor or destructor.
+  auto IsUnderConstruction = [&S](const Pointer &Ptr) {
+    for (const InterpFrame *F = S.Current; F && F->getFunction();
+         F = F->Caller) {
+      const FunctionDecl *FD = F->getFunction()->getDecl();
+      if (!isa<CXXConstructorDecl>(FD) && !isa<CXXDestructorDecl>(FD))
+        continue;
+      const Pointer &FrameThis = F->getThis();
+      if (Pointer::hasSameBase(FrameThis, Ptr) &&
+          FrameThis.getByteOffset() == Ptr.getByteOffset())
+        return true;
+    }
+    return false;
+  };
+
+  // Collect the path from the most derived object down to This.
+  SmallVector<Pointer, 4> Path;
+  Path.push_back(This);
+  while (Path.back().isBaseClass() && !IsUnderConstruction(Path.back()))
+    Path.push_back(Path.back().getBase());
+
+  // The final overrider is declared in one of the classes on the path.
+  const CXXMethodDecl *Callee = nullptr;
+  for (const Pointer &Ptr : llvm::reverse(Path)) {
+    const Record *R = Ptr.getRecord();
+    if (!R)
+      return nullptr;
+    const auto *RD = cast<CXXRecordDecl>(R->getDecl());
+    if ((Callee = MD->getCorrespondingMethodDeclaredInClass(RD, false))) {
+      This = Ptr;
+      break;
+    }
+  }
+  if (!Callee)
+    return nullptr;
+
+  const SourceInfo &E = S.Current->getSource(OpPC);
+  if (Callee->isPure()) {
+    S.FFDiag(E, diag::note_constexpr_pure_virtual_call, 1) << Callee;
+    S.Note(Callee->getLocation(), diag::note_declared_at);
+    return nullptr;
+  }
+
+  // Return types of overriders returning a pointer to a derived class
+  // would need an adjustment of the result, which is not supported yet.
+  if (!S.getCtx().hasSameType(Callee->getReturnType(), MD->getReturnType())) {
+    S.FFDiag(E, diag::note_invalid_subexpr_in_const_expr);
+    return nullptr;
+  }
+
+  Function *Func = S.Ctx.getOrCreateFunction(Callee);
+  if (!Func) {
+    S.FFDiag(E, diag::note_constexpr_invalid_function, 1)
+        << Callee->isConstexpr() << /*IsConstructor=*/0 << Callee;
+    S.Note(Callee->getLocation(), diag::note_declared_at);
+    return nullptr;
+  }
+  if (!CheckCallable(S, OpPC, Func))
+    return nullptr;
+  return Func;
+}
+
 bool CheckThis(InterpState &S, CodePtr OpPC, const Pointer &This) {
   if (!This.isZero())
     return true;
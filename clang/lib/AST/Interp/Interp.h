@@ -85,6 +85,12 @@ bool CheckInit(InterpState &S, CodePtr OpPC, const Pointer &Ptr);
 /// Checks if a method can be called.
 bool CheckCallable(InterpState &S, CodePtr OpPC, Function *F);
 
+/// Finds the final overrider of the virtual function \p MD in the dynamic
+/// type of the object \p This points into, and moves \p This to the subobject
+/// the overrider is a member of.
+Function *getVirtualOverrider(InterpState &S, CodePtr OpPC,
+                              const CXXMethodDecl *MD, Pointer &This);
+
 /// Checks the 'this' pointer.
 bool CheckThis(InterpState &S, CodePtr OpPC, const Pointer &This);
 
@@ -1265,6 +1271,18 @@ inline bool Call(InterpState &S, CodePtr &PC, const Function *Func) {
   return false;
 }
 
+inline bool CallVirt(InterpState &S, CodePtr &PC, const CXXMethodDecl *MD,
+                     uint32_t ThisOffset) {
+  // The This pointer is below the arguments, the overrider is called with
+  // the same arguments but with This adjusted to its class.
+  auto &This = *reinterpret_cast<Pointer *>(static_cast<char *>(S.Stk.top()) -
+                                            ThisOffset);
+  Function *Func = getVirtualOverrider(S, PC, MD, This);
+  if (!Func)
+    return false;
+  return Call(S, PC, Func);
+}
+
 //===----------------------------------------------------------------------===//
 // Read opcode arguments
 //===----------------------------------------------------------------------===//
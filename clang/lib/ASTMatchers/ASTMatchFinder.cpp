@@ -1024,19 +1024,47 @@ private:
     }
   }
 
+  /// Matcher indices for one node kind.
+  struct MatcherFilter {
+    /// The matchers that pass the toplevel restrict check.
+    std::vector<unsigned short> All;
+    /// The subset of \c All that does not require particular names.
+    std::vector<unsigned short> Unnamed;
+    /// The rest of \c All, indexed by each of the names they accept.
+    llvm::StringMap<std::vector<unsigned short>> ByName;
+  };
+
   void matchWithFilter(const DynTypedNode &DynNode) {
     auto Kind = DynNode.getNodeKind();
     auto it = MatcherFiltersMap.find(Kind);
     const auto &Filter =
         it != MatcherFiltersMap.end() ? it->second : getFilterForKind(Kind);
 
-    if (Filter.empty())
+    if (Filter.All.empty())
       return;
 
+    // Only try the matchers that do not require a name, and those that
+    // require the name of this node.
+    ArrayRef<unsigned short> Unnamed = Filter.All, Named;
+    if (llvm::Optional<StringRef> Name = getFilterName(DynNode)) {
+      Unnamed = Filter.Unnamed;
+      auto NamedIt = Filter.ByName.find(*Name);
+      if (NamedIt != Filter.ByName.end())
+        Named = NamedIt->second;
+    }
+
     const bool EnableCheckProfiling = Options.CheckProfiling.has_value();
     TimeBucketRegion Timer;
     auto &Matchers = this->Matchers->DeclOrStmt;
-    for (unsigned short I : Filter) {
+    // Merge both lists to run the matchers in the order they were added.
+    auto NextUnnamed = Unnamed.begin(), NextNamed = Named.begin();
+    while (NextUnnamed != Unnamed.end() || NextNamed != Named.end()) {
+      unsigned short I;
+      if (NextNamed == Named.end() ||
+          (NextUnnamed != Unnamed.end() && *NextUnnamed < *NextNamed))
+        I = *NextUnnamed++;
+      else
+        I = *NextNamed++;
       auto &MP = Matchers[I];
       if (EnableCheckProfiling)
         Timer.setBucket(&TimeByBucket[MP.second->getID()]);
@@ -1057,18 +1085,45 @@ private:
     }
   }
 
-  const std::vector<unsigned short> &getFilterForKind(ASTNodeKind Kind) {
+  const MatcherFilter &getFilterForKind(ASTNodeKind Kind) {
     auto &Filter = MatcherFiltersMap[Kind];
     auto &Matchers = this->Matchers->DeclOrStmt;
     assert((Matchers.size() < USHRT_MAX) && "Too many matchers.");
+    std::vector<StringRef> Names;
     for (unsigned I = 0, E = Matchers.size(); I != E; ++I) {
-      if (Matchers[I].first.canMatchNodesOfKind(Kind)) {
-        Filter.push_back(I);
+      if (!Matchers[I].first.canMatchNodesOfKind(Kind))
+        continue;
+      Filter.All.push_back(I);
+      Names.clear();
+      if (!Matchers[I].first.collectRequiredNames(Names)) {
+        Filter.Unnamed.push_back(I);
+        continue;
+      }
+      for (StringRef Name : Names) {
+        auto &Indices = Filter.ByName[Name];
+        if (Indices.empty() || Indices.back() != I)
+          Indices.push_back(I);
       }
     }
     return Filter;
   }
 
+  /// Returns the name that \c DynMatcherInterface::collectRequiredNames()
+  /// refers to for \p DynNode, or an empty string if the node has none.
+  /// Returns None if the node has a name that is not an identifier, as such
+  /// names are not indexed.
+  static llvm::Optional<StringRef> getFilterName(const DynTypedNode &DynNode) {
+    const Decl *D = DynNode.get<Decl>();
+    if (const auto *Call = DynNode.get<CallExpr>())
+      D = Call->getCalleeDecl();
+    const auto *ND = dyn_cast_or_null<NamedDecl>(D);
+    if (!ND)
+      return StringRef();
+    if (!ND->getIdentifier())
+      return llvm::None;
+    return ND->getName();
+  }
+
   /// @{
   /// Overloads to pair the different node types to their matchers.
   void matchDispatch(const Decl *Node) {
@@ -1315,7 +1370,10 @@ private:
   /// kind (and derived kinds) so it is a waste to try every matcher on every
   /// node.
   /// We precalculate a list of matchers that pass the toplevel restrict check.
-  llvm::DenseMap<ASTNodeKind, std::vector<unsigned short>> MatcherFiltersMap;
+  /// Many of them also only match declarations, or calls to declarations,
+  /// with particular names, e.g. \c callExpr(callee(functionDecl(hasName(
+  /// "free")))), so those are further indexed by name.
+  llvm::DenseMap<ASTNodeKind, MatcherFilter> MatcherFiltersMap;
 
   const MatchFinder::MatchFinderOptions &Options;
   ASTContext *ActiveASTContext;
@@ -18,6 +18,7 @@
 #include "clang/AST/ParentMapContext.h"
 #include "clang/AST/PrettyPrinter.h"
 #include "clang/ASTMatchers/ASTMatchers.h"
+#include "clang/Basic/CharInfo.h"
 #include "clang/Basic/LLVM.h"
 #include "clang/Lex/Lexer.h"
 #include "llvm/ADT/ArrayRef.h"
@@ -123,6 +124,31 @@ public:
     return Func(DynNode, Finder, Builder, InnerMatchers);
   }
 
+  bool collectRequiredNames(std::vector<StringRef> &Names) const override {
+    // Operands with their own traversal kind may be matched against a
+    // different node, so their names cannot be used.
+    auto CollectFrom = [&](const DynTypedMatcher &M) {
+      return !M.getTraversalKind() && M.collectRequiredNames(Names);
+    };
+    // allOf() matches only if every operand does, so the names required by
+    // any one of them are required.
+    if (Func == allOfVariadicOperator)
+      return llvm::any_of(InnerMatchers, CollectFrom);
+    // anyOf() and eachOf() match only if some operand does, so every operand
+    // must require names.
+    if (Func == anyOfVariadicOperator || Func == eachOfVariadicOperator) {
+      size_t NumNames = Names.size();
+      for (const DynTypedMatcher &M : InnerMatchers) {
+        if (!CollectFrom(M)) {
+          Names.resize(NumNames);
+          return false;
+        }
+      }
+      return true;
+    }
+    return false;
+  }
+
 private:
   std::vector<DynTypedMatcher> InnerMatchers;
 };
@@ -140,6 +166,10 @@ public:
     return Result;
   }
 
+  bool collectRequiredNames(std::vector<StringRef> &Names) const override {
+    return InnerMatcher->collectRequiredNames(Names);
+  }
+
   llvm::Optional<clang::TraversalKind> TraversalKind() const override {
     return InnerMatcher->TraversalKind();
   }
@@ -180,6 +210,10 @@ public:
     return TK;
   }
 
+  bool collectRequiredNames(std::vector<StringRef> &Names) const override {
+    return InnerMatcher->collectRequiredNames(Names);
+  }
+
 private:
   clang::TraversalKind TK;
   IntrusiveRefCntPtr<DynMatcherInterface> InnerMatcher;
@@ -664,6 +698,24 @@ bool HasNameMatcher::matchesNodeFullSlow(const NamedDecl &Node) const {
   return false;
 }
 
+bool HasNameMatcher::collectRequiredNames(
+    std::vector<StringRef> &RequiredNames) const {
+  // Every pattern ends in the name of the declaration. Patterns for names that
+  // are not identifiers, like operators, cannot be indexed.
+  size_t NumNames = RequiredNames.size();
+  for (StringRef Name : Names) {
+    size_t Pos = Name.rfind("::");
+    if (Pos != StringRef::npos)
+      Name = Name.drop_front(Pos + 2);
+    if (!isValidAsciiIdentifier(Name, /*AllowDollar=*/true)) {
+      RequiredNames.resize(NumNames);
+      return false;
+    }
+    RequiredNames.push_back(Name);
+  }
+  return true;
+}
+
 bool HasNameMatcher::matchesNode(const NamedDecl &Node) const {
   assert(matchesNodeFullFast(Node) == matchesNodeFullSlow(Node));
   if (UseUnqualifiedMatch) {
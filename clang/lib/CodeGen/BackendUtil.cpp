@@ -49,6 +49,7 @@
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/PrettyStackTrace.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/Timer.h"
 #include "llvm/Support/ToolOutputFile.h"
@@ -89,8 +90,11 @@
 #include "llvm/Transforms/Utils/EntryExitInstrumenter.h"
 #include "llvm/Transforms/Utils/ModuleUtils.h"
 #include "llvm/Transforms/Utils/NameAnonGlobals.h"
+#include "llvm/Transforms/Utils/SplitModule.h"
 #include "llvm/Transforms/Utils/SymbolRewriter.h"
+#include <atomic>
 #include <memory>
+#include <mutex>
 using namespace clang;
 using namespace llvm;
 
@@ -170,6 +174,10 @@ class EmitAssemblyHelper {
                           std::unique_ptr<raw_pwrite_stream> &OS,
                           std::unique_ptr<llvm::ToolOutputFile> &DwoOS);
 
+  /// Splits the module and emits an object file for each partition on a
+  /// separate thread, see -fparallel-codegen-output.
+  void RunParallelCodegenPipeline(raw_pwrite_stream &OS);
+
   /// Check whether we should emit a module summary for regular LTO.
   /// The module summary should be emitted by default for regular LTO
   /// except for ld64 targets.
@@ -280,6 +288,11 @@ static TargetLibraryInfoImpl *createTLII(llvm::Triple &TargetTriple,
         break;
     }
     break;
+  case CodeGenOptions::LLVMLIBC:
+    if (TargetTriple.getArch() == llvm::Triple::x86_64)
+      TLII->addVectorizableFunctionsFromVecLib(
+          TargetLibraryInfoImpl::LLVMLIBC_X86);
+    break;
   case CodeGenOptions::MASSV:
     TLII->addVectorizableFunctionsFromVecLib(TargetLibraryInfoImpl::MASSV);
     break;
@@ -1032,6 +1045,13 @@ void EmitAssemblyHelper::RunOptimizationPipeline(
 void EmitAssemblyHelper::RunCodegenPipeline(
     BackendAction Action, std::unique_ptr<raw_pwrite_stream> &OS,
     std::unique_ptr<llvm::ToolOutputFile> &DwoOS) {
+  // The driver does not allow -fparallel-codegen with -gsplit-dwarf.
+  if (Action == Backend_EmitObj && !CodeGenOpts.ParallelCodeGenOutputs.empty() &&
+      CodeGenOpts.SplitDwarfOutput.empty()) {
+    RunParallelCodegenPipeline(*OS);
+    return;
+  }
+
   // We still use the legacy PM to run the codegen pipeline since the new PM
   // does not work with the codegen pipeline.
   // FIXME: make the new PM work with the codegen pipeline.
@@ -1065,6 +1085,116 @@ void EmitAssemblyHelper::RunCodegenPipeline(
   }
 }
 
+namespace {
+/// Forwards the diagnostics of a partition that is code generated on another
+/// thread, in its own context, to the handler of the original module.
+class PartitionDiagnosticHandler final : public DiagnosticHandler {
+public:
+  PartitionDiagnosticHandler(LLVMContext &MainCtx, std::mutex &Lock)
+      : MainCtx(MainCtx), Lock(Lock) {}
+
+  bool handleDiagnostics(const DiagnosticInfo &DI) override {
+    std::lock_guard<std::mutex> Guard(Lock);
+    MainCtx.diagnose(DI);
+    return true;
+  }
+
+  bool isAnalysisRemarkEnabled(StringRef PassName) const override {
+    return MainCtx.getDiagHandlerPtr()->isAnalysisRemarkEnabled(PassName);
+  }
+  bool isMissedOptRemarkEnabled(StringRef PassName) const override {
+    return MainCtx.getDiagHandlerPtr()->isMissedOptRemarkEnabled(PassName);
+  }
+  bool isPassedOptRemarkEnabled(StringRef PassName) const override {
+    return MainCtx.getDiagHandlerPtr()->isPassedOptRemarkEnabled(PassName);
+  }
+  bool isAnyRemarkEnabled() const override {
+    return MainCtx.getDiagHandlerPtr()->isAnyRemarkEnabled();
+  }
+
+private:
+  LLVMContext &MainCtx;
+  std::mutex &Lock;
+};
+} // namespace
+
+void EmitAssemblyHelper::RunParallelCodegenPipeline(raw_pwrite_stream &OS) {
+  SmallVector<std::unique_ptr<llvm::ToolOutputFile>, 4> PartitionFiles;
+  SmallVector<raw_pwrite_stream *, 4> OSs = {&OS};
+  for (const std::string &Path : CodeGenOpts.ParallelCodeGenOutputs) {
+    PartitionFiles.push_back(openOutputFile(Path));
+    if (!PartitionFiles.back())
+      return;
+    OSs.push_back(&PartitionFiles.back()->os());
+  }
+
+  // Each partition is code generated in its own context. Like ParallelCG, the
+  // partitions are moved there through bitcode, which is written here since
+  // the original context can't be used from several threads.
+  SmallVector<SmallString<0>, 4> Partitions;
+  {
+    PrettyStackTraceString CrashInfo("Splitting module for code generation");
+    llvm::TimeTraceScope TimeScope("SplitModule");
+    SplitModule(
+        *TheModule, OSs.size(),
+        [&](std::unique_ptr<Module> MPart) {
+          raw_svector_ostream BCOS(Partitions.emplace_back());
+          WriteBitcodeToFile(*MPart, BCOS);
+        },
+        /*PreserveLocals=*/false);
+  }
+
+  std::mutex DiagLock;
+  std::atomic<bool> Failed(false);
+  {
+    llvm::TimeTraceScope TimeScope("CodeGenPasses");
+    ThreadPool Pool(hardware_concurrency(OSs.size()));
+    for (unsigned I = 0, E = OSs.size(); I != E; ++I) {
+      Pool.async([&, I] {
+        LLVMContext Ctx;
+        Ctx.setDiagnosticHandler(std::make_unique<PartitionDiagnosticHandler>(
+            TheModule->getContext(), DiagLock));
+        Expected<std::unique_ptr<Module>> MPart = parseBitcodeFile(
+            MemoryBufferRef(Partitions[I], "<split-module>"), Ctx);
+        if (!MPart)
+          report_fatal_error("Failed to read bitcode");
+
+        std::unique_ptr<TargetMachine> PartTM(
+            TM->getTarget().createTargetMachine(
+                TargetTriple.str(), TM->getTargetCPU(),
+                TM->getTargetFeatureString(), TM->Options,
+                TM->getRelocationModel(), TM->getCodeModel(),
+                TM->getOptLevel()));
+
+        // This mirrors RunCodegenPipeline() and AddEmitPasses().
+        legacy::PassManager CodeGenPasses;
+        CodeGenPasses.add(
+            createTargetTransformInfoWrapperPass(PartTM->getTargetIRAnalysis()));
+        Triple PartTriple(TargetTriple);
+        std::unique_ptr<TargetLibraryInfoImpl> TLII(
+            createTLII(PartTriple, CodeGenOpts));
+        CodeGenPasses.add(new TargetLibraryInfoWrapperPass(*TLII));
+        if (CodeGenOpts.OptimizationLevel > 0)
+          CodeGenPasses.add(createObjCARCContractPass());
+        if (PartTM->addPassesToEmitFile(
+                CodeGenPasses, *OSs[I], nullptr, CGFT_ObjectFile,
+                /*DisableVerify=*/!CodeGenOpts.VerifyModule)) {
+          Failed = true;
+          return;
+        }
+        CodeGenPasses.run(**MPart);
+      });
+    }
+  }
+
+  if (Failed) {
+    Diags.Report(diag::err_fe_unable_to_interface_with_target);
+    return;
+  }
+  for (auto &File : PartitionFiles)
+    File->keep();
+}
+
 void EmitAssemblyHelper::EmitAssembly(BackendAction Action,
                                       std::unique_ptr<raw_pwrite_stream> OS) {
   TimeRegion Region(CodeGenOpts.TimePasses ? &CodeGenerationTime : nullptr);
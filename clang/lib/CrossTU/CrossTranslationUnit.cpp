@@ -250,29 +250,43 @@ CrossTranslationUnitContext::getLookupName(const NamedDecl *ND) {
   return std::string(DeclUSR.str());
 }
 
-/// Recursively visits the decls of a DeclContext, and returns one with the
-/// given USR.
-template <typename T>
-const T *
-CrossTranslationUnitContext::findDefInDeclContext(const DeclContext *DC,
-                                                  StringRef LookupName) {
+/// Recursively visits the decls of a DeclContext, and records the definitions
+/// of functions and variables by their USR. If several definitions have the
+/// same USR, the first one found is kept.
+void CrossTranslationUnitContext::collectDefinitions(const DeclContext *DC,
+                                                     DefinitionMapTy &Defs) {
   assert(DC && "Declaration Context must not be null");
   for (const Decl *D : DC->decls()) {
-    const auto *SubDC = dyn_cast<DeclContext>(D);
-    if (SubDC)
-      if (const auto *ND = findDefInDeclContext<T>(SubDC, LookupName))
-        return ND;
-
-    const auto *ND = dyn_cast<T>(D);
-    const T *ResultDecl;
-    if (!ND || !hasBodyOrInit(ND, ResultDecl))
-      continue;
-    llvm::Optional<std::string> ResultLookupName = getLookupName(ResultDecl);
-    if (!ResultLookupName || *ResultLookupName != LookupName)
+    if (const auto *SubDC = dyn_cast<DeclContext>(D))
+      collectDefinitions(SubDC, Defs);
+
+    const NamedDecl *ResultDecl = nullptr;
+    if (const auto *FD = dyn_cast<FunctionDecl>(D)) {
+      const FunctionDecl *Def;
+      if (hasBodyOrInit(FD, Def))
+        ResultDecl = Def;
+    } else if (const auto *VD = dyn_cast<VarDecl>(D)) {
+      const VarDecl *Def;
+      if (hasBodyOrInit(VD, Def))
+        ResultDecl = Def;
+    }
+    if (!ResultDecl)
       continue;
-    return ResultDecl;
+    if (llvm::Optional<std::string> ResultLookupName =
+            getLookupName(ResultDecl))
+      Defs.try_emplace(*ResultLookupName, ResultDecl);
   }
-  return nullptr;
+}
+
+/// Returns the definition with the given USR in \p Unit.
+template <typename T>
+const T *CrossTranslationUnitContext::findDefInUnit(ASTUnit *Unit,
+                                                    StringRef LookupName) {
+  auto It = UnitDefinitions.try_emplace(Unit);
+  if (It.second)
+    collectDefinitions(Unit->getASTContext().getTranslationUnitDecl(),
+                       It.first->second);
+  return dyn_cast_or_null<T>(It.first->second.lookup(LookupName));
 }
 
 template <typename T>
@@ -343,8 +357,7 @@ llvm::Expected<const T *> CrossTranslationUnitContext::getCrossTUDefinitionImpl(
         index_error_code::lang_dialect_mismatch);
   }
 
-  TranslationUnitDecl *TU = Unit->getASTContext().getTranslationUnitDecl();
-  if (const T *ResultDecl = findDefInDeclContext<T>(TU, *LookupName))
+  if (const T *ResultDecl = findDefInUnit<T>(Unit, *LookupName))
     return importDefinition(ResultDecl, Unit);
   return llvm::make_error<IndexError>(index_error_code::failed_import);
 }
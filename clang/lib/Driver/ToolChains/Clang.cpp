@@ -5725,6 +5725,32 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
     }
   }
 
+  if (Arg *A = Args.getLastArg(options::OPT_fparallel_codegen_EQ)) {
+    StringRef Val = A->getValue();
+    unsigned Partitions;
+    if (Val.getAsInteger(10, Partitions) || Partitions == 0)
+      D.Diag(diag::err_drv_invalid_int_value) << A->getAsString(Args) << Val;
+    else if (!Args.hasArg(options::OPT_c) || !Output.isFilename() ||
+             Output.getType() != types::TY_Object)
+      // The partitions are separate objects, there is nothing to link them
+      // into a single one.
+      D.Diag(diag::err_drv_argument_only_allowed_with)
+          << A->getAsString(Args) << "-c";
+    else if (llvm::any_of(CmdArgs, [](const char *Arg) {
+               return StringRef(Arg) == "-split-dwarf-output";
+             }))
+      D.Diag(diag::err_drv_argument_not_allowed_with)
+          << A->getAsString(Args) << "-gsplit-dwarf";
+    else
+      for (unsigned I = 1; I < Partitions; ++I) {
+        const char *Path = Args.MakeArgString(Twine(Output.getFilename()) +
+                                              "." + Twine(I) + ".o");
+        C.addResultFile(Path, &JA);
+        CmdArgs.push_back(
+            Args.MakeArgString(Twine("-fparallel-codegen-output=") + Path));
+      }
+  }
+
   Args.AddLastArg(CmdArgs, options::OPT_finstrument_functions,
                   options::OPT_finstrument_functions_after_inlining,
                   options::OPT_finstrument_function_entry_bare);
@@ -6315,6 +6341,7 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
   Args.AddLastArg(CmdArgs, options::OPT_ftime_report_EQ);
   Args.AddLastArg(CmdArgs, options::OPT_ftime_trace);
   Args.AddLastArg(CmdArgs, options::OPT_ftime_trace_granularity_EQ);
+  Args.AddLastArg(CmdArgs, options::OPT_ftime_trace_memory);
   Args.AddLastArg(CmdArgs, options::OPT_ftime_trace_EQ);
   Args.AddLastArg(CmdArgs, options::OPT_ftrapv);
   Args.AddLastArg(CmdArgs, options::OPT_malign_double);
@@ -71,6 +71,9 @@ CompilerInstance::CompilerInstance(
 
 CompilerInstance::~CompilerInstance() {
   assert(OutputFiles.empty() && "Still output files in flight?");
+  // The time profiler may outlive the ASTContext.
+  if (Context && hasInvocation() && getFrontendOpts().TimeTraceMemory)
+    llvm::timeTraceProfilerSetMemoryCounter(nullptr);
 }
 
 void CompilerInstance::setInvocation(
@@ -177,6 +180,14 @@ void CompilerInstance::setPreprocessor(std::shared_ptr<Preprocessor> Value) {
 void CompilerInstance::setASTContext(ASTContext *Value) {
   Context = Value;
 
+  if (getFrontendOpts().TimeTraceMemory) {
+    if (Value)
+      llvm::timeTraceProfilerSetMemoryCounter(
+          [Value] { return Value->getASTAllocatedBytes(); });
+    else
+      llvm::timeTraceProfilerSetMemoryCounter(nullptr);
+  }
+
   if (Context && Consumer)
     getASTConsumer().Initialize(getASTContext());
 }
@@ -1684,6 +1695,8 @@ void CompilerInstance::createASTReader() {
       /*AllowConfigurationMismatch=*/false, HSOpts.ModulesValidateSystemHeaders,
       HSOpts.ValidateASTInputFilesContent,
       getFrontendOpts().UseGlobalModuleIndex, std::move(ReadTimer));
+  TheASTReader->setPrefetchIdentifierTables(
+      getFrontendOpts().PrefetchModuleIdentifierTables);
   if (hasASTConsumer()) {
     TheASTReader->setDeserializationListener(
         getASTConsumer().GetASTDeserializationListener());
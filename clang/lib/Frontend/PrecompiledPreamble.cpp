@@ -27,10 +27,12 @@
 #include "llvm/ADT/iterator_range.h"
 #include "llvm/Config/llvm-config.h"
 #include "llvm/Support/CrashRecoveryContext.h"
+#include "llvm/Support/EndianStream.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Process.h"
 #include "llvm/Support/VirtualFileSystem.h"
+#include "llvm/Support/raw_ostream.h"
 #include <limits>
 #include <mutex>
 #include <utility>
@@ -710,6 +712,135 @@ void PrecompiledPreamble::OverridePreamble(
   configurePreamble(Bounds, CI, VFS, MainFileBuffer);
 }
 
+// Bump this whenever the layout written by serialize() changes.
+static constexpr llvm::StringLiteral SerializedPreambleMagic = "CLANGPRE1";
+
+std::error_code PrecompiledPreamble::serialize(llvm::raw_ostream &OS) const {
+  std::unique_ptr<llvm::MemoryBuffer> PCHFile;
+  StringRef PCH;
+  if (Storage->getKind() == PCHStorage::Kind::InMemory) {
+    PCH = Storage->memoryContents();
+  } else {
+    auto Buf = llvm::MemoryBuffer::getFile(Storage->filePath());
+    if (!Buf)
+      return Buf.getError();
+    PCHFile = std::move(*Buf);
+    PCH = PCHFile->getBuffer();
+  }
+
+  llvm::support::endian::Writer W(OS, llvm::support::little);
+  auto WriteString = [&](StringRef S) {
+    W.write<uint32_t>(S.size());
+    OS << S;
+  };
+  OS << SerializedPreambleMagic;
+  W.write<uint8_t>(PreambleEndsAtStartOfLine);
+  WriteString(StringRef(PreambleBytes.data(), PreambleBytes.size()));
+
+  // Sort the file lists so that identical preambles serialize identically.
+  std::vector<const llvm::StringMapEntry<PreambleFileHash> *> Files;
+  for (const auto &F : FilesInPreamble)
+    Files.push_back(&F);
+  llvm::sort(Files, [](const auto *L, const auto *R) {
+    return L->getKey() < R->getKey();
+  });
+  W.write<uint32_t>(Files.size());
+  for (const auto *F : Files) {
+    WriteString(F->getKey());
+    W.write<uint64_t>(F->getValue().Size);
+    W.write<int64_t>(F->getValue().ModTime);
+    const llvm::MD5::MD5Result &MD5 = F->getValue().MD5;
+    OS.write(reinterpret_cast<const char *>(MD5.data()), MD5.size());
+  }
+
+  std::vector<StringRef> Missing;
+  for (const auto &F : MissingFiles)
+    Missing.push_back(F.getKey());
+  llvm::sort(Missing);
+  W.write<uint32_t>(Missing.size());
+  for (StringRef F : Missing)
+    WriteString(F);
+
+  W.write<uint64_t>(PCH.size());
+  OS << PCH;
+  return {};
+}
+
+llvm::ErrorOr<PrecompiledPreamble>
+PrecompiledPreamble::deserialize(StringRef Data, bool StoreInMemory) {
+  const std::error_code Malformed =
+      std::make_error_code(std::errc::invalid_argument);
+  bool Failed = false;
+  auto Consume = [&](size_t N) -> StringRef {
+    if (Failed || Data.size() < N) {
+      Failed = true;
+      return {};
+    }
+    StringRef Result = Data.take_front(N);
+    Data = Data.drop_front(N);
+    return Result;
+  };
+  auto Read = [&](auto Value) {
+    using T = decltype(Value);
+    StringRef Bytes = Consume(sizeof(T));
+    if (Failed)
+      return T();
+    return llvm::support::endian::read<T, llvm::support::little,
+                                       llvm::support::unaligned>(Bytes.data());
+  };
+  auto ReadString = [&] { return Consume(Read(uint32_t())); };
+
+  if (Consume(SerializedPreambleMagic.size()) != SerializedPreambleMagic)
+    return Malformed;
+  bool PreambleEndsAtStartOfLine = Read(uint8_t());
+  StringRef Bytes = ReadString();
+  std::vector<char> PreambleBytes(Bytes.begin(), Bytes.end());
+
+  llvm::StringMap<PreambleFileHash> FilesInPreamble;
+  for (uint32_t I = 0, E = Read(uint32_t()); I < E && !Failed; ++I) {
+    StringRef Name = ReadString();
+    PreambleFileHash &Hash = FilesInPreamble[Name];
+    Hash.Size = Read(uint64_t());
+    Hash.ModTime = Read(int64_t());
+    StringRef MD5 = Consume(Hash.MD5.size());
+    if (!Failed)
+      std::copy(MD5.begin(), MD5.end(), Hash.MD5.begin());
+  }
+
+  llvm::StringSet<> MissingFiles;
+  for (uint32_t I = 0, E = Read(uint32_t()); I < E && !Failed; ++I)
+    MissingFiles.insert(ReadString());
+
+  StringRef PCH = Consume(Read(uint64_t()));
+  if (Failed || !Data.empty())
+    return Malformed;
+
+  std::unique_ptr<PCHStorage> Storage;
+  if (StoreInMemory) {
+    auto Buffer = std::make_shared<PCHBuffer>();
+    Buffer->Data.assign(PCH.begin(), PCH.end());
+    Buffer->IsComplete = true;
+    Storage = PCHStorage::inMemory(std::move(Buffer));
+  } else {
+    std::unique_ptr<TempPCHFile> PreamblePCHFile = TempPCHFile::create();
+    if (!PreamblePCHFile)
+      return BuildPreambleError::CouldntCreateTempFile;
+    std::error_code EC;
+    llvm::raw_fd_ostream OS(PreamblePCHFile->getFilePath(), EC);
+    if (EC)
+      return EC;
+    OS << PCH;
+    OS.close();
+    if (OS.has_error())
+      return OS.error();
+    Storage = PCHStorage::file(std::move(PreamblePCHFile));
+  }
+  return PrecompiledPreamble(std::move(Storage), std::move(PreambleBytes),
+                             PreambleEndsAtStartOfLine,
+                             std::move(FilesInPreamble),
+                             std::move(MissingFiles));
+}
+
 PrecompiledPreamble::PrecompiledPreamble(
     std::unique_ptr<PCHStorage> Storage, std::vector<char> PreambleBytes,
     bool PreambleEndsAtStartOfLine,
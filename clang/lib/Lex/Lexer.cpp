@@ -48,6 +48,15 @@
 #include <tuple>
 #include <utility>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#elif __ALTIVEC__
+#include <altivec.h>
+#undef bool
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 using namespace clang;
 
 //===----------------------------------------------------------------------===//
@@ -1759,9 +1768,159 @@ bool Lexer::LexUnicodeIdentifierStart(Token &Result, uint32_t C,
   return true;
 }
 
+//===----------------------------------------------------------------------===//
+// Vectorized scanning
+//===----------------------------------------------------------------------===//
+//
+// The skip* functions below advance over a run of characters of one class,
+// 16 at a time, for the lexer's hot loops. They stop at the first character
+// outside the class or when less than 16 characters are left in the buffer,
+// and the caller's byte-at-a-time loop takes over from there, so they never
+// change how anything is lexed. Without SSE2 or NEON they return CurPtr.
+
+#if defined(__SSE2__) || (defined(__ARM_NEON) && defined(__aarch64__))
+#define CLANG_LEXER_VECTOR_SCAN 1
+
+namespace {
+#ifdef __SSE2__
+// Comparisons are signed, which works for the ASCII ranges we need: bytes of
+// non-ASCII characters are negative and never in them.
+using ByteVector = __m128i;
+ByteVector loadBytes(const char *Ptr) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i *>(Ptr));
+}
+ByteVector splat(char C) { return _mm_set1_epi8(C); }
+ByteVector either(ByteVector A, ByteVector B) { return _mm_or_si128(A, B); }
+ByteVector equal(ByteVector V, char C) { return _mm_cmpeq_epi8(V, splat(C)); }
+ByteVector inRange(ByteVector V, char Lo, char Hi) {
+  return _mm_and_si128(_mm_cmpgt_epi8(V, splat(Lo - 1)),
+                       _mm_cmplt_epi8(V, splat(Hi + 1)));
+}
+ByteVector nonASCII(ByteVector V) {
+  return _mm_cmplt_epi8(V, _mm_setzero_si128());
+}
+// The number of leading lanes that are set, each lane being 0 or 0xff.
+unsigned countLeadingSet(ByteVector Mask) {
+  return llvm::countTrailingOnes<unsigned>(_mm_movemask_epi8(Mask));
+}
+unsigned countLeadingClear(ByteVector Mask) {
+  return llvm::countTrailingZeros<unsigned>(_mm_movemask_epi8(Mask) | 0x10000);
+}
+#else
+using ByteVector = uint8x16_t;
+ByteVector loadBytes(const char *Ptr) {
+  return vld1q_u8(reinterpret_cast<const uint8_t *>(Ptr));
+}
+ByteVector splat(char C) { return vdupq_n_u8(C); }
+ByteVector either(ByteVector A, ByteVector B) { return vorrq_u8(A, B); }
+ByteVector equal(ByteVector V, char C) { return vceqq_u8(V, splat(C)); }
+ByteVector inRange(ByteVector V, char Lo, char Hi) {
+  return vandq_u8(vcgeq_u8(V, splat(Lo)), vcleq_u8(V, splat(Hi)));
+}
+ByteVector nonASCII(ByteVector V) { return vcgeq_u8(V, vdupq_n_u8(0x80)); }
+// NEON has no movemask; narrowing gives four bits per lane instead.
+uint64_t nibbleMask(ByteVector Mask) {
+  return vget_lane_u64(
+      vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(Mask), 4)), 0);
+}
+unsigned countLeadingSet(ByteVector Mask) {
+  return llvm::countTrailingOnes(nibbleMask(Mask)) / 4;
+}
+unsigned countLeadingClear(ByteVector Mask) {
+  uint64_t Nibbles = nibbleMask(Mask);
+  return Nibbles ? llvm::countTrailingZeros(Nibbles) / 4 : 16;
+}
+#endif
+} // namespace
+
+/// Advance while \p InClass sets the lanes of the characters.
+template <typename ClassifierT>
+static const char *skipWhileSet(const char *CurPtr, const char *BufferEnd,
+                                ClassifierT InClass) {
+  while (BufferEnd - CurPtr >= 16) {
+    unsigned N = countLeadingSet(InClass(loadBytes(CurPtr)));
+    CurPtr += N;
+    if (N != 16)
+      break;
+  }
+  return CurPtr;
+}
+
+/// Advance until \p Stop sets the lane of a character.
+template <typename ClassifierT>
+static const char *skipUntilSet(const char *CurPtr, const char *BufferEnd,
+                                ClassifierT Stop) {
+  while (BufferEnd - CurPtr >= 16) {
+    unsigned N = countLeadingClear(Stop(loadBytes(CurPtr)));
+    CurPtr += N;
+    if (N != 16)
+      break;
+  }
+  return CurPtr;
+}
+#endif
+
+/// Skip [_A-Za-z0-9]*.
+static const char *skipAsciiIdentifierContinue(const char *CurPtr,
+                                               const char *BufferEnd) {
+#ifdef CLANG_LEXER_VECTOR_SCAN
+  CurPtr = skipWhileSet(CurPtr, BufferEnd, [](ByteVector V) {
+    // Setting bit 5 maps upper case letters to lower case ones, and nothing
+    // else into [a-z].
+    return either(either(inRange(either(V, splat(0x20)), 'a', 'z'),
+                         inRange(V, '0', '9')),
+                  equal(V, '_'));
+  });
+#endif
+  return CurPtr;
+}
+
+/// Skip [ \t\f\v]*.
+static const char *skipHorizontalWhitespace(const char *CurPtr,
+                                            const char *BufferEnd) {
+#ifdef CLANG_LEXER_VECTOR_SCAN
+  // Most runs are a single space, don't pay for a vector load for those.
+  if (CurPtr[0] != ' ' || !isHorizontalWhitespace(CurPtr[1]))
+    return CurPtr;
+  CurPtr = skipWhileSet(CurPtr, BufferEnd, [](ByteVector V) {
+    return either(either(equal(V, ' '), equal(V, '\t')),
+                  either(equal(V, '\f'), equal(V, '\v')));
+  });
+#endif
+  return CurPtr;
+}
+
+/// Skip ASCII characters other than newlines and NUL, the ones the line
+/// comment loop doesn't need to look at.
+static const char *skipLineCommentBody(const char *CurPtr,
+                                       const char *BufferEnd) {
+#ifdef CLANG_LEXER_VECTOR_SCAN
+  CurPtr = skipUntilSet(CurPtr, BufferEnd, [](ByteVector V) {
+    return either(either(nonASCII(V), equal(V, 0)),
+                  either(equal(V, '\n'), equal(V, '\r')));
+  });
+#endif
+  return CurPtr;
+}
+
+/// Skip characters of a string literal that getAndAdvanceChar() would return
+/// as they are and that don't end or escape anything.
+static const char *skipStringLiteralBody(const char *CurPtr,
+                                         const char *BufferEnd) {
+#ifdef CLANG_LEXER_VECTOR_SCAN
+  CurPtr = skipUntilSet(CurPtr, BufferEnd, [](ByteVector V) {
+    return either(either(either(equal(V, '"'), equal(V, '\\')),
+                         either(equal(V, '?'), equal(V, 0))),
+                  either(equal(V, '\n'), equal(V, '\r')));
+  });
+#endif
+  return CurPtr;
+}
+
 bool Lexer::LexIdentifierContinue(Token &Result, const char *CurPtr) {
   // Match [_A-Za-z0-9]*, we have already matched an identifier start.
   while (true) {
+    CurPtr = skipAsciiIdentifierContinue(CurPtr, BufferEnd);
     unsigned char C = *CurPtr;
     // Fast path.
     if (isAsciiIdentifierContinue(C)) {
@@ -2025,6 +2184,7 @@ bool Lexer::LexStringLiteral(Token &Result, const char *CurPtr,
     Diag(BufferPtr, LangOpts.CPlusPlus ? diag::warn_cxx98_compat_unicode_literal
                                        : diag::warn_c99_compat_unicode_literal);
 
+  CurPtr = skipStringLiteralBody(CurPtr, BufferEnd);
   char C = getAndAdvanceChar(CurPtr, Result);
   while (C != '"') {
     // Skip escaped characters.  Escaped newlines will already be processed by
@@ -2053,6 +2213,7 @@ bool Lexer::LexStringLiteral(Token &Result, const char *CurPtr,
 
       NulCharacter = CurPtr-1;
     }
+    CurPtr = skipStringLiteralBody(CurPtr, BufferEnd);
     C = getAndAdvanceChar(CurPtr, Result);
   }
 
@@ -2316,6 +2477,8 @@ bool Lexer::SkipWhitespace(Token &Result, const char *CurPtr,
   // Skip consecutive spaces efficiently.
   while (true) {
     // Skip horizontal whitespace very aggressively.
+    CurPtr = skipHorizontalWhitespace(CurPtr, BufferEnd);
+    Char = *CurPtr;
     while (isHorizontalWhitespace(Char))
       Char = *++CurPtr;
 
@@ -2401,6 +2564,11 @@ bool Lexer::SkipLineComment(Token &Result, const char *CurPtr,
 
   char C;
   while (true) {
+    if (const char *Skipped = skipLineCommentBody(CurPtr, BufferEnd);
+        Skipped != CurPtr) {
+      CurPtr = Skipped;
+      UnicodeDecodingAlreadyDiagnosed = false;
+    }
     C = *CurPtr;
     // Skip over characters in the fast loop.
     while (isASCII(C) && C != 0 &&   // Potentially EOF.
@@ -2639,13 +2807,6 @@ static bool isEndOfBlockCommentWithEscapedNewLine(const char *CurPtr, Lexer *L,
   return true;
 }
 
-#ifdef __SSE2__
-#include <emmintrin.h>
-#elif __ALTIVEC__
-#include <altivec.h>
-#undef bool
-#endif
-
 /// We have just read from input the / and * characters that started a comment.
 /// Read until we find the * and / characters that terminate the comment.
 /// Note that we don't bother decoding trigraphs or escaped newlines in block
@@ -3525,9 +3686,9 @@ LexStart:
 
   // Small amounts of horizontal whitespace is very common between tokens.
   if (isHorizontalWhitespace(*CurPtr)) {
-    do {
+    CurPtr = skipHorizontalWhitespace(CurPtr, BufferEnd);
+    while (isHorizontalWhitespace(*CurPtr))
       ++CurPtr;
-    } while (isHorizontalWhitespace(*CurPtr));
 
     // If we are keeping whitespace and other tokens, just return what we just
     // skipped.  The next lexer invocation will return the token after the
@@ -47,9 +47,10 @@ MacroArgs *MacroArgs::create(const MacroInfo *MI,
   MacroArgs *Result;
   if (!ResultEnt) {
     // Allocate memory for a MacroArgs object with the lexer tokens at the end,
-    // and construct the MacroArgs object.
-    Result = new (
-        llvm::safe_malloc(totalSizeToAlloc<Token>(UnexpArgTokens.size())))
+    // and construct the MacroArgs object.  The memory lives as long as the
+    // preprocessor, the object is recycled through the free list.
+    Result = new (PP.getPreprocessorAllocator().Allocate(
+        totalSizeToAlloc<Token>(UnexpArgTokens.size()), alignof(MacroArgs)))
         MacroArgs(UnexpArgTokens.size(), VarargsElided, MI->getNumParams());
   } else {
     Result = *ResultEnt;
@@ -76,10 +77,9 @@ MacroArgs *MacroArgs::create(const MacroInfo *MI,
 /// destroy - Destroy and deallocate the memory for this object.
 ///
 void MacroArgs::destroy(Preprocessor &PP) {
-  // Don't clear PreExpArgTokens, just clear the entries.  Clearing the entries
-  // would deallocate the element vectors.
-  for (unsigned i = 0, e = PreExpArgTokens.size(); i != e; ++i)
-    PreExpArgTokens[i].clear();
+  assert(PreExpArgTokensStart == ~0U &&
+         "pre-expanded arguments should have been discarded");
+  PreExpArgTokens.clear();
 
   // Add this to the preprocessor's free list.
   ArgCache = PP.MacroArgCache;
@@ -91,12 +91,11 @@ void MacroArgs::destroy(Preprocessor &PP) {
 MacroArgs *MacroArgs::deallocate() {
   MacroArgs *Next = ArgCache;
 
-  // Run the dtor to deallocate the vectors.
-  this->~MacroArgs();
-  // Release the memory for the object.
+  // Run the dtor to deallocate the vectors.  The memory for the object is
+  // released with the preprocessor's allocator.
   static_assert(std::is_trivially_destructible_v<Token>,
                 "assume trivially destructible and forego destructors");
-  free(this);
+  this->~MacroArgs();
 
   return Next;
 }
@@ -158,16 +157,19 @@ bool MacroArgs::ArgNeedsPreexpansion(const Token *ArgTok,
 
 /// getPreExpArgument - Return the pre-expanded form of the specified
 /// argument.
-const std::vector<Token> &MacroArgs::getPreExpArgument(unsigned Arg,
-                                                       Preprocessor &PP) {
+ArrayRef<Token> MacroArgs::getPreExpArgument(unsigned Arg, Preprocessor &PP) {
   assert(Arg < getNumMacroArguments() && "Invalid argument number!");
+  SmallVectorImpl<Token> &Stack = PP.PreExpandedArgTokens;
 
   // If we have already computed this, return it.
   if (PreExpArgTokens.size() < getNumMacroArguments())
     PreExpArgTokens.resize(getNumMacroArguments());
 
-  std::vector<Token> &Result = PreExpArgTokens[Arg];
-  if (!Result.empty()) return Result;
+  if (PreExpArgTokens[Arg].second)
+    return makeArrayRef(Stack).slice(PreExpArgTokens[Arg].first,
+                                     PreExpArgTokens[Arg].second);
+  if (PreExpArgTokensStart == ~0U)
+    PreExpArgTokensStart = Stack.size();
 
   SaveAndRestore<bool> PreExpandingMacroArgs(PP.InMacroArgPreExpansion, true);
 
@@ -181,12 +183,15 @@ const std::vector<Token> &MacroArgs::getPreExpArgument(unsigned Arg,
   PP.EnterTokenStream(AT, NumToks, false /*disable expand*/,
                       false /*owns tokens*/, false /*is reinject*/);
 
-  // Lex all of the macro-expanded tokens into Result.
+  // Lex all of the macro-expanded tokens onto the stack.  Expanding macros in
+  // the argument pushes and pops their own arguments while we lex, so don't
+  // hold references into the stack.
+  unsigned Start = Stack.size();
+  Token Tok;
   do {
-    Result.push_back(Token());
-    Token &Tok = Result.back();
     PP.Lex(Tok);
-  } while (Result.back().isNot(tok::eof));
+    Stack.push_back(Tok);
+  } while (Tok.isNot(tok::eof));
 
   // Pop the token stream off the top of the stack.  We know that the internal
   // pointer inside of it is to the "end" of the token stream, but the stack
@@ -196,7 +201,20 @@ const std::vector<Token> &MacroArgs::getPreExpArgument(unsigned Arg,
   if (PP.InCachingLexMode())
     PP.ExitCachingLexMode();
   PP.RemoveTopOfLexerStack();
-  return Result;
+  PreExpArgTokens[Arg] = {Start, Stack.size() - Start};
+  return makeArrayRef(Stack).slice(Start);
+}
+
+/// discardPreExpArguments - Release the pre-expanded arguments of this
+/// invocation, once the expansion of the macro has been built.
+void MacroArgs::discardPreExpArguments(Preprocessor &PP) {
+  if (PreExpArgTokensStart == ~0U)
+    return;
+  assert(PreExpArgTokensStart <= PP.PreExpandedArgTokens.size() &&
+         "pre-expanded arguments were not discarded in order");
+  PP.PreExpandedArgTokens.truncate(PreExpArgTokensStart);
+  PreExpArgTokensStart = ~0U;
+  PreExpArgTokens.clear();
 }
 
 
@@ -453,7 +453,7 @@ void TokenLexer::ExpandFunctionArguments() {
       // avoids some work in common cases.
       const Token *ArgTok = ActualArgs->getUnexpArgument(ArgNo);
       if (ActualArgs->ArgNeedsPreexpansion(ArgTok, PP))
-        ResultArgToks = &ActualArgs->getPreExpArgument(ArgNo, PP)[0];
+        ResultArgToks = ActualArgs->getPreExpArgument(ArgNo, PP).data();
       else
         ResultArgToks = ArgTok;  // Use non-preexpanded tokens.
 
@@ -596,6 +596,9 @@ void TokenLexer::ExpandFunctionArguments() {
                                    Macro, ArgNo, PP);
   }
 
+  // The pre-expanded arguments have been copied into ResultToks.
+  ActualArgs->discardPreExpArguments(PP);
+
   // If anything changed, install this as the new Tokens list.
   if (MadeChange) {
     assert(!OwnsTokens && "This would leak if we already own the token list");
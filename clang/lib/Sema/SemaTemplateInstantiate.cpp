@@ -3698,6 +3698,17 @@ Sema::InstantiateClassMembers(SourceLocation PointOfInstantiation,
         } else if (TSK == TSK_ImplicitInstantiation) {
           PendingLocalImplicitInstantiations.push_back(
               std::make_pair(Function, PointOfInstantiation));
+        } else if (TSK == TSK_ExplicitInstantiationDeclaration &&
+                   TUKind == TU_Prefix && LangOpts.PCHInstantiateTemplates &&
+                   Pattern->isInlined() && Pattern->isDefined()) {
+          // Every TU that uses an inline member of a class named in an
+          // explicit instantiation declaration instantiates it. The explicit
+          // instantiation definition elsewhere in the program instantiates
+          // them all anyway, so instantiate them once in the PCH and let the
+          // TUs that include it reuse the definitions.
+          Function->setInstantiationIsPending(true);
+          PendingInstantiations.push_back(
+              std::make_pair(Function, PointOfInstantiation));
         }
       }
     } else if (auto *Var = dyn_cast<VarDecl>(D)) {
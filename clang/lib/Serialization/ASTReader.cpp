@@ -122,6 +122,7 @@
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/SaveAndRestore.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/Timer.h"
 #include "llvm/Support/VersionTuple.h"
@@ -1997,6 +1998,36 @@ void ASTReader::ReadDefinedMacros() {
   }
 }
 
+/// Returns the bit that represents an identifier with hash \p Hash in a
+/// ModuleFile::IdentifierFilter of \p Size bits, a power of two.
+static unsigned getIdentifierFilterBit(unsigned Hash, unsigned Size) {
+  // The low bits of the hash also pick the slot in the on-disk table, mix
+  // all of them in.
+  return (uint32_t(Hash) * 0x9E3779B1u) >> (32 - llvm::Log2_32(Size));
+}
+
+void ASTReader::prefetchIdentifierTable(ModuleFile &F) {
+  auto *IdTable = (ASTIdentifierLookupTable *)F.IdentifierLookupTable;
+  if (!IdTable || IdTable->getNumEntries() == 0)
+    return;
+  if (!PrefetchPool)
+    PrefetchPool = std::make_unique<llvm::ThreadPool>(
+        llvm::hardware_concurrency());
+
+  // The table is only read here, which is safe while the main thread does
+  // lookups in it. The filter is published by the release store.
+  PrefetchPool->async([&F, IdTable] {
+    // Eight bits per identifier keep false positives around one in eight.
+    unsigned Size = std::max(
+        64u, unsigned(llvm::PowerOf2Ceil(IdTable->getNumEntries() * 8ull)));
+    F.IdentifierFilter.resize(Size);
+    for (auto I = IdTable->key_begin(), E = IdTable->key_end(); I != E; ++I)
+      F.IdentifierFilter.set(getIdentifierFilterBit(
+          ASTIdentifierLookupTrait::ComputeHash(I.getInternalKey()), Size));
+    F.IdentifierFilterReady.store(true, std::memory_order_release);
+  });
+}
+
 namespace {
 
   /// Visitor class used to look up identifirs in an AST file.
@@ -2027,6 +2058,13 @@ namespace {
       if (!IdTable)
         return false;
 
+      // If the identifiers of this module have been prefetched, skip probing
+      // the on-disk table when they can't contain the one we look for.
+      if (M.IdentifierFilterReady.load(std::memory_order_acquire) &&
+          !M.IdentifierFilter.test(
+              getIdentifierFilterBit(NameHash, M.IdentifierFilter.size())))
+        return false;
+
       ASTIdentifierLookupTrait Trait(IdTable->getInfoObj().getReader(), M,
                                      Found);
       ++NumIdentifierLookups;
@@ -4326,6 +4364,8 @@ ASTReader::ASTReadResult ASTReader::ReadAST(StringRef FileName,
     ModuleFile &F = *M.Mod;
 
     ModuleMgr.moduleFileAccepted(&F);
+    if (PrefetchIdentifierTables)
+      prefetchIdentifierTable(F);
 
     // Set the import location.
     F.DirectImportLoc = ImportLoc;
@@ -9796,6 +9836,9 @@ ASTReader::ASTReader(Preprocessor &PP, InMemoryModuleCache &ModuleCache,
 }
 
 ASTReader::~ASTReader() {
+  // The prefetching threads reference the module files.
+  if (PrefetchPool)
+    PrefetchPool->wait();
   if (OwnsDeserializationListener)
     delete DeserializationListener;
 }
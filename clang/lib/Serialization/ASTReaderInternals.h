@@ -183,7 +183,7 @@ public:
 /// The on-disk hash table used to contain information about
 /// all of the identifiers in the program.
 using ASTIdentifierLookupTable =
-    llvm::OnDiskIterableChainedHashTable<ASTIdentifierLookupTrait>;
+    llvm::OnDiskOpenAddressingHashTable<ASTIdentifierLookupTrait>;
 
 /// Class that performs lookup for a selector's entries in the global
 /// method pool stored in an AST file.
@@ -3343,7 +3343,7 @@ void ASTWriter::WriteSelectors(Sema &SemaRef) {
 
       ASTMethodPoolTrait Trait(*this);
       llvm::raw_svector_ostream Out(MethodPool);
-      // Make sure that no bucket is at offset 0
+      // Make sure that no item is at offset 0
       endian::write<uint32_t>(Out, 0, little);
       BucketOffset = Generator.Emit(Out, Trait);
     }
@@ -3600,7 +3600,8 @@ void ASTWriter::WriteIdentifierTable(Preprocessor &PP,
   // Create and write out the blob that contains the identifier
   // strings.
   {
-    llvm::OnDiskChainedHashTableGenerator<ASTIdentifierTableTrait> Generator;
+    llvm::OnDiskOpenAddressingHashTableGenerator<ASTIdentifierTableTrait>
+        Generator;
     ASTIdentifierTableTrait Trait(
         *this, PP, IdResolver, IsModule,
         (getLangOpts().CPlusPlus && IsModule) ? &InterestingIdents : nullptr);
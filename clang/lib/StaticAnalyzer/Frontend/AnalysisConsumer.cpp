@@ -455,6 +455,7 @@ void AnalysisConsumer::HandleDeclsCallGraph(const unsigned LocalTUDeclsSize) {
   SetOfConstDecls Visited;
   SetOfConstDecls VisitedAsTopLevel;
   llvm::ReversePostOrderTraversal<clang::CallGraph*> RPOT(&CG);
+  unsigned Position = 0;
   for (auto &N : RPOT) {
     NumFunctionTopLevel++;
 
@@ -464,6 +465,12 @@ void AnalysisConsumer::HandleDeclsCallGraph(const unsigned LocalTUDeclsSize) {
     if (!D)
       continue;
 
+    // Assign the functions to shards by their position in the traversal,
+    // which does not depend on the shard being analyzed.
+    if (Opts->ShardCount > 1 &&
+        Position++ % Opts->ShardCount != Opts->ShardIndex)
+      continue;
+
     // Skip the functions which have been processed already or previously
     // inlined.
     if (shouldSkipFunction(D, Visited, VisitedAsTopLevel))
@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "clang/Tooling/DependencyScanning/DependencyScanningFilesystem.h"
+#include "clang/Tooling/DependencyScanning/DependencyScanningPersistentCache.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
 #include "llvm/Support/Threading.h"
@@ -60,10 +61,17 @@ EntryRef DependencyScanningWorkerFilesystem::scanForDirectivesIfNecessary(
     return EntryRef(Filename, Entry);
 
   SmallVector<dependency_directives_scan::Directive, 64> Directives;
-  // Scan the file for preprocessor directives that might affect the
-  // dependencies.
-  if (scanSourceForDependencyDirectives(Contents->Original->getBuffer(),
-                                        Contents->DepDirectiveTokens,
+  StringRef Input = Contents->Original->getBuffer();
+  // Reuse the directives scanned by a previous process if the file did not
+  // change. Otherwise, scan the file for preprocessor directives that might
+  // affect the dependencies.
+  const auto *PersistentCache = SharedCache.getPersistentCache();
+  bool FoundInPersistentCache =
+      PersistentCache &&
+      PersistentCache->lookup(Entry.getStatus(), Input,
+                              Contents->DepDirectiveTokens, Directives);
+  if (!FoundInPersistentCache &&
+      scanSourceForDependencyDirectives(Input, Contents->DepDirectiveTokens,
                                         Directives)) {
     Contents->DepDirectiveTokens.clear();
     // FIXME: Propagate the diagnostic if desired by the client.
@@ -105,6 +113,18 @@ DependencyScanningFilesystemSharedCache::getShardForUID(
   return CacheShards[Hash % NumShards];
 }
 
+void DependencyScanningFilesystemSharedCache::forEachEntryWithContents(
+    llvm::function_ref<void(const CachedFileSystemEntry &)> Fn) const {
+  for (unsigned I = 0; I < NumShards; ++I) {
+    CacheShard &Shard = CacheShards[I];
+    std::lock_guard<std::mutex> LockGuard(Shard.CacheLock);
+    for (const auto &Entry : Shard.EntriesByUID)
+      if (!Entry.second->isError() && !Entry.second->isDirectory() &&
+          Entry.second->getCachedContents())
+        Fn(*Entry.second);
+  }
+}
+
 const CachedFileSystemEntry *
 DependencyScanningFilesystemSharedCache::CacheShard::findEntryByFilename(
     StringRef Filename) const {
@@ -0,0 +1,345 @@
+//===- DependencyScanningPersistentCache.cpp - clang-scan-deps cache ------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// The cache file consists of a header followed by three arrays: the entries
+// sorted by unique ID, the tokens of all entries and the directives of all
+// entries. All integers are little-endian and no field is aligned, so the
+// arrays are used in place regardless of the host.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Tooling/DependencyScanning/DependencyScanningPersistentCache.h"
+#include "clang/Basic/TokenKinds.h"
+#include "clang/Basic/Version.h"
+#include "clang/Tooling/DependencyScanning/DependencyScanningFilesystem.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/FileUtilities.h"
+#include "llvm/Support/xxhash.h"
+#include <algorithm>
+
+using namespace clang;
+using namespace tooling;
+using namespace dependencies;
+using namespace llvm::support;
+
+namespace {
+
+// Bump this whenever the layout of the file changes.
+constexpr uint32_t CacheVersion = 1;
+constexpr llvm::StringLiteral CacheMagic = "CSDC";
+
+struct DiskHeader {
+  char Magic[4];
+  ulittle32_t Version;
+  ulittle32_t NumEntries;
+  ulittle32_t NumTokens;
+  ulittle32_t NumDirectives;
+  /// Length of the compiler version string that follows the header. Token
+  /// kinds are not stable across compiler versions.
+  ulittle32_t CompilerVersionSize;
+};
+
+struct DiskEntry {
+  ulittle64_t Device;
+  ulittle64_t File;
+  ulittle64_t ModificationTime;
+  ulittle64_t Size;
+  ulittle64_t ContentHash;
+  ulittle32_t FirstToken;
+  ulittle32_t NumTokens;
+  ulittle32_t FirstDirective;
+  ulittle32_t NumDirectives;
+};
+
+struct DiskToken {
+  ulittle32_t Offset;
+  ulittle32_t Length;
+  ulittle16_t Kind;
+  ulittle16_t Flags;
+};
+
+struct DiskDirective {
+  /// Index of the first token, relative to the first token of the entry.
+  ulittle32_t FirstToken;
+  ulittle32_t NumTokens;
+  ulittle32_t Kind;
+};
+
+static_assert(sizeof(DiskHeader) == 24 && sizeof(DiskEntry) == 56 &&
+                  sizeof(DiskToken) == 12 && sizeof(DiskDirective) == 12,
+              "on-disk records must not be padded");
+
+/// The arrays of a cache file, pointing into the mapped buffer.
+struct CacheContents {
+  ArrayRef<DiskEntry> Entries;
+  ArrayRef<DiskToken> Tokens;
+  ArrayRef<DiskDirective> Directives;
+};
+
+} // end anonymous namespace
+
+static uint64_t getModificationTime(const llvm::vfs::Status &Stat) {
+  return Stat.getLastModificationTime().time_since_epoch().count();
+}
+
+static bool isLess(const DiskEntry &E, llvm::sys::fs::UniqueID UID) {
+  return std::make_pair(uint64_t(E.Device), uint64_t(E.File)) <
+         std::make_pair(UID.getDevice(), UID.getFile());
+}
+
+/// Returns the arrays in \p Buffer, or None if it is not a cache file. If
+/// \p CompilerVersion is set, also checks that the file was written by it.
+static Optional<CacheContents>
+parseCacheFile(StringRef Buffer, Optional<StringRef> CompilerVersion = None) {
+  if (Buffer.size() < sizeof(DiskHeader))
+    return None;
+  const auto *Header = reinterpret_cast<const DiskHeader *>(Buffer.data());
+  if (StringRef(Header->Magic, sizeof(Header->Magic)) != CacheMagic ||
+      Header->Version != CacheVersion)
+    return None;
+  Buffer = Buffer.drop_front(sizeof(DiskHeader));
+  if (Buffer.size() < Header->CompilerVersionSize ||
+      (CompilerVersion &&
+       Buffer.take_front(Header->CompilerVersionSize) != *CompilerVersion))
+    return None;
+  Buffer = Buffer.drop_front(Header->CompilerVersionSize);
+
+  uint64_t ExpectedSize = uint64_t(Header->NumEntries) * sizeof(DiskEntry) +
+                          uint64_t(Header->NumTokens) * sizeof(DiskToken) +
+                          uint64_t(Header->NumDirectives) *
+                              sizeof(DiskDirective);
+  if (Buffer.size() != ExpectedSize)
+    return None;
+
+  CacheContents Result;
+  const char *Data = Buffer.data();
+  Result.Entries = llvm::makeArrayRef(
+      reinterpret_cast<const DiskEntry *>(Data), Header->NumEntries);
+  Data += Result.Entries.size() * sizeof(DiskEntry);
+  Result.Tokens = llvm::makeArrayRef(
+      reinterpret_cast<const DiskToken *>(Data), Header->NumTokens);
+  Data += Result.Tokens.size() * sizeof(DiskToken);
+  Result.Directives = llvm::makeArrayRef(
+      reinterpret_cast<const DiskDirective *>(Data), Header->NumDirectives);
+  return Result;
+}
+
+/// Decodes the directives of \p Entry into \p Tokens and \p Directives.
+/// Returns false if the entry is malformed for a file of \p ContentsSize
+/// bytes.
+static bool
+readEntry(const CacheContents &Cache, const DiskEntry &Entry,
+          uint64_t ContentsSize,
+          SmallVectorImpl<dependency_directives_scan::Token> &Tokens,
+          SmallVectorImpl<dependency_directives_scan::Directive> &Directives) {
+  if (uint64_t(Entry.FirstToken) + Entry.NumTokens > Cache.Tokens.size() ||
+      uint64_t(Entry.FirstDirective) + Entry.NumDirectives >
+          Cache.Directives.size())
+    return false;
+
+  Tokens.clear();
+  Tokens.reserve(Entry.NumTokens);
+  for (const DiskToken &T :
+       Cache.Tokens.slice(Entry.FirstToken, Entry.NumTokens)) {
+    if (T.Kind >= tok::NUM_TOKENS ||
+        uint64_t(T.Offset) + T.Length > ContentsSize)
+      return false;
+    Tokens.emplace_back(T.Offset, T.Length, tok::TokenKind(uint16_t(T.Kind)),
+                        T.Flags);
+  }
+
+  // The directives point into Tokens, which must not grow from here on.
+  Directives.clear();
+  for (const DiskDirective &D :
+       Cache.Directives.slice(Entry.FirstDirective, Entry.NumDirectives)) {
+    if (uint64_t(D.FirstToken) + D.NumTokens > Tokens.size() ||
+        D.Kind > dependency_directives_scan::pp_eof)
+      return false;
+    Directives.emplace_back(
+        dependency_directives_scan::DirectiveKind(uint32_t(D.Kind)),
+        llvm::makeArrayRef(Tokens).slice(D.FirstToken, D.NumTokens));
+  }
+  return true;
+}
+
+namespace {
+
+/// An entry of the cache file that is about to be written.
+struct PendingEntry {
+  llvm::sys::fs::UniqueID UID;
+  uint64_t ModificationTime;
+  uint64_t Size;
+  uint64_t ContentHash;
+  SmallVector<dependency_directives_scan::Token, 0> Tokens;
+  /// The first token, number of tokens and kind of each directive.
+  SmallVector<std::tuple<uint32_t, uint32_t, uint32_t>, 0> Directives;
+
+  void addDirectives(
+      ArrayRef<dependency_directives_scan::Directive> ScannedDirectives) {
+    for (const dependency_directives_scan::Directive &D : ScannedDirectives) {
+      Directives.emplace_back(Tokens.size(), D.Tokens.size(), D.Kind);
+      Tokens.append(D.Tokens.begin(), D.Tokens.end());
+    }
+  }
+};
+
+} // end anonymous namespace
+
+std::unique_ptr<DependencyScanningPersistentCache>
+DependencyScanningPersistentCache::open(StringRef Path) {
+  // The file is replaced by renaming a new one over it, so the mapping stays
+  // valid even if another process saves the cache meanwhile.
+  auto MaybeBuffer = llvm::MemoryBuffer::getFile(
+      Path, /*IsText=*/false, /*RequiresNullTerminator=*/false);
+  std::unique_ptr<llvm::MemoryBuffer> Buffer;
+  if (MaybeBuffer && parseCacheFile((*MaybeBuffer)->getBuffer(),
+                                    StringRef(getClangFullRepositoryVersion())))
+    Buffer = std::move(*MaybeBuffer);
+  return std::unique_ptr<DependencyScanningPersistentCache>(
+      new DependencyScanningPersistentCache(Path.str(), std::move(Buffer)));
+}
+
+size_t DependencyScanningPersistentCache::size() const {
+  if (!Buffer)
+    return 0;
+  return parseCacheFile(Buffer->getBuffer())->Entries.size();
+}
+
+bool DependencyScanningPersistentCache::lookup(
+    const llvm::vfs::Status &Stat, StringRef Contents,
+    SmallVectorImpl<dependency_directives_scan::Token> &Tokens,
+    SmallVectorImpl<dependency_directives_scan::Directive> &Directives) const {
+  if (!Buffer)
+    return false;
+  Optional<CacheContents> Cache = parseCacheFile(Buffer->getBuffer());
+  assert(Cache && "the buffer was validated when it was opened");
+
+  auto It = llvm::partition_point(Cache->Entries, [&](const DiskEntry &E) {
+    return isLess(E, Stat.getUniqueID());
+  });
+  if (It == Cache->Entries.end() ||
+      It->Device != Stat.getUniqueID().getDevice() ||
+      It->File != Stat.getUniqueID().getFile())
+    return false;
+
+  // Cheap checks first, then make sure the contents really are the same since
+  // modification times are not always precise enough.
+  if (It->ModificationTime != getModificationTime(Stat) ||
+      It->Size != Contents.size() ||
+      It->ContentHash != llvm::xxHash64(Contents))
+    return false;
+
+  if (!readEntry(*Cache, *It, Contents.size(), Tokens, Directives)) {
+    Tokens.clear();
+    Directives.clear();
+    return false;
+  }
+  return true;
+}
+
+llvm::Error DependencyScanningPersistentCache::save(
+    const DependencyScanningFilesystemSharedCache &SharedCache) {
+  std::vector<PendingEntry> Entries;
+  llvm::DenseSet<llvm::sys::fs::UniqueID> SeenUIDs;
+
+  SharedCache.forEachEntryWithContents([&](const CachedFileSystemEntry &Entry) {
+    Optional<ArrayRef<dependency_directives_scan::Directive>> Directives =
+        Entry.getDirectiveTokens();
+    if (!Directives)
+      return;
+    llvm::vfs::Status Stat = Entry.getStatus();
+    StringRef Contents = Entry.getOriginalContents();
+    PendingEntry &E = Entries.emplace_back();
+    E.UID = Stat.getUniqueID();
+    E.ModificationTime = getModificationTime(Stat);
+    E.Size = Contents.size();
+    E.ContentHash = llvm::xxHash64(Contents);
+    E.addDirectives(*Directives);
+    SeenUIDs.insert(E.UID);
+  });
+
+  // Keep the entries of files this process did not look at, other processes
+  // sharing the cache may need them.
+  if (Buffer) {
+    CacheContents Cache = *parseCacheFile(Buffer->getBuffer());
+    SmallVector<dependency_directives_scan::Token, 64> Tokens;
+    SmallVector<dependency_directives_scan::Directive, 64> Directives;
+    for (const DiskEntry &Old : Cache.Entries) {
+      llvm::sys::fs::UniqueID UID(Old.Device, Old.File);
+      if (SeenUIDs.count(UID) ||
+          !readEntry(Cache, Old, Old.Size, Tokens, Directives))
+        continue;
+      PendingEntry &E = Entries.emplace_back();
+      E.UID = UID;
+      E.ModificationTime = Old.ModificationTime;
+      E.Size = Old.Size;
+      E.ContentHash = Old.ContentHash;
+      E.addDirectives(Directives);
+    }
+  }
+
+  llvm::sort(Entries, [](const PendingEntry &LHS, const PendingEntry &RHS) {
+    return std::make_pair(LHS.UID.getDevice(), LHS.UID.getFile()) <
+           std::make_pair(RHS.UID.getDevice(), RHS.UID.getFile());
+  });
+
+  uint64_t NumTokens = 0, NumDirectives = 0;
+  for (const PendingEntry &E : Entries) {
+    NumTokens += E.Tokens.size();
+    NumDirectives += E.Directives.size();
+  }
+  if (NumTokens > UINT32_MAX || NumDirectives > UINT32_MAX)
+    return llvm::createStringError(std::errc::file_too_large,
+                                   "too many directives to cache");
+
+  return llvm::writeFileAtomically(
+      Path + ".tmp.%%%%%%%%", Path, [&](llvm::raw_ostream &OS) {
+        endian::Writer W(OS, little);
+        std::string CompilerVersion = getClangFullRepositoryVersion();
+        OS << CacheMagic;
+        W.write<uint32_t>(CacheVersion);
+        W.write<uint32_t>(Entries.size());
+        W.write<uint32_t>(NumTokens);
+        W.write<uint32_t>(NumDirectives);
+        W.write<uint32_t>(CompilerVersion.size());
+        OS << CompilerVersion;
+
+        uint32_t FirstToken = 0, FirstDirective = 0;
+        for (const PendingEntry &E : Entries) {
+          W.write<uint64_t>(E.UID.getDevice());
+          W.write<uint64_t>(E.UID.getFile());
+          W.write<uint64_t>(E.ModificationTime);
+          W.write<uint64_t>(E.Size);
+          W.write<uint64_t>(E.ContentHash);
+          W.write<uint32_t>(FirstToken);
+          W.write<uint32_t>(E.Tokens.size());
+          W.write<uint32_t>(FirstDirective);
+          W.write<uint32_t>(E.Directives.size());
+          FirstToken += E.Tokens.size();
+          FirstDirective += E.Directives.size();
+        }
+        for (const PendingEntry &E : Entries) {
+          for (const dependency_directives_scan::Token &T : E.Tokens) {
+            W.write<uint32_t>(T.Offset);
+            W.write<uint32_t>(T.Length);
+            W.write<uint16_t>(T.Kind);
+            W.write<uint16_t>(T.Flags);
+          }
+        }
+        for (const PendingEntry &E : Entries) {
+          for (const auto &D : E.Directives) {
+            W.write<uint32_t>(std::get<0>(D));
+            W.write<uint32_t>(std::get<1>(D));
+            W.write<uint32_t>(std::get<2>(D));
+          }
+        }
+        return llvm::Error::success();
+      });
+}
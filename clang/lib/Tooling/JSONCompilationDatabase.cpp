@@ -15,25 +15,36 @@
 #include "clang/Tooling/CompilationDatabase.h"
 #include "clang/Tooling/CompilationDatabasePluginRegistry.h"
 #include "clang/Tooling/Tooling.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/Triple.h"
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/EndianStream.h"
 #include "llvm/Support/ErrorOr.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Host.h"
+#include "llvm/Support/JSON.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
 #include "llvm/Support/StringSaver.h"
 #include "llvm/Support/VirtualFileSystem.h"
 #include "llvm/Support/YAMLParser.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
 #include <cassert>
+#include <cstring>
+#include <limits>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <system_error>
 #include <tuple>
@@ -163,8 +174,24 @@ class JSONCompilationDatabasePlugin : public CompilationDatabasePlugin {
   loadFromDirectory(StringRef Directory, std::string &ErrorMessage) override {
     SmallString<1024> JSONDatabasePath(Directory);
     llvm::sys::path::append(JSONDatabasePath, "compile_commands.json");
-    auto Base = JSONCompilationDatabase::loadFromFile(
-        JSONDatabasePath, ErrorMessage, JSONCommandLineSyntax::AutoDetect);
+    std::unique_ptr<CompilationDatabase> Base;
+    // Large databases load much faster with a side index, which is kept in
+    // the directory named by the environment if it is set.
+    if (llvm::Optional<std::string> IndexDirectory = llvm::sys::Process::GetEnv(
+            "CLANG_COMPILATION_DATABASE_INDEX_DIR")) {
+      SmallString<1024> AbsolutePath(JSONDatabasePath);
+      llvm::sys::fs::make_absolute(AbsolutePath);
+      SmallString<128> IndexPath(*IndexDirectory);
+      llvm::sys::path::append(IndexPath,
+                              llvm::utohexstr(llvm::xxHash64(AbsolutePath)) +
+                                  ".cdbindex");
+      Base = IndexedJSONCompilationDatabase::loadFromFile(
+          JSONDatabasePath, IndexPath, ErrorMessage,
+          JSONCommandLineSyntax::AutoDetect);
+    } else {
+      Base = JSONCompilationDatabase::loadFromFile(
+          JSONDatabasePath, ErrorMessage, JSONCommandLineSyntax::AutoDetect);
+    }
     return Base ? inferTargetAndDriverMode(
                       inferMissingCompileCommands(expandResponseFiles(
                           std::move(Base), llvm::vfs::getRealFileSystem())))
@@ -433,3 +460,523 @@ bool JSONCompilationDatabase::parse(std::string &ErrorMessage) {
   }
   return true;
 }
+
+//===----------------------------------------------------------------------===//
+// IndexedJSONCompilationDatabase
+//===----------------------------------------------------------------------===//
+
+namespace {
+
+// The side index of an IndexedJSONCompilationDatabase is laid out as
+//
+//   IndexHeader Header;
+//   IndexEntry Entries[NumEntries];     // In the order of the JSON file.
+//   ulittle32_t Sorted[NumEntries];     // Entries, sorted by file.
+//   char Files[];                       // The native paths of the entries.
+const char IndexMagic[4] = {'C', 'D', 'B', 'I'};
+const uint32_t IndexVersion = 1;
+
+struct IndexHeader {
+  char Magic[4];
+  llvm::support::ulittle32_t Version;
+  llvm::support::ulittle64_t JSONSize;
+  llvm::support::little64_t JSONModificationTime;
+  llvm::support::ulittle32_t NumEntries;
+  llvm::support::ulittle32_t FilesSize;
+};
+
+struct IndexEntry {
+  /// The byte range of the entry in the JSON file.
+  llvm::support::ulittle64_t Offset;
+  llvm::support::ulittle32_t Length;
+  /// The native path of the entry's file, in the Files table.
+  llvm::support::ulittle32_t FileOffset;
+  llvm::support::ulittle32_t FileLength;
+  llvm::support::ulittle32_t Reserved;
+  /// The hash of the text of the entry, used to reuse entries when the
+  /// index is rebuilt and to detect that the JSON file changed under us.
+  llvm::support::ulittle64_t Hash;
+};
+
+/// Provides typed access to a side index that has been validated.
+class IndexReader {
+  StringRef Buffer;
+
+public:
+  explicit IndexReader(StringRef Buffer) : Buffer(Buffer) {}
+
+  /// Checks that Buffer holds an index of the supported version and of
+  /// consistent size.
+  static bool isValid(StringRef Buffer) {
+    if (Buffer.size() < sizeof(IndexHeader))
+      return false;
+    IndexReader Reader(Buffer);
+    const IndexHeader &Header = Reader.getHeader();
+    if (memcmp(Header.Magic, IndexMagic, sizeof(IndexMagic)) != 0 ||
+        Header.Version != IndexVersion)
+      return false;
+    uint64_t Size = sizeof(IndexHeader) +
+                    uint64_t(Header.NumEntries) *
+                        (sizeof(IndexEntry) + sizeof(uint32_t)) +
+                    Header.FilesSize;
+    return Buffer.size() == Size;
+  }
+
+  const IndexHeader &getHeader() const {
+    return *reinterpret_cast<const IndexHeader *>(Buffer.data());
+  }
+  ArrayRef<IndexEntry> getEntries() const {
+    return llvm::makeArrayRef(
+        reinterpret_cast<const IndexEntry *>(Buffer.data() +
+                                             sizeof(IndexHeader)),
+        getHeader().NumEntries);
+  }
+  ArrayRef<llvm::support::ulittle32_t> getSorted() const {
+    return llvm::makeArrayRef(
+        reinterpret_cast<const llvm::support::ulittle32_t *>(
+            getEntries().end()),
+        getHeader().NumEntries);
+  }
+  StringRef getFile(const IndexEntry &Entry) const {
+    const char *Files = reinterpret_cast<const char *>(getSorted().end());
+    return StringRef(Files + Entry.FileOffset, Entry.FileLength);
+  }
+};
+
+/// An entry of a JSON compilation database, as it is written in the file.
+struct JSONEntry {
+  std::string Directory;
+  std::string File;
+  std::string Output;
+  /// Either a single shell-escaped command line, or the literal arguments.
+  std::vector<std::string> Command;
+};
+
+/// Parses one object of a JSON compilation database.
+bool parseJSONEntry(StringRef Text, JSONEntry &Entry,
+                    std::string &ErrorMessage) {
+  llvm::Expected<llvm::json::Value> Value = llvm::json::parse(Text);
+  if (!Value) {
+    ErrorMessage = "Error while parsing JSON: " + toString(Value.takeError());
+    return false;
+  }
+  const llvm::json::Object *Object = Value->getAsObject();
+  if (!Object) {
+    ErrorMessage = "Expected object.";
+    return false;
+  }
+  bool HasCommand = false, HasArguments = false;
+  bool HasDirectory = false, HasFile = false;
+  for (const auto &KV : *Object) {
+    StringRef Key = KV.first;
+    if (Key == "arguments") {
+      const llvm::json::Array *Arguments = KV.second.getAsArray();
+      if (!Arguments) {
+        ErrorMessage = "Expected sequence as value.";
+        return false;
+      }
+      Entry.Command.clear();
+      for (const llvm::json::Value &Argument : *Arguments) {
+        llvm::Optional<StringRef> String = Argument.getAsString();
+        if (!String) {
+          ErrorMessage = "Only strings are allowed in 'arguments'.";
+          return false;
+        }
+        Entry.Command.push_back(String->str());
+      }
+      HasArguments = true;
+      continue;
+    }
+    llvm::Optional<StringRef> String = KV.second.getAsString();
+    if (!String) {
+      ErrorMessage = "Expected string as value.";
+      return false;
+    }
+    if (Key == "directory") {
+      Entry.Directory = String->str();
+      HasDirectory = true;
+    } else if (Key == "command") {
+      if (!HasArguments)
+        Entry.Command = {String->str()};
+      HasCommand = true;
+    } else if (Key == "file") {
+      Entry.File = String->str();
+      HasFile = true;
+    } else if (Key == "output") {
+      Entry.Output = String->str();
+    } else {
+      ErrorMessage = ("Unknown key: \"" + Key + "\"").str();
+      return false;
+    }
+  }
+  if (!HasFile) {
+    ErrorMessage = "Missing key: \"file\".";
+    return false;
+  }
+  if (!HasCommand && !HasArguments) {
+    ErrorMessage = "Missing key: \"command\" or \"arguments\".";
+    return false;
+  }
+  if (!HasDirectory) {
+    ErrorMessage = "Missing key: \"directory\".";
+    return false;
+  }
+  return true;
+}
+
+/// Returns the normalized path under which the entry's file is looked up.
+SmallString<128> getNativeFilePath(const JSONEntry &Entry) {
+  SmallString<128> NativeFilePath;
+  if (llvm::sys::path::is_relative(Entry.File)) {
+    SmallString<128> AbsolutePath(Entry.Directory);
+    llvm::sys::path::append(AbsolutePath, Entry.File);
+    llvm::sys::path::native(AbsolutePath, NativeFilePath);
+  } else {
+    llvm::sys::path::native(Entry.File, NativeFilePath);
+  }
+  llvm::sys::path::remove_dots(NativeFilePath, /*remove_dot_dot=*/true);
+  return NativeFilePath;
+}
+
+/// Finds the byte ranges of the objects in the top-level array of a JSON
+/// compilation database, without parsing them.
+bool findJSONObjects(StringRef JSON,
+                     std::vector<std::pair<size_t, size_t>> &Objects,
+                     std::string &ErrorMessage) {
+  auto SkipWhitespace = [&](size_t I) {
+    while (I < JSON.size() && llvm::isSpace(JSON[I]))
+      ++I;
+    return I;
+  };
+  size_t I = SkipWhitespace(0);
+  if (I == JSON.size() || JSON[I] != '[') {
+    ErrorMessage = "Expected array.";
+    return false;
+  }
+  I = SkipWhitespace(I + 1);
+  if (I < JSON.size() && JSON[I] == ']')
+    return true;
+  while (true) {
+    if (I == JSON.size() || JSON[I] != '{') {
+      ErrorMessage = "Expected object.";
+      return false;
+    }
+    // Find the matching closing brace, skipping over strings.
+    size_t Begin = I;
+    unsigned Depth = 0;
+    bool InString = false;
+    for (; I < JSON.size(); ++I) {
+      char C = JSON[I];
+      if (InString) {
+        if (C == '\\')
+          ++I;
+        else if (C == '"')
+          InString = false;
+      } else if (C == '"') {
+        InString = true;
+      } else if (C == '{' || C == '[') {
+        ++Depth;
+      } else if ((C == '}' || C == ']') && --Depth == 0) {
+        break;
+      }
+    }
+    if (I >= JSON.size()) {
+      ErrorMessage = "Unterminated object.";
+      return false;
+    }
+    Objects.emplace_back(Begin, I + 1 - Begin);
+    I = SkipWhitespace(I + 1);
+    if (I < JSON.size() && JSON[I] == ']')
+      return true;
+    if (I == JSON.size() || JSON[I] != ',') {
+      ErrorMessage = "Expected ',' or ']'.";
+      return false;
+    }
+    I = SkipWhitespace(I + 1);
+  }
+}
+
+/// Builds the side index of the JSON compilation database \p JSON, reusing
+/// the files of unchanged entries from \p OldIndex if it is not empty.
+bool buildIndex(StringRef JSON, const llvm::sys::fs::file_status &Status,
+                StringRef OldIndex, std::string &Index,
+                std::string &ErrorMessage) {
+  std::vector<std::pair<size_t, size_t>> Objects;
+  if (!findJSONObjects(JSON, Objects, ErrorMessage))
+    return false;
+  if (Objects.size() > std::numeric_limits<uint32_t>::max()) {
+    ErrorMessage = "Too many entries.";
+    return false;
+  }
+
+  // The files of the entries of the previous index, by the hash and length
+  // of their text.
+  llvm::DenseMap<std::pair<uint64_t, uint32_t>, StringRef> OldFiles;
+  if (!OldIndex.empty()) {
+    IndexReader Reader(OldIndex);
+    for (const IndexEntry &Entry : Reader.getEntries())
+      OldFiles.try_emplace({Entry.Hash, Entry.Length}, Reader.getFile(Entry));
+  }
+
+  std::vector<IndexEntry> Entries(Objects.size());
+  std::string Files;
+  llvm::StringMap<uint32_t> FileOffsets;
+  for (size_t I = 0; I < Objects.size(); ++I) {
+    StringRef Text = JSON.substr(Objects[I].first, Objects[I].second);
+    IndexEntry &Entry = Entries[I];
+    Entry.Offset = Objects[I].first;
+    Entry.Length = Objects[I].second;
+    Entry.Reserved = 0;
+    Entry.Hash = llvm::xxHash64(Text);
+
+    SmallString<128> File;
+    auto Old = OldFiles.find({Entry.Hash, Entry.Length});
+    if (Old != OldFiles.end()) {
+      File = Old->second;
+    } else {
+      JSONEntry Parsed;
+      if (!parseJSONEntry(Text, Parsed, ErrorMessage))
+        return false;
+      File = getNativeFilePath(Parsed);
+    }
+    auto Inserted = FileOffsets.try_emplace(File, Files.size());
+    if (Inserted.second)
+      Files += File;
+    Entry.FileOffset = Inserted.first->second;
+    Entry.FileLength = File.size();
+  }
+  if (Files.size() > std::numeric_limits<uint32_t>::max()) {
+    ErrorMessage = "Too many files.";
+    return false;
+  }
+
+  std::vector<uint32_t> Sorted(Entries.size());
+  std::iota(Sorted.begin(), Sorted.end(), 0);
+  auto GetFile = [&](uint32_t I) {
+    return StringRef(Files).substr(Entries[I].FileOffset,
+                                   Entries[I].FileLength);
+  };
+  llvm::stable_sort(Sorted, [&](uint32_t LHS, uint32_t RHS) {
+    return GetFile(LHS) < GetFile(RHS);
+  });
+
+  IndexHeader Header;
+  memcpy(Header.Magic, IndexMagic, sizeof(IndexMagic));
+  Header.Version = IndexVersion;
+  Header.JSONSize = Status.getSize();
+  Header.JSONModificationTime =
+      Status.getLastModificationTime().time_since_epoch().count();
+  Header.NumEntries = Entries.size();
+  Header.FilesSize = Files.size();
+
+  llvm::raw_string_ostream OS(Index);
+  OS.write(reinterpret_cast<const char *>(&Header), sizeof(Header));
+  OS.write(reinterpret_cast<const char *>(Entries.data()),
+           Entries.size() * sizeof(IndexEntry));
+  for (uint32_t I : Sorted)
+    llvm::support::endian::write<uint32_t>(OS, I, llvm::support::little);
+  OS << Files;
+  OS.flush();
+  return true;
+}
+
+/// Writes the index atomically, so that concurrent readers see either the
+/// old or the new index.
+void writeIndex(StringRef IndexPath, StringRef Index) {
+  int FD;
+  SmallString<128> TempPath;
+  if (llvm::sys::fs::createUniqueFile(IndexPath + "-%%%%%%%%", FD, TempPath))
+    return;
+  {
+    llvm::raw_fd_ostream OS(FD, /*shouldClose=*/true);
+    OS << Index;
+    OS.close();
+    if (OS.has_error()) {
+      OS.clear_error();
+      llvm::sys::fs::remove(TempPath);
+      return;
+    }
+  }
+  if (llvm::sys::fs::rename(TempPath, IndexPath))
+    llvm::sys::fs::remove(TempPath);
+}
+
+} // namespace
+
+IndexedJSONCompilationDatabase::IndexedJSONCompilationDatabase(
+    StringRef FilePath, std::unique_ptr<llvm::MemoryBuffer> Index,
+    JSONCommandLineSyntax Syntax)
+    : FilePath(FilePath), Index(std::move(Index)), Syntax(Syntax) {}
+
+std::unique_ptr<IndexedJSONCompilationDatabase>
+IndexedJSONCompilationDatabase::loadFromFile(StringRef FilePath,
+                                             StringRef IndexPath,
+                                             std::string &ErrorMessage,
+                                             JSONCommandLineSyntax Syntax) {
+  llvm::sys::fs::file_status Status;
+  if (std::error_code EC = llvm::sys::fs::status(FilePath, Status)) {
+    ErrorMessage = "Error while opening JSON database: " + EC.message();
+    return nullptr;
+  }
+
+  // The index is replaced by renaming, so it is safe to map it.
+  std::unique_ptr<llvm::MemoryBuffer> Index;
+  if (auto IndexBuffer =
+          llvm::MemoryBuffer::getFile(IndexPath, /*IsText=*/false,
+                                      /*RequiresNullTerminator=*/false))
+    if (IndexReader::isValid((*IndexBuffer)->getBuffer()))
+      Index = std::move(*IndexBuffer);
+  if (Index) {
+    const IndexHeader &Header = IndexReader(Index->getBuffer()).getHeader();
+    if (Header.JSONSize == Status.getSize() &&
+        Header.JSONModificationTime ==
+            Status.getLastModificationTime().time_since_epoch().count())
+      return std::unique_ptr<IndexedJSONCompilationDatabase>(
+          new IndexedJSONCompilationDatabase(FilePath, std::move(Index),
+                                             Syntax));
+  }
+
+  // The index is missing or stale, rebuild it. Don't mmap the JSON file: the
+  // build system may overwrite it.
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> DatabaseBuffer =
+      llvm::MemoryBuffer::getFile(FilePath, /*IsText=*/false,
+                                  /*RequiresNullTerminator=*/false,
+                                  /*IsVolatile=*/true);
+  if (std::error_code Result = DatabaseBuffer.getError()) {
+    ErrorMessage = "Error while opening JSON database: " + Result.message();
+    return nullptr;
+  }
+  std::string NewIndex;
+  if (!buildIndex((*DatabaseBuffer)->getBuffer(), Status,
+                  Index ? Index->getBuffer() : StringRef(), NewIndex,
+                  ErrorMessage))
+    return nullptr;
+  writeIndex(IndexPath, NewIndex);
+  return std::unique_ptr<IndexedJSONCompilationDatabase>(
+      new IndexedJSONCompilationDatabase(
+          FilePath, llvm::MemoryBuffer::getMemBufferCopy(NewIndex, IndexPath),
+          Syntax));
+}
+
+StringRef IndexedJSONCompilationDatabase::getSortedFile(uint32_t I) const {
+  IndexReader Reader(Index->getBuffer());
+  return Reader.getFile(Reader.getEntries()[Reader.getSorted()[I]]);
+}
+
+std::pair<uint32_t, uint32_t>
+IndexedJSONCompilationDatabase::findEntries(StringRef File) const {
+  // Binary search for the first position at which Pred is false.
+  auto PartitionPoint = [&](uint32_t Begin, uint32_t End, auto Pred) {
+    while (Begin != End) {
+      uint32_t Mid = Begin + (End - Begin) / 2;
+      if (Pred(getSortedFile(Mid)))
+        Begin = Mid + 1;
+      else
+        End = Mid;
+    }
+    return Begin;
+  };
+  uint32_t Size = IndexReader(Index->getBuffer()).getHeader().NumEntries;
+  uint32_t Begin = PartitionPoint(
+      0, Size, [&](StringRef Candidate) { return Candidate < File; });
+  uint32_t End = PartitionPoint(
+      Begin, Size, [&](StringRef Candidate) { return Candidate == File; });
+  return {Begin, End};
+}
+
+void IndexedJSONCompilationDatabase::getCommand(
+    uint32_t Entry, StringRef JSON,
+    std::vector<CompileCommand> &Commands) const {
+  // If the JSON file changed since the index was loaded, the entry may not
+  // be there anymore.
+  const IndexEntry &IE = IndexReader(Index->getBuffer()).getEntries()[Entry];
+  if (llvm::xxHash64(JSON) != IE.Hash)
+    return;
+  JSONEntry Parsed;
+  std::string ErrorMessage;
+  if (!parseJSONEntry(JSON, Parsed, ErrorMessage))
+    return;
+  std::vector<std::string> Arguments;
+  if (Parsed.Command.size() == 1)
+    Arguments = unescapeCommandLine(Syntax, Parsed.Command[0]);
+  else
+    Arguments = std::move(Parsed.Command);
+  while (unwrapCommand(Arguments))
+    ;
+  Commands.emplace_back(Parsed.Directory, Parsed.File, std::move(Arguments),
+                        Parsed.Output);
+}
+
+std::vector<CompileCommand>
+IndexedJSONCompilationDatabase::getCompileCommands(StringRef FilePath) const {
+  SmallString<128> NativeFilePath;
+  llvm::sys::path::native(FilePath, NativeFilePath);
+
+  std::pair<uint32_t, uint32_t> Range = findEntries(NativeFilePath);
+  if (Range.first == Range.second) {
+    // Fall back to matching symlinks and relative paths like
+    // JSONCompilationDatabase does.
+    if (!MatchTrie) {
+      MatchTrie = std::make_unique<FileMatchTrie>();
+      IndexReader Reader(Index->getBuffer());
+      for (const IndexEntry &Entry : Reader.getEntries())
+        MatchTrie->insert(Reader.getFile(Entry));
+    }
+    std::string Error;
+    llvm::raw_string_ostream ES(Error);
+    StringRef Match = MatchTrie->findEquivalent(NativeFilePath, ES);
+    if (Match.empty())
+      return {};
+    Range = findEntries(Match);
+  }
+
+  IndexReader Reader(Index->getBuffer());
+  std::vector<uint32_t> Entries;
+  for (uint32_t I = Range.first; I != Range.second; ++I)
+    Entries.push_back(Reader.getSorted()[I]);
+  // Report the commands in the order of the JSON file.
+  llvm::sort(Entries);
+
+  std::vector<CompileCommand> Commands;
+  for (uint32_t Entry : Entries) {
+    const IndexEntry &IE = Reader.getEntries()[Entry];
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> Text =
+        llvm::MemoryBuffer::getFileSlice(this->FilePath, IE.Length, IE.Offset,
+                                         /*IsVolatile=*/true);
+    if (Text)
+      getCommand(Entry, (*Text)->getBuffer(), Commands);
+  }
+  return Commands;
+}
+
+std::vector<std::string>
+IndexedJSONCompilationDatabase::getAllFiles() const {
+  std::vector<std::string> Result;
+  uint32_t Size = IndexReader(Index->getBuffer()).getHeader().NumEntries;
+  for (uint32_t I = 0; I != Size; ++I) {
+    StringRef File = getSortedFile(I);
+    if (Result.empty() || Result.back() != File)
+      Result.push_back(File.str());
+  }
+  return Result;
+}
+
+std::vector<CompileCommand>
+IndexedJSONCompilationDatabase::getAllCompileCommands() const {
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> DatabaseBuffer =
+      llvm::MemoryBuffer::getFile(FilePath, /*IsText=*/false,
+                                  /*RequiresNullTerminator=*/false,
+                                  /*IsVolatile=*/true);
+  if (!DatabaseBuffer)
+    return {};
+  StringRef JSON = (*DatabaseBuffer)->getBuffer();
+  ArrayRef<IndexEntry> Entries = IndexReader(Index->getBuffer()).getEntries();
+  std::vector<CompileCommand> Commands;
+  for (uint32_t I = 0, E = Entries.size(); I != E; ++I) {
+    if (Entries[I].Offset + Entries[I].Length > JSON.size())
+      continue;
+    getCommand(I, JSON.substr(Entries[I].Offset, Entries[I].Length),
+               Commands);
+  }
+  return Commands;
+}
@@ -0,0 +1,28 @@
+// RUN: %clang_analyze_cc1 -analyzer-checker=core -verify=shard0 %s \
+// RUN:   -analyzer-config shard-count=2,shard-index=0
+// RUN: %clang_analyze_cc1 -analyzer-checker=core -verify=shard1 %s \
+// RUN:   -analyzer-config shard-count=2,shard-index=1
+// RUN: %clang_analyze_cc1 -analyzer-checker=core -verify=shard0,shard1 %s
+
+// RUN: not %clang_analyze_cc1 -analyzer-checker=core %s \
+// RUN:   -analyzer-config shard-count=0 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=CHECK-COUNT
+// CHECK-COUNT: (frontend): invalid input for analyzer-config option
+// CHECK-COUNT-SAME: 'shard-count', that expects a non-zero unsigned value
+
+// RUN: not %clang_analyze_cc1 -analyzer-checker=core %s \
+// RUN:   -analyzer-config shard-count=2,shard-index=2 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=CHECK-INDEX
+// CHECK-INDEX: (frontend): invalid input for analyzer-config option
+// CHECK-INDEX-SAME: 'shard-index', that expects an unsigned less than
+// CHECK-INDEX-SAME: 'shard-count' value
+
+int first(int x) {
+  int zero = 0;
+  return x / zero; // shard0-warning{{Division by zero}}
+}
+
+int second(int x) {
+  int zero = 0;
+  return x / zero; // shard1-warning{{Division by zero}}
+}
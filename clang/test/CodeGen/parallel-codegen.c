@@ -0,0 +1,20 @@
+// REQUIRES: x86-registered-target
+// RUN: rm -f %t.o %t.1.o %t.2.o
+// RUN: %clang_cc1 -triple x86_64-unknown-linux -O1 -emit-obj %s -o %t.o \
+// RUN:   -fparallel-codegen-output=%t.1.o -fparallel-codegen-output=%t.2.o
+// RUN: llvm-nm %t.o %t.1.o %t.2.o | FileCheck %s
+
+// Every definition ends up in one of the partitions.
+
+// CHECK-DAG: T f1
+// CHECK-DAG: T f2
+// CHECK-DAG: T f3
+// CHECK-DAG: T f4
+// CHECK-DAG: D counter
+
+int counter = 1;
+
+__attribute__((noinline)) int f1(int x) { return x + counter; }
+__attribute__((noinline)) int f2(int x) { return f1(x) * 2; }
+__attribute__((noinline)) int f3(int x) { return f2(x) - counter; }
+int f4(int x) { return f3(x) + f1(x); }
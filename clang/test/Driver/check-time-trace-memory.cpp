@@ -0,0 +1,21 @@
+// RUN: %clangxx -S -ftime-trace -ftime-trace-memory -ftime-trace-granularity=0 -o %t.s %s
+// RUN: %python -c 'import json, sys; \
+// RUN:   events = json.load(open(sys.argv[1]))["traceEvents"]; \
+// RUN:   [print(e["name"], e["args"].get("detail", ""), e["args"]["bytes"] > 0) for e in events \
+// RUN:    if e["name"].startswith("Top memory Instantiate")]' %t.json \
+// RUN:   | FileCheck %s
+
+// CHECK-DAG: Top memory InstantiateClass Big<int> True
+// CHECK-DAG: Top memory InstantiateFunction Big<int>::get True
+
+template <typename T> struct Big {
+  T A, B, C, D;
+  T get() const {
+    T Sum = A + B;
+    for (int I = 0; I < 10; ++I)
+      Sum += C * I - D;
+    return Sum;
+  }
+};
+
+int use() { return Big<int>().get(); }
@@ -0,0 +1,12 @@
+// RUN: %clang -### --target=x86_64 -fparallel-codegen=3 %s -c -o %t.o 2>&1 | FileCheck -check-prefix=CHECK-OPT %s
+// RUN: %clang -### --target=x86_64 -fparallel-codegen=1 %s -c -o %t.o 2>&1 | FileCheck -check-prefix=CHECK-ONE %s
+// RUN: not %clang -### --target=x86_64 -fparallel-codegen=0 %s -c 2>&1 | FileCheck -check-prefix=CHECK-INVALID %s
+// RUN: not %clang -### --target=x86_64 -fparallel-codegen=2 %s 2>&1 | FileCheck -check-prefix=CHECK-LINK %s
+// RUN: not %clang -### --target=x86_64 -fparallel-codegen=2 %s -S 2>&1 | FileCheck -check-prefix=CHECK-LINK %s
+// RUN: not %clang -### --target=x86_64-linux -fparallel-codegen=2 -g -gsplit-dwarf %s -c 2>&1 | FileCheck -check-prefix=CHECK-DWARF %s
+
+// CHECK-OPT: "-fparallel-codegen-output=[[OUT:.*]].o.1.o" "-fparallel-codegen-output=[[OUT]].o.2.o"
+// CHECK-ONE-NOT: -fparallel-codegen-output
+// CHECK-INVALID: error: invalid integral value '0' in '-fparallel-codegen=0'
+// CHECK-LINK: error: invalid argument '-fparallel-codegen=2' only allowed with '-c'
+// CHECK-DWARF: error: invalid argument '-fparallel-codegen=2' not allowed with '-gsplit-dwarf'
@@ -0,0 +1,40 @@
+// RUN: rm -rf %t
+// RUN: split-file %s %t
+// RUN: %clang_cc1 -fmodules -fno-implicit-modules -x c -I%t -emit-module \
+// RUN:   %t/module.modulemap -fmodule-name=a -o %t/a.pcm
+// RUN: %clang_cc1 -fmodules -fno-implicit-modules -x c -I%t -emit-module \
+// RUN:   %t/module.modulemap -fmodule-name=b -fmodule-file=%t/a.pcm -o %t/b.pcm
+// RUN: %clang_cc1 -fmodules -fno-implicit-modules -x c -I%t -fsyntax-only \
+// RUN:   -verify %t/test.c -fmodule-file=%t/a.pcm -fmodule-file=%t/b.pcm
+// RUN: %clang_cc1 -fmodules -fno-implicit-modules -x c -I%t -fsyntax-only \
+// RUN:   -verify %t/test.c -fmodule-file=%t/a.pcm -fmodule-file=%t/b.pcm \
+// RUN:   -fmodules-prefetch-identifier-tables
+
+// Identifier lookups give the same results whether or not the identifier
+// tables of the modules have been prefetched.
+
+//--- module.modulemap
+module a { header "a.h" }
+module b { header "b.h" }
+
+//--- a.h
+#define A_MACRO 1
+int a_function(void);
+struct a_struct { int a_field; };
+
+//--- b.h
+#include "a.h"
+#define B_MACRO A_MACRO
+int b_function(struct a_struct *);
+
+//--- test.c
+// expected-no-diagnostics
+#include "b.h"
+
+int test(void) {
+  struct a_struct S = {B_MACRO};
+#ifdef not_in_any_module
+  return not_in_any_module;
+#endif
+  return a_function() + b_function(&S) + S.a_field;
+}
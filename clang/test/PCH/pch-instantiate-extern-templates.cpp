@@ -0,0 +1,39 @@
+// Without -fpch-instantiate-templates, the members of an explicit
+// instantiation declaration are only instantiated when used.
+// RUN: %clang_cc1 -emit-pch -o %t %s -verify=ok
+// RUN: %clang_cc1 -include-pch %t -fsyntax-only %s -verify=ok
+
+// With -fpch-instantiate-templates, the inline members are instantiated in
+// the pch.
+// RUN: %clang_cc1 -emit-pch -fpch-instantiate-templates -o %t %s -verify=expected
+// RUN: %clang_cc1 -emit-pch -fpch-instantiate-templates -o %t %s -DVALID -verify=ok
+// RUN: %clang_cc1 -include-pch %t -fsyntax-only %s -DVALID -verify=ok
+
+// ok-no-diagnostics
+
+#ifndef HEADER_H
+#define HEADER_H
+
+template <typename T>
+struct A {
+#ifndef VALID
+  T foo() const { return "test"; } // @20
+#endif
+  T bar() const;
+  T baz() const { return T(); }
+};
+
+// Not inline, so not instantiated by an explicit instantiation declaration.
+template <typename T>
+T A<T>::bar() const { return "test"; }
+
+extern template struct A<double>; // @30
+
+#else
+
+double use(A<double> &a) { return a.baz(); }
+
+#endif
+
+// expected-error@20 {{cannot initialize return object}}
+// expected-note@30 {{in instantiation of member function}}
@@ -0,0 +1,44 @@
+// RUN: %clang_cc1 -std=c++20 -fsyntax-only -verify %s
+// RUN: %clang_cc1 -std=c++20 -fsyntax-only -verify -fexperimental-new-constant-interpreter %s
+
+// expected-no-diagnostics
+
+struct A {
+  constexpr virtual int f() const { return 1; }
+  constexpr virtual int g() const = 0;
+  constexpr int callF() const { return f(); }
+};
+
+struct B : A {
+  constexpr int f() const override { return 2; }
+  constexpr int g() const override { return 20; }
+};
+
+struct C : B {
+  constexpr int f() const override { return 3; }
+};
+
+constexpr int callThroughBase(const A &a) { return a.f() + a.g(); }
+
+constexpr B b;
+constexpr C c;
+static_assert(callThroughBase(b) == 22);
+static_assert(callThroughBase(c) == 23);
+static_assert(c.callF() == 3);
+static_assert(static_cast<const A &>(c).f() == 3);
+
+// Qualified calls are not dispatched.
+constexpr int qualified(const B &b) { return b.B::f(); }
+static_assert(qualified(c) == 2);
+
+// During construction the dynamic type is the class being constructed.
+struct D : B {
+  int Value;
+  constexpr D() : Value(f()) {}
+};
+struct E : D {
+  constexpr int f() const override { return 5; }
+};
+constexpr E e;
+static_assert(e.Value == 2);
+static_assert(callThroughBase(e) == 25);
@@ -9,6 +9,7 @@
 #include "clang/Driver/Driver.h"
 #include "clang/Frontend/CompilerInstance.h"
 #include "clang/Tooling/CommonOptionsParser.h"
+#include "clang/Tooling/DependencyScanning/DependencyScanningPersistentCache.h"
 #include "clang/Tooling/DependencyScanning/DependencyScanningService.h"
 #include "clang/Tooling/DependencyScanning/DependencyScanningTool.h"
 #include "clang/Tooling/DependencyScanning/DependencyScanningWorker.h"
@@ -156,6 +157,14 @@ static llvm::cl::opt<bool> EagerLoadModules(
     llvm::cl::desc("Load PCM files eagerly (instead of lazily on import)."),
     llvm::cl::init(false), llvm::cl::cat(DependencyScannerCategory));
 
+static llvm::cl::opt<std::string> PersistentCachePath(
+    "persistent-cache",
+    llvm::cl::desc("Reuse the directives scanned by previous runs from this "
+                   "file, and update it with the directives scanned by this "
+                   "run. Only used in the 'preprocess-dependency-directives' "
+                   "mode."),
+    llvm::cl::cat(DependencyScannerCategory));
+
 llvm::cl::opt<unsigned>
     NumThreads("j", llvm::cl::Optional,
                llvm::cl::desc("Number of worker threads to use (default: use "
@@ -526,6 +535,13 @@ int main(int argc, const char **argv) {
 
   DependencyScanningService Service(ScanMode, Format, OptimizeArgs,
                                     EagerLoadModules);
+  std::unique_ptr<DependencyScanningPersistentCache> PersistentCache;
+  if (!PersistentCachePath.empty() &&
+      ScanMode == ScanningMode::DependencyDirectivesScan) {
+    PersistentCache =
+        DependencyScanningPersistentCache::open(PersistentCachePath);
+    Service.getSharedCache().setPersistentCache(PersistentCache.get());
+  }
   llvm::ThreadPool Pool(llvm::hardware_concurrency(NumThreads));
   std::vector<std::unique_ptr<DependencyScanningTool>> WorkerTools;
   for (unsigned I = 0; I < Pool.getThreadCount(); ++I)
@@ -601,6 +617,12 @@ int main(int argc, const char **argv) {
   }
   Pool.wait();
 
+  // A cache that can't be written only makes the next run slower.
+  if (PersistentCache)
+    if (llvm::Error E = PersistentCache->save(Service.getSharedCache()))
+      llvm::errs() << "warning: could not write '" << PersistentCache->getPath()
+                   << "': " << llvm::toString(std::move(E)) << "\n";
+
   if (Format == ScanningOutputFormat::Full)
     FD.printFullOutput(llvm::outs());
 
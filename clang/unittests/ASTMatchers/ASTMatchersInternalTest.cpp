@@ -216,6 +216,38 @@ TEST(MatchFinder, CheckProfiling) {
   EXPECT_EQ("MyID", Records.begin()->getKey());
 }
 
+TEST(MatchFinder, RunsNameFilteredMatchersInOrder) {
+  struct RecordingCallback : public MatchFinder::MatchCallback {
+    RecordingCallback(std::vector<std::string> &Log, StringRef Name)
+        : Log(Log), Name(Name) {}
+    void run(const MatchFinder::MatchResult &Result) override {
+      const auto *Call = Result.Nodes.getNodeAs<CallExpr>("call");
+      Log.push_back((Name + ":" + Call->getDirectCallee()->getName()).str());
+    }
+    std::vector<std::string> &Log;
+    StringRef Name;
+  };
+
+  std::vector<std::string> Log;
+  RecordingCallback First(Log, "first"), Named(Log, "named"),
+      Last(Log, "last");
+  MatchFinder Finder;
+  Finder.addMatcher(callExpr().bind("call"), &First);
+  Finder.addMatcher(
+      callExpr(callee(functionDecl(hasAnyName("f", "::h")))).bind("call"),
+      &Named);
+  Finder.addMatcher(callExpr().bind("call"), &Last);
+  std::unique_ptr<FrontendActionFactory> Factory(
+      newFrontendActionFactory(&Finder));
+  ASSERT_TRUE(tooling::runToolOnCode(
+      Factory->create(), "void f(); void g(); void h(); "
+                         "void x() { f(); g(); h(); }"));
+
+  EXPECT_THAT(Log, testing::ElementsAre("first:f", "named:f", "last:f",
+                                        "first:g", "last:g", "first:h",
+                                        "named:h", "last:h"));
+}
+
 class VerifyStartOfTranslationUnit : public MatchFinder::MatchCallback {
 public:
   VerifyStartOfTranslationUnit() : Called(false) {}
@@ -297,6 +329,38 @@ TEST(DynTypedMatcherTest, ConstructWithTraversalKindOverridesNestedTK) {
               llvm::ValueIs(TK_IgnoreUnlessSpelledInSource));
 }
 
+TEST(DynTypedMatcherTest, CollectRequiredNames) {
+  std::vector<StringRef> Names;
+  EXPECT_TRUE(DynTypedMatcher(namedDecl(hasAnyName("a", "::ns::b")))
+                  .collectRequiredNames(Names));
+  EXPECT_THAT(Names, testing::ElementsAre("a", "b"));
+
+  Names.clear();
+  EXPECT_TRUE(DynTypedMatcher(callExpr(callee(functionDecl(
+                                  anyOf(hasName("a"), hasName("b"))))))
+                  .collectRequiredNames(Names));
+  EXPECT_THAT(Names, testing::ElementsAre("a", "b"));
+
+  Names.clear();
+  EXPECT_TRUE(DynTypedMatcher(traverse(TK_IgnoreUnlessSpelledInSource,
+                                       namedDecl(hasName("a"))))
+                  .collectRequiredNames(Names));
+  EXPECT_THAT(Names, testing::ElementsAre("a"));
+
+  Names.clear();
+  EXPECT_FALSE(DynTypedMatcher(namedDecl(anyOf(hasName("a"), isImplicit())))
+                   .collectRequiredNames(Names));
+  EXPECT_FALSE(DynTypedMatcher(functionDecl(hasName("operator+")))
+                   .collectRequiredNames(Names));
+  EXPECT_FALSE(
+      DynTypedMatcher(
+          callExpr(isExpansionInMainFile(),
+                   traverse(TK_IgnoreUnlessSpelledInSource,
+                            callExpr(callee(namedDecl(hasName("a")))))))
+          .collectRequiredNames(Names));
+  EXPECT_TRUE(Names.empty());
+}
+
 TEST(IsInlineMatcher, IsInline) {
   EXPECT_TRUE(matches("void g(); inline void f();",
                       functionDecl(isInline(), hasName("f"))));
@@ -660,4 +660,30 @@ TEST_F(LexerTest, RawAndNormalLexSameForLineComments) {
   }
   EXPECT_TRUE(ToksView.empty());
 }
+
+TEST_F(LexerTest, LongRunsOfSimpleCharacters) {
+  // The lexer skips these runs 16 characters at a time, make sure it stops at
+  // the right character, also near the end of the buffer.
+  const llvm::StringLiteral Source =
+      "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ_0123456789+\n"
+      "                         \t\t\t\t\f\v x\n"
+      "\"a string literal with an \\\" in it, and a ? too\"\n"
+      "// a comment that is long enough to be skipped in blocks\n"
+      "// a comment with a multibyte character: \xc3\xa9 after some text\n"
+      "y // a comment at the end of the buffer";
+  auto Toks = Lex(Source);
+  ASSERT_EQ(Toks.size(), 5u);
+  EXPECT_EQ(Toks[0].getKind(), tok::identifier);
+  EXPECT_EQ(Toks[0].getLength(), 63u);
+  EXPECT_EQ(Toks[1].getKind(), tok::plus);
+  EXPECT_EQ(Toks[2].getKind(), tok::identifier);
+  EXPECT_EQ(PP->getSpelling(Toks[2]), "x");
+  EXPECT_TRUE(Toks[2].hasLeadingSpace());
+  EXPECT_EQ(Toks[3].getKind(), tok::string_literal);
+  EXPECT_EQ(PP->getSpelling(Toks[3]),
+            "\"a string literal with an \\\" in it, and a ? too\"");
+  EXPECT_EQ(Toks[4].getKind(), tok::identifier);
+  EXPECT_EQ(PP->getSpelling(Toks[4]), "y");
+  EXPECT_TRUE(Toks[4].isAtStartOfLine());
+}
 } // anonymous namespace
@@ -15,6 +15,7 @@
 #include "clang/Tooling/Tooling.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/TargetSelect.h"
+#include "llvm/Testing/Support/SupportHelpers.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include <algorithm>
@@ -426,6 +427,108 @@ TEST(findCompileArgsInJsonDatabase, ParsesCompilerWrappers) {
   }
 }
 
+static void writeFile(StringRef Path, StringRef Contents) {
+  std::error_code EC;
+  llvm::raw_fd_ostream OS(Path, EC);
+  ASSERT_FALSE(EC) << EC.message();
+  OS << Contents;
+}
+
+static std::unique_ptr<IndexedJSONCompilationDatabase>
+loadIndexed(const llvm::unittest::TempDir &Dir, StringRef JSONDatabase,
+            std::string &ErrorMessage) {
+  writeFile(Dir.path("compile_commands.json"), JSONDatabase);
+  return IndexedJSONCompilationDatabase::loadFromFile(
+      Dir.path("compile_commands.json"), Dir.path("index"), ErrorMessage,
+      JSONCommandLineSyntax::Gnu);
+}
+
+static std::string
+commandsToString(const std::vector<CompileCommand> &Commands) {
+  std::string Result;
+  for (const CompileCommand &Command : Commands)
+    Result += Command.Directory + "|" + Command.Filename + "|" +
+              llvm::join(Command.CommandLine, " ") + "|" + Command.Output +
+              "\n";
+  return Result;
+}
+
+TEST(IndexedJSONCompilationDatabase, MatchesJSONCompilationDatabase) {
+  llvm::unittest::TempDir Dir("indexed-cdb", /*Unique=*/true);
+  std::string JSONDatabase =
+      R"([{"directory":"//net/dir", "file":"file1", "command":"c1 -a"},)"
+      R"( {"directory":"//net/dir", "file":"//net/dir/file2",)"
+      R"(  "arguments":["c2", "-b c"], "output":"file2.o"},)"
+      R"( {"directory":"//net/dir/sub", "file":"../file1",)"
+      R"(  "command":"distcc c3 \"-d e\""}])";
+  std::string ErrorMessage;
+  std::unique_ptr<CompilationDatabase> Expected =
+      JSONCompilationDatabase::loadFromBuffer(JSONDatabase, ErrorMessage,
+                                              JSONCommandLineSyntax::Gnu);
+  ASSERT_TRUE(Expected) << ErrorMessage;
+
+  // Once with a fresh index, and once with the one written to disk.
+  for (unsigned Run = 0; Run != 2; ++Run) {
+    std::unique_ptr<IndexedJSONCompilationDatabase> Database =
+        loadIndexed(Dir, JSONDatabase, ErrorMessage);
+    ASSERT_TRUE(Database) << ErrorMessage;
+    EXPECT_TRUE(llvm::sys::fs::exists(Dir.path("index")));
+
+    std::vector<std::string> ExpectedFiles = Expected->getAllFiles();
+    llvm::sort(ExpectedFiles);
+    EXPECT_EQ(ExpectedFiles, Database->getAllFiles());
+    EXPECT_EQ(commandsToString(Expected->getAllCompileCommands()),
+              commandsToString(Database->getAllCompileCommands()));
+    for (StringRef File : {"//net/dir/file1", "//net/dir/file2",
+                           "//net/dir/sub/../file2", "//net/dir/file3"})
+      EXPECT_EQ(commandsToString(Expected->getCompileCommands(File)),
+                commandsToString(Database->getCompileCommands(File)))
+          << File;
+  }
+}
+
+TEST(IndexedJSONCompilationDatabase, RebuildsStaleIndex) {
+  llvm::unittest::TempDir Dir("indexed-cdb", /*Unique=*/true);
+  std::string ErrorMessage;
+  std::unique_ptr<IndexedJSONCompilationDatabase> Database = loadIndexed(
+      Dir,
+      R"([{"directory":"//net/dir", "file":"file1", "command":"c1"},)"
+      R"( {"directory":"//net/dir", "file":"file2", "command":"c2"}])",
+      ErrorMessage);
+  ASSERT_TRUE(Database) << ErrorMessage;
+  EXPECT_THAT(Database->getAllFiles(),
+              ElementsAre("//net/dir/file1", "//net/dir/file2"));
+
+  Database = loadIndexed(
+      Dir,
+      R"([{"directory":"//net/dir", "file":"file3", "command":"c3 -x"},)"
+      R"( {"directory":"//net/dir", "file":"file1", "command":"c1"}])",
+      ErrorMessage);
+  ASSERT_TRUE(Database) << ErrorMessage;
+  EXPECT_THAT(Database->getAllFiles(),
+              ElementsAre("//net/dir/file1", "//net/dir/file3"));
+  EXPECT_EQ(
+      "//net/dir|file3|c3 -x|\n",
+      commandsToString(Database->getCompileCommands("//net/dir/file3")));
+  EXPECT_EQ(
+      "//net/dir|file1|c1|\n",
+      commandsToString(Database->getCompileCommands("//net/dir/file1")));
+  EXPECT_TRUE(Database->getCompileCommands("//net/dir/file2").empty());
+}
+
+TEST(IndexedJSONCompilationDatabase, ErrsOnInvalidFormat) {
+  llvm::unittest::TempDir Dir("indexed-cdb", /*Unique=*/true);
+  std::string ErrorMessage;
+  for (StringRef Invalid :
+       {"{}", "[{]", "[{}]", "[{\"directory\":\"//net\",\"file\":\"f\"}]",
+        "[{\"directory\":\"//net\",\"file\":\"f\",\"command\":\"c\",\"x\":1}]",
+        "[{\"directory\":\"//net\",\"file\":\"f\",\"command\":\"c\"} {}]"}) {
+    EXPECT_FALSE(loadIndexed(Dir, Invalid, ErrorMessage)) << Invalid;
+    EXPECT_FALSE(ErrorMessage.empty()) << Invalid;
+    ErrorMessage.clear();
+  }
+}
+
 static std::vector<std::string> unescapeJsonCommandLine(StringRef Command) {
   std::string JsonDatabase =
     ("[{\"directory\":\"//net/root\", \"file\":\"test\", \"command\": \"" +
@@ -14,10 +14,12 @@
 #include "clang/Frontend/FrontendAction.h"
 #include "clang/Frontend/FrontendActions.h"
 #include "clang/Tooling/CompilationDatabase.h"
+#include "clang/Tooling/DependencyScanning/DependencyScanningPersistentCache.h"
 #include "clang/Tooling/DependencyScanning/DependencyScanningTool.h"
 #include "clang/Tooling/Tooling.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/MC/TargetRegistry.h"
+#include "llvm/Support/FileUtilities.h"
 #include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/TargetSelect.h"
@@ -239,3 +241,67 @@ TEST(DependencyScanner, ScanDepsWithFS) {
   EXPECT_EQ(convert_to_slash(DepFile),
             "test.cpp.o: /root/test.cpp /root/header.h\n");
 }
+
+TEST(DependencyScanner, ScanDepsWithPersistentCache) {
+  std::vector<std::string> CommandLine = {"clang",
+                                          "-target",
+                                          "x86_64-apple-macosx10.7",
+                                          "-c",
+                                          "test.cpp",
+                                          "-o"
+                                          "test.cpp.o"};
+  StringRef CWD = "/root";
+
+  auto VFS = new llvm::vfs::InMemoryFileSystem();
+  VFS->setCurrentWorkingDirectory(CWD);
+  auto Sept = llvm::sys::path::get_separator();
+  std::string HeaderPath =
+      std::string(llvm::formatv("{0}root{0}header.h", Sept));
+  std::string TestPath = std::string(llvm::formatv("{0}root{0}test.cpp", Sept));
+
+  VFS->addFile(HeaderPath, 0, llvm::MemoryBuffer::getMemBuffer("#define A\n"));
+  VFS->addFile(TestPath, 0,
+               llvm::MemoryBuffer::getMemBuffer("#include \"header.h\"\n"));
+
+  SmallString<128> CachePath;
+  ASSERT_FALSE(
+      llvm::sys::fs::createTemporaryFile("scan-deps", "cache", CachePath));
+  llvm::FileRemover RemoveCache(CachePath);
+
+  auto ScanWithCache = [&](DependencyScanningPersistentCache &Cache) {
+    DependencyScanningService Service(ScanningMode::DependencyDirectivesScan,
+                                      ScanningOutputFormat::Make);
+    Service.getSharedCache().setPersistentCache(&Cache);
+    DependencyScanningTool ScanTool(Service, VFS);
+    std::string DepFile;
+    ASSERT_THAT_ERROR(
+        ScanTool.getDependencyFile(CommandLine, CWD).moveInto(DepFile),
+        llvm::Succeeded());
+    using llvm::sys::path::convert_to_slash;
+    EXPECT_EQ(convert_to_slash(DepFile),
+              "test.cpp.o: /root/test.cpp /root/header.h\n");
+    ASSERT_THAT_ERROR(Cache.save(Service.getSharedCache()), llvm::Succeeded());
+  };
+
+  // The empty temporary file is not a valid cache.
+  auto Cache = DependencyScanningPersistentCache::open(CachePath);
+  EXPECT_EQ(Cache->size(), 0u);
+  ScanWithCache(*Cache);
+
+  Cache = DependencyScanningPersistentCache::open(CachePath);
+  EXPECT_GE(Cache->size(), 2u);
+  auto Stat = VFS->status(HeaderPath);
+  ASSERT_TRUE(Stat);
+  SmallVector<dependency_directives_scan::Token, 4> Tokens;
+  SmallVector<dependency_directives_scan::Directive, 4> Directives;
+  ASSERT_TRUE(Cache->lookup(*Stat, "#define A\n", Tokens, Directives));
+  ASSERT_EQ(Directives.size(), 2u);
+  EXPECT_EQ(Directives[0].Kind, dependency_directives_scan::pp_define);
+  EXPECT_EQ(Directives[1].Kind, dependency_directives_scan::pp_eof);
+  EXPECT_FALSE(Cache->lookup(*Stat, "#define B\n", Tokens, Directives));
+
+  // A warm scan gives the same result and keeps the entries.
+  ScanWithCache(*Cache);
+  Cache = DependencyScanningPersistentCache::open(CachePath);
+  EXPECT_TRUE(Cache->lookup(*Stat, "#define A\n", Tokens, Directives));
+}
@@ -153,7 +153,10 @@ struct EntropicOptions {
 };
 
 class InputCorpus {
+public:
   static const uint32_t kFeatureSetSize = 1 << 21;
+
+private:
   static const uint8_t kMaxMutationFactor = 20;
   static const size_t kSparseEnergyUpdates = 100;
 
@@ -9,6 +9,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "FuzzerCommand.h"
+#include "FuzzerCorpus.h"
 #include "FuzzerFork.h"
 #include "FuzzerIO.h"
 #include "FuzzerInternal.h"
@@ -92,6 +93,8 @@ struct GlobalEnv {
   std::string TempDir;
   std::string DFTDir;
   std::string DataFlowBinary;
+  std::string SharedFeaturesFile;
+  SharedBitMap SharedFeatures;
   std::set<uint32_t> Features, Cov;
   std::set<std::string> FilesWithDFT;
   std::vector<std::string> Files;
@@ -129,6 +132,8 @@ struct GlobalEnv {
     Cmd.addFlag("print_funcs", "0");  // no need to spend time symbolizing.
     Cmd.addFlag("max_total_time", std::to_string(std::min((size_t)300, JobId)));
     Cmd.addFlag("stop_file", StopFile());
+    if (SharedFeatures.IsInitialized())
+      Cmd.addFlag("shared_features", SharedFeaturesFile);
     if (!DataFlowBinary.empty()) {
       Cmd.addFlag("data_flow_trace", DFTDir);
       if (!Cmd.hasFlag("focus_function"))
@@ -234,7 +239,7 @@ struct GlobalEnv {
         !Job->Cmd.getFlagValue("set_cover_merge").compare("1");
     CrashResistantMerge(Args, {}, MergeCandidates, &FilesToAdd, Features,
                         &NewFeatures, Cov, &NewCov, Job->CFPath, false,
-                        IsSetCoverMerge);
+                        IsSetCoverMerge, /*NumJobs=*/1);
     for (auto &Path : FilesToAdd) {
       auto U = FileToVector(Path);
       auto NewPath = DirPlusFile(MainCorpusDir, Hash(U));
@@ -251,6 +256,7 @@ struct GlobalEnv {
       }
     }
     Features.insert(NewFeatures.begin(), NewFeatures.end());
+    PublishFeatures(NewFeatures);
     Cov.insert(NewCov.begin(), NewCov.end());
     for (auto Idx : NewCov)
       if (auto *TE = TPC.PCTableEntryByIdx(Idx))
@@ -259,6 +265,26 @@ struct GlobalEnv {
                   TPC.GetNextInstructionPc(TE->PC));
   }
 
+  // Creates the feature bit map shared with the jobs. The jobs set the bits of
+  // the features they find as soon as they find them, and only write out the
+  // inputs that find features no other job has, so that less time is spent
+  // merging inputs that are redundant with each other.
+  void InitSharedFeatures() {
+    const size_t NumBits = InputCorpus::kFeatureSetSize;
+    SharedFeaturesFile = DirPlusFile(TempDir, "features");
+    if (void *Mem = MapSharedFile(SharedFeaturesFile,
+                                  SharedBitMap::SizeInBytes(NumBits)))
+      SharedFeatures.Init(Mem, NumBits);
+    PublishFeatures(Features);
+  }
+
+  void PublishFeatures(const std::set<uint32_t> &NewFeatures) {
+    if (!SharedFeatures.IsInitialized())
+      return;
+    for (auto Ft : NewFeatures)
+      SharedFeatures.AddValue(Ft);
+  }
+
   void CollectDFT(const std::string &InputPath) {
     if (DataFlowBinary.empty()) return;
     if (!FilesWithDFT.insert(InputPath).second) return;
@@ -347,7 +373,8 @@ void FuzzWithFork(Random &Rand, const FuzzingOptions &Options,
     std::set<uint32_t> NewFeatures, NewCov;
     CrashResistantMerge(Env.Args, {}, SeedFiles, &Env.Files, Env.Features,
                         &NewFeatures, Env.Cov, &NewCov, CFPath,
-                        /*Verbose=*/false, /*IsSetCoverMerge=*/false);
+                        /*Verbose=*/false, /*IsSetCoverMerge=*/false,
+                        /*NumJobs=*/1);
     Env.Features.insert(NewFeatures.begin(), NewFeatures.end());
     Env.Cov.insert(NewFeatures.begin(), NewFeatures.end());
     RemoveFile(CFPath);
@@ -358,6 +385,8 @@ void FuzzWithFork(Random &Rand, const FuzzingOptions &Options,
       Env.FilesSizes.push_back(FileSize(path));
   }
 
+  Env.InitSharedFeatures();
+
   Printf("INFO: -fork=%d: %zd seed inputs, starting to fuzz in %s\n", NumJobs,
          Env.Files.size(), Env.TempDir.c_str());
 
@@ -410,7 +439,8 @@ void FuzzWithFork(Random &Rand, const FuzzingOptions &Options,
       Env.FilesSizes.clear();
       CrashResistantMerge(Env.Args, {}, CurrentSeedFiles, &Env.Files,
                           TmpFeatures, &TmpNewFeatures, TmpCov, &TmpNewCov,
-                          CFPath, /*Verbose=*/false, /*IsSetCoverMerge=*/false);
+                          CFPath, /*Verbose=*/false, /*IsSetCoverMerge=*/false,
+                          /*NumJobs=*/1);
       for (auto &path : Env.Files)
         Env.FilesSizes.push_back(FileSize(path));
       RemoveFile(CFPath);
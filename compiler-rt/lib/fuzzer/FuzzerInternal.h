@@ -148,6 +148,12 @@ private:
 
   std::vector<uint32_t> UniqFeatureSetTmp;
 
+  // Features found by any of the processes of -fork mode, if this is one.
+  SharedBitMap SharedFeatures;
+  // Set when the last unit added to the corpus only has features that another
+  // process has already found, so there is no need to pass it on.
+  bool NewUnitIsKnownElsewhere = false;
+
   // Need to know our own thread.
   static thread_local bool IsMyThread;
 };
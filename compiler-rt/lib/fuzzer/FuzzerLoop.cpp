@@ -158,6 +158,12 @@ Fuzzer::Fuzzer(UserCallback CB, InputCorpus &Corpus, MutationDispatcher &MD,
   AllocateCurrentUnitData();
   CurrentUnitSize = 0;
   memset(BaseSha1, 0, sizeof(BaseSha1));
+  if (!Options.SharedFeaturesFile.empty()) {
+    const size_t NumBits = InputCorpus::kFeatureSetSize;
+    if (void *Mem = MapSharedFile(Options.SharedFeaturesFile,
+                                  SharedBitMap::SizeInBytes(NumBits)))
+      SharedFeatures.Init(Mem, NumBits);
+  }
 }
 
 Fuzzer::~Fuzzer() {}
@@ -537,13 +543,22 @@ bool Fuzzer::RunOne(const uint8_t *Data, size_t Size, bool MayDeleteFile,
   PrintPulseAndReportSlowInput(Data, Size);
   size_t NumNewFeatures = Corpus.NumFeatureUpdates() - NumUpdatesBefore;
   if (NumNewFeatures || ForceAddToCorpus) {
+    // The unit is still added to our own corpus so that we keep fuzzing from
+    // it, but it is only passed on if it has a feature no process had before.
+    NewUnitIsKnownElsewhere =
+        SharedFeatures.IsInitialized() && !ForceAddToCorpus;
+    if (SharedFeatures.IsInitialized())
+      for (auto Feature : UniqFeatureSetTmp)
+        if (SharedFeatures.AddValue(Feature))
+          NewUnitIsKnownElsewhere = false;
     TPC.UpdateObservedPCs();
     auto NewII =
         Corpus.AddToCorpus({Data, Data + Size}, NumNewFeatures, MayDeleteFile,
                            TPC.ObservedFocusFunction(), ForceAddToCorpus,
                            TimeOfUnit, UniqFeatureSetTmp, DFT, II);
-    WriteFeatureSetToFile(Options.FeaturesDir, Sha1ToString(NewII->Sha1),
-                          NewII->UniqFeatureSet);
+    if (!NewUnitIsKnownElsewhere)
+      WriteFeatureSetToFile(Options.FeaturesDir, Sha1ToString(NewII->Sha1),
+                            NewII->UniqFeatureSet);
     WriteEdgeToMutationGraphFile(Options.MutationGraphFile, NewII, II,
                                  MD.MutationSequence());
     return true;
@@ -553,6 +568,7 @@ bool Fuzzer::RunOne(const uint8_t *Data, size_t Size, bool MayDeleteFile,
       FoundUniqFeaturesOfII == II->UniqFeatureSet.size() &&
       II->U.size() > Size) {
     auto OldFeaturesFile = Sha1ToString(II->Sha1);
+    NewUnitIsKnownElsewhere = false;
     Corpus.Replace(II, {Data, Data + Size}, TimeOfUnit);
     RenameFeatureSetFile(Options.FeaturesDir, OldFeaturesFile,
                          Sha1ToString(II->Sha1));
@@ -667,7 +683,8 @@ void Fuzzer::ReportNewCoverage(InputInfo *II, const Unit &U) {
   II->NumSuccessfullMutations++;
   MD.RecordSuccessfulMutationSequence();
   PrintStatusForNewUnit(U, II->Reduced ? "REDUCE" : "NEW   ");
-  WriteToOutputCorpus(U);
+  if (!NewUnitIsKnownElsewhere)
+    WriteToOutputCorpus(U);
   NumberOfNewUnitsAdded++;
   CheckExitOnSrcPosOrItem(); // Check only after the unit is saved to corpus.
   LastCorpusUpdateRun = TotalNumberOfRuns;
@@ -19,6 +19,8 @@
 #include <iterator>
 #include <set>
 #include <sstream>
+#include <thread>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace fuzzer {
@@ -423,6 +425,152 @@ WriteNewControlFile(const std::string &CFPath,
   return FilesToUse.size();
 }
 
+// Writes a control file in which every input has been processed, so that a
+// later merge using it only needs to execute the inputs it does not list.
+static void WriteCompletedControlFile(const std::string &CFPath,
+                                      const Merger &M) {
+  RemoveFile(CFPath);
+  std::ofstream ControlFile(CFPath);
+  ControlFile << M.Files.size() << "\n";
+  ControlFile << M.NumFilesInFirstCorpus << "\n";
+  for (auto &File : M.Files)
+    ControlFile << File.Name << "\n";
+  for (size_t i = 0; i < M.Files.size(); i++) {
+    auto &File = M.Files[i];
+    ControlFile << "STARTED " << i << " " << File.Size << "\n";
+    ControlFile << "FT " << i;
+    for (auto F : File.Features)
+      ControlFile << " " << F;
+    ControlFile << "\n";
+    ControlFile << "COV " << i;
+    for (auto C : File.Cov)
+      ControlFile << " " << C;
+    ControlFile << "\n";
+  }
+  if (!ControlFile)
+    Printf("MERGE-OUTER: failed to update the control file: %s\n",
+           CFPath.c_str());
+}
+
+// Returns the previously processed inputs that are still part of the corpora
+// and have not changed size since, so their coverage can be reused.
+static std::vector<MergeFileInfo>
+KnownUnchangedFiles(const std::vector<MergeFileInfo> &Processed,
+                    const std::vector<SizedFile> &OldCorpus,
+                    const std::vector<SizedFile> &NewCorpus) {
+  std::unordered_map<std::string, size_t> CurrentSizes;
+  for (auto &SF : OldCorpus)
+    CurrentSizes[SF.File] = SF.Size;
+  for (auto &SF : NewCorpus)
+    CurrentSizes[SF.File] = SF.Size;
+  std::vector<MergeFileInfo> Res;
+  for (auto &File : Processed) {
+    auto It = CurrentSizes.find(File.Name);
+    if (It != CurrentSizes.end() && It->second == File.Size)
+      Res.push_back(File);
+  }
+  return Res;
+}
+
+// Launches the inner process until it has processed all inputs in the control
+// file. Every inner process should execute at least one input.
+static void RunInnerMergeSteps(const Command &BaseCmd,
+                               const std::string &CFPath, size_t NumAttempts,
+                               bool CollectAllFeatures, bool V) {
+  for (size_t Attempt = 1; Attempt <= NumAttempts; Attempt++) {
+    Fuzzer::MaybeExitGracefully();
+    VPrintf(V, "MERGE-OUTER: attempt %zd\n", Attempt);
+    Command Cmd(BaseCmd);
+    Cmd.addFlag("merge_control_file", CFPath);
+    // If we are going to use the set cover implementation for
+    // minimization add the merge_inner=2 internal flag.
+    Cmd.addFlag("merge_inner", CollectAllFeatures ? "2" : "1");
+    if (!V) {
+      Cmd.setOutputFile(getDevNull());
+      Cmd.combineOutAndErr();
+    }
+    auto ExitCode = ExecuteCommand(Cmd);
+    if (!ExitCode) {
+      VPrintf(V, "MERGE-OUTER: successful in %zd attempt(s)\n", Attempt);
+      break;
+    }
+  }
+}
+
+static void ParseControlFileOrExit(const std::string &CFPath, Merger *M,
+                                   bool V) {
+  std::ifstream IF(CFPath);
+  IF.seekg(0, IF.end);
+  VPrintf(V, "MERGE-OUTER: the control file has %zd bytes\n",
+          (size_t)IF.tellg());
+  IF.seekg(0, IF.beg);
+  M->ParseOrExit(IF, true);
+  IF.close();
+}
+
+// Processes the inputs of the control file that have not been processed yet
+// in NumJobs concurrent worker processes. Inputs are dealt round-robin to
+// per-worker control files, so that every worker gets a similar mix of input
+// sizes, and each worker is restarted on its own after a crash. The workers
+// record every feature of every input, which makes the result of the merge
+// independent of how the inputs were sharded.
+static void ParallelMergeInternalSteps(const Command &BaseCmd,
+                                       const std::string &CFPath,
+                                       size_t NumJobs, Merger *M, bool V) {
+  ParseControlFileOrExit(CFPath, M, V);
+  size_t First = M->FirstNotProcessedFile;
+  size_t NumPending = M->Files.size() - First;
+  NumJobs = std::min(NumJobs, NumPending);
+  VPrintf(V, "MERGE-OUTER: processing %zd files in %zd jobs\n", NumPending,
+          NumJobs);
+
+  std::vector<std::string> ShardPaths(NumJobs);
+  std::vector<size_t> ShardSizes(NumJobs);
+  for (size_t J = 0; J < NumJobs; J++) {
+    ShardPaths[J] = CFPath + "." + std::to_string(J);
+    std::vector<std::string> Names;
+    size_t NumInFirstCorpus = 0;
+    for (size_t i = First + J; i < M->Files.size(); i += NumJobs) {
+      Names.push_back(M->Files[i].Name);
+      if (i < M->NumFilesInFirstCorpus)
+        NumInFirstCorpus++;
+    }
+    ShardSizes[J] = Names.size();
+    RemoveFile(ShardPaths[J]);
+    std::ofstream ShardFile(ShardPaths[J]);
+    ShardFile << Names.size() << "\n" << NumInFirstCorpus << "\n";
+    for (auto &Name : Names)
+      ShardFile << Name << "\n";
+    if (!ShardFile) {
+      Printf("MERGE-OUTER: failed to write to the control file: %s\n",
+             ShardPaths[J].c_str());
+      exit(1);
+    }
+  }
+
+  std::vector<std::thread> Threads;
+  for (size_t J = 0; J < NumJobs; J++)
+    Threads.push_back(std::thread([&, J] {
+      RunInnerMergeSteps(BaseCmd, ShardPaths[J], ShardSizes[J],
+                         /*CollectAllFeatures=*/true, V);
+    }));
+  for (auto &T : Threads)
+    T.join();
+
+  for (size_t J = 0; J < NumJobs; J++) {
+    Merger Shard;
+    ParseControlFileOrExit(ShardPaths[J], &Shard, V);
+    for (size_t k = 0; k < Shard.Files.size(); k++) {
+      auto &File = M->Files[First + J + k * NumJobs];
+      File.Size = Shard.Files[k].Size;
+      File.Features = std::move(Shard.Files[k].Features);
+      File.Cov = std::move(Shard.Files[k].Cov);
+    }
+    RemoveFile(ShardPaths[J]);
+  }
+  M->FirstNotProcessedFile = M->Files.size();
+}
+
 // Outer process. Does not call the target code and thus should not fail.
 void CrashResistantMerge(const std::vector<std::string> &Args,
                          const std::vector<SizedFile> &OldCorpus,
@@ -433,7 +581,7 @@ void CrashResistantMerge(const std::vector<std::string> &Args,
                          const std::set<uint32_t> &InitialCov,
                          std::set<uint32_t> *NewCov, const std::string &CFPath,
                          bool V, /*Verbose*/
-                         bool IsSetCoverMerge) {
+                         bool IsSetCoverMerge, size_t NumJobs) {
   if (NewCorpus.empty() && OldCorpus.empty()) return;  // Nothing to merge.
   size_t NumAttempts = 0;
   std::vector<MergeFileInfo> KnownFiles;
@@ -452,20 +600,21 @@ void CrashResistantMerge(const std::vector<std::string> &Args,
                M.LastFailure.c_str());
       if (M.FirstNotProcessedFile >= M.Files.size()) {
         // Merge has already been completed with the given merge control file.
-        if (M.Files.size() == OldCorpus.size() + NewCorpus.size()) {
+        KnownFiles = KnownUnchangedFiles(M.Files, OldCorpus, NewCorpus);
+        if (KnownFiles.size() == OldCorpus.size() + NewCorpus.size()) {
           VPrintf(
               V,
               "MERGE-OUTER: nothing to do, merge has been completed before\n");
           exit(0);
         }
 
-        // Number of input files likely changed, start merge from scratch, but
-        // reuse coverage information from the given merge control file.
+        // Some inputs are new or have changed, start merge from scratch, but
+        // reuse coverage information from the given merge control file for
+        // the unchanged ones.
         VPrintf(
             V,
             "MERGE-OUTER: starting merge from scratch, but reusing coverage "
             "information from the given control file\n");
-        KnownFiles = M.Files;
       } else {
         // There is a merge in progress, continue.
         NumAttempts = M.Files.size() - M.FirstNotProcessedFile;
@@ -484,45 +633,50 @@ void CrashResistantMerge(const std::vector<std::string> &Args,
     NumAttempts = WriteNewControlFile(CFPath, OldCorpus, NewCorpus, KnownFiles);
   }
 
-  // Execute the inner process until it passes.
-  // Every inner process should execute at least one input.
   Command BaseCmd(Args);
   BaseCmd.removeFlag("merge");
   BaseCmd.removeFlag("set_cover_merge");
+  BaseCmd.removeFlag("merge_jobs");
   BaseCmd.removeFlag("fork");
   BaseCmd.removeFlag("collect_data_flow");
-  for (size_t Attempt = 1; Attempt <= NumAttempts; Attempt++) {
-    Fuzzer::MaybeExitGracefully();
-    VPrintf(V, "MERGE-OUTER: attempt %zd\n", Attempt);
-    Command Cmd(BaseCmd);
-    Cmd.addFlag("merge_control_file", CFPath);
-    // If we are going to use the set cover implementation for
-    // minimization add the merge_inner=2 internal flag.
-    Cmd.addFlag("merge_inner", IsSetCoverMerge ? "2" : "1");
-    if (!V) {
-      Cmd.setOutputFile(getDevNull());
-      Cmd.combineOutAndErr();
-    }
-    auto ExitCode = ExecuteCommand(Cmd);
-    if (!ExitCode) {
-      VPrintf(V, "MERGE-OUTER: successful in %zd attempt(s)\n", Attempt);
-      break;
-    }
-  }
-  // Read the control file and do the merge.
+
+  // Execute the inner process(es) and read the control file.
   Merger M;
-  std::ifstream IF(CFPath);
-  IF.seekg(0, IF.end);
-  VPrintf(V, "MERGE-OUTER: the control file has %zd bytes\n",
-          (size_t)IF.tellg());
-  IF.seekg(0, IF.beg);
-  M.ParseOrExit(IF, true);
-  IF.close();
+  if (NumJobs > 1 && NumAttempts > 1) {
+    ParallelMergeInternalSteps(BaseCmd, CFPath, NumJobs, &M, V);
+  } else {
+    RunInnerMergeSteps(BaseCmd, CFPath, NumAttempts, IsSetCoverMerge, V);
+    ParseControlFileOrExit(CFPath, &M, V);
+  }
   VPrintf(V,
           "MERGE-OUTER: consumed %zdMb (%zdMb rss) to parse the control file\n",
           M.ApproximateMemoryConsumption() >> 20, GetPeakRSSMb());
 
-  M.Files.insert(M.Files.end(), KnownFiles.begin(), KnownFiles.end());
+  // Put the processed and the reused inputs back in corpus order, so that the
+  // reused inputs of the initial corpus are counted as part of it.
+  if (!KnownFiles.empty()) {
+    std::unordered_map<std::string, MergeFileInfo *> ByName;
+    for (auto &File : KnownFiles)
+      ByName[File.Name] = &File;
+    for (auto &File : M.Files)
+      ByName[File.Name] = &File;
+    std::vector<MergeFileInfo> Files;
+    for (auto &SF : OldCorpus)
+      if (ByName.count(SF.File))
+        Files.push_back(std::move(*ByName[SF.File]));
+    M.NumFilesInFirstCorpus = Files.size();
+    for (auto &SF : NewCorpus)
+      if (ByName.count(SF.File))
+        Files.push_back(std::move(*ByName[SF.File]));
+    M.Files = std::move(Files);
+    M.FirstNotProcessedFile = M.Files.size();
+  }
+
+  // Record the coverage of all inputs, so that the next merge with this
+  // control file only executes the inputs that are new or have changed.
+  if (M.FirstNotProcessedFile >= M.Files.size())
+    WriteCompletedControlFile(CFPath, M);
+
   if (IsSetCoverMerge)
     M.SetCoverMerge(InitialFeatures, NewFeatures, InitialCov, NewCov, NewFiles);
   else
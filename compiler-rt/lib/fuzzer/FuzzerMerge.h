@@ -35,6 +35,15 @@
 //   It uses a single pass greedy algorithm choosing first the smallest inputs
 //   within the same size the inputs that have more new features.
 //
+//   With -merge_jobs=N the unprocessed inputs are dealt to N control files,
+//   one per concurrently running chain of inner processes, and the results are
+//   combined by the outer process.
+//
+//   After a merge the control file is rewritten to list every input as
+//   processed. A later merge with the same control file reuses the recorded
+//   coverage of the inputs that still exist with the same size, and only
+//   executes the others.
+//
 //===----------------------------------------------------------------------===//
 
 #ifndef LLVM_FUZZER_MERGE_H
@@ -86,7 +95,7 @@ void CrashResistantMerge(const std::vector<std::string> &Args,
                          std::set<uint32_t> *NewFeatures,
                          const std::set<uint32_t> &InitialCov,
                          std::set<uint32_t> *NewCov, const std::string &CFPath,
-                         bool Verbose, bool IsSetCoverMerge);
+                         bool Verbose, bool IsSetCoverMerge, size_t NumJobs);
 
 }  // namespace fuzzer
 
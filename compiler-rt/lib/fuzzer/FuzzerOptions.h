@@ -60,6 +60,7 @@ struct FuzzingOptions {
   std::string DataFlowTrace;
   std::string CollectDataFlow;
   std::string FeaturesDir;
+  std::string SharedFeaturesFile;
   std::string MutationGraphFile;
   std::string StopFile;
   bool SaveArtifacts = true;
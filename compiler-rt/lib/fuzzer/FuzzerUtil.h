@@ -56,6 +56,11 @@ unsigned long GetPid();
 
 size_t GetPeakRSSMb();
 
+// Maps the first Size bytes of the file at Path, which is created or extended
+// as needed, into memory that is shared with every other process mapping it.
+// Returns nullptr on failure or if this is not supported on the platform.
+void *MapSharedFile(const std::string &Path, size_t Size);
+
 int ExecuteCommand(const Command &Cmd);
 bool ExecuteCommand(const Command &Cmd, std::string *CmdOutput);
 
@@ -402,6 +402,8 @@ size_t GetPeakRSSMb() {
   return (Info.mem_private_bytes + Info.mem_shared_bytes) >> 20;
 }
 
+void *MapSharedFile(const std::string &Path, size_t Size) { return nullptr; }
+
 template <typename Fn>
 class RunOnDestruction {
  public:
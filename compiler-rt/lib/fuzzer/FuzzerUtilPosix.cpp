@@ -16,6 +16,7 @@
 #include <chrono>
 #include <cstring>
 #include <errno.h>
+#include <fcntl.h>
 #include <iomanip>
 #include <signal.h>
 #include <stdio.h>
@@ -162,6 +163,17 @@ size_t GetPeakRSSMb() {
   return 0;
 }
 
+void *MapSharedFile(const std::string &Path, size_t Size) {
+  int Fd = open(Path.c_str(), O_RDWR | O_CREAT, 0600);
+  if (Fd < 0)
+    return nullptr;
+  void *Mem = MAP_FAILED;
+  if (ftruncate(Fd, static_cast<off_t>(Size)) == 0)
+    Mem = mmap(nullptr, Size, PROT_READ | PROT_WRITE, MAP_SHARED, Fd, 0);
+  close(Fd);
+  return Mem == MAP_FAILED ? nullptr : Mem;
+}
+
 FILE *OpenProcessPipe(const char *Command, const char *Mode) {
   return popen(Command, Mode);
 }
@@ -156,6 +156,8 @@ size_t GetPeakRSSMb() {
   return info.PeakWorkingSetSize >> 20;
 }
 
+void *MapSharedFile(const std::string &Path, size_t Size) { return nullptr; }
+
 FILE *OpenProcessPipe(const char *Command, const char *Mode) {
   return _popen(Command, Mode);
 }
@@ -12,6 +12,7 @@
 #define LLVM_FUZZER_VALUE_BIT_MAP_H
 
 #include "FuzzerPlatform.h"
+#include <atomic>
 #include <cstdint>
 
 namespace fuzzer {
@@ -68,6 +69,39 @@ struct ValueBitMap {
   ATTRIBUTE_ALIGNED(512) uintptr_t Map[kMapSizeInWords];
 };
 
+// A bit map over memory shared by several processes, e.g. a file that all the
+// workers of -fork mode map. Bits are only ever set, and they are set
+// atomically, so updates from concurrent processes are never lost.
+struct SharedBitMap {
+  static const size_t kBitsInWord = 64;
+
+  static size_t SizeInBytes(size_t SizeInBits) {
+    return (SizeInBits + kBitsInWord - 1) / kBitsInWord * sizeof(uint64_t);
+  }
+
+  void Init(void *Mem, size_t SizeInBits) {
+    Words = reinterpret_cast<std::atomic<uint64_t> *>(Mem);
+    NumBits = SizeInBits;
+  }
+
+  bool IsInitialized() const { return Words != nullptr; }
+
+  // Sets the bit for Value. Returns true if the bit was changed from 0 to 1,
+  // i.e. if no process has set it before.
+  ATTRIBUTE_NO_SANITIZE_ALL
+  inline bool AddValue(size_t Value) {
+    size_t Idx = Value % NumBits;
+    uint64_t Mask = 1ULL << (Idx % kBitsInWord);
+    return !(Words[Idx / kBitsInWord].fetch_or(Mask,
+                                               std::memory_order_relaxed) &
+             Mask);
+  }
+
+ private:
+  std::atomic<uint64_t> *Words = nullptr;
+  size_t NumBits = 0;
+};
+
 }  // namespace fuzzer
 
 #endif  // LLVM_FUZZER_VALUE_BIT_MAP_H
@@ -1164,6 +1164,23 @@ TEST(DFT, FunctionWeights) {
   EXPECT_GT(Weights[1], Weights[0]);
 }
 
+TEST(Fuzzer, SharedBitMap) {
+  const size_t NumBits = 1000;
+  std::vector<uint64_t> Mem(SharedBitMap::SizeInBytes(NumBits) /
+                            sizeof(uint64_t));
+  EXPECT_EQ(Mem.size(), 16U);
+  SharedBitMap M1, M2;
+  EXPECT_FALSE(M1.IsInitialized());
+  // Two maps over the same memory see each other's updates.
+  M1.Init(Mem.data(), NumBits);
+  M2.Init(Mem.data(), NumBits);
+  EXPECT_TRUE(M1.IsInitialized());
+  EXPECT_TRUE(M1.AddValue(5));
+  EXPECT_FALSE(M2.AddValue(5));
+  EXPECT_FALSE(M2.AddValue(NumBits + 5));
+  EXPECT_TRUE(M2.AddValue(999));
+  EXPECT_FALSE(M1.AddValue(999));
+}
 
 TEST(Fuzzer, ForEachNonZeroByte) {
   const size_t N = 64;
@@ -1055,6 +1055,10 @@ inline void AvoidCVE_2016_2143() {}
 struct StackDepotStats {
   uptr n_uniq_ids;
   uptr allocated;
+  // Number of insertions which missed the lock-free lookup and took the bucket
+  // lock, and how many of them found the bucket already locked.
+  uptr n_locked_puts = 0;
+  uptr n_contended_puts = 0;
 };
 
 // The default value for allocator_release_to_os_interval_ms common flag to
@@ -46,8 +46,12 @@ void *BackgroundThread(void *arg) {
       StackDepotStats stack_depot_stats = StackDepotGetStats();
       if (prev_reported_stack_depot_size * 11 / 10 <
           stack_depot_stats.allocated) {
-        Printf("%s: StackDepot: %zd ids; %zdM allocated\n", SanitizerToolName,
-               stack_depot_stats.n_uniq_ids, stack_depot_stats.allocated >> 20);
+        Printf("%s: StackDepot: %zd ids; %zdM allocated; %zd locked puts, "
+               "%zd contended\n",
+               SanitizerToolName, stack_depot_stats.n_uniq_ids,
+               stack_depot_stats.allocated >> 20,
+               stack_depot_stats.n_locked_puts,
+               stack_depot_stats.n_contended_puts);
         prev_reported_stack_depot_size = stack_depot_stats.allocated;
       }
     }
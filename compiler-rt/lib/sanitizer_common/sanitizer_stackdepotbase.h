@@ -49,6 +49,8 @@ class StackDepotBase {
     return {
         atomic_load_relaxed(&n_uniq_ids),
         nodes.MemoryUsage() + Node::allocated(),
+        atomic_load_relaxed(&n_locked_puts),
+        atomic_load_relaxed(&n_contended_puts),
     };
   }
 
@@ -64,11 +66,14 @@ class StackDepotBase {
  private:
   friend Node;
   u32 find(u32 s, args_type args, hash_type hash) const;
-  static u32 lock(atomic_uint32_t *p);
+  static u32 lock(atomic_uint32_t *p, bool *contended = nullptr);
   static void unlock(atomic_uint32_t *p, u32 s);
   atomic_uint32_t tab[kTabSize];  // Hash table of Node's.
 
   atomic_uint32_t n_uniq_ids;
+  // Only updated on the locked path of Put, the lookups stay contention free.
+  atomic_uint32_t n_locked_puts;
+  atomic_uint32_t n_contended_puts;
 
   TwoLevelMap<Node, kNodesSize1, kNodesSize2> nodes;
 
@@ -89,14 +94,18 @@ u32 StackDepotBase<Node, kReservedBits, kTabSizeLog>::find(
 }
 
 template <class Node, int kReservedBits, int kTabSizeLog>
-u32 StackDepotBase<Node, kReservedBits, kTabSizeLog>::lock(atomic_uint32_t *p) {
+u32 StackDepotBase<Node, kReservedBits, kTabSizeLog>::lock(atomic_uint32_t *p,
+                                                           bool *contended) {
   // Uses the pointer lsb as mutex.
   for (int i = 0;; i++) {
     u32 cmp = atomic_load(p, memory_order_relaxed);
     if ((cmp & kLockMask) == 0 &&
         atomic_compare_exchange_weak(p, &cmp, cmp | kLockMask,
-                                     memory_order_acquire))
+                                     memory_order_acquire)) {
+      if (contended)
+        *contended = i > 0;
       return cmp;
+    }
     if (i < 10)
       proc_yield(10);
     else
@@ -128,7 +137,11 @@ u32 StackDepotBase<Node, kReservedBits, kTabSizeLog>::Put(args_type args,
     return node;
 
   // If failed, lock, retry and insert new.
-  u32 s2 = lock(p);
+  bool contended;
+  u32 s2 = lock(p, &contended);
+  atomic_fetch_add(&n_locked_puts, 1, memory_order_relaxed);
+  if (contended)
+    atomic_fetch_add(&n_contended_puts, 1, memory_order_relaxed);
   if (s2 != s) {
     node = find(s2, args, h);
     if (node) {
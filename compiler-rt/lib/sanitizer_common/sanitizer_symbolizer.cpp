@@ -60,6 +60,17 @@ SymbolizedStack *SymbolizedStack::New(uptr addr) {
   return res;
 }
 
+SymbolizedStack *SymbolizedStack::Clone() const {
+  SymbolizedStack *res = New(info.address);
+  res->info = info;
+  res->info.module = info.module ? internal_strdup(info.module) : nullptr;
+  res->info.function = info.function ? internal_strdup(info.function) : nullptr;
+  res->info.file = info.file ? internal_strdup(info.file) : nullptr;
+  if (next)
+    res->next = next->Clone();
+  return res;
+}
+
 void SymbolizedStack::ClearAll() {
   info.Clear();
   if (next)
@@ -19,6 +19,7 @@
 #define SANITIZER_SYMBOLIZER_H
 
 #include "sanitizer_common.h"
+#include "sanitizer_dense_map.h"
 #include "sanitizer_mutex.h"
 #include "sanitizer_vector.h"
 
@@ -56,6 +57,8 @@ struct SymbolizedStack {
   SymbolizedStack *next;
   AddressInfo info;
   static SymbolizedStack *New(uptr addr);
+  // Returns a deep copy of current, and all subsequent frames.
+  SymbolizedStack *Clone() const;
   // Deletes current, and all subsequent frames in the linked list.
   // The object cannot be accessed after the call to this function.
   void ClearAll();
@@ -200,6 +203,14 @@ class Symbolizer final {
 
   IntrusiveList<SymbolizerTool> tools_;
 
+  // The frames returned by SymbolizePC so far, by PC. Symbolizing a PC may
+  // take a round trip to an external symbolizer process, and reports (leak
+  // reports in particular) share many of their frames. The cache is dropped
+  // with the list of modules, whose addresses it depends on, and by Flush.
+  DenseMap<uptr, SymbolizedStack *> pc_cache_;
+  static const uptr kMaxCachedPCs = 1 << 16;
+  void ClearPCCache();
+
   explicit Symbolizer(IntrusiveList<SymbolizerTool> tools);
 
   static LowLevelAllocator symbolizer_allocator_;
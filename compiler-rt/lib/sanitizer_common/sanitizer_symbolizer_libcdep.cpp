@@ -12,6 +12,7 @@
 
 #include "sanitizer_allocator_internal.h"
 #include "sanitizer_internal_defs.h"
+#include "sanitizer_placement_new.h"
 #include "sanitizer_platform.h"
 #include "sanitizer_symbolizer_internal.h"
 
@@ -84,21 +85,35 @@ const char *ExtractTokenUpToDelimiter(const char *str, const char *delimiter,
 
 SymbolizedStack *Symbolizer::SymbolizePC(uptr addr) {
   Lock l(&mu_);
-  SymbolizedStack *res = SymbolizedStack::New(addr);
+  // Look for the module first, which drops the cache if the list of modules
+  // has to be reloaded.
   auto *mod = FindModuleForAddress(addr);
   if (!mod)
-    return res;
+    return SymbolizedStack::New(addr);
+  if (auto *cached = pc_cache_.find(addr))
+    return cached->second->Clone();
+  SymbolizedStack *res = SymbolizedStack::New(addr);
   // Always fill data about module name and offset.
   res->info.FillModuleInfo(*mod);
   for (auto &tool : tools_) {
     SymbolizerScope sym_scope(this);
-    if (tool.SymbolizePC(addr, res)) {
-      return res;
-    }
+    if (tool.SymbolizePC(addr, res))
+      break;
   }
+  if (pc_cache_.size() >= kMaxCachedPCs)
+    ClearPCCache();
+  pc_cache_[addr] = res->Clone();
   return res;
 }
 
+void Symbolizer::ClearPCCache() {
+  pc_cache_.forEach([](auto &kv) {
+    kv.second->ClearAll();
+    return true;
+  });
+  pc_cache_.clear();
+}
+
 bool Symbolizer::SymbolizeData(uptr addr, DataInfo *info) {
   Lock l(&mu_);
   const char *module_name = nullptr;
@@ -152,6 +167,7 @@ bool Symbolizer::GetModuleNameAndOffsetForPC(uptr pc, const char **module_name,
 
 void Symbolizer::Flush() {
   Lock l(&mu_);
+  ClearPCCache();
   for (auto &tool : tools_) {
     SymbolizerScope sym_scope(this);
     tool.Flush();
@@ -182,6 +198,7 @@ bool Symbolizer::FindModuleNameAndOffsetForAddress(uptr address,
 }
 
 void Symbolizer::RefreshModules() {
+  ClearPCCache();
   modules_.init();
   fallback_modules_.fallbackInit();
   RAW_CHECK(modules_.size() > 0);
@@ -83,6 +83,22 @@ TEST_F(StackDepotTest, Several) {
   EXPECT_NE(i1, i2);
 }
 
+TEST_F(StackDepotTest, LockedPuts) {
+  uptr array1[] = {1, 2, 3, 4, 10};
+  StackTrace s1(array1, ARRAY_SIZE(array1));
+  uptr array2[] = {1, 2, 3, 4, 11};
+  StackTrace s2(array2, ARRAY_SIZE(array2));
+  StackDepotPut(s1);
+  StackDepotPut(s2);
+  StackDepotPut(s1);
+  StackDepotPut(s2);
+  StackDepotStats stats = StackDepotGetStats();
+  EXPECT_EQ(2u, stats.n_uniq_ids);
+  // The second puts of the stacks are served by the lock-free lookup.
+  EXPECT_EQ(2u, stats.n_locked_puts);
+  EXPECT_EQ(0u, stats.n_contended_puts);
+}
+
 TEST_F(StackDepotTest, Print) {
   uptr array1[] = {0x111, 0x222, 0x333, 0x444, 0x777};
   StackTrace s1(array1, ARRAY_SIZE(array1));
@@ -54,6 +54,32 @@ TEST(Symbolizer, ExtractTokenUpToDelimiter) {
   InternalFree(token);
 }
 
+TEST(Symbolizer, CloneSymbolizedStack) {
+  SymbolizedStack *frames = SymbolizedStack::New(0x1234);
+  frames->info.FillModuleInfo("/lib/module.so", 0x34, kModuleArchUnknown);
+  frames->info.function = internal_strdup("inlined");
+  frames->info.line = 12;
+  frames->next = SymbolizedStack::New(0x1234);
+  frames->next->info.function = internal_strdup("caller");
+  frames->next->info.file = internal_strdup("caller.cpp");
+
+  SymbolizedStack *copy = frames->Clone();
+  frames->ClearAll();
+
+  EXPECT_EQ(0x1234U, copy->info.address);
+  EXPECT_STREQ("/lib/module.so", copy->info.module);
+  EXPECT_EQ(0x34U, copy->info.module_offset);
+  EXPECT_STREQ("inlined", copy->info.function);
+  EXPECT_EQ(nullptr, copy->info.file);
+  EXPECT_EQ(12, copy->info.line);
+  ASSERT_NE(nullptr, copy->next);
+  EXPECT_EQ(nullptr, copy->next->info.module);
+  EXPECT_STREQ("caller", copy->next->info.function);
+  EXPECT_STREQ("caller.cpp", copy->next->info.file);
+  EXPECT_EQ(nullptr, copy->next->next);
+  copy->ClearAll();
+}
+
 #if !SANITIZER_WINDOWS
 TEST(Symbolizer, DemangleSwiftAndCXX) {
   // Swift names are not demangled in default llvm build because Swift
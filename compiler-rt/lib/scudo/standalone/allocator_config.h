@@ -51,6 +51,11 @@ namespace scudo {
 //   // Indicates support for offsetting the start of a region by
 //   // a random number of pages. Only used with primary64.
 //   static const bool PrimaryEnableRandomOffset = true;
+//   // Maps the regions in 2 MiB aligned extents advised as huge pages, and
+//   // only releases whole huge pages to the OS, to reduce TLB misses on
+//   // hosts with large heaps. Only used with primary64, and requires a
+//   // PrimaryRegionSizeLog of at least 26.
+//   static const bool PrimaryUseHugePages = false;
 //   // Call map for user memory with at least this size. Only used with
 //   // primary64.
 //   static const uptr PrimaryMapSizeIncrement = 1UL << 18;
@@ -77,6 +82,7 @@ struct DefaultConfig {
   typedef uptr PrimaryCompactPtrT;
   static const uptr PrimaryCompactPtrScale = 0;
   static const bool PrimaryEnableRandomOffset = true;
+  static const bool PrimaryUseHugePages = false;
   static const uptr PrimaryMapSizeIncrement = 1UL << 18;
 #else
   typedef SizeClassAllocator32<DefaultConfig> Primary;
@@ -108,6 +114,7 @@ struct AndroidConfig {
   static const uptr PrimaryCompactPtrScale = SCUDO_MIN_ALIGNMENT_LOG;
   static const uptr PrimaryGroupSizeLog = 20U;
   static const bool PrimaryEnableRandomOffset = true;
+  static const bool PrimaryUseHugePages = false;
   static const uptr PrimaryMapSizeIncrement = 1UL << 18;
 #else
   typedef SizeClassAllocator32<AndroidConfig> Primary;
@@ -141,6 +148,7 @@ struct AndroidSvelteConfig {
   static const uptr PrimaryCompactPtrScale = SCUDO_MIN_ALIGNMENT_LOG;
   static const uptr PrimaryGroupSizeLog = 18U;
   static const bool PrimaryEnableRandomOffset = true;
+  static const bool PrimaryUseHugePages = false;
   static const uptr PrimaryMapSizeIncrement = 1UL << 18;
 #else
   typedef SizeClassAllocator32<AndroidSvelteConfig> Primary;
@@ -173,6 +181,7 @@ struct FuchsiaConfig {
   static const uptr PrimaryGroupSizeLog = 30U;
   typedef u32 PrimaryCompactPtrT;
   static const bool PrimaryEnableRandomOffset = true;
+  static const bool PrimaryUseHugePages = false;
   static const uptr PrimaryMapSizeIncrement = 1UL << 18;
   static const uptr PrimaryCompactPtrScale = SCUDO_MIN_ALIGNMENT_LOG;
   static const s32 PrimaryMinReleaseToOsIntervalMs = INT32_MIN;
@@ -193,6 +202,7 @@ struct TrustyConfig {
   static const uptr PrimaryGroupSizeLog = 10U;
   typedef u32 PrimaryCompactPtrT;
   static const bool PrimaryEnableRandomOffset = false;
+  static const bool PrimaryUseHugePages = false;
   // Trusty is extremely memory-constrained so minimally round up map calls.
   static const uptr PrimaryMapSizeIncrement = 1UL << 4;
   static const uptr PrimaryCompactPtrScale = SCUDO_MIN_ALIGNMENT_LOG;
@@ -106,4 +106,45 @@ BENCHMARK_TEMPLATE(BM_malloc_free_loop, scudo::FuchsiaConfig)
     ->Range(MinIters, MaxIters);
 #endif
 
+template <typename Config, bool Batch>
+static void BM_malloc_free_batch(benchmark::State &State) {
+  using AllocatorT = scudo::Allocator<Config, PostInitCallback<Config>>;
+  auto Deleter = [](AllocatorT *A) {
+    A->unmapTestOnly();
+    delete A;
+  };
+  std::unique_ptr<AllocatorT, decltype(Deleter)> Allocator(new AllocatorT,
+                                                           Deleter);
+  CurrentAllocator = Allocator.get();
+
+  const size_t NumPtrs = State.range(0);
+  std::vector<void *> Ptrs(NumPtrs);
+
+  for (auto _ : State) {
+    size_t Size = 16;
+    for (void *&Ptr : Ptrs) {
+      Ptr = Allocator->allocate(Size, scudo::Chunk::Origin::Malloc);
+      benchmark::DoNotOptimize(Ptr);
+      Size = Size % 1024 + 16;
+    }
+    if (Batch) {
+      Allocator->deallocateBatch(Ptrs.data(), NumPtrs,
+                                 scudo::Chunk::Origin::Malloc);
+    } else {
+      for (void *Ptr : Ptrs)
+        Allocator->deallocate(Ptr, scudo::Chunk::Origin::Malloc);
+    }
+  }
+
+  State.SetItemsProcessed(uint64_t(State.iterations()) * uint64_t(NumPtrs));
+}
+
+static const size_t MinPtrs = 8;
+static const size_t MaxPtrs = 4 * 1024;
+
+BENCHMARK_TEMPLATE(BM_malloc_free_batch, scudo::AndroidConfig, false)
+    ->Range(MinPtrs, MaxPtrs);
+BENCHMARK_TEMPLATE(BM_malloc_free_batch, scudo::AndroidConfig, true)
+    ->Range(MinPtrs, MaxPtrs);
+
 BENCHMARK_MAIN();
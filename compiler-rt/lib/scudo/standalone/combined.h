@@ -528,54 +528,63 @@ public:
 
 #ifdef GWP_ASAN_HOOKS
     if (UNLIKELY(GuardedAlloc.pointerIsMine(Ptr))) {
-      GuardedAlloc.deallocate(Ptr);
-      Stats.lock();
-      Stats.add(StatFree, GuardedAllocSlotSize);
-      Stats.sub(StatAllocated, GuardedAllocSlotSize);
-      Stats.unlock();
+      deallocateGuarded(Ptr);
       return;
     }
 #endif // GWP_ASAN_HOOKS
 
-    if (UNLIKELY(!isAligned(reinterpret_cast<uptr>(Ptr), MinAlignment)))
-      reportMisalignedPointer(AllocatorAction::Deallocating, Ptr);
-
-    void *TaggedPtr = Ptr;
-    Ptr = getHeaderTaggedPointer(Ptr);
-
+    const Options Options = Primary.Options.load();
     Chunk::UnpackedHeader Header;
-    Chunk::loadHeader(Cookie, Ptr, &Header);
-
-    if (UNLIKELY(Header.State != Chunk::State::Allocated))
-      reportInvalidChunkState(AllocatorAction::Deallocating, Ptr);
+    uptr Size;
+    checkDeallocation(Options, Ptr, Origin, DeleteSize, &Header, &Size);
+    quarantineOrDeallocateChunk(Options, Ptr, &Header, Size);
+  }
 
+  // Deallocates the Count chunks of Ptrs, allocated with the Origin. This is
+  // equivalent to deallocating them one by one, except that the chunks going
+  // back to the Primary are handed to the thread cache under a single TSD lock.
+  void deallocateBatch(void **Ptrs, uptr Count, Chunk::Origin Origin) {
+    initThreadMaybe(/*MinimalInit=*/true);
     const Options Options = Primary.Options.load();
-    if (Options.get(OptionBit::DeallocTypeMismatch)) {
-      if (UNLIKELY(Header.OriginOrWasZeroed != Origin)) {
-        // With the exception of memalign'd chunks, that can be still be free'd.
-        if (Header.OriginOrWasZeroed != Chunk::Origin::Memalign ||
-            Origin != Chunk::Origin::Malloc)
-          reportDeallocTypeMismatch(AllocatorAction::Deallocating, Ptr,
-                                    Header.OriginOrWasZeroed, Origin);
+    constexpr uptr MaxBatchSize = 64U;
+    void *BatchPtrs[MaxBatchSize];
+    Chunk::UnpackedHeader BatchHeaders[MaxBatchSize];
+    uptr BatchSizes[MaxBatchSize];
+    for (uptr I = 0; I < Count;) {
+      uptr BatchSize = 0;
+      for (; I < Count && BatchSize < MaxBatchSize; I++) {
+        void *Ptr = Ptrs[I];
+        if (UNLIKELY(&__scudo_deallocate_hook))
+          __scudo_deallocate_hook(Ptr);
+        if (UNLIKELY(!Ptr))
+          continue;
+#ifdef GWP_ASAN_HOOKS
+        if (UNLIKELY(GuardedAlloc.pointerIsMine(Ptr))) {
+          deallocateGuarded(Ptr);
+          continue;
+        }
+#endif // GWP_ASAN_HOOKS
+        Chunk::UnpackedHeader *Header = &BatchHeaders[BatchSize];
+        checkDeallocation(Options, Ptr, Origin, /*DeleteSize=*/0, Header,
+                          &BatchSizes[BatchSize]);
+        // The Secondary has its own lock, don't take it under the TSD one.
+        if (!Header->ClassId) {
+          quarantineOrDeallocateChunk(Options, Ptr, Header,
+                                      BatchSizes[BatchSize]);
+          continue;
+        }
+        BatchPtrs[BatchSize++] = Ptr;
       }
+      if (!BatchSize)
+        continue;
+      bool UnlockRequired;
+      auto *TSD = TSDRegistry.getTSDAndLock(&UnlockRequired);
+      for (uptr J = 0; J < BatchSize; J++)
+        quarantineOrDeallocateChunk(Options, BatchPtrs[J], &BatchHeaders[J],
+                                    BatchSizes[J], TSD);
+      if (UnlockRequired)
+        TSD->unlock();
     }
-
-    // Try to detect deallocation with a wrong MTE tag by touching the first
-    // byte with a correctly tagged pointer. Skip zero-sized allocations that do
-    // not always store the correct tag value anywhere (for example, a zero
-    // size, 32 byte aligned allocation in a 32-byte size class will end up with
-    // header at offset 16 in the block, payload at offset 32, and no space to
-    // store the tag).
-    const uptr Size = getSize(Ptr, &Header);
-    if (useMemoryTagging<Params>(Options) && Size != 0)
-      *reinterpret_cast<volatile char *>(TaggedPtr);
-
-    if (DeleteSize && Options.get(OptionBit::DeleteSizeMismatch)) {
-      if (UNLIKELY(DeleteSize != Size))
-        reportDeleteSizeMismatch(Ptr, DeleteSize, Size);
-    }
-
-    quarantineOrDeallocateChunk(Options, TaggedPtr, &Header, Size);
   }
 
   void *reallocate(void *OldPtr, uptr NewSize, uptr Alignment = MinAlignment) {
@@ -1084,8 +1093,64 @@ private:
            reinterpret_cast<uptr>(Ptr) - SizeOrUnusedBytes;
   }
 
+  // Loads the header of the chunk of the (tagged) Ptr being deallocated and
+  // reports the errors of the deallocation: corrupted or not allocated chunk,
+  // and mismatching origin or size.
+  void checkDeallocation(Options Options, void *Ptr, Chunk::Origin Origin,
+                         uptr DeleteSize, Chunk::UnpackedHeader *Header,
+                         uptr *Size) {
+    if (UNLIKELY(!isAligned(reinterpret_cast<uptr>(Ptr), MinAlignment)))
+      reportMisalignedPointer(AllocatorAction::Deallocating, Ptr);
+
+    void *TaggedPtr = Ptr;
+    Ptr = getHeaderTaggedPointer(Ptr);
+
+    Chunk::loadHeader(Cookie, Ptr, Header);
+
+    if (UNLIKELY(Header->State != Chunk::State::Allocated))
+      reportInvalidChunkState(AllocatorAction::Deallocating, Ptr);
+
+    if (Options.get(OptionBit::DeallocTypeMismatch)) {
+      if (UNLIKELY(Header->OriginOrWasZeroed != Origin)) {
+        // With the exception of memalign'd chunks, that can be still be free'd.
+        if (Header->OriginOrWasZeroed != Chunk::Origin::Memalign ||
+            Origin != Chunk::Origin::Malloc)
+          reportDeallocTypeMismatch(AllocatorAction::Deallocating, Ptr,
+                                    Header->OriginOrWasZeroed, Origin);
+      }
+    }
+
+    // Try to detect deallocation with a wrong MTE tag by touching the first
+    // byte with a correctly tagged pointer. Skip zero-sized allocations that do
+    // not always store the correct tag value anywhere (for example, a zero
+    // size, 32 byte aligned allocation in a 32-byte size class will end up with
+    // header at offset 16 in the block, payload at offset 32, and no space to
+    // store the tag).
+    *Size = getSize(Ptr, Header);
+    if (useMemoryTagging<Params>(Options) && *Size != 0)
+      *reinterpret_cast<volatile char *>(TaggedPtr);
+
+    if (DeleteSize && Options.get(OptionBit::DeleteSizeMismatch)) {
+      if (UNLIKELY(DeleteSize != *Size))
+        reportDeleteSizeMismatch(Ptr, DeleteSize, *Size);
+    }
+  }
+
+#ifdef GWP_ASAN_HOOKS
+  void deallocateGuarded(void *Ptr) {
+    GuardedAlloc.deallocate(Ptr);
+    Stats.lock();
+    Stats.add(StatFree, GuardedAllocSlotSize);
+    Stats.sub(StatAllocated, GuardedAllocSlotSize);
+    Stats.unlock();
+  }
+#endif // GWP_ASAN_HOOKS
+
+  // If LockedTSD is provided, it is used instead of locking a TSD for the
+  // Primary chunks.
   void quarantineOrDeallocateChunk(Options Options, void *TaggedPtr,
-                                   Chunk::UnpackedHeader *Header, uptr Size) {
+                                   Chunk::UnpackedHeader *Header, uptr Size,
+                                   TSD<ThisT> *LockedTSD = nullptr) {
     void *Ptr = getHeaderTaggedPointer(TaggedPtr);
     Chunk::UnpackedHeader NewHeader = *Header;
     // If the quarantine is disabled, the actual size of a chunk is 0 or larger
@@ -1125,6 +1190,10 @@ private:
       void *BlockBegin = getBlockBegin(Ptr, &NewHeader);
       const uptr ClassId = NewHeader.ClassId;
       if (LIKELY(ClassId)) {
+        if (LockedTSD) {
+          LockedTSD->Cache.deallocate(ClassId, BlockBegin);
+          return;
+        }
         bool UnlockRequired;
         auto *TSD = TSDRegistry.getTSDAndLock(&UnlockRequired);
         TSD->Cache.deallocate(ClassId, BlockBegin);
@@ -1136,6 +1205,9 @@ private:
                     reinterpret_cast<uptr>(Ptr));
         Secondary.deallocate(Options, BlockBegin);
       }
+    } else if (LockedTSD) {
+      Quarantine.put(&LockedTSD->QuarantineCache,
+                     QuarantineCallback(*this, LockedTSD->Cache), Ptr, Size);
     } else {
       bool UnlockRequired;
       auto *TSD = TSDRegistry.getTSDAndLock(&UnlockRequired);
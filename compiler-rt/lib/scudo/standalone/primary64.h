@@ -29,6 +29,12 @@ namespace scudo {
 // PrimaryEnableRandomOffset is set, each Region actually starts at a random
 // offset from its base.
 //
+// If PrimaryUseHugePages is set, the Regions start on a huge page boundary and
+// are mapped in huge page multiples advised as such to the kernel, and memory
+// is only released to the OS by whole huge pages. Since the free blocks of the
+// lowest BatchGroups are handed out first, the allocations tend to fill the
+// first huge pages of a Region and leave the last ones free to be released.
+//
 // Regions are mapped incrementally on demand to fulfill allocation requests,
 // those mappings being split into equally sized Blocks based on the size class
 // they belong to. The Blocks created are shuffled to prevent predictable
@@ -71,12 +77,15 @@ public:
     const u64 Time = getMonotonicTime();
     if (!getRandom(reinterpret_cast<void *>(&Seed), sizeof(Seed)))
       Seed = static_cast<u32>(Time ^ (PrimaryBase >> 12));
-    const uptr PageSize = getPageSizeCached();
+    const uptr PageSize = UseHugePages ? HugePageSize : getPageSizeCached();
     for (uptr I = 0; I < NumClasses; I++) {
       RegionInfo *Region = getRegionInfo(I);
       // The actual start of a region is offset by a random number of pages
       // when PrimaryEnableRandomOffset is set.
-      Region->RegionBeg = getRegionBaseByClassId(I) +
+      uptr RegionBase = getRegionBaseByClassId(I);
+      if (UseHugePages)
+        RegionBase = roundUpTo(RegionBase, HugePageSize);
+      Region->RegionBeg = RegionBase +
                           (Config::PrimaryEnableRandomOffset
                                ? ((getRandomModN(&Seed, 16) + 1) * PageSize)
                                : 0);
@@ -208,6 +217,14 @@ public:
                 "allocations; remains %zu\n",
                 TotalMapped >> 20, 0U, PoppedBlocks,
                 PoppedBlocks - PushedBlocks);
+    if (UseHugePages) {
+      uptr HugePagesReleased = 0;
+      for (uptr I = 0; I < NumClasses; I++)
+        HugePagesReleased += getRegionInfo(I)->ReleaseInfo.HugePagesReleased;
+      Str->append("Stats: SizeClassAllocator64: %zu huge pages mapped; %zu "
+                  "released\n",
+                  TotalMapped / HugePageSize, HugePagesReleased);
+    }
 
     for (uptr I = 0; I < NumClasses; I++)
       getStats(Str, I, 0);
@@ -312,7 +329,13 @@ private:
   static const uptr NumClasses = SizeClassMap::NumClasses;
   static const uptr PrimarySize = RegionSize * NumClasses;
 
-  static const uptr MapSizeIncrement = Config::PrimaryMapSizeIncrement;
+  static const bool UseHugePages = Config::PrimaryUseHugePages;
+  static const uptr HugePageSize = 1UL << 21;
+  // Leave room for the alignment and the random offset of the Region.
+  static_assert(!UseHugePages || Config::PrimaryRegionSizeLog >= 26U, "");
+  static const uptr MapSizeIncrement =
+      UseHugePages ? roundUpTo(Config::PrimaryMapSizeIncrement, HugePageSize)
+                   : Config::PrimaryMapSizeIncrement;
   // Fill at most this number of batches from the newly map'd memory.
   static const u32 MaxNumBatches = SCUDO_ANDROID ? 4U : 8U;
 
@@ -325,6 +348,8 @@ private:
     uptr PushedBlocksAtLastRelease;
     uptr RangesReleased;
     uptr LastReleasedBytes;
+    // Only maintained with PrimaryUseHugePages.
+    uptr HugePagesReleased;
     u64 LastReleaseAtNs;
   };
 
@@ -591,12 +616,15 @@ private:
               reinterpret_cast<void *>(RegionBeg + MappedUser), MapSize,
               "scudo:primary",
               MAP_ALLOWNOMEM | MAP_RESIZABLE |
-                  (useMemoryTagging<Config>(Options.load()) ? MAP_MEMTAG : 0),
+                  (useMemoryTagging<Config>(Options.load()) ? MAP_MEMTAG : 0) |
+                  (UseHugePages ? MAP_HUGEPAGE : 0),
               &Region->Data))) {
         return false;
       }
       Region->MappedUser += MapSize;
       C->getStats().add(StatMapped, MapSize);
+      if (UseHugePages)
+        C->getStats().add(StatMappedHuge, MapSize);
     }
 
     const u32 NumberOfBlocks = Min(
@@ -655,6 +683,9 @@ private:
                                  bool Force = false) {
     const uptr BlockSize = getSizeByClassId(ClassId);
     const uptr PageSize = getPageSizeCached();
+    // Releasing part of a huge page would split it back into small pages, so
+    // only whole huge pages are released.
+    const uptr ReleasePageSize = UseHugePages ? HugePageSize : PageSize;
 
     DCHECK_GE(Region->Stats.PoppedBlocks, Region->Stats.PushedBlocks);
     const uptr BytesInFreeList =
@@ -691,7 +722,8 @@ private:
     const uptr GroupSize = (1U << GroupSizeLog);
     const uptr AllocatedUserEnd = Region->AllocatedUser + Region->RegionBeg;
     ReleaseRecorder Recorder(Region->RegionBeg, &Region->Data);
-    PageReleaseContext Context(BlockSize, RegionSize, /*NumberOfRegions=*/1U);
+    PageReleaseContext Context(BlockSize, RegionSize, /*NumberOfRegions=*/1U,
+                               ReleasePageSize);
 
     const uptr CompactPtrBase = getCompactPtrBaseByClassId(ClassId);
     auto DecompactPtr = [CompactPtrBase](CompactPtrT CompactPtr) {
@@ -764,6 +796,15 @@ private:
     if (!Context.hasBlockMarked())
       return 0;
 
+    // The end of the last huge page is mapped but has never been handed out,
+    // so it doesn't prevent releasing that huge page.
+    if (UseHugePages) {
+      Context.markRangeAsFree(
+          /*RegionIndex=*/0U, Region->AllocatedUser,
+          Min(roundUpTo(Region->AllocatedUser, HugePageSize),
+              Region->MappedUser));
+    }
+
     auto SkipRegion = [](UNUSED uptr RegionIndex) { return false; };
     releaseFreeMemoryToOS(Context, Recorder, SkipRegion);
 
@@ -772,6 +813,9 @@ private:
           Region->Stats.PushedBlocks;
       Region->ReleaseInfo.RangesReleased += Recorder.getReleasedRangesCount();
       Region->ReleaseInfo.LastReleasedBytes = Recorder.getReleasedBytes();
+      if (UseHugePages)
+        Region->ReleaseInfo.HugePagesReleased +=
+            Recorder.getReleasedBytes() / HugePageSize;
     }
     Region->ReleaseInfo.LastReleaseAtNs = getMonotonicTime();
     return Recorder.getReleasedBytes();
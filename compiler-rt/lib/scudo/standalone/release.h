@@ -180,8 +180,10 @@ private:
 
 template <class ReleaseRecorderT> class FreePagesRangeTracker {
 public:
-  explicit FreePagesRangeTracker(ReleaseRecorderT &Recorder)
-      : Recorder(Recorder), PageSizeLog(getLog2(getPageSizeCached())) {}
+  explicit FreePagesRangeTracker(
+      ReleaseRecorderT &Recorder,
+      uptr PageSizeLog = getLog2(getPageSizeCached()))
+      : Recorder(Recorder), PageSizeLog(PageSizeLog) {}
 
   void processNextPage(bool Released) {
     if (Released) {
@@ -219,11 +221,16 @@ private:
 };
 
 struct PageReleaseContext {
-  PageReleaseContext(uptr BlockSize, uptr RegionSize, uptr NumberOfRegions) :
+  // The memory is released in units of ReleasePageSize, which defaults to the
+  // system page size. A larger power of two, like the huge page size, only
+  // releases the ranges which are entirely free at that granularity.
+  PageReleaseContext(uptr BlockSize, uptr RegionSize, uptr NumberOfRegions,
+                     uptr ReleasePageSize = 0) :
       BlockSize(BlockSize),
       RegionSize(RegionSize),
       NumberOfRegions(NumberOfRegions) {
-    PageSize = getPageSizeCached();
+    PageSize = ReleasePageSize ? ReleasePageSize : getPageSizeCached();
+    DCHECK(isPowerOfTwo(PageSize));
     if (BlockSize <= PageSize) {
       if (PageSize % BlockSize == 0) {
         // Same number of chunks per page, no cross overs.
@@ -320,6 +327,16 @@ struct PageReleaseContext {
     }
   }
 
+  // Counts the block slots starting in [From, To) of a region as free. This is
+  // used for the memory mapped past the last allocated block, which holds no
+  // block in use. From must be at a block boundary.
+  void markRangeAsFree(uptr RegionIndex, uptr From, uptr To) {
+    ensurePageMapAllocated();
+    for (uptr P = From; P < To && P < RegionSize; P += BlockSize)
+      PageMap.incRange(RegionIndex, P >> PageSizeLog,
+                       (P + BlockSize - 1) >> PageSizeLog);
+  }
+
   uptr BlockSize;
   uptr RegionSize;
   uptr NumberOfRegions;
@@ -350,7 +367,8 @@ releaseFreeMemoryToOS(PageReleaseContext &Context,
 
   // Iterate over pages detecting ranges of pages with chunk Counters equal
   // to the expected number of chunks for the particular page.
-  FreePagesRangeTracker<ReleaseRecorderT> RangeTracker(Recorder);
+  FreePagesRangeTracker<ReleaseRecorderT> RangeTracker(Recorder,
+                                                       Context.PageSizeLog);
   if (SameBlockCountPerPage) {
     // Fast path, every page has the same number of chunks affecting it.
     for (uptr I = 0; I < NumberOfRegions; I++) {
@@ -18,7 +18,15 @@
 namespace scudo {
 
 // Memory allocator statistics
-enum StatType { StatAllocated, StatFree, StatMapped, StatCount };
+// StatMappedHuge is the part of StatMapped which is backed by huge page aligned
+// extents advised to the kernel as such.
+enum StatType {
+  StatAllocated,
+  StatFree,
+  StatMapped,
+  StatMappedHuge,
+  StatCount
+};
 
 typedef uptr StatCounters[StatCount];
 
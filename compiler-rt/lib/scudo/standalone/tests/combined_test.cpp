@@ -275,6 +275,34 @@ SCUDO_TYPED_TEST(ScudoCombinedTest, BlockReuse) {
   EXPECT_TRUE(Found);
 }
 
+SCUDO_TYPED_TEST(ScudoCombinedTest, DeallocateBatch) {
+  auto *Allocator = this->Allocator.get();
+
+  // Mix Primary and Secondary chunks, more than a batch of them, and null
+  // pointers, then check that none of them is left allocated. As for
+  // IterateOverChunks, this requires no other allocated chunk.
+  if (!UseQuarantine) {
+    std::vector<void *> V;
+    for (scudo::uptr I = 0; I < 200U; I++) {
+      const scudo::uptr Size =
+          I % 50U == 0 ? TypeParam::Primary::SizeClassMap::MaxSize * 2U
+                       : 1U + rand() % 1024U;
+      V.push_back(I % 70U == 0 ? nullptr : Allocator->allocate(Size, Origin));
+    }
+    Allocator->deallocateBatch(V.data(), V.size(), Origin);
+    Allocator->disable();
+    Allocator->iterateOverChunks(
+        0U, static_cast<scudo::uptr>(SCUDO_MMAP_RANGE_SIZE - 1),
+        [](uintptr_t Base, size_t Size, void *Arg) {
+          std::vector<void *> *V = reinterpret_cast<std::vector<void *> *>(Arg);
+          void *P = reinterpret_cast<void *>(Base);
+          EXPECT_EQ(std::find(V->begin(), V->end(), P), V->end());
+        },
+        reinterpret_cast<void *>(&V));
+    Allocator->enable();
+  }
+}
+
 SCUDO_TYPED_TEST(ScudoCombinedTest, ReallocateLargeIncreasing) {
   auto *Allocator = this->Allocator.get();
 
@@ -546,6 +574,7 @@ struct DeathConfig {
   typedef scudo::uptr PrimaryCompactPtrT;
   static const scudo::uptr PrimaryCompactPtrScale = 0;
   static const bool PrimaryEnableRandomOffset = true;
+  static const bool PrimaryUseHugePages = false;
   static const scudo::uptr PrimaryMapSizeIncrement = 1UL << 18;
   static const scudo::uptr PrimaryGroupSizeLog = 18;
 
@@ -34,6 +34,7 @@ struct TestConfig1 {
   typedef scudo::uptr PrimaryCompactPtrT;
   static const scudo::uptr PrimaryCompactPtrScale = 0;
   static const bool PrimaryEnableRandomOffset = true;
+  static const bool PrimaryUseHugePages = false;
   static const scudo::uptr PrimaryMapSizeIncrement = 1UL << 18;
 };
 
@@ -51,6 +52,7 @@ struct TestConfig2 {
   typedef scudo::uptr PrimaryCompactPtrT;
   static const scudo::uptr PrimaryCompactPtrScale = 0;
   static const bool PrimaryEnableRandomOffset = true;
+  static const bool PrimaryUseHugePages = false;
   static const scudo::uptr PrimaryMapSizeIncrement = 1UL << 18;
 };
 
@@ -68,6 +70,7 @@ struct TestConfig3 {
   typedef scudo::uptr PrimaryCompactPtrT;
   static const scudo::uptr PrimaryCompactPtrScale = 0;
   static const bool PrimaryEnableRandomOffset = true;
+  static const bool PrimaryUseHugePages = false;
   static const scudo::uptr PrimaryMapSizeIncrement = 1UL << 18;
 };
 
@@ -85,6 +88,20 @@ struct TestConfig4 {
   static const scudo::uptr PrimaryGroupSizeLog = 20U;
   typedef scudo::u32 PrimaryCompactPtrT;
   static const bool PrimaryEnableRandomOffset = true;
+  static const bool PrimaryUseHugePages = false;
+  static const scudo::uptr PrimaryMapSizeIncrement = 1UL << 18;
+};
+
+struct TestConfig5 {
+  static const scudo::uptr PrimaryRegionSizeLog = 28U;
+  static const scudo::uptr PrimaryGroupSizeLog = 21U;
+  static const scudo::s32 PrimaryMinReleaseToOsIntervalMs = INT32_MIN;
+  static const scudo::s32 PrimaryMaxReleaseToOsIntervalMs = INT32_MAX;
+  static const bool MaySupportMemoryTagging = false;
+  typedef scudo::uptr PrimaryCompactPtrT;
+  static const scudo::uptr PrimaryCompactPtrScale = 0;
+  static const bool PrimaryEnableRandomOffset = true;
+  static const bool PrimaryUseHugePages = true;
   static const scudo::uptr PrimaryMapSizeIncrement = 1UL << 18;
 };
 
@@ -124,7 +141,8 @@ template <class BaseConfig> struct ScudoPrimaryTest : public Test {};
   SCUDO_TYPED_TEST_TYPE(FIXTURE, NAME, TestConfig1)                            \
   SCUDO_TYPED_TEST_TYPE(FIXTURE, NAME, TestConfig2)                            \
   SCUDO_TYPED_TEST_TYPE(FIXTURE, NAME, TestConfig3)                            \
-  SCUDO_TYPED_TEST_TYPE(FIXTURE, NAME, TestConfig4)
+  SCUDO_TYPED_TEST_TYPE(FIXTURE, NAME, TestConfig4)                            \
+  SCUDO_TYPED_TEST_TYPE(FIXTURE, NAME, TestConfig5)
 #endif
 
 #define SCUDO_TYPED_TEST_TYPE(FIXTURE, NAME, TYPE)                             \
@@ -176,6 +194,7 @@ struct SmallRegionsConfig {
   typedef scudo::uptr PrimaryCompactPtrT;
   static const scudo::uptr PrimaryCompactPtrScale = 0;
   static const bool PrimaryEnableRandomOffset = true;
+  static const bool PrimaryUseHugePages = false;
   static const scudo::uptr PrimaryMapSizeIncrement = 1UL << 18;
   static const scudo::uptr PrimaryGroupSizeLog = 20U;
 };
@@ -20,6 +20,12 @@
 void operator delete(void *, size_t) noexcept;
 void operator delete[](void *, size_t) noexcept;
 
+enum class __hot_cold_t : uint8_t {};
+void *operator new(size_t, __hot_cold_t);
+void *operator new[](size_t, __hot_cold_t);
+void *operator new(size_t, const std::nothrow_t &, __hot_cold_t) noexcept;
+void *operator new[](size_t, const std::nothrow_t &, __hot_cold_t) noexcept;
+
 // Note that every Cxx allocation function in the test binary will be fulfilled
 // by Scudo. See the comment in the C counterpart of this file.
 
@@ -84,6 +90,32 @@ TEST(ScudoWrappersCppDeathTest, New) {
   testCxxNew<Pixel>();
 }
 
+TEST(ScudoWrappersCppTest, HotColdNew) {
+  const size_t Size = 64U;
+  for (uint8_t Hint : {0U, 1U, 128U, 255U}) {
+    const __hot_cold_t HotCold = static_cast<__hot_cold_t>(Hint);
+    void *P = operator new(Size, HotCold);
+    EXPECT_NE(P, nullptr);
+    memset(P, 0x42, Size);
+    operator delete(P);
+
+    P = operator new[](Size, HotCold);
+    EXPECT_NE(P, nullptr);
+    memset(P, 0x42, Size);
+    operator delete[](P);
+
+    P = operator new(Size, std::nothrow, HotCold);
+    EXPECT_NE(P, nullptr);
+    memset(P, 0x42, Size);
+    operator delete(P);
+
+    P = operator new[](Size, std::nothrow, HotCold);
+    EXPECT_NE(P, nullptr);
+    memset(P, 0x42, Size);
+    operator delete[](P);
+  }
+}
+
 static std::mutex Mutex;
 static std::condition_variable Cv;
 static bool Ready;
@@ -34,4 +34,8 @@ scudo::Allocator<scudo::Config, SCUDO_PREFIX(malloc_postinit)> SCUDO_ALLOCATOR;
 
 extern "C" INTERFACE void __scudo_print_stats(void) { Allocator.printStats(); }
 
+extern "C" INTERFACE void __scudo_free_batch(void **ptrs, size_t count) {
+  Allocator.deallocateBatch(ptrs, count, scudo::Chunk::Origin::Malloc);
+}
+
 #endif // !SCUDO_ANDROID || !_BIONIC
@@ -50,6 +50,10 @@ static scudo::Allocator<scudo::AndroidSvelteConfig,
 // TODO(kostyak): support both allocators.
 INTERFACE void __scudo_print_stats(void) { Allocator.printStats(); }
 
+INTERFACE void __scudo_free_batch(void **ptrs, size_t count) {
+  Allocator.deallocateBatch(ptrs, count, scudo::Chunk::Origin::Malloc);
+}
+
 INTERFACE void
 __scudo_get_error_info(struct scudo_error_info *error_info,
                        uintptr_t fault_addr, const char *stack_depot,
@@ -21,6 +21,12 @@ struct nothrow_t {};
 enum class align_val_t : size_t {};
 } // namespace std
 
+// Hint passed by the compiler to the operator new variants below when a
+// memory profile found the allocation to be hot or cold. Lower values are
+// colder. Scudo does not segregate hot and cold allocations yet, so the
+// hint is accepted and ignored.
+enum class __hot_cold_t : uint8_t {};
+
 INTERFACE WEAK void *operator new(size_t size) {
   return Allocator.allocate(size, scudo::Chunk::Origin::New);
 }
@@ -54,6 +60,43 @@ INTERFACE WEAK void *operator new[](size_t size, std::align_val_t align,
                             static_cast<scudo::uptr>(align));
 }
 
+INTERFACE WEAK void *operator new(size_t size, __hot_cold_t) {
+  return Allocator.allocate(size, scudo::Chunk::Origin::New);
+}
+INTERFACE WEAK void *operator new[](size_t size, __hot_cold_t) {
+  return Allocator.allocate(size, scudo::Chunk::Origin::NewArray);
+}
+INTERFACE WEAK void *operator new(size_t size, std::nothrow_t const &,
+                                  __hot_cold_t) NOEXCEPT {
+  return Allocator.allocate(size, scudo::Chunk::Origin::New);
+}
+INTERFACE WEAK void *operator new[](size_t size, std::nothrow_t const &,
+                                    __hot_cold_t) NOEXCEPT {
+  return Allocator.allocate(size, scudo::Chunk::Origin::NewArray);
+}
+INTERFACE WEAK void *operator new(size_t size, std::align_val_t align,
+                                  __hot_cold_t) {
+  return Allocator.allocate(size, scudo::Chunk::Origin::New,
+                            static_cast<scudo::uptr>(align));
+}
+INTERFACE WEAK void *operator new[](size_t size, std::align_val_t align,
+                                    __hot_cold_t) {
+  return Allocator.allocate(size, scudo::Chunk::Origin::NewArray,
+                            static_cast<scudo::uptr>(align));
+}
+INTERFACE WEAK void *operator new(size_t size, std::align_val_t align,
+                                  std::nothrow_t const &,
+                                  __hot_cold_t) NOEXCEPT {
+  return Allocator.allocate(size, scudo::Chunk::Origin::New,
+                            static_cast<scudo::uptr>(align));
+}
+INTERFACE WEAK void *operator new[](size_t size, std::align_val_t align,
+                                    std::nothrow_t const &,
+                                    __hot_cold_t) NOEXCEPT {
+  return Allocator.allocate(size, scudo::Chunk::Origin::NewArray,
+                            static_cast<scudo::uptr>(align));
+}
+
 INTERFACE WEAK void operator delete(void *ptr) NOEXCEPT {
   Allocator.deallocate(ptr, scudo::Chunk::Origin::New);
 }
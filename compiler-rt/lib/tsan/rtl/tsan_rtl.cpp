@@ -957,6 +957,8 @@ void TraceSwitchPartImpl(ThreadState* thr) {
   TracePart* part = TracePartAlloc(thr);
   part->trace = trace;
   thr->trace_prev_pc = 0;
+  // Pick a different set of sampled PCs for the new part.
+  thr->access_sample_seed = thr->access_sample_seed * 1103515245u + 12345u;
   TracePart* recycle = nullptr;
   // Keep roughly half of parts local to the thread
   // (not queued into the recycle queue).
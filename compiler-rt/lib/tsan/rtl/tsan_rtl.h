@@ -167,6 +167,10 @@ struct ThreadState {
   atomic_uintptr_t trace_pos;
   // PC of the last memory access, used to compute PC deltas in the trace.
   uptr trace_prev_pc;
+  // If non-zero, only accesses whose PC hashes below this value are checked
+  // (see access_sample_percent flag). The seed changes with every trace part.
+  u32 access_sample_threshold;
+  u32 access_sample_seed;
 
   // Technically `current` should be a separate THREADLOCAL variable;
   // but it is placed here in order to share cache line with previous fields.
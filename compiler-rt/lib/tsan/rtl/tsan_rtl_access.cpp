@@ -417,8 +417,23 @@ NOINLINE void TraceRestartMemoryAccess(ThreadState* thr, uptr pc, uptr addr,
   MemoryAccess(thr, pc, addr, size, typ);
 }
 
+// With access_sample_percent < 100 only accesses from a subset of PCs are
+// checked. The PC is hashed together with a per-thread seed that changes on
+// every trace part switch, so over time every PC gets checked and a racy
+// access that executes often is still caught.
+ALWAYS_INLINE bool AccessSampledOut(ThreadState* thr, uptr pc) {
+  const u32 threshold = thr->access_sample_threshold;
+  if (LIKELY(threshold == 0))
+    return false;
+  const u64 hash = (static_cast<u64>(pc) ^ thr->access_sample_seed) *
+                   0x9e3779b97f4a7c15ull;
+  return static_cast<u32>(hash >> 32) >= threshold;
+}
+
 ALWAYS_INLINE USED void MemoryAccess(ThreadState* thr, uptr pc, uptr addr,
                                      uptr size, AccessType typ) {
+  if (UNLIKELY(AccessSampledOut(thr, pc)))
+    return;
   RawShadow* shadow_mem = MemToShadow(addr);
   UNUSED char memBuf[4][64];
   DPrintf2("#%d: Access: %d@%d %p/%zd typ=0x%x {%s, %s, %s, %s}\n", thr->tid,
@@ -455,7 +470,7 @@ ALWAYS_INLINE USED void MemoryAccess16(ThreadState* thr, uptr pc, uptr addr,
                                        AccessType typ) {
   const uptr size = 16;
   FastState fast_state = thr->fast_state;
-  if (UNLIKELY(fast_state.GetIgnoreBit()))
+  if (UNLIKELY(fast_state.GetIgnoreBit() || AccessSampledOut(thr, pc)))
     return;
   Shadow cur(fast_state, 0, 8, typ);
   RawShadow* shadow_mem = MemToShadow(addr);
@@ -492,7 +507,7 @@ ALWAYS_INLINE USED void UnalignedMemoryAccess(ThreadState* thr, uptr pc,
                                               AccessType typ) {
   DCHECK_LE(size, 8);
   FastState fast_state = thr->fast_state;
-  if (UNLIKELY(fast_state.GetIgnoreBit()))
+  if (UNLIKELY(fast_state.GetIgnoreBit() || AccessSampledOut(thr, pc)))
     return;
   RawShadow* shadow_mem = MemToShadow(addr);
   bool traced = false;
@@ -558,17 +573,23 @@ static void MemoryRangeSet(uptr addr, uptr size, RawShadow val) {
   // Don't want to touch lots of shadow memory.
   // If a program maps 10MB stack, there is no need reset the whole range.
   // UnmapOrDie/MmapFixedNoReserve does not work on Windows.
-  if (SANITIZER_WINDOWS ||
-      size <= common_flags()->clear_shadow_mmap_threshold) {
+  // With lazy_shadow any range that covers a whole shadow page is reset with
+  // mmap, so that shadow of memory that is never accessed is never committed.
+  const uptr kPageSize = GetPageSizeCached();
+  const bool lazy = flags()->lazy_shadow;
+  const uptr threshold = lazy ? 2 * kPageSize / kShadowMultiplier
+                              : common_flags()->clear_shadow_mmap_threshold;
+  if (SANITIZER_WINDOWS || size <= threshold) {
     ShadowSet(begin, end, val);
     return;
   }
   // The region is big, reset only beginning and end.
-  const uptr kPageSize = GetPageSizeCached();
-  // Set at least first kPageSize/2 to page boundary.
-  RawShadow* mid1 =
-      Min(end, reinterpret_cast<RawShadow*>(RoundUp(
-                   reinterpret_cast<uptr>(begin) + kPageSize / 2, kPageSize)));
+  // Set at least first kPageSize/2 to page boundary (only up to the page
+  // boundary in the lazy mode).
+  RawShadow* mid1 = Min(
+      end, reinterpret_cast<RawShadow*>(RoundUp(
+               reinterpret_cast<uptr>(begin) + (lazy ? 0 : kPageSize / 2),
+               kPageSize)));
   ShadowSet(begin, mid1, val);
   // Reset middle part.
   RawShadow* mid2 = RoundDown(end, kPageSize);
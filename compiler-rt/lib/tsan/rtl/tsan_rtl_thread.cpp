@@ -174,6 +174,13 @@ void ThreadStart(ThreadState *thr, Tid tid, tid_t os_id,
   thr->tls_addr = tls_addr;
   thr->tls_size = tls_size;
 
+  int sample_percent = flags()->access_sample_percent;
+  if (sample_percent > 0 && sample_percent < 100) {
+    thr->access_sample_threshold =
+        static_cast<u32>((1ull << 32) * sample_percent / 100);
+    thr->access_sample_seed = static_cast<u32>(tid) * 0x9e3779b9u;
+  }
+
 #if !SANITIZER_GO
   if (ctx->after_multithreaded_fork) {
     thr->ignore_interceptors++;
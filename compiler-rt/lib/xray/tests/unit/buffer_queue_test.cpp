@@ -120,6 +120,42 @@ TEST(BufferQueueTest, Apply) {
   ASSERT_EQ(Count, 10);
 }
 
+TEST(BufferQueueTest, Consume) {
+  bool Success = false;
+  BufferQueue Buffers(kSize, 2, Success);
+  ASSERT_TRUE(Success);
+  Buffers.enableStreaming();
+
+  // Released buffers are not handed out again until they are consumed.
+  BufferQueue::Buffer B0, B1, B2;
+  ASSERT_EQ(Buffers.getBuffer(B0), BufferQueue::ErrorCode::Ok);
+  ASSERT_EQ(Buffers.getBuffer(B1), BufferQueue::ErrorCode::Ok);
+  void *Data0 = B0.Data;
+  void *Data1 = B1.Data;
+  atomic_store(B1.Extents, 1, memory_order_release);
+  ASSERT_EQ(Buffers.releaseBuffer(B1), BufferQueue::ErrorCode::Ok);
+  ASSERT_EQ(Buffers.releaseBuffer(B0), BufferQueue::ErrorCode::Ok);
+  EXPECT_EQ(Buffers.getBuffer(B2), BufferQueue::ErrorCode::NotEnoughMemory);
+
+  // Buffers are consumed in release order, each exactly once.
+  std::vector<void *> Seen;
+  EXPECT_EQ(Buffers.consume([&](const BufferQueue::Buffer &B) {
+    Seen.push_back(B.Data);
+  }),
+            2u);
+  EXPECT_THAT(Seen, ::testing::ElementsAre(Data1, Data0));
+  EXPECT_EQ(Buffers.consume([](const BufferQueue::Buffer &) {}), 0u);
+
+  ASSERT_EQ(Buffers.getBuffer(B2), BufferQueue::ErrorCode::Ok);
+  ASSERT_EQ(Buffers.releaseBuffer(B2), BufferQueue::ErrorCode::Ok);
+  Seen.clear();
+  EXPECT_EQ(Buffers.consume([&](const BufferQueue::Buffer &B) {
+    Seen.push_back(B.Data);
+  }),
+            1u);
+  EXPECT_THAT(Seen, ::testing::ElementsAre(Data1));
+}
+
 TEST(BufferQueueTest, GenerationalSupport) {
   bool Success = false;
   BufferQueue Buffers(kSize, 10, Success);
@@ -159,6 +159,16 @@ private:
   // Count of buffers that have been handed out through 'getBuffer'.
   size_t LiveBuffers;
 
+  // When streaming, this is true and released buffers are not handed out again
+  // until they have been passed to a 'consume' callback.
+  bool Streaming;
+
+  // Pointer to the oldest released buffer not yet consumed when streaming.
+  BufferRep *Read;
+
+  // Count of released buffers not yet consumed when streaming.
+  size_t Unconsumed;
+
   // We use a generation number to identify buffers and which generation they're
   // associated with.
   atomic_uint64_t Generation;
@@ -205,6 +215,10 @@ public:
   /// Requirements:
   ///   - BufferQueue is not finalising.
   ///
+  /// In streaming mode, buffers that have been released but not yet consumed
+  /// are never handed out again, so writers run out of buffers (and drop
+  /// records) rather than overwrite data the consumer has not seen.
+  ///
   /// Returns:
   ///   - ErrorCode::NotEnoughMemory on exceeding MaxSize.
   ///   - ErrorCode::Ok when we find a Buffer.
@@ -221,7 +235,8 @@ public:
   ErrorCode releaseBuffer(Buffer &Buf);
 
   /// Initializes the buffer queue, starting a new generation. We can re-set the
-  /// size of buffers with |BS| along with the buffer count with |BC|.
+  /// size of buffers with |BS| along with the buffer count with |BC|. This
+  /// turns streaming mode off.
   ///
   /// Returns:
   ///   - ErrorCode::Ok when we successfully initialize the buffer. This
@@ -258,6 +273,40 @@ public:
       Fn(*I);
   }
 
+  /// Switches the queue to streaming mode, where released buffers are handed to
+  /// a consumer through 'consume' in the order they were released, and only
+  /// become available to 'getBuffer' again afterwards.
+  void enableStreaming() XRAY_NEVER_INSTRUMENT {
+    SpinMutexLock G(&Mutex);
+    Streaming = true;
+  }
+
+  /// Applies the provided function F to each buffer released since the last
+  /// call to consume, in release order, then makes those buffers available to
+  /// writers again. F runs without holding the queue lock, so writers are not
+  /// blocked while the data is being processed. Only one thread may consume at
+  /// a time. Returns the number of buffers consumed.
+  template <class F> size_t consume(F Fn) XRAY_NEVER_INSTRUMENT {
+    BufferRep *R;
+    size_t N;
+    {
+      SpinMutexLock G(&Mutex);
+      R = Read;
+      N = Unconsumed;
+    }
+    // Writers only release into slots after the unconsumed ones and never take
+    // an unconsumed slot from 'getBuffer', so these are stable while unlocked.
+    for (size_t I = 0; I < N; ++I) {
+      Fn(static_cast<const Buffer &>(R->Buff));
+      if (++R == Buffers + BufferCount)
+        R = Buffers;
+    }
+    SpinMutexLock G(&Mutex);
+    Read = R;
+    Unconsumed -= N;
+    return N;
+  }
+
   using const_iterator = Iterator<const Buffer>;
   using iterator = Iterator<Buffer>;
 
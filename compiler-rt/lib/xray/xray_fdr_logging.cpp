@@ -89,6 +89,12 @@ static atomic_uint64_t TicksPerSec{0};
 static atomic_sint32_t LogFlushStatus = {
     XRayLogFlushStatus::XRAY_LOG_NOT_FLUSHING};
 
+// State for the background thread that writes out buffers while logging, when
+// the stream_interval_ms flag is set.
+static LogWriter *StreamWriter = nullptr;
+static pthread_t StreamThread;
+static atomic_uint8_t StreamStop{0};
+
 // This function will initialize the thread-local data structure used by the FDR
 // logging implementation and return a reference to it. The implementation
 // details require a bit of care to maintain.
@@ -275,6 +281,76 @@ XRayBuffer fdrIterator(const XRayBuffer B) {
   return Result;
 }
 
+static void writeBuffer(LogWriter *LW,
+                        const BufferQueue::Buffer &B) XRAY_NEVER_INSTRUMENT {
+  // Starting at version 2 of the FDR logging implementation, we only write
+  // the records identified by the extents of the buffer. We use the Extents
+  // from the Buffer and write that out as the first record in the buffer.  We
+  // still use a Metadata record, but fill in the extents instead for the
+  // data.
+  MetadataRecord ExtentsRecord;
+  auto BufferExtents = atomic_load(B.Extents, memory_order_acquire);
+  DCHECK(BufferExtents <= B.Size);
+  ExtentsRecord.Type = uint8_t(RecordType::Metadata);
+  ExtentsRecord.RecordKind =
+      uint8_t(MetadataRecord::RecordKinds::BufferExtents);
+  internal_memcpy(ExtentsRecord.Data, &BufferExtents, sizeof(BufferExtents));
+  if (BufferExtents > 0) {
+    LW->WriteAll(reinterpret_cast<char *>(&ExtentsRecord),
+                 reinterpret_cast<char *>(&ExtentsRecord) +
+                     sizeof(MetadataRecord));
+    LW->WriteAll(reinterpret_cast<char *>(B.Data),
+                 reinterpret_cast<char *>(B.Data) + BufferExtents);
+  }
+}
+
+static LogWriter *openLogWithHeader() XRAY_NEVER_INSTRUMENT {
+  LogWriter *LW = LogWriter::Open();
+  if (LW == nullptr)
+    return nullptr;
+
+  XRayFileHeader Header = fdrCommonHeaderInfo();
+  Header.FdrData = FdrAdditionalHeaderData{BQ->ConfiguredBufferSize()};
+  LW->WriteAll(reinterpret_cast<char *>(&Header),
+               reinterpret_cast<char *>(&Header) + sizeof(Header));
+  return LW;
+}
+
+static void *streamBuffers(void *) XRAY_NEVER_INSTRUMENT {
+  while (!atomic_load(&StreamStop, memory_order_acquire)) {
+    SleepForMillis(fdrFlags()->stream_interval_ms);
+    BQ->consume(
+        [](const BufferQueue::Buffer &B) { writeBuffer(StreamWriter, B); });
+  }
+  return nullptr;
+}
+
+// Starts the background writer when the stream_interval_ms flag asks for it.
+// On failure we silently fall back to writing everything at flush time.
+static void startStreaming() XRAY_NEVER_INSTRUMENT {
+  if (fdrFlags()->stream_interval_ms <= 0 || fdrFlags()->no_file_flush)
+    return;
+  StreamWriter = openLogWithHeader();
+  if (StreamWriter == nullptr)
+    return;
+  atomic_store(&StreamStop, 0, memory_order_release);
+  if (pthread_create(&StreamThread, nullptr, streamBuffers, nullptr) != 0) {
+    if (Verbosity())
+      Report("XRay FDR: Failed to start the streaming thread.\n");
+    LogWriter::Close(StreamWriter);
+    StreamWriter = nullptr;
+    return;
+  }
+  BQ->enableStreaming();
+}
+
+static void stopStreaming() XRAY_NEVER_INSTRUMENT {
+  if (StreamWriter == nullptr)
+    return;
+  atomic_store(&StreamStop, 1, memory_order_release);
+  pthread_join(StreamThread, nullptr);
+}
+
 // Must finalize before flushing.
 XRayLogFlushStatus fdrLoggingFlush() XRAY_NEVER_INSTRUMENT {
   if (atomic_load(&LoggingStatus, memory_order_acquire) !=
@@ -298,6 +374,9 @@ XRayLogFlushStatus fdrLoggingFlush() XRAY_NEVER_INSTRUMENT {
     return XRayLogFlushStatus::XRAY_LOG_NOT_FLUSHING;
   }
 
+  // The background writer must be done with the queue before we take over.
+  stopStreaming();
+
   // We wait a number of milliseconds to allow threads to see that we've
   // finalised before attempting to flush the log.
   SleepForMillis(fdrFlags()->grace_period_ms);
@@ -337,18 +416,16 @@ XRayLogFlushStatus fdrLoggingFlush() XRAY_NEVER_INSTRUMENT {
   //      (fixed-sized) and let the tools reading the buffers deal with the data
   //      afterwards.
   //
-  LogWriter *LW = LogWriter::Open();
+  LogWriter *LW = StreamWriter;
   if (LW == nullptr) {
-    auto Result = XRayLogFlushStatus::XRAY_LOG_NOT_FLUSHING;
-    atomic_store(&LogFlushStatus, Result, memory_order_release);
-    return Result;
+    LW = openLogWithHeader();
+    if (LW == nullptr) {
+      auto Result = XRayLogFlushStatus::XRAY_LOG_NOT_FLUSHING;
+      atomic_store(&LogFlushStatus, Result, memory_order_release);
+      return Result;
+    }
   }
 
-  XRayFileHeader Header = fdrCommonHeaderInfo();
-  Header.FdrData = FdrAdditionalHeaderData{BQ->ConfiguredBufferSize()};
-  LW->WriteAll(reinterpret_cast<char *>(&Header),
-               reinterpret_cast<char *>(&Header) + sizeof(Header));
-
   // Release the current thread's buffer before we attempt to write out all the
   // buffers. This ensures that in case we had only a single thread going, that
   // we are able to capture the data nonetheless.
@@ -356,27 +433,14 @@ XRayLogFlushStatus fdrLoggingFlush() XRAY_NEVER_INSTRUMENT {
   if (TLD.Controller != nullptr)
     TLD.Controller->flush();
 
-  BQ->apply([&](const BufferQueue::Buffer &B) {
-    // Starting at version 2 of the FDR logging implementation, we only write
-    // the records identified by the extents of the buffer. We use the Extents
-    // from the Buffer and write that out as the first record in the buffer.  We
-    // still use a Metadata record, but fill in the extents instead for the
-    // data.
-    MetadataRecord ExtentsRecord;
-    auto BufferExtents = atomic_load(B.Extents, memory_order_acquire);
-    DCHECK(BufferExtents <= B.Size);
-    ExtentsRecord.Type = uint8_t(RecordType::Metadata);
-    ExtentsRecord.RecordKind =
-        uint8_t(MetadataRecord::RecordKinds::BufferExtents);
-    internal_memcpy(ExtentsRecord.Data, &BufferExtents, sizeof(BufferExtents));
-    if (BufferExtents > 0) {
-      LW->WriteAll(reinterpret_cast<char *>(&ExtentsRecord),
-                   reinterpret_cast<char *>(&ExtentsRecord) +
-                       sizeof(MetadataRecord));
-      LW->WriteAll(reinterpret_cast<char *>(B.Data),
-                   reinterpret_cast<char *>(B.Data) + BufferExtents);
-    }
-  });
+  // When streaming, the header and all previously released buffers have
+  // already been written; only the buffers released since then remain.
+  if (StreamWriter != nullptr) {
+    BQ->consume([&](const BufferQueue::Buffer &B) { writeBuffer(LW, B); });
+    StreamWriter = nullptr;
+  } else {
+    BQ->apply([&](const BufferQueue::Buffer &B) { writeBuffer(LW, B); });
+  }
 
   atomic_store(&LogFlushStatus, XRayLogFlushStatus::XRAY_LOG_FLUSHED,
                memory_order_release);
@@ -676,6 +740,8 @@ XRayLogInitStatus fdrLoggingInit(size_t, size_t, void *Options,
     }
   }
 
+  startStreaming();
+
   static pthread_once_t OnceInit = PTHREAD_ONCE_INIT;
   pthread_once(
       &OnceInit, +[] {
@@ -0,0 +1,28 @@
+// RUN: %clangxx_tsan -O1 %s -o %t
+// RUN: %env_tsan_opts=lazy_shadow=1 %deflake %run %t | FileCheck %s
+#include "test.h"
+
+// Races inside a big heap block are still reported when its shadow is reset
+// lazily on allocation.
+
+void *Thread(void *p) {
+  barrier_wait(&barrier);
+  *(int *)p = 42;
+  return 0;
+}
+
+int main() {
+  barrier_init(&barrier, 2);
+  char *p = (char *)malloc(1 << 20);
+  pthread_t t;
+  pthread_create(&t, 0, Thread, p + (1 << 19));
+  *(int *)(p + (1 << 19)) = 43;
+  barrier_wait(&barrier);
+  pthread_join(t, 0);
+  free(p);
+  fprintf(stderr, "DONE\n");
+  return 0;
+}
+
+// CHECK: WARNING: ThreadSanitizer: data race
+// CHECK: DONE
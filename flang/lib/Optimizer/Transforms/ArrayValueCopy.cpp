@@ -444,6 +444,22 @@ static bool hasPointerType(mlir::Type type) {
   return type.isa<fir::PointerType>();
 }
 
+/// Is \p addr directly the address of a local or global variable that does not
+/// have the TARGET attribute? A POINTER cannot be associated with any part of
+/// such a variable. Variables in COMMON blocks or EQUIVALENCE are accessed
+/// through a computed address and are never matched here.
+static bool isNonTargetVariable(mlir::Value addr) {
+  if (auto embox = addr.getDefiningOp<EmboxOp>())
+    addr = embox.getMemref();
+  if (auto alloca = addr.getDefiningOp<AllocaOp>())
+    return !alloca->hasAttr(fir::getTargetAttrName());
+  if (auto addrOf = addr.getDefiningOp<AddrOfOp>())
+    if (auto global = mlir::SymbolTable::lookupNearestSymbolFrom<GlobalOp>(
+            addrOf, addrOf.getSymbol()))
+      return !global.getTarget();
+  return false;
+}
+
 // This is a NF performance hack. It makes a simple test that the slices of the
 // load, \p ld, and the merge store, \p st, are trivially mutually exclusive.
 static bool mutuallyExclusiveSliceRange(ArrayLoadOp ld, ArrayMergeStoreOp st) {
@@ -479,37 +495,60 @@ static bool mutuallyExclusiveSliceRange(ArrayLoadOp ld, ArrayMergeStoreOp st) {
   if (size != stTriples.size())
     return false;
 
-  auto displacedByConstant = [](mlir::Value v1, mlir::Value v2) {
-    auto removeConvert = [](mlir::Value v) -> mlir::Operation * {
-      auto *op = v.getDefiningOp();
-      while (auto conv = mlir::dyn_cast_or_null<ConvertOp>(op))
-        op = conv.getValue().getDefiningOp();
-      return op;
-    };
+  auto removeConvert = [](mlir::Value v) -> mlir::Operation * {
+    auto *op = v.getDefiningOp();
+    while (auto conv = mlir::dyn_cast_or_null<ConvertOp>(op))
+      op = conv.getValue().getDefiningOp();
+    return op;
+  };
 
-    auto isPositiveConstant = [](mlir::Value v) -> bool {
-      if (auto conOp =
-              mlir::dyn_cast<mlir::arith::ConstantOp>(v.getDefiningOp()))
-        if (auto iattr = conOp.getValue().dyn_cast<mlir::IntegerAttr>())
-          return iattr.getInt() > 0;
-      return false;
-    };
+  auto getPositiveConstant = [&](mlir::Value v) -> llvm::Optional<int64_t> {
+    if (auto conOp =
+            mlir::dyn_cast_or_null<mlir::arith::ConstantOp>(removeConvert(v)))
+      if (auto iattr = conOp.getValue().dyn_cast<mlir::IntegerAttr>())
+        if (iattr.getInt() > 0)
+          return iattr.getInt();
+    return llvm::None;
+  };
 
+  // Return the positive constant c such that v2 == v1 + c, if any.
+  auto getDisplacement = [&](mlir::Value v1,
+                             mlir::Value v2) -> llvm::Optional<int64_t> {
     auto *op1 = removeConvert(v1);
     auto *op2 = removeConvert(v2);
     if (!op1 || !op2)
-      return false;
-    if (auto addi = mlir::dyn_cast<mlir::arith::AddIOp>(op2))
-      if ((addi.getLhs().getDefiningOp() == op1 &&
-           isPositiveConstant(addi.getRhs())) ||
-          (addi.getRhs().getDefiningOp() == op1 &&
-           isPositiveConstant(addi.getLhs())))
-        return true;
+      return llvm::None;
+    if (auto addi = mlir::dyn_cast<mlir::arith::AddIOp>(op2)) {
+      if (addi.getLhs().getDefiningOp() == op1)
+        if (auto c = getPositiveConstant(addi.getRhs()))
+          return c;
+      if (addi.getRhs().getDefiningOp() == op1)
+        if (auto c = getPositiveConstant(addi.getLhs()))
+          return c;
+    }
     if (auto subi = mlir::dyn_cast<mlir::arith::SubIOp>(op1))
-      if (subi.getLhs().getDefiningOp() == op2 &&
-          isPositiveConstant(subi.getRhs()))
-        return true;
-    return false;
+      if (subi.getLhs().getDefiningOp() == op2)
+        return getPositiveConstant(subi.getRhs());
+    return llvm::None;
+  };
+
+  auto displacedByConstant = [&](mlir::Value v1, mlir::Value v2) {
+    return getDisplacement(v1, v2).has_value();
+  };
+
+  // Sections with the same constant stride s > 1 whose lower bounds differ by
+  // a constant that is not a multiple of s, such as (1:n:2) and (2:n:2), are
+  // interleaved and never touch the same element.
+  auto interleavedByStride = [&](mlir::Value lb1, mlir::Value step1,
+                                 mlir::Value lb2, mlir::Value step2) {
+    auto stride = getPositiveConstant(step1);
+    if (!stride || *stride < 2 ||
+        (step1 != step2 && getPositiveConstant(step2) != stride))
+      return false;
+    auto disp = getDisplacement(lb1, lb2);
+    if (!disp)
+      disp = getDisplacement(lb2, lb1);
+    return disp && *disp % *stride != 0;
   };
 
   for (std::remove_const_t<decltype(size)> i = 0; i < size; i += 3) {
@@ -531,6 +570,11 @@ static bool mutuallyExclusiveSliceRange(ArrayLoadOp ld, ArrayMergeStoreOp st) {
     if (displacedByConstant(ldTriples[i + 1], stTriples[i]) ||
         displacedByConstant(stTriples[i + 1], ldTriples[i]))
       continue;
+    // If the sections are interleaved with the same stride, skip to the next
+    // triple.
+    if (interleavedByStride(ldTriples[i], ldTriples[i + 2], stTriples[i],
+                            stTriples[i + 2]))
+      continue;
     return false;
   }
   LLVM_DEBUG(llvm::dbgs() << "detected non-overlapping slice ranges on " << ld
@@ -561,7 +605,14 @@ static bool conflictOnLoad(llvm::ArrayRef<mlir::Operation *> reach,
         }
         load = ld;
       } else if ((hasPointerType(ldTy) || storeHasPointerType)) {
-        // TODO: Use target attribute to restrict this case further.
+        // A POINTER can only be associated with a TARGET or with the target
+        // of another POINTER.
+        if ((!hasPointerType(ldTy) && isNonTargetVariable(ld.getMemref())) ||
+            (!storeHasPointerType && isNonTargetVariable(addr))) {
+          LLVM_DEBUG(llvm::dbgs() << "pointer cannot be associated with "
+                                     "non-target variable, no conflict\n");
+          continue;
+        }
         // TODO: Check if types can also allow ruling out some cases. For now,
         // the fact that equivalences is using pointer attribute to enforce
         // aliasing is preventing any attempt to do so, and in general, it may
@@ -1342,6 +1393,16 @@ public:
     const auto &analysis = getAnalysis<ArrayCopyAnalysis>();
     const auto &useMap = analysis.getUseMap();
 
+    if (emitRemarks)
+      func.walk([&](ArrayLoadOp load) {
+        // Only the array_load merged into by an array_merge_store is copied.
+        if (useMap.count(load.getOperation()) &&
+            analysis.hasPotentialConflict(load.getOperation()))
+          mlir::emitRemark(load.getLoc(),
+                           "array temporary created: the assignment may "
+                           "overlap with its right-hand side");
+      });
+
     mlir::RewritePatternSet patterns1(context);
     patterns1.insert<ArrayFetchConversion>(context, useMap);
     patterns1.insert<ArrayUpdateConversion>(context, analysis, useMap);
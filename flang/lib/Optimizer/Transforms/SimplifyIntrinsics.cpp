@@ -58,6 +58,9 @@ class SimplifyIntrinsicsPass
       llvm::function_ref<void(fir::FirOpBuilder &, mlir::func::FuncOp &)>;
   using GenReductionBodyTy = llvm::function_ref<void(
       fir::FirOpBuilder &builder, mlir::func::FuncOp &funcOp, unsigned rank)>;
+  using GenLogicalReductionBodyTy = llvm::function_ref<void(
+      fir::FirOpBuilder &builder, mlir::func::FuncOp &funcOp, unsigned rank,
+      mlir::Type elementType)>;
 
 public:
   /// Generate a new function implementing a simplified version
@@ -81,6 +84,14 @@ private:
   /// \p genBodyFunc is the callback that builds the replacement function
   void simplifyReduction(fir::CallOp call, const fir::KindMapping &kindMap,
                          GenReductionBodyTy genBodyFunc);
+
+  /// Helper function to replace a call to a reduction of a LOGICAL array
+  /// (ANY, ALL, COUNT) without DIM argument with its simplified form.
+  /// \p genBodyFunc is the callback that builds the replacement function
+  /// for the given element type of the argument.
+  void simplifyLogicalReduction(fir::CallOp call,
+                                const fir::KindMapping &kindMap,
+                                GenLogicalReductionBodyTy genBodyFunc);
 };
 
 } // namespace
@@ -136,12 +147,17 @@ using InitValGeneratorTy = llvm::function_ref<mlir::Value(
 /// \p genBody is called to fill in the actual reduciton operation
 ///    for example add for SUM, MAX for MAXVAL, etc.
 /// \p rank is the rank of the input argument.
+/// \p elementType is the element type of the input argument. If it is
+///    not provided, it is the result type of \p funcOp.
 static void genReductionLoop(fir::FirOpBuilder &builder,
                              mlir::func::FuncOp &funcOp,
                              InitValGeneratorTy initVal,
-                             BodyOpGeneratorTy genBody, unsigned rank) {
+                             BodyOpGeneratorTy genBody, unsigned rank,
+                             mlir::Type elementType = {}) {
   auto loc = mlir::UnknownLoc::get(builder.getContext());
-  mlir::Type elementType = funcOp.getResultTypes()[0];
+  mlir::Type resultType = funcOp.getResultTypes()[0];
+  if (!elementType)
+    elementType = resultType;
   builder.setInsertionPointToEnd(funcOp.addEntryBlock());
 
   mlir::IndexType idxTy = builder.getIndexType();
@@ -156,7 +172,7 @@ static void genReductionLoop(fir::FirOpBuilder &builder,
   mlir::Type arrTy = fir::SequenceType::get(flatShape, elementType);
   mlir::Type boxArrTy = fir::BoxType::get(arrTy);
   mlir::Value array = builder.create<fir::ConvertOp>(loc, boxArrTy, arg);
-  mlir::Value init = initVal(builder, loc, elementType);
+  mlir::Value init = initVal(builder, loc, resultType);
 
   llvm::SmallVector<mlir::Value, 15> bounds;
 
@@ -296,6 +312,93 @@ static void genRuntimeMaxvalBody(fir::FirOpBuilder &builder,
   genReductionLoop(builder, funcOp, init, genBodyOp, rank);
 }
 
+static void genRuntimeMinvalBody(fir::FirOpBuilder &builder,
+                                 mlir::func::FuncOp &funcOp, unsigned rank) {
+  auto init = [](fir::FirOpBuilder builder, mlir::Location loc,
+                 mlir::Type elementType) {
+    if (auto ty = elementType.dyn_cast<mlir::FloatType>()) {
+      const llvm::fltSemantics &sem = ty.getFloatSemantics();
+      return builder.createRealConstant(
+          loc, elementType, llvm::APFloat::getLargest(sem, /*Negative=*/false));
+    }
+    unsigned bits = elementType.getIntOrFloatBitWidth();
+    int64_t maxInt = llvm::APInt::getSignedMaxValue(bits).getSExtValue();
+    return builder.createIntegerConstant(loc, elementType, maxInt);
+  };
+
+  auto genBodyOp = [](fir::FirOpBuilder builder, mlir::Location loc,
+                      mlir::Type elementType, mlir::Value elem1,
+                      mlir::Value elem2) -> mlir::Value {
+    if (elementType.isa<mlir::FloatType>())
+      return builder.create<mlir::arith::MinFOp>(loc, elem1, elem2);
+    if (elementType.isa<mlir::IntegerType>())
+      return builder.create<mlir::arith::MinSIOp>(loc, elem1, elem2);
+
+    llvm_unreachable("unsupported type");
+    return {};
+  };
+  genReductionLoop(builder, funcOp, init, genBodyOp, rank);
+}
+
+/// Generate function body of the simplified version of RTNAME(Any)
+/// for a LOGICAL array with the given \p elementType.
+static void genRuntimeAnyBody(fir::FirOpBuilder &builder,
+                              mlir::func::FuncOp &funcOp, unsigned rank,
+                              mlir::Type elementType) {
+  auto init = [](fir::FirOpBuilder builder, mlir::Location loc,
+                 mlir::Type resultType) {
+    return builder.createIntegerConstant(loc, resultType, 0);
+  };
+  auto genBodyOp = [](fir::FirOpBuilder builder, mlir::Location loc,
+                      mlir::Type elementType, mlir::Value elem,
+                      mlir::Value any) -> mlir::Value {
+    mlir::Value isTrue =
+        builder.create<fir::ConvertOp>(loc, builder.getI1Type(), elem);
+    return builder.create<mlir::arith::OrIOp>(loc, any, isTrue);
+  };
+  genReductionLoop(builder, funcOp, init, genBodyOp, rank, elementType);
+}
+
+/// Generate function body of the simplified version of RTNAME(All)
+/// for a LOGICAL array with the given \p elementType.
+static void genRuntimeAllBody(fir::FirOpBuilder &builder,
+                              mlir::func::FuncOp &funcOp, unsigned rank,
+                              mlir::Type elementType) {
+  auto init = [](fir::FirOpBuilder builder, mlir::Location loc,
+                 mlir::Type resultType) {
+    return builder.createIntegerConstant(loc, resultType, 1);
+  };
+  auto genBodyOp = [](fir::FirOpBuilder builder, mlir::Location loc,
+                      mlir::Type elementType, mlir::Value elem,
+                      mlir::Value all) -> mlir::Value {
+    mlir::Value isTrue =
+        builder.create<fir::ConvertOp>(loc, builder.getI1Type(), elem);
+    return builder.create<mlir::arith::AndIOp>(loc, all, isTrue);
+  };
+  genReductionLoop(builder, funcOp, init, genBodyOp, rank, elementType);
+}
+
+/// Generate function body of the simplified version of RTNAME(Count)
+/// for a LOGICAL array with the given \p elementType.
+static void genRuntimeCountBody(fir::FirOpBuilder &builder,
+                                mlir::func::FuncOp &funcOp, unsigned rank,
+                                mlir::Type elementType) {
+  auto init = [](fir::FirOpBuilder builder, mlir::Location loc,
+                 mlir::Type resultType) {
+    return builder.createIntegerConstant(loc, resultType, 0);
+  };
+  auto genBodyOp = [](fir::FirOpBuilder builder, mlir::Location loc,
+                      mlir::Type elementType, mlir::Value elem,
+                      mlir::Value count) -> mlir::Value {
+    mlir::Value isTrue =
+        builder.create<fir::ConvertOp>(loc, builder.getI1Type(), elem);
+    mlir::Value one =
+        builder.create<mlir::arith::ExtUIOp>(loc, count.getType(), isTrue);
+    return builder.create<mlir::arith::AddIOp>(loc, count, one);
+  };
+  genReductionLoop(builder, funcOp, init, genBodyOp, rank, elementType);
+}
+
 /// Generate function type for the simplified version of RTNAME(DotProduct)
 /// operating on the given \p elementType.
 static mlir::FunctionType genRuntimeDotType(fir::FirOpBuilder &builder,
@@ -580,6 +683,50 @@ void SimplifyIntrinsicsPass::simplifyReduction(fir::CallOp call,
   }
 }
 
+void SimplifyIntrinsicsPass::simplifyLogicalReduction(
+    fir::CallOp call, const fir::KindMapping &kindMap,
+    GenLogicalReductionBodyTy genBodyFunc) {
+  mlir::SymbolRefAttr callee = call.getCalleeAttr();
+  mlir::Operation::operand_range args = call.getArgs();
+  // args[1] and args[2] are source filename and line number, ignored.
+  // dim is zero when it is absent, which is an implementation
+  // detail in the runtime library.
+  const mlir::Value &dim = args[3];
+  unsigned rank = getDimCount(args[0]);
+  if (!isZero(dim) || rank == 0)
+    return;
+
+  llvm::Optional<mlir::Type> argType = getArgElementType(args[0]);
+  if (!argType || !argType->isa<fir::LogicalType>())
+    return;
+
+  mlir::Location loc = call.getLoc();
+  fir::FirOpBuilder builder{getSimplificationBuilder(call, kindMap)};
+  mlir::Type resultType = call.getResult(0).getType();
+  mlir::Type elementType = *argType;
+  auto typeGenerator = [&resultType](fir::FirOpBuilder &builder) {
+    return genNoneBoxType(builder, resultType);
+  };
+  auto bodyGenerator = [&rank, &elementType,
+                        &genBodyFunc](fir::FirOpBuilder &builder,
+                                      mlir::func::FuncOp &funcOp) {
+    genBodyFunc(builder, funcOp, rank, elementType);
+  };
+  // Mangle the function name with the rank value as "x<rank>" and
+  // with the element type of the argument.
+  std::string funcName;
+  llvm::raw_string_ostream nameOS(funcName);
+  nameOS << callee.getLeafReference().getValue() << 'x' << rank << '_';
+  elementType.print(nameOS);
+  mlir::func::FuncOp newFunc =
+      getOrCreateFunction(builder, nameOS.str(), typeGenerator, bodyGenerator);
+  auto newCall =
+      builder.create<fir::CallOp>(loc, newFunc, mlir::ValueRange{args[0]});
+  call->replaceAllUsesWith(newCall.getResults());
+  call->dropAllReferences();
+  call->erase();
+}
+
 void SimplifyIntrinsicsPass::runOnOperation() {
   LLVM_DEBUG(llvm::dbgs() << "=== Begin " DEBUG_TYPE " ===\n");
   mlir::ModuleOp module = getOperation();
@@ -672,6 +819,28 @@ void SimplifyIntrinsicsPass::runOnOperation() {
           simplifyReduction(call, kindMap, genRuntimeMaxvalBody);
           return;
         }
+        if (funcName.startswith(RTNAME_STRING(Minval))) {
+          simplifyReduction(call, kindMap, genRuntimeMinvalBody);
+          return;
+        }
+        // ANY, ALL and COUNT of a LOGICAL array without DIM argument.
+        // Prototypes for runtime calls (from reduction.h):
+        // bool RTNAME(Any)(const Descriptor &x, const char *source, int line,
+        //                  int dim)
+        // std::int64_t RTNAME(Count)(const Descriptor &x, const char *source,
+        //                            int line, int dim)
+        if (funcName == RTNAME_STRING(Any)) {
+          simplifyLogicalReduction(call, kindMap, genRuntimeAnyBody);
+          return;
+        }
+        if (funcName == RTNAME_STRING(All)) {
+          simplifyLogicalReduction(call, kindMap, genRuntimeAllBody);
+          return;
+        }
+        if (funcName == RTNAME_STRING(Count)) {
+          simplifyLogicalReduction(call, kindMap, genRuntimeCountBody);
+          return;
+        }
       }
     }
   });
@@ -140,11 +140,15 @@ public:
 private:
   STORE &Store() { return static_cast<STORE &>(*this); }
 
+  // The buffer grows geometrically so that a large record that is built up
+  // from many items (e.g., a sequential unformatted WRITE of a long list of
+  // arrays) costs linear, not quadratic, time in copying.
   void Reallocate(std::int64_t bytes, const Terminator &terminator) {
     if (bytes > size_) {
       char *old{buffer_};
       auto oldSize{size_};
-      size_ = std::max<std::int64_t>(bytes, size_ + minBuffer);
+      size_ = std::max<std::int64_t>(
+          bytes, size_ + std::max<std::int64_t>(size_, minBuffer));
       buffer_ =
           reinterpret_cast<char *>(AllocateMemoryOrCrash(terminator, size_));
       auto chunk{std::min<std::int64_t>(length_, oldSize - start_)};
@@ -85,6 +85,21 @@ static inline CppTypeFor<RCAT, RKIND> DoDotProduct(
           accum += std::conj(static_cast<AccumType>(*xp++)) *
               static_cast<AccumType>(*yp++);
         }
+      } else if constexpr (RCAT == TypeCategory::Real) {
+        // Independent partial sums allow the loop to be vectorized.
+        AccumType partial[4]{};
+        SubscriptValue j{0};
+        for (; j + 4 <= n; j += 4) {
+          for (int l{0}; l < 4; ++l) {
+            partial[l] += static_cast<AccumType>(xp[j + l]) *
+                static_cast<AccumType>(yp[j + l]);
+          }
+        }
+        for (; j < n; ++j) {
+          partial[0] +=
+              static_cast<AccumType>(xp[j]) * static_cast<AccumType>(yp[j]);
+        }
+        accum = (partial[0] + partial[1]) + (partial[2] + partial[3]);
       } else {
         for (SubscriptValue j{0}; j < n; ++j) {
           accum +=
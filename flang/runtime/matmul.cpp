@@ -17,7 +17,9 @@
 // of logical kinds (16).  A single template undergoes many instantiations
 // to cover all of the valid possibilities.
 //
-// Places where BLAS routines could be called are marked as TODO items.
+// When the runtime is built with FLANG_RUNTIME_EXTERNAL_BLAS, contiguous
+// matrices of homogeneous real and complex types are passed to the BLAS
+// GEMM and GEMV routines if the program has been linked with a BLAS library.
 
 #include "flang/Runtime/matmul.h"
 #include "terminator.h"
@@ -25,8 +27,36 @@
 #include "flang/Runtime/c-or-cpp.h"
 #include "flang/Runtime/cpp-type.h"
 #include "flang/Runtime/descriptor.h"
+#include <algorithm>
+#include <climits>
 #include <cstring>
 
+#if FLANG_RUNTIME_EXTERNAL_BLAS
+// The BLAS routines are weak references, so that programs that are not
+// linked with a BLAS library fall back to the loops below.
+extern "C" {
+#define BLAS_GEMM(NAME, T) \
+  void NAME(const char *transa, const char *transb, const int *m, \
+      const int *n, const int *k, const T *alpha, const T *a, const int *lda, \
+      const T *b, const int *ldb, const T *beta, T *c, const int *ldc) \
+      __attribute__((weak));
+#define BLAS_GEMV(NAME, T) \
+  void NAME(const char *trans, const int *m, const int *n, const T *alpha, \
+      const T *a, const int *lda, const T *x, const int *incx, const T *beta, \
+      T *y, const int *incy) __attribute__((weak));
+BLAS_GEMM(sgemm_, float)
+BLAS_GEMM(dgemm_, double)
+BLAS_GEMM(cgemm_, std::complex<float>)
+BLAS_GEMM(zgemm_, std::complex<double>)
+BLAS_GEMV(sgemv_, float)
+BLAS_GEMV(dgemv_, double)
+BLAS_GEMV(cgemv_, std::complex<float>)
+BLAS_GEMV(zgemv_, std::complex<double>)
+#undef BLAS_GEMM
+#undef BLAS_GEMV
+}
+#endif
+
 namespace Fortran::runtime {
 
 // General accumulator for any type and stride; this is not used for
@@ -52,6 +82,11 @@ private:
   Result sum_{};
 };
 
+// Block sizes for the contiguous algorithms below: a block of X holds
+// blockRows * blockN elements and is meant to stay in the L2 cache.
+static constexpr SubscriptValue blockRows{256};
+static constexpr SubscriptValue blockN{64};
+
 // Contiguous numeric matrix*matrix multiplication
 //   matrix(rows,n) * matrix(n,cols) -> matrix(rows,cols)
 // Straightforward algorithm:
@@ -65,27 +100,35 @@ private:
 //   DO 1 I = 1, NROWS
 //    DO 1 J = 1, NCOLS
 //   1 RES(I,J) = 0
-//   DO 2 K = 1, N
-//    DO 2 J = 1, NCOLS
+//   DO 2 J = 1, NCOLS
+//    DO 2 K = 1, N
 //     DO 2 I = 1, NROWS
 //   2  RES(I,J) = RES(I,J) + X(I,K)*Y(K,J) ! loop-invariant last term
+// The I and K loops are then blocked, so that a block of X is applied to
+// every column of the result while it is in cache.  The innermost loop
+// has unit strides and can be vectorized, and the terms of each element
+// are still added in order of increasing K.
 template <TypeCategory RCAT, int RKIND, typename XT, typename YT>
 inline void MatrixTimesMatrix(CppTypeFor<RCAT, RKIND> *RESTRICT product,
     SubscriptValue rows, SubscriptValue cols, const XT *RESTRICT x,
     const YT *RESTRICT y, SubscriptValue n) {
   using ResultType = CppTypeFor<RCAT, RKIND>;
   std::memset(product, 0, rows * cols * sizeof *product);
-  const XT *RESTRICT xp0{x};
-  for (SubscriptValue k{0}; k < n; ++k) {
-    ResultType *RESTRICT p{product};
-    for (SubscriptValue j{0}; j < cols; ++j) {
-      const XT *RESTRICT xp{xp0};
-      auto yv{static_cast<ResultType>(y[k + j * n])};
-      for (SubscriptValue i{0}; i < rows; ++i) {
-        *p++ += static_cast<ResultType>(*xp++) * yv;
+  for (SubscriptValue i0{0}; i0 < rows; i0 += blockRows) {
+    SubscriptValue iEnd{std::min(rows, i0 + blockRows)};
+    for (SubscriptValue k0{0}; k0 < n; k0 += blockN) {
+      SubscriptValue kEnd{std::min(n, k0 + blockN)};
+      for (SubscriptValue j{0}; j < cols; ++j) {
+        ResultType *RESTRICT p{product + j * rows};
+        for (SubscriptValue k{k0}; k < kEnd; ++k) {
+          const XT *RESTRICT xp{x + k * rows};
+          auto yv{static_cast<ResultType>(y[k + j * n])};
+          for (SubscriptValue i{i0}; i < iEnd; ++i) {
+            p[i] += static_cast<ResultType>(xp[i]) * yv;
+          }
+        }
       }
     }
-    xp0 += rows;
   }
 }
 
@@ -103,17 +146,22 @@ inline void MatrixTimesMatrix(CppTypeFor<RCAT, RKIND> *RESTRICT product,
 //   DO 2 K = 1, N
 //    DO 2 J = 1, NROWS
 //   2 RES(J) = RES(J) + X(J,K)*Y(K)
+// The J loop is then blocked, so that a block of the result stays in
+// cache while all of the columns of X are added to it.
 template <TypeCategory RCAT, int RKIND, typename XT, typename YT>
 inline void MatrixTimesVector(CppTypeFor<RCAT, RKIND> *RESTRICT product,
     SubscriptValue rows, SubscriptValue n, const XT *RESTRICT x,
     const YT *RESTRICT y) {
   using ResultType = CppTypeFor<RCAT, RKIND>;
   std::memset(product, 0, rows * sizeof *product);
-  for (SubscriptValue k{0}; k < n; ++k) {
-    ResultType *RESTRICT p{product};
-    auto yv{static_cast<ResultType>(*y++)};
-    for (SubscriptValue j{0}; j < rows; ++j) {
-      *p++ += static_cast<ResultType>(*x++) * yv;
+  for (SubscriptValue j0{0}; j0 < rows; j0 += blockRows) {
+    SubscriptValue jEnd{std::min(rows, j0 + blockRows)};
+    for (SubscriptValue k{0}; k < n; ++k) {
+      const XT *RESTRICT xp{x + k * rows};
+      auto yv{static_cast<ResultType>(y[k])};
+      for (SubscriptValue j{j0}; j < jEnd; ++j) {
+        product[j] += static_cast<ResultType>(xp[j]) * yv;
+      }
     }
   }
 }
@@ -125,30 +173,89 @@ inline void MatrixTimesVector(CppTypeFor<RCAT, RKIND> *RESTRICT product,
 //    RES(J) = 0
 //    DO 1 K = 1, N
 //   1 RES(J) = RES(J) + X(K)*Y(K,J)
-// With loop distribution and transposition to avoid the inner
-// sum reduction and one non-unit stride (the other remains):
-//   DO 1 J = 1, NCOLS
-//   1 RES(J) = 0
-//   DO 2 K = 1, N
-//    DO 2 J = 1, NCOLS
-//   2 RES(J) = RES(J) + X(K)*Y(K,J)
+// The columns of Y are contiguous, so the inner sum reduction is kept
+// to avoid the non-unit stride that loop distribution would introduce.
 template <TypeCategory RCAT, int RKIND, typename XT, typename YT>
 inline void VectorTimesMatrix(CppTypeFor<RCAT, RKIND> *RESTRICT product,
     SubscriptValue n, SubscriptValue cols, const XT *RESTRICT x,
     const YT *RESTRICT y) {
   using ResultType = CppTypeFor<RCAT, RKIND>;
-  std::memset(product, 0, cols * sizeof *product);
-  for (SubscriptValue k{0}; k < n; ++k) {
-    ResultType *RESTRICT p{product};
-    auto xv{static_cast<ResultType>(*x++)};
-    const YT *RESTRICT yp{&y[k]};
-    for (SubscriptValue j{0}; j < cols; ++j) {
-      *p++ += xv * static_cast<ResultType>(*yp);
-      yp += n;
+  for (SubscriptValue j{0}; j < cols; ++j) {
+    const YT *RESTRICT yp{y + j * n};
+    ResultType sum{};
+    for (SubscriptValue k{0}; k < n; ++k) {
+      sum += static_cast<ResultType>(x[k]) * static_cast<ResultType>(yp[k]);
     }
+    product[j] = sum;
+  }
+}
+
+#if FLANG_RUNTIME_EXTERNAL_BLAS
+// Calls the BLAS GEMM or GEMV routine for T, if the program has been
+// linked with one and the extents fit in its integer arguments.  Returns
+// false when the caller has to compute the product itself.
+template <typename T> struct Blas;
+template <> struct Blas<float> {
+  static auto Gemm() { return &sgemm_; }
+  static auto Gemv() { return &sgemv_; }
+};
+template <> struct Blas<double> {
+  static auto Gemm() { return &dgemm_; }
+  static auto Gemv() { return &dgemv_; }
+};
+template <> struct Blas<std::complex<float>> {
+  static auto Gemm() { return &cgemm_; }
+  static auto Gemv() { return &cgemv_; }
+};
+template <> struct Blas<std::complex<double>> {
+  static auto Gemm() { return &zgemm_; }
+  static auto Gemv() { return &zgemv_; }
+};
+
+static inline bool FitsBlasInt(SubscriptValue n) {
+  return n > 0 && n <= INT_MAX;
+}
+
+// matrix(rows,n) * matrix(n,cols) -> matrix(rows,cols)
+template <typename T>
+static inline bool BlasMatrixTimesMatrix(T *product, SubscriptValue rows,
+    SubscriptValue cols, const T *x, const T *y, SubscriptValue n) {
+  auto gemm{Blas<T>::Gemm()};
+  if (!gemm || !FitsBlasInt(rows) || !FitsBlasInt(cols) || !FitsBlasInt(n)) {
+    return false;
+  }
+  int m{static_cast<int>(rows)}, nc{static_cast<int>(cols)},
+      k{static_cast<int>(n)};
+  T one{1}, zero{0};
+  gemm("N", "N", &m, &nc, &k, &one, x, &m, y, &k, &zero, product, &m);
+  return true;
+}
+
+// Applies matrix(rows,cols), or its transpose if TRANSPOSE, to vector v.
+template <typename T>
+static inline bool BlasMatrixTimesVector(T *product, SubscriptValue rows,
+    SubscriptValue cols, const T *matrix, const T *v, bool transpose) {
+  auto gemv{Blas<T>::Gemv()};
+  if (!gemv || !FitsBlasInt(rows) || !FitsBlasInt(cols)) {
+    return false;
   }
+  int m{static_cast<int>(rows)}, n{static_cast<int>(cols)}, inc{1};
+  T one{1}, zero{0};
+  gemv(transpose ? "T" : "N", &m, &n, &one, matrix, &m, v, &inc, &zero,
+      product, &inc);
+  return true;
 }
 
+// True when T and the element types of the operands and the result are the
+// same type for which there is a BLAS routine.
+template <typename T, typename XT, typename YT>
+static constexpr bool isBlasType{std::is_same_v<T, XT> &&
+    std::is_same_v<T, YT> &&
+    (std::is_same_v<T, float> || std::is_same_v<T, double> ||
+        std::is_same_v<T, std::complex<float>> ||
+        std::is_same_v<T, std::complex<double>>)};
+#endif
+
 // Implements an instance of MATMUL for given argument types.
 template <bool IS_ALLOCATING, TypeCategory RCAT, int RKIND, typename XT,
     typename YT>
@@ -198,49 +305,46 @@ static inline void DoMatmul(
         (IS_ALLOCATING || result.IsContiguous())) {
       // Contiguous numeric matrices
       if (resRank == 2) { // M*M -> M
-        if (std::is_same_v<XT, YT>) {
-          if constexpr (std::is_same_v<XT, float>) {
-            // TODO: call BLAS-3 SGEMM
-          } else if constexpr (std::is_same_v<XT, double>) {
-            // TODO: call BLAS-3 DGEMM
-          } else if constexpr (std::is_same_v<XT, std::complex<float>>) {
-            // TODO: call BLAS-3 CGEMM
-          } else if constexpr (std::is_same_v<XT, std::complex<double>>) {
-            // TODO: call BLAS-3 ZGEMM
+#if FLANG_RUNTIME_EXTERNAL_BLAS
+        if constexpr (isBlasType<WriteResult, XT, YT>) {
+          if (BlasMatrixTimesMatrix(
+                  result.template OffsetElement<WriteResult>(), extent[0],
+                  extent[1], x.OffsetElement<XT>(), y.OffsetElement<YT>(),
+                  n)) {
+            return;
           }
         }
+#endif
         MatrixTimesMatrix<RCAT, RKIND, XT, YT>(
             result.template OffsetElement<WriteResult>(), extent[0], extent[1],
             x.OffsetElement<XT>(), y.OffsetElement<YT>(), n);
         return;
       } else if (xRank == 2) { // M*V -> V
-        if (std::is_same_v<XT, YT>) {
-          if constexpr (std::is_same_v<XT, float>) {
-            // TODO: call BLAS-2 SGEMV(x,y)
-          } else if constexpr (std::is_same_v<XT, double>) {
-            // TODO: call BLAS-2 DGEMV(x,y)
-          } else if constexpr (std::is_same_v<XT, std::complex<float>>) {
-            // TODO: call BLAS-2 CGEMV(x,y)
-          } else if constexpr (std::is_same_v<XT, std::complex<double>>) {
-            // TODO: call BLAS-2 ZGEMV(x,y)
+#if FLANG_RUNTIME_EXTERNAL_BLAS
+        if constexpr (isBlasType<WriteResult, XT, YT>) {
+          if (BlasMatrixTimesVector(
+                  result.template OffsetElement<WriteResult>(), extent[0], n,
+                  x.OffsetElement<XT>(), y.OffsetElement<YT>(), false)) {
+            return;
           }
         }
+#endif
         MatrixTimesVector<RCAT, RKIND, XT, YT>(
             result.template OffsetElement<WriteResult>(), extent[0], n,
             x.OffsetElement<XT>(), y.OffsetElement<YT>());
         return;
       } else { // V*M -> V
-        if (std::is_same_v<XT, YT>) {
-          if constexpr (std::is_same_v<XT, float>) {
-            // TODO: call BLAS-2 SGEMV(y,x)
-          } else if constexpr (std::is_same_v<XT, double>) {
-            // TODO: call BLAS-2 DGEMV(y,x)
-          } else if constexpr (std::is_same_v<XT, std::complex<float>>) {
-            // TODO: call BLAS-2 CGEMV(y,x)
-          } else if constexpr (std::is_same_v<XT, std::complex<double>>) {
-            // TODO: call BLAS-2 ZGEMV(y,x)
+#if FLANG_RUNTIME_EXTERNAL_BLAS
+        // MATMUL does not conjugate complex operands, so Y is transposed
+        // with "T" rather than "C".
+        if constexpr (isBlasType<WriteResult, XT, YT>) {
+          if (BlasMatrixTimesVector(
+                  result.template OffsetElement<WriteResult>(), n, extent[0],
+                  y.OffsetElement<YT>(), x.OffsetElement<XT>(), true)) {
+            return;
           }
         }
+#endif
         VectorTimesMatrix<RCAT, RKIND, XT, YT>(
             result.template OffsetElement<WriteResult>(), n, extent[0],
             x.OffsetElement<XT>(), y.OffsetElement<YT>());
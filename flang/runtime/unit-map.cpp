@@ -27,19 +27,23 @@ void UnitMap::Initialize() {
 // See 12.5.6.12 in Fortran 2018.  NEWUNIT= unit numbers are negative,
 // and not equal to -1 (or ERROR_UNIT, if it were negative, which it isn't.)
 ExternalFileUnit &UnitMap::NewUnit(const Terminator &terminator) {
-  CriticalSection critical{lock_};
-  Initialize();
-  std::optional<int> n{freeNewUnits_.PopValue()};
-  if (!n) {
-    n = emergencyNewUnit_++;
+  std::optional<int> n;
+  {
+    CriticalSection critical{lock_};
+    Initialize();
+    n = freeNewUnits_.PopValue();
+    if (!n) {
+      n = emergencyNewUnit_++;
+    }
   }
+  CriticalSection critical{BucketLock(Hash(-*n))};
   return Create(-*n, terminator);
 }
 
 ExternalFileUnit *UnitMap::LookUpForClose(int n) {
-  CriticalSection critical{lock_};
   Chain *previous{nullptr};
   int hash{Hash(n)};
+  CriticalSection critical{BucketLock(hash)};
   for (Chain *p{bucket_[hash].get()}; p; previous = p, p = p->next.get()) {
     if (p->unit.unitNumber() == n) {
       if (previous) {
@@ -48,6 +52,7 @@ ExternalFileUnit *UnitMap::LookUpForClose(int n) {
         bucket_[hash].swap(p->next);
       }
       // p->next.get() == p at this point; the next swap pushes p on closing_
+      CriticalSection closingCritical{lock_};
       closing_.swap(p->next);
       return &p->unit;
     }
@@ -83,15 +88,13 @@ void UnitMap::DestroyClosed(ExternalFileUnit &unit) {
 
 void UnitMap::CloseAll(IoErrorHandler &handler) {
   // Extract units from the map so they can be closed
-  // without holding lock_.
+  // without holding any lock.
   OwningPtr<Chain> closeList;
-  {
-    CriticalSection critical{lock_};
-    for (int j{0}; j < buckets_; ++j) {
-      while (Chain * p{bucket_[j].get()}) {
-        bucket_[j].swap(p->next); // pops p from head of bucket list
-        closeList.swap(p->next); // pushes p to closeList
-      }
+  for (int j{0}; j < buckets_; ++j) {
+    CriticalSection critical{BucketLock(j)};
+    while (Chain * p{bucket_[j].get()}) {
+      bucket_[j].swap(p->next); // pops p from head of bucket list
+      closeList.swap(p->next); // pushes p to closeList
     }
   }
   while (Chain * p{closeList.get()}) {
@@ -103,8 +106,8 @@ void UnitMap::CloseAll(IoErrorHandler &handler) {
 }
 
 void UnitMap::FlushAll(IoErrorHandler &handler) {
-  CriticalSection critical{lock_};
   for (int j{0}; j < buckets_; ++j) {
+    CriticalSection critical{BucketLock(j)};
     for (Chain *p{bucket_[j].get()}; p; p = p->next.get()) {
       p->unit.FlushOutput(handler);
     }
@@ -115,6 +118,7 @@ ExternalFileUnit *UnitMap::Find(const char *path, std::size_t pathLen) {
   if (path) {
     // TODO: Faster data structure
     for (int j{0}; j < buckets_; ++j) {
+      CriticalSection critical{BucketLock(j)};
       for (Chain *p{bucket_[j].get()}; p; p = p->next.get()) {
         if (p->unit.path() && p->unit.pathLength() == pathLen &&
             std::memcmp(p->unit.path(), path, pathLen) == 0) {
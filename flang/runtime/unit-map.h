@@ -8,6 +8,8 @@
 
 // Maps Fortran unit numbers to their ExternalFileUnit instances.
 // A simple hash table with forward-linked chains per bucket.
+// The buckets are protected by a set of striped locks so that statements
+// on different units running in different threads do not contend.
 
 #ifndef FORTRAN_RUNTIME_UNIT_MAP_H_
 #define FORTRAN_RUNTIME_UNIT_MAP_H_
@@ -24,13 +26,13 @@ namespace Fortran::runtime::io {
 class UnitMap {
 public:
   ExternalFileUnit *LookUp(int n) {
-    CriticalSection critical{lock_};
+    CriticalSection critical{BucketLock(Hash(n))};
     return Find(n);
   }
 
   ExternalFileUnit *LookUpOrCreate(
       int n, const Terminator &terminator, bool &wasExtant) {
-    CriticalSection critical{lock_};
+    CriticalSection critical{BucketLock(Hash(n))};
     if (auto *p{Find(n)}) {
       wasExtant = true;
       return p;
@@ -42,7 +44,6 @@ public:
 
   // Unit look-up by name is needed for INQUIRE(FILE="...")
   ExternalFileUnit *LookUp(const char *path, std::size_t pathLen) {
-    CriticalSection critical{lock_};
     return Find(path, pathLen);
   }
 
@@ -64,15 +65,18 @@ private:
   };
 
   static constexpr int buckets_{1031}; // must be prime
+  static constexpr int bucketLocks_{64};
 
   // The pool of recyclable new unit numbers uses the range that
   // works even with INTEGER(kind=1).  0 and -1 are never used.
   static constexpr int maxNewUnits_{129}; // [ -128 .. 0 ]
 
   int Hash(int n) { return std::abs(n) % buckets_; }
+  Lock &BucketLock(int hash) { return bucketLock_[hash % bucketLocks_]; }
 
   void Initialize();
 
+  // Call only with the bucket's lock held
   ExternalFileUnit *Find(int n) {
     Chain *previous{nullptr};
     int hash{Hash(n)};
@@ -90,10 +94,12 @@ private:
   }
   ExternalFileUnit *Find(const char *path, std::size_t pathLen);
 
+  // Call only with the bucket's lock held
   ExternalFileUnit &Create(int, const Terminator &);
 
-  Lock lock_;
+  Lock lock_; // protects the state below other than bucket_
   bool isInitialized_{false};
+  Lock bucketLock_[bucketLocks_]; // bucket_[j] under bucketLock_[j % 64]
   OwningPtr<Chain> bucket_[buckets_]{}; // all owned by *this
   OwningPtr<Chain> closing_{nullptr}; // units during CLOSE statement
   common::FastIntSet<maxNewUnits_> freeNewUnits_;
@@ -19,6 +19,7 @@
 #include "llvm/Support/raw_ostream.h"
 #include <cstring>
 #include <string_view>
+#include <vector>
 
 using namespace Fortran::runtime;
 using namespace Fortran::runtime::io;
@@ -335,6 +336,82 @@ TEST(ExternalIOTests, TestSequentialVariableUnformatted) {
       << "EndIoStatement() for Close";
 }
 
+TEST(ExternalIOTests, TestSequentialUnformattedLargeRecord) {
+  // OPEN(NEWUNIT=unit,ACCESS='SEQUENTIAL',ACTION='READWRITE',&
+  //   FORM='UNFORMATTED',STATUS='SCRATCH')
+  auto *io{IONAME(BeginOpenNewUnit)(__FILE__, __LINE__)};
+  ASSERT_TRUE(IONAME(SetAccess)(io, "SEQUENTIAL", 10))
+      << "SetAccess(SEQUENTIAL)";
+  ASSERT_TRUE(IONAME(SetAction)(io, "READWRITE", 9)) << "SetAction(READWRITE)";
+  ASSERT_TRUE(IONAME(SetForm)(io, "UNFORMATTED", 11)) << "SetForm(UNFORMATTED)";
+  ASSERT_TRUE(IONAME(SetStatus)(io, "SCRATCH", 7)) << "SetStatus(SCRATCH)";
+  int unit{-1};
+  ASSERT_TRUE(IONAME(GetNewUnit)(io, unit)) << "GetNewUnit()";
+  ASSERT_EQ(IONAME(EndIoStatement)(io), IostatOk)
+      << "EndIoStatement() for OpenNewUnit";
+
+  // A single record, much larger than the initial buffer, built from
+  // many items, followed by a short one.
+  static constexpr int items{64};
+  static constexpr int itemElements{4096};
+  std::vector<std::int64_t> buffer(itemElements);
+  // WRITE(UNIT=unit) (BUFFER+K*ITEMELEMENTS, K=0,ITEMS-1)
+  io = IONAME(BeginUnformattedOutput)(unit, __FILE__, __LINE__);
+  for (int k{0}; k < items; ++k) {
+    for (int j{0}; j < itemElements; ++j) {
+      buffer[j] = k * itemElements + j;
+    }
+    ASSERT_TRUE(IONAME(OutputUnformattedBlock)(io,
+        reinterpret_cast<const char *>(buffer.data()),
+        itemElements * sizeof buffer[0], sizeof buffer[0]))
+        << "OutputUnformattedBlock() for item " << k;
+  }
+  ASSERT_EQ(IONAME(EndIoStatement)(io), IostatOk)
+      << "EndIoStatement() for large OutputUnformattedBlock";
+  // WRITE(UNIT=unit) -1_8
+  std::int64_t last{-1};
+  io = IONAME(BeginUnformattedOutput)(unit, __FILE__, __LINE__);
+  ASSERT_TRUE(IONAME(OutputUnformattedBlock)(io,
+      reinterpret_cast<const char *>(&last), sizeof last, sizeof last))
+      << "OutputUnformattedBlock() for short record";
+  ASSERT_EQ(IONAME(EndIoStatement)(io), IostatOk)
+      << "EndIoStatement() for short OutputUnformattedBlock";
+
+  // REWIND(UNIT=unit)
+  io = IONAME(BeginRewind)(unit, __FILE__, __LINE__);
+  ASSERT_EQ(IONAME(EndIoStatement)(io), IostatOk)
+      << "EndIoStatement() for Rewind";
+
+  // READ(UNIT=unit) BIG
+  std::vector<std::int64_t> big(items * itemElements);
+  io = IONAME(BeginUnformattedInput)(unit, __FILE__, __LINE__);
+  ASSERT_TRUE(IONAME(InputUnformattedBlock)(io,
+      reinterpret_cast<char *>(big.data()), big.size() * sizeof big[0],
+      sizeof big[0]))
+      << "InputUnformattedBlock() for large record";
+  ASSERT_EQ(IONAME(EndIoStatement)(io), IostatOk)
+      << "EndIoStatement() for large InputUnformattedBlock";
+  for (std::size_t j{0}; j < big.size(); ++j) {
+    ASSERT_EQ(big[j], static_cast<std::int64_t>(j))
+        << "Read back [" << j << "] from large record";
+  }
+  // READ(UNIT=unit) LAST
+  last = 0;
+  io = IONAME(BeginUnformattedInput)(unit, __FILE__, __LINE__);
+  ASSERT_TRUE(IONAME(InputUnformattedBlock)(io,
+      reinterpret_cast<char *>(&last), sizeof last, sizeof last))
+      << "InputUnformattedBlock() for short record";
+  ASSERT_EQ(IONAME(EndIoStatement)(io), IostatOk)
+      << "EndIoStatement() for short InputUnformattedBlock";
+  ASSERT_EQ(last, -1) << "Read back short record after large record";
+
+  // CLOSE(UNIT=unit,STATUS='DELETE')
+  io = IONAME(BeginClose)(unit, __FILE__, __LINE__);
+  ASSERT_TRUE(IONAME(SetStatus)(io, "DELETE", 6)) << "SetStatus(DELETE)";
+  ASSERT_EQ(IONAME(EndIoStatement)(io), IostatOk)
+      << "EndIoStatement() for Close";
+}
+
 TEST(ExternalIOTests, TestDirectFormatted) {
   // OPEN(NEWUNIT=unit,ACCESS='DIRECT',ACTION='READWRITE',&
   //   FORM='FORMATTED',RECL=8,STATUS='SCRATCH')
@@ -96,3 +96,63 @@ TEST(Matmul, Basic) {
   EXPECT_TRUE(
       static_cast<bool>(*result.ZeroBasedIndexedElement<std::uint16_t>(3)));
 }
+
+TEST(Matmul, Blocked) {
+  // Extents that are not multiples of the block sizes used for contiguous
+  // operands.  The values are small integers, so the products are exact.
+  constexpr int rows{300}, n{70}, cols{5};
+  std::vector<double> xData(rows * n), yData(n * cols), vData(n);
+  for (int j{0}; j < rows * n; ++j) {
+    xData[j] = j % 7 - 3;
+  }
+  for (int j{0}; j < n * cols; ++j) {
+    yData[j] = j % 5 - 2;
+  }
+  for (int j{0}; j < n; ++j) {
+    vData[j] = j % 3 - 1;
+  }
+  auto x{MakeArray<TypeCategory::Real, 8>(std::vector<int>{rows, n}, xData)};
+  auto y{MakeArray<TypeCategory::Real, 8>(std::vector<int>{n, cols}, yData)};
+  auto v{MakeArray<TypeCategory::Real, 8>(std::vector<int>{n}, vData)};
+  StaticDescriptor<2, true> statDesc;
+  Descriptor &result{statDesc.descriptor()};
+
+  RTNAME(Matmul)(result, *x, *y, __FILE__, __LINE__);
+  ASSERT_EQ(result.rank(), 2);
+  ASSERT_EQ(result.GetDimension(0).Extent(), rows);
+  ASSERT_EQ(result.GetDimension(1).Extent(), cols);
+  for (int i{0}; i < rows; ++i) {
+    for (int j{0}; j < cols; ++j) {
+      double expect{0};
+      for (int k{0}; k < n; ++k) {
+        expect += xData[i + k * rows] * yData[k + j * n];
+      }
+      EXPECT_EQ(*result.ZeroBasedIndexedElement<double>(i + j * rows), expect);
+    }
+  }
+  result.Destroy();
+
+  RTNAME(Matmul)(result, *x, *v, __FILE__, __LINE__);
+  ASSERT_EQ(result.rank(), 1);
+  ASSERT_EQ(result.GetDimension(0).Extent(), rows);
+  for (int i{0}; i < rows; ++i) {
+    double expect{0};
+    for (int k{0}; k < n; ++k) {
+      expect += xData[i + k * rows] * vData[k];
+    }
+    EXPECT_EQ(*result.ZeroBasedIndexedElement<double>(i), expect);
+  }
+  result.Destroy();
+
+  RTNAME(Matmul)(result, *v, *y, __FILE__, __LINE__);
+  ASSERT_EQ(result.rank(), 1);
+  ASSERT_EQ(result.GetDimension(0).Extent(), cols);
+  for (int j{0}; j < cols; ++j) {
+    double expect{0};
+    for (int k{0}; k < n; ++k) {
+      expect += vData[k] * yData[k + j * n];
+    }
+    EXPECT_EQ(*result.ZeroBasedIndexedElement<double>(j), expect);
+  }
+  result.Destroy();
+}
@@ -10,16 +10,23 @@ extern void *memset(void *, int, size_t);
 extern void bzero(void *, size_t);
 extern int memcmp(const void *, const void *, size_t);
 extern int bcmp(const void *, const void *, size_t);
+extern size_t strlen(const char *);
+extern void *memchr(const void *, int, size_t);
+extern char *strchr(const char *, int);
+extern char *strrchr(const char *, int);
 
 } // namespace __llvm_libc
 
 // List of implementations to test.
 
 using llvm::libc_benchmarks::BzeroConfiguration;
+using llvm::libc_benchmarks::MemchrConfiguration;
 using llvm::libc_benchmarks::MemcmpOrBcmpConfiguration;
 using llvm::libc_benchmarks::MemcpyConfiguration;
 using llvm::libc_benchmarks::MemmoveConfiguration;
 using llvm::libc_benchmarks::MemsetConfiguration;
+using llvm::libc_benchmarks::StrchrOrStrrchrConfiguration;
+using llvm::libc_benchmarks::StrlenConfiguration;
 
 llvm::ArrayRef<MemcpyConfiguration> getMemcpyConfigurations() {
   static constexpr MemcpyConfiguration kMemcpyConfigurations[] = {
@@ -51,3 +58,23 @@ llvm::ArrayRef<BzeroConfiguration> getBzeroConfigurations() {
       {__llvm_libc::bzero, "__llvm_libc::bzero"}};
   return llvm::makeArrayRef(kBzeroConfigurations);
 }
+llvm::ArrayRef<StrlenConfiguration> getStrlenConfigurations() {
+  static constexpr StrlenConfiguration kStrlenConfigurations[] = {
+      {__llvm_libc::strlen, "__llvm_libc::strlen"}};
+  return llvm::makeArrayRef(kStrlenConfigurations);
+}
+llvm::ArrayRef<MemchrConfiguration> getMemchrConfigurations() {
+  static constexpr MemchrConfiguration kMemchrConfigurations[] = {
+      {__llvm_libc::memchr, "__llvm_libc::memchr"}};
+  return llvm::makeArrayRef(kMemchrConfigurations);
+}
+llvm::ArrayRef<StrchrOrStrrchrConfiguration> getStrchrConfigurations() {
+  static constexpr StrchrOrStrrchrConfiguration kStrchrConfigurations[] = {
+      {__llvm_libc::strchr, "__llvm_libc::strchr"}};
+  return llvm::makeArrayRef(kStrchrConfigurations);
+}
+llvm::ArrayRef<StrchrOrStrrchrConfiguration> getStrrchrConfigurations() {
+  static constexpr StrchrOrStrrchrConfiguration kStrrchrConfigurations[] = {
+      {__llvm_libc::strrchr, "__llvm_libc::strrchr"}};
+  return llvm::makeArrayRef(kStrrchrConfigurations);
+}
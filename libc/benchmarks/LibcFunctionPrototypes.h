@@ -38,6 +38,24 @@ struct MemcmpOrBcmpConfiguration {
   llvm::StringRef Name;
 };
 
+using StrlenFunction = size_t (*)(const char *);
+struct StrlenConfiguration {
+  StrlenFunction Function;
+  llvm::StringRef Name;
+};
+
+using MemchrFunction = void *(*)(const void *, int, size_t);
+struct MemchrConfiguration {
+  MemchrFunction Function;
+  llvm::StringRef Name;
+};
+
+using StrchrOrStrrchrFunction = char *(*)(const char *, int);
+struct StrchrOrStrrchrConfiguration {
+  StrchrOrStrrchrFunction Function;
+  llvm::StringRef Name;
+};
+
 } // namespace libc_benchmarks
 } // namespace llvm
 
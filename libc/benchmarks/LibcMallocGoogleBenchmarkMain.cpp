@@ -0,0 +1,74 @@
+//===-- Benchmark malloc and free against the system allocator ------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace __llvm_libc {
+
+extern void *malloc(size_t);
+extern void free(void *);
+
+} // namespace __llvm_libc
+
+struct LlvmLibcAllocator {
+  static void *allocate(size_t Size) { return __llvm_libc::malloc(Size); }
+  static void deallocate(void *Ptr) { __llvm_libc::free(Ptr); }
+};
+
+struct SystemAllocator {
+  static void *allocate(size_t Size) { return ::malloc(Size); }
+  static void deallocate(void *Ptr) { ::free(Ptr); }
+};
+
+// Every thread keeps a set of live blocks and repeatedly replaces a random one
+// with a new block of random size in [MinSize, MaxSize]. The sizes and slots
+// are drawn up front so that only the allocator is measured.
+template <typename Allocator>
+static void BM_MallocFree(benchmark::State &State) {
+  static constexpr size_t kLiveBlocks = 1024;
+  static constexpr size_t kBatchSize = 4096;
+  const size_t MinSize = State.range(0);
+  const size_t MaxSize = State.range(1);
+
+  std::mt19937_64 Generator(State.thread_index());
+  std::uniform_int_distribution<size_t> SizeSampler(MinSize, MaxSize);
+  std::uniform_int_distribution<size_t> SlotSampler(0, kLiveBlocks - 1);
+  std::vector<size_t> Sizes(kBatchSize);
+  std::vector<size_t> Slots(kBatchSize);
+  for (size_t I = 0; I < kBatchSize; ++I) {
+    Sizes[I] = SizeSampler(Generator);
+    Slots[I] = SlotSampler(Generator);
+  }
+
+  std::vector<void *> Live(kLiveBlocks, nullptr);
+  while (State.KeepRunningBatch(kBatchSize)) {
+    for (size_t I = 0; I < kBatchSize; ++I) {
+      void *&Slot = Live[Slots[I]];
+      Allocator::deallocate(Slot);
+      Slot = Allocator::allocate(Sizes[I]);
+      benchmark::DoNotOptimize(Slot);
+    }
+  }
+  for (void *Ptr : Live)
+    Allocator::deallocate(Ptr);
+  State.SetItemsProcessed(State.iterations());
+}
+
+static void applyArguments(benchmark::internal::Benchmark *Benchmark) {
+  // Small, medium and mixed sizes, the latter including large blocks.
+  Benchmark->Args({1, 128})->Args({128, 4096})->Args({1, 65536});
+  Benchmark->ThreadRange(1, 16)->UseRealTime();
+}
+
+BENCHMARK_TEMPLATE(BM_MallocFree, LlvmLibcAllocator)->Apply(applyArguments);
+BENCHMARK_TEMPLATE(BM_MallocFree, SystemAllocator)->Apply(applyArguments);
@@ -131,5 +131,12 @@ ComparisonSetup::ComparisonSetup()
 SetSetup::SetSetup()
     : ParameterBatch(1), DstBuffer(ParameterBatch::BufferSize) {}
 
+SearchSetup::SearchSetup()
+    : ParameterBatch(1), Buffer(ParameterBatch::BufferSize) {
+  // The buffer contains neither the null terminator nor the searched
+  // character, `Call` terminates the strings.
+  memset(Buffer.begin(), kFill, BufferSize);
+}
+
 } // namespace libc_benchmarks
 } // namespace llvm
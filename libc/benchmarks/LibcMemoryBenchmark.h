@@ -266,6 +266,42 @@ private:
   AlignedBuffer RhsBuffer;
 };
 
+/// Provides the buffer for the string search operations as well as the
+/// associated size distributions. The functions scan `SizeBytes` bytes without
+/// finding the character they look for.
+struct SearchSetup : public ParameterBatch {
+  SearchSetup();
+
+  inline static const ArrayRef<MemorySizeDistribution> getDistributions() {
+    return getMemcmpSizeDistributions();
+  }
+
+  inline size_t Call(ParameterType Parameter, StrlenFunction Strlen) {
+    const size_t End = Parameter.OffsetBytes + Parameter.SizeBytes;
+    Buffer[End] = '\0';
+    const size_t Length = Strlen(Buffer + Parameter.OffsetBytes);
+    Buffer[End] = kFill;
+    return Length;
+  }
+
+  inline void *Call(ParameterType Parameter, MemchrFunction Memchr) {
+    return Memchr(Buffer + Parameter.OffsetBytes, 0, Parameter.SizeBytes);
+  }
+
+  inline char *Call(ParameterType Parameter,
+                    StrchrOrStrrchrFunction StrchrOrStrrchr) {
+    const size_t End = Parameter.OffsetBytes + Parameter.SizeBytes;
+    Buffer[End] = '\0';
+    char *const Found = StrchrOrStrrchr(Buffer + Parameter.OffsetBytes, 'A');
+    Buffer[End] = kFill;
+    return Found;
+  }
+
+private:
+  static constexpr char kFill = 0xF;
+  AlignedBuffer Buffer;
+};
+
 } // namespace libc_benchmarks
 } // namespace llvm
 
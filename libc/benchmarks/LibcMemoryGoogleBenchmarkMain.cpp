@@ -23,6 +23,12 @@ using llvm::libc_benchmarks::MemsetConfiguration;
 using llvm::libc_benchmarks::MoveSetup;
 using llvm::libc_benchmarks::OffsetDistribution;
 using llvm::libc_benchmarks::SetSetup;
+#if defined(LIBC_BENCHMARK_STRING_FUNCTIONS)
+using llvm::libc_benchmarks::MemchrConfiguration;
+using llvm::libc_benchmarks::SearchSetup;
+using llvm::libc_benchmarks::StrchrOrStrrchrConfiguration;
+using llvm::libc_benchmarks::StrlenConfiguration;
+#endif
 
 // Alignment to use for when accessing the buffers.
 static constexpr Align kBenchmarkAlignment = Align::Constant<1>();
@@ -115,3 +121,24 @@ BENCHMARK_MEMORY_FUNCTION(BM_Memset, SetSetup, MemsetConfiguration,
 extern llvm::ArrayRef<BzeroConfiguration> getBzeroConfigurations();
 BENCHMARK_MEMORY_FUNCTION(BM_Bzero, SetSetup, BzeroConfiguration,
                           getBzeroConfigurations());
+
+// The string functions are not part of the generated automemcpy
+// implementations, which reuse this file.
+#if defined(LIBC_BENCHMARK_STRING_FUNCTIONS)
+extern llvm::ArrayRef<StrlenConfiguration> getStrlenConfigurations();
+BENCHMARK_MEMORY_FUNCTION(BM_Strlen, SearchSetup, StrlenConfiguration,
+                          getStrlenConfigurations());
+
+extern llvm::ArrayRef<MemchrConfiguration> getMemchrConfigurations();
+BENCHMARK_MEMORY_FUNCTION(BM_Memchr, SearchSetup, MemchrConfiguration,
+                          getMemchrConfigurations());
+
+extern llvm::ArrayRef<StrchrOrStrrchrConfiguration> getStrchrConfigurations();
+BENCHMARK_MEMORY_FUNCTION(BM_Strchr, SearchSetup, StrchrOrStrrchrConfiguration,
+                          getStrchrConfigurations());
+
+extern llvm::ArrayRef<StrchrOrStrrchrConfiguration> getStrrchrConfigurations();
+BENCHMARK_MEMORY_FUNCTION(BM_Strrchr, SearchSetup,
+                          StrchrOrStrrchrConfiguration,
+                          getStrrchrConfigurations());
+#endif // LIBC_BENCHMARK_STRING_FUNCTIONS
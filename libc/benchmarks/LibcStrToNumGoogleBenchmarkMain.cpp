@@ -0,0 +1,100 @@
+//===-- Benchmark the string to number conversions ------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "src/__support/str_to_float.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace __llvm_libc {
+
+extern double strtod(const char *__restrict, char **__restrict);
+extern long long strtoll(const char *__restrict, char **__restrict, int);
+
+} // namespace __llvm_libc
+
+// A line of a CSV file with kCount comma separated numbers, printed by
+// `Format` from random values. The values are drawn up front so that only the
+// parsing is measured.
+static constexpr size_t kCount = 4096;
+
+static std::string makeDoubles() {
+  std::mt19937_64 Generator(0);
+  std::uniform_real_distribution<double> Sampler(-1e6, 1e6);
+  std::string Line;
+  char Buffer[32];
+  for (size_t I = 0; I < kCount; ++I) {
+    snprintf(Buffer, sizeof(Buffer), "%.17g,", Sampler(Generator));
+    Line += Buffer;
+  }
+  return Line;
+}
+
+static std::string makeIntegers() {
+  std::mt19937_64 Generator(0);
+  std::string Line;
+  char Buffer[32];
+  for (size_t I = 0; I < kCount; ++I) {
+    snprintf(Buffer, sizeof(Buffer), "%lld,",
+             static_cast<long long>(Generator() >> 1));
+    Line += Buffer;
+  }
+  return Line;
+}
+
+template <double (*Strtod)(const char *__restrict, char **__restrict)>
+static void BM_Strtod(benchmark::State &State) {
+  const std::string Line = makeDoubles();
+  std::vector<double> Values(kCount);
+  while (State.KeepRunningBatch(kCount)) {
+    const char *Src = Line.c_str();
+    char *End;
+    for (size_t I = 0; I < kCount; ++I, Src = End + 1)
+      Values[I] = Strtod(Src, &End);
+    benchmark::DoNotOptimize(Values.data());
+  }
+  State.SetBytesProcessed(State.iterations() * Line.size() / kCount);
+}
+BENCHMARK_TEMPLATE(BM_Strtod, __llvm_libc::strtod);
+BENCHMARK_TEMPLATE(BM_Strtod, ::strtod);
+
+// The whole line at once, with the bulk interface of the implementation.
+static void BM_StrtodList(benchmark::State &State) {
+  const std::string Line = makeDoubles();
+  std::vector<double> Values(kCount);
+  while (State.KeepRunningBatch(kCount)) {
+    const size_t Parsed =
+        __llvm_libc::internal::strtofloatingpoint_list<double>(
+            Line.c_str(), ',', Values.data(), kCount, nullptr);
+    benchmark::DoNotOptimize(Parsed);
+    benchmark::DoNotOptimize(Values.data());
+  }
+  State.SetBytesProcessed(State.iterations() * Line.size() / kCount);
+}
+BENCHMARK(BM_StrtodList);
+
+template <long long (*Strtoll)(const char *__restrict, char **__restrict, int)>
+static void BM_Strtoll(benchmark::State &State) {
+  const std::string Line = makeIntegers();
+  std::vector<long long> Values(kCount);
+  while (State.KeepRunningBatch(kCount)) {
+    const char *Src = Line.c_str();
+    char *End;
+    for (size_t I = 0; I < kCount; ++I, Src = End + 1)
+      Values[I] = Strtoll(Src, &End, 10);
+    benchmark::DoNotOptimize(Values.data());
+  }
+  State.SetBytesProcessed(State.iterations() * Line.size() / kCount);
+}
+BENCHMARK_TEMPLATE(BM_Strtoll, __llvm_libc::strtoll);
+BENCHMARK_TEMPLATE(BM_Strtoll, ::strtoll);
@@ -9,6 +9,9 @@
 #include "file.h"
 
 #include "src/__support/CPP/span.h"
+#include "src/string/memory_utils/memcpy_implementations.h"
+#include "src/string/memory_utils/memset_implementations.h"
+#include "src/string/memory_utils/scan_implementations.h"
 
 #include <errno.h>
 #include <stdio.h>
@@ -83,9 +86,7 @@ size_t File::write_unlocked_fbf(const uint8_t *data, size_t len) {
   cpp::span<uint8_t> bufref(static_cast<uint8_t *>(buf), bufsize);
 
   // Copy the first piece into the buffer.
-  // TODO: Replace the for loop below with a call to internal memcpy.
-  for (size_t i = 0; i < primary.size(); ++i)
-    bufref[pos + i] = primary[i];
+  inline_memcpy(bufref.data() + pos, primary.data(), primary.size());
   pos += primary.size();
 
   // If there is no remainder, we can return early, since the first piece has
@@ -109,9 +110,7 @@ size_t File::write_unlocked_fbf(const uint8_t *data, size_t len) {
   // know that if the second piece has data in it then the buffer has been
   // flushed, meaning that pos is always 0.
   if (remainder.size() < bufsize) {
-    // TODO: Replace the for loop below with a call to internal memcpy.
-    for (size_t i = 0; i < remainder.size(); ++i)
-      bufref[i] = remainder[i];
+    inline_memcpy(bufref.data(), remainder.data(), remainder.size());
     pos = remainder.size();
   } else {
     size_t bytes_written =
@@ -175,6 +174,38 @@ size_t File::write_unlocked_lbf(const uint8_t *data, size_t len) {
   return len;
 }
 
+size_t File::fill_unlocked(uint8_t c, size_t len) {
+  if (!write_allowed()) {
+    errno = EBADF;
+    err = true;
+    return 0;
+  }
+
+  // Set the bytes in place if they fit in the buffer and don't require a
+  // flush of a line buffered file.
+  if (prev_op == FileOp::WRITE && len <= bufsize - pos &&
+      (bufmode == _IOFBF || (bufmode == _IOLBF && c != '\n'))) {
+    inline_memset(static_cast<uint8_t *>(buf) + pos, c, len);
+    pos += len;
+    return len;
+  }
+
+  // Else go through write_unlocked, a chunk at a time.
+  constexpr size_t CHUNK_SIZE = 64;
+  uint8_t chunk[CHUNK_SIZE];
+  inline_memset(chunk, c, len < CHUNK_SIZE ? len : CHUNK_SIZE);
+  size_t written = 0;
+  while (written < len) {
+    const size_t remaining = len - written;
+    const size_t chunk_size = remaining < CHUNK_SIZE ? remaining : CHUNK_SIZE;
+    const size_t chunk_written = write_unlocked(chunk, chunk_size);
+    written += chunk_written;
+    if (chunk_written < chunk_size)
+      break;
+  }
+  return written;
+}
+
 size_t File::read_unlocked(void *data, size_t len) {
   if (!read_allowed()) {
     errno = EBADF;
@@ -191,17 +222,13 @@ size_t File::read_unlocked(void *data, size_t len) {
   // available_data is never a wrapped around value.
   size_t available_data = read_limit - pos;
   if (len <= available_data) {
-    // TODO: Replace the for loop below with a call to internal memcpy.
-    for (size_t i = 0; i < len; ++i)
-      dataref[i] = bufref[i + pos];
+    inline_memcpy(dataref.data(), bufref.data() + pos, len);
     pos += len;
     return len;
   }
 
   // Copy all of the available data.
-  // TODO: Replace the for loop with a call to internal memcpy.
-  for (size_t i = 0; i < available_data; ++i)
-    dataref[i] = bufref[i + pos];
+  inline_memcpy(dataref.data(), bufref.data() + pos, available_data);
   read_limit = pos = 0; // Reset the pointers.
   // Update the dataref to reflect that fact that we have already
   // copied |available_data| into |data|.
@@ -225,8 +252,7 @@ size_t File::read_unlocked(void *data, size_t len) {
   size_t fetched_size = platform_read(this, buf, bufsize);
   read_limit += fetched_size;
   size_t transfer_size = fetched_size >= to_fetch ? to_fetch : fetched_size;
-  for (size_t i = 0; i < transfer_size; ++i)
-    dataref[i] = bufref[i];
+  inline_memcpy(dataref.data(), bufref.data(), transfer_size);
   pos += transfer_size;
   if (fetched_size < to_fetch) {
     if (errno == 0)
@@ -237,6 +263,45 @@ size_t File::read_unlocked(void *data, size_t len) {
   return transfer_size + available_data;
 }
 
+size_t File::read_until_unlocked(void *data, size_t len, uint8_t delim) {
+  if (!read_allowed()) {
+    errno = EBADF;
+    err = true;
+    return 0;
+  }
+
+  prev_op = FileOp::READ;
+
+  uint8_t *dataref = static_cast<uint8_t *>(data);
+  size_t read = 0;
+  while (read < len) {
+    // Because read_limit is always greater than equal to pos,
+    // available_data is never a wrapped around value.
+    const size_t available_data = read_limit - pos;
+    if (available_data == 0) {
+      // Let read_unlocked refill the buffer, it also deals with the end of
+      // file and the errors.
+      if (read_unlocked(dataref + read, 1) != 1)
+        return read;
+      if (dataref[read++] == delim)
+        return read;
+      continue;
+    }
+    const uint8_t *available = static_cast<const uint8_t *>(buf) + pos;
+    size_t transfer_size = len - read < available_data ? len - read
+                                                       : available_data;
+    const void *found = inline_memchr(available, delim, transfer_size);
+    if (found != nullptr)
+      transfer_size = static_cast<const uint8_t *>(found) - available + 1;
+    inline_memcpy(dataref + read, available, transfer_size);
+    pos += transfer_size;
+    read += transfer_size;
+    if (found != nullptr)
+      return read;
+  }
+  return read;
+}
+
 int File::ungetc_unlocked(int c) {
   // There is no meaning to unget if:
   // 1. You are trying to push back EOF.
@@ -10,6 +10,7 @@
 #define LLVM_LIBC_SRC_SUPPORT_OSUTIL_FILE_H
 
 #include "src/__support/threads/mutex.h"
+#include "src/__support/threads/single_threaded.h"
 
 #include <stddef.h>
 #include <stdint.h>
@@ -182,9 +183,18 @@ public:
     return write_unlocked(data, len);
   }
 
+  // Buffered write of |len| copies of the byte |c| without the file lock.
+  // When they fit, the bytes are set in place in the buffer.
+  size_t fill_unlocked(uint8_t c, size_t len);
+
   // Buffered read of |len| bytes into |data| without the file lock.
   size_t read_unlocked(void *data, size_t len);
 
+  // Buffered read into |data| of at most |len| bytes, stopping after the
+  // first byte equal to |delim|, without the file lock. The buffered data is
+  // searched for |delim| a block at a time instead of being read byte by byte.
+  size_t read_until_unlocked(void *data, size_t len, uint8_t delim);
+
   // Buffered read of |len| bytes into |data| under the file lock.
   size_t read(void *data, size_t len) {
     FileLock l(this);
@@ -227,8 +237,21 @@ public:
   // Closes the file stream and frees up all resources owned by it.
   int close();
 
-  void lock() { mutex.lock(); }
-  void unlock() { mutex.unlock(); }
+  // The lock is taken with plain loads and stores while the process has a
+  // single thread, as no other thread can contend for it.
+  void lock() {
+    if (is_single_threaded())
+      mutex.lock_single_threaded();
+    else
+      mutex.lock();
+  }
+
+  void unlock() {
+    if (is_single_threaded())
+      mutex.unlock_single_threaded();
+    else
+      mutex.unlock();
+  }
 
   bool error_unlocked() const { return err; }
 
@@ -0,0 +1,397 @@
+//===-- Implementation of the memory allocator ----------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/__support/allocator/allocator.h"
+
+#include "src/__support/CPP/atomic.h"
+#include "src/__support/OSUtil/syscall.h" // For syscall functions.
+#include "src/__support/allocator/size_class_map.h"
+#include "src/__support/common.h"
+#include "src/__support/threads/mutex.h"
+#include "src/string/memory_utils/memcpy_implementations.h"
+#include "src/string/memory_utils/memset_implementations.h"
+
+#include <linux/param.h> // For EXEC_PAGESIZE.
+#include <stdint.h>
+#include <sys/mman.h>    // For PROT_* and MAP_* definitions.
+#include <sys/syscall.h> // For syscall numbers.
+
+// Provided by the threading library, see src/__support/threads/thread.cpp.
+extern "C" int __cxa_thread_atexit_impl(void (*callback)(void *), void *obj,
+                                        void *dso_symbol);
+
+namespace __llvm_libc {
+namespace allocator {
+
+static_assert(sizeof(void *) == 8,
+              "the allocator reserves more than 32 bits of address space");
+
+#ifdef SYS_mmap2
+static constexpr long MMAP_SYSCALL_NUMBER = SYS_mmap2;
+#elif SYS_mmap
+static constexpr long MMAP_SYSCALL_NUMBER = SYS_mmap;
+#else
+#error "SYS_mmap or SYS_mmap2 not available on the target platform"
+#endif
+
+static constexpr size_t PAGE_SIZE = EXEC_PAGESIZE;
+// The address space reserved for every size class.
+static constexpr size_t REGION_SIZE_LOG = 32;
+static constexpr size_t REGION_SIZE = size_t(1) << REGION_SIZE_LOG;
+static constexpr size_t PRIMARY_SIZE = SizeClassMap::NUM_CLASSES * REGION_SIZE;
+// The regions are made accessible by chunks of the size and alignment of a
+// huge page, so that the kernel can back them with transparent huge pages.
+static constexpr size_t MAP_CHUNK_SIZE = size_t(1) << 21;
+
+static constexpr uintptr_t round_up(uintptr_t value, uintptr_t alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+//===----------------------------------------------------------------------===//
+// Page mapping
+//===----------------------------------------------------------------------===//
+
+static void *map_pages(size_t size, int prot, int flags) {
+  long result = __llvm_libc::syscall_impl(MMAP_SYSCALL_NUMBER,
+                                          0, // No special address
+                                          size, prot,
+                                          MAP_ANONYMOUS | MAP_PRIVATE | flags,
+                                          -1, // Not backed by any file
+                                          0   // No offset
+  );
+  // A negative value in the last page is an error code.
+  if (result < 0 && result > -long(PAGE_SIZE))
+    return nullptr;
+  return reinterpret_cast<void *>(result);
+}
+
+static void unmap_pages(uintptr_t addr, size_t size) {
+  __llvm_libc::syscall_impl(SYS_munmap, addr, size);
+}
+
+static bool make_accessible(uintptr_t addr, size_t size) {
+  return __llvm_libc::syscall_impl(SYS_mprotect, addr, size,
+                                   PROT_READ | PROT_WRITE) == 0;
+}
+
+//===----------------------------------------------------------------------===//
+// Primary allocator, for the sizes handled by the SizeClassMap
+//===----------------------------------------------------------------------===//
+
+namespace {
+
+struct FreeBlock {
+  FreeBlock *next;
+};
+
+// The state of a size class, shared by all the threads. Aligned to avoid false
+// sharing between the mutexes of different classes.
+struct alignas(64) Region {
+  Mutex mutex = Mutex(false, false, false);
+  FreeBlock *free_list = nullptr;
+  // Offsets in the region of the first never allocated byte and of the end of
+  // the accessible memory.
+  uintptr_t allocated_end = 0;
+  uintptr_t mapped_end = 0;
+};
+
+enum class PrimaryState : int { UNINITIALIZED, READY, FAILED };
+
+} // anonymous namespace
+
+static Region regions[SizeClassMap::NUM_CLASSES];
+static Mutex primary_mutex(false, false, false);
+static cpp::Atomic<int> primary_state(int(PrimaryState::UNINITIALIZED));
+// The start of the reserved address space, 0 until it is reserved.
+static cpp::Atomic<uintptr_t> primary_base(0);
+
+// Reserves the address space of the regions on first use. Returns false if it
+// couldn't be reserved, in which case everything is allocated by the secondary
+// allocator.
+static bool init_primary() {
+  const int state = primary_state.load(cpp::MemoryOrder::ACQUIRE);
+  if (likely(state == int(PrimaryState::READY)))
+    return true;
+  if (state == int(PrimaryState::FAILED))
+    return false;
+
+  MutexLock lock(&primary_mutex);
+  if (primary_state.load(cpp::MemoryOrder::RELAXED) ==
+      int(PrimaryState::UNINITIALIZED)) {
+    // Nothing is committed until the chunks are made accessible.
+    void *reserved =
+        map_pages(PRIMARY_SIZE + MAP_CHUNK_SIZE, PROT_NONE, MAP_NORESERVE);
+    if (reserved == nullptr) {
+      primary_state.store(int(PrimaryState::FAILED),
+                          cpp::MemoryOrder::RELEASE);
+      return false;
+    }
+    primary_base.store(
+        round_up(reinterpret_cast<uintptr_t>(reserved), MAP_CHUNK_SIZE),
+        cpp::MemoryOrder::RELAXED);
+    primary_state.store(int(PrimaryState::READY), cpp::MemoryOrder::RELEASE);
+  }
+  return primary_state.load(cpp::MemoryOrder::ACQUIRE) ==
+         int(PrimaryState::READY);
+}
+
+// Returns the class of the block `ptr` if it belongs to the primary allocator,
+// 0 otherwise.
+static size_t get_primary_class_id(const void *ptr) {
+  const uintptr_t base = primary_base.load(cpp::MemoryOrder::RELAXED);
+  const uintptr_t offset = reinterpret_cast<uintptr_t>(ptr) - base;
+  if (base == 0 || offset >= PRIMARY_SIZE)
+    return 0;
+  return offset >> REGION_SIZE_LOG;
+}
+
+// Moves up to `count` free blocks of class `class_id` to `blocks`, and returns
+// how many were moved. Blocks are carved from the region when the free list
+// runs out.
+static size_t pop_blocks(size_t class_id, void **blocks, size_t count) {
+  Region &region = regions[class_id];
+  const size_t size = SizeClassMap::get_size(class_id);
+  const uintptr_t region_begin =
+      primary_base.load(cpp::MemoryOrder::RELAXED) + class_id * REGION_SIZE;
+
+  MutexLock lock(&region.mutex);
+  size_t popped = 0;
+  for (; popped < count && region.free_list != nullptr; ++popped) {
+    blocks[popped] = region.free_list;
+    region.free_list = region.free_list->next;
+  }
+  if (popped == count)
+    return popped;
+
+  const uintptr_t wanted_end = region.allocated_end + (count - popped) * size;
+  if (wanted_end > region.mapped_end) {
+    const uintptr_t new_mapped_end = round_up(wanted_end, MAP_CHUNK_SIZE);
+    if (new_mapped_end <= REGION_SIZE &&
+        make_accessible(region_begin + region.mapped_end,
+                        new_mapped_end - region.mapped_end))
+      region.mapped_end = new_mapped_end;
+  }
+  for (; popped < count && region.allocated_end + size <= region.mapped_end;
+       ++popped) {
+    blocks[popped] =
+        reinterpret_cast<void *>(region_begin + region.allocated_end);
+    region.allocated_end += size;
+  }
+  return popped;
+}
+
+// Returns `count` blocks of class `class_id` to the free list of the class.
+static void push_blocks(size_t class_id, void **blocks, size_t count) {
+  // Link the blocks before taking the lock.
+  for (size_t i = 0; i + 1 < count; ++i)
+    static_cast<FreeBlock *>(blocks[i])->next =
+        static_cast<FreeBlock *>(blocks[i + 1]);
+  FreeBlock *last = static_cast<FreeBlock *>(blocks[count - 1]);
+
+  Region &region = regions[class_id];
+  MutexLock lock(&region.mutex);
+  last->next = region.free_list;
+  region.free_list = static_cast<FreeBlock *>(blocks[0]);
+}
+
+//===----------------------------------------------------------------------===//
+// Thread cache
+//===----------------------------------------------------------------------===//
+
+namespace {
+
+struct ThreadCache {
+  enum class State : uint8_t { UNINITIALIZED, ACTIVE, TORN_DOWN };
+
+  struct PerClass {
+    uint32_t count;
+    uint32_t max_count;
+    void *blocks[SizeClassMap::MAX_CACHED];
+  };
+
+  State state;
+  PerClass classes[SizeClassMap::NUM_CLASSES];
+};
+
+} // anonymous namespace
+
+// Zero initialized, so that it lives in the TLS bss and costs nothing to the
+// threads which don't allocate.
+static thread_local ThreadCache thread_cache;
+
+// Called when the thread exits, returns the cached blocks to the regions.
+static void tear_down_thread_cache(void *arg) {
+  ThreadCache *cache = static_cast<ThreadCache *>(arg);
+  for (size_t class_id = 1; class_id < SizeClassMap::NUM_CLASSES; ++class_id) {
+    ThreadCache::PerClass &per_class = cache->classes[class_id];
+    if (per_class.count != 0)
+      push_blocks(class_id, per_class.blocks, per_class.count);
+    per_class.count = 0;
+  }
+  // Later deallocations, from the destructors of other thread locals for
+  // instance, go directly to the regions.
+  cache->state = ThreadCache::State::TORN_DOWN;
+}
+
+// Returns true if the cache of this thread can be used.
+static bool init_thread_cache(ThreadCache &cache) {
+  if (cache.state == ThreadCache::State::TORN_DOWN)
+    return false;
+  for (size_t class_id = 1; class_id < SizeClassMap::NUM_CLASSES; ++class_id)
+    cache.classes[class_id].max_count =
+        uint32_t(SizeClassMap::get_max_cached(class_id));
+  // The last argument identifies the module of the callback.
+  if (__cxa_thread_atexit_impl(tear_down_thread_cache, &cache,
+                               reinterpret_cast<void *>(
+                                   &tear_down_thread_cache)) != 0)
+    return false;
+  cache.state = ThreadCache::State::ACTIVE;
+  return true;
+}
+
+static void *allocate_small(size_t class_id) {
+  ThreadCache &cache = thread_cache;
+  if (unlikely(cache.state != ThreadCache::State::ACTIVE) &&
+      !init_thread_cache(cache)) {
+    void *block;
+    return pop_blocks(class_id, &block, 1) ? block : nullptr;
+  }
+  ThreadCache::PerClass &per_class = cache.classes[class_id];
+  if (unlikely(per_class.count == 0)) {
+    // Refill half of the cache, so that the next deallocations don't drain it
+    // right away.
+    per_class.count = uint32_t(
+        pop_blocks(class_id, per_class.blocks, per_class.max_count / 2));
+    if (per_class.count == 0)
+      return nullptr;
+  }
+  return per_class.blocks[--per_class.count];
+}
+
+static void deallocate_small(void *ptr, size_t class_id) {
+  ThreadCache &cache = thread_cache;
+  if (unlikely(cache.state != ThreadCache::State::ACTIVE) &&
+      !init_thread_cache(cache)) {
+    push_blocks(class_id, &ptr, 1);
+    return;
+  }
+  ThreadCache::PerClass &per_class = cache.classes[class_id];
+  if (unlikely(per_class.count == per_class.max_count)) {
+    // Return the oldest half of the cache to the region.
+    const uint32_t drained = per_class.max_count / 2;
+    push_blocks(class_id, per_class.blocks, drained);
+    per_class.count -= drained;
+    for (uint32_t i = 0; i < per_class.count; ++i)
+      per_class.blocks[i] = per_class.blocks[i + drained];
+  }
+  per_class.blocks[per_class.count++] = ptr;
+}
+
+//===----------------------------------------------------------------------===//
+// Secondary allocator, for the large sizes
+//===----------------------------------------------------------------------===//
+
+namespace {
+
+// Stored right before the blocks of the secondary allocator.
+struct alignas(MIN_ALIGNMENT) LargeHeader {
+  uintptr_t map_begin;
+  size_t map_size;
+};
+
+} // anonymous namespace
+
+static void *allocate_large(size_t size, size_t alignment) {
+  // Over-aligned blocks need extra room to be aligned after the header.
+  const size_t padding = alignment > MIN_ALIGNMENT ? alignment : 0;
+  if (size > SIZE_MAX - sizeof(LargeHeader) - padding - PAGE_SIZE)
+    return nullptr;
+  const size_t map_size =
+      round_up(sizeof(LargeHeader) + padding + size, PAGE_SIZE);
+  void *mapped = map_pages(map_size, PROT_READ | PROT_WRITE, 0);
+  if (mapped == nullptr)
+    return nullptr;
+  const uintptr_t map_begin = reinterpret_cast<uintptr_t>(mapped);
+  const uintptr_t block = round_up(map_begin + sizeof(LargeHeader), alignment);
+  LargeHeader *header = reinterpret_cast<LargeHeader *>(block) - 1;
+  header->map_begin = map_begin;
+  header->map_size = map_size;
+  return reinterpret_cast<void *>(block);
+}
+
+static const LargeHeader *get_large_header(const void *ptr) {
+  return static_cast<const LargeHeader *>(ptr) - 1;
+}
+
+//===----------------------------------------------------------------------===//
+// Interface
+//===----------------------------------------------------------------------===//
+
+void *allocate(size_t size, size_t alignment) {
+  if (alignment < MIN_ALIGNMENT)
+    alignment = MIN_ALIGNMENT;
+  if (alignment > MIN_ALIGNMENT && size <= SizeClassMap::MAX_SIZE) {
+    // The blocks of a class are aligned to the largest power of two dividing
+    // their size, and the powers of two are class sizes.
+    size = round_up(size == 0 ? 1 : size, alignment);
+    const size_t class_size =
+        SizeClassMap::get_size(SizeClassMap::get_class_id(size));
+    if (class_size % alignment != 0)
+      size = size_t(1) << (sizeof(unsigned long long) * 8 -
+                           __builtin_clzll(size - 1));
+  }
+  const size_t class_id = SizeClassMap::get_class_id(size);
+  if (class_id != 0 && init_primary()) {
+    if (void *block = allocate_small(class_id))
+      return block;
+  }
+  return allocate_large(size, alignment);
+}
+
+void *allocate_zeroed(size_t size) {
+  void *block = allocate(size);
+  // The secondary blocks are freshly mapped, hence already zeroed.
+  if (block != nullptr && get_primary_class_id(block) != 0)
+    inline_memset(block, 0, size);
+  return block;
+}
+
+void *reallocate(void *ptr, size_t size) {
+  if (ptr == nullptr)
+    return allocate(size);
+  const size_t old_size = usable_size(ptr);
+  // Don't move the block unless it shrinks by more than half.
+  if (size <= old_size && size >= old_size / 2)
+    return ptr;
+  void *block = allocate(size);
+  if (block == nullptr)
+    return nullptr;
+  inline_memcpy(block, ptr, size < old_size ? size : old_size);
+  deallocate(ptr);
+  return block;
+}
+
+void deallocate(void *ptr) {
+  if (ptr == nullptr)
+    return;
+  if (const size_t class_id = get_primary_class_id(ptr))
+    return deallocate_small(ptr, class_id);
+  const LargeHeader *header = get_large_header(ptr);
+  unmap_pages(header->map_begin, header->map_size);
+}
+
+size_t usable_size(const void *ptr) {
+  if (const size_t class_id = get_primary_class_id(ptr))
+    return SizeClassMap::get_size(class_id);
+  const LargeHeader *header = get_large_header(ptr);
+  return header->map_begin + header->map_size -
+         reinterpret_cast<uintptr_t>(ptr);
+}
+
+} // namespace allocator
+} // namespace __llvm_libc
@@ -0,0 +1,53 @@
+//===-- The memory allocator behind malloc and free -------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_SUPPORT_ALLOCATOR_ALLOCATOR_H
+#define LLVM_LIBC_SRC_SUPPORT_ALLOCATOR_ALLOCATOR_H
+
+#include <stddef.h>
+
+namespace __llvm_libc {
+namespace allocator {
+
+// The alignment of the blocks returned by `allocate` when no larger alignment
+// is requested.
+static constexpr size_t MIN_ALIGNMENT = 16;
+
+// The allocator is organized like the one of Scudo, without the hardening:
+//
+// - The small sizes are rounded up to a size class (see SizeClassMap). Every
+//   class has its own region of the address space, reserved up front and
+//   mapped in huge page sized and aligned chunks as it grows, so the class of
+//   a block is known from its address. The free blocks of a class are kept in
+//   a list protected by a per class mutex.
+// - Every thread caches a few free blocks of each class, so that most
+//   allocations and deallocations don't take any lock.
+// - The large sizes are mapped and unmapped directly.
+
+// Returns a block of at least `size` bytes aligned to `alignment`, which must
+// be a power of two, or nullptr if the memory is exhausted.
+void *allocate(size_t size, size_t alignment = MIN_ALIGNMENT);
+
+// Same as `allocate` with the block filled with zeros.
+void *allocate_zeroed(size_t size);
+
+// Resizes the block `ptr` to `size` bytes, moving it if needed. Returns
+// nullptr and leaves `ptr` untouched if the memory is exhausted. A null `ptr`
+// is allocated.
+void *reallocate(void *ptr, size_t size);
+
+// Returns a block returned by `allocate` to the allocator. `ptr` can be null.
+void deallocate(void *ptr);
+
+// Returns the number of bytes usable in the block `ptr`.
+size_t usable_size(const void *ptr);
+
+} // namespace allocator
+} // namespace __llvm_libc
+
+#endif // LLVM_LIBC_SRC_SUPPORT_ALLOCATOR_ALLOCATOR_H
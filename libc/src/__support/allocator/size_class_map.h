@@ -0,0 +1,82 @@
+//===-- Size classes of the allocator ---------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_SUPPORT_ALLOCATOR_SIZE_CLASS_MAP_H
+#define LLVM_LIBC_SRC_SUPPORT_ALLOCATOR_SIZE_CLASS_MAP_H
+
+#include <stddef.h>
+
+namespace __llvm_libc {
+namespace allocator {
+
+// Maps the small allocation sizes to a fixed set of block sizes. The sizes up
+// to MID_SIZE are multiples of MIN_SIZE, past it every power of two interval
+// is split into 2^STEPS_LOG classes. This is the default size class map of
+// Scudo, with at most 25% of internal fragmentation past MID_SIZE.
+//
+// Class 0 is not used so that it can denote the allocations which are too
+// large for the size classes.
+struct SizeClassMap {
+  static constexpr size_t MIN_SIZE_LOG = 4;
+  static constexpr size_t MID_SIZE_LOG = 8;
+  static constexpr size_t MAX_SIZE_LOG = 15;
+  static constexpr size_t STEPS_LOG = 2;
+
+  static constexpr size_t MIN_SIZE = size_t(1) << MIN_SIZE_LOG;
+  static constexpr size_t MID_SIZE = size_t(1) << MID_SIZE_LOG;
+  static constexpr size_t MAX_SIZE = size_t(1) << MAX_SIZE_LOG;
+  static constexpr size_t MID_CLASS = MID_SIZE >> MIN_SIZE_LOG;
+  static constexpr size_t NUM_CLASSES =
+      MID_CLASS + ((MAX_SIZE_LOG - MID_SIZE_LOG) << STEPS_LOG) + 1;
+
+  // Returns the class of the smallest blocks holding `size` bytes, or 0 if
+  // `size` is larger than MAX_SIZE.
+  static constexpr size_t get_class_id(size_t size) {
+    if (size <= MID_SIZE)
+      return size == 0 ? 1 : (size + MIN_SIZE - 1) >> MIN_SIZE_LOG;
+    if (size > MAX_SIZE)
+      return 0;
+    // `size` is in (2^l, 2^(l + 1)].
+    const size_t l =
+        sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(size - 1);
+    const size_t step = (size - 1 - (size_t(1) << l)) >> (l - STEPS_LOG);
+    return MID_CLASS + ((l - MID_SIZE_LOG) << STEPS_LOG) + step + 1;
+  }
+
+  // Returns the size of the blocks of class `class_id`.
+  static constexpr size_t get_size(size_t class_id) {
+    if (class_id <= MID_CLASS)
+      return class_id << MIN_SIZE_LOG;
+    const size_t rest = class_id - MID_CLASS - 1;
+    const size_t l = MID_SIZE_LOG + (rest >> STEPS_LOG);
+    const size_t step = (rest & ((size_t(1) << STEPS_LOG) - 1)) + 1;
+    return (size_t(1) << l) + (step << (l - STEPS_LOG));
+  }
+
+  // Returns the number of blocks of class `class_id` that a thread keeps in
+  // its cache. Small blocks are cached in larger numbers to amortize the
+  // locking of the shared free lists.
+  static constexpr size_t get_max_cached(size_t class_id) {
+    const size_t count = (size_t(1) << 13) / get_size(class_id);
+    return count > MAX_CACHED ? MAX_CACHED : (count < 2 ? 2 : count);
+  }
+
+  static constexpr size_t MAX_CACHED = 32;
+};
+
+static_assert(SizeClassMap::get_class_id(SizeClassMap::MAX_SIZE) ==
+                  SizeClassMap::NUM_CLASSES - 1,
+              "the largest size must use the last class");
+static_assert(SizeClassMap::get_size(SizeClassMap::NUM_CLASSES - 1) ==
+                  SizeClassMap::MAX_SIZE,
+              "the last class must hold the largest size");
+
+} // namespace allocator
+} // namespace __llvm_libc
+
+#endif // LLVM_LIBC_SRC_SUPPORT_ALLOCATOR_SIZE_CLASS_MAP_H
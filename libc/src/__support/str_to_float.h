@@ -18,6 +18,7 @@
 #include "src/__support/high_precision_decimal.h"
 #include "src/__support/str_to_integer.h"
 #include <errno.h>
+#include <stddef.h>
 
 namespace __llvm_libc {
 namespace internal {
@@ -777,7 +778,26 @@ decimal_string_to_float(const char *__restrict src, const char DECIMAL_POINT,
   // The loop fills the mantissa with as many digits as it can hold
   const BitsType bitstype_max_div_by_base =
       cpp::numeric_limits<BitsType>::max() / BASE;
+  // The runs of digits are first consumed eight at a time, while the mantissa
+  // can hold them, see load_eight_chars. This gives the same mantissa as the
+  // digit by digit loop, which takes over for the remaining digits.
+  constexpr uint32_t TEN_POW_8 = 100000000;
+  const BitsType max_before_eight_digits =
+      (cpp::numeric_limits<BitsType>::max() - (TEN_POW_8 - 1)) / TEN_POW_8;
+  bool try_eight_digits = true;
   while (true) {
+    if (try_eight_digits) {
+      uint64_t chars;
+      while (mantissa <= max_before_eight_digits &&
+             load_eight_chars(src, chars) && is_eight_digits(chars)) {
+        mantissa = (mantissa * TEN_POW_8) + eight_digits_to_int(chars);
+        if (after_decimal)
+          exponent -= 8;
+        seen_digit = true;
+        src += 8;
+      }
+      try_eight_digits = false;
+    }
     if (isdigit(*src)) {
       uint32_t digit = *src - '0';
       seen_digit = true;
@@ -803,6 +823,7 @@ decimal_string_to_float(const char *__restrict src, const char DECIMAL_POINT,
                // the number.
       }
       after_decimal = true;
+      try_eight_digits = true;
       ++src;
       continue;
     }
@@ -1051,6 +1072,36 @@ static inline T strtofloatingpoint(const char *__restrict src,
   return T(result);
 }
 
+// Parses up to `count` floating point numbers separated by `separator` from
+// src into `results`, as for parsing a line of a CSV file. The numbers and the
+// separators may be surrounded by whitespace, so the separator must not be a
+// whitespace character. Stops at the first number which can't be parsed or
+// which is not followed by the separator. Returns the number of numbers
+// parsed, and sets strEnd, if not null, past the last one.
+template <class T>
+static inline size_t strtofloatingpoint_list(const char *__restrict src,
+                                             char separator, T *results,
+                                             size_t count,
+                                             char **__restrict strEnd) {
+  size_t parsed = 0;
+  const char *end = src;
+  while (parsed < count) {
+    char *number_end;
+    const T value = strtofloatingpoint<T>(src, &number_end);
+    if (number_end == src)
+      break;
+    results[parsed++] = value;
+    end = number_end;
+    src = first_non_whitespace(number_end);
+    if (*src != separator)
+      break;
+    ++src;
+  }
+  if (strEnd != nullptr)
+    *strEnd = const_cast<char *>(end);
+  return parsed;
+}
+
 } // namespace internal
 } // namespace __llvm_libc
 
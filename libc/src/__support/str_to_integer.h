@@ -13,6 +13,7 @@
 #include "src/__support/ctype_utils.h"
 #include <errno.h>
 #include <limits.h>
+#include <stdint.h>
 
 namespace __llvm_libc {
 namespace internal {
@@ -34,6 +35,66 @@ static inline int b36_char_to_int(char input) {
   return 0;
 }
 
+// Same as in src/string/memory_utils/utils.h.
+#ifndef LLVM_LIBC_NO_SANITIZE_OOB_ACCESS
+#if defined(__clang__)
+#define LLVM_LIBC_NO_SANITIZE_OOB_ACCESS                                       \
+  __attribute__((no_sanitize("address", "hwaddress", "memory")))
+#elif defined(__GNUC__)
+#define LLVM_LIBC_NO_SANITIZE_OOB_ACCESS __attribute__((no_sanitize_address))
+#else
+#define LLVM_LIBC_NO_SANITIZE_OOB_ACCESS
+#endif
+#endif // LLVM_LIBC_NO_SANITIZE_OOB_ACCESS
+
+// Loads the eight characters starting at src into `chars`, the first one in
+// the lowest byte, and returns true. The characters may extend past the end of
+// the string, so they are only loaded if they are in the same page as src,
+// which can't fault, and false is returned otherwise. Sanitizers would report
+// the bytes past the end of the string and are disabled for this load. The
+// pages are assumed to be at least 4KiB. Always returns false on big endian
+// targets, where the digits would need to be swapped.
+LLVM_LIBC_NO_SANITIZE_OOB_ACCESS static inline bool
+load_eight_chars(const char *__restrict src, uint64_t &chars) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  constexpr uintptr_t MIN_PAGE_SIZE = 4096;
+  if ((reinterpret_cast<uintptr_t>(src) & (MIN_PAGE_SIZE - 1)) >
+      MIN_PAGE_SIZE - sizeof(uint64_t))
+    return false;
+  __builtin_memcpy(&chars, src, sizeof(uint64_t));
+  return true;
+#else
+  (void)src;
+  (void)chars;
+  return false;
+#endif
+}
+
+// Returns true if the eight characters loaded by load_eight_chars are all
+// decimal digits. Adding 6 to a byte carries into its high nibble exactly when
+// its low nibble is above 9, so the high nibbles of the bytes and of the bytes
+// plus 6 are all 3 only for '0' to '9'.
+static inline bool is_eight_digits(uint64_t chars) {
+  constexpr uint64_t HIGH_NIBBLES = 0xf0f0f0f0f0f0f0f0;
+  return ((chars & HIGH_NIBBLES) |
+          (((chars + 0x0606060606060606) & HIGH_NIBBLES) >> 4)) ==
+         0x3333333333333333;
+}
+
+// Returns the value of the eight decimal digits loaded by load_eight_chars.
+// The digits are combined in pairs, then in groups of four and then eight,
+// with three multiplications instead of eight.
+static inline uint32_t eight_digits_to_int(uint64_t chars) {
+  constexpr uint64_t MASK = 0x000000ff000000ff;
+  constexpr uint64_t MUL1 = 100 + (1000000ULL << 32);
+  constexpr uint64_t MUL2 = 1 + (10000ULL << 32);
+  chars -= 0x3030303030303030;
+  // Every byte now holds the value of its digit and its preceding one.
+  chars = (chars * 10) + (chars >> 8);
+  chars = (((chars & MASK) * MUL1) + (((chars >> 16) & MASK) * MUL2)) >> 32;
+  return static_cast<uint32_t>(chars);
+}
+
 // checks if the next 3 characters of the string pointer are the start of a
 // hexadecimal number. Does not advance the string pointer.
 static inline bool is_hex_start(const char *__restrict src) {
@@ -101,6 +162,22 @@ static inline T strtointeger(const char *__restrict src,
   unsigned long long const abs_max =
       (is_positive ? cpp::numeric_limits<T>::max() : NEGATIVE_MAX);
   unsigned long long const abs_max_div_by_base = abs_max / base;
+
+  // Decimal digits are consumed eight at a time while the result can't
+  // overflow. The rest of the number, if any, goes through the loop below.
+  constexpr unsigned long long TEN_POW_8 = 100000000;
+  if (base == 10 && abs_max >= TEN_POW_8 - 1) {
+    const unsigned long long max_before_eight_digits =
+        (abs_max - (TEN_POW_8 - 1)) / TEN_POW_8;
+    uint64_t chars;
+    while (result <= max_before_eight_digits && load_eight_chars(src, chars) &&
+           is_eight_digits(chars)) {
+      result = result * TEN_POW_8 + eight_digits_to_int(chars);
+      is_number = true;
+      src += 8;
+    }
+  }
+
   while (isalnum(*src)) {
     int cur_digit = b36_char_to_int(*src);
     if (cur_digit >= base)
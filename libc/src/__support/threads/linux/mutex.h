@@ -13,6 +13,8 @@
 #include "src/__support/OSUtil/syscall.h" // For syscall functions.
 #include "src/__support/threads/linux/futex_word.h"
 #include "src/__support/threads/mutex_common.h"
+#include "src/__support/threads/mutex_stats.h"
+#include "src/__support/threads/sleep.h"
 
 #include <linux/futex.h>
 #include <stdint.h>
@@ -36,6 +38,11 @@ struct Mutex {
     Waiting,
   };
 
+  // The number of times a contended lock polls the mutex before going to
+  // sleep. Most critical sections are short, and waiting for them to end is
+  // cheaper than the futex syscalls to sleep and to wake up.
+  static constexpr unsigned SPIN_COUNT = 100;
+
 public:
   constexpr Mutex(bool istimed, bool isrecursive, bool isrobust)
       : timed(istimed), recursive(isrecursive), robust(isrobust),
@@ -58,6 +65,17 @@ public:
   MutexError reset();
 
   MutexError lock() {
+    FutexWordType free_status = FutexWordType(LockState::Free);
+    if (futex_word.compare_exchange_strong(free_status,
+                                           FutexWordType(LockState::Locked)))
+      return MutexError::NONE;
+
+    count_mutex_event(MutexEvent::CONTENDED);
+    if (spin_lock()) {
+      count_mutex_event(MutexEvent::SPIN_ACQUIRED);
+      return MutexError::NONE;
+    }
+
     bool was_waiting = false;
     while (true) {
       FutexWordType mutex_status = FutexWordType(LockState::Free);
@@ -76,6 +94,7 @@ public:
         // futex syscall will block if the futex data is still
         // `LockState::Waiting` (the 4th argument to the syscall function
         // below.)
+        count_mutex_event(MutexEvent::SLEEP);
         __llvm_libc::syscall_impl(SYS_futex, &futex_word.val,
                                   FUTEX_WAIT_PRIVATE,
                                   FutexWordType(LockState::Waiting), 0, 0, 0);
@@ -91,6 +110,7 @@ public:
           // we will wait for the futex to be woken up. Note again that the
           // following syscall will block only if the futex data is still
           // `LockState::Waiting`.
+          count_mutex_event(MutexEvent::SLEEP);
           __llvm_libc::syscall_impl(SYS_futex, &futex_word, FUTEX_WAIT_PRIVATE,
                                     FutexWordType(LockState::Waiting), 0, 0, 0);
           was_waiting = true;
@@ -103,6 +123,24 @@ public:
     }
   }
 
+  // Polls the mutex while it is held by another thread and acquires it if it
+  // is released within SPIN_COUNT polls. Gives up early if threads already
+  // sleep on the mutex, as it is then held long enough for spinning not to pay
+  // off.
+  bool spin_lock() {
+    for (unsigned i = 0; i < SPIN_COUNT; ++i) {
+      FutexWordType mutex_status = futex_word.load(cpp::MemoryOrder::RELAXED);
+      if (mutex_status == FutexWordType(LockState::Waiting))
+        return false;
+      if (mutex_status == FutexWordType(LockState::Free) &&
+          futex_word.compare_exchange_strong(mutex_status,
+                                             FutexWordType(LockState::Locked)))
+        return true;
+      sleep_briefly();
+    }
+    return false;
+  }
+
   MutexError unlock() {
     while (true) {
       FutexWordType mutex_status = FutexWordType(LockState::Waiting);
@@ -128,6 +166,28 @@ public:
   }
 
   MutexError trylock();
+
+  // Lock and unlock the mutex with plain loads and stores instead of atomic
+  // read-modify-write operations. They must only be used while a single thread
+  // can access the mutex. The lock state is maintained as by lock and unlock,
+  // so a mutex locked this way can still be unlocked with unlock once other
+  // threads have been started.
+  MutexError lock_single_threaded() {
+    if (futex_word.load(cpp::MemoryOrder::RELAXED) !=
+        FutexWordType(LockState::Free))
+      return lock();
+    futex_word.store(FutexWordType(LockState::Locked),
+                     cpp::MemoryOrder::RELAXED);
+    return MutexError::NONE;
+  }
+
+  MutexError unlock_single_threaded() {
+    if (futex_word.load(cpp::MemoryOrder::RELAXED) !=
+        FutexWordType(LockState::Locked))
+      return unlock();
+    futex_word.store(FutexWordType(LockState::Free), cpp::MemoryOrder::RELAXED);
+    return MutexError::NONE;
+  }
 };
 
 } // namespace __llvm_libc
@@ -14,6 +14,7 @@
 #include "src/__support/CPP/stringstream.h"
 #include "src/__support/OSUtil/syscall.h"           // For syscall functions.
 #include "src/__support/threads/linux/futex_word.h" // For FutexWordType
+#include "src/__support/threads/single_threaded.h"
 
 #ifdef LLVM_LIBC_ARCH_AARCH64
 #include <arm_acle.h>
@@ -186,6 +187,9 @@ int Thread::run(ThreadStyle style, ThreadRunner runner, void *arg, void *stack,
   clear_tid->val = CLEAR_TID_VALUE;
   attrib->platform_data = clear_tid;
 
+  // From now on, the libc internal locks have to be taken atomically.
+  mark_multithreaded();
+
   // The clone syscall takes arguments in an architecture specific order.
   // Also, we want the result of the syscall to be in a register as the child
   // thread gets a completely different stack after it is created. The stack
@@ -20,6 +20,8 @@
 // MutexError timedlock(...);
 // MutexError unlock();
 // MutexError reset(); // Used to reset inconsistent robust mutexes.
+// MutexError lock_single_threaded(); // Used while the process has a single
+// MutexError unlock_single_threaded(); // thread, see single_threaded.h.
 //
 // Apart from the above non-static methods, the specializations should
 // also provide few static methods with the following signature:
@@ -0,0 +1,71 @@
+//===-- Contention statistics of the mutexes --------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_SUPPORT_THREAD_MUTEX_STATS_H
+#define LLVM_LIBC_SRC_SUPPORT_THREAD_MUTEX_STATS_H
+
+#include "src/__support/CPP/atomic.h"
+
+#include <stdint.h>
+
+namespace __llvm_libc {
+
+// The events counted by the mutexes when libc is built with
+// LLVM_LIBC_MUTEX_STATS. Counting adds an atomic increment to the contended
+// paths only, the uncontended lock and unlock are not slowed down.
+enum class MutexEvent {
+  // A thread tried to lock a mutex held by another thread.
+  CONTENDED,
+  // A contended lock succeeded while spinning, without sleeping.
+  SPIN_ACQUIRED,
+  // A thread went to sleep waiting for a mutex.
+  SLEEP,
+  COUNT,
+};
+
+struct MutexStats {
+  uint64_t contended;
+  uint64_t spin_acquired;
+  uint64_t sleeps;
+};
+
+#ifdef LLVM_LIBC_MUTEX_STATS
+inline cpp::Atomic<uint64_t> mutex_event_counts[int(MutexEvent::COUNT)];
+#endif // LLVM_LIBC_MUTEX_STATS
+
+static inline void count_mutex_event([[maybe_unused]] MutexEvent event) {
+#ifdef LLVM_LIBC_MUTEX_STATS
+  mutex_event_counts[int(event)].fetch_add(1, cpp::MemoryOrder::RELAXED);
+#endif // LLVM_LIBC_MUTEX_STATS
+}
+
+// Returns the number of events counted by all the mutexes of the process
+// since its start or the last call to reset_mutex_stats. The counts are all
+// zero if libc was not built with LLVM_LIBC_MUTEX_STATS.
+static inline MutexStats get_mutex_stats() {
+#ifdef LLVM_LIBC_MUTEX_STATS
+  auto get = [](MutexEvent event) {
+    return mutex_event_counts[int(event)].load(cpp::MemoryOrder::RELAXED);
+  };
+  return {get(MutexEvent::CONTENDED), get(MutexEvent::SPIN_ACQUIRED),
+          get(MutexEvent::SLEEP)};
+#else
+  return {0, 0, 0};
+#endif // LLVM_LIBC_MUTEX_STATS
+}
+
+static inline void reset_mutex_stats() {
+#ifdef LLVM_LIBC_MUTEX_STATS
+  for (auto &count : mutex_event_counts)
+    count.store(0, cpp::MemoryOrder::RELAXED);
+#endif // LLVM_LIBC_MUTEX_STATS
+}
+
+} // namespace __llvm_libc
+
+#endif // LLVM_LIBC_SRC_SUPPORT_THREAD_MUTEX_STATS_H
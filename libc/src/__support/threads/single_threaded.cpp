@@ -0,0 +1,15 @@
+//===-- Tracking of the processes which never started a thread ------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "single_threaded.h"
+
+namespace __llvm_libc {
+
+bool process_is_multithreaded = false;
+
+} // namespace __llvm_libc
@@ -0,0 +1,30 @@
+//===-- Tracking of the processes which never started a thread --*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_SUPPORT_THREAD_SINGLE_THREADED_H
+#define LLVM_LIBC_SRC_SUPPORT_THREAD_SINGLE_THREADED_H
+
+namespace __llvm_libc {
+
+// Set by the thread library right before the first thread is started, and
+// never reset afterwards. It is a plain bool: it is only written while the
+// process has a single thread, and the threads which read it are created after
+// the write.
+extern bool process_is_multithreaded;
+
+// Returns true if no thread has ever been started by this process, in which
+// case the locks protecting the libc internal state don't need to be taken
+// atomically.
+inline bool is_single_threaded() { return !process_is_multithreaded; }
+
+// Called by the thread library before it starts a thread.
+inline void mark_multithreaded() { process_is_multithreaded = true; }
+
+} // namespace __llvm_libc
+
+#endif // LLVM_LIBC_SRC_SUPPORT_THREAD_SINGLE_THREADED_H
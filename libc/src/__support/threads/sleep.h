@@ -0,0 +1,28 @@
+//===-- Utilities for busy waiting threads ----------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_SUPPORT_THREAD_SLEEP_H
+#define LLVM_LIBC_SRC_SUPPORT_THREAD_SLEEP_H
+
+#include "src/__support/architectures.h"
+
+namespace __llvm_libc {
+
+// Tells the processor that the calling thread is busy waiting, so that it can
+// save power and give its resources to the other hardware threads of the core.
+static inline void sleep_briefly() {
+#if defined(LLVM_LIBC_ARCH_X86_64)
+  __builtin_ia32_pause();
+#elif defined(LLVM_LIBC_ARCH_AARCH64)
+  __builtin_arm_isb(0xf);
+#endif
+}
+
+} // namespace __llvm_libc
+
+#endif // LLVM_LIBC_SRC_SUPPORT_THREAD_SLEEP_H
@@ -0,0 +1,327 @@
+//===-- Vector implementations of expf, logf, sinf and cosf -----*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_MATH_GENERIC_VECTORF_UTILS_H
+#define LLVM_LIBC_SRC_MATH_GENERIC_VECTORF_UTILS_H
+
+#include "common_constants.h" // Lookup tables EXP_M1, EXP_M2, ONE_OVER_F, LOG_F
+#include "sincosf_utils.h"    // Lookup table SIN_K_PI_OVER_32
+#include "src/__support/CPP/type_traits.h"
+#include "src/__support/FPUtil/multiply_add.h"
+#include "src/__support/common.h"
+#include "src/math/cosf.h"
+#include "src/math/expf.h"
+#include "src/math/logf.h"
+#include "src/math/sinf.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+// The functions below evaluate the main path of the scalar functions on all
+// the lanes of a vector at once, with the same range reductions, lookup tables
+// and polynomials, so that their results are the same correctly rounded
+// results. The lanes which need one of the special cases of the scalar
+// functions (exceptional values, tiny or huge inputs, infinities and NaNs) are
+// computed with a call to the scalar function.
+
+namespace __llvm_libc {
+namespace vectorf {
+
+template <size_t N> struct VectorTypes;
+
+template <> struct VectorTypes<4> {
+  using Float = float __attribute__((__vector_size__(16)));
+  using Double = double __attribute__((__vector_size__(32)));
+  using UInt32 = uint32_t __attribute__((__vector_size__(16)));
+  using Int32 = int32_t __attribute__((__vector_size__(16)));
+  using Int64 = int64_t __attribute__((__vector_size__(32)));
+};
+
+template <> struct VectorTypes<8> {
+  using Float = float __attribute__((__vector_size__(32)));
+  using Double = double __attribute__((__vector_size__(64)));
+  using UInt32 = uint32_t __attribute__((__vector_size__(32)));
+  using Int32 = int32_t __attribute__((__vector_size__(32)));
+  using Int64 = int64_t __attribute__((__vector_size__(64)));
+};
+
+template <typename T> static constexpr size_t lanes() {
+  return sizeof(T) / sizeof(T{}[0]);
+}
+
+// Returns a vector with all its lanes set to `value`, or `value` itself if it
+// is already a vector.
+template <typename T, typename S> static inline T splat(S value) {
+  if constexpr (cpp::is_same_v<T, S>) {
+    return value;
+  } else {
+    T v;
+    for (size_t i = 0; i < lanes<T>(); ++i)
+      v[i] = value;
+    return v;
+  }
+}
+
+// Returns the lanes of `a` where `mask` is set, and those of `b` elsewhere.
+// `mask` is the result of a comparison of vectors of the same shape.
+template <typename T, typename Mask>
+static inline T select(Mask mask, T a, T b) {
+  return (T)(((Mask)a & mask) | ((Mask)b & ~mask));
+}
+
+template <typename Mask> static inline bool any(Mask mask) {
+  for (size_t i = 0; i < lanes<Mask>(); ++i)
+    if (mask[i])
+      return true;
+  return false;
+}
+
+// Same as fputil::multiply_add, lane by lane.
+template <typename T> static inline T multiply_add(T x, T y, T z) {
+#if defined(LIBC_TARGET_HAS_FMA)
+  // The builtins, rather than fputil::fma, let the compiler emit the vector
+  // instructions.
+  T r;
+  for (size_t i = 0; i < lanes<T>(); ++i) {
+    if constexpr (sizeof(r[0]) == sizeof(float))
+      r[i] = __builtin_fmaf(x[i], y[i], z[i]);
+    else
+      r[i] = __builtin_fma(x[i], y[i], z[i]);
+  }
+  return r;
+#else
+  return x * y + z;
+#endif // LIBC_TARGET_HAS_FMA
+}
+
+// Same as fputil::polyeval, lane by lane.
+template <typename T, typename S> static inline T polyeval(T, S a0) {
+  return splat<T>(a0);
+}
+
+template <typename T, typename S, typename... Ss>
+static inline T polyeval(T x, S a0, Ss... a) {
+  return multiply_add(x, polyeval(x, a...), splat<T>(a0));
+}
+
+// Same as the generic fputil::nearest_integer, lane by lane. The lanes must be
+// less than `two_pow_mantissa_width` in absolute value.
+template <typename T, typename S>
+static inline T nearest_integer(T x, S two_pow_mantissa_width) {
+#if (defined(LLVM_LIBC_ARCH_X86_64) && defined(__SSE4_2__)) ||                 \
+    defined(LLVM_LIBC_ARCH_AARCH64)
+  // The rounding instructions are available, the builtins are lowered to their
+  // vector forms.
+  (void)two_pow_mantissa_width;
+  T r;
+  for (size_t i = 0; i < lanes<T>(); ++i) {
+    if constexpr (sizeof(r[0]) == sizeof(float))
+      r[i] = __builtin_roundevenf(x[i]);
+    else
+      r[i] = __builtin_roundeven(x[i]);
+  }
+  return r;
+#else
+  const T shift = splat<T>(two_pow_mantissa_width);
+  T r = select(x < static_cast<S>(0), (x - shift) + shift, (x + shift) - shift);
+  const T diff = x - r;
+  // The expression above is correct for the default rounding mode, for the
+  // other rounding modes it might be off by 1.
+  r = select(diff > static_cast<S>(0.5), r + static_cast<S>(1), r);
+  r = select(diff < static_cast<S>(-0.5), r - static_cast<S>(1), r);
+  return r;
+#endif
+}
+
+// Replaces the lanes of `r` where `special` is set with the results of the
+// scalar function `f`.
+template <typename T, typename Mask>
+static inline T fix_special_lanes(T r, T x, Mask special, float (*f)(float)) {
+  if (unlikely(any(special))) {
+    for (size_t i = 0; i < lanes<T>(); ++i)
+      if (special[i])
+        r[i] = f(x[i]);
+  }
+  return r;
+}
+
+template <typename FloatV> static inline FloatV expf(FloatV x) {
+  using V = VectorTypes<lanes<FloatV>()>;
+  using Float = typename V::Float;
+  using Double = typename V::Double;
+  using Int32 = typename V::Int32;
+  using UInt32 = typename V::UInt32;
+
+  const UInt32 x_u = (UInt32)x;
+  const UInt32 x_abs = x_u & 0x7fff'ffffU;
+  // |x| >= 89, |x| <= 2^-25, NaNs and the exceptional value.
+  const Int32 special =
+      (Int32)((x_abs >= 0x42b2'0000U) | (x_abs <= 0x3280'0000U) |
+              (x_u == 0xc236'bd8cU));
+  // The special lanes are computed on 0 to stay in the range of the tables.
+  const Float xs = select(special, Float{}, x);
+
+  // x_hi = (hi + mid) * 2^7 = round(x * 2^7), see expf.
+  const Float kf = nearest_integer(xs * 0x1.0p7f, 0x1.0p23f);
+  const Double xd = __builtin_convertvector(
+      multiply_add(kf, splat<Float>(-0x1.0p-7f), xs), Double);
+  const Int32 x_hi = __builtin_convertvector(kf, Int32) + (104 << 7);
+  Double exp_hi, exp_mid;
+  for (size_t i = 0; i < lanes<Float>(); ++i) {
+    exp_hi[i] = EXP_M1[x_hi[i] >> 7];
+    exp_mid[i] = EXP_M2[x_hi[i] & 0x7f];
+  }
+  const Double exp_lo =
+      polyeval(xd, 0x1p0, 0x1.ffffffffff777p-1, 0x1.000000000071cp-1,
+               0x1.555566668e5e7p-3, 0x1.55555555ef243p-5);
+  const Float r = __builtin_convertvector(exp_hi * exp_mid * exp_lo, Float);
+  return fix_special_lanes(r, x, special, &__llvm_libc::expf);
+}
+
+template <typename FloatV> static inline FloatV logf(FloatV x) {
+  using V = VectorTypes<lanes<FloatV>()>;
+  using Float = typename V::Float;
+  using Double = typename V::Double;
+  using Int32 = typename V::Int32;
+  using UInt32 = typename V::UInt32;
+  constexpr double LOG_2 = 0x1.62e42fefa39efp-1;
+
+  UInt32 x_u = (UInt32)x;
+  // Zeros, denormals, negative numbers, infinities and NaNs.
+  Int32 special = (Int32)((x_u < 0x0080'0000U) | (x_u > 0x7f7f'ffffU));
+  // The exceptional values of logf.
+  constexpr uint32_t EXCEPTS[] = {0x41178febU, 0x4c5d65a5U, 0x65d890d3U,
+                                  0x6f31a8ecU, 0x3f800001U, 0x500ffb03U,
+                                  0x7a17f30aU, 0x5cd69e88U};
+  for (uint32_t value : EXCEPTS)
+    special |= (Int32)(x_u == value);
+  // The special lanes are computed on 1.
+  x_u = select(special, splat<UInt32>(0x3f80'0000U), x_u);
+
+  // See logf.
+  const Int32 m = (Int32)(x_u >> 23) - 127;
+  const UInt32 one_mant = (x_u & 0x007f'ffffU) | 0x3f80'0000U;
+  const Int32 f_index = (Int32)((x_u & 0x007f'ffffU) >> 16);
+  const UInt32 f = one_mant & ~0x0000'ffffU;
+  Double d = __builtin_convertvector((Float)one_mant - (Float)f, Double);
+  Double one_over_f, log_f;
+  for (size_t i = 0; i < lanes<Float>(); ++i) {
+    one_over_f[i] = ONE_OVER_F[f_index[i]];
+    log_f[i] = LOG_F[f_index[i]];
+  }
+  d *= one_over_f;
+  const Double extra_factor = multiply_add(__builtin_convertvector(m, Double),
+                                           splat<Double>(LOG_2), log_f);
+  const Double r = polyeval(d, extra_factor, 0x1.fffffffffffacp-1,
+                            -0x1.fffffffef9cb2p-2, 0x1.5555513bc679ap-2,
+                            -0x1.fff4805ea441p-3, 0x1.930180dbde91ap-3);
+  return fix_special_lanes(__builtin_convertvector(r, Float), x, special,
+                           &__llvm_libc::logf);
+}
+
+// The vector paths of sinf and cosf are taken below 2^22, the bound of the
+// small range reduction without FMA instructions.
+static constexpr uint32_t SINCOSF_VECTOR_BOUND = 0x4a80'0000U;
+
+// Same as sincosf_eval for |x| < SINCOSF_VECTOR_BOUND, lane by lane.
+template <typename Double>
+static inline void sincosf_eval(Double xd, Double &sin_k, Double &cos_k,
+                                Double &sin_y, Double &cosm1_y) {
+  // Small range reduction, see range_reduction.h and range_reduction_fma.h.
+#if defined(LIBC_TARGET_HAS_FMA)
+  const Double kd =
+      nearest_integer(xd * fma::THIRTYTWO_OVER_PI[0], 0x1.0p52);
+  Double y = multiply_add(xd, splat<Double>(fma::THIRTYTWO_OVER_PI[0]), -kd);
+  y = multiply_add(xd, splat<Double>(fma::THIRTYTWO_OVER_PI[1]), y);
+#else
+  const Double prod = xd * generic::THIRTYTWO_OVER_PI_28[0];
+  const Double kd = nearest_integer(prod, 0x1.0p52);
+  Double y = prod - kd;
+  y = multiply_add(xd, splat<Double>(generic::THIRTYTWO_OVER_PI_28[1]), y);
+  y = multiply_add(xd, splat<Double>(generic::THIRTYTWO_OVER_PI_28[2]), y);
+#endif // LIBC_TARGET_HAS_FMA
+
+  // |k| < 2^26 below SINCOSF_VECTOR_BOUND, so it fits in 32 bits.
+  using Int32 = typename VectorTypes<lanes<Double>()>::Int32;
+  const Int32 k = __builtin_convertvector(kd, Int32);
+  for (size_t i = 0; i < lanes<Double>(); ++i) {
+    sin_k[i] = SIN_K_PI_OVER_32[k[i] & 63];
+    cos_k[i] = SIN_K_PI_OVER_32[(k[i] + 16) & 63];
+  }
+
+  const Double ysq = y * y;
+  sin_y = y * polyeval(ysq, 0x1.921fb54442d18p-4, -0x1.4abbce625abb1p-13,
+                       0x1.466bc624f2776p-24, -0x1.32c3a619d4a7ep-36);
+  cosm1_y = ysq * polyeval(ysq, -0x1.3bd3cc9be430bp-8, 0x1.03c1f070c2e27p-18,
+                           -0x1.55cc84bd942p-30);
+}
+
+template <typename FloatV> static inline FloatV sinf(FloatV x) {
+  using V = VectorTypes<lanes<FloatV>()>;
+  using Float = typename V::Float;
+  using Double = typename V::Double;
+  using Int32 = typename V::Int32;
+  using UInt32 = typename V::UInt32;
+
+  const UInt32 x_abs = (UInt32)x & 0x7fff'ffffU;
+  // |x| < 0x1.d12ed2p-12f, the exceptional value 0x1.33333p13, and the inputs
+  // which need the large range reduction, infinities and NaNs.
+  const Int32 special = (Int32)((x_abs < 0x39e8'9769U) |
+                                (x_abs == 0x4619'9998U) |
+                                (x_abs >= SINCOSF_VECTOR_BOUND));
+  const Double xd =
+      __builtin_convertvector(select(special, Float{}, x), Double);
+
+  // |x| <= pi/16, the lanes are evaluated with a polynomial.
+  const Int32 small = (Int32)(x_abs <= 0x3e49'0fdbU); // pi/16
+  const Double xsq = xd * xd;
+  const Double small_r =
+      xd * polyeval(xsq, 1.0, -0x1.55555555554c6p-3, 0x1.1111111085e65p-7,
+                    -0x1.a019f70fb4d4fp-13, 0x1.718d179815e74p-19);
+
+  // Else sin(x) = sin_y * cos_k + (cosm1_y * sin_k + sin_k), see sinf.
+  Double sin_k, cos_k, sin_y, cosm1_y;
+  sincosf_eval(xd, sin_k, cos_k, sin_y, cosm1_y);
+  const Double r =
+      multiply_add(sin_y, cos_k, multiply_add(cosm1_y, sin_k, sin_k));
+
+  return fix_special_lanes(select(small,
+                                  __builtin_convertvector(small_r, Float),
+                                  __builtin_convertvector(r, Float)),
+                           x, special, &__llvm_libc::sinf);
+}
+
+template <typename FloatV> static inline FloatV cosf(FloatV x) {
+  using V = VectorTypes<lanes<FloatV>()>;
+  using Float = typename V::Float;
+  using Double = typename V::Double;
+  using Int32 = typename V::Int32;
+  using UInt32 = typename V::UInt32;
+
+  const UInt32 x_abs = (UInt32)x & 0x7fff'ffffU;
+  // |x| < 2^-12, and the inputs which need the large range reduction,
+  // infinities and NaNs. The exceptional values of cosf are all larger.
+  const Int32 special =
+      (Int32)((x_abs < 0x3980'0000U) | (x_abs >= SINCOSF_VECTOR_BOUND));
+  const Double xd = __builtin_convertvector(
+      (Float)select(special, UInt32{}, x_abs), Double);
+
+  // cos(x) = (cosm1_y * cos_k + cos_k) - sin_y * sin_k, see cosf.
+  Double sin_k, cos_k, sin_y, cosm1_y;
+  sincosf_eval(xd, sin_k, cos_k, sin_y, cosm1_y);
+  const Double r =
+      multiply_add(sin_y, -sin_k, multiply_add(cosm1_y, cos_k, cos_k));
+
+  return fix_special_lanes(__builtin_convertvector(r, Float), x, special,
+                           &__llvm_libc::cosf);
+}
+
+} // namespace vectorf
+} // namespace __llvm_libc
+
+#endif // LLVM_LIBC_SRC_MATH_GENERIC_VECTORF_UTILS_H
@@ -0,0 +1,38 @@
+//===-- Implementation header for the vector math functions -----*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_MATH_VECTORF_H
+#define LLVM_LIBC_SRC_MATH_VECTORF_H
+
+namespace __llvm_libc {
+
+using Float4 = float __attribute__((__vector_size__(16)));
+using Float8 = float __attribute__((__vector_size__(32)));
+
+// The vector variants of the single precision math functions, named after the
+// x86_64 vector function ABI as in glibc's libmvec, so that the loop vectorizer
+// can call them in place of the scalar functions. Their results are the
+// correctly rounded results of the scalar functions.
+//
+// SSE variants, processing 4 lanes.
+Float4 _ZGVbN4v_cosf(Float4 x);
+Float4 _ZGVbN4v_expf(Float4 x);
+Float4 _ZGVbN4v_logf(Float4 x);
+Float4 _ZGVbN4v_sinf(Float4 x);
+
+#ifdef __AVX2__
+// AVX2 variants, processing 8 lanes.
+Float8 _ZGVdN8v_cosf(Float8 x);
+Float8 _ZGVdN8v_expf(Float8 x);
+Float8 _ZGVdN8v_logf(Float8 x);
+Float8 _ZGVdN8v_sinf(Float8 x);
+#endif // __AVX2__
+
+} // namespace __llvm_libc
+
+#endif // LLVM_LIBC_SRC_MATH_VECTORF_H
@@ -0,0 +1,19 @@
+//===-- Implementation of the AVX2 vector variant of sinf -----------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/math/vectorf.h"
+#include "src/__support/common.h"
+#include "src/math/generic/vectorf_utils.h"
+
+namespace __llvm_libc {
+
+LLVM_LIBC_FUNCTION(Float8, _ZGVdN8v_sinf, (Float8 x)) {
+  return vectorf::sinf(x);
+}
+
+} // namespace __llvm_libc
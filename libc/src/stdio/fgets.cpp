@@ -20,19 +20,12 @@ LLVM_LIBC_FUNCTION(char *, fgets,
   if (count < 1)
     return nullptr;
 
-  unsigned char c = '\0';
   auto stream = reinterpret_cast<__llvm_libc::File *__restrict>(raw_stream);
   stream->lock();
 
-  // i is an int because it's frequently compared to count, which is also int.
-  int i = 0;
-
-  for (; i < (count - 1) && c != '\n'; ++i) {
-    size_t r = stream->read_unlocked(&c, 1);
-    if (r != 1)
-      break;
-    str[i] = c;
-  }
+  // The buffered data is searched for the newline instead of being read one
+  // character at a time.
+  size_t read = stream->read_until_unlocked(str, count - 1, '\n');
 
   bool has_error = stream->error_unlocked();
   bool has_eof = stream->iseof_unlocked();
@@ -40,10 +33,10 @@ LLVM_LIBC_FUNCTION(char *, fgets,
 
   // If the requested read size makes no sense, an error occured, or no bytes
   // were read due to an EOF, then return nullptr and don't write the null byte.
-  if (has_error || (i == 0 && has_eof))
+  if (has_error || (read == 0 && has_eof))
     return nullptr;
 
-  str[i] = '\0';
+  str[read] = '\0';
   return str;
 }
 
@@ -31,16 +31,14 @@ int FileWriter::write_str(void *raw_pointer, cpp::string_view new_string) {
 
 int FileWriter::write_chars(void *raw_pointer, char new_char, size_t len) {
   FileWriter *file_writer = reinterpret_cast<FileWriter *>(raw_pointer);
-  constexpr size_t BUFF_SIZE = 8;
-  char buff[BUFF_SIZE] = {new_char};
-  int result;
-  while (len > BUFF_SIZE) {
-    result = file_writer->write(buff, BUFF_SIZE);
-    if (result < 0)
-      return result;
-    len -= BUFF_SIZE;
-  }
-  return file_writer->write(buff, len);
+  // The padding is set in place in the file buffer rather than being staged.
+  int written = file_writer->file->fill_unlocked(
+      static_cast<uint8_t>(new_char), len);
+  if (written != static_cast<int>(len))
+    written = FILE_WRITE_ERROR;
+  if (file_writer->file->error_unlocked())
+    written = FILE_STATUS_ERROR;
+  return written;
 }
 
 // TODO(michaelrj): Move this to putc_unlocked once that is available.
@@ -14,7 +14,6 @@
 
 namespace __llvm_libc {
 
-// TODO: Look at performance benefits of comparing words.
 LLVM_LIBC_FUNCTION(void *, memchr, (const void *src, int c, size_t n)) {
   return internal::find_first_character(
       reinterpret_cast<const unsigned char *>(src),
@@ -171,6 +171,32 @@ template <size_t Size> struct Bcmp {
   }
 };
 
+///////////////////////////////////////////////////////////////////////////////
+// Scan
+#ifdef __ARM_NEON
+namespace neon {
+// There is no `movemask` on aarch64. Narrowing the comparison result with a
+// shift by 4 gives a 64-bit mask with 4 bits per byte instead.
+struct Scan : public generic::ScanMask<uint64_t, 16, 4> {
+  static inline Mask mask(uint8x16_t cmp) {
+    const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+  }
+  static inline uint8x16_t load(CPtr src) {
+    return load_aligned_block<uint8x16_t>(src);
+  }
+  static inline Mask zero(CPtr src) { return mask(vceqzq_u8(load(src))); }
+  static inline Mask equal(CPtr src, uint8_t value) {
+    return mask(vceqq_u8(load(src), vdupq_n_u8(value)));
+  }
+  static inline Mask zero_or_equal(CPtr src, uint8_t value) {
+    const uint8x16_t v = load(src);
+    return mask(vorrq_u8(vceqzq_u8(v), vceqq_u8(v, vdupq_n_u8(value))));
+  }
+};
+} // namespace neon
+#endif // __ARM_NEON
+
 } // namespace __llvm_libc::aarch64
 
 #endif // LLVM_LIBC_ARCH_AARCH64
@@ -469,6 +469,74 @@ template <size_t Size, size_t MaxSize> struct Memmove {
   }
 };
 
+///////////////////////////////////////////////////////////////////////////////
+// Scan
+//
+// The Scan building blocks look for bytes in an aligned block of SIZE bytes,
+// loaded with `load_aligned_block`.
+// They return a mask in which byte `i` of the block is represented by
+// `BITS_PER_BYTE` consecutive bits, all of them set when the byte matches.
+// Aligned blocks never straddle a page boundary, so a string function can load
+// the whole block containing its first and last bytes without faulting.
+
+// Operations on the masks returned by the Scan building blocks.
+template <typename MaskT, size_t Size, size_t BitsPerByte> struct ScanMask {
+  using Mask = MaskT;
+  static constexpr size_t SIZE = Size;
+  static constexpr size_t BITS_PER_BYTE = BitsPerByte;
+  static_assert(cpp::is_integral_v<Mask> && !cpp::is_signed_v<Mask>);
+  static_assert(sizeof(Mask) * 8 >= SIZE * BITS_PER_BYTE);
+
+  // Index of the first matching byte, `mask` must not be zero.
+  static inline size_t first(Mask mask) {
+    return static_cast<size_t>(__builtin_ctzll(mask)) / BITS_PER_BYTE;
+  }
+  // Index of the last matching byte, `mask` must not be zero.
+  static inline size_t last(Mask mask) {
+    return static_cast<size_t>(63 - __builtin_clzll(mask)) / BITS_PER_BYTE;
+  }
+  // Discards the bytes before `index`, with `index < SIZE`.
+  static inline Mask from(Mask mask, size_t index) {
+    return mask & (~Mask(0) << (index * BITS_PER_BYTE));
+  }
+  // Discards the bytes from `index` on, with `index <= SIZE`.
+  static inline Mask before(Mask mask, size_t index) {
+    if (index * BITS_PER_BYTE == sizeof(Mask) * 8)
+      return mask;
+    return mask & ((Mask(1) << (index * BITS_PER_BYTE)) - 1);
+  }
+};
+
+// Scans a word at a time. The mask is the word itself, with the most
+// significant bit of every zero byte set, so this only works on little endian
+// targets.
+template <typename T>
+struct Scan : public ScanMask<uint64_t, sizeof(T), 8> {
+  static_assert(Endian::IS_LITTLE, "word scanning needs a little endian target");
+  using Word = typename ScalarType<T>::Type;
+  using Mask = uint64_t;
+
+  // Returns the exact mask of the zero bytes of `word`. The usual
+  // `(word - 0x01..) & ~word & 0x80..` also flags some bytes that follow a zero
+  // byte, which matters to `last`.
+  static inline Mask zero_bytes(Word word) {
+    const Word low7 = ScalarType<T>::splat(0x7F);
+    return static_cast<Word>(~(((word & low7) + low7) | word | low7));
+  }
+
+  static inline Mask zero(CPtr src) {
+    return zero_bytes(load_aligned_block<Word>(src));
+  }
+  static inline Mask equal(CPtr src, uint8_t value) {
+    return zero_bytes(load_aligned_block<Word>(src) ^
+                      ScalarType<T>::splat(value));
+  }
+  static inline Mask zero_or_equal(CPtr src, uint8_t value) {
+    const Word word = load_aligned_block<Word>(src);
+    return zero_bytes(word) | zero_bytes(word ^ ScalarType<T>::splat(value));
+  }
+};
+
 } // namespace __llvm_libc::generic
 
 #endif // LLVM_LIBC_SRC_STRING_MEMORY_UTILS_OP_GENERIC_H
@@ -221,6 +221,50 @@ static inline MemcmpReturnType memcmp64(CPtr p1, CPtr p2) {
 template <size_t Size> using Memcmp = MemcmpImpl<Size, 64, memcmp64, bcmp64>;
 } // namespace avx512bw
 
+///////////////////////////////////////////////////////////////////////////////
+// Scan
+//
+// `movemask` turns the result of a byte comparison into a mask with one bit
+// per byte.
+
+namespace sse2 {
+struct Scan : public generic::ScanMask<uint32_t, 16, 1> {
+  using T = char __attribute__((__vector_size__(16)));
+  static inline Mask mask(T cmp) {
+    return static_cast<uint16_t>(_mm_movemask_epi8(cmp));
+  }
+  static inline Mask zero(CPtr src) {
+    return mask(load_aligned_block<T>(src) == T{});
+  }
+  static inline Mask equal(CPtr src, uint8_t value) {
+    return mask(load_aligned_block<T>(src) == static_cast<char>(value));
+  }
+  static inline Mask zero_or_equal(CPtr src, uint8_t value) {
+    const T v = load_aligned_block<T>(src);
+    return mask((v == T{}) | (v == static_cast<char>(value)));
+  }
+};
+} // namespace sse2
+
+namespace avx2 {
+struct Scan : public generic::ScanMask<uint64_t, 32, 1> {
+  using T = char __attribute__((__vector_size__(32)));
+  static inline Mask mask(T cmp) {
+    return static_cast<uint32_t>(_mm256_movemask_epi8(cmp));
+  }
+  static inline Mask zero(CPtr src) {
+    return mask(load_aligned_block<T>(src) == T{});
+  }
+  static inline Mask equal(CPtr src, uint8_t value) {
+    return mask(load_aligned_block<T>(src) == static_cast<char>(value));
+  }
+  static inline Mask zero_or_equal(CPtr src, uint8_t value) {
+    const T v = load_aligned_block<T>(src);
+    return mask((v == T{}) | (v == static_cast<char>(value)));
+  }
+};
+} // namespace avx2
+
 } // namespace __llvm_libc::x86
 
 #endif // LLVM_LIBC_ARCH_X86_64
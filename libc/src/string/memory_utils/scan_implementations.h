@@ -0,0 +1,195 @@
+//===-- Implementation of strlen, strchr, strrchr and memchr --------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_STRING_MEMORY_UTILS_SCAN_IMPLEMENTATIONS_H
+#define LLVM_LIBC_SRC_STRING_MEMORY_UTILS_SCAN_IMPLEMENTATIONS_H
+
+#include "src/__support/architectures.h"
+#include "src/__support/common.h"
+#include "src/__support/endian.h"
+#include "src/string/memory_utils/op_aarch64.h"
+#include "src/string/memory_utils/op_generic.h"
+#include "src/string/memory_utils/op_x86.h"
+#include "src/string/memory_utils/utils.h"
+
+#include <stddef.h> // size_t
+#include <stdint.h> // uint8_t, SIZE_MAX
+
+namespace __llvm_libc {
+
+///////////////////////////////////////////////////////////////////////////////
+// Byte at a time implementations, used on the targets without a Scan building
+// block.
+
+[[maybe_unused]] static inline size_t inline_strlen_byte_per_byte(CPtr src) {
+  size_t length = 0;
+  for (; src[length] != cpp::byte{0}; ++length)
+    ;
+  return length;
+}
+
+[[maybe_unused]] static inline CPtr inline_memchr_byte_per_byte(CPtr src,
+                                                                uint8_t value,
+                                                                size_t count) {
+  for (; count && src[0] != cpp::byte{value}; --count, ++src)
+    ;
+  return count ? src : nullptr;
+}
+
+[[maybe_unused]] static inline CPtr inline_strchr_byte_per_byte(CPtr src,
+                                                                uint8_t value) {
+  for (; src[0] != cpp::byte{0} && src[0] != cpp::byte{value}; ++src)
+    ;
+  return src[0] == cpp::byte{value} ? src : nullptr;
+}
+
+[[maybe_unused]] static inline CPtr inline_strrchr_byte_per_byte(CPtr src,
+                                                                 uint8_t value) {
+  CPtr last_occurrence = nullptr;
+  for (;; ++src) {
+    if (src[0] == cpp::byte{value})
+      last_occurrence = src;
+    if (src[0] == cpp::byte{0})
+      return last_occurrence;
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Block at a time implementations, `Scan` is one of the Scan building blocks.
+
+template <typename Scan>
+static inline size_t
+inline_strlen_scan(CPtr src) {
+  const size_t misalignment = distance_to_align_down<Scan::SIZE>(src);
+  CPtr block = assume_aligned<Scan::SIZE>(src - misalignment);
+  auto mask = Scan::from(Scan::zero(block), misalignment);
+  while (!mask) {
+    block += Scan::SIZE;
+    mask = Scan::zero(block);
+  }
+  return static_cast<size_t>(block - src) + Scan::first(mask);
+}
+
+template <typename Scan>
+static inline CPtr
+inline_memchr_scan(CPtr src, uint8_t value, size_t count) {
+  if (count == 0)
+    return nullptr;
+  const size_t misalignment = distance_to_align_down<Scan::SIZE>(src);
+  CPtr block = assume_aligned<Scan::SIZE>(src - misalignment);
+  // The end of the buffer relative to `block`. memchr is sometimes called with
+  // a huge count to find a byte that is known to be present.
+  size_t end =
+      count > SIZE_MAX - misalignment ? SIZE_MAX : misalignment + count;
+  auto mask = Scan::from(Scan::equal(block, value), misalignment);
+  while (end > Scan::SIZE) {
+    if (mask)
+      return block + Scan::first(mask);
+    block += Scan::SIZE;
+    end -= Scan::SIZE;
+    mask = Scan::equal(block, value);
+  }
+  mask = Scan::before(mask, end);
+  return mask ? block + Scan::first(mask) : nullptr;
+}
+
+template <typename Scan>
+static inline CPtr
+inline_strchr_scan(CPtr src, uint8_t value) {
+  const size_t misalignment = distance_to_align_down<Scan::SIZE>(src);
+  CPtr block = assume_aligned<Scan::SIZE>(src - misalignment);
+  auto mask = Scan::from(Scan::zero_or_equal(block, value), misalignment);
+  while (!mask) {
+    block += Scan::SIZE;
+    mask = Scan::zero_or_equal(block, value);
+  }
+  CPtr found = block + Scan::first(mask);
+  return found[0] == cpp::byte{value} ? found : nullptr;
+}
+
+template <typename Scan>
+static inline CPtr
+inline_strrchr_scan(CPtr src, uint8_t value) {
+  const size_t misalignment = distance_to_align_down<Scan::SIZE>(src);
+  CPtr block = assume_aligned<Scan::SIZE>(src - misalignment);
+  CPtr last_occurrence = nullptr;
+  auto zeros = Scan::from(Scan::zero(block), misalignment);
+  auto matches = Scan::from(Scan::equal(block, value), misalignment);
+  while (!zeros) {
+    if (matches)
+      last_occurrence = block + Scan::last(matches);
+    block += Scan::SIZE;
+    zeros = Scan::zero(block);
+    matches = Scan::equal(block, value);
+  }
+  // The null terminator is part of the string, strrchr(s, 0) finds it.
+  matches = Scan::before(matches, Scan::first(zeros) + 1);
+  if (matches)
+    last_occurrence = block + Scan::last(matches);
+  return last_occurrence;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Dispatch to the widest Scan building block available on the target.
+
+#if defined(LLVM_LIBC_ARCH_X86_64) && defined(__AVX2__)
+#define LLVM_LIBC_SCAN x86::avx2::Scan
+#elif defined(LLVM_LIBC_ARCH_X86_64) && defined(__SSE2__)
+#define LLVM_LIBC_SCAN x86::sse2::Scan
+#elif defined(LLVM_LIBC_ARCH_AARCH64) && defined(__ARM_NEON)
+#define LLVM_LIBC_SCAN aarch64::neon::Scan
+#elif __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define LLVM_LIBC_SCAN generic::Scan<uintptr_t>
+#endif
+
+static inline size_t inline_strlen(const char *src) {
+#ifdef LLVM_LIBC_SCAN
+  return inline_strlen_scan<LLVM_LIBC_SCAN>(reinterpret_cast<CPtr>(src));
+#else
+  return inline_strlen_byte_per_byte(reinterpret_cast<CPtr>(src));
+#endif
+}
+
+static inline void *inline_memchr(const void *src, uint8_t value,
+                                  size_t count) {
+#ifdef LLVM_LIBC_SCAN
+  CPtr found = inline_memchr_scan<LLVM_LIBC_SCAN>(reinterpret_cast<CPtr>(src),
+                                                  value, count);
+#else
+  CPtr found =
+      inline_memchr_byte_per_byte(reinterpret_cast<CPtr>(src), value, count);
+#endif
+  return const_cast<cpp::byte *>(found);
+}
+
+static inline char *inline_strchr(const char *src, uint8_t value) {
+#ifdef LLVM_LIBC_SCAN
+  CPtr found =
+      inline_strchr_scan<LLVM_LIBC_SCAN>(reinterpret_cast<CPtr>(src), value);
+#else
+  CPtr found = inline_strchr_byte_per_byte(reinterpret_cast<CPtr>(src), value);
+#endif
+  return reinterpret_cast<char *>(const_cast<cpp::byte *>(found));
+}
+
+static inline char *inline_strrchr(const char *src, uint8_t value) {
+#ifdef LLVM_LIBC_SCAN
+  CPtr found =
+      inline_strrchr_scan<LLVM_LIBC_SCAN>(reinterpret_cast<CPtr>(src), value);
+#else
+  CPtr found =
+      inline_strrchr_byte_per_byte(reinterpret_cast<CPtr>(src), value);
+#endif
+  return reinterpret_cast<char *>(const_cast<cpp::byte *>(found));
+}
+
+#undef LLVM_LIBC_SCAN
+
+} // namespace __llvm_libc
+
+#endif // LLVM_LIBC_SRC_STRING_MEMORY_UTILS_SCAN_IMPLEMENTATIONS_H
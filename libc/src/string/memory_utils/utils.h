@@ -150,6 +150,28 @@ template <typename T> static inline T load(CPtr ptr) {
   return Out;
 }
 
+#if defined(__clang__)
+#define LLVM_LIBC_NO_SANITIZE_OOB_ACCESS                                       \
+  __attribute__((no_sanitize("address", "hwaddress", "memory")))
+#elif defined(__GNUC__)
+#define LLVM_LIBC_NO_SANITIZE_OOB_ACCESS __attribute__((no_sanitize_address))
+#else
+#define LLVM_LIBC_NO_SANITIZE_OOB_ACCESS
+#endif
+
+// Loads the block of sizeof(T) bytes at `ptr`, which must be aligned to
+// sizeof(T). The string functions use it to read the whole aligned block
+// containing the beginning or the end of a string. Such a block never
+// straddles a page boundary so it can't fault, but it may extend past the
+// bounds of the object which sanitizers would report.
+template <typename T>
+LLVM_LIBC_NO_SANITIZE_OOB_ACCESS static inline T load_aligned_block(CPtr ptr) {
+  // Not using `load` as it would be instrumented when not inlined.
+  T Out;
+  __builtin_memcpy(&Out, assume_aligned<sizeof(T)>(ptr), sizeof(T));
+  return Out;
+}
+
 // Stores a value of type T in memory (possibly unaligned).
 template <typename T> static inline void store(Ptr ptr, T value) {
   memcpy_inline<sizeof(T)>(ptr, &value);
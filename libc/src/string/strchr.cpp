@@ -9,15 +9,12 @@
 #include "src/string/strchr.h"
 
 #include "src/__support/common.h"
+#include "src/string/memory_utils/scan_implementations.h"
 
 namespace __llvm_libc {
 
-// TODO: Look at performance benefits of comparing words.
 LLVM_LIBC_FUNCTION(char *, strchr, (const char *src, int c)) {
-  const char ch = static_cast<char>(c);
-  for (; *src && *src != ch; ++src)
-    ;
-  return *src == ch ? const_cast<char *>(src) : nullptr;
+  return inline_strchr(src, static_cast<uint8_t>(c));
 }
 
 } // namespace __llvm_libc
@@ -13,6 +13,7 @@
 #include "src/__support/common.h"
 #include "src/string/memory_utils/bzero_implementations.h"
 #include "src/string/memory_utils/memcpy_implementations.h"
+#include "src/string/memory_utils/scan_implementations.h"
 #include <stddef.h> // For size_t
 #include <stdlib.h> // For malloc and free
 
@@ -22,19 +23,14 @@ namespace internal {
 // Returns the length of a string, denoted by the first occurrence
 // of a null terminator.
 static inline size_t string_length(const char *src) {
-  size_t length;
-  for (length = 0; *src; ++src, ++length)
-    ;
-  return length;
+  return inline_strlen(src);
 }
 
 // Returns the first occurrence of 'ch' within the first 'n' characters of
 // 'src'. If 'ch' is not found, returns nullptr.
 static inline void *find_first_character(const unsigned char *src,
                                          unsigned char ch, size_t n) {
-  for (; n && *src != ch; --n, ++src)
-    ;
-  return n ? const_cast<unsigned char *>(src) : nullptr;
+  return inline_memchr(src, ch, n);
 }
 
 // Returns the maximum length span that contains only characters not found in
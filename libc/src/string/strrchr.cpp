@@ -9,17 +9,12 @@
 #include "src/string/strrchr.h"
 
 #include "src/__support/common.h"
+#include "src/string/memory_utils/scan_implementations.h"
 
 namespace __llvm_libc {
 
 LLVM_LIBC_FUNCTION(char *, strrchr, (const char *src, int c)) {
-  const char ch = static_cast<char>(c);
-  char *last_occurrence = nullptr;
-  for (; *src; ++src) {
-    if (*src == ch)
-      last_occurrence = const_cast<char *>(src);
-  }
-  return last_occurrence;
+  return inline_strrchr(src, static_cast<uint8_t>(c));
 }
 
 } // namespace __llvm_libc
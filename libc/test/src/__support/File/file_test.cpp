@@ -485,3 +485,72 @@ TEST(LlvmLibcFileTest, WriteNothing) {
   ASSERT_EQ(f_lbf->close(), 0);
   ASSERT_EQ(f_nbf->close(), 0);
 }
+
+TEST(LlvmLibcFileTest, ReadUntil) {
+  // StringFile reads past the end of the content up to the buffer size, so
+  // the content is a multiple of the buffer size.
+  const char initial_content[] = "line one\nline two\nlast_1";
+  constexpr size_t FILE_BUFFER_SIZE = 8;
+  char file_buffer[FILE_BUFFER_SIZE];
+  StringFile *f =
+      new_string_file(file_buffer, FILE_BUFFER_SIZE, _IOFBF, false, "r");
+  f->reset_and_fill(initial_content, sizeof(initial_content) - 1);
+
+  constexpr size_t READ_SIZE = 32;
+  char read_data[READ_SIZE];
+  // The delimiter is past the end of the buffer.
+  ASSERT_EQ(size_t(9), f->read_until_unlocked(read_data, READ_SIZE, '\n'));
+  MemoryView src1("line one\n", 9), dst1(read_data, 9);
+  EXPECT_MEM_EQ(src1, dst1);
+
+  // The read stops at the requested size.
+  ASSERT_EQ(size_t(4), f->read_until_unlocked(read_data, 4, '\n'));
+  MemoryView src2("line", 4), dst2(read_data, 4);
+  EXPECT_MEM_EQ(src2, dst2);
+  ASSERT_EQ(size_t(5), f->read_until_unlocked(read_data, READ_SIZE, '\n'));
+  MemoryView src3(" two\n", 5), dst3(read_data, 5);
+  EXPECT_MEM_EQ(src3, dst3);
+
+  // The last line has no delimiter.
+  ASSERT_EQ(size_t(6), f->read_until_unlocked(read_data, READ_SIZE, '\n'));
+  MemoryView src4("last_1", 6), dst4(read_data, 6);
+  EXPECT_MEM_EQ(src4, dst4);
+  EXPECT_TRUE(f->iseof());
+  ASSERT_EQ(size_t(0), f->read_until_unlocked(read_data, READ_SIZE, '\n'));
+
+  ASSERT_EQ(f->close(), 0);
+}
+
+TEST(LlvmLibcFileTest, Fill) {
+  constexpr size_t FILE_BUFFER_SIZE = 8;
+  char file_buffer_fbf[FILE_BUFFER_SIZE];
+  char file_buffer_lbf[FILE_BUFFER_SIZE];
+  StringFile *f_fbf =
+      new_string_file(file_buffer_fbf, FILE_BUFFER_SIZE, _IOFBF, false, "w");
+  StringFile *f_lbf =
+      new_string_file(file_buffer_lbf, FILE_BUFFER_SIZE, _IOLBF, false, "w");
+
+  ASSERT_EQ(size_t(1), f_fbf->write("a", 1));
+  ASSERT_EQ(size_t(3), f_fbf->fill_unlocked('b', 3));
+  EXPECT_EQ(f_fbf->get_pos(), size_t(0)); // The bytes fit in the buffer.
+  ASSERT_EQ(size_t(100), f_fbf->fill_unlocked('c', 100));
+  ASSERT_EQ(f_fbf->flush(), 0);
+  ASSERT_EQ(f_fbf->get_pos(), size_t(104));
+  const char *str = f_fbf->get_str();
+  EXPECT_EQ(str[0], 'a');
+  for (size_t i = 1; i < 4; ++i)
+    EXPECT_EQ(str[i], 'b');
+  for (size_t i = 4; i < 104; ++i)
+    EXPECT_EQ(str[i], 'c');
+
+  // A newline flushes a line buffered file.
+  ASSERT_EQ(size_t(2), f_lbf->fill_unlocked('x', 2));
+  EXPECT_EQ(f_lbf->get_pos(), size_t(0));
+  ASSERT_EQ(size_t(1), f_lbf->fill_unlocked('\n', 1));
+  EXPECT_EQ(f_lbf->get_pos(), size_t(3));
+  MemoryView src1("xx\n", 3), dst1(f_lbf->get_str(), 3);
+  EXPECT_MEM_EQ(src1, dst1);
+
+  ASSERT_EQ(f_fbf->close(), 0);
+  ASSERT_EQ(f_lbf->close(), 0);
+}
@@ -344,3 +344,56 @@ TEST_F(LlvmLibcStrToFloatTest, EiselLemireFloat128Fallback) {
       &quadOutputMantissa, &outputExp2));
 }
 #endif
+
+TEST_F(LlvmLibcStrToFloatTest, EightDigitsAtATime) {
+  // The runs of eight digits and the digits parsed one by one must give the
+  // same result, wherever the runs start and end.
+  char *str_end;
+  EXPECT_EQ(__llvm_libc::internal::strtofloatingpoint<double>(
+                "1234567890123456789", &str_end),
+            1234567890123456789.0);
+  EXPECT_EQ(__llvm_libc::internal::strtofloatingpoint<double>(
+                "12345678.87654321", &str_end),
+            12345678.87654321);
+  EXPECT_EQ(__llvm_libc::internal::strtofloatingpoint<double>(
+                "0.000000001234567890123456789012345e-3", &str_end),
+            0.000000001234567890123456789012345e-3);
+  EXPECT_EQ(__llvm_libc::internal::strtofloatingpoint<float>(
+                "3.1415926535897932384626", &str_end),
+            3.1415926535897932384626f);
+  const char *digits_then_letter = "123456789abc";
+  EXPECT_EQ(__llvm_libc::internal::strtofloatingpoint<double>(
+                digits_then_letter, &str_end),
+            123456789.0);
+  EXPECT_EQ(str_end - digits_then_letter, 9);
+}
+
+TEST_F(LlvmLibcStrToFloatTest, List) {
+  double results[4] = {0, 0, 0, 0};
+  char *str_end;
+  const char *line = "1.5, -2e3 ,0x10,  7 ";
+  EXPECT_EQ(__llvm_libc::internal::strtofloatingpoint_list<double>(
+                line, ',', results, 4, &str_end),
+            size_t(4));
+  EXPECT_EQ(results[0], 1.5);
+  EXPECT_EQ(results[1], -2e3);
+  EXPECT_EQ(results[2], 16.0);
+  EXPECT_EQ(results[3], 7.0);
+  EXPECT_EQ(str_end - line, 19);
+
+  // Stops at the count, a missing separator and an invalid number.
+  EXPECT_EQ(__llvm_libc::internal::strtofloatingpoint_list<double>(
+                line, ',', results, 2, &str_end),
+            size_t(2));
+  EXPECT_EQ(str_end - line, 9);
+  const char *missing_separator = "1;2";
+  EXPECT_EQ(__llvm_libc::internal::strtofloatingpoint_list<double>(
+                missing_separator, ',', results, 4, &str_end),
+            size_t(1));
+  EXPECT_EQ(str_end - missing_separator, 1);
+  const char *invalid = "1,,2";
+  EXPECT_EQ(__llvm_libc::internal::strtofloatingpoint_list<double>(
+                invalid, ',', results, 4, &str_end),
+            size_t(1));
+  EXPECT_EQ(str_end - invalid, 1);
+}
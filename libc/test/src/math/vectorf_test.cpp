@@ -0,0 +1,55 @@
+//===-- Unittests for the vector variants of the math functions -----------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/__support/FPUtil/FPBits.h"
+#include "src/math/cosf.h"
+#include "src/math/expf.h"
+#include "src/math/logf.h"
+#include "src/math/sinf.h"
+#include "src/math/vectorf.h"
+#include "utils/UnitTest/Test.h"
+
+#include <stdint.h>
+
+using FPBits = __llvm_libc::fputil::FPBits<float>;
+using __llvm_libc::Float4;
+
+// The vector variants must return the same bits as the scalar functions, in
+// all the lanes, special values included.
+template <typename VectorFunc, typename ScalarFunc>
+static void check_against_scalar(VectorFunc vector_func,
+                                 ScalarFunc scalar_func) {
+  constexpr uint32_t COUNT = 1000000;
+  constexpr uint32_t STEP = UINT32_MAX / COUNT;
+  uint32_t v = 0;
+  for (uint32_t i = 0; i <= COUNT; i += 4) {
+    Float4 x;
+    for (int lane = 0; lane < 4; ++lane, v += STEP)
+      x[lane] = float(FPBits(v));
+    Float4 result = vector_func(x);
+    for (int lane = 0; lane < 4; ++lane)
+      ASSERT_EQ(FPBits(result[lane]).uintval(),
+                FPBits(scalar_func(x[lane])).uintval());
+  }
+}
+
+TEST(LlvmLibcVectorfTest, Expf) {
+  check_against_scalar(__llvm_libc::_ZGVbN4v_expf, __llvm_libc::expf);
+}
+
+TEST(LlvmLibcVectorfTest, Logf) {
+  check_against_scalar(__llvm_libc::_ZGVbN4v_logf, __llvm_libc::logf);
+}
+
+TEST(LlvmLibcVectorfTest, Sinf) {
+  check_against_scalar(__llvm_libc::_ZGVbN4v_sinf, __llvm_libc::sinf);
+}
+
+TEST(LlvmLibcVectorfTest, Cosf) {
+  check_against_scalar(__llvm_libc::_ZGVbN4v_cosf, __llvm_libc::cosf);
+}
@@ -0,0 +1,120 @@
+//===-- Unittests for malloc, calloc, realloc, aligned_alloc and free -----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/__support/allocator/size_class_map.h"
+#include "src/stdlib/aligned_alloc.h"
+#include "src/stdlib/calloc.h"
+#include "src/stdlib/free.h"
+#include "src/stdlib/malloc.h"
+#include "src/stdlib/realloc.h"
+
+#include "utils/UnitTest/Test.h"
+
+#include <errno.h>
+#include <stdint.h>
+
+using __llvm_libc::allocator::SizeClassMap;
+
+// Sizes around the boundaries of the size classes and of the large blocks.
+static constexpr size_t SIZES[] = {
+    0,     1,     15,    16,     17,       255, 256, 257, 1000, 4096,
+    32767, 32768, 32769, 100000, 1 << 21};
+
+static void fill(void *ptr, size_t size, unsigned char value) {
+  unsigned char *bytes = static_cast<unsigned char *>(ptr);
+  for (size_t i = 0; i < size; ++i)
+    bytes[i] = value;
+}
+
+static bool is_filled(const void *ptr, size_t size, unsigned char value) {
+  const unsigned char *bytes = static_cast<const unsigned char *>(ptr);
+  for (size_t i = 0; i < size; ++i)
+    if (bytes[i] != value)
+      return false;
+  return true;
+}
+
+TEST(LlvmLibcMallocTest, SizeClasses) {
+  for (size_t size = 0; size <= SizeClassMap::MAX_SIZE; ++size) {
+    const size_t class_id = SizeClassMap::get_class_id(size);
+    ASSERT_GT(class_id, size_t(0));
+    ASSERT_LT(class_id, SizeClassMap::NUM_CLASSES);
+    ASSERT_GE(SizeClassMap::get_size(class_id), size);
+    if (class_id > 1)
+      ASSERT_LT(SizeClassMap::get_size(class_id - 1), size);
+  }
+  EXPECT_EQ(SizeClassMap::get_class_id(SizeClassMap::MAX_SIZE + 1), size_t(0));
+}
+
+TEST(LlvmLibcMallocTest, MallocAndFree) {
+  for (size_t size : SIZES) {
+    void *ptr = __llvm_libc::malloc(size);
+    ASSERT_TRUE(ptr != nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % 16, uintptr_t(0));
+    fill(ptr, size, 0xAB);
+    EXPECT_TRUE(is_filled(ptr, size, 0xAB));
+    __llvm_libc::free(ptr);
+  }
+  __llvm_libc::free(nullptr);
+}
+
+TEST(LlvmLibcMallocTest, BlocksAreReused) {
+  void *ptr = __llvm_libc::malloc(100);
+  __llvm_libc::free(ptr);
+  void *other = __llvm_libc::malloc(100);
+  EXPECT_EQ(ptr, other);
+  __llvm_libc::free(other);
+}
+
+TEST(LlvmLibcMallocTest, Calloc) {
+  for (size_t size : SIZES) {
+    // Dirty a block of the same class first, so that calloc reuses it.
+    void *dirty = __llvm_libc::malloc(size);
+    fill(dirty, size, 0xFF);
+    __llvm_libc::free(dirty);
+    void *ptr = __llvm_libc::calloc(1, size);
+    ASSERT_TRUE(ptr != nullptr);
+    EXPECT_TRUE(is_filled(ptr, size, 0));
+    __llvm_libc::free(ptr);
+  }
+  errno = 0;
+  EXPECT_TRUE(__llvm_libc::calloc(SIZE_MAX / 2, 3) == nullptr);
+  EXPECT_EQ(errno, ENOMEM);
+}
+
+TEST(LlvmLibcMallocTest, Realloc) {
+  void *ptr = __llvm_libc::realloc(nullptr, 10);
+  ASSERT_TRUE(ptr != nullptr);
+  fill(ptr, 10, 0x12);
+  for (size_t size : SIZES) {
+    if (size < 10)
+      continue;
+    ptr = __llvm_libc::realloc(ptr, size);
+    ASSERT_TRUE(ptr != nullptr);
+    ASSERT_TRUE(is_filled(ptr, 10, 0x12));
+  }
+  ptr = __llvm_libc::realloc(ptr, 10);
+  ASSERT_TRUE(ptr != nullptr);
+  EXPECT_TRUE(is_filled(ptr, 10, 0x12));
+  EXPECT_TRUE(__llvm_libc::realloc(ptr, 0) == nullptr);
+}
+
+TEST(LlvmLibcMallocTest, AlignedAlloc) {
+  for (size_t alignment = 1; alignment <= (size_t(1) << 20); alignment <<= 1) {
+    for (size_t size : SIZES) {
+      void *ptr = __llvm_libc::aligned_alloc(alignment, size);
+      ASSERT_TRUE(ptr != nullptr);
+      EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % alignment, uintptr_t(0));
+      fill(ptr, size, 0x34);
+      __llvm_libc::free(ptr);
+    }
+  }
+  errno = 0;
+  EXPECT_TRUE(__llvm_libc::aligned_alloc(3, 16) == nullptr);
+  EXPECT_EQ(errno, EINVAL);
+}
@@ -135,6 +135,22 @@ static void BM_FindRehash(benchmark::State& st, Container c, GenInputs gen) {
     }
 }
 
+template <class Container, class GenInputs>
+static void BM_FindMiss(benchmark::State& st, Container c, GenInputs gen) {
+    auto in = gen(2 * st.range(0));
+    // Look up every other input, which isn't in the container.
+    for (std::size_t i = 0; i < in.size(); i += 2)
+        c.insert(in[i]);
+    benchmark::DoNotOptimize(&(*c.begin()));
+    const auto end = in.data() + in.size();
+    while (st.KeepRunning()) {
+        for (auto it = in.data() + 1; it < end; it += 2) {
+            benchmark::DoNotOptimize(c.find(*it) == c.end());
+        }
+        benchmark::ClobberMemory();
+    }
+}
+
 template <class Container, class GenInputs>
 static void BM_Rehash(benchmark::State& st, Container c, GenInputs gen) {
     auto in = gen(st.range(0));
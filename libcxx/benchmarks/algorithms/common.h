@@ -10,6 +10,7 @@
 #define LIBCXX_ALGORITHMS_COMMON_H
 
 #include <algorithm>
+#include <execution>
 #include <numeric>
 #include <tuple>
 #include <vector>
@@ -241,4 +242,30 @@ const std::vector<size_t> Quantities = {1 << 0, 1 << 2,  1 << 4,  1 << 6,
 #endif
 };
 
+// The parallel algorithms only pay off on large inputs, these show how they
+// scale with the size of the input.
+const std::vector<size_t> ParallelQuantities = {1 << 10, 1 << 14, 1 << 16,
+    // Running each benchmark in parallel consumes too much memory with MSAN
+    // and can lead to the test process being killed.
+#if !TEST_HAS_FEATURE(memory_sanitizer)
+                                                1 << 18, 1 << 20
+#endif
+};
+
+enum class Policy { Seq, Par, ParUnseq };
+struct AllPolicies : EnumValuesAsTuple<AllPolicies, Policy, 3> {
+  static constexpr const char* Names[] = {"Seq", "Par", "ParUnseq"};
+};
+
+// Calls `F` with the execution policy `P`.
+template <class P, class F>
+auto runWithPolicy(F Body) {
+  if constexpr (P() == Policy::Seq)
+    return Body(std::execution::seq);
+  else if constexpr (P() == Policy::Par)
+    return Body(std::execution::par);
+  else
+    return Body(std::execution::par_unseq);
+}
+
 #endif // LIBCXX_ALGORITHMS_COMMON_H
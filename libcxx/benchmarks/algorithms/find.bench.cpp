@@ -0,0 +1,156 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// Benchmarks of the algorithms that compare the elements of ranges of arithmetic types, which are vectorized.
+
+#include <algorithm>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include "common.h"
+
+namespace {
+enum class ElementType { Uint8, Uint16, Int32, Int64, Float, Double };
+struct AllElementTypes : EnumValuesAsTuple<AllElementTypes, ElementType, 6> {
+  static constexpr const char* Names[] = {"uint8", "uint16", "int32", "int64", "float", "double"};
+};
+
+using ElementTypes = std::tuple<uint8_t, uint16_t, int32_t, int64_t, float, double>;
+
+template <class E>
+using Element = std::tuple_element_t<(int)E::value, ElementTypes>;
+
+// All the benchmarks look at every element: the range is all zeros, but for its last element.
+template <class T>
+std::vector<T> makeInput(size_t Quantity) {
+  std::vector<T> V(Quantity, T(0));
+  V.back() = T(1);
+  return V;
+}
+
+template <class ElemType>
+struct Find {
+  size_t Quantity;
+
+  void run(benchmark::State& state) const {
+    using T = Element<ElemType>;
+    std::vector<T> V = makeInput<T>(Quantity);
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(V);
+      benchmark::DoNotOptimize(std::find(V.begin(), V.end(), T(1)));
+    }
+    state.SetItemsProcessed(state.iterations() * Quantity);
+  }
+
+  std::string name() const { return "BM_Find" + ElemType::name() + "_" + std::to_string(Quantity); }
+};
+
+template <class ElemType>
+struct Count {
+  size_t Quantity;
+
+  void run(benchmark::State& state) const {
+    using T = Element<ElemType>;
+    std::vector<T> V = makeInput<T>(Quantity);
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(V);
+      benchmark::DoNotOptimize(std::count(V.begin(), V.end(), T(0)));
+    }
+    state.SetItemsProcessed(state.iterations() * Quantity);
+  }
+
+  std::string name() const { return "BM_Count" + ElemType::name() + "_" + std::to_string(Quantity); }
+};
+
+template <class ElemType>
+struct Mismatch {
+  size_t Quantity;
+
+  void run(benchmark::State& state) const {
+    using T = Element<ElemType>;
+    std::vector<T> V1 = makeInput<T>(Quantity);
+    std::vector<T> V2(Quantity, T(0));
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(V1);
+      benchmark::DoNotOptimize(V2);
+      benchmark::DoNotOptimize(std::mismatch(V1.begin(), V1.end(), V2.begin()));
+    }
+    state.SetItemsProcessed(state.iterations() * Quantity);
+  }
+
+  std::string name() const { return "BM_Mismatch" + ElemType::name() + "_" + std::to_string(Quantity); }
+};
+
+template <class ElemType>
+struct Equal {
+  size_t Quantity;
+
+  void run(benchmark::State& state) const {
+    using T = Element<ElemType>;
+    std::vector<T> V1 = makeInput<T>(Quantity);
+    std::vector<T> V2 = V1;
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(V1);
+      benchmark::DoNotOptimize(V2);
+      benchmark::DoNotOptimize(std::equal(V1.begin(), V1.end(), V2.begin()));
+    }
+    state.SetItemsProcessed(state.iterations() * Quantity);
+  }
+
+  std::string name() const { return "BM_Equal" + ElemType::name() + "_" + std::to_string(Quantity); }
+};
+
+template <class ElemType>
+struct MinElement {
+  size_t Quantity;
+
+  void run(benchmark::State& state) const {
+    using T = Element<ElemType>;
+    std::vector<T> V(Quantity, T(1));
+    V.back() = T(0);
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(V);
+      benchmark::DoNotOptimize(std::min_element(V.begin(), V.end()));
+    }
+    state.SetItemsProcessed(state.iterations() * Quantity);
+  }
+
+  std::string name() const { return "BM_MinElement" + ElemType::name() + "_" + std::to_string(Quantity); }
+};
+
+template <class ElemType>
+struct MaxElement {
+  size_t Quantity;
+
+  void run(benchmark::State& state) const {
+    using T = Element<ElemType>;
+    std::vector<T> V = makeInput<T>(Quantity);
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(V);
+      benchmark::DoNotOptimize(std::max_element(V.begin(), V.end()));
+    }
+    state.SetItemsProcessed(state.iterations() * Quantity);
+  }
+
+  std::string name() const { return "BM_MaxElement" + ElemType::name() + "_" + std::to_string(Quantity); }
+};
+} // namespace
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+  makeCartesianProductBenchmark<Find, AllElementTypes>(Quantities);
+  makeCartesianProductBenchmark<Count, AllElementTypes>(Quantities);
+  makeCartesianProductBenchmark<Mismatch, AllElementTypes>(Quantities);
+  makeCartesianProductBenchmark<Equal, AllElementTypes>(Quantities);
+  makeCartesianProductBenchmark<MinElement, AllElementTypes>(Quantities);
+  makeCartesianProductBenchmark<MaxElement, AllElementTypes>(Quantities);
+  benchmark::RunSpecifiedBenchmarks();
+}
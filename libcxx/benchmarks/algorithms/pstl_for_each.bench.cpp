@@ -0,0 +1,79 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <cmath>
+#include <execution>
+#include <vector>
+
+#include "common.h"
+
+namespace {
+template <class Policy>
+struct ForEach {
+  size_t Quantity;
+
+  void run(benchmark::State& state) const {
+    std::vector<double> V(Quantity, 1.0);
+    for ([[maybe_unused]] auto _ : state) {
+      runWithPolicy<Policy>([&](const auto& P) {
+        std::for_each(P, V.begin(), V.end(), [](double& X) { X = std::sqrt(X); });
+      });
+      benchmark::DoNotOptimize(V);
+    }
+    state.SetItemsProcessed(state.iterations() * Quantity);
+  }
+
+  std::string name() const { return "BM_PstlForEach" + Policy::name() + "_" + std::to_string(Quantity); };
+};
+
+template <class Policy>
+struct Transform {
+  size_t Quantity;
+
+  void run(benchmark::State& state) const {
+    std::vector<double> In1(Quantity, 1.0), In2(Quantity, 2.0), Out(Quantity);
+    for ([[maybe_unused]] auto _ : state) {
+      runWithPolicy<Policy>([&](const auto& P) {
+        std::transform(
+            P, In1.begin(), In1.end(), In2.begin(), Out.begin(), [](double X, double Y) { return X * Y + 1; });
+      });
+      benchmark::DoNotOptimize(Out);
+    }
+    state.SetItemsProcessed(state.iterations() * Quantity);
+  }
+
+  std::string name() const { return "BM_PstlTransform" + Policy::name() + "_" + std::to_string(Quantity); };
+};
+
+template <class Policy>
+struct Fill {
+  size_t Quantity;
+
+  void run(benchmark::State& state) const {
+    std::vector<uint64_t> V(Quantity);
+    for ([[maybe_unused]] auto _ : state) {
+      runWithPolicy<Policy>([&](const auto& P) { std::fill(P, V.begin(), V.end(), uint64_t(42)); });
+      benchmark::DoNotOptimize(V);
+    }
+    state.SetItemsProcessed(state.iterations() * Quantity);
+  }
+
+  std::string name() const { return "BM_PstlFill" + Policy::name() + "_" + std::to_string(Quantity); };
+};
+} // namespace
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+  makeCartesianProductBenchmark<ForEach, AllPolicies>(ParallelQuantities);
+  makeCartesianProductBenchmark<Transform, AllPolicies>(ParallelQuantities);
+  makeCartesianProductBenchmark<Fill, AllPolicies>(ParallelQuantities);
+  benchmark::RunSpecifiedBenchmarks();
+}
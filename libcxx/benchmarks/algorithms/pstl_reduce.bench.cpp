@@ -0,0 +1,74 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <execution>
+#include <numeric>
+#include <vector>
+
+#include "common.h"
+
+namespace {
+template <class Policy>
+struct Reduce {
+  size_t Quantity;
+
+  void run(benchmark::State& state) const {
+    std::vector<double> V(Quantity, 1.0);
+    for ([[maybe_unused]] auto _ : state) {
+      double Sum = runWithPolicy<Policy>([&](const auto& P) { return std::reduce(P, V.begin(), V.end()); });
+      benchmark::DoNotOptimize(Sum);
+    }
+    state.SetItemsProcessed(state.iterations() * Quantity);
+  }
+
+  std::string name() const { return "BM_PstlReduce" + Policy::name() + "_" + std::to_string(Quantity); };
+};
+
+template <class Policy>
+struct TransformReduce {
+  size_t Quantity;
+
+  void run(benchmark::State& state) const {
+    std::vector<double> V1(Quantity, 1.0), V2(Quantity, 2.0);
+    for ([[maybe_unused]] auto _ : state) {
+      double Dot = runWithPolicy<Policy>(
+          [&](const auto& P) { return std::transform_reduce(P, V1.begin(), V1.end(), V2.begin(), 0.0); });
+      benchmark::DoNotOptimize(Dot);
+    }
+    state.SetItemsProcessed(state.iterations() * Quantity);
+  }
+
+  std::string name() const { return "BM_PstlTransformReduce" + Policy::name() + "_" + std::to_string(Quantity); };
+};
+
+template <class Policy>
+struct InclusiveScan {
+  size_t Quantity;
+
+  void run(benchmark::State& state) const {
+    std::vector<uint64_t> In(Quantity, 1), Out(Quantity);
+    for ([[maybe_unused]] auto _ : state) {
+      runWithPolicy<Policy>([&](const auto& P) { std::inclusive_scan(P, In.begin(), In.end(), Out.begin()); });
+      benchmark::DoNotOptimize(Out);
+    }
+    state.SetItemsProcessed(state.iterations() * Quantity);
+  }
+
+  std::string name() const { return "BM_PstlInclusiveScan" + Policy::name() + "_" + std::to_string(Quantity); };
+};
+} // namespace
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+  makeCartesianProductBenchmark<Reduce, AllPolicies>(ParallelQuantities);
+  makeCartesianProductBenchmark<TransformReduce, AllPolicies>(ParallelQuantities);
+  makeCartesianProductBenchmark<InclusiveScan, AllPolicies>(ParallelQuantities);
+  benchmark::RunSpecifiedBenchmarks();
+}
@@ -0,0 +1,58 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <execution>
+
+#include "common.h"
+
+namespace {
+template <class ValueType, class Order, class Policy>
+struct Sort {
+  size_t Quantity;
+
+  void run(benchmark::State& state) const {
+    runOpOnCopies<ValueType>(state, Quantity, Order(), BatchSize::CountElements, [](auto& Copy) {
+      runWithPolicy<Policy>([&](const auto& P) { std::sort(P, Copy.begin(), Copy.end()); });
+    });
+  }
+
+  // The order of the input matters little to the parallel part.
+  bool skip() const { return Order() != ::Order::Random && Order() != ::Order::Ascending; }
+
+  std::string name() const {
+    return "BM_PstlSort" + ValueType::name() + Order::name() + Policy::name() + "_" + std::to_string(Quantity);
+  };
+};
+
+template <class ValueType, class Order, class Policy>
+struct StableSort {
+  size_t Quantity;
+
+  void run(benchmark::State& state) const {
+    runOpOnCopies<ValueType>(state, Quantity, Order(), BatchSize::CountElements, [](auto& Copy) {
+      runWithPolicy<Policy>([&](const auto& P) { std::stable_sort(P, Copy.begin(), Copy.end()); });
+    });
+  }
+
+  bool skip() const { return Order() != ::Order::Random && Order() != ::Order::Ascending; }
+
+  std::string name() const {
+    return "BM_PstlStableSort" + ValueType::name() + Order::name() + Policy::name() + "_" + std::to_string(Quantity);
+  };
+};
+} // namespace
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+  makeCartesianProductBenchmark<Sort, AllValueTypes, AllOrders, AllPolicies>(ParallelQuantities);
+  makeCartesianProductBenchmark<StableSort, AllValueTypes, AllOrders, AllPolicies>(ParallelQuantities);
+  benchmark::RunSpecifiedBenchmarks();
+}
@@ -9,6 +9,7 @@
 #include "benchmark/benchmark.h"
 
 #include <new>
+#include <memory_resource>
 #include <vector>
 #include <cassert>
 
@@ -60,6 +61,28 @@ struct BuiltinSizedNewWrapper {
   }
 };
 
+struct NewDeleteResourceWrapper {
+  static void* Allocate(size_t N) {
+    return std::pmr::new_delete_resource()->allocate(N);
+  }
+  static void Deallocate(void* P, size_t N) {
+    std::pmr::new_delete_resource()->deallocate(P, N);
+  }
+};
+
+// A single resource shared by all the threads of the benchmark.
+struct SynchronizedPoolWrapper {
+  static std::pmr::memory_resource* Resource() {
+    static std::pmr::synchronized_pool_resource Res;
+    return &Res;
+  }
+  static void* Allocate(size_t N) {
+    return Resource()->allocate(N);
+  }
+  static void Deallocate(void* P, size_t N) {
+    Resource()->deallocate(P, N);
+  }
+};
 
 template <class AllocWrapper>
 static void BM_AllocateAndDeallocate(benchmark::State& st) {
@@ -111,6 +134,22 @@ static void BM_DeallocateOnly(benchmark::State& st) {
   assert(Data == End);
 }
 
+// Allocates a batch of blocks and frees them, like the nodes of a short-lived container.
+template <class AllocWrapper>
+static void BM_AllocateAndDeallocateBatch(benchmark::State& st) {
+  const size_t alloc_size = st.range(0);
+  constexpr size_t BatchSize = 64;
+  void* Pointers[BatchSize];
+  while (st.KeepRunningBatch(BatchSize)) {
+    for (auto& p : Pointers) {
+      p = AllocWrapper::Allocate(alloc_size);
+      benchmark::DoNotOptimize(p);
+    }
+    for (auto p : Pointers)
+      AllocWrapper::Deallocate(p, alloc_size);
+  }
+}
+
 static int RegisterAllocBenchmarks() {
   using FnType = void(*)(benchmark::State&);
   struct {
@@ -128,6 +167,20 @@ static int RegisterAllocBenchmarks() {
   for (auto TC : TestCases) {
     benchmark::RegisterBenchmark(TC.name, TC.func)->Range(16, 4096 * 2);
   }
+
+  // Memory resources used by a growing number of threads.
+  struct {
+    const char* name;
+    FnType func;
+  } ThreadedTestCases[] = {
+      {"BM_NewDeleteResource", &BM_AllocateAndDeallocate<NewDeleteResourceWrapper>},
+      {"BM_SynchronizedPool", &BM_AllocateAndDeallocate<SynchronizedPoolWrapper>},
+      {"BM_NewDeleteResourceBatch", &BM_AllocateAndDeallocateBatch<NewDeleteResourceWrapper>},
+      {"BM_SynchronizedPoolBatch", &BM_AllocateAndDeallocateBatch<SynchronizedPoolWrapper>},
+  };
+  for (auto TC : ThreadedTestCases) {
+    benchmark::RegisterBenchmark(TC.name, TC.func)->Arg(16)->Arg(256)->Arg(4096)->ThreadRange(1, 16)->UseRealTime();
+  }
   return 0;
 }
 int Sink = RegisterAllocBenchmarks();
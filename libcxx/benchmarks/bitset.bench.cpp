@@ -0,0 +1,79 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <bitset>
+#include <cstddef>
+#include <random>
+
+#include "benchmark/benchmark.h"
+
+// Large bitsets, like the ones used by bloom filters and bitmap indices.
+constexpr std::size_t BitsetSize = 1 << 18;
+
+static std::bitset<BitsetSize> makeRandomBitset(unsigned seed) {
+  std::bitset<BitsetSize> b;
+  std::mt19937 gen(seed);
+  for (std::size_t i = 0; i != BitsetSize; ++i)
+    b[i] = gen() & 1;
+  return b;
+}
+
+static void BM_BitsetAnd(benchmark::State& state) {
+  static std::bitset<BitsetSize> a = makeRandomBitset(1);
+  static const std::bitset<BitsetSize> b = makeRandomBitset(2);
+  for (auto _ : state) {
+    a &= b;
+    benchmark::DoNotOptimize(a);
+  }
+  state.SetBytesProcessed(state.iterations() * (BitsetSize / 8));
+}
+BENCHMARK(BM_BitsetAnd);
+
+static void BM_BitsetXor(benchmark::State& state) {
+  static std::bitset<BitsetSize> a = makeRandomBitset(1);
+  static const std::bitset<BitsetSize> b = makeRandomBitset(2);
+  for (auto _ : state) {
+    a ^= b;
+    benchmark::DoNotOptimize(a);
+  }
+  state.SetBytesProcessed(state.iterations() * (BitsetSize / 8));
+}
+BENCHMARK(BM_BitsetXor);
+
+static void BM_BitsetCount(benchmark::State& state) {
+  static const std::bitset<BitsetSize> a = makeRandomBitset(1);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(a.count());
+  state.SetBytesProcessed(state.iterations() * (BitsetSize / 8));
+}
+BENCHMARK(BM_BitsetCount);
+
+// The shift amount is state.range(0). Multiples of the word size move whole words.
+static void BM_BitsetShiftLeft(benchmark::State& state) {
+  static std::bitset<BitsetSize> a = makeRandomBitset(1);
+  const std::size_t shift = state.range(0);
+  for (auto _ : state) {
+    a <<= shift;
+    benchmark::DoNotOptimize(a);
+  }
+  state.SetBytesProcessed(state.iterations() * (BitsetSize / 8));
+}
+BENCHMARK(BM_BitsetShiftLeft)->Arg(1)->Arg(13)->Arg(64);
+
+static void BM_BitsetShiftRight(benchmark::State& state) {
+  static std::bitset<BitsetSize> a = makeRandomBitset(1);
+  const std::size_t shift = state.range(0);
+  for (auto _ : state) {
+    a >>= shift;
+    benchmark::DoNotOptimize(a);
+  }
+  state.SetBytesProcessed(state.iterations() * (BitsetSize / 8));
+}
+BENCHMARK(BM_BitsetShiftRight)->Arg(1)->Arg(13)->Arg(64);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,41 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <stdexcept>
+
+#include "benchmark/benchmark.h"
+
+namespace {
+
+// Throw from Depth frames below the catch, so that every throw unwinds and
+// looks up the unwind info of Depth + 1 frames.
+[[gnu::noinline]] int throw_at_depth(int depth) {
+  if (depth == 0)
+    throw std::runtime_error("benchmark");
+  int result = throw_at_depth(depth - 1);
+  benchmark::DoNotOptimize(result);
+  return result + 1;
+}
+
+// Run with several threads to measure how well the unwinder's lookup of the
+// unwind sections of a PC scales when many threads throw at once.
+void BM_ThrowCatch(benchmark::State& state) {
+  int depth = state.range(0);
+  for (auto _ : state) {
+    try {
+      benchmark::DoNotOptimize(throw_at_depth(depth));
+    } catch (const std::runtime_error& e) {
+      benchmark::DoNotOptimize(e.what());
+    }
+  }
+}
+BENCHMARK(BM_ThrowCatch)->Arg(1)->Arg(16)->ThreadRange(1, 64)->UseRealTime();
+
+} // namespace
+
+BENCHMARK_MAIN();
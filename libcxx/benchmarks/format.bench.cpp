@@ -7,7 +7,9 @@
 
 #include <format>
 
+#include <concepts>
 #include <string>
+#include <string_view>
 
 #include "benchmark/benchmark.h"
 #include "make_string.h"
@@ -27,6 +29,39 @@ static void BM_format_string(benchmark::State& state) {
 BENCHMARK_TEMPLATE(BM_format_string, char)->RangeMultiplier(2)->Range(1, 1 << 20);
 BENCHMARK_TEMPLATE(BM_format_string, wchar_t)->RangeMultiplier(2)->Range(1, 1 << 20);
 
+/*** Log line ***/
+
+// A typical log line, formatted with the replacement fields recorded during
+// the validation of the format string.
+template <class CharT>
+static void BM_format_log_line(benchmark::State& state) {
+  std::basic_string<CharT> file = CSTR("main.cpp");
+  for (auto _ : state)
+    benchmark::DoNotOptimize(
+        std::format(CSTR("[{}] {}:{}: request {} took {} us"), 3, file, 42, 123456789, 1234));
+}
+BENCHMARK_TEMPLATE(BM_format_log_line, char);
+BENCHMARK_TEMPLATE(BM_format_log_line, wchar_t);
+
+// The same log line with a format string that is parsed at run time.
+template <class CharT>
+static void BM_vformat_log_line(benchmark::State& state) {
+  std::basic_string<CharT> file = CSTR("main.cpp");
+  std::basic_string_view<CharT> fmt = CSTR("[{}] {}:{}: request {} took {} us");
+  int level = 3;
+  int line = 42;
+  int id = 123456789;
+  int duration = 1234;
+  for (auto _ : state) {
+    if constexpr (std::same_as<CharT, char>)
+      benchmark::DoNotOptimize(std::vformat(fmt, std::make_format_args(level, file, line, id, duration)));
+    else
+      benchmark::DoNotOptimize(std::vformat(fmt, std::make_wformat_args(level, file, line, id, duration)));
+  }
+}
+BENCHMARK_TEMPLATE(BM_vformat_log_line, char);
+BENCHMARK_TEMPLATE(BM_vformat_log_line, wchar_t);
+
 int main(int argc, char** argv) {
   benchmark::Initialize(&argc, argv);
   if (benchmark::ReportUnrecognizedArguments(argc, argv))
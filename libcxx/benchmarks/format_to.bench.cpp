@@ -10,9 +10,11 @@
 #include <iterator>
 #include <algorithm>
 #include <array>
+#include <concepts>
 #include <list>
 #include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "benchmark/benchmark.h"
@@ -78,6 +80,39 @@ static void BM_format_to_string_pointer(benchmark::State& state) {
   state.SetBytesProcessed(state.iterations() * size * sizeof(CharT));
 }
 
+/*** Log line ***/
+
+// Formats a typical log line with the replacement fields recorded during the
+// validation of the format string, and with the same format string parsed at
+// run time.
+template <class CharT>
+static void BM_format_to_log_line(benchmark::State& state) {
+  auto file = std::basic_string<CharT>(CSTR("main.cpp"));
+  auto buffer = std::basic_string<CharT>(128, CharT('-'));
+  CharT* output = buffer.data();
+  for (auto _ : state)
+    benchmark::DoNotOptimize(
+        std::format_to(output, CSTR("[{}] {}:{}: request {} took {} us"), 3, file, 42, 123456789, 1234));
+}
+
+template <class CharT>
+static void BM_vformat_to_log_line(benchmark::State& state) {
+  auto file = std::basic_string<CharT>(CSTR("main.cpp"));
+  auto buffer = std::basic_string<CharT>(128, CharT('-'));
+  CharT* output = buffer.data();
+  std::basic_string_view<CharT> fmt = CSTR("[{}] {}:{}: request {} took {} us");
+  int level = 3;
+  int line = 42;
+  int id = 123456789;
+  int duration = 1234;
+  for (auto _ : state) {
+    if constexpr (std::same_as<CharT, char>)
+      benchmark::DoNotOptimize(std::vformat_to(output, fmt, std::make_format_args(level, file, line, id, duration)));
+    else
+      benchmark::DoNotOptimize(std::vformat_to(output, fmt, std::make_wformat_args(level, file, line, id, duration)));
+  }
+}
+
 /*** Main ***/
 
 BENCHMARK_TEMPLATE(BM_format_to_string_back_inserter, std::string)->RangeMultiplier(2)->Range(1, 1 << 20);
@@ -98,6 +133,11 @@ BENCHMARK_TEMPLATE(BM_format_to_string_begin, std::list<wchar_t>)->RangeMultipli
 BENCHMARK_TEMPLATE(BM_format_to_string_span, wchar_t)->RangeMultiplier(2)->Range(1, 1 << 20);
 BENCHMARK_TEMPLATE(BM_format_to_string_pointer, wchar_t)->RangeMultiplier(2)->Range(1, 1 << 20);
 
+BENCHMARK_TEMPLATE(BM_format_to_log_line, char);
+BENCHMARK_TEMPLATE(BM_vformat_to_log_line, char);
+BENCHMARK_TEMPLATE(BM_format_to_log_line, wchar_t);
+BENCHMARK_TEMPLATE(BM_vformat_to_log_line, wchar_t);
+
 int main(int argc, char** argv) {
   benchmark::Initialize(&argc, argv);
   if (benchmark::ReportUnrecognizedArguments(argc, argv))
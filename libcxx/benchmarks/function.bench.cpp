@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <string>
@@ -102,6 +103,32 @@ inline Function MakeFunction(FunctionType type, bool opaque = false) {
   }
 }
 
+#if TEST_STD_VER > 20
+using MoveOnlyFunction = std::move_only_function<int(const S*) const>;
+
+TEST_ALWAYS_INLINE
+inline MoveOnlyFunction MakeMoveOnlyFunction(FunctionType type) {
+  switch (type) {
+    case FunctionType::Null:
+      return nullptr;
+    case FunctionType::FunctionPointer:
+      return FunctionWithS;
+    case FunctionType::MemberFunctionPointer:
+      return &S::function;
+    case FunctionType::MemberPointer:
+      return &S::field;
+    case FunctionType::SmallTrivialFunctor:
+      return SmallTrivialFunctor{};
+    case FunctionType::SmallNonTrivialFunctor:
+      return SmallNonTrivialFunctor{};
+    case FunctionType::LargeTrivialFunctor:
+      return LargeTrivialFunctor{};
+    case FunctionType::LargeNonTrivialFunctor:
+      return LargeNonTrivialFunctor{};
+  }
+}
+#endif
+
 template <class Opacity, class FunctionType>
 struct ConstructAndDestroy {
   static void run(benchmark::State& state) {
@@ -212,6 +239,70 @@ struct InvokeInlined {
   }
 };
 
+#if TEST_STD_VER > 20
+template <class FunctionType>
+struct MoveOnlyConstructAndDestroy {
+  static void run(benchmark::State& state) {
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(MakeMoveOnlyFunction(FunctionType()));
+    }
+  }
+
+  static std::string name() { return "BM_MoveOnlyConstructAndDestroy" + FunctionType::name(); }
+};
+
+template <class FunctionType>
+struct MoveOnlyMove {
+  static void run(benchmark::State& state) {
+    MoveOnlyFunction values[2] = {MakeMoveOnlyFunction(FunctionType())};
+    int i = 0;
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(values);
+      benchmark::DoNotOptimize(values[i ^ 1] = std::move(values[i]));
+      i ^= 1;
+    }
+  }
+
+  static std::string name() { return "BM_MoveOnlyMove" + FunctionType::name(); }
+};
+
+template <class FunctionType>
+struct MoveOnlyInvoke {
+  static void run(benchmark::State& state) {
+    S s;
+    const auto value = MakeMoveOnlyFunction(FunctionType());
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(value);
+      benchmark::DoNotOptimize(value(&s));
+    }
+  }
+
+  static bool skip() { return FunctionType() == ::FunctionType::Null; }
+
+  static std::string name() { return "BM_MoveOnlyInvoke" + FunctionType::name(); }
+};
+
+// Models a task queue: callables capturing a few pointers are pushed into a
+// deque, moved out of it and run.
+template <class Wrapper>
+void BM_TaskQueue(benchmark::State& state) {
+  S s;
+  int a = 0, b = 0, c = 0;
+  std::deque<Wrapper> queue;
+  for (auto _ : state) {
+    for (int i = 0; i != 64; ++i)
+      queue.emplace_back([&a, &b, &c, p = &s](const S*) { return a + b + c + p->field; });
+    while (!queue.empty()) {
+      Wrapper task = std::move(queue.front());
+      queue.pop_front();
+      benchmark::DoNotOptimize(task(&s));
+    }
+  }
+}
+BENCHMARK(BM_TaskQueue<Function>);
+BENCHMARK(BM_TaskQueue<MoveOnlyFunction>);
+#endif
+
 }  // namespace
 
 int main(int argc, char** argv) {
@@ -227,5 +318,10 @@ int main(int argc, char** argv) {
   makeCartesianProductBenchmark<OperatorBool, AllFunctionTypes>();
   makeCartesianProductBenchmark<Invoke, AllFunctionTypes>();
   makeCartesianProductBenchmark<InvokeInlined, AllFunctionTypes>();
+#if TEST_STD_VER > 20
+  makeCartesianProductBenchmark<MoveOnlyConstructAndDestroy, AllFunctionTypes>();
+  makeCartesianProductBenchmark<MoveOnlyMove, AllFunctionTypes>();
+  makeCartesianProductBenchmark<MoveOnlyInvoke, AllFunctionTypes>();
+#endif
   benchmark::RunSpecifiedBenchmarks();
 }
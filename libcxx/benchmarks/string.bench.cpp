@@ -1,6 +1,9 @@
 
 #include <cstdint>
+#include <cstring>
 #include <new>
+#include <ranges>
+#include <string>
 #include <vector>
 
 #include "CartesianBenchmarks.h"
@@ -57,6 +60,79 @@ static void BM_StringCtorDefault(benchmark::State &state) {
 }
 BENCHMARK(BM_StringCtorDefault);
 
+// Build a string of state.range(0) characters out of chunks of 64 characters,
+// the way serialization code builds its output.
+constexpr std::size_t BUILD_CHUNK_LEN = 64;
+
+static void BM_StringBuildAppend(benchmark::State &state) {
+  const std::string chunk(BUILD_CHUNK_LEN, 'x');
+  for (auto _ : state) {
+    std::string s;
+    for (std::size_t n = 0; n < static_cast<std::size_t>(state.range(0)); n += chunk.size())
+      s.append(chunk.data(), chunk.size());
+    benchmark::DoNotOptimize(s.data());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StringBuildAppend)->Range(BUILD_CHUNK_LEN, MAX_STRING_LEN);
+
+// The chunks are produced lazily, so only a forward range of characters is
+// available.
+static void BM_StringBuildAppendIterators(benchmark::State &state) {
+  const std::string chunk(BUILD_CHUNK_LEN, 'x');
+  auto chunk_view = chunk | std::views::transform([](char c) { return static_cast<char>(c + 1); });
+  for (auto _ : state) {
+    std::string s;
+    for (std::size_t n = 0; n < static_cast<std::size_t>(state.range(0)); n += chunk.size())
+      s.append(chunk_view.begin(), chunk_view.end());
+    benchmark::DoNotOptimize(s.data());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StringBuildAppendIterators)->Range(BUILD_CHUNK_LEN, MAX_STRING_LEN);
+
+#if TEST_STD_VER > 20
+static void BM_StringBuildAppendRange(benchmark::State &state) {
+  const std::string chunk(BUILD_CHUNK_LEN, 'x');
+  auto chunk_view = chunk | std::views::transform([](char c) { return static_cast<char>(c + 1); });
+  for (auto _ : state) {
+    std::string s;
+    for (std::size_t n = 0; n < static_cast<std::size_t>(state.range(0)); n += chunk.size())
+      s.append_range(chunk_view);
+    benchmark::DoNotOptimize(s.data());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StringBuildAppendRange)->Range(BUILD_CHUNK_LEN, MAX_STRING_LEN);
+#endif
+
+// Build the string in place when its final size is known up front.
+static void BM_StringBuildResize(benchmark::State &state) {
+  for (auto _ : state) {
+    std::string s;
+    s.resize(state.range(0));
+    std::memset(s.data(), 'x', s.size());
+    benchmark::DoNotOptimize(s.data());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StringBuildResize)->Range(BUILD_CHUNK_LEN, MAX_STRING_LEN);
+
+#if TEST_STD_VER > 20
+static void BM_StringBuildResizeAndOverwrite(benchmark::State &state) {
+  for (auto _ : state) {
+    std::string s;
+    s.resize_and_overwrite(state.range(0), [](char* p, std::size_t n) {
+      std::memset(p, 'x', n);
+      return n;
+    });
+    benchmark::DoNotOptimize(s.data());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StringBuildResizeAndOverwrite)->Range(BUILD_CHUNK_LEN, MAX_STRING_LEN);
+#endif
+
 enum class Length { Empty, Small, Large, Huge };
 struct AllLengths : EnumValuesAsTuple<AllLengths, Length, 4> {
   static constexpr const char* Names[] = {"Empty", "Small", "Large", "Huge"};
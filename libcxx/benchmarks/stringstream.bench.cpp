@@ -1,6 +1,7 @@
 #include "benchmark/benchmark.h"
 #include "test_macros.h"
 
+#include <locale>
 #include <sstream>
 
 TEST_NOINLINE double istream_numbers();
@@ -37,4 +38,33 @@ static void BM_Istream_numbers(benchmark::State &state) {
 }
 
 BENCHMARK(BM_Istream_numbers)->RangeMultiplier(2)->Range(1024, 4096);
+
+template <class T>
+static void BM_Ostream_number(benchmark::State& state, T value) {
+  std::ostringstream s;
+  for (auto _ : state) {
+    s.str("");
+    for (int i = 0; i != 100; ++i)
+      s << value;
+    benchmark::DoNotOptimize(s.str().data());
+  }
+}
+BENCHMARK_CAPTURE(BM_Ostream_number, int, 123456);
+BENCHMARK_CAPTURE(BM_Ostream_number, long_long, -1234567890123LL);
+BENCHMARK_CAPTURE(BM_Ostream_number, double, 3.14159265358979);
+
+// The same, but with a locale that isn't the classic one, which makes the
+// stream go through num_put.
+static void BM_Ostream_int_num_put(benchmark::State& state) {
+  std::ostringstream s;
+  s.imbue(std::locale(std::locale::classic(), new std::num_put<char>));
+  for (auto _ : state) {
+    s.str("");
+    for (int i = 0; i != 100; ++i)
+      s << 123456;
+    benchmark::DoNotOptimize(s.str().data());
+  }
+}
+BENCHMARK(BM_Ostream_int_num_put);
+
 BENCHMARK_MAIN();
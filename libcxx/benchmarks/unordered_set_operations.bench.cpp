@@ -287,6 +287,25 @@ BENCHMARK_CAPTURE(BM_FindRehash,
     std::unordered_set<std::string>{},
     getRandomStringInputs)->Arg(TestNumInputs);
 
+//----------------------------------------------------------------------------//
+//                         BM_FindMiss
+// ---------------------------------------------------------------------------//
+
+BENCHMARK_CAPTURE(BM_FindMiss,
+    unordered_set_random_uint64,
+    std::unordered_set<uint64_t>{},
+    getRandomIntegerInputs<uint64_t>)->Arg(TestNumInputs)->Arg(TestNumInputs * 1024);
+
+BENCHMARK_CAPTURE(BM_FindMiss,
+    unordered_set_sorted_uint32,
+    std::unordered_set<uint32_t>{},
+    getSortedIntegerInputs<uint32_t>)->Arg(TestNumInputs)->Arg(TestNumInputs * 1024);
+
+BENCHMARK_CAPTURE(BM_FindMiss,
+    unordered_set_string,
+    std::unordered_set<std::string>{},
+    getRandomStringInputs)->Arg(TestNumInputs);
+
 //----------------------------------------------------------------------------//
 //                         BM_Rehash
 // ---------------------------------------------------------------------------//
@@ -299,7 +318,7 @@ BENCHMARK_CAPTURE(BM_Rehash,
 BENCHMARK_CAPTURE(BM_Rehash,
     unordered_set_int_arg,
     std::unordered_set<int>{},
-    getRandomIntegerInputs<int>)->Arg(TestNumInputs);
+    getRandomIntegerInputs<int>)->Arg(TestNumInputs)->Arg(TestNumInputs * 1024);
 
 ///////////////////////////////////////////////////////////////////////////////
 BENCHMARK_CAPTURE(BM_InsertDuplicate,
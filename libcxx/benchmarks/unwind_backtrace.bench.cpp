@@ -0,0 +1,44 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <unwind.h>
+
+#include "benchmark/benchmark.h"
+
+namespace {
+
+_Unwind_Reason_Code count_frame(struct _Unwind_Context*, void* arg) {
+  ++*static_cast<int*>(arg);
+  return _URC_NO_REASON;
+}
+
+[[gnu::noinline]] int backtrace_at_depth(int depth) {
+  if (depth == 0) {
+    int frames = 0;
+    _Unwind_Backtrace(count_frame, &frames);
+    return frames;
+  }
+  int result = backtrace_at_depth(depth - 1);
+  benchmark::DoNotOptimize(result);
+  return result;
+}
+
+// Walk the stack the way sampling profilers do: repeatedly, from the same few
+// return addresses. Reports the number of frames unwound per second.
+void BM_UnwindBacktrace(benchmark::State& state) {
+  int depth = state.range(0);
+  int frames = 0;
+  for (auto _ : state)
+    frames = backtrace_at_depth(depth);
+  state.SetItemsProcessed(state.iterations() * frames);
+}
+BENCHMARK(BM_UnwindBacktrace)->Arg(8)->Arg(64)->ThreadRange(1, 8);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -10,8 +10,15 @@
 #ifndef _LIBCPP___ALGORITHM_COUNT_H
 #define _LIBCPP___ALGORITHM_COUNT_H
 
+#include <__algorithm/find.h>
+#include <__algorithm/simd_utils.h>
+#include <__algorithm/unwrap_iter.h>
 #include <__config>
 #include <__iterator/iterator_traits.h>
+#include <__type_traits/enable_if.h>
+#include <__type_traits/is_constant_evaluated.h>
+#include <__type_traits/remove_cv.h>
+#include <cstddef>
 
 #if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
 #  pragma GCC system_header
@@ -19,17 +26,61 @@
 
 _LIBCPP_BEGIN_NAMESPACE_STD
 
-template <class _InputIterator, class _Tp>
-_LIBCPP_NODISCARD_EXT inline _LIBCPP_INLINE_VISIBILITY _LIBCPP_CONSTEXPR_SINCE_CXX20
-    typename iterator_traits<_InputIterator>::difference_type
-    count(_InputIterator __first, _InputIterator __last, const _Tp& __value) {
-  typename iterator_traits<_InputIterator>::difference_type __r(0);
+template <class _Iter, class _Sent, class _Tp>
+_LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX14 typename iterator_traits<_Iter>::difference_type
+__count_impl(_Iter __first, _Sent __last, const _Tp& __value) {
+  typename iterator_traits<_Iter>::difference_type __r(0);
   for (; __first != __last; ++__first)
     if (*__first == __value)
       ++__r;
   return __r;
 }
 
+#if _LIBCPP_HAS_ALGORITHM_VECTOR_UTILS
+template <class _ValueT, class _Tp, __enable_if_t<__can_vectorize_find<_ValueT, _Tp>::value, int> = 0>
+_LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX14 ptrdiff_t
+__count_impl(_ValueT* __first, _ValueT* __last, const _Tp& __value) {
+  if (__libcpp_is_constant_evaluated())
+    return std::__count_impl<_ValueT*, _ValueT*, _Tp>(__first, __last, __value);
+
+  // If converting __value changes it, no element can be equal to it.
+  __remove_cv_t<_ValueT> __converted = static_cast<__remove_cv_t<_ValueT> >(__value);
+  if (!(__converted == __value))
+    return 0;
+
+  typedef __simd_lane_t<_ValueT> _Lane;
+  const ptrdiff_t __lanes = __simd_vector_size<_Lane>::value;
+  __simd_vector<_Lane> __needle = std::__simd_broadcast(static_cast<_Lane>(__converted));
+
+  // The lanes of a comparison are -1 where it holds, so subtracting them counts the matches lane by lane. The counts
+  // are added up before they can overflow the lanes.
+  typedef __typeof__(__needle == __needle) _Mask;
+  const ptrdiff_t __max_iterations = sizeof(_Lane) < sizeof(ptrdiff_t)
+                                       ? (static_cast<ptrdiff_t>(1) << (8 * sizeof(_Lane) - 1)) - 1
+                                       : static_cast<ptrdiff_t>(static_cast<size_t>(-1) >> 1);
+  ptrdiff_t __r = 0;
+  while (__last - __first >= __lanes) {
+    ptrdiff_t __iterations = (__last - __first) / __lanes;
+    if (__iterations > __max_iterations)
+      __iterations = __max_iterations;
+    _Mask __counts = _Mask();
+    for (; __iterations != 0; --__iterations, __first += __lanes)
+      __counts -= std::__simd_load<_Lane>(__first) == __needle;
+    for (ptrdiff_t __i = 0; __i != __lanes; ++__i)
+      __r += __counts[__i];
+  }
+
+  return __r + std::__count_impl<_ValueT*, _ValueT*, _Tp>(__first, __last, __value);
+}
+#endif // _LIBCPP_HAS_ALGORITHM_VECTOR_UTILS
+
+template <class _InputIterator, class _Tp>
+_LIBCPP_NODISCARD_EXT inline _LIBCPP_INLINE_VISIBILITY _LIBCPP_CONSTEXPR_SINCE_CXX20
+    typename iterator_traits<_InputIterator>::difference_type
+    count(_InputIterator __first, _InputIterator __last, const _Tp& __value) {
+  return std::__count_impl(std::__unwrap_iter(__first), std::__unwrap_iter(__last), __value);
+}
+
 _LIBCPP_END_NAMESPACE_STD
 
 #endif // _LIBCPP___ALGORITHM_COUNT_H
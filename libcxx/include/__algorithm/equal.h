@@ -11,6 +11,8 @@
 #define _LIBCPP___ALGORITHM_EQUAL_H
 
 #include <__algorithm/comp.h>
+#include <__algorithm/mismatch.h>
+#include <__algorithm/unwrap_iter.h>
 #include <__config>
 #include <__iterator/distance.h>
 #include <__iterator/iterator_traits.h>
@@ -24,10 +26,9 @@ _LIBCPP_BEGIN_NAMESPACE_STD
 template <class _InputIterator1, class _InputIterator2, class _BinaryPredicate>
 _LIBCPP_NODISCARD_EXT inline _LIBCPP_INLINE_VISIBILITY _LIBCPP_CONSTEXPR_SINCE_CXX20 bool
 equal(_InputIterator1 __first1, _InputIterator1 __last1, _InputIterator2 __first2, _BinaryPredicate __pred) {
-  for (; __first1 != __last1; ++__first1, (void)++__first2)
-    if (!__pred(*__first1, *__first2))
-      return false;
-  return true;
+  auto __last = std::__unwrap_iter(__last1);
+  return std::__mismatch_impl(std::__unwrap_iter(__first1), __last, std::__unwrap_iter(__first2), __pred).first ==
+         __last;
 }
 
 template <class _InputIterator1, class _InputIterator2>
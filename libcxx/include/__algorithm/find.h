@@ -10,7 +10,16 @@
 #ifndef _LIBCPP___ALGORITHM_FIND_H
 #define _LIBCPP___ALGORITHM_FIND_H
 
+#include <__algorithm/simd_utils.h>
+#include <__algorithm/unwrap_iter.h>
 #include <__config>
+#include <__type_traits/enable_if.h>
+#include <__type_traits/integral_constant.h>
+#include <__type_traits/is_constant_evaluated.h>
+#include <__type_traits/is_integral.h>
+#include <__type_traits/is_same.h>
+#include <__type_traits/remove_cv.h>
+#include <cstddef>
 
 #if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
 #  pragma GCC system_header
@@ -18,15 +27,67 @@
 
 _LIBCPP_BEGIN_NAMESPACE_STD
 
-template <class _InputIterator, class _Tp>
-_LIBCPP_NODISCARD_EXT inline _LIBCPP_INLINE_VISIBILITY _LIBCPP_CONSTEXPR_SINCE_CXX20 _InputIterator
-find(_InputIterator __first, _InputIterator __last, const _Tp& __value) {
+template <class _Iter, class _Sent, class _Tp>
+_LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX14 _Iter __find_impl(_Iter __first, _Sent __last, const _Tp& __value) {
   for (; __first != __last; ++__first)
     if (*__first == __value)
       break;
   return __first;
 }
 
+#if _LIBCPP_HAS_ALGORITHM_VECTOR_UTILS
+// Comparing an integer with an integer of another type is the same as comparing it with the other one converted to
+// its type, as long as that conversion preserves the value. Values of other types have to be of the same type.
+template <class _ValueT, class _Tp>
+struct __can_vectorize_find
+    : integral_constant<bool,
+                        __can_vectorize<_ValueT>::value &&
+                            (is_same<__remove_cv_t<_ValueT>, __remove_cv_t<_Tp> >::value ||
+                             (is_integral<_ValueT>::value && is_integral<_Tp>::value &&
+                              !is_same<__remove_cv_t<_Tp>, bool>::value))> {};
+
+template <class _ValueT, class _Tp, __enable_if_t<__can_vectorize_find<_ValueT, _Tp>::value, int> = 0>
+_LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX14 _ValueT*
+__find_impl(_ValueT* __first, _ValueT* __last, const _Tp& __value) {
+  if (__libcpp_is_constant_evaluated())
+    return std::__find_impl<_ValueT*, _ValueT*, _Tp>(__first, __last, __value);
+
+  // If converting __value changes it, no element can be equal to it.
+  __remove_cv_t<_ValueT> __converted = static_cast<__remove_cv_t<_ValueT> >(__value);
+  if (!(__converted == __value))
+    return __last;
+
+  typedef __simd_lane_t<_ValueT> _Lane;
+  const ptrdiff_t __lanes = __simd_vector_size<_Lane>::value;
+  __simd_vector<_Lane> __needle = std::__simd_broadcast(static_cast<_Lane>(__converted));
+
+  // Look at four vectors at a time first, so that the comparisons don't wait on each other.
+  while (__last - __first >= 4 * __lanes) {
+    if (std::__simd_any_of((std::__simd_load<_Lane>(__first) == __needle) |
+                           (std::__simd_load<_Lane>(__first + __lanes) == __needle) |
+                           (std::__simd_load<_Lane>(__first + 2 * __lanes) == __needle) |
+                           (std::__simd_load<_Lane>(__first + 3 * __lanes) == __needle)))
+      break;
+    __first += 4 * __lanes;
+  }
+  while (__last - __first >= __lanes) {
+    if (std::__simd_any_of(std::__simd_load<_Lane>(__first) == __needle))
+      break;
+    __first += __lanes;
+  }
+
+  // Find the match in the vector that contains one, or look at the elements that don't fill a vector.
+  return std::__find_impl<_ValueT*, _ValueT*, _Tp>(__first, __last, __value);
+}
+#endif // _LIBCPP_HAS_ALGORITHM_VECTOR_UTILS
+
+template <class _InputIterator, class _Tp>
+_LIBCPP_NODISCARD_EXT inline _LIBCPP_INLINE_VISIBILITY _LIBCPP_CONSTEXPR_SINCE_CXX20 _InputIterator
+find(_InputIterator __first, _InputIterator __last, const _Tp& __value) {
+  return std::__rewrap_iter(
+      __first, std::__find_impl(std::__unwrap_iter(__first), std::__unwrap_iter(__last), __value));
+}
+
 _LIBCPP_END_NAMESPACE_STD
 
 #endif // _LIBCPP___ALGORITHM_FIND_H
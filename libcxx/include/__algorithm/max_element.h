@@ -11,8 +11,16 @@
 
 #include <__algorithm/comp.h>
 #include <__algorithm/comp_ref_type.h>
+#include <__algorithm/find.h>
+#include <__algorithm/simd_utils.h>
+#include <__algorithm/unwrap_iter.h>
 #include <__config>
 #include <__iterator/iterator_traits.h>
+#include <__type_traits/enable_if.h>
+#include <__type_traits/is_constant_evaluated.h>
+#include <__type_traits/is_integral.h>
+#include <__type_traits/remove_cv.h>
+#include <cstddef>
 
 #if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
 #  pragma GCC system_header
@@ -44,12 +52,45 @@ max_element(_ForwardIterator __first, _ForwardIterator __last, _Compare __comp)
 }
 
 
+template <class _ForwardIterator>
+_LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX14 _ForwardIterator
+__max_element_less(_ForwardIterator __first, _ForwardIterator __last) {
+  return std::max_element(__first, __last, __less<typename iterator_traits<_ForwardIterator>::value_type>());
+}
+
+#if _LIBCPP_HAS_ALGORITHM_VECTOR_UTILS
+template <class _Tp, __enable_if_t<__can_vectorize<_Tp>::value && is_integral<_Tp>::value, int> = 0>
+_LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX14 _Tp* __max_element_less(_Tp* __first, _Tp* __last) {
+  typedef __remove_cv_t<_Tp> _ValueT;
+  typedef __simd_lane_t<_Tp> _Lane;
+  const ptrdiff_t __lanes = __simd_vector_size<_Lane>::value;
+  if (__libcpp_is_constant_evaluated() || __last - __first < 2 * __lanes)
+    return std::__max_element_less<_Tp*>(__first, __last);
+
+  // Find the largest value a vector at a time, then its first occurrence.
+  _Tp* __it = __first;
+  __simd_vector<_Lane> __extremes = std::__simd_load<_Lane>(__it);
+  for (__it += __lanes; __last - __it >= __lanes; __it += __lanes) {
+    __simd_vector<_Lane> __values = std::__simd_load<_Lane>(__it);
+    __extremes = std::__simd_select(__values > __extremes, __values, __extremes);
+  }
+  _ValueT __extreme = static_cast<_ValueT>(__extremes[0]);
+  for (ptrdiff_t __i = 1; __i != __lanes; ++__i)
+    if (static_cast<_ValueT>(__extremes[__i]) > __extreme)
+      __extreme = static_cast<_ValueT>(__extremes[__i]);
+  for (; __it != __last; ++__it)
+    if (*__it > __extreme)
+      __extreme = *__it;
+  return std::__find_impl(__first, __last, __extreme);
+}
+#endif // _LIBCPP_HAS_ALGORITHM_VECTOR_UTILS
+
 template <class _ForwardIterator>
 _LIBCPP_NODISCARD_EXT inline _LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX14 _ForwardIterator
 max_element(_ForwardIterator __first, _ForwardIterator __last)
 {
-    return _VSTD::max_element(__first, __last,
-              __less<typename iterator_traits<_ForwardIterator>::value_type>());
+    return std::__rewrap_iter(
+        __first, std::__max_element_less(std::__unwrap_iter(__first), std::__unwrap_iter(__last)));
 }
 
 _LIBCPP_END_NAMESPACE_STD
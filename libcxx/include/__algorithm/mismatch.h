@@ -11,9 +11,17 @@
 #define _LIBCPP___ALGORITHM_MISMATCH_H
 
 #include <__algorithm/comp.h>
+#include <__algorithm/simd_utils.h>
+#include <__algorithm/unwrap_iter.h>
 #include <__config>
 #include <__iterator/iterator_traits.h>
+#include <__type_traits/enable_if.h>
+#include <__type_traits/integral_constant.h>
+#include <__type_traits/is_constant_evaluated.h>
+#include <__type_traits/is_same.h>
+#include <__type_traits/remove_cv.h>
 #include <__utility/pair.h>
+#include <cstddef>
 
 #if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
 #  pragma GCC system_header
@@ -21,14 +29,55 @@
 
 _LIBCPP_BEGIN_NAMESPACE_STD
 
+template <class _Iter1, class _Sent1, class _Iter2, class _Pred>
+_LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX14 pair<_Iter1, _Iter2>
+__mismatch_impl(_Iter1 __first1, _Sent1 __last1, _Iter2 __first2, _Pred& __pred) {
+  for (; __first1 != __last1; ++__first1, (void)++__first2)
+    if (!__pred(*__first1, *__first2))
+      break;
+  return pair<_Iter1, _Iter2>(__first1, __first2);
+}
+
+#if _LIBCPP_HAS_ALGORITHM_VECTOR_UTILS
+// Whether the elements of two ranges of _Tp and _Up compared with _Pred can be compared a vector at a time.
+template <class _Tp, class _Up, class _Pred>
+struct __can_vectorize_mismatch : false_type {};
+
+template <class _Tp, class _Up, class _V1, class _V2>
+struct __can_vectorize_mismatch<_Tp, _Up, __equal_to<_V1, _V2> >
+    : integral_constant<bool,
+                        __can_vectorize<_Tp>::value && is_same<__remove_cv_t<_Tp>, __remove_cv_t<_Up> >::value &&
+                            is_same<__remove_cv_t<_Tp>, __remove_cv_t<_V1> >::value &&
+                            is_same<__remove_cv_t<_Tp>, __remove_cv_t<_V2> >::value> {};
+
+template <class _Tp, class _Up, class _Pred, __enable_if_t<__can_vectorize_mismatch<_Tp, _Up, _Pred>::value, int> = 0>
+_LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX14 pair<_Tp*, _Up*>
+__mismatch_impl(_Tp* __first1, _Tp* __last1, _Up* __first2, _Pred& __pred) {
+  if (__libcpp_is_constant_evaluated())
+    return std::__mismatch_impl<_Tp*, _Tp*, _Up*, _Pred>(__first1, __last1, __first2, __pred);
+
+  typedef __simd_lane_t<_Tp> _Lane;
+  const ptrdiff_t __lanes = __simd_vector_size<_Lane>::value;
+  while (__last1 - __first1 >= __lanes) {
+    if (std::__simd_any_of(std::__simd_load<_Lane>(__first1) != std::__simd_load<_Lane>(__first2)))
+      break;
+    __first1 += __lanes;
+    __first2 += __lanes;
+  }
+
+  // Find the mismatch in the vector that contains one, or look at the elements that don't fill a vector.
+  return std::__mismatch_impl<_Tp*, _Tp*, _Up*, _Pred>(__first1, __last1, __first2, __pred);
+}
+#endif // _LIBCPP_HAS_ALGORITHM_VECTOR_UTILS
+
 template <class _InputIterator1, class _InputIterator2, class _BinaryPredicate>
 _LIBCPP_NODISCARD_EXT inline _LIBCPP_INLINE_VISIBILITY
     _LIBCPP_CONSTEXPR_SINCE_CXX20 pair<_InputIterator1, _InputIterator2>
     mismatch(_InputIterator1 __first1, _InputIterator1 __last1, _InputIterator2 __first2, _BinaryPredicate __pred) {
-  for (; __first1 != __last1; ++__first1, (void)++__first2)
-    if (!__pred(*__first1, *__first2))
-      break;
-  return pair<_InputIterator1, _InputIterator2>(__first1, __first2);
+  auto __result = std::__mismatch_impl(
+      std::__unwrap_iter(__first1), std::__unwrap_iter(__last1), std::__unwrap_iter(__first2), __pred);
+  return pair<_InputIterator1, _InputIterator2>(
+      std::__rewrap_iter(__first1, __result.first), std::__rewrap_iter(__first2, __result.second));
 }
 
 template <class _InputIterator1, class _InputIterator2>
@@ -41,15 +90,38 @@ _LIBCPP_NODISCARD_EXT inline _LIBCPP_INLINE_VISIBILITY
 }
 
 #if _LIBCPP_STD_VER > 11
+template <class _Iter1, class _Sent1, class _Iter2, class _Sent2, class _Pred>
+_LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX14 pair<_Iter1, _Iter2>
+__mismatch_impl(_Iter1 __first1, _Sent1 __last1, _Iter2 __first2, _Sent2 __last2, _Pred& __pred) {
+  for (; __first1 != __last1 && __first2 != __last2; ++__first1, (void)++__first2)
+    if (!__pred(*__first1, *__first2))
+      break;
+  return pair<_Iter1, _Iter2>(__first1, __first2);
+}
+
+#  if _LIBCPP_HAS_ALGORITHM_VECTOR_UTILS
+template <class _Tp, class _Up, class _Pred, __enable_if_t<__can_vectorize_mismatch<_Tp, _Up, _Pred>::value, int> = 0>
+_LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX14 pair<_Tp*, _Up*>
+__mismatch_impl(_Tp* __first1, _Tp* __last1, _Up* __first2, _Up* __last2, _Pred& __pred) {
+  if (__last2 - __first2 < __last1 - __first1)
+    __last1 = __first1 + (__last2 - __first2);
+  return std::__mismatch_impl(__first1, __last1, __first2, __pred);
+}
+#  endif // _LIBCPP_HAS_ALGORITHM_VECTOR_UTILS
+
 template <class _InputIterator1, class _InputIterator2, class _BinaryPredicate>
 _LIBCPP_NODISCARD_EXT inline _LIBCPP_INLINE_VISIBILITY
     _LIBCPP_CONSTEXPR_SINCE_CXX20 pair<_InputIterator1, _InputIterator2>
     mismatch(_InputIterator1 __first1, _InputIterator1 __last1, _InputIterator2 __first2, _InputIterator2 __last2,
              _BinaryPredicate __pred) {
-  for (; __first1 != __last1 && __first2 != __last2; ++__first1, (void)++__first2)
-    if (!__pred(*__first1, *__first2))
-      break;
-  return pair<_InputIterator1, _InputIterator2>(__first1, __first2);
+  auto __result = std::__mismatch_impl(
+      std::__unwrap_iter(__first1),
+      std::__unwrap_iter(__last1),
+      std::__unwrap_iter(__first2),
+      std::__unwrap_iter(__last2),
+      __pred);
+  return pair<_InputIterator1, _InputIterator2>(
+      std::__rewrap_iter(__first1, __result.first), std::__rewrap_iter(__first2, __result.second));
 }
 
 template <class _InputIterator1, class _InputIterator2>
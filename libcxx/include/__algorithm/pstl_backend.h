@@ -0,0 +1,67 @@
+// -*- C++ -*-
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _LIBCPP___ALGORITHM_PSTL_BACKEND_H
+#define _LIBCPP___ALGORITHM_PSTL_BACKEND_H
+
+#include <__config>
+
+#if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
+#  pragma GCC system_header
+#endif
+
+/*
+The parallel algorithms are implemented on top of a small set of primitives
+provided by the backend selected with LIBCXX_PSTL_CPU_BACKEND. Those live in
+namespace std::__par_backend, take random access iterators or integers (an
+"_Index") and call back into the algorithms with "bricks", the serial
+algorithms applied to a chunk of the input:
+
+  template <class _Index, class _Brick>
+  void __parallel_for(_Index __first, _Index __last, _Brick __brick);
+    - Calls `__brick(__chunk_first, __chunk_last)` on disjoint chunks that
+      cover [__first, __last).
+
+  template <class _Index, class _Tp, class _Reduction, class _Brick>
+  _Tp __parallel_transform_reduce(_Index __first, _Index __last, _Tp __init, _Reduction __reduction, _Brick __brick);
+    - Returns the generalized sum with `__reduction` of `__init` and of the
+      results of `__brick(__chunk_first, __chunk_last)`, which reduces a
+      non-empty chunk into a `_Tp`.
+
+  template <class _Index, class _Tp, class _Reduction, class _Reduce, class _Scan>
+  void __parallel_scan(_Index __first, _Index __last, const _Tp* __init, _Reduction __reduction,
+                       _Reduce __reduce, _Scan __scan);
+    - `__reduce(__chunk_first, __chunk_last)` returns the sum of a non-empty
+      chunk, and `__scan(__chunk_first, __chunk_last, __carry)` writes the
+      inclusive scan of the chunk, combined with `*__carry` unless it is null.
+      The carry of the first chunk is `__init`, the one of the other chunks is
+      the sum of `__init` and of all the elements before them.
+
+  template <class _RandomAccessIterator, class _Comp, class _LeafSort>
+  void __parallel_stable_sort(_RandomAccessIterator __first, _RandomAccessIterator __last, _Comp __comp,
+                              _LeafSort __leaf_sort);
+    - Sorts [__first, __last) stably, using `__leaf_sort(__chunk_first,
+      __chunk_last, __comp)` to sort the chunks before merging them.
+
+The serial backend runs the bricks on the whole input. The thread, OpenMP and
+libdispatch backends split the input into chunks and run the bricks on the
+thread pool of the dylib, see <__algorithm/pstl_backends/parallel.h>.
+
+The bricks may not throw, an exception escaping a parallel algorithm calls
+std::terminate as required by [algorithms.parallel.exceptions].
+*/
+
+#if defined(_LIBCPP_PSTL_CPU_BACKEND_THREAD) || defined(_LIBCPP_PSTL_CPU_BACKEND_OPENMP) ||                          \
+    defined(_LIBCPP_PSTL_CPU_BACKEND_LIBDISPATCH)
+#  include <__algorithm/pstl_backends/parallel.h>
+#else
+#  include <__algorithm/pstl_backends/serial.h>
+#endif
+
+#endif // _LIBCPP___ALGORITHM_PSTL_BACKEND_H
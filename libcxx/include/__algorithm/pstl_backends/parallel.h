@@ -0,0 +1,317 @@
+// -*- C++ -*-
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _LIBCPP___ALGORITHM_PSTL_BACKENDS_PARALLEL_H
+#define _LIBCPP___ALGORITHM_PSTL_BACKENDS_PARALLEL_H
+
+#include <__algorithm/lower_bound.h>
+#include <__algorithm/max.h>
+#include <__algorithm/min.h>
+#include <__algorithm/move.h>
+#include <__algorithm/upper_bound.h>
+#include <__config>
+#include <__iterator/iterator_traits.h>
+#include <__memory/addressof.h>
+#include <__memory/allocator.h>
+#include <__memory/construct_at.h>
+#include <__memory/uninitialized_algorithms.h>
+#include <__utility/move.h>
+#include <cstddef>
+
+#if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
+#  pragma GCC system_header
+#endif
+
+#if !defined(_LIBCPP_HAS_NO_INCOMPLETE_PSTL) && _LIBCPP_STD_VER > 14
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+
+namespace __par_backend {
+
+// These are implemented in the dylib by the backend selected with
+// LIBCXX_PSTL_CPU_BACKEND, see src/pstl.
+
+// Returns the number of threads the tasks are run on.
+_LIBCPP_EXPORTED_FROM_ABI size_t __concurrency() noexcept;
+
+// Calls `__func(__context, __index)` for every index in [0, __size), on the
+// threads of the backend and on the calling thread, and returns once all the
+// calls returned. This may be called from within `__func`.
+_LIBCPP_EXPORTED_FROM_ABI void
+__parallel_apply(size_t __size, void* __context, void (*__func)(void* __context, size_t __index) noexcept) noexcept;
+
+template <class _Func>
+_LIBCPP_HIDE_FROM_ABI void __apply(size_t __size, _Func& __func) {
+  std::__par_backend::__parallel_apply(__size, std::addressof(__func), [](void* __context, size_t __index) noexcept {
+    (*static_cast<_Func*>(__context))(__index);
+  });
+}
+
+// The chunks an input of `__size_` elements is split into. Their sizes differ
+// by at most one element.
+struct __chunk_partitions {
+  ptrdiff_t __size_;
+  ptrdiff_t __count_;
+
+  _LIBCPP_HIDE_FROM_ABI ptrdiff_t __begin(ptrdiff_t __chunk) const {
+    return __size_ / __count_ * __chunk + std::min(__chunk, __size_ % __count_);
+  }
+  _LIBCPP_HIDE_FROM_ABI ptrdiff_t __end(ptrdiff_t __chunk) const { return __begin(__chunk + 1); }
+};
+
+_LIBCPP_HIDE_FROM_ABI inline __chunk_partitions __partition_chunks(ptrdiff_t __size) {
+  // Below this size, the cost of scheduling a chunk dominates the cost of
+  // processing it, even for the cheapest bricks.
+  const ptrdiff_t __min_chunk_size = 2048;
+  // A few chunks per thread balance the load when the threads don't run at
+  // the same speed, or when the cost of the elements varies.
+  const ptrdiff_t __chunks_per_thread = 4;
+  ptrdiff_t __max_count = static_cast<ptrdiff_t>(std::__par_backend::__concurrency()) * __chunks_per_thread;
+  return {__size, std::max<ptrdiff_t>(1, std::min(__max_count, __size / __min_chunk_size))};
+}
+
+// Uninitialized storage for the results of the chunks. Only the first
+// `__constructed_` elements are destroyed.
+template <class _Tp>
+struct __chunk_buffer {
+  _Tp* __data_;
+  size_t __size_;
+  size_t __constructed_ = 0;
+
+  _LIBCPP_HIDE_FROM_ABI explicit __chunk_buffer(size_t __size)
+      : __data_(allocator<_Tp>().allocate(__size)), __size_(__size) {}
+  __chunk_buffer(const __chunk_buffer&)            = delete;
+  __chunk_buffer& operator=(const __chunk_buffer&) = delete;
+  _LIBCPP_HIDE_FROM_ABI ~__chunk_buffer() {
+    std::__destroy(__data_, __data_ + __constructed_);
+    allocator<_Tp>().deallocate(__data_, __size_);
+  }
+};
+
+template <class _Index, class _Brick>
+_LIBCPP_HIDE_FROM_ABI void __parallel_for(_Index __first, _Index __last, _Brick __brick) {
+  __chunk_partitions __partitions = std::__par_backend::__partition_chunks(__last - __first);
+  if (__partitions.__count_ == 1) {
+    __brick(__first, __last);
+    return;
+  }
+
+  auto __task = [&](size_t __chunk) {
+    __brick(__first + __partitions.__begin(__chunk), __first + __partitions.__end(__chunk));
+  };
+  std::__par_backend::__apply(__partitions.__count_, __task);
+}
+
+template <class _Index, class _Tp, class _Reduction, class _Brick>
+_LIBCPP_HIDE_FROM_ABI _Tp
+__parallel_transform_reduce(_Index __first, _Index __last, _Tp __init, _Reduction __reduction, _Brick __brick) {
+  if (__first == __last)
+    return __init;
+  __chunk_partitions __partitions = std::__par_backend::__partition_chunks(__last - __first);
+  if (__partitions.__count_ == 1)
+    return __reduction(std::move(__init), __brick(__first, __last));
+
+  __chunk_buffer<_Tp> __results(__partitions.__count_);
+  auto __task = [&](size_t __chunk) {
+    std::__construct_at(
+        __results.__data_ + __chunk,
+        __brick(__first + __partitions.__begin(__chunk), __first + __partitions.__end(__chunk)));
+  };
+  std::__par_backend::__apply(__partitions.__count_, __task);
+  __results.__constructed_ = __partitions.__count_;
+
+  for (size_t __chunk = 0; __chunk != __results.__size_; ++__chunk)
+    __init = __reduction(std::move(__init), std::move(__results.__data_[__chunk]));
+  return __init;
+}
+
+template <class _Index, class _Tp, class _Reduction, class _Reduce, class _Scan>
+_LIBCPP_HIDE_FROM_ABI void __parallel_scan(
+    _Index __first, _Index __last, const _Tp* __init, _Reduction __reduction, _Reduce __reduce, _Scan __scan) {
+  if (__first == __last)
+    return;
+  __chunk_partitions __partitions = std::__par_backend::__partition_chunks(__last - __first);
+  if (__partitions.__count_ == 1) {
+    __scan(__first, __last, __init);
+    return;
+  }
+
+  // Sum all the chunks but the last one, in parallel...
+  __chunk_buffer<_Tp> __carries(__partitions.__count_ - 1);
+  auto __reduce_task = [&](size_t __chunk) {
+    std::__construct_at(
+        __carries.__data_ + __chunk,
+        __reduce(__first + __partitions.__begin(__chunk), __first + __partitions.__end(__chunk)));
+  };
+  std::__par_backend::__apply(__carries.__size_, __reduce_task);
+  __carries.__constructed_ = __carries.__size_;
+
+  // ...turn the sums into the carries of the chunks that follow them...
+  if (__init)
+    __carries.__data_[0] = __reduction(*__init, std::move(__carries.__data_[0]));
+  for (size_t __chunk = 1; __chunk != __carries.__size_; ++__chunk)
+    __carries.__data_[__chunk] = __reduction(__carries.__data_[__chunk - 1], std::move(__carries.__data_[__chunk]));
+
+  // ...and scan all the chunks in parallel.
+  auto __scan_task = [&](size_t __chunk) {
+    __scan(__first + __partitions.__begin(__chunk),
+           __first + __partitions.__end(__chunk),
+           __chunk == 0 ? __init : __carries.__data_ + __chunk - 1);
+  };
+  std::__par_backend::__apply(__partitions.__count_, __scan_task);
+}
+
+// Returns in `__split1` and `__split2` the offsets in the sorted ranges
+// [__first1, __last1) and [__first2, __last2) of the piece `__piece` out of
+// `__pieces` of their stable merge. The longer range is split evenly, and the
+// other one so that the elements before the split come first in the merge.
+template <class _Iter, class _Comp>
+_LIBCPP_HIDE_FROM_ABI void __merge_split(
+    _Iter __first1,
+    _Iter __last1,
+    _Iter __first2,
+    _Iter __last2,
+    ptrdiff_t __piece,
+    ptrdiff_t __pieces,
+    _Comp& __comp,
+    ptrdiff_t& __split1,
+    ptrdiff_t& __split2) {
+  ptrdiff_t __size1 = __last1 - __first1;
+  ptrdiff_t __size2 = __last2 - __first2;
+  if (__piece == 0) {
+    __split1 = __split2 = 0;
+  } else if (__size1 >= __size2) {
+    __split1 = __chunk_partitions{__size1, __pieces}.__begin(__piece);
+    __split2 =
+        __split1 == __size1 ? __size2 : std::lower_bound(__first2, __last2, __first1[__split1], __comp) - __first2;
+  } else {
+    __split2 = __chunk_partitions{__size2, __pieces}.__begin(__piece);
+    __split1 =
+        __split2 == __size2 ? __size1 : std::upper_bound(__first1, __last1, __first2[__split2], __comp) - __first1;
+  }
+}
+
+// This is std::merge, but moving the elements. They are compared as lvalues,
+// like std::sort does.
+template <class _Iter, class _OutIter, class _Comp>
+_LIBCPP_HIDE_FROM_ABI void
+__move_merge(_Iter __first1, _Iter __last1, _Iter __first2, _Iter __last2, _OutIter __result, _Comp& __comp) {
+  for (; __first1 != __last1 && __first2 != __last2; ++__result) {
+    if (__comp(*__first2, *__first1)) {
+      *__result = std::move(*__first2);
+      ++__first2;
+    } else {
+      *__result = std::move(*__first1);
+      ++__first1;
+    }
+  }
+  __result = std::move(__first1, __last1, __result);
+  std::move(__first2, __last2, __result);
+}
+
+template <class _RandomAccessIterator, class _Comp, class _LeafSort>
+_LIBCPP_HIDE_FROM_ABI void __parallel_stable_sort(
+    _RandomAccessIterator __first, _RandomAccessIterator __last, _Comp __comp, _LeafSort __leaf_sort) {
+  using _ValueType = typename iterator_traits<_RandomAccessIterator>::value_type;
+  __chunk_partitions __partitions = std::__par_backend::__partition_chunks(__last - __first);
+  if (__partitions.__count_ == 1) {
+    __leaf_sort(__first, __last, __comp);
+    return;
+  }
+
+  // Sort the chunks and move them to the buffer...
+  __chunk_buffer<_ValueType> __buffer(__partitions.__size_);
+  auto __sort_task = [&](size_t __chunk) {
+    _RandomAccessIterator __chunk_first = __first + __partitions.__begin(__chunk);
+    _RandomAccessIterator __chunk_last  = __first + __partitions.__end(__chunk);
+    __leaf_sort(__chunk_first, __chunk_last, __comp);
+    std::uninitialized_move(__chunk_first, __chunk_last, __buffer.__data_ + __partitions.__begin(__chunk));
+  };
+  std::__par_backend::__apply(__partitions.__count_, __sort_task);
+  __buffer.__constructed_ = __buffer.__size_;
+
+  // ...then merge the sorted runs pairwise, back and forth between the buffer
+  // and the input. Each merge is split into pieces, so that all the rounds
+  // run on about as many tasks as there are chunks.
+  __chunk_buffer<ptrdiff_t> __bounds(__partitions.__count_ + 1);
+  for (ptrdiff_t __chunk = 0; __chunk <= __partitions.__count_; ++__chunk)
+    __bounds.__data_[__chunk] = __partitions.__begin(__chunk);
+  // There are less than 3 * __count_ splits, see below.
+  __chunk_buffer<ptrdiff_t> __splits(6 * __partitions.__count_);
+  ptrdiff_t __runs = __partitions.__count_;
+  bool __in_buffer = true;
+  while (__runs > 1) {
+    ptrdiff_t __pairs  = (__runs + 1) / 2;
+    ptrdiff_t __pieces = (__partitions.__count_ + __pairs - 1) / __pairs;
+    auto __merge_round = [&](auto __input, auto __output) {
+      auto __get_run = [&](ptrdiff_t __run) { return __input + __bounds.__data_[std::min(__run, __runs)]; };
+
+      // All the splits are found before merging anything, as the searches may
+      // look at elements another piece moved from.
+      for (ptrdiff_t __pair = 0; __pair != __pairs; ++__pair) {
+        for (ptrdiff_t __piece = 0; __piece <= __pieces; ++__piece) {
+          ptrdiff_t* __split = __splits.__data_ + 2 * (__pair * (__pieces + 1) + __piece);
+          std::__par_backend::__merge_split(
+              __get_run(2 * __pair),
+              __get_run(2 * __pair + 1),
+              __get_run(2 * __pair + 1),
+              __get_run(2 * __pair + 2),
+              __piece,
+              __pieces,
+              __comp,
+              __split[0],
+              __split[1]);
+        }
+      }
+
+      auto __merge_task = [&](size_t __task) {
+        ptrdiff_t __pair       = __task / __pieces;
+        ptrdiff_t* __split     = __splits.__data_ + 2 * (__pair * (__pieces + 1) + __task % __pieces);
+        auto __first1          = __get_run(2 * __pair);
+        auto __first2          = __get_run(2 * __pair + 1);
+        ptrdiff_t __out_offset = __bounds.__data_[2 * __pair] + __split[0] + __split[1];
+        std::__par_backend::__move_merge(
+            __first1 + __split[0],
+            __first1 + __split[2],
+            __first2 + __split[1],
+            __first2 + __split[3],
+            __output + __out_offset,
+            __comp);
+      };
+      std::__par_backend::__apply(__pairs * __pieces, __merge_task);
+    };
+    if (__in_buffer)
+      __merge_round(__buffer.__data_, __first);
+    else
+      __merge_round(__first, __buffer.__data_);
+
+    for (ptrdiff_t __pair = 0; __pair != __pairs; ++__pair)
+      __bounds.__data_[__pair] = __bounds.__data_[2 * __pair];
+    __bounds.__data_[__pairs] = __partitions.__size_;
+    __runs                    = __pairs;
+    __in_buffer               = !__in_buffer;
+  }
+
+  if (__in_buffer) {
+    auto __move_task = [&](size_t __chunk) {
+      std::move(__buffer.__data_ + __partitions.__begin(__chunk),
+                __buffer.__data_ + __partitions.__end(__chunk),
+                __first + __partitions.__begin(__chunk));
+    };
+    std::__par_backend::__apply(__partitions.__count_, __move_task);
+  }
+}
+
+} // namespace __par_backend
+
+_LIBCPP_END_NAMESPACE_STD
+
+#endif // !defined(_LIBCPP_HAS_NO_INCOMPLETE_PSTL) && _LIBCPP_STD_VER > 14
+
+#endif // _LIBCPP___ALGORITHM_PSTL_BACKENDS_PARALLEL_H
@@ -0,0 +1,58 @@
+// -*- C++ -*-
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _LIBCPP___ALGORITHM_PSTL_BACKENDS_SERIAL_H
+#define _LIBCPP___ALGORITHM_PSTL_BACKENDS_SERIAL_H
+
+#include <__config>
+#include <__utility/move.h>
+
+#if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
+#  pragma GCC system_header
+#endif
+
+#if !defined(_LIBCPP_HAS_NO_INCOMPLETE_PSTL) && _LIBCPP_STD_VER > 14
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+
+namespace __par_backend {
+
+template <class _Index, class _Brick>
+_LIBCPP_HIDE_FROM_ABI void __parallel_for(_Index __first, _Index __last, _Brick __brick) {
+  __brick(__first, __last);
+}
+
+template <class _Index, class _Tp, class _Reduction, class _Brick>
+_LIBCPP_HIDE_FROM_ABI _Tp
+__parallel_transform_reduce(_Index __first, _Index __last, _Tp __init, _Reduction __reduction, _Brick __brick) {
+  if (__first == __last)
+    return __init;
+  return __reduction(std::move(__init), __brick(__first, __last));
+}
+
+template <class _Index, class _Tp, class _Reduction, class _Reduce, class _Scan>
+_LIBCPP_HIDE_FROM_ABI void
+__parallel_scan(_Index __first, _Index __last, const _Tp* __init, _Reduction, _Reduce, _Scan __scan) {
+  if (__first != __last)
+    __scan(__first, __last, __init);
+}
+
+template <class _RandomAccessIterator, class _Comp, class _LeafSort>
+_LIBCPP_HIDE_FROM_ABI void __parallel_stable_sort(
+    _RandomAccessIterator __first, _RandomAccessIterator __last, _Comp __comp, _LeafSort __leaf_sort) {
+  __leaf_sort(__first, __last, __comp);
+}
+
+} // namespace __par_backend
+
+_LIBCPP_END_NAMESPACE_STD
+
+#endif // !defined(_LIBCPP_HAS_NO_INCOMPLETE_PSTL) && _LIBCPP_STD_VER > 14
+
+#endif // _LIBCPP___ALGORITHM_PSTL_BACKENDS_SERIAL_H
@@ -0,0 +1,59 @@
+// -*- C++ -*-
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _LIBCPP___ALGORITHM_PSTL_SORT_H
+#define _LIBCPP___ALGORITHM_PSTL_SORT_H
+
+#include <__algorithm/pstl_backend.h>
+#include <__algorithm/sort.h>
+#include <__config>
+#include <__functional/operations.h>
+#include <__iterator/iterator_traits.h>
+#include <__type_traits/is_execution_policy.h>
+#include <__utility/move.h>
+
+#if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
+#  pragma GCC system_header
+#endif
+
+#if !defined(_LIBCPP_HAS_NO_INCOMPLETE_PSTL) && _LIBCPP_STD_VER > 14
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+
+// The chunks are sorted with std::sort, and merged like for std::stable_sort.
+template <class _ExecutionPolicy,
+          class _RandomAccessIterator,
+          class _Comp,
+          __enable_if_execution_policy<_ExecutionPolicy> = 0>
+_LIBCPP_HIDE_FROM_ABI void
+sort(_ExecutionPolicy&&, _RandomAccessIterator __first, _RandomAccessIterator __last, _Comp __comp) {
+  if constexpr (__is_parallel_execution_policy_v<_ExecutionPolicy>) {
+    std::__par_backend::__parallel_stable_sort(
+        __first,
+        __last,
+        __comp,
+        [](_RandomAccessIterator __brick_first, _RandomAccessIterator __brick_last, _Comp& __c) {
+          std::sort(__brick_first, __brick_last, __c);
+        });
+  } else {
+    std::sort(__first, __last, std::move(__comp));
+  }
+}
+
+template <class _ExecutionPolicy, class _RandomAccessIterator, __enable_if_execution_policy<_ExecutionPolicy> = 0>
+_LIBCPP_HIDE_FROM_ABI void
+sort(_ExecutionPolicy&& __policy, _RandomAccessIterator __first, _RandomAccessIterator __last) {
+  std::sort(__policy, __first, __last, less<>());
+}
+
+_LIBCPP_END_NAMESPACE_STD
+
+#endif // !defined(_LIBCPP_HAS_NO_INCOMPLETE_PSTL) && _LIBCPP_STD_VER > 14
+
+#endif // _LIBCPP___ALGORITHM_PSTL_SORT_H
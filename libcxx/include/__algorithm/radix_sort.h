@@ -0,0 +1,120 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _LIBCPP___ALGORITHM_RADIX_SORT_H
+#define _LIBCPP___ALGORITHM_RADIX_SORT_H
+
+#include <__algorithm/comp.h>
+#include <__config>
+#include <__functional/operations.h>
+#include <__functional/ranges_operations.h>
+#include <__type_traits/integral_constant.h>
+#include <__type_traits/is_integral.h>
+#include <__type_traits/is_same.h>
+#include <__type_traits/is_signed.h>
+#include <__type_traits/make_unsigned.h>
+#include <__type_traits/remove_cv.h>
+#include <climits>
+#include <cstddef>
+
+#if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
+#  pragma GCC system_header
+#endif
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+
+// Whether _Comp orders values of type _Tp by increasing value, like operator< does.
+template <class _Comp, class _Tp>
+struct __is_default_less_comparator : false_type {};
+template <class _Tp>
+struct __is_default_less_comparator<__less<_Tp, _Tp>, _Tp> : true_type {};
+template <class _Tp>
+struct __is_default_less_comparator<less<_Tp>, _Tp> : true_type {};
+#if _LIBCPP_STD_VER > 11
+template <class _Tp>
+struct __is_default_less_comparator<less<void>, _Tp> : true_type {};
+#endif
+#if _LIBCPP_STD_VER > 17
+template <class _Tp>
+struct __is_default_less_comparator<ranges::less, _Tp> : true_type {};
+#endif
+
+// Ranges of integers sorted in increasing order can be radix sorted, since equivalent integers can't be told apart.
+template <class _Comp, class _Tp>
+struct __use_radix_sort
+    : integral_constant<bool, is_integral<_Tp>::value && !is_same<__remove_cv_t<_Tp>, bool>::value &&
+                                  sizeof(_Tp) <= 8 && __is_default_less_comparator<__remove_cv_t<_Comp>, _Tp>::value> {
+};
+
+// The number of values of a digit of the radix sort, which sorts on bytes.
+const size_t __radix_sort_radix = 1 << CHAR_BIT;
+
+// Ranges shorter than this are sorted faster by introsort than by the passes of the radix sort over the range.
+template <class _Tp>
+struct __radix_sort_threshold : integral_constant<ptrdiff_t, sizeof(_Tp) <= 2 ? 256 : 1024 * sizeof(_Tp)> {};
+
+// Ranges of more bytes than this are distributed by their most significant byte first, so that the passes over the
+// remaining bytes are done on parts of the range that fit in the cache.
+const size_t __radix_sort_cache_size = size_t(1) << 23;
+
+// Maps __value to an unsigned integer with the same order, by flipping the sign bit of signed integers.
+template <class _Tp>
+inline _LIBCPP_HIDE_FROM_ABI __make_unsigned_t<_Tp> __radix_key(_Tp __value) _NOEXCEPT {
+  typedef __make_unsigned_t<_Tp> _Key;
+  const _Key __sign_bit = is_signed<_Tp>::value ? _Key(_Key(1) << (sizeof(_Tp) * CHAR_BIT - 1)) : _Key(0);
+  return static_cast<_Key>(static_cast<_Key>(__value) ^ __sign_bit);
+}
+
+template <class _Tp>
+inline _LIBCPP_HIDE_FROM_ABI size_t __radix_digit(_Tp __value, size_t __digit) _NOEXCEPT {
+  return static_cast<size_t>(std::__radix_key(__value) >> (__digit * CHAR_BIT)) & (__radix_sort_radix - 1);
+}
+
+// Counts how many elements of [__first, __last) have each value of each of their __digits lowest digits, in a single
+// read of the range.
+template <class _Tp>
+_LIBCPP_HIDE_FROM_ABI void __radix_sort_count(_Tp* __first, _Tp* __last, size_t __digits,
+                                              size_t (*__counts)[__radix_sort_radix]) _NOEXCEPT {
+  for (_Tp* __i = __first; __i != __last; ++__i) {
+    for (size_t __digit = 0; __digit != __digits; ++__digit)
+      ++__counts[__digit][std::__radix_digit(*__i, __digit)];
+  }
+}
+
+// Sorts [__first, __last) on the __digits lowest digits of its elements with a least significant digit radix sort,
+// going back and forth between the range and __buffer, which must have room for as many elements. __counts holds the
+// counts of the digits. The passes for digits that are the same in all the elements are skipped, which is common for
+// the high bytes of IDs and sizes. Returns the range or the buffer, whichever holds the sorted elements.
+template <class _Tp>
+_LIBCPP_HIDE_FROM_ABI _Tp* __radix_sort_lsd(_Tp* __first, _Tp* __last, _Tp* __buffer, size_t __digits,
+                                            size_t (*__counts)[__radix_sort_radix]) _NOEXCEPT {
+  const size_t __len = static_cast<size_t>(__last - __first);
+  _Tp* __src = __first;
+  _Tp* __dst = __buffer;
+  for (size_t __digit = 0; __digit != __digits; ++__digit) {
+    size_t* __offsets = __counts[__digit];
+    if (__offsets[std::__radix_digit(*__src, __digit)] == __len)
+      continue;
+    size_t __sum = 0;
+    for (size_t __d = 0; __d != __radix_sort_radix; ++__d) {
+      size_t __count = __offsets[__d];
+      __offsets[__d] = __sum;
+      __sum += __count;
+    }
+    for (_Tp* __i = __src; __i != __src + __len; ++__i)
+      __dst[__offsets[std::__radix_digit(*__i, __digit)]++] = *__i;
+    _Tp* __tmp = __src;
+    __src = __dst;
+    __dst = __tmp;
+  }
+  return __src;
+}
+
+_LIBCPP_END_NAMESPACE_STD
+
+#endif // _LIBCPP___ALGORITHM_RADIX_SORT_H
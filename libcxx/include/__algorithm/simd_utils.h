@@ -0,0 +1,132 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _LIBCPP___ALGORITHM_SIMD_UTILS_H
+#define _LIBCPP___ALGORITHM_SIMD_UTILS_H
+
+#include <__config>
+#include <__type_traits/conditional.h>
+#include <__type_traits/integral_constant.h>
+#include <__type_traits/is_integral.h>
+#include <__type_traits/is_same.h>
+#include <__type_traits/is_signed.h>
+#include <__type_traits/make_signed.h>
+#include <__type_traits/make_unsigned.h>
+#include <__type_traits/remove_cv.h>
+#include <cstddef>
+
+#if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
+#  pragma GCC system_header
+#endif
+
+// The algorithms only use the generic vector extensions of GCC and Clang, which are lowered to scalar code on
+// targets without vector registers, so they are only enabled where they are known to pay off.
+#if __has_attribute(__vector_size__) && (defined(__SSE2__) || defined(__ARM_NEON)) &&                              \
+    !defined(_LIBCPP_HAS_NO_ALGORITHM_VECTOR_UTILS)
+#  define _LIBCPP_HAS_ALGORITHM_VECTOR_UTILS 1
+#else
+#  define _LIBCPP_HAS_ALGORITHM_VECTOR_UTILS 0
+#endif
+
+#if _LIBCPP_HAS_ALGORITHM_VECTOR_UTILS
+
+// The size of the vectors the algorithms work on, in bytes.
+#  if defined(__AVX2__)
+#    define _LIBCPP_NATIVE_SIMD_WIDTH_IN_BYTES 32
+#  else
+#    define _LIBCPP_NATIVE_SIMD_WIDTH_IN_BYTES 16
+#  endif
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+
+// The type of the lanes of the vectors holding values of type _Tp, or void if _Tp can't be vectorized. Integral
+// types are mapped to the standard integer type of the same size and signedness, so that character types like
+// wchar_t can be used as well.
+template <class _Tp, bool = is_integral<_Tp>::value && !is_same<_Tp, bool>::value && sizeof(_Tp) <= 8>
+struct __simd_lane {
+  typedef void type;
+};
+
+template <class _Tp>
+struct __simd_lane<_Tp, true> {
+  typedef typename conditional<is_signed<_Tp>::value, __make_signed_t<_Tp>, __make_unsigned_t<_Tp> >::type type;
+};
+
+template <>
+struct __simd_lane<float, false> {
+  typedef float type;
+};
+
+template <>
+struct __simd_lane<double, false> {
+  typedef double type;
+};
+
+template <class _Tp>
+using __simd_lane_t = typename __simd_lane<__remove_cv_t<_Tp> >::type;
+
+template <class _Tp>
+struct __can_vectorize : integral_constant<bool, !is_same<__simd_lane_t<_Tp>, void>::value> {};
+
+template <class _Lane>
+struct __simd_vector_impl {
+  typedef _Lane __type __attribute__((__vector_size__(_LIBCPP_NATIVE_SIMD_WIDTH_IN_BYTES)));
+};
+
+// A native vector of _Lane.
+template <class _Lane>
+using __simd_vector = typename __simd_vector_impl<_Lane>::__type;
+
+template <class _Lane>
+struct __simd_vector_size : integral_constant<size_t, _LIBCPP_NATIVE_SIMD_WIDTH_IN_BYTES / sizeof(_Lane)> {};
+
+// Loads a vector from memory that doesn't have to be aligned.
+template <class _Lane, class _Tp>
+_LIBCPP_HIDE_FROM_ABI __simd_vector<_Lane> __simd_load(const _Tp* __ptr) _NOEXCEPT {
+  __simd_vector<_Lane> __vec;
+  __builtin_memcpy(&__vec, __ptr, sizeof(__vec));
+  return __vec;
+}
+
+// Returns a vector with all lanes set to __value.
+template <class _Lane>
+_LIBCPP_HIDE_FROM_ABI __simd_vector<_Lane> __simd_broadcast(_Lane __value) _NOEXCEPT {
+  return __simd_vector<_Lane>() + __value;
+}
+
+// Returns whether any lane of __mask, the result of a comparison, is set.
+template <class _Mask>
+_LIBCPP_HIDE_FROM_ABI bool __simd_any_of(_Mask __mask) _NOEXCEPT {
+#  if defined(__AVX2__)
+  typedef char __bytes __attribute__((__vector_size__(32)));
+  return __builtin_ia32_pmovmskb256(reinterpret_cast<__bytes>(__mask)) != 0;
+#  elif defined(__SSE2__)
+  typedef char __bytes __attribute__((__vector_size__(16)));
+  return __builtin_ia32_pmovmskb128(reinterpret_cast<__bytes>(__mask)) != 0;
+#  else
+  typedef unsigned long long __words __attribute__((__vector_size__(_LIBCPP_NATIVE_SIMD_WIDTH_IN_BYTES)));
+  __words __w = reinterpret_cast<__words>(__mask);
+  unsigned long long __any = 0;
+  for (size_t __i = 0; __i != sizeof(__words) / sizeof(unsigned long long); ++__i)
+    __any |= __w[__i];
+  return __any != 0;
+#  endif
+}
+
+// Returns __mask ? __lhs : __rhs lane by lane, for vectors of integers.
+template <class _Vec, class _Mask>
+_LIBCPP_HIDE_FROM_ABI _Vec __simd_select(_Mask __mask, _Vec __lhs, _Vec __rhs) _NOEXCEPT {
+  _Vec __m = reinterpret_cast<_Vec>(__mask);
+  return (__lhs & __m) | (__rhs & ~__m);
+}
+
+_LIBCPP_END_NAMESPACE_STD
+
+#endif // _LIBCPP_HAS_ALGORITHM_VECTOR_UTILS
+
+#endif // _LIBCPP___ALGORITHM_SIMD_UTILS_H
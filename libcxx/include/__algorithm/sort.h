@@ -14,6 +14,7 @@
 #include <__algorithm/iterator_operations.h>
 #include <__algorithm/min_element.h>
 #include <__algorithm/partial_sort.h>
+#include <__algorithm/radix_sort.h>
 #include <__algorithm/unwrap_iter.h>
 #include <__bits>
 #include <__config>
@@ -23,9 +24,12 @@
 #include <__functional/ranges_operations.h>
 #include <__iterator/iterator_traits.h>
 #include <__memory/destruct_n.h>
+#include <__memory/temporary_buffer.h>
 #include <__memory/unique_ptr.h>
 #include <__utility/move.h>
+#include <__utility/pair.h>
 #include <climits>
+#include <cstdint>
 
 #if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
 #  pragma GCC system_header
@@ -314,30 +318,6 @@ void __insertion_sort(_BidirectionalIterator __first, _BidirectionalIterator __l
   }
 }
 
-template <class _AlgPolicy, class _Compare, class _RandomAccessIterator>
-_LIBCPP_HIDE_FROM_ABI
-void __insertion_sort_3(_RandomAccessIterator __first, _RandomAccessIterator __last, _Compare __comp) {
-  using _Ops = _IterOps<_AlgPolicy>;
-
-  typedef typename iterator_traits<_RandomAccessIterator>::difference_type difference_type;
-  typedef typename iterator_traits<_RandomAccessIterator>::value_type value_type;
-  _RandomAccessIterator __j = __first + difference_type(2);
-  std::__sort3_maybe_branchless<_AlgPolicy, _Compare>(__first, __first + difference_type(1), __j, __comp);
-  for (_RandomAccessIterator __i = __j + difference_type(1); __i != __last; ++__i) {
-    if (__comp(*__i, *__j)) {
-      value_type __t(_Ops::__iter_move(__i));
-      _RandomAccessIterator __k = __j;
-      __j = __i;
-      do {
-        *__j = _Ops::__iter_move(__k);
-        __j = __k;
-      } while (__j != __first && __comp(__t, *--__k));
-      *__j = std::move(__t);
-    }
-    __j = __i;
-  }
-}
-
 template <class _WrappedComp, class _RandomAccessIterator>
 _LIBCPP_HIDDEN bool __insertion_sort_incomplete(
     _RandomAccessIterator __first, _RandomAccessIterator __last, _WrappedComp __wrapped_comp) {
@@ -424,17 +404,296 @@ void __insertion_sort_move(_BidirectionalIterator __first1, _BidirectionalIterat
   }
 }
 
+// Sorts [__first, __last) with insertion sort without bounds checks in the inner loop. It assumes that there is an
+// element at __first - 1 that isn't greater than any element of the range, which holds for every part of the range to
+// sort except the leftmost one.
 template <class _AlgPolicy, class _Compare, class _RandomAccessIterator>
-void __introsort(_RandomAccessIterator __first, _RandomAccessIterator __last, _Compare __comp,
-                 typename iterator_traits<_RandomAccessIterator>::difference_type __depth) {
+_LIBCPP_HIDE_FROM_ABI
+void __insertion_sort_unguarded(_RandomAccessIterator __first, _RandomAccessIterator __last, _Compare __comp) {
+  using _Ops = _IterOps<_AlgPolicy>;
+
+  typedef typename iterator_traits<_RandomAccessIterator>::difference_type difference_type;
+  typedef typename iterator_traits<_RandomAccessIterator>::value_type value_type;
+  if (__first == __last)
+    return;
+  for (_RandomAccessIterator __i = __first + difference_type(1); __i != __last; ++__i) {
+    _RandomAccessIterator __j = __i - difference_type(1);
+    if (__comp(*__i, *__j)) {
+      value_type __t(_Ops::__iter_move(__i));
+      _RandomAccessIterator __k = __j;
+      __j = __i;
+      do {
+        *__j = _Ops::__iter_move(__k);
+        __j = __k;
+      } while (__comp(__t, *--__k)); // *(__first - 1) guards the loop
+      *__j = std::move(__t);
+    }
+  }
+}
+
+namespace __detail {
+
+// The number of elements whose comparison results are recorded in one bitset of the bitset partition.
+enum { __block_size = sizeof(uint64_t) * 8 };
+
+} // namespace __detail
+
+// Swaps the elements at the positions recorded in __left_bitset, counted forwards from __first, with those recorded in
+// __right_bitset, counted backwards from __last, until one of the bitsets is empty.
+template <class _AlgPolicy, class _RandomAccessIterator>
+inline _LIBCPP_HIDE_FROM_ABI void __swap_bitmap_pos(_RandomAccessIterator __first, _RandomAccessIterator __last,
+                                                    uint64_t& __left_bitset, uint64_t& __right_bitset) {
+  using _Ops = _IterOps<_AlgPolicy>;
+  typedef typename iterator_traits<_RandomAccessIterator>::difference_type difference_type;
+  while (__left_bitset != 0 && __right_bitset != 0) {
+    difference_type __tz_left = __libcpp_ctz(__left_bitset);
+    __left_bitset &= __left_bitset - 1;
+    difference_type __tz_right = __libcpp_ctz(__right_bitset);
+    __right_bitset &= __right_bitset - 1;
+    _Ops::iter_swap(__first + __tz_left, __last - __tz_right);
+  }
+}
+
+// Records in __left_bitset which of the __block_size elements starting at __first don't belong to the left part.
+// The loop has no branches and no dependencies between iterations, so that it can be vectorized.
+template <class _Compare, class _RandomAccessIterator,
+          class _ValueType = typename iterator_traits<_RandomAccessIterator>::value_type>
+inline _LIBCPP_HIDE_FROM_ABI void __populate_left_bitset(_RandomAccessIterator __first, _Compare __comp,
+                                                         _ValueType& __pivot, uint64_t& __left_bitset) {
+  _RandomAccessIterator __iter = __first;
+  for (int __j = 0; __j < __detail::__block_size; ++__j, (void)++__iter) {
+    bool __comp_result = !__comp(*__iter, __pivot);
+    __left_bitset |= (static_cast<uint64_t>(__comp_result) << __j);
+  }
+}
+
+// Records in __right_bitset which of the __block_size elements ending at __lm1 don't belong to the right part.
+template <class _Compare, class _RandomAccessIterator,
+          class _ValueType = typename iterator_traits<_RandomAccessIterator>::value_type>
+inline _LIBCPP_HIDE_FROM_ABI void __populate_right_bitset(_RandomAccessIterator __lm1, _Compare __comp,
+                                                          _ValueType& __pivot, uint64_t& __right_bitset) {
+  _RandomAccessIterator __iter = __lm1;
+  for (int __j = 0; __j < __detail::__block_size; ++__j, (void)--__iter) {
+    bool __comp_result = __comp(*__iter, __pivot);
+    __right_bitset |= (static_cast<uint64_t>(__comp_result) << __j);
+  }
+}
+
+// Partitions the elements of [__first, __lm1] that are left once less than two blocks remain, after which at least
+// one of the bitsets is empty.
+template <class _AlgPolicy, class _Compare, class _RandomAccessIterator,
+          class _ValueType = typename iterator_traits<_RandomAccessIterator>::value_type>
+inline _LIBCPP_HIDE_FROM_ABI void __bitset_partition_partial_blocks(
+    _RandomAccessIterator& __first, _RandomAccessIterator& __lm1, _Compare __comp, _ValueType& __pivot,
+    uint64_t& __left_bitset, uint64_t& __right_bitset) {
+  typedef typename iterator_traits<_RandomAccessIterator>::difference_type difference_type;
+  difference_type __remaining_len = __lm1 - __first + 1;
+  difference_type __l_size;
+  difference_type __r_size;
+  if (__left_bitset == 0 && __right_bitset == 0) {
+    __l_size = __remaining_len / 2;
+    __r_size = __remaining_len - __l_size;
+  } else if (__left_bitset == 0) {
+    // At least one side is a full block.
+    __l_size = __remaining_len - __detail::__block_size;
+    __r_size = __detail::__block_size;
+  } else { // __right_bitset == 0
+    __l_size = __detail::__block_size;
+    __r_size = __remaining_len - __detail::__block_size;
+  }
+  if (__left_bitset == 0) {
+    _RandomAccessIterator __iter = __first;
+    for (int __j = 0; __j < __l_size; ++__j, (void)++__iter) {
+      bool __comp_result = !__comp(*__iter, __pivot);
+      __left_bitset |= (static_cast<uint64_t>(__comp_result) << __j);
+    }
+  }
+  if (__right_bitset == 0) {
+    _RandomAccessIterator __iter = __lm1;
+    for (int __j = 0; __j < __r_size; ++__j, (void)--__iter) {
+      bool __comp_result = __comp(*__iter, __pivot);
+      __right_bitset |= (static_cast<uint64_t>(__comp_result) << __j);
+    }
+  }
+  std::__swap_bitmap_pos<_AlgPolicy, _RandomAccessIterator>(__first, __lm1, __left_bitset, __right_bitset);
+  __first += (__left_bitset == 0) ? __l_size : difference_type(0);
+  __lm1 -= (__right_bitset == 0) ? __r_size : difference_type(0);
+}
+
+// Moves the elements recorded in the one bitset that isn't empty to the other side of [__first, __lm1].
+template <class _AlgPolicy, class _RandomAccessIterator>
+inline _LIBCPP_HIDE_FROM_ABI void __swap_bitmap_pos_within(_RandomAccessIterator& __first, _RandomAccessIterator& __lm1,
+                                                           uint64_t& __left_bitset, uint64_t& __right_bitset) {
   using _Ops = _IterOps<_AlgPolicy>;
+  typedef typename iterator_traits<_RandomAccessIterator>::difference_type difference_type;
+  if (__left_bitset) {
+    // Visit the recorded positions from the last to the first one, so that the elements swapped to __lm1 are never
+    // recorded ones.
+    while (__left_bitset != 0) {
+      difference_type __tz_left = __detail::__block_size - 1 - __libcpp_clz(__left_bitset);
+      __left_bitset &= (static_cast<uint64_t>(1) << __tz_left) - 1;
+      _RandomAccessIterator __it = __first + __tz_left;
+      if (__it != __lm1)
+        _Ops::iter_swap(__it, __lm1);
+      --__lm1;
+    }
+    __first = __lm1 + difference_type(1);
+  } else if (__right_bitset) {
+    while (__right_bitset != 0) {
+      difference_type __tz_right = __detail::__block_size - 1 - __libcpp_clz(__right_bitset);
+      __right_bitset &= (static_cast<uint64_t>(1) << __tz_right) - 1;
+      _RandomAccessIterator __it = __lm1 - __tz_right;
+      if (__it != __first)
+        _Ops::iter_swap(__it, __first);
+      ++__first;
+    }
+  }
+}
 
+// Partitions [__first, __last) around the pivot stored at *__first, keeping the elements equivalent to the pivot on
+// its right. Returns the final position of the pivot, and whether the range was already partitioned. The range must
+// have at least three elements, and an element that isn't less than the pivot must be among its last three elements.
+//
+// This is the partition of BlockQuickSort (Edelkamp and Weiß, 2016): the outcomes of the comparisons for a block of
+// elements on each side are recorded in a bitset first, and the misplaced elements are swapped afterwards. This avoids
+// the branch mispredictions of Hoare's partition, so it is only used when comparisons are cheap and branchless.
+template <class _AlgPolicy, class _RandomAccessIterator, class _Compare>
+_LIBCPP_HIDE_FROM_ABI pair<_RandomAccessIterator, bool>
+__bitset_partition(_RandomAccessIterator __first, _RandomAccessIterator __last, _Compare __comp) {
+  using _Ops = _IterOps<_AlgPolicy>;
+  typedef typename iterator_traits<_RandomAccessIterator>::value_type value_type;
   typedef typename iterator_traits<_RandomAccessIterator>::difference_type difference_type;
+  const _RandomAccessIterator __begin = __first;
+  value_type __pivot(_Ops::__iter_move(__first));
+  // Find the first element greater than or equal to the pivot.
+  while (__comp(*++__first, __pivot))
+    ;
+  // Find the last element less than the pivot. The search is guarded by *(__first - 1) unless no element was skipped.
+  if (__begin == __first - difference_type(1)) {
+    while (__first < __last && !__comp(*--__last, __pivot))
+      ;
+  } else {
+    while (!__comp(*--__last, __pivot))
+      ;
+  }
+  bool __already_partitioned = __first >= __last;
+  if (!__already_partitioned) {
+    _Ops::iter_swap(__first, __last);
+    ++__first;
+  }
+
+  // From now on, [__first, __lm1] are the elements that aren't partitioned yet.
+  _RandomAccessIterator __lm1 = __last - difference_type(1);
+  uint64_t __left_bitset = 0;
+  uint64_t __right_bitset = 0;
+  while (__lm1 - __first >= 2 * __detail::__block_size - 1) {
+    if (__left_bitset == 0)
+      std::__populate_left_bitset<_Compare>(__first, __comp, __pivot, __left_bitset);
+    if (__right_bitset == 0)
+      std::__populate_right_bitset<_Compare>(__lm1, __comp, __pivot, __right_bitset);
+    std::__swap_bitmap_pos<_AlgPolicy, _RandomAccessIterator>(__first, __lm1, __left_bitset, __right_bitset);
+    // Only move past a block once all of its misplaced elements have been swapped.
+    __first += (__left_bitset == 0) ? difference_type(__detail::__block_size) : difference_type(0);
+    __lm1 -= (__right_bitset == 0) ? difference_type(__detail::__block_size) : difference_type(0);
+  }
+  std::__bitset_partition_partial_blocks<_AlgPolicy, _Compare>(
+      __first, __lm1, __comp, __pivot, __left_bitset, __right_bitset);
+  std::__swap_bitmap_pos_within<_AlgPolicy>(__first, __lm1, __left_bitset, __right_bitset);
+
+  // Move the pivot to its final position.
+  _RandomAccessIterator __pivot_pos = __first - difference_type(1);
+  if (__begin != __pivot_pos)
+    *__begin = _Ops::__iter_move(__pivot_pos);
+  *__pivot_pos = std::move(__pivot);
+  return std::make_pair(__pivot_pos, __already_partitioned);
+}
+
+// Partitions [__first, __last) around the pivot stored at *__first with Hoare's scheme, keeping the elements
+// equivalent to the pivot on its right. It has the same contract as __bitset_partition.
+template <class _AlgPolicy, class _RandomAccessIterator, class _Compare>
+_LIBCPP_HIDE_FROM_ABI pair<_RandomAccessIterator, bool>
+__partition_with_equals_on_right(_RandomAccessIterator __first, _RandomAccessIterator __last, _Compare __comp) {
+  using _Ops = _IterOps<_AlgPolicy>;
   typedef typename iterator_traits<_RandomAccessIterator>::value_type value_type;
-  const difference_type __limit =
-      is_trivially_copy_constructible<value_type>::value && is_trivially_copy_assignable<value_type>::value ? 30 : 6;
+  typedef typename iterator_traits<_RandomAccessIterator>::difference_type difference_type;
+  const _RandomAccessIterator __begin = __first;
+  value_type __pivot(_Ops::__iter_move(__first));
+  while (__comp(*++__first, __pivot))
+    ;
+  if (__begin == __first - difference_type(1)) {
+    while (__first < __last && !__comp(*--__last, __pivot))
+      ;
+  } else {
+    while (!__comp(*--__last, __pivot))
+      ;
+  }
+  bool __already_partitioned = __first >= __last;
+  // Swap the pairs of elements that are on the wrong side; each swapped pair guards the next searches.
+  while (__first < __last) {
+    _Ops::iter_swap(__first, __last);
+    while (__comp(*++__first, __pivot))
+      ;
+    while (!__comp(*--__last, __pivot))
+      ;
+  }
+  _RandomAccessIterator __pivot_pos = __first - difference_type(1);
+  if (__begin != __pivot_pos)
+    *__begin = _Ops::__iter_move(__pivot_pos);
+  *__pivot_pos = std::move(__pivot);
+  return std::make_pair(__pivot_pos, __already_partitioned);
+}
+
+// Partitions [__first, __last) around the pivot stored at *__first, keeping the elements equivalent to the pivot on
+// its left. Returns the position after the pivot.
+template <class _AlgPolicy, class _RandomAccessIterator, class _Compare>
+_LIBCPP_HIDE_FROM_ABI _RandomAccessIterator
+__partition_with_equals_on_left(_RandomAccessIterator __first, _RandomAccessIterator __last, _Compare __comp) {
+  using _Ops = _IterOps<_AlgPolicy>;
+  typedef typename iterator_traits<_RandomAccessIterator>::value_type value_type;
+  typedef typename iterator_traits<_RandomAccessIterator>::difference_type difference_type;
+  const _RandomAccessIterator __begin = __first;
+  value_type __pivot(_Ops::__iter_move(__first));
+  if (__comp(__pivot, *(__last - difference_type(1)))) {
+    // Guarded by the last element.
+    while (!__comp(__pivot, *++__first))
+      ;
+  } else {
+    while (++__first < __last && !__comp(__pivot, *__first))
+      ;
+  }
+  if (__first < __last) {
+    // Guarded by the pivot at *__begin.
+    while (__comp(__pivot, *--__last))
+      ;
+  }
+  while (__first < __last) {
+    _Ops::iter_swap(__first, __last);
+    while (!__comp(__pivot, *++__first))
+      ;
+    while (__comp(__pivot, *--__last))
+      ;
+  }
+  _RandomAccessIterator __pivot_pos = __first - difference_type(1);
+  if (__begin != __pivot_pos)
+    *__begin = _Ops::__iter_move(__pivot_pos);
+  *__pivot_pos = std::move(__pivot);
+  return __first;
+}
+
+// Sorts [__first, __last) with introsort. __leftmost tells whether the range is the leftmost part of the range being
+// sorted; otherwise, the element before it isn't greater than any of its elements. _UseBitSetPartition selects the
+// BlockQuickSort partition instead of Hoare's.
+template <class _AlgPolicy, class _Compare, class _RandomAccessIterator, bool _UseBitSetPartition>
+void __introsort(_RandomAccessIterator __first, _RandomAccessIterator __last, _Compare __comp,
+                 typename iterator_traits<_RandomAccessIterator>::difference_type __depth, bool __leftmost = true) {
+  using _Ops = _IterOps<_AlgPolicy>;
+
+  typedef typename iterator_traits<_RandomAccessIterator>::difference_type difference_type;
+  // Ranges shorter than this are sorted with insertion sort.
+  const difference_type __limit = 24;
+  // Ranges longer than this use Tukey's ninther as the pivot instead of the median of three.
+  const difference_type __ninther_threshold = 128;
   while (true) {
-  __restart:
     difference_type __len = __last - __first;
     switch (__len) {
     case 0:
@@ -442,7 +701,7 @@ void __introsort(_RandomAccessIterator __first, _RandomAccessIterator __last, _C
       return;
     case 2:
       if (__comp(*--__last, *__first))
-        _IterOps<_AlgPolicy>::iter_swap(__first, __last);
+        _Ops::iter_swap(__first, __last);
       return;
     case 3:
       std::__sort3_maybe_branchless<_AlgPolicy, _Compare>(__first, __first + difference_type(1), --__last, __comp);
@@ -457,127 +716,51 @@ void __introsort(_RandomAccessIterator __first, _RandomAccessIterator __last, _C
           --__last, __comp);
       return;
     }
-    if (__len <= __limit) {
-      std::__insertion_sort_3<_AlgPolicy, _Compare>(__first, __last, __comp);
+    if (__len < __limit) {
+      if (__leftmost)
+        std::__insertion_sort<_AlgPolicy, _Compare>(__first, __last, __comp);
+      else
+        std::__insertion_sort_unguarded<_AlgPolicy, _Compare>(__first, __last, __comp);
       return;
     }
-    // __len > 5
     if (__depth == 0) {
       // Fallback to heap sort as Introsort suggests.
       std::__partial_sort<_AlgPolicy, _Compare>(__first, __last, __last, __comp);
       return;
     }
     --__depth;
-    _RandomAccessIterator __m = __first;
-    _RandomAccessIterator __lm1 = __last;
-    --__lm1;
-    unsigned __n_swaps;
     {
-      difference_type __delta;
-      if (__len >= 1000) {
-        __delta = __len / 2;
-        __m += __delta;
-        __delta /= 2;
-        __n_swaps = std::__sort5_wrap_policy<_AlgPolicy, _Compare>(
-            __first, __first + __delta, __m, __m + __delta, __lm1, __comp);
+      // Move the pivot to *__first. Either way, one of the last three elements isn't less than the pivot.
+      difference_type __half_len = __len / 2;
+      if (__len > __ninther_threshold) {
+        std::__sort3<_AlgPolicy, _Compare>(__first, __first + __half_len, __last - difference_type(1), __comp);
+        std::__sort3<_AlgPolicy, _Compare>(
+            __first + difference_type(1), __first + (__half_len - 1), __last - difference_type(2), __comp);
+        std::__sort3<_AlgPolicy, _Compare>(
+            __first + difference_type(2), __first + (__half_len + 1), __last - difference_type(3), __comp);
+        std::__sort3<_AlgPolicy, _Compare>(
+            __first + (__half_len - 1), __first + __half_len, __first + (__half_len + 1), __comp);
+        _Ops::iter_swap(__first, __first + __half_len);
       } else {
-        __delta = __len / 2;
-        __m += __delta;
-        __n_swaps = std::__sort3<_AlgPolicy, _Compare>(__first, __m, __lm1, __comp);
+        std::__sort3<_AlgPolicy, _Compare>(__first + __half_len, __first, __last - difference_type(1), __comp);
       }
     }
-    // *__m is median
-    // partition [__first, __m) < *__m and *__m <= [__m, __last)
-    // (this inhibits tossing elements equivalent to __m around unnecessarily)
-    _RandomAccessIterator __i = __first;
-    _RandomAccessIterator __j = __lm1;
-    // j points beyond range to be tested, *__m is known to be <= *__lm1
-    // The search going up is known to be guarded but the search coming down isn't.
-    // Prime the downward search with a guard.
-    if (!__comp(*__i, *__m)) // if *__first == *__m
-    {
-      // *__first == *__m, *__first doesn't go in first part
-      // manually guard downward moving __j against __i
-      while (true) {
-        if (__i == --__j) {
-          // *__first == *__m, *__m <= all other elements
-          // Parition instead into [__first, __i) == *__first and *__first < [__i, __last)
-          ++__i; // __first + 1
-          __j = __last;
-          if (!__comp(*__first, *--__j)) // we need a guard if *__first == *(__last-1)
-          {
-            while (true) {
-              if (__i == __j)
-                return; // [__first, __last) all equivalent elements
-              if (__comp(*__first, *__i)) {
-                _Ops::iter_swap(__i, __j);
-                ++__n_swaps;
-                ++__i;
-                break;
-              }
-              ++__i;
-            }
-          }
-          // [__first, __i) == *__first and *__first < [__j, __last) and __j == __last - 1
-          if (__i == __j)
-            return;
-          while (true) {
-            while (!__comp(*__first, *__i))
-              ++__i;
-            while (__comp(*__first, *--__j))
-              ;
-            if (__i >= __j)
-              break;
-            _Ops::iter_swap(__i, __j);
-            ++__n_swaps;
-            ++__i;
-          }
-          // [__first, __i) == *__first and *__first < [__i, __last)
-          // The first part is sorted, sort the second part
-          // std::__sort<_Compare>(__i, __last, __comp);
-          __first = __i;
-          goto __restart;
-        }
-        if (__comp(*__j, *__m)) {
-          _Ops::iter_swap(__i, __j);
-          ++__n_swaps;
-          break; // found guard for downward moving __j, now use unguarded partition
-        }
-      }
-    }
-    // It is known that *__i < *__m
-    ++__i;
-    // j points beyond range to be tested, *__m is known to be <= *__lm1
-    // if not yet partitioned...
-    if (__i < __j) {
-      // known that *(__i - 1) < *__m
-      // known that __i <= __m
-      while (true) {
-        // __m still guards upward moving __i
-        while (__comp(*__i, *__m))
-          ++__i;
-        // It is now known that a guard exists for downward moving __j
-        while (!__comp(*--__j, *__m))
-          ;
-        if (__i > __j)
-          break;
-        _Ops::iter_swap(__i, __j);
-        ++__n_swaps;
-        // It is known that __m != __j
-        // If __m just moved, follow it
-        if (__m == __i)
-          __m = __j;
-        ++__i;
-      }
-    }
-    // [__first, __i) < *__m and *__m <= [__i, __last)
-    if (__i != __m && __comp(*__m, *__i)) {
-      _Ops::iter_swap(__i, __m);
-      ++__n_swaps;
+    // If the pivot is equivalent to the element before the range, which isn't greater than any element of the range,
+    // all the elements that aren't greater than the pivot are equivalent and already in their final place.
+    if (!__leftmost && !__comp(*(__first - difference_type(1)), *__first)) {
+      __first = std::__partition_with_equals_on_left<_AlgPolicy, _RandomAccessIterator, _Compare>(
+          __first, __last, __comp);
+      continue;
     }
+    pair<_RandomAccessIterator, bool> __ret =
+        _UseBitSetPartition
+            ? std::__bitset_partition<_AlgPolicy, _RandomAccessIterator, _Compare>(__first, __last, __comp)
+            : std::__partition_with_equals_on_right<_AlgPolicy, _RandomAccessIterator, _Compare>(
+                  __first, __last, __comp);
+    _RandomAccessIterator __i = __ret.first;
     // [__first, __i) < *__i and *__i <= [__i+1, __last)
     // If we were given a perfect partition, see if insertion sort is quick...
-    if (__n_swaps == 0) {
+    if (__ret.second) {
       using _WrappedComp = typename _WrapAlgPolicy<_AlgPolicy, _Compare>::type;
       _WrappedComp __wrapped_comp(__comp);
       bool __fs = std::__insertion_sort_incomplete<_WrappedComp>(__first, __i, __wrapped_comp);
@@ -593,14 +776,11 @@ void __introsort(_RandomAccessIterator __first, _RandomAccessIterator __last, _C
         }
       }
     }
-    // sort smaller range with recursive call and larger with tail recursion elimination
-    if (__i - __first < __last - __i) {
-      std::__introsort<_AlgPolicy, _Compare>(__first, __i, __comp, __depth);
-      __first = ++__i;
-    } else {
-      std::__introsort<_AlgPolicy, _Compare>(__i + difference_type(1), __last, __comp, __depth);
-      __last = __i;
-    }
+    // Sort the left part with a recursive call and the right part with tail recursion elimination.
+    std::__introsort<_AlgPolicy, _Compare, _RandomAccessIterator, _UseBitSetPartition>(
+        __first, __i, __comp, __depth, __leftmost);
+    __leftmost = false;
+    __first = ++__i;
   }
 }
 
@@ -632,7 +812,10 @@ _LIBCPP_HIDDEN void __sort(_RandomAccessIterator __first, _RandomAccessIterator
   using _AlgPolicy = typename _Unwrap::_AlgPolicy;
   using _Compare = typename _Unwrap::_Comp;
   _Compare __comp = _Unwrap::__get_comp(__wrapped_comp);
-  std::__introsort<_AlgPolicy, _Compare>(__first, __last, __comp, __depth_limit);
+  // The bitset partition only pays off when comparisons don't branch.
+  std::__introsort<_AlgPolicy, _Compare, _RandomAccessIterator,
+                   __use_branchless_sort<_Compare, _RandomAccessIterator>::value>(
+      __first, __last, __comp, __depth_limit);
 }
 
 template <class _Compare, class _Tp>
@@ -679,6 +862,82 @@ extern template _LIBCPP_FUNC_VIS bool __insertion_sort_incomplete<__less<long do
 
 extern template _LIBCPP_FUNC_VIS unsigned __sort5<__less<long double>&, long double*>(long double*, long double*, long double*, long double*, long double*, __less<long double>&);
 
+// Radix sorts [__first, __last) using __buffer, which must have room for as many elements. Ranges that don't fit in the
+// cache are first distributed into __buffer by their most significant byte that isn't the same in all the elements;
+// then each part is sorted on the lower bytes, or with introsort if it is short.
+template <class _Tp>
+_LIBCPP_HIDE_FROM_ABI void __radix_sort(_Tp* __first, _Tp* __last, _Tp* __buffer) {
+  const size_t __len = static_cast<size_t>(__last - __first);
+  size_t __counts[sizeof(_Tp)][__radix_sort_radix] = {};
+  std::__radix_sort_count(__first, __last, sizeof(_Tp), __counts);
+  if (__len * sizeof(_Tp) <= __radix_sort_cache_size) {
+    _Tp* __result = std::__radix_sort_lsd(__first, __last, __buffer, sizeof(_Tp), __counts);
+    if (__result != __first)
+      __builtin_memcpy(__first, __result, __len * sizeof(_Tp));
+    return;
+  }
+
+  size_t __top = sizeof(_Tp);
+  while (__counts[__top - 1][std::__radix_digit(*__first, __top - 1)] == __len) {
+    if (--__top == 0)
+      return; // All the elements are equal.
+  }
+  --__top;
+  size_t __starts[__radix_sort_radix + 1];
+  size_t __offsets[__radix_sort_radix];
+  __starts[0] = 0;
+  for (size_t __d = 0; __d != __radix_sort_radix; ++__d) {
+    __offsets[__d] = __starts[__d];
+    __starts[__d + 1] = __starts[__d] + __counts[__top][__d];
+  }
+  for (_Tp* __i = __first; __i != __last; ++__i)
+    __buffer[__offsets[std::__radix_digit(*__i, __top)]++] = *__i;
+
+  __less<_Tp> __comp;
+  for (size_t __d = 0; __d != __radix_sort_radix; ++__d) {
+    _Tp* __part = __buffer + __starts[__d];
+    _Tp* __part_end = __buffer + __starts[__d + 1];
+    _Tp* __dest = __first + __starts[__d];
+    size_t __part_len = static_cast<size_t>(__part_end - __part);
+    if (__part_len < static_cast<size_t>(__radix_sort_threshold<_Tp>::value)) {
+      __builtin_memcpy(__dest, __part, __part_len * sizeof(_Tp));
+      std::__sort<__less<_Tp>&, _Tp*>(__dest, __dest + __part_len, __comp);
+      continue;
+    }
+    for (size_t __digit = 0; __digit != __top; ++__digit) {
+      for (size_t __v = 0; __v != __radix_sort_radix; ++__v)
+        __counts[__digit][__v] = 0;
+    }
+    std::__radix_sort_count(__part, __part_end, __top, __counts);
+    _Tp* __result = std::__radix_sort_lsd(__part, __part_end, __dest, __top, __counts);
+    if (__result != __dest)
+      __builtin_memcpy(__dest, __result, __part_len * sizeof(_Tp));
+  }
+}
+
+// Radix sorts [__first, __last) if it can be and is long enough, and returns whether it did so. The range is left
+// untouched if the buffer for the radix sort can't be allocated.
+template <class _Comp, class _Iter>
+inline _LIBCPP_HIDE_FROM_ABI bool __radix_sort_if_profitable(_Iter, _Iter, _Comp&) {
+  return false;
+}
+
+template <class _Comp, class _Tp>
+inline _LIBCPP_HIDE_FROM_ABI __enable_if_t<__use_radix_sort<_Comp, _Tp>::value, bool>
+__radix_sort_if_profitable(_Tp* __first, _Tp* __last, _Comp&) {
+  ptrdiff_t __len = __last - __first;
+  if (__len < __radix_sort_threshold<_Tp>::value)
+    return false;
+_LIBCPP_SUPPRESS_DEPRECATED_PUSH
+  pair<_Tp*, ptrdiff_t> __buf = std::get_temporary_buffer<_Tp>(__len);
+_LIBCPP_SUPPRESS_DEPRECATED_POP
+  unique_ptr<_Tp, __return_temporary_buffer> __h(__buf.first);
+  if (__buf.second < __len)
+    return false;
+  std::__radix_sort(__first, __last, __buf.first);
+  return true;
+}
+
 template <class _AlgPolicy, class _RandomAccessIterator, class _Comp>
 inline _LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX20
 void __sort_impl(_RandomAccessIterator __first, _RandomAccessIterator __last, _Comp& __comp) {
@@ -688,7 +947,7 @@ void __sort_impl(_RandomAccessIterator __first, _RandomAccessIterator __last, _C
   if (__libcpp_is_constant_evaluated()) {
     std::__partial_sort<_AlgPolicy>(__first, __last, __last, __comp);
 
-  } else {
+  } else if (!std::__radix_sort_if_profitable(std::__unwrap_iter(__first), std::__unwrap_iter(__last), __comp)) {
     using _WrappedComp = typename _WrapAlgPolicy<_AlgPolicy, _Comp_ref>::type;
     _Comp_ref __comp_ref(__comp);
     _WrappedComp __wrapped_comp(__comp_ref);
@@ -34,6 +34,7 @@
 #include <__format/formatter_char.h>
 #include <__format/formatter_floating_point.h>
 #include <__format/formatter_integer.h>
+#include <__format/formatter_output.h>
 #include <__format/formatter_pointer.h>
 #include <__format/formatter_string.h>
 #include <__format/parser_std_format_spec.h>
@@ -107,6 +108,56 @@ private:
   void (*__parse_)(basic_format_parse_context<_CharT>&);
 };
 
+/// The location of a replacement field in a format string.
+///
+/// The offsets are relative to the start of the format string.
+struct __replacement_field {
+  size_t __begin_;   // The opening '{'.
+  size_t __arg_end_; // The ':' before the format-spec, or the closing '}'.
+  size_t __end_;     // The character after the closing '}'.
+  size_t __arg_id_;
+};
+
+/// Records the replacement fields of a basic_format_string while it's validated.
+///
+/// The replacement fields are stored in the basic_format_string, so that
+/// formatting with it doesn't need to parse the format string again.
+template <class _CharT>
+struct _LIBCPP_TEMPLATE_VIS __replacement_field_recorder {
+  const _CharT* __str_;
+  __replacement_field* __fields_;
+  size_t __capacity_;
+  size_t __size_ = 0;
+  // Whether there are more replacement fields than fit in __fields_.
+  bool __overflow_ = false;
+  // Whether the literal text contains escaped braces.
+  bool __escapes_ = false;
+  bool __automatic_ = false;
+
+  _LIBCPP_HIDE_FROM_ABI constexpr void
+  __record(const _CharT* __begin, const _CharT* __arg_end, const _CharT* __end, size_t __arg_id, bool __automatic) {
+    __automatic_ = __automatic;
+    if (__size_ == __capacity_) {
+      __overflow_ = true;
+      return;
+    }
+    __fields_[__size_++] = {static_cast<size_t>(__begin - __str_), static_cast<size_t>(__arg_end - __str_),
+                            static_cast<size_t>(__end - __str_), __arg_id};
+  }
+};
+
+/// The replacement fields of a basic_format_string.
+struct __replacement_fields {
+  static constexpr size_t __unknown = size_t(-1);
+
+  const __replacement_field* __data_ = nullptr;
+  // __unknown when the format string needs to be parsed while formatting.
+  size_t __size_ = __unknown;
+  // Whether the literal text contains escaped braces.
+  bool __escapes_ = false;
+  bool __automatic_ = false;
+};
+
 // Dummy format_context only providing the parts used during constant
 // validation of the basic_format_string.
 template <class _CharT>
@@ -115,8 +166,11 @@ public:
   using char_type = _CharT;
 
   _LIBCPP_HIDE_FROM_ABI constexpr explicit __compile_time_basic_format_context(
-      const __arg_t* __args, const __compile_time_handle<_CharT>* __handles, size_t __size)
-      : __args_(__args), __handles_(__handles), __size_(__size) {}
+      const __arg_t* __args,
+      const __compile_time_handle<_CharT>* __handles,
+      size_t __size,
+      __replacement_field_recorder<_CharT>* __recorder = nullptr)
+      : __args_(__args), __handles_(__handles), __size_(__size), __recorder_(__recorder) {}
 
   // During the compile-time validation nothing needs to be written.
   // Therefore all operations of this iterator are a NOP.
@@ -141,10 +195,13 @@ public:
   _LIBCPP_HIDE_FROM_ABI constexpr iterator out() { return {}; }
   _LIBCPP_HIDE_FROM_ABI constexpr void advance_to(iterator) {}
 
+  _LIBCPP_HIDE_FROM_ABI constexpr __replacement_field_recorder<_CharT>* __recorder() const { return __recorder_; }
+
 private:
   const __arg_t* __args_;
   const __compile_time_handle<_CharT>* __handles_;
   size_t __size_;
+  __replacement_field_recorder<_CharT>* __recorder_;
 };
 
 _LIBCPP_HIDE_FROM_ABI
@@ -235,6 +292,27 @@ _LIBCPP_HIDE_FROM_ABI constexpr void __compile_time_visit_format_arg(basic_forma
   __throw_format_error("Invalid argument");
 }
 
+/// Parses the format-spec of a replacement field, if it has one, and formats
+/// its argument.
+template <class _ParseCtx, class _Ctx>
+_LIBCPP_HIDE_FROM_ABI void __format_replacement_field(
+    bool __parse, _ParseCtx& __parse_ctx, _Ctx& __ctx, basic_format_arg<_Ctx> __format_arg) {
+  _VSTD::visit_format_arg(
+      [&](auto __arg) {
+        if constexpr (same_as<decltype(__arg), monostate>)
+          __throw_format_error("Argument index out of bounds");
+        else if constexpr (same_as<decltype(__arg), typename basic_format_arg<_Ctx>::handle>)
+          __arg.format(__parse_ctx, __ctx);
+        else {
+          formatter<decltype(__arg), typename _ParseCtx::char_type> __formatter;
+          if (__parse)
+            __parse_ctx.advance_to(__formatter.parse(__parse_ctx));
+          __ctx.advance_to(__formatter.format(__arg, __ctx));
+        }
+      },
+      __format_arg);
+}
+
 template <class _CharT, class _ParseCtx, class _Ctx>
 _LIBCPP_HIDE_FROM_ABI constexpr const _CharT*
 __handle_replacement_field(const _CharT* __begin, const _CharT* __end,
@@ -263,26 +341,25 @@ __handle_replacement_field(const _CharT* __begin, const _CharT* __end,
     else
         __format::__compile_time_visit_format_arg(__parse_ctx, __ctx, __type);
   } else
-    _VSTD::visit_format_arg(
-        [&](auto __arg) {
-          if constexpr (same_as<decltype(__arg), monostate>)
-            __throw_format_error("Argument index out of bounds");
-          else if constexpr (same_as<decltype(__arg), typename basic_format_arg<_Ctx>::handle>)
-            __arg.format(__parse_ctx, __ctx);
-          else {
-            formatter<decltype(__arg), _CharT> __formatter;
-            if (__parse)
-              __parse_ctx.advance_to(__formatter.parse(__parse_ctx));
-            __ctx.advance_to(__formatter.format(__arg, __ctx));
-          }
-        },
-        __ctx.arg(__r.__value));
-
-  __begin = __parse_ctx.begin();
-  if (__begin == __end || *__begin != _CharT('}'))
+    __format::__format_replacement_field(__parse, __parse_ctx, __ctx, __ctx.arg(__r.__value));
+
+  const _CharT* __field_end = __parse_ctx.begin();
+  if (__field_end == __end || *__field_end != _CharT('}'))
     __throw_format_error("The replacement field misses a terminating '}'");
+  ++__field_end;
+
+  if constexpr (same_as<_Ctx, __compile_time_basic_format_context<_CharT>>)
+    if (__ctx.__recorder())
+      __ctx.__recorder()->__record(__begin - 1, __r.__ptr, __field_end, __r.__value, __r.__ptr == __begin);
 
-  return ++__begin;
+  return __field_end;
+}
+
+template <class _Ctx>
+_LIBCPP_HIDE_FROM_ABI constexpr void __record_escape(_Ctx& __ctx) {
+  if constexpr (same_as<_Ctx, __compile_time_basic_format_context<typename _Ctx::char_type>>)
+    if (__ctx.__recorder())
+      __ctx.__recorder()->__escapes_ = true;
 }
 
 template <class _ParseCtx, class _Ctx>
@@ -312,6 +389,7 @@ __vformat_to(_ParseCtx&& __parse_ctx, _Ctx&& __ctx) {
         continue;
       }
       // The string is an escape character.
+      __format::__record_escape(__ctx);
       break;
 
     case _CharT('}'):
@@ -320,6 +398,7 @@ __vformat_to(_ParseCtx&& __parse_ctx, _Ctx&& __ctx) {
         __throw_format_error(
             "The format string contains an invalid escape sequence");
 
+      __format::__record_escape(__ctx);
       break;
     }
 
@@ -329,6 +408,57 @@ __vformat_to(_ParseCtx&& __parse_ctx, _Ctx&& __ctx) {
   return __out_it;
 }
 
+/// Copies the literal text [__begin, __end) of a validated format string.
+template <class _CharT, class _OutIt>
+_LIBCPP_HIDE_FROM_ABI _OutIt
+__copy_literal_text(const _CharT* __begin, const _CharT* __end, bool __escapes, _OutIt __out_it) {
+  if (!__escapes)
+    return __formatter::__copy(__begin, __end, _VSTD::move(__out_it));
+
+  while (__begin != __end) {
+    // The validation guarantees braces in the literal text are doubled.
+    if (*__begin == _CharT('{') || *__begin == _CharT('}'))
+      ++__begin;
+    *__out_it++ = *__begin++;
+  }
+  return __out_it;
+}
+
+/// Formats using the replacement fields recorded during the compile-time
+/// validation of the format string.
+///
+/// Unlike __vformat_to this doesn't scan the literal text or parse the
+/// arg-ids, it only invokes the parser of the format-spec of the formatters.
+template <class _ParseCtx, class _Ctx>
+_LIBCPP_HIDE_FROM_ABI typename _Ctx::iterator
+__vformat_to(_ParseCtx&& __parse_ctx, _Ctx&& __ctx, __replacement_fields __fields) {
+  if (__fields.__size_ == __replacement_fields::__unknown)
+    return __format::__vformat_to(_VSTD::move(__parse_ctx), _VSTD::move(__ctx));
+
+  using _CharT = typename _ParseCtx::char_type;
+  const _CharT* __str = __parse_ctx.begin();
+  const _CharT* __text = __str;
+  for (const __replacement_field* __field = __fields.__data_; __field != __fields.__data_ + __fields.__size_;
+       ++__field) {
+    __ctx.advance_to(
+        __format::__copy_literal_text(__text, __str + __field->__begin_, __fields.__escapes_, __ctx.out()));
+
+    // Keep the argument numbering of the parse context up to date, nested
+    // replacement fields in the format-spec depend on it.
+    if (__fields.__automatic_)
+      (void)__parse_ctx.next_arg_id();
+    else
+      __parse_ctx.check_arg_id(__field->__arg_id_);
+
+    const _CharT* __arg_end = __str + __field->__arg_end_;
+    bool __parse = *__arg_end == _CharT(':');
+    __parse_ctx.advance_to(__parse ? __arg_end + 1 : __arg_end);
+    __format::__format_replacement_field(__parse, __parse_ctx, __ctx, __ctx.arg(__field->__arg_id_));
+    __text = __str + __field->__end_;
+  }
+  return __format::__copy_literal_text(__text, __parse_ctx.end(), __fields.__escapes_, __ctx.out());
+}
+
 } // namespace __format
 
 template <class _CharT, class... _Args>
@@ -336,17 +466,34 @@ struct _LIBCPP_TEMPLATE_VIS basic_format_string {
   template <class _Tp>
     requires convertible_to<const _Tp&, basic_string_view<_CharT>>
   consteval basic_format_string(const _Tp& __str) : __str_{__str} {
+    __format::__replacement_field_recorder<_CharT> __recorder{__str_.data(), __fields_.data(), __fields_.size()};
     __format::__vformat_to(basic_format_parse_context<_CharT>{__str_, sizeof...(_Args)},
-                           _Context{__types_.data(), __handles_.data(), sizeof...(_Args)});
+                           _Context{__types_.data(), __handles_.data(), sizeof...(_Args), &__recorder});
+    if (!__recorder.__overflow_)
+      __num_fields_ = __recorder.__size_;
+    __escapes_ = __recorder.__escapes_;
+    __automatic_ = __recorder.__automatic_;
   }
 
   _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT constexpr basic_string_view<_CharT> get() const noexcept {
     return __str_;
   }
 
+  // The replacement fields recorded during the validation.
+  _LIBCPP_HIDE_FROM_ABI constexpr __format::__replacement_fields __fields() const noexcept {
+    return {__fields_.data(), __num_fields_, __escapes_, __automatic_};
+  }
+
 private:
   basic_string_view<_CharT> __str_;
 
+  // The replacement fields, as long as there are no more of them than
+  // arguments, which is the case for the typical format string.
+  array<__format::__replacement_field, sizeof...(_Args)> __fields_{};
+  size_t __num_fields_ = __format::__replacement_fields::__unknown;
+  bool __escapes_ = false;
+  bool __automatic_ = false;
+
   using _Context = __format::__compile_time_basic_format_context<_CharT>;
 
   static constexpr array<__format::__arg_t, sizeof...(_Args)> __types_{
@@ -389,14 +536,15 @@ template <class _OutIt, class _CharT, class _FormatOutIt>
 requires(output_iterator<_OutIt, const _CharT&>) _LIBCPP_HIDE_FROM_ABI _OutIt
     __vformat_to(
         _OutIt __out_it, basic_string_view<_CharT> __fmt,
-        basic_format_args<basic_format_context<_FormatOutIt, _CharT>> __args) {
+        basic_format_args<basic_format_context<_FormatOutIt, _CharT>> __args,
+        __format::__replacement_fields __fields = {}) {
   if constexpr (same_as<_OutIt, _FormatOutIt>)
     return _VSTD::__format::__vformat_to(basic_format_parse_context{__fmt, __args.__size()},
-                                         _VSTD::__format_context_create(_VSTD::move(__out_it), __args));
+                                         _VSTD::__format_context_create(_VSTD::move(__out_it), __args), __fields);
   else {
     __format::__format_buffer<_OutIt, _CharT> __buffer{_VSTD::move(__out_it)};
     _VSTD::__format::__vformat_to(basic_format_parse_context{__fmt, __args.__size()},
-                                  _VSTD::__format_context_create(__buffer.__make_output_iterator(), __args));
+                                  _VSTD::__format_context_create(__buffer.__make_output_iterator(), __args), __fields);
     return _VSTD::move(__buffer).__out_it();
   }
 }
@@ -421,16 +569,16 @@ vformat_to(_OutIt __out_it, wstring_view __fmt, wformat_args __args) {
 template <output_iterator<const char&> _OutIt, class... _Args>
 _LIBCPP_ALWAYS_INLINE _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT _OutIt
 format_to(_OutIt __out_it, format_string<_Args...> __fmt, _Args&&... __args) {
-  return _VSTD::vformat_to(_VSTD::move(__out_it), __fmt.get(),
-                           _VSTD::make_format_args(__args...));
+  return _VSTD::__vformat_to(
+      _VSTD::move(__out_it), __fmt.get(), format_args(_VSTD::make_format_args(__args...)), __fmt.__fields());
 }
 
 #ifndef _LIBCPP_HAS_NO_WIDE_CHARACTERS
 template <output_iterator<const wchar_t&> _OutIt, class... _Args>
 _LIBCPP_ALWAYS_INLINE _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT _OutIt
 format_to(_OutIt __out_it, wformat_string<_Args...> __fmt, _Args&&... __args) {
-  return _VSTD::vformat_to(_VSTD::move(__out_it), __fmt.get(),
-                           _VSTD::make_wformat_args(__args...));
+  return _VSTD::__vformat_to(
+      _VSTD::move(__out_it), __fmt.get(), wformat_args(_VSTD::make_wformat_args(__args...)), __fmt.__fields());
 }
 #endif
 
@@ -453,31 +601,39 @@ vformat(wstring_view __fmt, wformat_args __args) {
 template <class... _Args>
 _LIBCPP_ALWAYS_INLINE _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT string format(format_string<_Args...> __fmt,
                                                                                       _Args&&... __args) {
-  return _VSTD::vformat(__fmt.get(), _VSTD::make_format_args(__args...));
+  string __res;
+  _VSTD::__vformat_to(
+      _VSTD::back_inserter(__res), __fmt.get(), format_args(_VSTD::make_format_args(__args...)), __fmt.__fields());
+  return __res;
 }
 
 #ifndef _LIBCPP_HAS_NO_WIDE_CHARACTERS
 template <class... _Args>
 _LIBCPP_ALWAYS_INLINE _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT wstring
 format(wformat_string<_Args...> __fmt, _Args&&... __args) {
-  return _VSTD::vformat(__fmt.get(), _VSTD::make_wformat_args(__args...));
+  wstring __res;
+  _VSTD::__vformat_to(
+      _VSTD::back_inserter(__res), __fmt.get(), wformat_args(_VSTD::make_wformat_args(__args...)), __fmt.__fields());
+  return __res;
 }
 #endif
 
 template <class _Context, class _OutIt, class _CharT>
 _LIBCPP_HIDE_FROM_ABI format_to_n_result<_OutIt> __vformat_to_n(_OutIt __out_it, iter_difference_t<_OutIt> __n,
                                                                 basic_string_view<_CharT> __fmt,
-                                                                basic_format_args<_Context> __args) {
+                                                                basic_format_args<_Context> __args,
+                                                                __format::__replacement_fields __fields = {}) {
   __format::__format_to_n_buffer<_OutIt, _CharT> __buffer{_VSTD::move(__out_it), __n};
   _VSTD::__format::__vformat_to(basic_format_parse_context{__fmt, __args.__size()},
-                                _VSTD::__format_context_create(__buffer.__make_output_iterator(), __args));
+                                _VSTD::__format_context_create(__buffer.__make_output_iterator(), __args), __fields);
   return _VSTD::move(__buffer).__result();
 }
 
 template <output_iterator<const char&> _OutIt, class... _Args>
 _LIBCPP_ALWAYS_INLINE _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT format_to_n_result<_OutIt>
 format_to_n(_OutIt __out_it, iter_difference_t<_OutIt> __n, format_string<_Args...> __fmt, _Args&&... __args) {
-  return _VSTD::__vformat_to_n<format_context>(_VSTD::move(__out_it), __n, __fmt.get(), _VSTD::make_format_args(__args...));
+  return _VSTD::__vformat_to_n<format_context>(
+      _VSTD::move(__out_it), __n, __fmt.get(), _VSTD::make_format_args(__args...), __fmt.__fields());
 }
 
 #ifndef _LIBCPP_HAS_NO_WIDE_CHARACTERS
@@ -485,29 +641,33 @@ template <output_iterator<const wchar_t&> _OutIt, class... _Args>
 _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT format_to_n_result<_OutIt>
 format_to_n(_OutIt __out_it, iter_difference_t<_OutIt> __n, wformat_string<_Args...> __fmt,
             _Args&&... __args) {
-  return _VSTD::__vformat_to_n<wformat_context>(_VSTD::move(__out_it), __n, __fmt.get(), _VSTD::make_wformat_args(__args...));
+  return _VSTD::__vformat_to_n<wformat_context>(
+      _VSTD::move(__out_it), __n, __fmt.get(), _VSTD::make_wformat_args(__args...), __fmt.__fields());
 }
 #endif
 
 template <class _CharT>
-_LIBCPP_HIDE_FROM_ABI size_t __vformatted_size(basic_string_view<_CharT> __fmt, auto __args) {
+_LIBCPP_HIDE_FROM_ABI size_t
+__vformatted_size(basic_string_view<_CharT> __fmt, auto __args, __format::__replacement_fields __fields = {}) {
   __format::__formatted_size_buffer<_CharT> __buffer;
   _VSTD::__format::__vformat_to(basic_format_parse_context{__fmt, __args.__size()},
-                                _VSTD::__format_context_create(__buffer.__make_output_iterator(), __args));
+                                _VSTD::__format_context_create(__buffer.__make_output_iterator(), __args), __fields);
   return _VSTD::move(__buffer).__result();
 }
 
 template <class... _Args>
 _LIBCPP_ALWAYS_INLINE _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT size_t
 formatted_size(format_string<_Args...> __fmt, _Args&&... __args) {
-  return _VSTD::__vformatted_size(__fmt.get(), basic_format_args{_VSTD::make_format_args(__args...)});
+  return _VSTD::__vformatted_size(
+      __fmt.get(), basic_format_args{_VSTD::make_format_args(__args...)}, __fmt.__fields());
 }
 
 #ifndef _LIBCPP_HAS_NO_WIDE_CHARACTERS
 template <class... _Args>
 _LIBCPP_ALWAYS_INLINE _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT size_t
 formatted_size(wformat_string<_Args...> __fmt, _Args&&... __args) {
-  return _VSTD::__vformatted_size(__fmt.get(), basic_format_args{_VSTD::make_wformat_args(__args...)});
+  return _VSTD::__vformatted_size(
+      __fmt.get(), basic_format_args{_VSTD::make_wformat_args(__args...)}, __fmt.__fields());
 }
 #endif
 
@@ -517,16 +677,17 @@ template <class _OutIt, class _CharT, class _FormatOutIt>
 requires(output_iterator<_OutIt, const _CharT&>) _LIBCPP_HIDE_FROM_ABI _OutIt
     __vformat_to(
         _OutIt __out_it, locale __loc, basic_string_view<_CharT> __fmt,
-        basic_format_args<basic_format_context<_FormatOutIt, _CharT>> __args) {
+        basic_format_args<basic_format_context<_FormatOutIt, _CharT>> __args,
+        __format::__replacement_fields __fields = {}) {
   if constexpr (same_as<_OutIt, _FormatOutIt>)
     return _VSTD::__format::__vformat_to(
         basic_format_parse_context{__fmt, __args.__size()},
-        _VSTD::__format_context_create(_VSTD::move(__out_it), __args, _VSTD::move(__loc)));
+        _VSTD::__format_context_create(_VSTD::move(__out_it), __args, _VSTD::move(__loc)), __fields);
   else {
     __format::__format_buffer<_OutIt, _CharT> __buffer{_VSTD::move(__out_it)};
     _VSTD::__format::__vformat_to(
         basic_format_parse_context{__fmt, __args.__size()},
-        _VSTD::__format_context_create(__buffer.__make_output_iterator(), __args, _VSTD::move(__loc)));
+        _VSTD::__format_context_create(__buffer.__make_output_iterator(), __args, _VSTD::move(__loc)), __fields);
     return _VSTD::move(__buffer).__out_it();
   }
 }
@@ -550,16 +711,22 @@ _LIBCPP_ALWAYS_INLINE _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT _OutIt v
 template <output_iterator<const char&> _OutIt, class... _Args>
 _LIBCPP_ALWAYS_INLINE _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT _OutIt
 format_to(_OutIt __out_it, locale __loc, format_string<_Args...> __fmt, _Args&&... __args) {
-  return _VSTD::vformat_to(_VSTD::move(__out_it), _VSTD::move(__loc), __fmt.get(),
-                           _VSTD::make_format_args(__args...));
+  return _VSTD::__vformat_to(_VSTD::move(__out_it),
+                             _VSTD::move(__loc),
+                             __fmt.get(),
+                             format_args(_VSTD::make_format_args(__args...)),
+                             __fmt.__fields());
 }
 
 #ifndef _LIBCPP_HAS_NO_WIDE_CHARACTERS
 template <output_iterator<const wchar_t&> _OutIt, class... _Args>
 _LIBCPP_ALWAYS_INLINE _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT _OutIt
 format_to(_OutIt __out_it, locale __loc, wformat_string<_Args...> __fmt, _Args&&... __args) {
-  return _VSTD::vformat_to(_VSTD::move(__out_it), _VSTD::move(__loc), __fmt.get(),
-                           _VSTD::make_wformat_args(__args...));
+  return _VSTD::__vformat_to(_VSTD::move(__out_it),
+                             _VSTD::move(__loc),
+                             __fmt.get(),
+                             wformat_args(_VSTD::make_wformat_args(__args...)),
+                             __fmt.__fields());
 }
 #endif
 
@@ -585,27 +752,38 @@ template <class... _Args>
 _LIBCPP_ALWAYS_INLINE _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT string format(locale __loc,
                                                                                       format_string<_Args...> __fmt,
                                                                                       _Args&&... __args) {
-  return _VSTD::vformat(_VSTD::move(__loc), __fmt.get(),
-                        _VSTD::make_format_args(__args...));
+  string __res;
+  _VSTD::__vformat_to(_VSTD::back_inserter(__res),
+                      _VSTD::move(__loc),
+                      __fmt.get(),
+                      format_args(_VSTD::make_format_args(__args...)),
+                      __fmt.__fields());
+  return __res;
 }
 
 #ifndef _LIBCPP_HAS_NO_WIDE_CHARACTERS
 template <class... _Args>
 _LIBCPP_ALWAYS_INLINE _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT wstring
 format(locale __loc, wformat_string<_Args...> __fmt, _Args&&... __args) {
-  return _VSTD::vformat(_VSTD::move(__loc), __fmt.get(),
-                        _VSTD::make_wformat_args(__args...));
+  wstring __res;
+  _VSTD::__vformat_to(_VSTD::back_inserter(__res),
+                      _VSTD::move(__loc),
+                      __fmt.get(),
+                      wformat_args(_VSTD::make_wformat_args(__args...)),
+                      __fmt.__fields());
+  return __res;
 }
 #endif
 
 template <class _Context, class _OutIt, class _CharT>
 _LIBCPP_HIDE_FROM_ABI format_to_n_result<_OutIt> __vformat_to_n(_OutIt __out_it, iter_difference_t<_OutIt> __n,
                                                                 locale __loc, basic_string_view<_CharT> __fmt,
-                                                                basic_format_args<_Context> __args) {
+                                                                basic_format_args<_Context> __args,
+                                                                __format::__replacement_fields __fields = {}) {
   __format::__format_to_n_buffer<_OutIt, _CharT> __buffer{_VSTD::move(__out_it), __n};
   _VSTD::__format::__vformat_to(
       basic_format_parse_context{__fmt, __args.__size()},
-      _VSTD::__format_context_create(__buffer.__make_output_iterator(), __args, _VSTD::move(__loc)));
+      _VSTD::__format_context_create(__buffer.__make_output_iterator(), __args, _VSTD::move(__loc)), __fields);
   return _VSTD::move(__buffer).__result();
 }
 
@@ -614,7 +792,7 @@ _LIBCPP_ALWAYS_INLINE _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT format_t
 format_to_n(_OutIt __out_it, iter_difference_t<_OutIt> __n, locale __loc, format_string<_Args...> __fmt,
             _Args&&... __args) {
   return _VSTD::__vformat_to_n<format_context>(_VSTD::move(__out_it), __n, _VSTD::move(__loc), __fmt.get(),
-                                               _VSTD::make_format_args(__args...));
+                                               _VSTD::make_format_args(__args...), __fmt.__fields());
 }
 
 #ifndef _LIBCPP_HAS_NO_WIDE_CHARACTERS
@@ -623,30 +801,33 @@ _LIBCPP_ALWAYS_INLINE _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT format_t
 format_to_n(_OutIt __out_it, iter_difference_t<_OutIt> __n, locale __loc, wformat_string<_Args...> __fmt,
             _Args&&... __args) {
   return _VSTD::__vformat_to_n<wformat_context>(_VSTD::move(__out_it), __n, _VSTD::move(__loc), __fmt.get(),
-                                                _VSTD::make_wformat_args(__args...));
+                                                _VSTD::make_wformat_args(__args...), __fmt.__fields());
 }
 #endif
 
 template <class _CharT>
-_LIBCPP_HIDE_FROM_ABI size_t __vformatted_size(locale __loc, basic_string_view<_CharT> __fmt, auto __args) {
+_LIBCPP_HIDE_FROM_ABI size_t __vformatted_size(
+    locale __loc, basic_string_view<_CharT> __fmt, auto __args, __format::__replacement_fields __fields = {}) {
   __format::__formatted_size_buffer<_CharT> __buffer;
   _VSTD::__format::__vformat_to(
       basic_format_parse_context{__fmt, __args.__size()},
-      _VSTD::__format_context_create(__buffer.__make_output_iterator(), __args, _VSTD::move(__loc)));
+      _VSTD::__format_context_create(__buffer.__make_output_iterator(), __args, _VSTD::move(__loc)), __fields);
   return _VSTD::move(__buffer).__result();
 }
 
 template <class... _Args>
 _LIBCPP_ALWAYS_INLINE _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT size_t
 formatted_size(locale __loc, format_string<_Args...> __fmt, _Args&&... __args) {
-  return _VSTD::__vformatted_size(_VSTD::move(__loc), __fmt.get(), basic_format_args{_VSTD::make_format_args(__args...)});
+  return _VSTD::__vformatted_size(
+      _VSTD::move(__loc), __fmt.get(), basic_format_args{_VSTD::make_format_args(__args...)}, __fmt.__fields());
 }
 
 #ifndef _LIBCPP_HAS_NO_WIDE_CHARACTERS
 template <class... _Args>
 _LIBCPP_ALWAYS_INLINE _LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT size_t
 formatted_size(locale __loc, wformat_string<_Args...> __fmt, _Args&&... __args) {
-  return _VSTD::__vformatted_size(_VSTD::move(__loc), __fmt.get(), basic_format_args{_VSTD::make_wformat_args(__args...)});
+  return _VSTD::__vformatted_size(
+      _VSTD::move(__loc), __fmt.get(), basic_format_args{_VSTD::make_wformat_args(__args...)}, __fmt.__fields());
 }
 #endif
 
@@ -0,0 +1,90 @@
+// -*- C++ -*-
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _LIBCPP___FUNCTIONAL_MOVE_ONLY_FUNCTION_H
+#define _LIBCPP___FUNCTIONAL_MOVE_ONLY_FUNCTION_H
+
+#include <__assert>
+#include <__config>
+#include <__functional/invoke.h>
+#include <__functional/move_only_function_common.h>
+#include <__memory/addressof.h>
+#include <__type_traits/decay.h>
+#include <__type_traits/is_constructible.h>
+#include <__type_traits/is_function.h>
+#include <__type_traits/is_member_pointer.h>
+#include <__type_traits/is_pointer.h>
+#include <__type_traits/is_same.h>
+#include <__type_traits/remove_cvref.h>
+#include <__type_traits/remove_pointer.h>
+#include <__utility/forward.h>
+#include <__utility/in_place.h>
+#include <__utility/move.h>
+#include <cstddef>
+#include <initializer_list>
+
+#if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
+#  pragma GCC system_header
+#endif
+
+#if _LIBCPP_STD_VER > 20
+
+// move_only_function has a specialization for each combination of the cv,
+// ref and noexcept qualifiers of its signature. They are all generated from
+// the same implementation.
+
+// clang-format off
+#include <__functional/move_only_function_impl.h>
+
+#define _LIBCPP_MOVE_ONLY_FUNCTION_REF &
+#include <__functional/move_only_function_impl.h>
+
+#define _LIBCPP_MOVE_ONLY_FUNCTION_REF &&
+#include <__functional/move_only_function_impl.h>
+
+#define _LIBCPP_MOVE_ONLY_FUNCTION_CV const
+#include <__functional/move_only_function_impl.h>
+
+#define _LIBCPP_MOVE_ONLY_FUNCTION_CV const
+#define _LIBCPP_MOVE_ONLY_FUNCTION_REF &
+#include <__functional/move_only_function_impl.h>
+
+#define _LIBCPP_MOVE_ONLY_FUNCTION_CV const
+#define _LIBCPP_MOVE_ONLY_FUNCTION_REF &&
+#include <__functional/move_only_function_impl.h>
+
+#define _LIBCPP_MOVE_ONLY_FUNCTION_NOEXCEPT true
+#include <__functional/move_only_function_impl.h>
+
+#define _LIBCPP_MOVE_ONLY_FUNCTION_NOEXCEPT true
+#define _LIBCPP_MOVE_ONLY_FUNCTION_REF &
+#include <__functional/move_only_function_impl.h>
+
+#define _LIBCPP_MOVE_ONLY_FUNCTION_NOEXCEPT true
+#define _LIBCPP_MOVE_ONLY_FUNCTION_REF &&
+#include <__functional/move_only_function_impl.h>
+
+#define _LIBCPP_MOVE_ONLY_FUNCTION_NOEXCEPT true
+#define _LIBCPP_MOVE_ONLY_FUNCTION_CV const
+#include <__functional/move_only_function_impl.h>
+
+#define _LIBCPP_MOVE_ONLY_FUNCTION_NOEXCEPT true
+#define _LIBCPP_MOVE_ONLY_FUNCTION_CV const
+#define _LIBCPP_MOVE_ONLY_FUNCTION_REF &
+#include <__functional/move_only_function_impl.h>
+
+#define _LIBCPP_MOVE_ONLY_FUNCTION_NOEXCEPT true
+#define _LIBCPP_MOVE_ONLY_FUNCTION_CV const
+#define _LIBCPP_MOVE_ONLY_FUNCTION_REF &&
+#include <__functional/move_only_function_impl.h>
+// clang-format on
+
+#endif // _LIBCPP_STD_VER > 20
+
+#endif // _LIBCPP___FUNCTIONAL_MOVE_ONLY_FUNCTION_H
@@ -0,0 +1,136 @@
+// -*- C++ -*-
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _LIBCPP___FUNCTIONAL_MOVE_ONLY_FUNCTION_COMMON_H
+#define _LIBCPP___FUNCTIONAL_MOVE_ONLY_FUNCTION_COMMON_H
+
+#include <__config>
+#include <__memory/construct_at.h>
+#include <__type_traits/conditional.h>
+#include <__type_traits/is_nothrow_move_constructible.h>
+#include <__type_traits/is_scalar.h>
+#include <__type_traits/is_trivially_copyable.h>
+#include <__type_traits/is_trivially_destructible.h>
+#include <__utility/forward.h>
+#include <__utility/move.h>
+#include <cstddef>
+
+#if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
+#  pragma GCC system_header
+#endif
+
+#if _LIBCPP_STD_VER > 20
+
+// The size of the buffer in which move_only_function stores small callables
+// without allocating. The default lets a move_only_function fill a 64 byte
+// cache line on 64 bit targets, so lambdas capturing up to six pointers are
+// stored inline. Changing it changes the layout of move_only_function.
+#  ifndef _LIBCPP_MOVE_ONLY_FUNCTION_BUFFER_SIZE
+#    define _LIBCPP_MOVE_ONLY_FUNCTION_BUFFER_SIZE (6 * sizeof(void*))
+#  endif
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+
+template <class...>
+class move_only_function; // not defined
+
+namespace __move_only_function {
+
+union __storage {
+  void* __large_;
+  alignas(max_align_t) unsigned char __small_[_LIBCPP_MOVE_ONLY_FUNCTION_BUFFER_SIZE];
+};
+
+// The callables that don't fit into the buffer, or whose move constructor may
+// throw, are allocated on the heap.
+template <class _Tp>
+inline constexpr bool __is_small = sizeof(_Tp) <= sizeof(__storage) && alignof(_Tp) <= alignof(__storage) &&
+                                   is_nothrow_move_constructible_v<_Tp>;
+
+struct __vtable {
+  // Moves the callable from __src to __dst and destroys it in __src. Null when
+  // the storage can be copied bytewise, which is the case for the callables on
+  // the heap and the trivially copyable ones in the buffer.
+  void (*__relocate_)(__storage* __dst, __storage* __src) noexcept;
+  // Destroys the callable. Null when there is nothing to do.
+  void (*__destroy_)(__storage*) noexcept;
+};
+
+template <class _Tp>
+_LIBCPP_HIDE_FROM_ABI _Tp* __get(__storage* __s) noexcept {
+  if constexpr (__is_small<_Tp>)
+    return reinterpret_cast<_Tp*>(__s->__small_);
+  else
+    return static_cast<_Tp*>(__s->__large_);
+}
+
+template <class _Tp, class... _Args>
+_LIBCPP_HIDE_FROM_ABI void __construct(__storage* __s, _Args&&... __args) {
+  if constexpr (__is_small<_Tp>)
+    std::__construct_at(reinterpret_cast<_Tp*>(__s->__small_), std::forward<_Args>(__args)...);
+  else
+    __s->__large_ = new _Tp(std::forward<_Args>(__args)...);
+}
+
+template <class _Tp>
+struct __manager {
+  _LIBCPP_HIDE_FROM_ABI static void __relocate(__storage* __dst, __storage* __src) noexcept {
+    _Tp* __p = reinterpret_cast<_Tp*>(__src->__small_);
+    std::__construct_at(reinterpret_cast<_Tp*>(__dst->__small_), std::move(*__p));
+    __p->~_Tp();
+  }
+
+  _LIBCPP_HIDE_FROM_ABI static void __destroy(__storage* __s) noexcept {
+    if constexpr (__is_small<_Tp>)
+      reinterpret_cast<_Tp*>(__s->__small_)->~_Tp();
+    else
+      delete static_cast<_Tp*>(__s->__large_);
+  }
+
+  _LIBCPP_HIDE_FROM_ABI static constexpr __vtable __make_vtable() noexcept {
+    if constexpr (!__is_small<_Tp>)
+      return {nullptr, &__destroy};
+    else if constexpr (is_trivially_destructible_v<_Tp>)
+      return {&__relocate, nullptr};
+    else
+      return {&__relocate, &__destroy};
+  }
+
+  static constexpr __vtable __vtable_ = __make_vtable();
+};
+
+// Returns the vtable of _Tp, or nullptr if it neither needs to be relocated
+// nor destroyed. The storage of such callables is just copied when the
+// move_only_function is moved.
+template <class _Tp>
+_LIBCPP_HIDE_FROM_ABI constexpr const __vtable* __get_vtable() noexcept {
+  if constexpr (__is_small<_Tp> && is_trivially_copyable_v<_Tp>)
+    return nullptr;
+  else
+    return &__manager<_Tp>::__vtable_;
+}
+
+// The arguments of scalar types are passed by value to the invoker, the others
+// by reference.
+template <class _Tp>
+using __fast_forward = __conditional_t<is_scalar_v<_Tp>, _Tp, _Tp&&>;
+
+template <class>
+inline constexpr bool __is_move_only_function = false;
+
+template <class... _Signature>
+inline constexpr bool __is_move_only_function<move_only_function<_Signature...>> = true;
+
+} // namespace __move_only_function
+
+_LIBCPP_END_NAMESPACE_STD
+
+#endif // _LIBCPP_STD_VER > 20
+
+#endif // _LIBCPP___FUNCTIONAL_MOVE_ONLY_FUNCTION_COMMON_H
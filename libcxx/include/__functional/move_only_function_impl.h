@@ -0,0 +1,195 @@
+// -*- C++ -*-
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// This header is unguarded on purpose. It is included by
+// <__functional/move_only_function.h> once for each combination of the
+// qualifiers of the signature of move_only_function, which are given by the
+// macros
+//   _LIBCPP_MOVE_ONLY_FUNCTION_CV        empty or const
+//   _LIBCPP_MOVE_ONLY_FUNCTION_REF       empty, & or &&
+//   _LIBCPP_MOVE_ONLY_FUNCTION_NOEXCEPT  false or true
+
+#if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
+#  pragma GCC system_header
+#endif
+
+#ifndef _LIBCPP_MOVE_ONLY_FUNCTION_CV
+#  define _LIBCPP_MOVE_ONLY_FUNCTION_CV
+#endif
+
+#ifndef _LIBCPP_MOVE_ONLY_FUNCTION_REF
+#  define _LIBCPP_MOVE_ONLY_FUNCTION_REF
+#  define _LIBCPP_MOVE_ONLY_FUNCTION_INV_QUALS _LIBCPP_MOVE_ONLY_FUNCTION_CV&
+#else
+#  define _LIBCPP_MOVE_ONLY_FUNCTION_INV_QUALS _LIBCPP_MOVE_ONLY_FUNCTION_CV _LIBCPP_MOVE_ONLY_FUNCTION_REF
+#endif
+
+#ifndef _LIBCPP_MOVE_ONLY_FUNCTION_NOEXCEPT
+#  define _LIBCPP_MOVE_ONLY_FUNCTION_NOEXCEPT false
+#endif
+
+#define _LIBCPP_MOVE_ONLY_FUNCTION_CV_REF _LIBCPP_MOVE_ONLY_FUNCTION_CV _LIBCPP_MOVE_ONLY_FUNCTION_REF
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+
+template <class _Rp, class... _ArgTypes>
+class _LIBCPP_TEMPLATE_VIS move_only_function<_Rp(_ArgTypes...) _LIBCPP_MOVE_ONLY_FUNCTION_CV_REF noexcept(
+    _LIBCPP_MOVE_ONLY_FUNCTION_NOEXCEPT)> {
+  using __storage = __move_only_function::__storage;
+  using __vtable = __move_only_function::__vtable;
+  using __invoker = _Rp (*)(__storage*, __move_only_function::__fast_forward<_ArgTypes>...) noexcept(
+      _LIBCPP_MOVE_ONLY_FUNCTION_NOEXCEPT);
+
+  template <class _VT>
+  static constexpr bool __is_callable_from = [] {
+    if constexpr (_LIBCPP_MOVE_ONLY_FUNCTION_NOEXCEPT)
+      return is_nothrow_invocable_r_v<_Rp, _VT _LIBCPP_MOVE_ONLY_FUNCTION_CV_REF, _ArgTypes...> &&
+             is_nothrow_invocable_r_v<_Rp, _VT _LIBCPP_MOVE_ONLY_FUNCTION_INV_QUALS, _ArgTypes...>;
+    else
+      return is_invocable_r_v<_Rp, _VT _LIBCPP_MOVE_ONLY_FUNCTION_CV_REF, _ArgTypes...> &&
+             is_invocable_r_v<_Rp, _VT _LIBCPP_MOVE_ONLY_FUNCTION_INV_QUALS, _ArgTypes...>;
+  }();
+
+  template <class _VT>
+  _LIBCPP_HIDE_FROM_ABI static _Rp
+  __invoke(__storage* __s, __move_only_function::__fast_forward<_ArgTypes>... __args) noexcept(
+      _LIBCPP_MOVE_ONLY_FUNCTION_NOEXCEPT) {
+    return __invoke_void_return_wrapper<_Rp>::__call(
+        static_cast<_VT _LIBCPP_MOVE_ONLY_FUNCTION_INV_QUALS>(*__move_only_function::__get<_VT>(__s)),
+        std::forward<_ArgTypes>(__args)...);
+  }
+
+  template <class _VT, class... _Args>
+  _LIBCPP_HIDE_FROM_ABI void __construct(_Args&&... __args) {
+    __move_only_function::__construct<_VT>(&__storage_, std::forward<_Args>(__args)...);
+    __vtable_ = __move_only_function::__get_vtable<_VT>();
+    __call_ = &__invoke<_VT>;
+  }
+
+  template <class _Func>
+  _LIBCPP_HIDE_FROM_ABI void __construct_from(_Func&& __func) {
+    using _VT = decay_t<_Func>;
+    if constexpr (is_member_pointer_v<_VT> || (is_pointer_v<_VT> && is_function_v<remove_pointer_t<_VT>>) ||
+                  __move_only_function::__is_move_only_function<_VT>) {
+      // [func.wrap.move.ctor]/6: A null pointer or an empty move_only_function
+      // gives an empty move_only_function.
+      if (__func == nullptr)
+        return;
+    }
+    __construct<_VT>(std::forward<_Func>(__func));
+  }
+
+  // Takes over the callable of __other, which is left empty.
+  _LIBCPP_HIDE_FROM_ABI void __take(move_only_function& __other) noexcept {
+    if (__other.__vtable_ && __other.__vtable_->__relocate_)
+      __other.__vtable_->__relocate_(&__storage_, &__other.__storage_);
+    else
+      __storage_ = __other.__storage_;
+    __vtable_ = __other.__vtable_;
+    __call_ = __other.__call_;
+    __other.__vtable_ = nullptr;
+    __other.__call_ = nullptr;
+  }
+
+  _LIBCPP_HIDE_FROM_ABI void __reset() noexcept {
+    if (__vtable_ && __vtable_->__destroy_)
+      __vtable_->__destroy_(&__storage_);
+    __vtable_ = nullptr;
+    __call_ = nullptr;
+  }
+
+public:
+  using result_type = _Rp;
+
+  // [func.wrap.move.ctor]
+  _LIBCPP_HIDE_FROM_ABI move_only_function() noexcept = default;
+
+  _LIBCPP_HIDE_FROM_ABI move_only_function(nullptr_t) noexcept {}
+
+  _LIBCPP_HIDE_FROM_ABI move_only_function(move_only_function&& __other) noexcept { __take(__other); }
+
+  template <class _Func>
+    requires(!is_same_v<remove_cvref_t<_Func>, move_only_function> && !__is_inplace_type<_Func>::value &&
+             __is_callable_from<decay_t<_Func>>)
+  _LIBCPP_HIDE_FROM_ABI move_only_function(_Func&& __func) {
+    static_assert(is_constructible_v<decay_t<_Func>, _Func>);
+    __construct_from(std::forward<_Func>(__func));
+  }
+
+  template <class _Func, class... _Args>
+    requires is_constructible_v<_Func, _Args...> && __is_callable_from<_Func>
+  _LIBCPP_HIDE_FROM_ABI explicit move_only_function(in_place_type_t<_Func>, _Args&&... __args) {
+    static_assert(is_same_v<decay_t<_Func>, _Func>);
+    __construct<_Func>(std::forward<_Args>(__args)...);
+  }
+
+  template <class _Func, class _InitListType, class... _Args>
+    requires is_constructible_v<_Func, initializer_list<_InitListType>&, _Args...> && __is_callable_from<_Func>
+  _LIBCPP_HIDE_FROM_ABI explicit move_only_function(
+      in_place_type_t<_Func>, initializer_list<_InitListType> __il, _Args&&... __args) {
+    static_assert(is_same_v<decay_t<_Func>, _Func>);
+    __construct<_Func>(__il, std::forward<_Args>(__args)...);
+  }
+
+  _LIBCPP_HIDE_FROM_ABI move_only_function& operator=(move_only_function&& __other) noexcept {
+    if (this != std::addressof(__other)) {
+      __reset();
+      __take(__other);
+    }
+    return *this;
+  }
+
+  _LIBCPP_HIDE_FROM_ABI move_only_function& operator=(nullptr_t) noexcept {
+    __reset();
+    return *this;
+  }
+
+  template <class _Func>
+  _LIBCPP_HIDE_FROM_ABI move_only_function& operator=(_Func&& __func) {
+    move_only_function(std::forward<_Func>(__func)).swap(*this);
+    return *this;
+  }
+
+  _LIBCPP_HIDE_FROM_ABI ~move_only_function() { __reset(); }
+
+  // [func.wrap.move.inv]
+  _LIBCPP_HIDE_FROM_ABI explicit operator bool() const noexcept { return __call_ != nullptr; }
+
+  _LIBCPP_HIDE_FROM_ABI _Rp operator()(_ArgTypes... __args) _LIBCPP_MOVE_ONLY_FUNCTION_CV_REF noexcept(
+      _LIBCPP_MOVE_ONLY_FUNCTION_NOEXCEPT) {
+    _LIBCPP_ASSERT(static_cast<bool>(*this), "Tried to call an empty move_only_function");
+    return __call_(const_cast<__storage*>(&__storage_), std::forward<_ArgTypes>(__args)...);
+  }
+
+  // [func.wrap.move.util]
+  _LIBCPP_HIDE_FROM_ABI void swap(move_only_function& __other) noexcept {
+    move_only_function __tmp(std::move(__other));
+    __other.__take(*this);
+    __take(__tmp);
+  }
+
+  _LIBCPP_HIDE_FROM_ABI friend void swap(move_only_function& __lhs, move_only_function& __rhs) noexcept {
+    __lhs.swap(__rhs);
+  }
+
+  _LIBCPP_HIDE_FROM_ABI friend bool operator==(const move_only_function& __func, nullptr_t) noexcept { return !__func; }
+
+private:
+  __storage __storage_;
+  const __vtable* __vtable_ = nullptr;
+  __invoker __call_ = nullptr;
+};
+
+_LIBCPP_END_NAMESPACE_STD
+
+#undef _LIBCPP_MOVE_ONLY_FUNCTION_CV
+#undef _LIBCPP_MOVE_ONLY_FUNCTION_REF
+#undef _LIBCPP_MOVE_ONLY_FUNCTION_NOEXCEPT
+#undef _LIBCPP_MOVE_ONLY_FUNCTION_INV_QUALS
+#undef _LIBCPP_MOVE_ONLY_FUNCTION_CV_REF
@@ -22,12 +22,25 @@
 #  pragma GCC system_header
 #endif
 
+// Whether the threads keep caches of free blocks for each synchronized_pool_resource, which they allocate from and
+// deallocate to without locking the mutex.
+#if defined(_LIBCPP_ABI_SYNCHRONIZED_POOL_RESOURCE_THREAD_CACHES) && !defined(_LIBCPP_HAS_NO_THREADS) &&              \
+    !defined(_LIBCPP_HAS_NO_ATOMIC_HEADER)
+#  define _LIBCPP_HAS_SYNCHRONIZED_POOL_THREAD_CACHES 1
+#else
+#  define _LIBCPP_HAS_SYNCHRONIZED_POOL_THREAD_CACHES 0
+#endif
+
 #if _LIBCPP_STD_VER > 14
 
 _LIBCPP_BEGIN_NAMESPACE_STD
 
 namespace pmr {
 
+#  if _LIBCPP_HAS_SYNCHRONIZED_POOL_THREAD_CACHES
+class _LIBCPP_HIDDEN __pool_thread_caches;
+#  endif
+
 // [mem.res.pool.overview]
 
 class _LIBCPP_TYPE_VIS synchronized_pool_resource : public memory_resource {
@@ -46,43 +59,65 @@ public:
 
   synchronized_pool_resource(const synchronized_pool_resource&) = delete;
 
+#  if _LIBCPP_HAS_SYNCHRONIZED_POOL_THREAD_CACHES
+  ~synchronized_pool_resource() override;
+#  else
   ~synchronized_pool_resource() override = default;
+#  endif
 
   synchronized_pool_resource& operator=(const synchronized_pool_resource&) = delete;
 
+#  if _LIBCPP_HAS_SYNCHRONIZED_POOL_THREAD_CACHES
+  void release();
+#  else
   _LIBCPP_HIDE_FROM_ABI void release() {
-#  if !defined(_LIBCPP_HAS_NO_THREADS)
+#    if !defined(_LIBCPP_HAS_NO_THREADS)
     unique_lock<mutex> __lk(__mut_);
-#  endif
+#    endif
     __unsync_.release();
   }
+#  endif
 
   _LIBCPP_HIDE_FROM_ABI memory_resource* upstream_resource() const { return __unsync_.upstream_resource(); }
 
   _LIBCPP_HIDE_FROM_ABI pool_options options() const { return __unsync_.options(); }
 
 protected:
+#  if _LIBCPP_HAS_SYNCHRONIZED_POOL_THREAD_CACHES
+  void* do_allocate(size_t __bytes, size_t __align) override;
+
+  void do_deallocate(void* __p, size_t __bytes, size_t __align) override;
+#  else
   _LIBCPP_HIDE_FROM_ABI void* do_allocate(size_t __bytes, size_t __align) override {
-#  if !defined(_LIBCPP_HAS_NO_THREADS)
+#    if !defined(_LIBCPP_HAS_NO_THREADS)
     unique_lock<mutex> __lk(__mut_);
-#  endif
+#    endif
     return __unsync_.allocate(__bytes, __align);
   }
 
   _LIBCPP_HIDE_FROM_ABI void do_deallocate(void* __p, size_t __bytes, size_t __align) override {
-#  if !defined(_LIBCPP_HAS_NO_THREADS)
+#    if !defined(_LIBCPP_HAS_NO_THREADS)
     unique_lock<mutex> __lk(__mut_);
-#  endif
+#    endif
     return __unsync_.deallocate(__p, __bytes, __align);
   }
+#  endif
 
   bool do_is_equal(const memory_resource& __other) const noexcept override; // key function
 
 private:
+#  if _LIBCPP_HAS_SYNCHRONIZED_POOL_THREAD_CACHES
+  __pool_thread_caches* __get_caches();
+#  endif
+
 #  if !defined(_LIBCPP_HAS_NO_THREADS)
   mutex __mut_;
 #  endif
   unsynchronized_pool_resource __unsync_;
+#  if _LIBCPP_HAS_SYNCHRONIZED_POOL_THREAD_CACHES
+  // Created on the first allocation, since constructing the resource must not allocate.
+  __pool_thread_caches* __caches_ = nullptr;
+#  endif
 };
 
 } // namespace pmr
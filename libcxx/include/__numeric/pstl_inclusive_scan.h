@@ -0,0 +1,109 @@
+// -*- C++ -*-
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _LIBCPP___NUMERIC_PSTL_INCLUSIVE_SCAN_H
+#define _LIBCPP___NUMERIC_PSTL_INCLUSIVE_SCAN_H
+
+#include <__algorithm/pstl_backend.h>
+#include <__config>
+#include <__functional/operations.h>
+#include <__iterator/iterator_traits.h>
+#include <__numeric/inclusive_scan.h>
+#include <__numeric/reduce.h>
+#include <__type_traits/is_execution_policy.h>
+#include <__utility/move.h>
+
+#if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
+#  pragma GCC system_header
+#endif
+
+#if !defined(_LIBCPP_HAS_NO_INCOMPLETE_PSTL) && _LIBCPP_STD_VER > 14
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+
+template <class _ExecutionPolicy, class _ForwardIterator, class _ForwardOutIterator, class _BinaryOperation, class _Tp>
+_LIBCPP_HIDE_FROM_ABI _ForwardOutIterator __pstl_inclusive_scan(
+    _ExecutionPolicy&&,
+    _ForwardIterator __first,
+    _ForwardIterator __last,
+    _ForwardOutIterator __result,
+    _BinaryOperation __op,
+    const _Tp* __init) {
+  if constexpr (__is_parallel_execution_policy_v<_ExecutionPolicy> &&
+                __is_cpp17_random_access_iterator<_ForwardIterator>::value &&
+                __is_cpp17_random_access_iterator<_ForwardOutIterator>::value) {
+    std::__par_backend::__parallel_scan(
+        __first,
+        __last,
+        __init,
+        __op,
+        [&](_ForwardIterator __brick_first, _ForwardIterator __brick_last) {
+          return std::reduce(__brick_first + 1, __brick_last, _Tp(*__brick_first), __op);
+        },
+        [&](_ForwardIterator __brick_first, _ForwardIterator __brick_last, const _Tp* __carry) {
+          _ForwardOutIterator __brick_result = __result + (__brick_first - __first);
+          if (__carry)
+            std::inclusive_scan(__brick_first, __brick_last, __brick_result, __op, *__carry);
+          else
+            std::inclusive_scan(__brick_first, __brick_last, __brick_result, __op);
+        });
+    return __result + (__last - __first);
+  } else if (__init) {
+    return std::inclusive_scan(__first, __last, __result, std::move(__op), *__init);
+  } else {
+    return std::inclusive_scan(__first, __last, __result, std::move(__op));
+  }
+}
+
+template <class _ExecutionPolicy,
+          class _ForwardIterator,
+          class _ForwardOutIterator,
+          class _BinaryOperation,
+          class _Tp,
+          __enable_if_execution_policy<_ExecutionPolicy> = 0>
+_LIBCPP_HIDE_FROM_ABI _ForwardOutIterator inclusive_scan(
+    _ExecutionPolicy&& __policy,
+    _ForwardIterator __first,
+    _ForwardIterator __last,
+    _ForwardOutIterator __result,
+    _BinaryOperation __op,
+    _Tp __init) {
+  return std::__pstl_inclusive_scan(__policy, __first, __last, __result, std::move(__op), &__init);
+}
+
+template <class _ExecutionPolicy,
+          class _ForwardIterator,
+          class _ForwardOutIterator,
+          class _BinaryOperation,
+          __enable_if_execution_policy<_ExecutionPolicy> = 0>
+_LIBCPP_HIDE_FROM_ABI _ForwardOutIterator inclusive_scan(
+    _ExecutionPolicy&& __policy,
+    _ForwardIterator __first,
+    _ForwardIterator __last,
+    _ForwardOutIterator __result,
+    _BinaryOperation __op) {
+  using _ValueType = typename iterator_traits<_ForwardIterator>::value_type;
+  return std::__pstl_inclusive_scan(
+      __policy, __first, __last, __result, std::move(__op), static_cast<const _ValueType*>(nullptr));
+}
+
+template <class _ExecutionPolicy,
+          class _ForwardIterator,
+          class _ForwardOutIterator,
+          __enable_if_execution_policy<_ExecutionPolicy> = 0>
+_LIBCPP_HIDE_FROM_ABI _ForwardOutIterator inclusive_scan(
+    _ExecutionPolicy&& __policy, _ForwardIterator __first, _ForwardIterator __last, _ForwardOutIterator __result) {
+  return std::inclusive_scan(__policy, __first, __last, __result, plus<>());
+}
+
+_LIBCPP_END_NAMESPACE_STD
+
+#endif // !defined(_LIBCPP_HAS_NO_INCOMPLETE_PSTL) && _LIBCPP_STD_VER > 14
+
+#endif // _LIBCPP___NUMERIC_PSTL_INCLUSIVE_SCAN_H
@@ -14,7 +14,9 @@
 
 #include <__utility/unreachable.h>
 #include <algorithm>
+#include <charconv>
 #include <clocale>
+#include <cmath>
 #include <codecvt>
 #include <cstdio>
 #include <cstdlib>
@@ -4925,6 +4927,123 @@ __num_put_base::__identify_padding(char* __nb, char* __ne,
     return __nb;
 }
 
+#ifndef _LIBCPP_HAS_NO_NUM_PUT_CLASSIC_IN_LIBRARY
+
+// __num_put_classic
+
+// snprintf prints the hexadecimal digits and the exponent in upper case when
+// ios_base::uppercase is set, to_chars only knows lower case.
+static void __to_upper_case(char* __first, char* __last)
+{
+    for (; __first != __last; ++__first)
+        if ('a' <= *__first && *__first <= 'z')
+            *__first -= 'a' - 'A';
+}
+
+// Formats __v like snprintf does with the conversion specification
+// __num_put_base::__format_int creates for the flags of __iob.
+template <class _Tp>
+char*
+__num_put_classic::__format_integral(char* __nb, char* __ne, char*& __np,
+                                     const ios_base& __iob, _Tp __v)
+{
+    if (!__iob.__has_classic_locale())
+        return nullptr;
+    ios_base::fmtflags __flags = __iob.flags();
+    ios_base::fmtflags __basefield = __flags & ios_base::basefield;
+    char* __p = __nb;
+    to_chars_result __r;
+    if (__basefield == ios_base::oct || __basefield == ios_base::hex)
+    {
+        // %o and %x print the value as an unsigned number, and the alternative
+        // form only adds a prefix to non-zero values.
+        bool __hex = __basefield == ios_base::hex;
+        auto __u = static_cast<make_unsigned_t<_Tp>>(__v);
+        if ((__flags & ios_base::showbase) && __u != 0)
+        {
+            *__p++ = '0';
+            if (__hex)
+                *__p++ = 'x';
+        }
+        __r = std::to_chars(__p, __ne, __u, __hex ? 16 : 8);
+        if (__hex && (__flags & ios_base::uppercase))
+            __to_upper_case(__nb, __r.ptr);
+    }
+    else
+    {
+        if (is_signed<_Tp>::value && (__flags & ios_base::showpos) && __v >= 0)
+            *__p++ = '+';
+        __r = std::to_chars(__p, __ne, __v);
+    }
+    if (__r.ec != errc())
+        return nullptr;
+    __np = __identify_padding(__nb, __r.ptr, __iob);
+    return __r.ptr;
+}
+
+char*
+__num_put_classic::__format(char* __nb, char* __ne, char*& __np,
+                            const ios_base& __iob, long __v)
+{
+    return __format_integral(__nb, __ne, __np, __iob, __v);
+}
+
+char*
+__num_put_classic::__format(char* __nb, char* __ne, char*& __np,
+                            const ios_base& __iob, unsigned long __v)
+{
+    return __format_integral(__nb, __ne, __np, __iob, __v);
+}
+
+char*
+__num_put_classic::__format(char* __nb, char* __ne, char*& __np,
+                            const ios_base& __iob, long long __v)
+{
+    return __format_integral(__nb, __ne, __np, __iob, __v);
+}
+
+char*
+__num_put_classic::__format(char* __nb, char* __ne, char*& __np,
+                            const ios_base& __iob, unsigned long long __v)
+{
+    return __format_integral(__nb, __ne, __np, __iob, __v);
+}
+
+// Formats __v like snprintf does with the conversion specification
+// __num_put_base::__format_float creates for the flags of __iob. The
+// hexadecimal format, the alternative form, negative precisions, infinities
+// and NaNs aren't handled; to_chars doesn't print them the way snprintf does.
+char*
+__num_put_classic::__format(char* __nb, char* __ne, char*& __np,
+                            const ios_base& __iob, double __v)
+{
+    if (!__iob.__has_classic_locale())
+        return nullptr;
+    ios_base::fmtflags __flags = __iob.flags();
+    ios_base::fmtflags __floatfield = __flags & ios_base::floatfield;
+    int __prec = static_cast<int>(__iob.precision());
+    if (__floatfield == ios_base::floatfield || (__flags & ios_base::showpoint) ||
+        __prec < 0 || !std::isfinite(__v))
+        return nullptr;
+    chars_format __fmt = chars_format::general;
+    if (__floatfield == ios_base::fixed)
+        __fmt = chars_format::fixed;
+    else if (__floatfield == ios_base::scientific)
+        __fmt = chars_format::scientific;
+    char* __p = __nb;
+    if ((__flags & ios_base::showpos) && !std::signbit(__v))
+        *__p++ = '+';
+    to_chars_result __r = std::to_chars(__p, __ne, __v, __fmt, __prec);
+    if (__r.ec != errc())
+        return nullptr;
+    if (__flags & ios_base::uppercase)
+        __to_upper_case(__p, __r.ptr);
+    __np = __identify_padding(__nb, __r.ptr, __iob);
+    return __r.ptr;
+}
+
+#endif // _LIBCPP_HAS_NO_NUM_PUT_CLASSIC_IN_LIBRARY
+
 // time_get
 
 static
@@ -18,6 +18,15 @@
 #  endif
 #endif
 
+#if _LIBCPP_HAS_SYNCHRONIZED_POOL_THREAD_CACHES
+#  include <__bits>
+#  include <__threading_support>
+#  include <cstdint>
+#  include <cstdlib>
+#  include <new>
+#  include "include/atomic_support.h"
+#endif
+
 _LIBCPP_BEGIN_NAMESPACE_STD
 
 namespace pmr {
@@ -408,6 +417,341 @@ void unsynchronized_pool_resource::do_deallocate(void* p, size_t bytes, size_t a
 
 bool synchronized_pool_resource::do_is_equal(const memory_resource& other) const noexcept { return &other == this; }
 
+#if _LIBCPP_HAS_SYNCHRONIZED_POOL_THREAD_CACHES
+
+// Each thread that uses a synchronized_pool_resource gets a cache with a list of free blocks for each of the small
+// size classes. Allocations pop a block from the list of the thread, and deallocations push the block onto it, so they
+// only lock the mutex of the resource to get a batch of new blocks from its pools.
+//
+// When a list grows too long, a batch of its blocks is pushed onto the depot of the size class, a lock-free stack
+// shared by all the threads, so that blocks freed by other threads than the ones that allocated them are reused. A
+// thread whose list is empty takes the whole depot before asking the pools for more blocks. Since the depot is only
+// ever emptied by an exchange, its operations don't suffer from the ABA problem.
+//
+// The caches outlive both the threads and the resource that have a reference to them. When a thread exits, its caches
+// are orphaned, and the next thread that uses the resource adopts one of them with its blocks. When the resource is
+// destroyed, the caches are marked dead, and their threads forget them the next time they look for a cache.
+
+namespace {
+
+struct __cached_block {
+  __cached_block* __next_;
+};
+
+// Blocks of up to 4096 bytes are cached.
+const int __max_cached_pools = 10;
+
+const size_t __smallest_cached_block_size = 8;
+
+// Returns the number of blocks that move between a list of a thread and the depot or the pools at a time.
+size_t __cache_batch_size(int pool) {
+  size_t n = size_t(16384) >> pool;
+  return n > 64 ? 64 : (n < 4 ? 4 : n);
+}
+
+// The caches are allocated with malloc, since they aren't memory that the resource hands out or gets from upstream.
+template <class _Tp, class _Arg>
+_Tp* __create_cache(_Arg arg) {
+  void* p = std::malloc(sizeof(_Tp));
+  return p ? ::new (p) _Tp(arg) : nullptr;
+}
+
+template <class _Tp>
+void __destroy_cache(_Tp* p) {
+  if (p != nullptr) {
+    p->~_Tp();
+    std::free(p);
+  }
+}
+
+enum __cache_state { __cache_owned, __cache_orphaned };
+
+struct __thread_cache {
+  // Only accessed by the thread that owns the cache.
+  __cached_block* __free_[__max_cached_pools] = {};
+  size_t __count_[__max_cached_pools]         = {};
+  size_t __epoch_                             = 0;
+  uint64_t __resource_id_;
+  __thread_cache* __next_in_thread_ = nullptr;
+
+  // Set once before the cache is published, then only read.
+  __thread_cache* __next_in_resource_ = nullptr;
+
+  atomic<int> __state_{__cache_owned};
+  atomic<bool> __resource_dead_{false};
+  // One for the resource, and one for the thread that owns the cache, if any.
+  atomic<int> __refs_{2};
+
+  explicit __thread_cache(uint64_t resource_id) : __resource_id_(resource_id) {}
+
+  void __drop_ref() {
+    if (__refs_.fetch_sub(1, memory_order_acq_rel) == 1)
+      __destroy_cache(this);
+  }
+
+  void __clear() {
+    for (int i = 0; i < __max_cached_pools; ++i) {
+      __free_[i]  = nullptr;
+      __count_[i] = 0;
+    }
+  }
+};
+
+atomic<uint64_t> __next_resource_id{1};
+
+// Orphans the caches of an exiting thread, so that other threads can adopt them.
+void _LIBCPP_TLS_DESTRUCTOR_CC __orphan_thread_caches(void* p) {
+  __thread_cache* c = static_cast<__thread_cache*>(p);
+  while (c != nullptr) {
+    __thread_cache* next = c->__next_in_thread_;
+    c->__next_in_thread_ = nullptr;
+    c->__state_.store(__cache_orphaned, memory_order_release);
+    c->__drop_ref();
+    c = next;
+  }
+}
+
+// The key of the list of the caches of the current thread, or nullptr if it can't be created.
+__libcpp_tls_key* __thread_caches_key() {
+  static __libcpp_tls_key key;
+  static bool created = __libcpp_tls_create(&key, &__orphan_thread_caches) == 0;
+  return created ? &key : nullptr;
+}
+
+} // end namespace
+
+class __pool_thread_caches {
+  // Only read after construction.
+  uint64_t __id_;
+  int __num_cached_pools_;
+
+  atomic<size_t> __epoch_{0};
+  atomic<__cached_block*> __depot_[__max_cached_pools] = {};
+  atomic<__thread_cache*> __caches_{nullptr};
+
+public:
+  explicit __pool_thread_caches(int num_fixed_pools)
+      : __id_(__next_resource_id.fetch_add(1, memory_order_relaxed)),
+        __num_cached_pools_(num_fixed_pools < __max_cached_pools ? num_fixed_pools : __max_cached_pools) {}
+
+  ~__pool_thread_caches() {
+    __thread_cache* c = __caches_.load(memory_order_acquire);
+    while (c != nullptr) {
+      __thread_cache* next = c->__next_in_resource_;
+      c->__resource_dead_.store(true, memory_order_release);
+      c->__drop_ref();
+      c = next;
+    }
+  }
+
+  // Returns the size class of the blocks of a request, or -1 if such blocks aren't cached.
+  int __pool_index(size_t bytes, size_t align) const {
+    if (align > alignof(max_align_t))
+      return -1;
+    size_t size = bytes > align ? bytes : align;
+    if (size <= __smallest_cached_block_size)
+      return 0;
+    int i = static_cast<int>(sizeof(size_t) * __CHAR_BIT__) - __libcpp_clz(size - 1) - 3;
+    return i < __num_cached_pools_ ? i : -1;
+  }
+
+  static size_t __block_size(int i) { return __smallest_cached_block_size << i; }
+
+  // Returns the cache of the current thread, or nullptr if it can't get one.
+  __thread_cache* __local_cache() {
+    __libcpp_tls_key* key = __thread_caches_key();
+    if (key == nullptr)
+      return nullptr;
+    __thread_cache* head = static_cast<__thread_cache*>(__libcpp_tls_get(*key));
+    __thread_cache* prev = nullptr;
+    for (__thread_cache* c = head; c != nullptr;) {
+      __thread_cache* next = c->__next_in_thread_;
+      if (c->__resource_id_ == __id_) {
+        if (prev != nullptr) {
+          // Keep the cache of the resource used last first.
+          prev->__next_in_thread_ = next;
+          c->__next_in_thread_    = head;
+          __libcpp_tls_set(*key, c);
+        }
+        __check_epoch(c);
+        return c;
+      }
+      if (c->__resource_dead_.load(memory_order_acquire)) {
+        if (prev != nullptr)
+          prev->__next_in_thread_ = next;
+        else
+          head = next;
+        c->__drop_ref();
+      } else {
+        prev = c;
+      }
+      c = next;
+    }
+
+    __thread_cache* c = __adopt_orphan();
+    if (c == nullptr) {
+      c = __create_cache<__thread_cache>(__id_);
+      if (c == nullptr) {
+        __libcpp_tls_set(*key, head);
+        return nullptr;
+      }
+      c->__epoch_           = __epoch_.load(memory_order_relaxed);
+      __thread_cache* first = __caches_.load(memory_order_relaxed);
+      do {
+        c->__next_in_resource_ = first;
+      } while (!__caches_.compare_exchange_weak(first, c, memory_order_release, memory_order_relaxed));
+    }
+    c->__next_in_thread_ = head;
+    if (__libcpp_tls_set(*key, c) != 0) {
+      // Without the thread-exit callback, the cache could never be adopted again.
+      c->__next_in_thread_ = nullptr;
+      c->__state_.store(__cache_orphaned, memory_order_release);
+      c->__drop_ref();
+      __libcpp_tls_set(*key, head);
+      return nullptr;
+    }
+    __check_epoch(c);
+    return c;
+  }
+
+  // Takes the blocks of the depot of pool i into the list of c, and returns whether there were any.
+  bool __refill_from_depot(__thread_cache* c, int i) {
+    if (__depot_[i].load(memory_order_relaxed) == nullptr)
+      return false;
+    __cached_block* blocks = __depot_[i].exchange(nullptr, memory_order_acquire);
+    if (blocks == nullptr)
+      return false;
+    // The number of blocks isn't known without walking the list; the count is only used to trim the list.
+    c->__free_[i]  = blocks;
+    c->__count_[i] = __cache_batch_size(i);
+    return true;
+  }
+
+  // Moves a batch of blocks from the list of pool i of c to the depot. This is called with the mutex of the resource
+  // locked, so that the blocks are dropped instead if the resource was released since c was last checked.
+  void __return_to_depot(__thread_cache* c, int i) {
+    size_t n              = __cache_batch_size(i);
+    __cached_block* first = c->__free_[i];
+    __cached_block* last  = first;
+    for (size_t k = 1; k < n && last->__next_ != nullptr; ++k)
+      last = last->__next_;
+    c->__free_[i] = last->__next_;
+    c->__count_[i] -= n;
+    if (c->__epoch_ != __epoch_.load(memory_order_relaxed))
+      return;
+    __cached_block* head = __depot_[i].load(memory_order_relaxed);
+    do {
+      last->__next_ = head;
+    } while (!__depot_[i].compare_exchange_weak(head, first, memory_order_release, memory_order_relaxed));
+  }
+
+  // Forgets all the cached blocks, whose memory was released. This is called with the mutex of the resource locked.
+  void __invalidate() {
+    __epoch_.fetch_add(1, memory_order_relaxed);
+    for (int i = 0; i < __num_cached_pools_; ++i)
+      __depot_[i].store(nullptr, memory_order_relaxed);
+  }
+
+  int __num_cached_pools() const { return __num_cached_pools_; }
+
+private:
+  void __check_epoch(__thread_cache* c) {
+    size_t epoch = __epoch_.load(memory_order_relaxed);
+    if (c->__epoch_ != epoch) {
+      c->__clear();
+      c->__epoch_ = epoch;
+    }
+  }
+
+  __thread_cache* __adopt_orphan() {
+    for (__thread_cache* c = __caches_.load(memory_order_acquire); c != nullptr; c = c->__next_in_resource_) {
+      int expected = __cache_orphaned;
+      if (c->__state_.load(memory_order_relaxed) == __cache_orphaned &&
+          c->__state_.compare_exchange_strong(expected, __cache_owned, memory_order_acquire, memory_order_relaxed)) {
+        c->__refs_.fetch_add(1, memory_order_relaxed);
+        return c;
+      }
+    }
+    return nullptr;
+  }
+};
+
+synchronized_pool_resource::~synchronized_pool_resource() { __destroy_cache(__caches_); }
+
+__pool_thread_caches* synchronized_pool_resource::__get_caches() {
+  __pool_thread_caches* caches = __libcpp_atomic_load(&__caches_, _AO_Acquire);
+  if (caches == nullptr) {
+    unique_lock<mutex> lk(__mut_);
+    caches = __caches_;
+    if (caches == nullptr) {
+      int num_fixed_pools = 1;
+      for (size_t size = __smallest_cached_block_size; size < __unsync_.options().largest_required_pool_block; size <<= 1)
+        ++num_fixed_pools;
+      caches = __create_cache<__pool_thread_caches>(num_fixed_pools);
+      __libcpp_atomic_store(&__caches_, caches, _AO_Release);
+    }
+  }
+  return caches;
+}
+
+void synchronized_pool_resource::release() {
+  unique_lock<mutex> lk(__mut_);
+  if (__caches_ != nullptr)
+    __caches_->__invalidate();
+  __unsync_.release();
+}
+
+void* synchronized_pool_resource::do_allocate(size_t bytes, size_t align) {
+  __pool_thread_caches* caches = __get_caches();
+  int i                        = caches ? caches->__pool_index(bytes, align) : -1;
+  __thread_cache* c            = i >= 0 ? caches->__local_cache() : nullptr;
+  if (c == nullptr) {
+    unique_lock<mutex> lk(__mut_);
+    return __unsync_.allocate(bytes, align);
+  }
+
+  if (c->__free_[i] == nullptr && !caches->__refill_from_depot(c, i)) {
+    // Get a batch of blocks from the pool, which all the blocks of the size class come from.
+    size_t n          = __cache_batch_size(i);
+    size_t block_size = __pool_thread_caches::__block_size(i);
+    unique_lock<mutex> lk(__mut_);
+    void* result = __unsync_.allocate(block_size, alignof(max_align_t));
+    for (size_t k = 1; k < n; ++k) {
+      __cached_block* b = static_cast<__cached_block*>(__unsync_.allocate(block_size, alignof(max_align_t)));
+      b->__next_        = c->__free_[i];
+      c->__free_[i]     = b;
+      ++c->__count_[i];
+    }
+    return result;
+  }
+  __cached_block* b = c->__free_[i];
+  c->__free_[i]     = b->__next_;
+  if (c->__count_[i] != 0)
+    --c->__count_[i];
+  return b;
+}
+
+void synchronized_pool_resource::do_deallocate(void* p, size_t bytes, size_t align) {
+  __pool_thread_caches* caches = __get_caches();
+  int i                        = caches ? caches->__pool_index(bytes, align) : -1;
+  __thread_cache* c = i >= 0 ? caches->__local_cache() : nullptr;
+  if (c == nullptr) {
+    unique_lock<mutex> lk(__mut_);
+    __unsync_.deallocate(p, bytes, align);
+    return;
+  }
+
+  __cached_block* b = static_cast<__cached_block*>(p);
+  b->__next_        = c->__free_[i];
+  c->__free_[i]     = b;
+  if (++c->__count_[i] > 2 * __cache_batch_size(i)) {
+    unique_lock<mutex> lk(__mut_);
+    caches->__return_to_depot(c, i);
+  }
+}
+
+#endif // _LIBCPP_HAS_SYNCHRONIZED_POOL_THREAD_CACHES
+
 // 23.12.6, mem.res.monotonic.buffer
 
 void* monotonic_buffer_resource::__initial_descriptor::__try_allocate_from_chunk(size_t bytes, size_t align) {
@@ -0,0 +1,33 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <__algorithm/pstl_backends/parallel.h>
+#include <__config>
+#include <dispatch/dispatch.h>
+#include <thread>
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+
+namespace __par_backend {
+
+size_t __concurrency() noexcept {
+  static const size_t __num_threads = std::max(thread::hardware_concurrency(), 1u);
+  return __num_threads;
+}
+
+void __parallel_apply(size_t __size, void* __context, void (*__func)(void*, size_t) noexcept) noexcept {
+  if (__size == 0)
+    return;
+  // dispatch_apply_f runs some of the iterations on the calling thread, and
+  // doesn't deadlock when it's called from one of them.
+  ::dispatch_apply_f(__size, DISPATCH_APPLY_AUTO, __context, __func);
+}
+
+} // namespace __par_backend
+
+_LIBCPP_END_NAMESPACE_STD
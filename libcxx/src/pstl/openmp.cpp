@@ -0,0 +1,37 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <__algorithm/pstl_backends/parallel.h>
+#include <__config>
+#include <omp.h>
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+
+namespace __par_backend {
+
+size_t __concurrency() noexcept { return omp_get_max_threads(); }
+
+void __parallel_apply(size_t __size, void* __context, void (*__func)(void*, size_t) noexcept) noexcept {
+  if (__size == 0)
+    return;
+  if (__size == 1 || omp_in_parallel()) {
+    // OpenMP runs nested parallel regions on a single thread by default, so
+    // don't pay for creating one.
+    for (size_t __i = 0; __i != __size; ++__i)
+      __func(__context, __i);
+    return;
+  }
+
+#pragma omp parallel for schedule(dynamic, 1)
+  for (size_t __i = 0; __i < __size; ++__i)
+    __func(__context, __i);
+}
+
+} // namespace __par_backend
+
+_LIBCPP_END_NAMESPACE_STD
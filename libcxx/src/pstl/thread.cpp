@@ -0,0 +1,131 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <__algorithm/pstl_backends/parallel.h>
+#include <__config>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+
+namespace __par_backend {
+
+namespace {
+
+// A call to __parallel_apply. It lives on the stack of the calling thread,
+// which runs tasks of the job like the workers do, so that nested calls can't
+// deadlock.
+struct __job {
+  size_t __size_;
+  void* __context_;
+  void (*__func_)(void*, size_t) noexcept;
+  atomic<size_t> __next_{0};
+  atomic<size_t> __done_{0};
+};
+
+class __thread_pool {
+public:
+  __thread_pool() {
+    unsigned __num_threads = thread::hardware_concurrency();
+    // The thread calling __parallel_apply is the last one.
+    for (unsigned __i = 1; __i < __num_threads; ++__i)
+      __workers_.emplace_back([this] { __work(); });
+  }
+
+  size_t __concurrency() const { return __workers_.size() + 1; }
+
+  void __run(__job& __j) {
+    {
+      lock_guard<mutex> __lock(__mutex_);
+      __jobs_.push_back(&__j);
+    }
+    __work_available_.notify_all();
+
+    // Run the tasks no worker took yet...
+    for (size_t __i; (__i = __j.__next_.fetch_add(1)) < __j.__size_;)
+      __run_task(__j, __i);
+
+    // ...make sure no worker takes a task anymore, and wait for the ones they
+    // took to finish.
+    unique_lock<mutex> __lock(__mutex_);
+    for (auto __it = __jobs_.begin(); __it != __jobs_.end(); ++__it) {
+      if (*__it == &__j) {
+        __jobs_.erase(__it);
+        break;
+      }
+    }
+    __job_done_.wait(__lock, [&] { return __j.__done_.load() == __j.__size_; });
+  }
+
+private:
+  void __run_task(__job& __j, size_t __i) {
+    __j.__func_(__j.__context_, __i);
+    // The job may be destroyed as soon as the last task is done, so nothing
+    // in it may be touched afterwards.
+    size_t __size = __j.__size_;
+    if (__j.__done_.fetch_add(1) + 1 == __size) {
+      lock_guard<mutex> __lock(__mutex_);
+      __job_done_.notify_all();
+    }
+  }
+
+  // The workers run forever, the pool is never destroyed.
+  [[noreturn]] void __work() {
+    unique_lock<mutex> __lock(__mutex_);
+    while (true) {
+      __work_available_.wait(__lock, [this] { return !__jobs_.empty(); });
+      // Jobs are only taken from the list while the mutex is held, and the
+      // thread running a job removes it from the list under the mutex too, so
+      // a job is still alive when a task is taken from it here.
+      __job& __j = *__jobs_.front();
+      size_t __i = __j.__next_.fetch_add(1);
+      if (__i + 1 >= __j.__size_)
+        __jobs_.erase(__jobs_.begin());
+      if (__i >= __j.__size_)
+        continue;
+      __lock.unlock();
+      __run_task(__j, __i);
+      __lock.lock();
+    }
+  }
+
+  mutex __mutex_;
+  condition_variable __work_available_;
+  condition_variable __job_done_;
+  vector<__job*> __jobs_;
+  vector<thread> __workers_;
+};
+
+__thread_pool& __get_thread_pool() {
+  // This is leaked on purpose: the parallel algorithms may be used by the
+  // destructors of other static objects.
+  static __thread_pool* __pool = new __thread_pool;
+  return *__pool;
+}
+
+} // namespace
+
+size_t __concurrency() noexcept { return __get_thread_pool().__concurrency(); }
+
+void __parallel_apply(size_t __size, void* __context, void (*__func)(void*, size_t) noexcept) noexcept {
+  if (__size == 0)
+    return;
+  if (__size == 1) {
+    __func(__context, 0);
+    return;
+  }
+  __job __j{__size, __context, __func};
+  __get_thread_pool().__run(__j);
+}
+
+} // namespace __par_backend
+
+_LIBCPP_END_NAMESPACE_STD
@@ -0,0 +1,134 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03
+
+// <algorithm>
+
+// sort partitions contiguous ranges of arithmetic types with the bitset partition, and radix sorts long enough ranges
+// of integers compared with the default comparators. Make sure that both give sorted permutations of the input, around
+// the block size of the partition and the radix sort thresholds, with negative values, with many duplicates, when only
+// some of the bytes of the values differ, and for ranges that are distributed by their most significant byte first.
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "test_macros.h"
+
+template <class T, class Comp>
+void check_sort(std::vector<T> v, Comp comp) {
+  std::vector<T> expected = v;
+  std::stable_sort(expected.begin(), expected.end(), comp);
+  std::sort(v.begin(), v.end(), comp);
+  assert(v == expected);
+}
+
+template <class T>
+void check_all_comparators(const std::vector<T>& v) {
+  check_sort(v, std::less<T>());
+  check_sort(v, std::greater<T>());
+  check_sort(v, std::less<>());
+  check_sort(v, [](T x, T y) { return x < y; });
+#if TEST_STD_VER > 17
+  std::vector<T> w = v;
+  std::vector<T> expected = v;
+  std::stable_sort(expected.begin(), expected.end());
+  std::ranges::sort(w);
+  assert(w == expected);
+  w = v;
+  std::ranges::sort(w, std::ranges::greater());
+  assert(std::is_sorted(w.begin(), w.end(), std::greater<T>()));
+#endif
+}
+
+template <class T>
+void test_type() {
+  std::mt19937_64 gen(42);
+  const std::size_t sizes[] = {0, 1, 2, 5, 23, 24, 64, 127, 128, 129, 255, 256, 257, 1000, 2048, 4095, 8192, 20000};
+  for (std::size_t size : sizes) {
+    std::vector<T> v(size);
+
+    // Random values of the whole range of the type.
+    std::uniform_int_distribution<long long> all(std::numeric_limits<T>::min(), std::numeric_limits<T>::max());
+    for (T& x : v)
+      x = static_cast<T>(all(gen));
+    check_all_comparators(v);
+
+    // Only the lowest byte differs, so that radix sort skips the other passes.
+    for (T& x : v)
+      x = static_cast<T>(all(gen) & 0xff);
+    check_all_comparators(v);
+
+    // Many duplicates.
+    for (T& x : v)
+      x = static_cast<T>(static_cast<int>(gen() % 4) - 2);
+    check_all_comparators(v);
+
+    // Already sorted, reverse sorted and all equal.
+    std::sort(v.begin(), v.end());
+    check_all_comparators(v);
+    std::reverse(v.begin(), v.end());
+    check_all_comparators(v);
+    std::fill(v.begin(), v.end(), std::numeric_limits<T>::min());
+    check_all_comparators(v);
+  }
+}
+
+template <class T>
+void test_large(std::size_t size) {
+  std::mt19937_64 gen(42);
+  std::vector<T> v(size);
+  for (T& x : v)
+    x = static_cast<T>(gen());
+  check_sort(v, std::less<T>());
+
+  // Most of the elements are in a few of the parts for the most significant byte.
+  for (T& x : v)
+    x = static_cast<T>(gen() % 8 == 0 ? gen() : gen() >> (64 - sizeof(T) * 8 + 3));
+  check_sort(v, std::less<T>());
+}
+
+void test_floating_point() {
+  std::mt19937_64 gen(42);
+  std::uniform_real_distribution<double> dist(-1000, 1000);
+  for (std::size_t size : {10, 100, 1000, 10000}) {
+    std::vector<double> v(size);
+    for (double& x : v)
+      x = dist(gen);
+    check_sort(v, std::less<double>());
+    check_sort(v, std::greater<double>());
+    std::vector<float> w(size);
+    for (float& x : w)
+      x = static_cast<float>(static_cast<int>(dist(gen)) % 10);
+    check_sort(w, std::less<float>());
+  }
+}
+
+int main(int, char**) {
+  test_type<signed char>();
+  test_type<unsigned char>();
+  test_type<short>();
+  test_type<unsigned short>();
+  test_type<int>();
+  test_type<unsigned>();
+  test_type<long long>();
+  test_type<unsigned long long>();
+  test_type<std::int64_t>();
+  test_type<std::uint64_t>();
+  test_large<int>(std::size_t(1) << 22);
+  test_large<std::uint64_t>(std::size_t(1) << 21);
+  test_floating_point();
+  return 0;
+}
@@ -0,0 +1,147 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03
+
+// <algorithm>
+
+// find, count, mismatch, equal, min_element and max_element compare the elements of contiguous ranges of arithmetic
+// types a vector at a time. Make sure that they give the same results as the scalar loops, for every position of the
+// element they look for relative to the vectors, for the elements that don't fill a vector, and for values of other
+// types than the elements.
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "test_macros.h"
+
+template <class T>
+void test_find_count(std::vector<T>& v) {
+  for (std::size_t i = 0; i != v.size(); ++i) {
+    T value = v[i];
+    auto expected = std::find_if(v.begin(), v.end(), [&](T x) { return x == value; });
+    assert(std::find(v.begin(), v.end(), value) == expected);
+    assert(std::count(v.begin(), v.end(), value) == std::count_if(v.begin(), v.end(), [&](T x) { return x == value; }));
+  }
+  assert(std::find(v.begin(), v.end(), T(100)) == v.end());
+  assert(std::count(v.begin(), v.end(), T(100)) == 0);
+}
+
+template <class T>
+void test_mismatch_equal(std::vector<T>& v) {
+  std::vector<T> w = v;
+  assert(std::equal(v.begin(), v.end(), w.begin()));
+  assert(std::mismatch(v.begin(), v.end(), w.begin()).first == v.end());
+  for (std::size_t i = 0; i != v.size(); ++i) {
+    w[i] = T(99);
+    assert(std::mismatch(v.begin(), v.end(), w.begin()).first == v.begin() + i);
+    assert(std::mismatch(v.cbegin(), v.cend(), w.data()).second == w.data() + i);
+    assert(!std::equal(v.begin(), v.end(), w.begin()));
+#if TEST_STD_VER >= 14
+    std::size_t n = i / 2 + 1;
+    assert(std::mismatch(v.begin(), v.end(), w.begin(), w.begin() + n).first == v.begin() + std::min(i, n));
+    assert(std::equal(v.begin(), v.begin() + i, w.begin(), w.begin() + i));
+    assert(!std::equal(v.begin(), v.end(), w.begin(), w.end() - 1));
+#endif
+    w[i] = v[i];
+  }
+}
+
+template <class T>
+void test_min_max_element(std::vector<T>& v) {
+  for (std::size_t i = 0; i != v.size(); ++i) {
+    T old = v[i];
+    v[i]  = T(0);
+    assert(std::min_element(v.begin(), v.end()) == std::min_element(v.begin(), v.end(), [](T x, T y) {
+             return x < y;
+           }));
+    v[i] = T(100);
+    assert(std::max_element(v.begin(), v.end()) == std::max_element(v.begin(), v.end(), [](T x, T y) {
+             return x < y;
+           }));
+    v[i] = old;
+  }
+}
+
+template <class T>
+void test() {
+  for (std::size_t size = 0; size != 200; ++size) {
+    std::vector<T> v(size);
+    for (std::size_t i = 0; i != size; ++i)
+      v[i] = T(i % 37 + 1);
+    test_find_count(v);
+    test_mismatch_equal(v);
+    test_min_max_element(v);
+  }
+
+  // More matches than a lane of the counters can hold.
+  std::vector<T> v(70000, T(7));
+  assert(std::count(v.begin(), v.end(), T(7)) == 70000);
+}
+
+int main(int, char**) {
+  test<char>();
+  test<signed char>();
+  test<unsigned char>();
+  test<wchar_t>();
+  test<char16_t>();
+  test<char32_t>();
+  test<short>();
+  test<unsigned short>();
+  test<int>();
+  test<unsigned>();
+  test<long>();
+  test<unsigned long>();
+  test<long long>();
+  test<unsigned long long>();
+  test<float>();
+  test<double>();
+
+  // The values are compared after the usual arithmetic conversions.
+  {
+    std::vector<unsigned> v(100, 5);
+    v[50] = 0xffffffff;
+    assert(std::find(v.begin(), v.end(), -1) == v.begin() + 50);
+    assert(std::count(v.begin(), v.end(), -1) == 1);
+    assert(std::find(v.begin(), v.end(), 5LL + (1LL << 32)) == v.end());
+  }
+  {
+    std::vector<short> v(100, 1);
+    v[10] = -1;
+    assert(std::find(v.begin(), v.end(), 65535) == v.end());
+    assert(std::find(v.begin(), v.end(), -1LL) == v.begin() + 10);
+    assert(std::count(v.begin(), v.end(), 1u) == 99);
+  }
+  {
+    std::vector<std::uint8_t> v(100, 1);
+    v[99] = 2;
+    assert(std::find(v.begin(), v.end(), 258) == v.end());
+    assert(std::find(v.begin(), v.end(), 2) == v.begin() + 99);
+  }
+  {
+    std::vector<double> v(100, 0.0);
+    v[20] = -0.0;
+    assert(std::find(v.begin(), v.end(), -0.0) == v.begin());
+    v[30] = std::numeric_limits<double>::infinity();
+    assert(std::find(v.begin(), v.end(), v[30]) == v.begin() + 30);
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    v[40] = nan;
+    assert(std::find(v.begin(), v.end(), nan) == v.end());
+    assert(std::count(v.begin(), v.end(), nan) == 0);
+    std::vector<double> w = v;
+    assert(std::mismatch(v.begin(), v.end(), w.begin()).first == v.begin() + 40);
+    assert(!std::equal(v.begin(), v.end(), w.begin()));
+  }
+
+  return 0;
+}
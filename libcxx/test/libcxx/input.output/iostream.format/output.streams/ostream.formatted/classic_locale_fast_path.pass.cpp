@@ -0,0 +1,156 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// <ostream>
+
+// The arithmetic inserters of basic_ostream<char> format numbers without the
+// num_put facet when the stream uses the classic locale. Make sure the output
+// is the same as the one of num_put for all the formatting flags, by comparing
+// with a stream whose locale has a num_put facet that isn't from the classic
+// locale.
+
+// XFAIL: use_system_cxx_lib
+
+#include <cassert>
+#include <ios>
+#include <limits>
+#include <locale>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+#include "test_macros.h"
+
+struct Options {
+  std::ios_base::fmtflags flags;
+  std::streamsize width;
+  std::streamsize precision;
+  char fill;
+};
+
+template <class T>
+std::string format(T value, const Options& opts, bool classic) {
+  std::ostringstream os;
+  if (!classic)
+    os.imbue(std::locale(std::locale::classic(), new std::num_put<char>));
+  os.flags(opts.flags);
+  os.width(opts.width);
+  os.precision(opts.precision);
+  os.fill(opts.fill);
+  os << value << '|';
+  assert(os.good());
+  assert(os.width() == 0);
+  return os.str();
+}
+
+template <class T>
+void check(T value, const Options& opts) {
+  std::string fast = format(value, opts, true);
+  std::string slow = format(value, opts, false);
+  assert(fast == slow);
+}
+
+struct FailingBuf : std::streambuf {
+  int_type overflow(int_type) override { return traits_type::eof(); }
+};
+
+const std::ios_base::fmtflags adjust_fields[] = {
+    std::ios_base::fmtflags(), std::ios_base::left, std::ios_base::right, std::ios_base::internal};
+
+template <class T>
+void test_integral() {
+  const std::ios_base::fmtflags base_fields[] = {
+      std::ios_base::fmtflags(), std::ios_base::dec, std::ios_base::oct, std::ios_base::hex,
+      std::ios_base::dec | std::ios_base::hex};
+  const std::ios_base::fmtflags extra_flags[] = {
+      std::ios_base::fmtflags(),
+      std::ios_base::showbase,
+      std::ios_base::showpos,
+      std::ios_base::uppercase,
+      std::ios_base::showbase | std::ios_base::uppercase | std::ios_base::showpos};
+  const T values[] = {T(0),
+                      T(1),
+                      T(7),
+                      T(42),
+                      T(255),
+                      T(12345),
+                      T(-1),
+                      T(-42),
+                      std::numeric_limits<T>::min(),
+                      std::numeric_limits<T>::max()};
+  for (std::ios_base::fmtflags base : base_fields)
+    for (std::ios_base::fmtflags extra : extra_flags)
+      for (std::ios_base::fmtflags adjust : adjust_fields)
+        for (std::streamsize width : {0, 1, 8, 30})
+          for (T value : values)
+            check(value, Options{base | extra | adjust, width, 6, '*'});
+}
+
+template <class T>
+void test_floating_point() {
+  const std::ios_base::fmtflags float_fields[] = {
+      std::ios_base::fmtflags(), std::ios_base::fixed, std::ios_base::scientific,
+      std::ios_base::fixed | std::ios_base::scientific};
+  const std::ios_base::fmtflags extra_flags[] = {
+      std::ios_base::fmtflags(),
+      std::ios_base::showpoint,
+      std::ios_base::showpos,
+      std::ios_base::uppercase,
+      std::ios_base::showpos | std::ios_base::uppercase};
+  const T values[] = {T(0),
+                      -T(0),
+                      T(1),
+                      T(0.1),
+                      T(-2.5),
+                      T(3.14159265358979),
+                      T(1234567.0),
+                      T(1e-7),
+                      T(6.02214076e23),
+                      std::numeric_limits<T>::min(),
+                      std::numeric_limits<T>::max(),
+                      std::numeric_limits<T>::denorm_min(),
+                      std::numeric_limits<T>::infinity(),
+                      -std::numeric_limits<T>::infinity(),
+                      std::numeric_limits<T>::quiet_NaN()};
+  for (std::ios_base::fmtflags field : float_fields)
+    for (std::ios_base::fmtflags extra : extra_flags)
+      for (std::ios_base::fmtflags adjust : adjust_fields)
+        for (std::streamsize precision : {-1, 0, 1, 6, 17, 40})
+          for (std::streamsize width : {0, 12})
+            for (T value : values)
+              check(value, Options{field | extra | adjust, width, precision, '_'});
+}
+
+int main(int, char**) {
+  test_integral<short>();
+  test_integral<unsigned short>();
+  test_integral<int>();
+  test_integral<unsigned int>();
+  test_integral<long>();
+  test_integral<unsigned long>();
+  test_integral<long long>();
+  test_integral<unsigned long long>();
+  test_floating_point<float>();
+  test_floating_point<double>();
+  test_floating_point<long double>();
+
+  {
+    // A stream buffer that fails sets badbit and failbit, like num_put does.
+    FailingBuf buf;
+    std::ostream os(&buf);
+    os << 42;
+    assert(os.bad());
+    assert(os.fail());
+    os.clear();
+    os << 4.2;
+    assert(os.bad());
+    assert(os.fail());
+  }
+
+  return 0;
+}
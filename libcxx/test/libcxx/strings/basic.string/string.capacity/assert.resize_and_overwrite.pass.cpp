@@ -0,0 +1,30 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// <string>
+
+// Return a size larger than n from the operation passed to resize_and_overwrite.
+
+// REQUIRES: has-unix-headers
+// UNSUPPORTED: c++03, c++11, c++14, c++17, c++20
+// XFAIL: use_system_cxx_lib && target={{.+}}-apple-macosx{{10.9|10.10|10.11|10.12|10.13|10.14|10.15|11.0|12.0}}
+// ADDITIONAL_COMPILE_FLAGS: -D_LIBCPP_ENABLE_ASSERTIONS=1
+
+#include <string>
+
+#include "check_assertion.h"
+
+int main(int, char**) {
+  std::string s;
+  TEST_LIBCPP_ASSERT_FAILURE(s.resize_and_overwrite(10, [](char*, std::size_t n) { return n + 1; }),
+                             "basic_string::resize_and_overwrite: the operation returned a size outside of [0, n]");
+  TEST_LIBCPP_ASSERT_FAILURE(s.resize_and_overwrite(10, [](char*, std::size_t) { return -1; }),
+                             "basic_string::resize_and_overwrite: the operation returned a size outside of [0, n]");
+
+  return 0;
+}
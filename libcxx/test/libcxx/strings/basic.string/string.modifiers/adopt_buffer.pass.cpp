@@ -0,0 +1,65 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// <string>
+
+// __adopt_buffer(pointer, size_type, size_type)
+
+#include <string>
+#include <cassert>
+#include <memory>
+
+#include "test_macros.h"
+#include "min_allocator.h"
+
+template <class S>
+TEST_CONSTEXPR_CXX20 void test_adopt(S s) {
+  typename S::allocator_type a = s.get_allocator();
+  typename S::pointer p = std::allocator_traits<typename S::allocator_type>::allocate(a, 64);
+  for (int i = 0; i != 40; ++i)
+    p[i] = static_cast<char>('a' + i % 26);
+
+  s.__adopt_buffer(p, 40, 64);
+  assert(s.size() == 40);
+  assert(s.capacity() == 63);
+  assert(s.data() == std::__to_address(p));
+  assert(s.data()[40] == '\0');
+  for (int i = 0; i != 40; ++i)
+    assert(s[i] == 'a' + i % 26);
+
+  // The string owns the buffer now, so it can grow out of it and release it.
+  s.append(100, 'x');
+  assert(s.size() == 140);
+  assert(s[39] == 'a' + 39 % 26);
+  assert(s[139] == 'x');
+}
+
+template <class S>
+TEST_CONSTEXPR_CXX20 void test_string() {
+  test_adopt(S());
+  test_adopt(S("short"));
+  test_adopt(S(100, 'y'));
+}
+
+TEST_CONSTEXPR_CXX20 bool test() {
+  test_string<std::string>();
+#if TEST_STD_VER >= 11
+  test_string<std::basic_string<char, std::char_traits<char>, min_allocator<char> > >();
+#endif
+
+  return true;
+}
+
+int main(int, char**) {
+  test();
+#if TEST_STD_VER > 17
+  static_assert(test());
+#endif
+
+  return 0;
+}
@@ -0,0 +1,74 @@
+//===----------------------------------------------------------------------===//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17
+// UNSUPPORTED: libcpp-has-no-incomplete-format
+
+// <format>
+
+// The replacement fields of a basic_format_string are recorded during its
+// compile-time validation, and the formatting functions use them instead of
+// parsing the format string again. Test that the recorded fields are correct
+// and produce the same output as the run-time parser.
+
+#include <format>
+#include <cassert>
+#include <string>
+#include <string_view>
+
+#include "test_macros.h"
+
+template <class... Args>
+void check(std::string_view expected, std::format_string<const Args&...> fmt, const Args&... args) {
+  assert(std::format(fmt, args...) == expected);
+  assert(std::vformat(fmt.get(), std::make_format_args(args...)) == expected);
+
+  std::string out;
+  std::format_to(std::back_inserter(out), fmt, args...);
+  assert(out == expected);
+
+  assert(std::formatted_size(fmt, args...) == expected.size());
+
+  char buffer[8];
+  auto result = std::format_to_n(buffer, sizeof(buffer), fmt, args...);
+  assert(static_cast<size_t>(result.size) == expected.size());
+  assert(std::string_view(buffer, result.out) == expected.substr(0, sizeof(buffer)));
+}
+
+template <class... Args>
+constexpr size_t num_fields(std::format_string<Args...> fmt) {
+  return fmt.__fields().__size_;
+}
+
+constexpr size_t unknown = std::__format::__replacement_fields::__unknown;
+
+int main(int, char**) {
+  static_assert(num_fields("no fields") == 0);
+  static_assert(num_fields<int, int>("a{}b{}c") == 2);
+  static_assert(num_fields<int, int>("{1}{0}") == 2);
+  static_assert(num_fields<int, int>("{:{}}") == 1);
+  static_assert(num_fields<int>("{0}{0}") == unknown);
+
+  static_assert(std::format_string<int, int>("{}{}").__fields().__automatic_);
+  static_assert(!std::format_string<int, int>("{1}{0}").__fields().__automatic_);
+  static_assert(!std::format_string<int>("{}").__fields().__escapes_);
+  static_assert(std::format_string<int>("{{{}}}").__fields().__escapes_);
+
+  check("no fields", "no fields");
+  check("a1bxyc", "a{}b{}c", 1, "xy");
+  check("2-1", "{1}-{0}", 1, 2);
+  check("7-7", "{0}-{0}", 7);
+  check("{5}", "{{{}}}", 5);
+  check("}5{", "}}{}{{", 5);
+  check("ff 1.50", "{:x} {:.2f}", 255, 1.5);
+  check("   3|9", "{:>{}}|{}", 3, 4, 9);
+  check("   3|9", "{0:>{1}}|{2}", 3, 4, 9);
+  check("**abc**", "{:*^7}", std::string("abc"));
+  check("1 2 3 4 5", "{} {} {} {} {}", 1, 2, 3, 4, 5);
+
+  return 0;
+}
@@ -0,0 +1,92 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17, c++20
+
+// <functional>
+
+// Make sure that move_only_function stores callables of up to
+// _LIBCPP_MOVE_ONLY_FUNCTION_BUFFER_SIZE bytes whose move constructor doesn't
+// throw without allocating, and that it allocates for all the others.
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "count_new.h"
+#include "test_macros.h"
+
+template <std::size_t Size>
+struct Sized {
+  unsigned char bytes[Size] = {};
+  int operator()() const { return Size; }
+};
+
+struct ThrowingMove {
+  int value = 0;
+  ThrowingMove() = default;
+  ThrowingMove(ThrowingMove&&) noexcept(false) {}
+  int operator()() const { return value; }
+};
+
+struct Tracked {
+  static int moves;
+  std::unique_ptr<int> p = std::make_unique<int>(3);
+  Tracked() = default;
+  Tracked(Tracked&& other) noexcept : p(std::move(other.p)) { ++moves; }
+  int operator()() const { return *p; }
+};
+int Tracked::moves = 0;
+
+static_assert(sizeof(std::move_only_function<void()>) ==
+              _LIBCPP_MOVE_ONLY_FUNCTION_BUFFER_SIZE + 2 * sizeof(void*));
+
+int main(int, char**) {
+  {
+    // A lambda capturing six pointers is stored inline.
+    int a = 1, b = 2, c = 3, d = 4, e = 5, f = 6;
+    globalMemCounter.reset();
+    std::move_only_function<int()> func = [&a, &b, &c, &d, &e, &f] { return a + b + c + d + e + f; };
+    std::move_only_function<int()> moved = std::move(func);
+    assert(moved() == 21);
+    assert(globalMemCounter.checkNewCalledEq(0));
+  }
+  {
+    globalMemCounter.reset();
+    std::move_only_function<int()> func = Sized<_LIBCPP_MOVE_ONLY_FUNCTION_BUFFER_SIZE>{};
+    assert(globalMemCounter.checkNewCalledEq(0));
+    std::move_only_function<int()> large = Sized<_LIBCPP_MOVE_ONLY_FUNCTION_BUFFER_SIZE + 1>{};
+    assert(globalMemCounter.checkNewCalledEq(1));
+    // Moving a heap allocated callable only transfers the pointer.
+    std::move_only_function<int()> moved = std::move(large);
+    assert(globalMemCounter.checkNewCalledEq(1));
+    assert(moved() == _LIBCPP_MOVE_ONLY_FUNCTION_BUFFER_SIZE + 1);
+  }
+  assert(globalMemCounter.checkOutstandingNewEq(0));
+  {
+    globalMemCounter.reset();
+    std::move_only_function<int()> func = ThrowingMove{};
+    assert(globalMemCounter.checkNewCalledEq(1));
+  }
+  assert(globalMemCounter.checkOutstandingNewEq(0));
+  {
+    // Callables that aren't trivially copyable are moved with their move
+    // constructor when the move_only_function is moved.
+    std::move_only_function<int()> func = Tracked{};
+    Tracked::moves = 0;
+    std::move_only_function<int()> moved = std::move(func);
+    assert(Tracked::moves == 1);
+    std::move_only_function<int()> empty;
+    moved.swap(empty);
+    assert(empty() == 3);
+  }
+
+  return 0;
+}
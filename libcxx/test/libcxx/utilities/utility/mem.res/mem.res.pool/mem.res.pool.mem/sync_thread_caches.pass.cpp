@@ -0,0 +1,144 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+// UNSUPPORTED: no-threads
+// XFAIL: use_system_cxx_lib && target={{.+}}-apple-macosx10.{{9|10|11|12|13|14|15}}
+// XFAIL: use_system_cxx_lib && target={{.+}}-apple-macosx{{11.0|12.0}}
+
+// <memory_resource>
+
+// class synchronized_pool_resource
+
+// With the unstable ABI, the blocks of the small size classes are cached by each thread. Make sure that blocks are
+// never handed out twice when threads allocate concurrently, when blocks are deallocated by other threads than the ones
+// that allocated them, when the caches of exited threads are reused, when the resource is released while the caches
+// hold blocks, and when the resource is destroyed before the threads that used it.
+
+#include <memory_resource>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+struct Block {
+  void* p;
+  std::size_t size;
+  std::size_t align;
+};
+
+static void fill(const Block& b, unsigned char value) { std::memset(b.p, value, b.size); }
+
+static void check(const Block& b, unsigned char value) {
+  const unsigned char* bytes = static_cast<const unsigned char*>(b.p);
+  for (std::size_t i = 0; i < b.size; ++i)
+    assert(bytes[i] == value);
+}
+
+static std::vector<Block> allocate_blocks(std::pmr::memory_resource& res, int n, unsigned char value) {
+  const std::size_t sizes[] = {1, 8, 13, 16, 24, 64, 100, 256, 1000, 4096, 5000, 70000};
+  std::vector<Block> blocks;
+  for (int i = 0; i < n; ++i) {
+    std::size_t size  = sizes[i % (sizeof(sizes) / sizeof(sizes[0]))];
+    std::size_t align = i % 7 == 0 ? 64 : alignof(std::max_align_t);
+    Block b           = {res.allocate(size, align), size, align};
+    assert(reinterpret_cast<std::size_t>(b.p) % align == 0);
+    fill(b, value);
+    blocks.push_back(b);
+  }
+  return blocks;
+}
+
+static void deallocate_blocks(std::pmr::memory_resource& res, const std::vector<Block>& blocks, unsigned char value) {
+  for (const Block& b : blocks) {
+    check(b, value);
+    res.deallocate(b.p, b.size, b.align);
+  }
+}
+
+static void test_concurrent_allocations() {
+  std::pmr::synchronized_pool_resource res;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; ++t) {
+    threads.emplace_back([&res, t] {
+      unsigned char value = static_cast<unsigned char>(t + 1);
+      for (int round = 0; round < 20; ++round) {
+        std::vector<Block> blocks = allocate_blocks(res, 500, value);
+        deallocate_blocks(res, blocks, value);
+      }
+    });
+  }
+  for (std::thread& t : threads)
+    t.join();
+}
+
+static void test_cross_thread_deallocations() {
+  std::pmr::synchronized_pool_resource res;
+  std::vector<std::vector<Block> > blocks(8);
+  for (int round = 0; round < 4; ++round) {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t)
+      threads.emplace_back([&res, &blocks, t] { blocks[t] = allocate_blocks(res, 2000, static_cast<unsigned char>(t)); });
+    for (std::thread& t : threads)
+      t.join();
+    threads.clear();
+    // Each thread frees the blocks of another one, and allocates again from the blocks it got back.
+    for (int t = 0; t < 8; ++t) {
+      threads.emplace_back([&res, &blocks, t] {
+        int other = (t + 1) % 8;
+        deallocate_blocks(res, blocks[other], static_cast<unsigned char>(other));
+        std::vector<Block> mine = allocate_blocks(res, 2000, static_cast<unsigned char>(t + 100));
+        deallocate_blocks(res, mine, static_cast<unsigned char>(t + 100));
+      });
+    }
+    for (std::thread& t : threads)
+      t.join();
+  }
+}
+
+static void test_release() {
+  std::pmr::synchronized_pool_resource res;
+  std::vector<Block> blocks = allocate_blocks(res, 1000, 1);
+  deallocate_blocks(res, blocks, 1);
+  std::thread([&res] { deallocate_blocks(res, allocate_blocks(res, 1000, 2), 2); }).join();
+  res.release();
+  // The blocks cached before the release must not be handed out anymore.
+  blocks = allocate_blocks(res, 1000, 3);
+  std::vector<Block> other;
+  std::thread([&res, &other] { other = allocate_blocks(res, 1000, 4); }).join();
+  deallocate_blocks(res, blocks, 3);
+  deallocate_blocks(res, other, 4);
+  res.release();
+}
+
+static void test_destroyed_while_threads_run() {
+  std::pmr::synchronized_pool_resource* res = new std::pmr::synchronized_pool_resource;
+  std::thread t([&] {
+    deallocate_blocks(*res, allocate_blocks(*res, 1000, 5), 5);
+    delete res;
+    // Using another resource from the same thread forgets the caches of the destroyed one.
+    std::pmr::synchronized_pool_resource res2;
+    deallocate_blocks(res2, allocate_blocks(res2, 1000, 6), 6);
+  });
+  t.join();
+
+  // Destroy a resource whose cache belongs to a thread that is still running.
+  res = new std::pmr::synchronized_pool_resource;
+  std::thread([&] { deallocate_blocks(*res, allocate_blocks(*res, 1000, 7), 7); }).join();
+  deallocate_blocks(*res, allocate_blocks(*res, 1000, 8), 8);
+  delete res;
+}
+
+int main(int, char**) {
+  test_concurrent_allocations();
+  test_cross_thread_deallocations();
+  test_release();
+  test_destroyed_while_threads_run();
+  return 0;
+}
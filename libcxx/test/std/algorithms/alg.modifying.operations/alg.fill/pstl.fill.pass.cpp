@@ -0,0 +1,51 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+// UNSUPPORTED: libcpp-has-no-incomplete-pstl
+
+// <algorithm>
+
+// template<class ExecutionPolicy, class ForwardIterator, class T>
+//   void fill(ExecutionPolicy&& exec, ForwardIterator first, ForwardIterator last, const T& value);
+//
+// template<class ExecutionPolicy, class ForwardIterator, class Size, class T>
+//   ForwardIterator fill_n(ExecutionPolicy&& exec, ForwardIterator first, Size n, const T& value);
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+#include "test_macros.h"
+#include "test_execution_policies.h"
+#include "test_iterators.h"
+
+template <class Iter>
+struct Test {
+  template <class Policy>
+  void operator()(Policy&& policy) {
+    for (int size : execution_test_sizes) {
+      std::vector<int> a(size);
+      std::fill(policy, Iter(a.data()), Iter(a.data() + a.size()), 7);
+      assert(std::count(a.begin(), a.end(), 7) == size);
+
+      Iter it = std::fill_n(policy, Iter(a.data()), size / 2, 4);
+      assert(base(it) == a.data() + size / 2);
+      assert(std::count(a.begin(), a.end(), 4) == size / 2);
+      assert(std::count(a.begin(), a.end(), 7) == size - size / 2);
+    }
+  }
+};
+
+int main(int, char**) {
+  test_execution_policies(Test<int*>());
+  test_execution_policies(Test<forward_iterator<int*>>());
+  test_execution_policies(Test<random_access_iterator<int*>>());
+
+  return 0;
+}
@@ -0,0 +1,64 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+// UNSUPPORTED: libcpp-has-no-incomplete-pstl
+
+// <algorithm>
+
+// template<class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2, class UnaryOperation>
+//   ForwardIterator2 transform(ExecutionPolicy&& exec, ForwardIterator1 first1, ForwardIterator1 last1,
+//                              ForwardIterator2 result, UnaryOperation op);
+//
+// template<class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2, class ForwardIterator,
+//          class BinaryOperation>
+//   ForwardIterator transform(ExecutionPolicy&& exec, ForwardIterator1 first1, ForwardIterator1 last1,
+//                             ForwardIterator2 first2, ForwardIterator result, BinaryOperation binary_op);
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+#include "test_macros.h"
+#include "test_execution_policies.h"
+#include "test_iterators.h"
+
+template <class Iter>
+struct Test {
+  template <class Policy>
+  void operator()(Policy&& policy) {
+    for (int size : execution_test_sizes) {
+      std::vector<int> a(size);
+      for (int i = 0; i != size; ++i)
+        a[i] = i;
+      std::vector<int> b(size);
+
+      Iter it = std::transform(
+          policy, Iter(a.data()), Iter(a.data() + a.size()), Iter(b.data()), [](int i) { return 2 * i; });
+      assert(base(it) == b.data() + size);
+      for (int i = 0; i != size; ++i)
+        assert(b[i] == 2 * i);
+
+      std::vector<int> c(size);
+      it = std::transform(
+          policy, Iter(a.data()), Iter(a.data() + a.size()), Iter(b.data()), Iter(c.data()), [](int x, int y) {
+            return y - x;
+          });
+      assert(base(it) == c.data() + size);
+      assert(c == a);
+    }
+  }
+};
+
+int main(int, char**) {
+  test_execution_policies(Test<int*>());
+  test_execution_policies(Test<forward_iterator<int*>>());
+  test_execution_policies(Test<random_access_iterator<int*>>());
+
+  return 0;
+}
@@ -0,0 +1,51 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+// UNSUPPORTED: libcpp-has-no-incomplete-pstl
+
+// <algorithm>
+
+// template<class ExecutionPolicy, class ForwardIterator, class Function>
+//   void for_each(ExecutionPolicy&& exec, ForwardIterator first, ForwardIterator last, Function f);
+//
+// template<class ExecutionPolicy, class ForwardIterator, class Size, class Function>
+//   ForwardIterator for_each_n(ExecutionPolicy&& exec, ForwardIterator first, Size n, Function f);
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+#include "test_macros.h"
+#include "test_execution_policies.h"
+#include "test_iterators.h"
+
+template <class Iter>
+struct Test {
+  template <class Policy>
+  void operator()(Policy&& policy) {
+    for (int size : execution_test_sizes) {
+      std::vector<int> a(size, 1);
+      std::for_each(policy, Iter(a.data()), Iter(a.data() + a.size()), [](int& i) { i += 2; });
+      assert(std::all_of(a.begin(), a.end(), [](int i) { return i == 3; }));
+
+      Iter it = std::for_each_n(policy, Iter(a.data()), size / 2, [](int& i) { i = 0; });
+      assert(base(it) == a.data() + size / 2);
+      assert(std::count(a.begin(), a.end(), 0) == size / 2);
+      assert(std::count(a.begin(), a.end(), 3) == size - size / 2);
+    }
+  }
+};
+
+int main(int, char**) {
+  test_execution_policies(Test<int*>());
+  test_execution_policies(Test<forward_iterator<int*>>());
+  test_execution_policies(Test<random_access_iterator<int*>>());
+
+  return 0;
+}
@@ -0,0 +1,59 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+// UNSUPPORTED: libcpp-has-no-incomplete-pstl
+
+// <algorithm>
+
+// template<class ExecutionPolicy, class RandomAccessIterator>
+//   void sort(ExecutionPolicy&& exec, RandomAccessIterator first, RandomAccessIterator last);
+//
+// template<class ExecutionPolicy, class RandomAccessIterator, class Compare>
+//   void sort(ExecutionPolicy&& exec, RandomAccessIterator first, RandomAccessIterator last, Compare comp);
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "test_macros.h"
+#include "test_execution_policies.h"
+#include "test_iterators.h"
+
+template <class Iter>
+struct Test {
+  template <class Policy>
+  void operator()(Policy&& policy) {
+    std::mt19937 gen;
+    for (int size : execution_test_sizes) {
+      std::vector<int> v(size);
+      for (int& i : v)
+        i = gen() % 1000;
+      std::vector<int> expected = v;
+      std::sort(expected.begin(), expected.end());
+
+      std::vector<int> a = v;
+      std::sort(policy, Iter(a.data()), Iter(a.data() + a.size()));
+      assert(a == expected);
+
+      a = v;
+      std::sort(policy, Iter(a.data()), Iter(a.data() + a.size()), std::greater<int>());
+      std::reverse(a.begin(), a.end());
+      assert(a == expected);
+    }
+  }
+};
+
+int main(int, char**) {
+  test_execution_policies(Test<int*>());
+  test_execution_policies(Test<random_access_iterator<int*>>());
+
+  return 0;
+}
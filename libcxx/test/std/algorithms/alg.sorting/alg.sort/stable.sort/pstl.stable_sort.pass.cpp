@@ -0,0 +1,64 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+// UNSUPPORTED: libcpp-has-no-incomplete-pstl
+
+// <algorithm>
+
+// template<class ExecutionPolicy, class RandomAccessIterator>
+//   void stable_sort(ExecutionPolicy&& exec, RandomAccessIterator first, RandomAccessIterator last);
+//
+// template<class ExecutionPolicy, class RandomAccessIterator, class Compare>
+//   void stable_sort(ExecutionPolicy&& exec, RandomAccessIterator first, RandomAccessIterator last, Compare comp);
+
+#include <algorithm>
+#include <cassert>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "test_macros.h"
+#include "test_execution_policies.h"
+#include "test_iterators.h"
+
+template <class Iter>
+struct Test {
+  template <class Policy>
+  void operator()(Policy&& policy) {
+    using Value = std::pair<int, std::string>;
+    std::mt19937 gen;
+    for (int size : execution_test_sizes) {
+      // Few distinct keys, so that the stability is observable.
+      std::vector<Value> v;
+      for (int i = 0; i != size; ++i)
+        v.emplace_back(gen() % 16, std::to_string(i));
+      auto comp = [](const Value& lhs, const Value& rhs) { return lhs.first < rhs.first; };
+      std::vector<Value> expected = v;
+      std::stable_sort(expected.begin(), expected.end(), comp);
+
+      std::vector<Value> a = v;
+      std::stable_sort(policy, Iter(a.data()), Iter(a.data() + a.size()), comp);
+      assert(a == expected);
+
+      // Without a comparator the whole pair is compared.
+      a = v;
+      std::stable_sort(policy, Iter(a.data()), Iter(a.data() + a.size()));
+      std::sort(expected.begin(), expected.end());
+      assert(a == expected);
+    }
+  }
+};
+
+int main(int, char**) {
+  test_execution_policies(Test<std::pair<int, std::string>*>());
+  test_execution_policies(Test<random_access_iterator<std::pair<int, std::string>*>>());
+
+  return 0;
+}
@@ -0,0 +1,76 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+// UNSUPPORTED: libcpp-has-no-incomplete-pstl
+
+// <numeric>
+
+// template<class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2>
+//   ForwardIterator2 inclusive_scan(ExecutionPolicy&& exec, ForwardIterator1 first, ForwardIterator1 last,
+//                                   ForwardIterator2 result);
+//
+// template<class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2, class BinaryOperation>
+//   ForwardIterator2 inclusive_scan(ExecutionPolicy&& exec, ForwardIterator1 first, ForwardIterator1 last,
+//                                   ForwardIterator2 result, BinaryOperation binary_op);
+//
+// template<class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2, class BinaryOperation, class T>
+//   ForwardIterator2 inclusive_scan(ExecutionPolicy&& exec, ForwardIterator1 first, ForwardIterator1 last,
+//                                   ForwardIterator2 result, BinaryOperation binary_op, T init);
+
+#include <cassert>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+#include "test_macros.h"
+#include "test_execution_policies.h"
+#include "test_iterators.h"
+
+template <class Iter>
+struct Test {
+  template <class Policy>
+  void operator()(Policy&& policy) {
+    for (int size : execution_test_sizes) {
+      std::vector<int> a(size);
+      for (int i = 0; i != size; ++i)
+        a[i] = i % 9;
+      std::vector<int> expected(size);
+      std::partial_sum(a.begin(), a.end(), expected.begin());
+
+      std::vector<int> b(size);
+      Iter it = std::inclusive_scan(policy, Iter(a.data()), Iter(a.data() + a.size()), Iter(b.data()));
+      assert(base(it) == b.data() + size);
+      assert(b == expected);
+
+      std::fill(b.begin(), b.end(), 0);
+      it = std::inclusive_scan(policy, Iter(a.data()), Iter(a.data() + a.size()), Iter(b.data()), std::plus<>());
+      assert(base(it) == b.data() + size);
+      assert(b == expected);
+
+      std::fill(b.begin(), b.end(), 0);
+      it = std::inclusive_scan(policy, Iter(a.data()), Iter(a.data() + a.size()), Iter(b.data()), std::plus<>(), 5);
+      assert(base(it) == b.data() + size);
+      for (int i = 0; i != size; ++i)
+        assert(b[i] == expected[i] + 5);
+
+      // In place.
+      it = std::inclusive_scan(policy, Iter(a.data()), Iter(a.data() + a.size()), Iter(a.data()));
+      assert(base(it) == a.data() + size);
+      assert(a == expected);
+    }
+  }
+};
+
+int main(int, char**) {
+  test_execution_policies(Test<int*>());
+  test_execution_policies(Test<forward_iterator<int*>>());
+  test_execution_policies(Test<random_access_iterator<int*>>());
+
+  return 0;
+}
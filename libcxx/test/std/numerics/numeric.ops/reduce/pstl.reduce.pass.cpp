@@ -0,0 +1,60 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+// UNSUPPORTED: libcpp-has-no-incomplete-pstl
+
+// <numeric>
+
+// template<class ExecutionPolicy, class ForwardIterator>
+//   typename iterator_traits<ForwardIterator>::value_type
+//     reduce(ExecutionPolicy&& exec, ForwardIterator first, ForwardIterator last);
+//
+// template<class ExecutionPolicy, class ForwardIterator, class T>
+//   T reduce(ExecutionPolicy&& exec, ForwardIterator first, ForwardIterator last, T init);
+//
+// template<class ExecutionPolicy, class ForwardIterator, class T, class BinaryOperation>
+//   T reduce(ExecutionPolicy&& exec, ForwardIterator first, ForwardIterator last, T init, BinaryOperation binary_op);
+
+#include <cassert>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+#include "test_macros.h"
+#include "test_execution_policies.h"
+#include "test_iterators.h"
+
+template <class Iter>
+struct Test {
+  template <class Policy>
+  void operator()(Policy&& policy) {
+    for (int size : execution_test_sizes) {
+      std::vector<int> a(size);
+      for (int i = 0; i != size; ++i)
+        a[i] = i % 7;
+      long long sum = std::accumulate(a.begin(), a.end(), 0LL);
+
+      ASSERT_SAME_TYPE(decltype(std::reduce(policy, Iter(a.data()), Iter(a.data() + a.size()))), int);
+      assert(std::reduce(policy, Iter(a.data()), Iter(a.data() + a.size())) == sum);
+      ASSERT_SAME_TYPE(decltype(std::reduce(policy, Iter(a.data()), Iter(a.data() + a.size()), 3LL)), long long);
+      assert(std::reduce(policy, Iter(a.data()), Iter(a.data() + a.size()), 3LL) == sum + 3);
+
+      auto max = [](long long x, long long y) { return x < y ? y : x; };
+      assert(std::reduce(policy, Iter(a.data()), Iter(a.data() + a.size()), -1LL, max) == (size > 6 ? 6 : size - 1));
+    }
+  }
+};
+
+int main(int, char**) {
+  test_execution_policies(Test<int*>());
+  test_execution_policies(Test<forward_iterator<int*>>());
+  test_execution_policies(Test<random_access_iterator<int*>>());
+
+  return 0;
+}
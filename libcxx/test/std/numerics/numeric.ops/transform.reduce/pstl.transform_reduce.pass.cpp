@@ -0,0 +1,76 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+// UNSUPPORTED: libcpp-has-no-incomplete-pstl
+
+// <numeric>
+
+// template<class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2, class T>
+//   T transform_reduce(ExecutionPolicy&& exec, ForwardIterator1 first1, ForwardIterator1 last1,
+//                      ForwardIterator2 first2, T init);
+//
+// template<class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2, class T,
+//          class BinaryOperation1, class BinaryOperation2>
+//   T transform_reduce(ExecutionPolicy&& exec, ForwardIterator1 first1, ForwardIterator1 last1,
+//                      ForwardIterator2 first2, T init, BinaryOperation1 binary_op1, BinaryOperation2 binary_op2);
+//
+// template<class ExecutionPolicy, class ForwardIterator, class T, class BinaryOperation, class UnaryOperation>
+//   T transform_reduce(ExecutionPolicy&& exec, ForwardIterator first, ForwardIterator last, T init,
+//                      BinaryOperation binary_op, UnaryOperation unary_op);
+
+#include <cassert>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+#include "test_macros.h"
+#include "test_execution_policies.h"
+#include "test_iterators.h"
+
+template <class Iter>
+struct Test {
+  template <class Policy>
+  void operator()(Policy&& policy) {
+    for (int size : execution_test_sizes) {
+      std::vector<int> a(size);
+      std::vector<int> b(size);
+      for (int i = 0; i != size; ++i) {
+        a[i] = i % 5;
+        b[i] = i % 3;
+      }
+      long long inner = std::inner_product(a.begin(), a.end(), b.begin(), 0LL);
+
+      assert(std::transform_reduce(policy, Iter(a.data()), Iter(a.data() + a.size()), Iter(b.data()), 1LL) ==
+             inner + 1);
+      assert(std::transform_reduce(
+                 policy,
+                 Iter(a.data()),
+                 Iter(a.data() + a.size()),
+                 Iter(b.data()),
+                 2LL,
+                 std::plus<>(),
+                 std::multiplies<>()) == inner + 2);
+
+      long long squares = 0;
+      for (int i : a)
+        squares += i * i;
+      assert(std::transform_reduce(policy, Iter(a.data()), Iter(a.data() + a.size()), 0LL, std::plus<>(), [](int i) {
+               return i * i;
+             }) == squares);
+    }
+  }
+};
+
+int main(int, char**) {
+  test_execution_policies(Test<int*>());
+  test_execution_policies(Test<forward_iterator<int*>>());
+  test_execution_policies(Test<random_access_iterator<int*>>());
+
+  return 0;
+}
@@ -0,0 +1,87 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17, c++20
+
+// <string>
+
+// template<container-compatible-range<charT> R>
+//   constexpr basic_string(from_range_t, R&& rg, const Allocator& a = Allocator()); // since C++23
+//
+// template<ranges::input_range R, class Allocator = allocator<ranges::range_value_t<R>>>
+//   basic_string(from_range_t, R&&, Allocator = Allocator())
+//     -> basic_string<ranges::range_value_t<R>, char_traits<ranges::range_value_t<R>>, Allocator>;
+
+#include <string>
+#include <cassert>
+#include <ranges>
+#include <string_view>
+#include <vector>
+
+#include "test_macros.h"
+#include "test_iterators.h"
+#include "min_allocator.h"
+#include "test_allocator.h"
+
+template <class S>
+constexpr void test_string() {
+  {
+    std::vector<char> v{'a', 'b', 'c'};
+    S s(std::from_range, v);
+    assert(s == "abc");
+  }
+  {
+    const char in[] = "abcdefghijklmnopqrstuvwxyz";
+    S s(std::from_range, std::ranges::subrange(forward_iterator<const char*>(in), forward_iterator<const char*>(in + 26)));
+    assert(s == in);
+  }
+  {
+    char in[] = "abc";
+    using It  = cpp20_input_iterator<char*>;
+    S s(std::from_range, std::ranges::subrange(It(in), sentinel_wrapper<It>(It(in + 3))));
+    assert(s == "abc");
+  }
+  {
+    S s(std::from_range, std::string_view());
+    assert(s.empty());
+  }
+}
+
+constexpr void test_alloc() {
+  using S = std::basic_string<char, std::char_traits<char>, test_allocator<char>>;
+  S s(std::from_range, std::string_view("abcdefghijklmnopqrstuvwxyz"), test_allocator<char>(3));
+  assert(s == "abcdefghijklmnopqrstuvwxyz");
+  assert(s.get_allocator().get_data() == 3);
+}
+
+constexpr void test_deduction() {
+  std::vector<char> v{'a', 'b', 'c'};
+  std::basic_string s(std::from_range, v);
+  ASSERT_SAME_TYPE(decltype(s), std::string);
+  assert(s == "abc");
+
+  std::basic_string t(std::from_range, v, min_allocator<char>());
+  ASSERT_SAME_TYPE(decltype(t), std::basic_string<char, std::char_traits<char>, min_allocator<char>>);
+  assert(t == "abc");
+}
+
+constexpr bool test() {
+  test_string<std::string>();
+  test_string<std::basic_string<char, std::char_traits<char>, min_allocator<char>>>();
+  test_alloc();
+  test_deduction();
+
+  return true;
+}
+
+int main(int, char**) {
+  test();
+  static_assert(test());
+
+  return 0;
+}
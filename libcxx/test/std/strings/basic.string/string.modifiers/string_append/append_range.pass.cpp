@@ -0,0 +1,100 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17, c++20
+
+// <string>
+
+// template<container-compatible-range<charT> R>
+//   constexpr basic_string& append_range(R&& rg); // since C++23
+
+#include <string>
+#include <cassert>
+#include <ranges>
+#include <string_view>
+#include <vector>
+
+#include "test_macros.h"
+#include "test_iterators.h"
+#include "min_allocator.h"
+
+template <class S>
+constexpr void test_contiguous() {
+  S s("123");
+  std::vector<char> v{'a', 'b', 'c'};
+  assert(&s.append_range(v) == &s);
+  assert(s == "123abc");
+
+  s.append_range(std::string_view());
+  assert(s == "123abc");
+
+  // The range refers to the string itself.
+  s.append_range(std::string_view(s.data(), s.size()));
+  assert(s == "123abc123abc");
+}
+
+template <class S>
+constexpr void test_forward() {
+  const char abc[] = "abc";
+  S s("123");
+  s.append_range(std::ranges::subrange(forward_iterator<const char*>(abc), forward_iterator<const char*>(abc + 3)));
+  assert(s == "123abc");
+
+  // Grow well past the capacity of the string in a single call.
+  S long_str(100, 'x');
+  s.append_range(long_str | std::views::transform([](char c) { return c; }));
+  assert(s.size() == 106);
+  assert(s.substr(0, 6) == "123abc");
+  assert(s.find_first_not_of('x', 6) == S::npos);
+}
+
+template <class S>
+constexpr void test_alias() {
+  S s("abc");
+  for (int i = 0; i != 5; ++i)
+    s.append_range(s | std::views::transform([](char c) { return c; }));
+  assert(s.size() == 3 * 32);
+  for (std::size_t i = 0; i != s.size(); ++i)
+    assert(s[i] == "abc"[i % 3]);
+}
+
+template <class S>
+constexpr void test_input() {
+  char in[] = "abcdefghijklmnopqrstuvwxyz";
+  using It  = cpp20_input_iterator<char*>;
+  S s("123");
+  s.append_range(std::ranges::subrange(It(in), sentinel_wrapper<It>(It(in + 26))));
+  assert(s == "123abcdefghijklmnopqrstuvwxyz");
+
+  // A sized input range.
+  S t("123");
+  t.append_range(std::views::counted(It(in), 3));
+  assert(t == "123abc");
+}
+
+template <class S>
+constexpr void test_string() {
+  test_contiguous<S>();
+  test_forward<S>();
+  test_alias<S>();
+  test_input<S>();
+}
+
+constexpr bool test() {
+  test_string<std::string>();
+  test_string<std::basic_string<char, std::char_traits<char>, min_allocator<char>>>();
+
+  return true;
+}
+
+int main(int, char**) {
+  test();
+  static_assert(test());
+
+  return 0;
+}
@@ -0,0 +1,69 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17, c++20
+
+// <string>
+
+// template<container-compatible-range<charT> R>
+//   constexpr basic_string& assign_range(R&& rg); // since C++23
+
+#include <string>
+#include <cassert>
+#include <ranges>
+#include <string_view>
+#include <vector>
+
+#include "test_macros.h"
+#include "test_iterators.h"
+#include "min_allocator.h"
+
+template <class S>
+constexpr void test_string() {
+  {
+    S s("123");
+    std::vector<char> v{'a', 'b', 'c'};
+    assert(&s.assign_range(v) == &s);
+    assert(s == "abc");
+    s.assign_range(std::string_view());
+    assert(s.empty());
+  }
+  {
+    const char in[] = "abcdefghijklmnopqrstuvwxyz";
+    S s("123");
+    s.assign_range(std::ranges::subrange(forward_iterator<const char*>(in), forward_iterator<const char*>(in + 26)));
+    assert(s == in);
+  }
+  {
+    char in[] = "abc";
+    using It  = cpp20_input_iterator<char*>;
+    S s("123");
+    s.assign_range(std::ranges::subrange(It(in), sentinel_wrapper<It>(It(in + 3))));
+    assert(s == "abc");
+  }
+  {
+    // The range refers to the string itself.
+    S s("abcdefghijklmnopqrstuvwxyz");
+    s.assign_range(s | std::views::drop(23) | std::views::transform([](char c) { return c; }));
+    assert(s == "xyz");
+  }
+}
+
+constexpr bool test() {
+  test_string<std::string>();
+  test_string<std::basic_string<char, std::char_traits<char>, min_allocator<char>>>();
+
+  return true;
+}
+
+int main(int, char**) {
+  test();
+  static_assert(test());
+
+  return 0;
+}
@@ -0,0 +1,75 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17, c++20
+
+// <string>
+
+// template<container-compatible-range<charT> R>
+//   constexpr iterator insert_range(const_iterator p, R&& rg); // since C++23
+
+#include <string>
+#include <cassert>
+#include <ranges>
+#include <string_view>
+#include <vector>
+
+#include "test_macros.h"
+#include "test_iterators.h"
+#include "min_allocator.h"
+
+template <class S>
+constexpr void test_string() {
+  {
+    S s("123");
+    std::vector<char> v{'a', 'b', 'c'};
+    typename S::iterator it = s.insert_range(s.begin() + 1, v);
+    assert(it == s.begin() + 1);
+    assert(s == "1abc23");
+    it = s.insert_range(s.end(), std::string_view());
+    assert(it == s.end());
+    assert(s == "1abc23");
+  }
+  {
+    const char in[] = "abcdefghijklmnopqrstuvwxyz";
+    S s("123");
+    typename S::iterator it =
+        s.insert_range(s.end(), std::ranges::subrange(forward_iterator<const char*>(in), forward_iterator<const char*>(in + 26)));
+    assert(it == s.begin() + 3);
+    assert(s == "123abcdefghijklmnopqrstuvwxyz");
+  }
+  {
+    char in[] = "abc";
+    using It  = cpp20_input_iterator<char*>;
+    S s("123");
+    s.insert_range(s.begin(), std::ranges::subrange(It(in), sentinel_wrapper<It>(It(in + 3))));
+    assert(s == "abc123");
+  }
+  {
+    // The range refers to the string itself.
+    S s("abc");
+    s.insert_range(s.begin() + 1, std::string_view(s.data(), s.size()));
+    assert(s == "aabcbc");
+    s.insert_range(s.begin(), s | std::views::transform([](char c) { return c; }));
+    assert(s == "aabcbcaabcbc");
+  }
+}
+
+constexpr bool test() {
+  test_string<std::string>();
+  test_string<std::basic_string<char, std::char_traits<char>, min_allocator<char>>>();
+
+  return true;
+}
+
+int main(int, char**) {
+  test();
+  static_assert(test());
+
+  return 0;
+}
@@ -0,0 +1,72 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17, c++20
+
+// <string>
+
+// template<container-compatible-range<charT> R>
+//   constexpr basic_string& replace_with_range(const_iterator i1, const_iterator i2, R&& rg); // since C++23
+
+#include <string>
+#include <cassert>
+#include <ranges>
+#include <string_view>
+#include <vector>
+
+#include "test_macros.h"
+#include "test_iterators.h"
+#include "min_allocator.h"
+
+template <class S>
+constexpr void test_string() {
+  {
+    S s("12345");
+    std::vector<char> v{'a', 'b', 'c'};
+    assert(&s.replace_with_range(s.begin() + 1, s.begin() + 4, v) == &s);
+    assert(s == "1abc5");
+    s.replace_with_range(s.begin(), s.end(), std::string_view());
+    assert(s.empty());
+  }
+  {
+    const char in[] = "abcdefghijklmnopqrstuvwxyz";
+    S s("123");
+    s.replace_with_range(s.begin() + 1, s.begin() + 2,
+                         std::ranges::subrange(forward_iterator<const char*>(in), forward_iterator<const char*>(in + 26)));
+    assert(s == "1abcdefghijklmnopqrstuvwxyz3");
+  }
+  {
+    char in[] = "abc";
+    using It  = cpp20_input_iterator<char*>;
+    S s("123");
+    s.replace_with_range(s.begin(), s.begin() + 3, std::ranges::subrange(It(in), sentinel_wrapper<It>(It(in + 3))));
+    assert(s == "abc");
+  }
+  {
+    // The range refers to the string itself.
+    S s("abc");
+    s.replace_with_range(s.begin() + 1, s.begin() + 2, std::string_view(s.data(), s.size()));
+    assert(s == "aabcc");
+    s.replace_with_range(s.begin(), s.begin() + 1, s | std::views::transform([](char c) { return c; }));
+    assert(s == "aabccabcc");
+  }
+}
+
+constexpr bool test() {
+  test_string<std::string>();
+  test_string<std::basic_string<char, std::char_traits<char>, min_allocator<char>>>();
+
+  return true;
+}
+
+int main(int, char**) {
+  test();
+  static_assert(test());
+
+  return 0;
+}
@@ -0,0 +1,57 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+// UNSUPPORTED: libcpp-has-no-incomplete-pstl
+
+// <execution>
+
+// class sequenced_policy;
+// class parallel_policy;
+// class parallel_unsequenced_policy;
+// class unsequenced_policy; // since C++20
+//
+// inline constexpr sequenced_policy seq = implementation-defined;
+// inline constexpr parallel_policy par = implementation-defined;
+// inline constexpr parallel_unsequenced_policy par_unseq = implementation-defined;
+// inline constexpr unsequenced_policy unseq = implementation-defined; // since C++20
+//
+// template<class T> struct is_execution_policy;
+// template<class T> inline constexpr bool is_execution_policy_v = is_execution_policy<T>::value;
+
+#include <execution>
+#include <type_traits>
+
+#include "test_macros.h"
+
+template <class Policy>
+void test(const Policy& policy) {
+  static_assert(std::is_execution_policy<Policy>::value);
+  static_assert(std::is_execution_policy_v<Policy>);
+  static_assert(!std::is_execution_policy_v<const Policy>);
+  static_assert(!std::is_copy_constructible_v<Policy>);
+  static_assert(!std::is_copy_assignable_v<Policy>);
+  (void)policy;
+}
+
+void test() {
+  test(std::execution::seq);
+  test(std::execution::par);
+  test(std::execution::par_unseq);
+  static_assert(std::is_same_v<decltype(std::execution::seq), const std::execution::sequenced_policy>);
+  static_assert(std::is_same_v<decltype(std::execution::par), const std::execution::parallel_policy>);
+  static_assert(
+      std::is_same_v<decltype(std::execution::par_unseq), const std::execution::parallel_unsequenced_policy>);
+#if TEST_STD_VER >= 20
+  test(std::execution::unseq);
+  static_assert(std::is_same_v<decltype(std::execution::unseq), const std::execution::unsequenced_policy>);
+#endif
+
+  static_assert(!std::is_execution_policy_v<int>);
+  static_assert(!std::is_execution_policy_v<std::execution::sequenced_policy*>);
+}
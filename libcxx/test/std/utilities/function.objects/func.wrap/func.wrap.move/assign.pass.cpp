@@ -0,0 +1,90 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17, c++20
+
+// <functional>
+
+// class move_only_function<R(ArgTypes...) cv ref noexcept(noex)>
+
+// move_only_function& operator=(move_only_function&& f);
+// move_only_function& operator=(nullptr_t) noexcept;
+// template<class F> move_only_function& operator=(F&& f);
+// ~move_only_function();
+
+#include <cassert>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "test_macros.h"
+
+struct Counted {
+  static int alive;
+  int value;
+  char padding[128] = {};
+  Counted(int v) : value(v) { ++alive; }
+  Counted(const Counted& other) : value(other.value) { ++alive; }
+  ~Counted() { --alive; }
+  int operator()() const { return value; }
+};
+int Counted::alive = 0;
+
+struct SmallCounted {
+  static int alive;
+  int value;
+  SmallCounted(int v) : value(v) { ++alive; }
+  SmallCounted(SmallCounted&& other) noexcept : value(other.value) { ++alive; }
+  ~SmallCounted() { --alive; }
+  int operator()() const { return value; }
+};
+int SmallCounted::alive = 0;
+
+static_assert(std::is_nothrow_move_assignable_v<std::move_only_function<int()>>);
+static_assert(!std::is_copy_assignable_v<std::move_only_function<int()>>);
+
+int main(int, char**) {
+  {
+    std::move_only_function<int()> f = Counted{1};
+    std::move_only_function<int()> g = SmallCounted{2};
+    assert(Counted::alive == 1);
+    assert(SmallCounted::alive == 1);
+
+    f = std::move(g);
+    assert(!g);
+    assert(f() == 2);
+    assert(Counted::alive == 0);
+    assert(SmallCounted::alive == 1);
+
+    f = Counted{3};
+    assert(f() == 3);
+    assert(Counted::alive == 1);
+    assert(SmallCounted::alive == 0);
+
+    f = nullptr;
+    assert(!f);
+    assert(Counted::alive == 0);
+
+    f = SmallCounted{4};
+    assert(f() == 4);
+  }
+  assert(Counted::alive == 0);
+  assert(SmallCounted::alive == 0);
+  {
+    std::move_only_function<int()> f = [] { return 5; };
+    f = std::move(f);
+    f = [p = std::make_unique<int>(6)] { return *p; };
+    assert(f() == 6);
+    int (*fp)() = nullptr;
+    f = fp;
+    assert(!f);
+  }
+
+  return 0;
+}
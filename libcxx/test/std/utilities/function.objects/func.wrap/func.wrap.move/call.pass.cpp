@@ -0,0 +1,143 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17, c++20
+
+// <functional>
+
+// class move_only_function<R(ArgTypes...) cv ref noexcept(noex)>
+
+// explicit operator bool() const noexcept;
+// R operator()(ArgTypes... args) cv ref noexcept(noex);
+
+#include <cassert>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "test_macros.h"
+
+struct Qualified {
+  int operator()() & { return 1; }
+  int operator()() && { return 2; }
+  int operator()() const& { return 3; }
+  int operator()() const&& { return 4; }
+};
+
+struct NoexceptQualified {
+  int operator()() & noexcept { return 1; }
+  int operator()() && noexcept { return 2; }
+  int operator()() const& noexcept { return 3; }
+  int operator()() const&& noexcept { return 4; }
+};
+
+struct OnlyMutable {
+  int count = 0;
+  int operator()() { return ++count; }
+};
+
+static_assert(std::is_invocable_r_v<int, std::move_only_function<int()>&>);
+static_assert(std::is_invocable_r_v<int, const std::move_only_function<int() const>&>);
+static_assert(!std::is_invocable_v<const std::move_only_function<int()>&>);
+static_assert(std::is_invocable_v<std::move_only_function<int() &>&>);
+static_assert(!std::is_invocable_v<std::move_only_function<int() &>>);
+static_assert(std::is_invocable_v<std::move_only_function<int() &&>>);
+static_assert(!std::is_invocable_v<std::move_only_function<int() &&>&>);
+static_assert(std::is_nothrow_invocable_v<std::move_only_function<int() noexcept>&>);
+static_assert(!std::is_nothrow_invocable_v<std::move_only_function<int()>&>);
+static_assert(!std::is_constructible_v<std::move_only_function<int() const>, OnlyMutable>);
+static_assert(noexcept(static_cast<bool>(std::declval<const std::move_only_function<int()>&>())));
+
+template <class Callable>
+void test_qualifiers() {
+  {
+    std::move_only_function<int()> f = Callable{};
+    assert(f() == 1);
+  }
+  {
+    std::move_only_function<int() &> f = Callable{};
+    assert(f() == 1);
+  }
+  {
+    std::move_only_function<int() &&> f = Callable{};
+    assert(std::move(f)() == 2);
+  }
+  {
+    const std::move_only_function<int() const> f = Callable{};
+    assert(f() == 3);
+  }
+  {
+    const std::move_only_function<int() const&> f = Callable{};
+    assert(f() == 3);
+  }
+  {
+    const std::move_only_function<int() const&&> f = Callable{};
+    assert(std::move(f)() == 4);
+  }
+}
+
+void test_noexcept_qualifiers() {
+  {
+    std::move_only_function<int() noexcept> f = NoexceptQualified{};
+    assert(f() == 1);
+  }
+  {
+    std::move_only_function<int() & noexcept> f = NoexceptQualified{};
+    assert(f() == 1);
+  }
+  {
+    std::move_only_function<int() && noexcept> f = NoexceptQualified{};
+    assert(std::move(f)() == 2);
+  }
+  {
+    const std::move_only_function<int() const noexcept> f = NoexceptQualified{};
+    assert(f() == 3);
+  }
+  {
+    const std::move_only_function<int() const & noexcept> f = NoexceptQualified{};
+    assert(f() == 3);
+  }
+  {
+    const std::move_only_function<int() const && noexcept> f = NoexceptQualified{};
+    assert(std::move(f)() == 4);
+  }
+}
+
+int main(int, char**) {
+  test_qualifiers<Qualified>();
+  test_noexcept_qualifiers();
+  {
+    std::move_only_function<int()> f = OnlyMutable{};
+    assert(f() == 1);
+    assert(f() == 2);
+  }
+  {
+    // Arguments are forwarded without extra copies.
+    std::move_only_function<std::size_t(std::unique_ptr<int>, const std::string&, int&)> f =
+        [](std::unique_ptr<int> p, const std::string& s, int& out) {
+          out = *p;
+          return s.size();
+        };
+    int out = 0;
+    assert(f(std::make_unique<int>(7), std::string("abc"), out) == 3);
+    assert(out == 7);
+  }
+  {
+    // The return value is converted, or discarded for void.
+    std::move_only_function<long(int)> f = [](int i) { return i * 2; };
+    assert(f(21) == 42);
+    int calls = 0;
+    std::move_only_function<void()> g = [&calls] { return ++calls; };
+    g();
+    assert(calls == 1);
+  }
+
+  return 0;
+}
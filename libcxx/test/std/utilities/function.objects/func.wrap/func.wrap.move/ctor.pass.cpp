@@ -0,0 +1,127 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17, c++20
+
+// <functional>
+
+// class move_only_function<R(ArgTypes...) cv ref noexcept(noex)>
+
+// move_only_function() noexcept;
+// move_only_function(nullptr_t) noexcept;
+// move_only_function(move_only_function&& f) noexcept;
+// template<class F> move_only_function(F&& f);
+// template<class T, class... Args>
+//   explicit move_only_function(in_place_type_t<T>, Args&&... args);
+// template<class T, class U, class... Args>
+//   explicit move_only_function(in_place_type_t<T>, initializer_list<U> il, Args&&... args);
+
+#include <cassert>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "test_macros.h"
+
+int add_one(int i) { return i + 1; }
+
+struct S {
+  int value;
+  int get(int i) const { return value + i; }
+};
+
+struct Large {
+  char buffer[256] = {};
+  int operator()(int i) const { return i + 2; }
+};
+
+struct NonMovable {
+  int value;
+  constexpr NonMovable(int v) : value(v) {}
+  NonMovable(NonMovable&&) = delete;
+  int operator()(int i) const { return value + i; }
+};
+
+struct ListInit {
+  int sum = 0;
+  ListInit(std::initializer_list<int> il, int extra) {
+    for (int i : il)
+      sum += i;
+    sum += extra;
+  }
+  int operator()(int i) const { return sum + i; }
+};
+
+struct NotCallable {};
+
+static_assert(std::is_nothrow_default_constructible_v<std::move_only_function<void()>>);
+static_assert(std::is_nothrow_constructible_v<std::move_only_function<void()>, std::nullptr_t>);
+static_assert(std::is_nothrow_move_constructible_v<std::move_only_function<void()>>);
+static_assert(!std::is_copy_constructible_v<std::move_only_function<void()>>);
+static_assert(!std::is_constructible_v<std::move_only_function<int(int)>, NotCallable>);
+static_assert(!std::is_constructible_v<std::move_only_function<int() noexcept>, int (*)()>);
+static_assert(std::is_constructible_v<std::move_only_function<int() noexcept>, int (*)() noexcept>);
+static_assert(!std::is_convertible_v<std::in_place_type_t<Large>, std::move_only_function<int(int)>>);
+
+int main(int, char**) {
+  {
+    std::move_only_function<int(int)> f;
+    assert(!f);
+    std::move_only_function<int(int)> g(nullptr);
+    assert(!g);
+  }
+  {
+    std::move_only_function<int(int)> f = add_one;
+    assert(f);
+    assert(f(1) == 2);
+  }
+  {
+    int (*fp)(int) = nullptr;
+    std::move_only_function<int(int)> f = fp;
+    assert(!f);
+  }
+  {
+    int (S::*mp)(int) const = nullptr;
+    std::move_only_function<int(const S&, int)> f = mp;
+    assert(!f);
+    std::move_only_function<int(const S&, int)> g = &S::get;
+    assert(g(S{3}, 4) == 7);
+    std::move_only_function<int(S)> h = &S::value;
+    assert(h(S{5}) == 5);
+  }
+  {
+    std::move_only_function<int(int)> empty;
+    std::move_only_function<long(int)> f = std::move(empty);
+    assert(!f);
+  }
+  {
+    auto p = std::make_unique<int>(40);
+    std::move_only_function<int(int)> f = [p = std::move(p)](int i) { return *p + i; };
+    assert(f(2) == 42);
+    std::move_only_function<int(int)> g = std::move(f);
+    assert(g(2) == 42);
+  }
+  {
+    std::move_only_function<int(int) const> f = Large{};
+    assert(f(1) == 3);
+    std::move_only_function<int(int) const> g = std::move(f);
+    assert(g(1) == 3);
+  }
+  {
+    std::move_only_function<int(int) const> f(std::in_place_type<NonMovable>, 10);
+    assert(f(1) == 11);
+  }
+  {
+    std::move_only_function<int(int)> f(std::in_place_type<ListInit>, {1, 2, 3}, 4);
+    assert(f(0) == 10);
+  }
+
+  return 0;
+}
@@ -0,0 +1,66 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17, c++20
+
+// <functional>
+
+// class move_only_function<R(ArgTypes...) cv ref noexcept(noex)>
+
+// void swap(move_only_function& other) noexcept;
+// friend void swap(move_only_function& f1, move_only_function& f2) noexcept;
+// friend bool operator==(const move_only_function& f, nullptr_t) noexcept;
+
+#include <cassert>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "test_macros.h"
+
+struct Large {
+  char buffer[256] = {};
+  int value;
+  Large(int v) : value(v) {}
+  int operator()() const { return value; }
+};
+
+int main(int, char**) {
+  {
+    std::move_only_function<int()> small = [] { return 1; };
+    std::move_only_function<int()> large = Large{2};
+    std::move_only_function<int()> nontrivial = [s = std::string(3, 'x')] { return static_cast<int>(s.size()); };
+    std::move_only_function<int()> empty;
+
+    small.swap(large);
+    assert(small() == 2);
+    assert(large() == 1);
+
+    swap(small, nontrivial);
+    assert(small() == 3);
+    assert(nontrivial() == 2);
+
+    swap(small, empty);
+    assert(!small);
+    assert(empty() == 3);
+    assert(small == nullptr);
+    assert(nullptr == small);
+    assert(empty != nullptr);
+
+    empty.swap(empty);
+    assert(empty() == 3);
+  }
+  {
+    static_assert(noexcept(std::declval<std::move_only_function<int()>&>().swap(
+        std::declval<std::move_only_function<int()>&>())));
+    static_assert(noexcept(std::declval<const std::move_only_function<int()>&>() == nullptr));
+  }
+
+  return 0;
+}
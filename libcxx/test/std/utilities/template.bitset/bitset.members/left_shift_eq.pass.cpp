@@ -24,11 +24,16 @@ TEST_CONSTEXPR_CXX23 bool test_left_shift() {
             std::bitset<N> v1 = cases[c];
             std::bitset<N> v2 = v1;
             v1 <<= s;
-            for (std::size_t i = 0; i < v1.size(); ++i)
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < v1.size(); ++i) {
                 if (i < s)
                     assert(v1[i] == 0);
                 else
                     assert(v1[i] == v2[i-s]);
+                count += v1[i];
+            }
+            // The bits shifted past the end are discarded.
+            assert(v1.count() == count);
         }
     }
     return true;
@@ -0,0 +1,31 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef TEST_SUPPORT_TEST_EXECUTION_POLICIES_H
+#define TEST_SUPPORT_TEST_EXECUTION_POLICIES_H
+
+#include <execution>
+
+#include "test_macros.h"
+
+// Calls func with every standard execution policy.
+template <class Functor>
+void test_execution_policies(Functor func) {
+  func(std::execution::seq);
+  func(std::execution::par);
+  func(std::execution::par_unseq);
+#if TEST_STD_VER >= 20
+  func(std::execution::unseq);
+#endif
+}
+
+// The sizes to test the parallel algorithms with, the large ones are split
+// into several chunks by the parallel backends.
+inline constexpr int execution_test_sizes[] = {0, 1, 2, 3, 100, 5000, 100003};
+
+#endif // TEST_SUPPORT_TEST_EXECUTION_POLICIES_H
@@ -377,6 +377,8 @@ struct _LIBUNWIND_HIDDEN dl_iterate_cb_data {
   LocalAddressSpace *addressSpace;
   UnwindInfoSections *sects;
   uintptr_t targetAddr;
+  // Set once the frame header cache has been consulted for targetAddr.
+  bool checkedCache;
 };
 
 #if defined(_LIBUNWIND_USE_FRAME_HEADER_CACHE)
@@ -439,8 +441,15 @@ static int findUnwindSectionsByPhdr(struct dl_phdr_info *pinfo,
   if (pinfo->dlpi_phnum == 0 || cbdata->targetAddr < pinfo->dlpi_addr)
     return 0;
 #if defined(_LIBUNWIND_USE_FRAME_HEADER_CACHE)
-  if (TheFrameHeaderCache.find(pinfo, pinfo_size, data))
-    return 1;
+  // The cache is not specific to the object being visited, so look in it only
+  // once per dl_iterate_phdr call instead of once for every loaded object. The
+  // loader lock is held for the whole iteration, and with hundreds of objects
+  // repeated misses would keep every other unwinding thread waiting.
+  if (!cbdata->checkedCache) {
+    cbdata->checkedCache = true;
+    if (TheFrameHeaderCache.find(pinfo, pinfo_size, data))
+      return 1;
+  }
 #else
   // Avoid warning about unused variable.
   (void)pinfo_size;
@@ -629,7 +638,7 @@ inline bool LocalAddressSpace::findUnwindSections(pint_t targetAddr,
     return true;
   }
 #endif
-  dl_iterate_cb_data cb_data = {this, &info, targetAddr};
+  dl_iterate_cb_data cb_data = {this, &info, targetAddr, false};
   int found = dl_iterate_phdr(findUnwindSectionsByPhdr, &cb_data);
   return static_cast<bool>(found);
 #endif
@@ -54,6 +54,7 @@
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/FormatAdapters.h"
 #include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/ScopedPrinter.h"
 #include <memory>
@@ -641,8 +642,11 @@ void PDBLinker::analyzeSymbolSubsection(
 
 Error PDBLinker::writeAllModuleSymbolRecords(ObjFile *file,
                                              BinaryStreamWriter &writer) {
+  // Writing bytes has a very high overhead, so buffer the symbols of the whole
+  // object file and write them at once.
   std::vector<uint8_t> storage;
   SmallVector<uint32_t, 4> scopes;
+  uint32_t moduleSymStart = writer.getOffset();
 
   // Visit all live .debug$S sections a second time, and write them to the PDB.
   for (SectionChunk *debugChunk : file->getDebugChunks()) {
@@ -662,9 +666,8 @@ Error PDBLinker::writeAllModuleSymbolRecords(ObjFile *file,
       if (ss.kind() != DebugSubsectionKind::Symbols)
         continue;
 
-      uint32_t moduleSymStart = writer.getOffset();
+      size_t subsectionStart = storage.size();
       scopes.clear();
-      storage.clear();
       ArrayRef<uint8_t> symsBuffer;
       BinaryStreamRef sr = ss.getRecordData();
       cantFail(sr.readBytes(0, sr.getLength(), symsBuffer));
@@ -691,19 +694,12 @@ Error PDBLinker::writeAllModuleSymbolRecords(ObjFile *file,
       // already warned about them in the first analysis pass.
       if (ec) {
         consumeError(std::move(ec));
-        storage.clear();
+        storage.resize(subsectionStart);
       }
-
-      // Writing bytes has a very high overhead, so write the entire subsection
-      // at once.
-      // TODO: Consider buffering symbols for the entire object file to reduce
-      // overhead even further.
-      if (Error e = writer.writeBytes(storage))
-        return e;
     }
   }
 
-  return Error::success();
+  return writer.writeBytes(storage);
 }
 
 Error PDBLinker::commitSymbolsForObject(void *ctx, void *obj,
@@ -1180,8 +1176,8 @@ void PDBLinker::addPublicsToPDB() {
   ScopedTimer t3(ctx.publicsLayoutTimer);
   // Compute the public symbols.
   auto &gsiBuilder = builder.getGsiBuilder();
-  std::vector<pdb::BulkPublic> publics;
-  ctx.symtab.forEachSymbol([&publics, this](Symbol *s) {
+  std::vector<Defined *> publicDefs;
+  ctx.symtab.forEachSymbol([&publicDefs](Symbol *s) {
     // Only emit external, defined, live symbols that have a chunk. Static,
     // non-external symbols do not appear in the symbol table.
     auto *def = dyn_cast<Defined>(s);
@@ -1202,10 +1198,17 @@ void PDBLinker::addPublicsToPDB() {
           return;
         }
       }
-      publics.push_back(createPublic(ctx, def));
+      publicDefs.push_back(def);
     }
   });
 
+  // The names have been computed above, so creating the records only reads
+  // the symbols and can be done in parallel.
+  std::vector<pdb::BulkPublic> publics(publicDefs.size());
+  parallelFor(0, publicDefs.size(), [&](size_t i) {
+    publics[i] = createPublic(ctx, publicDefs[i]);
+  });
+
   if (!publics.empty()) {
     publicSymbols = publics.size();
     gsiBuilder.addPublicSymbols(std::move(publics));
@@ -45,6 +45,8 @@
 #include "InputSection.h"
 #include "Symbols.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Parallel.h"
+#include "llvm/Transforms/Utils/CodeLayout.h"
 
 #include <numeric>
 
@@ -177,6 +179,37 @@ static void mergeClusters(std::vector<Cluster> &cs, Cluster &into, int intoIdx,
   from.weight = 0;
 }
 
+// Number the given sections in order, and print their symbols to the file
+// given by --print-symbol-order.
+static DenseMap<const InputSectionBase *, int>
+buildOrderMap(ArrayRef<const InputSectionBase *> orderedSections) {
+  DenseMap<const InputSectionBase *, int> orderMap;
+  int curOrder = 1;
+  for (const InputSectionBase *sec : orderedSections)
+    orderMap[sec] = curOrder++;
+
+  if (!config->printSymbolOrder.empty()) {
+    std::error_code ec;
+    raw_fd_ostream os(config->printSymbolOrder, ec, sys::fs::OF_None);
+    if (ec) {
+      error("cannot open " + config->printSymbolOrder + ": " + ec.message());
+      return orderMap;
+    }
+
+    for (const InputSectionBase *sec : orderedSections) {
+      // Search all the symbols in the file of the section
+      // and find out a Defined symbol with name that is within the section.
+      for (Symbol *sym : sec->file->getSymbols())
+        if (!sym->isSection()) // Filter out section-type symbols here.
+          if (auto *d = dyn_cast<Defined>(sym))
+            if (sec == d->section)
+              os << sym->getName() << "\n";
+    }
+  }
+
+  return orderMap;
+}
+
 // Group InputSections into clusters using the Call-Chain Clustering heuristic
 // then sort the clusters by density.
 DenseMap<const InputSectionBase *, int> CallGraphSort::run() {
@@ -222,49 +255,90 @@ DenseMap<const InputSectionBase *, int> CallGraphSort::run() {
     return clusters[a].getDensity() > clusters[b].getDensity();
   });
 
-  DenseMap<const InputSectionBase *, int> orderMap;
-  int curOrder = 1;
+  std::vector<const InputSectionBase *> orderedSections;
   for (int leader : sorted) {
     for (int i = leader;;) {
-      orderMap[sections[i]] = curOrder++;
+      orderedSections.push_back(sections[i]);
       i = clusters[i].next;
       if (i == leader)
         break;
     }
   }
-  if (!config->printSymbolOrder.empty()) {
-    std::error_code ec;
-    raw_fd_ostream os(config->printSymbolOrder, ec, sys::fs::OF_None);
-    if (ec) {
-      error("cannot open " + config->printSymbolOrder + ": " + ec.message());
-      return orderMap;
+  return buildOrderMap(orderedSections);
+}
+
+namespace {
+// The call graph between the input sections of one output section, in the
+// form expected by applyExtTspLayout. Node 0 is a virtual entry point with no
+// edges, as the algorithm keeps the first node in place.
+struct SectionGraph {
+  std::vector<const InputSectionBase *> sections = {nullptr};
+  std::vector<uint64_t> sizes = {0};
+  std::vector<uint64_t> counts = {0};
+  std::vector<EdgeCountT> edges;
+  DenseMap<const InputSectionBase *, uint64_t> secToNode;
+  std::vector<uint64_t> order;
+
+  uint64_t getOrCreateNode(const InputSectionBase *isec) {
+    auto res = secToNode.try_emplace(isec, sections.size());
+    if (res.second) {
+      sections.push_back(isec);
+      sizes.push_back(isec->getSize());
+      counts.push_back(0);
     }
+    return res.first->second;
+  }
+};
+} // end anonymous namespace
+
+// Order the sections with the Ext-TSP algorithm, which places callers and
+// callees close to each other according to the call counts, so that calls
+// are more likely to stay within the same cache lines and pages. Sections in
+// different output sections can't be placed next to each other, so each
+// output section gets its own graph, and the graphs are laid out in parallel.
+static DenseMap<const InputSectionBase *, int> computeExtTspOrder() {
+  MapVector<const OutputSection *, SectionGraph> graphs;
+  for (std::pair<SectionPair, uint64_t> &c : config->callGraphProfile) {
+    const auto *fromSB = cast<InputSectionBase>(c.first.first);
+    const auto *toSB = cast<InputSectionBase>(c.first.second);
+    if (fromSB->getOutputSection() != toSB->getOutputSection())
+      continue;
 
-    // Print the symbols ordered by C3, in the order of increasing curOrder
-    // Instead of sorting all the orderMap, just repeat the loops above.
-    for (int leader : sorted)
-      for (int i = leader;;) {
-        // Search all the symbols in the file of the section
-        // and find out a Defined symbol with name that is within the section.
-        for (Symbol *sym : sections[i]->file->getSymbols())
-          if (!sym->isSection()) // Filter out section-type symbols here.
-            if (auto *d = dyn_cast<Defined>(sym))
-              if (sections[i] == d->section)
-                os << sym->getName() << "\n";
-        i = clusters[i].next;
-        if (i == leader)
-          break;
-      }
+    SectionGraph &g = graphs[fromSB->getOutputSection()];
+    uint64_t from = g.getOrCreateNode(fromSB);
+    uint64_t to = g.getOrCreateNode(toSB);
+    // The number of calls into a section stands for its execution count.
+    g.counts[to] += c.second;
+    if (from != to)
+      g.edges.push_back({{from, to}, c.second});
   }
 
-  return orderMap;
+  parallelFor(0, graphs.size(), [&](size_t i) {
+    SectionGraph &g = graphs.begin()[i].second;
+    // The algorithm needs at least two real nodes.
+    if (g.sections.size() < 3) {
+      g.order.resize(g.sections.size());
+      std::iota(g.order.begin(), g.order.end(), 0);
+      return;
+    }
+    g.order = applyExtTspLayout(g.sizes, g.counts, g.edges);
+  });
+
+  std::vector<const InputSectionBase *> orderedSections;
+  for (auto &it : graphs)
+    for (uint64_t node : ArrayRef<uint64_t>(it.second.order).drop_front())
+      orderedSections.push_back(it.second.sections[node]);
+  return buildOrderMap(orderedSections);
 }
 
 // Sort sections by the profile data provided by --callgraph-profile-file.
 //
-// This first builds a call graph based on the profile data then merges sections
-// according to the C³ heuristic. All clusters are then sorted by a density
-// metric to further improve locality.
+// By default, this first builds a call graph based on the profile data then
+// merges sections according to the C³ heuristic. All clusters are then sorted
+// by a density metric to further improve locality. With
+// --call-graph-profile-sort=exttsp, the Ext-TSP algorithm is used instead.
 DenseMap<const InputSectionBase *, int> elf::computeCallGraphProfileOrder() {
+  if (config->callGraphProfileSort == CGProfileSortKind::ExtTsp)
+    return computeExtTspOrder();
   return CallGraphSort().run();
 }
@@ -63,6 +63,7 @@
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
 #include <cstdlib>
 #include <utility>
 
@@ -438,6 +439,26 @@ static SeparateSegmentKind getZSeparate(opt::InputArgList &args) {
   return SeparateSegmentKind::None;
 }
 
+static CGProfileSortKind getCGProfileSortKind(opt::InputArgList &args) {
+  auto *arg = args.getLastArg(OPT_call_graph_profile_sort,
+                              OPT_no_call_graph_profile_sort,
+                              OPT_call_graph_profile_sort_eq);
+  if (!arg || arg->getOption().getID() == OPT_call_graph_profile_sort)
+    return CGProfileSortKind::Hfsort;
+  if (arg->getOption().getID() == OPT_no_call_graph_profile_sort)
+    return CGProfileSortKind::None;
+
+  StringRef s = arg->getValue();
+  if (s == "none")
+    return CGProfileSortKind::None;
+  if (s == "hfsort")
+    return CGProfileSortKind::Hfsort;
+  if (s == "exttsp")
+    return CGProfileSortKind::ExtTsp;
+  error("unknown --call-graph-profile-sort= value: " + s);
+  return CGProfileSortKind::Hfsort;
+}
+
 static GnuStackKind getZGnuStack(opt::InputArgList &args) {
   for (auto *arg : args.filtered_reverse(OPT_z)) {
     if (StringRef("execstack") == arg->getValue())
@@ -1092,8 +1113,7 @@ static void readConfigs(opt::InputArgList &args) {
       args.hasFlag(OPT_eh_frame_hdr, OPT_no_eh_frame_hdr, false);
   config->emitLLVM = args.hasArg(OPT_plugin_opt_emit_llvm, false);
   config->emitRelocs = args.hasArg(OPT_emit_relocs);
-  config->callGraphProfileSort = args.hasFlag(
-      OPT_call_graph_profile_sort, OPT_no_call_graph_profile_sort, true);
+  config->callGraphProfileSort = getCGProfileSortKind(args);
   config->enableNewDtags =
       args.hasFlag(OPT_enable_new_dtags, OPT_disable_new_dtags, true);
   config->entry = args.getLastArgValue(OPT_entry);
@@ -1122,6 +1142,8 @@ static void readConfigs(opt::InputArgList &args) {
       args.hasArg(OPT_ignore_data_address_equality);
   config->ignoreFunctionAddressEquality =
       args.hasArg(OPT_ignore_function_address_equality);
+  config->incremental =
+      args.hasFlag(OPT_incremental, OPT_no_incremental, false);
   config->init = args.getLastArgValue(OPT_init, "_init");
   config->ltoAAPipeline = args.getLastArgValue(OPT_lto_aa_pipeline);
   config->ltoCSProfileGenerate = args.hasArg(OPT_lto_cs_profile_generate);
@@ -1214,6 +1236,8 @@ static void readConfigs(opt::InputArgList &args) {
   config->target1Rel = args.hasFlag(OPT_target1_rel, OPT_target1_abs, false);
   config->target2 = getTarget2(args);
   config->thinLTOCacheDir = args.getLastArgValue(OPT_thinlto_cache_dir);
+  config->thinLTORemoteCacheDir =
+      args.getLastArgValue(OPT_thinlto_remote_cache_dir);
   config->thinLTOCachePolicy = CHECK(
       parseCachePruningPolicy(args.getLastArgValue(OPT_thinlto_cache_policy)),
       "--thinlto-cache-policy: invalid cache policy");
@@ -1461,7 +1485,7 @@ static void readConfigs(opt::InputArgList &args) {
       config->symbolOrderingFile = getSymbolOrderingFile(*buffer);
       // Also need to disable CallGraphProfileSort to prevent
       // LLD order symbols with CGProfile
-      config->callGraphProfileSort = false;
+      config->callGraphProfileSort = CGProfileSortKind::None;
     }
   }
 
@@ -1697,6 +1721,13 @@ void LinkerDriver::createFiles(opt::InputArgList &args) {
 
   if (files.empty() && !hasInput && errorCount() == 0)
     error("no input files");
+
+  // Read the IR symbol tables of the bitcode files, which is independent of
+  // symbol resolution, in parallel.
+  parallelForEach(files, [](InputFile *file) {
+    if (auto *f = dyn_cast<BitcodeFile>(file))
+      f->init();
+  });
 }
 
 // If -m <machine_type> was not given, infer it from object files.
@@ -1914,6 +1945,109 @@ static void writeWhyExtract() {
   }
 }
 
+// --incremental keeps a state file next to the output. It records a hash of
+// the command line, the size and modification time of the output, and a hash
+// of every file that the link read. If a later link of the same output has
+// the same command line and none of those files changed, the existing output
+// is exactly what we would produce, so the link is skipped. In any other case
+// we fall back to a full link and rewrite the state file.
+static constexpr StringRef incrementalStateMagic = "lld-incremental-v1";
+
+static std::string getIncrementalStatePath() {
+  return (config->outputFile + ".lld-incremental").str();
+}
+
+static uint64_t hashCommandLine(opt::InputArgList &args) {
+  std::string s = getLLDVersion();
+  for (unsigned i = 0, e = args.getNumInputArgStrings(); i != e; ++i)
+    (s += '\0') += args.getArgString(i);
+  return xxHash64(s);
+}
+
+static Optional<uint64_t> hashFileContents(StringRef path) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> mbOrErr =
+      MemoryBuffer::getFile(path, /*IsText=*/false,
+                            /*RequiresNullTerminator=*/false);
+  if (!mbOrErr)
+    return None;
+  return xxHash64((*mbOrErr)->getBuffer());
+}
+
+static std::string getOutputStamp() {
+  sys::fs::file_status st;
+  if (sys::fs::status(config->outputFile, st))
+    return "";
+  return (Twine(st.getSize()) + " " +
+          Twine(st.getLastModificationTime().time_since_epoch().count()))
+      .str();
+}
+
+// Returns true if the output file is up to date with respect to the state
+// file written by a previous --incremental link. Called after all input files
+// named on the command line have been read.
+static bool isOutputUpToDate(opt::InputArgList &args) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> mbOrErr =
+      MemoryBuffer::getFile(getIncrementalStatePath(), /*IsText=*/true);
+  std::string stamp = getOutputStamp();
+  if (!mbOrErr || stamp.empty())
+    return false;
+  SmallVector<StringRef, 0> lines;
+  (*mbOrErr)->getBuffer().split(lines, '\n', -1, /*KeepEmpty=*/false);
+  if (lines.size() < 3 || lines[0] != incrementalStateMagic ||
+      lines[1] != ("args " + utohexstr(hashCommandLine(args))) ||
+      lines[2] != ("output " + stamp))
+    return false;
+
+  // Every file read by the previous link must be unchanged. This also covers
+  // files that are only read later in the link, such as --symbol-ordering-file
+  // or archive members selected by symbol resolution.
+  DenseSet<CachedHashStringRef> recorded;
+  for (StringRef line : makeArrayRef(lines).slice(3)) {
+    if (!line.consume_front("file "))
+      return false;
+    StringRef hash, path;
+    std::tie(hash, path) = line.split(' ');
+    Optional<uint64_t> h = hashFileContents(path);
+    if (!h || utohexstr(*h) != hash)
+      return false;
+    recorded.insert(CachedHashStringRef(path));
+  }
+
+  // A file we read that the previous link did not (e.g. a library found
+  // earlier in the search path) may change the result.
+  for (const CachedHashString &path : config->dependencyFiles)
+    if (!recorded.count(CachedHashStringRef(path.val())))
+      return false;
+  return true;
+}
+
+static void writeIncrementalState(opt::InputArgList &args) {
+  std::string stamp = getOutputStamp();
+  if (stamp.empty())
+    return;
+  std::string path = getIncrementalStatePath();
+  std::error_code ec;
+  raw_fd_ostream os(path, ec, sys::fs::OF_None);
+  if (ec) {
+    error("cannot open " + path + ": " + ec.message());
+    return;
+  }
+
+  SmallVector<std::string, 0> hashes(config->dependencyFiles.size());
+  parallelFor(0, hashes.size(), [&](size_t i) {
+    if (Optional<uint64_t> h =
+            hashFileContents(config->dependencyFiles[i].val()))
+      hashes[i] = utohexstr(*h);
+  });
+
+  os << incrementalStateMagic << '\n';
+  os << "args " << utohexstr(hashCommandLine(args)) << '\n';
+  os << "output " << stamp << '\n';
+  for (auto [file, hash] : llvm::zip(config->dependencyFiles, hashes))
+    if (!hash.empty())
+      os << "file " << hash << ' ' << file.val() << '\n';
+}
+
 static void reportBackrefs() {
   for (auto &ref : ctx.backwardReferences) {
     const Symbol &sym = *ref.first;
@@ -2507,6 +2641,11 @@ void LinkerDriver::link(opt::InputArgList &args) {
   if (errorCount())
     return;
 
+  if (config->incremental && isOutputUpToDate(args)) {
+    log("output file " + config->outputFile + " is up to date");
+    return;
+  }
+
   // Use default entry point name if no name was given via the command
   // line nor linker scripts. For some reason, MIPS entry point name is
   // different from others.
@@ -2530,6 +2669,14 @@ void LinkerDriver::link(opt::InputArgList &args) {
   // appended to the Files vector.
   {
     llvm::TimeTraceScope timeScope("Parse input files");
+    // Hashing symbol names is a large part of the cost of inserting symbols,
+    // and unlike symbol resolution it does not depend on the order in which
+    // files are added. Hash the names of all initial ELF relocatable files
+    // concurrently so that the serial loop below only probes the table.
+    parallelForEach(files, [](InputFile *file) {
+      if (file->kind() == InputFile::ObjKind)
+        cast<ELFFileBase>(file)->hashGlobalSymbolNames();
+    });
     for (size_t i = 0; i < files.size(); ++i) {
       llvm::TimeTraceScope timeScope("Parse input files", files[i]->getName());
       parseFile(files[i]);
@@ -2850,7 +2997,7 @@ void LinkerDriver::link(opt::InputArgList &args) {
   }
 
   // Read the callgraph now that we know what was gced or icfed
-  if (config->callGraphProfileSort) {
+  if (config->callGraphProfileSort != CGProfileSortKind::None) {
     if (auto *arg = args.getLastArg(OPT_call_graph_ordering_file))
       if (Optional<MemoryBufferRef> buffer = readFile(arg->getValue()))
         readCallGraph(*buffer);
@@ -2859,4 +3006,7 @@ void LinkerDriver::link(opt::InputArgList &args) {
 
   // Write the result to the file.
   invokeELFT(writeResult);
+
+  if (config->incremental && !errorCount())
+    writeIncrementalState(args);
 }
@@ -249,6 +249,10 @@ static bool isCompatible(InputFile *file) {
 }
 
 template <class ELFT> static void doParseFile(InputFile *file) {
+  // Files added while parsing, such as dependent libraries, have not been
+  // initialized yet.
+  if (auto *f = dyn_cast<BitcodeFile>(file))
+    f->init();
   if (!isCompatible(file))
     return;
 
@@ -478,6 +482,47 @@ void ELFFileBase::init() {
   }
 }
 
+void ELFFileBase::hashGlobalSymbolNames() {
+  switch (ekind) {
+  case ELF32LEKind:
+    hashGlobalSymbolNames<ELF32LE>();
+    break;
+  case ELF32BEKind:
+    hashGlobalSymbolNames<ELF32BE>();
+    break;
+  case ELF64LEKind:
+    hashGlobalSymbolNames<ELF64LE>();
+    break;
+  case ELF64BEKind:
+    hashGlobalSymbolNames<ELF64BE>();
+    break;
+  default:
+    llvm_unreachable("getELFKind");
+  }
+}
+
+template <class ELFT> void ELFFileBase::hashGlobalSymbolNames() {
+  ArrayRef<typename ELFT::Sym> eSyms = getGlobalELFSyms<ELFT>();
+  globalNameHashes.resize(eSyms.size());
+  for (size_t i = 0, end = eSyms.size(); i != end; ++i) {
+    Expected<StringRef> name = eSyms[i].getName(stringTable);
+    if (!name) {
+      // Leave the diagnostic to the serial parsing code.
+      consumeError(name.takeError());
+      globalNameHashes.clear();
+      return;
+    }
+    globalNameHashes[i] =
+        CachedHashStringRef(SymbolTable::getStem(*name)).hash();
+  }
+}
+
+Symbol *ELFFileBase::insertGlobal(size_t i, StringRef name) {
+  if (globalNameHashes.empty())
+    return symtab.insert(name);
+  return symtab.insert(name, globalNameHashes[i - firstGlobal]);
+}
+
 template <class ELFT> void ELFFileBase::init(InputFile::Kind k) {
   using Elf_Shdr = typename ELFT::Shdr;
   using Elf_Sym = typename ELFT::Sym;
@@ -1040,7 +1085,8 @@ void ObjFile<ELFT>::initializeSymbols(const object::ELFFile<ELFT> &obj) {
   // Some entries have been filled by LazyObjFile.
   for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i)
     if (!symbols[i])
-      symbols[i] = symtab.insert(CHECK(eSyms[i].getName(stringTable), this));
+      symbols[i] = insertGlobal(i, CHECK(eSyms[i].getName(stringTable), this));
+  globalNameHashes = {};
 
   // Perform symbol resolution on non-local symbols.
   SmallVector<unsigned, 32> undefineds;
@@ -1610,13 +1656,21 @@ BitcodeFile::BitcodeFile(MemoryBufferRef mb, StringRef archiveName,
   // into consideration at LTO time (which very likely causes undefined
   // symbols later in the link stage). So we append file offset to make
   // filename unique.
-  StringRef name = archiveName.empty()
-                       ? saver().save(path)
-                       : saver().save(archiveName + "(" + path::filename(path) +
-                                      " at " + utostr(offsetInArchive) + ")");
-  MemoryBufferRef mbref(mb.getBuffer(), name);
+  ltoName = archiveName.empty()
+                ? saver().save(path)
+                : saver().save(archiveName + "(" + path::filename(path) +
+                               " at " + utostr(offsetInArchive) + ")");
+}
 
-  obj = CHECK(lto::InputFile::create(mbref), this);
+// Reading the IR symbol table is the expensive part of creating a bitcode
+// file, in particular when it is outdated and has to be rebuilt from the
+// module. It does not depend on the other files, so the driver does it for all
+// the input files in parallel before they are parsed.
+void BitcodeFile::init() {
+  if (obj)
+    return;
+  obj = CHECK(lto::InputFile::create(MemoryBufferRef(mb.getBuffer(), ltoName)),
+              this);
 
   Triple t(obj->getTargetTriple());
   ekind = getBitcodeELFKind(t);
@@ -1768,7 +1822,8 @@ template <class ELFT> void ObjFile<ELFT>::parseLazy() {
   symbols.resize(eSyms.size());
   for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i)
     if (eSyms[i].st_shndx != SHN_UNDEF)
-      symbols[i] = symtab.insert(CHECK(eSyms[i].getName(stringTable), this));
+      symbols[i] = insertGlobal(i, CHECK(eSyms[i].getName(stringTable), this));
+  globalNameHashes = {};
 
   // Replace existing symbols with LazyObject symbols.
   //
@@ -195,9 +195,19 @@ public:
     return getELFSyms<ELFT>().slice(firstGlobal);
   }
 
+  // Computes globalNameHashes. Unlike symbol resolution, this does not depend
+  // on the order in which files are added, so it can run concurrently for all
+  // input files before they are parsed.
+  void hashGlobalSymbolNames();
+
 protected:
   // Initializes this class's member variables.
   template <typename ELFT> void init(InputFile::Kind k);
+  template <typename ELFT> void hashGlobalSymbolNames();
+
+  // Inserts the global symbol at index i of the ELF symbol table, named name,
+  // into the symbol table, reusing globalNameHashes if available.
+  Symbol *insertGlobal(size_t i, StringRef name);
 
   StringRef stringTable;
   const void *elfShdrs = nullptr;
@@ -206,6 +216,11 @@ protected:
   uint32_t numELFSyms = 0;
   uint32_t firstGlobal = 0;
 
+  // Hashes of the unversioned names of global symbols (see
+  // SymbolTable::getStem) used when inserting them into the symbol table.
+  // Empty if not computed, or released after the symbols have been inserted.
+  SmallVector<uint32_t, 0> globalNameHashes;
+
 public:
   uint32_t andFeatures = 0;
   bool hasCommonSyms = false;
@@ -319,11 +334,16 @@ public:
   BitcodeFile(MemoryBufferRef m, StringRef archiveName,
               uint64_t offsetInArchive, bool lazy);
   static bool classof(const InputFile *f) { return f->kind() == BitcodeKind; }
+  void init();
   void parse();
   void parseLazy();
   void postParse();
   std::unique_ptr<llvm::lto::InputFile> obj;
   std::vector<bool> keptComdats;
+
+private:
+  // The unique name of the file for LTO.
+  StringRef ltoName;
 };
 
 // .so file.
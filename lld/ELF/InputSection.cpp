@@ -19,6 +19,7 @@
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/Compression.h"
 #include "llvm/Support/Endian.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/xxhash.h"
 #include <algorithm>
 #include <mutex>
@@ -1235,7 +1236,22 @@ void MergeInputSection::splitStrings(StringRef s, size_t entSize) {
   const char *p = s.data(), *end = s.data() + s.size();
   if (!std::all_of(end - entSize, end, [](char c) { return c == 0; }))
     fatal(toString(this) + ": string is not null terminated");
-  if (entSize == 1) {
+  if (isLargeStringSection()) {
+    // Find string boundaries first, and then hash the strings in parallel.
+    do {
+      size_t size = entSize == 1 ? strlen(p)
+                                 : findNull(StringRef(p, end - p), entSize);
+      pieces.emplace_back(p - s.begin(), 0, live);
+      p += size + entSize;
+    } while (p != end);
+    parallelFor(0, pieces.size(), [&](size_t i) {
+      size_t begin = pieces[i].inputOff;
+      size_t size =
+          (i + 1 == pieces.size() ? s.size() : pieces[i + 1].inputOff) -
+          begin - entSize;
+      pieces[i].hash = (uint32_t)xxHash64(s.substr(begin, size)) >> 1;
+    });
+  } else if (entSize == 1) {
     // Optimize the common case.
     do {
       size_t size = strlen(p);
@@ -1276,6 +1292,10 @@ MergeInputSection::MergeInputSection(uint64_t flags, uint32_t type,
     : InputSectionBase(nullptr, flags, type, entsize, /*Link*/ 0, /*Info*/ 0,
                        /*Alignment*/ entsize, data, name, SectionBase::Merge) {}
 
+bool MergeInputSection::isLargeStringSection() const {
+  return (flags & SHF_STRINGS) && rawData.size() >= (1 << 20);
+}
+
 // This function is called after we obtain a complete list of input sections
 // that need to be linked. This is responsible to split section contents
 // into small chunks for further processing.
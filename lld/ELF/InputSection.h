@@ -272,6 +272,10 @@ public:
   static bool classof(const SectionBase *s) { return s->kind() == Merge; }
   void splitIntoPieces();
 
+  // Returns true if this is a string section large enough to be worth
+  // hashing its pieces in parallel.
+  bool isLargeStringSection() const;
+
   // Translate an offset in the input section to an offset in the parent
   // MergeSyntheticSection.
   uint64_t getParentOffset(uint64_t offset) const;
@@ -207,7 +207,18 @@ BitcodeCompiler::BitcodeCompiler() {
         config->thinLTOEmitImportsFiles);
   }
 
-  ltoObj = std::make_unique<lto::LTO>(createConfig(), backend,
+  // The --thinlto-remote-cache-dir option specifies a cache directory shared
+  // between machines, which is used behind the local cache.
+  lto::Config c = createConfig();
+  if (!config->thinLTOCacheDir.empty() &&
+      !config->thinLTORemoteCacheDir.empty()) {
+    remoteCache = directoryCacheStore(config->thinLTORemoteCacheDir);
+    c.CachePrefetchHook = [rc = remoteCache](StringRef key) {
+      rc->prefetch(key);
+    };
+  }
+
+  ltoObj = std::make_unique<lto::LTO>(std::move(c), backend,
                                        config->ltoPartitions);
 
   // Initialize usedStartStop.
@@ -332,6 +343,8 @@ std::vector<InputFile *> BitcodeCompiler::compile() {
                          [&](size_t task, std::unique_ptr<MemoryBuffer> mb) {
                            files[task] = std::move(mb);
                          }));
+  if (cache && remoteCache)
+    cache = llvm::remoteCache(std::move(cache), remoteCache);
 
   if (!ctx.bitcodeFiles.empty())
     checkError(ltoObj->run(
@@ -340,6 +353,8 @@ std::vector<InputFile *> BitcodeCompiler::compile() {
               std::make_unique<raw_svector_ostream>(buf[task]));
         },
         cache));
+  if (remoteCache)
+    remoteCache->wait();
 
   // Emit empty index files for non-indexed files but not in single-module mode.
   if (config->thinLTOModulesToCompile.empty()) {
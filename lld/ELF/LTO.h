@@ -27,9 +27,12 @@
 #include <memory>
 #include <vector>
 
-namespace llvm::lto {
+namespace llvm {
+class RemoteCacheStore;
+namespace lto {
 class LTO;
 }
+} // namespace llvm
 
 namespace lld::elf {
 
@@ -46,6 +49,7 @@ public:
 
 private:
   std::unique_ptr<llvm::lto::LTO> ltoObj;
+  std::shared_ptr<llvm::RemoteCacheStore> remoteCache;
   std::vector<SmallString<0>> buf;
   std::vector<std::unique_ptr<MemoryBuffer>> files;
   llvm::DenseSet<StringRef> usedStartStop;
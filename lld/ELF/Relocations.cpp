@@ -1514,22 +1514,45 @@ template <class ELFT> void elf::scanRelocations() {
   // for parallelism.
   bool serial = !config->zCombreloc || config->emachine == EM_MIPS ||
                 config->emachine == EM_PPC64;
+  //
+  // Sections are scanned in batches of roughly relocsPerTask relocations
+  // rather than one task per object file, so that a few large files do not
+  // leave the other threads idle. The scan order within and across batches
+  // does not affect the output: sharded dynamic relocations are sorted later.
+  constexpr size_t relocsPerTask = 4096;
   parallel::TaskGroup tg;
-  for (ELFFileBase *f : ctx.objectFiles) {
-    auto fn = [f]() {
+  SmallVector<InputSectionBase *, 0> batch;
+  size_t batchRelocs = 0;
+  auto flush = [&]() {
+    auto fn = [secs = std::move(batch)]() {
       RelocationScanner scanner;
-      for (InputSectionBase *s : f->getSections()) {
-        if (s && s->kind() == SectionBase::Regular && s->isLive() &&
-            (s->flags & SHF_ALLOC) &&
-            !(s->type == SHT_ARM_EXIDX && config->emachine == EM_ARM))
-          scanner.template scanSection<ELFT>(*s);
-      }
+      for (InputSectionBase *s : secs)
+        scanner.template scanSection<ELFT>(*s);
     };
+    batch.clear();
+    batchRelocs = 0;
     if (serial)
       fn();
     else
       tg.execute(fn);
+  };
+  for (ELFFileBase *f : ctx.objectFiles) {
+    for (InputSectionBase *s : f->getSections()) {
+      if (!s || s->kind() != SectionBase::Regular || !s->isLive() ||
+          !(s->flags & SHF_ALLOC) ||
+          (s->type == SHT_ARM_EXIDX && config->emachine == EM_ARM))
+        continue;
+      const RelsOrRelas<ELFT> rels = s->template relsOrRelas<ELFT>();
+      if (rels.rels.empty() && rels.relas.empty())
+        continue;
+      batch.push_back(s);
+      batchRelocs += rels.rels.size() + rels.relas.size();
+      if (batchRelocs >= relocsPerTask)
+        flush();
+    }
   }
+  if (!batch.empty())
+    flush();
 
   // Both the main thread and thread pool index 0 use getThreadIndex()==0. Be
   // careful that they don't concurrently run scanSections. When serial is
@@ -38,6 +38,14 @@ public:
   void wrap(Symbol *sym, Symbol *real, Symbol *wrap);
 
   Symbol *insert(StringRef name);
+  // Same as insert(name), where stemHash is the hash of getStem(name) computed
+  // ahead of time, possibly on another thread.
+  Symbol *insert(StringRef name, uint32_t stemHash);
+
+  // Returns the name a symbol is keyed by in the symbol table. <name>@@<version>
+  // means the symbol is the default version, in which case it is used to
+  // resolve references to <name>.
+  static StringRef getStem(StringRef name);
 
   template <typename T> Symbol *addSymbol(const T &newSym) {
     Symbol *sym = insert(newSym.getName());
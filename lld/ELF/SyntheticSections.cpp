@@ -54,6 +54,7 @@ using llvm::support::endian::write32le;
 using llvm::support::endian::write64le;
 
 constexpr size_t MergeNoTailSection::numShards;
+constexpr size_t MergeTailSection::numShards;
 
 static uint64_t readUint(uint8_t *buf) {
   return config->is64 ? read64(buf) : read32(buf);
@@ -3209,31 +3210,68 @@ void MergeSyntheticSection::addSection(MergeInputSection *ms) {
 
 MergeTailSection::MergeTailSection(StringRef name, uint32_t type,
                                    uint64_t flags, uint32_t alignment)
-    : MergeSyntheticSection(name, type, flags, alignment),
-      builder(StringTableBuilder::RAW, alignment) {}
+    : MergeSyntheticSection(name, type, flags, alignment) {}
 
-size_t MergeTailSection::getSize() const { return builder.getSize(); }
-
-void MergeTailSection::writeTo(uint8_t *buf) { builder.write(buf); }
+void MergeTailSection::writeTo(uint8_t *buf) {
+  parallelFor(0, numShards,
+              [&](size_t i) { shards[i].write(buf + shardOffsets[i]); });
+}
 
+// Tail merging sorts all strings by their suffixes, which is too slow to do
+// on a single thread for sections like .debug_str of large programs. Like
+// MergeNoTailSection, we split the strings into shards that can never share a
+// suffix and optimize each shard on its own thread.
 void MergeTailSection::finalizeContents() {
-  // Add all string pieces to the string table builder to create section
-  // contents.
-  for (MergeInputSection *sec : sections)
-    for (size_t i = 0, e = sec->pieces.size(); i != e; ++i)
-      if (sec->pieces[i].live)
-        builder.add(sec->getData(i));
+  // Initializes string table builders.
+  for (size_t i = 0; i < numShards; ++i)
+    shards.emplace_back(StringTableBuilder::RAW, alignment);
 
-  // Fix the string table content. After this, the contents will never change.
-  builder.finalize();
+  // Concurrency level. Must be a power of 2 to avoid expensive modulo
+  // operations in the following tight loop.
+  const size_t concurrency =
+      PowerOf2Floor(std::min<size_t>(config->threadCount, numShards));
+
+  // Add section pieces to the builders and fix the contents of each shard.
+  // Pieces are added in the same order regardless of the concurrency level,
+  // so the output is deterministic.
+  parallelFor(0, concurrency, [&](size_t threadId) {
+    for (MergeInputSection *sec : sections) {
+      for (size_t i = 0, e = sec->pieces.size(); i != e; ++i) {
+        if (!sec->pieces[i].live)
+          continue;
+        CachedHashStringRef data = sec->getData(i);
+        size_t shardId = getShardId(data.val());
+        if ((shardId & (concurrency - 1)) == threadId)
+          shards[shardId].add(data);
+      }
+    }
+    for (size_t i = threadId; i < numShards; i += concurrency)
+      shards[i].finalize();
+  });
+
+  // Compute an in-section offset for each shard.
+  size_t off = 0;
+  for (size_t i = 0; i < numShards; ++i) {
+    if (shards[i].getSize() > 0)
+      off = alignToPowerOf2(off, alignment);
+    shardOffsets[i] = off;
+    off += shards[i].getSize();
+  }
+  size = off;
 
   // finalize() fixed tail-optimized strings, so we can now get
   // offsets of strings. Get an offset for each string and save it
   // to a corresponding SectionPiece for easy access.
-  for (MergeInputSection *sec : sections)
-    for (size_t i = 0, e = sec->pieces.size(); i != e; ++i)
-      if (sec->pieces[i].live)
-        sec->pieces[i].outputOff = builder.getOffset(sec->getData(i));
+  parallelForEach(sections, [&](MergeInputSection *sec) {
+    for (size_t i = 0, e = sec->pieces.size(); i != e; ++i) {
+      if (!sec->pieces[i].live)
+        continue;
+      CachedHashStringRef data = sec->getData(i);
+      size_t shardId = getShardId(data.val());
+      sec->pieces[i].outputOff =
+          shardOffsets[shardId] + shards[shardId].getOffset(data);
+    }
+  });
 }
 
 void MergeNoTailSection::writeTo(uint8_t *buf) {
@@ -3301,12 +3339,24 @@ template <class ELFT> void elf::splitSections() {
     for (InputSectionBase *sec : file->getSections()) {
       if (!sec)
         continue;
-      if (auto *s = dyn_cast<MergeInputSection>(sec))
-        s->splitIntoPieces();
-      else if (auto *eh = dyn_cast<EhInputSection>(sec))
+      if (auto *s = dyn_cast<MergeInputSection>(sec)) {
+        if (!s->isLargeStringSection())
+          s->splitIntoPieces();
+      } else if (auto *eh = dyn_cast<EhInputSection>(sec)) {
         eh->split<ELFT>();
+      }
     }
   });
+
+  // Nested parallel loops run serially, so a single huge string section
+  // (e.g. .debug_str of an LTO object) would keep one thread busy above.
+  // Split such sections one by one so that each hashes its pieces in
+  // parallel.
+  for (ELFFileBase *file : ctx.objectFiles)
+    for (InputSectionBase *sec : file->getSections())
+      if (auto *s = dyn_cast_or_null<MergeInputSection>(sec))
+        if (s->isLargeStringSection())
+          s->splitIntoPieces();
 }
 
 void elf::combineEhSections() {
@@ -945,12 +945,26 @@ public:
   MergeTailSection(StringRef name, uint32_t type, uint64_t flags,
                    uint32_t alignment);
 
-  size_t getSize() const override;
+  size_t getSize() const override { return size; }
   void writeTo(uint8_t *buf) override;
   void finalizeContents() override;
 
 private:
-  llvm::StringTableBuilder builder;
+  // A string can only be a suffix of another string if both end with the
+  // same character, so we can shard strings by their last non-null byte
+  // without missing tail merge opportunities.
+  static size_t getShardId(StringRef s) {
+    size_t i = s.find_last_not_of('\0');
+    return i == StringRef::npos ? 0 : (uint8_t)s[i] % numShards;
+  }
+
+  // Section size
+  size_t size;
+
+  // String table contents
+  constexpr static size_t numShards = 32;
+  SmallVector<llvm::StringTableBuilder, 0> shards;
+  size_t shardOffsets[numShards];
 };
 
 class MergeNoTailSection final : public MergeSyntheticSection {
@@ -1140,6 +1140,7 @@ static void createFiles(const InputArgList &args) {
 static void gatherInputSections() {
   TimeTraceScope timeScope("Gathering input sections");
   int inputOrder = 0;
+  std::vector<CStringInputSection *> cStringInputSections;
   for (const InputFile *file : inputFiles) {
     for (const Section *section : file->sections) {
       // Compact unwind entries require special handling elsewhere. (In
@@ -1163,6 +1164,7 @@ static void gatherInputSections() {
           inputSections.push_back(isec);
         } else if (auto *isec =
                        dyn_cast<CStringInputSection>(subsection.isec)) {
+          cStringInputSections.push_back(isec);
           if (isec->getName() == section_names::objcMethname) {
             if (in.objcMethnameSection->inputOrder == UnspecifiedInputOrder)
               in.objcMethnameSection->inputOrder = inputOrder++;
@@ -1186,6 +1188,16 @@ static void gatherInputSections() {
       in.objCImageInfo->addFile(file);
   }
   assert(inputOrder <= UnspecifiedInputOrder);
+
+  // Splitting a C string section hashes every string in it, which is a
+  // significant part of the link time for inputs with many literals. The
+  // sections are independent of each other, so split them all at once here
+  // rather than one by one while the object files are parsed.
+  {
+    TimeTraceScope timeScope("Split C string sections");
+    parallelForEach(cStringInputSections,
+                    [](CStringInputSection *isec) { isec->splitIntoPieces(); });
+  }
 }
 
 static void foldIdenticalLiterals() {
@@ -1841,6 +1853,8 @@ bool macho::link(ArrayRef<const char *> argsArr, llvm::raw_ostream &stdoutOS,
     // ICF assumes that all literals have been folded already, so we must run
     // foldIdenticalLiterals before foldIdenticalSections.
     foldIdenticalLiterals();
+    if (config->dedupLiterals)
+      deduplicateObjCSelRefs();
     if (config->icfLevel != ICFLevel::none) {
       if (config->icfLevel == ICFLevel::safe)
         markAddrSigSymbols();
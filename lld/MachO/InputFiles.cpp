@@ -269,14 +269,16 @@ static Optional<size_t> getRecordSize(StringRef segname, StringRef name) {
   if (name == section_names::cfString && segname == segment_names::data)
     return target->wordSize == 8 ? 32 : 16;
 
+  // Selector references are deduplicated even without ICF; see
+  // deduplicateObjCSelRefs().
+  if (name == section_names::objcSelrefs && segname == segment_names::data)
+    return target->wordSize;
+
   if (config->icfLevel == ICFLevel::none)
     return {};
 
   if (name == section_names::objcClassRefs && segname == segment_names::data)
     return target->wordSize;
-
-  if (name == section_names::objcSelrefs && segname == segment_names::data)
-    return target->wordSize;
   return {};
 }
 
@@ -349,8 +351,8 @@ void ObjFile::parseSections(ArrayRef<SectionHeader> sectionHeaders) {
                                          /*dedupLiterals=*/name ==
                                                  section_names::objcMethname ||
                                              config->dedupLiterals);
-        // FIXME: parallelize this?
-        cast<CStringInputSection>(isec)->splitIntoPieces();
+        // The section is split into pieces later by gatherInputSections(),
+        // which handles all input files in parallel.
       } else {
         isec = make<WordLiteralInputSection>(section, data, align);
       }
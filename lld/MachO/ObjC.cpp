@@ -10,11 +10,16 @@
 #include "InputFiles.h"
 #include "InputSection.h"
 #include "OutputSegment.h"
+#include "Symbols.h"
 #include "Target.h"
 
 #include "lld/Common/ErrorHandler.h"
+#include "llvm/ADT/CachedHashString.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/BinaryFormat/MachO.h"
 #include "llvm/Bitcode/BitcodeReader.h"
+#include "llvm/Support/Parallel.h"
+#include "llvm/Support/TimeProfiler.h"
 
 using namespace llvm;
 using namespace llvm::MachO;
@@ -66,3 +71,66 @@ bool macho::hasObjCSection(MemoryBufferRef mb) {
     return false;
   }
 }
+
+// Returns the selector name that a __objc_selrefs record points to, or None if
+// the record does not have the expected shape.
+static Optional<StringRef> getSelRefName(const ConcatInputSection *isec) {
+  if (isec->getSize() != target->wordSize || isec->relocs.size() != 1)
+    return None;
+  const Reloc &r = isec->relocs.front();
+  if (r.pcrel || r.offset != 0)
+    return None;
+
+  const InputSection *referentIsec;
+  uint64_t off = r.addend;
+  if (auto *sym = r.referent.dyn_cast<Symbol *>()) {
+    auto *d = dyn_cast<Defined>(sym);
+    if (!d || !d->isec)
+      return None;
+    referentIsec = d->isec;
+    off += d->value;
+  } else {
+    referentIsec = r.referent.get<InputSection *>();
+  }
+
+  // The string is null-terminated since splitIntoPieces() has accepted it.
+  if (!isa<CStringInputSection>(referentIsec) ||
+      off >= referentIsec->data.size())
+    return None;
+  return StringRef(
+      reinterpret_cast<const char *>(referentIsec->data.data() + off));
+}
+
+// Every object file that sends a message has its own reference to the
+// selector, and dyld has to fix up each of them at launch. Since the
+// referenced names are uniqued by the runtime anyway, only one reference per
+// name is needed. The names are looked up and hashed in parallel; the folding
+// itself walks inputSections in order so that the output is deterministic.
+void macho::deduplicateObjCSelRefs() {
+  TimeTraceScope timeScope("Deduplicate ObjC selector references");
+  std::vector<ConcatInputSection *> selRefs;
+  for (ConcatInputSection *isec : inputSections)
+    if (isSelRefsSection(isec) && !isec->shouldOmitFromOutput() &&
+        !isec->hasAltEntry)
+      selRefs.push_back(isec);
+
+  std::vector<Optional<CachedHashStringRef>> names(selRefs.size());
+  parallelFor(0, selRefs.size(), [&](size_t i) {
+    if (Optional<StringRef> name = getSelRefName(selRefs[i]))
+      names[i] = CachedHashStringRef(*name);
+  });
+
+  DenseMap<CachedHashStringRef, ConcatInputSection *> canonicalSelRefs;
+  size_t numFolded = 0;
+  for (size_t i = 0, e = selRefs.size(); i != e; ++i) {
+    if (!names[i])
+      continue;
+    auto it = canonicalSelRefs.try_emplace(*names[i], selRefs[i]);
+    if (it.second)
+      continue;
+    it.first->second->foldIdentical(selRefs[i]);
+    ++numFolded;
+  }
+  log("deduplicated " + Twine(numFolded) + " of " + Twine(selRefs.size()) +
+      " selector references");
+}
@@ -24,6 +24,10 @@ constexpr const char ivar[] = "_OBJC_IVAR_$_";
 
 bool hasObjCSection(llvm::MemoryBufferRef);
 
+// Fold the live __objc_selrefs records that refer to the same selector name
+// into the first one in input order.
+void deduplicateObjCSelRefs();
+
 } // namespace lld::macho
 
 #endif
@@ -467,6 +467,14 @@ public:
   void ForEach(std::function<bool(const lldb::ModuleSP &module_sp)> const
                    &callback) const;
 
+  /// Call Module::PreloadSymbols() for every module in the list, using the
+  /// debugger thread pool so that the symbol tables and symbol file indexes
+  /// of different modules are parsed in parallel.
+  ///
+  /// \param[in] debugger
+  ///     The debugger to report progress to, or nullptr.
+  void PreloadSymbols(Debugger *debugger = nullptr) const;
+
 protected:
   // Class typedefs.
   typedef std::vector<lldb::ModuleSP>
@@ -339,11 +339,13 @@ private:
   LineTable(const LineTable &) = delete;
   const LineTable &operator=(const LineTable &) = delete;
 
-  template <typename T>
+  // The matcher is called for every row, so it is taken as a template
+  // parameter rather than a std::function, and the file indexes by reference.
+  template <typename T, typename MatcherT>
   uint32_t FindLineEntryIndexByFileIndexImpl(
-      uint32_t start_idx, T file_idx,
+      uint32_t start_idx, const T &file_idx,
       const SourceLocationSpec &src_location_spec, LineEntry *line_entry_ptr,
-      std::function<bool(T, uint16_t)> file_idx_matcher) {
+      MatcherT file_idx_matcher) {
     const size_t count = m_entries.size();
     size_t best_match = UINT32_MAX;
 
@@ -163,6 +163,8 @@ public:
 
   bool GetEnableNotifyAboutFixIts() const;
 
+  uint64_t GetExpressionCacheSize() const;
+
   FileSpec GetSaveJITObjectsDir() const;
 
   bool GetEnableSyntheticValue() const;
@@ -1140,6 +1142,16 @@ public:
                                const EvaluateExpressionOptions &options,
                                ValueObject *ctx_obj, Status &error);
 
+  /// Return an expression that was parsed with the given \a key and can be
+  /// executed again in \a exe_ctx without parsing it, or nullptr.
+  lldb::UserExpressionSP GetCachedUserExpression(llvm::StringRef key,
+                                                 ExecutionContext &exe_ctx);
+
+  /// Remember a parsed expression for GetCachedUserExpression(), evicting
+  /// the least recently used one if the cache is full.
+  void CacheUserExpression(llvm::StringRef key,
+                           const lldb::UserExpressionSP &expr_sp);
+
   // Creates a FunctionCaller for the given language, the rest of the
   // parameters have the same meaning as for the FunctionCaller constructor.
   // Since a FunctionCaller can't be
@@ -1549,6 +1561,11 @@ protected:
   /// more usefully in the Dummy target where you can't know exactly what
   /// signals you will have.
   llvm::StringMap<DummySignalValues> m_dummy_signals;
+  /// Parsed expressions and the keys they were parsed with, most recently
+  /// used last.
+  std::vector<std::pair<std::string, lldb::UserExpressionSP>>
+      m_user_expression_cache;
+  std::mutex m_user_expression_cache_mutex;
 
   static void ImageSearchPathsChanged(const PathMappingList &path_list,
                                       void *baton);
@@ -180,6 +180,7 @@ public:
     eServerPacketType_vStopped,
     eServerPacketType_vCtrlC,
     eServerPacketType_vStdio,
+    eServerPacketType_MultiMemRead,
   };
 
   ServerPacketType GetServerPacketType() const;
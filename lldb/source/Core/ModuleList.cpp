@@ -7,9 +7,11 @@
 //===----------------------------------------------------------------------===//
 
 #include "lldb/Core/ModuleList.h"
+#include "lldb/Core/Debugger.h"
 #include "lldb/Core/FileSpecList.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/ModuleSpec.h"
+#include "lldb/Core/Progress.h"
 #include "lldb/Host/FileSystem.h"
 #include "lldb/Interpreter/OptionValueFileSpec.h"
 #include "lldb/Interpreter/OptionValueFileSpecList.h"
@@ -34,6 +36,8 @@
 #include "clang/Driver/Driver.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/Threading.h"
 #include "llvm/Support/raw_ostream.h"
 
@@ -1073,3 +1077,34 @@ void ModuleList::ForEach(
       break;
   }
 }
+
+void ModuleList::PreloadSymbols(Debugger *debugger) const {
+  // Work on a copy so that the list lock is not held while parsing.
+  collection modules;
+  {
+    std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
+    modules = m_modules;
+  }
+  if (modules.empty())
+    return;
+  if (modules.size() == 1) {
+    modules.front()->PreloadSymbols();
+    return;
+  }
+
+  Progress progress(
+      llvm::formatv("Loading symbols for {0} modules", modules.size()),
+      modules.size(), debugger);
+
+  // Each module is protected by its own mutex, so the modules can be parsed
+  // independently. Symbol files that index in parallel themselves use the
+  // same pool, whose task groups can be waited on from a worker thread.
+  llvm::ThreadPoolTaskGroup task_group(Debugger::GetThreadPool());
+  for (const ModuleSP &module_sp : modules) {
+    task_group.async([&module_sp, &progress] {
+      module_sp->PreloadSymbols();
+      progress.Increment();
+    });
+  }
+  task_group.wait();
+}
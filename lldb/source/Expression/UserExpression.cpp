@@ -248,18 +248,40 @@ UserExpression::Evaluate(ExecutionContext &exe_ctx,
       language = frame->GetLanguage();
   }
 
-  lldb::UserExpressionSP user_expression_sp(
-      target->GetUserExpressionForLanguage(expr, full_prefix, language,
-                                           desired_type, options, ctx_obj,
-                                           error));
-  if (error.Fail()) {
-    LLDB_LOG(log, "== [UserExpression::Evaluate] Getting expression: {0} ==",
-             error.AsCString());
-    return lldb::eExpressionSetupError;
+  // Expressions that are evaluated repeatedly, e.g. by scripts stepping
+  // through a program, are kept parsed in the target and executed again as
+  // long as the process and frame location match the ones they were parsed
+  // for. Expressions that can change what the next parse sees (top-level
+  // declarations and persistent variables) are always parsed again.
+  std::string cache_key;
+  if (!ctx_obj && !options.GetREPLEnabled() && !options.GetDebug() &&
+      options.GetPoundLineFilePath() == nullptr &&
+      execution_policy != eExecutionPolicyTopLevel &&
+      target->GetExpressionCacheSize() != 0 && !expr.contains('$')) {
+    llvm::raw_string_ostream os(cache_key);
+    os << language << ';' << desired_type << ';' << execution_policy << ';'
+       << (exe_ctx.GetFramePtr() != nullptr) << ';'
+       << options.GetGenerateDebugInfo() << ';' << options.GetUseDynamic()
+       << ';' << full_prefix.size() << ';' << full_prefix << expr;
+  }
+
+  lldb::UserExpressionSP user_expression_sp;
+  if (!cache_key.empty())
+    user_expression_sp = target->GetCachedUserExpression(cache_key, exe_ctx);
+  const bool is_cached = user_expression_sp != nullptr;
+
+  if (!is_cached) {
+    user_expression_sp.reset(target->GetUserExpressionForLanguage(
+        expr, full_prefix, language, desired_type, options, ctx_obj, error));
+    if (error.Fail()) {
+      LLDB_LOG(log, "== [UserExpression::Evaluate] Getting expression: {0} ==",
+               error.AsCString());
+      return lldb::eExpressionSetupError;
+    }
   }
 
-  LLDB_LOG(log, "== [UserExpression::Evaluate] Parsing expression {0} ==",
-           expr.str());
+  LLDB_LOG(log, "== [UserExpression::Evaluate] {0} expression {1} ==",
+           is_cached ? "Reusing parsed" : "Parsing", expr.str());
 
   const bool keep_expression_in_memory = true;
   const bool generate_debug_info = options.GetGenerateDebugInfo();
@@ -274,8 +296,11 @@ UserExpression::Evaluate(ExecutionContext &exe_ctx,
   DiagnosticManager diagnostic_manager;
 
   bool parse_success =
+      is_cached ||
       user_expression_sp->Parse(diagnostic_manager, exe_ctx, execution_policy,
                                 keep_expression_in_memory, generate_debug_info);
+  if (parse_success && !is_cached && !cache_key.empty())
+    target->CacheUserExpression(cache_key, user_expression_sp);
 
   // Calculate the fixed expression always, since we need it for errors.
   std::string tmp_fixed_expression;
@@ -282,6 +282,7 @@ void GDBRemoteCommunicationClient::ResetDiscoverableSettings(bool did_exec) {
     m_avoid_g_packets = eLazyBoolCalculate;
     m_supports_multiprocess = eLazyBoolCalculate;
     m_supports_qSaveCore = eLazyBoolCalculate;
+    m_supports_MultiMemRead = eLazyBoolCalculate;
     m_supports_qXfer_auxv_read = eLazyBoolCalculate;
     m_supports_qXfer_libraries_read = eLazyBoolCalculate;
     m_supports_qXfer_libraries_svr4_read = eLazyBoolCalculate;
@@ -341,6 +342,7 @@ void GDBRemoteCommunicationClient::GetRemoteQSupported() {
   m_supports_QPassSignals = eLazyBoolNo;
   m_supports_memory_tagging = eLazyBoolNo;
   m_supports_qSaveCore = eLazyBoolNo;
+  m_supports_MultiMemRead = eLazyBoolNo;
   m_uses_native_signals = eLazyBoolNo;
 
   m_max_packet_size = UINT64_MAX; // It's supposed to always be there, but if
@@ -390,6 +392,8 @@ void GDBRemoteCommunicationClient::GetRemoteQSupported() {
         m_supports_memory_tagging = eLazyBoolYes;
       else if (x == "qSaveCore+")
         m_supports_qSaveCore = eLazyBoolYes;
+      else if (x == "MultiMemRead+")
+        m_supports_MultiMemRead = eLazyBoolYes;
       else if (x == "native-signals+")
         m_uses_native_signals = eLazyBoolYes;
       // Look for a list of compressions in the features list e.g.
@@ -620,6 +624,59 @@ bool GDBRemoteCommunicationClient::GetMemoryTaggingSupported() {
   return m_supports_memory_tagging == eLazyBoolYes;
 }
 
+bool GDBRemoteCommunicationClient::GetMultiMemReadSupported() {
+  if (m_supports_MultiMemRead == eLazyBoolCalculate)
+    GetRemoteQSupported();
+  return m_supports_MultiMemRead == eLazyBoolYes;
+}
+
+llvm::Expected<std::vector<std::string>>
+GDBRemoteCommunicationClient::MultiMemRead(
+    llvm::ArrayRef<std::pair<lldb::addr_t, size_t>> ranges) {
+  // Format packet:
+  // MultiMemRead:ranges:<addr1>,<len1>,<addr2>,<len2>...;
+  StreamString packet;
+  packet.PutCString("MultiMemRead:ranges:");
+  for (size_t i = 0; i < ranges.size(); ++i)
+    packet.Printf("%s%" PRIx64 ",%zx", i == 0 ? "" : ",", ranges[i].first,
+                  ranges[i].second);
+  packet.PutChar(';');
+
+  StringExtractorGDBRemote response;
+  if (SendPacketAndWaitForResponse(packet.GetString(), response) !=
+      PacketResult::Success)
+    return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                   "failed to send MultiMemRead packet");
+  if (response.IsErrorResponse() || response.IsUnsupportedResponse())
+    return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                   "MultiMemRead packet failed");
+
+  // We are expecting
+  // <len1>,<len2>...;<binary data of all ranges>
+  // The lower level packet layer has already removed the binary escaping.
+  llvm::StringRef lengths_str, data;
+  std::tie(lengths_str, data) = response.GetStringRef().split(';');
+  llvm::SmallVector<llvm::StringRef, 16> lengths;
+  lengths_str.split(lengths, ',');
+  if (lengths.size() != ranges.size())
+    return llvm::createStringError(
+        llvm::inconvertibleErrorCode(),
+        "MultiMemRead response has %zu ranges, expected %zu", lengths.size(),
+        ranges.size());
+
+  std::vector<std::string> result;
+  for (size_t i = 0; i < lengths.size(); ++i) {
+    size_t len;
+    if (lengths[i].getAsInteger(16, len) || len > ranges[i].second ||
+        len > data.size())
+      return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                     "malformed MultiMemRead response");
+    result.push_back(data.take_front(len).str());
+    data = data.drop_front(len);
+  }
+  return result;
+}
+
 DataBufferSP GDBRemoteCommunicationClient::ReadMemoryTags(lldb::addr_t addr,
                                                           size_t len,
                                                           int32_t type) {
@@ -431,6 +431,16 @@ public:
 
   bool GetMemoryTaggingSupported();
 
+  bool GetMultiMemReadSupported();
+
+  /// Read several ranges of memory with a single MultiMemRead packet.
+  ///
+  /// \return
+  ///   The bytes read for each range, in order. A range may come back short
+  ///   or empty if it was only partially readable.
+  llvm::Expected<std::vector<std::string>>
+  MultiMemRead(llvm::ArrayRef<std::pair<lldb::addr_t, size_t>> ranges);
+
   bool UsesNativeSignals();
 
   lldb::DataBufferSP ReadMemoryTags(lldb::addr_t addr, size_t len,
@@ -558,6 +568,7 @@ protected:
   LazyBool m_supports_multiprocess = eLazyBoolCalculate;
   LazyBool m_supports_memory_tagging = eLazyBoolCalculate;
   LazyBool m_supports_qSaveCore = eLazyBoolCalculate;
+  LazyBool m_supports_MultiMemRead = eLazyBoolCalculate;
   LazyBool m_uses_native_signals = eLazyBoolCalculate;
 
   bool m_supports_qProcessInfoPID : 1, m_supports_qfProcessInfo : 1,
@@ -95,6 +95,9 @@ void GDBRemoteCommunicationServerLLGS::RegisterPacketHandlers() {
       &GDBRemoteCommunicationServerLLGS::Handle_memory_read);
   RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_M,
                                 &GDBRemoteCommunicationServerLLGS::Handle_M);
+  RegisterMemberFunctionHandler(
+      StringExtractorGDBRemote::eServerPacketType_MultiMemRead,
+      &GDBRemoteCommunicationServerLLGS::Handle_MultiMemRead);
   RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType__M,
                                 &GDBRemoteCommunicationServerLLGS::Handle__M);
   RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType__m,
@@ -2555,6 +2558,59 @@ GDBRemoteCommunicationServerLLGS::Handle_memory_read(
   return SendPacketNoLock(response.GetString());
 }
 
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServerLLGS::Handle_MultiMemRead(
+    StringExtractorGDBRemote &packet) {
+  Log *log = GetLog(LLDBLog::Process);
+
+  if (!m_current_process ||
+      (m_current_process->GetID() == LLDB_INVALID_PROCESS_ID)) {
+    LLDB_LOGF(
+        log,
+        "GDBRemoteCommunicationServerLLGS::%s failed, no process available",
+        __FUNCTION__);
+    return SendErrorResponse(0x15);
+  }
+
+  // Packet format: MultiMemRead:ranges:<addr>,<len>[,<addr>,<len>...];
+  llvm::StringRef ranges_str = packet.GetStringRef();
+  if (!ranges_str.consume_front("MultiMemRead:ranges:") ||
+      !ranges_str.consume_back(";"))
+    return SendIllFormedResponse(packet, "Invalid MultiMemRead packet");
+
+  llvm::SmallVector<llvm::StringRef, 16> fields;
+  ranges_str.split(fields, ',');
+  if (fields.size() % 2 != 0)
+    return SendIllFormedResponse(packet, "Odd number of MultiMemRead fields");
+
+  // Reply with the number of bytes read for each range, followed by the data
+  // of all ranges. A range that could not be read at all has length zero.
+  StreamGDBRemote response;
+  std::string data;
+  for (size_t i = 0; i < fields.size(); i += 2) {
+    lldb::addr_t addr;
+    uint64_t len;
+    if (fields[i].getAsInteger(16, addr) ||
+        fields[i + 1].getAsInteger(16, len))
+      return SendIllFormedResponse(packet, "Invalid MultiMemRead range");
+
+    size_t bytes_read = 0;
+    if (len) {
+      const size_t offset = data.size();
+      data.resize(offset + len);
+      Status error = m_current_process->ReadMemoryWithoutTrap(
+          addr, &data[offset], len, bytes_read);
+      if (error.Fail())
+        bytes_read = 0;
+      data.resize(offset + bytes_read);
+    }
+    response.Printf("%s%" PRIx64, i == 0 ? "" : ",", uint64_t(bytes_read));
+  }
+  response.PutChar(';');
+  response.PutEscapedBytes(data.data(), data.size());
+  return SendPacketNoLock(response.GetString());
+}
+
 GDBRemoteCommunication::PacketResult
 GDBRemoteCommunicationServerLLGS::Handle__M(StringExtractorGDBRemote &packet) {
   Log *log = GetLog(LLDBLog::Process);
@@ -4205,6 +4261,7 @@ std::vector<std::string> GDBRemoteCommunicationServerLLGS::HandleFeatures(
                             "QListThreadsInStopReply+",
                             "qXfer:features:read+",
                             "QNonStop+",
+                            "MultiMemRead+",
                         });
 
   // report server-only features
@@ -164,6 +164,12 @@ public:
     const uint32_t idx = ePropertyUseGPacketForReading;
     return m_collection_sp->GetPropertyAtIndexAsBoolean(nullptr, idx, true);
   }
+
+  uint64_t GetStackPrefetchSize() const {
+    const uint32_t idx = ePropertyStackPrefetchSize;
+    return m_collection_sp->GetPropertyAtIndexAsUInt64(
+        nullptr, idx, g_processgdbremote_properties[idx].default_uint_value);
+  }
 };
 
 } // namespace
@@ -2313,6 +2319,52 @@ void ProcessGDBRemote::RefreshStateAfterStop() {
   // Let all threads recover from stopping and do any clean up based on the
   // previous thread state (if any).
   m_thread_list_real.RefreshStateAfterStop();
+
+  PrefetchStackMemory();
+}
+
+void ProcessGDBRemote::PrefetchStackMemory() {
+  const uint64_t prefetch_size =
+      GetGlobalPluginProperties().GetStackPrefetchSize();
+  if (prefetch_size == 0 || !m_gdb_comm.GetMultiMemReadSupported())
+    return;
+
+  // The reply carries binary data that may need escaping, so keep the total
+  // within half of the largest memory read.
+  GetMaxMemorySize();
+  const uint64_t budget = m_max_memory_size / 2;
+
+  std::vector<std::pair<lldb::addr_t, size_t>> ranges;
+  uint64_t total = 0;
+  const uint32_t num_threads = m_thread_list_real.GetSize(false);
+  for (uint32_t i = 0; i < num_threads; ++i) {
+    if (total + prefetch_size > budget)
+      break;
+    ThreadGDBRemote *thread = static_cast<ThreadGDBRemote *>(
+        m_thread_list_real.GetThreadAtIndex(i, false).get());
+    if (!thread)
+      continue;
+    if (llvm::Optional<lldb::addr_t> sp = thread->GetExpeditedStackPointer()) {
+      ranges.emplace_back(*sp, prefetch_size);
+      total += prefetch_size;
+    }
+  }
+  if (ranges.empty())
+    return;
+
+  llvm::Expected<std::vector<std::string>> data =
+      m_gdb_comm.MultiMemRead(ranges);
+  if (!data) {
+    LLDB_LOG_ERROR(GetLog(GDBRLog::Memory), data.takeError(),
+                   "failed to prefetch stack memory: {0}");
+    return;
+  }
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    const std::string &bytes = (*data)[i];
+    if (!bytes.empty())
+      m_memory_cache.AddL1CacheData(ranges[i].first, bytes.data(),
+                                    bytes.size());
+  }
 }
 
 Status ProcessGDBRemote::DoHalt(bool &caused_stop) {
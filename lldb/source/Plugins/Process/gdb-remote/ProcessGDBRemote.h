@@ -331,6 +331,11 @@ protected:
 
   void GetMaxMemorySize();
 
+  /// Read the top of the stack of every thread whose stack pointer came with
+  /// the stop reply into the memory cache, using one MultiMemRead packet.
+  /// Unwinding then does not need a round trip per stack slot.
+  void PrefetchStackMemory();
+
   bool CalculateThreadStopInfo(ThreadGDBRemote *thread);
 
   size_t UpdateThreadPCsFromStopReplyThreadsValue(llvm::StringRef value);
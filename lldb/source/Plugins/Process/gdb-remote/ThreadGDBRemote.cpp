@@ -339,6 +339,21 @@ bool ThreadGDBRemote::PrivateSetRegisterValue(uint32_t reg, uint64_t regval) {
   return gdb_reg_ctx->PrivateSetRegisterValue(reg, regval);
 }
 
+llvm::Optional<lldb::addr_t> ThreadGDBRemote::GetExpeditedStackPointer() {
+  GDBRemoteRegisterContext *gdb_reg_ctx =
+      static_cast<GDBRemoteRegisterContext *>(GetRegisterContext().get());
+  assert(gdb_reg_ctx);
+  const uint32_t reg = gdb_reg_ctx->ConvertRegisterKindToRegisterNumber(
+      eRegisterKindGeneric, LLDB_REGNUM_GENERIC_SP);
+  if (reg == LLDB_INVALID_REGNUM || !gdb_reg_ctx->GetRegisterIsValid(reg))
+    return llvm::None;
+  const lldb::addr_t sp =
+      gdb_reg_ctx->ReadRegisterAsUnsigned(reg, LLDB_INVALID_ADDRESS);
+  if (sp == LLDB_INVALID_ADDRESS)
+    return llvm::None;
+  return sp;
+}
+
 bool ThreadGDBRemote::CalculateStopInfo() {
   ProcessSP process_sp(GetProcess());
   if (process_sp)
@@ -109,6 +109,10 @@ protected:
 
   bool PrivateSetRegisterValue(uint32_t reg, uint64_t regval);
 
+  /// Return the stack pointer if the stop reply expedited it, without asking
+  /// the remote for it.
+  llvm::Optional<lldb::addr_t> GetExpeditedStackPointer();
+
   bool CachedQueueInfoIsValid() const {
     return m_queue_kind != lldb::eQueueKindUnknown;
   }
@@ -544,6 +544,25 @@ DWARFDIE DWARFFormValue::Reference() const {
   }
 }
 
+DWARFUnit *DWARFFormValue::ReferencedUnit() const {
+  switch (m_form) {
+  case DW_FORM_ref1:
+  case DW_FORM_ref2:
+  case DW_FORM_ref4:
+  case DW_FORM_ref8:
+  case DW_FORM_ref_udata:
+    return const_cast<DWARFUnit *>(m_unit);
+  case DW_FORM_ref_addr:
+    return m_unit->GetSymbolFileDWARF().DebugInfo().GetUnitContainingDIEOffset(
+        DIERef::Section::DebugInfo, m_value.value.uval);
+  case DW_FORM_ref_sig8:
+    return m_unit->GetSymbolFileDWARF().DebugInfo().GetTypeUnitForHash(
+        m_value.value.uval);
+  default:
+    return nullptr;
+  }
+}
+
 uint64_t DWARFFormValue::Reference(dw_offset_t base_offset) const {
   uint64_t value = m_value.value.uval;
   switch (m_form) {
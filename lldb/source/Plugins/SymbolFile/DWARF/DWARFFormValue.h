@@ -59,6 +59,9 @@ public:
                                               const DWARFUnit *u);
   llvm::Optional<uint8_t> GetFixedSize() const;
   DWARFDIE Reference() const;
+  /// Return the unit a reference points into without extracting its DIEs, or
+  /// nullptr if this is not a reference.
+  DWARFUnit *ReferencedUnit() const;
   uint64_t Reference(dw_offset_t offset) const;
   bool Boolean() const { return m_value.value.uval != 0; }
   uint64_t Unsigned() const { return m_value.value.uval; }
@@ -170,9 +170,13 @@ void ManualDWARFIndex::IndexUnit(DWARFUnit &unit, SymbolFileDWARFDwo *dwp,
       if (dwo_symbol_file == dwp) {
         IndexUnitImpl(unit.GetNonSkeletonUnit(), cu_language, set);
       } else {
+        const uint64_t dwo_id = *unit.GetDWOId();
+        if (LoadUnitFromCache(dwo_id, *dwo_symbol_file->GetDwoNum(), set))
+          return;
         DWARFDebugInfo &dwo_info = dwo_symbol_file->DebugInfo();
         for (size_t i = 0; i < dwo_info.GetNumUnits(); ++i)
           IndexUnitImpl(*dwo_info.GetUnitAtIndex(i), cu_language, set);
+        SaveUnitToCache(dwo_id, set);
       }
     }
   } else {
@@ -524,7 +528,7 @@ enum DataID {
   kDataIDEnd = 255u,
 
 };
-constexpr uint32_t CURRENT_CACHE_VERSION = 1;
+constexpr uint32_t CURRENT_CACHE_VERSION = 2;
 
 bool ManualDWARFIndex::IndexSet::Decode(const DataExtractor &data,
                                         lldb::offset_t *offset_ptr) {
@@ -701,6 +705,8 @@ bool ManualDWARFIndex::LoadFromCache() {
   const bool result = Decode(data, &offset, signature_mismatch);
   if (signature_mismatch)
     cache->RemoveCacheFile(GetCacheKey());
+  if (result)
+    m_cache_buffer_up = std::move(mem_buffer_up);
   return result;
 }
 
@@ -719,3 +725,54 @@ void ManualDWARFIndex::SaveToCache() {
       m_dwarf->SetDebugInfoIndexWasSavedToCache();
   }
 }
+
+std::string ManualDWARFIndex::GetUnitCacheKey(uint64_t dwo_id) {
+  std::string key;
+  llvm::raw_string_ostream strm(key);
+  strm << m_module.GetArchitecture().GetTriple().str() << "-dwo-index-"
+       << llvm::format_hex(dwo_id, 18);
+  return strm.str();
+}
+
+bool ManualDWARFIndex::LoadUnitFromCache(uint64_t dwo_id, uint32_t dwo_num,
+                                         IndexSet &set) {
+  DataFileCache *cache = Module::GetIndexCache();
+  if (!cache)
+    return false;
+  std::unique_ptr<llvm::MemoryBuffer> mem_buffer_up =
+      cache->GetCachedData(GetUnitCacheKey(dwo_id));
+  if (!mem_buffer_up)
+    return false;
+  DataExtractor data(mem_buffer_up->getBufferStart(),
+                     mem_buffer_up->getBufferSize(),
+                     endian::InlHostByteOrder(),
+                     m_module.GetArchitecture().GetAddressByteSize());
+  lldb::offset_t offset = 0;
+  IndexSet cached;
+  if (!cached.Decode(data, &offset))
+    return false;
+  // The DIE references name the .dwo file by the index of its skeleton unit,
+  // which need not be the same as when the entry was cached.
+  auto rebind = [&](NameToDIE(IndexSet::*index)) {
+    (set.*index).AppendWithDwoNum(cached.*index, dwo_num);
+  };
+  rebind(&IndexSet::function_basenames);
+  rebind(&IndexSet::function_fullnames);
+  rebind(&IndexSet::function_methods);
+  rebind(&IndexSet::function_selectors);
+  rebind(&IndexSet::objc_class_selectors);
+  rebind(&IndexSet::globals);
+  rebind(&IndexSet::types);
+  rebind(&IndexSet::namespaces);
+  return true;
+}
+
+void ManualDWARFIndex::SaveUnitToCache(uint64_t dwo_id, const IndexSet &set) {
+  DataFileCache *cache = Module::GetIndexCache();
+  if (!cache)
+    return; // Caching is not enabled.
+  DataEncoder file(endian::InlHostByteOrder(),
+                   m_module.GetArchitecture().GetAddressByteSize());
+  set.Encode(file);
+  cache->SetCachedData(GetUnitCacheKey(dwo_id), file.GetData());
+}
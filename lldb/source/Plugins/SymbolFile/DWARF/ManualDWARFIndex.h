@@ -12,6 +12,7 @@
 #include "Plugins/SymbolFile/DWARF/DWARFIndex.h"
 #include "Plugins/SymbolFile/DWARF/NameToDIE.h"
 #include "llvm/ADT/DenseSet.h"
+#include "llvm/Support/MemoryBuffer.h"
 
 class DWARFDebugInfo;
 class SymbolFileDWARFDwo;
@@ -159,6 +160,21 @@ private:
   ///   false if the symbol table wasn't cached or was out of date.
   bool LoadFromCache();
 
+  /// Get the cache key for the index of the .dwo file with DWO ID \a dwo_id.
+  ///
+  /// The DWO ID is a hash of the contents of the split unit, so the cached
+  /// index of a .dwo file stays valid when the main executable is relinked.
+  /// After a rebuild only the units whose .dwo files changed need to be
+  /// indexed again.
+  std::string GetUnitCacheKey(uint64_t dwo_id);
+
+  /// Load the index of the .dwo file with DWO ID \a dwo_id into \a set,
+  /// rewriting its DIE references to refer to the .dwo file \a dwo_num.
+  bool LoadUnitFromCache(uint64_t dwo_id, uint32_t dwo_num, IndexSet &set);
+
+  /// Save the index \a set of the .dwo file with DWO ID \a dwo_id.
+  void SaveUnitToCache(uint64_t dwo_id, const IndexSet &set);
+
   void IndexUnit(DWARFUnit &unit, SymbolFileDWARFDwo *dwp, IndexSet &set);
 
   static void IndexUnitImpl(DWARFUnit &unit,
@@ -171,6 +187,9 @@ private:
   llvm::DenseSet<dw_offset_t> m_units_to_avoid;
 
   IndexSet m_set;
+  /// The cache file m_set was decoded from. The decoded name tables are
+  /// searched in place and refer to this buffer.
+  std::unique_ptr<llvm::MemoryBuffer> m_cache_buffer_up;
   bool m_indexed = false;
 };
 } // namespace lldb_private
@@ -20,17 +20,56 @@
 using namespace lldb;
 using namespace lldb_private;
 
+// Each encoded entry is a uint32_t string table offset and an 8 byte DIERef.
+static constexpr uint32_t kEntrySize = 12;
+
 void NameToDIE::Finalize() {
   m_map.Sort(std::less<DIERef>());
   m_map.SizeToFit();
 }
 
 void NameToDIE::Insert(ConstString name, const DIERef &die_ref) {
+  assert(m_mapped_count == 0 && "inserting into a decoded map");
   m_map.Append(name, die_ref);
 }
 
+void NameToDIE::Clear() {
+  m_map.Clear();
+  m_mapped_data.Clear();
+  m_mapped_strtab = StringTableReader();
+  m_mapped_start = 0;
+  m_mapped_count = 0;
+}
+
+llvm::StringRef NameToDIE::GetMappedName(uint32_t idx) const {
+  lldb::offset_t offset = m_mapped_start + idx * kEntrySize;
+  return m_mapped_strtab.Get(m_mapped_data.GetU32(&offset));
+}
+
+DIERef NameToDIE::GetMappedDIERef(uint32_t idx) const {
+  lldb::offset_t offset = m_mapped_start + idx * kEntrySize + 4;
+  // Every entry was validated by Decode().
+  return *DIERef::Decode(m_mapped_data, &offset);
+}
+
 bool NameToDIE::Find(ConstString name,
                      llvm::function_ref<bool(DIERef ref)> callback) const {
+  if (m_mapped_count) {
+    llvm::StringRef key = name.GetStringRef();
+    uint32_t lo = 0;
+    uint32_t hi = m_mapped_count;
+    while (lo < hi) {
+      const uint32_t mid = lo + (hi - lo) / 2;
+      if (GetMappedName(mid) < key)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    for (; lo < m_mapped_count && GetMappedName(lo) == key; ++lo)
+      if (!callback(GetMappedDIERef(lo)))
+        return false;
+    return true;
+  }
   for (const auto &entry : m_map.equal_range(name))
     if (!callback(entry.value))
       return false;
@@ -39,6 +78,11 @@ bool NameToDIE::Find(ConstString name,
 
 bool NameToDIE::Find(const RegularExpression &regex,
                      llvm::function_ref<bool(DIERef ref)> callback) const {
+  for (uint32_t i = 0; i < m_mapped_count; ++i)
+    if (regex.Execute(GetMappedName(i))) {
+      if (!callback(GetMappedDIERef(i)))
+        return false;
+    }
   for (const auto &entry : m_map)
     if (regex.Execute(entry.cstring.GetCString())) {
       if (!callback(entry.value))
@@ -51,20 +95,28 @@ void NameToDIE::FindAllEntriesForUnit(
     DWARFUnit &s_unit, llvm::function_ref<bool(DIERef ref)> callback) const {
   lldbassert(!s_unit.GetSymbolFileDWARF().GetDwoNum());
   const DWARFUnit &ns_unit = s_unit.GetNonSkeletonUnit();
+  auto in_unit = [&](const DIERef &die_ref) {
+    return ns_unit.GetSymbolFileDWARF().GetDwoNum() == die_ref.dwo_num() &&
+           ns_unit.GetDebugSection() == die_ref.section() &&
+           ns_unit.GetOffset() <= die_ref.die_offset() &&
+           die_ref.die_offset() < ns_unit.GetNextUnitOffset();
+  };
+  for (uint32_t i = 0; i < m_mapped_count; ++i) {
+    const DIERef die_ref = GetMappedDIERef(i);
+    if (in_unit(die_ref) && !callback(die_ref))
+      return;
+  }
   const uint32_t size = m_map.GetSize();
   for (uint32_t i = 0; i < size; ++i) {
     const DIERef &die_ref = m_map.GetValueAtIndexUnchecked(i);
-    if (ns_unit.GetSymbolFileDWARF().GetDwoNum() == die_ref.dwo_num() &&
-        ns_unit.GetDebugSection() == die_ref.section() &&
-        ns_unit.GetOffset() <= die_ref.die_offset() &&
-        die_ref.die_offset() < ns_unit.GetNextUnitOffset()) {
-      if (!callback(die_ref))
-        return;
-    }
+    if (in_unit(die_ref) && !callback(die_ref))
+      return;
   }
 }
 
 void NameToDIE::Dump(Stream *s) {
+  for (uint32_t i = 0; i < m_mapped_count; ++i)
+    s->Format("{0} \"{1}\"\n", GetMappedDIERef(i), GetMappedName(i));
   const uint32_t size = m_map.GetSize();
   for (uint32_t i = 0; i < size; ++i) {
     s->Format("{0} \"{1}\"\n", m_map.GetValueAtIndexUnchecked(i),
@@ -75,6 +127,10 @@ void NameToDIE::Dump(Stream *s) {
 void NameToDIE::ForEach(
     std::function<bool(ConstString name, const DIERef &die_ref)> const
         &callback) const {
+  for (uint32_t i = 0; i < m_mapped_count; ++i) {
+    if (!callback(ConstString(GetMappedName(i)), GetMappedDIERef(i)))
+      return;
+  }
   const uint32_t size = m_map.GetSize();
   for (uint32_t i = 0; i < size; ++i) {
     if (!callback(m_map.GetCStringAtIndexUnchecked(i),
@@ -84,6 +140,9 @@ void NameToDIE::ForEach(
 }
 
 void NameToDIE::Append(const NameToDIE &other) {
+  for (uint32_t i = 0; i < other.m_mapped_count; ++i)
+    m_map.Append(ConstString(other.GetMappedName(i)),
+                 other.GetMappedDIERef(i));
   const uint32_t size = other.m_map.GetSize();
   for (uint32_t i = 0; i < size; ++i) {
     m_map.Append(other.m_map.GetCStringAtIndexUnchecked(i),
@@ -91,60 +150,75 @@ void NameToDIE::Append(const NameToDIE &other) {
   }
 }
 
+void NameToDIE::AppendWithDwoNum(const NameToDIE &other, uint32_t dwo_num) {
+  other.ForEach([&](ConstString name, const DIERef &die_ref) {
+    assert(die_ref.dwo_num() && "entry is not from a .dwo file");
+    m_map.Append(name, DIERef(dwo_num, die_ref.section(), die_ref.die_offset()));
+    return true;
+  });
+}
+
+std::vector<std::pair<ConstString, DIERef>>
+NameToDIE::GetSortedEntries() const {
+  std::vector<std::pair<ConstString, DIERef>> entries;
+  entries.reserve(m_mapped_count + m_map.GetSize());
+  ForEach([&](ConstString name, const DIERef &die_ref) {
+    entries.emplace_back(name, die_ref);
+    return true;
+  });
+  llvm::sort(entries, [](const auto &lhs, const auto &rhs) {
+    if (lhs.first != rhs.first)
+      return lhs.first.GetStringRef() < rhs.first.GetStringRef();
+    return lhs.second < rhs.second;
+  });
+  return entries;
+}
+
 constexpr llvm::StringLiteral kIdentifierNameToDIE("N2DI");
 
 bool NameToDIE::Decode(const DataExtractor &data, lldb::offset_t *offset_ptr,
                        const StringTableReader &strtab) {
-  m_map.Clear();
+  Clear();
   llvm::StringRef identifier((const char *)data.GetData(offset_ptr, 4), 4);
   if (identifier != kIdentifierNameToDIE)
     return false;
   const uint32_t count = data.GetU32(offset_ptr);
-  m_map.Reserve(count);
+  const lldb::offset_t start = *offset_ptr;
+  if (!data.ValidOffsetForDataOfSize(start, uint64_t(count) * kEntrySize))
+    return false;
+  // Validate the table once so that lookups can decode entries unchecked. This
+  // is much cheaper than creating a ConstString for every name.
+  llvm::StringRef prev_name;
   for (uint32_t i = 0; i < count; ++i) {
     llvm::StringRef str(strtab.Get(data.GetU32(offset_ptr)));
     // No empty strings allowed in the name to DIE maps.
-    if (str.empty())
+    if (str.empty() || str < prev_name)
       return false;
-    if (llvm::Optional<DIERef> die_ref = DIERef::Decode(data, offset_ptr))
-      m_map.Append(ConstString(str), *die_ref);
-    else
+    if (!DIERef::Decode(data, offset_ptr))
       return false;
+    prev_name = str;
   }
-  // We must sort the UniqueCStringMap after decoding it since it is a vector
-  // of UniqueCStringMap::Entry objects which contain a ConstString and type T.
-  // ConstString objects are sorted by "const char *" and then type T and
-  // the "const char *" are point values that will depend on the order in which
-  // ConstString objects are created and in which of the 256 string pools they
-  // are created in. So after we decode all of the entries, we must sort the
-  // name map to ensure name lookups succeed. If we encode and decode within
-  // the same process we wouldn't need to sort, so unit testing didn't catch
-  // this issue when first checked in.
-  m_map.Sort(std::less<DIERef>());
+  m_mapped_data = data;
+  m_mapped_strtab = strtab;
+  m_mapped_start = start;
+  m_mapped_count = count;
   return true;
 }
 
 void NameToDIE::Encode(DataEncoder &encoder, ConstStringTable &strtab) const {
   encoder.AppendData(kIdentifierNameToDIE);
-  encoder.AppendU32(m_map.GetSize());
-  for (const auto &entry : m_map) {
+  // Entries are written sorted by name so that a decoded map can be searched
+  // in place.
+  std::vector<std::pair<ConstString, DIERef>> entries = GetSortedEntries();
+  encoder.AppendU32(entries.size());
+  for (const auto &entry : entries) {
     // Make sure there are no empty strings.
-    assert((bool)entry.cstring);
-    encoder.AppendU32(strtab.Add(entry.cstring));
-    entry.value.Encode(encoder);
+    assert((bool)entry.first);
+    encoder.AppendU32(strtab.Add(entry.first));
+    entry.second.Encode(encoder);
   }
 }
 
 bool NameToDIE::operator==(const NameToDIE &rhs) const {
-  const size_t size = m_map.GetSize();
-  if (size != rhs.m_map.GetSize())
-    return false;
-  for (size_t i = 0; i < size; ++i) {
-    if (m_map.GetCStringAtIndex(i) != rhs.m_map.GetCStringAtIndex(i))
-      return false;
-    if (m_map.GetValueRefAtIndexUnchecked(i) !=
-        rhs.m_map.GetValueRefAtIndexUnchecked(i))
-      return false;
-  }
-  return true;
+  return GetSortedEntries() == rhs.GetSortedEntries();
 }
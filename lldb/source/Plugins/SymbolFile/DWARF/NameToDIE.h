@@ -12,8 +12,10 @@
 #include <functional>
 
 #include "DIERef.h"
+#include "lldb/Core/DataFileCache.h"
 #include "lldb/Core/UniqueCStringMap.h"
 #include "lldb/Core/dwarf.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/lldb-defines.h"
 
 class DWARFUnit;
@@ -30,6 +32,10 @@ public:
 
   void Append(const NameToDIE &other);
 
+  /// Append the entries of \a other, which must all refer to DIEs in a single
+  /// .dwo file, rewritten to refer to the .dwo file with number \a dwo_num.
+  void AppendWithDwoNum(const NameToDIE &other, uint32_t dwo_num);
+
   void Finalize();
 
   bool Find(lldb_private::ConstString name,
@@ -50,6 +56,10 @@ public:
 
   /// Decode a serialized version of this object from data.
   ///
+  /// The entries are not copied: lookups binary search the sorted table in
+  /// \a data directly, so the bytes \a data and \a strtab refer to must
+  /// outlive this object or the next call to Clear().
+  ///
   /// \param data
   ///   The decoder object that references the serialized data.
   ///
@@ -82,12 +92,28 @@ public:
   /// Used for unit testing the encoding and decoding.
   bool operator==(const NameToDIE &rhs) const;
 
-  bool IsEmpty() const { return m_map.IsEmpty(); }
+  bool IsEmpty() const { return m_map.IsEmpty() && m_mapped_count == 0; }
 
-  void Clear() { m_map.Clear(); }
+  void Clear();
 
 protected:
+  /// Return the entries sorted by name and then by DIERef, which is the order
+  /// in which they are encoded.
+  std::vector<std::pair<lldb_private::ConstString, DIERef>>
+  GetSortedEntries() const;
+
+  llvm::StringRef GetMappedName(uint32_t idx) const;
+  DIERef GetMappedDIERef(uint32_t idx) const;
+
   lldb_private::UniqueCStringMap<DIERef> m_map;
+
+  /// A decoded table, m_mapped_count records of a string table offset
+  /// followed by an encoded DIERef starting at m_mapped_start in
+  /// m_mapped_data, sorted by name.
+  lldb_private::DataExtractor m_mapped_data;
+  lldb_private::StringTableReader m_mapped_strtab;
+  lldb::offset_t m_mapped_start = 0;
+  uint32_t m_mapped_count = 0;
 };
 
 #endif // LLDB_SOURCE_PLUGINS_SYMBOLFILE_DWARF_NAMETODIE_H
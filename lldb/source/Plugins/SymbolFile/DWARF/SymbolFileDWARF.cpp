@@ -13,6 +13,7 @@
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/Threading.h"
 
+#include "lldb/Core/Debugger.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/ModuleList.h"
 #include "lldb/Core/ModuleSpec.h"
@@ -78,6 +79,7 @@
 #include "llvm/DebugInfo/DWARF/DWARFContext.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/ThreadPool.h"
 
 #include <algorithm>
 #include <map>
@@ -3188,6 +3190,7 @@ size_t SymbolFileDWARF::ParseVariablesForContext(const SymbolContext &sc) {
               /*check_hi_lo_pc=*/true))
         func_lo_pc = ranges.GetMinRangeBase(0);
       if (func_lo_pc != LLDB_INVALID_ADDRESS) {
+        PrefetchVariableTypeUnits(function_die);
         const size_t num_variables =
             ParseVariablesInFunctionContext(sc, function_die, func_lo_pc);
 
@@ -3759,6 +3762,49 @@ SymbolFileDWARF::MergeBlockAbstractParameters(const DWARFDIE &block_die,
   return merged;
 }
 
+void SymbolFileDWARF::PrefetchVariableTypeUnits(const DWARFDIE &function_die) {
+  llvm::SetVector<DWARFUnit *> units;
+  std::vector<DWARFDIE> worklist{function_die};
+  while (!worklist.empty()) {
+    DWARFDIE die = worklist.back();
+    worklist.pop_back();
+    for (DWARFDIE child : die.children())
+      worklist.push_back(child);
+
+    const dw_tag_t tag = die.Tag();
+    if (tag != DW_TAG_variable && tag != DW_TAG_constant &&
+        tag != DW_TAG_formal_parameter)
+      continue;
+
+    // Follow typedefs and type modifiers within the unit, which has its DIEs
+    // extracted already, to the first type that lives in another unit.
+    DWARFDIE type_die = die;
+    for (int depth = 0; type_die && depth < 8; ++depth) {
+      DWARFFormValue form_value;
+      if (!type_die.GetDIE()->GetAttributeValue(
+              type_die.GetCU(), DW_AT_type, form_value, nullptr,
+              /*check_specification_or_abstract_origin=*/true))
+        break;
+      DWARFUnit *unit = form_value.ReferencedUnit();
+      if (!unit)
+        break;
+      if (unit != form_value.GetUnit()) {
+        units.insert(unit);
+        break;
+      }
+      type_die = form_value.Reference();
+    }
+  }
+
+  // A single unit gains nothing from being extracted ahead of time.
+  if (units.size() < 2)
+    return;
+  llvm::ThreadPoolTaskGroup task_group(Debugger::GetThreadPool());
+  for (DWARFUnit *unit : units)
+    task_group.async([unit] { unit->ExtractDIEsIfNeeded(); });
+  task_group.wait();
+}
+
 size_t SymbolFileDWARF::ParseVariablesInFunctionContext(
     const SymbolContext &sc, const DWARFDIE &die,
     const lldb::addr_t func_low_pc) {
@@ -399,6 +399,12 @@ protected:
                                const DWARFDIE &die,
                                lldb_private::VariableList &cc_variable_list);
 
+  /// Extract, in parallel, the DIEs of the other units that the types of the
+  /// variables in \a function_die are defined in, such as type units. The
+  /// types themselves are still parsed lazily and serially, but parsing no
+  /// longer stops to extract each of those units in turn.
+  void PrefetchVariableTypeUnits(const DWARFDIE &function_die);
+
   size_t ParseVariablesInFunctionContext(const lldb_private::SymbolContext &sc,
                                          const DWARFDIE &die,
                                          const lldb::addr_t func_low_pc);
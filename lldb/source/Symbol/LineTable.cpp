@@ -26,6 +26,13 @@ LineTable::LineTable(CompileUnit *comp_unit,
     : m_comp_unit(comp_unit), m_entries() {
   LineTable::Entry::LessThanBinaryPredicate less_than_bp(this);
   llvm::stable_sort(sequences, less_than_bp);
+  // Line tables live as long as their compile unit, so size the collection
+  // exactly instead of letting it grow geometrically.
+  size_t num_entries = 0;
+  for (const auto &sequence : sequences)
+    num_entries +=
+        static_cast<LineSequenceImpl *>(sequence.get())->m_entries.size();
+  m_entries.reserve(num_entries);
   for (const auto &sequence : sequences) {
     LineSequenceImpl *seq = static_cast<LineSequenceImpl *>(sequence.get());
     m_entries.insert(m_entries.end(), seq->m_entries.begin(),
@@ -308,8 +315,7 @@ uint32_t LineTable::FindLineEntryIndexByFileIndex(
   auto file_idx_matcher = [](uint32_t file_index, uint16_t entry_file_idx) {
     return file_index == entry_file_idx;
   };
-  return FindLineEntryIndexByFileIndexImpl<uint32_t>(
-
+  return FindLineEntryIndexByFileIndexImpl(
       start_idx, file_idx, src_location_spec, line_entry_ptr, file_idx_matcher);
 }
 
@@ -321,7 +327,7 @@ uint32_t LineTable::FindLineEntryIndexByFileIndex(
     return llvm::is_contained(file_indexes, entry_file_idx);
   };
 
-  return FindLineEntryIndexByFileIndexImpl<std::vector<uint32_t>>(
+  return FindLineEntryIndexByFileIndexImpl(
       start_idx, file_idx, src_location_spec, line_entry_ptr, file_idx_matcher);
 }
 
@@ -494,5 +500,7 @@ LineTable *LineTable::LinkLineTable(const FileRangeMap &file_range_map) {
   }
   if (line_table_up->m_entries.empty())
     return nullptr;
+  // The linked table was built by inserting one sequence at a time.
+  line_table_up->m_entries.shrink_to_fit();
   return line_table_up.release();
 }
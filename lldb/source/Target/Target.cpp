@@ -200,6 +200,12 @@ void Target::DeleteCurrentProcess() {
 
     CleanupProcess();
 
+    {
+      // The cached expressions are bound to the process they were JITted in.
+      std::lock_guard<std::mutex> guard(m_user_expression_cache_mutex);
+      m_user_expression_cache.clear();
+    }
+
     m_process_sp.reset();
   }
 }
@@ -1645,6 +1651,10 @@ void Target::NotifyModulesRemoved(lldb_private::ModuleList &module_list) {
 void Target::ModulesDidLoad(ModuleList &module_list) {
   const size_t num_images = module_list.GetSize();
   if (m_valid && num_images) {
+    // Dynamic loaders report all the libraries that were loaded by one event
+    // at once, so their symbols can be preloaded in parallel.
+    if (GetPreloadSymbols())
+      module_list.PreloadSymbols(&GetDebugger());
     for (size_t idx = 0; idx < num_images; ++idx) {
       ModuleSP module_sp(module_list.GetModuleAtIndex(idx));
       LoadScriptingResourceForModule(module_sp, this);
@@ -2201,11 +2211,6 @@ ModuleSP Target::GetOrCreateModule(const ModuleSpec &module_spec, bool notify,
           });
         }
 
-        // Preload symbols outside of any lock, so hopefully we can do this for
-        // each library in parallel.
-        if (GetPreloadSymbols())
-          module_sp->PreloadSymbols();
-
         llvm::SmallVector<ModuleSP, 1> replaced_modules;
         for (ModuleSP &old_module_sp : old_modules) {
           if (m_images.GetIndexForModule(old_module_sp.get()) !=
@@ -2418,6 +2423,40 @@ UserExpression *Target::GetUserExpressionForLanguage(
   return user_expr;
 }
 
+lldb::UserExpressionSP
+Target::GetCachedUserExpression(llvm::StringRef key,
+                                ExecutionContext &exe_ctx) {
+  std::lock_guard<std::mutex> guard(m_user_expression_cache_mutex);
+  for (auto it = m_user_expression_cache.rbegin(),
+            end = m_user_expression_cache.rend();
+       it != end; ++it) {
+    if (it->first != key)
+      continue;
+    // The expression was parsed for one process and frame location; its
+    // variable lookups are only valid there.
+    if (!it->second->MatchesContext(exe_ctx))
+      continue;
+    lldb::UserExpressionSP expr_sp = it->second;
+    // Move the entry to the most recently used end.
+    std::rotate(std::prev(it.base()), it.base(), m_user_expression_cache.end());
+    return expr_sp;
+  }
+  return nullptr;
+}
+
+void Target::CacheUserExpression(llvm::StringRef key,
+                                 const lldb::UserExpressionSP &expr_sp) {
+  const uint64_t max_size = GetExpressionCacheSize();
+  std::lock_guard<std::mutex> guard(m_user_expression_cache_mutex);
+  if (max_size == 0) {
+    m_user_expression_cache.clear();
+    return;
+  }
+  while (m_user_expression_cache.size() >= max_size)
+    m_user_expression_cache.erase(m_user_expression_cache.begin());
+  m_user_expression_cache.emplace_back(key.str(), expr_sp);
+}
+
 FunctionCaller *Target::GetFunctionCallerForLanguage(
     lldb::LanguageType language, const CompilerType &return_type,
     const Address &function_address, const ValueList &arg_value_list,
@@ -4401,6 +4440,12 @@ bool TargetProperties::GetEnableAutoApplyFixIts() const {
       nullptr, idx, g_target_properties[idx].default_uint_value != 0);
 }
 
+uint64_t TargetProperties::GetExpressionCacheSize() const {
+  const uint32_t idx = ePropertyExpressionCacheSize;
+  return m_collection_sp->GetPropertyAtIndexAsUInt64(
+      nullptr, idx, g_target_properties[idx].default_uint_value);
+}
+
 uint64_t TargetProperties::GetNumberOfRetriesWithFixits() const {
   const uint32_t idx = ePropertyRetriesWithFixIts;
   return m_collection_sp->GetPropertyAtIndexAsUInt64(
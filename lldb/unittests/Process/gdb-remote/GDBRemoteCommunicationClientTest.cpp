@@ -591,3 +591,26 @@ TEST_F(GDBRemoteCommunicationClientTest, WriteMemoryTags) {
                  std::vector<uint8_t>{0x99}, "QMemTags:456789,0:80000000:99",
                  "E03", false);
 }
+
+TEST_F(GDBRemoteCommunicationClientTest, MultiMemRead) {
+  std::vector<std::pair<addr_t, size_t>> ranges = {
+      {0x1000, 4}, {0x2000, 2}, {0x3000, 3}};
+  auto read_ranges = [&] { return client.MultiMemRead(ranges); };
+  std::future<Expected<std::vector<std::string>>> result =
+      std::async(std::launch::async, read_ranges);
+
+  // The second range comes back empty, the third one short.
+  HandlePacket(server, "MultiMemRead:ranges:1000,4,2000,2,3000,3;",
+               "4,0,1;abcdz");
+  Expected<std::vector<std::string>> read = result.get();
+  ASSERT_THAT_EXPECTED(read, llvm::Succeeded());
+  EXPECT_THAT(*read, testing::ElementsAre("abcd", "", "z"));
+
+  result = std::async(std::launch::async, read_ranges);
+  HandlePacket(server, testing::_, "4,0;abcd");
+  EXPECT_THAT_EXPECTED(result.get(), llvm::Failed());
+
+  result = std::async(std::launch::async, read_ranges);
+  HandlePacket(server, testing::_, "E03");
+  EXPECT_THAT_EXPECTED(result.get(), llvm::Failed());
+}
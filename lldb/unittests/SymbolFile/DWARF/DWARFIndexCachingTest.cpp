@@ -88,6 +88,67 @@ TEST(DWARFIndexCachingTest, NameToDIEEncodeDecode) {
   EncodeDecode(map);
 }
 
+TEST(DWARFIndexCachingTest, NameToDIEDecodedLookup) {
+  NameToDIE map;
+  const DIERef a1(llvm::None, DIERef::Section::DebugInfo, 0x10);
+  const DIERef a2(llvm::None, DIERef::Section::DebugInfo, 0x20);
+  const DIERef b(llvm::None, DIERef::Section::DebugInfo, 0x30);
+  const DIERef c(7, DIERef::Section::DebugTypes, 0x40);
+  map.Insert(ConstString("zeta"), c);
+  map.Insert(ConstString("alpha"), a2);
+  map.Insert(ConstString("beta"), b);
+  map.Insert(ConstString("alpha"), a1);
+  map.Finalize();
+
+  const uint8_t addr_size = 8;
+  DataEncoder encoder(eByteOrderLittle, addr_size);
+  DataEncoder strtab_encoder(eByteOrderLittle, addr_size);
+  ConstStringTable const_strtab;
+  map.Encode(encoder, const_strtab);
+  const_strtab.Encode(strtab_encoder);
+  llvm::ArrayRef<uint8_t> bytes = encoder.GetData();
+  llvm::ArrayRef<uint8_t> strtab_bytes = strtab_encoder.GetData();
+  DataExtractor data(bytes.data(), bytes.size(), eByteOrderLittle, addr_size);
+  DataExtractor strtab_data(strtab_bytes.data(), strtab_bytes.size(),
+                            eByteOrderLittle, addr_size);
+  StringTableReader strtab_reader;
+  offset_t offset = 0;
+  ASSERT_TRUE(strtab_reader.Decode(strtab_data, &offset));
+  NameToDIE decoded;
+  offset = 0;
+  ASSERT_TRUE(decoded.Decode(data, &offset, strtab_reader));
+
+  auto find = [&](const char *name) {
+    std::vector<DIERef> refs;
+    decoded.Find(ConstString(name), [&](DIERef ref) {
+      refs.push_back(ref);
+      return true;
+    });
+    return refs;
+  };
+  EXPECT_THAT(find("alpha"), testing::ElementsAre(a1, a2));
+  EXPECT_THAT(find("beta"), testing::ElementsAre(b));
+  EXPECT_THAT(find("zeta"), testing::ElementsAre(c));
+  EXPECT_THAT(find("gamma"), testing::IsEmpty());
+  EXPECT_THAT(find("aaa"), testing::IsEmpty());
+  EXPECT_THAT(find("zzz"), testing::IsEmpty());
+
+  // Appending a decoded .dwo index rewrites the .dwo file number.
+  NameToDIE rebound;
+  NameToDIE dwo_only;
+  dwo_only.Insert(ConstString("zeta"), c);
+  dwo_only.Finalize();
+  rebound.AppendWithDwoNum(dwo_only, 3);
+  rebound.Finalize();
+  std::vector<DIERef> refs;
+  rebound.Find(ConstString("zeta"), [&](DIERef ref) {
+    refs.push_back(ref);
+    return true;
+  });
+  EXPECT_THAT(refs, testing::ElementsAre(
+                        DIERef(3, DIERef::Section::DebugTypes, 0x40)));
+}
+
 static void EncodeDecode(const ManualDWARFIndex::IndexSet &object,
                          ByteOrder byte_order) {
   const uint8_t addr_size = 8;
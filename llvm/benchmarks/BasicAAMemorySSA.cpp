@@ -0,0 +1,117 @@
+#include "benchmark/benchmark.h"
+#include "llvm/Analysis/AliasAnalysis.h"
+#include "llvm/Analysis/AssumptionCache.h"
+#include "llvm/Analysis/BasicAliasAnalysis.h"
+#include "llvm/Analysis/MemoryLocation.h"
+#include "llvm/Analysis/MemorySSA.h"
+#include "llvm/Analysis/TargetLibraryInfo.h"
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/IR/Dominators.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+using namespace llvm;
+
+// Build a straight-line function with the given number of stores and loads
+// through GEPs of two pointer arguments, like generated code that fills and
+// reads back large structures.
+static std::string buildMemoryOps(unsigned NumOps) {
+  std::string IR;
+  raw_string_ostream OS(IR);
+  OS << "define i64 @ops(ptr %p, ptr %q, i64 %n) {\n"
+     << "entry:\n"
+     << "  %acc0 = add i64 %n, 0\n";
+  for (unsigned I = 0; I != NumOps; ++I) {
+    const char *Base = I % 2 ? "%q" : "%p";
+    OS << "  %i" << I << " = add nsw i64 %n, " << I << "\n"
+       << "  %g" << I << " = getelementptr inbounds i64, ptr " << Base
+       << ", i64 %i" << I << "\n"
+       << "  store i64 %acc" << I << ", ptr %g" << I << "\n"
+       << "  %l" << I << " = load i64, ptr %g" << I / 2 << "\n"
+       << "  %acc" << I + 1 << " = add i64 %acc" << I << ", %l" << I << "\n";
+  }
+  OS << "  ret i64 %acc" << NumOps << "\n"
+     << "}\n";
+  return OS.str();
+}
+
+namespace {
+struct MemoryOps {
+  LLVMContext Context;
+  std::unique_ptr<Module> M;
+  Function *F;
+  TargetLibraryInfoImpl TLII;
+  TargetLibraryInfo TLI;
+  std::unique_ptr<AssumptionCache> AC;
+  std::unique_ptr<DominatorTree> DT;
+  std::unique_ptr<BasicAAResult> BAR;
+  std::unique_ptr<AAResults> AA;
+
+  MemoryOps(unsigned NumOps) : TLI(TLII) {
+    SMDiagnostic Err;
+    M = parseAssemblyString(buildMemoryOps(NumOps), Err, Context);
+    if (!M) {
+      Err.print("BasicAAMemorySSA", errs());
+      std::abort();
+    }
+    F = M->getFunction("ops");
+    AC = std::make_unique<AssumptionCache>(*F);
+    DT = std::make_unique<DominatorTree>(*F);
+    BAR = std::make_unique<BasicAAResult>(M->getDataLayout(), *F, TLI, *AC,
+                                          DT.get());
+    AA = std::make_unique<AAResults>(TLI);
+    AA->addAAResult(*BAR);
+  }
+};
+} // namespace
+
+// Build MemorySSA and optimize all uses, which queries BasicAA in batch mode.
+static void BM_BuildMemorySSA(benchmark::State &State) {
+  MemoryOps Ops(State.range(0));
+  for (auto _ : State) {
+    MemorySSA MSSA(*Ops.F, Ops.AA.get(), Ops.DT.get());
+    MSSA.ensureOptimizedUses();
+    benchmark::DoNotOptimize(MSSA.getLiveOnEntryDef());
+  }
+}
+BENCHMARK(BM_BuildMemorySSA)->Arg(1000)->Arg(10000);
+
+// Query the location of every store against all other stores, once with a
+// single batch and once with a fresh AAQueryInfo for each query.
+static void BM_AliasOneToMany(benchmark::State &State) {
+  MemoryOps Ops(State.range(0));
+  SmallVector<MemoryLocation, 0> Locs;
+  for (Instruction &I : instructions(*Ops.F))
+    if (isa<StoreInst>(I))
+      Locs.push_back(MemoryLocation::get(&I));
+  bool Batch = State.range(1);
+  SmallVector<AliasResult, 0> Results;
+  for (auto _ : State) {
+    BatchAAResults BatchAA(*Ops.AA);
+    for (const MemoryLocation &Loc : Locs) {
+      Results.clear();
+      if (Batch) {
+        BatchAA.alias(Loc, Locs, Results);
+      } else {
+        for (const MemoryLocation &Other : Locs)
+          Results.push_back(Ops.AA->alias(Loc, Other));
+      }
+      benchmark::DoNotOptimize(Results.data());
+    }
+  }
+}
+BENCHMARK(BM_AliasOneToMany)
+    ->Args({100, 0})
+    ->Args({100, 1})
+    ->Args({1000, 0})
+    ->Args({1000, 1});
+
+BENCHMARK_MAIN();
@@ -0,0 +1,89 @@
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/FlatHashMap.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace llvm;
+
+template <typename KeyT> static KeyT makeKey(uint64_t Random);
+
+// Keys that look like the pointers clang, lld and opt use as map keys: aligned
+// addresses spread over a heap-sized range.
+template <> void *makeKey<void *>(uint64_t Random) {
+  return reinterpret_cast<void *>((Random & 0xffffffffffULL) << 4);
+}
+
+// Stay clear of the empty and tombstone keys of DenseMapInfo<unsigned>.
+template <> uint32_t makeKey<uint32_t>(uint64_t Random) {
+  return uint32_t(Random) >> 2;
+}
+
+template <typename KeyT>
+static std::vector<KeyT> makeKeys(size_t N, unsigned Seed) {
+  std::mt19937_64 Rng(Seed);
+  std::vector<KeyT> Keys(N);
+  for (KeyT &K : Keys)
+    K = makeKey<KeyT>(Rng());
+  return Keys;
+}
+
+template <typename MapT> static void insertKeys(benchmark::State &State) {
+  auto Keys = makeKeys<typename MapT::key_type>(State.range(0), 1);
+  for (auto _ : State) {
+    MapT Map;
+    for (const auto &K : Keys)
+      Map[K] = 1;
+    benchmark::DoNotOptimize(Map.size());
+  }
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+
+// Look up keys that are all in the map.
+template <typename MapT> static void findHits(benchmark::State &State) {
+  auto Keys = makeKeys<typename MapT::key_type>(State.range(0), 1);
+  MapT Map;
+  for (const auto &K : Keys)
+    Map[K] = 1;
+  std::shuffle(Keys.begin(), Keys.end(), std::mt19937(2));
+  for (auto _ : State)
+    for (const auto &K : Keys)
+      benchmark::DoNotOptimize(Map.find(K));
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+
+// Look up keys that are not in the map, like the many failed lookups of
+// uniquing tables.
+template <typename MapT> static void findMisses(benchmark::State &State) {
+  MapT Map;
+  for (const auto &K : makeKeys<typename MapT::key_type>(State.range(0), 1))
+    Map[K] = 1;
+  auto Keys = makeKeys<typename MapT::key_type>(State.range(0), 3);
+  for (auto _ : State)
+    for (const auto &K : Keys)
+      benchmark::DoNotOptimize(Map.find(K));
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+
+using DensePtrMap = DenseMap<void *, int>;
+using FlatPtrMap = FlatHashMap<void *, int>;
+using DenseIntMap = DenseMap<uint32_t, int>;
+using FlatIntMap = FlatHashMap<uint32_t, int>;
+
+BENCHMARK_TEMPLATE(insertKeys, DensePtrMap)->Range(64, 1 << 20);
+BENCHMARK_TEMPLATE(insertKeys, FlatPtrMap)->Range(64, 1 << 20);
+BENCHMARK_TEMPLATE(insertKeys, DenseIntMap)->Range(64, 1 << 20);
+BENCHMARK_TEMPLATE(insertKeys, FlatIntMap)->Range(64, 1 << 20);
+BENCHMARK_TEMPLATE(findHits, DensePtrMap)->Range(64, 1 << 20);
+BENCHMARK_TEMPLATE(findHits, FlatPtrMap)->Range(64, 1 << 20);
+BENCHMARK_TEMPLATE(findHits, DenseIntMap)->Range(64, 1 << 20);
+BENCHMARK_TEMPLATE(findHits, FlatIntMap)->Range(64, 1 << 20);
+BENCHMARK_TEMPLATE(findMisses, DensePtrMap)->Range(64, 1 << 20);
+BENCHMARK_TEMPLATE(findMisses, FlatPtrMap)->Range(64, 1 << 20);
+BENCHMARK_TEMPLATE(findMisses, DenseIntMap)->Range(64, 1 << 20);
+BENCHMARK_TEMPLATE(findMisses, FlatIntMap)->Range(64, 1 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,140 @@
+//===- IRMemory.cpp - Memory footprint of in-memory IR --------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Loads IR and reports how much memory it takes, and how much of that is
+// taken by operands (Use) and by the use-lists of constants. Without inputs,
+// this loads a generated module. LTO-sized bitcode makes a better corpus:
+//
+//   IRMemory merged.bc --benchmark_repetitions=3
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/Use.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+static std::vector<std::string> Inputs;
+
+// Generate functions with the mix of instructions that optimized C code
+// tends to have.
+static std::string generateModule() {
+  std::string IR;
+  raw_string_ostream OS(IR);
+  const unsigned NumFunctions = 2000, NumBlocks = 8;
+  OS << "@g = global [64 x i64] zeroinitializer\n";
+  for (unsigned F = 0; F != NumFunctions; ++F) {
+    OS << "define i64 @f" << F << "(ptr %p, i64 %n) {\n"
+       << "entry:\n"
+       << "  br label %b0\n";
+    for (unsigned B = 0; B != NumBlocks; ++B) {
+      OS << "b" << B << ":\n"
+         << "  %i" << B << " = getelementptr inbounds i64, ptr %p, i64 " << B
+         << "\n"
+         << "  %l" << B << " = load i64, ptr %i" << B << ", align 8\n"
+         << "  %a" << B << " = add nsw i64 %l" << B << ", " << F << "\n"
+         << "  %m" << B << " = mul i64 %a" << B << ", 3\n"
+         << "  %c" << B << " = icmp slt i64 %m" << B << ", %n\n"
+         << "  %s" << B << " = select i1 %c" << B << ", i64 %m" << B
+         << ", i64 0\n"
+         << "  store i64 %s" << B << ", ptr @g, align 8\n";
+      if (B + 1 != NumBlocks)
+        OS << "  br i1 %c" << B << ", label %b" << B + 1 << ", label %exit\n";
+      else
+        OS << "  br label %exit\n";
+    }
+    OS << "exit:\n"
+       << "  ret i64 0\n"
+       << "}\n";
+  }
+  return OS.str();
+}
+
+static void loadIR(benchmark::State &State) {
+  std::vector<std::unique_ptr<MemoryBuffer>> Buffers;
+  if (Inputs.empty()) {
+    Buffers.push_back(
+        MemoryBuffer::getMemBufferCopy(generateModule(), "<generated>"));
+  } else {
+    for (const std::string &Input : Inputs) {
+      auto Buffer = MemoryBuffer::getFile(Input);
+      if (!Buffer) {
+        State.SkipWithError(("can't read " + Input).c_str());
+        return;
+      }
+      Buffers.push_back(std::move(*Buffer));
+    }
+  }
+
+  size_t Bytes = 0, NumInsts = 0, NumUses = 0, NumConstantDataUses = 0;
+  for (auto _ : State) {
+    LLVMContext Context;
+    std::vector<std::unique_ptr<Module>> Modules;
+    size_t Before = sys::Process::GetMallocUsage();
+    for (const auto &Buffer : Buffers) {
+      SMDiagnostic Err;
+      Modules.push_back(parseIR(Buffer->getMemBufferRef(), Err, Context));
+      if (!Modules.back()) {
+        State.SkipWithError("can't parse the input");
+        return;
+      }
+    }
+    Bytes = sys::Process::GetMallocUsage() - Before;
+
+    State.PauseTiming();
+    NumInsts = NumUses = NumConstantDataUses = 0;
+    for (const auto &M : Modules) {
+      for (const Function &F : *M) {
+        for (const Instruction &I : instructions(F)) {
+          ++NumInsts;
+          NumUses += I.getNumOperands();
+          for (const Use &U : I.operands())
+            if (isa<ConstantData>(U.get()))
+              ++NumConstantDataUses;
+        }
+      }
+    }
+    State.ResumeTiming();
+  }
+
+  State.counters["bytes"] = Bytes;
+  State.counters["insts"] = NumInsts;
+  State.counters["uses"] = NumUses;
+  // Operands make up this much of the IR...
+  State.counters["use_bytes"] = NumUses * sizeof(Use);
+  // ...and this many of them link into the use-list of a ConstantData, such
+  // as i32 0, whose use-lists are rarely walked.
+  State.counters["constant_data_uses"] = NumConstantDataUses;
+}
+BENCHMARK(loadIR)->Unit(benchmark::kMillisecond);
+
+int main(int argc, char *argv[]) {
+  // Input files come first, then the options of the benchmark library.
+  int FirstOption = 1;
+  for (; FirstOption < argc && !StringRef(argv[FirstOption]).startswith("--");
+       ++FirstOption)
+    Inputs.push_back(argv[FirstOption]);
+  argv[FirstOption - 1] = argv[0];
+  argc -= FirstOption - 1;
+  argv += FirstOption - 1;
+  ::benchmark::Initialize(&argc, argv);
+  ::benchmark::RunSpecifiedBenchmarks();
+}
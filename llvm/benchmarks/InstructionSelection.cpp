@@ -0,0 +1,151 @@
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/LegacyPassManager.h"
+#include "llvm/IR/Module.h"
+#include "llvm/MC/TargetRegistry.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Host.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Target/TargetMachine.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+
+#include <memory>
+#include <string>
+
+using namespace llvm;
+
+// Build a function in the style of a bytecode interpreter: a large entry
+// block, followed by a switch with the given number of small cases.
+static std::string buildSwitch(unsigned NumCases) {
+  std::string IR;
+  raw_string_ostream OS(IR);
+  OS << "define i64 @dispatch(ptr %p, i64 %op, i64 %a) {\n"
+     << "entry:\n"
+     << "  %e0 = add i64 %a, 1\n";
+  for (unsigned I = 1; I != 4 * NumCases; ++I)
+    OS << "  %e" << I << " = " << (I % 3 ? "xor" : "mul") << " i64 %e"
+       << I - 1 << ", " << I << "\n";
+  OS << "  switch i64 %op, label %exit [\n";
+  for (unsigned I = 0; I != NumCases; ++I)
+    OS << "    i64 " << I << ", label %case" << I << "\n";
+  OS << "  ]\n";
+  for (unsigned I = 0; I != NumCases; ++I)
+    OS << "case" << I << ":\n"
+       << "  %g" << I << " = getelementptr i64, ptr %p, i64 " << I << "\n"
+       << "  %l" << I << " = load i64, ptr %g" << I << "\n"
+       << "  %r" << I << " = add i64 %l" << I << ", %e" << I << "\n"
+       << "  store i64 %r" << I << ", ptr %g" << I << "\n"
+       << "  br label %exit\n";
+  OS << "exit:\n"
+     << "  %v = phi i64 [ 0, %entry ]";
+  for (unsigned I = 0; I != NumCases; ++I)
+    OS << ", [ %r" << I << ", %case" << I << " ]";
+  OS << "\n"
+     << "  ret i64 %v\n"
+     << "}\n";
+  return OS.str();
+}
+
+static std::unique_ptr<TargetMachine>
+createHostTargetMachine(CodeGenOpt::Level OptLevel, std::string &Error) {
+  InitializeNativeTarget();
+  InitializeNativeTargetAsmPrinter();
+  std::string TripleName = sys::getProcessTriple();
+  const Target *T = TargetRegistry::lookupTarget(TripleName, Error);
+  if (!T)
+    return nullptr;
+  return std::unique_ptr<TargetMachine>(T->createTargetMachine(
+      TripleName, "", "", TargetOptions(), None, None, OptLevel));
+}
+
+// Generate an object file for a switch with State.range(0) cases on each
+// iteration, and report the throughput in IR instructions per second.
+static void runCodeGen(benchmark::State &State, TargetMachine &TM) {
+  LLVMContext Context;
+  SMDiagnostic Err;
+  std::unique_ptr<Module> M =
+      parseAssemblyString(buildSwitch(State.range(0)), Err, Context);
+  if (!M) {
+    State.SkipWithError("can't parse the generated module");
+    return;
+  }
+  M->setDataLayout(TM.createDataLayout());
+  M->setTargetTriple(TM.getTargetTriple().str());
+  size_t NumInsts = M->getInstructionCount();
+
+  for (auto _ : State) {
+    State.PauseTiming();
+    std::unique_ptr<Module> Clone = CloneModule(*M);
+    SmallString<0> Object;
+    raw_svector_ostream OS(Object);
+    legacy::PassManager PM;
+    if (TM.addPassesToEmitFile(PM, OS, nullptr, CGFT_ObjectFile)) {
+      State.SkipWithError("target can't emit object files");
+      return;
+    }
+    State.ResumeTiming();
+    PM.run(*Clone);
+    benchmark::DoNotOptimize(Object.size());
+  }
+  State.counters["insts"] = benchmark::Counter(
+      State.iterations() * NumInsts, benchmark::Counter::kIsRate);
+}
+
+// Optimized codegen, which is dominated by building, combining and selecting
+// the DAGs of the blocks.
+static void BM_SelectSwitch(benchmark::State &State) {
+  std::string Error;
+  std::unique_ptr<TargetMachine> TM =
+      createHostTargetMachine(CodeGenOpt::Default, Error);
+  if (!TM) {
+    State.SkipWithError(Error.c_str());
+    return;
+  }
+  runCodeGen(State, *TM);
+}
+BENCHMARK(BM_SelectSwitch)
+    ->Arg(256)
+    ->Arg(1024)
+    ->Arg(4096)
+    ->Unit(benchmark::kMillisecond);
+
+enum class Selector { FastISel, SelectionDAG, GlobalISel };
+
+// -O0 codegen with each of the instruction selectors. Functions that
+// GlobalISel can't handle fall back to SelectionDAG, as with
+// -global-isel-abort=2.
+static void BM_SelectO0(benchmark::State &State, Selector Sel) {
+  std::string Error;
+  std::unique_ptr<TargetMachine> TM =
+      createHostTargetMachine(CodeGenOpt::None, Error);
+  if (!TM) {
+    State.SkipWithError(Error.c_str());
+    return;
+  }
+  // TargetPassConfig picks FastISel at -O0 unless -fast-isel=false is given.
+  cl::Option *FastISel = cl::getRegisteredOptions().lookup("fast-isel");
+  if (!FastISel) {
+    State.SkipWithError("no -fast-isel option");
+    return;
+  }
+  FastISel->addOccurrence(0, "fast-isel",
+                          Sel == Selector::FastISel ? "true" : "false");
+  TM->setGlobalISel(Sel == Selector::GlobalISel);
+  TM->setGlobalISelAbort(GlobalISelAbortMode::Disable);
+  runCodeGen(State, *TM);
+}
+BENCHMARK_CAPTURE(BM_SelectO0, FastISel, Selector::FastISel)
+    ->Arg(1024)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_SelectO0, SelectionDAG, Selector::SelectionDAG)
+    ->Arg(1024)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_SelectO0, GlobalISel, Selector::GlobalISel)
+    ->Arg(1024)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
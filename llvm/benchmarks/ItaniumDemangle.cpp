@@ -0,0 +1,50 @@
+#include "benchmark/benchmark.h"
+#include "llvm/Demangle/Demangle.h"
+
+#include <cstdlib>
+
+using namespace llvm;
+
+// A mix of the names a symbolizer sees: short C++ functions, long template
+// instantiations, and special names.
+static const char *const Names[] = {
+    "_Z3fooi",
+    "_ZN9benchmark5State16StartKeepRunningEv",
+    "_ZNK9benchmark17BenchmarkReporter3Run14benchmark_nameB5cxx11Ev",
+    "_ZN9benchmark12_GLOBAL__N_18FormatKVERKNSt7__cxx1112basic_stringIcSt11ch"
+    "ar_traitsIcESaIcEEES8_",
+    "_Z8findHitsIN4llvm8DenseMapIjiNS0_12DenseMapInfoIjvEENS0_6detail12DenseM"
+    "apPairIjiEEEEEvRN9benchmark5StateE",
+    "_ZNSt17_Function_handlerIFbcENSt8__detail12_CharMatcherINSt7__cxx1112reg"
+    "ex_traitsIcEELb1ELb1EEEE10_M_managerERSt9_Any_dataRKS8_St18_Manager_oper"
+    "ation",
+    "_ZNSt8_Rb_treeINSt7__cxx1112basic_stringIcSt11char_traitsIcESaIcEEESt4pa"
+    "irIKS5_S5_ESt10_Select1stIS8_ESt4lessIS5_ESaIS8_EE29_M_get_insert_hint_u"
+    "nique_posESt23_Rb_tree_const_iteratorIS8_ERS7_",
+    "_ZTVN10__cxxabiv117__class_type_infoE",
+};
+static constexpr size_t NumNames = sizeof(Names) / sizeof(Names[0]);
+
+static void BM_ItaniumDemangle(benchmark::State &State) {
+  for (auto _ : State) {
+    for (const char *Name : Names) {
+      char *Demangled = itaniumDemangle(Name, nullptr, nullptr, nullptr);
+      benchmark::DoNotOptimize(Demangled);
+      std::free(Demangled);
+    }
+  }
+  State.SetItemsProcessed(State.iterations() * NumNames);
+}
+BENCHMARK(BM_ItaniumDemangle);
+
+static void BM_ItaniumBatchDemangler(benchmark::State &State) {
+  ItaniumBatchDemangler Demangler;
+  for (auto _ : State)
+    Demangler.demangleAll(Names, NumNames, [](size_t, const char *Demangled) {
+      benchmark::DoNotOptimize(Demangled);
+    });
+  State.SetItemsProcessed(State.iterations() * NumNames);
+}
+BENCHMARK(BM_ItaniumBatchDemangler);
+
+BENCHMARK_MAIN();
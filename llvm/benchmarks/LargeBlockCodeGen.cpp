@@ -0,0 +1,134 @@
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/LegacyPassManager.h"
+#include "llvm/IR/Module.h"
+#include "llvm/MC/TargetRegistry.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Host.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Target/TargetMachine.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+
+#include <memory>
+#include <string>
+
+using namespace llvm;
+
+// Build a function made of a single block in the style of an unrolled hash
+// round: each step loads a word, mixes it into one of several running states
+// and stores the result, so that many values are live at once and the
+// scheduler and the coalescer see long chains of copies and dependencies.
+static std::string buildRounds(unsigned NumSteps) {
+  constexpr unsigned NumStates = 8;
+  std::string IR;
+  raw_string_ostream OS(IR);
+  OS << "define void @rounds(ptr %in, ptr %out) {\n"
+     << "entry:\n";
+  for (unsigned S = 0; S != NumStates; ++S)
+    OS << "  %s" << S << "_0 = add i64 0, " << S + 1 << "\n";
+  for (unsigned I = 0; I != NumSteps; ++I) {
+    unsigned S = I % NumStates, Gen = I / NumStates;
+    unsigned Other = (S + 3) % NumStates;
+    unsigned OtherGen = Other < S ? Gen + 1 : Gen;
+    OS << "  %p" << I << " = getelementptr i64, ptr %in, i64 " << I << "\n"
+       << "  %w" << I << " = load i64, ptr %p" << I << "\n"
+       << "  %x" << I << " = xor i64 %s" << S << "_" << Gen << ", %w" << I
+       << "\n"
+       << "  %r" << I << " = call i64 @llvm.fshl.i64(i64 %x" << I << ", i64 %x"
+       << I << ", i64 " << (I * 7) % 63 + 1 << ")\n"
+       << "  %s" << S << "_" << Gen + 1 << " = add i64 %r" << I << ", %s"
+       << Other << "_" << OtherGen << "\n"
+       << "  %q" << I << " = getelementptr i64, ptr %out, i64 " << I << "\n"
+       << "  store i64 %s" << S << "_" << Gen + 1 << ", ptr %q" << I << "\n";
+  }
+  OS << "  ret void\n"
+     << "}\n"
+     << "declare i64 @llvm.fshl.i64(i64, i64, i64)\n";
+  return OS.str();
+}
+
+static bool setOption(StringRef Name, StringRef Value) {
+  cl::Option *Opt = cl::getRegisteredOptions().lookup(Name);
+  if (!Opt)
+    return false;
+  return !Opt->addOccurrence(0, Name, Value);
+}
+
+// Generate an object file for a block of State.range(0) steps on each
+// iteration, and report the throughput in IR instructions per second.
+// Functions of this shape are where the machine scheduler and the register
+// coalescer go superlinear, so this doubles as a compile time regression
+// test for them.
+static void runCodeGen(benchmark::State &State, bool Bounded) {
+  InitializeNativeTarget();
+  InitializeNativeTargetAsmPrinter();
+  std::string TripleName = sys::getProcessTriple(), Error;
+  const Target *T = TargetRegistry::lookupTarget(TripleName, Error);
+  if (!T) {
+    State.SkipWithError(Error.c_str());
+    return;
+  }
+  std::unique_ptr<TargetMachine> TM(T->createTargetMachine(
+      TripleName, "", "", TargetOptions(), None, None, CodeGenOpt::Default));
+
+  if (!setOption("misched-max-region-instrs", Bounded ? "1024" : "0") ||
+      !setOption("join-max-worklist-rounds", Bounded ? "4" : "0")) {
+    State.SkipWithError("missing compile time bounding options");
+    return;
+  }
+
+  LLVMContext Context;
+  SMDiagnostic Err;
+  std::unique_ptr<Module> M =
+      parseAssemblyString(buildRounds(State.range(0)), Err, Context);
+  if (!M) {
+    State.SkipWithError("can't parse the generated module");
+    return;
+  }
+  M->setDataLayout(TM->createDataLayout());
+  M->setTargetTriple(TM->getTargetTriple().str());
+  size_t NumInsts = M->getInstructionCount();
+
+  for (auto _ : State) {
+    State.PauseTiming();
+    std::unique_ptr<Module> Clone = CloneModule(*M);
+    SmallString<0> Object;
+    raw_svector_ostream OS(Object);
+    legacy::PassManager PM;
+    if (TM->addPassesToEmitFile(PM, OS, nullptr, CGFT_ObjectFile)) {
+      State.SkipWithError("target can't emit object files");
+      return;
+    }
+    State.ResumeTiming();
+    PM.run(*Clone);
+    benchmark::DoNotOptimize(Object.size());
+  }
+  State.counters["insts"] = benchmark::Counter(
+      State.iterations() * NumInsts, benchmark::Counter::kIsRate);
+}
+
+static void BM_LargeBlock(benchmark::State &State) {
+  runCodeGen(State, /*Bounded=*/false);
+}
+BENCHMARK(BM_LargeBlock)
+    ->Arg(1024)
+    ->Arg(4096)
+    ->Arg(16384)
+    ->Unit(benchmark::kMillisecond);
+
+// The same, with scheduling windows and a bounded number of coalescing
+// rounds.
+static void BM_LargeBlockBounded(benchmark::State &State) {
+  runCodeGen(State, /*Bounded=*/true);
+}
+BENCHMARK(BM_LargeBlockBounded)
+    ->Arg(1024)
+    ->Arg(4096)
+    ->Arg(16384)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
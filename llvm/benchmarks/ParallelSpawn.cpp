@@ -0,0 +1,49 @@
+#include "benchmark/benchmark.h"
+#include "llvm/Support/Parallel.h"
+#include "llvm/Support/Threading.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <vector>
+
+using namespace llvm;
+
+// Measure spawn/sync throughput of parallel::TaskGroup with tiny tasks. Run
+// with --benchmark_filter and vary the thread count below to see how the
+// executor scales with the number of cores.
+static void BM_TaskGroupSpawnSync(benchmark::State &State) {
+  std::atomic<uint64_t> Sum{0};
+  for (auto _ : State) {
+    parallel::TaskGroup TG;
+    for (int64_t I = 0, E = State.range(0); I != E; ++I)
+      TG.spawn([&Sum, I] { Sum.fetch_add(I, std::memory_order_relaxed); });
+  }
+  benchmark::DoNotOptimize(Sum.load());
+  State.SetItemsProcessed(State.iterations() * State.range(0));
+}
+BENCHMARK(BM_TaskGroupSpawnSync)->Arg(1 << 10)->Arg(1 << 14)->Arg(1 << 17);
+
+// Measure parallelFor over many small items, which is how lld and dsymutil
+// typically drive the executor.
+static void BM_ParallelForSmallItems(benchmark::State &State) {
+  std::vector<uint32_t> Data(State.range(0), 1);
+  for (auto _ : State) {
+    parallelFor(0, Data.size(), [&](size_t I) { Data[I] = Data[I] * 3 + 1; });
+    benchmark::ClobberMemory();
+  }
+  State.SetItemsProcessed(State.iterations() * State.range(0));
+}
+BENCHMARK(BM_ParallelForSmallItems)->Arg(1 << 12)->Arg(1 << 17)->Arg(1 << 20);
+
+int main(int argc, char **argv) {
+  // The default executor is created on first use, so the thread count has to
+  // be picked before any benchmark runs. Use LLVM_PARALLEL_BENCH_THREADS to
+  // compare different core counts.
+  if (const char *Threads = getenv("LLVM_PARALLEL_BENCH_THREADS"))
+    parallel::strategy = hardware_concurrency(atoi(Threads));
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
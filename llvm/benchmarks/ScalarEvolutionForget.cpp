@@ -0,0 +1,144 @@
+#include "benchmark/benchmark.h"
+#include "llvm/Analysis/AssumptionCache.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/ScalarEvolution.h"
+#include "llvm/Analysis/TargetLibraryInfo.h"
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/IR/Dominators.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+using namespace llvm;
+
+// Build a perfect loop nest of the given depth. The innermost loop computes an
+// address from all induction variables and stores to it, so that its SCEVs
+// depend on every loop of the nest.
+static std::string buildLoopNest(unsigned Depth) {
+  std::string IR;
+  raw_string_ostream OS(IR);
+  OS << "define void @nest(ptr %p, i64 %n) {\n"
+     << "entry:\n"
+     << "  br label %h0\n";
+  for (unsigned I = 0; I != Depth; ++I) {
+    OS << "h" << I << ":\n"
+       << "  %iv" << I << " = phi i64 [ 0, %" << (I ? "h" : "entry");
+    if (I)
+      OS << I - 1;
+    OS << " ], [ %iv" << I << ".next, %l" << I << " ]\n";
+    if (I + 1 != Depth) {
+      OS << "  br label %h" << I + 1 << "\n";
+      continue;
+    }
+    OS << "  %s0 = mul i64 %iv0, 3\n";
+    for (unsigned J = 1; J != Depth; ++J)
+      OS << "  %s" << J << " = add i64 %s" << J - 1 << ", %iv" << J << "\n";
+    OS << "  %g = getelementptr i64, ptr %p, i64 %s" << Depth - 1 << "\n"
+       << "  store i64 %s" << Depth - 1 << ", ptr %g\n"
+       << "  br label %l" << I << "\n";
+  }
+  for (unsigned I = Depth; I-- != 0;) {
+    OS << "l" << I << ":\n"
+       << "  %iv" << I << ".next = add nuw nsw i64 %iv" << I << ", 1\n"
+       << "  %c" << I << " = icmp slt i64 %iv" << I << ".next, %n\n"
+       << "  br i1 %c" << I << ", label %h" << I << ", label %";
+    if (I)
+      OS << "l" << I - 1 << "\n";
+    else
+      OS << "exit\n";
+  }
+  OS << "exit:\n"
+     << "  ret void\n"
+     << "}\n";
+  return OS.str();
+}
+
+namespace {
+struct LoopNest {
+  LLVMContext Context;
+  std::unique_ptr<Module> M;
+  Function *F;
+  TargetLibraryInfoImpl TLII;
+  TargetLibraryInfo TLI;
+  std::unique_ptr<AssumptionCache> AC;
+  std::unique_ptr<DominatorTree> DT;
+  std::unique_ptr<LoopInfo> LI;
+  std::unique_ptr<ScalarEvolution> SE;
+
+  LoopNest(unsigned Depth) : TLI(TLII) {
+    SMDiagnostic Err;
+    M = parseAssemblyString(buildLoopNest(Depth), Err, Context);
+    if (!M) {
+      Err.print("ScalarEvolutionForget", errs());
+      std::abort();
+    }
+    F = M->getFunction("nest");
+    AC = std::make_unique<AssumptionCache>(*F);
+    DT = std::make_unique<DominatorTree>(*F);
+    LI = std::make_unique<LoopInfo>(*DT);
+    SE = std::make_unique<ScalarEvolution>(*F, TLI, *AC, *DT, *LI);
+  }
+
+  /// Query everything that loop passes typically ask for.
+  void query() {
+    for (Instruction &I : instructions(*F))
+      if (SE->isSCEVable(I.getType()))
+        benchmark::DoNotOptimize(SE->getSCEV(&I));
+    for (Loop *L : LI->getLoopsInPreorder())
+      benchmark::DoNotOptimize(SE->getBackedgeTakenCount(L));
+  }
+
+  Loop *getInnermostLoop() {
+    Loop *L = *LI->begin();
+    while (!L->isInnermost())
+      L = *L->begin();
+    return L;
+  }
+};
+} // namespace
+
+// Forget the innermost loop of the nest and recompute, like a loop pass that
+// changed only that loop.
+static void BM_ForgetInnermostLoop(benchmark::State &State) {
+  LoopNest Nest(State.range(0));
+  Nest.query();
+  Loop *Innermost = Nest.getInnermostLoop();
+  for (auto _ : State) {
+    Nest.SE->forgetLoop(Innermost);
+    Nest.query();
+  }
+}
+BENCHMARK(BM_ForgetInnermostLoop)->Arg(4)->Arg(16)->Arg(64);
+
+// Forget the outermost loop, and therefore the whole nest, and recompute.
+static void BM_ForgetTopmostLoop(benchmark::State &State) {
+  LoopNest Nest(State.range(0));
+  Nest.query();
+  Loop *Outermost = *Nest.LI->begin();
+  for (auto _ : State) {
+    Nest.SE->forgetTopmostLoop(Outermost);
+    Nest.query();
+  }
+}
+BENCHMARK(BM_ForgetTopmostLoop)->Arg(4)->Arg(16)->Arg(64);
+
+// Forget the value of the outermost induction variable, whose users span the
+// whole nest, and recompute.
+static void BM_ForgetValue(benchmark::State &State) {
+  LoopNest Nest(State.range(0));
+  Nest.query();
+  Instruction *IV = &*(*Nest.LI->begin())->getHeader()->begin();
+  for (auto _ : State) {
+    Nest.SE->forgetValue(IV);
+    Nest.query();
+  }
+}
+BENCHMARK(BM_ForgetValue)->Arg(4)->Arg(16)->Arg(64);
+
+BENCHMARK_MAIN();
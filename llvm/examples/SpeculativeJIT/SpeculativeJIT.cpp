@@ -13,6 +13,7 @@
 #include "llvm/IRReader/IRReader.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/InitLLVM.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/TargetSelect.h"
@@ -35,6 +36,15 @@ static cl::opt<unsigned> NumThreads("num-threads", cl::Optional,
                                     cl::desc("Number of compile threads"),
                                     cl::init(4));
 
+static cl::opt<std::string> ProfileFile(
+    "speculation-profile", cl::Optional,
+    cl::desc("Speculate on the first-call order recorded in this file, and "
+             "update it on exit"));
+
+static cl::opt<bool> ShowStats("show-speculation-stats", cl::Optional,
+                               cl::desc("Print speculation statistics on exit"),
+                               cl::init(false));
+
 ExitOnError ExitOnErr;
 
 // Add Layers
@@ -89,6 +99,14 @@ public:
     return ES->lookup({&MainJD}, Mangle(UnmangledName));
   }
 
+  Error saveProfile() {
+    if (ProfileFile.empty())
+      return Error::success();
+    return Profile.save(ProfileFile);
+  }
+
+  Speculator::Stats getStats() { return S.getStats(); }
+
   ~SpeculativeJIT() { CompileThreads.wait(); }
 
 private:
@@ -111,7 +129,7 @@ private:
         CompileLayer(*this->ES, ObjLayer,
                      std::make_unique<ConcurrentIRCompiler>(std::move(JTMB))),
         S(Imps, *this->ES),
-        SpeculateLayer(*this->ES, CompileLayer, S, Mangle, BlockFreqQuery()),
+        SpeculateLayer(*this->ES, CompileLayer, S, Mangle, createQuery()),
         CODLayer(*this->ES, SpeculateLayer, *this->LCTMgr,
                  std::move(ISMBuilder)) {
     MainJD.addGenerator(std::move(ProcessSymbolsGenerator));
@@ -129,6 +147,15 @@ private:
     ExitOnErr(CXXRuntimeoverrides.enable(MainJD, Mangle));
   }
 
+  IRSpeculationLayer::ResultEval createQuery() {
+    if (ProfileFile.empty())
+      return BlockFreqQuery();
+    if (sys::fs::exists(ProfileFile))
+      ExitOnErr(Profile.load(ProfileFile));
+    S.setProfile(&Profile);
+    return ProfileQuery(Profile, DL.getGlobalPrefix(), BlockFreqQuery());
+  }
+
   static std::unique_ptr<SectionMemoryManager> createMemMgr() {
     return std::make_unique<SectionMemoryManager>();
   }
@@ -144,6 +171,7 @@ private:
   std::unique_ptr<LazyCallThroughManager> LCTMgr;
   IRCompileLayer CompileLayer;
   ImplSymbolMap Imps;
+  SpeculationProfile Profile;
   Speculator S;
   RTDyldObjectLinkingLayer ObjLayer{*ES, createMemMgr};
   IRSpeculationLayer SpeculateLayer;
@@ -186,7 +214,15 @@ int main(int argc, char *argv[]) {
   auto Main =
       jitTargetAddressToFunction<int (*)(int, char *[])>(MainSym.getAddress());
 
-  return runAsMain(Main, InputArgv, StringRef(InputFiles.front()));
+  int Result = runAsMain(Main, InputArgv, StringRef(InputFiles.front()));
+
+  ExitOnErr(SJ->saveProfile());
+  if (ShowStats) {
+    auto Stats = SJ->getStats();
+    outs() << "Speculatively compiled: " << Stats.NumSpeculated << "\n"
+           << "First calls: " << Stats.NumFirstCalls << "\n"
+           << "Speculation hits: " << Stats.NumHits << "\n";
+  }
 
-  return 0;
+  return Result;
 }
@@ -0,0 +1,125 @@
+//===- ConcurrentStringMap.h - Thread-safe sharded StringMap ----*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file defines ConcurrentStringMap, a StringMap that can be inserted
+/// into from multiple threads at once.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_ADT_CONCURRENTSTRINGMAP_H
+#define LLVM_ADT_CONCURRENTSTRINGMAP_H
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/STLFunctionalExtras.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/Allocator.h"
+#include "llvm/Support/MathExtras.h"
+#include <algorithm>
+#include <memory>
+#include <mutex>
+
+namespace llvm {
+
+/// ConcurrentStringMap - A thread-safe map from strings to values with the
+/// same entry layout as StringMap.
+///
+/// The map is split into a power-of-two number of shards. Each shard is a
+/// StringMap with its own mutex and its own allocator, and a key is assigned
+/// to a shard by the high bits of its StringMapImpl::hash value, so threads
+/// inserting different keys rarely contend. The hash is computed once, before
+/// the lock is taken.
+///
+/// Entries are never moved or removed while the map is alive, so the returned
+/// StringMapEntry pointers are stable and may be used without holding any
+/// lock. Access to the value stored in an entry is not synchronized by the
+/// map.
+template <typename ValueTy, typename AllocatorTy = BumpPtrAllocator>
+class ConcurrentStringMap {
+public:
+  using MapEntryTy = StringMapEntry<ValueTy>;
+
+  static constexpr unsigned DefaultNumShards = 64;
+
+  /// Create a map with \p NumShards shards, rounded up to a power of two.
+  explicit ConcurrentStringMap(unsigned NumShards = DefaultNumShards)
+      : NumShards(PowerOf2Ceil(std::max(NumShards, 1u))),
+        ShardShift(32 - Log2_32(this->NumShards)),
+        Shards(std::make_unique<Shard[]>(this->NumShards)) {}
+
+  ConcurrentStringMap(const ConcurrentStringMap &) = delete;
+  ConcurrentStringMap &operator=(const ConcurrentStringMap &) = delete;
+
+  /// Return the entry for \p Key, creating it from \p Args if it is not in
+  /// the map yet. The bool is true if the entry was created by this call.
+  template <typename... ArgsTy>
+  std::pair<MapEntryTy *, bool> try_emplace(StringRef Key, ArgsTy &&...Args) {
+    uint32_t FullHashValue = StringMapImpl::hash(Key);
+    Shard &S = getShard(FullHashValue);
+    std::lock_guard<std::mutex> Lock(S.Mutex);
+    auto [It, Inserted] = S.Map.try_emplace_with_hash(
+        Key, FullHashValue, std::forward<ArgsTy>(Args)...);
+    return {&*It, Inserted};
+  }
+
+  /// Return the entry for \p Key, or null if it is not in the map.
+  MapEntryTy *find(StringRef Key) {
+    uint32_t FullHashValue = StringMapImpl::hash(Key);
+    Shard &S = getShard(FullHashValue);
+    std::lock_guard<std::mutex> Lock(S.Mutex);
+    auto It = S.Map.find(Key, FullHashValue);
+    return It == S.Map.end() ? nullptr : &*It;
+  }
+
+  /// Return the number of entries. Takes every shard's lock in turn, so the
+  /// result is only exact if no other thread is inserting.
+  size_t size() {
+    size_t Size = 0;
+    for (Shard &S : shards()) {
+      std::lock_guard<std::mutex> Lock(S.Mutex);
+      Size += S.Map.size();
+    }
+    return Size;
+  }
+
+  bool empty() { return size() == 0; }
+
+  /// Call \p Fn on every entry. The visiting order is unspecified; users that
+  /// need a deterministic order must sort. Must not be called concurrently
+  /// with insertions.
+  void forEach(function_ref<void(MapEntryTy &)> Fn) {
+    for (Shard &S : shards())
+      for (MapEntryTy &E : S.Map)
+        Fn(E);
+  }
+
+  unsigned getNumShards() const { return NumShards; }
+
+private:
+  struct Shard {
+    std::mutex Mutex;
+    StringMap<ValueTy, AllocatorTy> Map;
+  };
+
+  Shard &getShard(uint32_t FullHashValue) {
+    // Use the high bits: StringMap uses the low bits to pick a bucket.
+    return Shards[static_cast<uint64_t>(FullHashValue) >> ShardShift];
+  }
+
+  MutableArrayRef<Shard> shards() {
+    return MutableArrayRef<Shard>(Shards.get(), NumShards);
+  }
+
+  const unsigned NumShards;
+  const unsigned ShardShift;
+  std::unique_ptr<Shard[]> Shards;
+};
+
+} // end namespace llvm
+
+#endif // LLVM_ADT_CONCURRENTSTRINGMAP_H
@@ -0,0 +1,518 @@
+//===- llvm/ADT/FlatHashMap.h - Hash table with control bytes ---*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file defines the FlatHashMap class, an open addressing hash table that
+/// keeps one control byte per bucket and probes groups of buckets at once.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_ADT_FLATHASHMAP_H
+#define LLVM_ADT_FLATHASHMAP_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseMapInfo.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/MemAlloc.h"
+#include "llvm/Support/type_traits.h"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LLVM_FLATHASHMAP_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace llvm {
+
+namespace detail {
+
+/// Control byte of an empty bucket. Full buckets hold 7 bits of the hash of
+/// their key, so they are never negative.
+constexpr int8_t FlatHashEmpty = -128;
+/// Control byte of a bucket whose entry was erased.
+constexpr int8_t FlatHashDeleted = -2;
+
+/// The control bytes of a group of buckets that are probed together. Each
+/// match function returns a bit mask with one bit per bucket of the group.
+class FlatHashGroup {
+public:
+  static constexpr unsigned Width = 16;
+
+#ifdef LLVM_FLATHASHMAP_SSE2
+  explicit FlatHashGroup(const int8_t *Ctrl)
+      : Ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(Ctrl))) {}
+
+  uint32_t match(int8_t H2) const {
+    return static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(Ctrl, _mm_set1_epi8(H2))));
+  }
+
+  /// Buckets that are empty or deleted.
+  uint32_t matchAvailable() const {
+    return static_cast<uint32_t>(_mm_movemask_epi8(Ctrl));
+  }
+
+private:
+  __m128i Ctrl;
+#else
+  explicit FlatHashGroup(const int8_t *Ctrl) {
+    std::memcpy(this->Ctrl, Ctrl, Width);
+  }
+
+  // These loops are simple enough for compilers to vectorize them on targets
+  // other than x86, such as AArch64.
+  uint32_t match(int8_t H2) const {
+    uint32_t Mask = 0;
+    for (unsigned I = 0; I != Width; ++I)
+      Mask |= uint32_t(Ctrl[I] == H2) << I;
+    return Mask;
+  }
+
+  uint32_t matchAvailable() const {
+    uint32_t Mask = 0;
+    for (unsigned I = 0; I != Width; ++I)
+      Mask |= uint32_t(Ctrl[I] < 0) << I;
+    return Mask;
+  }
+
+private:
+  int8_t Ctrl[Width];
+#endif
+
+public:
+  uint32_t matchEmpty() const { return match(FlatHashEmpty); }
+};
+
+} // end namespace detail
+
+/// A hash map with the interface of DenseMap that does not need empty or
+/// tombstone keys. Only KeyInfoT::getHashValue and KeyInfoT::isEqual are used.
+///
+/// Buckets are split into groups of 16. Each bucket has a control byte that
+/// tells whether it is empty, deleted, or full, and for full buckets holds 7
+/// bits of the hash of the key. A lookup compares the control bytes of a whole
+/// group against the hash in a few instructions, and only compares the keys of
+/// the buckets that match, which are usually none or the one being looked for.
+/// Probing stops at the first group with an empty bucket.
+///
+/// As with DenseMap, inserting into the map invalidates iterators and
+/// references to the entries.
+template <typename KeyT, typename ValueT,
+          typename KeyInfoT = DenseMapInfo<KeyT>>
+class FlatHashMap {
+  using Group = detail::FlatHashGroup;
+  static constexpr unsigned GroupWidth = Group::Width;
+
+  template <typename T>
+  using const_arg_type_t = typename const_pointer_or_const_ref<T>::type;
+
+public:
+  using key_type = KeyT;
+  using mapped_type = ValueT;
+  using value_type = detail::DenseMapPair<KeyT, ValueT>;
+  using size_type = unsigned;
+
+  template <bool IsConst> class Iterator;
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  explicit FlatHashMap(unsigned InitialReserve = 0) {
+    if (InitialReserve)
+      reserve(InitialReserve);
+  }
+
+  FlatHashMap(const FlatHashMap &Other) {
+    reserve(Other.size());
+    for (const value_type &KV : Other)
+      try_emplace(KV.first, KV.second);
+  }
+
+  FlatHashMap(FlatHashMap &&Other) { swap(Other); }
+
+  FlatHashMap(std::initializer_list<value_type> Vals) {
+    reserve(Vals.size());
+    insert(Vals.begin(), Vals.end());
+  }
+
+  ~FlatHashMap() {
+    destroyAll();
+    deallocate(Ctrl, Buckets, NumBuckets);
+  }
+
+  FlatHashMap &operator=(const FlatHashMap &Other) {
+    if (&Other != this) {
+      FlatHashMap Copy(Other);
+      swap(Copy);
+    }
+    return *this;
+  }
+
+  FlatHashMap &operator=(FlatHashMap &&Other) {
+    FlatHashMap Moved(std::move(Other));
+    swap(Moved);
+    return *this;
+  }
+
+  void swap(FlatHashMap &RHS) {
+    std::swap(Ctrl, RHS.Ctrl);
+    std::swap(Buckets, RHS.Buckets);
+    std::swap(NumBuckets, RHS.NumBuckets);
+    std::swap(NumEntries, RHS.NumEntries);
+    std::swap(GrowthLeft, RHS.GrowthLeft);
+  }
+
+  bool empty() const { return NumEntries == 0; }
+  unsigned size() const { return NumEntries; }
+  unsigned getNumBuckets() const { return NumBuckets; }
+
+  iterator begin() { return iterator(Ctrl, Ctrl + NumBuckets, Buckets); }
+  iterator end() {
+    return iterator(Ctrl + NumBuckets, Ctrl + NumBuckets, Buckets + NumBuckets);
+  }
+  const_iterator begin() const {
+    return const_iterator(Ctrl, Ctrl + NumBuckets, Buckets);
+  }
+  const_iterator end() const {
+    return const_iterator(Ctrl + NumBuckets, Ctrl + NumBuckets,
+                          Buckets + NumBuckets);
+  }
+
+  /// Grow the map so that it can hold \p NumEntries entries without having
+  /// to rehash.
+  void reserve(size_type NumEntries) {
+    unsigned Needed = GroupWidth;
+    while (maxLoad(Needed) < NumEntries)
+      Needed *= 2;
+    if (Needed > NumBuckets)
+      rehash(Needed);
+  }
+
+  void clear() {
+    if (NumEntries == 0 && GrowthLeft == maxLoad(NumBuckets))
+      return;
+    destroyAll();
+    std::memset(Ctrl, detail::FlatHashEmpty, NumBuckets);
+    NumEntries = 0;
+    GrowthLeft = maxLoad(NumBuckets);
+  }
+
+  size_type count(const_arg_type_t<KeyT> Key) const {
+    return findBucket(Key, hash(Key)) ? 1 : 0;
+  }
+
+  bool contains(const_arg_type_t<KeyT> Key) const {
+    return findBucket(Key, hash(Key)) != nullptr;
+  }
+
+  iterator find(const_arg_type_t<KeyT> Key) {
+    return makeIterator<false>(findBucket(Key, hash(Key)));
+  }
+  const_iterator find(const_arg_type_t<KeyT> Key) const {
+    return makeIterator<true>(findBucket(Key, hash(Key)));
+  }
+
+  /// Alternate version of find() which allows a different, and possibly less
+  /// expensive, key type. KeyInfoT must provide getHashValue and isEqual for
+  /// LookupKeyT.
+  template <class LookupKeyT> iterator find_as(const LookupKeyT &Key) {
+    return makeIterator<false>(findBucket(Key, hash(Key)));
+  }
+  template <class LookupKeyT>
+  const_iterator find_as(const LookupKeyT &Key) const {
+    return makeIterator<true>(findBucket(Key, hash(Key)));
+  }
+
+  /// Return the entry for the specified key, or a default constructed value
+  /// if no such entry exists.
+  ValueT lookup(const_arg_type_t<KeyT> Key) const {
+    if (const value_type *Bucket = findBucket(Key, hash(Key)))
+      return Bucket->second;
+    return ValueT();
+  }
+
+  std::pair<iterator, bool> insert(const value_type &KV) {
+    return try_emplace(KV.first, KV.second);
+  }
+
+  std::pair<iterator, bool> insert(value_type &&KV) {
+    return try_emplace(std::move(KV.first), std::move(KV.second));
+  }
+
+  template <typename InputIt> void insert(InputIt I, InputIt E) {
+    for (; I != E; ++I)
+      insert(*I);
+  }
+
+  /// Insert an entry constructed from \p Args if \p Key is not in the map.
+  template <typename... Ts>
+  std::pair<iterator, bool> try_emplace(KeyT &&Key, Ts &&...Args) {
+    return tryEmplaceImpl(std::move(Key), std::forward<Ts>(Args)...);
+  }
+
+  template <typename... Ts>
+  std::pair<iterator, bool> try_emplace(const KeyT &Key, Ts &&...Args) {
+    return tryEmplaceImpl(Key, std::forward<Ts>(Args)...);
+  }
+
+  ValueT &operator[](const KeyT &Key) { return try_emplace(Key).first->second; }
+  ValueT &operator[](KeyT &&Key) {
+    return try_emplace(std::move(Key)).first->second;
+  }
+
+  bool erase(const KeyT &Key) {
+    value_type *Bucket = findBucket(Key, hash(Key));
+    if (!Bucket)
+      return false;
+    eraseBucket(Bucket - Buckets);
+    return true;
+  }
+
+  void erase(iterator I) { eraseBucket(I.Bucket - Buckets); }
+
+  template <bool IsConst> class Iterator {
+    friend class FlatHashMap;
+    friend class Iterator<!IsConst>;
+    using BucketT =
+        std::conditional_t<IsConst, const FlatHashMap::value_type,
+                           FlatHashMap::value_type>;
+
+    const int8_t *Ctrl = nullptr;
+    const int8_t *CtrlEnd = nullptr;
+    BucketT *Bucket = nullptr;
+
+    void skipAvailable() {
+      while (Ctrl != CtrlEnd && *Ctrl < 0) {
+        ++Ctrl;
+        ++Bucket;
+      }
+    }
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = BucketT;
+    using difference_type = std::ptrdiff_t;
+    using pointer = BucketT *;
+    using reference = BucketT &;
+
+    Iterator() = default;
+    Iterator(const int8_t *Ctrl, const int8_t *CtrlEnd, BucketT *Bucket)
+        : Ctrl(Ctrl), CtrlEnd(CtrlEnd), Bucket(Bucket) {
+      skipAvailable();
+    }
+
+    // Converting ctor from non-const iterators to const iterators.
+    template <bool WasConst,
+              typename = std::enable_if_t<IsConst && !WasConst>>
+    Iterator(const Iterator<WasConst> &I)
+        : Ctrl(I.Ctrl), CtrlEnd(I.CtrlEnd), Bucket(I.Bucket) {}
+
+    reference operator*() const { return *Bucket; }
+    pointer operator->() const { return Bucket; }
+
+    friend bool operator==(const Iterator &LHS, const Iterator &RHS) {
+      return LHS.Bucket == RHS.Bucket;
+    }
+    friend bool operator!=(const Iterator &LHS, const Iterator &RHS) {
+      return LHS.Bucket != RHS.Bucket;
+    }
+
+    Iterator &operator++() {
+      ++Ctrl;
+      ++Bucket;
+      skipAvailable();
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator Tmp = *this;
+      ++*this;
+      return Tmp;
+    }
+  };
+
+private:
+  int8_t *Ctrl = nullptr;
+  value_type *Buckets = nullptr;
+  /// Zero, or a power of two that is at least GroupWidth.
+  unsigned NumBuckets = 0;
+  unsigned NumEntries = 0;
+  /// Number of empty buckets that can still be filled before the map has to
+  /// grow. Deleted buckets are not counted, so that some buckets always stay
+  /// empty and every probe sequence ends.
+  unsigned GrowthLeft = 0;
+
+  /// Keep the load factor at or below 7/8.
+  static unsigned maxLoad(unsigned NumBuckets) {
+    return NumBuckets - NumBuckets / 8;
+  }
+
+  /// DenseMapInfo hashes are often weak in the low bits, for example for
+  /// pointers, so mix them before taking the group index and control byte.
+  template <typename LookupKeyT> static uint64_t hash(const LookupKeyT &Key) {
+    uint64_t H = uint64_t(KeyInfoT::getHashValue(Key)) * 0x9E3779B97F4A7C15ULL;
+    return H ^ (H >> 32);
+  }
+  static int8_t getH2(uint64_t Hash) { return int8_t(Hash & 0x7F); }
+  unsigned getFirstGroup(uint64_t Hash) const {
+    return unsigned(Hash >> 7) & (NumBuckets / GroupWidth - 1);
+  }
+
+  /// Groups are probed in triangular order, which visits every group once
+  /// because the number of groups is a power of two.
+  unsigned getNextGroup(unsigned G, unsigned Step) const {
+    return (G + Step) & (NumBuckets / GroupWidth - 1);
+  }
+
+  template <typename LookupKeyT>
+  value_type *findBucket(const LookupKeyT &Key, uint64_t Hash) const {
+    if (NumBuckets == 0)
+      return nullptr;
+    int8_t H2 = getH2(Hash);
+    unsigned G = getFirstGroup(Hash);
+    for (unsigned Step = 1;; ++Step) {
+      Group Grp(Ctrl + G * GroupWidth);
+      for (uint32_t Mask = Grp.match(H2); Mask; Mask &= Mask - 1) {
+        value_type *Bucket =
+            Buckets + G * GroupWidth + countTrailingZeros(Mask, ZB_Undefined);
+        if (KeyInfoT::isEqual(Key, Bucket->first))
+          return Bucket;
+      }
+      if (Grp.matchEmpty())
+        return nullptr;
+      G = getNextGroup(G, Step);
+    }
+  }
+
+  /// Return the first empty or deleted bucket in the probe sequence of Hash.
+  unsigned findAvailableBucket(uint64_t Hash) const {
+    unsigned G = getFirstGroup(Hash);
+    for (unsigned Step = 1;; ++Step) {
+      if (uint32_t Mask = Group(Ctrl + G * GroupWidth).matchAvailable())
+        return G * GroupWidth + countTrailingZeros(Mask, ZB_Undefined);
+      G = getNextGroup(G, Step);
+    }
+  }
+
+  template <typename KeyArg, typename... Ts>
+  std::pair<iterator, bool> tryEmplaceImpl(KeyArg &&Key, Ts &&...Args) {
+    uint64_t Hash = hash(Key);
+    if (value_type *Bucket = findBucket(Key, Hash))
+      return {makeIterator<false>(Bucket), false};
+
+    if (GrowthLeft == 0)
+      grow();
+    unsigned Idx = findAvailableBucket(Hash);
+    if (Ctrl[Idx] == detail::FlatHashEmpty)
+      --GrowthLeft;
+    Ctrl[Idx] = getH2(Hash);
+    value_type *Bucket = Buckets + Idx;
+    ::new (Bucket) value_type(std::piecewise_construct,
+                              std::forward_as_tuple(std::forward<KeyArg>(Key)),
+                              std::forward_as_tuple(std::forward<Ts>(Args)...));
+    ++NumEntries;
+    return {makeIterator<false>(Bucket), true};
+  }
+
+  void eraseBucket(unsigned Idx) {
+    assert(Ctrl[Idx] >= 0 && "Erasing an empty bucket");
+    Buckets[Idx].~value_type();
+    --NumEntries;
+    // Probing stops at groups with an empty bucket, so no probe sequence
+    // continues past such a group and the bucket can become empty again.
+    if (Group(Ctrl + Idx / GroupWidth * GroupWidth).matchEmpty()) {
+      Ctrl[Idx] = detail::FlatHashEmpty;
+      ++GrowthLeft;
+    } else {
+      Ctrl[Idx] = detail::FlatHashDeleted;
+    }
+  }
+
+  template <bool IsConst>
+  Iterator<IsConst> makeIterator(value_type *Bucket) const {
+    if (!Bucket)
+      return Iterator<IsConst>(Ctrl + NumBuckets, Ctrl + NumBuckets,
+                               Buckets + NumBuckets);
+    unsigned Idx = Bucket - Buckets;
+    return Iterator<IsConst>(Ctrl + Idx, Ctrl + NumBuckets, Bucket);
+  }
+
+  void grow() {
+    if (NumBuckets == 0)
+      return rehash(GroupWidth);
+    // If at least half of the used buckets hold deleted entries, rehashing
+    // at the same size frees enough of them.
+    if (NumEntries * 2 >= maxLoad(NumBuckets))
+      return rehash(NumBuckets * 2);
+    rehash(NumBuckets);
+  }
+
+  void rehash(unsigned NewNumBuckets) {
+    assert(isPowerOf2_32(NewNumBuckets) && NewNumBuckets >= GroupWidth);
+    assert(maxLoad(NewNumBuckets) > NumEntries);
+    int8_t *OldCtrl = Ctrl;
+    value_type *OldBuckets = Buckets;
+    unsigned OldNumBuckets = NumBuckets;
+
+    Ctrl = static_cast<int8_t *>(allocate_buffer(NewNumBuckets, 1));
+    Buckets = static_cast<value_type *>(allocate_buffer(
+        sizeof(value_type) * NewNumBuckets, alignof(value_type)));
+    NumBuckets = NewNumBuckets;
+    std::memset(Ctrl, detail::FlatHashEmpty, NumBuckets);
+    GrowthLeft = maxLoad(NumBuckets) - NumEntries;
+
+    for (unsigned I = 0; I != OldNumBuckets; ++I) {
+      if (OldCtrl[I] < 0)
+        continue;
+      value_type &Old = OldBuckets[I];
+      uint64_t Hash = hash(Old.first);
+      unsigned Idx = findAvailableBucket(Hash);
+      Ctrl[Idx] = getH2(Hash);
+      ::new (Buckets + Idx) value_type(std::move(Old));
+      Old.~value_type();
+    }
+    deallocate(OldCtrl, OldBuckets, OldNumBuckets);
+  }
+
+  void destroyAll() {
+    if (std::is_trivially_destructible<value_type>::value)
+      return;
+    for (unsigned I = 0; I != NumBuckets; ++I)
+      if (Ctrl[I] >= 0)
+        Buckets[I].~value_type();
+  }
+
+  static void deallocate(int8_t *Ctrl, value_type *Buckets,
+                         unsigned NumBuckets) {
+    if (NumBuckets == 0)
+      return;
+    deallocate_buffer(Ctrl, NumBuckets, 1);
+    deallocate_buffer(Buckets, sizeof(value_type) * NumBuckets,
+                      alignof(value_type));
+  }
+};
+
+template <typename KeyT, typename ValueT, typename KeyInfoT>
+inline void swap(FlatHashMap<KeyT, ValueT, KeyInfoT> &LHS,
+                 FlatHashMap<KeyT, ValueT, KeyInfoT> &RHS) {
+  LHS.swap(RHS);
+}
+
+} // end namespace llvm
+
+#undef LLVM_FLATHASHMAP_SSE2
+
+#endif // LLVM_ADT_FLATHASHMAP_H
@@ -278,6 +278,20 @@ public:
   ///   store %l, ...
   bool MayBeCrossIteration = false;
 
+  /// Whether alias analyses may keep the results of expensive pointer
+  /// analyses, such as BasicAA's GEP decompositions, for later queries that
+  /// use this AAQueryInfo. Only safe if the IR does not change in between, so
+  /// it is set by BatchAAResults.
+  bool CacheImplResults = false;
+
+  /// Base class for the per-query-session state of an alias analysis.
+  struct ImplCache {
+    virtual ~ImplCache() = default;
+  };
+
+  /// State owned by BasicAA, created on demand if CacheImplResults is set.
+  std::unique_ptr<ImplCache> BasicAACache;
+
   AAQueryInfo(AAResults &AAR, CaptureInfo *CI) : AAR(AAR), CI(CI) {}
 };
 
@@ -612,12 +626,25 @@ class BatchAAResults {
   SimpleCaptureInfo SimpleCI;
 
 public:
-  BatchAAResults(AAResults &AAR) : AA(AAR), AAQI(AAR, &SimpleCI) {}
-  BatchAAResults(AAResults &AAR, CaptureInfo *CI) : AA(AAR), AAQI(AAR, CI) {}
+  BatchAAResults(AAResults &AAR) : AA(AAR), AAQI(AAR, &SimpleCI) {
+    AAQI.CacheImplResults = true;
+  }
+  BatchAAResults(AAResults &AAR, CaptureInfo *CI) : AA(AAR), AAQI(AAR, CI) {
+    AAQI.CacheImplResults = true;
+  }
 
   AliasResult alias(const MemoryLocation &LocA, const MemoryLocation &LocB) {
     return AA.alias(LocA, LocB, AAQI);
   }
+  /// Query \p LocA against each location in \p LocBs and append the results
+  /// to \p Results in the same order. The analysis of LocA, e.g. its
+  /// decomposition into a base pointer and offsets, is done only once.
+  void alias(const MemoryLocation &LocA, ArrayRef<MemoryLocation> LocBs,
+             SmallVectorImpl<AliasResult> &Results) {
+    Results.reserve(Results.size() + LocBs.size());
+    for (const MemoryLocation &LocB : LocBs)
+      Results.push_back(AA.alias(LocA, LocB, AAQI));
+  }
   bool pointsToConstantMemory(const MemoryLocation &Loc, bool OrLocal = false) {
     return AA.pointsToConstantMemory(Loc, AAQI, OrLocal);
   }
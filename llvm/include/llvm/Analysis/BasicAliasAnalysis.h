@@ -97,6 +97,7 @@ public:
 
 private:
   struct DecomposedGEP;
+  struct QueryCache;
 
   /// Tracks instructions visited by pointsToConstantMemory.
   SmallPtrSet<const Value *, 16> Visited;
@@ -105,6 +106,15 @@ private:
   DecomposeGEPExpression(const Value *V, const DataLayout &DL,
                          AssumptionCache *AC, DominatorTree *DT);
 
+  /// Return the cache of this AA in \p AAQI, or null if it may not keep one.
+  QueryCache *getQueryCache(AAQueryInfo &AAQI);
+
+  /// DecomposeGEPExpression, reusing earlier results of the query session.
+  DecomposedGEP getDecomposedGEP(const Value *V, AAQueryInfo &AAQI);
+
+  /// getUnderlyingObject, reusing earlier results of the query session.
+  const Value *getCachedUnderlyingObject(const Value *V, AAQueryInfo &AAQI);
+
   /// A Heuristic for aliasGEP that searches for a constant offset
   /// between the variables.
   ///
@@ -92,6 +92,7 @@ public:
     Accelerate,       // Use Accelerate framework.
     DarwinLibSystemM, // Use Darwin's libsystem_m.
     LIBMVEC_X86,      // GLIBC Vector Math library.
+    LLVMLIBC_X86,     // LLVM libc vector math functions.
     MASSV,            // IBM MASS vector library.
     SVML              // Intel short vector math library.
   };
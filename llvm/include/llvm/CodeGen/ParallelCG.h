@@ -32,6 +32,11 @@ class raw_pwrite_stream;
 ///
 /// Writes bitcode for individual partitions into output streams in BCOSs, if
 /// BCOSs is not empty.
+///
+/// Every partition is emitted with its own MCContext and MCAssembler, which
+/// are not safe to share between threads, so there is no way to emit the
+/// partitions into different subsections of a single object file. Clients
+/// that need one object have to link the outputs together.
 void splitCodeGen(
     Module &M, ArrayRef<raw_pwrite_stream *> OSs,
     ArrayRef<llvm::raw_pwrite_stream *> BCOSs,
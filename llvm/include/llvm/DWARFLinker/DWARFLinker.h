@@ -284,6 +284,12 @@ public:
   /// Use specified number of threads for parallel files linking.
   void setNumThreads(unsigned NumThreads) { Options.Threads = NumThreads; }
 
+  /// Limit how many object files may be analyzed ahead of the one being
+  /// cloned when analysis and cloning run concurrently. 0 means no limit.
+  void setMaxInFlightObjects(unsigned Max) {
+    Options.MaxInFlightObjects = Max;
+  }
+
   /// Set kind of accelerator tables to be generated.
   void setAccelTableKind(DwarfLinkerAccelTableKind Kind) {
     Options.TheAccelTableKind = Kind;
@@ -823,6 +829,11 @@ private:
     /// Number of threads.
     unsigned Threads = 1;
 
+    /// Maximum number of object files that have been analyzed but not yet
+    /// cloned. Every such file keeps its per-DIE info alive, so this bounds
+    /// the memory used by the analyze/clone pipeline. 0 means no limit.
+    unsigned MaxInFlightObjects = 0;
+
     /// The accelerator table kind
     DwarfLinkerAccelTableKind TheAccelTableKind =
         DwarfLinkerAccelTableKind::Default;
@@ -22,8 +22,11 @@
 #include "llvm/Support/DataExtractor.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/Host.h"
+#include "llvm/Support/Threading.h"
+#include <atomic>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 
 namespace llvm {
 
@@ -44,6 +47,11 @@ class DWARFUnitIndex;
 /// DWARFContext
 /// This data structure is the top level entity that deals with dwarf debug
 /// information parsing. The actual data is supplied through DWARFObj.
+///
+/// Units, DIEs, line tables, accelerator tables and the other sections are
+/// parsed lazily, and it is safe to query them from several threads at the
+/// same time. Functions that discard parsed data, such as
+/// clearLineTableForUnit(), must not run concurrently with other queries.
 class DWARFContext : public DIContext {
   DWARFUnitVector NormalUnits;
   Optional<DenseMap<uint64_t, DWARFTypeUnit*>> NormalTypeUnits;
@@ -71,7 +79,7 @@ class DWARFContext : public DIContext {
   std::unique_ptr<DWARFDebugMacro> MacroDWO;
 
   /// The maximum DWARF version of all units.
-  unsigned MaxVersion = 0;
+  std::atomic<unsigned> MaxVersion{0};
 
   struct DWOFile {
     object::OwningBinary<object::ObjectFile> File;
@@ -82,6 +90,25 @@ class DWARFContext : public DIContext {
   bool CheckedForDWP = false;
   std::string DWPName;
 
+  /// The members above are built on first use. Each of them is guarded on its
+  /// own so that one context can serve lookups from several threads without
+  /// serializing unrelated queries.
+  llvm::once_flag NormalUnitsOnce;
+  llvm::once_flag NormalTypeUnitsOnce, DWOTypeUnitsOnce;
+  llvm::once_flag CUIndexOnce, TUIndexOnce, GdbIndexOnce;
+  llvm::once_flag AbbrevOnce, AbbrevDWOOnce, LocOnce, ArangesOnce;
+  llvm::once_flag MacroOnce, MacroDWOOnce, MacinfoOnce, MacinfoDWOOnce;
+  llvm::once_flag NamesOnce, AppleNamesOnce, AppleTypesOnce;
+  llvm::once_flag AppleNamespacesOnce, AppleObjCOnce;
+  /// Guards DebugFrame and EHFrame, which are not cached if parsing fails.
+  std::mutex FrameMutex;
+  /// Guards the line table cache in Line.
+  std::mutex LineMutex;
+  /// Guards DWOFiles, DWP and CheckedForDWP.
+  std::mutex DWOFilesMutex;
+  /// Guards DWOUnits, which may be parsed on demand by hash lookups.
+  std::mutex DWOUnitsMutex;
+
   std::unique_ptr<MCRegisterInfo> RegInfo;
 
   std::function<void(Error)> RecoverableErrorHandler =
@@ -270,8 +297,9 @@ public:
   }
 
   void setMaxVersionIfGreater(unsigned Version) {
-    if (Version > MaxVersion)
-      MaxVersion = Version;
+    unsigned Max = MaxVersion.load(std::memory_order_relaxed);
+    while (Version > Max && !MaxVersion.compare_exchange_weak(Max, Version))
+      ;
   }
 
   const DWARFUnitIndex &getCUIndex();
@@ -23,11 +23,14 @@
 #include "llvm/DebugInfo/DWARF/DWARFLocationExpression.h"
 #include "llvm/DebugInfo/DWARF/DWARFUnitIndex.h"
 #include "llvm/Support/DataExtractor.h"
+#include "llvm/Support/RWMutex.h"
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <utility>
 #include <vector>
@@ -232,25 +235,34 @@ class DWARFUnit {
   /// offsets table (DWARF v5).
   Optional<StrOffsetsContributionDescriptor> StringOffsetsTableContribution;
 
-  mutable const DWARFAbbreviationDeclarationSet *Abbrevs;
+  mutable std::atomic<const DWARFAbbreviationDeclarationSet *> Abbrevs;
   llvm::Optional<object::SectionedAddress> BaseAddr;
+  std::mutex BaseAddrMutex;
   /// The compile unit debug information entry items.
   std::vector<DWARFDebugInfoEntry> DieArray;
+  /// Serializes the lazy extraction of DieArray so that DIEs of the same unit
+  /// can be requested from several threads. Extracting all DIEs after only
+  /// the unit DIE was extracted still invalidates DWARFDie objects referring
+  /// to the unit DIE.
+  llvm::sys::RWMutex DieArrayMutex;
 
   /// Map from range's start address to end address and corresponding DIE.
   /// IntervalMap does not support range removal, as a result, we use the
   /// std::map::upper_bound for address range lookup.
   std::map<uint64_t, std::pair<uint64_t, DWARFDie>> AddrDieMap;
+  std::mutex AddrDieMapMutex;
 
   /// Map from the location (interpreted DW_AT_location) of a DW_TAG_variable,
   /// to the end address and the corresponding DIE.
   std::map<uint64_t, std::pair<uint64_t, DWARFDie>> VariableDieMap;
   DenseSet<uint64_t> RootsParsedForVariables;
+  std::mutex VariableDieMapMutex;
 
   using die_iterator_range =
       iterator_range<std::vector<DWARFDebugInfoEntry>::iterator>;
 
   std::shared_ptr<DWARFUnit> DWO;
+  std::mutex DWOMutex;
 
 protected:
   /// Return the index of a \p Die entry inside the unit's DIE vector.
@@ -157,6 +157,19 @@ private:
   unsigned verifyUnitSection(const DWARFSection &S);
   unsigned verifyUnits(const DWARFUnitVector &Units);
 
+  /// Verifies the contents of \p Unit and the references local to it.
+  /// References to other units are added to \p CrossUnitReferences.
+  ///
+  /// \returns The number of errors that occurred during verification.
+  unsigned verifyUnit(DWARFUnit &Unit, ReferenceMap &CrossUnitReferences);
+
+  /// Verifies \p Units on DumpOpts.NumThreads threads. Every unit is checked
+  /// by its own verifier writing to a buffer, and the buffers are printed in
+  /// unit order as soon as they are complete. References to other units are
+  /// added to \p CrossUnitReferences.
+  unsigned verifyUnitsConcurrently(const DWARFUnitVector &Units,
+                                   ReferenceMap &CrossUnitReferences);
+
   unsigned verifyIndexes(const DWARFObject &DObj);
   unsigned verifyIndex(StringRef Name, DWARFSectionKind SectionKind,
                        StringRef Index);
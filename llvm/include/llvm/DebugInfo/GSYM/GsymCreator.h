@@ -22,7 +22,10 @@
 #include "llvm/MC/StringTableBuilder.h"
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/Error.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
 
 namespace llvm {
 
@@ -131,9 +134,34 @@ class FileWriter;
 /// entry in the Function Info Offsets Table. For details on the exact encoding
 /// of FunctionInfo objects, see "llvm/DebugInfo/GSYM/FunctionInfo.h".
 class GsymCreator {
+  /// A FunctionInfo that was encoded into the spill file as soon as it was
+  /// added. Only what is needed to sort and prune the functions is kept in
+  /// memory.
+  struct SpilledFunctionInfo {
+    AddressRange Range;
+    /// Offset and size of the encoded FunctionInfo in the spill file.
+    uint64_t Offset;
+    uint32_t Size;
+    bool HasInline;
+    bool HasLineTable;
+
+    bool hasRichInfo() const { return HasInline || HasLineTable; }
+  };
+
   // Private member variables require Mutex protections
   mutable std::mutex Mutex;
   std::vector<FunctionInfo> Funcs;
+  std::vector<SpilledFunctionInfo> SpilledFuncs;
+  Optional<sys::fs::TempFile> SpillFile;
+  std::unique_ptr<raw_fd_ostream> SpillStream;
+  std::unique_ptr<MemoryBuffer> SpillBuffer;
+  support::endianness SpillByteOrder = support::native;
+  uint64_t SpillSize = 0;
+  /// The first FunctionInfo that could not be encoded into the spill file.
+  Optional<std::string> SpillError;
+  // The string table has its own lock so that threads adding strings don't
+  // wait for threads adding files and functions.
+  mutable std::mutex StrTabMutex;
   StringTableBuilder StrTab;
   StringSet<> StringStorage;
   DenseMap<llvm::gsym::FileEntry, uint32_t> FileEntryToIndex;
@@ -145,8 +173,38 @@ class GsymCreator {
   bool Finalized = false;
   bool Quiet;
 
+  /// Return the encoded bytes of a spilled FunctionInfo. Only valid after
+  /// finalize() mapped the spill file.
+  StringRef getSpilledBytes(const SpilledFunctionInfo &SFI) const {
+    return SpillBuffer->getBuffer().substr(SFI.Offset, SFI.Size);
+  }
+
+  size_t getNumFunctionInfosLocked() const {
+    return Funcs.size() + SpilledFuncs.size();
+  }
+
 public:
   GsymCreator(bool Quiet = false);
+  ~GsymCreator();
+
+  /// Encode function infos as soon as they are added and keep them in a
+  /// temporary file instead of in memory.
+  ///
+  /// Creating GSYM files for very large binaries can otherwise require
+  /// more memory than the debug information being converted. Once spilling
+  /// is enabled, each added FunctionInfo only keeps its address range and
+  /// the location of its encoding in the spill file in memory. The file is
+  /// mapped back during finalize() and copied to the output by encode().
+  /// Spilled functions can't be visited with forEachFunctionInfo().
+  ///
+  /// This must be called before any function info is added.
+  ///
+  /// \param Directory The directory to create the spill file in.
+  /// \param ByteOrder The endianness the GSYM file will be saved with.
+  /// \returns An error object that indicates success or failure of creating
+  ///          the spill file.
+  llvm::Error enableSpilling(StringRef Directory,
+                             llvm::support::endianness ByteOrder);
 
   /// Save a GSYM file to a stand alone file.
   ///
@@ -214,14 +272,15 @@ public:
     UUID.assign(UUIDBytes.begin(), UUIDBytes.end());
   }
 
-  /// Thread safe iteration over all function infos.
+  /// Thread safe iteration over all function infos that are kept in memory.
   ///
   /// \param  Callback A callback function that will get called with each
   ///         FunctionInfo. If the callback returns false, stop iterating.
   void forEachFunctionInfo(
       std::function<bool(FunctionInfo &)> const &Callback);
 
-  /// Thread safe const iteration over all function infos.
+  /// Thread safe const iteration over all function infos that are kept in
+  /// memory.
   ///
   /// \param  Callback A callback function that will get called with each
   ///         FunctionInfo. If the callback returns false, stop iterating.
@@ -62,6 +62,9 @@ public:
     std::string FallbackDebugPath;
     std::string DWPName;
     std::vector<std::string> DebugFileDirectory;
+    /// If set, ELF binaries with a build ID are symbolized from GSYM files
+    /// kept in this directory, which are created from DWARF on first use.
+    std::string GsymCacheDirectory;
     size_t MaxCacheSize =
         sizeof(size_t) == 4
             ? 512 * 1024 * 1024 /* 512 MiB */
@@ -158,6 +161,12 @@ private:
   createModuleInfo(const ObjectFile *Obj, std::unique_ptr<DIContext> Context,
                    StringRef ModuleName);
 
+  /// Returns a context reading the GSYM file cached for the build ID of Obj,
+  /// converting the debug info of DbgObj to GSYM first if there is none yet.
+  /// Returns nullptr if Obj has no build ID or the conversion fails.
+  std::unique_ptr<DIContext> getOrCreateGsymContext(const ObjectFile &Obj,
+                                                    const ObjectFile &DbgObj);
+
   ObjectFile *lookUpDsymFile(const std::string &Path,
                              const MachOObjectFile *ExeObj,
                              const std::string &ArchName);
@@ -128,6 +128,38 @@ private:
   void *RootNode;
   void *Context;
 };
+
+/// Demangles Itanium names one after another. Unlike itaniumDemangle, the
+/// parser and the output buffer are kept between calls, so demangling many
+/// names does not construct a parser and allocate a result for each of them.
+struct ItaniumBatchDemangler {
+  ItaniumBatchDemangler();
+
+  ItaniumBatchDemangler(ItaniumBatchDemangler &&Other);
+  ItaniumBatchDemangler &operator=(ItaniumBatchDemangler &&Other);
+
+  /// Demangle MangledName. Returns the null-terminated demangled name, which
+  /// is owned by this object and stays valid until the next call, or nullptr
+  /// if MangledName is not a valid Itanium mangled name. If N is not nullptr,
+  /// it receives the length of the demangled name.
+  const char *demangle(const char *MangledName, size_t *N = nullptr);
+
+  /// Demangle the Count names in MangledNames, calling Callback with the
+  /// index of each name and the result of demangle() for it.
+  template <typename CallbackT>
+  void demangleAll(const char *const *MangledNames, size_t Count,
+                   CallbackT Callback) {
+    for (size_t I = 0; I != Count; ++I)
+      Callback(I, demangle(MangledNames[I]));
+  }
+
+  ~ItaniumBatchDemangler();
+
+private:
+  void *Context;
+  char *Buf = nullptr;
+  size_t BufSize = 0;
+};
 } // namespace llvm
 
 #endif
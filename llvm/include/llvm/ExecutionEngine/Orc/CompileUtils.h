@@ -16,7 +16,11 @@
 #include "llvm/ExecutionEngine/Orc/IRCompileLayer.h"
 #include "llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h"
 #include "llvm/ExecutionEngine/Orc/Layer.h"
+#include "llvm/Support/Caching.h"
+#include <atomic>
+#include <map>
 #include <memory>
+#include <mutex>
 
 namespace llvm {
 
@@ -93,6 +97,51 @@ private:
   ObjectCache *ObjCache = nullptr;
 };
 
+/// A compile functor that keeps the objects produced by another compiler in a
+/// persistent FileCache (see llvm/Support/Caching.h).
+///
+/// Modules are keyed by a hash of their bitcode, the LLVM version and the
+/// code generation settings of the target machine builder, so cached objects
+/// can be reused across process restarts. On a hit the cached object is
+/// returned without compiling the module. This compiler is thread-safe if the
+/// wrapped compiler is.
+class CachingIRCompiler : public IRCompileLayer::IRCompiler {
+public:
+  /// Create a CachingIRCompiler that caches the output of \p Compile in
+  /// \p CacheDirectory and, if \p Remote is set, in a remote store behind
+  /// it. \p JTMB must describe the target machine that \p Compile uses.
+  static Expected<std::unique_ptr<CachingIRCompiler>>
+  Create(std::unique_ptr<IRCompileLayer::IRCompiler> Compile,
+         const JITTargetMachineBuilder &JTMB, StringRef CacheDirectory,
+         std::shared_ptr<RemoteCacheStore> Remote = nullptr);
+
+  Expected<std::unique_ptr<MemoryBuffer>> operator()(Module &M) override;
+
+  /// Number of modules whose object was found in the cache.
+  uint64_t getNumHits() const { return NumHits; }
+
+  /// Number of modules that had to be compiled.
+  uint64_t getNumMisses() const { return NumMisses; }
+
+private:
+  CachingIRCompiler(std::unique_ptr<IRCompileLayer::IRCompiler> Compile,
+                    std::string TargetKey);
+
+  std::string computeKey(Module &M) const;
+
+  std::unique_ptr<IRCompileLayer::IRCompiler> Compile;
+  std::string TargetKey;
+  FileCache Cache;
+
+  /// Objects handed back by the cache, by task number.
+  std::mutex CachedObjectsMutex;
+  std::map<unsigned, std::unique_ptr<MemoryBuffer>> CachedObjects;
+  std::atomic<unsigned> NextTask{0};
+
+  std::atomic<uint64_t> NumHits{0};
+  std::atomic<uint64_t> NumMisses{0};
+};
+
 } // end namespace orc
 
 } // end namespace llvm
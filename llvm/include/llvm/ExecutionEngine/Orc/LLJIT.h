@@ -20,6 +20,7 @@
 #include "llvm/ExecutionEngine/Orc/IRTransformLayer.h"
 #include "llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h"
 #include "llvm/ExecutionEngine/Orc/ThreadSafeModule.h"
+#include "llvm/ExecutionEngine/Orc/TieredCompileLayer.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/ThreadPool.h"
 
@@ -177,6 +178,10 @@ public:
   /// Returns a reference to the IR compile layer.
   IRCompileLayer &getIRCompileLayer() { return *CompileLayer; }
 
+  /// Returns a pointer to the tiered compile layer, or null if tiered
+  /// compilation is disabled.
+  TieredCompileLayer *getTieredCompileLayer() { return TieredLayer.get(); }
+
   /// Returns a linker-mangled version of UnmangledName.
   std::string mangle(StringRef UnmangledName) const;
 
@@ -211,6 +216,9 @@ protected:
   std::unique_ptr<ObjectLayer> ObjLinkingLayer;
   std::unique_ptr<ObjectTransformLayer> ObjTransformLayer;
   std::unique_ptr<IRCompileLayer> CompileLayer;
+  std::unique_ptr<IRCompileLayer> OptCompileLayer;
+  std::unique_ptr<IRTransformLayer> OptTransformLayer;
+  std::unique_ptr<TieredCompileLayer> TieredLayer;
   std::unique_ptr<IRTransformLayer> TransformLayer;
   std::unique_ptr<IRTransformLayer> InitHelperTransformLayer;
 };
@@ -268,6 +276,7 @@ public:
   CompileFunctionCreator CreateCompileFunction;
   PlatformSetupFunction SetUpPlatform;
   unsigned NumCompileThreads = 0;
+  uint64_t TierUpThreshold = 0;
 
   /// Called prior to JIT class construcion to fix up defaults.
   Error prepareForConstruction();
@@ -361,6 +370,18 @@ public:
     return impl();
   }
 
+  /// Enable tiered compilation. Modules are compiled at -O0 first, and
+  /// recompiled with the default -O2 pipeline once their functions have been
+  /// entered TierUpThreshold times. See TieredCompileLayer. The JIT'd code
+  /// must run in-process.
+  ///
+  /// If this method is not called, or is called with a zero argument, every
+  /// module is compiled once with the target machine builder's settings.
+  SetterImpl &setTierUpThreshold(uint64_t TierUpThreshold) {
+    impl().TierUpThreshold = TierUpThreshold;
+    return impl();
+  }
+
   /// Set an ExecutorProcessControl object.
   ///
   /// If the platform uses ObjectLinkingLayer by default and no
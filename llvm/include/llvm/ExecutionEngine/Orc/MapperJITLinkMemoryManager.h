@@ -46,6 +46,11 @@ public:
   // synchronous overload
   using JITLinkMemoryManager::deallocate;
 
+  /// Reserve at least NumBytes of executor memory up front, so that the
+  /// allocations served from it do not wait for a reservation. Blocks until
+  /// the reservation is made.
+  Error preReserve(size_t NumBytes);
+
 private:
   class InFlightAlloc;
 
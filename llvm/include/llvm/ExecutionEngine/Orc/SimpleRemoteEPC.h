@@ -31,6 +31,14 @@ namespace orc {
 class SimpleRemoteEPC : public ExecutorProcessControl,
                         public SimpleRemoteEPCTransportClient {
 public:
+  /// Size of the executor memory reserved up front when sharing memory with
+  /// the executor.
+#ifdef _WIN32
+  static constexpr size_t DefaultSharedMemorySlabSize = 1024 * 1024;
+#else
+  static constexpr size_t DefaultSharedMemorySlabSize = 1024 * 1024 * 1024;
+#endif
+
   /// A setup object containing callbacks to construct a memory manager and
   /// memory access object. Both are optional. If not specified,
   /// EPCGenericJITLinkMemoryManager and EPCGenericMemoryAccess will be used.
@@ -43,6 +51,15 @@ public:
 
     unique_function<CreateMemoryManagerFn> CreateMemoryManager;
     unique_function<CreateMemoryAccessFn> CreateMemoryAccess;
+
+    /// If no CreateMemoryManager function is given, first try to share
+    /// memory with the executor, so that linked code and data are written in
+    /// place rather than copied over the channel. This requires the executor
+    /// to provide the ExecutorSharedMemoryMapperService and to run on the
+    /// same host. If the initial reservation of SharedMemorySlabSize bytes
+    /// fails, memory is managed through EPCGenericJITLinkMemoryManager.
+    bool PreferSharedMemory = true;
+    size_t SharedMemorySlabSize = DefaultSharedMemorySlabSize;
   };
 
   /// Create a SimpleRemoteEPC using the given transport type and args.
@@ -63,6 +80,12 @@ public:
     return std::move(SREPC);
   }
 
+  /// Create a MapperJITLinkMemoryManager that shares memory with the
+  /// executor through its ExecutorSharedMemoryMapperService, with SlabSize
+  /// bytes reserved up front.
+  static Expected<std::unique_ptr<jitlink::JITLinkMemoryManager>>
+  createSharedMemoryManager(SimpleRemoteEPC &SREPC, size_t SlabSize);
+
   SimpleRemoteEPC(const SimpleRemoteEPC &) = delete;
   SimpleRemoteEPC &operator=(const SimpleRemoteEPC &) = delete;
   SimpleRemoteEPC(SimpleRemoteEPC &&) = delete;
@@ -78,6 +78,29 @@ public:
   ResultTy operator()(Function &F);
 };
 
+// Likely next executables are the functions that were first called shortly
+// after F in earlier runs, as recorded in a SpeculationProfile. Functions the
+// profile knows nothing about are passed to the Fallback query, if any. Every
+// function gets an entry in the result, even with no likely callees, so that
+// its first call is recorded by the Speculator.
+//
+// GlobalPrefix is the data layout's global symbol prefix, which is stripped
+// from the linker-mangled profile names to get IR names.
+class ProfileQuery : public SpeculateQuery {
+public:
+  ProfileQuery(const SpeculationProfile &Profile, char GlobalPrefix,
+               IRSpeculationLayer::ResultEval Fallback = nullptr)
+      : Profile(Profile), GlobalPrefix(GlobalPrefix),
+        Fallback(std::move(Fallback)) {}
+
+  ResultTy operator()(Function &F);
+
+private:
+  const SpeculationProfile &Profile;
+  char GlobalPrefix;
+  IRSpeculationLayer::ResultEval Fallback;
+};
+
 } // namespace orc
 } // namespace llvm
 
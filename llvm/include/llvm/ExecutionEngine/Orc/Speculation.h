@@ -15,10 +15,15 @@
 
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/Optional.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ExecutionEngine/Orc/Core.h"
 #include "llvm/ExecutionEngine/Orc/DebugUtils.h"
 #include "llvm/ExecutionEngine/Orc/IRCompileLayer.h"
+#include "llvm/Support/Allocator.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/StringSaver.h"
+#include <deque>
 #include <mutex>
 #include <type_traits>
 #include <utility>
@@ -57,6 +62,42 @@ private:
   ImapTy Maps;
 };
 
+// Records which functions are called for the first time shortly after each
+// function is first called. Speculators fill it in at runtime, and it can be
+// saved and loaded again so that later runs can speculate on the functions
+// earlier runs actually needed. Names are linker-mangled symbol names.
+// Operations are guarded by a lock.
+class SpeculationProfile {
+public:
+  // A function called within this many first calls after another one is
+  // recorded as its successor.
+  static constexpr unsigned Window = 4;
+  // Number of successors kept per function.
+  static constexpr unsigned MaxSuccessors = 8;
+
+  // Record the first call of the function Name.
+  void recordFirstCall(StringRef Name);
+
+  // Returns the recorded successors of Name. The returned strings live as
+  // long as the profile.
+  SmallVector<StringRef, MaxSuccessors> getSuccessors(StringRef Name) const;
+
+  // Merge the profile saved in Path into this one.
+  Error load(StringRef Path);
+
+  // Write the profile to Path.
+  Error save(StringRef Path) const;
+
+private:
+  void addSuccessor(StringRef Name, StringRef Succ);
+
+  mutable std::mutex ConcurrentAccess;
+  BumpPtrAllocator Alloc;
+  UniqueStringSaver Saver{Alloc};
+  StringMap<SmallVector<StringRef, MaxSuccessors>> Successors;
+  std::deque<StringRef> Recent;
+};
+
 // Defines Speculator Concept,
 class Speculator {
 public:
@@ -64,11 +105,32 @@ public:
   using FunctionCandidatesMap = DenseMap<SymbolStringPtr, SymbolNameSet>;
   using StubAddrLikelies = DenseMap<TargetFAddr, SymbolNameSet>;
 
+  // Speculation counters. A hit is the first call of a function that was
+  // speculatively compiled before.
+  struct Stats {
+    uint64_t NumSpeculated = 0;
+    uint64_t NumFirstCalls = 0;
+    uint64_t NumHits = 0;
+  };
+
 private:
-  void registerSymbolsWithAddr(TargetFAddr ImplAddr,
+  void registerSymbolsWithAddr(TargetFAddr ImplAddr, SymbolStringPtr Name,
                                SymbolNameSet likelySymbols) {
     std::lock_guard<std::mutex> Lockit(ConcurrentAccess);
     GlobalSpecMap.insert({ImplAddr, std::move(likelySymbols)});
+    ImplNames.insert({ImplAddr, std::move(Name)});
+  }
+
+  void recordFirstCall(TargetFAddr FAddr) {
+    std::lock_guard<std::mutex> Lockit(ConcurrentAccess);
+    auto It = ImplNames.find(FAddr);
+    if (It == ImplNames.end())
+      return;
+    ++Counters.NumFirstCalls;
+    if (Speculated.count(It->second))
+      ++Counters.NumHits;
+    if (Profile)
+      Profile->recordFirstCall(*It->second);
   }
 
   void launchCompile(JITTargetAddress FAddr) {
@@ -96,6 +158,14 @@ private:
       SymbolsInJD.insert(ImplSymbolName);
     }
 
+    {
+      std::lock_guard<std::mutex> Lockit(ConcurrentAccess);
+      for (auto &I : SpeculativeLookUpImpls)
+        for (auto &N : I.second)
+          if (Speculated.insert(N).second)
+            ++Counters.NumSpeculated;
+    }
+
     DEBUG_WITH_TYPE("orc", {
       for (auto &I : SpeculativeLookUpImpls) {
         llvm::dbgs() << "\n In " << I.first->getName() << " JITDylib ";
@@ -134,7 +204,22 @@ public:
 
   // Speculatively compile likely functions for the given Stub Address.
   // destination of __orc_speculate_for jump
-  void speculateFor(TargetFAddr StubAddr) { launchCompile(StubAddr); }
+  void speculateFor(TargetFAddr StubAddr) {
+    recordFirstCall(StubAddr);
+    launchCompile(StubAddr);
+  }
+
+  // Record the order of first calls in Profile, which must outlive this
+  // Speculator.
+  void setProfile(SpeculationProfile *P) {
+    std::lock_guard<std::mutex> Lockit(ConcurrentAccess);
+    Profile = P;
+  }
+
+  Stats getStats() {
+    std::lock_guard<std::mutex> Lockit(ConcurrentAccess);
+    return Counters;
+  }
 
   // FIXME : Register with Stub Address, after JITLink Fix.
   void registerSymbols(FunctionCandidatesMap Candidates, JITDylib *JD) {
@@ -146,7 +231,7 @@ public:
                            this](Expected<SymbolMap> ReadySymbol) {
         if (ReadySymbol) {
           auto RAddr = (*ReadySymbol)[Target].getAddress();
-          registerSymbolsWithAddr(RAddr, std::move(Likely));
+          registerSymbolsWithAddr(RAddr, Target, std::move(Likely));
         } else
           this->getES().reportError(ReadySymbol.takeError());
       };
@@ -167,6 +252,10 @@ private:
   ImplSymbolMap &AliaseeImplTable;
   ExecutionSession &ES;
   StubAddrLikelies GlobalSpecMap;
+  DenseMap<TargetFAddr, SymbolStringPtr> ImplNames;
+  DenseSet<SymbolStringPtr> Speculated;
+  SpeculationProfile *Profile = nullptr;
+  Stats Counters;
 };
 
 class IRSpeculationLayer : public IRLayer {
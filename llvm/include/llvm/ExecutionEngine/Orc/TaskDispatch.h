@@ -13,6 +13,7 @@
 #ifndef LLVM_EXECUTIONENGINE_ORC_TASKDISPATCH_H
 #define LLVM_EXECUTIONENGINE_ORC_TASKDISPATCH_H
 
+#include "llvm/ADT/FunctionExtras.h"
 #include "llvm/Config/llvm-config.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/ExtensibleRTTI.h"
@@ -22,9 +23,14 @@
 #include <string>
 
 #if LLVM_ENABLE_THREADS
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
+#include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 #endif
 
 namespace llvm {
@@ -123,6 +129,81 @@ private:
   std::condition_variable OutstandingCV;
 };
 
+/// Runs tasks on a fixed number of threads.
+///
+/// Each thread has its own queues. Tasks dispatched from a worker thread are
+/// queued on that thread and run most-recent-first; other tasks are spread
+/// over the threads round-robin. Idle threads steal the oldest tasks from the
+/// others.
+///
+/// Tasks are sorted into priority lanes, and a thread only picks up work from
+/// a lane when every queue of the lanes before it is empty. By default, tasks
+/// that complete lookups or deliver results, which other threads may be
+/// blocked on, go ahead of materialization tasks.
+///
+/// Since the number of threads is bounded, tasks must not block waiting for
+/// work that is queued behind them.
+class WorkStealingTaskDispatcher : public TaskDispatcher {
+public:
+  enum Lane : unsigned { Urgent, Materialization, NumLanes };
+
+  /// Picks the lane of a task.
+  using LaneClassifier = unique_function<Lane(Task &)>;
+
+  /// Queueing statistics for one lane.
+  struct LaneStats {
+    uint64_t NumDispatched = 0;
+    size_t QueueDepth = 0;
+    size_t MaxQueueDepth = 0;
+    /// Time between dispatch and the start of the task.
+    std::chrono::nanoseconds TotalLatency{0};
+    std::chrono::nanoseconds MaxLatency{0};
+  };
+
+  /// Puts MaterializationTasks in the Materialization lane and every other
+  /// task in the Urgent lane.
+  static Lane classifyByTaskKind(Task &T);
+
+  WorkStealingTaskDispatcher(unsigned NumThreads,
+                             LaneClassifier Classify = classifyByTaskKind);
+  ~WorkStealingTaskDispatcher() override;
+
+  void dispatch(std::unique_ptr<Task> T) override;
+  void shutdown() override;
+
+  /// Returns a snapshot of the statistics for lane \p L.
+  LaneStats getStats(Lane L) const;
+
+private:
+  struct QueuedTask {
+    std::unique_ptr<Task> T;
+    std::chrono::steady_clock::time_point DispatchTime;
+  };
+
+  struct Worker {
+    std::mutex QueueMutex;
+    std::deque<QueuedTask> Queues[NumLanes];
+    std::thread Thread;
+  };
+
+  void runWorker(unsigned Idx);
+  bool takeTask(unsigned Idx, QueuedTask &QT, Lane &L);
+
+  LaneClassifier Classify;
+  std::vector<std::unique_ptr<Worker>> Workers;
+  std::atomic<unsigned> NextWorker{0};
+
+  std::mutex DispatchMutex;
+  std::condition_variable WorkAvailableCV;
+  std::condition_variable IdleCV;
+  size_t Queued = 0;
+  size_t Active = 0;
+  bool Running = true;
+
+  mutable std::mutex StatsMutex;
+  LaneStats Stats[NumLanes];
+};
+
 #endif // LLVM_ENABLE_THREADS
 
 } // End namespace orc
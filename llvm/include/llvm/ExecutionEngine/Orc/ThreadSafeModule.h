@@ -69,6 +69,20 @@ public:
     return Lock(S);
   }
 
+  /// Locks the context and calls the given function on it. This lets several
+  /// threads build IR in one shared context, each holding the lock while it
+  /// touches types, constants or modules of the context.
+  template <typename Func> decltype(auto) withContextDo(Func &&F) {
+    auto L = getLock();
+    return F(*S->Ctx);
+  }
+
+  /// Locks the context and calls the given function on it.
+  template <typename Func> decltype(auto) withContextDo(Func &&F) const {
+    auto L = getLock();
+    return F(*S->Ctx);
+  }
+
 private:
   std::shared_ptr<State> S;
 };
@@ -0,0 +1,106 @@
+//===- TieredCompileLayer.h - Recompile hot modules -------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// An IR layer that compiles modules quickly first and recompiles the ones
+// whose functions turn out to be hot with a more expensive pipeline.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_EXECUTIONENGINE_ORC_TIEREDCOMPILELAYER_H
+#define LLVM_EXECUTIONENGINE_ORC_TIEREDCOMPILELAYER_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ExecutionEngine/Orc/Core.h"
+#include "llvm/ExecutionEngine/Orc/IndirectionUtils.h"
+#include "llvm/ExecutionEngine/Orc/Layer.h"
+#include "llvm/ExecutionEngine/Orc/ThreadSafeModule.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace llvm {
+namespace orc {
+
+/// Two-tier compilation of IR modules.
+///
+/// Each module is emitted through the base layer (usually a compile layer
+/// running at -O0) with its externally visible function definitions renamed
+/// and instrumented with an entry counter that is shared by the module. The
+/// original function names are bound to indirect stubs that point at these
+/// baseline definitions, and all references from the baseline code go through
+/// the stubs. A copy of the module taken before instrumentation is kept aside.
+///
+/// Once the functions of a module have been entered TierUpThreshold times in
+/// total, the copy is handed to the optimizing layer on a separate task, and
+/// the stubs are repointed to the optimized definitions when they are ready.
+/// Calls already in progress finish in the baseline code.
+///
+/// The counters call back into this object directly, so the JIT'd code must
+/// run in the same process. Modules containing aliases or ifuncs are passed
+/// to the base layer unchanged. Modules that have been tiered up stay
+/// resident until the session ends, even if their resource tracker is removed.
+class TieredCompileLayer : public IRLayer {
+public:
+  /// Builder for IndirectStubsManagers.
+  using IndirectStubsManagerBuilder =
+      std::function<std::unique_ptr<IndirectStubsManager>()>;
+
+  /// Construct a TieredCompileLayer that emits baseline code through
+  /// BaseLayer and optimized code through OptimizingLayer.
+  TieredCompileLayer(ExecutionSession &ES, IRLayer &BaseLayer,
+                     IRLayer &OptimizingLayer,
+                     IndirectStubsManagerBuilder BuildIndirectStubsManager,
+                     uint64_t TierUpThreshold);
+
+  /// Emits the given module. This should not be called by clients: it will be
+  /// called by the JIT when a definition added via the add method is requested.
+  void emit(std::unique_ptr<MaterializationResponsibility> R,
+            ThreadSafeModule TSM) override;
+
+  /// Returns the number of modules that have been handed to the optimizing
+  /// layer.
+  uint64_t getNumTieredUpModules() const;
+
+private:
+  /// A module waiting for its counter to reach the threshold.
+  struct PendingModule {
+    ThreadSafeModule Tier1;
+    JITDylib *JD = nullptr;
+    /// Pairs of stub names and the optimized definitions they should point
+    /// to after tier-up.
+    std::vector<std::pair<SymbolStringPtr, SymbolStringPtr>> Stubs;
+  };
+
+  static void tierUpEntryPoint(TieredCompileLayer *Layer, uint64_t ModuleKey);
+
+  void tierUp(uint64_t ModuleKey);
+
+  void emitTier1(PendingModule PM);
+
+  IndirectStubsManager &getStubsManager(JITDylib &JD);
+
+  mutable std::mutex TieredLayerMutex;
+
+  IRLayer &BaseLayer;
+  IRLayer &OptimizingLayer;
+  IndirectStubsManagerBuilder BuildIndirectStubsManager;
+  uint64_t TierUpThreshold;
+
+  std::map<const JITDylib *, std::unique_ptr<IndirectStubsManager>> Stubs;
+  DenseMap<uint64_t, PendingModule> Pending;
+  uint64_t NextModuleKey = 0;
+  uint64_t NumTieredUp = 0;
+};
+
+} // end namespace orc
+} // end namespace llvm
+
+#endif // LLVM_EXECUTIONENGINE_ORC_TIEREDCOMPILELAYER_H
@@ -46,10 +46,12 @@
 #include "llvm/IR/Module.h"
 #include "llvm/IR/PassInstrumentation.h"
 #include "llvm/IR/PassManagerInternal.h"
+#include "llvm/Support/Threading.h"
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/TypeName.h"
 #include <cassert>
 #include <cstring>
+#include <functional>
 #include <iterator>
 #include <list>
 #include <memory>
@@ -1190,11 +1192,23 @@ using ModuleAnalysisManagerFunctionProxy =
 /// Note that although function passes can access module analyses, module
 /// analyses are not invalidated while the function passes are running, so they
 /// may be stale.  Function analyses will not be stale.
+///
+/// The adaptor can optionally run the function pipeline on several functions
+/// at once, see \c createParallelModuleToFunctionPassAdaptor. This is only
+/// correct for pipelines that are strictly function-local: besides the rules
+/// above, they must not create constants, globals, types or uniqued metadata,
+/// since the LLVMContext is not thread-safe.
 class ModuleToFunctionPassAdaptor
     : public PassInfoMixin<ModuleToFunctionPassAdaptor> {
 public:
   using PassConceptT = detail::PassConcept<Function, FunctionAnalysisManager>;
 
+  /// Creates a fresh instance of the function pipeline for a worker thread.
+  using PassFactoryT = std::function<std::unique_ptr<PassConceptT>()>;
+
+  /// Registers the function analyses on a worker thread's analysis manager.
+  using AnalysisRegistrationT = std::function<void(FunctionAnalysisManager &)>;
+
   explicit ModuleToFunctionPassAdaptor(std::unique_ptr<PassConceptT> Pass,
                                        bool EagerlyInvalidate)
       : Pass(std::move(Pass)), EagerlyInvalidate(EagerlyInvalidate) {}
@@ -1204,11 +1218,31 @@ public:
   void printPipeline(raw_ostream &OS,
                      function_ref<StringRef(StringRef)> MapClassName2PassName);
 
+  /// Run the function pipeline on up to \p Strategy threads. Each thread gets
+  /// its own pipeline from \p MakePass and its own FunctionAnalysisManager,
+  /// populated by \p RegisterAnalyses. The module analysis manager proxy is
+  /// registered on those analysis managers by the adaptor.
+  void setParallel(PassFactoryT MakePass,
+                   AnalysisRegistrationT RegisterAnalyses,
+                   ThreadPoolStrategy Strategy = hardware_concurrency()) {
+    this->MakePass = std::move(MakePass);
+    this->RegisterAnalyses = std::move(RegisterAnalyses);
+    this->Strategy = Strategy;
+  }
+
+  bool isParallel() const { return bool(MakePass); }
+
   static bool isRequired() { return true; }
 
 private:
+  PreservedAnalyses runParallel(Module &M, ModuleAnalysisManager &AM);
+
   std::unique_ptr<PassConceptT> Pass;
   bool EagerlyInvalidate;
+
+  PassFactoryT MakePass;
+  AnalysisRegistrationT RegisterAnalyses;
+  ThreadPoolStrategy Strategy;
 };
 
 /// A function to deduce a function pass type and wrap it in the
@@ -1228,6 +1262,35 @@ createModuleToFunctionPassAdaptor(FunctionPassT &&Pass,
       EagerlyInvalidate);
 }
 
+/// Wrap a function pass type in an adaptor that runs it on several functions
+/// concurrently.
+///
+/// \p MakePass is called once per worker thread and must return a new
+/// instance of the pipeline, and \p RegisterAnalyses is called on each worker
+/// thread's FunctionAnalysisManager. Instrumentation callbacks reachable from
+/// those analysis managers must be thread-safe.
+template <typename FunctionPassT>
+ModuleToFunctionPassAdaptor createParallelModuleToFunctionPassAdaptor(
+    std::function<FunctionPassT()> MakePass,
+    ModuleToFunctionPassAdaptor::AnalysisRegistrationT RegisterAnalyses,
+    ThreadPoolStrategy Strategy = hardware_concurrency(),
+    bool EagerlyInvalidate = false) {
+  using PassModelT =
+      detail::PassModel<Function, FunctionPassT, PreservedAnalyses,
+                        FunctionAnalysisManager>;
+  ModuleToFunctionPassAdaptor Adaptor(
+      std::unique_ptr<ModuleToFunctionPassAdaptor::PassConceptT>(
+          new PassModelT(MakePass())),
+      EagerlyInvalidate);
+  Adaptor.setParallel(
+      [MakePass = std::move(MakePass)] {
+        return std::unique_ptr<ModuleToFunctionPassAdaptor::PassConceptT>(
+            new PassModelT(MakePass()));
+      },
+      std::move(RegisterAnalyses), Strategy);
+  return Adaptor;
+}
+
 /// A utility pass template to force an analysis result to be available.
 ///
 /// If there are extra arguments at the pass's run level there may also be
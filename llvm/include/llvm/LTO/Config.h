@@ -166,6 +166,13 @@ struct Config {
   /// Specific thinLTO modules to compile.
   std::vector<std::string> ThinLTOModulesToCompile;
 
+  /// If non-zero, the in-process ThinLTO backend keeps the memory of its
+  /// concurrent backend jobs under this many bytes: it orders the jobs by
+  /// their predicted memory use, and waits for running jobs to finish before
+  /// starting one that would go over the budget, or while the heap is
+  /// already larger than the budget.
+  uint64_t ThinLTOMemoryBudget = 0;
+
   /// Time trace enabled.
   bool TimeTraceEnabled = false;
 
@@ -253,6 +260,13 @@ struct Config {
       const DenseSet<GlobalValue::GUID> &GUIDPreservedSymbols)>;
   CombinedIndexHookFn CombinedIndexHook;
 
+  /// This hook is called by the in-process ThinLTO backend with the cache key
+  /// of each backend job as soon as the job is scheduled, before it runs. A
+  /// remote cache can use it to start fetching the entries that will be looked
+  /// up (see RemoteCacheStore::prefetch). When it is set, the cache keys are
+  /// computed on the thread that schedules the jobs.
+  std::function<void(StringRef Key)> CachePrefetchHook;
+
   /// This is a convenience function that configures this Config object to write
   /// temporary files named after the given OutputFileName for each of the LTO
   /// phases to disk. A client can use this function to implement -save-temps.
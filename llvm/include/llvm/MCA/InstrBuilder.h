@@ -93,6 +93,7 @@ class InstrBuilder {
   InstrBuilder(const InstrBuilder &) = delete;
   InstrBuilder &operator=(const InstrBuilder &) = delete;
 
+  void warnAboutCallsAndReturns(const MCInstrDesc &MCDesc);
   void populateWrites(InstrDesc &ID, const MCInst &MCI, unsigned SchedClassID);
   void populateReads(InstrDesc &ID, const MCInst &MCI, unsigned SchedClassID);
   Error verifyInstrDesc(const InstrDesc &ID, const MCInst &MCI) const;
@@ -109,6 +110,15 @@ public:
     FirstReturnInst = true;
   }
 
+  /// Report the warnings about calls and return instructions again for the
+  /// next instructions created. Unlike clear(), this keeps the instruction
+  /// descriptors built so far, which stay valid as long as the MCInsts they
+  /// were created from.
+  void resetWarnings() {
+    FirstCallInst = true;
+    FirstReturnInst = true;
+  }
+
   /// Set a callback which is invoked to retrieve a recycled mca::Instruction
   /// or null if there isn't any.
   void setInstRecycleCallback(InstRecycleCallback CB) { InstRecycleCB = CB; }
@@ -584,6 +584,10 @@ class CoverageMapping {
   Error loadFunctionRecord(const CoverageMappingRecord &Record,
                            IndexedInstrProfReader &ProfileReader);
 
+  /// Add \p Function unless a function with the same name and files has
+  /// already been added.
+  void addFunctionRecord(FunctionRecord &&Function);
+
   /// Look up the indices for function records which are at least partially
   /// defined in the specified file. This is guaranteed to return a superset of
   /// such records: extra records not in the file may be included if there is
@@ -603,9 +607,13 @@ public:
   /// Load the coverage mapping from the given object files and profile. If
   /// \p Arches is non-empty, it must specify an architecture for each object.
   /// Ignores non-instrumented object files unless all are not instrumented.
+  /// The objects are decoded on up to \p NumThreads threads, where 0 means
+  /// one thread per object up to the number of cores. The result does not
+  /// depend on the number of threads.
   static Expected<std::unique_ptr<CoverageMapping>>
   load(ArrayRef<StringRef> ObjectFilenames, StringRef ProfileFilename,
-       ArrayRef<StringRef> Arches = None, StringRef CompilationDir = "");
+       ArrayRef<StringRef> Arches = None, StringRef CompilationDir = "",
+       unsigned NumThreads = 1);
 
   /// The number of functions that couldn't have their profiles mapped.
   ///
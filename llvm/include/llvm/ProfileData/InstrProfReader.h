@@ -15,6 +15,7 @@
 #define LLVM_PROFILEDATA_INSTRPROFREADER_H
 
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/IR/ProfileSummary.h"
 #include "llvm/ProfileData/InstrProf.h"
@@ -479,6 +480,10 @@ struct InstrProfReaderIndexBase {
   // Read all the profile records with the key equal to FuncName
   virtual Error getRecords(StringRef FuncName,
                                      ArrayRef<NamedInstrProfRecord> &Data) = 0;
+
+  // Return the index of the on-disk hash table bucket FuncName belongs to.
+  // Buckets are laid out in index order in the file.
+  virtual uint64_t getBucketIndex(StringRef FuncName) = 0;
   virtual void advanceToNextKey() = 0;
   virtual bool atEnd() const = 0;
   virtual void setValueProfDataEndianness(support::endianness Endianness) = 0;
@@ -523,6 +528,10 @@ public:
   Error getRecords(ArrayRef<NamedInstrProfRecord> &Data) override;
   Error getRecords(StringRef FuncName,
                    ArrayRef<NamedInstrProfRecord> &Data) override;
+  uint64_t getBucketIndex(StringRef FuncName) override {
+    return HashTable->getInfoObj().ComputeHash(FuncName) &
+           (HashTable->getNumBuckets() - 1);
+  }
   void advanceToNextKey() override { RecordIterator++; }
 
   bool atEnd() const override {
@@ -599,6 +608,8 @@ private:
 
   // Index to the current record in the record array.
   unsigned RecordIndex;
+  /// Records read ahead by prefetchRecords(), keyed by function name.
+  StringMap<std::vector<NamedInstrProfRecord>> PrefetchedRecords;
 
   // Read the profile summary. Return a pointer pointing to one byte past the
   // end of the summary data if it exists or the input \c Cur.
@@ -657,6 +668,13 @@ public:
   getInstrProfRecord(StringRef FuncName, uint64_t FuncHash,
                      uint64_t *MismatchedFuncSum = nullptr);
 
+  /// Read the records of all \p FuncNames ahead of time, so that later calls
+  /// to getInstrProfRecord for them do not go back to the file. The on-disk
+  /// hash table is visited in bucket order, which touches only the pages
+  /// holding these functions and does so front to back. Names that are not
+  /// in the profile are skipped.
+  Error prefetchRecords(ArrayRef<StringRef> FuncNames);
+
   /// Return the memprof record for the function identified by
   /// llvm::md5(Name).
   Expected<memprof::MemProfRecord> getMemProfRecord(uint64_t FuncNameHash);
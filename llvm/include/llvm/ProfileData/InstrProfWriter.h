@@ -16,6 +16,7 @@
 
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/MapVector.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/IR/GlobalValue.h"
 #include "llvm/ProfileData/InstrProf.h"
@@ -41,6 +42,10 @@ private:
   bool Sparse;
   StringMap<ProfilingData> FunctionData;
 
+  // Writers holding the records of functions that are not in FunctionData.
+  // Their records are written out together with ours.
+  SmallVector<InstrProfWriter *, 0> Partitions;
+
   // A map to hold memprof data per function. The lower 64 bits obtained from
   // the md5 hash of the function name is used to index into the map.
   llvm::MapVector<GlobalValue::GUID, memprof::IndexedMemProfRecord>
@@ -83,6 +88,16 @@ public:
   void mergeRecordsFromWriter(InstrProfWriter &&IPW,
                               function_ref<void(Error)> Warn);
 
+  /// Write the function records of \p Partition together with the ones of
+  /// this writer, without merging them. The function names in \p Partition
+  /// must be disjoint from the ones in this writer and in the partitions
+  /// added before, and \p Partition must stay alive until the profile is
+  /// written. Its MemProf data is merged into this writer. An error is
+  /// returned if the profile kinds cannot be merged; a partition without a
+  /// profile kind takes the kind of this writer.
+  Error addPartition(InstrProfWriter &Partition,
+                     function_ref<void(Error)> Warn);
+
   /// Write the profile to \c OS
   Error write(raw_fd_ostream &OS);
 
@@ -151,6 +166,11 @@ private:
   void addRecord(StringRef Name, uint64_t Hash, InstrProfRecord &&I,
                  uint64_t Weight, function_ref<void(Error)> Warn);
   bool shouldEncodeData(const ProfilingData &PD);
+  void mergeMemProfFromWriter(InstrProfWriter &IPW,
+                              function_ref<void(Error)> Warn);
+  /// Call \p Fn for the functions of this writer and of its partitions.
+  void forEachFunction(
+      function_ref<void(const StringMapEntry<ProfilingData> &)> Fn) const;
 
   Error writeImpl(ProfOStream &OS);
 };
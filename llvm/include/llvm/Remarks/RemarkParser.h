@@ -13,10 +13,12 @@
 #ifndef LLVM_REMARKS_REMARKPARSER_H
 #define LLVM_REMARKS_REMARKPARSER_H
 
+#include "llvm/ADT/Optional.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Remarks/RemarkFormat.h"
 #include "llvm/Support/Error.h"
 #include <memory>
+#include <string>
 
 namespace llvm {
 namespace remarks {
@@ -41,9 +43,21 @@ struct RemarkParser {
   Format ParserFormat;
   /// Path to prepend when opening an external remark file.
   std::string ExternalFilePrependPath;
+  /// If set, next() only returns the remarks emitted by this pass.
+  Optional<std::string> PassNameFilter;
+  /// If set, next() only returns the remarks about this function.
+  Optional<std::string> FunctionNameFilter;
 
   RemarkParser(Format ParserFormat) : ParserFormat(ParserFormat) {}
 
+  /// \returns true if a remark emitted by \p PassName about \p FunctionName
+  /// passes the filters above. Parsers check this as early as they can, so
+  /// that the remarks that are filtered out are not fully built.
+  bool matchesFilters(StringRef PassName, StringRef FunctionName) const {
+    return (!PassNameFilter || PassName == *PassNameFilter) &&
+           (!FunctionNameFilter || FunctionName == *FunctionNameFilter);
+  }
+
   /// If no error occurs, this returns a valid Remark object.
   /// If an error of type EndOfFileError occurs, it is safe to recover from it
   /// by stopping the parsing.
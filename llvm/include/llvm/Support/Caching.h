@@ -8,14 +8,20 @@
 //
 // This file defines the CachedFileStream and the localCache function, which
 // simplifies caching files on the local filesystem in a directory whose
-// contents are managed by a CachePruningPolicy.
+// contents are managed by a CachePruningPolicy. It also defines the
+// RemoteCacheStore interface and the remoteCache function, which put a store
+// shared between machines behind a local cache.
 //
 //===----------------------------------------------------------------------===//
 
 #ifndef LLVM_SUPPORT_CACHING_H
 #define LLVM_SUPPORT_CACHING_H
 
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Support/Error.h"
+#include <future>
+#include <memory>
+#include <mutex>
 
 namespace llvm {
 
@@ -71,6 +77,57 @@ Expected<FileCache> localCache(
     Twine CacheNameRef, Twine TempFilePrefixRef, Twine CacheDirectoryPathRef,
     AddBufferFn AddBuffer = [](size_t Task, std::unique_ptr<MemoryBuffer> MB) {
     });
+
+/// A store of cache entries that is shared between machines, such as a
+/// network service or a directory on a shared file system. Entries are keyed
+/// by the same keys as a FileCache.
+///
+/// The store is accessed asynchronously, so that entries can be fetched ahead
+/// of the lookups that need them. Implementations must be thread safe. A store
+/// does not report errors: one that cannot be reached simply misses, and the
+/// entry is then produced locally.
+class RemoteCacheStore {
+public:
+  using EntryFuture = std::shared_future<std::shared_ptr<MemoryBuffer>>;
+
+  virtual ~RemoteCacheStore() = default;
+
+  /// Start fetching the entry for \p Key. The result is null on a miss.
+  virtual EntryFuture get(StringRef Key) = 0;
+
+  /// Start storing \p Data as the entry for \p Key.
+  virtual void put(StringRef Key, std::unique_ptr<MemoryBuffer> Data) = 0;
+
+  /// Wait until the entries passed to put() have been stored.
+  virtual void wait() = 0;
+
+  /// Start fetching the entry for \p Key, which is known to be looked up
+  /// later.
+  void prefetch(StringRef Key);
+
+  /// Get the entry for \p Key, using the prefetched one if there is one.
+  EntryFuture fetch(StringRef Key);
+
+  /// Drop the prefetched entry for \p Key, if any, when it is no longer
+  /// needed.
+  void dropPrefetched(StringRef Key);
+
+private:
+  std::mutex PrefetchedMu;
+  StringMap<EntryFuture> Prefetched;
+};
+
+/// Create a RemoteCacheStore that keeps its entries in \p DirectoryPath, which
+/// would typically be on a file system shared between machines. Reads and
+/// writes are done on a small pool of threads.
+std::unique_ptr<RemoteCacheStore> directoryCacheStore(Twine DirectoryPath);
+
+/// Put \p Remote behind \p LocalCache. Lookups go to the local cache first; on
+/// a local miss, the entry is fetched from the remote store and added to the
+/// local cache, which adds it to the link. Entries that are produced because
+/// both caches missed are added to the local cache and stored remotely.
+FileCache remoteCache(FileCache LocalCache,
+                      std::shared_ptr<RemoteCacheStore> Remote);
 } // namespace llvm
 
 #endif
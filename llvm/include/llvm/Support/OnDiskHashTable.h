@@ -22,6 +22,7 @@
 #include "llvm/Support/raw_ostream.h"
 #include <cassert>
 #include <cstdlib>
+#include <vector>
 
 namespace llvm {
 
@@ -611,6 +612,365 @@ public:
   }
 };
 
+/// Generates an on disk hash table that resolves collisions by linear probing.
+///
+/// The table produced by OnDiskChainedHashTableGenerator stores the hashes
+/// next to the items, so a lookup has to chase the bucket offset and read
+/// through the items of the bucket before it can reject a key. This table
+/// instead stores a fixed-width slot per bucket holding the full hash and the
+/// offset of the item, so a lookup scans adjacent slots and only touches the
+/// payload once the hash matches.
+///
+/// The generator takes the same \c Info as OnDiskChainedHashTableGenerator.
+/// The resulting table is read with OnDiskOpenAddressingHashTable.
+template <typename Info> class OnDiskOpenAddressingHashTableGenerator {
+  typedef typename Info::offset_type offset_type;
+  typedef typename Info::hash_value_type hash_value_type;
+
+  struct Item {
+    typename Info::key_type Key;
+    typename Info::data_type Data;
+    const hash_value_type Hash;
+    offset_type Off = 0;
+
+    Item(typename Info::key_type_ref Key, typename Info::data_type_ref Data,
+         Info &InfoObj)
+        : Key(Key), Data(Data), Hash(InfoObj.ComputeHash(Key)) {}
+  };
+
+  /// The items in insertion order, which is also the order of the payload.
+  std::vector<Item> Items;
+
+public:
+  /// Insert an entry into the table.
+  void insert(typename Info::key_type_ref Key,
+              typename Info::data_type_ref Data) {
+    Info InfoObj;
+    insert(Key, Data, InfoObj);
+  }
+
+  /// Insert an entry into the table.
+  ///
+  /// Uses the provided Info instead of a stack allocated one.
+  void insert(typename Info::key_type_ref Key,
+              typename Info::data_type_ref Data, Info &InfoObj) {
+    Items.emplace_back(Key, Data, InfoObj);
+  }
+
+  /// Determine whether an entry has been inserted.
+  bool contains(typename Info::key_type_ref Key, Info &InfoObj) {
+    hash_value_type Hash = InfoObj.ComputeHash(Key);
+    for (const Item &I : Items)
+      if (I.Hash == Hash && InfoObj.EqualKey(I.Key, Key))
+        return true;
+    return false;
+  }
+
+  /// Emit the table to Out, which must not be at offset 0.
+  offset_type Emit(raw_ostream &Out) {
+    Info InfoObj;
+    return Emit(Out, InfoObj);
+  }
+
+  /// Emit the table to Out, which must not be at offset 0.
+  ///
+  /// Uses the provided Info instead of a stack allocated one.
+  offset_type Emit(raw_ostream &Out, Info &InfoObj) {
+    using namespace llvm::support;
+    endian::Writer LE(Out, little);
+
+    // Emit the payload of the table.
+    for (Item &I : Items) {
+      I.Off = Out.tell();
+      assert(I.Off && "Cannot write an item at offset 0. Please add padding.");
+
+      const std::pair<offset_type, offset_type> &Len =
+          InfoObj.EmitKeyDataLength(Out, I.Key, I.Data);
+#ifdef NDEBUG
+      InfoObj.EmitKey(Out, I.Key, Len.first);
+      InfoObj.EmitData(Out, I.Key, I.Data, Len.second);
+#else
+      // In asserts mode, check that the users length matches the data they
+      // wrote.
+      uint64_t KeyStart = Out.tell();
+      InfoObj.EmitKey(Out, I.Key, Len.first);
+      uint64_t DataStart = Out.tell();
+      InfoObj.EmitData(Out, I.Key, I.Data, Len.second);
+      uint64_t End = Out.tell();
+      assert(offset_type(DataStart - KeyStart) == Len.first &&
+             "key length does not match bytes written");
+      assert(offset_type(End - DataStart) == Len.second &&
+             "data length does not match bytes written");
+#endif
+    }
+
+    // Keep the load factor at or below 3/4. This also guarantees at least
+    // one empty slot, which terminates unsuccessful lookups.
+    offset_type NumEntries = Items.size();
+    offset_type NumSlots = NextPowerOf2(NumEntries * 4 / 3);
+    std::vector<const Item *> Slots(NumSlots);
+    for (const Item &I : Items) {
+      offset_type Idx = I.Hash & (NumSlots - 1);
+      while (Slots[Idx])
+        Idx = (Idx + 1) & (NumSlots - 1);
+      Slots[Idx] = &I;
+    }
+
+    // Pad with zeros so that we can start the slots at an aligned address.
+    offset_type TableOff = Out.tell();
+    uint64_t N = offsetToAlignment(TableOff, Align(alignof(offset_type)));
+    TableOff += N;
+    while (N--)
+      LE.write<uint8_t>(0);
+
+    // Emit the slots. Empty slots have an offset of 0.
+    LE.write<offset_type>(NumSlots);
+    LE.write<offset_type>(NumEntries);
+    for (const Item *I : Slots) {
+      LE.write<hash_value_type>(I ? I->Hash : 0);
+      LE.write<offset_type>(I ? I->Off : 0);
+    }
+
+    return TableOff;
+  }
+};
+
+/// Provides lookup and iteration over an on disk hash table produced by
+/// OnDiskOpenAddressingHashTableGenerator.
+///
+/// This takes the same \c Info as OnDiskChainedHashTable and provides the
+/// interface of OnDiskIterableChainedHashTable.
+template <typename Info> class OnDiskOpenAddressingHashTable {
+public:
+  typedef Info InfoType;
+  typedef typename Info::internal_key_type internal_key_type;
+  typedef typename Info::external_key_type external_key_type;
+  typedef typename Info::data_type data_type;
+  typedef typename Info::hash_value_type hash_value_type;
+  typedef typename Info::offset_type offset_type;
+
+  /// The result of a lookup, which is the same as for the chained table.
+  typedef typename OnDiskChainedHashTable<Info>::iterator iterator;
+
+private:
+  const offset_type NumSlots;
+  const offset_type NumEntries;
+  const unsigned char *const Slots;
+  const unsigned char *const Payload;
+  const unsigned char *const Base;
+  Info InfoObj;
+
+  static constexpr size_t SlotSize =
+      sizeof(hash_value_type) + sizeof(offset_type);
+
+  /// Iterates over all of the items in the payload.
+  class iterator_base {
+    const unsigned char *Ptr;
+    offset_type NumEntriesLeft;
+
+  public:
+    iterator_base(const unsigned char *const Ptr, offset_type NumEntries)
+        : Ptr(Ptr), NumEntriesLeft(NumEntries) {}
+    iterator_base() : Ptr(nullptr), NumEntriesLeft(0) {}
+
+    friend bool operator==(const iterator_base &X, const iterator_base &Y) {
+      return X.NumEntriesLeft == Y.NumEntriesLeft;
+    }
+    friend bool operator!=(const iterator_base &X, const iterator_base &Y) {
+      return X.NumEntriesLeft != Y.NumEntriesLeft;
+    }
+
+    /// Move to the next item.
+    void advance() {
+      const std::pair<offset_type, offset_type> &L =
+          Info::ReadKeyDataLength(Ptr);
+      Ptr += L.first + L.second;
+      assert(NumEntriesLeft);
+      --NumEntriesLeft;
+    }
+
+    /// Get the start of the item as written by the trait (immediately before
+    /// the key and value length).
+    const unsigned char *getItem() const { return Ptr; }
+  };
+
+public:
+  OnDiskOpenAddressingHashTable(offset_type NumSlots, offset_type NumEntries,
+                                const unsigned char *Slots,
+                                const unsigned char *Payload,
+                                const unsigned char *Base,
+                                const Info &InfoObj = Info())
+      : NumSlots(NumSlots), NumEntries(NumEntries), Slots(Slots),
+        Payload(Payload), Base(Base), InfoObj(InfoObj) {
+    assert(isPowerOf2_64(NumSlots) && NumSlots > NumEntries &&
+           "table must have a power of two slots and an empty one");
+  }
+
+  offset_type getNumSlots() const { return NumSlots; }
+  offset_type getNumEntries() const { return NumEntries; }
+  const unsigned char *getBase() const { return Base; }
+  const unsigned char *getSlots() const { return Slots; }
+
+  bool isEmpty() const { return NumEntries == 0; }
+
+  /// Look up the stored data for a particular key.
+  iterator find(const external_key_type &EKey, Info *InfoPtr = nullptr) {
+    const internal_key_type &IKey = InfoObj.GetInternalKey(EKey);
+    hash_value_type KeyHash = InfoObj.ComputeHash(IKey);
+    return find_hashed(IKey, KeyHash, InfoPtr);
+  }
+
+  /// Look up the stored data for a particular key with a known hash.
+  iterator find_hashed(const internal_key_type &IKey, hash_value_type KeyHash,
+                       Info *InfoPtr = nullptr) {
+    using namespace llvm::support;
+
+    if (!InfoPtr)
+      InfoPtr = &InfoObj;
+
+    // Probe the slots until we find the key or an empty slot. Only slots with
+    // a matching hash need to look at the payload.
+    for (offset_type Idx = KeyHash & (NumSlots - 1);;
+         Idx = (Idx + 1) & (NumSlots - 1)) {
+      const unsigned char *Slot = Slots + SlotSize * Idx;
+      hash_value_type SlotHash =
+          endian::readNext<hash_value_type, little, unaligned>(Slot);
+      offset_type Offset = endian::readNext<offset_type, little, unaligned>(Slot);
+      if (Offset == 0)
+        return iterator(); // Empty slot.
+      if (SlotHash != KeyHash)
+        continue;
+
+      const unsigned char *Item = Base + Offset;
+      const std::pair<offset_type, offset_type> &L =
+          Info::ReadKeyDataLength(Item);
+      const internal_key_type &X =
+          InfoPtr->ReadKey((const unsigned char *const)Item, L.first);
+      if (InfoPtr->EqualKey(X, IKey))
+        return iterator(X, Item + L.first, L.second, InfoPtr);
+    }
+  }
+
+  iterator end() const { return iterator(); }
+
+  Info &getInfoObj() { return InfoObj; }
+
+  /// Iterates over all of the keys in the table.
+  class key_iterator : public iterator_base {
+    Info *InfoObj;
+
+  public:
+    typedef external_key_type value_type;
+
+    key_iterator(const unsigned char *const Ptr, offset_type NumEntries,
+                 Info *InfoObj)
+        : iterator_base(Ptr, NumEntries), InfoObj(InfoObj) {}
+    key_iterator() : iterator_base(), InfoObj() {}
+
+    key_iterator &operator++() {
+      this->advance();
+      return *this;
+    }
+    key_iterator operator++(int) { // Postincrement
+      key_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    internal_key_type getInternalKey() const {
+      auto *LocalPtr = this->getItem();
+
+      // Determine the length of the key and the data.
+      auto L = Info::ReadKeyDataLength(LocalPtr);
+
+      // Read the key.
+      return InfoObj->ReadKey(LocalPtr, L.first);
+    }
+
+    value_type operator*() const {
+      return InfoObj->GetExternalKey(getInternalKey());
+    }
+  };
+
+  key_iterator key_begin() {
+    return key_iterator(Payload, NumEntries, &InfoObj);
+  }
+  key_iterator key_end() { return key_iterator(); }
+
+  iterator_range<key_iterator> keys() {
+    return make_range(key_begin(), key_end());
+  }
+
+  /// Iterates over all the entries in the table, returning the data.
+  class data_iterator : public iterator_base {
+    Info *InfoObj;
+
+  public:
+    typedef data_type value_type;
+
+    data_iterator(const unsigned char *const Ptr, offset_type NumEntries,
+                  Info *InfoObj)
+        : iterator_base(Ptr, NumEntries), InfoObj(InfoObj) {}
+    data_iterator() : iterator_base(), InfoObj() {}
+
+    data_iterator &operator++() { // Preincrement
+      this->advance();
+      return *this;
+    }
+    data_iterator operator++(int) { // Postincrement
+      data_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    value_type operator*() const {
+      auto *LocalPtr = this->getItem();
+
+      // Determine the length of the key and the data.
+      auto L = Info::ReadKeyDataLength(LocalPtr);
+
+      // Read the key.
+      const internal_key_type &Key = InfoObj->ReadKey(LocalPtr, L.first);
+      return InfoObj->ReadData(Key, LocalPtr + L.first, L.second);
+    }
+  };
+
+  data_iterator data_begin() {
+    return data_iterator(Payload, NumEntries, &InfoObj);
+  }
+  data_iterator data_end() { return data_iterator(); }
+
+  iterator_range<data_iterator> data() {
+    return make_range(data_begin(), data_end());
+  }
+
+  /// Create the hash table.
+  ///
+  /// \param Slots is the beginning of the hash table itself, which follows
+  /// the payload of entire structure. This is the value returned by
+  /// OnDiskOpenAddressingHashTableGenerator::Emit.
+  ///
+  /// \param Payload is the beginning of the data contained in the table, ie,
+  /// the offset that the stream was at when calling Emit.
+  ///
+  /// \param Base is the point from which all offsets into the structure are
+  /// based. This is offset 0 in the stream that was used when Emitting the
+  /// table.
+  static OnDiskOpenAddressingHashTable *
+  Create(const unsigned char *Slots, const unsigned char *const Payload,
+         const unsigned char *const Base, const Info &InfoObj = Info()) {
+    assert(Slots > Base);
+    assert((reinterpret_cast<uintptr_t>(Slots) & 0x3) == 0 &&
+           "slots should be 4-byte aligned.");
+    using namespace llvm::support;
+    offset_type NumSlots = endian::readNext<offset_type, little, aligned>(Slots);
+    offset_type NumEntries =
+        endian::readNext<offset_type, little, aligned>(Slots);
+    return new OnDiskOpenAddressingHashTable<Info>(NumSlots, NumEntries, Slots,
+                                                   Payload, Base, InfoObj);
+  }
+};
+
 } // end namespace llvm
 
 #endif
@@ -55,6 +55,12 @@
 // Each new thread should begin with a timeTraceProfilerInitialize, and
 // finish with a timeTraceProfilerFinishThread call.
 //
+// A client that allocates from an arena can also attribute memory to the
+// events of a thread with timeTraceProfilerSetMemoryCounter. The events then
+// record the bytes allocated while they were open, and the trace includes
+// 'Top memory' entries for the name and detail pairs that allocated the most
+// themselves, i.e. not counting the events nested in them.
+//
 // Timestamps come from std::chrono::stable_clock. Note that threads need
 // not see the same time from that clock, and the resolution may not be
 // the best available.
@@ -78,6 +84,8 @@
 
 #include "llvm/ADT/STLFunctionalExtras.h"
 #include "llvm/Support/Error.h"
+#include <cstdint>
+#include <functional>
 
 namespace llvm {
 
@@ -127,6 +135,12 @@ void timeTraceProfilerBegin(StringRef Name,
 /// Manually end the last time section.
 void timeTraceProfilerEnd();
 
+/// Set the function returning the number of bytes allocated so far on this
+/// thread. Events that begin and end with the same counter record the bytes
+/// allocated in between. Pass an empty function when the memory it reads
+/// goes away.
+void timeTraceProfilerSetMemoryCounter(std::function<uint64_t()> Counter);
+
 /// The TimeTraceScope is a helper class to call the begin and end functions
 /// of the time trace profiler.  When the object is constructed, it begins
 /// the section; and when it is destroyed, it stops it. If the time profiler
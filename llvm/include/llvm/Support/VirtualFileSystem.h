@@ -18,7 +18,9 @@
 #include "llvm/ADT/None.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/ADT/STLFunctionalExtras.h"
 #include "llvm/Support/Chrono.h"
 #include "llvm/Support/ErrorOr.h"
@@ -30,6 +32,7 @@
 #include <cstdint>
 #include <ctime>
 #include <memory>
+#include <mutex>
 #include <stack>
 #include <string>
 #include <system_error>
@@ -459,6 +462,49 @@ private:
   virtual void anchor();
 };
 
+/// Remembers the result of every status() call on the underlying file system,
+/// including failed ones, so that each path is looked up at most once.
+///
+/// When a lookup fails, the directory containing the path is listed once and
+/// later lookups of names that are not in the listing fail without querying
+/// the underlying file system. Names are compared case-insensitively, so this
+/// never hides a file on a case-insensitive file system. This makes the
+/// repeated misses of header search across include directories cheap on file
+/// systems with a high latency.
+///
+/// The underlying file system is assumed not to change while this one is in
+/// use. It is safe to use from multiple threads.
+class StatCachingFileSystem : public ProxyFileSystem {
+public:
+  explicit StatCachingFileSystem(IntrusiveRefCntPtr<FileSystem> FS)
+      : ProxyFileSystem(std::move(FS)) {}
+
+  llvm::ErrorOr<Status> status(const Twine &Path) override;
+  llvm::ErrorOr<std::unique_ptr<File>>
+  openFileForRead(const Twine &Path) override;
+
+protected:
+  void printImpl(raw_ostream &OS, PrintType Type,
+                 unsigned IndentLevel) const override;
+
+private:
+  /// Returns the cached status of \p AbsPath, if any.
+  Optional<llvm::ErrorOr<Status>> lookup(StringRef AbsPath);
+  /// Whether the listing of \p Dir shows that it has no entry \p Name.
+  bool isKnownMissing(StringRef Dir, StringRef Name);
+  /// Records the entries of \p Dir, unless it was listed before.
+  void listDirectory(StringRef Dir);
+
+  std::mutex Mutex;
+  /// Keys are absolute paths.
+  StringMap<llvm::ErrorOr<Status>> Statuses;
+  /// Lowercased names of the entries in each listed directory. None if the
+  /// directory could not be listed.
+  StringMap<Optional<StringSet<>>> Listings;
+
+  void anchor() override;
+};
+
 namespace detail {
 
 class InMemoryDirectory;
@@ -17,12 +17,24 @@ namespace llvm {
 
 class raw_ostream;
 class RecordKeeper;
+class StringRef;
 
 /// Perform the action using Records, and write output to OS.
 /// Returns true on error, false otherwise.
 using TableGenMainFn = bool (raw_ostream &OS, RecordKeeper &Records);
 
-int TableGenMain(const char *argv0, TableGenMainFn *MainFn);
+/// Perform the action with the given command line name (e.g. "gen-dag-isel")
+/// using Records, and write output to OS. Returns true on error or if the
+/// action is unknown, false otherwise.
+using TableGenActionFn = bool (StringRef Action, raw_ostream &OS,
+                               RecordKeeper &Records);
+
+/// Parse the input file and run MainFn on the records. If ActionFn is
+/// provided, the -extra-output=<action>=<file> option runs further actions on
+/// the same records, so that a set of outputs generated from one input file
+/// does not need to parse it once for each output.
+int TableGenMain(const char *argv0, TableGenMainFn *MainFn,
+                 TableGenActionFn *ActionFn = nullptr);
 
 } // end namespace llvm
 
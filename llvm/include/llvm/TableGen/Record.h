@@ -2004,6 +2004,9 @@ private:
   RecordKeeper &operator=(RecordKeeper &&) = delete;
   RecordKeeper &operator=(const RecordKeeper &) = delete;
 
+  std::vector<Record *>
+  computeAllDerivedDefinitions(ArrayRef<StringRef> ClassNames) const;
+
   std::string InputFilename;
   RecordMap Classes, Defs;
   mutable StringMap<std::vector<Record *>> ClassRecordsMap;
@@ -0,0 +1,32 @@
+//===- PGOMultiVersioning.h - Clone hot functions per ISA level -*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This pass clones the functions whose loops are hot in the profile for newer
+// x86-64 ISA levels, and dispatches between the clones at load time with an
+// IFUNC, as if they had been annotated with target_clones.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_TRANSFORMS_IPO_PGOMULTIVERSIONING_H
+#define LLVM_TRANSFORMS_IPO_PGOMULTIVERSIONING_H
+
+#include "llvm/IR/PassManager.h"
+
+namespace llvm {
+
+class Module;
+
+/// Pass to multiversion hot loops for x86-64 ISA levels.
+class PGOMultiVersioningPass : public PassInfoMixin<PGOMultiVersioningPass> {
+public:
+  PreservedAnalyses run(Module &M, ModuleAnalysisManager &AM);
+};
+
+} // end namespace llvm
+
+#endif // LLVM_TRANSFORMS_IPO_PGOMULTIVERSIONING_H
@@ -73,6 +73,15 @@ private:
 
   int64_t TotalCountersPromoted = 0;
 
+  /// A sampled counter update: the instructions from First to Last only run
+  /// when Sampled is true.
+  struct SampledIncrement {
+    Value *Sampled;
+    Instruction *First;
+    Instruction *Last;
+  };
+  std::vector<SampledIncrement> SampledIncrements;
+
   /// Lower instrumentation intrinsics in the function. Returns true if there
   /// any lowering.
   bool lowerIntrinsics(Function *F);
@@ -80,6 +89,12 @@ private:
   /// Register-promote counter loads and stores in loops.
   void promoteCounterLoadStores(Function *F);
 
+  /// Move the sampled counter updates under a branch on their condition.
+  void guardSampledIncrements();
+
+  /// Get the thread local countdown used to sample counter updates.
+  GlobalVariable *getOrCreateSamplingVar();
+
   /// Returns true if relocating counters at runtime is enabled.
   bool isRuntimeCounterRelocationEnabled() const;
 
@@ -248,6 +248,13 @@ namespace llvm {
   /// Emit a call to the calloc function.
   Value *emitCalloc(Value *Num, Value *Size, IRBuilderBase &B,
                     const TargetLibraryInfo &TLI);
+
+  /// Emit a call to NewFunc, one of the operator new variants taking a
+  /// trailing __hot_cold_t hint. Args are the arguments of the original
+  /// operator new call and HotCold is passed as the hint.
+  Value *emitHotColdNew(ArrayRef<Value *> Args, IRBuilderBase &B,
+                        const TargetLibraryInfo *TLI, LibFunc NewFunc,
+                        uint8_t HotCold);
 }
 
 #endif
@@ -503,6 +503,12 @@ struct BasicAAResult::DecomposedGEP {
   }
 };
 
+// Results that are kept across the queries of a BatchAAResults. They depend
+// only on the queried pointer, not on the other location or the query state.
+struct BasicAAResult::QueryCache final : AAQueryInfo::ImplCache {
+  DenseMap<const Value *, DecomposedGEP> DecomposedGEPs;
+  DenseMap<const Value *, const Value *> UnderlyingObjects;
+};
 
 /// If V is a symbolic pointer expression, decompose it into a base pointer
 /// with a constant offset and a number of scaled symbolic offsets.
@@ -676,6 +682,40 @@ BasicAAResult::DecomposeGEPExpression(const Value *V, const DataLayout &DL,
   return Decomposed;
 }
 
+BasicAAResult::QueryCache *BasicAAResult::getQueryCache(AAQueryInfo &AAQI) {
+  if (!AAQI.CacheImplResults)
+    return nullptr;
+  if (!AAQI.BasicAACache)
+    AAQI.BasicAACache = std::make_unique<QueryCache>();
+  return static_cast<QueryCache *>(AAQI.BasicAACache.get());
+}
+
+BasicAAResult::DecomposedGEP
+BasicAAResult::getDecomposedGEP(const Value *V, AAQueryInfo &AAQI) {
+  QueryCache *Cache = getQueryCache(AAQI);
+  if (!Cache)
+    return DecomposeGEPExpression(V, DL, &AC, DT);
+
+  auto It = Cache->DecomposedGEPs.find(V);
+  if (It != Cache->DecomposedGEPs.end())
+    return It->second;
+  DecomposedGEP Decomposed = DecomposeGEPExpression(V, DL, &AC, DT);
+  Cache->DecomposedGEPs.try_emplace(V, Decomposed);
+  return Decomposed;
+}
+
+const Value *BasicAAResult::getCachedUnderlyingObject(const Value *V,
+                                                      AAQueryInfo &AAQI) {
+  QueryCache *Cache = getQueryCache(AAQI);
+  if (!Cache)
+    return getUnderlyingObject(V, MaxLookupSearchDepth);
+
+  auto [It, Inserted] = Cache->UnderlyingObjects.try_emplace(V, nullptr);
+  if (Inserted)
+    It->second = getUnderlyingObject(V, MaxLookupSearchDepth);
+  return It->second;
+}
+
 ModRefInfo BasicAAResult::getModRefInfoMask(const MemoryLocation &Loc,
                                             AAQueryInfo &AAQI,
                                             bool IgnoreLocals) {
@@ -1029,8 +1069,8 @@ AliasResult BasicAAResult::aliasGEP(
                                              : AliasResult::MayAlias;
   }
 
-  DecomposedGEP DecompGEP1 = DecomposeGEPExpression(GEP1, DL, &AC, DT);
-  DecomposedGEP DecompGEP2 = DecomposeGEPExpression(V2, DL, &AC, DT);
+  DecomposedGEP DecompGEP1 = getDecomposedGEP(GEP1, AAQI);
+  DecomposedGEP DecompGEP2 = getDecomposedGEP(V2, AAQI);
 
   // Bail if we were not able to decompose anything.
   if (DecompGEP1.Base == GEP1 && DecompGEP2.Base == V2)
@@ -1459,8 +1499,8 @@ AliasResult BasicAAResult::aliasCheck(const Value *V1, LocationSize V1Size,
     return AliasResult::NoAlias; // Scalars cannot alias each other
 
   // Figure out what objects these things are pointing to if we can.
-  const Value *O1 = getUnderlyingObject(V1, MaxLookupSearchDepth);
-  const Value *O2 = getUnderlyingObject(V2, MaxLookupSearchDepth);
+  const Value *O1 = getCachedUnderlyingObject(V1, AAQI);
+  const Value *O2 = getCachedUnderlyingObject(V2, AAQI);
 
   // Null values in the default address space don't point to any object, so they
   // don't alias any other pointer.
@@ -15,6 +15,7 @@
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Analysis/AssumptionCache.h"
 #include "llvm/Analysis/ConstantFolding.h"
 #include "llvm/Analysis/InstructionSimplify.h"
@@ -34,6 +35,7 @@
 #include "llvm/IR/PatternMatch.h"
 #include "llvm/IR/ValueHandle.h"
 #include "llvm/InitializePasses.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/FormattedStream.h"
 #include "llvm/Support/KnownBits.h"
@@ -47,6 +49,16 @@ using namespace PatternMatch;
 // answer for a given value.
 static const unsigned MaxProcessedPerValue = 500;
 
+static cl::opt<unsigned> MaxCacheEntries(
+    "lvi-max-cache-entries", cl::Hidden, cl::init(1000000),
+    cl::desc("Maximum number of values cached by LazyValueInfo before the "
+             "least recently used blocks are evicted (0 = unlimited)"));
+
+STATISTIC(NumCacheHits, "Number of block values found in the cache");
+STATISTIC(NumCacheMisses, "Number of block values not found in the cache");
+STATISTIC(NumBlocksEvicted, "Number of blocks evicted from the cache");
+STATISTIC(MaxSolverDepth, "Maximum depth of the block value stack");
+
 char LazyValueInfoWrapperPass::ID = 0;
 LazyValueInfoWrapperPass::LazyValueInfoWrapperPass() : FunctionPass(ID) {
   initializeLazyValueInfoWrapperPassPass(*PassRegistry::getPassRegistry());
@@ -165,6 +177,14 @@ namespace {
       // None indicates that the nonnull pointers for this basic block
       // block have not been computed yet.
       Optional<NonNullPointerSet> NonNullPointers;
+      // Time of the last lookup or insertion, for evicting the least recently
+      // used blocks.
+      uint64_t LastUse = 0;
+
+      size_t size() const {
+        return LatticeElements.size() + OverDefined.size() +
+               (NonNullPointers ? NonNullPointers->size() : 0);
+      }
     };
 
     /// Cached information per basic block.
@@ -172,6 +192,10 @@ namespace {
         BlockCache;
     /// Set of value handles used to erase values from the cache on deletion.
     DenseSet<LVIValueHandle, DenseMapInfo<Value *>> ValueHandles;
+    /// Total number of values cached in all blocks.
+    size_t NumEntries = 0;
+    /// Incremented on every access to a block entry.
+    uint64_t UseClock = 0;
 
     const BlockCacheEntry *getBlockEntry(BasicBlock *BB) const {
       auto It = BlockCache.find_as(BB);
@@ -186,6 +210,7 @@ namespace {
         It = BlockCache.insert({ BB, std::make_unique<BlockCacheEntry>() })
                        .first;
 
+      It->second->LastUse = ++UseClock;
       return It->second.get();
     }
 
@@ -203,26 +228,35 @@ namespace {
       // Insert over-defined values into their own cache to reduce memory
       // overhead.
       if (Result.isOverdefined())
-        Entry->OverDefined.insert(Val);
+        NumEntries += Entry->OverDefined.insert(Val).second;
       else
-        Entry->LatticeElements.insert({ Val, Result });
+        NumEntries += Entry->LatticeElements.insert({ Val, Result }).second;
 
       addValueHandle(Val);
     }
 
     Optional<ValueLatticeElement> getCachedValueInfo(Value *V,
-                                                     BasicBlock *BB) const {
-      const BlockCacheEntry *Entry = getBlockEntry(BB);
-      if (!Entry)
+                                                     BasicBlock *BB) {
+      auto It = BlockCache.find_as(BB);
+      if (It == BlockCache.end()) {
+        ++NumCacheMisses;
         return None;
+      }
+      BlockCacheEntry *Entry = It->second.get();
+      Entry->LastUse = ++UseClock;
 
-      if (Entry->OverDefined.count(V))
+      if (Entry->OverDefined.count(V)) {
+        ++NumCacheHits;
         return ValueLatticeElement::getOverdefined();
+      }
 
       auto LatticeIt = Entry->LatticeElements.find_as(V);
-      if (LatticeIt == Entry->LatticeElements.end())
+      if (LatticeIt == Entry->LatticeElements.end()) {
+        ++NumCacheMisses;
         return None;
+      }
 
+      ++NumCacheHits;
       return LatticeIt->second;
     }
 
@@ -232,6 +266,7 @@ namespace {
       BlockCacheEntry *Entry = getOrCreateBlockEntry(BB);
       if (!Entry->NonNullPointers) {
         Entry->NonNullPointers = InitFn(BB);
+        NumEntries += Entry->NonNullPointers->size();
         for (Value *V : *Entry->NonNullPointers)
           addValueHandle(V);
       }
@@ -243,8 +278,14 @@ namespace {
     void clear() {
       BlockCache.clear();
       ValueHandles.clear();
+      NumEntries = 0;
     }
 
+    /// If more than \p MaxEntries values are cached, evict the least recently
+    /// used blocks until three quarters of that budget are left. A budget of
+    /// zero means unlimited.
+    void shrinkToBudget(size_t MaxEntries);
+
     /// Inform the cache that a given value has been deleted.
     void eraseValue(Value *V);
 
@@ -261,10 +302,10 @@ namespace {
 
 void LazyValueInfoCache::eraseValue(Value *V) {
   for (auto &Pair : BlockCache) {
-    Pair.second->LatticeElements.erase(V);
-    Pair.second->OverDefined.erase(V);
+    NumEntries -= Pair.second->LatticeElements.erase(V);
+    NumEntries -= Pair.second->OverDefined.erase(V);
     if (Pair.second->NonNullPointers)
-      Pair.second->NonNullPointers->erase(V);
+      NumEntries -= Pair.second->NonNullPointers->erase(V);
   }
 
   auto HandleIt = ValueHandles.find_as(V);
@@ -279,7 +320,32 @@ void LVIValueHandle::deleted() {
 }
 
 void LazyValueInfoCache::eraseBlock(BasicBlock *BB) {
-  BlockCache.erase(BB);
+  auto It = BlockCache.find_as(BB);
+  if (It == BlockCache.end())
+    return;
+  NumEntries -= It->second->size();
+  BlockCache.erase(It);
+}
+
+void LazyValueInfoCache::shrinkToBudget(size_t MaxEntries) {
+  if (!MaxEntries || NumEntries <= MaxEntries)
+    return;
+
+  // Evict down to less than the budget, so that the blocks only need to be
+  // sorted again after a good number of insertions.
+  SmallVector<std::pair<uint64_t, BasicBlock *>, 0> Blocks;
+  Blocks.reserve(BlockCache.size());
+  for (auto &Pair : BlockCache)
+    Blocks.push_back({Pair.second->LastUse, Pair.first});
+  llvm::sort(Blocks, less_first());
+
+  size_t Target = MaxEntries - MaxEntries / 4;
+  for (const auto &Block : Blocks) {
+    if (NumEntries <= Target)
+      break;
+    eraseBlock(Block.second);
+    ++NumBlocksEvicted;
+  }
 }
 
 void LazyValueInfoCache::threadEdgeImpl(BasicBlock *OldSucc,
@@ -324,6 +390,7 @@ void LazyValueInfoCache::threadEdgeImpl(BasicBlock *OldSucc,
     for (Value *V : ValsToClear) {
       if (!ValueSet.erase(V))
         continue;
+      --NumEntries;
 
       // If we removed anything, then we potentially need to update
       // blocks successors too.
@@ -384,6 +451,7 @@ class LazyValueInfoImpl {
     LLVM_DEBUG(dbgs() << "PUSH: " << *BV.second << " in "
                       << BV.first->getName() << "\n");
     BlockValueStack.push_back(BV);
+    MaxSolverDepth.updateMax(BlockValueStack.size());
     return true;
   }
 
@@ -1457,6 +1525,7 @@ ValueLatticeElement LazyValueInfoImpl::getValueInBlock(Value *V, BasicBlock *BB,
                     << BB->getName() << "'\n");
 
   assert(BlockValueStack.empty() && BlockValueSet.empty());
+  TheCache.shrinkToBudget(MaxCacheEntries);
   Optional<ValueLatticeElement> OptResult = getBlockValue(V, BB, CxtI);
   if (!OptResult) {
     solve();
@@ -1492,6 +1561,7 @@ getValueOnEdge(Value *V, BasicBlock *FromBB, BasicBlock *ToBB,
                     << FromBB->getName() << "' to '" << ToBB->getName()
                     << "'\n");
 
+  TheCache.shrinkToBudget(MaxCacheEntries);
   Optional<ValueLatticeElement> Result = getEdgeValue(V, FromBB, ToBB, CxtI);
   if (!Result) {
     solve();
@@ -78,6 +78,14 @@ static cl::opt<bool> ImportFullTypeDefinitions(
     "import-full-type-definitions", cl::init(false), cl::Hidden,
     cl::desc("Import full type definitions for ThinLTO."));
 
+/// Flag whether to load the enums, retained types, globals and macros listed on
+/// DICompileUnits when loading bitcode for importing.
+static cl::opt<bool> ImportCompileUnitLists(
+    "import-compile-unit-lists", cl::init(false), cl::Hidden,
+    cl::desc("Load the lists of enums, retained types, global variables and "
+             "macros of compile units when loading bitcode for ThinLTO "
+             "importing."));
+
 static cl::opt<bool> DisableLazyLoading(
     "disable-ondemand-mds-loading", cl::init(false), cl::Hidden,
     cl::desc("Force disable the lazy-loading on-demand of metadata when "
@@ -1636,12 +1644,22 @@ Error MetadataLoader::MetadataLoaderImpl::parseOneMetadata(
     // Ignore Record[0], which indicates whether this compile unit is
     // distinct.  It's always distinct.
     IsDistinct = true;
+
+    // When importing, the IRMover drops the enums, retained types, globals and
+    // macros of the source compile units (see prepareCompileUnitsForImport),
+    // and only what the imported functions reach gets mapped. Don't load
+    // these lists at all: with lazy loading, they would otherwise pull in most
+    // of the debug info of the source module.
+    bool SkipLists = IsImporting && !ImportCompileUnitLists;
+    auto getListOrNull = [&](unsigned ID) {
+      return SkipLists ? nullptr : getMDOrNull(ID);
+    };
     auto *CU = DICompileUnit::getDistinct(
         Context, Record[1], getMDOrNull(Record[2]), getMDString(Record[3]),
         Record[4], getMDString(Record[5]), Record[6], getMDString(Record[7]),
-        Record[8], getMDOrNull(Record[9]), getMDOrNull(Record[10]),
-        getMDOrNull(Record[12]), getMDOrNull(Record[13]),
-        Record.size() <= 15 ? nullptr : getMDOrNull(Record[15]),
+        Record[8], getListOrNull(Record[9]), getListOrNull(Record[10]),
+        getListOrNull(Record[12]), getMDOrNull(Record[13]),
+        Record.size() <= 15 ? nullptr : getListOrNull(Record[15]),
         Record.size() <= 14 ? 0 : Record[14],
         Record.size() <= 16 ? true : Record[16],
         Record.size() <= 17 ? false : Record[17],
@@ -4868,18 +4868,22 @@ void llvm::WriteBitcodeToFile(const Module &M, raw_ostream &Out,
   Buffer.reserve(256*1024);
 
   // If this is darwin or another generic macho target, reserve space for the
-  // header.
+  // header. The header is only filled in once the whole module is written, so
+  // the buffer cannot be flushed to the output file incrementally.
   Triple TT(M.getTargetTriple());
-  if (TT.isOSDarwin() || TT.isOSBinFormatMachO())
+  bool HasWrapperHeader = TT.isOSDarwin() || TT.isOSBinFormatMachO();
+  if (HasWrapperHeader)
     Buffer.insert(Buffer.begin(), BWH_HeaderSize, 0);
 
-  BitcodeWriter Writer(Buffer, dyn_cast<raw_fd_stream>(&Out));
+  raw_fd_stream *FS =
+      HasWrapperHeader ? nullptr : dyn_cast<raw_fd_stream>(&Out);
+  BitcodeWriter Writer(Buffer, FS);
   Writer.writeModule(M, ShouldPreserveUseListOrder, Index, GenerateHash,
                      ModHash);
   Writer.writeSymtab();
   Writer.writeStrtab();
 
-  if (TT.isOSDarwin() || TT.isOSBinFormatMachO())
+  if (HasWrapperHeader)
     emitDarwinBCHeaderAndTrailer(Buffer, TT);
 
   // Write the generated bitstream to "Out".
@@ -13,6 +13,7 @@
 #include "llvm/ADT/APFloat.h"
 #include "llvm/ADT/APInt.h"
 #include "llvm/ADT/Optional.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/CodeGen/CodeGenCommonISel.h"
 #include "llvm/CodeGen/GlobalISel/GISelChangeObserver.h"
 #include "llvm/CodeGen/GlobalISel/GISelKnownBits.h"
@@ -37,6 +38,12 @@
 
 #define DEBUG_TYPE "globalisel-utils"
 
+STATISTIC(NumLegalizerFailures, "Number of functions the legalizer failed on");
+STATISTIC(NumRegBankSelectFailures,
+          "Number of functions register bank selection failed on");
+STATISTIC(NumInstructionSelectFailures,
+          "Number of functions instruction selection failed on");
+
 using namespace llvm;
 using namespace MIPatternMatch;
 
@@ -268,6 +275,17 @@ void llvm::reportGISelWarning(MachineFunction &MF, const TargetPassConfig &TPC,
 void llvm::reportGISelFailure(MachineFunction &MF, const TargetPassConfig &TPC,
                               MachineOptimizationRemarkEmitter &MORE,
                               MachineOptimizationRemarkMissed &R) {
+  // Attribute each fallback to the first pass that failed on the function.
+  if (!MF.getProperties().hasProperty(
+          MachineFunctionProperties::Property::FailedISel)) {
+    StringRef PassName = R.getPassName();
+    if (PassName == "gisel-legalize")
+      ++NumLegalizerFailures;
+    else if (PassName == "gisel-regbankselect")
+      ++NumRegBankSelectFailures;
+    else if (PassName == "gisel-select")
+      ++NumInstructionSelectFailures;
+  }
   MF.getProperties().set(MachineFunctionProperties::Property::FailedISel);
   reportGISelDiagnostic(DS_Error, MF, TPC, MORE, R);
 }
@@ -122,6 +122,13 @@ static cl::opt<unsigned> SchedOnlyBlock("misched-only-block", cl::Hidden,
 static cl::opt<unsigned> ReadyListLimit("misched-limit", cl::Hidden,
   cl::desc("Limit ready list to N instructions"), cl::init(256));
 
+static cl::opt<unsigned> MaxRegionInstrs(
+    "misched-max-region-instrs", cl::Hidden,
+    cl::desc("Split scheduling regions into windows of at most this many "
+             "instructions, to bound compile time on huge blocks (0 = no "
+             "limit)"),
+    cl::init(0));
+
 static cl::opt<bool> EnableRegPressure("misched-regpressure", cl::Hidden,
   cl::desc("Enable register pressure scheduling."), cl::init(true));
 
@@ -511,6 +518,10 @@ getSchedRegions(MachineBasicBlock *MBB,
       if (isSchedBoundary(&MI, &*MBB, MF, TII))
         break;
       if (!MI.isDebugOrPseudoInstr()) {
+        // Close the window once it is full. MI then acts as the boundary at
+        // the end of the next region up, and is not moved.
+        if (MaxRegionInstrs && NumRegionInstrs == MaxRegionInstrs)
+          break;
         // MBB::size() uses instr_iterator to count. Here we need a bundle to
         // count as a single instruction.
         ++NumRegionInstrs;
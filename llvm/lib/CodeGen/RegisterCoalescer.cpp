@@ -118,6 +118,13 @@ static cl::opt<unsigned> LargeIntervalFreqThreshold(
              "coalescing to control the compile time. "),
     cl::init(100));
 
+static cl::opt<unsigned> MaxWorkListRounds(
+    "join-max-worklist-rounds", cl::Hidden,
+    cl::desc("Stop retrying the copies that could not be coalesced yet after "
+             "this many rounds over the work list, to bound compile time "
+             "(0 = until no more progress is made)"),
+    cl::init(0));
+
 namespace {
 
   class JoinVals;
@@ -4090,9 +4097,13 @@ void RegisterCoalescer::joinAllIntervals() {
   coalesceLocals();
 
   // Joining intervals can allow other intervals to be joined.  Iteratively join
-  // until we make no progress.
-  while (copyCoalesceWorkList(WorkList))
-    /* empty */ ;
+  // until we make no progress. Drop the handled copies after each round so
+  // that the rounds only revisit the copies that may still be joined.
+  for (unsigned Round = 1; copyCoalesceWorkList(WorkList); ++Round) {
+    erase_value(WorkList, nullptr);
+    if (Round == MaxWorkListRounds)
+      break;
+  }
   lateLiveIntervalUpdate();
 }
 
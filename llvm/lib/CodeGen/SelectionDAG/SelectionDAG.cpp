@@ -1363,10 +1363,19 @@ SDNode *SelectionDAG::FindNodeOrInsertPos(const FoldingSetNodeID &ID,
 }
 
 void SelectionDAG::clear() {
+  // The CSE map keeps its buckets from one block to the next, and clearing it
+  // touches all of them. After an unusually large block, start over with a
+  // small map so that the many small blocks of switch-heavy functions don't
+  // pay for it.
+  bool ShrinkCSEMap =
+      CSEMap.capacity() > 16 * std::max<size_t>(AllNodes.size(), 64);
   allnodes_clear();
   OperandRecycler.clear(OperandAllocator);
   OperandAllocator.Reset();
-  CSEMap.clear();
+  if (ShrinkCSEMap)
+    CSEMap = FoldingSet<SDNode>();
+  else
+    CSEMap.clear();
 
   ExtendedValueTypeNodes.clear();
   ExternalSymbols.clear();
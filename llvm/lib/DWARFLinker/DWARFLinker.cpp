@@ -2525,9 +2525,12 @@ Error DWARFLinker::link() {
 
   // These variables manage the list of processed object files.
   // The mutex and condition variable are to ensure that this is thread safe.
+  // NumClonedFiles is used to keep analysis from running more than
+  // Options.MaxInFlightObjects files ahead of cloning.
   std::mutex ProcessedFilesMutex;
   std::condition_variable ProcessedFilesConditionVariable;
   BitVector ProcessedFiles(NumObjects, false);
+  unsigned NumClonedFiles = 0;
 
   //  Analyzing the context info is particularly expensive so it is executed in
   //  parallel with emitting the previous compile unit.
@@ -2649,11 +2652,17 @@ Error DWARFLinker::link() {
 
   auto AnalyzeAll = [&]() {
     for (unsigned I = 0, E = NumObjects; I != E; ++I) {
+      if (unsigned Max = Options.MaxInFlightObjects) {
+        std::unique_lock<std::mutex> LockGuard(ProcessedFilesMutex);
+        ProcessedFilesConditionVariable.wait(
+            LockGuard, [&]() { return I < NumClonedFiles + Max; });
+      }
+
       AnalyzeLambda(I);
 
       std::unique_lock<std::mutex> LockGuard(ProcessedFilesMutex);
       ProcessedFiles.set(I);
-      ProcessedFilesConditionVariable.notify_one();
+      ProcessedFilesConditionVariable.notify_all();
     }
   };
 
@@ -2668,6 +2677,10 @@ Error DWARFLinker::link() {
       }
 
       CloneLambda(I);
+
+      std::unique_lock<std::mutex> LockGuard(ProcessedFilesMutex);
+      ++NumClonedFiles;
+      ProcessedFilesConditionVariable.notify_all();
     }
     EmitLambda();
   };
@@ -11,6 +11,7 @@
 //
 //===----------------------------------------------------------------------===//
 #include "llvm/DWP/DWP.h"
+#include "llvm/ADT/ScopeExit.h"
 #include "llvm/DWP/DWPError.h"
 #include "llvm/MC/MCContext.h"
 #include "llvm/MC/MCObjectFileInfo.h"
@@ -18,6 +19,7 @@
 #include "llvm/Object/Decompressor.h"
 #include "llvm/Object/ELFObjectFile.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include <limits>
 
 using namespace llvm;
@@ -477,39 +479,20 @@ Error buildDuplicateError(const std::pair<uint64_t, UnitIndexEntry> &PrevE,
       " and " + buildDWODescription(ID.Name, DWPName, ID.DWOName));
 }
 
-Error handleSection(
+// Dispatches the (already decompressed) contents of the section Name to the
+// output or to the Cur* slots of the file being processed.
+static Error handleSectionContents(
     const StringMap<std::pair<MCSection *, DWARFSectionKind>> &KnownSections,
     const MCSection *StrSection, const MCSection *StrOffsetSection,
     const MCSection *TypesSection, const MCSection *CUIndexSection,
     const MCSection *TUIndexSection, const MCSection *InfoSection,
-    const SectionRef &Section, MCStreamer &Out,
-    std::deque<SmallString<32>> &UncompressedSections,
+    StringRef Name, StringRef Contents, MCStreamer &Out,
     uint32_t (&ContributionOffsets)[8], UnitIndexEntry &CurEntry,
     StringRef &CurStrSection, StringRef &CurStrOffsetSection,
     std::vector<StringRef> &CurTypesSection,
     std::vector<StringRef> &CurInfoSection, StringRef &AbbrevSection,
     StringRef &CurCUIndexSection, StringRef &CurTUIndexSection,
     std::vector<std::pair<DWARFSectionKind, uint32_t>> &SectionLength) {
-  if (Section.isBSS())
-    return Error::success();
-
-  if (Section.isVirtual())
-    return Error::success();
-
-  Expected<StringRef> NameOrErr = Section.getName();
-  if (!NameOrErr)
-    return NameOrErr.takeError();
-  StringRef Name = *NameOrErr;
-
-  Expected<StringRef> ContentsOrErr = Section.getContents();
-  if (!ContentsOrErr)
-    return ContentsOrErr.takeError();
-  StringRef Contents = *ContentsOrErr;
-
-  if (auto Err = handleCompressedSection(UncompressedSections, Section, Name,
-                                         Contents))
-    return Err;
-
   Name = Name.substr(Name.find_first_not_of("._"));
 
   auto SectionPair = KnownSections.find(Name);
@@ -546,6 +529,96 @@ Error handleSection(
   return Error::success();
 }
 
+// Appends the name and contents of Section to Loaded, decompressing the
+// contents into UncompressedSections if needed. Sections without contents are
+// skipped.
+template <typename ContainerT>
+static Error loadSection(const SectionRef &Section,
+                         std::deque<SmallString<32>> &UncompressedSections,
+                         ContainerT &Loaded) {
+  if (Section.isBSS())
+    return Error::success();
+
+  if (Section.isVirtual())
+    return Error::success();
+
+  Expected<StringRef> NameOrErr = Section.getName();
+  if (!NameOrErr)
+    return NameOrErr.takeError();
+  StringRef Name = *NameOrErr;
+
+  Expected<StringRef> ContentsOrErr = Section.getContents();
+  if (!ContentsOrErr)
+    return ContentsOrErr.takeError();
+  StringRef Contents = *ContentsOrErr;
+
+  if (auto Err = handleCompressedSection(UncompressedSections, Section, Name,
+                                         Contents))
+    return Err;
+
+  Loaded.emplace_back(Name, Contents);
+  return Error::success();
+}
+
+Error handleSection(
+    const StringMap<std::pair<MCSection *, DWARFSectionKind>> &KnownSections,
+    const MCSection *StrSection, const MCSection *StrOffsetSection,
+    const MCSection *TypesSection, const MCSection *CUIndexSection,
+    const MCSection *TUIndexSection, const MCSection *InfoSection,
+    const SectionRef &Section, MCStreamer &Out,
+    std::deque<SmallString<32>> &UncompressedSections,
+    uint32_t (&ContributionOffsets)[8], UnitIndexEntry &CurEntry,
+    StringRef &CurStrSection, StringRef &CurStrOffsetSection,
+    std::vector<StringRef> &CurTypesSection,
+    std::vector<StringRef> &CurInfoSection, StringRef &AbbrevSection,
+    StringRef &CurCUIndexSection, StringRef &CurTUIndexSection,
+    std::vector<std::pair<DWARFSectionKind, uint32_t>> &SectionLength) {
+  SmallVector<std::pair<StringRef, StringRef>, 1> Loaded;
+  if (auto Err = loadSection(Section, UncompressedSections, Loaded))
+    return Err;
+
+  for (const auto &NameAndContents : Loaded)
+    if (auto Err = handleSectionContents(
+            KnownSections, StrSection, StrOffsetSection, TypesSection,
+            CUIndexSection, TUIndexSection, InfoSection, NameAndContents.first,
+            NameAndContents.second, Out, ContributionOffsets, CurEntry,
+            CurStrSection, CurStrOffsetSection, CurTypesSection,
+            CurInfoSection, AbbrevSection, CurCUIndexSection,
+            CurTUIndexSection, SectionLength))
+      return Err;
+  return Error::success();
+}
+
+namespace {
+// An input file, opened and with the contents of its sections read and
+// decompressed, ready to be merged into the output.
+struct LoadedInput {
+  OwningBinary<object::ObjectFile> Obj;
+  std::deque<SmallString<32>> UncompressedSections;
+  // Names and contents of the sections of Obj, in order.
+  std::vector<std::pair<StringRef, StringRef>> Sections;
+  Error Err = Error::success();
+};
+} // namespace
+
+static Error loadInput(StringRef Input, LoadedInput &Loaded) {
+  auto ErrOrObj = object::ObjectFile::createObjectFile(Input);
+  if (!ErrOrObj) {
+    return handleErrors(ErrOrObj.takeError(),
+                        [&](std::unique_ptr<ECError> EC) -> Error {
+                          return createFileError(Input, Error(std::move(EC)));
+                        });
+  }
+  Loaded.Obj = std::move(*ErrOrObj);
+
+  for (const auto &Section : Loaded.Obj.getBinary()->sections())
+    if (auto Err =
+            loadSection(Section, Loaded.UncompressedSections, Loaded.Sections))
+      return Err;
+  return Error::success();
+}
+
+
 Error write(MCStreamer &Out, ArrayRef<std::string> Inputs) {
   const auto &MCOFI = *Out.getContext().getObjectFileInfo();
   MCSection *const StrSection = MCOFI.getDwarfStrDWOSection();
@@ -579,22 +652,28 @@ Error write(MCStreamer &Out, ArrayRef<std::string> Inputs) {
 
   DWPStringPool Strings(Out, StrSection);
 
-  SmallVector<OwningBinary<object::ObjectFile>, 128> Objects;
-  Objects.reserve(Inputs.size());
-
-  std::deque<SmallString<32>> UncompressedSections;
-
-  for (const auto &Input : Inputs) {
-    auto ErrOrObj = object::ObjectFile::createObjectFile(Input);
-    if (!ErrOrObj) {
-      return handleErrors(ErrOrObj.takeError(),
-                          [&](std::unique_ptr<ECError> EC) -> Error {
-                            return createFileError(Input, Error(std::move(EC)));
-                          });
-    }
-
-    auto &Obj = *ErrOrObj->getBinary();
-    Objects.push_back(std::move(*ErrOrObj));
+  // Opening the inputs and decompressing their sections is independent for
+  // each input and usually dominates the run time, so do it up front in
+  // parallel. Everything that touches the output or the string pool stays
+  // serial, in input order, so the output does not depend on scheduling. All
+  // the inputs are kept alive until the end anyway, as the string pool refers
+  // into them.
+  std::vector<LoadedInput> LoadedInputs(Inputs.size());
+  parallelFor(0, Inputs.size(), [&](size_t I) {
+    LoadedInputs[I].Err = loadInput(Inputs[I], LoadedInputs[I]);
+  });
+  // Errors of the inputs after a failing one are dropped, as before.
+  auto ConsumeLoadErrors = make_scope_exit([&] {
+    for (LoadedInput &Loaded : LoadedInputs)
+      consumeError(std::move(Loaded.Err));
+  });
+
+  for (size_t InputIdx = 0; InputIdx != Inputs.size(); ++InputIdx) {
+    const std::string &Input = Inputs[InputIdx];
+    LoadedInput &Loaded = LoadedInputs[InputIdx];
+    if (Loaded.Err)
+      return std::move(Loaded.Err);
+    auto &Obj = *Loaded.Obj.getBinary();
 
     UnitIndexEntry CurEntry = {};
 
@@ -611,14 +690,15 @@ Error write(MCStreamer &Out, ArrayRef<std::string> Inputs) {
     // i.e. offset and length, of each compile/type unit to a section.
     std::vector<std::pair<DWARFSectionKind, uint32_t>> SectionLength;
 
-    for (const auto &Section : Obj.sections())
-      if (auto Err = handleSection(
+    for (const auto &NameAndContents : Loaded.Sections)
+      if (auto Err = handleSectionContents(
               KnownSections, StrSection, StrOffsetSection, TypesSection,
-              CUIndexSection, TUIndexSection, InfoSection, Section, Out,
-              UncompressedSections, ContributionOffsets, CurEntry,
-              CurStrSection, CurStrOffsetSection, CurTypesSection,
-              CurInfoSection, AbbrevSection, CurCUIndexSection,
-              CurTUIndexSection, SectionLength))
+              CUIndexSection, TUIndexSection, InfoSection,
+              NameAndContents.first, NameAndContents.second, Out,
+              ContributionOffsets, CurEntry, CurStrSection,
+              CurStrOffsetSection, CurTypesSection, CurInfoSection,
+              AbbrevSection, CurCUIndexSection, CurTUIndexSection,
+              SectionLength))
         return Err;
 
     if (CurInfoSection.empty())
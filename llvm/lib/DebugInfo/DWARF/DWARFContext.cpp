@@ -704,36 +704,44 @@ DWARFTypeUnit *DWARFContext::getTypeUnitForHash(uint16_t Version, uint64_t Hash,
   parseDWOUnits(LazyParse);
 
   if (const auto &TUI = getTUIndex()) {
-    if (const auto *R = TUI.getFromHash(Hash))
+    if (const auto *R = TUI.getFromHash(Hash)) {
+      std::lock_guard<std::mutex> Lock(DWOUnitsMutex);
       return dyn_cast_or_null<DWARFTypeUnit>(
           DWOUnits.getUnitForIndexEntry(*R));
+    }
     return nullptr;
   }
 
   struct UnitContainers {
     const DWARFUnitVector &Units;
     Optional<DenseMap<uint64_t, DWARFTypeUnit *>> &Map;
+    llvm::once_flag &Once;
   };
-  UnitContainers Units = IsDWO ? UnitContainers{DWOUnits, DWOTypeUnits}
-                               : UnitContainers{NormalUnits, NormalTypeUnits};
-  if (!Units.Map) {
+  UnitContainers Units =
+      IsDWO ? UnitContainers{DWOUnits, DWOTypeUnits, DWOTypeUnitsOnce}
+            : UnitContainers{NormalUnits, NormalTypeUnits, NormalTypeUnitsOnce};
+  llvm::call_once(Units.Once, [&] {
     Units.Map.emplace();
     for (const auto &U : IsDWO ? dwo_units() : normal_units()) {
       if (DWARFTypeUnit *TU = dyn_cast<DWARFTypeUnit>(U.get()))
         (*Units.Map)[TU->getTypeHash()] = TU;
     }
-  }
+  });
 
-  return (*Units.Map)[Hash];
+  // Don't insert missing hashes so that lookups don't modify the map once it
+  // has been built.
+  return Units.Map->lookup(Hash);
 }
 
 DWARFCompileUnit *DWARFContext::getDWOCompileUnitForHash(uint64_t Hash) {
   parseDWOUnits(LazyParse);
 
   if (const auto &CUI = getCUIndex()) {
-    if (const auto *R = CUI.getFromHash(Hash))
+    if (const auto *R = CUI.getFromHash(Hash)) {
+      std::lock_guard<std::mutex> Lock(DWOUnitsMutex);
       return dyn_cast_or_null<DWARFCompileUnit>(
           DWOUnits.getUnitForIndexEntry(*R));
+    }
     return nullptr;
   }
 
@@ -741,7 +749,10 @@ DWARFCompileUnit *DWARFContext::getDWOCompileUnitForHash(uint64_t Hash) {
   // probably only one unless this is something like LTO - though an in-process
   // built/cached lookup table could be used in that case to improve repeated
   // lookups of different CUs in the DWO.
-  for (const auto &DWOCU : dwo_compile_units()) {
+  auto DWOCUs = dwo_compile_units();
+  // The DWO IDs are cached in the units.
+  std::lock_guard<std::mutex> Lock(DWOUnitsMutex);
+  for (const auto &DWOCU : DWOCUs) {
     // Might not have parsed DWO ID yet.
     if (!DWOCU->getDWOId()) {
       if (Optional<uint64_t> DWOId =
@@ -782,82 +793,76 @@ bool DWARFContext::verify(raw_ostream &OS, DIDumpOptions DumpOpts) {
 }
 
 const DWARFUnitIndex &DWARFContext::getCUIndex() {
-  if (CUIndex)
-    return *CUIndex;
+  llvm::call_once(CUIndexOnce, [&] {
+    DataExtractor CUIndexData(DObj->getCUIndexSection(), isLittleEndian(), 0);
 
-  DataExtractor CUIndexData(DObj->getCUIndexSection(), isLittleEndian(), 0);
-
-  CUIndex = std::make_unique<DWARFUnitIndex>(DW_SECT_INFO);
-  CUIndex->parse(CUIndexData);
+    CUIndex = std::make_unique<DWARFUnitIndex>(DW_SECT_INFO);
+    CUIndex->parse(CUIndexData);
+  });
   return *CUIndex;
 }
 
 const DWARFUnitIndex &DWARFContext::getTUIndex() {
-  if (TUIndex)
-    return *TUIndex;
+  llvm::call_once(TUIndexOnce, [&] {
+    DataExtractor TUIndexData(DObj->getTUIndexSection(), isLittleEndian(), 0);
 
-  DataExtractor TUIndexData(DObj->getTUIndexSection(), isLittleEndian(), 0);
-
-  TUIndex = std::make_unique<DWARFUnitIndex>(DW_SECT_EXT_TYPES);
-  TUIndex->parse(TUIndexData);
+    TUIndex = std::make_unique<DWARFUnitIndex>(DW_SECT_EXT_TYPES);
+    TUIndex->parse(TUIndexData);
+  });
   return *TUIndex;
 }
 
 DWARFGdbIndex &DWARFContext::getGdbIndex() {
-  if (GdbIndex)
-    return *GdbIndex;
-
-  DataExtractor GdbIndexData(DObj->getGdbIndexSection(), true /*LE*/, 0);
-  GdbIndex = std::make_unique<DWARFGdbIndex>();
-  GdbIndex->parse(GdbIndexData);
+  llvm::call_once(GdbIndexOnce, [&] {
+    DataExtractor GdbIndexData(DObj->getGdbIndexSection(), true /*LE*/, 0);
+    GdbIndex = std::make_unique<DWARFGdbIndex>();
+    GdbIndex->parse(GdbIndexData);
+  });
   return *GdbIndex;
 }
 
 const DWARFDebugAbbrev *DWARFContext::getDebugAbbrev() {
-  if (Abbrev)
-    return Abbrev.get();
+  llvm::call_once(AbbrevOnce, [&] {
+    DataExtractor abbrData(DObj->getAbbrevSection(), isLittleEndian(), 0);
 
-  DataExtractor abbrData(DObj->getAbbrevSection(), isLittleEndian(), 0);
-
-  Abbrev.reset(new DWARFDebugAbbrev());
-  Abbrev->extract(abbrData);
+    Abbrev.reset(new DWARFDebugAbbrev());
+    Abbrev->extract(abbrData);
+  });
   return Abbrev.get();
 }
 
 const DWARFDebugAbbrev *DWARFContext::getDebugAbbrevDWO() {
-  if (AbbrevDWO)
-    return AbbrevDWO.get();
-
-  DataExtractor abbrData(DObj->getAbbrevDWOSection(), isLittleEndian(), 0);
-  AbbrevDWO.reset(new DWARFDebugAbbrev());
-  AbbrevDWO->extract(abbrData);
+  llvm::call_once(AbbrevDWOOnce, [&] {
+    DataExtractor abbrData(DObj->getAbbrevDWOSection(), isLittleEndian(), 0);
+    AbbrevDWO.reset(new DWARFDebugAbbrev());
+    AbbrevDWO->extract(abbrData);
+  });
   return AbbrevDWO.get();
 }
 
 const DWARFDebugLoc *DWARFContext::getDebugLoc() {
-  if (Loc)
-    return Loc.get();
-
-  // Assume all units have the same address byte size.
-  auto LocData =
-      getNumCompileUnits()
-          ? DWARFDataExtractor(*DObj, DObj->getLocSection(), isLittleEndian(),
-                               getUnitAtIndex(0)->getAddressByteSize())
-          : DWARFDataExtractor("", isLittleEndian(), 0);
-  Loc.reset(new DWARFDebugLoc(std::move(LocData)));
+  llvm::call_once(LocOnce, [&] {
+    // Assume all units have the same address byte size.
+    auto LocData =
+        getNumCompileUnits()
+            ? DWARFDataExtractor(*DObj, DObj->getLocSection(), isLittleEndian(),
+                                 getUnitAtIndex(0)->getAddressByteSize())
+            : DWARFDataExtractor("", isLittleEndian(), 0);
+    Loc.reset(new DWARFDebugLoc(std::move(LocData)));
+  });
   return Loc.get();
 }
 
 const DWARFDebugAranges *DWARFContext::getDebugAranges() {
-  if (Aranges)
-    return Aranges.get();
-
-  Aranges.reset(new DWARFDebugAranges());
-  Aranges->generate(this);
+  llvm::call_once(ArangesOnce, [&] {
+    Aranges.reset(new DWARFDebugAranges());
+    Aranges->generate(this);
+  });
   return Aranges.get();
 }
 
 Expected<const DWARFDebugFrame *> DWARFContext::getDebugFrame() {
+  std::lock_guard<std::mutex> Lock(FrameMutex);
   if (DebugFrame)
     return DebugFrame.get();
 
@@ -884,6 +889,7 @@ Expected<const DWARFDebugFrame *> DWARFContext::getDebugFrame() {
 }
 
 Expected<const DWARFDebugFrame *> DWARFContext::getEHFrame() {
+  std::lock_guard<std::mutex> Lock(FrameMutex);
   if (EHFrame)
     return EHFrame.get();
 
@@ -900,67 +906,70 @@ Expected<const DWARFDebugFrame *> DWARFContext::getEHFrame() {
 }
 
 const DWARFDebugMacro *DWARFContext::getDebugMacro() {
-  if (!Macro)
-    Macro = parseMacroOrMacinfo(MacroSection);
+  llvm::call_once(MacroOnce,
+                  [&] { Macro = parseMacroOrMacinfo(MacroSection); });
   return Macro.get();
 }
 
 const DWARFDebugMacro *DWARFContext::getDebugMacroDWO() {
-  if (!MacroDWO)
-    MacroDWO = parseMacroOrMacinfo(MacroDwoSection);
+  llvm::call_once(MacroDWOOnce,
+                  [&] { MacroDWO = parseMacroOrMacinfo(MacroDwoSection); });
   return MacroDWO.get();
 }
 
 const DWARFDebugMacro *DWARFContext::getDebugMacinfo() {
-  if (!Macinfo)
-    Macinfo = parseMacroOrMacinfo(MacinfoSection);
+  llvm::call_once(MacinfoOnce,
+                  [&] { Macinfo = parseMacroOrMacinfo(MacinfoSection); });
   return Macinfo.get();
 }
 
 const DWARFDebugMacro *DWARFContext::getDebugMacinfoDWO() {
-  if (!MacinfoDWO)
-    MacinfoDWO = parseMacroOrMacinfo(MacinfoDwoSection);
+  llvm::call_once(MacinfoDWOOnce,
+                  [&] { MacinfoDWO = parseMacroOrMacinfo(MacinfoDwoSection); });
   return MacinfoDWO.get();
 }
 
 template <typename T>
-static T &getAccelTable(std::unique_ptr<T> &Cache, const DWARFObject &Obj,
-                        const DWARFSection &Section, StringRef StringSection,
-                        bool IsLittleEndian) {
-  if (Cache)
-    return *Cache;
-  DWARFDataExtractor AccelSection(Obj, Section, IsLittleEndian, 0);
-  DataExtractor StrData(StringSection, IsLittleEndian, 0);
-  Cache.reset(new T(AccelSection, StrData));
-  if (Error E = Cache->extract())
-    llvm::consumeError(std::move(E));
+static T &getAccelTable(std::unique_ptr<T> &Cache, llvm::once_flag &Once,
+                        const DWARFObject &Obj, const DWARFSection &Section,
+                        StringRef StringSection, bool IsLittleEndian) {
+  llvm::call_once(Once, [&] {
+    DWARFDataExtractor AccelSection(Obj, Section, IsLittleEndian, 0);
+    DataExtractor StrData(StringSection, IsLittleEndian, 0);
+    Cache.reset(new T(AccelSection, StrData));
+    if (Error E = Cache->extract())
+      llvm::consumeError(std::move(E));
+  });
   return *Cache;
 }
 
 const DWARFDebugNames &DWARFContext::getDebugNames() {
-  return getAccelTable(Names, *DObj, DObj->getNamesSection(),
+  return getAccelTable(Names, NamesOnce, *DObj, DObj->getNamesSection(),
                        DObj->getStrSection(), isLittleEndian());
 }
 
 const AppleAcceleratorTable &DWARFContext::getAppleNames() {
-  return getAccelTable(AppleNames, *DObj, DObj->getAppleNamesSection(),
-                       DObj->getStrSection(), isLittleEndian());
+  return getAccelTable(AppleNames, AppleNamesOnce, *DObj,
+                       DObj->getAppleNamesSection(), DObj->getStrSection(),
+                       isLittleEndian());
 }
 
 const AppleAcceleratorTable &DWARFContext::getAppleTypes() {
-  return getAccelTable(AppleTypes, *DObj, DObj->getAppleTypesSection(),
-                       DObj->getStrSection(), isLittleEndian());
+  return getAccelTable(AppleTypes, AppleTypesOnce, *DObj,
+                       DObj->getAppleTypesSection(), DObj->getStrSection(),
+                       isLittleEndian());
 }
 
 const AppleAcceleratorTable &DWARFContext::getAppleNamespaces() {
-  return getAccelTable(AppleNamespaces, *DObj,
+  return getAccelTable(AppleNamespaces, AppleNamespacesOnce, *DObj,
                        DObj->getAppleNamespacesSection(),
                        DObj->getStrSection(), isLittleEndian());
 }
 
 const AppleAcceleratorTable &DWARFContext::getAppleObjC() {
-  return getAccelTable(AppleObjC, *DObj, DObj->getAppleObjCSection(),
-                       DObj->getStrSection(), isLittleEndian());
+  return getAccelTable(AppleObjC, AppleObjCOnce, *DObj,
+                       DObj->getAppleObjCSection(), DObj->getStrSection(),
+                       isLittleEndian());
 }
 
 const DWARFDebugLine::LineTable *
@@ -976,9 +985,6 @@ DWARFContext::getLineTableForUnit(DWARFUnit *U) {
 
 Expected<const DWARFDebugLine::LineTable *> DWARFContext::getLineTableForUnit(
     DWARFUnit *U, function_ref<void(Error)> RecoverableErrorHandler) {
-  if (!Line)
-    Line.reset(new DWARFDebugLine);
-
   auto UnitDIE = U->getUnitDIE();
   if (!UnitDIE)
     return nullptr;
@@ -988,6 +994,10 @@ Expected<const DWARFDebugLine::LineTable *> DWARFContext::getLineTableForUnit(
     return nullptr; // No line table for this compile unit.
 
   uint64_t stmtOffset = *Offset + U->getLineTableOffset();
+  std::lock_guard<std::mutex> Lock(LineMutex);
+  if (!Line)
+    Line.reset(new DWARFDebugLine);
+
   // See if the line table is cached.
   if (const DWARFLineTable *lt = Line->getLineTable(stmtOffset))
     return lt;
@@ -1004,9 +1014,6 @@ Expected<const DWARFDebugLine::LineTable *> DWARFContext::getLineTableForUnit(
 }
 
 void DWARFContext::clearLineTableForUnit(DWARFUnit *U) {
-  if (!Line)
-    return;
-
   auto UnitDIE = U->getUnitDIE();
   if (!UnitDIE)
     return;
@@ -1016,22 +1023,27 @@ void DWARFContext::clearLineTableForUnit(DWARFUnit *U) {
     return;
 
   uint64_t stmtOffset = *Offset + U->getLineTableOffset();
-  Line->clearLineTable(stmtOffset);
+  std::lock_guard<std::mutex> Lock(LineMutex);
+  if (Line)
+    Line->clearLineTable(stmtOffset);
 }
 
 void DWARFContext::parseNormalUnits() {
-  if (!NormalUnits.empty())
-    return;
-  DObj->forEachInfoSections([&](const DWARFSection &S) {
-    NormalUnits.addUnitsForSection(*this, S, DW_SECT_INFO);
-  });
-  NormalUnits.finishedInfoUnits();
-  DObj->forEachTypesSections([&](const DWARFSection &S) {
-    NormalUnits.addUnitsForSection(*this, S, DW_SECT_EXT_TYPES);
+  llvm::call_once(NormalUnitsOnce, [&] {
+    DObj->forEachInfoSections([&](const DWARFSection &S) {
+      NormalUnits.addUnitsForSection(*this, S, DW_SECT_INFO);
+    });
+    NormalUnits.finishedInfoUnits();
+    DObj->forEachTypesSections([&](const DWARFSection &S) {
+      NormalUnits.addUnitsForSection(*this, S, DW_SECT_EXT_TYPES);
+    });
   });
 }
 
 void DWARFContext::parseDWOUnits(bool Lazy) {
+  // Not a once-initialization: units that were only set up for lazy parsing
+  // are still all parsed by a later eager request.
+  std::lock_guard<std::mutex> Lock(DWOUnitsMutex);
   if (!DWOUnits.empty())
     return;
   DObj->forEachInfoDWOSections([&](const DWARFSection &S) {
@@ -1400,6 +1412,7 @@ DWARFContext::getInliningInfoForAddress(object::SectionedAddress Address,
 
 std::shared_ptr<DWARFContext>
 DWARFContext::getDWOContext(StringRef AbsolutePath) {
+  std::lock_guard<std::mutex> Lock(DWOFilesMutex);
   if (auto S = DWP.lock()) {
     DWARFContext *Ctxt = S->Context.get();
     return std::shared_ptr<DWARFContext>(std::move(S), Ctxt);
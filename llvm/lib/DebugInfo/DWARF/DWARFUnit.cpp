@@ -484,9 +484,16 @@ void DWARFUnit::extractDIEsIfNeeded(bool CUDieOnly) {
 }
 
 Error DWARFUnit::tryExtractDIEsIfNeeded(bool CUDieOnly) {
-  if ((CUDieOnly && !DieArray.empty()) ||
-      DieArray.size() > 1)
-    return Error::success(); // Already parsed.
+  {
+    llvm::sys::ScopedReader Lock(DieArrayMutex);
+    if ((CUDieOnly && !DieArray.empty()) || DieArray.size() > 1)
+      return Error::success(); // Already parsed.
+  }
+
+  llvm::sys::ScopedWriter Lock(DieArrayMutex);
+  // Another thread may have extracted the DIEs while we were waiting.
+  if ((CUDieOnly && !DieArray.empty()) || DieArray.size() > 1)
+    return Error::success();
 
   bool HasCUDie = !DieArray.empty();
   extractDIEsToVector(!HasCUDie, !CUDieOnly, DieArray);
@@ -590,6 +597,7 @@ Error DWARFUnit::tryExtractDIEsIfNeeded(bool CUDieOnly) {
 bool DWARFUnit::parseDWO(StringRef DWOAlternativeLocation) {
   if (IsDWO)
     return false;
+  std::lock_guard<std::mutex> Lock(DWOMutex);
   if (DWO.get())
     return false;
   DWARFDie UnitDie = getUnitDIE();
@@ -645,6 +653,7 @@ void DWARFUnit::clearDIEs(bool KeepCUDie) {
   // It depends on the implementation whether the request is fulfilled.
   // Create a new vector with a small capacity and assign it to the DieArray to
   // have previous contents freed.
+  llvm::sys::ScopedWriter Lock(DieArrayMutex);
   DieArray = (KeepCUDie && !DieArray.empty())
                  ? std::vector<DWARFDebugInfoEntry>({DieArray[0]})
                  : std::vector<DWARFDebugInfoEntry>();
@@ -749,6 +758,7 @@ void DWARFUnit::updateAddressDieMap(DWARFDie Die) {
 
 DWARFDie DWARFUnit::getSubroutineForAddress(uint64_t Address) {
   extractDIEsIfNeeded(false);
+  std::lock_guard<std::mutex> Lock(AddrDieMapMutex);
   if (AddrDieMap.empty())
     updateAddressDieMap(getUnitDIE());
   auto R = AddrDieMap.upper_bound(Address);
@@ -840,6 +850,7 @@ DWARFDie DWARFUnit::getVariableForAddress(uint64_t Address) {
 
   auto RootDie = getUnitDIE();
 
+  std::lock_guard<std::mutex> Lock(VariableDieMapMutex);
   auto RootLookup = RootsParsedForVariables.insert(RootDie.getOffset());
   if (RootLookup.second)
     updateVariableDieMap(RootDie);
@@ -1039,12 +1050,17 @@ DWARFUnit::getLastChildEntry(const DWARFDebugInfoEntry *Die) const {
 }
 
 const DWARFAbbreviationDeclarationSet *DWARFUnit::getAbbreviations() const {
-  if (!Abbrevs)
-    Abbrevs = Abbrev->getAbbreviationDeclarationSet(getAbbreviationsOffset());
-  return Abbrevs;
+  // Racing threads look up the same set, so the first store can be kept.
+  const DWARFAbbreviationDeclarationSet *Set = Abbrevs.load();
+  if (!Set) {
+    Set = Abbrev->getAbbreviationDeclarationSet(getAbbreviationsOffset());
+    Abbrevs.store(Set);
+  }
+  return Set;
 }
 
 llvm::Optional<object::SectionedAddress> DWARFUnit::getBaseAddress() {
+  std::lock_guard<std::mutex> Lock(BaseAddrMutex);
   if (BaseAddr)
     return BaseAddr;
 
@@ -1136,7 +1152,11 @@ parseDWARFStringOffsetsTableHeader(DWARFDataExtractor &DA,
 Expected<Optional<StrOffsetsContributionDescriptor>>
 DWARFUnit::determineStringOffsetsTableContribution(DWARFDataExtractor &DA) {
   assert(!IsDWO);
-  auto OptOffset = toSectionOffset(getUnitDIE().find(DW_AT_str_offsets_base));
+  // This is called while the DIEs are being extracted, so the unit DIE must
+  // be read from DieArray directly rather than through getUnitDIE().
+  assert(!DieArray.empty());
+  DWARFDie UnitDie(this, &DieArray[0]);
+  auto OptOffset = toSectionOffset(UnitDie.find(DW_AT_str_offsets_base));
   if (!OptOffset)
     return None;
   auto DescOrError =
@@ -29,8 +29,10 @@
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/WithColor.h"
 #include "llvm/Support/raw_ostream.h"
+#include <future>
 #include <map>
 #include <set>
 #include <vector>
@@ -333,23 +335,100 @@ bool DWARFVerifier::handleDebugAbbrev() {
   return NumErrors == 0;
 }
 
+static void printUnitHeader(raw_ostream &OS, unsigned Index,
+                            const DWARFUnitVector &Units) {
+  OS << "Verifying unit: " << Index + 1 << " / " << Units.getNumUnits();
+  if (const char *Name = Units[Index]->getUnitDIE(true).getShortName())
+    OS << ", \"" << Name << '\"';
+  OS << '\n';
+  OS.flush();
+}
+
+unsigned DWARFVerifier::verifyUnit(DWARFUnit &Unit,
+                                   ReferenceMap &CrossUnitReferences) {
+  ReferenceMap UnitLocalReferences;
+  unsigned NumErrors =
+      verifyUnitContents(Unit, UnitLocalReferences, CrossUnitReferences);
+  NumErrors += verifyDebugInfoReferences(
+      UnitLocalReferences, [&](uint64_t Offset) { return &Unit; });
+  return NumErrors;
+}
+
+namespace {
+/// Buffers the output of a verifier running on a worker thread. Colors are
+/// enabled if they are enabled for the stream the buffer is printed to.
+class BufferedVerifierOutput : public raw_string_ostream {
+  bool Colors;
+
+public:
+  BufferedVerifierOutput(std::string &Buffer, const raw_ostream &OS)
+      : raw_string_ostream(Buffer), Colors(OS.has_colors()) {
+    enable_colors(Colors);
+  }
+
+  bool has_colors() const override { return Colors; }
+};
+} // namespace
+
+unsigned
+DWARFVerifier::verifyUnitsConcurrently(const DWARFUnitVector &Units,
+                                       ReferenceMap &CrossUnitReferences) {
+  // Build the state that is shared between units, and created lazily, before
+  // starting the threads: the abbreviations of each unit, the line tables and
+  // the type unit signature maps. DIEs are extracted in parallel.
+  for (const auto &Unit : Units) {
+    Unit->getAbbreviations();
+    Unit->getContext().getLineTableForUnit(Unit.get());
+  }
+  DCtx.getTypeUnitForHash(0, 0, /*IsDWO=*/false);
+  DCtx.getTypeUnitForHash(0, 0, /*IsDWO=*/true);
+
+  struct UnitResult {
+    std::string Output;
+    unsigned NumErrors = 0;
+    ReferenceMap CrossUnitReferences;
+  };
+  std::vector<UnitResult> Results(Units.getNumUnits());
+  std::vector<std::shared_future<void>> Done;
+  ThreadPool Pool(hardware_concurrency(DumpOpts.NumThreads));
+  for (unsigned I = 0, E = Units.getNumUnits(); I != E; ++I)
+    Done.push_back(Pool.async([&, I] {
+      UnitResult &Result = Results[I];
+      BufferedVerifierOutput UnitOS(Result.Output, OS);
+      DWARFVerifier UnitVerifier(UnitOS, DCtx, DumpOpts);
+      Result.NumErrors =
+          UnitVerifier.verifyUnit(*Units[I], Result.CrossUnitReferences);
+      UnitOS.flush();
+    }));
+
+  unsigned NumDebugInfoErrors = 0;
+  for (unsigned I = 0, E = Units.getNumUnits(); I != E; ++I) {
+    Done[I].wait();
+    UnitResult &Result = Results[I];
+    printUnitHeader(OS, I, Units);
+    OS << Result.Output;
+    NumDebugInfoErrors += Result.NumErrors;
+    for (auto &Ref : Result.CrossUnitReferences)
+      CrossUnitReferences[Ref.first].insert(Ref.second.begin(),
+                                            Ref.second.end());
+    // Release the memory as we go.
+    Result = UnitResult();
+  }
+  Pool.wait();
+  return NumDebugInfoErrors;
+}
+
 unsigned DWARFVerifier::verifyUnits(const DWARFUnitVector &Units) {
   unsigned NumDebugInfoErrors = 0;
   ReferenceMap CrossUnitReferences;
 
-  unsigned Index = 1;
-  for (const auto &Unit : Units) {
-    OS << "Verifying unit: " << Index << " / " << Units.getNumUnits();
-    if (const char* Name = Unit->getUnitDIE(true).getShortName())
-      OS << ", \"" << Name << '\"';
-    OS << '\n';
-    OS.flush();
-    ReferenceMap UnitLocalReferences;
-    NumDebugInfoErrors +=
-        verifyUnitContents(*Unit, UnitLocalReferences, CrossUnitReferences);
-    NumDebugInfoErrors += verifyDebugInfoReferences(
-        UnitLocalReferences, [&](uint64_t Offset) { return Unit.get(); });
-    ++Index;
+  if (DumpOpts.NumThreads != 1 && Units.getNumUnits() > 1) {
+    NumDebugInfoErrors += verifyUnitsConcurrently(Units, CrossUnitReferences);
+  } else {
+    for (unsigned I = 0, E = Units.getNumUnits(); I != E; ++I) {
+      printUnitHeader(OS, I, Units);
+      NumDebugInfoErrors += verifyUnit(*Units[I], CrossUnitReferences);
+    }
   }
 
   NumDebugInfoErrors += verifyDebugInfoReferences(
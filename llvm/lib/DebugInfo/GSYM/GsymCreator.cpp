@@ -10,6 +10,8 @@
 #include "llvm/DebugInfo/GSYM/Header.h"
 #include "llvm/DebugInfo/GSYM/LineTable.h"
 #include "llvm/MC/StringTableBuilder.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include <algorithm>
@@ -25,6 +27,35 @@ GsymCreator::GsymCreator(bool Quiet)
   insertFile(StringRef());
 }
 
+GsymCreator::~GsymCreator() {
+  SpillBuffer.reset();
+  SpillStream.reset();
+  if (SpillFile)
+    consumeError(SpillFile->discard());
+}
+
+llvm::Error GsymCreator::enableSpilling(StringRef Directory,
+                                       llvm::support::endianness ByteOrder) {
+  std::lock_guard<std::mutex> Guard(Mutex);
+  if (SpillFile)
+    return createStringError(std::errc::invalid_argument,
+                             "spilling is already enabled");
+  if (!Funcs.empty())
+    return createStringError(std::errc::invalid_argument,
+                             "function infos were added before enabling "
+                             "spilling");
+  SmallString<128> Model(Directory);
+  sys::path::append(Model, "gsym-%%%%%%%%.spill");
+  Expected<sys::fs::TempFile> TempOrErr = sys::fs::TempFile::create(Model);
+  if (!TempOrErr)
+    return TempOrErr.takeError();
+  SpillFile.emplace(std::move(*TempOrErr));
+  SpillStream =
+      std::make_unique<raw_fd_ostream>(SpillFile->FD, /*shouldClose=*/false);
+  SpillByteOrder = ByteOrder;
+  return Error::success();
+}
+
 uint32_t GsymCreator::insertFile(StringRef Path, llvm::sys::path::Style Style) {
   llvm::StringRef directory = llvm::sys::path::parent_path(Path, Style);
   llvm::StringRef filename = llvm::sys::path::filename(Path, Style);
@@ -51,26 +82,43 @@ llvm::Error GsymCreator::save(StringRef Path,
   raw_fd_ostream OutStrm(Path, EC);
   if (EC)
     return llvm::errorCodeToError(EC);
+  if (SpillFile && ByteOrder != SpillByteOrder)
+    return createStringError(std::errc::invalid_argument,
+                             "function infos were spilled with a different "
+                             "byte order");
   FileWriter O(OutStrm, ByteOrder);
   return encode(O);
 }
 
 llvm::Error GsymCreator::encode(FileWriter &O) const {
   std::lock_guard<std::mutex> Guard(Mutex);
-  if (Funcs.empty())
+  const size_t NumFuncs = getNumFunctionInfosLocked();
+  if (NumFuncs == 0)
     return createStringError(std::errc::invalid_argument,
                              "no functions to encode");
   if (!Finalized)
     return createStringError(std::errc::invalid_argument,
                              "GsymCreator wasn't finalized prior to encoding");
 
-  if (Funcs.size() > UINT32_MAX)
+  if (NumFuncs > UINT32_MAX)
     return createStringError(std::errc::invalid_argument,
                              "too many FunctionInfos");
 
-  const uint64_t MinAddr =
-      BaseAddress ? *BaseAddress : Funcs.front().startAddress();
-  const uint64_t MaxAddr = Funcs.back().startAddress();
+  if (SpillFile && O.getByteOrder() != SpillByteOrder)
+    return createStringError(std::errc::invalid_argument,
+                             "function infos were spilled with a different "
+                             "byte order");
+
+  // Only one of the lists is populated.
+  std::vector<uint64_t> StartAddrs;
+  StartAddrs.reserve(NumFuncs);
+  for (const auto &FuncInfo : Funcs)
+    StartAddrs.push_back(FuncInfo.startAddress());
+  for (const auto &SFI : SpilledFuncs)
+    StartAddrs.push_back(SFI.Range.start());
+
+  const uint64_t MinAddr = BaseAddress ? *BaseAddress : StartAddrs.front();
+  const uint64_t MaxAddr = StartAddrs.back();
   const uint64_t AddrDelta = MaxAddr - MinAddr;
   Header Hdr;
   Hdr.Magic = GSYM_MAGIC;
@@ -78,7 +126,7 @@ llvm::Error GsymCreator::encode(FileWriter &O) const {
   Hdr.AddrOffSize = 0;
   Hdr.UUIDSize = static_cast<uint8_t>(UUID.size());
   Hdr.BaseAddress = MinAddr;
-  Hdr.NumAddresses = static_cast<uint32_t>(Funcs.size());
+  Hdr.NumAddresses = static_cast<uint32_t>(NumFuncs);
   Hdr.StrtabOffset = 0; // We will fix this up later.
   Hdr.StrtabSize = 0;   // We will fix this up later.
   memset(Hdr.UUID, 0, sizeof(Hdr.UUID));
@@ -104,8 +152,8 @@ llvm::Error GsymCreator::encode(FileWriter &O) const {
 
   // Write out the address offsets.
   O.alignTo(Hdr.AddrOffSize);
-  for (const auto &FuncInfo : Funcs) {
-    uint64_t AddrOffset = FuncInfo.startAddress() - Hdr.BaseAddress;
+  for (uint64_t StartAddr : StartAddrs) {
+    uint64_t AddrOffset = StartAddr - Hdr.BaseAddress;
     switch (Hdr.AddrOffSize) {
     case 1:
       O.writeU8(static_cast<uint8_t>(AddrOffset));
@@ -125,7 +173,7 @@ llvm::Error GsymCreator::encode(FileWriter &O) const {
   // Write out all zeros for the AddrInfoOffsets.
   O.alignTo(4);
   const off_t AddrInfoOffsetsOffset = O.tell();
-  for (size_t i = 0, n = Funcs.size(); i < n; ++i)
+  for (size_t i = 0; i < NumFuncs; ++i)
     O.writeU32(0);
 
   // Write out the file table
@@ -144,7 +192,10 @@ llvm::Error GsymCreator::encode(FileWriter &O) const {
 
   // Write out the sting table.
   const off_t StrtabOffset = O.tell();
-  StrTab.write(O.get_stream());
+  {
+    std::lock_guard<std::mutex> StrTabGuard(StrTabMutex);
+    StrTab.write(O.get_stream());
+  }
   const off_t StrtabSize = O.tell() - StrtabOffset;
   std::vector<uint32_t> AddrInfoOffsets;
 
@@ -155,6 +206,15 @@ llvm::Error GsymCreator::encode(FileWriter &O) const {
     else
       return OffsetOrErr.takeError();
   }
+  // Spilled function infos are already encoded. The size is rewritten since
+  // finalize() may have extended the last function.
+  for (const auto &SFI : SpilledFuncs) {
+    O.alignTo(4);
+    AddrInfoOffsets.push_back(O.tell());
+    StringRef Bytes = getSpilledBytes(SFI);
+    O.writeU32(static_cast<uint32_t>(SFI.Range.size()));
+    O.writeData(arrayRefFromStringRef(Bytes.drop_front(4)));
+  }
   // Fixup the string table offset and size in the header
   O.fixup32((uint32_t)StrtabOffset, offsetof(Header, StrtabOffset));
   O.fixup32((uint32_t)StrtabSize, offsetof(Header, StrtabSize));
@@ -188,18 +248,12 @@ static ForwardIt removeIfBinary(ForwardIt FirstIt, ForwardIt LastIt,
   return FirstIt;
 }
 
-llvm::Error GsymCreator::finalize(llvm::raw_ostream &OS) {
-  std::lock_guard<std::mutex> Guard(Mutex);
-  if (Finalized)
-    return createStringError(std::errc::invalid_argument, "already finalized");
-  Finalized = true;
-
-  // Sort function infos so we can emit sorted functions.
-  llvm::sort(Funcs);
-
-  // Don't let the string table indexes change by finalizing in order.
-  StrTab.finalizeInOrder();
-
+// Remove duplicates and overlapping entries from the sorted list of function
+// infos \p Funcs. \p Equal decides whether two entries with the same range
+// are identical, and \p Print describes an entry in warnings.
+template <class FuncT, class EqualFn, class PrintFn>
+static void pruneFunctionInfos(std::vector<FuncT> &Funcs, raw_ostream &OS,
+                               bool Quiet, EqualFn Equal, PrintFn Print) {
   // Remove duplicates function infos that have both entries from debug info
   // (DWARF or Breakpad) and entries from the SymbolTable.
   //
@@ -220,7 +274,6 @@ llvm::Error GsymCreator::finalize(llvm::raw_ostream &OS) {
   // Note that in case of (b), we cannot include Y in the result because then
   // we wouldn't find any function for range (end of Y, end of X)
   // with binary search
-  auto NumBefore = Funcs.size();
   Funcs.erase(
       removeIfBinary(Funcs.begin(), Funcs.end(),
                      [&](const auto &Prev, const auto &Curr) {
@@ -237,7 +290,7 @@ llvm::Error GsymCreator::finalize(llvm::raw_ostream &OS) {
                            // sorting guarantees that entries with matching
                            // address ranges that have debug info are last in
                            // the sort.
-                           if (Prev == Curr) {
+                           if (Equal(Prev, Curr)) {
                              // FunctionInfo entries match exactly (range,
                              // lines, inlines)
 
@@ -256,26 +309,32 @@ llvm::Error GsymCreator::finalize(llvm::raw_ostream &OS) {
                                if (!Quiet) {
                                  OS << "warning: same address range contains "
                                        "different debug "
-                                    << "info. Removing:\n"
-                                    << Prev << "\nIn favor of this one:\n"
-                                    << Curr << "\n";
+                                    << "info. Removing:\n";
+                                 Print(Prev);
+                                 OS << "\nIn favor of this one:\n";
+                                 Print(Curr);
+                                 OS << "\n";
                                }
                                return true;
                              }
                            }
                          } else {
                            if (!Quiet) { // print warnings about overlaps
-                             OS << "warning: function ranges overlap:\n"
-                                << Prev << "\n"
-                                << Curr << "\n";
+                             OS << "warning: function ranges overlap:\n";
+                             Print(Prev);
+                             OS << "\n";
+                             Print(Curr);
+                             OS << "\n";
                            }
                          }
                        } else if (Prev.Range.size() == 0 &&
                                   Curr.Range.contains(Prev.Range.start())) {
                          if (!Quiet) {
-                           OS << "warning: removing symbol:\n"
-                              << Prev << "\nKeeping:\n"
-                              << Curr << "\n";
+                           OS << "warning: removing symbol:\n";
+                           Print(Prev);
+                           OS << "\nKeeping:\n";
+                           Print(Curr);
+                           OS << "\n";
                          }
                          return true;
                        }
@@ -283,7 +342,11 @@ llvm::Error GsymCreator::finalize(llvm::raw_ostream &OS) {
                        return false;
                      }),
       Funcs.end());
+}
 
+template <class FuncT>
+static void extendLastFunction(std::vector<FuncT> &Funcs,
+                               const Optional<AddressRanges> &ValidTextRanges) {
   // If our last function info entry doesn't have a size and if we have valid
   // text ranges, we should set the size of the last entry since any search for
   // a high address might match our last entry. By fixing up this size, we can
@@ -295,8 +358,73 @@ llvm::Error GsymCreator::finalize(llvm::raw_ostream &OS) {
       Funcs.back().Range = {Funcs.back().Range.start(), Range->end()};
     }
   }
-  OS << "Pruned " << NumBefore - Funcs.size() << " functions, ended with "
-     << Funcs.size() << " total\n";
+}
+
+llvm::Error GsymCreator::finalize(llvm::raw_ostream &OS) {
+  std::lock_guard<std::mutex> Guard(Mutex);
+  if (Finalized)
+    return createStringError(std::errc::invalid_argument, "already finalized");
+  Finalized = true;
+
+  if (SpillError)
+    return createStringError(std::errc::invalid_argument, "%s",
+                             SpillError->c_str());
+
+  // Don't let the string table indexes change by finalizing in order.
+  {
+    std::lock_guard<std::mutex> StrTabGuard(StrTabMutex);
+    StrTab.finalizeInOrder();
+  }
+
+  auto NumBefore = getNumFunctionInfosLocked();
+  if (SpillFile) {
+    // Map the spill file back so that the encoded bytes can be compared while
+    // pruning and copied by encode().
+    SpillStream->flush();
+    if (SpillStream->has_error())
+      return errorCodeToError(SpillStream->error());
+    auto BufferOrErr = MemoryBuffer::getOpenFile(
+        sys::fs::convertFDToNativeFile(SpillFile->FD), SpillFile->TmpName,
+        SpillSize, /*RequiresNullTerminator=*/false);
+    if (!BufferOrErr)
+      return errorCodeToError(BufferOrErr.getError());
+    SpillBuffer = std::move(*BufferOrErr);
+
+    // Sort in the same order as FunctionInfo: entries with more information
+    // come last for the same range.
+    llvm::sort(SpilledFuncs, [&](const SpilledFunctionInfo &LHS,
+                                 const SpilledFunctionInfo &RHS) {
+      if (LHS.Range != RHS.Range)
+        return LHS.Range < RHS.Range;
+      if (LHS.HasInline != RHS.HasInline)
+        return RHS.HasInline;
+      if (LHS.HasLineTable != RHS.HasLineTable)
+        return RHS.HasLineTable;
+      return getSpilledBytes(LHS) < getSpilledBytes(RHS);
+    });
+    pruneFunctionInfos(
+        SpilledFuncs, OS, Quiet,
+        [&](const SpilledFunctionInfo &LHS, const SpilledFunctionInfo &RHS) {
+          return getSpilledBytes(LHS) == getSpilledBytes(RHS);
+        },
+        [&](const SpilledFunctionInfo &SFI) {
+          OS << SFI.Range << ": encoded in " << SFI.Size << " bytes";
+        });
+    extendLastFunction(SpilledFuncs, ValidTextRanges);
+  } else {
+    // Sort function infos so we can emit sorted functions.
+    llvm::sort(Funcs);
+    pruneFunctionInfos(
+        Funcs, OS, Quiet,
+        [](const FunctionInfo &LHS, const FunctionInfo &RHS) {
+          return LHS == RHS;
+        },
+        [&](const FunctionInfo &FI) { OS << FI; });
+    extendLastFunction(Funcs, ValidTextRanges);
+  }
+
+  OS << "Pruned " << NumBefore - getNumFunctionInfosLocked()
+     << " functions, ended with " << getNumFunctionInfosLocked() << " total\n";
   return Error::success();
 }
 
@@ -306,7 +434,7 @@ uint32_t GsymCreator::insertString(StringRef S, bool Copy) {
 
   // The hash can be calculated outside the lock.
   CachedHashStringRef CHStr(S);
-  std::lock_guard<std::mutex> Guard(Mutex);
+  std::lock_guard<std::mutex> Guard(StrTabMutex);
   if (Copy) {
     // We need to provide backing storage for the string if requested
     // since StringTableBuilder stores references to strings. Any string
@@ -322,9 +450,33 @@ uint32_t GsymCreator::insertString(StringRef S, bool Copy) {
 }
 
 void GsymCreator::addFunctionInfo(FunctionInfo &&FI) {
+  if (!SpillFile) {
+    std::lock_guard<std::mutex> Guard(Mutex);
+    Ranges.insert(FI.Range);
+    Funcs.emplace_back(std::move(FI));
+    return;
+  }
+
+  // Encode outside the lock so that threads converting debug info in
+  // parallel only serialize on appending the bytes to the spill file.
+  SmallString<512> Bytes;
+  raw_svector_ostream BytesOS(Bytes);
+  FileWriter FW(BytesOS, SpillByteOrder);
+  Expected<uint64_t> OffsetOrErr = FI.encode(FW);
   std::lock_guard<std::mutex> Guard(Mutex);
+  if (!OffsetOrErr) {
+    std::string Msg = toString(OffsetOrErr.takeError());
+    if (!SpillError)
+      SpillError = std::move(Msg);
+    return;
+  }
   Ranges.insert(FI.Range);
-  Funcs.emplace_back(std::move(FI));
+  SpilledFuncs.push_back({FI.Range, SpillSize,
+                          static_cast<uint32_t>(Bytes.size()),
+                          FI.Inline.has_value(),
+                          FI.OptLineTable.has_value()});
+  SpillStream->write(Bytes.data(), Bytes.size());
+  SpillSize += Bytes.size();
 }
 
 void GsymCreator::forEachFunctionInfo(
@@ -347,7 +499,7 @@ void GsymCreator::forEachFunctionInfo(
 
 size_t GsymCreator::getNumFunctionInfos() const {
   std::lock_guard<std::mutex> Guard(Mutex);
-  return Funcs.size();
+  return getNumFunctionInfosLocked();
 }
 
 bool GsymCreator::IsValidTextAddress(uint64_t Addr) const {
@@ -0,0 +1,126 @@
+//===-- GsymDIContext.cpp ---------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/DebugInfo/GSYM/GsymDIContext.h"
+#include "llvm/DebugInfo/GSYM/GsymReader.h"
+#include "llvm/Support/Path.h"
+
+using namespace llvm;
+using namespace llvm::gsym;
+
+GsymDIContext::GsymDIContext(std::unique_ptr<GsymReader> Reader)
+    : DIContext(CK_GSYM), Reader(std::move(Reader)) {}
+
+GsymDIContext::~GsymDIContext() = default;
+
+void GsymDIContext::dump(raw_ostream &OS, DIDumpOptions DumpOpts) {
+  Reader->dump(OS);
+}
+
+static void fillLineInfoFromLocation(const SourceLocation &Location,
+                                     DILineInfoSpecifier Specifier,
+                                     DILineInfo &LineInfo) {
+  if (Specifier.FNKind != DINameKind::None)
+    LineInfo.FunctionName = Location.Name.str();
+
+  switch (Specifier.FLIKind) {
+  case DILineInfoSpecifier::FileLineInfoKind::None:
+    break;
+  case DILineInfoSpecifier::FileLineInfoKind::BaseNameOnly:
+    LineInfo.FileName = Location.Base.str();
+    break;
+  case DILineInfoSpecifier::FileLineInfoKind::RawValue:
+  case DILineInfoSpecifier::FileLineInfoKind::RelativeFilePath:
+  case DILineInfoSpecifier::FileLineInfoKind::AbsoluteFilePath: {
+    SmallString<128> Path(Location.Dir);
+    sys::path::append(Path, Location.Base);
+    LineInfo.FileName = std::string(Path);
+    break;
+  }
+  }
+  LineInfo.Line = Location.Line;
+}
+
+DILineInfo
+GsymDIContext::getLineInfoForAddress(object::SectionedAddress Address,
+                                     DILineInfoSpecifier Specifier) {
+  DILineInfo LineInfo;
+  auto ResultOrErr = Reader->lookup(Address.Address);
+  if (!ResultOrErr) {
+    consumeError(ResultOrErr.takeError());
+    return LineInfo;
+  }
+
+  LineInfo.StartAddress = ResultOrErr->FuncRange.start();
+  if (ResultOrErr->Locations.empty()) {
+    // Functions from the symbol table have no line table.
+    if (Specifier.FNKind != DINameKind::None)
+      LineInfo.FunctionName = ResultOrErr->FuncName.str();
+    return LineInfo;
+  }
+
+  // The innermost inlined frame comes first.
+  fillLineInfoFromLocation(ResultOrErr->Locations.front(), Specifier,
+                           LineInfo);
+  return LineInfo;
+}
+
+DILineInfo
+GsymDIContext::getLineInfoForDataAddress(object::SectionedAddress Address) {
+  // GSYM does not describe variables.
+  return DILineInfo();
+}
+
+DILineInfoTable
+GsymDIContext::getLineInfoForAddressRange(object::SectionedAddress Address,
+                                          uint64_t Size,
+                                          DILineInfoSpecifier Specifier) {
+  // GSYM lookups do not report where line table rows end, so only the start
+  // of the range can be described.
+  DILineInfoTable Table;
+  if (Size == 0)
+    return Table;
+  DILineInfo LineInfo = getLineInfoForAddress(Address, Specifier);
+  if (LineInfo.Line != 0)
+    Table.push_back(std::make_pair(Address.Address, LineInfo));
+  return Table;
+}
+
+DIInliningInfo
+GsymDIContext::getInliningInfoForAddress(object::SectionedAddress Address,
+                                         DILineInfoSpecifier Specifier) {
+  DIInliningInfo InlineInfo;
+  auto ResultOrErr = Reader->lookup(Address.Address);
+  if (!ResultOrErr) {
+    consumeError(ResultOrErr.takeError());
+    return InlineInfo;
+  }
+
+  if (ResultOrErr->Locations.empty()) {
+    DILineInfo LineInfo;
+    LineInfo.StartAddress = ResultOrErr->FuncRange.start();
+    if (Specifier.FNKind != DINameKind::None)
+      LineInfo.FunctionName = ResultOrErr->FuncName.str();
+    InlineInfo.addFrame(LineInfo);
+    return InlineInfo;
+  }
+
+  for (const SourceLocation &Location : ResultOrErr->Locations) {
+    DILineInfo LineInfo;
+    fillLineInfoFromLocation(Location, Specifier, LineInfo);
+    InlineInfo.addFrame(LineInfo);
+  }
+  InlineInfo.getMutableFrame(0)->StartAddress = ResultOrErr->FuncRange.start();
+  return InlineInfo;
+}
+
+std::vector<DILocal>
+GsymDIContext::getLocalsForAddress(object::SectionedAddress Address) {
+  // GSYM does not describe frame variables.
+  return std::vector<DILocal>();
+}
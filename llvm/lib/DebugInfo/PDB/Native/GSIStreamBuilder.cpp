@@ -378,17 +378,20 @@ void GSIStreamBuilder::addGlobalSymbol(const codeview::CVSymbol &Symbol) {
   Globals.push_back(Symbol);
 }
 
-// Serialize each public and write it.
+// Serialize all publics in parallel into one buffer and write it.
 static Error writePublics(BinaryStreamWriter &Writer,
                           ArrayRef<BulkPublic> Publics) {
-  std::vector<uint8_t> Storage;
-  for (const BulkPublic &Pub : Publics) {
-    Storage.resize(sizeOfPublic(Pub));
-    serializePublic(Storage.data(), Pub);
-    if (Error E = Writer.writeBytes(Storage))
-      return E;
-  }
-  return Error::success();
+  // Compute the offset of every record first so that they can be serialized
+  // independently.
+  std::vector<uint32_t> Offsets(Publics.size() + 1);
+  for (size_t I = 0, E = Publics.size(); I != E; ++I)
+    Offsets[I + 1] = Offsets[I] + sizeOfPublic(Publics[I]);
+
+  std::vector<uint8_t> Storage(Offsets.back());
+  parallelFor(0, Publics.size(), [&](size_t I) {
+    serializePublic(Storage.data() + Offsets[I], Publics[I]);
+  });
+  return Writer.writeBytes(Storage);
 }
 
 static Error writeRecords(BinaryStreamWriter &Writer,
@@ -14,6 +14,11 @@
 
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/DebugInfo/DWARF/DWARFContext.h"
+#include "llvm/DebugInfo/GSYM/DwarfTransformer.h"
+#include "llvm/DebugInfo/GSYM/GsymCreator.h"
+#include "llvm/DebugInfo/GSYM/GsymDIContext.h"
+#include "llvm/DebugInfo/GSYM/GsymReader.h"
+#include "llvm/DebugInfo/GSYM/ObjectFileTransformer.h"
 #include "llvm/DebugInfo/PDB/PDB.h"
 #include "llvm/DebugInfo/PDB/PDBContext.h"
 #include "llvm/DebugInfo/Symbolize/SymbolizableObjectFile.h"
@@ -30,6 +35,7 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/Threading.h"
 #include <algorithm>
 #include <cassert>
 #include <cstring>
@@ -555,6 +561,74 @@ LLVMSymbolizer::createModuleInfo(const ObjectFile *Obj,
   return InsertResult.first->second.get();
 }
 
+// Convert the DWARF and symbol table of Obj to a GSYM file at Path. The file
+// is written under a temporary name and renamed into place, so concurrent
+// symbolizers sharing a cache directory never see a partial file.
+static Error createGsymFile(const ObjectFile &Obj, StringRef Path) {
+  gsym::GsymCreator Gsym(/*Quiet=*/true);
+
+  AddressRanges TextRanges;
+  for (const SectionRef &Sect : Obj.sections()) {
+    if (!Sect.isText() || Sect.getSize() == 0)
+      continue;
+    TextRanges.insert(
+        AddressRange(Sect.getAddress(), Sect.getAddress() + Sect.getSize()));
+  }
+  if (!TextRanges.empty())
+    Gsym.SetValidTextRanges(TextRanges);
+
+  std::unique_ptr<DWARFContext> DICtx = DWARFContext::create(Obj);
+  gsym::DwarfTransformer DT(*DICtx, nulls(), Gsym);
+  if (Error Err = DT.convert(hardware_concurrency().compute_thread_count()))
+    return Err;
+  if (Error Err = gsym::ObjectFileTransformer::convert(Obj, nulls(), Gsym))
+    return Err;
+  if (Error Err = Gsym.finalize(nulls()))
+    return Err;
+
+  SmallString<128> TempPath;
+  sys::fs::createUniquePath(Path + "-%%%%%%%%.tmp", TempPath,
+                            /*MakeAbsolute=*/false);
+  support::endianness Endian =
+      Obj.makeTriple().isLittleEndian() ? support::little : support::big;
+  if (Error Err = Gsym.save(TempPath, Endian)) {
+    sys::fs::remove(TempPath);
+    return Err;
+  }
+  if (std::error_code EC = sys::fs::rename(TempPath, Path)) {
+    sys::fs::remove(TempPath);
+    return errorCodeToError(EC);
+  }
+  return Error::success();
+}
+
+std::unique_ptr<DIContext>
+LLVMSymbolizer::getOrCreateGsymContext(const ObjectFile &Obj,
+                                       const ObjectFile &DbgObj) {
+  Optional<BuildIDRef> BuildID = getBuildID(&Obj);
+  if (!BuildID || BuildID->empty())
+    return nullptr;
+
+  SmallString<128> Path(Opts.GsymCacheDirectory);
+  sys::path::append(Path, toHex(*BuildID, /*LowerCase=*/true) + ".gsym");
+  if (!sys::fs::exists(Path)) {
+    if (sys::fs::create_directories(Opts.GsymCacheDirectory))
+      return nullptr;
+    if (Error Err = createGsymFile(DbgObj, Path)) {
+      consumeError(std::move(Err));
+      return nullptr;
+    }
+  }
+
+  auto ReaderOrErr = gsym::GsymReader::openFile(Path);
+  if (!ReaderOrErr) {
+    consumeError(ReaderOrErr.takeError());
+    return nullptr;
+  }
+  return std::make_unique<gsym::GsymDIContext>(
+      std::make_unique<gsym::GsymReader>(std::move(*ReaderOrErr)));
+}
+
 Expected<SymbolizableModule *>
 LLVMSymbolizer::getOrCreateModuleInfo(const std::string &ModuleName) {
   std::string BinaryName = ModuleName;
@@ -605,6 +679,8 @@ LLVMSymbolizer::getOrCreateModuleInfo(const std::string &ModuleName) {
       Context.reset(new PDBContext(*CoffObject, std::move(Session)));
     }
   }
+  if (!Context && !Opts.GsymCacheDirectory.empty())
+    Context = getOrCreateGsymContext(*Objects.first, *Objects.second);
   if (!Context)
     Context = DWARFContext::create(
         *Objects.second, DWARFContext::ProcessDebugRelocations::Process,
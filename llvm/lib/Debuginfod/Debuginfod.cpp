@@ -24,6 +24,7 @@
 #include "llvm/Debuginfod/Debuginfod.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/BinaryFormat/Magic.h"
 #include "llvm/DebugInfo/DWARF/DWARFContext.h"
 #include "llvm/DebugInfo/Symbolize/Symbolize.h"
@@ -41,6 +42,8 @@
 #include "llvm/Support/xxhash.h"
 
 #include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <thread>
 
 namespace llvm {
@@ -171,6 +174,45 @@ Error StreamedHTTPResponseHandler::handleBodyChunk(StringRef BodyChunk) {
   return Error::success();
 }
 
+namespace {
+
+/// Serializes the downloads of an artifact within the process. The
+/// constructor blocks while another thread holds the lock for the same key, so
+/// that concurrent requests for an artifact result in a single download, after
+/// which the waiting threads find the artifact in the cache.
+class ArtifactDownloadLock {
+  struct State {
+    std::mutex Mutex;
+    std::condition_variable Released;
+    StringSet<> Keys;
+  };
+
+  static State &getState() {
+    static State S;
+    return S;
+  }
+
+  std::string Key;
+
+public:
+  ArtifactDownloadLock(StringRef Key) : Key(Key.str()) {
+    State &S = getState();
+    std::unique_lock<std::mutex> Guard(S.Mutex);
+    S.Released.wait(Guard, [&] { return S.Keys.insert(this->Key).second; });
+  }
+
+  ~ArtifactDownloadLock() {
+    State &S = getState();
+    {
+      std::lock_guard<std::mutex> Guard(S.Mutex);
+      S.Keys.erase(Key);
+    }
+    S.Released.notify_all();
+  }
+};
+
+} // namespace
+
 // An over-accepting simplification of the HTTP RFC 7230 spec.
 static bool isHeader(StringRef S) {
   StringRef Name;
@@ -222,6 +264,10 @@ Expected<std::string> getCachedOrDownloadArtifact(
     return CacheOrErr.takeError();
 
   FileCache Cache = *CacheOrErr;
+  // If another thread is downloading this artifact, wait for it to finish, so
+  // that the lookup below finds the artifact in the cache instead of starting
+  // a second download.
+  ArtifactDownloadLock DownloadLock(UniqueKey);
   // We choose an arbitrary Task parameter as we do not make use of it.
   unsigned Task = 0;
   Expected<AddStreamFn> CacheAddStreamOrErr = Cache(Task, UniqueKey);
@@ -262,6 +308,15 @@ Expected<std::string> getCachedOrDownloadArtifact(
     if (Client.responseCode() != 200)
       continue;
 
+    // Keep the cache bounded. The policy defaults to the CachePruningPolicy
+    // defaults and can be set with DEBUGINFOD_CACHE_POLICY, using the syntax
+    // of parseCachePruningPolicy.
+    Expected<CachePruningPolicy> PruningPolicyOrErr =
+        parseCachePruningPolicy(std::getenv("DEBUGINFOD_CACHE_POLICY"));
+    if (!PruningPolicyOrErr)
+      return PruningPolicyOrErr.takeError();
+    pruneCache(CacheDirectoryPath, *PruningPolicyOrErr);
+
     // Return the path to the artifact on disk.
     return std::string(AbsCachedArtifactPath);
   }
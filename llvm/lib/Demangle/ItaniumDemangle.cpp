@@ -606,3 +606,47 @@ bool ItaniumPartialDemangler::isSpecialName() const {
 bool ItaniumPartialDemangler::isData() const {
   return !isFunction() && !isSpecialName();
 }
+
+ItaniumBatchDemangler::ItaniumBatchDemangler()
+    : Context(new Demangler{nullptr, nullptr}) {}
+
+ItaniumBatchDemangler::~ItaniumBatchDemangler() {
+  delete static_cast<Demangler *>(Context);
+  std::free(Buf);
+}
+
+ItaniumBatchDemangler::ItaniumBatchDemangler(ItaniumBatchDemangler &&Other)
+    : Context(Other.Context), Buf(Other.Buf), BufSize(Other.BufSize) {
+  Other.Context = nullptr;
+  Other.Buf = nullptr;
+  Other.BufSize = 0;
+}
+
+ItaniumBatchDemangler &
+ItaniumBatchDemangler::operator=(ItaniumBatchDemangler &&Other) {
+  std::swap(Context, Other.Context);
+  std::swap(Buf, Other.Buf);
+  std::swap(BufSize, Other.BufSize);
+  return *this;
+}
+
+const char *ItaniumBatchDemangler::demangle(const char *MangledName,
+                                            size_t *N) {
+  Demangler *Parser = static_cast<Demangler *>(Context);
+  Parser->reset(MangledName, MangledName + std::strlen(MangledName));
+  // A failed parse can leave unresolved forward references behind.
+  Parser->ForwardTemplateRefs.clear();
+  Node *AST = Parser->parse();
+  if (AST == nullptr)
+    return nullptr;
+
+  OutputBuffer OB(Buf, BufSize);
+  assert(Parser->ForwardTemplateRefs.empty());
+  AST->print(OB);
+  OB += '\0';
+  Buf = OB.getBuffer();
+  BufSize = OB.getBufferCapacity();
+  if (N != nullptr)
+    *N = OB.getCurrentPosition() - 1;
+  return Buf;
+}
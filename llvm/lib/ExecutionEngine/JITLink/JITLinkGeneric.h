@@ -15,6 +15,7 @@
 
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ExecutionEngine/JITLink/JITLink.h"
+#include "llvm/Support/Parallel.h"
 
 #define DEBUG_TYPE "jitlink"
 
@@ -123,31 +124,56 @@ private:
   Error fixUpBlocks(LinkGraph &G) const override {
     LLVM_DEBUG(dbgs() << "Fixing up blocks:\n");
 
+    std::vector<Block *> Blocks;
+    size_t NumEdges = 0;
     for (auto *B : G.blocks()) {
-      LLVM_DEBUG(dbgs() << "  " << *B << ":\n");
-
-      // Copy Block data and apply fixups.
-      LLVM_DEBUG(dbgs() << "    Applying fixups.\n");
-      assert((!B->isZeroFill() || all_of(B->edges(),
-                                         [](const Edge &E) {
-                                           return E.getKind() ==
-                                                  Edge::KeepAlive;
-                                         })) &&
-             "Non-KeepAlive edges in zero-fill block?");
-      for (auto &E : B->edges()) {
-
-        // Skip non-relocation edges.
-        if (!E.isRelocation())
-          continue;
-
-        // Dispatch to LinkerImpl for fixup.
-        if (auto Err = impl().applyFixup(G, *B, E))
-          return Err;
-      }
+      Blocks.push_back(B);
+      NumEdges += B->edges_size();
+    }
+
+    // Fixups only write to the content of the block they belong to, so the
+    // blocks of large graphs are fixed up concurrently. Keep the debug output
+    // in order.
+    bool FixUpConcurrently = NumEdges >= ConcurrentFixUpThreshold;
+    LLVM_DEBUG(FixUpConcurrently = false);
+    if (FixUpConcurrently)
+      return parallelForEachError(
+          Blocks, [&](Block *B) { return fixUpBlock(G, *B); });
+
+    for (auto *B : Blocks)
+      if (auto Err = fixUpBlock(G, *B))
+        return Err;
+
+    return Error::success();
+  }
+
+  Error fixUpBlock(LinkGraph &G, Block &B) const {
+    LLVM_DEBUG(dbgs() << "  " << B << ":\n");
+
+    // Copy Block data and apply fixups.
+    LLVM_DEBUG(dbgs() << "    Applying fixups.\n");
+    assert((!B.isZeroFill() || all_of(B.edges(),
+                                      [](const Edge &E) {
+                                        return E.getKind() == Edge::KeepAlive;
+                                      })) &&
+           "Non-KeepAlive edges in zero-fill block?");
+    for (auto &E : B.edges()) {
+
+      // Skip non-relocation edges.
+      if (!E.isRelocation())
+        continue;
+
+      // Dispatch to LinkerImpl for fixup.
+      if (auto Err = impl().applyFixup(G, B, E))
+        return Err;
     }
 
     return Error::success();
   }
+
+  // Graphs with fewer edges than this are fixed up on the calling thread,
+  // where the cost of spawning work outweighs the fixups themselves.
+  static constexpr size_t ConcurrentFixUpThreshold = 16384;
 };
 
 /// Removes dead symbols/blocks/addressables.
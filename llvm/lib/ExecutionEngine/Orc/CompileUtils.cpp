@@ -9,6 +9,9 @@
 #include "llvm/ExecutionEngine/Orc/CompileUtils.h"
 
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/Config/llvm-config.h"
 #include "llvm/ExecutionEngine/ObjectCache.h"
 #include "llvm/IR/LegacyPassManager.h"
 #include "llvm/IR/Module.h"
@@ -17,7 +20,9 @@
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/SHA1.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
+#include "llvm/Support/VCSRevision.h"
 #include "llvm/Target/TargetMachine.h"
 
 #include <algorithm>
@@ -92,5 +97,114 @@ ConcurrentIRCompiler::operator()(Module &M) {
   return C(M);
 }
 
+CachingIRCompiler::CachingIRCompiler(
+    std::unique_ptr<IRCompileLayer::IRCompiler> Compile, std::string TargetKey)
+    : IRCompiler(Compile->getManglingOptions()), Compile(std::move(Compile)),
+      TargetKey(std::move(TargetKey)) {}
+
+Expected<std::unique_ptr<CachingIRCompiler>>
+CachingIRCompiler::Create(std::unique_ptr<IRCompileLayer::IRCompiler> Compile,
+                          const JITTargetMachineBuilder &JTMB,
+                          StringRef CacheDirectory,
+                          std::shared_ptr<RemoteCacheStore> Remote) {
+  // Everything in the target machine builder that changes the generated
+  // code. The module's own triple and data layout are part of its bitcode.
+  std::string TargetKey;
+  {
+    raw_string_ostream OS(TargetKey);
+    const auto &Opts = JTMB.getOptions();
+    OS << JTMB.getTargetTriple().str() << '\0' << JTMB.getCPU() << '\0'
+       << JTMB.getFeatures().getString() << '\0'
+       << static_cast<int>(JTMB.getCodeGenOptLevel()) << ' '
+       << (JTMB.getRelocationModel() ? *JTMB.getRelocationModel() + 1 : 0)
+       << ' ' << (JTMB.getCodeModel() ? *JTMB.getCodeModel() + 1 : 0) << ' '
+       << static_cast<int>(Opts.FloatABIType) << ' '
+       << static_cast<int>(Opts.AllowFPOpFusion) << ' '
+       << static_cast<int>(Opts.ExceptionModel) << ' ' << Opts.EmulatedTLS
+       << Opts.UnsafeFPMath << Opts.NoInfsFPMath << Opts.NoNaNsFPMath
+       << Opts.FunctionSections << Opts.DataSections;
+  }
+
+  std::unique_ptr<CachingIRCompiler> C(
+      new CachingIRCompiler(std::move(Compile), std::move(TargetKey)));
+
+  auto *CP = C.get();
+  auto LocalCache = localCache(
+      "ORC", "orc-object", CacheDirectory,
+      [CP](unsigned Task, std::unique_ptr<MemoryBuffer> MB) {
+        std::lock_guard<std::mutex> Lock(CP->CachedObjectsMutex);
+        CP->CachedObjects[Task] = std::move(MB);
+      });
+  if (!LocalCache)
+    return LocalCache.takeError();
+  C->Cache = Remote ? remoteCache(std::move(*LocalCache), std::move(Remote))
+                    : std::move(*LocalCache);
+  return std::move(C);
+}
+
+std::string CachingIRCompiler::computeKey(Module &M) const {
+  SHA1 Hasher;
+  Hasher.update(LLVM_VERSION_STRING);
+#ifdef LLVM_REVISION
+  Hasher.update(LLVM_REVISION);
+#endif
+  Hasher.update(TargetKey);
+
+  SmallVector<char, 0> Bitcode;
+  {
+    raw_svector_ostream OS(Bitcode);
+    WriteBitcodeToFile(M, OS);
+  }
+  Hasher.update(
+      arrayRefFromStringRef(StringRef(Bitcode.data(), Bitcode.size())));
+  return toHex(Hasher.result());
+}
+
+Expected<std::unique_ptr<MemoryBuffer>>
+CachingIRCompiler::operator()(Module &M) {
+  // Task numbers only serve to pair the objects passed to the cache's
+  // AddBuffer callback with the compile that asked for them.
+  unsigned Task = NextTask++;
+  auto AddStream = Cache(Task, computeKey(M));
+  if (!AddStream)
+    return AddStream.takeError();
+
+  auto TakeCachedObject = [&]() {
+    std::lock_guard<std::mutex> Lock(CachedObjectsMutex);
+    auto I = CachedObjects.find(Task);
+    if (I == CachedObjects.end())
+      return std::unique_ptr<MemoryBuffer>();
+    auto Obj = std::move(I->second);
+    CachedObjects.erase(I);
+    return Obj;
+  };
+
+  if (!*AddStream) {
+    ++NumHits;
+    if (auto Obj = TakeCachedObject())
+      return std::move(Obj);
+    return make_error<StringError>("Cache hit for " + M.getModuleIdentifier() +
+                                       " did not produce an object",
+                                   inconvertibleErrorCode());
+  }
+
+  ++NumMisses;
+  auto Obj = (*Compile)(M);
+  if (!Obj)
+    return Obj.takeError();
+
+  {
+    auto Stream = (*AddStream)(Task);
+    if (!Stream)
+      return Stream.takeError();
+    *(*Stream)->OS << (*Obj)->getBuffer();
+  }
+
+  // The cache hands the committed entry back; the compiled object is used
+  // instead.
+  TakeCachedObject();
+  return Obj;
+}
+
 } // end namespace orc
 } // end namespace llvm
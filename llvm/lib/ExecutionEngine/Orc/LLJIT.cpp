@@ -22,6 +22,7 @@
 #include "llvm/IR/IRBuilder.h"
 #include "llvm/IR/Mangler.h"
 #include "llvm/IR/Module.h"
+#include "llvm/Passes/PassBuilder.h"
 #include "llvm/Support/DynamicLibrary.h"
 
 #include <map>
@@ -810,6 +811,24 @@ LLJIT::createObjectLinkingLayer(LLJITBuilderState &S, ExecutionSession &ES) {
   return std::unique_ptr<ObjectLayer>(std::move(Layer));
 }
 
+/// Run the default -O2 pipeline on a module that is being recompiled by the
+/// tiered compile layer.
+static void optimizeForTierUp(Module &M) {
+  LoopAnalysisManager LAM;
+  FunctionAnalysisManager FAM;
+  CGSCCAnalysisManager CGAM;
+  ModuleAnalysisManager MAM;
+
+  PassBuilder PB;
+  PB.registerModuleAnalyses(MAM);
+  PB.registerCGSCCAnalyses(CGAM);
+  PB.registerFunctionAnalyses(FAM);
+  PB.registerLoopAnalyses(LAM);
+  PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
+
+  PB.buildPerModuleDefaultPipeline(OptimizationLevel::O2).run(M, MAM);
+}
+
 Expected<std::unique_ptr<IRCompileLayer::IRCompiler>>
 LLJIT::createCompileFunction(LLJITBuilderState &S,
                              JITTargetMachineBuilder JTMB) {
@@ -875,6 +894,36 @@ LLJIT::LLJIT(LLJITBuilderState &S, Error &Err)
   ObjTransformLayer =
       std::make_unique<ObjectTransformLayer>(*ES, *ObjLinkingLayer);
 
+  TieredCompileLayer::IndirectStubsManagerBuilder ISMBuilder;
+  if (S.TierUpThreshold) {
+    ISMBuilder = createLocalIndirectStubsManagerBuilder(TT);
+    if (!ISMBuilder) {
+      Err = make_error<StringError>("Tiered compilation is not supported for " +
+                                        TT.str(),
+                                    inconvertibleErrorCode());
+      return;
+    }
+
+    auto OptJTMB = *S.JTMB;
+    OptJTMB.setCodeGenOptLevel(CodeGenOpt::Aggressive);
+    auto OptCompileFunction = createCompileFunction(S, std::move(OptJTMB));
+    if (!OptCompileFunction) {
+      Err = OptCompileFunction.takeError();
+      return;
+    }
+    OptCompileLayer = std::make_unique<IRCompileLayer>(
+        *ES, *ObjTransformLayer, std::move(*OptCompileFunction));
+    OptTransformLayer = std::make_unique<IRTransformLayer>(
+        *ES, *OptCompileLayer,
+        [](ThreadSafeModule TSM, const MaterializationResponsibility &R) {
+          TSM.withModuleDo([](Module &M) { optimizeForTierUp(M); });
+          return Expected<ThreadSafeModule>(std::move(TSM));
+        });
+
+    // The baseline tier is compiled as quickly as possible.
+    S.JTMB->setCodeGenOptLevel(CodeGenOpt::None);
+  }
+
   {
     auto CompileFunction = createCompileFunction(S, std::move(*S.JTMB));
     if (!CompileFunction) {
@@ -883,7 +932,14 @@ LLJIT::LLJIT(LLJITBuilderState &S, Error &Err)
     }
     CompileLayer = std::make_unique<IRCompileLayer>(
         *ES, *ObjTransformLayer, std::move(*CompileFunction));
-    TransformLayer = std::make_unique<IRTransformLayer>(*ES, *CompileLayer);
+    IRLayer *BaseLayer = CompileLayer.get();
+    if (S.TierUpThreshold) {
+      TieredLayer = std::make_unique<TieredCompileLayer>(
+          *ES, *CompileLayer, *OptTransformLayer, std::move(ISMBuilder),
+          S.TierUpThreshold);
+      BaseLayer = TieredLayer.get();
+    }
+    TransformLayer = std::make_unique<IRTransformLayer>(*ES, *BaseLayer);
     InitHelperTransformLayer =
         std::make_unique<IRTransformLayer>(*ES, *TransformLayer);
   }
@@ -10,8 +10,11 @@
 
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ExecutionEngine/JITLink/JITLink.h"
+#include "llvm/Support/MSVCErrorWorkarounds.h"
 #include "llvm/Support/Process.h"
 
+#include <future>
+
 using namespace llvm::jitlink;
 
 namespace llvm {
@@ -185,5 +188,22 @@ void MapperJITLinkMemoryManager::deallocate(
   });
 }
 
+Error MapperJITLinkMemoryManager::preReserve(size_t NumBytes) {
+  std::promise<MSVCPError> ResultP;
+  auto ResultF = ResultP.get_future();
+  Mapper->reserve(alignTo(NumBytes, ReservationUnits),
+                  [&](Expected<ExecutorAddrRange> Result) {
+                    if (!Result)
+                      return ResultP.set_value(Result.takeError());
+                    {
+                      std::lock_guard<std::mutex> Lock(Mutex);
+                      AvailableMemory.insert(Result->Start, Result->End - 1,
+                                             true);
+                    }
+                    ResultP.set_value(Error::success());
+                  });
+  return ResultF.get();
+}
+
 } // end namespace orc
 } // end namespace llvm
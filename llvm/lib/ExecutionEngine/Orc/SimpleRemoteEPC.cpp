@@ -9,6 +9,7 @@
 #include "llvm/ExecutionEngine/Orc/SimpleRemoteEPC.h"
 #include "llvm/ExecutionEngine/Orc/EPCGenericJITLinkMemoryManager.h"
 #include "llvm/ExecutionEngine/Orc/EPCGenericMemoryAccess.h"
+#include "llvm/ExecutionEngine/Orc/MapperJITLinkMemoryManager.h"
 #include "llvm/ExecutionEngine/Orc/Shared/OrcRTBridge.h"
 #include "llvm/Support/FormatVariadic.h"
 
@@ -210,6 +211,36 @@ SimpleRemoteEPC::createDefaultMemoryManager(SimpleRemoteEPC &SREPC) {
   return std::make_unique<EPCGenericJITLinkMemoryManager>(SREPC, SAs);
 }
 
+Expected<std::unique_ptr<jitlink::JITLinkMemoryManager>>
+SimpleRemoteEPC::createSharedMemoryManager(SimpleRemoteEPC &SREPC,
+                                           size_t SlabSize) {
+  SharedMemoryMapper::SymbolAddrs SAs;
+  if (auto Err = SREPC.getBootstrapSymbols(
+          {{SAs.Instance, rt::ExecutorSharedMemoryMapperServiceInstanceName},
+           {SAs.Reserve,
+            rt::ExecutorSharedMemoryMapperServiceReserveWrapperName},
+           {SAs.Initialize,
+            rt::ExecutorSharedMemoryMapperServiceInitializeWrapperName},
+           {SAs.Deinitialize,
+            rt::ExecutorSharedMemoryMapperServiceDeinitializeWrapperName},
+           {SAs.Release,
+            rt::ExecutorSharedMemoryMapperServiceReleaseWrapperName}}))
+    return std::move(Err);
+
+  auto MemMgr =
+      MapperJITLinkMemoryManager::CreateWithMapper<SharedMemoryMapper>(
+          SlabSize, SREPC, SAs);
+  if (!MemMgr)
+    return MemMgr.takeError();
+
+  // Reserving the slab now also checks that the executor's shared memory can
+  // be mapped here.
+  if (auto Err = (*MemMgr)->preReserve(SlabSize))
+    return std::move(Err);
+
+  return std::move(*MemMgr);
+}
+
 Expected<std::unique_ptr<ExecutorProcessControl::MemoryAccess>>
 SimpleRemoteEPC::createDefaultMemoryAccess(SimpleRemoteEPC &SREPC) {
   return nullptr;
@@ -340,15 +371,31 @@ Error SimpleRemoteEPC::setup(Setup S) {
   else
     return DM.takeError();
 
-  // Set a default CreateMemoryManager if none is specified.
-  if (!S.CreateMemoryManager)
-    S.CreateMemoryManager = createDefaultMemoryManager;
+  // Prefer shared memory if none is specified and the executor supports it.
+  if (!S.CreateMemoryManager && S.PreferSharedMemory) {
+    if (auto MemMgr = createSharedMemoryManager(*this, S.SharedMemorySlabSize))
+      OwnedMemMgr = std::move(*MemMgr);
+    else {
+      auto Err = MemMgr.takeError();
+      LLVM_DEBUG({
+        dbgs() << "SimpleRemoteEPC: not sharing memory with executor: "
+               << toString(std::move(Err)) << "\n";
+      });
+      consumeError(std::move(Err));
+    }
+  }
 
-  if (auto MemMgr = S.CreateMemoryManager(*this)) {
-    OwnedMemMgr = std::move(*MemMgr);
-    this->MemMgr = OwnedMemMgr.get();
-  } else
-    return MemMgr.takeError();
+  // Set a default CreateMemoryManager if none is specified.
+  if (!OwnedMemMgr) {
+    if (!S.CreateMemoryManager)
+      S.CreateMemoryManager = createDefaultMemoryManager;
+
+    if (auto MemMgr = S.CreateMemoryManager(*this))
+      OwnedMemMgr = std::move(*MemMgr);
+    else
+      return MemMgr.takeError();
+  }
+  this->MemMgr = OwnedMemMgr.get();
 
   // Set a default CreateMemoryAccess if none is specified.
   if (!S.CreateMemoryAccess)
@@ -302,5 +302,26 @@ SpeculateQuery::ResultTy SequenceBBQuery::operator()(Function &F) {
   return CallerAndCalles;
 }
 
+SpeculateQuery::ResultTy ProfileQuery::operator()(Function &F) {
+  std::string Name;
+  if (GlobalPrefix)
+    Name += GlobalPrefix;
+  Name += F.getName();
+
+  auto Successors = Profile.getSuccessors(Name);
+  if (Successors.empty() && Fallback)
+    if (auto Result = Fallback(F))
+      return Result;
+
+  DenseSet<StringRef> Calles;
+  for (StringRef Succ : Successors)
+    if (!GlobalPrefix || Succ.consume_front(StringRef(&GlobalPrefix, 1)))
+      Calles.insert(Succ);
+
+  DenseMap<StringRef, DenseSet<StringRef>> CallerAndCalles;
+  CallerAndCalles.insert({F.getName(), std::move(Calles)});
+  return CallerAndCalles;
+}
+
 } // namespace orc
 } // namespace llvm
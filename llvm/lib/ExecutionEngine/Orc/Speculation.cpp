@@ -16,6 +16,10 @@
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Type.h"
 #include "llvm/IR/Verifier.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/LineIterator.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
 
 namespace llvm {
 
@@ -33,6 +37,75 @@ void ImplSymbolMap::trackImpls(SymbolAliasMap ImplMaps, JITDylib *SrcJD) {
   }
 }
 
+// SpeculationProfile methods
+void SpeculationProfile::addSuccessor(StringRef Name, StringRef Succ) {
+  if (Name == Succ)
+    return;
+  auto &Succs = Successors[Name];
+  if (Succs.size() < MaxSuccessors && !is_contained(Succs, Succ))
+    Succs.push_back(Saver.save(Succ));
+}
+
+void SpeculationProfile::recordFirstCall(StringRef Name) {
+  std::lock_guard<std::mutex> Lockit(ConcurrentAccess);
+  Name = Saver.save(Name);
+  for (StringRef Pred : Recent)
+    addSuccessor(Pred, Name);
+  Recent.push_back(Name);
+  if (Recent.size() > Window)
+    Recent.pop_front();
+}
+
+SmallVector<StringRef, SpeculationProfile::MaxSuccessors>
+SpeculationProfile::getSuccessors(StringRef Name) const {
+  std::lock_guard<std::mutex> Lockit(ConcurrentAccess);
+  auto It = Successors.find(Name);
+  if (It == Successors.end())
+    return {};
+  return It->second;
+}
+
+Error SpeculationProfile::load(StringRef Path) {
+  auto Buffer = MemoryBuffer::getFile(Path);
+  if (!Buffer)
+    return createFileError(Path, Buffer.getError());
+
+  std::lock_guard<std::mutex> Lockit(ConcurrentAccess);
+  for (line_iterator Line(**Buffer, /*SkipBlanks=*/true, '#');
+       !Line.is_at_eof(); ++Line) {
+    SmallVector<StringRef, 1 + MaxSuccessors> Names;
+    Line->split(Names, ' ', -1, /*KeepEmpty=*/false);
+    for (StringRef Succ : drop_begin(Names))
+      addSuccessor(Names.front(), Succ);
+  }
+  return Error::success();
+}
+
+Error SpeculationProfile::save(StringRef Path) const {
+  std::error_code EC;
+  raw_fd_ostream OS(Path, EC, sys::fs::OF_TextWithCRLF);
+  if (EC)
+    return createFileError(Path, EC);
+
+  std::lock_guard<std::mutex> Lockit(ConcurrentAccess);
+  std::vector<StringRef> Names;
+  for (auto &E : Successors)
+    Names.push_back(E.getKey());
+  llvm::sort(Names);
+
+  OS << "# ORC speculation profile: function followed by its successors\n";
+  for (StringRef Name : Names) {
+    OS << Name;
+    for (StringRef Succ : Successors.find(Name)->second)
+      OS << ' ' << Succ;
+    OS << '\n';
+  }
+  OS.close();
+  if (OS.has_error())
+    return createFileError(Path, OS.error());
+  return Error::success();
+}
+
 // Trigger Speculative Compiles.
 void Speculator::speculateForEntryPoint(Speculator *Ptr, uint64_t StubId) {
   assert(Ptr && " Null Address Received in orc_speculate_for ");
@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/ExecutionEngine/Orc/TaskDispatch.h"
+#include "llvm/ExecutionEngine/Orc/Core.h"
 
 namespace llvm {
 namespace orc {
@@ -42,6 +43,154 @@ void DynamicThreadPoolTaskDispatcher::shutdown() {
   Running = false;
   OutstandingCV.wait(Lock, [this]() { return Outstanding == 0; });
 }
+
+/// The worker running on this thread, if any.
+static thread_local const WorkStealingTaskDispatcher *CurrentDispatcher =
+    nullptr;
+static thread_local unsigned CurrentWorker = 0;
+
+WorkStealingTaskDispatcher::Lane
+WorkStealingTaskDispatcher::classifyByTaskKind(Task &T) {
+  return isa<MaterializationTask>(T) ? Materialization : Urgent;
+}
+
+WorkStealingTaskDispatcher::WorkStealingTaskDispatcher(unsigned NumThreads,
+                                                       LaneClassifier Classify)
+    : Classify(std::move(Classify)) {
+  assert(NumThreads > 0 && "Dispatcher needs at least one thread");
+  for (unsigned I = 0; I != NumThreads; ++I)
+    Workers.push_back(std::make_unique<Worker>());
+  for (unsigned I = 0; I != NumThreads; ++I)
+    Workers[I]->Thread = std::thread([this, I]() { runWorker(I); });
+}
+
+WorkStealingTaskDispatcher::~WorkStealingTaskDispatcher() { shutdown(); }
+
+void WorkStealingTaskDispatcher::dispatch(std::unique_ptr<Task> T) {
+  Lane L = Classify(*T);
+  assert(L < NumLanes && "Invalid lane");
+
+  {
+    std::lock_guard<std::mutex> Lock(DispatchMutex);
+    if (!Running) {
+      // Late tasks from other tasks finishing up during shutdown.
+      T->run();
+      return;
+    }
+    ++Queued;
+  }
+
+  {
+    std::lock_guard<std::mutex> Lock(StatsMutex);
+    auto &S = Stats[L];
+    ++S.NumDispatched;
+    S.MaxQueueDepth = std::max(S.MaxQueueDepth, ++S.QueueDepth);
+  }
+
+  unsigned Idx = CurrentDispatcher == this
+                     ? CurrentWorker
+                     : NextWorker++ % Workers.size();
+  {
+    auto &W = *Workers[Idx];
+    std::lock_guard<std::mutex> Lock(W.QueueMutex);
+    W.Queues[L].push_back({std::move(T), std::chrono::steady_clock::now()});
+  }
+  WorkAvailableCV.notify_one();
+}
+
+bool WorkStealingTaskDispatcher::takeTask(unsigned Idx, QueuedTask &QT,
+                                          Lane &L) {
+  unsigned NumWorkers = Workers.size();
+  for (unsigned Ln = 0; Ln != NumLanes; ++Ln) {
+    // Own queue first, newest task first.
+    {
+      auto &W = *Workers[Idx];
+      std::lock_guard<std::mutex> Lock(W.QueueMutex);
+      auto &Q = W.Queues[Ln];
+      if (!Q.empty()) {
+        QT = std::move(Q.back());
+        Q.pop_back();
+        L = static_cast<Lane>(Ln);
+        return true;
+      }
+    }
+    // Then steal the oldest task of another thread.
+    for (unsigned I = 1; I != NumWorkers; ++I) {
+      auto &W = *Workers[(Idx + I) % NumWorkers];
+      std::lock_guard<std::mutex> Lock(W.QueueMutex);
+      auto &Q = W.Queues[Ln];
+      if (!Q.empty()) {
+        QT = std::move(Q.front());
+        Q.pop_front();
+        L = static_cast<Lane>(Ln);
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void WorkStealingTaskDispatcher::runWorker(unsigned Idx) {
+  CurrentDispatcher = this;
+  CurrentWorker = Idx;
+
+  while (true) {
+    QueuedTask QT;
+    Lane L;
+    if (!takeTask(Idx, QT, L)) {
+      std::unique_lock<std::mutex> Lock(DispatchMutex);
+      // A task counted in Queued may not have been pushed yet, in which case
+      // this wakes up immediately and looks again.
+      WorkAvailableCV.wait(Lock, [this]() { return Queued || !Running; });
+      if (!Running && !Queued)
+        return;
+      continue;
+    }
+
+    {
+      std::lock_guard<std::mutex> Lock(DispatchMutex);
+      --Queued;
+      ++Active;
+    }
+
+    auto Latency = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - QT.DispatchTime);
+    {
+      std::lock_guard<std::mutex> Lock(StatsMutex);
+      auto &S = Stats[L];
+      --S.QueueDepth;
+      S.TotalLatency += Latency;
+      S.MaxLatency = std::max(S.MaxLatency, Latency);
+    }
+
+    QT.T->run();
+    QT.T.reset();
+
+    std::lock_guard<std::mutex> Lock(DispatchMutex);
+    --Active;
+    if (!Queued && !Active)
+      IdleCV.notify_all();
+  }
+}
+
+void WorkStealingTaskDispatcher::shutdown() {
+  {
+    std::unique_lock<std::mutex> Lock(DispatchMutex);
+    if (!Running)
+      return;
+    IdleCV.wait(Lock, [this]() { return !Queued && !Active; });
+    Running = false;
+  }
+  WorkAvailableCV.notify_all();
+  for (auto &W : Workers)
+    W->Thread.join();
+}
+
+WorkStealingTaskDispatcher::LaneStats
+WorkStealingTaskDispatcher::getStats(Lane L) const {
+  std::lock_guard<std::mutex> Lock(StatsMutex);
+  return Stats[L];
+}
 #endif
 
 } // namespace orc
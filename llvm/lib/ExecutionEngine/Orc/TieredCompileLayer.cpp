@@ -0,0 +1,325 @@
+//===--- TieredCompileLayer.cpp - Recompile hot modules -------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/TieredCompileLayer.h"
+#include "llvm/ADT/StringSet.h"
+#include "llvm/ExecutionEngine/Orc/Mangling.h"
+#include "llvm/ExecutionEngine/Orc/TaskDispatch.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/MDBuilder.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Transforms/Utils/BasicBlockUtils.h"
+
+#define DEBUG_TYPE "orc"
+
+using namespace llvm;
+using namespace llvm::orc;
+
+/// Rename \p F to its name plus \p Suffix and replace its uses with a new
+/// declaration under the original name. If \p KeepDirectCalls is set, direct
+/// calls keep calling the renamed body.
+static void splitOffBody(Function &F, StringRef Suffix, bool KeepDirectCalls) {
+  std::string Name = F.getName().str();
+  F.setName(Name + Suffix);
+
+  auto *Decl =
+      Function::Create(F.getFunctionType(), GlobalValue::ExternalLinkage,
+                       F.getAddressSpace(), Name, F.getParent());
+  Decl->setCallingConv(F.getCallingConv());
+  Decl->setAttributes(F.getAttributes());
+  Decl->setVisibility(F.getVisibility());
+  Decl->setDLLStorageClass(F.getDLLStorageClass());
+
+  F.replaceUsesWithIf(Decl, [&](Use &U) {
+    if (!KeepDirectCalls)
+      return true;
+    auto *CB = dyn_cast<CallBase>(U.getUser());
+    return !CB || !CB->isCallee(&U);
+  });
+
+  F.setLinkage(GlobalValue::ExternalLinkage);
+  F.setVisibility(GlobalValue::HiddenVisibility);
+  F.setDLLStorageClass(GlobalValue::DefaultStorageClass);
+  F.setComdat(nullptr);
+}
+
+TieredCompileLayer::TieredCompileLayer(
+    ExecutionSession &ES, IRLayer &BaseLayer, IRLayer &OptimizingLayer,
+    IndirectStubsManagerBuilder BuildIndirectStubsManager,
+    uint64_t TierUpThreshold)
+    : IRLayer(ES, BaseLayer.getManglingOptions()), BaseLayer(BaseLayer),
+      OptimizingLayer(OptimizingLayer),
+      BuildIndirectStubsManager(std::move(BuildIndirectStubsManager)),
+      TierUpThreshold(TierUpThreshold) {
+  assert(TierUpThreshold > 0 && "Tier-up threshold must be positive");
+}
+
+void TieredCompileLayer::emit(std::unique_ptr<MaterializationResponsibility> R,
+                              ThreadSafeModule TSM) {
+  assert(TSM && "Null module");
+
+  auto &ES = getExecutionSession();
+  auto &JD = R->getTargetJITDylib();
+
+  uint64_t ModuleKey;
+  {
+    std::lock_guard<std::mutex> Lock(TieredLayerMutex);
+    ModuleKey = NextModuleKey++;
+  }
+  std::string Prefix = ("__orc_tier." + Twine(ModuleKey) + ".").str();
+
+  // Pick the functions to tier and give module-local variables unique,
+  // external names so that both tiers can share them.
+  std::vector<std::string> TieredNames;
+  SymbolFlagsMap StubFlags;
+  SymbolFlagsMap NewDefs;
+  PendingModule PM;
+  PM.JD = &JD;
+  TSM.withModuleDo([&](Module &M) {
+    if (!M.alias_empty() || !M.ifunc_empty())
+      return;
+
+    MangleAndInterner Mangle(ES, M.getDataLayout());
+    auto &Symbols = R->getSymbols();
+    for (auto &F : M) {
+      if (F.isDeclaration() || F.hasLocalLinkage() ||
+          F.hasAvailableExternallyLinkage())
+        continue;
+      auto Name = Mangle(F.getName());
+      auto I = Symbols.find(Name);
+      if (I == Symbols.end())
+        continue;
+      TieredNames.push_back(F.getName().str());
+      StubFlags[Name] = I->second;
+      PM.Stubs.push_back({Name, Mangle((F.getName() + "$tier1").str())});
+    }
+    if (TieredNames.empty())
+      return;
+
+    for (auto &GV : M.globals()) {
+      if (!GV.hasLocalLinkage() || GV.getName().startswith("llvm."))
+        continue;
+      GV.setName(Prefix + GV.getName());
+      GV.setLinkage(GlobalValue::ExternalLinkage);
+      GV.setVisibility(GlobalValue::HiddenVisibility);
+      NewDefs[Mangle(GV.getName())] = JITSymbolFlags::fromGlobalValue(GV);
+    }
+  });
+
+  if (TieredNames.empty()) {
+    BaseLayer.emit(std::move(R), std::move(TSM));
+    return;
+  }
+
+  // Keep a copy of the functions for the optimizing tier. Variables are
+  // defined by the baseline module only.
+  PM.Tier1 = cloneToNewContext(
+      TSM, [](const GlobalValue &GV) { return isa<Function>(GV); });
+  PM.Tier1.withModuleDo([&](Module &M) {
+    M.setModuleInlineAsm("");
+    for (auto &GV : make_early_inc_range(M.globals()))
+      if (GV.getName().startswith("llvm."))
+        GV.eraseFromParent();
+
+    StringSet<> Tiered;
+    for (auto &Name : TieredNames)
+      Tiered.insert(Name);
+    // Definitions that are not ours are provided by other modules.
+    for (auto &F : M)
+      if (!F.isDeclaration() && !F.hasLocalLinkage() &&
+          !F.hasAvailableExternallyLinkage() && !Tiered.count(F.getName()))
+        F.deleteBody();
+    // Calls within the module bind directly so they can be inlined.
+    for (auto &Name : TieredNames)
+      splitOffBody(*M.getFunction(Name), "$tier1", /*KeepDirectCalls=*/true);
+  });
+
+  // Rename and instrument the baseline definitions.
+  std::vector<std::pair<SymbolStringPtr, SymbolStringPtr>> Tier0Stubs;
+  TSM.withModuleDo([&](Module &M) {
+    MangleAndInterner Mangle(ES, M.getDataLayout());
+    auto &Ctx = M.getContext();
+    auto *Int64Ty = Type::getInt64Ty(Ctx);
+    auto *Int8PtrTy = Type::getInt8PtrTy(Ctx);
+    auto *Counter = new GlobalVariable(M, Int64Ty, false,
+                                       GlobalValue::InternalLinkage,
+                                       ConstantInt::get(Int64Ty, 0),
+                                       "__orc_tier.counter");
+    auto *TierUpTy = FunctionType::get(Type::getVoidTy(Ctx),
+                                       {Int8PtrTy, Int64Ty}, false);
+    auto *TierUpFn = createIRTypedAddress(
+        *TierUpTy, pointerToJITTargetAddress(&tierUpEntryPoint));
+    auto *LayerPtr = ConstantExpr::getIntToPtr(
+        ConstantInt::get(Int64Ty, pointerToJITTargetAddress(this)),
+        Int8PtrTy);
+    auto *Weights = MDBuilder(Ctx).createBranchWeights(1, 1 << 20);
+
+    for (size_t I = 0; I != TieredNames.size(); ++I) {
+      auto &F = *M.getFunction(TieredNames[I]);
+      splitOffBody(F, "$tier0", /*KeepDirectCalls=*/false);
+      auto Tier0Name = Mangle(F.getName());
+      NewDefs[Tier0Name] = JITSymbolFlags::fromGlobalValue(F);
+      Tier0Stubs.push_back({PM.Stubs[I].first, Tier0Name});
+
+      IRBuilder<> B(&*F.getEntryBlock().getFirstNonPHIOrDbgOrAlloca());
+      auto *Old = B.CreateAtomicRMW(AtomicRMWInst::Add, Counter,
+                                    ConstantInt::get(Int64Ty, 1), MaybeAlign(),
+                                    AtomicOrdering::Monotonic);
+      auto *Hit = cast<Instruction>(
+          B.CreateICmpEQ(Old, ConstantInt::get(Int64Ty, TierUpThreshold - 1)));
+      auto *Call = SplitBlockAndInsertIfThen(Hit, Hit->getNextNode(),
+                                             /*Unreachable=*/false, Weights);
+      B.SetInsertPoint(Call);
+      B.CreateCall(TierUpTy, TierUpFn,
+                   {LayerPtr, ConstantInt::get(Int64Ty, ModuleKey)});
+    }
+  });
+
+  // The baseline module now defines the renamed functions and variables, and
+  // everything else that R was responsible for except the stubs.
+  if (auto Err = R->defineMaterializing(std::move(NewDefs))) {
+    ES.reportError(std::move(Err));
+    R->failMaterialization();
+    return;
+  }
+  SymbolNameSet Delegated;
+  for (auto &KV : R->getSymbols())
+    if (!StubFlags.count(KV.first))
+      Delegated.insert(KV.first);
+  auto Tier0R = R->delegate(Delegated);
+  if (!Tier0R) {
+    ES.reportError(Tier0R.takeError());
+    R->failMaterialization();
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> Lock(TieredLayerMutex);
+    Pending[ModuleKey] = std::move(PM);
+  }
+  BaseLayer.emit(std::move(*Tier0R), std::move(TSM));
+
+  // Bind the original names to stubs once the baseline addresses are known.
+  // The stubs are not ready until the code they point to is.
+  std::shared_ptr<MaterializationResponsibility> SharedR = std::move(R);
+  SymbolLookupSet LookupSet;
+  for (auto &KV : Tier0Stubs)
+    LookupSet.add(KV.second);
+
+  auto OnResolved = [this, SharedR, StubFlags = std::move(StubFlags),
+                     Tier0Stubs](Expected<SymbolMap> Result) {
+    auto &ES = getExecutionSession();
+    if (!Result) {
+      ES.reportError(Result.takeError());
+      SharedR->failMaterialization();
+      return;
+    }
+
+    IndirectStubsManager::StubInitsMap StubInits;
+    for (auto &KV : Tier0Stubs)
+      StubInits[*KV.first] = {(*Result)[KV.second].getAddress(),
+                              StubFlags.lookup(KV.first)};
+
+    auto &ISM = getStubsManager(SharedR->getTargetJITDylib());
+    if (auto Err = ISM.createStubs(StubInits)) {
+      ES.reportError(std::move(Err));
+      SharedR->failMaterialization();
+      return;
+    }
+
+    SymbolMap Resolved;
+    for (auto &KV : StubFlags)
+      Resolved[KV.first] =
+          JITEvaluatedSymbol(ISM.findStub(*KV.first, false).getAddress(),
+                             KV.second);
+    if (auto Err = SharedR->notifyResolved(Resolved)) {
+      ES.reportError(std::move(Err));
+      SharedR->failMaterialization();
+      return;
+    }
+    if (auto Err = SharedR->notifyEmitted()) {
+      ES.reportError(std::move(Err));
+      SharedR->failMaterialization();
+    }
+  };
+
+  ES.lookup(LookupKind::Static,
+            {{&JD, JITDylibLookupFlags::MatchAllSymbols}},
+            std::move(LookupSet), SymbolState::Resolved,
+            std::move(OnResolved),
+            [SharedR](const SymbolDependenceMap &Deps) {
+              SharedR->addDependenciesForAll(Deps);
+            });
+}
+
+uint64_t TieredCompileLayer::getNumTieredUpModules() const {
+  std::lock_guard<std::mutex> Lock(TieredLayerMutex);
+  return NumTieredUp;
+}
+
+void TieredCompileLayer::tierUpEntryPoint(TieredCompileLayer *Layer,
+                                          uint64_t ModuleKey) {
+  Layer->tierUp(ModuleKey);
+}
+
+void TieredCompileLayer::tierUp(uint64_t ModuleKey) {
+  PendingModule PM;
+  {
+    std::lock_guard<std::mutex> Lock(TieredLayerMutex);
+    auto I = Pending.find(ModuleKey);
+    if (I == Pending.end())
+      return;
+    PM = std::move(I->second);
+    Pending.erase(I);
+    ++NumTieredUp;
+  }
+
+  // Compile off the calling thread when the session has compile threads.
+  getExecutionSession().dispatchTask(makeGenericNamedTask(
+      [this, PM = std::move(PM)]() mutable { emitTier1(std::move(PM)); },
+      "tier-up"));
+}
+
+void TieredCompileLayer::emitTier1(PendingModule PM) {
+  auto &ES = getExecutionSession();
+  auto &JD = *PM.JD;
+
+  LLVM_DEBUG({
+    dbgs() << "Tiering up " << PM.Stubs.size() << " functions in "
+           << JD.getName() << "\n";
+  });
+
+  if (auto Err = OptimizingLayer.add(JD, std::move(PM.Tier1))) {
+    ES.reportError(std::move(Err));
+    return;
+  }
+
+  SymbolLookupSet LookupSet;
+  for (auto &KV : PM.Stubs)
+    LookupSet.add(KV.second);
+  auto Result = ES.lookup({{&JD, JITDylibLookupFlags::MatchAllSymbols}},
+                          std::move(LookupSet));
+  if (!Result) {
+    ES.reportError(Result.takeError());
+    return;
+  }
+
+  auto &ISM = getStubsManager(JD);
+  for (auto &KV : PM.Stubs)
+    if (auto Err =
+            ISM.updatePointer(*KV.first, (*Result)[KV.second].getAddress()))
+      ES.reportError(std::move(Err));
+}
+
+IndirectStubsManager &TieredCompileLayer::getStubsManager(JITDylib &JD) {
+  std::lock_guard<std::mutex> Lock(TieredLayerMutex);
+  auto &ISM = Stubs[&JD];
+  if (!ISM)
+    ISM = BuildIndirectStubsManager();
+  return *ISM;
+}
@@ -10,6 +10,9 @@
 #include "llvm/ADT/DenseMapInfo.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/IR/PassManagerImpl.h"
+#include "llvm/Support/ThreadPool.h"
+#include <atomic>
+#include <mutex>
 
 using namespace llvm;
 
@@ -103,6 +106,9 @@ void ModuleToFunctionPassAdaptor::printPipeline(
 
 PreservedAnalyses ModuleToFunctionPassAdaptor::run(Module &M,
                                                    ModuleAnalysisManager &AM) {
+  if (isParallel())
+    return runParallel(M, AM);
+
   FunctionAnalysisManager &FAM =
       AM.getResult<FunctionAnalysisManagerModuleProxy>(M).getManager();
 
@@ -144,6 +150,65 @@ PreservedAnalyses ModuleToFunctionPassAdaptor::run(Module &M,
   return PA;
 }
 
+PreservedAnalyses
+ModuleToFunctionPassAdaptor::runParallel(Module &M, ModuleAnalysisManager &AM) {
+  FunctionAnalysisManager &FAM =
+      AM.getResult<FunctionAnalysisManagerModuleProxy>(M).getManager();
+  PassInstrumentation PI = AM.getResult<PassInstrumentationAnalysis>(M);
+
+  SmallVector<Function *, 0> Worklist;
+  for (Function &F : M)
+    if (!F.isDeclaration())
+      Worklist.push_back(&F);
+
+  // Guards the module-level instrumentation, the shared function analysis
+  // manager and PA. Only the pipelines themselves run concurrently.
+  std::mutex Mutex;
+  std::atomic<size_t> NextFunction(0);
+  PreservedAnalyses PA = PreservedAnalyses::all();
+
+  auto RunWorker = [&] {
+    std::unique_ptr<PassConceptT> WorkerPass = MakePass();
+    FunctionAnalysisManager WorkerFAM;
+    RegisterAnalyses(WorkerFAM);
+    // These are no-ops if RegisterAnalyses already provided them.
+    WorkerFAM.registerPass(
+        [&] { return ModuleAnalysisManagerFunctionProxy(AM); });
+    WorkerFAM.registerPass([] { return PassInstrumentationAnalysis(); });
+
+    for (size_t I = NextFunction++; I < Worklist.size(); I = NextFunction++) {
+      Function &F = *Worklist[I];
+      {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        if (!PI.runBeforePass<Function>(*WorkerPass, F))
+          continue;
+      }
+
+      PreservedAnalyses PassPA = WorkerPass->run(F, WorkerFAM);
+
+      // Nothing else will look at this function on this thread, so drop its
+      // cached results right away.
+      WorkerFAM.clear(F, F.getName());
+
+      std::lock_guard<std::mutex> Lock(Mutex);
+      PI.runAfterPass(*WorkerPass, F, PassPA);
+      FAM.invalidate(F, EagerlyInvalidate ? PreservedAnalyses::none() : PassPA);
+      PA.intersect(std::move(PassPA));
+    }
+  };
+
+  ThreadPool Pool(Strategy);
+  size_t NumWorkers = std::min<size_t>(Pool.getThreadCount(), Worklist.size());
+  for (size_t I = 0; I != NumWorkers; ++I)
+    Pool.async(RunWorker);
+  Pool.wait();
+
+  // See run() above.
+  PA.preserveSet<AllAnalysesOn<Function>>();
+  PA.preserve<FunctionAnalysisManagerModuleProxy>();
+  return PA;
+}
+
 AnalysisSetKey CFGAnalyses::SetKey;
 
 AnalysisSetKey PreservedAnalyses::AllAnalysesKey;
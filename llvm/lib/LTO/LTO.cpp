@@ -41,6 +41,7 @@
 #include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
 #include "llvm/Support/SHA1.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/ThreadPool.h"
@@ -57,6 +58,7 @@
 #include "llvm/Transforms/Utils/FunctionImportUtils.h"
 #include "llvm/Transforms/Utils/SplitModule.h"
 
+#include <condition_variable>
 #include <set>
 
 using namespace llvm;
@@ -1244,6 +1246,33 @@ public:
   }
 };
 
+/// A rough ratio of the memory a ThinLTO backend uses to the size of the
+/// bitcode it loads.
+static constexpr uint64_t ThinBackendMemoryPerBitcodeByte = 8;
+
+/// Predict the memory the ThinLTO backend for \p BM will use, from the size of
+/// its bitcode and of the part of each module it imports from.
+static uint64_t estimateThinBackendMemory(
+    const BitcodeModule &BM, const FunctionImporter::ImportMapTy &ImportList,
+    const MapVector<StringRef, BitcodeModule> &ModuleMap,
+    const StringMap<GVSummaryMapTy> &ModuleToDefinedGVSummaries) {
+  uint64_t Size = BM.getBuffer().size();
+  for (const auto &Import : ImportList) {
+    auto SourceIt = ModuleMap.find(Import.first());
+    auto SummariesIt = ModuleToDefinedGVSummaries.find(Import.first());
+    if (SourceIt == ModuleMap.end() ||
+        SummariesIt == ModuleToDefinedGVSummaries.end() ||
+        SummariesIt->second.empty())
+      continue;
+    // The lazily loaded source module only materializes what is imported.
+    uint64_t SourceSize = SourceIt->second.getBuffer().size();
+    Size += SourceSize * std::min<uint64_t>(Import.second.size(),
+                                            SummariesIt->second.size()) /
+            SummariesIt->second.size();
+  }
+  return Size * ThinBackendMemoryPerBitcodeByte;
+}
+
 namespace {
 class InProcessThinBackend : public ThinBackendProc {
   ThreadPool BackendThreadPool;
@@ -1257,6 +1286,35 @@ class InProcessThinBackend : public ThinBackendProc {
 
   bool ShouldEmitIndexFiles;
 
+  /// The predicted memory use of the running backend jobs, which is kept
+  /// under Conf.ThinLTOMemoryBudget if that is set.
+  uint64_t InFlightMemory = 0;
+  unsigned InFlightJobs = 0;
+  std::mutex BudgetMu;
+  std::condition_variable BudgetCV;
+
+  /// Wait until a backend job predicted to use \p Memory fits in the memory
+  /// budget. A job always starts when no other job is running.
+  void acquireMemoryBudget(uint64_t Memory) {
+    std::unique_lock<std::mutex> L(BudgetMu);
+    BudgetCV.wait(L, [&] {
+      return InFlightJobs == 0 ||
+             (InFlightMemory + Memory <= Conf.ThinLTOMemoryBudget &&
+              sys::Process::GetMallocUsage() <= Conf.ThinLTOMemoryBudget);
+    });
+    InFlightMemory += Memory;
+    ++InFlightJobs;
+  }
+
+  void releaseMemoryBudget(uint64_t Memory) {
+    {
+      std::lock_guard<std::mutex> L(BudgetMu);
+      InFlightMemory -= Memory;
+      --InFlightJobs;
+    }
+    BudgetCV.notify_all();
+  }
+
 public:
   InProcessThinBackend(
       const Config &Conf, ModuleSummaryIndex &CombinedIndex,
@@ -1276,6 +1334,16 @@ public:
           GlobalValue::getGUID(GlobalValue::dropLLVMManglingEscape(Name)));
   }
 
+  /// Whether the backend for \p ModuleID looks up the cache.
+  bool isCacheable(const FileCache &Cache, ModuleSummaryIndex &CombinedIndex,
+                   StringRef ModuleID) {
+    // Not if the cache is disabled, there is no entry for this module in the
+    // combined index, or there is no module hash.
+    return Cache && CombinedIndex.modulePaths().count(ModuleID) &&
+           !all_of(CombinedIndex.getModuleHash(ModuleID),
+                   [](uint32_t V) { return V == 0; });
+  }
+
   Error runThinLTOBackendThread(
       AddStreamFn AddStream, FileCache Cache, unsigned Task, BitcodeModule BM,
       ModuleSummaryIndex &CombinedIndex,
@@ -1283,7 +1351,7 @@ public:
       const FunctionImporter::ExportSetTy &ExportList,
       const std::map<GlobalValue::GUID, GlobalValue::LinkageTypes> &ResolvedODR,
       const GVSummaryMapTy &DefinedGlobals,
-      MapVector<StringRef, BitcodeModule> &ModuleMap) {
+      MapVector<StringRef, BitcodeModule> &ModuleMap, SmallString<40> Key) {
     auto RunThinBackend = [&](AddStreamFn AddStream) {
       LTOLLVMContext BackendContext(Conf);
       Expected<std::unique_ptr<Module>> MOrErr = BM.parseModule(BackendContext);
@@ -1301,18 +1369,15 @@ public:
         return E;
     }
 
-    if (!Cache || !CombinedIndex.modulePaths().count(ModuleID) ||
-        all_of(CombinedIndex.getModuleHash(ModuleID),
-               [](uint32_t V) { return V == 0; }))
-      // Cache disabled or no entry for this module in the combined index or
-      // no module hash.
+    if (!isCacheable(Cache, CombinedIndex, ModuleID))
       return RunThinBackend(AddStream);
 
-    SmallString<40> Key;
-    // The module may be cached, this helps handling it.
-    computeLTOCacheKey(Key, Conf, CombinedIndex, ModuleID, ImportList,
-                       ExportList, ResolvedODR, DefinedGlobals, CfiFunctionDefs,
-                       CfiFunctionDecls);
+    // The module may be cached, this helps handling it. The key may have been
+    // computed already for prefetching.
+    if (Key.empty())
+      computeLTOCacheKey(Key, Conf, CombinedIndex, ModuleID, ImportList,
+                         ExportList, ResolvedODR, DefinedGlobals,
+                         CfiFunctionDefs, CfiFunctionDecls);
     Expected<AddStreamFn> CacheAddStreamOrErr = Cache(Task, Key);
     if (Error Err = CacheAddStreamOrErr.takeError())
       return Err;
@@ -1333,6 +1398,22 @@ public:
     assert(ModuleToDefinedGVSummaries.count(ModulePath));
     const GVSummaryMapTy &DefinedGlobals =
         ModuleToDefinedGVSummaries.find(ModulePath)->second;
+    // With a memory budget, push back on the caller until the job fits.
+    uint64_t Memory = 0;
+    if (Conf.ThinLTOMemoryBudget) {
+      Memory = estimateThinBackendMemory(BM, ImportList, ModuleMap,
+                                         ModuleToDefinedGVSummaries);
+      acquireMemoryBudget(Memory);
+    }
+    // Let a remote cache start fetching the entry while the job waits to run.
+    SmallString<40> Key;
+    if (Conf.CachePrefetchHook &&
+        isCacheable(Cache, CombinedIndex, ModulePath)) {
+      computeLTOCacheKey(Key, Conf, CombinedIndex, ModulePath, ImportList,
+                         ExportList, ResolvedODR, DefinedGlobals,
+                         CfiFunctionDefs, CfiFunctionDecls);
+      Conf.CachePrefetchHook(Key);
+    }
     BackendThreadPool.async(
         [=](BitcodeModule BM, ModuleSummaryIndex &CombinedIndex,
             const FunctionImporter::ImportMapTy &ImportList,
@@ -1346,7 +1427,7 @@ public:
                                         "thin backend");
           Error E = runThinLTOBackendThread(
               AddStream, Cache, Task, BM, CombinedIndex, ImportList, ExportList,
-              ResolvedODR, DefinedGlobals, ModuleMap);
+              ResolvedODR, DefinedGlobals, ModuleMap, Key);
           if (E) {
             std::unique_lock<std::mutex> L(ErrMu);
             if (Err)
@@ -1356,6 +1437,8 @@ public:
           }
           if (LLVM_ENABLE_THREADS && Conf.TimeTraceEnabled)
             timeTraceProfilerFinishThread();
+          if (Conf.ThinLTOMemoryBudget)
+            releaseMemoryBudget(Memory);
         },
         BM, std::ref(CombinedIndex), std::ref(ImportList), std::ref(ExportList),
         std::ref(ResolvedODR), std::ref(DefinedGlobals), std::ref(ModuleMap));
@@ -1634,7 +1717,21 @@ Error LTO::runThinLTO(AddStreamFn AddStream, FileCache Cache,
     ModulesVec.reserve(ModuleMap.size());
     for (auto &Mod : ModuleMap)
       ModulesVec.push_back(&Mod.second);
-    for (int I : generateModulesOrdering(ModulesVec))
+    std::vector<int> Ordering = generateModulesOrdering(ModulesVec);
+    // With a memory budget, order by the predicted memory use instead, which
+    // also accounts for the imports.
+    if (Conf.ThinLTOMemoryBudget) {
+      std::vector<uint64_t> Memory;
+      Memory.reserve(ModuleMap.size());
+      for (auto &Mod : ModuleMap)
+        Memory.push_back(estimateThinBackendMemory(
+            Mod.second, ImportLists[Mod.first], ThinLTO.ModuleMap,
+            ModuleToDefinedGVSummaries));
+      llvm::stable_sort(Ordering, [&](int LeftIndex, int RightIndex) {
+        return Memory[LeftIndex] > Memory[RightIndex];
+      });
+    }
+    for (int I : Ordering)
       if (Error E = ProcessOneModule(I))
         return E;
   }
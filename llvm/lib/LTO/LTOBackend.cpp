@@ -118,7 +118,9 @@ Error Config::addSaveTemps(std::string OutputFileName, bool UseInputModulePath,
         PathPrefix = M.getModuleIdentifier() + ".";
       std::string Path = PathPrefix + PathSuffix + ".bc";
       std::error_code EC;
-      raw_fd_ostream OS(Path, EC, sys::fs::OpenFlags::OF_None);
+      // Use a seekable stream so that the bitcode writer can flush large
+      // modules to the file as it goes instead of buffering all of it.
+      raw_fd_stream OS(Path, EC);
       // Because -save-temps is a debugging feature, we report the error
       // directly and exit.
       if (EC)
@@ -69,6 +69,8 @@ STATISTIC(evaluateFixup, "Number of evaluated fixups");
 STATISTIC(FragmentLayouts, "Number of fragment layouts");
 STATISTIC(ObjectBytes, "Number of emitted object file bytes");
 STATISTIC(RelaxationSteps, "Number of assembler layout and relaxation steps");
+STATISTIC(RelaxationFragmentVisits,
+          "Number of fragments visited during relaxation");
 STATISTIC(RelaxedInstructions, "Number of relaxed instructions");
 
 } // end namespace stats
@@ -1192,24 +1194,22 @@ bool MCAssembler::relaxFragment(MCAsmLayout &Layout, MCFragment &F) {
 }
 
 bool MCAssembler::layoutSectionOnce(MCAsmLayout &Layout, MCSection &Sec) {
-  // Holds the first fragment which needed relaxing during this layout. It will
-  // remain NULL if none were relaxed.
-  // When a fragment is relaxed, all the fragments following it should get
-  // invalidated because their offset is going to change.
-  MCFragment *FirstRelaxedFragment = nullptr;
+  bool WasRelaxed = false;
 
   // Attempt to relax all the fragments in the section.
   for (MCFragment &Frag : Sec) {
-    // Check if this is a fragment that needs relaxation.
-    bool RelaxedFrag = relaxFragment(Layout, Frag);
-    if (RelaxedFrag && !FirstRelaxedFragment)
-      FirstRelaxedFragment = &Frag;
-  }
-  if (FirstRelaxedFragment) {
-    Layout.invalidateFragmentsFrom(FirstRelaxedFragment);
-    return true;
+    ++stats::RelaxationFragmentVisits;
+    // When a fragment is relaxed, all the fragments following it get
+    // invalidated right away because their offset is going to change. The
+    // remaining fragments of this pass are then relaxed against the new
+    // layout, which usually saves another pass over the section. Only the
+    // offsets that are actually queried are recomputed.
+    if (relaxFragment(Layout, Frag)) {
+      Layout.invalidateFragmentsFrom(&Frag);
+      WasRelaxed = true;
+    }
   }
-  return false;
+  return WasRelaxed;
 }
 
 bool MCAssembler::layoutOnce(MCAsmLayout &Layout) {
@@ -509,6 +509,23 @@ Error InstrBuilder::verifyInstrDesc(const InstrDesc &ID,
   return make_error<InstructionError<MCInst>>(std::string(Message), MCI);
 }
 
+void InstrBuilder::warnAboutCallsAndReturns(const MCInstrDesc &MCDesc) {
+  if (MCDesc.isCall() && FirstCallInst) {
+    // We don't correctly model calls.
+    WithColor::warning() << "found a call in the input assembly sequence.\n";
+    WithColor::note() << "call instructions are not correctly modeled. "
+                      << "Assume a latency of 100cy.\n";
+    FirstCallInst = false;
+  }
+
+  if (MCDesc.isReturn() && FirstReturnInst) {
+    WithColor::warning() << "found a return instruction in the input"
+                         << " assembly sequence.\n";
+    WithColor::note() << "program counter updates are ignored.\n";
+    FirstReturnInst = false;
+  }
+}
+
 Expected<const InstrDesc &>
 InstrBuilder::createInstrDescImpl(const MCInst &MCI,
                                   const SmallVector<SharedInstrument> &IVec) {
@@ -555,20 +572,7 @@ InstrBuilder::createInstrDescImpl(const MCInst &MCI,
   ID->NumMicroOps = SCDesc.NumMicroOps;
   ID->SchedClassID = SchedClassID;
 
-  if (MCDesc.isCall() && FirstCallInst) {
-    // We don't correctly model calls.
-    WithColor::warning() << "found a call in the input assembly sequence.\n";
-    WithColor::note() << "call instructions are not correctly modeled. "
-                      << "Assume a latency of 100cy.\n";
-    FirstCallInst = false;
-  }
-
-  if (MCDesc.isReturn() && FirstReturnInst) {
-    WithColor::warning() << "found a return instruction in the input"
-                         << " assembly sequence.\n";
-    WithColor::note() << "program counter updates are ignored.\n";
-    FirstReturnInst = false;
-  }
+  warnAboutCallsAndReturns(MCDesc);
 
   initializeUsedResources(*ID, SCDesc, STI, ProcResourceMasks);
   computeMaxLatency(*ID, MCDesc, SCDesc, STI);
@@ -605,15 +609,25 @@ InstrBuilder::getOrCreateInstrDesc(const MCInst &MCI,
   // Cache lookup using SchedClassID from Instrumentation
   unsigned SchedClassID = IM.getSchedClassID(MCII, MCI, IVec);
 
+  // Descriptors may have been created before the last call to
+  // resetWarnings(), so the warnings are checked on cache hits too.
   auto DKey = std::make_pair(MCI.getOpcode(), SchedClassID);
-  if (Descriptors.find_as(DKey) != Descriptors.end())
-    return *Descriptors[DKey];
+  auto DI = Descriptors.find_as(DKey);
+  if (DI != Descriptors.end()) {
+    if (FirstCallInst || FirstReturnInst)
+      warnAboutCallsAndReturns(MCII.get(MCI.getOpcode()));
+    return *DI->second;
+  }
 
   unsigned CPUID = STI.getSchedModel().getProcessorID();
   SchedClassID = STI.resolveVariantSchedClass(SchedClassID, &MCI, &MCII, CPUID);
   auto VDKey = std::make_pair(&MCI, SchedClassID);
-  if (VariantDescriptors.find(VDKey) != VariantDescriptors.end())
-    return *VariantDescriptors[VDKey];
+  auto VDI = VariantDescriptors.find(VDKey);
+  if (VDI != VariantDescriptors.end()) {
+    if (FirstCallInst || FirstReturnInst)
+      warnAboutCallsAndReturns(MCII.get(MCI.getOpcode()));
+    return *VDI->second;
+  }
 
   return createInstrDescImpl(MCI, IVec);
 }
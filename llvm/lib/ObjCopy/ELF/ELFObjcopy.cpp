@@ -32,6 +32,7 @@
 #include "llvm/Support/ErrorOr.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Memory.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
@@ -506,11 +507,46 @@ static Error replaceAndRemoveSections(const CommonConfig &Config,
     return E;
 
   if (Config.CompressionType != DebugCompressionType::None) {
+    // Compress the sections in parallel up front, since adding sections to
+    // the object has to be done serially.
+    std::vector<const SectionBase *> ToCompress;
+    for (const SectionBase &Sec : Obj.sections())
+      if (isCompressable(Sec))
+        ToCompress.push_back(&Sec);
+    // Concatenated zstd frames form a valid zstd stream, so large sections
+    // are split into 4 MiB frames that are compressed independently. This
+    // spreads the work for a single section over several threads.
+    size_t ShardSize = Config.CompressionType == DebugCompressionType::Zstd
+                           ? size_t(4) << 20
+                           : SIZE_MAX;
+    std::vector<std::pair<const SectionBase *, ArrayRef<uint8_t>>> Shards;
+    for (const SectionBase *Sec : ToCompress) {
+      ArrayRef<uint8_t> Data = Sec->OriginalData;
+      do {
+        Shards.emplace_back(Sec, Data.take_front(ShardSize));
+        Data = Data.drop_front(Shards.back().second.size());
+      } while (!Data.empty());
+    }
+    std::vector<SmallVector<uint8_t, 0>> Compressed(Shards.size());
+    compression::Params Params(Config.CompressionType);
+    parallelFor(0, Shards.size(), [&](size_t I) {
+      compression::compress(Params, Shards[I].second, Compressed[I]);
+    });
+    DenseMap<const SectionBase *, SmallVector<uint8_t, 0>> CompressedData;
+    for (size_t I = 0, E = Shards.size(); I != E; ++I) {
+      SmallVector<uint8_t, 0> &Data = CompressedData[Shards[I].first];
+      if (Data.empty())
+        Data = std::move(Compressed[I]);
+      else
+        Data.append(Compressed[I].begin(), Compressed[I].end());
+    }
+
     if (Error Err = replaceDebugSections(
             Obj, isCompressable,
-            [&Config, &Obj](const SectionBase *S) -> Expected<SectionBase *> {
-              return &Obj.addSection<CompressedSection>(
-                  CompressedSection(*S, Config.CompressionType, Obj.Is64Bits));
+            [&](const SectionBase *S) -> Expected<SectionBase *> {
+              return &Obj.addSection<CompressedSection>(CompressedSection(
+                  *S, Config.CompressionType, Obj.Is64Bits,
+                  std::move(CompressedData[S])));
             }))
       return Err;
   } else if (Config.DecompressDebugSections) {
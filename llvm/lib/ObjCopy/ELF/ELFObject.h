@@ -540,11 +540,15 @@ class CompressedSection : public SectionBase {
   DebugCompressionType CompressionType;
   uint64_t DecompressedSize;
   uint64_t DecompressedAlign;
-  SmallVector<uint8_t, 128> CompressedData;
+  SmallVector<uint8_t, 0> CompressedData;
 
 public:
+  /// Construct a section holding the contents of \p Sec compressed with
+  /// \p CompressionType. The contents are compressed by the caller, so that
+  /// several sections can be compressed in parallel.
   CompressedSection(const SectionBase &Sec,
-    DebugCompressionType CompressionType, bool Is64Bits);
+                    DebugCompressionType CompressionType, bool Is64Bits,
+                    SmallVector<uint8_t, 0> CompressedData);
   CompressedSection(ArrayRef<uint8_t> CompressedData, uint32_t ChType,
                     uint64_t DecompressedSize, uint64_t DecompressedAlign);
 
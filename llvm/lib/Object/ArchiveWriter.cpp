@@ -12,9 +12,11 @@
 
 #include "llvm/Object/ArchiveWriter.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/BinaryFormat/Magic.h"
+#include "llvm/Bitcode/BitcodeReader.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/Object/Archive.h"
 #include "llvm/Object/Error.h"
@@ -29,6 +31,7 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
 #include "llvm/Support/raw_ostream.h"
@@ -446,28 +449,32 @@ static Expected<std::vector<unsigned>>
 getSymbols(MemoryBufferRef Buf, raw_ostream &SymNames, bool &HasObject) {
   std::vector<unsigned> Ret;
 
-  // In the scenario when LLVMContext is populated SymbolicFile will contain a
-  // reference to it, thus SymbolicFile should be destroyed first.
-  LLVMContext Context;
-  std::unique_ptr<object::SymbolicFile> Obj;
-
   const file_magic Type = identify_magic(Buf.getBuffer());
-  // Treat unsupported file types as having no symbols.
-  if (!object::SymbolicFile::isSymbolicFile(Type, &Context))
-    return Ret;
+  // Read the symbols of bitcode files from their irsymtab. It holds the same
+  // symbols and flags an IRObjectFile would report, and the modules only have
+  // to be parsed if it is missing or was written by another producer.
   if (Type == file_magic::bitcode) {
-    auto ObjOrErr = object::SymbolicFile::createSymbolicFile(
-        Buf, file_magic::bitcode, &Context);
-    if (!ObjOrErr)
-      return ObjOrErr.takeError();
-    Obj = std::move(*ObjOrErr);
-  } else {
-    auto ObjOrErr = object::SymbolicFile::createSymbolicFile(Buf);
-    if (!ObjOrErr)
-      return ObjOrErr.takeError();
-    Obj = std::move(*ObjOrErr);
+    Expected<object::IRSymtabFile> FOrErr = object::readIRSymtab(Buf);
+    if (!FOrErr)
+      return FOrErr.takeError();
+    HasObject = true;
+    for (const irsymtab::Reader::SymbolRef &Sym : FOrErr->TheReader.symbols()) {
+      if (Sym.isFormatSpecific() || !Sym.isGlobal() || Sym.isUndefined())
+        continue;
+      Ret.push_back(SymNames.tell());
+      SymNames << Sym.getName() << '\0';
+    }
+    return Ret;
   }
 
+  // Treat unsupported file types as having no symbols.
+  if (!object::SymbolicFile::isSymbolicFile(Type, /*Context=*/nullptr))
+    return Ret;
+  auto ObjOrErr = object::SymbolicFile::createSymbolicFile(Buf);
+  if (!ObjOrErr)
+    return ObjOrErr.takeError();
+  std::unique_ptr<object::SymbolicFile> Obj = std::move(*ObjOrErr);
+
   HasObject = true;
   for (const object::BasicSymbolRef &S : Obj->symbols()) {
     if (!isArchiveSymbol(S))
@@ -492,6 +499,34 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
   std::vector<MemberData> Ret;
   bool HasObject = false;
 
+  // Reading the symbol tables is the expensive part, and independent for each
+  // member, so it is done up front in parallel. The names are appended to
+  // SymNames in member order below.
+  struct MemberSymbols {
+    std::string Names;
+    std::vector<unsigned> Offsets;
+    bool HasObject = false;
+    Error Err = Error::success();
+  };
+  std::vector<MemberSymbols> MemberSyms(NeedSymbols ? NewMembers.size() : 0);
+  parallelFor(0, MemberSyms.size(), [&](size_t I) {
+    MemberSymbols &MS = MemberSyms[I];
+    raw_string_ostream Names(MS.Names);
+    Expected<std::vector<unsigned>> SymbolsOrErr =
+        getSymbols(NewMembers[I].Buf->getMemBufferRef(), Names, MS.HasObject);
+    if (!SymbolsOrErr)
+      MS.Err = SymbolsOrErr.takeError();
+    else
+      MS.Offsets = std::move(*SymbolsOrErr);
+  });
+  for (size_t I = 0, E = MemberSyms.size(); I != E; ++I) {
+    if (Error Err = std::move(MemberSyms[I].Err)) {
+      for (MemberSymbols &MS : drop_begin(MemberSyms, I + 1))
+        consumeError(std::move(MS.Err));
+      return createFileError(NewMembers[I].MemberName, std::move(Err));
+    }
+  }
+
   // Deduplicate long member names in the string table and reuse earlier name
   // offsets. This especially saves space for COFF Import libraries where all
   // members have the same name.
@@ -550,7 +585,7 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
   // The big archive format needs to know the offset of the previous member
   // header.
   unsigned PrevOffset = 0;
-  for (const NewArchiveMember &M : NewMembers) {
+  for (const auto &[I, M] : enumerate(NewMembers)) {
     std::string Header;
     raw_string_ostream Out(Header);
 
@@ -596,11 +631,13 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
 
     std::vector<unsigned> Symbols;
     if (NeedSymbols) {
-      Expected<std::vector<unsigned>> SymbolsOrErr =
-          getSymbols(Buf, SymNames, HasObject);
-      if (!SymbolsOrErr)
-        return createFileError(M.MemberName, SymbolsOrErr.takeError());
-      Symbols = std::move(*SymbolsOrErr);
+      MemberSymbols &MS = MemberSyms[I];
+      uint64_t Base = SymNames.tell();
+      SymNames << MS.Names;
+      for (unsigned Offset : MS.Offsets)
+        Symbols.push_back(Base + Offset);
+      HasObject |= MS.HasObject;
+      MS = MemberSymbols();
     }
 
     Pos += Header.size() + Data.size() + Padding.size();
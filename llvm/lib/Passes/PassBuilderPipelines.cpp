@@ -58,6 +58,7 @@
 #include "llvm/Transforms/IPO/MergeFunctions.h"
 #include "llvm/Transforms/IPO/ModuleInliner.h"
 #include "llvm/Transforms/IPO/OpenMPOpt.h"
+#include "llvm/Transforms/IPO/PGOMultiVersioning.h"
 #include "llvm/Transforms/IPO/PartialInlining.h"
 #include "llvm/Transforms/IPO/SCCP.h"
 #include "llvm/Transforms/IPO/SampleProfile.h"
@@ -222,6 +223,11 @@ static cl::opt<bool>
     EnableHotColdSplit("hot-cold-split",
                        cl::desc("Enable hot-cold splitting pass"));
 
+static cl::opt<bool> EnablePGOMultiVersioning(
+    "enable-pgo-multiversion", cl::init(false), cl::Hidden,
+    cl::desc("Clone the functions with hot loops for newer x86-64 ISA levels "
+             "when optimizing with a profile"));
+
 static cl::opt<bool> EnableIROutliner("ir-outliner", cl::init(false),
                                       cl::Hidden,
                                       cl::desc("Enable ir outliner pass"));
@@ -1270,6 +1276,13 @@ PassBuilder::buildModuleOptimizationPipeline(OptimizationLevel Level,
                         PGOOpt->ProfileRemappingFile, LTOPhase);
   }
 
+  // Clone the functions with hot loops for newer ISA levels before the
+  // vectorizers run, so that each clone is vectorized for its level.
+  if (EnablePGOMultiVersioning && !LTOPreLink && PGOOpt &&
+      (PGOOpt->Action == PGOOptions::IRUse ||
+       PGOOpt->Action == PGOOptions::SampleUse))
+    MPM.addPass(PGOMultiVersioningPass());
+
   // Re-compute GlobalsAA here prior to function passes. This is particularly
   // useful as the above will have inlined, DCE'ed, and function-attr
   // propagated everything. We should at this point have a reasonably minimal
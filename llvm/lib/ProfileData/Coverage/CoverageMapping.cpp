@@ -26,6 +26,8 @@
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cassert>
@@ -33,6 +35,7 @@
 #include <iterator>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <system_error>
 #include <utility>
@@ -229,9 +232,13 @@ static unsigned getMaxCounterID(const CounterMappingContext &Ctx,
   return MaxCounterID;
 }
 
-Error CoverageMapping::loadFunctionRecord(
-    const CoverageMappingRecord &Record,
-    IndexedInstrProfReader &ProfileReader) {
+/// Evaluate the counters of \p Record against the profile. \p Function is
+/// left empty if the record does not contribute a function. The profile is
+/// read under \p ProfileMutex, if given.
+static Error evaluateFunctionRecord(
+    const CoverageMappingRecord &Record, IndexedInstrProfReader &ProfileReader,
+    std::mutex *ProfileMutex, Optional<FunctionRecord> &Function,
+    std::vector<std::pair<std::string, uint64_t>> &FuncHashMismatches) {
   StringRef OrigFuncName = Record.FunctionName;
   if (OrigFuncName.empty())
     return make_error<CoverageMapError>(coveragemap_error::malformed);
@@ -244,9 +251,16 @@ Error CoverageMapping::loadFunctionRecord(
   CounterMappingContext Ctx(Record.Expressions);
 
   std::vector<uint64_t> Counts;
-  if (Error E = ProfileReader.getFunctionCounts(Record.FunctionName,
-                                                Record.FunctionHash, Counts)) {
-    instrprof_error IPE = InstrProfError::take(std::move(E));
+  Error CountsErr = Error::success();
+  {
+    std::unique_lock<std::mutex> Lock;
+    if (ProfileMutex)
+      Lock = std::unique_lock<std::mutex>(*ProfileMutex);
+    CountsErr = ProfileReader.getFunctionCounts(Record.FunctionName,
+                                                Record.FunctionHash, Counts);
+  }
+  if (CountsErr) {
+    instrprof_error IPE = InstrProfError::take(std::move(CountsErr));
     if (IPE == instrprof_error::hash_mismatch) {
       FuncHashMismatches.emplace_back(std::string(Record.FunctionName),
                                       Record.FunctionHash);
@@ -268,7 +282,7 @@ Error CoverageMapping::loadFunctionRecord(
       Record.MappingRegions[0].Count.isZero() && Counts[0] > 0)
     return Error::success();
 
-  FunctionRecord Function(OrigFuncName, Record.Filenames);
+  FunctionRecord Result(OrigFuncName, Record.Filenames);
   for (const auto &Region : Record.MappingRegions) {
     Expected<int64_t> ExecutionCount = Ctx.evaluate(Region.Count);
     if (auto E = ExecutionCount.takeError()) {
@@ -280,14 +294,31 @@ Error CoverageMapping::loadFunctionRecord(
       consumeError(std::move(E));
       return Error::success();
     }
-    Function.pushRegion(Region, *ExecutionCount, *AltExecutionCount);
+    Result.pushRegion(Region, *ExecutionCount, *AltExecutionCount);
   }
+  Function = std::move(Result);
+  return Error::success();
+}
 
+Error CoverageMapping::loadFunctionRecord(
+    const CoverageMappingRecord &Record,
+    IndexedInstrProfReader &ProfileReader) {
+  Optional<FunctionRecord> Function;
+  if (Error E = evaluateFunctionRecord(Record, ProfileReader,
+                                       /*ProfileMutex=*/nullptr, Function,
+                                       FuncHashMismatches))
+    return E;
+  if (Function)
+    addFunctionRecord(std::move(*Function));
+  return Error::success();
+}
+
+void CoverageMapping::addFunctionRecord(FunctionRecord &&Function) {
   // Don't create records for (filenames, function) pairs we've already seen.
-  auto FilenamesHash = hash_combine_range(Record.Filenames.begin(),
-                                          Record.Filenames.end());
-  if (!RecordProvenance[FilenamesHash].insert(hash_value(OrigFuncName)).second)
-    return Error::success();
+  auto FilenamesHash = hash_combine_range(Function.Filenames.begin(),
+                                          Function.Filenames.end());
+  if (!RecordProvenance[FilenamesHash].insert(hash_value(Function.Name)).second)
+    return;
 
   Functions.push_back(std::move(Function));
 
@@ -295,7 +326,7 @@ Error CoverageMapping::loadFunctionRecord(
   // which correspond to each filename. This can be used to substantially speed
   // up queries for coverage info in a file.
   unsigned RecordIndex = Functions.size() - 1;
-  for (StringRef Filename : Record.Filenames) {
+  for (StringRef Filename : Functions.back().Filenames) {
     auto &RecordIndices = FilenameHash2RecordIndices[hash_value(Filename)];
     // Note that there may be duplicates in the filename set for a function
     // record, because of e.g. macro expansions in the function in which both
@@ -303,8 +334,6 @@ Error CoverageMapping::loadFunctionRecord(
     if (RecordIndices.empty() || RecordIndices.back() != RecordIndex)
       RecordIndices.push_back(RecordIndex);
   }
-
-  return Error::success();
 }
 
 // This function is for memory optimization by shortening the lifetimes
@@ -343,10 +372,61 @@ static Error handleMaybeNoDataFoundError(Error E) {
       });
 }
 
+namespace {
+
+/// The function records decoded from one object file, in reader order.
+struct DecodedObject {
+  std::vector<FunctionRecord> Functions;
+  std::vector<std::pair<std::string, uint64_t>> FuncHashMismatches;
+  bool DataFound = false;
+};
+
+} // end anonymous namespace
+
+/// Decode the coverage mapping of \p ObjectFilename and evaluate its records
+/// against the profile, without adding them to a CoverageMapping yet.
+static Error decodeObject(StringRef ObjectFilename, StringRef Arch,
+                          StringRef CompilationDir,
+                          IndexedInstrProfReader &ProfileReader,
+                          std::mutex &ProfileMutex, DecodedObject &Result) {
+  auto CovMappingBufOrErr = MemoryBuffer::getFileOrSTDIN(
+      ObjectFilename, /*IsText=*/false, /*RequiresNullTerminator=*/false);
+  if (std::error_code EC = CovMappingBufOrErr.getError())
+    return createFileError(ObjectFilename, errorCodeToError(EC));
+  MemoryBufferRef CovMappingBufRef =
+      CovMappingBufOrErr.get()->getMemBufferRef();
+  SmallVector<std::unique_ptr<MemoryBuffer>, 4> Buffers;
+  auto CoverageReadersOrErr = BinaryCoverageReader::create(
+      CovMappingBufRef, Arch, Buffers, CompilationDir);
+  if (Error E = CoverageReadersOrErr.takeError()) {
+    E = handleMaybeNoDataFoundError(std::move(E));
+    if (E)
+      return createFileError(ObjectFilename, std::move(E));
+    // E == success (originally a no_data_found error).
+    return Error::success();
+  }
+
+  for (const auto &CoverageReader : CoverageReadersOrErr.get()) {
+    Result.DataFound = true;
+    for (auto RecordOrErr : *CoverageReader) {
+      if (Error E = RecordOrErr.takeError())
+        return createFileError(ObjectFilename, std::move(E));
+      Optional<FunctionRecord> Function;
+      if (Error E = evaluateFunctionRecord(*RecordOrErr, ProfileReader,
+                                           &ProfileMutex, Function,
+                                           Result.FuncHashMismatches))
+        return createFileError(ObjectFilename, std::move(E));
+      if (Function)
+        Result.Functions.push_back(std::move(*Function));
+    }
+  }
+  return Error::success();
+}
+
 Expected<std::unique_ptr<CoverageMapping>>
 CoverageMapping::load(ArrayRef<StringRef> ObjectFilenames,
                       StringRef ProfileFilename, ArrayRef<StringRef> Arches,
-                      StringRef CompilationDir) {
+                      StringRef CompilationDir, unsigned NumThreads) {
   auto ProfileReaderOrErr = IndexedInstrProfReader::create(ProfileFilename);
   if (Error E = ProfileReaderOrErr.takeError())
     return createFileError(ProfileFilename, std::move(E));
@@ -354,32 +434,56 @@ CoverageMapping::load(ArrayRef<StringRef> ObjectFilenames,
   auto Coverage = std::unique_ptr<CoverageMapping>(new CoverageMapping());
   bool DataFound = false;
 
-  for (const auto &File : llvm::enumerate(ObjectFilenames)) {
-    auto CovMappingBufOrErr = MemoryBuffer::getFileOrSTDIN(
-        File.value(), /*IsText=*/false, /*RequiresNullTerminator=*/false);
-    if (std::error_code EC = CovMappingBufOrErr.getError())
-      return createFileError(File.value(), errorCodeToError(EC));
-    StringRef Arch = Arches.empty() ? StringRef() : Arches[File.index()];
-    MemoryBufferRef CovMappingBufRef =
-        CovMappingBufOrErr.get()->getMemBufferRef();
-    SmallVector<std::unique_ptr<MemoryBuffer>, 4> Buffers;
-    auto CoverageReadersOrErr = BinaryCoverageReader::create(
-        CovMappingBufRef, Arch, Buffers, CompilationDir);
-    if (Error E = CoverageReadersOrErr.takeError()) {
-      E = handleMaybeNoDataFoundError(std::move(E));
-      if (E)
-        return createFileError(File.value(), std::move(E));
-      // E == success (originally a no_data_found error).
-      continue;
-    }
+  ThreadPoolStrategy S = hardware_concurrency(NumThreads);
+  if (NumThreads == 0) {
+    S = heavyweight_hardware_concurrency(ObjectFilenames.size());
+    S.Limit = true;
+  }
+
+  std::vector<DecodedObject> Objects(ObjectFilenames.size());
+  std::vector<Error> Errors;
+  for (size_t I = 0, E = ObjectFilenames.size(); I != E; ++I)
+    Errors.push_back(Error::success());
+  std::mutex ProfileMutex;
+  auto Decode = [&](size_t I) {
+    StringRef Arch = Arches.empty() ? StringRef() : Arches[I];
+    Errors[I] = decodeObject(ObjectFilenames[I], Arch, CompilationDir,
+                             *ProfileReader, ProfileMutex, Objects[I]);
+  };
+
+  // Decoding and evaluating the records of different objects is independent,
+  // only the profile lookups are serialized. The records are added in object
+  // order, which keeps the deduplication of functions seen in several objects
+  // the same however many threads are used.
+  bool Parallel = ObjectFilenames.size() > 1 && S.compute_thread_count() > 1;
+  if (Parallel) {
+    ThreadPool Pool(S);
+    for (size_t I = 0, E = ObjectFilenames.size(); I != E; ++I)
+      Pool.async(Decode, I);
+    Pool.wait();
+  }
 
-    SmallVector<std::unique_ptr<CoverageMappingReader>, 4> Readers;
-    for (auto &Reader : CoverageReadersOrErr.get())
-      Readers.push_back(std::move(Reader));
-    DataFound |= !Readers.empty();
-    if (Error E = loadFromReaders(Readers, *ProfileReader, *Coverage))
-      return createFileError(File.value(), std::move(E));
+  for (size_t I = 0, E = ObjectFilenames.size(); I != E; ++I) {
+    if (!Parallel)
+      Decode(I);
+    if (Errors[I])
+      break;
+    DecodedObject &Object = Objects[I];
+    DataFound |= Object.DataFound;
+    for (FunctionRecord &Function : Object.Functions)
+      Coverage->addFunctionRecord(std::move(Function));
+    llvm::append_range(Coverage->FuncHashMismatches,
+                       Object.FuncHashMismatches);
+    // Release the moved-from records early.
+    Object = DecodedObject();
   }
+
+  Error Err = Error::success();
+  for (Error &E : Errors)
+    Err = joinErrors(std::move(Err), std::move(E));
+  if (Err)
+    return std::move(Err);
+
   // If no readers were created, either no objects were provided or none of them
   // had coverage data. Return an error in the latter case.
   if (!DataFound && !ObjectFilenames.empty())
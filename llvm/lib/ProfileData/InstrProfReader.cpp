@@ -63,9 +63,12 @@ static InstrProfKind getProfileKindFromVersion(uint64_t Version) {
 }
 
 static Expected<std::unique_ptr<MemoryBuffer>>
-setupMemoryBuffer(const Twine &Path) {
+setupMemoryBuffer(const Twine &Path, bool IsText = true) {
+  // Binary formats do not need a null terminator, which lets large files be
+  // mapped rather than read in, whatever their size.
   ErrorOr<std::unique_ptr<MemoryBuffer>> BufferOrErr =
-      MemoryBuffer::getFileOrSTDIN(Path, /*IsText=*/true);
+      MemoryBuffer::getFileOrSTDIN(Path, IsText,
+                                   /*RequiresNullTerminator=*/IsText);
   if (std::error_code EC = BufferOrErr.getError())
     return errorCodeToError(EC);
   return std::move(BufferOrErr.get());
@@ -117,8 +120,9 @@ InstrProfReader::create(std::unique_ptr<MemoryBuffer> Buffer,
 
 Expected<std::unique_ptr<IndexedInstrProfReader>>
 IndexedInstrProfReader::create(const Twine &Path, const Twine &RemappingPath) {
-  // Set up the buffer to read.
-  auto BufferOrError = setupMemoryBuffer(Path);
+  // Set up the buffer to read. Records are only paged in as they are looked
+  // up.
+  auto BufferOrError = setupMemoryBuffer(Path, /*IsText=*/false);
   if (Error E = BufferOrError.takeError())
     return std::move(E);
 
@@ -1032,9 +1036,14 @@ Expected<InstrProfRecord> IndexedInstrProfReader::getInstrProfRecord(
     StringRef FuncName, uint64_t FuncHash, uint64_t *MismatchedFuncSum) {
   ArrayRef<NamedInstrProfRecord> Data;
   uint64_t FuncSum = 0;
-  Error Err = Remapper->getRecords(FuncName, Data);
-  if (Err)
-    return std::move(Err);
+  auto Prefetched = PrefetchedRecords.find(FuncName);
+  if (Prefetched != PrefetchedRecords.end()) {
+    Data = Prefetched->second;
+  } else {
+    Error Err = Remapper->getRecords(FuncName, Data);
+    if (Err)
+      return std::move(Err);
+  }
   // Found it. Look for counters with the right hash.
 
   // A flag to indicate if the records are from the same type
@@ -1073,6 +1082,29 @@ Expected<InstrProfRecord> IndexedInstrProfReader::getInstrProfRecord(
   return error(instrprof_error::unknown_function);
 }
 
+Error IndexedInstrProfReader::prefetchRecords(ArrayRef<StringRef> FuncNames) {
+  std::vector<std::pair<uint64_t, StringRef>> Order;
+  Order.reserve(FuncNames.size());
+  for (StringRef FuncName : FuncNames)
+    Order.emplace_back(Index->getBucketIndex(FuncName), FuncName);
+  llvm::sort(Order);
+
+  for (const auto &[Bucket, FuncName] : Order) {
+    if (PrefetchedRecords.count(FuncName))
+      continue;
+    ArrayRef<NamedInstrProfRecord> Data;
+    if (Error E = Remapper->getRecords(FuncName, Data)) {
+      instrprof_error Err = InstrProfError::take(std::move(E));
+      if (Err == instrprof_error::unknown_function)
+        continue;
+      return error(Err);
+    }
+    // The lookup trait reuses its buffer, so the records have to be copied.
+    PrefetchedRecords[FuncName].assign(Data.begin(), Data.end());
+  }
+  return success();
+}
+
 Expected<memprof::MemProfRecord>
 IndexedInstrProfReader::getMemProfRecord(const uint64_t FuncNameHash) {
   // TODO: Add memprof specific errors.
@@ -286,6 +286,31 @@ void InstrProfWriter::mergeRecordsFromWriter(InstrProfWriter &&IPW,
     for (auto &Func : I.getValue())
       addRecord(I.getKey(), Func.first, std::move(Func.second), 1, Warn);
 
+  mergeMemProfFromWriter(IPW, Warn);
+}
+
+Error InstrProfWriter::addPartition(InstrProfWriter &Partition,
+                                    function_ref<void(Error)> Warn) {
+  assert(Partition.Partitions.empty() && "Partitions cannot be nested");
+  if (Partition.getProfileKind() != InstrProfKind::Unknown)
+    if (Error E = mergeProfileKind(Partition.getProfileKind()))
+      return E;
+  Partitions.push_back(&Partition);
+  mergeMemProfFromWriter(Partition, Warn);
+  return Error::success();
+}
+
+void InstrProfWriter::forEachFunction(
+    function_ref<void(const StringMapEntry<ProfilingData> &)> Fn) const {
+  for (const auto &I : FunctionData)
+    Fn(I);
+  for (const InstrProfWriter *Partition : Partitions)
+    for (const auto &I : Partition->FunctionData)
+      Fn(I);
+}
+
+void InstrProfWriter::mergeMemProfFromWriter(InstrProfWriter &IPW,
+                                             function_ref<void(Error)> Warn) {
   MemProfFrameData.reserve(IPW.MemProfFrameData.size());
   for (auto &I : IPW.MemProfFrameData) {
     // If we weren't able to add the frame mappings then it doesn't make sense
@@ -339,9 +364,10 @@ Error InstrProfWriter::writeImpl(ProfOStream &OS) {
   InfoObj->CSSummaryBuilder = &CSISB;
 
   // Populate the hash table generator.
-  for (const auto &I : FunctionData)
+  forEachFunction([&](const StringMapEntry<ProfilingData> &I) {
     if (shouldEncodeData(I.getValue()))
       Generator.insert(I.getKey(), &I.getValue());
+  });
 
   // Write the header.
   IndexedInstrProf::Header Header;
@@ -492,12 +518,15 @@ Error InstrProfWriter::writeImpl(ProfOStream &OS) {
 
   OS.patch(PatchItems, sizeof(PatchItems) / sizeof(*PatchItems));
 
-  for (const auto &I : FunctionData)
+  Error Result = Error::success();
+  forEachFunction([&](const StringMapEntry<ProfilingData> &I) {
+    if (Result)
+      return;
     for (const auto &F : I.getValue())
-      if (Error E = validateRecord(F.second))
-        return E;
-
-  return Error::success();
+      if ((Result = validateRecord(F.second)))
+        return;
+  });
+  return Result;
 }
 
 Error InstrProfWriter::write(raw_fd_ostream &OS) {
@@ -597,14 +626,17 @@ Error InstrProfWriter::writeText(raw_fd_ostream &OS) {
   using RecordType = std::pair<StringRef, FuncPair>;
   SmallVector<RecordType, 4> OrderedFuncData;
 
-  for (const auto &I : FunctionData) {
-    if (shouldEncodeData(I.getValue())) {
-      if (Error E = Symtab.addFuncName(I.getKey()))
-        return E;
-      for (const auto &Func : I.getValue())
-        OrderedFuncData.push_back(std::make_pair(I.getKey(), Func));
-    }
-  }
+  Error SymtabErr = Error::success();
+  forEachFunction([&](const StringMapEntry<ProfilingData> &I) {
+    if (SymtabErr || !shouldEncodeData(I.getValue()))
+      return;
+    if ((SymtabErr = Symtab.addFuncName(I.getKey())))
+      return;
+    for (const auto &Func : I.getValue())
+      OrderedFuncData.push_back(std::make_pair(I.getKey(), Func));
+  });
+  if (SymtabErr)
+    return SymtabErr;
 
   llvm::sort(OrderedFuncData, [](const RecordType &A, const RecordType &B) {
     return std::tie(A.first, A.second.first) <
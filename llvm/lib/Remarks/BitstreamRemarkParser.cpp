@@ -489,11 +489,37 @@ Error BitstreamRemarkParser::processSeparateRemarksMetaMeta(
 }
 
 Expected<std::unique_ptr<Remark>> BitstreamRemarkParser::parseRemark() {
-  BitstreamRemarkParserHelper RemarkHelper(ParserHelper.Stream);
-  if (Error E = RemarkHelper.parse())
-    return std::move(E);
+  while (true) {
+    BitstreamRemarkParserHelper RemarkHelper(ParserHelper.Stream);
+    if (Error E = RemarkHelper.parse())
+      return std::move(E);
+
+    if (!isFilteredOut(RemarkHelper))
+      return processRemark(RemarkHelper);
+
+    if (ParserHelper.atEndOfStream())
+      return make_error<EndOfFileError>();
+  }
+}
 
-  return processRemark(RemarkHelper);
+bool BitstreamRemarkParser::isFilteredOut(
+    BitstreamRemarkParserHelper &Helper) const {
+  if (!PassNameFilter && !FunctionNameFilter)
+    return false;
+  // Anything malformed is left to processRemark to report.
+  if (!StrTab || !Helper.PassNameIdx || !Helper.FunctionNameIdx)
+    return false;
+  Expected<StringRef> PassName = (*StrTab)[*Helper.PassNameIdx];
+  if (!PassName) {
+    consumeError(PassName.takeError());
+    return false;
+  }
+  Expected<StringRef> FunctionName = (*StrTab)[*Helper.FunctionNameIdx];
+  if (!FunctionName) {
+    consumeError(FunctionName.takeError());
+    return false;
+  }
+  return !matchesFilters(*PassName, *FunctionName);
 }
 
 Expected<std::unique_ptr<Remark>>
@@ -73,6 +73,9 @@ private:
   Error processSeparateRemarksMetaMeta(BitstreamMetaParserHelper &Helper);
   Expected<std::unique_ptr<Remark>>
   processRemark(BitstreamRemarkParserHelper &Helper);
+  /// Check the filters against the string table indices of a parsed remark
+  /// block, before building the remark and its arguments.
+  bool isFilteredOut(BitstreamRemarkParserHelper &Helper) const;
   Error processExternalFilePath(Optional<StringRef> ExternalFilePath);
 };
 
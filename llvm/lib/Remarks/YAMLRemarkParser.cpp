@@ -411,19 +411,23 @@ Expected<Argument> YAMLRemarkParser::parseArg(yaml::Node &Node) {
 }
 
 Expected<std::unique_ptr<Remark>> YAMLRemarkParser::next() {
-  if (YAMLIt == Stream.end())
-    return make_error<EndOfFileError>();
-
-  Expected<std::unique_ptr<Remark>> MaybeResult = parseRemark(*YAMLIt);
-  if (!MaybeResult) {
-    // Avoid garbage input, set the iterator to the end.
-    YAMLIt = Stream.end();
-    return MaybeResult.takeError();
-  }
+  while (true) {
+    if (YAMLIt == Stream.end())
+      return make_error<EndOfFileError>();
+
+    Expected<std::unique_ptr<Remark>> MaybeResult = parseRemark(*YAMLIt);
+    if (!MaybeResult) {
+      // Avoid garbage input, set the iterator to the end.
+      YAMLIt = Stream.end();
+      return MaybeResult.takeError();
+    }
 
-  ++YAMLIt;
+    ++YAMLIt;
 
-  return std::move(*MaybeResult);
+    const Remark &R = **MaybeResult;
+    if (matchesFilters(R.PassName, R.FunctionName))
+      return std::move(*MaybeResult);
+  }
 }
 
 Expected<StringRef> YAMLStrTabRemarkParser::parseStr(yaml::KeyValueNode &Node) {
@@ -9,6 +9,8 @@
 // This file implements the localCache function, which simplifies creating,
 // adding to, and querying a local file system cache. localCache takes care of
 // periodically pruning older files from the cache using a CachePruningPolicy.
+// It also implements the remoteCache function, which puts a RemoteCacheStore
+// behind such a cache.
 //
 //===----------------------------------------------------------------------===//
 
@@ -17,6 +19,8 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/SmallVectorMemoryBuffer.h"
+#include "llvm/Support/ThreadPool.h"
 
 #if !defined(_MSC_VER) && !defined(__MINGW32__)
 #include <unistd.h>
@@ -162,3 +166,155 @@ Expected<FileCache> llvm::localCache(Twine CacheNameRef,
     };
   };
 }
+
+void RemoteCacheStore::prefetch(StringRef Key) {
+  std::lock_guard<std::mutex> Lock(PrefetchedMu);
+  if (!Prefetched.count(Key))
+    Prefetched[Key] = get(Key);
+}
+
+RemoteCacheStore::EntryFuture RemoteCacheStore::fetch(StringRef Key) {
+  {
+    std::lock_guard<std::mutex> Lock(PrefetchedMu);
+    auto It = Prefetched.find(Key);
+    if (It != Prefetched.end()) {
+      EntryFuture Entry = std::move(It->second);
+      Prefetched.erase(It);
+      return Entry;
+    }
+  }
+  return get(Key);
+}
+
+void RemoteCacheStore::dropPrefetched(StringRef Key) {
+  std::lock_guard<std::mutex> Lock(PrefetchedMu);
+  Prefetched.erase(Key);
+}
+
+namespace {
+class DirectoryCacheStore : public RemoteCacheStore {
+  SmallString<64> DirectoryPath;
+  ThreadPool Pool;
+
+public:
+  DirectoryCacheStore(Twine DirectoryPathRef)
+      : Pool(hardware_concurrency(4)) {
+    DirectoryPathRef.toVector(DirectoryPath);
+  }
+
+  EntryFuture get(StringRef Key) override {
+    // Use the same file names as localCache, so that a local cache directory
+    // can be shared as is.
+    SmallString<64> EntryPath;
+    sys::path::append(EntryPath, DirectoryPath, "llvmcache-" + Key);
+    return Pool.async([EntryPath]() -> std::shared_ptr<MemoryBuffer> {
+      ErrorOr<std::unique_ptr<MemoryBuffer>> MBOrErr =
+          MemoryBuffer::getFile(EntryPath, /*IsText=*/false,
+                                /*RequiresNullTerminator=*/false);
+      if (!MBOrErr)
+        return nullptr;
+      return std::move(*MBOrErr);
+    });
+  }
+
+  void put(StringRef Key, std::unique_ptr<MemoryBuffer> Data) override {
+    SmallString<64> EntryPath;
+    sys::path::append(EntryPath, DirectoryPath, "llvmcache-" + Key);
+    SmallString<64> Dir = DirectoryPath;
+    std::shared_ptr<MemoryBuffer> SharedData = std::move(Data);
+    Pool.async([Dir, EntryPath, SharedData]() {
+      if (sys::fs::create_directories(Dir, /*IgnoreExisting=*/true))
+        return;
+      // Write to a temporary file and rename it, so that concurrent readers
+      // never see a partial entry.
+      SmallString<64> TempFilenameModel;
+      sys::path::append(TempFilenameModel, Dir, "remote-%%%%%%.tmp.o");
+      Expected<sys::fs::TempFile> Temp = sys::fs::TempFile::create(
+          TempFilenameModel, sys::fs::owner_read | sys::fs::owner_write |
+                                 sys::fs::group_read | sys::fs::others_read);
+      if (!Temp) {
+        consumeError(Temp.takeError());
+        return;
+      }
+      {
+        raw_fd_ostream OS(Temp->FD, /*shouldClose=*/false);
+        OS << SharedData->getBuffer();
+      }
+      if (Error E = Temp->keep(EntryPath)) {
+        consumeError(std::move(E));
+        consumeError(Temp->discard());
+      }
+    });
+  }
+
+  void wait() override { Pool.wait(); }
+};
+
+/// The stream for an entry that missed both caches. It collects the content,
+/// then writes it to the local cache's stream and stores it remotely.
+struct RemoteCacheStream : CachedFileStream {
+  std::unique_ptr<SmallString<0>> Data;
+  std::unique_ptr<CachedFileStream> Local;
+  std::shared_ptr<RemoteCacheStore> Remote;
+  std::string Key;
+
+  RemoteCacheStream(std::unique_ptr<SmallString<0>> Data,
+                    std::unique_ptr<CachedFileStream> Local,
+                    std::shared_ptr<RemoteCacheStore> Remote, std::string Key)
+      : CachedFileStream(std::make_unique<raw_svector_ostream>(*Data),
+                         Local->ObjectPathName),
+        Data(std::move(Data)), Local(std::move(Local)),
+        Remote(std::move(Remote)), Key(std::move(Key)) {}
+
+  ~RemoteCacheStream() {
+    OS.reset();
+    *Local->OS << *Data;
+    // Commit the entry to the local cache, which adds it to the link.
+    Local.reset();
+    Remote->put(Key, std::make_unique<SmallVectorMemoryBuffer>(
+                         std::move(*Data), /*RequiresNullTerminator=*/false));
+  }
+};
+} // namespace
+
+std::unique_ptr<RemoteCacheStore>
+llvm::directoryCacheStore(Twine DirectoryPath) {
+  return std::make_unique<DirectoryCacheStore>(DirectoryPath);
+}
+
+FileCache llvm::remoteCache(FileCache LocalCache,
+                            std::shared_ptr<RemoteCacheStore> Remote) {
+  return [=](unsigned Task, StringRef Key) -> Expected<AddStreamFn> {
+    Expected<AddStreamFn> LocalAddStreamOrErr = LocalCache(Task, Key);
+    if (!LocalAddStreamOrErr)
+      return LocalAddStreamOrErr.takeError();
+    AddStreamFn LocalAddStream = std::move(*LocalAddStreamOrErr);
+    if (!LocalAddStream) {
+      // Local hit.
+      Remote->dropPrefetched(Key);
+      return AddStreamFn();
+    }
+
+    if (std::shared_ptr<MemoryBuffer> MB = Remote->fetch(Key).get()) {
+      // Remote hit: add the entry to the local cache, which adds it to the
+      // link when the stream is destroyed.
+      Expected<std::unique_ptr<CachedFileStream>> StreamOrErr =
+          LocalAddStream(Task);
+      if (!StreamOrErr)
+        return StreamOrErr.takeError();
+      *(*StreamOrErr)->OS << MB->getBuffer();
+      return AddStreamFn();
+    }
+
+    std::string KeyStr = Key.str();
+    return [=](unsigned Task) -> Expected<std::unique_ptr<CachedFileStream>> {
+      Expected<std::unique_ptr<CachedFileStream>> LocalOrErr =
+          LocalAddStream(Task);
+      if (!LocalOrErr)
+        return LocalOrErr.takeError();
+      return std::make_unique<RemoteCacheStream>(
+          std::make_unique<SmallString<0>>(), std::move(*LocalOrErr), Remote,
+          KeyStr);
+    };
+  };
+}
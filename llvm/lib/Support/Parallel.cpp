@@ -12,8 +12,8 @@
 #include "llvm/Support/Threading.h"
 
 #include <atomic>
+#include <deque>
 #include <future>
-#include <stack>
 #include <thread>
 #include <vector>
 
@@ -44,12 +44,25 @@ public:
   static Executor *getDefaultExecutor();
 };
 
-/// An implementation of an Executor that runs closures on a thread pool
-///   in filo order.
+/// An implementation of an Executor that runs closures on a thread pool.
+///
+/// Every worker owns a work queue. Closures added from a worker thread are
+/// pushed onto that worker's own queue and popped back in filo order, so that
+/// tasks spawned by a running task (e.g. the recursion in parallelSort) stay
+/// on the same thread while it is busy. Closures added from any other thread
+/// go to a shared queue. An idle worker first drains its own queue, then the
+/// shared queue, and then steals the oldest task from another worker's queue.
+/// Each queue has its own lock, so workers don't serialize on a single mutex.
 class ThreadPoolExecutor : public Executor {
 public:
   explicit ThreadPoolExecutor(ThreadPoolStrategy S = hardware_concurrency()) {
     unsigned ThreadCount = S.compute_thread_count();
+    // One queue per worker plus the shared queue at index ThreadCount. All of
+    // them are created up front because tasks may be queued (and stolen)
+    // before every worker thread has been spawned.
+    Queues.reserve(ThreadCount + 1);
+    for (unsigned I = 0; I <= ThreadCount; ++I)
+      Queues.push_back(std::make_unique<WorkQueue>());
     // Spawn all but one of the threads in another thread as spawning threads
     // can take a while.
     Threads.reserve(ThreadCount);
@@ -95,37 +108,95 @@ public:
   };
 
   void add(std::function<void()> F) override {
+    WorkQueue &Q = LocalQueue ? *LocalQueue : *Queues.back();
     {
-      std::lock_guard<std::mutex> Lock(Mutex);
-      WorkStack.push(std::move(F));
+      std::lock_guard<std::mutex> Lock(Q.Mutex);
+      Q.Tasks.push_back(std::move(F));
+    }
+    ++Pending;
+    // Only take the global lock if some worker may be waiting for work. A
+    // worker increments Sleeping before checking Pending under Mutex, so
+    // either it sees our task or we see it sleeping and wake it up.
+    if (Sleeping.load() != 0) {
+      { std::lock_guard<std::mutex> Lock(Mutex); }
+      Cond.notify_one();
     }
-    Cond.notify_one();
   }
 
 private:
+  struct WorkQueue {
+    std::mutex Mutex;
+    std::deque<std::function<void()>> Tasks;
+  };
+
+  /// Pop the newest task from the calling worker's own queue, or else the
+  /// oldest task from the shared queue or from another worker's queue.
+  bool getTask(unsigned ThreadID, std::function<void()> &Task) {
+    {
+      WorkQueue &Q = *Queues[ThreadID];
+      std::lock_guard<std::mutex> Lock(Q.Mutex);
+      if (!Q.Tasks.empty()) {
+        Task = std::move(Q.Tasks.back());
+        Q.Tasks.pop_back();
+        return true;
+      }
+    }
+    if (stealTask(*Queues.back(), Task))
+      return true;
+    // Visit the other workers starting after our own index to spread out the
+    // stealing.
+    unsigned NumWorkers = Queues.size() - 1;
+    for (unsigned I = 1; I != NumWorkers; ++I)
+      if (stealTask(*Queues[(ThreadID + I) % NumWorkers], Task))
+        return true;
+    return false;
+  }
+
+  static bool stealTask(WorkQueue &Q, std::function<void()> &Task) {
+    std::lock_guard<std::mutex> Lock(Q.Mutex);
+    if (Q.Tasks.empty())
+      return false;
+    Task = std::move(Q.Tasks.front());
+    Q.Tasks.pop_front();
+    return true;
+  }
+
   void work(ThreadPoolStrategy S, unsigned ThreadID) {
     threadIndex = ThreadID;
+    LocalQueue = Queues[ThreadID].get();
     S.apply_thread_strategy(ThreadID);
-    while (true) {
+    while (!Stop) {
+      std::function<void()> Task;
+      if (getTask(ThreadID, Task)) {
+        --Pending;
+        Task();
+        continue;
+      }
       std::unique_lock<std::mutex> Lock(Mutex);
-      Cond.wait(Lock, [&] { return Stop || !WorkStack.empty(); });
-      if (Stop)
-        break;
-      auto Task = std::move(WorkStack.top());
-      WorkStack.pop();
-      Lock.unlock();
-      Task();
+      ++Sleeping;
+      Cond.wait(Lock, [&] { return Stop || Pending.load() != 0; });
+      --Sleeping;
     }
   }
 
+  /// The work queue owned by the current thread if it is a worker.
+  static thread_local WorkQueue *LocalQueue;
+
   std::atomic<bool> Stop{false};
-  std::stack<std::function<void()>> WorkStack;
+  /// Number of tasks queued but not yet picked up by a worker.
+  std::atomic<unsigned> Pending{0};
+  /// Number of workers blocked (or about to block) on Cond.
+  std::atomic<unsigned> Sleeping{0};
+  std::vector<std::unique_ptr<WorkQueue>> Queues;
   std::mutex Mutex;
   std::condition_variable Cond;
   std::promise<void> ThreadsCreated;
   std::vector<std::thread> Threads;
 };
 
+thread_local ThreadPoolExecutor::WorkQueue *ThreadPoolExecutor::LocalQueue =
+    nullptr;
+
 Executor *Executor::getDefaultExecutor() {
   // The ManagedStatic enables the ThreadPoolExecutor to be stopped via
   // llvm_shutdown() which allows a "clean" fast exit, e.g. via _exit(). This
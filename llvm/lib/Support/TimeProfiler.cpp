@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <map>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -63,6 +64,10 @@ using DurationType = duration<ClockType::rep, ClockType::period>;
 using CountAndDurationType = std::pair<size_t, DurationType>;
 using NameAndCountAndDurationType =
     std::pair<std::string, CountAndDurationType>;
+using CountAndBytesType = std::pair<size_t, uint64_t>;
+
+// Number of 'Top memory' entries in the trace.
+constexpr size_t NumTopMemoryEvents = 100;
 
 /// Represents an open or completed time section entry to be captured.
 struct TimeTraceProfilerEntry {
@@ -70,6 +75,13 @@ struct TimeTraceProfilerEntry {
   TimePointType End;
   const std::string Name;
   const std::string Detail;
+  // Memory counter when the entry began, and its generation. The bytes are
+  // only known if the counter was not replaced while the entry was open.
+  uint64_t StartBytes = 0;
+  unsigned CounterGeneration = 0;
+  bool HasBytes = false;
+  uint64_t Bytes = 0;
+  uint64_t NestedBytes = 0;
 
   TimeTraceProfilerEntry(TimePointType &&S, TimePointType &&E, std::string &&N,
                          std::string &&Dt)
@@ -105,6 +117,10 @@ struct llvm::TimeTraceProfiler {
   void begin(std::string Name, llvm::function_ref<std::string()> Detail) {
     Stack.emplace_back(ClockType::now(), TimePointType(), std::move(Name),
                        Detail());
+    if (MemoryCounter) {
+      Stack.back().StartBytes = MemoryCounter();
+      Stack.back().CounterGeneration = CounterGeneration;
+    }
   }
 
   void end() {
@@ -119,6 +135,17 @@ struct llvm::TimeTraceProfiler {
                  Entries.back().getFlameGraphDurUs())) &&
            "TimeProfiler scope ended earlier than previous scope");
 
+    if (MemoryCounter && E.CounterGeneration == CounterGeneration) {
+      E.HasBytes = true;
+      E.Bytes = MemoryCounter() - E.StartBytes;
+      if (Stack.size() > 1)
+        Stack[Stack.size() - 2].NestedBytes += E.Bytes;
+      auto &CountAndBytes =
+          CountAndBytesPerDetail[std::make_pair(E.Name, E.Detail)];
+      CountAndBytes.first++;
+      CountAndBytes.second += E.Bytes - std::min(E.NestedBytes, E.Bytes);
+    }
+
     // Calculate duration at full precision for overall counts.
     DurationType Duration = E.End - E.Start;
 
@@ -172,8 +199,13 @@ struct llvm::TimeTraceProfiler {
         J.attribute("ts", StartUs);
         J.attribute("dur", DurUs);
         J.attribute("name", E.Name);
-        if (!E.Detail.empty()) {
-          J.attributeObject("args", [&] { J.attribute("detail", E.Detail); });
+        if (!E.Detail.empty() || E.HasBytes) {
+          J.attributeObject("args", [&] {
+            if (!E.Detail.empty())
+              J.attribute("detail", E.Detail);
+            if (E.HasBytes)
+              J.attribute("bytes", int64_t(E.Bytes));
+          });
         }
       });
     };
@@ -237,6 +269,50 @@ struct llvm::TimeTraceProfiler {
       ++TotalTid;
     }
 
+    // Report the events that allocated the most memory themselves, combined
+    // by name and detail. These are on one more thread, from the largest.
+    std::map<std::pair<std::string, std::string>, CountAndBytesType>
+        AllCountAndBytesPerDetail;
+    auto combineBytes = [&](const auto &Stat) {
+      auto &CountAndBytes = AllCountAndBytesPerDetail[Stat.first];
+      CountAndBytes.first += Stat.second.first;
+      CountAndBytes.second += Stat.second.second;
+    };
+    for (const auto &Stat : CountAndBytesPerDetail)
+      combineBytes(Stat);
+    for (const TimeTraceProfiler *TTP : Instances.List)
+      for (const auto &Stat : TTP->CountAndBytesPerDetail)
+        combineBytes(Stat);
+
+    std::vector<std::pair<const std::pair<std::string, std::string> *,
+                          CountAndBytesType>>
+        SortedBytes;
+    for (const auto &Stat : AllCountAndBytesPerDetail)
+      if (Stat.second.second)
+        SortedBytes.emplace_back(&Stat.first, Stat.second);
+    llvm::sort(SortedBytes, [](const auto &A, const auto &B) {
+      return A.second.second > B.second.second;
+    });
+    if (SortedBytes.size() > NumTopMemoryEvents)
+      SortedBytes.resize(NumTopMemoryEvents);
+
+    for (const auto &Stat : SortedBytes) {
+      J.object([&] {
+        J.attribute("pid", Pid);
+        J.attribute("tid", int64_t(TotalTid));
+        J.attribute("ph", "X");
+        J.attribute("ts", 0);
+        J.attribute("dur", 0);
+        J.attribute("name", "Top memory " + Stat.first->first);
+        J.attributeObject("args", [&] {
+          if (!Stat.first->second.empty())
+            J.attribute("detail", Stat.first->second);
+          J.attribute("count", int64_t(Stat.second.first));
+          J.attribute("bytes", int64_t(Stat.second.second));
+        });
+      });
+    }
+
     auto writeMetadataEvent = [&](const char *Name, uint64_t Tid,
                                   StringRef arg) {
       J.object([&] {
@@ -272,6 +348,12 @@ struct llvm::TimeTraceProfiler {
   SmallVector<TimeTraceProfilerEntry, 16> Stack;
   SmallVector<TimeTraceProfilerEntry, 128> Entries;
   StringMap<CountAndDurationType> CountAndTotalPerName;
+  // Number of entries and the bytes they allocated, not counting the ones
+  // nested in them, by name and detail.
+  std::map<std::pair<std::string, std::string>, CountAndBytesType>
+      CountAndBytesPerDetail;
+  std::function<uint64_t()> MemoryCounter;
+  unsigned CounterGeneration = 0;
   // System clock time when the session was begun.
   const time_point<system_clock> BeginningOfTime;
   // Profiling clock time when the session was begun.
@@ -357,3 +439,11 @@ void llvm::timeTraceProfilerEnd() {
   if (TimeTraceProfilerInstance != nullptr)
     TimeTraceProfilerInstance->end();
 }
+
+void llvm::timeTraceProfilerSetMemoryCounter(
+    std::function<uint64_t()> Counter) {
+  if (TimeTraceProfilerInstance != nullptr) {
+    TimeTraceProfilerInstance->MemoryCounter = std::move(Counter);
+    ++TimeTraceProfilerInstance->CounterGeneration;
+  }
+}
@@ -65,6 +65,17 @@ struct CreateTrackSpace {
   }
 };
 static ManagedStatic<cl::opt<bool>, CreateTrackSpace> TrackSpace;
+struct CreateWallClockOnly {
+  static void *call() {
+    return new cl::opt<bool>(
+        "timer-wall-clock-only",
+        cl::desc("Only record wall clock time in timers, reading a monotonic "
+                 "clock instead of making a system call at every timer start "
+                 "and stop"),
+        cl::Hidden);
+  }
+};
+static ManagedStatic<cl::opt<bool>, CreateWallClockOnly> WallClockOnly;
 struct CreateInfoOutputFilename {
   static void *call() {
     return new cl::opt<std::string, true>(
@@ -89,6 +100,7 @@ ManagedStatic<cl::opt<bool>, CreateSortTimers> SortTimers;
 
 void llvm::initTimerOptions() {
   *TrackSpace;
+  *WallClockOnly;
   *InfoOutputFilename;
   *SortTimers;
 }
@@ -168,6 +180,12 @@ static uint64_t getCurInstructionsExecuted() {
 TimeRecord TimeRecord::getCurrentTime(bool Start) {
   using Seconds = std::chrono::duration<double, std::ratio<1>>;
   TimeRecord Result;
+  if (*WallClockOnly) {
+    Result.WallTime =
+        Seconds(std::chrono::steady_clock::now().time_since_epoch()).count();
+    return Result;
+  }
+
   sys::TimePoint<> now;
   std::chrono::nanoseconds user, sys;
 
@@ -374,9 +392,15 @@ void TimerGroup::PrintQueuedTimers(raw_ostream &OS) {
   // If this is not an collection of ungrouped times, print the total time.
   // Ungrouped timers don't really make sense to add up.  We still print the
   // TOTAL line to make the percentages make sense.
-  if (this != getDefaultTimerGroup())
-    OS << format("  Total Execution Time: %5.4f seconds (%5.4f wall clock)\n",
-                 Total.getProcessTime(), Total.getWallTime());
+  if (this != getDefaultTimerGroup()) {
+    if (Total.getProcessTime())
+      OS << format(
+          "  Total Execution Time: %5.4f seconds (%5.4f wall clock)\n",
+          Total.getProcessTime(), Total.getWallTime());
+    else
+      OS << format("  Total Execution Time: %5.4f seconds (wall clock)\n",
+                   Total.getWallTime());
+  }
   OS << '\n';
 
   if (Total.getUserTime())
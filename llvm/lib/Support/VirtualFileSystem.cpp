@@ -585,6 +585,109 @@ directory_iterator OverlayFileSystem::dir_begin(const Twine &Dir,
 
 void ProxyFileSystem::anchor() {}
 
+//===-----------------------------------------------------------------------===/
+// StatCachingFileSystem implementation
+//===-----------------------------------------------------------------------===/
+
+void StatCachingFileSystem::anchor() {}
+
+Optional<llvm::ErrorOr<Status>>
+StatCachingFileSystem::lookup(StringRef AbsPath) {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  auto It = Statuses.find(AbsPath);
+  if (It == Statuses.end())
+    return None;
+  return It->second;
+}
+
+bool StatCachingFileSystem::isKnownMissing(StringRef Dir, StringRef Name) {
+  // Listings never contain these.
+  if (Dir.empty() || Name == "." || Name == "..")
+    return false;
+  std::lock_guard<std::mutex> Lock(Mutex);
+  auto It = Listings.find(Dir);
+  if (It == Listings.end() || !It->second)
+    return false;
+  return !It->second->contains(Name.lower());
+}
+
+void StatCachingFileSystem::listDirectory(StringRef Dir) {
+  if (Dir.empty())
+    return;
+  {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    if (Listings.count(Dir))
+      return;
+  }
+
+  // List the directory without holding the lock. If another thread does the
+  // same, the first result wins.
+  Optional<StringSet<>> Names;
+  std::error_code EC;
+  directory_iterator I = getUnderlyingFS().dir_begin(Dir, EC);
+  if (EC == errc::no_such_file_or_directory) {
+    // Nothing exists in a directory that does not exist.
+    Names.emplace();
+  } else if (!EC) {
+    Names.emplace();
+    for (directory_iterator E; I != E && !EC; I.increment(EC))
+      Names->insert(sys::path::filename(I->path()).lower());
+    if (EC)
+      Names = None;
+  }
+
+  std::lock_guard<std::mutex> Lock(Mutex);
+  Listings.try_emplace(Dir, std::move(Names));
+}
+
+llvm::ErrorOr<Status> StatCachingFileSystem::status(const Twine &Path) {
+  SmallString<256> AbsPath;
+  Path.toVector(AbsPath);
+  std::string Name(AbsPath.str());
+  if (std::error_code EC = makeAbsolute(AbsPath))
+    return EC;
+
+  Optional<llvm::ErrorOr<Status>> Result = lookup(AbsPath);
+  if (!Result) {
+    StringRef Dir = sys::path::parent_path(AbsPath);
+    if (isKnownMissing(Dir, sys::path::filename(AbsPath))) {
+      Result = std::make_error_code(std::errc::no_such_file_or_directory);
+    } else {
+      Result = getUnderlyingFS().status(AbsPath);
+      if (Result->getError() == errc::no_such_file_or_directory)
+        listDirectory(Dir);
+    }
+    std::lock_guard<std::mutex> Lock(Mutex);
+    Statuses.try_emplace(AbsPath, *Result);
+  }
+
+  if (!*Result)
+    return Result->getError();
+  // Report the path the way it was requested, like the other file systems.
+  return Status::copyWithNewName(**Result, Name);
+}
+
+llvm::ErrorOr<std::unique_ptr<File>>
+StatCachingFileSystem::openFileForRead(const Twine &Path) {
+  SmallString<256> AbsPath;
+  Path.toVector(AbsPath);
+  if (!makeAbsolute(AbsPath)) {
+    if (Optional<llvm::ErrorOr<Status>> Cached = lookup(AbsPath))
+      if (!*Cached)
+        return Cached->getError();
+    if (isKnownMissing(sys::path::parent_path(AbsPath),
+                       sys::path::filename(AbsPath)))
+      return std::make_error_code(std::errc::no_such_file_or_directory);
+  }
+  return getUnderlyingFS().openFileForRead(Path);
+}
+
+void StatCachingFileSystem::printImpl(raw_ostream &OS, PrintType Type,
+                                      unsigned IndentLevel) const {
+  printIndent(OS, IndentLevel);
+  OS << "StatCachingFileSystem\n";
+}
+
 namespace llvm {
 namespace vfs {
 
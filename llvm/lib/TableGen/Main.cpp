@@ -16,6 +16,8 @@
 
 #include "llvm/TableGen/Main.h"
 #include "TGParser.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
@@ -57,6 +59,12 @@ static cl::opt<bool> NoWarnOnUnusedTemplateArgs(
     "no-warn-on-unused-template-args",
     cl::desc("Disable unused template argument warnings."));
 
+static cl::list<std::string>
+    ExtraOutputs("extra-output",
+                 cl::desc("Also run <action> on the parsed records and write "
+                          "its output to <file>"),
+                 cl::value_desc("action=file"));
+
 static int reportError(const char *ProgName, Twine Msg) {
   errs() << ProgName << ": " << Msg;
   errs().flush();
@@ -85,7 +93,42 @@ static int createDependencyFile(const TGParser &Parser, const char *argv0) {
   return 0;
 }
 
-int llvm::TableGenMain(const char *argv0, TableGenMainFn *MainFn) {
+/// Write Contents to Filename, or leave the file alone if -write-if-changed
+/// is given and it already has these contents.
+static int writeOutput(const char *argv0, StringRef Filename,
+                       StringRef Contents) {
+  if (WriteIfChanged) {
+    // Only updates the real output file if there are any differences.
+    // This prevents recompilation of all the files depending on it if there
+    // aren't any.
+    if (auto ExistingOrErr = MemoryBuffer::getFile(Filename, /*IsText=*/true))
+      if (std::move(ExistingOrErr.get())->getBuffer() == Contents)
+        return 0;
+  }
+  std::error_code EC;
+  ToolOutputFile OutFile(Filename, EC, sys::fs::OF_Text);
+  if (EC)
+    return reportError(argv0, "error opening " + Filename + ": " +
+                                  EC.message() + "\n");
+  OutFile.os() << Contents;
+  if (ErrorsPrinted == 0)
+    OutFile.keep();
+  return 0;
+}
+
+int llvm::TableGenMain(const char *argv0, TableGenMainFn *MainFn,
+                       TableGenActionFn *ActionFn) {
+  if (!ExtraOutputs.empty() && !ActionFn)
+    return reportError(argv0, "-extra-output is not supported by this tool\n");
+  SmallVector<std::pair<StringRef, StringRef>, 4> ExtraActions;
+  for (StringRef ExtraOutput : ExtraOutputs) {
+    auto [Action, Filename] = ExtraOutput.split('=');
+    if (Action.empty() || Filename.empty() || Filename == "-")
+      return reportError(argv0, "-extra-output expects <action>=<file>, got '" +
+                                    ExtraOutput + "'\n");
+    ExtraActions.emplace_back(Action.ltrim('-'), Filename);
+  }
+
   RecordKeeper Records;
 
   if (TimePhases)
@@ -120,6 +163,14 @@ int llvm::TableGenMain(const char *argv0, TableGenMainFn *MainFn) {
   std::string OutString;
   raw_string_ostream Out(OutString);
   unsigned status = MainFn(Out, Records);
+  // The backends share the records, and the results of the queries on them
+  // cached by the RecordKeeper. They are run one after the other since the
+  // uniqued Inits they create are not protected against concurrent access.
+  SmallVector<std::string, 4> ExtraOutStrings(ExtraActions.size());
+  for (size_t I = 0, E = ExtraActions.size(); I != E && !status; ++I) {
+    raw_string_ostream ExtraOut(ExtraOutStrings[I]);
+    status = ActionFn(ExtraActions[I].first, ExtraOut, Records);
+  }
   Records.stopBackendTimer();
   if (status)
     return 1;
@@ -134,27 +185,12 @@ int llvm::TableGenMain(const char *argv0, TableGenMainFn *MainFn) {
   }
 
   Records.startTimer("Write output");
-  bool WriteFile = true;
-  if (WriteIfChanged) {
-    // Only updates the real output file if there are any differences.
-    // This prevents recompilation of all the files depending on it if there
-    // aren't any.
-    if (auto ExistingOrErr =
-            MemoryBuffer::getFile(OutputFilename, /*IsText=*/true))
-      if (std::move(ExistingOrErr.get())->getBuffer() == Out.str())
-        WriteFile = false;
-  }
-  if (WriteFile) {
-    std::error_code EC;
-    ToolOutputFile OutFile(OutputFilename, EC, sys::fs::OF_Text);
-    if (EC)
-      return reportError(argv0, "error opening " + OutputFilename + ": " +
-                                    EC.message() + "\n");
-    OutFile.os() << Out.str();
-    if (ErrorsPrinted == 0)
-      OutFile.keep();
-  }
-  
+  if (int Ret = writeOutput(argv0, OutputFilename, Out.str()))
+    return Ret;
+  for (size_t I = 0, E = ExtraActions.size(); I != E; ++I)
+    if (int Ret = writeOutput(argv0, ExtraActions[I].second,
+                              ExtraOutStrings[I]))
+      return Ret;
   Records.stopTimer();
   Records.stopPhaseTiming();
 
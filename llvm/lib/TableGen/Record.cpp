@@ -2905,17 +2905,31 @@ void RecordKeeper::stopBackendTimer() {
 
 std::vector<Record *>
 RecordKeeper::getAllDerivedDefinitions(StringRef ClassName) const {
-  // We cache the record vectors for single classes. Many backends request
-  // the same vectors multiple times.
+  // We cache the record vectors. Many backends request the same vectors
+  // multiple times, and several backends may run on the same records.
   auto Pair = ClassRecordsMap.try_emplace(ClassName);
   if (Pair.second)
-    Pair.first->second = getAllDerivedDefinitions(makeArrayRef(ClassName));
+    Pair.first->second = computeAllDerivedDefinitions(makeArrayRef(ClassName));
 
   return Pair.first->second;
 }
 
 std::vector<Record *> RecordKeeper::getAllDerivedDefinitions(
     ArrayRef<StringRef> ClassNames) const {
+  if (ClassNames.size() == 1)
+    return getAllDerivedDefinitions(ClassNames.front());
+
+  // Class names cannot contain commas, so the key cannot clash with the one
+  // of a single class.
+  auto Pair = ClassRecordsMap.try_emplace(join(ClassNames, ","));
+  if (Pair.second)
+    Pair.first->second = computeAllDerivedDefinitions(ClassNames);
+
+  return Pair.first->second;
+}
+
+std::vector<Record *> RecordKeeper::computeAllDerivedDefinitions(
+    ArrayRef<StringRef> ClassNames) const {
   SmallVector<Record *, 2> ClassRecs;
   std::vector<Record *> Defs;
 
@@ -49,18 +49,28 @@
 //===----------------------------------------------------------------------===//
 
 #include "X86TargetTransformInfo.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/ScalarEvolution.h"
 #include "llvm/Analysis/TargetTransformInfo.h"
+#include "llvm/Analysis/VectorUtils.h"
 #include "llvm/CodeGen/BasicTTIImpl.h"
 #include "llvm/CodeGen/CostTable.h"
 #include "llvm/CodeGen/TargetLowering.h"
 #include "llvm/IR/InstIterator.h"
 #include "llvm/IR/IntrinsicInst.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 
 using namespace llvm;
 
 #define DEBUG_TYPE "x86tti"
 
+static cl::opt<unsigned> TailFoldingTripCountThreshold(
+    "x86-tail-folding-trip-count-threshold", cl::init(64), cl::Hidden,
+    cl::desc("Prefer folding the tail of vectorized loops by masking on "
+             "AVX-512 targets when the loop runs at most this many "
+             "iterations (0 disables)"));
+
 //===----------------------------------------------------------------------===//
 //
 // X86 cost model.
@@ -6151,6 +6161,57 @@ bool X86TTIImpl::enableInterleavedAccessVectorization() {
   return !(ST->isAtom());
 }
 
+bool X86TTIImpl::preferPredicateOverEpilogue(
+    Loop *L, LoopInfo *LI, ScalarEvolution &SE, AssumptionCache &AC,
+    TargetLibraryInfo *TLI, DominatorTree *DT, LoopVectorizationLegality *LVL,
+    InterleavedAccessInfo *IAI) {
+  // Masked tails are only cheap with AVX-512 mask registers; with AVX2 every
+  // masked access needs a vector mask and integer compares.
+  if (!TailFoldingTripCountThreshold || !ST->hasAVX512())
+    return false;
+
+  // Interleave groups are not masked on X86, so they would have to be
+  // scalarized in a tail-folded loop.
+  if (IAI->hasGroups())
+    return false;
+
+  // Loops with a large or unknown trip count spend little time in the
+  // remainder, which is better served by a (vectorized) scalar epilogue.
+  unsigned TC = SE.getSmallConstantTripCount(L);
+  if (!TC)
+    TC = SE.getSmallConstantMaxTripCount(L);
+  if (!TC || TC > TailFoldingTripCountThreshold) {
+    LLVM_DEBUG(dbgs() << "X86TTI: not folding the tail of a loop with "
+                      << (TC ? "a large" : "an unknown") << " trip count\n");
+    return false;
+  }
+
+  // Every memory access has to become a legal masked load or store at the
+  // widest vector the vectorizer may pick for its element type.
+  unsigned VecWidth = ST->getPreferVectorWidth();
+  for (BasicBlock *BB : L->blocks()) {
+    for (Instruction &I : *BB) {
+      if (!isa<LoadInst>(I) && !isa<StoreInst>(I))
+        continue;
+      Type *Ty = getLoadStoreType(&I);
+      if (!Ty->isIntegerTy() && !Ty->isFloatingPointTy())
+        return false;
+      unsigned EltBits = DL.getTypeSizeInBits(Ty);
+      if (EltBits > VecWidth)
+        return false;
+      auto *VecTy = FixedVectorType::get(Ty, VecWidth / EltBits);
+      Align Alignment = getLoadStoreAlignment(&I);
+      if (isa<LoadInst>(I) ? !isLegalMaskedLoad(VecTy, Alignment)
+                           : !isLegalMaskedStore(VecTy, Alignment))
+        return false;
+    }
+  }
+
+  LLVM_DEBUG(dbgs() << "X86TTI: preferring a masked tail for a loop with at "
+                    << "most " << TC << " iterations\n");
+  return true;
+}
+
 // Get estimation for interleaved load/store operations and strided load.
 // \p Indices contains indices for strided load.
 // \p Factor - the factor of interleaving.
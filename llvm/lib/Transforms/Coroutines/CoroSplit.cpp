@@ -31,6 +31,7 @@
 #include "llvm/Analysis/CallGraph.h"
 #include "llvm/Analysis/ConstantFolding.h"
 #include "llvm/Analysis/LazyCallGraph.h"
+#include "llvm/Analysis/OptimizationRemarkEmitter.h"
 #include "llvm/Analysis/TargetTransformInfo.h"
 #include "llvm/BinaryFormat/Dwarf.h"
 #include "llvm/IR/Argument.h"
@@ -2146,6 +2147,19 @@ PreservedAnalyses CoroSplitPass::run(LazyCallGraph::SCC &C,
         F, Clones, FAM.getResult<TargetIRAnalysis>(F), OptimizeFrame);
     updateCallGraphAfterCoroutineSplit(*N, Shape, Clones, C, CG, AM, UR, FAM);
 
+    if (Shape.CoroBegin) {
+      OptimizationRemarkEmitter ORE(&F);
+      ORE.emit([&]() {
+        return OptimizationRemarkAnalysis(DEBUG_TYPE, "CoroFrameSize", &F)
+               << "coroutine frame of '" << ore::NV("Coroutine", F.getName())
+               << "' is " << ore::NV("FrameSize", Shape.FrameSize)
+               << " bytes with alignment "
+               << ore::NV("FrameAlign", Shape.FrameAlign.value()) << " and "
+               << ore::NV("NumFields", Shape.FrameTy->getNumElements())
+               << " fields";
+      });
+    }
+
     if (!Shape.CoroSuspends.empty()) {
       // Run the CGSCC pipeline on the original and newly split functions.
       UR.CWorklist.insert(&C);
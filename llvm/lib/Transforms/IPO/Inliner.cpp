@@ -29,6 +29,7 @@
 #include "llvm/Analysis/BlockFrequencyInfo.h"
 #include "llvm/Analysis/CGSCCPassManager.h"
 #include "llvm/Analysis/CallGraph.h"
+#include "llvm/Analysis/EphemeralValuesCache.h"
 #include "llvm/Analysis/InlineAdvisor.h"
 #include "llvm/Analysis/InlineCost.h"
 #include "llvm/Analysis/LazyCallGraph.h"
@@ -921,6 +922,12 @@ PreservedAnalyses InlinerPass::run(LazyCallGraph::SCC &InitialC,
         Advice->recordUnsuccessfulInlining(IR);
         continue;
       }
+      // The caller's analyses are only invalidated once all of its calls have
+      // been visited, but its ephemeral values may be queried before that if
+      // it is reachable from one of the remaining calls.
+      if (auto *EphValuesCache =
+              FAM.getCachedResult<EphemeralValuesAnalysis>(F))
+        EphValuesCache->clear();
 
       DidInline = true;
       InlinedCallees.insert(&Callee);
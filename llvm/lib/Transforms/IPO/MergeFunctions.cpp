@@ -117,6 +117,7 @@
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/IPO.h"
 #include "llvm/Transforms/Utils/FunctionComparator.h"
@@ -179,6 +180,8 @@ public:
   // Note the hash is recalculated potentially multiple times, but it is cheap.
   FunctionNode(Function *F)
     : F(F), Hash(FunctionComparator::functionHash(*F))  {}
+  FunctionNode(Function *F, FunctionComparator::FunctionHash Hash)
+      : F(F), Hash(Hash) {}
 
   Function *getFunc() const { return F; }
   FunctionComparator::FunctionHash getHash() const { return Hash; }
@@ -293,6 +296,11 @@ private:
   // dangling iterators into FnTree. The invariant that preserves this is that
   // there is exactly one mapping F -> FN for each FunctionNode FN in FnTree.
   DenseMap<AssertingVH<Function>, FnTreeType::iterator> FNodesInTree;
+
+  /// Hashes computed up front for the functions of the first worklist. An
+  /// entry is consumed by the first insert() of its function, later inserts
+  /// rehash the possibly modified function.
+  DenseMap<Function *, FunctionComparator::FunctionHash> PrecomputedHashes;
 };
 
 class MergeFunctionsLegacyPass : public ModulePass {
@@ -417,14 +425,18 @@ bool MergeFunctions::runOnModule(Module &M) {
   Used.insert(UsedV.begin(), UsedV.end());
 
   // All functions in the module, ordered by hash. Functions with a unique
-  // hash value are easily eliminated.
+  // hash value are easily eliminated. Hashing only reads the IR of each
+  // function, so it is done in parallel.
   std::vector<std::pair<FunctionComparator::FunctionHash, Function *>>
     HashedFuncs;
   for (Function &Func : M) {
     if (isEligibleForMerging(Func)) {
-      HashedFuncs.push_back({FunctionComparator::functionHash(Func), &Func});
+      HashedFuncs.push_back({0, &Func});
     }
   }
+  parallelForEach(HashedFuncs, [](auto &HF) {
+    HF.first = FunctionComparator::functionHash(*HF.second);
+  });
 
   llvm::stable_sort(HashedFuncs, less_first());
 
@@ -435,6 +447,7 @@ bool MergeFunctions::runOnModule(Module &M) {
     if ((I != S && std::prev(I)->first == I->first) ||
         (std::next(I) != IE && std::next(I)->first == I->first) ) {
       Deferred.push_back(WeakTrackingVH(I->second));
+      PrecomputedHashes.insert({I->second, I->first});
     }
   }
 
@@ -461,6 +474,7 @@ bool MergeFunctions::runOnModule(Module &M) {
 
   FnTree.clear();
   FNodesInTree.clear();
+  PrecomputedHashes.clear();
   GlobalNumbers.clear();
   Used.clear();
 
@@ -909,8 +923,13 @@ static bool isFuncOrderCorrect(const Function *F, const Function *G) {
 // Insert a ComparableFunction into the FnTree, or merge it away if equal to one
 // that was already inserted.
 bool MergeFunctions::insert(Function *NewFunction) {
-  std::pair<FnTreeType::iterator, bool> Result =
-      FnTree.insert(FunctionNode(NewFunction));
+  auto HashIt = PrecomputedHashes.find(NewFunction);
+  bool HasHash = HashIt != PrecomputedHashes.end();
+  FunctionNode NewNode = HasHash ? FunctionNode(NewFunction, HashIt->second)
+                                 : FunctionNode(NewFunction);
+  if (HasHash)
+    PrecomputedHashes.erase(HashIt);
+  std::pair<FnTreeType::iterator, bool> Result = FnTree.insert(NewNode);
 
   if (Result.second) {
     assert(FNodesInTree.count(NewFunction) == 0);
@@ -941,6 +960,7 @@ bool MergeFunctions::insert(Function *NewFunction) {
 // Remove a function from FnTree. If it was already in FnTree, add
 // it to Deferred so that we'll look at it in the next round.
 void MergeFunctions::remove(Function *F) {
+  PrecomputedHashes.erase(F);
   auto I = FNodesInTree.find(F);
   if (I != FNodesInTree.end()) {
     LLVM_DEBUG(dbgs() << "Deferred " << F->getName() << ".\n");
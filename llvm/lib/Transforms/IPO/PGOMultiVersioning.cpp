@@ -0,0 +1,362 @@
+//===- PGOMultiVersioning.cpp - Clone hot functions for ISA levels --------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Binaries that are shipped to machines of several x86-64 generations are
+// usually built for the oldest one, which leaves the wider vector units of the
+// newer ones unused. This pass picks the functions whose innermost loops are
+// hot in the profile and look vectorizable, clones them once per requested ISA
+// level with that level's features enabled, and replaces the original symbol
+// by an IFUNC whose resolver picks the widest clone the CPU supports, the same
+// way Clang lowers target_clones. It runs before the vectorizers so that the
+// clones are vectorized for their level.
+//
+// The total size of the clones is capped relative to the size of the module,
+// and the hottest functions are served first.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Transforms/IPO/PGOMultiVersioning.h"
+#include "llvm/ADT/Optional.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/ADT/StringSet.h"
+#include "llvm/ADT/Triple.h"
+#include "llvm/Analysis/BlockFrequencyInfo.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/OptimizationRemarkEmitter.h"
+#include "llvm/Analysis/ProfileSummaryInfo.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/GlobalIFunc.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/X86TargetParser.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+#include <algorithm>
+
+using namespace llvm;
+
+#define DEBUG_TYPE "pgo-multiversion"
+
+STATISTIC(NumMultiVersioned, "Number of functions multiversioned");
+STATISTIC(NumClones, "Number of ISA level clones created");
+
+static cl::list<std::string> MultiVersionLevels(
+    "pgo-multiversion-levels", cl::CommaSeparated, cl::Hidden,
+    cl::desc("The x86-64 ISA levels to clone hot functions for, "
+             "defaults to x86-64-v3,x86-64-v4"));
+
+static cl::opt<unsigned> MultiVersionMaxGrowth(
+    "pgo-multiversion-max-growth", cl::init(5), cl::Hidden,
+    cl::desc("Maximum size of the clones, in percent of the instructions of "
+             "the module"));
+
+namespace {
+
+/// An ISA level that clones can be made for.
+struct ISALevel {
+  std::string CPU;
+  /// All the features of the level.
+  SmallVector<StringRef, 32> Features;
+  /// The bits of the features that can be checked at run time.
+  uint64_t SupportsMask = 0;
+};
+
+/// A function selected for multiversioning.
+struct Candidate {
+  Function *F;
+  uint64_t HotLoopCount;
+  /// Indices in the level list of the levels to clone the function for.
+  SmallVector<unsigned, 4> Levels;
+};
+
+} // end anonymous namespace
+
+/// Returns the features that the compatibility structure filled in by
+/// __cpu_indicator_init reports.
+static const StringSet<> &getCheckableFeatures() {
+  static const StringSet<> Features = {
+#define X86_FEATURE_COMPAT(ENUM, STR, PRIORITY) STR,
+#include "llvm/Support/X86TargetParser.def"
+  };
+  return Features;
+}
+
+/// Parses the requested levels, widest first, so that the resolver can return
+/// the first one the CPU supports.
+static SmallVector<ISALevel, 4> getLevels() {
+  SmallVector<std::string, 4> Names(MultiVersionLevels.begin(),
+                                    MultiVersionLevels.end());
+  if (Names.empty())
+    Names = {"x86-64-v3", "x86-64-v4"};
+
+  SmallVector<ISALevel, 4> Levels;
+  for (const std::string &Name : Names) {
+    X86::CPUKind Kind = X86::parseArchX86(Name, /*Only64Bit=*/true);
+    if (Kind == X86::CK_None) {
+      LLVM_DEBUG(dbgs() << "PGOMV: ignoring unknown level " << Name << "\n");
+      continue;
+    }
+    ISALevel Level;
+    Level.CPU = Name;
+    X86::getFeaturesForCPU(Level.CPU, Level.Features);
+    SmallVector<StringRef, 32> Checkable;
+    for (StringRef Feature : Level.Features)
+      if (getCheckableFeatures().contains(Feature))
+        Checkable.push_back(Feature);
+    Level.SupportsMask = X86::getCpuSupportsMask(Checkable);
+    Levels.push_back(std::move(Level));
+  }
+  llvm::stable_sort(Levels, [](const ISALevel &A, const ISALevel &B) {
+    return A.Features.size() > B.Features.size();
+  });
+  return Levels;
+}
+
+/// Returns the features that F is already compiled with.
+static StringSet<> getEnabledFeatures(const Function &F) {
+  StringSet<> Enabled;
+  StringRef CPU = F.getFnAttribute("target-cpu").getValueAsString();
+  if (!CPU.empty() && X86::parseArchX86(CPU) != X86::CK_None) {
+    SmallVector<StringRef, 32> Features;
+    X86::getFeaturesForCPU(CPU, Features);
+    Enabled.insert(Features.begin(), Features.end());
+  }
+  SmallVector<StringRef, 32> Features;
+  F.getFnAttribute("target-features")
+      .getValueAsString()
+      .split(Features, ',', -1, /*KeepEmpty=*/false);
+  for (StringRef Feature : Features) {
+    if (Feature.consume_front("+"))
+      Enabled.insert(Feature);
+    else if (Feature.consume_front("-"))
+      Enabled.erase(Feature);
+  }
+  return Enabled;
+}
+
+/// Returns whether L looks like a candidate for vectorization: an innermost
+/// loop that accesses memory and makes no calls but to intrinsics.
+static bool isVectorizableLoop(const Loop &L) {
+  if (!L.isInnermost())
+    return false;
+  bool AccessesMemory = false;
+  for (const BasicBlock *BB : L.blocks()) {
+    for (const Instruction &I : *BB) {
+      if (isa<CallBase>(I) && !isa<IntrinsicInst>(I))
+        return false;
+      if (isa<LoadInst>(I) || isa<StoreInst>(I))
+        AccessesMemory = true;
+    }
+  }
+  return AccessesMemory;
+}
+
+/// Returns whether F can be replaced by an IFUNC at all.
+static bool
+canMultiVersion(const Function &F,
+                const SmallPtrSetImpl<const Function *> &Resolvers) {
+  if (F.isDeclaration() || F.isInterposable() || F.hasComdat() ||
+      F.hasAvailableExternallyLinkage() || F.isVarArg() || !F.hasName())
+    return false;
+  if (F.hasOptNone() || F.hasOptSize() || F.hasFnAttribute(Attribute::Naked))
+    return false;
+  if (Resolvers.count(&F))
+    return false;
+  for (const User *U : F.users()) {
+    // Blocks cannot be addressed through an IFUNC, and the functions that an
+    // existing resolver returns are already multiversioned.
+    if (isa<BlockAddress>(U))
+      return false;
+    if (const auto *I = dyn_cast<Instruction>(U))
+      if (Resolvers.count(I->getFunction()))
+        return false;
+  }
+  return true;
+}
+
+/// Emits the check that the CPU has all the features in Mask, reading the
+/// structures filled in by __cpu_indicator_init, as Clang does for
+/// __builtin_cpu_supports.
+static Value *emitCpuSupports(IRBuilder<> &B, Module &M, uint64_t Mask) {
+  Type *Int32Ty = B.getInt32Ty();
+  Value *Result = B.getTrue();
+  auto CheckBits = [&](Value *Features, uint32_t Bits) {
+    Value *BitMask = B.getInt32(Bits);
+    Value *Cmp = B.CreateICmpEQ(B.CreateAnd(Features, BitMask), BitMask);
+    Result = B.CreateAnd(Result, Cmp);
+  };
+
+  if (uint32_t Features1 = Lo_32(Mask)) {
+    // { __cpu_vendor, __cpu_type, __cpu_subtype, __cpu_features[1] }
+    StructType *STy = StructType::get(Int32Ty, Int32Ty, Int32Ty,
+                                      ArrayType::get(Int32Ty, 1));
+    auto *CpuModel =
+        cast<GlobalValue>(M.getOrInsertGlobal("__cpu_model", STy));
+    CpuModel->setDSOLocal(true);
+    Value *Idxs[] = {B.getInt32(0), B.getInt32(3), B.getInt32(0)};
+    Value *Features =
+        B.CreateAlignedLoad(Int32Ty, B.CreateGEP(STy, CpuModel, Idxs),
+                            Align(4));
+    CheckBits(Features, Features1);
+  }
+
+  if (uint32_t Features2 = Hi_32(Mask)) {
+    auto *CpuFeatures2 =
+        cast<GlobalValue>(M.getOrInsertGlobal("__cpu_features2", Int32Ty));
+    CpuFeatures2->setDSOLocal(true);
+    Value *Features = B.CreateAlignedLoad(Int32Ty, CpuFeatures2, Align(4));
+    CheckBits(Features, Features2);
+  }
+
+  return Result;
+}
+
+/// Clones C.F for its levels and turns its symbol into an IFUNC that selects
+/// between the clones and the original function.
+static void multiVersion(Module &M, const Candidate &C,
+                         ArrayRef<ISALevel> Levels) {
+  Function &F = *C.F;
+  std::string Name = F.getName().str();
+
+  SmallVector<std::pair<const ISALevel *, Function *>, 4> Clones;
+  for (unsigned Index : C.Levels) {
+    const ISALevel &Level = Levels[Index];
+    ValueToValueMapTy VMap;
+    Function *Clone = CloneFunction(&F, VMap);
+    Clone->setName(Name + "." + Level.CPU);
+    Clone->setLinkage(GlobalValue::InternalLinkage);
+    Clone->addFnAttr("target-cpu", Level.CPU);
+    std::string Features =
+        F.getFnAttribute("target-features").getValueAsString().str();
+    for (StringRef Feature : Level.Features)
+      Features += (Features.empty() ? "+" : ",+") + Feature.str();
+    Clone->addFnAttr("target-features", Features);
+    Clones.emplace_back(&Level, Clone);
+    ++NumClones;
+  }
+
+  // The IFUNC takes over the name, linkage and users of the function, which
+  // becomes the default version.
+  LLVMContext &Ctx = M.getContext();
+  Function *Resolver = Function::Create(
+      GlobalIFunc::getResolverFunctionType(F.getValueType()),
+      GlobalValue::InternalLinkage, Name + ".resolver", &M);
+  Resolver->addFnAttr(Attribute::NoUnwind);
+  GlobalIFunc *IFunc =
+      GlobalIFunc::create(F.getValueType(), F.getAddressSpace(),
+                          F.getLinkage(), "", Resolver, &M);
+  IFunc->takeName(&F);
+  IFunc->setVisibility(F.getVisibility());
+  F.replaceAllUsesWith(IFunc);
+  F.setName(Name + ".default");
+  F.setLinkage(GlobalValue::InternalLinkage);
+
+  BasicBlock *Entry = BasicBlock::Create(Ctx, "resolver_entry", Resolver);
+  IRBuilder<> B(Entry);
+  FunctionCallee CpuInit =
+      M.getOrInsertFunction("__cpu_indicator_init", B.getVoidTy());
+  cast<GlobalValue>(CpuInit.getCallee())->setDSOLocal(true);
+  B.CreateCall(CpuInit);
+  for (auto [Level, Clone] : Clones) {
+    Value *Supported = emitCpuSupports(B, M, Level->SupportsMask);
+    BasicBlock *Return = BasicBlock::Create(Ctx, "resolver_return", Resolver);
+    BasicBlock *Else = BasicBlock::Create(Ctx, "resolver_else", Resolver);
+    B.CreateCondBr(Supported, Return, Else);
+    IRBuilder<>(Return).CreateRet(Clone);
+    B.SetInsertPoint(Else);
+  }
+  B.CreateRet(&F);
+  ++NumMultiVersioned;
+}
+
+PreservedAnalyses PGOMultiVersioningPass::run(Module &M,
+                                              ModuleAnalysisManager &AM) {
+  Triple TT(M.getTargetTriple());
+  if (!TT.isX86() || !TT.isOSBinFormatELF())
+    return PreservedAnalyses::all();
+  ProfileSummaryInfo &PSI = AM.getResult<ProfileSummaryAnalysis>(M);
+  if (!PSI.hasProfileSummary())
+    return PreservedAnalyses::all();
+  SmallVector<ISALevel, 4> Levels = getLevels();
+  if (Levels.empty())
+    return PreservedAnalyses::all();
+
+  SmallPtrSet<const Function *, 8> Resolvers;
+  for (const GlobalIFunc &IFunc : M.ifuncs())
+    if (const Function *Resolver = IFunc.getResolverFunction())
+      Resolvers.insert(Resolver);
+
+  auto &FAM = AM.getResult<FunctionAnalysisManagerModuleProxy>(M).getManager();
+  uint64_t ModuleSize = 0;
+  SmallVector<Candidate, 16> Candidates;
+  for (Function &F : M) {
+    if (F.isDeclaration())
+      continue;
+    ModuleSize += F.getInstructionCount();
+    if (!canMultiVersion(F, Resolvers))
+      continue;
+
+    Candidate C{&F, 0, {}};
+    StringSet<> Enabled = getEnabledFeatures(F);
+    for (unsigned I = 0, E = Levels.size(); I != E; ++I)
+      if (!llvm::all_of(Levels[I].Features,
+                        [&](StringRef Feat) { return Enabled.count(Feat); }))
+        C.Levels.push_back(I);
+    if (C.Levels.empty())
+      continue;
+
+    auto &LI = FAM.getResult<LoopAnalysis>(F);
+    if (LI.empty())
+      continue;
+    auto &BFI = FAM.getResult<BlockFrequencyAnalysis>(F);
+    for (const Loop *L : LI.getLoopsInPreorder()) {
+      if (!isVectorizableLoop(*L))
+        continue;
+      Optional<uint64_t> Count = BFI.getBlockProfileCount(L->getHeader());
+      if (Count && PSI.isHotCount(*Count))
+        C.HotLoopCount = std::max(C.HotLoopCount, *Count);
+    }
+    if (C.HotLoopCount)
+      Candidates.push_back(std::move(C));
+  }
+
+  llvm::stable_sort(Candidates, [](const Candidate &A, const Candidate &B) {
+    return A.HotLoopCount > B.HotLoopCount;
+  });
+
+  uint64_t Budget = ModuleSize * MultiVersionMaxGrowth / 100;
+  bool Changed = false;
+  for (const Candidate &C : Candidates) {
+    uint64_t Cost = uint64_t(C.F->getInstructionCount()) * C.Levels.size();
+    if (Cost > Budget) {
+      LLVM_DEBUG(dbgs() << "PGOMV: " << C.F->getName()
+                        << " does not fit in the size budget\n");
+      continue;
+    }
+    Budget -= Cost;
+
+    OptimizationRemarkEmitter &ORE =
+        FAM.getResult<OptimizationRemarkEmitterAnalysis>(*C.F);
+    ORE.emit([&]() {
+      return OptimizationRemark(DEBUG_TYPE, "MultiVersioned", C.F)
+             << "multiversioned hot function "
+             << ore::NV("Function", C.F) << " for "
+             << ore::NV("NumLevels", unsigned(C.Levels.size()))
+             << " ISA levels";
+    });
+    multiVersion(M, C, Levels);
+    Changed = true;
+  }
+
+  return Changed ? PreservedAnalyses::none() : PreservedAnalyses::all();
+}
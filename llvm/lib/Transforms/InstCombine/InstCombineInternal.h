@@ -78,6 +78,12 @@ public:
   /// \returns true if the IR is changed.
   bool run();
 
+  /// The number of instructions that run() constant folded or combined.
+  unsigned NumChangedInsts = 0;
+
+  /// If set, run() counts the instructions it combines here, by opcode.
+  DenseMap<unsigned, unsigned> *CombinedOpcodes = nullptr;
+
   // Visitation implementation - Implement instruction combining for different
   // instruction types.  The semantics are as follows:
   // Return Value:
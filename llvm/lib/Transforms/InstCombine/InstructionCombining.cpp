@@ -103,6 +103,7 @@
 #include "llvm/Transforms/Utils/Local.h"
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -116,6 +117,11 @@ using namespace llvm::PatternMatch;
 
 STATISTIC(NumWorklistIterations,
           "Number of instruction combining iterations performed");
+STATISTIC(MaxFunctionIterations,
+          "Maximum number of instruction combining iterations on a function");
+STATISTIC(NumConverged,
+          "Number of functions where combining stopped below the "
+          "convergence threshold");
 
 STATISTIC(NumCombined , "Number of insts combined");
 STATISTIC(NumConstProp, "Number of constant folds");
@@ -148,6 +154,12 @@ static cl::opt<unsigned> LimitMaxIterations(
     cl::desc("Limit the maximum number of instruction combining iterations"),
     cl::init(InstCombineDefaultMaxIterations));
 
+static cl::opt<unsigned> ConvergenceThreshold(
+    "instcombine-convergence-threshold",
+    cl::desc("Stop iterating once an iteration of instruction combining "
+             "folds or combines fewer than this many instructions"),
+    cl::init(0));
+
 static cl::opt<unsigned> InfiniteLoopDetectionThreshold(
     "instcombine-infinite-loop-threshold",
     cl::desc("Number of instruction combining iterations considered an "
@@ -4230,6 +4242,7 @@ bool InstCombinerImpl::run() {
         // Add operands to the worklist.
         replaceInstUsesWith(*I, C);
         ++NumConstProp;
+        ++NumChangedInsts;
         if (isInstructionTriviallyDead(I, &TLI))
           eraseInstFromFunction(*I);
         MadeIRChange = true;
@@ -4337,6 +4350,9 @@ bool InstCombinerImpl::run() {
 
     if (Instruction *Result = visit(*I)) {
       ++NumCombined;
+      ++NumChangedInsts;
+      if (CombinedOpcodes)
+        ++(*CombinedOpcodes)[I->getOpcode()];
       // Should we replace the old instruction with a new one?
       if (Result != I) {
         LLVM_DEBUG(dbgs() << "IC: Old = " << *I << '\n'
@@ -4602,8 +4618,16 @@ static bool combineInstructionsOverFunction(
       RemoveRedundantDbgInstrs(&BB);
   }
 
+  // When remarks are requested, record what each iteration did so that
+  // functions that take many iterations to converge can be found.
+  bool RecordIterations = ORE.allowExtraAnalysis(DEBUG_TYPE);
+  SmallVector<std::pair<unsigned, DenseMap<unsigned, unsigned>>, 4>
+      IterationChanges;
+  auto StartTime = std::chrono::steady_clock::now();
+
   // Iterate while there is work to do.
   unsigned Iteration = 0;
+  bool Converged = false;
   while (true) {
     ++NumWorklistIterations;
     ++Iteration;
@@ -4629,11 +4653,56 @@ static bool combineInstructionsOverFunction(
     InstCombinerImpl IC(Worklist, Builder, F.hasMinSize(), AA, AC, TLI, TTI, DT,
                         ORE, BFI, PSI, DL, LI);
     IC.MaxArraySizeForCombine = MaxArraySize;
+    if (RecordIterations) {
+      IterationChanges.emplace_back();
+      IC.CombinedOpcodes = &IterationChanges.back().second;
+    }
 
-    if (!IC.run())
+    bool Changed = IC.run();
+    if (RecordIterations)
+      IterationChanges.back().first = IC.NumChangedInsts;
+    if (!Changed)
       break;
 
     MadeIRChange = true;
+
+    // The remaining changes are not worth another walk over the function.
+    if (IC.NumChangedInsts < ConvergenceThreshold) {
+      LLVM_DEBUG(dbgs() << "\n\n[IC] Iteration #" << Iteration << " on "
+                        << F.getName() << " changed " << IC.NumChangedInsts
+                        << " instructions; stopping below the convergence "
+                           "threshold\n");
+      ++NumConverged;
+      Converged = true;
+      break;
+    }
+  }
+  MaxFunctionIterations.updateMax(Iteration);
+
+  if (RecordIterations) {
+    auto Elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - StartTime);
+    ORE.emit([&]() {
+      using namespace ore;
+      OptimizationRemarkAnalysis R(DEBUG_TYPE, "Iterations", &F);
+      R << "combined in " << NV("Iterations", Iteration) << " iterations and "
+        << NV("TimeUs", uint64_t(Elapsed.count())) << " us";
+      if (Converged)
+        R << ", stopped below the convergence threshold";
+      for (unsigned I = 0, E = IterationChanges.size(); I != E; ++I) {
+        const auto &[NumChanged, Opcodes] = IterationChanges[I];
+        R << "; iteration " << NV("Iteration", I + 1) << ": "
+          << NV("Changed", NumChanged) << " changed";
+        // Name the combines that fired, in a stable order.
+        SmallVector<std::pair<unsigned, unsigned>, 8> Sorted(Opcodes.begin(),
+                                                             Opcodes.end());
+        llvm::sort(Sorted);
+        for (const auto &[Opcode, Count] : Sorted)
+          R << ", " << NV("Opcode", Instruction::getOpcodeName(Opcode))
+            << " x" << NV("Count", Count);
+      }
+      return R;
+    });
   }
 
   return MadeIRChange;
@@ -44,6 +44,7 @@
 #include "llvm/IR/DebugInfoMetadata.h"
 #include "llvm/IR/DebugLoc.h"
 #include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/Dominators.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/GlobalAlias.h"
 #include "llvm/IR/GlobalValue.h"
@@ -376,6 +377,12 @@ static cl::opt<bool> ClOptSameTemp(
     "asan-opt-same-temp", cl::desc("Instrument the same temp just once"),
     cl::Hidden, cl::init(true));
 
+static cl::opt<bool> ClOptDominatedChecks(
+    "asan-opt-dominated-checks",
+    cl::desc("Don't instrument accesses whose check is dominated by the check "
+             "of an access to the same address in a function without calls"),
+    cl::Hidden, cl::init(false));
+
 static cl::opt<bool> ClOptGlobals("asan-opt-globals",
                                   cl::desc("Don't instrument scalar globals"),
                                   cl::Hidden, cl::init(true));
@@ -449,6 +456,8 @@ STATISTIC(NumOptimizedAccessesToGlobalVar,
           "Number of optimized accesses to global vars");
 STATISTIC(NumOptimizedAccessesToStackVar,
           "Number of optimized accesses to stack vars");
+STATISTIC(NumOptimizedDominatedAccesses,
+          "Number of optimized accesses dominated by an identical check");
 
 namespace {
 
@@ -716,6 +725,9 @@ private:
 
   bool LooksLikeCodeInBug11395(Instruction *I);
   bool GlobalIsLinkerInitialized(GlobalVariable *G);
+  void
+  removeDominatedChecks(Function &F,
+                        SmallVectorImpl<InterestingMemoryOperand> &Operands);
   bool isSafeAccess(ObjectSizeOffsetVisitor &ObjSizeVis, Value *Addr,
                     uint64_t TypeSize) const;
 
@@ -2736,6 +2748,9 @@ bool AddressSanitizer::instrumentFunction(Function &F,
     }
   }
 
+  if (ClOpt && ClOptDominatedChecks)
+    removeDominatedChecks(F, OperandsToInstrument);
+
   bool UseCalls = (ClInstrumentationWithCallsThreshold >= 0 &&
                    OperandsToInstrument.size() + IntrinToInstrument.size() >
                        (unsigned)ClInstrumentationWithCallsThreshold);
@@ -2782,6 +2797,60 @@ bool AddressSanitizer::instrumentFunction(Function &F,
   return FunctionModified;
 }
 
+// Removes the operands whose check is implied by the check of another operand.
+// Within a basic block this is done by ClOptSameTemp; here an access is
+// dropped when an access of at least the same size to the same address
+// dominates it. Only a call (free, a lifetime marker, a callback of another
+// tool, ...) can poison the shadow between the two accesses, so this is only
+// done in functions without calls, which covers most hot loops.
+void AddressSanitizer::removeDominatedChecks(
+    Function &F, SmallVectorImpl<InterestingMemoryOperand> &Operands) {
+  if (Operands.size() < 2)
+    return;
+  for (auto &BB : F)
+    for (auto &Inst : BB)
+      if (isa<CallBase>(Inst) && !isa<DbgInfoIntrinsic>(Inst))
+        return;
+
+  DenseMap<Value *, SmallVector<unsigned, 4>> OperandsByPtr;
+  for (unsigned I = 0, E = Operands.size(); I != E; ++I)
+    OperandsByPtr[Operands[I].getPtr()].push_back(I);
+
+  DominatorTree DT(F);
+  SmallVector<bool, 16> IsDominated(Operands.size());
+  for (auto &KV : OperandsByPtr) {
+    ArrayRef<unsigned> Indices = KV.second;
+    if (Indices.size() < 2)
+      continue;
+    for (unsigned I : Indices) {
+      InterestingMemoryOperand &O = Operands[I];
+      for (unsigned J : Indices) {
+        InterestingMemoryOperand &Dom = Operands[J];
+        // Dominance is a strict order, so the dominated operands can be
+        // removed independently: every chain ends at an instrumented one.
+        if (Dom.MaybeMask || Dom.TypeSize < O.TypeSize ||
+            Dom.getInsn() == O.getInsn() ||
+            !DT.dominates(Dom.getInsn(), O.getInsn()))
+          continue;
+        IsDominated[I] = true;
+        break;
+      }
+    }
+  }
+
+  unsigned Kept = 0;
+  for (unsigned I = 0, E = Operands.size(); I != E; ++I) {
+    if (IsDominated[I]) {
+      NumOptimizedDominatedAccesses++;
+      continue;
+    }
+    if (Kept != I)
+      Operands[Kept] = Operands[I];
+    Kept++;
+  }
+  Operands.truncate(Kept);
+}
+
 // Workaround for bug 11395: we don't want to instrument stack in functions
 // with large assembly blobs (32-bit only), otherwise reg alloc may crash.
 // FIXME: remove once the bug 11395 is fixed.
@@ -15,6 +15,7 @@
 #include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/Triple.h"
@@ -59,6 +60,8 @@ using namespace llvm;
 
 #define DEBUG_TYPE "hwasan"
 
+STATISTIC(NumCoalescedChecks, "Number of memory access checks coalesced");
+
 const char kHwasanModuleCtorName[] = "hwasan.module_ctor";
 const char kHwasanNoteName[] = "hwasan.note";
 const char kHwasanInitName[] = "__hwasan_init";
@@ -229,6 +232,12 @@ static cl::opt<bool> ClInlineAllChecks("hwasan-inline-all-checks",
                                        cl::desc("inline all checks"),
                                        cl::Hidden, cl::init(false));
 
+static cl::opt<bool> ClCoalesceChecks(
+    "hwasan-coalesce-checks",
+    cl::desc("skip checks of bytes already checked earlier in the same basic "
+             "block"),
+    cl::Hidden, cl::init(false));
+
 // Enabled from clang by "-fsanitize-hwaddress-experimental-aliasing".
 static cl::opt<bool> ClUsePageAliases("hwasan-experimental-use-page-aliases",
                                       cl::desc("Use page aliasing in HWASan"),
@@ -263,6 +272,38 @@ bool shouldDetectUseAfterScope(const Triple &TargetTriple) {
   return ClUseAfterScope && shouldInstrumentStack(TargetTriple);
 }
 
+/// Tracks the bytes checked so far in a basic block, so that accesses to the
+/// same bytes later in the block need no check of their own. Memory tags only
+/// change across calls, so the caller resets the state at every call.
+class CheckCoalescer {
+public:
+  CheckCoalescer(const DataLayout &DL) : DL(DL) {}
+
+  /// Returns true if all bytes accessed by O were checked before. Otherwise
+  /// records them as checked and returns false.
+  bool isCovered(InterestingMemoryOperand &O) {
+    if (O.MaybeMask || O.TypeSize % 8 != 0)
+      return false;
+    int64_t Offset;
+    const Value *Base =
+        GetPointerBaseWithConstantOffset(O.getPtr(), Offset, DL);
+    int64_t End = Offset + O.TypeSize / 8;
+    auto &Ranges = Checked[Base];
+    for (const auto &R : Ranges)
+      if (R.first <= Offset && End <= R.second)
+        return true;
+    Ranges.emplace_back(Offset, End);
+    return false;
+  }
+
+  void reset() { Checked.clear(); }
+
+private:
+  const DataLayout &DL;
+  SmallDenseMap<const Value *, SmallVector<std::pair<int64_t, int64_t>, 2>>
+      Checked;
+};
+
 /// An instrumentation pass implementing detection of addressability bugs
 /// using tagged pointers.
 class HWAddressSanitizer {
@@ -1404,9 +1445,11 @@ bool HWAddressSanitizer::sanitizeFunction(Function &F,
   LLVM_DEBUG(dbgs() << "Function: " << F.getName() << "\n");
 
   SmallVector<InterestingMemoryOperand, 16> OperandsToInstrument;
+  SmallVector<InterestingMemoryOperand, 16> CoalescedOperands;
   SmallVector<MemIntrinsic *, 16> IntrinToInstrument;
   SmallVector<Instruction *, 8> LandingPadVec;
 
+  CheckCoalescer Coalescer(F.getParent()->getDataLayout());
   memtag::StackInfoBuilder SIB(SSI);
   for (auto &Inst : instructions(F)) {
     if (InstrumentStack) {
@@ -1416,8 +1459,26 @@ bool HWAddressSanitizer::sanitizeFunction(Function &F,
     if (InstrumentLandingPads && isa<LandingPadInst>(Inst))
       LandingPadVec.push_back(&Inst);
 
+    size_t NumOperands = OperandsToInstrument.size();
     getInterestingMemoryOperands(&Inst, OperandsToInstrument);
 
+    if (ClCoalesceChecks) {
+      if (!Inst.getPrevNode())
+        Coalescer.reset();
+      for (size_t I = NumOperands; I < OperandsToInstrument.size();) {
+        if (Coalescer.isCovered(OperandsToInstrument[I])) {
+          CoalescedOperands.push_back(OperandsToInstrument[I]);
+          OperandsToInstrument.erase(OperandsToInstrument.begin() + I);
+          ++NumCoalescedChecks;
+        } else {
+          ++I;
+        }
+      }
+      // The callee may free or retag memory.
+      if (isa<CallBase>(Inst) && !isa<DbgInfoIntrinsic>(Inst))
+        Coalescer.reset();
+    }
+
     if (MemIntrinsic *MI = dyn_cast<MemIntrinsic>(&Inst))
       if (!ignoreMemIntrinsic(MI))
         IntrinToInstrument.push_back(MI);
@@ -1441,7 +1502,7 @@ bool HWAddressSanitizer::sanitizeFunction(Function &F,
   }
 
   if (SInfo.AllocasToInstrument.empty() && OperandsToInstrument.empty() &&
-      IntrinToInstrument.empty())
+      CoalescedOperands.empty() && IntrinToInstrument.empty())
     return Changed;
 
   assert(!ShadowBase);
@@ -1478,6 +1539,11 @@ bool HWAddressSanitizer::sanitizeFunction(Function &F,
   for (auto &Operand : OperandsToInstrument)
     instrumentMemAccess(Operand);
 
+  // Accesses whose check was coalesced with an earlier one still need an
+  // untagged pointer on targets without top byte ignore.
+  for (auto &Operand : CoalescedOperands)
+    untagPointerOperand(Operand.getInsn(), Operand.getPtr());
+
   if (ClInstrumentMemIntrinsics && !IntrinToInstrument.empty()) {
     for (auto *Inst : IntrinToInstrument)
       instrumentMemIntrinsic(Inst);
@@ -37,6 +37,7 @@
 #include "llvm/IR/Instruction.h"
 #include "llvm/IR/Instructions.h"
 #include "llvm/IR/IntrinsicInst.h"
+#include "llvm/IR/MDBuilder.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Type.h"
 #include "llvm/InitializePasses.h"
@@ -47,6 +48,7 @@
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Transforms/Utils/BasicBlockUtils.h"
 #include "llvm/Transforms/Utils/ModuleUtils.h"
 #include "llvm/Transforms/Utils/SSAUpdater.h"
 #include <algorithm>
@@ -97,6 +99,13 @@ cl::opt<bool> AtomicCounterUpdateAll(
     cl::desc("Make all profile counter updates atomic (for testing only)"),
     cl::init(false));
 
+cl::opt<unsigned> SamplingPeriod(
+    "instrprof-sampling-period",
+    cl::desc("Only update the profile counters once every N executions of "
+             "their increment, adding N times the step (0 or 1: update them "
+             "every time)"),
+    cl::init(0));
+
 cl::opt<bool> AtomicCounterUpdatePromoted(
     "atomic-counter-update-promoted",
     cl::desc("Do counter update using atomic fetch add "
@@ -434,6 +443,8 @@ bool InstrProfiling::lowerIntrinsics(Function *F) {
   if (!MadeChange)
     return false;
 
+  // Splitting the blocks had to wait until the walk over them was done.
+  guardSampledIncrements();
   promoteCounterLoadStores(F);
   return true;
 }
@@ -714,21 +725,79 @@ void InstrProfiling::lowerIncrement(InstrProfIncrementInst *Inc) {
   auto *Addr = getCounterAddress(Inc);
 
   IRBuilder<> Builder(Inc);
+  Value *IncStep = Inc->getStep();
+  // With sampling, a thread local countdown selects one execution out of
+  // SamplingPeriod, which adds SamplingPeriod times the step. This keeps the
+  // counts unbiased while most executions only touch thread local memory
+  // instead of the cache lines of the counters shared by all threads.
+  Value *Sampled = nullptr;
+  if (SamplingPeriod > 1) {
+    GlobalVariable *SamplingVar = getOrCreateSamplingVar();
+    Type *Int32Ty = Builder.getInt32Ty();
+    Value *Left = Builder.CreateLoad(Int32Ty, SamplingVar, "pgosampling");
+    Sampled = Builder.CreateICmpEQ(Left, ConstantInt::get(Int32Ty, 0));
+    Value *Dec = Builder.CreateSub(Left, ConstantInt::get(Int32Ty, 1));
+    Builder.CreateStore(
+        Builder.CreateSelect(
+            Sampled, ConstantInt::get(Int32Ty, SamplingPeriod - 1), Dec),
+        SamplingVar);
+    IncStep = Builder.CreateMul(
+        IncStep, ConstantInt::get(IncStep->getType(), SamplingPeriod));
+  }
+
+  Instruction *First, *Last;
   if (Options.Atomic || AtomicCounterUpdateAll ||
       (Inc->getIndex()->isZeroValue() && AtomicFirstCounter)) {
-    Builder.CreateAtomicRMW(AtomicRMWInst::Add, Addr, Inc->getStep(),
-                            MaybeAlign(), AtomicOrdering::Monotonic);
+    First = Last =
+        Builder.CreateAtomicRMW(AtomicRMWInst::Add, Addr, IncStep,
+                                MaybeAlign(), AtomicOrdering::Monotonic);
   } else {
-    Value *IncStep = Inc->getStep();
-    Value *Load = Builder.CreateLoad(IncStep->getType(), Addr, "pgocount");
-    auto *Count = Builder.CreateAdd(Load, Inc->getStep());
+    auto *Load = Builder.CreateLoad(IncStep->getType(), Addr, "pgocount");
+    auto *Count = Builder.CreateAdd(Load, IncStep);
     auto *Store = Builder.CreateStore(Count, Addr);
-    if (isCounterPromotionEnabled())
-      PromotionCandidates.emplace_back(cast<Instruction>(Load), Store);
+    // A sampled update is not executed on every path through the loop, so it
+    // can't be promoted.
+    if (isCounterPromotionEnabled() && !Sampled)
+      PromotionCandidates.emplace_back(Load, Store);
+    First = Load;
+    Last = Store;
   }
+  if (Sampled)
+    SampledIncrements.push_back({Sampled, First, Last});
   Inc->eraseFromParent();
 }
 
+void InstrProfiling::guardSampledIncrements() {
+  MDBuilder MDB(M->getContext());
+  for (auto &SI : SampledIncrements) {
+    Instruction *Term = SplitBlockAndInsertIfThen(
+        SI.Sampled, SI.First, /*Unreachable=*/false,
+        MDB.createBranchWeights(1, SamplingPeriod - 1));
+    for (Instruction *I = SI.First, *Next;; I = Next) {
+      Next = I->getNextNode();
+      I->moveBefore(Term);
+      if (I == SI.Last)
+        break;
+    }
+  }
+  SampledIncrements.clear();
+}
+
+GlobalVariable *InstrProfiling::getOrCreateSamplingVar() {
+  const StringRef VarName = "__llvm_profile_sampling";
+  if (auto *GV = M->getNamedGlobal(VarName))
+    return GV;
+  Type *Int32Ty = Type::getInt32Ty(M->getContext());
+  auto *GV = new GlobalVariable(
+      *M, Int32Ty, /*isConstant=*/false, GlobalValue::LinkOnceODRLinkage,
+      ConstantInt::get(Int32Ty, 0), VarName, /*InsertBefore=*/nullptr,
+      GlobalValue::GeneralDynamicTLSModel);
+  GV->setVisibility(GlobalValue::HiddenVisibility);
+  if (TT.supportsCOMDAT())
+    GV->setComdat(M->getOrInsertComdat(VarName));
+  return GV;
+}
+
 void InstrProfiling::lowerCoverageData(GlobalVariable *CoverageNamesVar) {
   ConstantArray *Names =
       cast<ConstantArray>(CoverageNamesVar->getInitializer());
@@ -2122,6 +2122,21 @@ static bool annotateAllFunctions(
   bool InstrumentFuncEntry = PGOReader->instrEntryBBEnabled();
   if (PGOInstrumentEntry.getNumOccurrences() > 0)
     InstrumentFuncEntry = PGOInstrumentEntry;
+
+  // Read the records of the whole module in one sweep over the profile rather
+  // than one random access per function. Functions whose name changes while
+  // they are instrumented (renamed comdats) are still looked up on their own,
+  // as are all functions if prefetching fails; errors surface from there.
+  if (PGOReader->isIRLevelProfile()) {
+    std::vector<std::string> FuncNames;
+    for (auto &F : M)
+      if (!skipPGO(F))
+        FuncNames.push_back(getPGOFuncName(F));
+    SmallVector<StringRef, 0> FuncNameRefs(FuncNames.begin(), FuncNames.end());
+    if (Error E = PGOReader->prefetchRecords(FuncNameRefs))
+      consumeError(std::move(E));
+  }
+
   for (auto &F : M) {
     if (skipPGO(F))
       continue;
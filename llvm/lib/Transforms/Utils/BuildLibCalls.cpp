@@ -1927,3 +1927,15 @@ Value *llvm::emitCalloc(Value *Num, Value *Size, IRBuilderBase &B,
 
   return CI;
 }
+
+Value *llvm::emitHotColdNew(ArrayRef<Value *> Args, IRBuilderBase &B,
+                            const TargetLibraryInfo *TLI, LibFunc NewFunc,
+                            uint8_t HotCold) {
+  SmallVector<Type *, 4> ParamTypes;
+  SmallVector<Value *, 4> Operands(Args.begin(), Args.end());
+  for (Value *Arg : Args)
+    ParamTypes.push_back(Arg->getType());
+  ParamTypes.push_back(B.getInt8Ty());
+  Operands.push_back(B.getInt8(HotCold));
+  return emitLibCall(NewFunc, B.getInt8PtrTy(), ParamTypes, Operands, B, TLI);
+}
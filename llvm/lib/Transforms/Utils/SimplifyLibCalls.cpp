@@ -44,6 +44,22 @@ static cl::opt<bool>
                          cl::desc("Enable unsafe double to float "
                                   "shrinking for math lib calls"));
 
+// Enable conversion of operator new calls with a MemProf hot or cold hint
+// to an operator new call that takes a hot/cold hint. Off by default since
+// not all allocators currently support this extension.
+static cl::opt<bool>
+    OptimizeHotColdNew("optimize-hot-cold-new", cl::Hidden, cl::init(false),
+                       cl::desc("Enable hot/cold operator new library calls"));
+
+// Values to pass for the hot/cold hint. The hint is an 8-bit value where a
+// lower value means colder.
+static cl::opt<unsigned> ColdNewHintValue(
+    "cold-new-hint-value", cl::Hidden, cl::init(1),
+    cl::desc("Value to pass to hot/cold operator new for cold allocation"));
+static cl::opt<unsigned> NotColdNewHintValue(
+    "notcold-new-hint-value", cl::Hidden, cl::init(128),
+    cl::desc("Value to pass to hot/cold operator new for notcold allocation"));
+
 //===----------------------------------------------------------------------===//
 // Helper Functions
 //===----------------------------------------------------------------------===//
@@ -1651,6 +1667,59 @@ Value *LibCallSimplifier::optimizeRealloc(CallInst *CI, IRBuilderBase &B) {
   return nullptr;
 }
 
+// When enabled, replace operator new() calls marked with a hot or cold memprof
+// attribute with an operator new() call that takes a __hot_cold_t parameter.
+// Currently this is supported by the open source version of tcmalloc, see:
+// https://github.com/google/tcmalloc/blob/master/tcmalloc/new_extension.h
+Value *LibCallSimplifier::optimizeNew(CallInst *CI, IRBuilderBase &B,
+                                      LibFunc &Func) {
+  if (!OptimizeHotColdNew)
+    return nullptr;
+
+  uint8_t HotCold;
+  StringRef AllocType =
+      CI->getAttributes().getFnAttr("memprof").getValueAsString();
+  if (AllocType == "cold")
+    HotCold = ColdNewHintValue;
+  else if (AllocType == "notcold")
+    HotCold = NotColdNewHintValue;
+  else
+    return nullptr;
+
+  LibFunc NewFunc;
+  switch (Func) {
+  case LibFunc_Znwm:
+    NewFunc = LibFunc_Znwm12__hot_cold_t;
+    break;
+  case LibFunc_Znam:
+    NewFunc = LibFunc_Znam12__hot_cold_t;
+    break;
+  case LibFunc_ZnwmRKSt9nothrow_t:
+    NewFunc = LibFunc_ZnwmRKSt9nothrow_t12__hot_cold_t;
+    break;
+  case LibFunc_ZnamRKSt9nothrow_t:
+    NewFunc = LibFunc_ZnamRKSt9nothrow_t12__hot_cold_t;
+    break;
+  case LibFunc_ZnwmSt11align_val_t:
+    NewFunc = LibFunc_ZnwmSt11align_val_t12__hot_cold_t;
+    break;
+  case LibFunc_ZnamSt11align_val_t:
+    NewFunc = LibFunc_ZnamSt11align_val_t12__hot_cold_t;
+    break;
+  case LibFunc_ZnwmSt11align_val_tRKSt9nothrow_t:
+    NewFunc = LibFunc_ZnwmSt11align_val_tRKSt9nothrow_t12__hot_cold_t;
+    break;
+  case LibFunc_ZnamSt11align_val_tRKSt9nothrow_t:
+    NewFunc = LibFunc_ZnamSt11align_val_tRKSt9nothrow_t12__hot_cold_t;
+    break;
+  default:
+    return nullptr;
+  }
+
+  SmallVector<Value *, 3> Args(CI->args());
+  return copyFlags(*CI, emitHotColdNew(Args, B, TLI, NewFunc, HotCold));
+}
+
 //===----------------------------------------------------------------------===//
 // Math Library Optimizations
 //===----------------------------------------------------------------------===//
@@ -3686,6 +3755,15 @@ Value *LibCallSimplifier::optimizeCall(CallInst *CI, IRBuilderBase &Builder) {
     case LibFunc_vfprintf:
     case LibFunc_fiprintf:
       return optimizeErrorReporting(CI, Builder, 0);
+    case LibFunc_Znwm:
+    case LibFunc_ZnwmRKSt9nothrow_t:
+    case LibFunc_ZnwmSt11align_val_t:
+    case LibFunc_ZnwmSt11align_val_tRKSt9nothrow_t:
+    case LibFunc_Znam:
+    case LibFunc_ZnamRKSt9nothrow_t:
+    case LibFunc_ZnamSt11align_val_t:
+    case LibFunc_ZnamSt11align_val_tRKSt9nothrow_t:
+      return optimizeNew(CI, Builder, Func);
     default:
       return nullptr;
     }
@@ -7459,6 +7459,26 @@ LoopVectorizationPlanner::planInVPlanNativePath(ElementCount UserVF) {
                           << "overriding computed VF.\n");
         VF = ElementCount::getFixed(4);
       }
+
+      // A VF larger than a known trip count of the outer loop would leave
+      // all of the work to the scalar epilogue. Clamp it to the trip count.
+      unsigned TC = PSE.getSE()->getSmallConstantTripCount(OrigLoop);
+      if (!VPlanBuildStressTest && TC && TC < VF.getFixedValue()) {
+        VF = ElementCount::getFixed(PowerOf2Floor(TC));
+        LLVM_DEBUG(dbgs() << "LV: Clamped VF to " << VF
+                          << " to fit the outer loop trip count " << TC
+                          << ".\n");
+      }
+
+      // The target may have no vector registers wide enough for the widest
+      // type in the loop nest, or the trip count may be too small.
+      if (VF.getKnownMinValue() < 2) {
+        reportVectorizationInfo(
+            "the computed vectorization factor for the outer loop is less "
+            "than two",
+            "OuterLoopVFTooSmall", ORE, OrigLoop);
+        return VectorizationFactor::Disabled();
+      }
     }
     assert(EnableVPlanNativePath && "VPlan-native path is not enabled.");
     assert(isPowerOf2_32(VF.getKnownMinValue()) &&
@@ -10498,6 +10518,20 @@ bool LoopVectorizePass::processLoop(Loop *L) {
         if (!LB.areSafetyChecksAdded())
           DisableRuntimeUnroll = true;
       }
+      // Report how the iterations left over by the vector loop are handled.
+      ORE->emit([&]() {
+        OptimizationRemarkAnalysis R(LV_NAME, "TailStrategy", L->getStartLoc(),
+                                     L->getHeader());
+        if (CM.foldTailByMasking())
+          R << "tail folded by masking, no scalar epilogue needed";
+        else if (EpilogueVF.Width.isVector())
+          R << "remainder vectorized in an epilogue loop (vectorization "
+               "width: "
+            << NV("EpilogueVectorizationFactor", EpilogueVF.Width) << ")";
+        else
+          R << "remainder executed by a scalar epilogue";
+        return R;
+      });
       // Report the vectorization decision.
       ORE->emit([&]() {
         return OptimizationRemark(LV_NAME, "Vectorized", L->getStartLoc(),
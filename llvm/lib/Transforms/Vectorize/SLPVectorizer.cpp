@@ -134,6 +134,12 @@ static cl::opt<unsigned>
 MaxVFOption("slp-max-vf", cl::init(0), cl::Hidden,
     cl::desc("Maximum SLP vectorization factor (0=unlimited)"));
 
+static cl::opt<bool> VectorizeNonPowerOf2(
+    "slp-vectorize-non-power-of-2", cl::init(false), cl::Hidden,
+    cl::desc("Try to vectorize store chains whose length is one less than a "
+             "power of 2 (e.g. 3 or 7 elements) with non-power-of-2 vector "
+             "types."));
+
 static cl::opt<int>
 MaxStoreLookup("slp-max-store-lookup", cl::init(32), cl::Hidden,
     cl::desc("Maximum depth of the lookup for consecutive stores."));
@@ -2525,6 +2531,16 @@ private:
     /// Some of the instructions in the list have alternate opcodes.
     bool isAltShuffle() const { return MainOp != AltOp; }
 
+    /// Return true if this is a non-power-of-2 node. Such nodes are only
+    /// built with -slp-vectorize-non-power-of-2 and are not reordered,
+    /// reshuffled or matched against other nodes yet.
+    bool isNonPowOf2Vec() const {
+      bool IsNonPowerOf2 = !isPowerOf2_32(Scalars.size());
+      assert((!IsNonPowerOf2 || ReuseShuffleIndices.empty()) &&
+             "Reshuffling scalars not yet supported for nodes with padding");
+      return IsNonPowerOf2;
+    }
+
     bool isOpcodeOrAlt(Instruction *I) const {
       unsigned CheckedOpcode = I->getOpcode();
       return (getOpcode() == CheckedOpcode ||
@@ -3721,7 +3737,9 @@ static LoadsState canVectorizeLoads(ArrayRef<Value *> VL, const Value *VL0,
         CommonAlignment =
             std::min(CommonAlignment, cast<LoadInst>(V)->getAlign());
       auto *VecTy = FixedVectorType::get(ScalarTy, VL.size());
-      if (TTI.isLegalMaskedGather(VecTy, CommonAlignment) &&
+      // Masked gathers of non-power-of-2 vectors are not supported yet.
+      if (isPowerOf2_32(VL.size()) &&
+          TTI.isLegalMaskedGather(VecTy, CommonAlignment) &&
           !TTI.forceScalarizeMaskedGather(VecTy, CommonAlignment))
         return LoadsState::ScatterVectorize;
     }
@@ -3864,6 +3882,10 @@ static bool areTwoInsertFromSameBuildVector(
 
 Optional<BoUpSLP::OrdersType> BoUpSLP::getReorderingData(const TreeEntry &TE,
                                                          bool TopToBottom) {
+  // Non-power-of-2 nodes are kept in their original order.
+  if (TE.isNonPowOf2Vec())
+    return None;
+
   // No need to reorder if need to shuffle reuses, still need to shuffle the
   // node.
   if (!TE.ReuseShuffleIndices.empty()) {
@@ -4952,6 +4974,12 @@ void BoUpSLP::buildTree_rec(ArrayRef<Value *> VL, unsigned Depth,
       ReuseShuffleIndicies.clear();
     } else {
       LLVM_DEBUG(dbgs() << "SLP: Shuffle for reused scalars.\n");
+      if (!isPowerOf2_32(VL.size())) {
+        LLVM_DEBUG(dbgs() << "SLP: Reshuffling scalars not yet supported "
+                          << "for nodes with padding.\n");
+        newTreeEntry(VL, None /*not vectorized*/, S, UserTreeIdx);
+        return false;
+      }
       if (NumUniqueScalarValues <= 1 ||
           (UniquePositions.size() == 1 && all_of(UniqueValues,
                                                  [](Value *V) {
@@ -7659,6 +7687,9 @@ BoUpSLP::isGatherShuffledEntry(const TreeEntry *TE, SmallVectorImpl<int> &Mask,
   // reused elements too for better cost estimation.
   Mask.assign(TE->Scalars.size(), UndefMaskElem);
   Entries.clear();
+  // No need to check for the topmost gather node and non-power-of-2 nodes.
+  if (TE->isNonPowOf2Vec())
+    return None;
   // Build a lists of values to tree entries.
   DenseMap<Value *, SmallPtrSet<const TreeEntry *, 4>> ValueToTEs;
   for (const std::unique_ptr<TreeEntry> &EntryPtr : VectorizableTree) {
@@ -10665,7 +10696,11 @@ bool SLPVectorizerPass::vectorizeStoreChain(ArrayRef<Value *> Chain, BoUpSLP &R,
   const unsigned Sz = R.getVectorElementSize(Chain[0]);
   unsigned VF = Chain.size();
 
-  if (!isPowerOf2_32(Sz) || !isPowerOf2_32(VF) || VF < 2 || VF < MinVF)
+  if (!isPowerOf2_32(Sz) || VF < 2 || VF < MinVF)
+    return false;
+  // Non-power-of-2 chains are padded to the next power of 2 by the target,
+  // so only accept those wasting a single lane.
+  if (!isPowerOf2_32(VF) && (!VectorizeNonPowerOf2 || !isPowerOf2_32(VF + 1)))
     return false;
 
   LLVM_DEBUG(dbgs() << "SLP: Analyzing " << VF << " stores at offset " << Idx
@@ -10819,7 +10854,15 @@ bool SLPVectorizerPass::vectorizeStores(ArrayRef<StoreInst *> Stores,
     // FIXME: Is division-by-2 the correct step? Should we assert that the
     // register size is a power-of-2?
     unsigned StartIdx = 0;
-    for (unsigned Size = MaxVF; Size >= MinVF; Size /= 2) {
+    SmallVector<unsigned> CandidateVFs;
+    // Try the whole chain first if it is one short of a power of 2, e.g. the
+    // three components of an xyz or rgb triple.
+    if (VectorizeNonPowerOf2 && Operands.size() + 1 <= MaxVF &&
+        !isPowerOf2_32(Operands.size()) && isPowerOf2_32(Operands.size() + 1))
+      CandidateVFs.push_back(Operands.size());
+    for (unsigned Size = MaxVF; Size >= MinVF; Size /= 2)
+      CandidateVFs.push_back(Size);
+    for (unsigned Size : CandidateVFs) {
       for (unsigned Cnt = StartIdx, E = Operands.size(); Cnt + Size <= E;) {
         ArrayRef<Value *> Slice = makeArrayRef(Operands).slice(Cnt, Size);
         if (!VectorizedStores.count(Slice.front()) &&
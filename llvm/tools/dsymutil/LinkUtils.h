@@ -52,6 +52,9 @@ struct LinkOptions {
   /// Number of threads.
   unsigned Threads = 1;
 
+  /// Maximum number of object files analyzed ahead of cloning (0 = no limit).
+  unsigned MaxInFlightObjects = 0;
+
   // Output file type.
   OutputFileType FileType = OutputFileType::Object;
 
@@ -358,6 +358,9 @@ static Expected<DsymutilOptions> getOptions(opt::InputArgList &Args) {
   if (Options.DumpDebugMap || Options.LinkOpts.Verbose)
     Options.LinkOpts.Threads = 1;
 
+  if (opt::Arg *MaxInFlight = Args.getLastArg(OPT_max_in_flight_objects))
+    Options.LinkOpts.MaxInFlightObjects = atoi(MaxInFlight->getValue());
+
   if (getenv("RC_DEBUG_OPTIONS"))
     Options.PaperTrailWarnings = true;
 
@@ -192,6 +192,9 @@ namespace options {
   static std::string thinlto_object_suffix_replace;
   // Optional path to a directory for caching ThinLTO objects.
   static std::string cache_dir;
+  // Optional path to a directory of ThinLTO objects shared between machines,
+  // used behind the cache in cache_dir.
+  static std::string remote_cache_dir;
   // Optional pruning policy for ThinLTO caches.
   static std::string cache_policy;
   // Additional options to pass into the code generator.
@@ -264,6 +267,8 @@ namespace options {
                 "thinlto-object-suffix-replace expects 'old;new' format");
     } else if (opt.consume_front("cache-dir=")) {
       cache_dir = std::string(opt);
+    } else if (opt.consume_front("remote-cache-dir=")) {
+      remote_cache_dir = std::string(opt);
     } else if (opt.consume_front("cache-policy=")) {
       cache_policy = std::string(opt);
     } else if (opt.size() == 2 && opt[0] == 'O') {
@@ -871,6 +876,9 @@ static void getThinLTOOldAndNewPrefix(std::string &OldPrefix,
   NewPrefix = std::string(Split.second);
 }
 
+/// The store shared between machines behind the ThinLTO cache, if any.
+static std::shared_ptr<RemoteCacheStore> RemoteCache;
+
 /// Creates instance of LTO.
 /// OnIndexWrite is callback to let caller know when LTO writes index files.
 /// LinkedObjectsFile is an output stream to write the list of object files for
@@ -974,6 +982,10 @@ static std::unique_ptr<LTO> createLTO(IndexWriteCallback OnIndexWrite,
   Conf.OpaquePointers = options::opaque_pointers;
 
   Conf.StatsFile = options::stats_file;
+  if (!options::cache_dir.empty() && !options::remote_cache_dir.empty()) {
+    RemoteCache = directoryCacheStore(options::remote_cache_dir);
+    Conf.CachePrefetchHook = [](StringRef Key) { RemoteCache->prefetch(Key); };
+  }
   return std::make_unique<LTO>(std::move(Conf), Backend,
                                 options::ParallelCodeGenParallelismLevel);
 }
@@ -1106,8 +1118,12 @@ static std::vector<std::pair<SmallString<128>, bool>> runLTO() {
   FileCache Cache;
   if (!options::cache_dir.empty())
     Cache = check(localCache("ThinLTO", "Thin", options::cache_dir, AddBuffer));
+  if (Cache && RemoteCache)
+    Cache = remoteCache(std::move(Cache), RemoteCache);
 
   check(Lto->run(AddStream, Cache));
+  if (RemoteCache)
+    RemoteCache->wait();
 
   // Write empty output files that may be expected by the distributed build
   // system.
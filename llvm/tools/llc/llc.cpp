@@ -22,6 +22,7 @@
 #include "llvm/CodeGen/MIRParser/MIRParser.h"
 #include "llvm/CodeGen/MachineFunctionPass.h"
 #include "llvm/CodeGen/MachineModuleInfo.h"
+#include "llvm/CodeGen/ParallelCG.h"
 #include "llvm/CodeGen/TargetPassConfig.h"
 #include "llvm/CodeGen/TargetSubtargetInfo.h"
 #include "llvm/IR/AutoUpgrade.h"
@@ -154,6 +155,12 @@ static cl::opt<bool>
                           "manager and verify the result is the same."),
                  cl::init(false));
 
+static cl::opt<unsigned> CodeGenPartitions(
+    "codegen-partitions", cl::Hidden, cl::init(1), cl::value_desc("N"),
+    cl::desc("Experimental: split the module into N partitions and generate "
+             "code for them on N threads. Partition 0 is written to the "
+             "output file and partition I to <output>.I"));
+
 static cl::opt<bool> DiscardValueNames(
     "discard-value-names",
     cl::desc("Discard names from Value (other than GlobalValue)."),
@@ -656,6 +663,54 @@ static int compileModule(char **argv, LLVMContext &Context) {
     WithColor::warning(errs(), argv[0])
         << ": warning: ignoring -mc-relax-all because filetype != obj";
 
+  if (CodeGenPartitions > 1) {
+    if (MIR || !getRunPassNames().empty() || DwoOut || CompileTwice ||
+        Out->outputFilename() == "-")
+      reportError("-codegen-partitions requires IR input and an output file, "
+                  "and cannot be used with -run-pass, -split-dwarf-output or "
+                  "-compile-twice");
+
+    // Each partition gets a module in its own LLVMContext and its own
+    // TargetMachine, and therefore its own MCContext, so the partitions share
+    // no mutable state. The partitioning only depends on the module, which
+    // keeps the output deterministic.
+    std::vector<std::unique_ptr<ToolOutputFile>> PartOuts;
+    SmallVector<raw_pwrite_stream *, 8> PartOSs = {&Out->os()};
+    sys::fs::OpenFlags OpenFlags = codegen::getFileType() == CGFT_AssemblyFile
+                                       ? sys::fs::OF_TextWithCRLF
+                                       : sys::fs::OF_None;
+    for (unsigned I = 1; I != CodeGenPartitions; ++I) {
+      std::string PartName = (Out->outputFilename() + "." + Twine(I)).str();
+      std::error_code EC;
+      PartOuts.push_back(
+          std::make_unique<ToolOutputFile>(PartName, EC, OpenFlags));
+      if (EC)
+        reportError(EC.message(), PartName);
+      PartOSs.push_back(&PartOuts.back()->os());
+    }
+
+    TargetOptions PartOptions = Target->Options;
+    CodeModel::Model PartCM = Target->getCodeModel();
+    cl::PrintOptionValues();
+    splitCodeGen(
+        *M, PartOSs, {},
+        [&]() {
+          return std::unique_ptr<TargetMachine>(TheTarget->createTargetMachine(
+              TheTriple.getTriple(), CPUStr, FeaturesStr, PartOptions, RM,
+              PartCM, OLvl));
+        },
+        codegen::getFileType());
+
+    auto HasError =
+        ((const LLCDiagnosticHandler *)(Context.getDiagHandlerPtr()))->HasError;
+    if (*HasError)
+      return 1;
+    Out->keep();
+    for (auto &PartOut : PartOuts)
+      PartOut->keep();
+    return 0;
+  }
+
   {
     raw_pwrite_stream *OS = &Out->os();
 
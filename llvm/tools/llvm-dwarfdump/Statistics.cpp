@@ -14,6 +14,7 @@
 #include "llvm/DebugInfo/DWARF/DWARFExpression.h"
 #include "llvm/Object/ObjectFile.h"
 #include "llvm/Support/JSON.h"
+#include "llvm/Support/ThreadPool.h"
 
 #define DEBUG_TYPE "dwarfdump"
 using namespace llvm;
@@ -112,6 +113,27 @@ struct PerFunctionStats {
   uint64_t NumLocalVarTypes = 0;
   /// Number of local variables with DW_AT_location.
   uint64_t NumLocalVarLocations = 0;
+
+  void add(const PerFunctionStats &Other) {
+    NumFnInlined += Other.NumFnInlined;
+    NumFnOutOfLine += Other.NumFnOutOfLine;
+    NumAbstractOrigins += Other.NumAbstractOrigins;
+    TotalVarWithLoc += Other.TotalVarWithLoc;
+    ConstantMembers += Other.ConstantMembers;
+    NumArtificial += Other.NumArtificial;
+    for (const auto &Var : Other.VarsInFunction)
+      VarsInFunction.insert(Var.getKey());
+    IsFunction |= Other.IsFunction;
+    HasSourceLocation |= Other.HasSourceLocation;
+    NumParams += Other.NumParams;
+    NumParamSourceLocations += Other.NumParamSourceLocations;
+    NumParamTypes += Other.NumParamTypes;
+    NumParamLocations += Other.NumParamLocations;
+    NumLocalVars += Other.NumLocalVars;
+    NumLocalVarSourceLocations += Other.NumLocalVarSourceLocations;
+    NumLocalVarTypes += Other.NumLocalVarTypes;
+    NumLocalVarLocations += Other.NumLocalVarLocations;
+  }
 };
 
 /// Holds accumulated global statistics about DIEs.
@@ -154,6 +176,26 @@ struct GlobalStats {
   /// for the top inline functions within concrete functions. This can help
   /// tune the inline settings when compiling to match user expectations.
   SaturatingUINT64 InlineFunctionSize = 0;
+
+  void add(const GlobalStats &Other) {
+    TotalBytesCovered += Other.TotalBytesCovered.Value;
+    ScopeBytesCovered += Other.ScopeBytesCovered.Value;
+    ScopeBytes += Other.ScopeBytes.Value;
+    ScopeEntryValueBytesCovered += Other.ScopeEntryValueBytesCovered.Value;
+    ParamScopeBytesCovered += Other.ParamScopeBytesCovered.Value;
+    ParamScopeBytes += Other.ParamScopeBytes.Value;
+    ParamScopeEntryValueBytesCovered +=
+        Other.ParamScopeEntryValueBytesCovered.Value;
+    LocalVarScopeBytesCovered += Other.LocalVarScopeBytesCovered.Value;
+    LocalVarScopeBytes += Other.LocalVarScopeBytes.Value;
+    LocalVarScopeEntryValueBytesCovered +=
+        Other.LocalVarScopeEntryValueBytesCovered.Value;
+    CallSiteEntries += Other.CallSiteEntries.Value;
+    CallSiteDIEs += Other.CallSiteDIEs.Value;
+    CallSiteParamDIEs += Other.CallSiteParamDIEs.Value;
+    FunctionSize += Other.FunctionSize.Value;
+    InlineFunctionSize += Other.InlineFunctionSize.Value;
+  }
 };
 
 /// Holds accumulated debug location statistics about local variables and
@@ -187,6 +229,51 @@ struct LocationStats {
   SaturatingUINT64 NumParam = 0;
   /// Total number of local variables processed.
   SaturatingUINT64 NumVar = 0;
+
+  void add(const LocationStats &Other) {
+    auto AddBuckets = [](std::vector<SaturatingUINT64> &Buckets,
+                         const std::vector<SaturatingUINT64> &OtherBuckets) {
+      for (unsigned I = 0; I < NumOfCoverageCategories; ++I)
+        Buckets[I] += OtherBuckets[I].Value;
+    };
+    AddBuckets(VarParamLocStats, Other.VarParamLocStats);
+    AddBuckets(VarParamNonEntryValLocStats, Other.VarParamNonEntryValLocStats);
+    AddBuckets(ParamLocStats, Other.ParamLocStats);
+    AddBuckets(ParamNonEntryValLocStats, Other.ParamNonEntryValLocStats);
+    AddBuckets(LocalVarLocStats, Other.LocalVarLocStats);
+    AddBuckets(LocalVarNonEntryValLocStats, Other.LocalVarNonEntryValLocStats);
+    NumVarParam += Other.NumVarParam.Value;
+    NumParam += Other.NumParam.Value;
+    NumVar += Other.NumVar.Value;
+  }
+};
+
+/// Statistics collected from one or more compile units.
+struct UnitStats {
+  GlobalStats Global;
+  LocationStats Loc;
+  StringMap<PerFunctionStats> Functions;
+  /// This holds variable information for functions with abstract_origin
+  /// across the units.
+  AbstractOriginVarsTyMap AbstractOriginFnInfo;
+  /// This holds information about the CU of a function with abstract_origin.
+  FunctionDIECUTyMap AbstractOriginFnCUs;
+  /// DIEs whose abstract_origin is in another unit.
+  CrossCUReferencingDIELocationTy CrossCUReferencesToBeResolved;
+
+  /// Add the statistics of units that come after the ones in this object.
+  void add(UnitStats &&Other) {
+    Global.add(Other.Global);
+    Loc.add(Other.Loc);
+    for (const auto &Entry : Other.Functions)
+      Functions[Entry.getKey()].add(Entry.getValue());
+    for (auto &Entry : Other.AbstractOriginFnInfo)
+      llvm::append_range(AbstractOriginFnInfo[Entry.first], Entry.second);
+    for (const auto &Entry : Other.AbstractOriginFnCUs)
+      AbstractOriginFnCUs[Entry.first] = Entry.second;
+    llvm::append_range(CrossCUReferencesToBeResolved,
+                       Other.CrossCUReferencesToBeResolved);
+  }
 };
 } // namespace
 
@@ -831,6 +918,65 @@ static void collectZeroLocCovForVarsWithCrossCUReferencingAbstractOrigin(
   }
 }
 
+/// Collect debug info quality metrics for the unit of \p CUDie.
+static void collectStatsForUnit(DWARFDie CUDie, UnitStats &Stats) {
+  // This variable holds variable information for functions with
+  // abstract_origin, but just for the current CU.
+  AbstractOriginVarsTyMap LocalAbstractOriginFnInfo;
+  FunctionsWithAbstractOriginTy FnsWithAbstractOriginToBeProcessed;
+
+  collectStatsRecursive(CUDie, "/", "g", 0, 0, Stats.Functions, Stats.Global,
+                        Stats.Loc, Stats.AbstractOriginFnCUs,
+                        Stats.AbstractOriginFnInfo, LocalAbstractOriginFnInfo,
+                        FnsWithAbstractOriginToBeProcessed);
+
+  // collectZeroLocCovForVarsWithAbstractOrigin will filter out all
+  // out-of-order DWARF functions that have been processed within it,
+  // leaving FnsWithAbstractOriginToBeProcessed with only CrossCU
+  // references.
+  collectZeroLocCovForVarsWithAbstractOrigin(
+      CUDie.getDwarfUnit(), Stats.Global, Stats.Loc, LocalAbstractOriginFnInfo,
+      FnsWithAbstractOriginToBeProcessed);
+
+  // Collect all CrossCU references into CrossCUReferencesToBeResolved.
+  for (auto CrossCUReferencingDIEOffset : FnsWithAbstractOriginToBeProcessed)
+    Stats.CrossCUReferencesToBeResolved.push_back(
+        DIELocation(CUDie.getDwarfUnit(), CrossCUReferencingDIEOffset));
+}
+
+/// Collect the statistics of the compile units of \p DICtx on \p NumThreads
+/// threads. The per-unit statistics are added up in unit order.
+static void collectStatsConcurrently(DWARFContext &DICtx, UnitStats &Totals,
+                                     unsigned NumThreads) {
+  // Load the split units and build the state that is shared between units,
+  // and created lazily, before starting the threads: the abbreviations of
+  // each unit, the line tables and the type unit signature maps. DIEs are
+  // extracted in parallel.
+  std::vector<DWARFUnit *> Units;
+  for (const auto &CU : DICtx.compile_units()) {
+    if (DWARFDie CUDie = CU->getNonSkeletonUnitDIE()) {
+      DWARFUnit *U = CUDie.getDwarfUnit();
+      U->getAbbreviations();
+      U->getContext().getLineTableForUnit(U);
+      Units.push_back(U);
+    }
+  }
+  DICtx.getTypeUnitForHash(0, 0, /*IsDWO=*/false);
+  DICtx.getTypeUnitForHash(0, 0, /*IsDWO=*/true);
+
+  std::vector<UnitStats> PerUnit(Units.size());
+  ThreadPool Pool(hardware_concurrency(NumThreads));
+  for (size_t I = 0; I < Units.size(); ++I)
+    Pool.async([&, I] {
+      if (DWARFDie CUDie = Units[I]->getUnitDIE(false))
+        collectStatsForUnit(CUDie, PerUnit[I]);
+    });
+  Pool.wait();
+
+  for (UnitStats &Stats : PerUnit)
+    Totals.add(std::move(Stats));
+}
+
 /// \}
 
 /// Collect debug info quality metrics for an entire DIContext.
@@ -843,50 +989,25 @@ static void collectZeroLocCovForVarsWithCrossCUReferencingAbstractOrigin(
 /// compilers is.
 bool dwarfdump::collectStatsForObjectFile(ObjectFile &Obj, DWARFContext &DICtx,
                                           const Twine &Filename,
-                                          raw_ostream &OS) {
+                                          raw_ostream &OS,
+                                          unsigned NumThreads) {
   StringRef FormatName = Obj.getFileFormatName();
-  GlobalStats GlobalStats;
-  LocationStats LocStats;
-  StringMap<PerFunctionStats> Statistics;
-  // This variable holds variable information for functions with
-  // abstract_origin globally, across all CUs.
-  AbstractOriginVarsTyMap GlobalAbstractOriginFnInfo;
-  // This variable holds information about the CU of a function with
-  // abstract_origin.
-  FunctionDIECUTyMap AbstractOriginFnCUs;
-  CrossCUReferencingDIELocationTy CrossCUReferencesToBeResolved;
-  for (const auto &CU : static_cast<DWARFContext *>(&DICtx)->compile_units()) {
-    if (DWARFDie CUDie = CU->getNonSkeletonUnitDIE(false)) {
-      // This variable holds variable information for functions with
-      // abstract_origin, but just for the current CU.
-      AbstractOriginVarsTyMap LocalAbstractOriginFnInfo;
-      FunctionsWithAbstractOriginTy FnsWithAbstractOriginToBeProcessed;
-
-      collectStatsRecursive(
-          CUDie, "/", "g", 0, 0, Statistics, GlobalStats, LocStats,
-          AbstractOriginFnCUs, GlobalAbstractOriginFnInfo,
-          LocalAbstractOriginFnInfo, FnsWithAbstractOriginToBeProcessed);
-
-      // collectZeroLocCovForVarsWithAbstractOrigin will filter out all
-      // out-of-order DWARF functions that have been processed within it,
-      // leaving FnsWithAbstractOriginToBeProcessed with only CrossCU
-      // references.
-      collectZeroLocCovForVarsWithAbstractOrigin(
-          CUDie.getDwarfUnit(), GlobalStats, LocStats,
-          LocalAbstractOriginFnInfo, FnsWithAbstractOriginToBeProcessed);
-
-      // Collect all CrossCU references into CrossCUReferencesToBeResolved.
-      for (auto CrossCUReferencingDIEOffset :
-           FnsWithAbstractOriginToBeProcessed)
-        CrossCUReferencesToBeResolved.push_back(
-            DIELocation(CUDie.getDwarfUnit(), CrossCUReferencingDIEOffset));
-    }
+  UnitStats Totals;
+  if (NumThreads != 1) {
+    collectStatsConcurrently(DICtx, Totals, NumThreads);
+  } else {
+    for (const auto &CU : DICtx.compile_units())
+      if (DWARFDie CUDie = CU->getNonSkeletonUnitDIE(false))
+        collectStatsForUnit(CUDie, Totals);
   }
+  GlobalStats &GlobalStats = Totals.Global;
+  LocationStats &LocStats = Totals.Loc;
+  StringMap<PerFunctionStats> &Statistics = Totals.Functions;
 
   /// Resolve CrossCU references.
   collectZeroLocCovForVarsWithCrossCUReferencingAbstractOrigin(
-      LocStats, AbstractOriginFnCUs, GlobalAbstractOriginFnInfo,
-      CrossCUReferencesToBeResolved);
+      LocStats, Totals.AbstractOriginFnCUs, Totals.AbstractOriginFnInfo,
+      Totals.CrossCUReferencesToBeResolved);
 
   /// Collect the sizes of debug sections.
   SectionSizes Sizes;
@@ -256,6 +256,11 @@ static opt<bool> Verify("verify", desc("Verify the DWARF debug info."),
                         cat(DwarfDumpCategory));
 static opt<bool> Quiet("quiet", desc("Use with -verify to not emit to STDOUT."),
                        cat(DwarfDumpCategory));
+static opt<unsigned>
+    NumThreads("num-threads",
+               desc("Number of threads to use with --verify and --statistics. "
+                    "0 uses all available cores."),
+               cat(DwarfDumpCategory), init(1), value_desc("n"));
 static opt<bool> DumpUUID("uuid", desc("Show the UUID for each architecture."),
                           cat(DwarfDumpCategory));
 static alias DumpUUIDAlias("u", desc("Alias for --uuid."), aliasopt(DumpUUID),
@@ -304,6 +309,7 @@ static DIDumpOptions getDumpOpts(DWARFContext &C) {
   // In -verify mode, print DIEs without children in error messages.
   if (Verify) {
     DumpOpts.Verbose = true;
+    DumpOpts.NumThreads = NumThreads;
     return DumpOpts.noImplicitRecursion();
   }
   return DumpOpts;
@@ -760,8 +766,12 @@ int main(int argc, char **argv) {
     for (auto Object : Objects)
       Success &= handleFile(Object, verifyObjectFile, OutputFile.os());
   } else if (Statistics) {
+    auto CollectStats = [](ObjectFile &Obj, DWARFContext &DICtx,
+                           const Twine &Filename, raw_ostream &OS) {
+      return collectStatsForObjectFile(Obj, DICtx, Filename, OS, NumThreads);
+    };
     for (auto Object : Objects)
-      Success &= handleFile(Object, collectStatsForObjectFile, OutputFile.os());
+      Success &= handleFile(Object, CollectStats, OutputFile.os());
   } else if (ShowSectionSizes) {
     for (auto Object : Objects)
       Success &= handleFile(Object, collectObjectSectionSizes, OutputFile.os());
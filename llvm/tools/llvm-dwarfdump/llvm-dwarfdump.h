@@ -35,7 +35,8 @@ void calculateSectionSizes(const object::ObjectFile &Obj, SectionSizes &Sizes,
                            const Twine &Filename);
 
 bool collectStatsForObjectFile(object::ObjectFile &Obj, DWARFContext &DICtx,
-                               const Twine &Filename, raw_ostream &OS);
+                               const Twine &Filename, raw_ostream &OS,
+                               unsigned NumThreads);
 bool collectObjectSectionSizes(object::ObjectFile &Obj, DWARFContext &DICtx,
                                const Twine &Filename, raw_ostream &OS);
 
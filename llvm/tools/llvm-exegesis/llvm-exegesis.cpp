@@ -33,14 +33,22 @@
 #include "llvm/MC/TargetRegistry.h"
 #include "llvm/Object/ObjectFile.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Errno.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Format.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/TargetSelect.h"
 #include <algorithm>
 #include <string>
 
+#ifdef __linux__
+#include <sched.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 namespace llvm {
 namespace exegesis {
 
@@ -188,6 +196,12 @@ static cl::opt<bool>
                               "and prints a message to access it"),
                      cl::cat(BenchmarkOptions), cl::init(true));
 
+static cl::list<unsigned> BenchmarkCpus(
+    "benchmark-cpus",
+    cl::desc("run the benchmarks in one worker process per listed cpu, "
+             "pinned to that cpu (Linux only)"),
+    cl::CommaSeparated, cl::cat(BenchmarkOptions));
+
 static ExitOnError ExitOnErr("llvm-exegesis error: ");
 
 // Helper function that logs the error(s) and exits.
@@ -290,6 +304,87 @@ generateSnippets(const LLVMState &State, unsigned Opcode,
   return Benchmarks;
 }
 
+// Runs `Configurations` in one worker process per cpu of `BenchmarkCpus`, each
+// pinned to its cpu, and writes the results in the order of `Configurations`.
+// Worker I measures configurations I, I + N, I + 2N, ... and writes each
+// result to a file of its own in a temporary directory, so that the parent
+// can read them back in order once all the workers are done.
+static void runConfigurationsInWorkers(
+    const LLVMState &State, const BenchmarkRunner &Runner,
+    ArrayRef<BenchmarkCode> Configurations,
+    ArrayRef<std::unique_ptr<const SnippetRepetitor>> Repetitors) {
+#ifdef __linux__
+  SmallString<128> TmpDir;
+  ExitOnErr(errorCodeToError(
+      sys::fs::createUniqueDirectory("llvm-exegesis", TmpDir)));
+  const auto getResultPath = [&TmpDir](size_t I) {
+    SmallString<128> Path(TmpDir);
+    sys::path::append(Path, Twine(I) + ".yaml");
+    return std::string(Path);
+  };
+
+  // Don't let the workers flush what the parent has buffered.
+  outs().flush();
+  errs().flush();
+
+  const size_t NumWorkers = BenchmarkCpus.size();
+  std::vector<pid_t> Workers;
+  for (size_t W = 0; W < NumWorkers; ++W) {
+    const pid_t Pid = fork();
+    if (Pid == -1)
+      ExitWithError(Twine("cannot fork benchmark worker: ") +
+                    sys::StrError());
+    if (Pid != 0) {
+      Workers.push_back(Pid);
+      continue;
+    }
+    cpu_set_t CpuSet;
+    CPU_ZERO(&CpuSet);
+    CPU_SET(BenchmarkCpus[W], &CpuSet);
+    if (sched_setaffinity(0, sizeof(CpuSet), &CpuSet) != 0)
+      ExitWithError(Twine("cannot pin benchmark worker to cpu ") +
+                    Twine(BenchmarkCpus[W]) + ": " + sys::StrError());
+    for (size_t I = W; I < Configurations.size(); I += NumWorkers) {
+      InstructionBenchmark Result = ExitOnErr(
+          Runner.runConfiguration(Configurations[I], NumRepetitions,
+                                  LoopBodySize, Repetitors, DumpObjectToDisk));
+      ExitOnFileError(getResultPath(I),
+                      Result.writeYaml(State, getResultPath(I)));
+    }
+    errs().flush();
+    _exit(0);
+  }
+
+  bool AllSucceeded = true;
+  for (size_t W = 0; W < NumWorkers; ++W) {
+    int Status = 0;
+    if (waitpid(Workers[W], &Status, 0) == -1 || !WIFEXITED(Status) ||
+        WEXITSTATUS(Status) != 0) {
+      errs() << "llvm-exegesis: benchmark worker on cpu " << BenchmarkCpus[W]
+             << " failed\n";
+      AllSucceeded = false;
+    }
+  }
+
+  for (size_t I = 0; I < Configurations.size() && AllSucceeded; ++I) {
+    const std::string Path = getResultPath(I);
+    std::unique_ptr<MemoryBuffer> Buffer =
+        ExitOnFileError(Path, errorOrToExpected(MemoryBuffer::getFile(Path)));
+    InstructionBenchmark Result = ExitOnFileError(
+        Path, InstructionBenchmark::readYaml(State, *Buffer));
+    ExitOnFileError(BenchmarkFile, Result.writeYaml(State, BenchmarkFile));
+  }
+
+  for (size_t I = 0; I < Configurations.size(); ++I)
+    sys::fs::remove(getResultPath(I));
+  sys::fs::remove(TmpDir);
+  if (!AllSucceeded)
+    ExitWithError("some benchmark workers failed");
+#else
+  ExitWithError("--benchmark-cpus is only supported on Linux");
+#endif
+}
+
 void benchmarkMain() {
 #ifndef HAVE_LIBPFM
   ExitWithError("benchmarking unavailable, LLVM was built without libpfm.");
@@ -371,6 +466,12 @@ void benchmarkMain() {
   if (BenchmarkFile.empty())
     BenchmarkFile = "-";
 
+  if (!BenchmarkCpus.empty()) {
+    runConfigurationsInWorkers(State, *Runner, Configurations, Repetitors);
+    exegesis::pfm::pfmTerminate();
+    return;
+  }
+
   for (const BenchmarkCode &Conf : Configurations) {
     InstructionBenchmark Result = ExitOnErr(Runner->runConfiguration(
         Conf, NumRepetitions, LoopBodySize, Repetitors, DumpObjectToDisk));
@@ -106,6 +106,14 @@ static opt<unsigned>
                     "number of cores on the current machine."),
                cl::value_desc("n"), cat(ConversionOptions));
 
+static opt<std::string>
+    SpillDirectory("spill-dir", cl::init(""),
+                   cl::desc("Keep the converted function information in a "
+                            "temporary file in the specified directory "
+                            "instead of in memory.\nThis bounds the memory "
+                            "needed to convert very large binaries."),
+                   cl::value_desc("path"), cat(ConversionOptions));
+
 static opt<bool>
     Quiet("quiet", desc("Do not output warnings about the debug information"),
           cat(ConversionOptions));
@@ -258,6 +266,11 @@ static llvm::Error handleObjectFile(ObjectFile &Obj,
   auto &OS = outs();
 
   GsymCreator Gsym(Quiet);
+  support::endianness Endian =
+      Obj.makeTriple().isLittleEndian() ? support::little : support::big;
+  if (!SpillDirectory.empty())
+    if (auto Err = Gsym.enableSpilling(SpillDirectory, Endian))
+      return Err;
 
   // See if we can figure out the base address for a given object file, and if
   // we can, then set the base address to use to this value. This will ease
@@ -308,8 +321,6 @@ static llvm::Error handleObjectFile(ObjectFile &Obj,
     return Err;
 
   // Save the GSYM file to disk.
-  support::endianness Endian =
-      Obj.makeTriple().isLittleEndian() ? support::little : support::big;
   if (auto Err = Gsym.save(OutFile, Endian))
     return Err;
 
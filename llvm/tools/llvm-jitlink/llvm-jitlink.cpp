@@ -46,6 +46,7 @@
 #include "llvm/Object/ObjectFile.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/InitLLVM.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
@@ -240,8 +241,9 @@ static cl::opt<bool>
 
 static cl::opt<bool> UseSharedMemory(
     "use-shared-memory",
-    cl::desc("Use shared memory to transfer generated code and data"),
-    cl::init(false), cl::cat(JITLinkCategory));
+    cl::desc("Use shared memory to transfer generated code and data to the "
+             "executor (default: when the executor supports it)"),
+    cl::init(true), cl::cat(JITLinkCategory));
 
 static ExitOnError ExitOnErr;
 
@@ -593,32 +595,26 @@ static std::unique_ptr<JITLinkMemoryManager> createInProcessMemoryManager() {
           SlabSize));
 }
 
-Expected<std::unique_ptr<jitlink::JITLinkMemoryManager>>
-createSharedMemoryManager(SimpleRemoteEPC &SREPC) {
-  SharedMemoryMapper::SymbolAddrs SAs;
-  if (auto Err = SREPC.getBootstrapSymbols(
-          {{SAs.Instance, rt::ExecutorSharedMemoryMapperServiceInstanceName},
-           {SAs.Reserve,
-            rt::ExecutorSharedMemoryMapperServiceReserveWrapperName},
-           {SAs.Initialize,
-            rt::ExecutorSharedMemoryMapperServiceInitializeWrapperName},
-           {SAs.Deinitialize,
-            rt::ExecutorSharedMemoryMapperServiceDeinitializeWrapperName},
-           {SAs.Release,
-            rt::ExecutorSharedMemoryMapperServiceReleaseWrapperName}}))
-    return std::move(Err);
-
-#ifdef _WIN32
-  size_t SlabSize = 1024 * 1024;
-#else
-  size_t SlabSize = 1024 * 1024 * 1024;
-#endif
-
+static size_t getSharedMemorySlabSize() {
   if (!SlabAllocateSizeString.empty())
-    SlabSize = ExitOnErr(getSlabAllocSize(SlabAllocateSizeString));
+    return ExitOnErr(getSlabAllocSize(SlabAllocateSizeString));
+  return SimpleRemoteEPC::DefaultSharedMemorySlabSize;
+}
 
-  return MapperJITLinkMemoryManager::CreateWithMapper<SharedMemoryMapper>(
-      SlabSize, SREPC, SAs);
+static SimpleRemoteEPC::Setup getSimpleRemoteEPCSetup() {
+  SimpleRemoteEPC::Setup S;
+  if (UseSharedMemory.getNumOccurrences()) {
+    // Shared memory was asked for explicitly, so don't fall back to copying.
+    if (UseSharedMemory)
+      S.CreateMemoryManager = [](SimpleRemoteEPC &SREPC) {
+        return SimpleRemoteEPC::createSharedMemoryManager(
+            SREPC, getSharedMemorySlabSize());
+      };
+    else
+      S.PreferSharedMemory = false;
+  }
+  S.SharedMemorySlabSize = getSharedMemorySlabSize();
+  return S;
 }
 
 
@@ -778,13 +774,9 @@ static Expected<std::unique_ptr<ExecutorProcessControl>> launchExecutor() {
   close(ToExecutor[ReadEnd]);
   close(FromExecutor[WriteEnd]);
 
-  auto S = SimpleRemoteEPC::Setup();
-  if (UseSharedMemory)
-    S.CreateMemoryManager = createSharedMemoryManager;
-
   return SimpleRemoteEPC::Create<FDSimpleRemoteEPCTransport>(
-      std::make_unique<DynamicThreadPoolTaskDispatcher>(), std::move(S),
-      FromExecutor[ReadEnd], ToExecutor[WriteEnd]);
+      std::make_unique<DynamicThreadPoolTaskDispatcher>(),
+      getSimpleRemoteEPCSetup(), FromExecutor[ReadEnd], ToExecutor[WriteEnd]);
 #endif
 }
 
@@ -868,13 +860,9 @@ static Expected<std::unique_ptr<ExecutorProcessControl>> connectToExecutor() {
   if (!SockFD)
     return SockFD.takeError();
 
-  auto S = SimpleRemoteEPC::Setup();
-  if (UseSharedMemory)
-    S.CreateMemoryManager = createSharedMemoryManager;
-
   return SimpleRemoteEPC::Create<FDSimpleRemoteEPCTransport>(
       std::make_unique<DynamicThreadPoolTaskDispatcher>(),
-      std::move(S), *SockFD, *SockFD);
+      getSimpleRemoteEPCSetup(), *SockFD, *SockFD);
 #endif
 }
 
@@ -1115,6 +1103,33 @@ void Session::modifyPassConfig(const Triple &TT,
 
   if (AddSelfRelocations)
     PassConfig.PostPrunePasses.push_back(addSelfRelocations);
+
+  // Time link phases with marker passes. The first phase covers all pre- and
+  // post-prune passes, the second runs from the last pre-fixup pass added
+  // here to the first post-fixup pass, which is where blocks are fixed up.
+  if (ShowTimes) {
+    auto StartPhase = [this](LinkGraph &G) -> Error {
+      std::lock_guard<std::mutex> Lock(LinkPhaseTimesMutex);
+      LinkPhaseStarts[&G] = LinkPhaseClock::now();
+      return Error::success();
+    };
+    PassConfig.PrePrunePasses.insert(PassConfig.PrePrunePasses.begin(),
+                                     StartPhase);
+    PassConfig.PostPrunePasses.push_back([this](LinkGraph &G) -> Error {
+      std::lock_guard<std::mutex> Lock(LinkPhaseTimesMutex);
+      PassesAndPruningTime += LinkPhaseClock::now() - LinkPhaseStarts[&G];
+      return Error::success();
+    });
+    PassConfig.PreFixupPasses.push_back(StartPhase);
+    PassConfig.PostFixupPasses.insert(
+        PassConfig.PostFixupPasses.begin(), [this](LinkGraph &G) -> Error {
+          std::lock_guard<std::mutex> Lock(LinkPhaseTimesMutex);
+          FixupTime += LinkPhaseClock::now() - LinkPhaseStarts[&G];
+          LinkPhaseStarts.erase(&G);
+          ++NumGraphsFixedUp;
+          return Error::success();
+        });
+  }
 }
 
 Expected<JITDylib *> Session::getOrLoadDynamicLibrary(StringRef LibPath) {
@@ -1934,6 +1949,18 @@ static void dumpSessionStats(Session &S) {
            << "\n";
 }
 
+static void dumpLinkPhaseTimes(Session &S) {
+  if (!ShowTimes)
+    return;
+  using Seconds = std::chrono::duration<double>;
+  std::lock_guard<std::mutex> Lock(S.LinkPhaseTimesMutex);
+  errs() << "Link phase times summed over " << S.NumGraphsFixedUp
+         << " graphs:\n"
+         << format("  %10.4fs  pre-prune passes, pruning, post-prune passes\n",
+                   Seconds(S.PassesAndPruningTime).count())
+         << format("  %10.4fs  fixups\n", Seconds(S.FixupTime).count());
+}
+
 static Expected<JITEvaluatedSymbol> getMainEntryPoint(Session &S) {
   return S.ES.lookup(S.JDSearchOrder, S.ES.intern(EntryPointName));
 }
@@ -2052,6 +2079,7 @@ int main(int argc, char *argv[]) {
     S->dumpSessionInfo(outs());
 
   dumpSessionStats(*S);
+  dumpLinkPhaseTimes(*S);
 
   if (!EntryPoint) {
     if (Timers)
@@ -25,6 +25,8 @@
 #include "llvm/Support/Regex.h"
 #include "llvm/Support/raw_ostream.h"
 
+#include <chrono>
+#include <mutex>
 #include <vector>
 
 namespace llvm {
@@ -79,6 +81,15 @@ struct Session {
   uint64_t SizeBeforePruning = 0;
   uint64_t SizeAfterFixups = 0;
 
+  /// Time spent in link phases, summed over all graphs (see -show-times).
+  using LinkPhaseClock = std::chrono::steady_clock;
+  std::mutex LinkPhaseTimesMutex;
+  DenseMap<const jitlink::LinkGraph *, LinkPhaseClock::time_point>
+      LinkPhaseStarts;
+  LinkPhaseClock::duration PassesAndPruningTime{0};
+  LinkPhaseClock::duration FixupTime{0};
+  uint64_t NumGraphsFixedUp = 0;
+
   StringSet<> HarnessFiles;
   StringSet<> HarnessExternals;
   StringSet<> HarnessDefinitions;
@@ -54,6 +54,12 @@ static cl::opt<std::string> OutputFilename("o", cl::Required,
                                            cl::desc("Output filename"),
                                            cl::value_desc("filename"));
 
+static cl::opt<std::string> RemoteCacheDir(
+    "remote-cache-dir",
+    cl::desc("Directory of a cache shared between machines, used behind the "
+             "local cache of -cache-dir"),
+    cl::value_desc("directory"));
+
 static cl::opt<std::string> CacheDir("cache-dir", cl::desc("Cache Directory"),
                                      cl::value_desc("directory"));
 
@@ -104,6 +110,12 @@ static cl::opt<bool>
 // to use all hardware threads or cores in the system.
 static cl::opt<std::string> Threads("thinlto-threads");
 
+static cl::opt<uint64_t> ThinLTOMemoryBudget(
+    "thinlto-memory-budget",
+    cl::desc("Limit the memory of concurrent ThinLTO backend jobs to this "
+             "many bytes"),
+    cl::init(0));
+
 static cl::list<std::string> SymbolResolutions(
     "r",
     cl::desc("Specify a symbol resolution: filename,symbolname,resolution\n"
@@ -331,6 +343,15 @@ static int run(int argc, char **argv) {
   Conf.OverrideTriple = OverrideTriple;
   Conf.DefaultTriple = DefaultTriple;
   Conf.StatsFile = StatsFile;
+  Conf.ThinLTOMemoryBudget = ThinLTOMemoryBudget;
+
+  std::shared_ptr<RemoteCacheStore> RemoteCache;
+  if (!CacheDir.empty() && !RemoteCacheDir.empty()) {
+    RemoteCache = directoryCacheStore(RemoteCacheDir);
+    Conf.CachePrefetchHook = [RemoteCache](StringRef Key) {
+      RemoteCache->prefetch(Key);
+    };
+  }
   Conf.PTO.LoopVectorization = Conf.OptLevel > 1;
   Conf.PTO.SLPVectorization = Conf.OptLevel > 1;
   Conf.OpaquePointers = LtoOpaquePointers;
@@ -428,8 +449,12 @@ static int run(int argc, char **argv) {
   if (!CacheDir.empty())
     Cache = check(localCache("ThinLTO", "Thin", CacheDir, AddBuffer),
                   "failed to create cache");
+  if (RemoteCache)
+    Cache = remoteCache(std::move(Cache), RemoteCache);
 
   check(Lto.run(AddStream, Cache), "LTO::run failed");
+  if (RemoteCache)
+    RemoteCache->wait();
   return static_cast<int>(HasErrors);
 }
 
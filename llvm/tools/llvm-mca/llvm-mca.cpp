@@ -58,6 +58,7 @@
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/ToolOutputFile.h"
 #include "llvm/Support/WithColor.h"
 
@@ -237,6 +238,12 @@ static cl::opt<bool> DisableInstrumentManager(
              "ignores instruments.)."),
     cl::cat(ViewOptions), cl::init(false));
 
+static cl::opt<unsigned>
+    NumJobs("jobs",
+            cl::desc("Number of threads used to simulate the code regions "
+                     "(0 = one per hardware thread)"),
+            cl::cat(ToolOptions), cl::init(1));
+
 namespace {
 
 const Target *getTarget(const char *ProgName) {
@@ -302,15 +309,28 @@ static void processViewOptions(bool IsOutOfOrder) {
     processOptionImpl(PrintRetireStats, Default);
 }
 
-// Returns true on success.
-static bool runPipeline(mca::Pipeline &P) {
-  // Handle pipeline errors here.
-  Expected<unsigned> Cycles = P.run();
-  if (!Cycles) {
-    WithColor::error() << toString(Cycles.takeError());
-    return false;
-  }
-  return true;
+namespace {
+/// A code region that has been lowered to mca::Instructions, together with
+/// the pipeline that simulates it and the views that report on it. Regions
+/// don't share any mutable state once they are built, so their pipelines can
+/// run concurrently.
+struct SimulatedRegion {
+  SmallVector<std::unique_ptr<mca::Instruction>> LoweredSequence;
+  std::unique_ptr<mca::CodeEmitter> CE;
+  std::unique_ptr<mca::CircularSourceMgr> S;
+  std::unique_ptr<mca::CustomBehaviour> CB;
+  std::unique_ptr<mca::Pipeline> P;
+  std::unique_ptr<mca::PipelinePrinter> Printer;
+  // Set if the pipeline failed.
+  std::string ErrorMessage;
+};
+} // end of anonymous namespace
+
+static void runPipeline(SimulatedRegion &R) {
+  // Pipeline errors are reported when the region is printed.
+  Expected<unsigned> Cycles = R.P->run();
+  if (!Cycles)
+    R.ErrorMessage = toString(Cycles.takeError());
 }
 
 int main(int argc, char **argv) {
@@ -552,20 +572,55 @@ int main(int argc, char **argv) {
   assert(MAB && "Unable to create asm backend!");
 
   json::Object JSONOutput;
+  std::vector<std::unique_ptr<SimulatedRegion>> PendingRegions;
+
+  // Simulate the pending regions, concurrently if requested, and print their
+  // reports in program order. Returns false if a simulation failed, in which
+  // case the regions that follow the failing one are not reported.
+  auto FlushRegions = [&]() {
+    bool Parallel = NumJobs != 1 && PendingRegions.size() > 1;
+    if (Parallel) {
+      ThreadPool Pool(hardware_concurrency(NumJobs));
+      for (std::unique_ptr<SimulatedRegion> &R : PendingRegions)
+        Pool.async([&R]() { runPipeline(*R); });
+      Pool.wait();
+    }
+
+    for (std::unique_ptr<SimulatedRegion> &R : PendingRegions) {
+      if (!Parallel)
+        runPipeline(*R);
+      if (!R->ErrorMessage.empty()) {
+        WithColor::error() << R->ErrorMessage;
+        return false;
+      }
+      if (PrintJson) {
+        R->Printer->printReport(JSONOutput);
+      } else {
+        R->Printer->printReport(TOF->os());
+      }
+    }
+    PendingRegions.clear();
+    return true;
+  };
+
   for (const std::unique_ptr<mca::AnalysisRegion> &Region : Regions) {
     // Skip empty code regions.
     if (Region->empty())
       continue;
 
-    IB.clear();
+    // Instruction descriptors are shared by all the regions, but the warnings
+    // about calls and returns are reported once per region.
+    IB.resetWarnings();
 
     // Lower the MCInst sequence into an mca::Instruction sequence.
     ArrayRef<MCInst> Insts = Region->getInstructions();
-    mca::CodeEmitter CE(*STI, *MAB, *MCE, Insts);
+    auto SR = std::make_unique<SimulatedRegion>();
+    SR->CE = std::make_unique<mca::CodeEmitter>(*STI, *MAB, *MCE, Insts);
 
     IPP->resetState();
 
-    SmallVector<std::unique_ptr<mca::Instruction>> LoweredSequence;
+    SmallVector<std::unique_ptr<mca::Instruction>> &LoweredSequence =
+        SR->LoweredSequence;
     for (const MCInst &MCI : Insts) {
       SMLoc Loc = MCI.getLoc();
       const SmallVector<mca::SharedInstrument> Instruments =
@@ -588,6 +643,8 @@ int main(int argc, char **argv) {
           // Default case.
           WithColor::error() << toString(std::move(NewE));
         }
+        // Report the regions that precede the invalid one.
+        FlushRegions();
         return 1;
       }
 
@@ -596,22 +653,27 @@ int main(int argc, char **argv) {
       LoweredSequence.emplace_back(std::move(Inst.get()));
     }
 
-    mca::CircularSourceMgr S(LoweredSequence,
-                             PrintInstructionTables ? 1 : Iterations);
+    SR->S = std::make_unique<mca::CircularSourceMgr>(
+        LoweredSequence, PrintInstructionTables ? 1 : Iterations);
+    mca::CircularSourceMgr &S = *SR->S;
+    mca::CodeEmitter &CE = *SR->CE;
 
     if (PrintInstructionTables) {
       //  Create a pipeline, stages, and a printer.
-      auto P = std::make_unique<mca::Pipeline>();
-      P->appendStage(std::make_unique<mca::EntryStage>(S));
-      P->appendStage(std::make_unique<mca::InstructionTables>(SM));
+      SR->P = std::make_unique<mca::Pipeline>();
+      SR->P->appendStage(std::make_unique<mca::EntryStage>(S));
+      SR->P->appendStage(std::make_unique<mca::InstructionTables>(SM));
 
-      mca::PipelinePrinter Printer(*P, *Region, RegionIdx, *STI, PO);
+      SR->Printer = std::make_unique<mca::PipelinePrinter>(*SR->P, *Region,
+                                                           RegionIdx, *STI, PO);
+      mca::PipelinePrinter &Printer = *SR->Printer;
       if (PrintJson) {
         Printer.addView(
             std::make_unique<mca::InstructionView>(*STI, *IP, Insts));
       }
 
-      // Create the views for this pipeline, execute, and emit a report.
+      // Create the views for this pipeline; the simulation and the report
+      // happen in FlushRegions.
       if (PrintInstructionInfoView) {
         Printer.addView(std::make_unique<mca::InstructionInfoView>(
             *STI, *MCII, CE, ShowEncoding, Insts, *IP, LoweredSequence,
@@ -620,15 +682,7 @@ int main(int argc, char **argv) {
       Printer.addView(
           std::make_unique<mca::ResourcePressureView>(*STI, *IP, Insts));
 
-      if (!runPipeline(*P))
-        return 1;
-
-      if (PrintJson) {
-        Printer.printReport(JSONOutput);
-      } else {
-        Printer.printReport(TOF->os());
-      }
-
+      PendingRegions.push_back(std::move(SR));
       ++RegionIdx;
       continue;
     }
@@ -639,7 +693,7 @@ int main(int argc, char **argv) {
     // the source code (but it can depend on the list of
     // mca::Instruction or any objects that can be reconstructed
     // from the target information).
-    std::unique_ptr<mca::CustomBehaviour> CB;
+    std::unique_ptr<mca::CustomBehaviour> &CB = SR->CB;
     if (!DisableCustomBehaviour)
       CB = std::unique_ptr<mca::CustomBehaviour>(
           TheTarget->createCustomBehaviour(*STI, S, *MCII));
@@ -649,9 +703,11 @@ int main(int argc, char **argv) {
       CB = std::make_unique<mca::CustomBehaviour>(*STI, S, *MCII);
 
     // Create a basic pipeline simulating an out-of-order backend.
-    auto P = MCA.createDefaultPipeline(PO, S, *CB);
+    SR->P = MCA.createDefaultPipeline(PO, S, *CB);
 
-    mca::PipelinePrinter Printer(*P, *Region, RegionIdx, *STI, PO);
+    SR->Printer = std::make_unique<mca::PipelinePrinter>(*SR->P, *Region,
+                                                         RegionIdx, *STI, PO);
+    mca::PipelinePrinter &Printer = *SR->Printer;
 
     // Targets can define their own custom Views that exist within their
     // /lib/Target/ directory so that the View can utilize their CustomBehaviour
@@ -738,18 +794,13 @@ int main(int argc, char **argv) {
         Printer.addView(std::move(CBView));
     }
 
-    if (!runPipeline(*P))
-      return 1;
-
-    if (PrintJson) {
-      Printer.printReport(JSONOutput);
-    } else {
-      Printer.printReport(TOF->os());
-    }
-
+    PendingRegions.push_back(std::move(SR));
     ++RegionIdx;
   }
 
+  if (!FlushRegions())
+    return 1;
+
   if (PrintJson)
     TOF->os() << formatv("{0:2}", json::Value(std::move(JSONOutput))) << "\n";
 
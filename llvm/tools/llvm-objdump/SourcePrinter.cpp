@@ -340,7 +340,7 @@ bool SourcePrinter::cacheSource(const DILineInfo &LineInfo) {
   } else {
     auto BufferOrError = MemoryBuffer::getFile(LineInfo.FileName);
     if (!BufferOrError) {
-      if (MissingSources.insert(LineInfo.FileName).second)
+      if (Shared->MissingSources.insert(LineInfo.FileName).second)
         reportWarning("failed to find source " + LineInfo.FileName,
                       Obj->getFileName());
       return false;
@@ -350,7 +350,7 @@ bool SourcePrinter::cacheSource(const DILineInfo &LineInfo) {
   // Chomp the file to get lines
   const char *BufferStart = Buffer->getBufferStart(),
              *BufferEnd = Buffer->getBufferEnd();
-  std::vector<StringRef> &Lines = LineCache[LineInfo.FileName];
+  std::vector<StringRef> &Lines = Shared->LineCache[LineInfo.FileName];
   const char *Start = BufferStart;
   for (const char *I = BufferStart; I != BufferEnd; ++I)
     if (*I == '\n') {
@@ -359,7 +359,7 @@ bool SourcePrinter::cacheSource(const DILineInfo &LineInfo) {
     }
   if (Start < BufferEnd)
     Lines.emplace_back(Start, BufferEnd - Start);
-  SourceCache[LineInfo.FileName] = std::move(Buffer);
+  Shared->SourceCache[LineInfo.FileName] = std::move(Buffer);
   return true;
 }
 
@@ -368,17 +368,18 @@ void SourcePrinter::printSourceLine(formatted_raw_ostream &OS,
                                     StringRef ObjectFilename,
                                     LiveVariablePrinter &LVP,
                                     StringRef Delimiter) {
-  if (!Symbolizer)
+  if (!Shared)
     return;
 
+  std::lock_guard<std::mutex> Lock(Shared->Mutex);
   DILineInfo LineInfo = DILineInfo();
   Expected<DILineInfo> ExpectedLineInfo =
-      Symbolizer->symbolizeCode(*Obj, Address);
+      Shared->Symbolizer->symbolizeCode(*Obj, Address);
   std::string ErrorMessage;
   if (ExpectedLineInfo) {
     LineInfo = *ExpectedLineInfo;
-  } else if (!WarnedInvalidDebugInfo) {
-    WarnedInvalidDebugInfo = true;
+  } else if (!Shared->WarnedInvalidDebugInfo) {
+    Shared->WarnedInvalidDebugInfo = true;
     // TODO Untested.
     reportWarning("failed to parse debug information: " +
                       toString(ExpectedLineInfo.takeError()),
@@ -451,11 +452,12 @@ void SourcePrinter::printSources(formatted_raw_ostream &OS,
        OldLineInfo.FileName == LineInfo.FileName))
     return;
 
-  if (SourceCache.find(LineInfo.FileName) == SourceCache.end())
+  if (Shared->SourceCache.find(LineInfo.FileName) ==
+      Shared->SourceCache.end())
     if (!cacheSource(LineInfo))
       return;
-  auto LineBuffer = LineCache.find(LineInfo.FileName);
-  if (LineBuffer != LineCache.end()) {
+  auto LineBuffer = Shared->LineCache.find(LineInfo.FileName);
+  if (LineBuffer != Shared->LineCache.end()) {
     if (LineInfo.Line > LineBuffer->second.size()) {
       reportWarning(
           formatv(
@@ -472,13 +474,13 @@ void SourcePrinter::printSources(formatted_raw_ostream &OS,
 
 SourcePrinter::SourcePrinter(const object::ObjectFile *Obj,
                              StringRef DefaultArch)
-    : Obj(Obj) {
+    : Obj(Obj), Shared(std::make_shared<SharedState>()) {
   symbolize::LLVMSymbolizer::Options SymbolizerOpts;
   SymbolizerOpts.PrintFunctions =
       DILineInfoSpecifier::FunctionNameKind::LinkageName;
   SymbolizerOpts.Demangle = Demangle;
   SymbolizerOpts.DefaultArch = std::string(DefaultArch);
-  Symbolizer.reset(new symbolize::LLVMSymbolizer(SymbolizerOpts));
+  Shared->Symbolizer.reset(new symbolize::LLVMSymbolizer(SymbolizerOpts));
 }
 
 } // namespace objdump
@@ -15,6 +15,8 @@
 #include "llvm/DebugInfo/Symbolize/Symbolize.h"
 #include "llvm/MC/MCSubtargetInfo.h"
 #include "llvm/Support/FormattedStream.h"
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -126,19 +128,27 @@ public:
   void printAfterInst(formatted_raw_ostream &OS);
 };
 
+// Copies of a SourcePrinter share the symbolizer and the source caches, which
+// are locked while a line is printed, so each thread disassembling in parallel
+// can use its own copy.
 class SourcePrinter {
 protected:
+  struct SharedState {
+    std::mutex Mutex;
+    std::unique_ptr<symbolize::LLVMSymbolizer> Symbolizer;
+    // File name to file contents of source.
+    std::unordered_map<std::string, std::unique_ptr<MemoryBuffer>> SourceCache;
+    // Mark the line endings of the cached source.
+    std::unordered_map<std::string, std::vector<StringRef>> LineCache;
+    // Keep track of missing sources.
+    StringSet<> MissingSources;
+    // Only emit 'invalid debug info' warning once.
+    bool WarnedInvalidDebugInfo = false;
+  };
+
   DILineInfo OldLineInfo;
   const object::ObjectFile *Obj = nullptr;
-  std::unique_ptr<symbolize::LLVMSymbolizer> Symbolizer;
-  // File name to file contents of source.
-  std::unordered_map<std::string, std::unique_ptr<MemoryBuffer>> SourceCache;
-  // Mark the line endings of the cached source.
-  std::unordered_map<std::string, std::vector<StringRef>> LineCache;
-  // Keep track of missing sources.
-  StringSet<> MissingSources;
-  // Only emit 'invalid debug info' warning once.
-  bool WarnedInvalidDebugInfo = false;
+  std::shared_ptr<SharedState> Shared;
 
 private:
   bool cacheSource(const DILineInfo &LineInfoFile);
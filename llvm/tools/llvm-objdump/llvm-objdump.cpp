@@ -81,11 +81,15 @@
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/StringSaver.h"
 #include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/WithColor.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cctype>
 #include <cstring>
+#include <deque>
+#include <future>
+#include <mutex>
 #include <system_error>
 #include <unordered_map>
 #include <utility>
@@ -226,6 +230,7 @@ static bool DynamicSymbolTable;
 std::string objdump::TripleName;
 bool objdump::UnwindInfo;
 static bool Wide;
+static unsigned DisassemblerThreads;
 std::string objdump::Prefix;
 uint32_t objdump::PrefixStrip;
 
@@ -234,6 +239,8 @@ DebugVarsFormat objdump::DbgVariables = DVDisabled;
 int objdump::DbgIndent = 52;
 
 static StringSet<> DisasmSymbolSet;
+// Guards outs() while disassembling in parallel.
+static std::mutex OutputMutex;
 StringSet<> objdump::FoundSectionSet;
 static StringRef ToolName;
 
@@ -303,6 +310,8 @@ std::string objdump::getFileNameForError(const object::Archive::Child &C,
 }
 
 void objdump::reportWarning(const Twine &Message, StringRef File) {
+  // Warnings can be reported while disassembling in parallel.
+  std::lock_guard<std::mutex> Lock(OutputMutex);
   // Output order between errs() and outs() matters especially for archive
   // files where the output is per member object.
   outs().flush();
@@ -1039,7 +1048,7 @@ static uint64_t dumpARMELFData(uint64_t SectionAddr, uint64_t Index,
 }
 
 static void dumpELFData(uint64_t SectionAddr, uint64_t Index, uint64_t End,
-                        ArrayRef<uint8_t> Bytes) {
+                        ArrayRef<uint8_t> Bytes, raw_ostream &OS) {
   // print out data up to 8 bytes at a time in hex and ascii
   uint8_t AsciiData[9] = {'\0'};
   uint8_t Byte;
@@ -1047,9 +1056,9 @@ static void dumpELFData(uint64_t SectionAddr, uint64_t Index, uint64_t End,
 
   for (; Index < End; ++Index) {
     if (NumBytes == 0)
-      outs() << format("%8" PRIx64 ":", SectionAddr + Index);
+      OS << format("%8" PRIx64 ":", SectionAddr + Index);
     Byte = Bytes.slice(Index)[0];
-    outs() << format(" %02x", Byte);
+    OS << format(" %02x", Byte);
     AsciiData[NumBytes] = isPrint(Byte) ? Byte : '.';
 
     uint8_t IndentOffset = 0;
@@ -1064,9 +1073,9 @@ static void dumpELFData(uint64_t SectionAddr, uint64_t Index, uint64_t End,
     }
     if (NumBytes == 8) {
       AsciiData[8] = '\0';
-      outs() << std::string(IndentOffset, ' ') << "         ";
-      outs() << reinterpret_cast<char *>(AsciiData);
-      outs() << '\n';
+      OS << std::string(IndentOffset, ' ') << "         ";
+      OS << reinterpret_cast<char *>(AsciiData);
+      OS << '\n';
       NumBytes = 0;
     }
   }
@@ -1287,20 +1296,62 @@ fetchBinaryByBuildID(const ObjectFile &Obj) {
   return std::move(*DebugBinary);
 }
 
-static void disassembleObject(const Target *TheTarget, ObjectFile &Obj,
-                              const ObjectFile &DbgObj, MCContext &Ctx,
-                              MCDisassembler *PrimaryDisAsm,
-                              MCDisassembler *SecondaryDisAsm,
-                              const MCInstrAnalysis *MIA, MCInstPrinter *IP,
-                              const MCSubtargetInfo *PrimarySTI,
-                              const MCSubtargetInfo *SecondarySTI,
-                              PrettyPrinter &PIP, SourcePrinter &SP,
-                              bool InlineRelocs) {
-  const MCSubtargetInfo *STI = PrimarySTI;
-  MCDisassembler *DisAsm = PrimaryDisAsm;
+namespace {
+
+/// The disassembler objects owned by one thread when disassembling in
+/// parallel.
+struct ThreadDisassembler {
+  std::unique_ptr<MCContext> Ctx;
+  std::unique_ptr<MCObjectFileInfo> MOFI;
+  std::unique_ptr<MCDisassembler> DisAsm;
+  std::unique_ptr<MCDisassembler> SecondaryDisAsm;
+  std::unique_ptr<MCInstPrinter> IP;
+};
+
+/// The state that carries over from one instruction to the next while
+/// disassembling.
+struct DisassemblyState {
+  MCDisassembler *PrimaryDisAsm;
+  MCDisassembler *SecondaryDisAsm;
+  MCDisassembler *DisAsm;
+  const MCSubtargetInfo *STI;
+  MCInstPrinter *IP;
+  SourcePrinter *SP;
+  LiveVariablePrinter *LVP;
+  std::vector<RelocationRef>::const_iterator RelCur;
+};
+
+/// A range of code starting at one or more symbols that has been selected for
+/// disassembly. Offsets are relative to the start of the section.
+struct DisassemblyChunk {
+  ArrayRef<SymbolInfoTy> SymbolsHere;
+  std::vector<std::string> SymNamesHere;
+  std::vector<bool> SymsToPrint;
+  uint64_t Start;
+  uint64_t End;
+  /// The end of the previous chunk in the section, or 0.
+  uint64_t PrevEnd;
+  bool DisassembleAsData;
+};
+
+} // end anonymous namespace
+
+/// The amount of code disassembled by one task when disassembling in
+/// parallel.
+static constexpr uint64_t ParallelDisassemblyBatchSize = 64 * 1024;
+
+static void disassembleObject(
+    const Target *TheTarget, ObjectFile &Obj, const ObjectFile &DbgObj,
+    MCContext &Ctx, MCDisassembler *PrimaryDisAsm,
+    MCDisassembler *SecondaryDisAsm, const MCInstrAnalysis *MIA,
+    MCInstPrinter *IP, const MCSubtargetInfo *PrimarySTI,
+    const MCSubtargetInfo *SecondarySTI, PrettyPrinter &PIP, SourcePrinter &SP,
+    bool InlineRelocs,
+    function_ref<std::unique_ptr<ThreadDisassembler>()>
+        CreateThreadDisassembler) {
   bool PrimaryIsThumb = false;
   if (isArmElf(Obj))
-    PrimaryIsThumb = STI->checkFeatures("+thumb-mode");
+    PrimaryIsThumb = PrimarySTI->checkFeatures("+thumb-mode");
 
   std::map<SectionRef, std::vector<RelocationRef>> RelocMap;
   if (InlineRelocs)
@@ -1411,7 +1462,7 @@ static void disassembleObject(const Target *TheTarget, ObjectFile &Obj,
   llvm::stable_sort(AbsoluteSymbols);
 
   std::unique_ptr<DWARFContext> DICtx;
-  LiveVariablePrinter LVP(*Ctx.getRegisterInfo(), *STI);
+  LiveVariablePrinter LVP(*Ctx.getRegisterInfo(), *PrimarySTI);
 
   if (DbgVariables != DVDisabled) {
     DICtx = DWARFContext::create(DbgObj);
@@ -1440,6 +1491,18 @@ static void disassembleObject(const Target *TheTarget, ObjectFile &Obj,
   if (SymbolizeOperands && !Obj.isRelocatableObject())
     ReadBBAddrMap();
 
+  DisassemblyState SerialState{PrimaryDisAsm, SecondaryDisAsm, PrimaryDisAsm,
+                               PrimarySTI,    IP,              &SP,
+                               &LVP,          {}};
+
+  // Live variables are tracked across chunks, and the AMDGPU disassembler
+  // is given a symbolizer per section, so both are disassembled serially.
+  std::unique_ptr<ThreadPool> Pool;
+  if (DisassemblerThreads != 1 && DbgVariables == DVDisabled &&
+      !(Obj.isELF() && Obj.getArch() == Triple::amdgcn))
+    Pool = std::make_unique<ThreadPool>(
+        hardware_concurrency(DisassemblerThreads));
+
   for (const SectionRef &Section : ToolSectionFilter(Obj)) {
     if (FilterSections.empty() && !DisassembleAll &&
         (!Section.isText() || Section.isVirtual()))
@@ -1481,8 +1544,8 @@ static void disassembleObject(const Target *TheTarget, ObjectFile &Obj,
     std::vector<std::unique_ptr<std::string>> SynthesizedLabelNames;
     if (Obj.isELF() && Obj.getArch() == Triple::amdgcn) {
       // AMDGPU disassembler uses symbolizer for printing labels
-      addSymbolizer(Ctx, TheTarget, TripleName, DisAsm, SectionAddr, Bytes,
-                    Symbols, SynthesizedLabelNames);
+      addSymbolizer(Ctx, TheTarget, TripleName, SerialState.DisAsm,
+                    SectionAddr, Bytes, Symbols, SynthesizedLabelNames);
     }
 
     StringRef SegmentName = getSegmentName(MachO, Section);
@@ -1495,9 +1558,6 @@ static void disassembleObject(const Target *TheTarget, ObjectFile &Obj,
                                                             : ELF::STT_OBJECT));
     }
 
-    SmallString<40> Comments;
-    raw_svector_ostream CommentStream(Comments);
-
     uint64_t VMAAdjustment = 0;
     if (shouldAdjustVA(Section))
       VMAAdjustment = AdjustVMA;
@@ -1506,15 +1566,12 @@ static void disassembleObject(const Target *TheTarget, ObjectFile &Obj,
     // Subtract SectionAddr from the r_offset field of a relocation to get
     // the section offset.
     uint64_t RelAdjustment = Obj.isRelocatableObject() ? 0 : SectionAddr;
-    uint64_t Size;
-    uint64_t Index;
-    bool PrintedSection = false;
     std::vector<RelocationRef> Rels = RelocMap[Section];
-    std::vector<RelocationRef>::const_iterator RelCur = Rels.begin();
     std::vector<RelocationRef>::const_iterator RelEnd = Rels.end();
 
-    // Loop over each chunk of code between two points where at least
-    // one symbol is defined.
+    // Select the chunks of code between two points where at least one symbol
+    // is defined.
+    std::vector<DisassemblyChunk> Chunks;
     for (size_t SI = 0, SE = Symbols.size(); SI != SE;) {
       // Advance SI past all the symbols starting at the same address,
       // and make an ArrayRef of them.
@@ -1525,24 +1582,11 @@ static void disassembleObject(const Target *TheTarget, ObjectFile &Obj,
         ++SI;
       SymbolsHere = ArrayRef<SymbolInfoTy>(&Symbols[FirstSI], SI - FirstSI);
 
-      // Get the demangled names of all those symbols. We end up with a vector
-      // of StringRef that holds the names we're going to use, and a vector of
-      // std::string that stores the new strings returned by demangle(), if
-      // any. If we don't call demangle() then that vector can stay empty.
-      std::vector<StringRef> SymNamesHere;
-      std::vector<std::string> DemangledSymNamesHere;
-      if (Demangle) {
-        // Fetch the demangled names and store them locally.
-        for (const SymbolInfoTy &Symbol : SymbolsHere)
-          DemangledSymNamesHere.push_back(demangle(Symbol.Name.str()));
-        // Now we've finished modifying that vector, it's safe to make
-        // a vector of StringRefs pointing into it.
-        SymNamesHere.insert(SymNamesHere.begin(), DemangledSymNamesHere.begin(),
-                            DemangledSymNamesHere.end());
-      } else {
-        for (const SymbolInfoTy &Symbol : SymbolsHere)
-          SymNamesHere.push_back(Symbol.Name);
-      }
+      // Get the demangled names of all those symbols.
+      std::vector<std::string> SymNamesHere;
+      for (const SymbolInfoTy &Symbol : SymbolsHere)
+        SymNamesHere.push_back(Demangle ? demangle(Symbol.Name.str())
+                                        : Symbol.Name.str());
 
       // Distinguish ELF data from code symbols, which will be used later on to
       // decide whether to 'disassemble' this chunk as a data declaration via
@@ -1629,37 +1673,56 @@ static void disassembleObject(const Target *TheTarget, ObjectFile &Obj,
       Start -= SectionAddr;
       End -= SectionAddr;
 
-      if (!PrintedSection) {
-        PrintedSection = true;
-        outs() << "\nDisassembly of section ";
-        if (!SegmentName.empty())
-          outs() << SegmentName << ",";
-        outs() << SectionName << ":\n";
-      }
+      uint64_t PrevEnd = Chunks.empty() ? 0 : Chunks.back().End;
+      Chunks.push_back({SymbolsHere, std::move(SymNamesHere),
+                        std::move(SymsToPrint), Start, End, PrevEnd,
+                        DisassembleAsData});
+    }
+    if (Chunks.empty())
+      continue;
 
-      outs() << '\n';
+    outs() << "\nDisassembly of section ";
+    if (!SegmentName.empty())
+      outs() << SegmentName << ",";
+    outs() << SectionName << ":\n";
+
+
+    // Disassemble a chunk into OS. State carries over from one chunk to the
+    // next when the section is disassembled serially.
+    auto DisassembleChunk = [&](const DisassemblyChunk &Chunk,
+                                DisassemblyState &State, raw_ostream &OS) {
+      ArrayRef<SymbolInfoTy> SymbolsHere = Chunk.SymbolsHere;
+      ArrayRef<std::string> SymNamesHere = Chunk.SymNamesHere;
+      uint64_t Start = Chunk.Start;
+      uint64_t End = Chunk.End;
+      uint64_t Size;
+      uint64_t Index;
+      SmallString<40> Comments;
+      raw_svector_ostream CommentStream(Comments);
+
+      OS << '\n';
 
       for (size_t i = 0; i < SymbolsHere.size(); ++i) {
-        if (!SymsToPrint[i])
+        if (!Chunk.SymsToPrint[i])
           continue;
 
         const SymbolInfoTy &Symbol = SymbolsHere[i];
         const StringRef SymbolName = SymNamesHere[i];
 
         if (LeadingAddr)
-          outs() << format(Is64Bits ? "%016" PRIx64 " " : "%08" PRIx64 " ",
+          OS << format(Is64Bits ? "%016" PRIx64 " " : "%08" PRIx64 " ",
                            SectionAddr + Start + VMAAdjustment);
         if (Obj.isXCOFF() && SymbolDescription) {
-          outs() << getXCOFFSymbolDescription(Symbol, SymbolName) << ":\n";
+          OS << getXCOFFSymbolDescription(Symbol, SymbolName) << ":\n";
         } else
-          outs() << '<' << SymbolName << ">:\n";
+          OS << '<' << SymbolName << ">:\n";
       }
 
       // Don't print raw contents of a virtual section. A virtual section
       // doesn't have any contents in the file.
       if (Section.isVirtual()) {
-        outs() << "...\n";
-        continue;
+        OS << "...\n";
+        return;
       }
 
       // See if any of the symbols defined at this location triggers target-
@@ -1675,9 +1738,9 @@ static void disassembleObject(const Target *TheTarget, ObjectFile &Obj,
       for (size_t SHI = 0; SHI < SymbolsHere.size(); ++SHI) {
         SymbolInfoTy Symbol = SymbolsHere[SHI];
 
-        auto Status =
-            DisAsm->onSymbolStart(Symbol, Size, Bytes.slice(Start, End - Start),
-                                  SectionAddr + Start, CommentStream);
+        auto Status = State.DisAsm->onSymbolStart(
+            Symbol, Size, Bytes.slice(Start, End - Start), SectionAddr + Start,
+            CommentStream);
 
         if (!Status) {
           // If onSymbolStart returns None, that means it didn't trigger any
@@ -1702,10 +1765,10 @@ static void disassembleObject(const Target *TheTarget, ObjectFile &Obj,
           // distance to the next symbol, and sometimes it will be just a
           // prologue and we should start disassembling instructions from where
           // it left off.
-          outs() << "// Error in decoding " << SymNamesHere[SHI]
+          OS << "// Error in decoding " << SymNamesHere[SHI]
                  << " : Decoding failed region as bytes.\n";
           for (uint64_t I = 0; I < Size; ++I) {
-            outs() << "\t.byte\t " << format_hex(Bytes[I], 1, /*Upper=*/true)
+            OS << "\t.byte\t " << format_hex(Bytes[I], 1, /*Upper=*/true)
                    << "\n";
           }
         }
@@ -1717,20 +1780,20 @@ static void disassembleObject(const Target *TheTarget, ObjectFile &Obj,
       if (SectionAddr < StartAddress)
         Index = std::max<uint64_t>(Index, StartAddress - SectionAddr);
 
-      if (DisassembleAsData) {
-        dumpELFData(SectionAddr, Index, End, Bytes);
-        Index = End;
-        continue;
+      if (Chunk.DisassembleAsData) {
+        dumpELFData(SectionAddr, Index, End, Bytes, OS);
+        return;
       }
 
       bool DumpARMELFData = false;
-      formatted_raw_ostream FOS(outs());
+      formatted_raw_ostream FOS(OS);
 
       std::unordered_map<uint64_t, std::string> AllLabels;
       std::unordered_map<uint64_t, std::vector<std::string>> BBAddrMapLabels;
       if (SymbolizeOperands) {
-        collectLocalBranchTargets(Bytes, MIA, DisAsm, IP, PrimarySTI,
-                                  SectionAddr, Index, End, AllLabels);
+        collectLocalBranchTargets(Bytes, MIA, State.DisAsm, State.IP,
+                                  PrimarySTI, SectionAddr, Index, End,
+                                  AllLabels);
         collectBBAddrMapLabels(AddrToBBAddrMap, SectionAddr, Index, End,
                                BBAddrMapLabels);
       }
@@ -1745,18 +1808,20 @@ static void disassembleObject(const Target *TheTarget, ObjectFile &Obj,
           DumpARMELFData = Kind == 'd';
           if (SecondarySTI) {
             if (Kind == 'a') {
-              STI = PrimaryIsThumb ? SecondarySTI : PrimarySTI;
-              DisAsm = PrimaryIsThumb ? SecondaryDisAsm : PrimaryDisAsm;
+              State.STI = PrimaryIsThumb ? SecondarySTI : PrimarySTI;
+              State.DisAsm = PrimaryIsThumb ? State.SecondaryDisAsm
+                                            : State.PrimaryDisAsm;
             } else if (Kind == 't') {
-              STI = PrimaryIsThumb ? PrimarySTI : SecondarySTI;
-              DisAsm = PrimaryIsThumb ? PrimaryDisAsm : SecondaryDisAsm;
+              State.STI = PrimaryIsThumb ? PrimarySTI : SecondarySTI;
+              State.DisAsm = PrimaryIsThumb ? State.PrimaryDisAsm
+                                            : State.SecondaryDisAsm;
             }
           }
         }
 
         if (DumpARMELFData) {
           Size = dumpARMELFData(SectionAddr, Index, End, Obj, Bytes,
-                                MappingSymbols, *STI, FOS);
+                                MappingSymbols, *State.STI, FOS);
         } else {
           // When -z or --disassemble-zeroes are given we always dissasemble
           // them. Otherwise we might want to skip zero bytes we see.
@@ -1764,9 +1829,9 @@ static void disassembleObject(const Target *TheTarget, ObjectFile &Obj,
             uint64_t MaxOffset = End - Index;
             // For --reloc: print zero blocks patched by relocations, so that
             // relocations can be shown in the dump.
-            if (RelCur != RelEnd)
-              MaxOffset = std::min(RelCur->getOffset() - RelAdjustment - Index,
-                                   MaxOffset);
+            if (State.RelCur != RelEnd)
+              MaxOffset = std::min(
+                  State.RelCur->getOffset() - RelAdjustment - Index, MaxOffset);
 
             if (size_t N =
                     countSkippableZeroBytes(Bytes.slice(Index, MaxOffset))) {
@@ -1792,24 +1857,25 @@ static void disassembleObject(const Target *TheTarget, ObjectFile &Obj,
           MCInst Inst;
           ArrayRef<uint8_t> ThisBytes = Bytes.slice(Index);
           uint64_t ThisAddr = SectionAddr + Index;
-          bool Disassembled = DisAsm->getInstruction(Inst, Size, ThisBytes,
-                                                     ThisAddr, CommentStream);
+          bool Disassembled = State.DisAsm->getInstruction(
+              Inst, Size, ThisBytes, ThisAddr, CommentStream);
           if (Size == 0)
             Size = std::min<uint64_t>(
                 ThisBytes.size(),
-                DisAsm->suggestBytesToSkip(ThisBytes, ThisAddr));
+                State.DisAsm->suggestBytesToSkip(ThisBytes, ThisAddr));
 
-          LVP.update({Index, Section.getIndex()},
+          State.LVP->update({Index, Section.getIndex()},
                      {Index + Size, Section.getIndex()}, Index + Size != End);
 
-          IP->setCommentStream(CommentStream);
+          State.IP->setCommentStream(CommentStream);
 
           PIP.printInst(
-              *IP, Disassembled ? &Inst : nullptr, Bytes.slice(Index, Size),
+              *State.IP, Disassembled ? &Inst : nullptr,
+              Bytes.slice(Index, Size),
               {SectionAddr + Index + VMAAdjustment, Section.getIndex()}, FOS,
-              "", *STI, &SP, Obj.getFileName(), &Rels, LVP);
+              "", *State.STI, State.SP, Obj.getFileName(), &Rels, *State.LVP);
 
-          IP->setCommentStream(llvm::nulls());
+          State.IP->setCommentStream(llvm::nulls());
 
           // If disassembly has failed, avoid analysing invalid/incomplete
           // instruction information. Otherwise, try to resolve the target
@@ -1824,7 +1890,7 @@ static void disassembleObject(const Target *TheTarget, ObjectFile &Obj,
             if (!PrintTarget)
               if (Optional<uint64_t> MaybeTarget =
                       MIA->evaluateMemoryOperandAddress(
-                          Inst, STI, SectionAddr + Index, Size)) {
+                          Inst, State.STI, SectionAddr + Index, Size)) {
                 Target = *MaybeTarget;
                 PrintTarget = true;
                 // Do not print real address when symbolizing.
@@ -1858,7 +1924,9 @@ static void disassembleObject(const Target *TheTarget, ObjectFile &Obj,
                     TargetSecAddr = It->first;
                   if (It->first != TargetSecAddr)
                     break;
-                  TargetSectionSymbols.push_back(&AllSymbols[It->second]);
+                  auto SecSyms = AllSymbols.find(It->second);
+                  if (SecSyms != AllSymbols.end())
+                    TargetSectionSymbols.push_back(&SecSyms->second);
                 }
               } else {
                 TargetSectionSymbols.push_back(&Symbols);
@@ -1921,18 +1989,19 @@ static void disassembleObject(const Target *TheTarget, ObjectFile &Obj,
         }
 
         assert(Ctx.getAsmInfo());
-        emitPostInstructionInfo(FOS, *Ctx.getAsmInfo(), *STI,
-                                CommentStream.str(), LVP);
+        emitPostInstructionInfo(FOS, *Ctx.getAsmInfo(), *State.STI,
+                                CommentStream.str(), *State.LVP);
         Comments.clear();
 
         // Hexagon does this in pretty printer
         if (Obj.getArch() != Triple::hexagon) {
           // Print relocation for instruction and data.
-          while (RelCur != RelEnd) {
-            uint64_t Offset = RelCur->getOffset() - RelAdjustment;
+          while (State.RelCur != RelEnd) {
+            uint64_t Offset = State.RelCur->getOffset() - RelAdjustment;
             // If this relocation is hidden, skip it.
-            if (getHidden(*RelCur) || SectionAddr + Offset < StartAddress) {
-              ++RelCur;
+            if (getHidden(*State.RelCur) ||
+                SectionAddr + Offset < StartAddress) {
+              ++State.RelCur;
               continue;
             }
 
@@ -1945,24 +2014,105 @@ static void disassembleObject(const Target *TheTarget, ObjectFile &Obj,
               break;
 
             // When --adjust-vma is used, update the address printed.
-            if (RelCur->getSymbol() != Obj.symbol_end()) {
+            if (State.RelCur->getSymbol() != Obj.symbol_end()) {
               Expected<section_iterator> SymSI =
-                  RelCur->getSymbol()->getSection();
+                  State.RelCur->getSymbol()->getSection();
               if (SymSI && *SymSI != Obj.section_end() &&
                   shouldAdjustVA(**SymSI))
                 Offset += AdjustVMA;
             }
 
-            printRelocation(FOS, Obj.getFileName(), *RelCur,
+            printRelocation(FOS, Obj.getFileName(), *State.RelCur,
                             SectionAddr + Offset, Is64Bits);
-            LVP.printAfterOtherLine(FOS, true);
-            ++RelCur;
+            State.LVP->printAfterOtherLine(FOS, true);
+            ++State.RelCur;
           }
         }
 
         Index += Size;
       }
+    };
+
+    if (!Pool || Chunks.size() == 1) {
+      SerialState.RelCur = Rels.begin();
+      for (const DisassemblyChunk &Chunk : Chunks)
+        DisassembleChunk(Chunk, SerialState, outs());
+      continue;
+    }
+
+    // Disassemble batches of chunks in parallel. Every chunk starts from a
+    // fresh state, so the output does not depend on the number of threads.
+    // The batches are written out in order as they finish, and only a few
+    // are in flight at a time to bound the memory held by their output.
+    auto DisassembleBatch = [&](size_t Begin, size_t End, std::string &Out) {
+      std::unique_ptr<ThreadDisassembler> TD = CreateThreadDisassembler();
+      raw_string_ostream OS(Out);
+      for (const DisassemblyChunk &Chunk : makeArrayRef(Chunks).slice(
+               Begin, End - Begin)) {
+        SourcePrinter ChunkSP = SP;
+        LiveVariablePrinter ChunkLVP(*Ctx.getRegisterInfo(), *PrimarySTI);
+        DisassemblyState State{TD->DisAsm.get(),
+                               TD->SecondaryDisAsm.get(),
+                               TD->DisAsm.get(),
+                               PrimarySTI,
+                               TD->IP.get(),
+                               &ChunkSP,
+                               &ChunkLVP,
+                               Rels.begin()};
+        // Start in the instruction set selected by the last mapping symbol
+        // before the chunk.
+        if (SecondarySTI) {
+          auto It = partition_point(MappingSymbols,
+                                    [&](const MappingSymbolPair &P) {
+                                      return P.first <= Chunk.Start;
+                                    });
+          while (It != MappingSymbols.begin()) {
+            --It;
+            if (It->second != 'a' && It->second != 't')
+              continue;
+            bool UseSecondary = (It->second == 't') != PrimaryIsThumb;
+            State.STI = UseSecondary ? SecondarySTI : PrimarySTI;
+            State.DisAsm =
+                UseSecondary ? State.SecondaryDisAsm : State.PrimaryDisAsm;
+            break;
+          }
+        }
+        // Print the relocations that were not covered by the previous chunk.
+        State.RelCur = partition_point(Rels, [&](const RelocationRef &Rel) {
+          return Rel.getOffset() - RelAdjustment < Chunk.PrevEnd;
+        });
+        DisassembleChunk(Chunk, State, OS);
+      }
+    };
+
+    std::deque<std::pair<std::shared_future<void>, std::string>> InFlight;
+    auto WriteFront = [&] {
+      InFlight.front().first.wait();
+      {
+        std::lock_guard<std::mutex> Lock(OutputMutex);
+        outs() << InFlight.front().second;
+      }
+      InFlight.pop_front();
+    };
+    for (size_t Begin = 0, E = Chunks.size(); Begin != E;) {
+      size_t End = Begin;
+      uint64_t BatchSize = 0;
+      while (End != E && BatchSize < ParallelDisassemblyBatchSize) {
+        BatchSize += Chunks[End].End - Chunks[End].Start;
+        ++End;
+      }
+      InFlight.emplace_back();
+      std::string &Out = InFlight.back().second;
+      InFlight.back().first =
+          Pool->async([&DisassembleBatch, Begin, End, &Out] {
+            DisassembleBatch(Begin, End, Out);
+          });
+      if (InFlight.size() > 4 * Pool->getThreadCount())
+        WriteFront();
+      Begin = End;
     }
+    while (!InFlight.empty())
+      WriteFront();
   }
   StringSet<> MissingDisasmSymbolSet =
       set_difference(DisasmSymbolSet, FoundDisasmSymbolSet);
@@ -2078,15 +2228,23 @@ static void disassembleObject(ObjectFile *Obj, bool InlineRelocs) {
       TheTarget->createMCInstrAnalysis(MII.get()));
 
   int AsmPrinterVariant = AsmInfo->getAssemblerDialect();
-  std::unique_ptr<MCInstPrinter> IP(TheTarget->createMCInstPrinter(
-      Triple(TripleName), AsmPrinterVariant, *AsmInfo, *MII, *MRI));
-  if (!IP)
-    reportError(Obj->getFileName(),
-                "no instruction printer for target " + TripleName);
-  IP->setPrintImmHex(PrintImmHex);
-  IP->setPrintBranchImmAsAddress(true);
-  IP->setSymbolizeOperands(SymbolizeOperands);
-  IP->setMCInstrAnalysis(MIA.get());
+  auto CreateInstPrinter = [&]() {
+    std::unique_ptr<MCInstPrinter> IP(TheTarget->createMCInstPrinter(
+        Triple(TripleName), AsmPrinterVariant, *AsmInfo, *MII, *MRI));
+    if (!IP)
+      reportError(Obj->getFileName(),
+                  "no instruction printer for target " + TripleName);
+    IP->setPrintImmHex(PrintImmHex);
+    IP->setPrintBranchImmAsAddress(true);
+    IP->setSymbolizeOperands(SymbolizeOperands);
+    IP->setMCInstrAnalysis(MIA.get());
+    for (StringRef Opt : DisassemblerOptions)
+      if (!IP->applyTargetSpecificCLOption(Opt))
+        reportError(Obj->getFileName(),
+                    "Unrecognized disassembler option: " + Opt);
+    return IP;
+  };
+  std::unique_ptr<MCInstPrinter> IP = CreateInstPrinter();
 
   PrettyPrinter &PIP = selectPrettyPrinter(Triple(TripleName));
 
@@ -2117,14 +2275,24 @@ static void disassembleObject(ObjectFile *Obj, bool InlineRelocs) {
 
   SourcePrinter SP(DbgObj, TheTarget->getName());
 
-  for (StringRef Opt : DisassemblerOptions)
-    if (!IP->applyTargetSpecificCLOption(Opt))
-      reportError(Obj->getFileName(),
-                  "Unrecognized disassembler option: " + Opt);
+  auto CreateThreadDisassembler = [&]() {
+    auto TD = std::make_unique<ThreadDisassembler>();
+    TD->Ctx = std::make_unique<MCContext>(Triple(TripleName), AsmInfo.get(),
+                                          MRI.get(), STI.get());
+    TD->MOFI.reset(TheTarget->createMCObjectFileInfo(*TD->Ctx, /*PIC=*/false));
+    TD->Ctx->setObjectFileInfo(TD->MOFI.get());
+    TD->DisAsm.reset(TheTarget->createMCDisassembler(*STI, *TD->Ctx));
+    if (SecondarySTI)
+      TD->SecondaryDisAsm.reset(
+          TheTarget->createMCDisassembler(*SecondarySTI, *TD->Ctx));
+    TD->IP = CreateInstPrinter();
+    return TD;
+  };
 
   disassembleObject(TheTarget, *Obj, *DbgObj, Ctx, DisAsm.get(),
                     SecondaryDisAsm.get(), MIA.get(), IP.get(), STI.get(),
-                    SecondarySTI.get(), PIP, SP, InlineRelocs);
+                    SecondarySTI.get(), PIP, SP, InlineRelocs,
+                    CreateThreadDisassembler);
 }
 
 void objdump::printRelocations(const ObjectFile *Obj) {
@@ -3049,6 +3217,8 @@ static void parseObjdumpOptions(const llvm::opt::InputArgList &InputArgs) {
   Wide = InputArgs.hasArg(OBJDUMP_wide);
   Prefix = InputArgs.getLastArgValue(OBJDUMP_prefix).str();
   parseIntArg(InputArgs, OBJDUMP_prefix_strip, PrefixStrip);
+  DisassemblerThreads = 1;
+  parseIntArg(InputArgs, OBJDUMP_threads_EQ, DisassemblerThreads);
   if (const opt::Arg *A = InputArgs.getLastArg(OBJDUMP_debug_vars_EQ)) {
     DbgVariables = StringSwitch<DebugVarsFormat>(A->getValue())
                        .Case("ascii", DVASCII)
@@ -245,6 +245,27 @@ static void overlapInput(const std::string &BaseFilename,
   }
 }
 
+/// Add a record read from \p Input to the writer of \p WC, whose lock must
+/// be held.
+static void addRecord(NamedInstrProfRecord &&I, const WeightedFile &Input,
+                      WriterContext *WC) {
+  const StringRef FuncName = I.Name;
+  bool Reported = false;
+  WC->Writer.addRecord(std::move(I), Input.Weight, [&](Error E) {
+    if (Reported) {
+      consumeError(std::move(E));
+      return;
+    }
+    Reported = true;
+    // Only show hint the first time an error occurs.
+    instrprof_error IPE = InstrProfError::take(std::move(E));
+    std::unique_lock<std::mutex> ErrGuard{WC->ErrLock};
+    bool firstTime = WC->WriterErrorCodes.insert(IPE).second;
+    handleMergeWriterError(make_error<InstrProfError>(IPE), Input.Filename,
+                           FuncName, firstTime);
+  });
+}
+
 /// Load an input into a writer context.
 static void loadInput(const WeightedFile &Input, SymbolRemapper *Remapper,
                       const InstrProfCorrelator *Correlator,
@@ -321,40 +342,81 @@ static void loadInput(const WeightedFile &Input, SymbolRemapper *Remapper,
   for (auto &I : *Reader) {
     if (Remapper)
       I.Name = (*Remapper)(I.Name);
-    const StringRef FuncName = I.Name;
-    bool Reported = false;
-    WC->Writer.addRecord(std::move(I), Input.Weight, [&](Error E) {
-      if (Reported) {
-        consumeError(std::move(E));
-        return;
-      }
-      Reported = true;
-      // Only show hint the first time an error occurs.
-      instrprof_error IPE = InstrProfError::take(std::move(E));
-      std::unique_lock<std::mutex> ErrGuard{WC->ErrLock};
-      bool firstTime = WC->WriterErrorCodes.insert(IPE).second;
-      handleMergeWriterError(make_error<InstrProfError>(IPE), Input.Filename,
-                             FuncName, firstTime);
-    });
+    addRecord(std::move(I), Input, WC);
   }
   if (Reader->hasError())
     if (Error E = Reader->getError())
       WC->Errors.emplace_back(std::move(E), Filename);
 }
 
-/// Merge the \p Src writer context into \p Dst.
-static void mergeWriterContexts(WriterContext *Dst, WriterContext *Src) {
-  for (auto &ErrorPair : Src->Errors)
-    Dst->Errors.push_back(std::move(ErrorPair));
-  Src->Errors.clear();
+/// Load an input into writer contexts that each own the functions whose name
+/// hashes fall into one partition. Records are handed to their partition in
+/// small batches while the input is read, so a thread only holds a bounded
+/// number of records and the partitions never have to be merged. Errors,
+/// the profile kind and MemProf data are kept in the first partition.
+static void loadInputIntoPartitions(
+    const WeightedFile &Input, SymbolRemapper *Remapper,
+    const InstrProfCorrelator *Correlator, const StringRef ProfiledBinary,
+    ArrayRef<std::unique_ptr<WriterContext>> Partitions) {
+  // Copy the filename, see loadInput().
+  std::string Filename = Input.Filename;
+  WriterContext *First = Partitions.front().get();
+
+  if (memprof::RawMemProfReader::hasFormat(Filename)) {
+    loadInput(Input, Remapper, Correlator, ProfiledBinary, First);
+    return;
+  }
 
-  Dst->Writer.mergeRecordsFromWriter(std::move(Src->Writer), [&](Error E) {
+  auto AddError = [&](Error E) {
+    std::unique_lock<std::mutex> CtxGuard{First->Lock};
+    First->Errors.emplace_back(std::move(E), Filename);
+  };
+
+  auto ReaderOrErr = InstrProfReader::create(Filename, Correlator);
+  if (Error E = ReaderOrErr.takeError()) {
+    // Skip the empty profiles by returning sliently.
     instrprof_error IPE = InstrProfError::take(std::move(E));
-    std::unique_lock<std::mutex> ErrGuard{Dst->ErrLock};
-    bool firstTime = Dst->WriterErrorCodes.insert(IPE).second;
-    if (firstTime)
-      warn(toString(make_error<InstrProfError>(IPE)));
-  });
+    if (IPE != instrprof_error::empty_raw_profile)
+      AddError(make_error<InstrProfError>(IPE));
+    return;
+  }
+
+  auto Reader = std::move(ReaderOrErr.get());
+  Error KindErr = [&] {
+    std::unique_lock<std::mutex> CtxGuard{First->Lock};
+    return First->Writer.mergeProfileKind(Reader->getProfileKind());
+  }();
+  if (KindErr) {
+    consumeError(std::move(KindErr));
+    AddError(make_error<StringError>(
+        "Merge IR generated profile with Clang generated profile.",
+        std::error_code()));
+    return;
+  }
+
+  const size_t BatchSize = 1024;
+  std::vector<std::vector<NamedInstrProfRecord>> Batches(Partitions.size());
+  auto Flush = [&](size_t P) {
+    WriterContext *WC = Partitions[P].get();
+    std::unique_lock<std::mutex> CtxGuard{WC->Lock};
+    for (NamedInstrProfRecord &I : Batches[P])
+      addRecord(std::move(I), Input, WC);
+    Batches[P].clear();
+  };
+  for (auto &I : *Reader) {
+    if (Remapper)
+      I.Name = (*Remapper)(I.Name);
+    size_t P = IndexedInstrProf::ComputeHash(I.Name) % Partitions.size();
+    Batches[P].push_back(std::move(I));
+    if (Batches[P].size() == BatchSize)
+      Flush(P);
+  }
+  for (size_t P = 0; P < Partitions.size(); ++P)
+    if (!Batches[P].empty())
+      Flush(P);
+  if (Reader->hasError())
+    if (Error E = Reader->getError())
+      AddError(std::move(E));
 }
 
 static void writeInstrProfile(StringRef OutputFilename,
@@ -405,13 +467,13 @@ static void mergeInstrProfile(const WeightedFileVector &Inputs,
   if (NumThreads == 0)
     NumThreads = std::min(hardware_concurrency().compute_thread_count(),
                           unsigned((Inputs.size() + 1) / 2));
-  // FIXME: There's a bug here, where setting NumThreads = Inputs.size() fails
-  // the merge_empty_profile.test because the InstrProfWriter.ProfileKind isn't
-  // merged, thus the emitted file ends up with a PF_Unknown kind.
 
-  // Initialize the writer contexts.
+  // Initialize the writer contexts. With several threads, each context owns
+  // a partition of the functions, and there are more partitions than threads
+  // to keep the threads from waiting on each other.
   SmallVector<std::unique_ptr<WriterContext>, 4> Contexts;
-  for (unsigned I = 0; I < NumThreads; ++I)
+  unsigned NumContexts = NumThreads == 1 ? 1 : NumThreads * 4;
+  for (unsigned I = 0; I < NumContexts; ++I)
     Contexts.emplace_back(std::make_unique<WriterContext>(
         OutputSparse, ErrorLock, WriterErrorCodes));
 
@@ -421,33 +483,24 @@ static void mergeInstrProfile(const WeightedFileVector &Inputs,
                 Contexts[0].get());
   } else {
     ThreadPool Pool(hardware_concurrency(NumThreads));
-
-    // Load the inputs in parallel (N/NumThreads serial steps).
-    unsigned Ctx = 0;
-    for (const auto &Input : Inputs) {
-      Pool.async(loadInput, Input, Remapper, Correlator.get(), ProfiledBinary,
-                 Contexts[Ctx].get());
-      Ctx = (Ctx + 1) % NumThreads;
-    }
+    for (const auto &Input : Inputs)
+      Pool.async(loadInputIntoPartitions, Input, Remapper, Correlator.get(),
+                 ProfiledBinary, makeArrayRef(Contexts));
     Pool.wait();
 
-    // Merge the writer contexts together (~ lg(NumThreads) serial steps).
-    unsigned Mid = Contexts.size() / 2;
-    unsigned End = Contexts.size();
-    assert(Mid > 0 && "Expected more than one context");
-    do {
-      for (unsigned I = 0; I < Mid; ++I)
-        Pool.async(mergeWriterContexts, Contexts[I].get(),
-                   Contexts[I + Mid].get());
-      Pool.wait();
-      if (End & 1) {
-        Pool.async(mergeWriterContexts, Contexts[0].get(),
-                   Contexts[End - 1].get());
-        Pool.wait();
-      }
-      End = Mid;
-      Mid /= 2;
-    } while (Mid > 0);
+    // The partitions hold disjoint functions, so they are written out
+    // together instead of being merged.
+    WriterContext *First = Contexts[0].get();
+    for (unsigned I = 1; I < NumContexts; ++I)
+      if (Error E = First->Writer.addPartition(
+              Contexts[I]->Writer, [&](Error E) {
+                instrprof_error IPE = InstrProfError::take(std::move(E));
+                std::unique_lock<std::mutex> ErrGuard{First->ErrLock};
+                bool firstTime = First->WriterErrorCodes.insert(IPE).second;
+                if (firstTime)
+                  warn(toString(make_error<InstrProfError>(IPE)));
+              }))
+        exitWithError(std::move(E));
   }
 
   // Handle deferred errors encountered during merging. If the number of errors
@@ -10,6 +10,7 @@
 #include "llvm/DebugInfo/Symbolize/SymbolizableModule.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Process.h"
+#include "llvm/Support/ThreadPool.h"
 
 #define DEBUG_TYPE "perf-reader"
 
@@ -37,6 +38,11 @@ static cl::opt<bool>
     IgnoreStackSamples("ignore-stack-samples",
                        cl::desc("Ignore call stack samples for hybrid samples "
                                 "and produce context-insensitive profile."));
+static cl::opt<unsigned> NumUnwindThreads(
+    "unwind-threads", cl::init(1),
+    cl::desc("Number of threads used to unwind hybrid samples of binaries "
+             "with pseudo probes (0 = one per hardware thread)."));
+
 cl::opt<bool> ShowDetailedWarning("show-detailed-warning",
                                   cl::desc("Show detailed warning message."));
 
@@ -317,6 +323,18 @@ bool VirtualUnwinder::unwind(const PerfSample *Sample, uint64_t Repeat) {
   return true;
 }
 
+void VirtualUnwinder::mergeStats(const VirtualUnwinder &Other) {
+  NumTotalBranches += Other.NumTotalBranches;
+  NumExtCallBranch += Other.NumExtCallBranch;
+  NumMissingExternalFrame += Other.NumMissingExternalFrame;
+  NumMismatchedProEpiBranch += Other.NumMismatchedProEpiBranch;
+  NumMismatchedExtCallBranch += Other.NumMismatchedExtCallBranch;
+  NumUnpairedExtAddr += Other.NumUnpairedExtAddr;
+  NumPairedExtAddr += Other.NumPairedExtAddr;
+  UntrackedCallsites.insert(Other.UntrackedCallsites.begin(),
+                            Other.UntrackedCallsites.end());
+}
+
 std::unique_ptr<PerfReaderBase>
 PerfReaderBase::create(ProfiledBinary *Binary, PerfInputFile &PerfInput,
                        Optional<uint32_t> PIDFilter) {
@@ -481,9 +499,59 @@ void HybridPerfReader::unwindSamples() {
   if (Binary->useFSDiscriminator())
     exitWithError("FS discriminator is not supported in CS profile.");
   VirtualUnwinder Unwinder(&SampleCounters, Binary);
-  for (const auto &Item : AggregatedSamples) {
-    const PerfSample *Sample = Item.first.getPtr();
-    Unwinder.unwind(Sample, Item.second);
+
+  // Unwinding with pseudo probes only reads the binary, so the samples can be
+  // split into shards that are unwound concurrently into their own counter
+  // maps. Line-number based contexts are symbolized through the binary's
+  // location cache, which is not thread-safe.
+  unsigned NumShards = 1;
+  if (Binary->usePseudoProbes() && NumUnwindThreads != 1)
+    NumShards = std::min<size_t>(
+        hardware_concurrency(NumUnwindThreads).compute_thread_count(),
+        AggregatedSamples.size());
+  if (NumShards <= 1) {
+    for (const auto &Item : AggregatedSamples) {
+      const PerfSample *Sample = Item.first.getPtr();
+      Unwinder.unwind(Sample, Item.second);
+    }
+  } else {
+    std::vector<std::pair<const PerfSample *, uint64_t>> Samples;
+    Samples.reserve(AggregatedSamples.size());
+    for (const auto &Item : AggregatedSamples)
+      Samples.emplace_back(Item.first.getPtr(), Item.second);
+
+    std::vector<ContextSampleCounterMap> ShardCounters(NumShards);
+    std::vector<std::unique_ptr<VirtualUnwinder>> ShardUnwinders;
+    for (ContextSampleCounterMap &Counters : ShardCounters)
+      ShardUnwinders.push_back(
+          std::make_unique<VirtualUnwinder>(&Counters, Binary));
+
+    ThreadPool Pool(hardware_concurrency(NumShards));
+    size_t ShardSize = (Samples.size() + NumShards - 1) / NumShards;
+    for (unsigned I = 0; I < NumShards; ++I) {
+      Pool.async([&, I]() {
+        size_t End = std::min(Samples.size(), (I + 1) * ShardSize);
+        for (size_t J = I * ShardSize; J < End; ++J)
+          ShardUnwinders[I]->unwind(Samples[J].first, Samples[J].second);
+      });
+    }
+    Pool.wait();
+
+    // Merge the shards in order.
+    for (unsigned I = 0; I < NumShards; ++I) {
+      Unwinder.mergeStats(*ShardUnwinders[I]);
+      for (const auto &Item : ShardCounters[I]) {
+        SampleCounter &Counter =
+            SampleCounters.emplace(Item.first, SampleCounter()).first->second;
+        for (const auto &Range : Item.second.RangeCounter)
+          Counter.recordRangeCount(Range.first.first, Range.first.second,
+                                   Range.second);
+        for (const auto &Branch : Item.second.BranchCounter)
+          Counter.recordBranchCount(Branch.first.first, Branch.first.second,
+                                    Branch.second);
+      }
+      ShardCounters[I].clear();
+    }
   }
 
   // Warn about untracked frames due to missing probes.
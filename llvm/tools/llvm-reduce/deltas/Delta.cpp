@@ -29,6 +29,7 @@
 #include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/ToolOutputFile.h"
 #include <fstream>
+#include <limits>
 #include <set>
 
 using namespace llvm;
@@ -132,13 +133,16 @@ static bool increaseGranularity(std::vector<Chunk> &Chunks) {
 }
 
 // Check if \p ChunkToCheckForUninterestingness is interesting. Returns the
-// modified module if the chunk resulted in a reduction.
+// modified module if the chunk resulted in a reduction. If \p IsSuperseded is
+// given and returns true once the chunks have been extracted, the
+// interestingness test is skipped and null is returned.
 static std::unique_ptr<ReducerWorkItem>
 CheckChunk(Chunk &ChunkToCheckForUninterestingness,
            std::unique_ptr<ReducerWorkItem> Clone, TestRunner &Test,
            ReductionFunc ExtractChunksFromModule,
            DenseSet<Chunk> &UninterestingChunks,
-           std::vector<Chunk> &ChunksStillConsideredInteresting) {
+           std::vector<Chunk> &ChunksStillConsideredInteresting,
+           function_ref<bool()> IsSuperseded = {}) {
   // Take all of ChunksStillConsideredInteresting chunks, except those we've
   // already deemed uninteresting (UninterestingChunks) but didn't remove
   // from ChunksStillConsideredInteresting yet, and additionally ignore
@@ -178,6 +182,9 @@ CheckChunk(Chunk &ChunkToCheckForUninterestingness,
     errs() << "\n";
   }
 
+  if (IsSuperseded && IsSuperseded())
+    return nullptr;
+
   if (!isReduced(*Clone, Test)) {
     // Program became non-reduced, so this chunk appears to be interesting.
     if (Verbose)
@@ -187,11 +194,20 @@ CheckChunk(Chunk &ChunkToCheckForUninterestingness,
   return Clone;
 }
 
+/// Processes the chunk of the parallel task \p TaskIdx on a copy of the module
+/// parsed from \p OriginalBC. \p FirstReducedTask holds the index of the
+/// first task known to have reduced the program. The results of the tasks
+/// after it are discarded, so they stop as early as possible once it is set.
 static SmallString<0> ProcessChunkFromSerializedBitcode(
     Chunk &ChunkToCheckForUninterestingness, TestRunner &Test,
     ReductionFunc ExtractChunksFromModule, DenseSet<Chunk> &UninterestingChunks,
     std::vector<Chunk> &ChunksStillConsideredInteresting,
-    SmallString<0> &OriginalBC, std::atomic<bool> &AnyReduced) {
+    const SmallString<0> &OriginalBC, unsigned TaskIdx,
+    std::atomic<unsigned> &FirstReducedTask) {
+  const auto IsSuperseded = [&]() { return FirstReducedTask < TaskIdx; };
+  if (IsSuperseded())
+    return {};
+
   LLVMContext Ctx;
   auto CloneMMM = std::make_unique<ReducerWorkItem>();
   MemoryBufferRef Data(StringRef(OriginalBC), "<bc file>");
@@ -201,11 +217,14 @@ static SmallString<0> ProcessChunkFromSerializedBitcode(
   if (std::unique_ptr<ReducerWorkItem> ChunkResult =
           CheckChunk(ChunkToCheckForUninterestingness, std::move(CloneMMM),
                      Test, ExtractChunksFromModule, UninterestingChunks,
-                     ChunksStillConsideredInteresting)) {
+                     ChunksStillConsideredInteresting, IsSuperseded)) {
     raw_svector_ostream BCOS(Result);
     writeBitcode(*ChunkResult, BCOS);
     // Communicate that the task reduced a chunk.
-    AnyReduced = true;
+    unsigned Prev = FirstReducedTask;
+    while (TaskIdx < Prev &&
+           !FirstReducedTask.compare_exchange_weak(Prev, TaskIdx))
+      ;
   }
   return Result;
 }
@@ -260,11 +279,18 @@ void llvm::runDeltaPass(TestRunner &Test, ReductionFunc ExtractChunksFromModule,
     increaseGranularity(ChunksStillConsideredInteresting);
   }
 
-  std::atomic<bool> AnyReduced;
+  std::atomic<unsigned> FirstReducedTask;
   std::unique_ptr<ThreadPool> ChunkThreadPoolPtr;
-  if (NumJobs > 1)
+  // When running with more than one thread, serialize the original bitcode
+  // to OriginalBC. The program is only replaced at the end of the pass, so
+  // this is done once for all granularity levels.
+  SmallString<0> OriginalBC;
+  if (NumJobs > 1) {
     ChunkThreadPoolPtr =
         std::make_unique<ThreadPool>(hardware_concurrency(NumJobs));
+    raw_svector_ostream BCOS(OriginalBC);
+    writeBitcode(Test.getProgram(), BCOS);
+  }
 
   bool FoundAtLeastOneNewUninterestingChunkWithCurrentGranularity;
   do {
@@ -272,14 +298,6 @@ void llvm::runDeltaPass(TestRunner &Test, ReductionFunc ExtractChunksFromModule,
 
     DenseSet<Chunk> UninterestingChunks;
 
-    // When running with more than one thread, serialize the original bitcode
-    // to OriginalBC.
-    SmallString<0> OriginalBC;
-    if (NumJobs > 1) {
-      raw_svector_ostream BCOS(OriginalBC);
-      writeBitcode(Test.getProgram(), BCOS);
-    }
-
     std::deque<std::shared_future<SmallString<0>>> TaskQueue;
     for (auto I = ChunksStillConsideredInteresting.rbegin(),
               E = ChunksStillConsideredInteresting.rend();
@@ -296,7 +314,7 @@ void llvm::runDeltaPass(TestRunner &Test, ReductionFunc ExtractChunksFromModule,
         ThreadPool &ChunkThreadPool = *ChunkThreadPoolPtr;
         TaskQueue.clear();
 
-        AnyReduced = false;
+        FirstReducedTask = std::numeric_limits<unsigned>::max();
         // Queue jobs to process NumInitialTasks chunks in parallel using
         // ChunkThreadPool. When the tasks are added to the pool, parse the
         // original module from OriginalBC with a fresh LLVMContext object. This
@@ -306,11 +324,12 @@ void llvm::runDeltaPass(TestRunner &Test, ReductionFunc ExtractChunksFromModule,
         for (unsigned J = 0; J < NumInitialTasks; ++J) {
           TaskQueue.emplace_back(ChunkThreadPool.async(
               [J, I, &Test, &ExtractChunksFromModule, &UninterestingChunks,
-               &ChunksStillConsideredInteresting, &OriginalBC, &AnyReduced]() {
+               &ChunksStillConsideredInteresting, &OriginalBC,
+               &FirstReducedTask]() {
                 return ProcessChunkFromSerializedBitcode(
                     *(I + J), Test, ExtractChunksFromModule,
                     UninterestingChunks, ChunksStillConsideredInteresting,
-                    OriginalBC, AnyReduced);
+                    OriginalBC, J, FirstReducedTask);
               }));
         }
 
@@ -329,16 +348,18 @@ void llvm::runDeltaPass(TestRunner &Test, ReductionFunc ExtractChunksFromModule,
           TaskQueue.pop_front();
           if (Res.empty()) {
             unsigned NumScheduledTasks = NumChunksProcessed + TaskQueue.size();
+            bool AnyReduced =
+                FirstReducedTask != std::numeric_limits<unsigned>::max();
             if (!AnyReduced && I + NumScheduledTasks != E) {
               Chunk &ChunkToCheck = *(I + NumScheduledTasks);
               TaskQueue.emplace_back(ChunkThreadPool.async(
                   [&Test, &ExtractChunksFromModule, &UninterestingChunks,
                    &ChunksStillConsideredInteresting, &OriginalBC,
-                   &ChunkToCheck, &AnyReduced]() {
+                   &ChunkToCheck, NumScheduledTasks, &FirstReducedTask]() {
                     return ProcessChunkFromSerializedBitcode(
                         ChunkToCheck, Test, ExtractChunksFromModule,
                         UninterestingChunks, ChunksStillConsideredInteresting,
-                        OriginalBC, AnyReduced);
+                        OriginalBC, NumScheduledTasks, FirstReducedTask);
                   }));
             }
             continue;
@@ -350,6 +371,11 @@ void llvm::runDeltaPass(TestRunner &Test, ReductionFunc ExtractChunksFromModule,
                       Test.getToolName());
           break;
         }
+        // The tasks still in the queue come after the reduced chunk and their
+        // results are dropped, but they must finish before UninterestingChunks
+        // is updated. They skip the interestingness test if they haven't
+        // started it yet.
+        ChunkThreadPool.wait();
         // Forward I to the last chunk processed in parallel.
         I += NumChunksProcessed - 1;
       } else {
@@ -49,12 +49,22 @@ static cl::SubCommand InstructionCount(
   static cl::opt<std::string> OutputFileName(                                  \
       "o", cl::init("-"), cl::cat(RemarkUtilCategory), cl::desc("Output"),     \
       cl::value_desc("filename"), cl::sub(SUBOPT));
+#define FILTER_COMMAND_LINE_OPTIONS(SUBOPT)                                    \
+  static cl::opt<std::string> PassFilter(                                      \
+      "pass", cl::cat(RemarkUtilCategory),                                     \
+      cl::desc("Only process the remarks emitted by this pass"),               \
+      cl::value_desc("name"), cl::sub(SUBOPT));                                \
+  static cl::opt<std::string> FunctionFilter(                                  \
+      "function", cl::cat(RemarkUtilCategory),                                 \
+      cl::desc("Only process the remarks about this function"),                \
+      cl::value_desc("name"), cl::sub(SUBOPT));
 namespace yaml2bitstream {
 /// Remark format to parse.
 static constexpr Format InputFormat = Format::YAML;
 /// Remark format to output.
 static constexpr Format OutputFormat = Format::Bitstream;
 INPUT_OUTPUT_COMMAND_LINE_OPTIONS(subopts::YAML2Bitstream)
+FILTER_COMMAND_LINE_OPTIONS(subopts::YAML2Bitstream)
 } // namespace yaml2bitstream
 
 namespace bitstream2yaml {
@@ -63,6 +73,7 @@ static constexpr Format InputFormat = Format::Bitstream;
 /// Remark format to output.
 static constexpr Format OutputFormat = Format::YAML;
 INPUT_OUTPUT_COMMAND_LINE_OPTIONS(subopts::Bitstream2YAML)
+FILTER_COMMAND_LINE_OPTIONS(subopts::Bitstream2YAML)
 } // namespace bitstream2yaml
 
 namespace instructioncount {
@@ -72,6 +83,7 @@ static cl::opt<Format> InputFormat(
                clEnumValN(Format::Bitstream, "bitstream", "Bitstream")),
     cl::sub(subopts::InstructionCount));
 INPUT_OUTPUT_COMMAND_LINE_OPTIONS(subopts::InstructionCount)
+FILTER_COMMAND_LINE_OPTIONS(subopts::InstructionCount)
 } // namespace instructioncount
 
 /// \returns A MemoryBuffer for the input file on success, and an Error
@@ -86,6 +98,16 @@ getInputMemoryBuffer(StringRef InputFileName) {
   return std::move(*MaybeBuf);
 }
 
+/// Make \p Parser skip the remarks that do not match the -pass and -function
+/// options, so that they are not fully parsed.
+static void setFilters(RemarkParser &Parser, StringRef PassFilter,
+                       StringRef FunctionFilter) {
+  if (!PassFilter.empty())
+    Parser.PassNameFilter = PassFilter.str();
+  if (!FunctionFilter.empty())
+    Parser.FunctionNameFilter = FunctionFilter.str();
+}
+
 /// \returns A ToolOutputFile which can be used for outputting the results of
 /// some tool mode.
 /// \p OutputFileName is the desired destination.
@@ -131,6 +153,7 @@ tryParseRemarksFromYAMLFile(std::vector<std::unique_ptr<Remark>> &ParsedRemarks,
   if (!MaybeParser)
     return MaybeParser.takeError();
   auto &Parser = **MaybeParser;
+  setFilters(Parser, PassFilter, FunctionFilter);
   auto MaybeRemark = Parser.next();
   for (; MaybeRemark; MaybeRemark = Parser.next()) {
     StrTab.internalize(**MaybeRemark);
@@ -198,6 +221,7 @@ static Error tryBitstream2YAML() {
   if (!MaybeParser)
     return MaybeParser.takeError();
   auto &Parser = **MaybeParser;
+  setFilters(Parser, PassFilter, FunctionFilter);
 
   // Parse + reserialize all remarks.
   auto MaybeRemark = Parser.next();
@@ -233,6 +257,7 @@ static Error tryInstructionCount() {
   // Parse all remarks. Whenever we see an instruction count remark, output
   // the file name and the number of instructions.
   auto &Parser = **MaybeParser;
+  setFilters(Parser, PassFilter, FunctionFilter);
   auto MaybeRemark = Parser.next();
   for (; MaybeRemark; MaybeRemark = Parser.next()) {
     auto &Remark = **MaybeRemark;
@@ -15,6 +15,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "Opts.inc"
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Config/config.h"
@@ -36,6 +37,7 @@
 #include "llvm/Support/InitLLVM.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/StringSaver.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cstdio>
@@ -111,15 +113,16 @@ enum class Command {
 
 static void enableDebuginfod(LLVMSymbolizer &Symbolizer,
                              const opt::ArgList &Args) {
-  static bool IsEnabled = false;
-  if (IsEnabled)
+  static SmallPtrSet<LLVMSymbolizer *, 8> EnabledSymbolizers;
+  bool IsFirst = EnabledSymbolizers.empty();
+  if (!EnabledSymbolizers.insert(&Symbolizer).second)
     return;
-  IsEnabled = true;
   // Look up symbols using the debuginfod client.
   Symbolizer.setBuildIDFetcher(std::make_unique<DebuginfodFetcher>(
       Args.getAllArgValues(OPT_debug_file_directory_EQ)));
   // The HTTPClient must be initialized for use by the debuginfod client.
-  HTTPClient::initialize();
+  if (IsFirst)
+    HTTPClient::initialize();
 }
 
 static object::BuildID parseBuildID(StringRef Str) {
@@ -366,6 +369,80 @@ static object::BuildID parseBuildIDArg(const opt::InputArgList &Args, int ID) {
   return BuildID;
 }
 
+static std::unique_ptr<DIPrinter> createPrinter(OutputStyle Style,
+                                                raw_ostream &OS,
+                                                raw_ostream &ES,
+                                                PrinterConfig &Config) {
+  if (Style == OutputStyle::GNU)
+    return std::make_unique<GNUPrinter>(OS, ES, Config);
+  if (Style == OutputStyle::JSON)
+    return std::make_unique<JSONPrinter>(OS, Config);
+  return std::make_unique<LLVMPrinter>(OS, ES, Config);
+}
+
+// Symbolize stdin in batches, splitting each batch into one contiguous slice
+// per thread. Symbolizers are not thread-safe, so every thread has its own,
+// and the output of a batch is written in input order once it is complete.
+static void symbolizeStdinConcurrently(
+    const opt::InputArgList &Args, object::BuildIDRef BuildID,
+    uint64_t AdjustVMA, bool IsAddr2Line, OutputStyle Style,
+    const LLVMSymbolizer::Options &Opts, PrinterConfig &Config,
+    unsigned NumThreads) {
+  std::vector<std::unique_ptr<LLVMSymbolizer>> Symbolizers;
+  for (unsigned I = 0; I < NumThreads; ++I) {
+    Symbolizers.push_back(std::make_unique<LLVMSymbolizer>(Opts));
+    // Symbolizing a BUILDID: line turns debuginfod on lazily, which must not
+    // happen from the worker threads.
+    if (!Args.hasArg(OPT_no_debuginfod))
+      enableDebuginfod(*Symbolizers.back(), Args);
+  }
+
+  ThreadPool Pool(hardware_concurrency(NumThreads));
+  const size_t BatchSize = 4096 * NumThreads;
+  const int kMaxInputStringLength = 1024;
+  char InputString[kMaxInputStringLength];
+  std::vector<std::string> Lines;
+  bool AtEOF = false;
+  while (!AtEOF) {
+    Lines.clear();
+    while (Lines.size() < BatchSize) {
+      if (!fgets(InputString, sizeof(InputString), stdin)) {
+        AtEOF = true;
+        break;
+      }
+      // Strip newline characters.
+      std::string StrippedInputString(InputString);
+      llvm::erase_if(StrippedInputString,
+                     [](char c) { return c == '\r' || c == '\n'; });
+      Lines.push_back(std::move(StrippedInputString));
+    }
+
+    std::vector<std::string> Outputs(Lines.size());
+    std::vector<std::string> Errors(Lines.size());
+    size_t SliceSize = divideCeil(Lines.size(), NumThreads);
+    for (unsigned T = 0; T < NumThreads; ++T) {
+      Pool.async([&, T] {
+        size_t End = std::min(Lines.size(), (T + 1) * SliceSize);
+        for (size_t I = T * SliceSize; I < End; ++I) {
+          raw_string_ostream OS(Outputs[I]);
+          raw_string_ostream ES(Errors[I]);
+          std::unique_ptr<DIPrinter> Printer =
+              createPrinter(Style, OS, ES, Config);
+          symbolizeInput(Args, BuildID, AdjustVMA, IsAddr2Line, Style,
+                         Lines[I], *Symbolizers[T], *Printer);
+        }
+      });
+    }
+    Pool.wait();
+
+    for (size_t I = 0; I < Lines.size(); ++I) {
+      errs() << Errors[I];
+      outs() << Outputs[I];
+    }
+    outs().flush();
+  }
+}
+
 // Symbolize markup from stdin and write the result to stdout.
 static void filterMarkup(const opt::InputArgList &Args, LLVMSymbolizer &Symbolizer) {
   MarkupFilter Filter(outs(), Symbolizer, parseColorArg(Args));
@@ -402,6 +479,7 @@ int main(int argc, char **argv) {
     Opts.PathStyle = DILineInfoSpecifier::FileLineInfoKind::AbsoluteFilePath;
   }
   Opts.DebugFileDirectory = Args.getAllArgValues(OPT_debug_file_directory_EQ);
+  Opts.GsymCacheDirectory = Args.getLastArgValue(OPT_gsym_cache_dir_EQ).str();
   Opts.DefaultArch = Args.getLastArgValue(OPT_default_arch_EQ).str();
   Opts.Demangle = Args.hasFlag(OPT_demangle, OPT_no_demangle, !IsAddr2Line);
   Opts.DWPName = Args.getLastArgValue(OPT_dwp_EQ).str();
@@ -423,6 +501,9 @@ int main(int argc, char **argv) {
   Opts.UseSymbolTable = true;
   if (Args.hasArg(OPT_cache_size_EQ))
     parseIntArg(Args, OPT_cache_size_EQ, Opts.MaxCacheSize);
+  unsigned NumThreads = 1;
+  if (Args.hasArg(OPT_threads_EQ))
+    parseIntArg(Args, OPT_threads_EQ, NumThreads);
   Config.PrintAddress = Args.hasArg(OPT_addresses);
   Config.PrintFunctions = Opts.PrintFunctions != FunctionNameKind::None;
   Config.Pretty = Args.hasArg(OPT_pretty_print);
@@ -470,16 +551,14 @@ int main(int argc, char **argv) {
   }
   object::BuildID BuildID = parseBuildIDArg(Args, OPT_build_id_EQ);
 
-  std::unique_ptr<DIPrinter> Printer;
-  if (Style == OutputStyle::GNU)
-    Printer = std::make_unique<GNUPrinter>(outs(), errs(), Config);
-  else if (Style == OutputStyle::JSON)
-    Printer = std::make_unique<JSONPrinter>(outs(), Config);
-  else
-    Printer = std::make_unique<LLVMPrinter>(outs(), errs(), Config);
+  std::unique_ptr<DIPrinter> Printer =
+      createPrinter(Style, outs(), errs(), Config);
 
   std::vector<std::string> InputAddresses = Args.getAllArgValues(OPT_INPUT);
-  if (InputAddresses.empty()) {
+  if (InputAddresses.empty() && NumThreads > 1) {
+    symbolizeStdinConcurrently(Args, BuildID, AdjustVMA, IsAddr2Line, Style,
+                               Opts, Config, NumThreads);
+  } else if (InputAddresses.empty()) {
     const int kMaxInputStringLength = 1024;
     char InputString[kMaxInputStringLength];
 
@@ -0,0 +1,103 @@
+//===- llvm/unittest/ADT/ConcurrentStringMapTest.cpp ----------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/ConcurrentStringMap.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Config/llvm-config.h"
+#include "gtest/gtest.h"
+#include <thread>
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+
+TEST(ConcurrentStringMapTest, Basic) {
+  ConcurrentStringMap<int> Map(3);
+  EXPECT_EQ(4u, Map.getNumShards());
+  EXPECT_TRUE(Map.empty());
+  EXPECT_EQ(nullptr, Map.find("foo"));
+
+  auto [Foo, Inserted] = Map.try_emplace("foo", 1);
+  EXPECT_TRUE(Inserted);
+  EXPECT_EQ("foo", Foo->getKey());
+  EXPECT_EQ(1, Foo->getValue());
+
+  // A second insertion returns the existing entry.
+  auto [Foo2, Inserted2] = Map.try_emplace("foo", 2);
+  EXPECT_FALSE(Inserted2);
+  EXPECT_EQ(Foo, Foo2);
+  EXPECT_EQ(1, Foo2->getValue());
+
+  Map.try_emplace("bar", 3);
+  EXPECT_EQ(2u, Map.size());
+  EXPECT_EQ(Foo, Map.find("foo"));
+  ASSERT_NE(nullptr, Map.find("bar"));
+  EXPECT_EQ(3, Map.find("bar")->getValue());
+
+  int Sum = 0;
+  Map.forEach([&](StringMapEntry<int> &E) { Sum += E.getValue(); });
+  EXPECT_EQ(4, Sum);
+}
+
+TEST(ConcurrentStringMapTest, SingleShard) {
+  ConcurrentStringMap<int> Map(1);
+  EXPECT_EQ(1u, Map.getNumShards());
+  for (int I = 0; I != 100; ++I)
+    Map.try_emplace(utostr(I), I);
+  EXPECT_EQ(100u, Map.size());
+  EXPECT_EQ(42, Map.find("42")->getValue());
+}
+
+TEST(ConcurrentStringMapTest, StableEntries) {
+  ConcurrentStringMap<int> Map(2);
+  StringMapEntry<int> *First = Map.try_emplace("first", 0).first;
+  // Force several rehashes of the shard that holds "first".
+  for (int I = 0; I != 10000; ++I)
+    Map.try_emplace(utostr(I), I);
+  EXPECT_EQ(First, Map.find("first"));
+  EXPECT_EQ("first", First->getKey());
+}
+
+#if LLVM_ENABLE_THREADS
+TEST(ConcurrentStringMapTest, ConcurrentInsert) {
+  // Every thread inserts the same set of keys. Each key must end up in the
+  // map exactly once, and every thread must get the same entry for it.
+  constexpr unsigned NumThreads = 8;
+  constexpr unsigned NumKeys = 5000;
+  ConcurrentStringMap<unsigned> Map;
+  std::vector<std::vector<StringMapEntry<unsigned> *>> Entries(NumThreads);
+  std::vector<unsigned> NumInserted(NumThreads, 0);
+  std::vector<std::thread> Threads;
+  for (unsigned T = 0; T != NumThreads; ++T)
+    Threads.emplace_back([&, T] {
+      for (unsigned K = 0; K != NumKeys; ++K) {
+        auto [E, Inserted] = Map.try_emplace("key" + utostr(K), K);
+        Entries[T].push_back(E);
+        NumInserted[T] += Inserted;
+      }
+    });
+  for (std::thread &T : Threads)
+    T.join();
+
+  unsigned TotalInserted = 0;
+  for (unsigned N : NumInserted)
+    TotalInserted += N;
+  EXPECT_EQ(NumKeys, TotalInserted);
+  EXPECT_EQ(NumKeys, Map.size());
+  for (unsigned K = 0; K != NumKeys; ++K) {
+    StringMapEntry<unsigned> *E = Map.find("key" + utostr(K));
+    ASSERT_NE(nullptr, E);
+    EXPECT_EQ(K, E->getValue());
+    for (unsigned T = 0; T != NumThreads; ++T)
+      EXPECT_EQ(E, Entries[T][K]);
+  }
+}
+#endif
+
+} // end anonymous namespace
@@ -0,0 +1,199 @@
+//===- llvm/unittest/ADT/FlatHashMapTest.cpp - FlatHashMap unit tests -----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/FlatHashMap.h"
+#include "gtest/gtest.h"
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+
+using namespace llvm;
+
+namespace {
+
+TEST(FlatHashMapTest, EmptyMap) {
+  FlatHashMap<int, int> Map;
+  EXPECT_TRUE(Map.empty());
+  EXPECT_EQ(0u, Map.size());
+  EXPECT_EQ(0u, Map.getNumBuckets());
+  EXPECT_TRUE(Map.begin() == Map.end());
+  EXPECT_FALSE(Map.contains(0));
+  EXPECT_TRUE(Map.find(0) == Map.end());
+  EXPECT_EQ(0, Map.lookup(0));
+  EXPECT_FALSE(Map.erase(0));
+  Map.clear();
+  EXPECT_TRUE(Map.empty());
+}
+
+TEST(FlatHashMapTest, InsertFindErase) {
+  FlatHashMap<int, int> Map;
+  // DenseMapInfo<int> reserves these values, FlatHashMap does not.
+  int EmptyKey = DenseMapInfo<int>::getEmptyKey();
+  int TombstoneKey = DenseMapInfo<int>::getTombstoneKey();
+
+  EXPECT_TRUE(Map.insert({1, 10}).second);
+  EXPECT_TRUE(Map.try_emplace(EmptyKey, 20).second);
+  EXPECT_TRUE(Map.try_emplace(TombstoneKey, 30).second);
+  EXPECT_FALSE(Map.insert({1, 40}).second);
+  EXPECT_EQ(3u, Map.size());
+
+  EXPECT_EQ(10, Map.lookup(1));
+  EXPECT_EQ(20, Map.find(EmptyKey)->second);
+  EXPECT_EQ(30, Map[TombstoneKey]);
+  EXPECT_EQ(1u, Map.count(1));
+  EXPECT_EQ(0u, Map.count(2));
+
+  EXPECT_TRUE(Map.erase(EmptyKey));
+  EXPECT_FALSE(Map.erase(EmptyKey));
+  Map.erase(Map.find(1));
+  EXPECT_EQ(1u, Map.size());
+  EXPECT_FALSE(Map.contains(1));
+  EXPECT_TRUE(Map.contains(TombstoneKey));
+
+  Map[2] = 50;
+  EXPECT_EQ(50, Map.lookup(2));
+  EXPECT_EQ(2u, Map.size());
+}
+
+TEST(FlatHashMapTest, MatchesStdMap) {
+  FlatHashMap<unsigned, unsigned> Map;
+  std::map<unsigned, unsigned> Expected;
+  std::mt19937 Rng(0);
+  for (unsigned I = 0; I != 20000; ++I) {
+    unsigned Key = Rng() % 4096;
+    if (Rng() % 3 == 0) {
+      EXPECT_EQ(Expected.erase(Key) != 0, Map.erase(Key));
+    } else {
+      Expected[Key] = I;
+      Map[Key] = I;
+    }
+  }
+  EXPECT_EQ(Expected.size(), Map.size());
+  for (const auto &KV : Expected)
+    EXPECT_EQ(KV.second, Map.lookup(KV.first));
+
+  unsigned Visited = 0;
+  for (const auto &KV : Map) {
+    EXPECT_EQ(Expected[KV.first], KV.second);
+    ++Visited;
+  }
+  EXPECT_EQ(Expected.size(), Visited);
+}
+
+// All keys collide, so lookups have to probe across many groups.
+struct CollidingInfo {
+  static unsigned getHashValue(int) { return 0; }
+  static bool isEqual(int LHS, int RHS) { return LHS == RHS; }
+};
+
+TEST(FlatHashMapTest, Collisions) {
+  FlatHashMap<int, int, CollidingInfo> Map;
+  for (int I = 0; I != 200; ++I)
+    Map[I] = I * 2;
+  for (int I = 0; I < 200; I += 2)
+    EXPECT_TRUE(Map.erase(I));
+  EXPECT_EQ(100u, Map.size());
+  for (int I = 0; I != 200; ++I)
+    EXPECT_EQ(I % 2 ? I * 2 : 0, Map.lookup(I));
+
+  // Reinsert into the deleted buckets.
+  for (int I = 0; I < 200; I += 2)
+    Map[I] = I;
+  EXPECT_EQ(200u, Map.size());
+  for (int I = 0; I != 200; ++I)
+    EXPECT_EQ(I % 2 ? I * 2 : I, Map.lookup(I));
+}
+
+TEST(FlatHashMapTest, EraseAndInsertDoesNotGrow) {
+  FlatHashMap<int, int> Map;
+  Map.reserve(100);
+  unsigned NumBuckets = Map.getNumBuckets();
+  for (int I = 0; I != 10000; ++I) {
+    Map[I] = I;
+    if (I >= 50) {
+      EXPECT_TRUE(Map.erase(I - 50));
+    }
+  }
+  EXPECT_EQ(50u, Map.size());
+  EXPECT_EQ(NumBuckets, Map.getNumBuckets());
+}
+
+TEST(FlatHashMapTest, Reserve) {
+  FlatHashMap<int, int> Map;
+  Map.reserve(1000);
+  unsigned NumBuckets = Map.getNumBuckets();
+  for (int I = 0; I != 1000; ++I)
+    Map[I] = I;
+  EXPECT_EQ(NumBuckets, Map.getNumBuckets());
+}
+
+// Allows looking up std::string keys by StringRef.
+struct StringInfo {
+  static unsigned getHashValue(const std::string &S) {
+    return getHashValue(StringRef(S));
+  }
+  static unsigned getHashValue(StringRef S) { return hash_value(S); }
+  static bool isEqual(StringRef LHS, const std::string &RHS) {
+    return LHS == RHS;
+  }
+  static bool isEqual(const std::string &LHS, const std::string &RHS) {
+    return LHS == RHS;
+  }
+};
+
+TEST(FlatHashMapTest, NonTrivialValues) {
+  using MapT = FlatHashMap<std::string, std::unique_ptr<int>, StringInfo>;
+  MapT Map;
+  for (int I = 0; I != 100; ++I)
+    Map.try_emplace(std::to_string(I), std::make_unique<int>(I));
+  EXPECT_EQ(42, *Map.find("42")->second);
+
+  MapT Moved(std::move(Map));
+  EXPECT_TRUE(Map.empty());
+  EXPECT_EQ(100u, Moved.size());
+  EXPECT_EQ(7, *Moved.find("7")->second);
+  Moved.erase("7");
+  Moved.clear();
+  EXPECT_TRUE(Moved.empty());
+}
+
+TEST(FlatHashMapTest, CopyAndSwap) {
+  FlatHashMap<int, std::string> Map = {{1, "one"}, {2, "two"}};
+  FlatHashMap<int, std::string> Copy(Map);
+  Copy[3] = "three";
+  EXPECT_EQ(2u, Map.size());
+  EXPECT_EQ(3u, Copy.size());
+  EXPECT_EQ("two", Copy.lookup(2));
+
+  swap(Map, Copy);
+  EXPECT_EQ(3u, Map.size());
+  EXPECT_EQ(2u, Copy.size());
+
+  Copy = Map;
+  EXPECT_EQ("three", Copy.lookup(3));
+}
+
+TEST(FlatHashMapTest, ConstIterator) {
+  FlatHashMap<int, int> Map = {{1, 2}};
+  FlatHashMap<int, int>::const_iterator CI = Map.find(1);
+  EXPECT_TRUE(CI == Map.begin());
+  EXPECT_EQ(2, CI->second);
+  const FlatHashMap<int, int> &ConstMap = Map;
+  EXPECT_TRUE(ConstMap.find(1) == CI);
+  EXPECT_TRUE(ConstMap.find(2) == ConstMap.end());
+}
+
+TEST(FlatHashMapTest, FindAs) {
+  FlatHashMap<std::string, int, StringInfo> Map;
+  Map["foo"] = 1;
+  EXPECT_EQ(1, Map.find_as(StringRef("foo"))->second);
+  EXPECT_TRUE(Map.find_as(StringRef("bar")) == Map.end());
+}
+
+} // namespace
@@ -288,6 +288,22 @@ TEST_F(StringMapTest, InsertRehashingPairTest) {
   EXPECT_EQ(42u, It->second);
 }
 
+TEST_F(StringMapTest, PrecomputedHashTest) {
+  StringMap<int> t;
+  uint32_t Hash = StringMapImpl::hash("key");
+  auto [It, Inserted] = t.try_emplace_with_hash("key", Hash, 1);
+  EXPECT_TRUE(Inserted);
+  EXPECT_EQ(1, It->second);
+  EXPECT_EQ(It, t.find("key"));
+  EXPECT_EQ(It, t.find("key", Hash));
+  EXPECT_EQ(t.end(), t.find("other", StringMapImpl::hash("other")));
+
+  auto [It2, Inserted2] = t.try_emplace_with_hash("key", Hash, 2);
+  EXPECT_FALSE(Inserted2);
+  EXPECT_EQ(It, It2);
+  EXPECT_EQ(1, It2->second);
+}
+
 TEST_F(StringMapTest, InsertOrAssignTest) {
   struct A : CountCopyAndMove {
     A(int v) : v(v) {}
@@ -296,6 +296,50 @@ TEST_F(AliasAnalysisTest, BatchAAPhiAssumption) {
   EXPECT_EQ(AliasResult::MayAlias, BatchAA.alias(ANextLoc, BNextLoc));
 }
 
+// Querying one location against many in batch mode reuses the decomposition
+// of the GEPs; the results must match individual queries.
+TEST_F(AliasAnalysisTest, BatchAAOneToMany) {
+  LLVMContext C;
+  SMDiagnostic Err;
+  std::unique_ptr<Module> M = parseAssemblyString(R"(
+    define void @f(ptr noalias %a, ptr %b, i64 %i) {
+    entry:
+      %a0 = getelementptr i32, ptr %a, i64 %i
+      %i1 = add nsw i64 %i, 1
+      %a1 = getelementptr i32, ptr %a, i64 %i1
+      %a2 = getelementptr i8, ptr %a0, i64 2
+      %b0 = getelementptr i32, ptr %b, i64 %i
+      ret void
+    }
+  )", Err, C);
+
+  Function *F = M->getFunction("f");
+  MemoryLocation A0Loc(getInstructionByName(*F, "a0"),
+                       LocationSize::precise(4));
+  SmallVector<MemoryLocation, 4> Locs;
+  for (StringRef Name : {"a0", "a1", "a2", "b0"})
+    Locs.push_back(MemoryLocation(getInstructionByName(*F, Name),
+                                  LocationSize::precise(4)));
+
+  auto &AA = getAAResults(*F);
+  BatchAAResults BatchAA(AA);
+  SmallVector<AliasResult, 4> Results;
+  BatchAA.alias(A0Loc, Locs, Results);
+  ASSERT_EQ(Locs.size(), Results.size());
+  EXPECT_EQ(AliasResult::MustAlias, Results[0]);
+  EXPECT_EQ(AliasResult::NoAlias, Results[1]);
+  EXPECT_EQ(AliasResult::PartialAlias, Results[2]);
+  EXPECT_EQ(AliasResult::NoAlias, Results[3]);
+  for (unsigned I = 0; I != Locs.size(); ++I)
+    EXPECT_EQ(AA.alias(A0Loc, Locs[I]), Results[I]);
+
+  // Asking again hits the cached decompositions.
+  Results.clear();
+  BatchAA.alias(A0Loc, Locs, Results);
+  for (unsigned I = 0; I != Locs.size(); ++I)
+    EXPECT_EQ(AA.alias(A0Loc, Locs[I]), Results[I]);
+}
+
 // Check that two aliased GEPs with non-constant offsets are correctly
 // analyzed and their relative offset can be requested from AA.
 TEST_F(AliasAnalysisTest, PartialAliasOffset) {
@@ -0,0 +1,75 @@
+//===- EphemeralValuesCacheTest.cpp - EphemeralValuesCache unit tests -----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Analysis/EphemeralValuesCache.h"
+#include "llvm/Analysis/AssumptionCache.h"
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/PassManager.h"
+#include "llvm/Support/SourceMgr.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+std::unique_ptr<Module> parseIR(LLVMContext &C, const char *IR) {
+  SMDiagnostic Err;
+  std::unique_ptr<Module> Mod = parseAssemblyString(IR, Err, C);
+  if (!Mod)
+    Err.print("EphemeralValuesCacheTest", errs());
+  return Mod;
+}
+
+TEST(EphemeralValuesCacheTest, CollectsAssumeOnlyValues) {
+  LLVMContext C;
+  std::unique_ptr<Module> M = parseIR(C, R"IR(
+declare void @llvm.assume(i1)
+
+define i32 @foo(i32 %a, i32 %b) {
+  %cmp = icmp ne i32 %a, 0
+  call void @llvm.assume(i1 %cmp)
+  %add = add i32 %a, %b
+  ret i32 %add
+}
+)IR");
+  ASSERT_TRUE(M);
+  Function *F = M->getFunction("foo");
+  ASSERT_TRUE(F);
+
+  FunctionAnalysisManager FAM;
+  FAM.registerPass([] { return AssumptionAnalysis(); });
+  FAM.registerPass([] { return EphemeralValuesAnalysis(); });
+
+  BasicBlock &BB = F->getEntryBlock();
+  auto It = BB.begin();
+  Instruction *Cmp = &*It++;
+  Instruction *Assume = &*It++;
+  Instruction *Add = &*It++;
+
+  EphemeralValuesCache &EVC = FAM.getResult<EphemeralValuesAnalysis>(*F);
+  const SmallPtrSetImpl<const Value *> &EphValues = EVC.ephValues();
+  EXPECT_TRUE(EphValues.contains(Cmp));
+  EXPECT_TRUE(EphValues.contains(Assume));
+  EXPECT_FALSE(EphValues.contains(Add));
+
+  // The second query returns the same cached set.
+  EXPECT_EQ(&EVC.ephValues(), &EphValues);
+
+  // Clearing the cache forces a recollection on the next query.
+  EVC.clear();
+  EXPECT_TRUE(EVC.ephValues().contains(Cmp));
+
+  // Any change to the function invalidates the cache.
+  FAM.invalidate(*F, PreservedAnalyses::none());
+  EXPECT_EQ(FAM.getCachedResult<EphemeralValuesAnalysis>(*F), nullptr);
+}
+
+} // namespace
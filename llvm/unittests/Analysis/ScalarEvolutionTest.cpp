@@ -58,6 +58,10 @@ protected:
     Test(*F, *LI, SE);
   }
 
+  static const SCEV *getExistingSCEV(ScalarEvolution &SE, Value *V) {
+    return SE.getExistingSCEV(V);
+  }
+
   static Optional<APInt> computeConstantDifference(ScalarEvolution &SE,
                                                    const SCEV *LHS,
                                                    const SCEV *RHS) {
@@ -893,6 +897,44 @@ TEST_F(ScalarEvolutionsTest, SCEVExitLimitForgetValue) {
   EXPECT_EQ(cast<SCEVConstant>(NewEC)->getAPInt().getLimitedValue(), 1999u);
 }
 
+// Make sure that forgetValue only drops the SCEVs that may depend on the value,
+// and not those that only see it through a non-SCEVable instruction.
+TEST_F(ScalarEvolutionsTest, SCEVForgetValueStopsAtNonSCEVable) {
+  LLVMContext C;
+  SMDiagnostic Err;
+  std::unique_ptr<Module> M = parseAssemblyString(
+      "define void @f(i64 %x) { "
+      "entry: "
+      "  %a = add i64 %x, 1 "
+      "  %b = mul i64 %a, 3 "
+      "  %f = sitofp i64 %a to double "
+      "  %i = fptosi double %f to i64 "
+      "  %c = add i64 %i, 1 "
+      "  ret void "
+      "} ",
+      Err, C);
+
+  ASSERT_TRUE(M && "Could not parse module?");
+  ASSERT_TRUE(!verifyModule(*M) && "Must have been well formed!");
+
+  runWithSE(*M, "f", [&](Function &F, LoopInfo &LI, ScalarEvolution &SE) {
+    auto *A = getInstructionByName(F, "a");
+    auto *B = getInstructionByName(F, "b");
+    auto *I = getInstructionByName(F, "i");
+    auto *Cc = getInstructionByName(F, "c");
+    SE.getSCEV(B);
+    SE.getSCEV(Cc);
+    ASSERT_NE(getExistingSCEV(SE, A), nullptr);
+    ASSERT_NE(getExistingSCEV(SE, I), nullptr);
+
+    SE.forgetValue(A);
+    EXPECT_EQ(getExistingSCEV(SE, A), nullptr);
+    EXPECT_EQ(getExistingSCEV(SE, B), nullptr);
+    EXPECT_NE(getExistingSCEV(SE, I), nullptr);
+    EXPECT_NE(getExistingSCEV(SE, Cc), nullptr);
+  });
+}
+
 TEST_F(ScalarEvolutionsTest, SCEVAddRecFromPHIwithLargeConstants) {
   // Reference: https://reviews.llvm.org/D37265
   // Make sure that SCEV does not blow up when constructing an AddRec
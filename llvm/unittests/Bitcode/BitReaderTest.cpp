@@ -11,6 +11,7 @@
 #include "llvm/AsmParser/Parser.h"
 #include "llvm/Bitcode/BitcodeReader.h"
 #include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/IR/DebugInfoMetadata.h"
 #include "llvm/IR/InstrTypes.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
@@ -255,4 +256,61 @@ TEST(BitReaderTest, MaterializeFunctionsForBlockAddrInFunctionAfter) {
   EXPECT_FALSE(verifyModule(*M, &dbgs()));
 }
 
+// Tests that loading bitcode for importing skips the lists on compile units
+// that importing drops anyway, but keeps the imported entities.
+TEST(BitReaderTest, ImportingSkipsCompileUnitLists) {
+  const char *Assembly =
+      "define void @f() !dbg !10 {\n"
+      "  ret void\n"
+      "}\n"
+      "!llvm.dbg.cu = !{!0}\n"
+      "!llvm.module.flags = !{!13}\n"
+      "!0 = distinct !DICompileUnit(language: DW_LANG_C99, file: !1, "
+      "emissionKind: FullDebug, enums: !2, retainedTypes: !5, globals: !6, "
+      "imports: !9)\n"
+      "!1 = !DIFile(filename: \"t.c\", directory: \"/\")\n"
+      "!2 = !{!3}\n"
+      "!3 = !DICompositeType(tag: DW_TAG_enumeration_type, name: \"E\", "
+      "file: !1, elements: !4)\n"
+      "!4 = !{}\n"
+      "!5 = !{!12}\n"
+      "!6 = !{!7}\n"
+      "!7 = !DIGlobalVariableExpression(var: !8, expr: !DIExpression())\n"
+      "!8 = distinct !DIGlobalVariable(name: \"g\", scope: !0, file: !1, "
+      "type: !12, isDefinition: true)\n"
+      "!9 = !{!14}\n"
+      "!10 = distinct !DISubprogram(name: \"f\", scope: !1, file: !1, "
+      "type: !11, spFlags: DISPFlagDefinition, unit: !0)\n"
+      "!11 = !DISubroutineType(types: !4)\n"
+      "!12 = !DIBasicType(name: \"int\", size: 32, encoding: DW_ATE_signed)\n"
+      "!13 = !{i32 2, !\"Debug Info Version\", i32 3}\n"
+      "!14 = !DIImportedEntity(tag: DW_TAG_imported_declaration, scope: !10, "
+      "entity: !8)\n";
+  SmallString<1024> Mem;
+  LLVMContext Context;
+  writeModuleToBuffer(parseAssembly(Context, Assembly), Mem);
+
+  auto getCU = [&](bool IsImporting) {
+    std::unique_ptr<Module> M = cantFail(
+        getLazyBitcodeModule(MemoryBufferRef(Mem.str(), "test"), Context,
+                             /*ShouldLazyLoadMetadata=*/true, IsImporting));
+    EXPECT_FALSE(M->materializeMetadata());
+    auto *CU = cast<DICompileUnit>(
+        M->getNamedMetadata("llvm.dbg.cu")->getOperand(0));
+    return std::make_pair(std::move(M), CU);
+  };
+
+  auto [M, CU] = getCU(/*IsImporting=*/false);
+  EXPECT_EQ(CU->getEnumTypes().size(), 1u);
+  EXPECT_EQ(CU->getRetainedTypes().size(), 1u);
+  EXPECT_EQ(CU->getGlobalVariables().size(), 1u);
+  EXPECT_EQ(CU->getImportedEntities().size(), 1u);
+
+  auto [ImportM, ImportCU] = getCU(/*IsImporting=*/true);
+  EXPECT_TRUE(ImportCU->getEnumTypes().empty());
+  EXPECT_TRUE(ImportCU->getRetainedTypes().empty());
+  EXPECT_TRUE(ImportCU->getGlobalVariables().empty());
+  EXPECT_EQ(ImportCU->getImportedEntities().size(), 1u);
+}
+
 } // end namespace
@@ -30,8 +30,10 @@
 #include "llvm/Support/Error.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Testing/Support/Error.h"
 #include "gtest/gtest.h"
+#include <atomic>
 #include <string>
 
 using namespace llvm;
@@ -2166,4 +2168,126 @@ TEST(DWARFDebugInfo, TestDWARF64UnitLength) {
   });
 }
 
+TEST(DWARFDebugInfo, TestConcurrentAddressLookups) {
+  // Four compile units at 0x1000, 0x2000, 0x3000 and 0x4000, each with two
+  // subprograms covering one half of the unit.
+  const char *yamldata = R"(
+    debug_abbrev:
+      - Table:
+          - Code:            0x1
+            Tag:             DW_TAG_compile_unit
+            Children:        DW_CHILDREN_yes
+            Attributes:
+              - Attribute:       DW_AT_low_pc
+                Form:            DW_FORM_addr
+              - Attribute:       DW_AT_high_pc
+                Form:            DW_FORM_data4
+          - Code:            0x2
+            Tag:             DW_TAG_subprogram
+            Children:        DW_CHILDREN_no
+            Attributes:
+              - Attribute:       DW_AT_low_pc
+                Form:            DW_FORM_addr
+              - Attribute:       DW_AT_high_pc
+                Form:            DW_FORM_data4
+    debug_info:
+      - Version:         4
+        AddrSize:        8
+        Entries:
+          - AbbrCode:        0x1
+            Values:
+              - Value:           0x1000
+              - Value:           0x1000
+          - AbbrCode:        0x2
+            Values:
+              - Value:           0x1000
+              - Value:           0x800
+          - AbbrCode:        0x2
+            Values:
+              - Value:           0x1800
+              - Value:           0x800
+          - AbbrCode:        0x0
+      - Version:         4
+        AddrSize:        8
+        Entries:
+          - AbbrCode:        0x1
+            Values:
+              - Value:           0x2000
+              - Value:           0x1000
+          - AbbrCode:        0x2
+            Values:
+              - Value:           0x2000
+              - Value:           0x800
+          - AbbrCode:        0x2
+            Values:
+              - Value:           0x2800
+              - Value:           0x800
+          - AbbrCode:        0x0
+      - Version:         4
+        AddrSize:        8
+        Entries:
+          - AbbrCode:        0x1
+            Values:
+              - Value:           0x3000
+              - Value:           0x1000
+          - AbbrCode:        0x2
+            Values:
+              - Value:           0x3000
+              - Value:           0x800
+          - AbbrCode:        0x2
+            Values:
+              - Value:           0x3800
+              - Value:           0x800
+          - AbbrCode:        0x0
+      - Version:         4
+        AddrSize:        8
+        Entries:
+          - AbbrCode:        0x1
+            Values:
+              - Value:           0x4000
+              - Value:           0x1000
+          - AbbrCode:        0x2
+            Values:
+              - Value:           0x4000
+              - Value:           0x800
+          - AbbrCode:        0x2
+            Values:
+              - Value:           0x4800
+              - Value:           0x800
+          - AbbrCode:        0x0
+  )";
+  Expected<StringMap<std::unique_ptr<MemoryBuffer>>> Sections =
+      DWARFYAML::emitDebugSections(StringRef(yamldata),
+                                   /*IsLittleEndian=*/true,
+                                   /*Is64BitAddrSize=*/true);
+  ASSERT_THAT_EXPECTED(Sections, Succeeded());
+  std::unique_ptr<DWARFContext> Ctx =
+      DWARFContext::create(*Sections, 8, /*isLittleEndian=*/true);
+
+  // All threads start from a context that has not parsed anything yet, so
+  // the units, DIEs, address ranges and subroutine maps are built while they
+  // race.
+  std::atomic<unsigned> Mismatches{0};
+  ThreadPool Pool(hardware_concurrency(4));
+  for (unsigned I = 0; I < 4; ++I)
+    Pool.async([&] {
+      for (uint64_t Addr = 0x1000; Addr < 0x5000; Addr += 0x40) {
+        DWARFContext::DIEsForAddress DIEs = Ctx->getDIEsForAddress(Addr);
+        if (!DIEs.CompileUnit || !DIEs.FunctionDIE) {
+          ++Mismatches;
+          continue;
+        }
+        Optional<object::SectionedAddress> Base =
+            DIEs.CompileUnit->getBaseAddress();
+        if (!Base || Base->Address != (Addr & ~uint64_t(0xfff)) ||
+            toAddress(DIEs.FunctionDIE.find(DW_AT_low_pc)) !=
+                (Addr & ~uint64_t(0x7ff)))
+          ++Mismatches;
+      }
+    });
+  Pool.wait();
+  EXPECT_EQ(0u, Mismatches);
+  EXPECT_EQ(4u, Ctx->getNumCompileUnits());
+}
+
 } // end anonymous namespace
@@ -15,6 +15,7 @@
 #include "llvm/DebugInfo/GSYM/FileWriter.h"
 #include "llvm/DebugInfo/GSYM/FunctionInfo.h"
 #include "llvm/DebugInfo/GSYM/GsymCreator.h"
+#include "llvm/DebugInfo/GSYM/GsymDIContext.h"
 #include "llvm/DebugInfo/GSYM/GsymReader.h"
 #include "llvm/DebugInfo/GSYM/Header.h"
 #include "llvm/DebugInfo/GSYM/InlineInfo.h"
@@ -23,6 +24,7 @@
 #include "llvm/Support/DataExtractor.h"
 #include "llvm/Support/Endian.h"
 #include "llvm/Testing/Support/Error.h"
+#include "llvm/Testing/Support/SupportHelpers.h"
 
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
@@ -2443,3 +2445,130 @@ TEST(GSYMTest, TestGsymCreatorMultipleSymbolsWithNoSize) {
                    1, // NumAddresses
                    ArrayRef<uint8_t>(UUID));
 }
+
+static void AddSpillTestFunctions(GsymCreator &GC) {
+  // Add functions out of order, with a symbol and a debug info entry for the
+  // same range, an exact duplicate, an overlap and a zero sized last symbol.
+  const uint32_t FileIdx = GC.insertFile("/tmp/main.c");
+  FunctionInfo Rich(0x1100, 0x100, GC.insertString("rich"));
+  AddLines(0x1100, FileIdx, Rich);
+  AddInline(0x1100, 0x100, Rich);
+  FunctionInfo RichCopy = Rich;
+  GC.addFunctionInfo(FunctionInfo(0x2000, 0, GC.insertString("last")));
+  GC.addFunctionInfo(std::move(Rich));
+  GC.addFunctionInfo(FunctionInfo(0x1100, 0x100, GC.insertString("rich")));
+  GC.addFunctionInfo(std::move(RichCopy));
+  GC.addFunctionInfo(FunctionInfo(0x1000, 0x80, GC.insertString("first")));
+  GC.addFunctionInfo(FunctionInfo(0x1040, 0x80, GC.insertString("overlap")));
+  AddressRanges TextRanges;
+  TextRanges.insert(AddressRange(0x1000, 0x3000));
+  GC.SetValidTextRanges(TextRanges);
+}
+
+TEST(GSYMTest, TestGsymCreatorSpilling) {
+  // Test that a GsymCreator that spills function infos to a file produces
+  // the same GSYM data as one that keeps them in memory.
+  unittest::TempDir Dir("gsym-spill", /*Unique=*/true);
+  for (auto ByteOrder : {llvm::support::little, llvm::support::big}) {
+    GsymCreator InMemory(/*Quiet=*/true);
+    AddSpillTestFunctions(InMemory);
+    ASSERT_THAT_ERROR(InMemory.finalize(llvm::nulls()), Succeeded());
+
+    GsymCreator Spilled(/*Quiet=*/true);
+    ASSERT_THAT_ERROR(Spilled.enableSpilling(Dir.path(), ByteOrder),
+                      Succeeded());
+    AddSpillTestFunctions(Spilled);
+    EXPECT_EQ(Spilled.getNumFunctionInfos(), 6u);
+    size_t NumVisited = 0;
+    Spilled.forEachFunctionInfo([&](const FunctionInfo &) {
+      ++NumVisited;
+      return true;
+    });
+    EXPECT_EQ(NumVisited, 0u);
+    ASSERT_THAT_ERROR(Spilled.finalize(llvm::nulls()), Succeeded());
+    EXPECT_EQ(Spilled.getNumFunctionInfos(), InMemory.getNumFunctionInfos());
+
+    SmallString<512> InMemoryStr;
+    raw_svector_ostream InMemoryOS(InMemoryStr);
+    FileWriter InMemoryFW(InMemoryOS, ByteOrder);
+    ASSERT_THAT_ERROR(InMemory.encode(InMemoryFW), Succeeded());
+    SmallString<512> SpilledStr;
+    raw_svector_ostream SpilledOS(SpilledStr);
+    FileWriter SpilledFW(SpilledOS, ByteOrder);
+    ASSERT_THAT_ERROR(Spilled.encode(SpilledFW), Succeeded());
+    EXPECT_EQ(SpilledStr, InMemoryStr);
+
+    // The spilled encodings can't be written in another byte order.
+    const auto OtherByteOrder = ByteOrder == llvm::support::little
+                                    ? llvm::support::big
+                                    : llvm::support::little;
+    SmallString<512> OtherStr;
+    raw_svector_ostream OtherOS(OtherStr);
+    FileWriter OtherFW(OtherOS, OtherByteOrder);
+    EXPECT_THAT_ERROR(Spilled.encode(OtherFW), Failed());
+  }
+}
+
+TEST(GSYMTest, TestGsymDIContext) {
+  // Test that a GsymDIContext answers DIContext queries from the lookups of
+  // the GSYM file it reads, with the innermost inlined frame first.
+  GsymCreator GC;
+  FunctionInfo FI(0x1000, 0x100, GC.insertString("main"));
+  const auto ByteOrder = support::endian::system_endianness();
+  FI.OptLineTable = LineTable();
+  const uint32_t MainFileIndex = GC.insertFile("/tmp/main.c");
+  const uint32_t FooFileIndex = GC.insertFile("/tmp/foo.h");
+  FI.OptLineTable->push(LineEntry(0x1000, MainFileIndex, 5));
+  FI.OptLineTable->push(LineEntry(0x1010, FooFileIndex, 10));
+  FI.OptLineTable->push(LineEntry(0x1020, MainFileIndex, 8));
+  FI.Inline = InlineInfo();
+  FI.Inline->Name = GC.insertString("inline1");
+  FI.Inline->CallFile = MainFileIndex;
+  FI.Inline->CallLine = 6;
+  FI.Inline->Ranges.insert(AddressRange(0x1010, 0x1020));
+  GC.addFunctionInfo(std::move(FI));
+  GC.addFunctionInfo(FunctionInfo(0x2000, 0x10, GC.insertString("nolines")));
+  Error FinalizeErr = GC.finalize(llvm::nulls());
+  ASSERT_FALSE(FinalizeErr);
+  SmallString<512> Str;
+  raw_svector_ostream OutStrm(Str);
+  FileWriter FW(OutStrm, ByteOrder);
+  llvm::Error Err = GC.encode(FW);
+  ASSERT_FALSE((bool)Err);
+  Expected<GsymReader> GR = GsymReader::copyBuffer(OutStrm.str());
+  ASSERT_TRUE(bool(GR));
+  GsymDIContext DICtx(std::make_unique<GsymReader>(std::move(*GR)));
+
+  DILineInfoSpecifier Spec(
+      DILineInfoSpecifier::FileLineInfoKind::AbsoluteFilePath,
+      DINameKind::LinkageName);
+  DILineInfo LI = DICtx.getLineInfoForAddress({0x1004}, Spec);
+  EXPECT_EQ(LI.FunctionName, "main");
+  EXPECT_EQ(LI.FileName, "/tmp/main.c");
+  EXPECT_EQ(LI.Line, 5u);
+  ASSERT_TRUE(LI.StartAddress.has_value());
+  EXPECT_EQ(*LI.StartAddress, 0x1000u);
+
+  DIInliningInfo II = DICtx.getInliningInfoForAddress({0x1010}, Spec);
+  ASSERT_EQ(II.getNumberOfFrames(), 2u);
+  EXPECT_EQ(II.getFrame(0).FunctionName, "inline1");
+  EXPECT_EQ(II.getFrame(0).FileName, "/tmp/foo.h");
+  EXPECT_EQ(II.getFrame(0).Line, 10u);
+  EXPECT_EQ(II.getFrame(1).FunctionName, "main");
+  EXPECT_EQ(II.getFrame(1).FileName, "/tmp/main.c");
+  EXPECT_EQ(II.getFrame(1).Line, 6u);
+
+  Spec.FLIKind = DILineInfoSpecifier::FileLineInfoKind::BaseNameOnly;
+  LI = DICtx.getLineInfoForAddress({0x1010}, Spec);
+  EXPECT_EQ(LI.FunctionName, "inline1");
+  EXPECT_EQ(LI.FileName, "foo.h");
+
+  // Functions without a line table only have a name.
+  LI = DICtx.getLineInfoForAddress({0x2004}, Spec);
+  EXPECT_EQ(LI.FunctionName, "nolines");
+  EXPECT_EQ(LI.Line, 0u);
+
+  // Addresses outside of any function are not found.
+  LI = DICtx.getLineInfoForAddress({0x3000}, Spec);
+  EXPECT_EQ(LI.FunctionName, DILineInfo::BadString);
+}
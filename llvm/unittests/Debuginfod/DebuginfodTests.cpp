@@ -12,6 +12,7 @@
 #include "llvm/Support/Path.h"
 #include "llvm/Testing/Support/Error.h"
 #include "gtest/gtest.h"
+#include <thread>
 
 #ifdef _WIN32
 #define setenv(name, var, ignore) _putenv_s(name, var)
@@ -67,3 +68,31 @@ TEST(DebuginfodClient, CacheMiss) {
   // A cache miss with no possible URLs should not create the cache directory.
   EXPECT_FALSE(sys::fs::exists(CacheDir));
 }
+
+// Check that concurrent lookups of the same artifact all see the cached file.
+TEST(DebuginfodClient, ConcurrentCacheHits) {
+  int FD;
+  SmallString<64> CachedFilePath;
+  sys::fs::createTemporaryFile("llvmcache-key", "temp", FD, CachedFilePath);
+  StringRef CacheDir = sys::path::parent_path(CachedFilePath);
+  StringRef UniqueKey = sys::path::filename(CachedFilePath);
+  EXPECT_TRUE(UniqueKey.consume_front("llvmcache-"));
+  raw_fd_ostream OF(FD, true, /*unbuffered=*/true);
+  OF << "contents\n";
+  OF.close();
+
+  std::vector<std::thread> Threads;
+  std::vector<Expected<std::string>> Results;
+  for (unsigned I = 0; I < 8; ++I)
+    Results.push_back(std::string());
+  for (unsigned I = 0; I < 8; ++I)
+    Threads.emplace_back([&, I]() {
+      Results[I] = getCachedOrDownloadArtifact(
+          UniqueKey, /*UrlPath=*/"/null", CacheDir,
+          /*DebuginfodUrls=*/{}, /*Timeout=*/std::chrono::milliseconds(1));
+    });
+  for (std::thread &T : Threads)
+    T.join();
+  for (Expected<std::string> &PathOrErr : Results)
+    EXPECT_THAT_EXPECTED(PathOrErr, HasValue(CachedFilePath));
+}
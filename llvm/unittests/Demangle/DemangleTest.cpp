@@ -30,3 +30,33 @@ TEST(Demangle, demangleTest) {
   EXPECT_EQ(demangle("_Z3fooILi79EEbU7_ExtIntIXT_EEi"),
             "bool foo<79>(int _ExtInt<79>)");
 }
+
+TEST(Demangle, batchDemangleTest) {
+  ItaniumBatchDemangler D;
+  size_t N = 0;
+  EXPECT_STREQ(D.demangle("_Z3fooi", &N), "foo(int)");
+  EXPECT_EQ(N, 8u);
+  EXPECT_EQ(D.demangle("_Z"), nullptr);
+  EXPECT_EQ(D.demangle("foo"), nullptr);
+  // A name that needs more memory than the previous ones, and a name with a
+  // forward template reference after a failed parse.
+  const char *Long =
+      "_ZNSt6vectorINSt7__cxx1112basic_stringIcSt11char_traitsIcESaIcEEESaIS5_"
+      "EE17_M_realloc_insertIJRKS5_EEEvN9__gnu_cxx17__normal_iteratorIPS5_S7_"
+      "EEDpOT_";
+  EXPECT_EQ(D.demangle(Long), demangle(Long));
+  EXPECT_EQ(D.demangle("_ZcvT_IiEv_"), nullptr);
+  EXPECT_STREQ(D.demangle("_ZN1AcvT_I1BEEv"), "A::operator B<B>()");
+  EXPECT_STREQ(D.demangle("_Z3fooi"), "foo(int)");
+
+  const char *Names[] = {"_Z1fv", "_Z1gv", "bad"};
+  std::vector<std::string> Results;
+  D.demangleAll(Names, 3, [&](size_t I, const char *Demangled) {
+    EXPECT_EQ(I, Results.size());
+    Results.push_back(Demangled ? Demangled : "<invalid>");
+  });
+  EXPECT_THAT(Results, testing::ElementsAre("f()", "g()", "<invalid>"));
+
+  ItaniumBatchDemangler Moved(std::move(D));
+  EXPECT_STREQ(Moved.demangle("_Z1hv"), "h()");
+}
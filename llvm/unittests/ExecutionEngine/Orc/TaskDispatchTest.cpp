@@ -9,7 +9,9 @@
 #include "llvm/ExecutionEngine/Orc/TaskDispatch.h"
 #include "gtest/gtest.h"
 
+#include <atomic>
 #include <future>
+#include <vector>
 
 using namespace llvm;
 using namespace llvm::orc;
@@ -32,4 +34,48 @@ TEST(DynamicThreadPoolDispatchTest, GenericNamedTask) {
   EXPECT_TRUE(F.get());
   D->shutdown();
 }
+
+TEST(WorkStealingDispatchTest, UrgentTasksRunFirst) {
+  // Put tasks described as "slow" in the materialization lane.
+  auto D = std::make_unique<WorkStealingTaskDispatcher>(1, [](Task &T) {
+    std::string Desc;
+    raw_string_ostream OS(Desc);
+    T.printDescription(OS);
+    return OS.str() == "slow" ? WorkStealingTaskDispatcher::Materialization
+                              : WorkStealingTaskDispatcher::Urgent;
+  });
+
+  // Keep the only thread busy while the other tasks are queued.
+  std::promise<void> Unblock;
+  auto UnblockF = Unblock.get_future();
+  std::vector<int> Order;
+  D->dispatch(makeGenericNamedTask([&]() { UnblockF.wait(); }, "block"));
+  D->dispatch(makeGenericNamedTask([&]() { Order.push_back(1); }, "slow"));
+  D->dispatch(makeGenericNamedTask([&]() { Order.push_back(2); }, "fast"));
+  Unblock.set_value();
+  D->shutdown();
+
+  EXPECT_EQ(Order, std::vector<int>({2, 1}));
+  auto Urgent = D->getStats(WorkStealingTaskDispatcher::Urgent);
+  auto Materialization =
+      D->getStats(WorkStealingTaskDispatcher::Materialization);
+  EXPECT_EQ(Urgent.NumDispatched, 2U);
+  EXPECT_EQ(Materialization.NumDispatched, 1U);
+  EXPECT_EQ(Urgent.QueueDepth, 0U);
+  EXPECT_EQ(Materialization.QueueDepth, 0U);
+}
+
+TEST(WorkStealingDispatchTest, NestedTasks) {
+  auto D = std::make_unique<WorkStealingTaskDispatcher>(4);
+  std::atomic<unsigned> Count{0};
+  std::function<void(unsigned)> Spawn = [&](unsigned Depth) {
+    ++Count;
+    if (Depth != 4)
+      for (unsigned I = 0; I != 3; ++I)
+        D->dispatch(makeGenericNamedTask([&, Depth]() { Spawn(Depth + 1); }));
+  };
+  D->dispatch(makeGenericNamedTask([&]() { Spawn(0); }));
+  D->shutdown();
+  EXPECT_EQ(Count, 121U);
+}
 #endif
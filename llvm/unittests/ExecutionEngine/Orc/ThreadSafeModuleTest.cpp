@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/ExecutionEngine/Orc/ThreadSafeModule.h"
+#include "llvm/IR/IRBuilder.h"
 #include "gtest/gtest.h"
 
 #include <atomic>
@@ -91,4 +92,37 @@ TEST(ThreadSafeModuleTest, ContextLockPreservesContext) {
   TSCtx = ThreadSafeContext();
 }
 
+TEST(ThreadSafeModuleTest, SharedContextAcrossThreads) {
+  // Test that several threads can build modules in one context, sharing its
+  // types and constants, and hand the modules to another thread without
+  // cloning them.
+  ThreadSafeContext TSCtx(std::make_unique<LLVMContext>());
+  constexpr unsigned NumThreads = 4;
+  std::vector<std::future<ThreadSafeModule>> Results;
+  for (unsigned I = 0; I != NumThreads; ++I)
+    Results.push_back(std::async(std::launch::async, [TSCtx, I]() {
+      return TSCtx.withContextDo([&](LLVMContext &Ctx) {
+        auto M = std::make_unique<Module>("M" + std::to_string(I), Ctx);
+        FunctionType *FTy = FunctionType::get(Type::getInt32Ty(Ctx), false);
+        Function *F =
+            Function::Create(FTy, Function::ExternalLinkage, "f", M.get());
+        IRBuilder<> B(BasicBlock::Create(Ctx, "entry", F));
+        B.CreateRet(B.getInt32(42));
+        return ThreadSafeModule(std::move(M), TSCtx);
+      });
+    }));
+
+  ConstantInt *FortyTwo = TSCtx.withContextDo([](LLVMContext &Ctx) {
+    return ConstantInt::get(Type::getInt32Ty(Ctx), 42);
+  });
+  for (auto &Result : Results) {
+    ThreadSafeModule TSM = Result.get();
+    TSM.withModuleDo([&](Module &M) {
+      BasicBlock &Entry = M.getFunction("f")->getEntryBlock();
+      auto *Ret = cast<ReturnInst>(Entry.getTerminator());
+      EXPECT_EQ(Ret->getReturnValue(), FortyTwo);
+    });
+  }
+}
+
 } // end anonymous namespace
@@ -0,0 +1,88 @@
+//===- TieredCompileLayerTest.cpp - Test baseline and optimized tiers -----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "OrcTestCommon.h"
+#include "llvm/ExecutionEngine/Orc/LLJIT.h"
+#include "llvm/ExecutionEngine/Orc/TieredCompileLayer.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/Support/SourceMgr.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace llvm::orc;
+
+namespace {
+
+const char *TestModule = R"(
+  @calls = internal global i32 0
+
+  define i32 @add1(i32 %x) {
+    %n = load i32, i32* @calls
+    %n1 = add i32 %n, 1
+    store i32 %n1, i32* @calls
+    %r = add i32 %x, 1
+    ret i32 %r
+  }
+
+  define i32 @add2(i32 %x) {
+    %a = call i32 @add1(i32 %x)
+    %b = call i32 @add1(i32 %a)
+    ret i32 %b
+  }
+
+  define i32 @getCalls() {
+    %n = load i32, i32* @calls
+    ret i32 %n
+  }
+)";
+
+TEST(TieredCompileLayerTest, TierUpKeepsStateAndResults) {
+  OrcNativeTarget::initialize();
+
+  auto JTMB = JITTargetMachineBuilder::detectHost();
+  if (!JTMB) {
+    consumeError(JTMB.takeError());
+    return;
+  }
+
+  // Bail out if the host has no indirect stubs support.
+  if (!createLocalIndirectStubsManagerBuilder(JTMB->getTargetTriple()))
+    return;
+
+  auto J = LLJITBuilder()
+               .setJITTargetMachineBuilder(std::move(*JTMB))
+               .setTierUpThreshold(4)
+               .create();
+  if (!J) {
+    consumeError(J.takeError());
+    return;
+  }
+
+  auto Ctx = std::make_unique<LLVMContext>();
+  SMDiagnostic Err;
+  auto M = parseIR(MemoryBufferRef(TestModule, "test"), Err, *Ctx);
+  ASSERT_TRUE(M) << "Could not parse test module";
+  cantFail((*J)->addIRModule(ThreadSafeModule(std::move(M), std::move(Ctx))));
+
+  auto Add2 = cantFail((*J)->lookup("add2")).toPtr<int (*)(int)>();
+  auto GetCalls = cantFail((*J)->lookup("getCalls")).toPtr<int (*)()>();
+
+  // The first call enters add2 and add1 three times in total, the second
+  // call reaches the threshold and tiers the module up.
+  EXPECT_EQ(Add2(1), 3);
+  EXPECT_EQ((*J)->getTieredCompileLayer()->getNumTieredUpModules(), 0U);
+  EXPECT_EQ(Add2(2), 4);
+  EXPECT_EQ((*J)->getTieredCompileLayer()->getNumTieredUpModules(), 1U);
+
+  // The optimized code must share the module state with the baseline code.
+  for (int I = 0; I != 10; ++I)
+    EXPECT_EQ(Add2(I), I + 2);
+  EXPECT_EQ(GetCalls(), 24);
+}
+
+} // namespace
@@ -19,6 +19,9 @@
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Transforms/Scalar/SimplifyCFG.h"
 #include "gtest/gtest.h"
+#include <atomic>
+#include <list>
+#include <mutex>
 
 using namespace llvm;
 
@@ -151,6 +154,29 @@ struct TestFunctionPass : PassInfoMixin<TestFunctionPass> {
   bool OnlyUseCachedResults;
 };
 
+// A function pass that can be run on several functions at once. It counts
+// instructions through TestFunctionAnalysis and invalidates all analyses of
+// the function named Name.
+struct TestParallelFunctionPass : PassInfoMixin<TestParallelFunctionPass> {
+  TestParallelFunctionPass(std::atomic<int> &RunCount,
+                           std::atomic<int> &AnalyzedInstrCount,
+                           StringRef Name)
+      : RunCount(RunCount), AnalyzedInstrCount(AnalyzedInstrCount),
+        Name(Name) {}
+
+  PreservedAnalyses run(Function &F, FunctionAnalysisManager &AM) {
+    ++RunCount;
+    TestFunctionAnalysis::Result &AR = AM.getResult<TestFunctionAnalysis>(F);
+    AnalyzedInstrCount += AR.InstructionCount;
+    return F.getName() == Name ? PreservedAnalyses::none()
+                               : PreservedAnalyses::all();
+  }
+
+  std::atomic<int> &RunCount;
+  std::atomic<int> &AnalyzedInstrCount;
+  StringRef Name;
+};
+
 // A test function pass that invalidates all function analyses for a function
 // with a specific name.
 struct TestInvalidationFunctionPass
@@ -703,6 +729,59 @@ struct LambdaPass : public PassInfoMixin<LambdaPass> {
   FuncT Func;
 };
 
+TEST_F(PassManagerTest, ParallelFunctionPipeline) {
+  FunctionAnalysisManager FAM;
+  int FunctionAnalysisRuns = 0;
+  FAM.registerPass([&] { return TestFunctionAnalysis(FunctionAnalysisRuns); });
+
+  ModuleAnalysisManager MAM;
+  MAM.registerPass([&] { return FunctionAnalysisManagerModuleProxy(FAM); });
+  FAM.registerPass([&] { return ModuleAnalysisManagerFunctionProxy(MAM); });
+  MAM.registerPass([&] { return PassInstrumentationAnalysis(); });
+  FAM.registerPass([&] { return PassInstrumentationAnalysis(); });
+
+  // Populate the shared analysis manager so we can check that the adaptor
+  // invalidates it.
+  for (Function &F : *M)
+    FAM.getResult<TestFunctionAnalysis>(F);
+  EXPECT_EQ(3, FunctionAnalysisRuns);
+
+  // Each worker gets its own analysis manager and its own counter.
+  std::mutex WorkerMutex;
+  std::list<int> WorkerAnalysisRuns;
+  std::atomic<int> RunCount(0), AnalyzedInstrCount(0);
+  ModulePassManager MPM;
+  MPM.addPass(createParallelModuleToFunctionPassAdaptor<
+              TestParallelFunctionPass>(
+      [&] {
+        return TestParallelFunctionPass(RunCount, AnalyzedInstrCount, "f");
+      },
+      [&](FunctionAnalysisManager &WorkerFAM) {
+        std::lock_guard<std::mutex> Lock(WorkerMutex);
+        int &Runs = WorkerAnalysisRuns.emplace_back(0);
+        WorkerFAM.registerPass([&] { return TestFunctionAnalysis(Runs); });
+      },
+      heavyweight_hardware_concurrency(2)));
+  MPM.run(*M, MAM);
+
+  EXPECT_EQ(3, RunCount);
+  EXPECT_EQ(5, AnalyzedInstrCount);
+  int TotalWorkerAnalysisRuns = 0;
+  for (int Runs : WorkerAnalysisRuns)
+    TotalWorkerAnalysisRuns += Runs;
+  EXPECT_EQ(3, TotalWorkerAnalysisRuns);
+
+  // The shared analysis manager was not used by the workers, and only the
+  // results for @f were invalidated.
+  EXPECT_EQ(3, FunctionAnalysisRuns);
+  EXPECT_EQ(nullptr, FAM.getCachedResult<TestFunctionAnalysis>(
+                         *M->getFunction("f")));
+  EXPECT_NE(nullptr, FAM.getCachedResult<TestFunctionAnalysis>(
+                         *M->getFunction("g")));
+  EXPECT_NE(nullptr, FAM.getCachedResult<TestFunctionAnalysis>(
+                         *M->getFunction("h")));
+}
+
 TEST_F(PassManagerTest, IndirectAnalysisInvalidation) {
   FunctionAnalysisManager FAM;
   ModuleAnalysisManager MAM;
@@ -115,6 +115,40 @@ TEST_P(MaybeSparseInstrProfTest, get_instr_prof_record) {
   ASSERT_TRUE(ErrorEquals(instrprof_error::unknown_function, R.takeError()));
 }
 
+TEST_P(MaybeSparseInstrProfTest, prefetch_records) {
+  Writer.addRecord({"foo", 0x1234, {1, 2}}, Err);
+  Writer.addRecord({"foo", 0x1235, {3, 4}}, Err);
+  Writer.addRecord({"bar", 0x2345, {5}}, Err);
+  Writer.addRecord({"baz", 0x3456, {6}}, Err);
+  auto Profile = Writer.writeBuffer();
+  readProfile(std::move(Profile));
+
+  StringRef FuncNames[] = {"foo", "bar", "missing", "foo"};
+  EXPECT_THAT_ERROR(Reader->prefetchRecords(FuncNames), Succeeded());
+
+  Expected<InstrProfRecord> R = Reader->getInstrProfRecord("foo", 0x1235);
+  EXPECT_THAT_ERROR(R.takeError(), Succeeded());
+  ASSERT_EQ(2U, R->Counts.size());
+  ASSERT_EQ(3U, R->Counts[0]);
+  ASSERT_EQ(4U, R->Counts[1]);
+
+  R = Reader->getInstrProfRecord("bar", 0x2345);
+  EXPECT_THAT_ERROR(R.takeError(), Succeeded());
+  ASSERT_EQ(1U, R->Counts.size());
+  ASSERT_EQ(5U, R->Counts[0]);
+
+  R = Reader->getInstrProfRecord("foo", 0x5678);
+  ASSERT_TRUE(ErrorEquals(instrprof_error::hash_mismatch, R.takeError()));
+
+  // Functions that were not prefetched are still read from the profile.
+  R = Reader->getInstrProfRecord("baz", 0x3456);
+  EXPECT_THAT_ERROR(R.takeError(), Succeeded());
+  ASSERT_EQ(6U, R->Counts[0]);
+
+  R = Reader->getInstrProfRecord("missing", 0x1234);
+  ASSERT_TRUE(ErrorEquals(instrprof_error::unknown_function, R.takeError()));
+}
+
 TEST_P(MaybeSparseInstrProfTest, get_function_counts) {
   Writer.addRecord({"foo", 0x1234, {1, 2}}, Err);
   Writer.addRecord({"foo", 0x1235, {3, 4}}, Err);
@@ -224,6 +258,41 @@ TEST_F(InstrProfTest, test_writer_merge) {
   ASSERT_EQ(0U, R->Counts[1]);
 }
 
+TEST_F(InstrProfTest, test_writer_partitions) {
+  Writer.addRecord({"func1", 0x1234, {42}}, Err);
+
+  InstrProfWriter Partition1, Partition2;
+  Partition1.addRecord({"func2", 0x1234, {1, 2}}, Err);
+  Partition1.addRecord({"func2", 0x5678, {3}}, Err);
+  Partition2.addRecord({"func3", 0x1234, {100}}, Err);
+
+  ASSERT_THAT_ERROR(Writer.addPartition(Partition1, Err), Succeeded());
+  ASSERT_THAT_ERROR(Writer.addPartition(Partition2, Err), Succeeded());
+
+  auto Profile = Writer.writeBuffer();
+  readProfile(std::move(Profile));
+
+  Expected<InstrProfRecord> R = Reader->getInstrProfRecord("func1", 0x1234);
+  EXPECT_THAT_ERROR(R.takeError(), Succeeded());
+  ASSERT_EQ(1U, R->Counts.size());
+  ASSERT_EQ(42U, R->Counts[0]);
+
+  R = Reader->getInstrProfRecord("func2", 0x5678);
+  EXPECT_THAT_ERROR(R.takeError(), Succeeded());
+  ASSERT_EQ(1U, R->Counts.size());
+  ASSERT_EQ(3U, R->Counts[0]);
+
+  R = Reader->getInstrProfRecord("func3", 0x1234);
+  EXPECT_THAT_ERROR(R.takeError(), Succeeded());
+  ASSERT_EQ(1U, R->Counts.size());
+  ASSERT_EQ(100U, R->Counts[0]);
+
+  // The summary covers the records of all partitions.
+  ProfileSummary &PS = Reader->getSummary(/* IsCS */ false);
+  ASSERT_EQ(4U, PS.getNumFunctions());
+  ASSERT_EQ(100U, PS.getMaxFunctionCount());
+}
+
 using ::llvm::memprof::IndexedMemProfRecord;
 using ::llvm::memprof::MemInfoBlock;
 using FrameIdMapTy =
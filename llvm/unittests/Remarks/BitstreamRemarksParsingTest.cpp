@@ -333,6 +333,78 @@ static void parseBad(StringRef Input, const char *ErrorMsg) {
   EXPECT_EQ(ErrorMsg, toString(BSRemark.takeError())); // Expect an error.
 }
 
+TEST(BitstreamRemarks, Filters) {
+  const char *Buf = "\n"
+                    "--- !Missed\n"
+                    "Pass: inline\n"
+                    "Name: NoDefinition\n"
+                    "Function: foo\n"
+                    "Args:\n"
+                    "  - Callee: bar\n"
+                    "...\n"
+                    "--- !Passed\n"
+                    "Pass: inline\n"
+                    "Name: Inlined\n"
+                    "Function: bar\n"
+                    "...\n"
+                    "--- !Missed\n"
+                    "Pass: loop-vectorize\n"
+                    "Name: MissedDetails\n"
+                    "Function: foo\n"
+                    "...\n";
+
+  // Convert the YAML remarks to a bitstream.
+  Expected<std::unique_ptr<remarks::RemarkParser>> MaybeParser =
+      remarks::createRemarkParser(remarks::Format::YAML, Buf);
+  EXPECT_FALSE(errorToBool(MaybeParser.takeError()));
+  std::vector<std::unique_ptr<remarks::Remark>> Remarks;
+  remarks::StringTable BSStrTab;
+  Expected<std::unique_ptr<remarks::Remark>> Remark = (*MaybeParser)->next();
+  for (; Remark; Remark = (*MaybeParser)->next()) {
+    BSStrTab.internalize(**Remark);
+    Remarks.push_back(std::move(*Remark));
+  }
+  consumeError(Remark.takeError());
+  std::string BSBuf;
+  raw_string_ostream BSStream(BSBuf);
+  Expected<std::unique_ptr<remarks::RemarkSerializer>> BSSerializer =
+      remarks::createRemarkSerializer(remarks::Format::Bitstream,
+                                      remarks::SerializerMode::Standalone,
+                                      BSStream, std::move(BSStrTab));
+  EXPECT_FALSE(errorToBool(BSSerializer.takeError()));
+  for (const auto &R : Remarks)
+    (*BSSerializer)->emit(*R);
+
+  auto getNames = [&](Optional<std::string> Pass,
+                      Optional<std::string> Function) {
+    Expected<std::unique_ptr<remarks::RemarkParser>> MaybeBSParser =
+        remarks::createRemarkParser(remarks::Format::Bitstream,
+                                    BSStream.str());
+    EXPECT_FALSE(errorToBool(MaybeBSParser.takeError()));
+    remarks::RemarkParser &BSParser = **MaybeBSParser;
+    BSParser.PassNameFilter = Pass;
+    BSParser.FunctionNameFilter = Function;
+    std::vector<std::string> Names;
+    Expected<std::unique_ptr<remarks::Remark>> BSRemark = BSParser.next();
+    for (; BSRemark; BSRemark = BSParser.next())
+      Names.push_back((*BSRemark)->RemarkName.str());
+    Error E = BSRemark.takeError();
+    EXPECT_TRUE(E.isA<remarks::EndOfFileError>());
+    consumeError(std::move(E));
+    return Names;
+  };
+
+  EXPECT_EQ(getNames(None, None),
+            (std::vector<std::string>{"NoDefinition", "Inlined",
+                                      "MissedDetails"}));
+  EXPECT_EQ(getNames(std::string("inline"), None),
+            (std::vector<std::string>{"NoDefinition", "Inlined"}));
+  EXPECT_EQ(getNames(None, std::string("foo")),
+            (std::vector<std::string>{"NoDefinition", "MissedDetails"}));
+  EXPECT_EQ(getNames(std::string("loop-vectorize"), std::string("bar")),
+            std::vector<std::string>{});
+}
+
 TEST(BitstreamRemarks, ParsingEmpty) {
   parseBad(StringRef(), "End of file reached.");
 }
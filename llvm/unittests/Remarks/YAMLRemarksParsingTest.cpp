@@ -382,6 +382,52 @@ static inline StringRef checkStr(StringRef Str, unsigned ExpectedLen) {
   return StringRef(StrData, StrLen);
 }
 
+TEST(YAMLRemarks, Filters) {
+  const char *Buf = "\n"
+                    "--- !Missed\n"
+                    "Pass: inline\n"
+                    "Name: NoDefinition\n"
+                    "Function: foo\n"
+                    "...\n"
+                    "--- !Passed\n"
+                    "Pass: inline\n"
+                    "Name: Inlined\n"
+                    "Function: bar\n"
+                    "...\n"
+                    "--- !Missed\n"
+                    "Pass: loop-vectorize\n"
+                    "Name: MissedDetails\n"
+                    "Function: foo\n"
+                    "...\n";
+  auto getNames = [&](Optional<std::string> Pass,
+                      Optional<std::string> Function) {
+    Expected<std::unique_ptr<remarks::RemarkParser>> MaybeParser =
+        remarks::createRemarkParser(remarks::Format::YAML, Buf);
+    EXPECT_FALSE(errorToBool(MaybeParser.takeError()));
+    remarks::RemarkParser &Parser = **MaybeParser;
+    Parser.PassNameFilter = Pass;
+    Parser.FunctionNameFilter = Function;
+    std::vector<std::string> Names;
+    Expected<std::unique_ptr<remarks::Remark>> Remark = Parser.next();
+    for (; Remark; Remark = Parser.next())
+      Names.push_back((*Remark)->RemarkName.str());
+    Error E = Remark.takeError();
+    EXPECT_TRUE(E.isA<remarks::EndOfFileError>());
+    consumeError(std::move(E));
+    return Names;
+  };
+
+  EXPECT_EQ(getNames(None, None),
+            (std::vector<std::string>{"NoDefinition", "Inlined",
+                                      "MissedDetails"}));
+  EXPECT_EQ(getNames(std::string("inline"), None),
+            (std::vector<std::string>{"NoDefinition", "Inlined"}));
+  EXPECT_EQ(getNames(None, std::string("foo")),
+            (std::vector<std::string>{"NoDefinition", "MissedDetails"}));
+  EXPECT_EQ(getNames(std::string("loop-vectorize"), std::string("bar")),
+            std::vector<std::string>{});
+}
+
 TEST(YAMLRemarks, Contents) {
   StringRef Buf = "\n"
                   "--- !Missed\n"
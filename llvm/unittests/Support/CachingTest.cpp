@@ -0,0 +1,115 @@
+//===- CachingTest.cpp ----------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/Caching.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Testing/Support/Error.h"
+#include "llvm/Testing/Support/SupportHelpers.h"
+#include "gtest/gtest.h"
+#include <map>
+
+using namespace llvm;
+using llvm::unittest::TempDir;
+
+namespace {
+
+struct CacheHarness {
+  std::mutex Mu;
+  std::map<unsigned, std::string> Buffers;
+  unsigned NumProduced = 0;
+
+  FileCache makeLocalCache(StringRef Dir) {
+    Expected<FileCache> CacheOrErr = localCache(
+        "Test", "Test", Dir,
+        [this](size_t Task, std::unique_ptr<MemoryBuffer> MB) {
+          std::lock_guard<std::mutex> Lock(Mu);
+          Buffers[Task] = MB->getBuffer().str();
+        });
+    EXPECT_THAT_EXPECTED(CacheOrErr, Succeeded());
+    return std::move(*CacheOrErr);
+  }
+
+  /// Look up \p Key and produce \p Content on a miss, like an LTO backend.
+  void lookup(FileCache &Cache, unsigned Task, StringRef Key,
+              StringRef Content) {
+    Expected<AddStreamFn> AddStreamOrErr = Cache(Task, Key);
+    ASSERT_THAT_EXPECTED(AddStreamOrErr, Succeeded());
+    if (!*AddStreamOrErr)
+      return;
+    ++NumProduced;
+    Expected<std::unique_ptr<CachedFileStream>> StreamOrErr =
+        (*AddStreamOrErr)(Task);
+    ASSERT_THAT_EXPECTED(StreamOrErr, Succeeded());
+    *(*StreamOrErr)->OS << Content;
+  }
+};
+
+TEST(RemoteCacheTest, SharesEntriesBetweenLocalCaches) {
+  TempDir Root("remote-cache-test", /*Unique=*/true);
+  SmallString<128> RemoteDir(Root.path()), LocalA(Root.path()),
+      LocalB(Root.path());
+  sys::path::append(RemoteDir, "remote");
+  sys::path::append(LocalA, "a");
+  sys::path::append(LocalB, "b");
+  std::shared_ptr<RemoteCacheStore> Remote = directoryCacheStore(RemoteDir);
+
+  // The first builder misses both caches and produces the entry, which is
+  // added to its local cache and stored remotely.
+  CacheHarness A;
+  FileCache CacheA = remoteCache(A.makeLocalCache(LocalA), Remote);
+  A.lookup(CacheA, 1, "key", "object");
+  Remote->wait();
+  EXPECT_EQ(A.NumProduced, 1u);
+  EXPECT_EQ(A.Buffers[1], "object");
+  SmallString<128> RemoteEntry(RemoteDir);
+  sys::path::append(RemoteEntry, "llvmcache-key");
+  EXPECT_TRUE(sys::fs::exists(RemoteEntry));
+
+  // A second builder with an empty local cache gets it from the store, and
+  // adds it to its local cache.
+  CacheHarness B;
+  FileCache CacheB = remoteCache(B.makeLocalCache(LocalB), Remote);
+  Remote->prefetch("key");
+  B.lookup(CacheB, 2, "key", "not used");
+  EXPECT_EQ(B.NumProduced, 0u);
+  EXPECT_EQ(B.Buffers[2], "object");
+  SmallString<128> LocalEntry(LocalB);
+  sys::path::append(LocalEntry, "llvmcache-key");
+  EXPECT_TRUE(sys::fs::exists(LocalEntry));
+
+  // Other keys still miss.
+  B.lookup(CacheB, 3, "other", "other object");
+  Remote->wait();
+  EXPECT_EQ(B.NumProduced, 1u);
+  EXPECT_EQ(B.Buffers[3], "other object");
+}
+
+TEST(RemoteCacheTest, EmptyStoreMisses) {
+  TempDir Root("remote-cache-test", /*Unique=*/true);
+  SmallString<128> RemoteDir(Root.path()), Local(Root.path());
+  sys::path::append(RemoteDir, "remote");
+  sys::path::append(Local, "local");
+  std::shared_ptr<RemoteCacheStore> Remote = directoryCacheStore(RemoteDir);
+
+  CacheHarness H;
+  FileCache Cache = remoteCache(H.makeLocalCache(Local), Remote);
+  H.lookup(Cache, 0, "key", "object");
+  Remote->wait();
+  EXPECT_EQ(H.NumProduced, 1u);
+  EXPECT_EQ(H.Buffers[0], "object");
+
+  // The local cache now hits without asking the store.
+  H.lookup(Cache, 1, "key", "not used");
+  EXPECT_EQ(H.NumProduced, 1u);
+  EXPECT_EQ(H.Buffers[1], "object");
+}
+
+} // namespace
@@ -0,0 +1,121 @@
+//===- unittests/Support/OnDiskHashTableTest.cpp - OnDiskHashTable tests --===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/OnDiskHashTable.h"
+#include "llvm/ADT/SmallString.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <set>
+
+using namespace llvm;
+using namespace support;
+
+namespace {
+
+// Maps integers to their squares. The hash only looks at the high bits of the
+// key so that neighbouring keys collide.
+struct SquareInfo {
+  typedef uint32_t key_type;
+  typedef uint32_t key_type_ref;
+  typedef uint32_t data_type;
+  typedef uint32_t data_type_ref;
+  typedef uint32_t internal_key_type;
+  typedef uint32_t external_key_type;
+  typedef uint32_t hash_value_type;
+  typedef uint32_t offset_type;
+
+  static hash_value_type ComputeHash(uint32_t Key) { return Key >> 2; }
+  static bool EqualKey(uint32_t LHS, uint32_t RHS) { return LHS == RHS; }
+  static uint32_t GetInternalKey(uint32_t Key) { return Key; }
+  static uint32_t GetExternalKey(uint32_t Key) { return Key; }
+
+  static std::pair<offset_type, offset_type>
+  EmitKeyDataLength(raw_ostream &Out, uint32_t Key, uint32_t Data) {
+    return std::make_pair(4, 4);
+  }
+  static void EmitKey(raw_ostream &Out, uint32_t Key, offset_type) {
+    endian::write<uint32_t>(Out, Key, little);
+  }
+  static void EmitData(raw_ostream &Out, uint32_t, uint32_t Data,
+                       offset_type) {
+    endian::write<uint32_t>(Out, Data, little);
+  }
+
+  static std::pair<offset_type, offset_type>
+  ReadKeyDataLength(const unsigned char *&) {
+    return std::make_pair(4, 4);
+  }
+  static uint32_t ReadKey(const unsigned char *D, offset_type) {
+    return endian::read<uint32_t, little, unaligned>(D);
+  }
+  static uint32_t ReadData(uint32_t, const unsigned char *D, offset_type) {
+    return endian::read<uint32_t, little, unaligned>(D);
+  }
+};
+
+typedef OnDiskOpenAddressingHashTable<SquareInfo> SquareTable;
+
+std::unique_ptr<SquareTable> emitSquares(SmallVectorImpl<char> &Buffer,
+                                         unsigned NumEntries) {
+  OnDiskOpenAddressingHashTableGenerator<SquareInfo> Generator;
+  for (uint32_t I = 0; I < NumEntries; ++I)
+    Generator.insert(I, I * I);
+
+  uint32_t TableOffset;
+  {
+    raw_svector_ostream Out(Buffer);
+    // Make sure that no item is at offset 0.
+    endian::write<uint32_t>(Out, 0, little);
+    TableOffset = Generator.Emit(Out);
+  }
+  const unsigned char *Base =
+      reinterpret_cast<const unsigned char *>(Buffer.data());
+  return std::unique_ptr<SquareTable>(SquareTable::Create(
+      Base + TableOffset, Base + sizeof(uint32_t), Base));
+}
+
+TEST(OnDiskOpenAddressingHashTable, Empty) {
+  SmallString<64> Buffer;
+  std::unique_ptr<SquareTable> Table = emitSquares(Buffer, 0);
+  EXPECT_TRUE(Table->isEmpty());
+  EXPECT_TRUE(Table->find(0) == Table->end());
+  EXPECT_TRUE(Table->key_begin() == Table->key_end());
+}
+
+TEST(OnDiskOpenAddressingHashTable, Lookup) {
+  SmallString<4096> Buffer;
+  std::unique_ptr<SquareTable> Table = emitSquares(Buffer, 100);
+  EXPECT_EQ(Table->getNumEntries(), 100u);
+  EXPECT_GT(Table->getNumSlots(), Table->getNumEntries());
+
+  for (uint32_t I = 0; I < 100; ++I) {
+    SquareTable::iterator It = Table->find(I);
+    ASSERT_TRUE(It != Table->end());
+    EXPECT_EQ(*It, I * I);
+  }
+  for (uint32_t I = 100; I < 200; ++I)
+    EXPECT_TRUE(Table->find(I) == Table->end());
+}
+
+TEST(OnDiskOpenAddressingHashTable, Iterate) {
+  SmallString<4096> Buffer;
+  std::unique_ptr<SquareTable> Table = emitSquares(Buffer, 50);
+
+  std::set<uint32_t> Keys;
+  for (uint32_t Key : Table->keys())
+    EXPECT_TRUE(Keys.insert(Key).second);
+  EXPECT_EQ(Keys.size(), 50u);
+  EXPECT_EQ(*Keys.rbegin(), 49u);
+
+  uint32_t Sum = 0;
+  for (uint32_t Data : Table->data())
+    Sum += Data;
+  EXPECT_EQ(Sum, 49u * 50u * 99u / 6u);
+}
+
+} // end anonymous namespace
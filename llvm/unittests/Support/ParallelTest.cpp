@@ -14,6 +14,7 @@
 #include "llvm/Support/Parallel.h"
 #include "gtest/gtest.h"
 #include <array>
+#include <atomic>
 #include <random>
 
 uint32_t array[1024 * 1024];
@@ -80,6 +81,25 @@ TEST(Parallel, TransformReduce) {
   EXPECT_EQ(sum, 3060U);
 }
 
+TEST(Parallel, TaskGroupManySmallTasks) {
+  // Spawn a large number of tiny tasks, both from the calling thread and from
+  // inside running tasks, and check that every one of them ran exactly once
+  // before the TaskGroup is synced.
+  constexpr unsigned NumOuter = 1000;
+  constexpr unsigned NumInner = 16;
+  std::atomic<unsigned> Count{0};
+  {
+    parallel::TaskGroup TG;
+    for (unsigned I = 0; I != NumOuter; ++I)
+      TG.spawn([&] {
+        for (unsigned J = 0; J != NumInner; ++J)
+          TG.spawn([&] { ++Count; });
+        ++Count;
+      });
+  }
+  EXPECT_EQ(Count, NumOuter * (NumInner + 1));
+}
+
 TEST(Parallel, ForEachError) {
   int nums[] = {1, 2, 3, 4, 5, 6};
   Error e = parallelForEachError(nums, [](int v) -> Error {
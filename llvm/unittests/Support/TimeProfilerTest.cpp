@@ -54,6 +54,34 @@ TEST(TimeProfiler, Begin_End_Smoke) {
   ASSERT_TRUE(json.find(R"("detail":"detail")") != std::string::npos);
 }
 
+TEST(TimeProfiler, Memory_Smoke) {
+  setupProfiler();
+
+  uint64_t Allocated = 0;
+  timeTraceProfilerSetMemoryCounter([&] { return Allocated; });
+  {
+    TimeTraceScope outer("outer", "a");
+    Allocated += 10;
+    {
+      TimeTraceScope inner("inner", "b");
+      Allocated += 32;
+    }
+  }
+  timeTraceProfilerSetMemoryCounter(nullptr);
+  { TimeTraceScope scope("untracked"); }
+
+  std::string json = teardownProfiler();
+  // Events record the bytes allocated while they were open.
+  ASSERT_TRUE(json.find(R"("detail":"a","bytes":42)") != std::string::npos);
+  ASSERT_TRUE(json.find(R"("detail":"b","bytes":32)") != std::string::npos);
+  // Top entries count only the bytes that were not allocated in nested events.
+  ASSERT_TRUE(json.find(R"("name":"Top memory outer","args":{"detail":"a",)"
+                        R"("count":1,"bytes":10})") != std::string::npos);
+  ASSERT_TRUE(json.find(R"("name":"Top memory inner","args":{"detail":"b",)"
+                        R"("count":1,"bytes":32})") != std::string::npos);
+  ASSERT_TRUE(json.find(R"("name":"untracked"})") != std::string::npos);
+}
+
 TEST(TimeProfiler, Begin_End_Disabled) {
   // Nothing should be observable here. The test is really just making sure
   // we've not got a stray nullptr deref.
@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Support/Timer.h"
+#include "llvm/Support/CommandLine.h"
 #include "gtest/gtest.h"
 
 #if _WIN32
@@ -61,4 +62,24 @@ TEST(Timer, CheckIfTriggered) {
   EXPECT_FALSE(T1.hasTriggered());
 }
 
+TEST(Timer, WallClockOnly) {
+  const char *Args[] = {"prog", "-timer-wall-clock-only"};
+  cl::ResetAllOptionOccurrences();
+  ASSERT_TRUE(cl::ParseCommandLineOptions(2, Args, "", &llvm::nulls()));
+
+  Timer T1("T1", "T1");
+  T1.startTimer();
+  SleepMS();
+  T1.stopTimer();
+  TimeRecord TR = T1.getTotalTime();
+  EXPECT_GT(TR.getWallTime(), 0.0);
+  EXPECT_EQ(TR.getUserTime(), 0.0);
+  EXPECT_EQ(TR.getSystemTime(), 0.0);
+
+  const char *ResetArgs[] = {"prog", "-timer-wall-clock-only=false"};
+  cl::ResetAllOptionOccurrences();
+  ASSERT_TRUE(cl::ParseCommandLineOptions(2, ResetArgs, "", &llvm::nulls()));
+  cl::ResetAllOptionOccurrences();
+}
+
 } // end anon namespace
@@ -934,6 +934,71 @@ TEST(ProxyFileSystemTest, Basic) {
   EXPECT_FALSE(Local);
 }
 
+namespace {
+class CountingFileSystem : public vfs::ProxyFileSystem {
+public:
+  explicit CountingFileSystem(IntrusiveRefCntPtr<vfs::FileSystem> FS)
+      : ProxyFileSystem(std::move(FS)) {}
+
+  ErrorOr<vfs::Status> status(const Twine &Path) override {
+    ++NumStatus;
+    return ProxyFileSystem::status(Path);
+  }
+  vfs::directory_iterator dir_begin(const Twine &Dir,
+                                    std::error_code &EC) override {
+    ++NumDirBegin;
+    return ProxyFileSystem::dir_begin(Dir, EC);
+  }
+
+  unsigned NumStatus = 0;
+  unsigned NumDirBegin = 0;
+};
+} // namespace
+
+TEST(StatCachingFileSystemTest, Basic) {
+  IntrusiveRefCntPtr<vfs::InMemoryFileSystem> Base(
+      new vfs::InMemoryFileSystem());
+  Base->addFile("/inc1/a.h", 0, MemoryBuffer::getMemBuffer("a"));
+  Base->addFile("/inc2/b.h", 0, MemoryBuffer::getMemBuffer("b"));
+  auto Counting = makeIntrusiveRefCnt<CountingFileSystem>(Base);
+  vfs::StatCachingFileSystem FS(Counting);
+
+  auto Stat = FS.status("/inc1/a.h");
+  ASSERT_FALSE(Stat.getError());
+  EXPECT_EQ("/inc1/a.h", getPosixPath(std::string(Stat->getName())));
+  EXPECT_TRUE(FS.exists("/inc1/a.h"));
+  EXPECT_EQ(1u, Counting->NumStatus);
+
+  // The first miss in a directory lists it, later misses are answered from
+  // the listing.
+  EXPECT_FALSE(FS.exists("/inc1/b.h"));
+  EXPECT_EQ(2u, Counting->NumStatus);
+  EXPECT_EQ(1u, Counting->NumDirBegin);
+  EXPECT_FALSE(FS.exists("/inc1/c.h"));
+  EXPECT_FALSE(FS.openFileForRead("/inc1/c.h"));
+  EXPECT_EQ(2u, Counting->NumStatus);
+  EXPECT_EQ(1u, Counting->NumDirBegin);
+
+  // Nothing exists in a directory that does not exist.
+  EXPECT_FALSE(FS.exists("/missing/a.h"));
+  EXPECT_FALSE(FS.exists("/missing/b.h"));
+  EXPECT_EQ(3u, Counting->NumStatus);
+  EXPECT_EQ(2u, Counting->NumDirBegin);
+
+  // Listings are matched case-insensitively, so a name that differs from an
+  // entry only in case is still looked up.
+  EXPECT_FALSE(FS.exists("/inc2/c.h"));
+  EXPECT_EQ(4u, Counting->NumStatus);
+  EXPECT_FALSE(FS.exists("/inc2/B.h"));
+  EXPECT_EQ(5u, Counting->NumStatus);
+  EXPECT_TRUE(FS.exists("/inc2/b.h"));
+  EXPECT_EQ(6u, Counting->NumStatus);
+
+  auto File = FS.openFileForRead("/inc2/b.h");
+  ASSERT_FALSE(File.getError());
+  EXPECT_EQ("b", (*(*File)->getBuffer("ignored"))->getBuffer());
+}
+
 class InMemoryFileSystemTest : public ::testing::Test {
 protected:
   llvm::vfs::InMemoryFileSystem FS;
@@ -0,0 +1,193 @@
+//===- PGOMultiVersioningTest.cpp - Unit tests for PGO multiversioning ----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Transforms/IPO/PGOMultiVersioning.h"
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/IR/GlobalIFunc.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/Verifier.h"
+#include "llvm/Passes/PassBuilder.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/SourceMgr.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+class PGOMultiVersioningTest : public testing::Test {
+protected:
+  static const char *IRString;
+  LLVMContext C;
+  std::unique_ptr<Module> M;
+  cl::opt<unsigned> *MaxGrowth;
+  unsigned OldMaxGrowth;
+
+  void SetUp() override {
+    SMDiagnostic Err;
+    M = parseAssemblyString(IRString, Err, C);
+    ASSERT_TRUE(M);
+    // The test module is too small for the default size budget.
+    MaxGrowth = static_cast<cl::opt<unsigned> *>(
+        cl::getRegisteredOptions()["pgo-multiversion-max-growth"]);
+    ASSERT_TRUE(MaxGrowth);
+    OldMaxGrowth = *MaxGrowth;
+    MaxGrowth->setValue(1000);
+  }
+
+  void TearDown() override { MaxGrowth->setValue(OldMaxGrowth); }
+
+  void run() {
+    LoopAnalysisManager LAM;
+    FunctionAnalysisManager FAM;
+    CGSCCAnalysisManager CGAM;
+    ModuleAnalysisManager MAM;
+    PassBuilder PB;
+    PB.registerModuleAnalyses(MAM);
+    PB.registerCGSCCAnalyses(CGAM);
+    PB.registerFunctionAnalyses(FAM);
+    PB.registerLoopAnalyses(LAM);
+    PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
+    PGOMultiVersioningPass().run(*M, MAM);
+    EXPECT_FALSE(verifyModule(*M, &errs()));
+  }
+};
+
+TEST_F(PGOMultiVersioningTest, ClonesHotLoops) {
+  run();
+
+  GlobalIFunc *IFunc = M->getNamedIFunc("hot");
+  ASSERT_TRUE(IFunc);
+  EXPECT_EQ(IFunc->getLinkage(), GlobalValue::ExternalLinkage);
+  EXPECT_EQ(IFunc->getResolverFunction(), M->getFunction("hot.resolver"));
+
+  Function *Default = M->getFunction("hot.default");
+  ASSERT_TRUE(Default);
+  EXPECT_TRUE(Default->hasInternalLinkage());
+  EXPECT_EQ(Default->getFnAttribute("target-cpu").getValueAsString(),
+            "x86-64");
+  for (StringRef Level : {"x86-64-v3", "x86-64-v4"}) {
+    Function *Clone = M->getFunction(("hot." + Level).str());
+    ASSERT_TRUE(Clone);
+    EXPECT_TRUE(Clone->hasInternalLinkage());
+    EXPECT_EQ(Clone->getFnAttribute("target-cpu").getValueAsString(), Level);
+    EXPECT_TRUE(Clone->getFnAttribute("target-features")
+                    .getValueAsString()
+                    .contains("+avx2"));
+  }
+
+  // Calls go through the IFUNC.
+  auto *Call = cast<CallInst>(&M->getFunction("main")->getEntryBlock().front());
+  EXPECT_EQ(Call->getCalledOperand(), IFunc);
+
+  // The loop of @cold is not hot, and @v4 already targets every level.
+  EXPECT_FALSE(M->getNamedIFunc("cold"));
+  EXPECT_FALSE(M->getNamedIFunc("v4"));
+  EXPECT_FALSE(M->getFunction("cold.x86-64-v3"));
+  EXPECT_FALSE(M->getFunction("v4.x86-64-v4"));
+}
+
+TEST_F(PGOMultiVersioningTest, SizeBudget) {
+  MaxGrowth->setValue(0);
+  run();
+
+  EXPECT_FALSE(M->getNamedIFunc("hot"));
+  EXPECT_TRUE(M->getFunction("hot"));
+  EXPECT_FALSE(M->getFunction("hot.x86-64-v3"));
+}
+
+const char *PGOMultiVersioningTest::IRString = R"IR(
+  target triple = "x86_64-unknown-linux-gnu"
+
+  define void @hot(ptr %p, i64 %n) #0 !prof !14 {
+  entry:
+    br label %loop
+
+  loop:
+    %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+    %addr = getelementptr float, ptr %p, i64 %i
+    %v = load float, ptr %addr
+    %m = fmul float %v, 2.0
+    store float %m, ptr %addr
+    %i.next = add i64 %i, 1
+    %c = icmp ult i64 %i.next, %n
+    br i1 %c, label %loop, label %exit, !prof !17
+
+  exit:
+    ret void
+  }
+
+  define void @cold(ptr %p, i64 %n) #0 !prof !15 {
+  entry:
+    br label %loop
+
+  loop:
+    %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+    %addr = getelementptr float, ptr %p, i64 %i
+    %v = load float, ptr %addr
+    %m = fmul float %v, 2.0
+    store float %m, ptr %addr
+    %i.next = add i64 %i, 1
+    %c = icmp ult i64 %i.next, %n
+    br i1 %c, label %loop, label %exit, !prof !17
+
+  exit:
+    ret void
+  }
+
+  define void @v4(ptr %p, i64 %n) #1 !prof !14 {
+  entry:
+    br label %loop
+
+  loop:
+    %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+    %addr = getelementptr float, ptr %p, i64 %i
+    %v = load float, ptr %addr
+    %m = fmul float %v, 2.0
+    store float %m, ptr %addr
+    %i.next = add i64 %i, 1
+    %c = icmp ult i64 %i.next, %n
+    br i1 %c, label %loop, label %exit, !prof !17
+
+  exit:
+    ret void
+  }
+
+  define i32 @main() #0 !prof !16 {
+    call void @hot(ptr null, i64 0)
+    ret i32 0
+  }
+
+  attributes #0 = { "target-cpu"="x86-64" }
+  attributes #1 = { "target-cpu"="x86-64-v4" }
+
+  !llvm.module.flags = !{!0}
+
+  !0 = !{i32 1, !"ProfileSummary", !1}
+  !1 = !{!2, !3, !4, !5, !6, !7, !8, !9}
+  !2 = !{!"ProfileFormat", !"InstrProf"}
+  !3 = !{!"TotalCount", i64 10000}
+  !4 = !{!"MaxCount", i64 10}
+  !5 = !{!"MaxInternalCount", i64 1}
+  !6 = !{!"MaxFunctionCount", i64 1000}
+  !7 = !{!"NumCounts", i64 3}
+  !8 = !{!"NumFunctions", i64 3}
+  !9 = !{!"DetailedSummary", !10}
+  !10 = !{!11, !12, !13}
+  !11 = !{i32 10000, i64 1000, i32 1}
+  !12 = !{i32 999000, i64 300, i32 3}
+  !13 = !{i32 999999, i64 5, i32 10}
+  !14 = !{!"function_entry_count", i64 400}
+  !15 = !{!"function_entry_count", i64 1}
+  !16 = !{!"function_entry_count", i64 1}
+  !17 = !{!"branch_weights", i32 100, i32 1}
+)IR";
+
+} // end anonymous namespace
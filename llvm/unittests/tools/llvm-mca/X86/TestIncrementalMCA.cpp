@@ -185,3 +185,24 @@ TEST_F(X86TestBase, TestInstructionRecycling) {
     ASSERT_EQ(*BV, *V) << "Value of '" << F << "' does not match";
   }
 }
+
+TEST_F(X86TestBase, TestDescriptorsSurviveResetWarnings) {
+  SmallVector<MCInst> MCIs;
+  getSimpleInsts(MCIs);
+
+  auto IM = std::make_unique<mca::InstrumentManager>(*STI, *MCII);
+  mca::InstrBuilder IB(*STI, *MCII, *MRI, MCIA.get(), *IM);
+
+  const SmallVector<mca::SharedInstrument> Instruments;
+  Expected<std::unique_ptr<mca::Instruction>> First =
+      IB.createInstruction(MCIs[0], Instruments);
+  ASSERT_TRUE(bool(First));
+
+  // Starting a new code region must not invalidate the descriptors that
+  // have already been built.
+  IB.resetWarnings();
+  Expected<std::unique_ptr<mca::Instruction>> Second =
+      IB.createInstruction(MCIs[0], Instruments);
+  ASSERT_TRUE(bool(Second));
+  ASSERT_EQ(&(*First)->getDesc(), &(*Second)->getDesc());
+}
@@ -18,6 +18,7 @@
 #include "CodeGenIntrinsics.h"
 #include "CodeGenSchedule.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/TableGen/Error.h"
 #include "llvm/TableGen/Record.h"
@@ -538,6 +539,11 @@ void CodeGenTarget::reverseBitsForLittleEndianEncoding() {
   if (!isLittleEndianEncoding())
     return;
 
+  // Several backends may run on the same records, so only reverse them once.
+  static SmallPtrSet<const RecordKeeper *, 1> ReversedRecords;
+  if (!ReversedRecords.insert(&Records).second)
+    return;
+
   std::vector<Record *> Insts =
       Records.getAllDerivedDefinitions("InstructionEncoding");
   for (Record *R : Insts) {
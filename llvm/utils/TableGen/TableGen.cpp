@@ -284,11 +284,25 @@ bool LLVMTableGenMain(raw_ostream &OS, RecordKeeper &Records) {
 }
 }
 
+static bool LLVMTableGenAction(StringRef Name, raw_ostream &OS,
+                               RecordKeeper &Records) {
+  ActionType Val;
+  if (Action.getParser().parse(Action, Name, "", Val)) {
+    errs() << "unknown action '" << Name << "'\n";
+    return true;
+  }
+  ActionType MainAction = Action;
+  Action = Val;
+  bool Failed = LLVMTableGenMain(OS, Records);
+  Action = MainAction;
+  return Failed;
+}
+
 int main(int argc, char **argv) {
   InitLLVM X(argc, argv);
   cl::ParseCommandLineOptions(argc, argv);
 
-  return TableGenMain(argv[0], &LLVMTableGenMain);
+  return TableGenMain(argv[0], &LLVMTableGenMain, &LLVMTableGenAction);
 }
 
 #ifndef __has_feature
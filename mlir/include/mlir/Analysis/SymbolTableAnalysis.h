@@ -0,0 +1,60 @@
+//===- SymbolTableAnalysis.h - Cached symbol tables and users ---*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef MLIR_ANALYSIS_SYMBOLTABLEANALYSIS_H
+#define MLIR_ANALYSIS_SYMBOLTABLEANALYSIS_H
+
+#include "mlir/IR/SymbolTable.h"
+
+#include <memory>
+#include <mutex>
+
+namespace mlir {
+
+/// An analysis holding the symbol tables, and on request the symbol user map,
+/// of the symbol tables nested under an operation. Building these requires
+/// walking every symbol and every symbol use, so passes that neither add,
+/// remove nor rename symbols, nor add or drop symbol uses, should mark this
+/// analysis as preserved to let later passes reuse it.
+///
+/// Nested passes running in parallel may query the analysis of an ancestor
+/// through `getCachedParentAnalysis`, and should then only go through
+/// `getLockedSymbolTables` and `getSymbolUserMap`.
+class SymbolTableAnalysis {
+public:
+  explicit SymbolTableAnalysis(Operation *op);
+
+  /// Returns the symbol tables. This must not be used concurrently with any
+  /// other access to the analysis.
+  SymbolTableCollection &getSymbolTables() { return symbolTables; }
+
+  /// Returns a view of the symbol tables that is safe to use from multiple
+  /// threads.
+  SymbolTableCollection &getLockedSymbolTables() { return lockedSymbolTables; }
+
+  /// Returns the map from symbols to their users, building it on first use.
+  /// Callers that modify symbol uses must keep it up to date (e.g. through
+  /// `SymbolUserMap::replaceAllUsesWith`) or not preserve the analysis.
+  SymbolUserMap &getSymbolUserMap();
+
+private:
+  /// The operation the analysis was built for.
+  Operation *op;
+
+  SymbolTableCollection symbolTables;
+  LockedSymbolTableCollection lockedSymbolTables;
+
+  /// The lazily built user map, along with the flag guarding its
+  /// construction.
+  std::unique_ptr<SymbolUserMap> userMap;
+  std::once_flag userMapFlag;
+};
+
+} // namespace mlir
+
+#endif // MLIR_ANALYSIS_SYMBOLTABLEANALYSIS_H
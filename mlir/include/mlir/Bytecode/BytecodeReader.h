@@ -16,11 +16,64 @@
 #include "mlir/IR/AsmState.h"
 #include "mlir/Support/LLVM.h"
 
+#include <memory>
+
 namespace llvm {
 class MemoryBufferRef;
+class SourceMgr;
 } // namespace llvm
 
 namespace mlir {
+/// The BytecodeReader allows to load MLIR bytecode files, while keeping the
+/// state explicitly available in order to support lazy loading. Operations
+/// that are lazily loaded have empty regions until they are materialized, and
+/// must not be erased before they are materialized or finalized.
+class BytecodeReader {
+public:
+  /// Create a bytecode reader for the given buffer. If `lazyLoad` is true,
+  /// isolated regions aren't loaded eagerly. The buffer and the config must
+  /// outlive the reader. If `bufferOwnerRef` is provided, it must own the
+  /// buffer, and blob resources within the bytecode alias the buffer and keep
+  /// it alive instead of being copied.
+  explicit BytecodeReader(
+      llvm::MemoryBufferRef buffer, const ParserConfig &config, bool lazyLoad,
+      const std::shared_ptr<llvm::SourceMgr> &bufferOwnerRef = {});
+  ~BytecodeReader();
+
+  /// Read the operations defined within the given memory buffer, containing
+  /// MLIR bytecode, into the provided block. If the reader was created with
+  /// `lazyLoad` enabled, `lazyOps` is invoked for every operation that can be
+  /// lazily loaded, and returns true if its regions should be materialized
+  /// later instead of now.
+  LogicalResult readTopLevel(
+      Block *block, function_ref<bool(Operation *)> lazyOps =
+                        [](Operation *) { return false; });
+
+  /// Return the number of ops that haven't been materialized yet.
+  int64_t getNumOpsToMaterialize() const;
+
+  /// Return true if the provided op is materializable.
+  bool isMaterializable(Operation *op);
+
+  /// Materialize the regions of the provided operation, which must be
+  /// materializable. `lazyOpsCallback` is invoked for every newly found
+  /// operation that can be lazily loaded.
+  LogicalResult materialize(
+      Operation *op, function_ref<bool(Operation *)> lazyOpsCallback =
+                         [](Operation *) { return false; });
+
+  /// Finalize the lazy loading by calling back with every op that hasn't been
+  /// materialized yet. The op is materialized if the callback returns true,
+  /// and its regions are left empty otherwise.
+  LogicalResult finalize(function_ref<bool(Operation *)> shouldMaterialize =
+                             [](Operation *) { return true; });
+
+  class Impl;
+
+private:
+  std::unique_ptr<Impl> impl;
+};
+
 /// Returns true if the given buffer starts with the magic bytes that signal
 /// MLIR bytecode.
 bool isBytecode(llvm::MemoryBufferRef buffer);
@@ -29,6 +82,13 @@ bool isBytecode(llvm::MemoryBufferRef buffer);
 /// bytecode, into the provided block.
 LogicalResult readBytecodeFile(llvm::MemoryBufferRef buffer, Block *block,
                                const ParserConfig &config);
+/// An overload with a source manager whose main buffer contains MLIR bytecode.
+/// The source manager is kept alive by the blob resources of the bytecode,
+/// which alias its buffer instead of being copied, e.g. to avoid copying the
+/// data of large resources out of a memory mapped file.
+LogicalResult
+readBytecodeFile(const std::shared_ptr<llvm::SourceMgr> &sourceMgr,
+                 Block *block, const ParserConfig &config);
 } // namespace mlir
 
 #endif // MLIR_BYTECODE_BYTECODEREADER_H
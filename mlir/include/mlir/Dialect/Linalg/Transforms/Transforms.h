@@ -430,6 +430,49 @@ computeMultiTileSizes(OpBuilder &builder, LinalgOp op, unsigned dimension,
                       OpFoldResult targetSize, OpFoldResult divisor,
                       bool emitAssertions = true);
 
+/// A description of the memory hierarchy of a CPU, used to pick tile sizes.
+struct LinalgCacheModel {
+  /// The sizes of the data caches in bytes, innermost level first.
+  SmallVector<int64_t> cacheSizes = {32 * 1024, 1024 * 1024};
+  /// The size of the vector registers in bytes.
+  int64_t vectorSize = 32;
+  /// The number of vector registers available for accumulators.
+  int64_t numVectorRegisters = 16;
+  /// The fraction of each cache the tiles are allowed to occupy. The rest is
+  /// left for the lines of other data that is not evicted in time.
+  double cacheUtilization = 0.5;
+
+  /// Returns the model described by the `dlti.cache_sizes` and
+  /// `dlti.vector_size` entries of the closest data layout specification
+  /// enclosing `op`. Missing entries keep their default value.
+  static LinalgCacheModel get(Operation *op);
+};
+
+/// Tile sizes computed by `computeCacheTileSizes`.
+struct LinalgCacheTileSizes {
+  /// The tile sizes for each cache level, outermost level first, with one
+  /// entry per loop. Zero means that the loop is not tiled at this level.
+  SmallVector<SmallVector<int64_t>> tileSizes;
+  /// The sizes of the innermost tile, to be vectorized. The innermost parallel
+  /// loop of the first output is tiled by the number of vector lanes, and
+  /// further parallel loops of the output are unrolled while the accumulators
+  /// fit in the vector registers. Reduction loops are not unrolled.
+  SmallVector<int64_t> vectorSizes;
+};
+
+/// Picks multi-level tile sizes and vector sizes for `op` with an analytic
+/// model of the caches described by `model`. For every cache level, from the
+/// innermost to the outermost one, the tile of the level below is doubled
+/// along the loop that most increases the number of iterations per byte of
+/// operand data, as long as the operand tiles fit in the cache. The tiles of
+/// a level thus are multiples of the tiles of the level below.
+///
+/// Fails if any loop range is dynamic, or if an operand is indexed with an
+/// expression that is not a linear combination of the loops with constant
+/// coefficients. Convolution windows such as `d1 * 2 + d4` are supported.
+FailureOr<LinalgCacheTileSizes>
+computeCacheTileSizes(LinalgOp op, const LinalgCacheModel &model);
+
 /// Rewrite a TilingInterface `op` to a tiled `scf.foreach_thread`, applying
 /// tiling by `numThreads`.
 /// If non-empty, the `mapping` is added as an attribute to the
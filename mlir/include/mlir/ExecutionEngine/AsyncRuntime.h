@@ -126,12 +126,26 @@ mlirAsyncRuntimeAwaitAllInGroupAndExecute(AsyncGroup *, CoroHandle, CoroResume);
 // Returns the current number of available worker threads in the threadpool.
 extern "C" int64_t mlirAsyncRuntimGetNumWorkerThreads();
 
+// Returns the number of tasks executed by the worker threads so far.
+extern "C" int64_t mlirAsyncRuntimeGetNumExecutedTasks();
+
+// Returns the number of tasks that were stolen by a worker thread from the
+// queue of another worker thread.
+extern "C" int64_t mlirAsyncRuntimeGetNumStolenTasks();
+
+// Returns the total time the worker threads spent waiting for tasks, in
+// nanoseconds.
+extern "C" int64_t mlirAsyncRuntimeGetIdleTimeNs();
+
 //===----------------------------------------------------------------------===//
 // Small async runtime support library for testing.
 //===----------------------------------------------------------------------===//
 
 extern "C" void mlirAsyncRuntimePrintCurrentThreadId();
 
+// Prints the task, steal and idle time counters of the runtime scheduler.
+extern "C" void mlirAsyncRuntimePrintStatistics();
+
 } // namespace runtime
 } // namespace mlir
 
@@ -21,6 +21,7 @@
 #include <cassert>
 #include <cinttypes>
 #include <functional>
+#include <thread>
 #include <vector>
 
 namespace mlir {
@@ -68,6 +69,56 @@ struct ElementLT final {
   const uint64_t rank;
 };
 
+namespace detail {
+/// The minimum number of elements that each thread of `parallelSort` sorts.
+/// Below this, the cost of starting threads outweighs the gains.
+constexpr uint64_t kMinParallelSortChunkSize = 1 << 16;
+
+/// Runs `fn(i)` for each `i` in `[0, n)` on its own thread, then waits for
+/// all of them to finish.
+template <typename Fn>
+void forEachInParallel(uint64_t n, Fn fn) {
+  std::vector<std::thread> threads;
+  threads.reserve(n);
+  for (uint64_t i = 1; i < n; ++i)
+    threads.emplace_back(fn, i);
+  fn(0);
+  for (std::thread &thread : threads)
+    thread.join();
+}
+
+/// Sorts the range `[begin, end)` a la `std::sort`.  Large ranges are split
+/// into one chunk per hardware thread, the chunks are sorted in parallel, and
+/// then merged pairwise, again in parallel.
+template <typename RandomIt, typename Compare>
+void parallelSort(RandomIt begin, RandomIt end, Compare cmp) {
+  const uint64_t size = end - begin;
+  const uint64_t numChunks = std::min<uint64_t>(
+      std::thread::hardware_concurrency(), size / kMinParallelSortChunkSize);
+  if (numChunks < 2) {
+    std::sort(begin, end, cmp);
+    return;
+  }
+  std::vector<RandomIt> bounds(numChunks + 1);
+  for (uint64_t c = 0; c <= numChunks; ++c)
+    bounds[c] = begin + size * c / numChunks;
+  forEachInParallel(numChunks, [&](uint64_t c) {
+    std::sort(bounds[c], bounds[c + 1], cmp);
+  });
+  // Merge runs of `width` sorted chunks until a single run remains.
+  for (uint64_t width = 1; width < numChunks; width *= 2) {
+    const uint64_t numMerges = (numChunks + 2 * width - 1) / (2 * width);
+    forEachInParallel(numMerges, [&](uint64_t m) {
+      const uint64_t lo = 2 * width * m;
+      const uint64_t mid = std::min(lo + width, numChunks);
+      const uint64_t hi = std::min(lo + 2 * width, numChunks);
+      if (mid < hi)
+        std::inplace_merge(bounds[lo], bounds[mid], bounds[hi], cmp);
+    });
+  }
+}
+} // namespace detail
+
 /// The type of callback functions which receive an element.  We avoid
 /// packaging the coordinates and value together as an `Element` object
 /// because this helps keep code somewhat cleaner.
@@ -190,12 +241,13 @@ public:
 
   /// Sorts elements lexicographically by index.  If an index is mapped to
   /// multiple values, then the relative order of those values is unspecified.
+  /// Large tensors are sorted using multiple threads.
   ///
   /// This method invalidates all iterators.
   void sort() {
     if (isSorted)
       return;
-    std::sort(elements.begin(), elements.end(), getElementLT());
+    detail::parallelSort(elements.begin(), elements.end(), getElementLT());
     isSorted = true;
   }
 
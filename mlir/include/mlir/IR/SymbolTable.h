@@ -11,8 +11,10 @@
 
 #include "mlir/IR/Attributes.h"
 #include "mlir/IR/OpDefinition.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/StringMap.h"
+#include "llvm/Support/RWMutex.h"
 
 namespace mlir {
 
@@ -244,10 +246,14 @@ raw_ostream &operator<<(raw_ostream &os, SymbolTable::Visibility visibility);
 /// unnecessary tables.
 class SymbolTableCollection {
 public:
+  virtual ~SymbolTableCollection() = default;
+
   /// Look up a symbol with the specified name within the specified symbol table
   /// operation, returning null if no such name exists.
-  Operation *lookupSymbolIn(Operation *symbolTableOp, StringAttr symbol);
-  Operation *lookupSymbolIn(Operation *symbolTableOp, SymbolRefAttr name);
+  virtual Operation *lookupSymbolIn(Operation *symbolTableOp,
+                                    StringAttr symbol);
+  virtual Operation *lookupSymbolIn(Operation *symbolTableOp,
+                                    SymbolRefAttr name);
   template <typename T, typename NameT>
   T lookupSymbolIn(Operation *symbolTableOp, NameT &&name) {
     return dyn_cast_or_null<T>(
@@ -257,15 +263,18 @@ public:
   /// by a given SymbolRefAttr when resolved within the provided symbol table
   /// operation. Returns failure if any of the nested references could not be
   /// resolved.
-  LogicalResult lookupSymbolIn(Operation *symbolTableOp, SymbolRefAttr name,
-                               SmallVectorImpl<Operation *> &symbols);
+  virtual LogicalResult lookupSymbolIn(Operation *symbolTableOp,
+                                       SymbolRefAttr name,
+                                       SmallVectorImpl<Operation *> &symbols);
 
   /// Returns the operation registered with the given symbol name within the
   /// closest parent operation of, or including, 'from' with the
   /// 'OpTrait::SymbolTable' trait. Returns nullptr if no valid symbol was
   /// found.
-  Operation *lookupNearestSymbolFrom(Operation *from, StringAttr symbol);
-  Operation *lookupNearestSymbolFrom(Operation *from, SymbolRefAttr symbol);
+  virtual Operation *lookupNearestSymbolFrom(Operation *from,
+                                             StringAttr symbol);
+  virtual Operation *lookupNearestSymbolFrom(Operation *from,
+                                             SymbolRefAttr symbol);
   template <typename T>
   T lookupNearestSymbolFrom(Operation *from, StringAttr symbol) {
     return dyn_cast_or_null<T>(lookupNearestSymbolFrom(from, symbol));
@@ -276,13 +285,63 @@ public:
   }
 
   /// Lookup, or create, a symbol table for an operation.
-  SymbolTable &getSymbolTable(Operation *op);
+  virtual SymbolTable &getSymbolTable(Operation *op);
+
+  /// Drop the symbol table cached for the given operation, if any. This must
+  /// be called when symbols are added to or removed from `op` without going
+  /// through its cached SymbolTable.
+  virtual void invalidateSymbolTable(Operation *op);
 
 private:
   /// The constructed symbol tables nested within this table.
   DenseMap<Operation *, std::unique_ptr<SymbolTable>> symbolTables;
 };
 
+//===----------------------------------------------------------------------===//
+// LockedSymbolTableCollection
+//===----------------------------------------------------------------------===//
+
+/// This class implements a lock-protected view of a SymbolTableCollection, so
+/// that the symbol tables it holds can be queried and lazily constructed from
+/// multiple threads, e.g. from passes running on sibling operations in
+/// parallel. Lookups only take a shared lock once the table of the queried
+/// symbol table operation has been built. Modifying the returned SymbolTables
+/// is not synchronized.
+class LockedSymbolTableCollection : public SymbolTableCollection {
+public:
+  /// Create a lock-protected view of the given collection. The collection must
+  /// outlive this view, and should not be accessed directly while the view is
+  /// in use.
+  explicit LockedSymbolTableCollection(SymbolTableCollection &collection)
+      : collection(collection) {}
+
+  using SymbolTableCollection::lookupNearestSymbolFrom;
+  using SymbolTableCollection::lookupSymbolIn;
+
+  Operation *lookupSymbolIn(Operation *symbolTableOp,
+                            StringAttr symbol) override;
+  Operation *lookupSymbolIn(Operation *symbolTableOp,
+                            SymbolRefAttr name) override;
+  LogicalResult lookupSymbolIn(Operation *symbolTableOp, SymbolRefAttr name,
+                               SmallVectorImpl<Operation *> &symbols) override;
+  Operation *lookupNearestSymbolFrom(Operation *from,
+                                     StringAttr symbol) override;
+  Operation *lookupNearestSymbolFrom(Operation *from,
+                                     SymbolRefAttr symbol) override;
+  SymbolTable &getSymbolTable(Operation *op) override;
+  void invalidateSymbolTable(Operation *op) override;
+
+private:
+  /// The underlying collection.
+  SymbolTableCollection &collection;
+
+  /// The symbol tables that have been constructed through this view.
+  DenseSet<Operation *> constructedTables;
+
+  /// Guards `collection` and `constructedTables`.
+  llvm::sys::SmartRWMutex<true> mutex;
+};
+
 //===----------------------------------------------------------------------===//
 // SymbolUserMap
 //===----------------------------------------------------------------------===//
@@ -17,6 +17,7 @@
 #include "mlir/IR/Builders.h"
 #include "mlir/IR/OwningOpRef.h"
 #include <cstddef>
+#include <memory>
 
 namespace llvm {
 class SourceMgr;
@@ -93,6 +94,13 @@ inline OwningOpRef<ContainerOpT> constructContainerOpForParserIfNecessary(
 LogicalResult parseSourceFile(const llvm::SourceMgr &sourceMgr, Block *block,
                               const ParserConfig &config,
                               LocationAttr *sourceFileLoc = nullptr);
+/// An overload with a source manager that may be kept alive beyond parsing,
+/// which allows for blob resources of MLIR bytecode to alias the source buffer
+/// instead of being copied.
+LogicalResult
+parseSourceFile(const std::shared_ptr<llvm::SourceMgr> &sourceMgr,
+                Block *block, const ParserConfig &config,
+                LocationAttr *sourceFileLoc = nullptr);
 
 /// This parses the file specified by the indicated filename and appends parsed
 /// operations to the given block. If the block is non-empty, the operations are
@@ -157,6 +165,15 @@ inline OwningOpRef<ContainerOpT>
 parseSourceFile(const llvm::SourceMgr &sourceMgr, const ParserConfig &config) {
   return detail::parseSourceFile<ContainerOpT>(config, sourceMgr);
 }
+/// An overload with a source manager that may be kept alive beyond parsing,
+/// which allows for blob resources of MLIR bytecode to alias the source buffer
+/// instead of being copied.
+template <typename ContainerOpT = Operation *>
+inline OwningOpRef<ContainerOpT>
+parseSourceFile(const std::shared_ptr<llvm::SourceMgr> &sourceMgr,
+                const ParserConfig &config) {
+  return detail::parseSourceFile<ContainerOpT>(config, sourceMgr);
+}
 
 /// This parses the file specified by the indicated filename. If the source IR
 /// contained a single instance of `ContainerOpT`, it is returned. Otherwise, a
@@ -19,6 +19,7 @@
 #include "llvm/Support/raw_ostream.h"
 
 #include <functional>
+#include <memory>
 #include <vector>
 
 namespace llvm {
@@ -190,6 +191,49 @@ private:
   friend detail::OpPassManagerImpl;
 };
 
+//===----------------------------------------------------------------------===//
+// PassPipelineCache
+//===----------------------------------------------------------------------===//
+
+/// A cache of the results of the pipelines that a pass manager runs on nested
+/// operations, e.g. of the `func.func` pipeline in
+/// `builtin.module(func.func(...))`. The results are keyed by a hash of the
+/// pipeline and of the operation it runs on, including its attributes,
+/// regions and locations. When a pipeline is about to run on an operation it
+/// already transformed in a previous run, the operation is replaced by the
+/// cached result instead. To be useful, the cache is kept across the runs of
+/// the pass managers of a context.
+///
+/// Only the pipelines nested directly under the pass manager are cached. They
+/// must only depend on the operation they run on, and not, for example, on the
+/// symbols defined by its parent. Results are only cached if the pipeline
+/// succeeds.
+class PassPipelineCache {
+public:
+  /// If `directory` is not empty, the results are also written to
+  /// `directory` as bytecode files, and looked up there when they are not in
+  /// memory. This shares the cache with other processes and across restarts,
+  /// which must run the same version of the compiler.
+  explicit PassPipelineCache(StringRef directory = "");
+  ~PassPipelineCache();
+
+  /// Returns the bytecode of the result cached for `key`, if any.
+  Optional<std::string> lookup(StringRef key);
+
+  /// Caches the bytecode of the result for `key`.
+  void insert(StringRef key, std::string bytecode);
+
+  /// Returns the number of lookups that found a result, and that did not.
+  unsigned getNumHits() const;
+  unsigned getNumMisses() const;
+
+private:
+  struct Impl;
+
+  /// The internal implementation of the cache.
+  std::unique_ptr<Impl> impl;
+};
+
 //===----------------------------------------------------------------------===//
 // PassManager
 //===----------------------------------------------------------------------===//
@@ -263,6 +307,11 @@ public:
   /// Runs the verifier after each individual pass.
   void enableVerifier(bool enabled = true);
 
+  /// Reuse the results of the pipelines nested under this pass manager from
+  /// `cache`, see `PassPipelineCache`. The cache must outlive the pass
+  /// manager. A null `cache` disables caching.
+  void enablePipelineCache(PassPipelineCache *cache) { pipelineCache = cache; }
+
   //===--------------------------------------------------------------------===//
   // Instrumentations
   //===--------------------------------------------------------------------===//
@@ -440,6 +489,9 @@ private:
   /// A hash key used to detect when reinitialization is necessary.
   llvm::hash_code initializationKey;
 
+  /// An optional cache of the results of the nested pipelines.
+  PassPipelineCache *pipelineCache = nullptr;
+
   /// Flag that specifies if pass timing is enabled.
   bool passTiming : 1;
 
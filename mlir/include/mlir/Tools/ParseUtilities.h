@@ -32,6 +32,18 @@ parseSourceFileForTool(llvm::SourceMgr &sourceMgr, const ParserConfig &config,
   }
   return parseSourceFile(sourceMgr, config);
 }
+/// An overload with a source manager that may be kept alive beyond parsing,
+/// which allows for blob resources of MLIR bytecode to alias the source buffer
+/// instead of being copied.
+inline OwningOpRef<Operation *>
+parseSourceFileForTool(const std::shared_ptr<llvm::SourceMgr> &sourceMgr,
+                       const ParserConfig &config, bool insertImplicitModule) {
+  if (insertImplicitModule) {
+    // TODO: Move implicit module logic out of 'parseSourceFile' and into here.
+    return parseSourceFile<ModuleOp>(sourceMgr, config);
+  }
+  return parseSourceFile(sourceMgr, config);
+}
 } // namespace mlir
 
 #endif // MLIR_TOOLS_PARSEUTILITIES_H
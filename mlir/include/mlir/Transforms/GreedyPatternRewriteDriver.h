@@ -15,9 +15,42 @@
 #define MLIR_TRANSFORMS_GREEDYPATTERNREWRITEDRIVER_H_
 
 #include "mlir/Rewrite/FrozenRewritePatternSet.h"
+#include "llvm/ADT/StringMap.h"
+
+#include <chrono>
 
 namespace mlir {
 
+/// This class accumulates statistics about the patterns applied by the greedy
+/// pattern rewrite driver.
+class GreedyRewriteStatistics {
+public:
+  /// The statistics of a single pattern.
+  struct PatternStatistics {
+    /// The number of times that the pattern was attempted, and succeeded.
+    unsigned numAttempts = 0;
+    unsigned numSuccesses = 0;
+
+    /// The time spent matching and rewriting with the pattern.
+    std::chrono::nanoseconds time{0};
+  };
+
+  /// Record an attempt to apply the given pattern.
+  void recordAttempt(const Pattern &pattern, bool succeeded,
+                     std::chrono::nanoseconds time);
+
+  /// Print the statistics of each pattern, the most expensive first.
+  void print(raw_ostream &os) const;
+
+  /// Return the statistics of each pattern, keyed by debug name.
+  const llvm::StringMap<PatternStatistics> &getPatternStatistics() const {
+    return patterns;
+  }
+
+private:
+  llvm::StringMap<PatternStatistics> patterns;
+};
+
 /// This class allows control over how the GreedyPatternRewriteDriver works.
 class GreedyRewriteConfig {
 public:
@@ -38,6 +71,20 @@ public:
   int64_t maxIterations = 10;
 
   static constexpr int64_t kNoIterationLimit = -1;
+
+  /// When set to true, the regions aren't scanned again to find the fixpoint.
+  /// Instead, operations are only revisited when the rewriter is notified of a
+  /// change that may affect them: a change to the operation itself, to the
+  /// producers of its operands, to its users, or to the operations nested in
+  /// its regions. Operations that failed to match are thus not attempted again
+  /// until then. This requires patterns to notify the rewriter of all of their
+  /// changes. The regions are only scanned again if region simplification
+  /// changed them.
+  bool useIncrementalWorklist = false;
+
+  /// If set, the statistics of the patterns that were attempted are
+  /// accumulated here.
+  GreedyRewriteStatistics *statistics = nullptr;
 };
 
 //===----------------------------------------------------------------------===//
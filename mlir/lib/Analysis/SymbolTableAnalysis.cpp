@@ -0,0 +1,23 @@
+//===- SymbolTableAnalysis.cpp - Cached symbol tables and users -----------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Analysis/SymbolTableAnalysis.h"
+
+using namespace mlir;
+
+SymbolTableAnalysis::SymbolTableAnalysis(Operation *op)
+    : op(op), lockedSymbolTables(symbolTables) {}
+
+SymbolUserMap &SymbolTableAnalysis::getSymbolUserMap() {
+  // The map keeps a reference to the collection used to build it. Use the
+  // locked view so that lookups made later through the map are thread-safe.
+  std::call_once(userMapFlag, [&] {
+    userMap = std::make_unique<SymbolUserMap>(lockedSymbolTables, op);
+  });
+  return *userMap;
+}
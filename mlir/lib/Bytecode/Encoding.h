@@ -23,8 +23,16 @@ namespace bytecode {
 //===----------------------------------------------------------------------===//
 
 enum {
+  /// The oldest bytecode version that can still be read.
+  kMinSupportedVersion = 0,
+
+  /// The version that started encoding the regions of operations that are
+  /// isolated from above in a nested IR section, so that readers can skip them
+  /// and load them lazily.
+  kLazyLoading = 1,
+
   /// The current bytecode version.
-  kVersion = 0,
+  kVersion = 1,
 
   /// An arbitrary value used to fill alignment padding.
   kAlignmentByte = 0xCB,
@@ -16,6 +16,7 @@
 #include "mlir/IR/BuiltinDialect.h"
 #include "mlir/IR/BuiltinOps.h"
 #include "mlir/IR/OpImplementation.h"
+#include "mlir/IR/Threading.h"
 #include "mlir/IR/Verifier.h"
 #include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/ScopeExit.h"
@@ -23,6 +24,9 @@
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/Support/MemoryBufferRef.h"
 #include "llvm/Support/SaveAndRestore.h"
+#include "llvm/Support/SourceMgr.h"
+
+#include <list>
 
 #define DEBUG_TYPE "mlir-bytecode-reader"
 
@@ -488,12 +492,15 @@ namespace {
 /// This class is used to read the resource section from the bytecode.
 class ResourceSectionReader {
 public:
-  /// Initialize the resource section reader with the given section data.
-  LogicalResult initialize(Location fileLoc, const ParserConfig &config,
-                           MutableArrayRef<BytecodeDialect> dialects,
-                           StringSectionReader &stringReader,
-                           ArrayRef<uint8_t> sectionData,
-                           ArrayRef<uint8_t> offsetSectionData);
+  /// Initialize the resource section reader with the given section data. If
+  /// `bufferOwnerRef` is non-null, it owns the buffer holding the section
+  /// data, and blobs alias the buffer instead of being copied.
+  LogicalResult
+  initialize(Location fileLoc, const ParserConfig &config,
+             MutableArrayRef<BytecodeDialect> dialects,
+             StringSectionReader &stringReader, ArrayRef<uint8_t> sectionData,
+             ArrayRef<uint8_t> offsetSectionData,
+             const std::shared_ptr<llvm::SourceMgr> &bufferOwnerRef);
 
   /// Parse a dialect resource handle from the resource section.
   LogicalResult parseResourceHandle(EncodingReader &reader,
@@ -509,8 +516,10 @@ private:
 class ParsedResourceEntry : public AsmParsedResourceEntry {
 public:
   ParsedResourceEntry(StringRef key, AsmResourceEntryKind kind,
-                      EncodingReader &reader, StringSectionReader &stringReader)
-      : key(key), kind(kind), reader(reader), stringReader(stringReader) {}
+                      EncodingReader &reader, StringSectionReader &stringReader,
+                      const std::shared_ptr<llvm::SourceMgr> &bufferOwnerRef)
+      : key(key), kind(kind), reader(reader), stringReader(stringReader),
+        bufferOwnerRef(bufferOwnerRef) {}
   ~ParsedResourceEntry() override = default;
 
   StringRef getKey() const final { return key; }
@@ -551,11 +560,20 @@ public:
     if (failed(reader.parseBlobAndAlignment(data, alignment)))
       return failure();
 
-    // Allocate memory for the blob using the provided allocator and copy the
-    // data into it.
-    // FIXME: If the current holder of the bytecode can ensure its lifetime
-    // (e.g. when mmap'd), we should not copy the data. We should use the data
-    // from the bytecode directly.
+    // If the buffer is shared with us, keep it alive for as long as the blob
+    // is and use the data in place. The data was already checked to be
+    // aligned when parsed.
+    if (bufferOwnerRef) {
+      ArrayRef<char> charData(reinterpret_cast<const char *>(data.data()),
+                              data.size());
+      return AsmResourceBlob(
+          charData, alignment,
+          [bufferOwnerRef = bufferOwnerRef](void *, size_t, size_t) {},
+          /*dataIsMutable=*/false);
+    }
+
+    // Otherwise, allocate memory for the blob using the provided allocator and
+    // copy the data into it.
     AsmResourceBlob blob = allocator(data.size(), alignment);
     assert(llvm::isAddrAligned(llvm::Align(alignment), blob.getData().data()) &&
            blob.isMutable() &&
@@ -569,6 +587,7 @@ private:
   AsmResourceEntryKind kind;
   EncodingReader &reader;
   StringSectionReader &stringReader;
+  const std::shared_ptr<llvm::SourceMgr> &bufferOwnerRef;
 };
 } // namespace
 
@@ -577,6 +596,7 @@ static LogicalResult
 parseResourceGroup(Location fileLoc, bool allowEmpty,
                    EncodingReader &offsetReader, EncodingReader &resourceReader,
                    StringSectionReader &stringReader, T *handler,
+                   const std::shared_ptr<llvm::SourceMgr> &bufferOwnerRef,
                    function_ref<LogicalResult(StringRef)> processKeyFn = {}) {
   uint64_t numResources;
   if (failed(offsetReader.parseVarInt(numResources)))
@@ -608,7 +628,8 @@ parseResourceGroup(Location fileLoc, bool allowEmpty,
 
     // Otherwise, parse the resource value.
     EncodingReader entryReader(data, fileLoc);
-    ParsedResourceEntry entry(key, kind, entryReader, stringReader);
+    ParsedResourceEntry entry(key, kind, entryReader, stringReader,
+                              bufferOwnerRef);
     if (failed(handler->parseResource(entry)))
       return failure();
     if (!entryReader.empty()) {
@@ -619,12 +640,12 @@ parseResourceGroup(Location fileLoc, bool allowEmpty,
   return success();
 }
 
-LogicalResult
-ResourceSectionReader::initialize(Location fileLoc, const ParserConfig &config,
-                                  MutableArrayRef<BytecodeDialect> dialects,
-                                  StringSectionReader &stringReader,
-                                  ArrayRef<uint8_t> sectionData,
-                                  ArrayRef<uint8_t> offsetSectionData) {
+LogicalResult ResourceSectionReader::initialize(
+    Location fileLoc, const ParserConfig &config,
+    MutableArrayRef<BytecodeDialect> dialects,
+    StringSectionReader &stringReader, ArrayRef<uint8_t> sectionData,
+    ArrayRef<uint8_t> offsetSectionData,
+    const std::shared_ptr<llvm::SourceMgr> &bufferOwnerRef) {
   EncodingReader resourceReader(sectionData, fileLoc);
   EncodingReader offsetReader(offsetSectionData, fileLoc);
 
@@ -638,7 +659,7 @@ ResourceSectionReader::initialize(Location fileLoc, const ParserConfig &config,
   auto parseGroup = [&](auto *handler, bool allowEmpty = false,
                         function_ref<LogicalResult(StringRef)> keyFn = {}) {
     return parseResourceGroup(fileLoc, allowEmpty, offsetReader, resourceReader,
-                              stringReader, handler, keyFn);
+                              stringReader, handler, bufferOwnerRef, keyFn);
   };
 
   // Read the external resources from the bytecode.
@@ -742,6 +763,18 @@ public:
   }
   Type resolveType(size_t index) { return resolveEntry(types, index, "Type"); }
 
+  /// Resolve all of the attributes and types. Once resolved, entries can be
+  /// looked up from multiple threads.
+  LogicalResult resolveAll() {
+    for (size_t i = 0, e = attributes.size(); i != e; ++i)
+      if (!resolveAttribute(i))
+        return failure();
+    for (size_t i = 0, e = types.size(); i != e; ++i)
+      if (!resolveType(i))
+        return failure();
+    return success();
+  }
+
   /// Parse a reference to an attribute or type using the given reader.
   LogicalResult parseAttribute(EncodingReader &reader, Attribute &result) {
     uint64_t attrIdx;
@@ -1051,12 +1084,14 @@ LogicalResult AttrTypeReader::parseCustomEntry(Entry<T> &entry,
 // Bytecode Reader
 //===----------------------------------------------------------------------===//
 
-namespace {
 /// This class is used to read a bytecode buffer and translate it into MLIR.
-class BytecodeReader {
+class mlir::BytecodeReader::Impl {
 public:
-  BytecodeReader(Location fileLoc, const ParserConfig &config)
-      : config(config), fileLoc(fileLoc),
+  Impl(Location fileLoc, const ParserConfig &config, bool lazyLoading,
+       llvm::MemoryBufferRef buffer,
+       const std::shared_ptr<llvm::SourceMgr> &bufferOwnerRef)
+      : config(config), fileLoc(fileLoc), lazyLoading(lazyLoading),
+        buffer(buffer), bufferOwnerRef(bufferOwnerRef),
         attrTypeReader(stringReader, resourceReader, fileLoc),
         // Use the builtin unrealized conversion cast operation to represent
         // forward references to values that aren't yet defined.
@@ -1065,7 +1100,47 @@ public:
                           NoneType::get(config.getContext())) {}
 
   /// Read the bytecode defined within `buffer` into the given block.
-  LogicalResult read(llvm::MemoryBufferRef buffer, Block *block);
+  LogicalResult read(Block *block,
+                     llvm::function_ref<bool(Operation *)> lazyOps);
+
+  /// Return the buffer being read, and the location used for its errors.
+  llvm::MemoryBufferRef getBuffer() const { return buffer; }
+  Location getLocation() const { return fileLoc; }
+
+  /// Return the number of ops that haven't been materialized yet.
+  int64_t getNumOpsToMaterialize() const { return lazyLoadableOpsMap.size(); }
+
+  /// Return true if the provided op is materializable.
+  bool isMaterializable(Operation *op) { return lazyLoadableOpsMap.count(op); }
+
+  /// Materialize the provided operation, invoke the lazyOpsCallback on every
+  /// newly found lazy operation.
+  LogicalResult
+  materialize(Operation *op,
+              llvm::function_ref<bool(Operation *)> lazyOpsCallback) {
+    auto it = lazyLoadableOpsMap.find(op);
+    assert(it != lazyLoadableOpsMap.end() &&
+           "materialize called on non-materializable op");
+    return materialize(it, lazyOpsCallback);
+  }
+
+  /// Materialize all operations, or the ones selected by `shouldMaterialize`.
+  LogicalResult
+  finalize(llvm::function_ref<bool(Operation *)> shouldMaterialize) {
+    while (!lazyLoadableOps.empty()) {
+      Operation *op = lazyLoadableOps.begin()->first;
+      if (shouldMaterialize(op)) {
+        if (failed(materialize(lazyLoadableOpsMap.find(op),
+                               [](Operation *) { return false; })))
+          return failure();
+        continue;
+      }
+      // The regions of the operations that aren't materialized are left empty.
+      lazyLoadableOpsMap.erase(op);
+      lazyLoadableOps.pop_front();
+    }
+    return success();
+  }
 
 private:
   /// Return the context for this config.
@@ -1104,18 +1179,31 @@ private:
   //===--------------------------------------------------------------------===//
   // IR Section
 
+  struct ValueState;
+
   /// This struct represents the current read state of a range of regions. This
   /// struct is used to enable iterative parsing of regions.
   struct RegionReadState {
-    RegionReadState(Operation *op, bool isIsolatedFromAbove)
-        : RegionReadState(op->getRegions(), isIsolatedFromAbove) {}
-    RegionReadState(MutableArrayRef<Region> regions, bool isIsolatedFromAbove)
-        : curRegion(regions.begin()), endRegion(regions.end()),
-          isIsolatedFromAbove(isIsolatedFromAbove) {}
+    RegionReadState(Operation *op, EncodingReader *reader,
+                    ValueState *valueState, bool isIsolatedFromAbove)
+        : RegionReadState(op->getRegions(), reader, valueState,
+                          isIsolatedFromAbove) {}
+    RegionReadState(MutableArrayRef<Region> regions, EncodingReader *reader,
+                    ValueState *valueState, bool isIsolatedFromAbove)
+        : curRegion(regions.begin()), endRegion(regions.end()), reader(reader),
+          valueState(valueState), isIsolatedFromAbove(isIsolatedFromAbove) {}
 
     /// The current regions being read.
     MutableArrayRef<Region>::iterator curRegion, endRegion;
 
+    /// The reader used to process the regions. Regions isolated from above are
+    /// encoded in their own section, which `owningReader` reads if present.
+    EncodingReader *reader;
+    std::unique_ptr<EncodingReader> owningReader;
+
+    /// The state used to resolve the values referenced within the regions.
+    ValueState *valueState;
+
     /// The number of values defined immediately within this region.
     unsigned numValues = 0;
 
@@ -1131,30 +1219,50 @@ private:
     bool isIsolatedFromAbove = false;
   };
 
+  /// An operation isolated from above, and the section encoding its regions.
+  using IsolatedRegionsInfo = std::pair<Operation *, ArrayRef<uint8_t>>;
+
   LogicalResult parseIRSection(ArrayRef<uint8_t> sectionData, Block *block);
-  LogicalResult parseRegions(EncodingReader &reader,
-                             std::vector<RegionReadState> &regionStack,
+  LogicalResult parseRegions(std::vector<RegionReadState> &regionStack,
                              RegionReadState &readState);
+
+  /// Parse the regions of the given operation isolated from above, encoded in
+  /// `sectionData`, using the provided value state.
+  LogicalResult parseIsolatedRegions(Operation *op,
+                                     ArrayRef<uint8_t> sectionData,
+                                     ValueState &valueState);
+
+  /// Parse the regions of the given operations in parallel. The isolated
+  /// operations found within those regions are parsed in parallel afterwards,
+  /// until everything has been parsed.
+  LogicalResult
+  parseIsolatedRegionsInParallel(std::vector<IsolatedRegionsInfo> worklist);
+
+  /// Resolve all of the operation names, attributes, and types, which are
+  /// otherwise resolved lazily, so that the IR can be parsed in parallel.
+  LogicalResult resolveAllEntries(EncodingReader &reader);
   FailureOr<Operation *> parseOpWithoutRegions(EncodingReader &reader,
                                                RegionReadState &readState,
                                                bool &isIsolatedFromAbove);
 
   LogicalResult parseRegion(EncodingReader &reader, RegionReadState &readState);
   LogicalResult parseBlock(EncodingReader &reader, RegionReadState &readState);
-  LogicalResult parseBlockArguments(EncodingReader &reader, Block *block);
+  LogicalResult parseBlockArguments(EncodingReader &reader, Block *block,
+                                    ValueState &valueState);
 
   //===--------------------------------------------------------------------===//
   // Value Processing
 
   /// Parse an operand reference using the given reader. Returns nullptr in the
   /// case of failure.
-  Value parseOperand(EncodingReader &reader);
+  Value parseOperand(EncodingReader &reader, ValueState &valueState);
 
   /// Sequentially define the given value range.
-  LogicalResult defineValues(EncodingReader &reader, ValueRange values);
+  LogicalResult defineValues(EncodingReader &reader, ValueState &valueState,
+                             ValueRange values);
 
   /// Create a value to use for a forward reference.
-  Value createForwardRef();
+  Value createForwardRef(ValueState &valueState);
 
   //===--------------------------------------------------------------------===//
   // Fields
@@ -1184,12 +1292,61 @@ private:
     SmallVector<unsigned, 4> nextValueIDs;
   };
 
+  /// This struct contains the state used to resolve values while parsing a
+  /// tree of regions. Trees of regions that are parsed in parallel each use
+  /// their own state.
+  struct ValueState {
+    /// The current set of available IR value scopes.
+    std::vector<ValueScope> valueScopes;
+    /// A block containing the set of operations defined to create forward
+    /// references.
+    Block forwardRefOps;
+    /// A block containing previously created, and no longer used, forward
+    /// reference operations.
+    Block openForwardRefOps;
+
+    /// If true, the regions of the operations isolated from above that are
+    /// found are not parsed, but added to `isolatedOps` to be parsed in
+    /// parallel later.
+    bool deferIsolatedOps = false;
+    std::vector<IsolatedRegionsInfo> isolatedOps;
+  };
+
   /// The configuration of the parser.
   const ParserConfig &config;
 
   /// A location to use when emitting errors.
   Location fileLoc;
 
+  /// Flag that indicates if lazy loading is enabled.
+  bool lazyLoading;
+
+  /// The operations that are lazily loadable, in the order they were found,
+  /// along with the section containing their regions. The map allows for
+  /// quick lookup of an operation in the list.
+  using LazyLoadableOpsInfo =
+      std::list<std::pair<Operation *, ArrayRef<uint8_t>>>;
+  LazyLoadableOpsInfo lazyLoadableOps;
+  using LazyLoadableOpsMap =
+      DenseMap<Operation *, LazyLoadableOpsInfo::iterator>;
+  LazyLoadableOpsMap lazyLoadableOpsMap;
+
+  /// The callback invoked on each op found while parsing that can be lazily
+  /// loaded, which returns true if the op should be left for later.
+  llvm::function_ref<bool(Operation *)> lazyOpsCallback;
+
+  /// Materialize the lazy operation at the given position of the map.
+  LogicalResult
+  materialize(LazyLoadableOpsMap::iterator it,
+              llvm::function_ref<bool(Operation *)> lazyOpsCallback);
+
+  /// The buffer containing the bytecode, which must outlive this reader.
+  llvm::MemoryBufferRef buffer;
+
+  /// The optional owner of the buffer. If set, it is shared with the blob
+  /// resources that alias the buffer.
+  std::shared_ptr<llvm::SourceMgr> bufferOwnerRef;
+
   /// The reader used to process attribute and types within the bytecode.
   AttrTypeReader attrTypeReader;
 
@@ -1209,21 +1366,17 @@ private:
   /// The table of strings referenced within the bytecode file.
   StringSectionReader stringReader;
 
-  /// The current set of available IR value scopes.
-  std::vector<ValueScope> valueScopes;
-  /// A block containing the set of operations defined to create forward
-  /// references.
-  Block forwardRefOps;
-  /// A block containing previously created, and no longer used, forward
-  /// reference operations.
-  Block openForwardRefOps;
   /// An operation state used when instantiating forward references.
   OperationState forwardRefOpState;
 };
-} // namespace
 
-LogicalResult BytecodeReader::read(llvm::MemoryBufferRef buffer, Block *block) {
+LogicalResult
+BytecodeReader::Impl::read(Block *block,
+                           llvm::function_ref<bool(Operation *)> lazyOps) {
   EncodingReader reader(buffer.getBuffer(), fileLoc);
+  this->lazyOpsCallback = lazyOps;
+  auto resetLazyOpsCallback =
+      llvm::make_scope_exit([&] { this->lazyOpsCallback = nullptr; });
 
   // Skip over the bytecode header, this should have already been checked.
   if (failed(reader.skipBytes(StringRef("ML\xefR").size())))
@@ -1253,7 +1406,7 @@ LogicalResult BytecodeReader::read(llvm::MemoryBufferRef buffer, Block *block) {
     // Check for duplicate sections, we only expect one instance of each.
     if (sectionDatas[sectionID]) {
       return reader.emitError("duplicate top-level section: ",
-                              toString(sectionID));
+                            ::toString(sectionID));
     }
     sectionDatas[sectionID] = sectionData;
   }
@@ -1262,7 +1415,7 @@ LogicalResult BytecodeReader::read(llvm::MemoryBufferRef buffer, Block *block) {
     bytecode::Section::ID sectionID = static_cast<bytecode::Section::ID>(i);
     if (!sectionDatas[i] && !isSectionOptional(sectionID)) {
       return reader.emitError("missing data for top-level section: ",
-                              toString(sectionID));
+                            ::toString(sectionID));
     }
   }
 
@@ -1291,13 +1444,14 @@ LogicalResult BytecodeReader::read(llvm::MemoryBufferRef buffer, Block *block) {
   return parseIRSection(*sectionDatas[bytecode::Section::kIR], block);
 }
 
-LogicalResult BytecodeReader::parseVersion(EncodingReader &reader) {
+LogicalResult BytecodeReader::Impl::parseVersion(EncodingReader &reader) {
   if (failed(reader.parseVarInt(version)))
     return failure();
 
   // Validate the bytecode version.
   uint64_t currentVersion = bytecode::kVersion;
-  if (version < currentVersion) {
+  uint64_t minSupportedVersion = bytecode::kMinSupportedVersion;
+  if (version < minSupportedVersion) {
     return reader.emitError("bytecode version ", version,
                             " is older than the current version of ",
                             currentVersion, ", and upgrade is not supported");
@@ -1314,7 +1468,7 @@ LogicalResult BytecodeReader::parseVersion(EncodingReader &reader) {
 // Dialect Section
 
 LogicalResult
-BytecodeReader::parseDialectSection(ArrayRef<uint8_t> sectionData) {
+BytecodeReader::Impl::parseDialectSection(ArrayRef<uint8_t> sectionData) {
   EncodingReader sectionReader(sectionData, fileLoc);
 
   // Parse the number of dialects in the section.
@@ -1342,7 +1496,8 @@ BytecodeReader::parseDialectSection(ArrayRef<uint8_t> sectionData) {
   return success();
 }
 
-FailureOr<OperationName> BytecodeReader::parseOpName(EncodingReader &reader) {
+FailureOr<OperationName>
+BytecodeReader::Impl::parseOpName(EncodingReader &reader) {
   BytecodeOperationName *opName = nullptr;
   if (failed(parseEntry(reader, opNames, opName, "operation name")))
     return failure();
@@ -1361,7 +1516,7 @@ FailureOr<OperationName> BytecodeReader::parseOpName(EncodingReader &reader) {
 //===----------------------------------------------------------------------===//
 // Resource Section
 
-LogicalResult BytecodeReader::parseResourceSection(
+LogicalResult BytecodeReader::Impl::parseResourceSection(
     Optional<ArrayRef<uint8_t>> resourceData,
     Optional<ArrayRef<uint8_t>> resourceOffsetData) {
   // Ensure both sections are either present or not.
@@ -1380,40 +1535,60 @@ LogicalResult BytecodeReader::parseResourceSection(
 
   // Initialize the resource reader with the resource sections.
   return resourceReader.initialize(fileLoc, config, dialects, stringReader,
-                                   *resourceData, *resourceOffsetData);
+                                   *resourceData, *resourceOffsetData,
+                                   bufferOwnerRef);
 }
 
 //===----------------------------------------------------------------------===//
 // IR Section
 
-LogicalResult BytecodeReader::parseIRSection(ArrayRef<uint8_t> sectionData,
-                                             Block *block) {
+LogicalResult
+BytecodeReader::Impl::parseIRSection(ArrayRef<uint8_t> sectionData,
+                                     Block *block) {
   EncodingReader reader(sectionData, fileLoc);
 
+  // The regions of operations isolated from above can be parsed in parallel
+  // when they are encoded in their own section, after the entries they may
+  // reference have been resolved. We don't do this when lazy loading, which
+  // records the operations found as they are parsed.
+  ValueState valueState;
+  valueState.deferIsolatedOps = !lazyLoading &&
+                                version >= bytecode::kLazyLoading &&
+                                getContext()->isMultithreadingEnabled();
+  if (valueState.deferIsolatedOps && failed(resolveAllEntries(reader)))
+    return failure();
+
   // A stack of operation regions currently being read from the bytecode.
   std::vector<RegionReadState> regionStack;
 
   // Parse the top-level block using a temporary module operation.
   OwningOpRef<ModuleOp> moduleOp = ModuleOp::create(fileLoc);
-  regionStack.emplace_back(*moduleOp, /*isIsolatedFromAbove=*/true);
+  regionStack.emplace_back(*moduleOp, &reader, &valueState,
+                           /*isIsolatedFromAbove=*/true);
   regionStack.back().curBlocks.push_back(moduleOp->getBody());
   regionStack.back().curBlock = regionStack.back().curRegion->begin();
   if (failed(parseBlock(reader, regionStack.back())))
     return failure();
-  valueScopes.emplace_back();
-  valueScopes.back().push(regionStack.back());
+  valueState.valueScopes.emplace_back();
+  valueState.valueScopes.back().push(regionStack.back());
 
   // Iteratively parse regions until everything has been resolved.
   while (!regionStack.empty())
-    if (failed(parseRegions(reader, regionStack, regionStack.back())))
+    if (failed(parseRegions(regionStack, regionStack.back())))
       return failure();
-  if (!forwardRefOps.empty()) {
+  if (!valueState.forwardRefOps.empty()) {
     return reader.emitError(
         "not all forward unresolved forward operand references");
   }
+  if (failed(parseIsolatedRegionsInParallel(
+          std::move(valueState.isolatedOps))))
+    return failure();
 
-  // Verify that the parsed operations are valid.
-  if (config.shouldVerifyAfterParse() && failed(verify(*moduleOp)))
+  // Verify that the parsed operations are valid. The regions of lazily loaded
+  // operations are still empty at this point, so we leave verification to the
+  // materialization of those operations.
+  if (config.shouldVerifyAfterParse() && lazyLoadableOps.empty() &&
+      failed(verify(*moduleOp)))
     return failure();
 
   // Splice the parsed operations over to the provided top-level block.
@@ -1423,10 +1598,99 @@ LogicalResult BytecodeReader::parseIRSection(ArrayRef<uint8_t> sectionData,
   return success();
 }
 
+LogicalResult BytecodeReader::Impl::materialize(
+    LazyLoadableOpsMap::iterator it,
+    llvm::function_ref<bool(Operation *)> lazyOpsCallback) {
+  this->lazyOpsCallback = lazyOpsCallback;
+  auto resetLazyOpsCallback =
+      llvm::make_scope_exit([&] { this->lazyOpsCallback = nullptr; });
+
+  Operation *op = it->second->first;
+  ArrayRef<uint8_t> sectionData = it->second->second;
+  lazyLoadableOps.erase(it->second);
+  lazyLoadableOpsMap.erase(it);
+  size_t numLazyOps = lazyLoadableOps.size();
+
+  ValueState valueState;
+  if (failed(parseIsolatedRegions(op, sectionData, valueState)))
+    return failure();
+
+  // Verify the operation, unless some of the operations nested within it were
+  // left to be materialized later.
+  if (config.shouldVerifyAfterParse() &&
+      lazyLoadableOps.size() == numLazyOps && failed(verify(op)))
+    return failure();
+  return success();
+}
+
 LogicalResult
-BytecodeReader::parseRegions(EncodingReader &reader,
-                             std::vector<RegionReadState> &regionStack,
-                             RegionReadState &readState) {
+BytecodeReader::Impl::parseIsolatedRegions(Operation *op,
+                                           ArrayRef<uint8_t> sectionData,
+                                           ValueState &valueState) {
+  EncodingReader reader(sectionData, fileLoc);
+
+  // The regions of the operation are parsed in a fresh value scope, as the
+  // operation is isolated from above.
+  std::vector<RegionReadState> regionStack;
+  regionStack.emplace_back(op, &reader, &valueState,
+                           /*isIsolatedFromAbove=*/true);
+  valueState.valueScopes.emplace_back();
+  while (!regionStack.empty())
+    if (failed(parseRegions(regionStack, regionStack.back())))
+      return failure();
+  if (!valueState.forwardRefOps.empty()) {
+    return reader.emitError(
+        "not all forward unresolved forward operand references");
+  }
+  if (!reader.empty())
+    return reader.emitError("unexpected trailing data in region section");
+  return success();
+}
+
+LogicalResult BytecodeReader::Impl::parseIsolatedRegionsInParallel(
+    std::vector<IsolatedRegionsInfo> worklist) {
+  while (!worklist.empty()) {
+    // Each task collects the isolated operations nested within the regions it
+    // parses, which form the next worklist.
+    std::vector<std::vector<IsolatedRegionsInfo>> nestedOps(worklist.size());
+    LogicalResult result = failableParallelForEachN(
+        getContext(), 0, worklist.size(), [&](size_t i) {
+          ValueState valueState;
+          valueState.deferIsolatedOps = true;
+          if (failed(parseIsolatedRegions(worklist[i].first,
+                                          worklist[i].second, valueState)))
+            return failure();
+          nestedOps[i] = std::move(valueState.isolatedOps);
+          return success();
+        });
+    if (failed(result))
+      return failure();
+
+    worklist.clear();
+    for (std::vector<IsolatedRegionsInfo> &ops : nestedOps)
+      llvm::append_range(worklist, ops);
+  }
+  return success();
+}
+
+LogicalResult BytecodeReader::Impl::resolveAllEntries(EncodingReader &reader) {
+  for (BytecodeOperationName &opName : opNames) {
+    if (opName.opName)
+      continue;
+    if (failed(opName.dialect->load(reader, getContext())))
+      return failure();
+    opName.opName.emplace((opName.dialect->name + "." + opName.name).str(),
+                          getContext());
+  }
+  return attrTypeReader.resolveAll();
+}
+
+LogicalResult
+BytecodeReader::Impl::parseRegions(std::vector<RegionReadState> &regionStack,
+                                   RegionReadState &readState) {
+  EncodingReader &reader = *readState.reader;
+  ValueState &valueState = *readState.valueState;
+
   // Read the regions of this operation.
   for (; readState.curRegion != readState.endRegion; ++readState.curRegion) {
     // If the current block hasn't been setup yet, parse the header for this
@@ -1453,11 +1717,38 @@ BytecodeReader::parseRegions(EncodingReader &reader,
 
         // If the op has regions, add it to the stack for processing.
         if ((*op)->getNumRegions()) {
-          regionStack.emplace_back(*op, isIsolatedFromAbove);
+          RegionReadState childState(*op, &reader, &valueState,
+                                     isIsolatedFromAbove);
+
+          // Isolated regions are encoded in their own section, which we either
+          // read now, or record for lazy loading or parsing in parallel.
+          if (isIsolatedFromAbove && version >= bytecode::kLazyLoading) {
+            bytecode::Section::ID sectionID;
+            ArrayRef<uint8_t> sectionData;
+            if (failed(reader.parseSection(sectionID, sectionData)))
+              return failure();
+            if (sectionID != bytecode::Section::kIR)
+              return reader.emitError("expected IR section for region");
+
+            if (lazyLoading && lazyOpsCallback && lazyOpsCallback(*op)) {
+              lazyLoadableOps.emplace_back(*op, sectionData);
+              lazyLoadableOpsMap.try_emplace(*op,
+                                             std::prev(lazyLoadableOps.end()));
+              continue;
+            }
+            if (valueState.deferIsolatedOps) {
+              valueState.isolatedOps.emplace_back(*op, sectionData);
+              continue;
+            }
+            childState.owningReader =
+                std::make_unique<EncodingReader>(sectionData, fileLoc);
+            childState.reader = childState.owningReader.get();
+          }
+          regionStack.push_back(std::move(childState));
 
           // If the op is isolated from above, push a new value scope.
           if (isIsolatedFromAbove)
-            valueScopes.emplace_back();
+            valueState.valueScopes.emplace_back();
           return success();
         }
       }
@@ -1471,21 +1762,21 @@ BytecodeReader::parseRegions(EncodingReader &reader,
 
     // Reset the current block and any values reserved for this region.
     readState.curBlock = {};
-    valueScopes.back().pop(readState);
+    valueState.valueScopes.back().pop(readState);
   }
 
   // When the regions have been fully parsed, pop them off of the read stack. If
   // the regions were isolated from above, we also pop the last value scope.
   if (readState.isIsolatedFromAbove)
-    valueScopes.pop_back();
+    valueState.valueScopes.pop_back();
   regionStack.pop_back();
   return success();
 }
 
 FailureOr<Operation *>
-BytecodeReader::parseOpWithoutRegions(EncodingReader &reader,
-                                      RegionReadState &readState,
-                                      bool &isIsolatedFromAbove) {
+BytecodeReader::Impl::parseOpWithoutRegions(EncodingReader &reader,
+                                            RegionReadState &readState,
+                                            bool &isIsolatedFromAbove) {
   // Parse the name of the operation.
   FailureOr<OperationName> opName = parseOpName(reader);
   if (failed(opName))
@@ -1532,7 +1823,7 @@ BytecodeReader::parseOpWithoutRegions(EncodingReader &reader,
       return failure();
     opState.operands.resize(numOperands);
     for (int i = 0, e = numOperands; i < e; ++i)
-      if (!(opState.operands[i] = parseOperand(reader)))
+      if (!(opState.operands[i] = parseOperand(reader, *readState.valueState)))
         return failure();
   }
 
@@ -1565,14 +1856,15 @@ BytecodeReader::parseOpWithoutRegions(EncodingReader &reader,
   readState.curBlock->push_back(op);
 
   // If the operation had results, update the value references.
-  if (op->getNumResults() && failed(defineValues(reader, op->getResults())))
+  if (op->getNumResults() &&
+      failed(defineValues(reader, *readState.valueState, op->getResults())))
     return failure();
 
   return op;
 }
 
-LogicalResult BytecodeReader::parseRegion(EncodingReader &reader,
-                                          RegionReadState &readState) {
+LogicalResult BytecodeReader::Impl::parseRegion(EncodingReader &reader,
+                                                RegionReadState &readState) {
   // Parse the number of blocks in the region.
   uint64_t numBlocks;
   if (failed(reader.parseVarInt(numBlocks)))
@@ -1598,29 +1890,32 @@ LogicalResult BytecodeReader::parseRegion(EncodingReader &reader,
   }
 
   // Prepare the current value scope for this region.
-  valueScopes.back().push(readState);
+  readState.valueState->valueScopes.back().push(readState);
 
   // Parse the entry block of the region.
   readState.curBlock = readState.curRegion->begin();
   return parseBlock(reader, readState);
 }
 
-LogicalResult BytecodeReader::parseBlock(EncodingReader &reader,
-                                         RegionReadState &readState) {
+LogicalResult BytecodeReader::Impl::parseBlock(EncodingReader &reader,
+                                               RegionReadState &readState) {
   bool hasArgs;
   if (failed(reader.parseVarIntWithFlag(readState.numOpsRemaining, hasArgs)))
     return failure();
 
   // Parse the arguments of the block.
-  if (hasArgs && failed(parseBlockArguments(reader, &*readState.curBlock)))
+  if (hasArgs && failed(parseBlockArguments(reader, &*readState.curBlock,
+                                            *readState.valueState)))
     return failure();
 
   // We don't parse the operations of the block here, that's done elsewhere.
   return success();
 }
 
-LogicalResult BytecodeReader::parseBlockArguments(EncodingReader &reader,
-                                                  Block *block) {
+LogicalResult
+BytecodeReader::Impl::parseBlockArguments(EncodingReader &reader,
+                                          Block *block,
+                                          ValueState &valueState) {
   // Parse the value ID for the first argument, and the number of arguments.
   uint64_t numArgs;
   if (failed(reader.parseVarInt(numArgs)))
@@ -1642,27 +1937,29 @@ LogicalResult BytecodeReader::parseBlockArguments(EncodingReader &reader,
     argLocs.push_back(argLoc);
   }
   block->addArguments(argTypes, argLocs);
-  return defineValues(reader, block->getArguments());
+  return defineValues(reader, valueState, block->getArguments());
 }
 
 //===----------------------------------------------------------------------===//
 // Value Processing
 
-Value BytecodeReader::parseOperand(EncodingReader &reader) {
-  std::vector<Value> &values = valueScopes.back().values;
+Value BytecodeReader::Impl::parseOperand(EncodingReader &reader,
+                                         ValueState &valueState) {
+  std::vector<Value> &values = valueState.valueScopes.back().values;
   Value *value = nullptr;
   if (failed(parseEntry(reader, values, value, "value")))
     return Value();
 
   // Create a new forward reference if necessary.
   if (!*value)
-    *value = createForwardRef();
+    *value = createForwardRef(valueState);
   return *value;
 }
 
-LogicalResult BytecodeReader::defineValues(EncodingReader &reader,
-                                           ValueRange newValues) {
-  ValueScope &valueScope = valueScopes.back();
+LogicalResult BytecodeReader::Impl::defineValues(EncodingReader &reader,
+                                                 ValueState &valueState,
+                                                 ValueRange newValues) {
+  ValueScope &valueScope = valueState.valueScopes.back();
   std::vector<Value> &values = valueScope.values;
 
   unsigned &valueID = valueScope.nextValueIDs.back();
@@ -1686,17 +1983,21 @@ LogicalResult BytecodeReader::defineValues(EncodingReader &reader,
       // Assert that this is a forward reference operation. Given how we compute
       // definition ids (incrementally as we parse), it shouldn't be possible
       // for the value to be defined any other way.
-      assert(forwardRefOp && forwardRefOp->getBlock() == &forwardRefOps &&
+      assert(forwardRefOp &&
+             forwardRefOp->getBlock() == &valueState.forwardRefOps &&
              "value index was already defined?");
 
       oldValue.replaceAllUsesWith(newValue);
-      forwardRefOp->moveBefore(&openForwardRefOps, openForwardRefOps.end());
+      forwardRefOp->moveBefore(&valueState.openForwardRefOps,
+                               valueState.openForwardRefOps.end());
     }
   }
   return success();
 }
 
-Value BytecodeReader::createForwardRef() {
+Value BytecodeReader::Impl::createForwardRef(ValueState &valueState) {
+  Block &forwardRefOps = valueState.forwardRefOps;
+  Block &openForwardRefOps = valueState.openForwardRefOps;
   // Check for an avaliable existing operation to use. Otherwise, create a new
   // fake operation to use for the reference.
   if (!openForwardRefOps.empty()) {
@@ -1716,8 +2017,10 @@ bool mlir::isBytecode(llvm::MemoryBufferRef buffer) {
   return buffer.getBuffer().startswith("ML\xefR");
 }
 
-LogicalResult mlir::readBytecodeFile(llvm::MemoryBufferRef buffer, Block *block,
-                                     const ParserConfig &config) {
+static LogicalResult
+readBytecodeFileImpl(llvm::MemoryBufferRef buffer, Block *block,
+                     const ParserConfig &config,
+                     const std::shared_ptr<llvm::SourceMgr> &bufferOwnerRef) {
   Location sourceFileLoc =
       FileLineColLoc::get(config.getContext(), buffer.getBufferIdentifier(),
                           /*line=*/0, /*column=*/0);
@@ -1726,6 +2029,59 @@ LogicalResult mlir::readBytecodeFile(llvm::MemoryBufferRef buffer, Block *block,
                      "input buffer is not an MLIR bytecode file");
   }
 
-  BytecodeReader reader(sourceFileLoc, config);
-  return reader.read(buffer, block);
+  BytecodeReader::Impl reader(sourceFileLoc, config, /*lazyLoading=*/false,
+                              buffer, bufferOwnerRef);
+  return reader.read(block, /*lazyOps=*/nullptr);
+}
+
+LogicalResult mlir::readBytecodeFile(llvm::MemoryBufferRef buffer, Block *block,
+                                     const ParserConfig &config) {
+  return readBytecodeFileImpl(buffer, block, config, /*bufferOwnerRef=*/{});
+}
+LogicalResult
+mlir::readBytecodeFile(const std::shared_ptr<llvm::SourceMgr> &sourceMgr,
+                       Block *block, const ParserConfig &config) {
+  return readBytecodeFileImpl(
+      *sourceMgr->getMemoryBuffer(sourceMgr->getMainFileID()), block, config,
+      sourceMgr);
+}
+
+BytecodeReader::BytecodeReader(
+    llvm::MemoryBufferRef buffer, const ParserConfig &config, bool lazyLoading,
+    const std::shared_ptr<llvm::SourceMgr> &bufferOwnerRef) {
+  Location sourceFileLoc =
+      FileLineColLoc::get(config.getContext(), buffer.getBufferIdentifier(),
+                          /*line=*/0, /*column=*/0);
+  impl = std::make_unique<Impl>(sourceFileLoc, config, lazyLoading, buffer,
+                                bufferOwnerRef);
+}
+
+BytecodeReader::~BytecodeReader() = default;
+
+LogicalResult
+BytecodeReader::readTopLevel(Block *block,
+                             llvm::function_ref<bool(Operation *)> lazyOps) {
+  if (!isBytecode(impl->getBuffer())) {
+    return emitError(impl->getLocation(),
+                     "input buffer is not an MLIR bytecode file");
+  }
+  return impl->read(block, lazyOps);
+}
+
+int64_t BytecodeReader::getNumOpsToMaterialize() const {
+  return impl->getNumOpsToMaterialize();
+}
+
+bool BytecodeReader::isMaterializable(Operation *op) {
+  return impl->isMaterializable(op);
+}
+
+LogicalResult BytecodeReader::materialize(
+    Operation *op, llvm::function_ref<bool(Operation *)> lazyOpsCallback) {
+  return impl->materialize(op, lazyOpsCallback);
+}
+
+LogicalResult
+BytecodeReader::finalize(function_ref<bool(Operation *)> shouldMaterialize) {
+  return impl->finalize(shouldMaterialize);
 }
@@ -12,6 +12,7 @@
 #include "mlir/Bytecode/BytecodeImplementation.h"
 #include "mlir/IR/BuiltinDialect.h"
 #include "mlir/IR/OpImplementation.h"
+#include "mlir/IR/Threading.h"
 #include "llvm/ADT/CachedHashString.h"
 #include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/SmallString.h"
@@ -374,6 +375,10 @@ private:
   void writeRegion(EncodingEmitter &emitter, Region *region);
   void writeIRSection(EncodingEmitter &emitter, Operation *op);
 
+  /// Encode the regions of the outermost operations isolated from above nested
+  /// within `rootOp` in parallel, into `isolatedRegionSections`.
+  void writeIsolatedRegionsInParallel(Operation *rootOp);
+
   //===--------------------------------------------------------------------===//
   // Resources
 
@@ -393,6 +398,11 @@ private:
 
   /// The IR numbering state generated for the root operation.
   IRNumberingState numberingState;
+
+  /// The sections encoding the regions of operations isolated from above that
+  /// were written in parallel ahead of the rest of the IR.
+  DenseMap<Operation *, std::unique_ptr<EncodingEmitter>>
+      isolatedRegionSections;
 };
 } // namespace
 
@@ -699,6 +709,20 @@ void BytecodeWriter::writeOp(EncodingEmitter &emitter, Operation *op) {
     bool isIsolatedFromAbove = op->hasTrait<OpTrait::IsIsolatedFromAbove>();
     emitter.emitVarIntWithFlag(numRegions, isIsolatedFromAbove);
 
+    // Regions isolated from above are emitted into a nested IR section, which
+    // allows for the reader to skip over them and load them lazily.
+    if (isIsolatedFromAbove) {
+      auto it = isolatedRegionSections.find(op);
+      if (it != isolatedRegionSections.end()) {
+        emitter.emitSection(bytecode::Section::kIR, std::move(*it->second));
+        return;
+      }
+      EncodingEmitter regionEmitter;
+      for (Region &region : op->getRegions())
+        writeRegion(regionEmitter, &region);
+      emitter.emitSection(bytecode::Section::kIR, std::move(regionEmitter));
+      return;
+    }
     for (Region &region : op->getRegions())
       writeRegion(emitter, &region);
   }
@@ -722,6 +746,9 @@ void BytecodeWriter::writeRegion(EncodingEmitter &emitter, Region *region) {
 }
 
 void BytecodeWriter::writeIRSection(EncodingEmitter &emitter, Operation *op) {
+  if (op->getContext()->isMultithreadingEnabled())
+    writeIsolatedRegionsInParallel(op);
+
   EncodingEmitter irEmitter;
 
   // Write the IR section the same way as a block with no arguments. Note that
@@ -735,6 +762,39 @@ void BytecodeWriter::writeIRSection(EncodingEmitter &emitter, Operation *op) {
   emitter.emitSection(bytecode::Section::kIR, std::move(irEmitter));
 }
 
+void BytecodeWriter::writeIsolatedRegionsInParallel(Operation *rootOp) {
+  // Collect the outermost operations isolated from above, the operations
+  // nested within them are written along with them.
+  SmallVector<Operation *> isolatedOps;
+  SmallVector<Region *> worklist;
+  for (Region &region : rootOp->getRegions())
+    worklist.push_back(&region);
+  while (!worklist.empty()) {
+    for (Operation &op : worklist.pop_back_val()->getOps()) {
+      if (!op.getNumRegions())
+        continue;
+      if (op.hasTrait<OpTrait::IsIsolatedFromAbove>()) {
+        isolatedOps.push_back(&op);
+        continue;
+      }
+      for (Region &region : op.getRegions())
+        worklist.push_back(&region);
+    }
+  }
+  if (isolatedOps.size() < 2)
+    return;
+
+  // The numbering state is only read while writing the operations, so the
+  // sections can be encoded independently.
+  for (Operation *op : isolatedOps)
+    isolatedRegionSections[op] = std::make_unique<EncodingEmitter>();
+  parallelForEach(rootOp->getContext(), isolatedOps, [&](Operation *op) {
+    EncodingEmitter &regionEmitter = *isolatedRegionSections.find(op)->second;
+    for (Region &region : op->getRegions())
+      writeRegion(regionEmitter, &region);
+  });
+}
+
 //===----------------------------------------------------------------------===//
 // Resources
 
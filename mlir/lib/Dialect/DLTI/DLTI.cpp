@@ -309,6 +309,8 @@ constexpr const StringLiteral mlir::DLTIDialect::kDataLayoutAttrName;
 constexpr const StringLiteral mlir::DLTIDialect::kDataLayoutEndiannessKey;
 constexpr const StringLiteral mlir::DLTIDialect::kDataLayoutEndiannessBig;
 constexpr const StringLiteral mlir::DLTIDialect::kDataLayoutEndiannessLittle;
+constexpr const StringLiteral mlir::DLTIDialect::kDataLayoutCacheSizesKey;
+constexpr const StringLiteral mlir::DLTIDialect::kDataLayoutVectorSizeKey;
 
 namespace {
 class TargetDataLayoutInterface : public DataLayoutDialectInterface {
@@ -329,6 +331,23 @@ public:
                             << DLTIDialect::kDataLayoutEndiannessBig << "' or '"
                             << DLTIDialect::kDataLayoutEndiannessLittle << "'";
     }
+    if (entryName == DLTIDialect::kDataLayoutCacheSizesKey) {
+      auto value = entry.getValue().dyn_cast<DenseI64ArrayAttr>();
+      if (value && llvm::all_of(value.asArrayRef(),
+                                [](int64_t size) { return size > 0; }))
+        return success();
+      return emitError(loc) << "'" << entryName
+                            << "' data layout entry is expected to be an "
+                               "array of positive integers";
+    }
+    if (entryName == DLTIDialect::kDataLayoutVectorSizeKey) {
+      auto value = entry.getValue().dyn_cast<IntegerAttr>();
+      if (value && value.getInt() > 0)
+        return success();
+      return emitError(loc) << "'" << entryName
+                            << "' data layout entry is expected to be a "
+                               "positive integer";
+    }
     return emitError(loc) << "unknown data layout entry name: " << entryName;
   }
 };
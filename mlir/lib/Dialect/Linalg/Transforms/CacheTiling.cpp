@@ -0,0 +1,228 @@
+//===- CacheTiling.cpp - Tile size selection with a cache model -----------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements an analytic model that picks the tile sizes and the
+// vector sizes of Linalg ops from the sizes of the caches and of the vector
+// registers of the target CPU.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Dialect/DLTI/DLTI.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/Linalg/Transforms/Transforms.h"
+#include "mlir/IR/AffineExpr.h"
+#include "mlir/Interfaces/DataLayoutInterfaces.h"
+
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/Support/MathExtras.h"
+
+using namespace mlir;
+using namespace mlir::linalg;
+
+LinalgCacheModel LinalgCacheModel::get(Operation *op) {
+  LinalgCacheModel model;
+  bool foundCacheSizes = false, foundVectorSize = false;
+  for (Operation *parent = op; parent && !(foundCacheSizes && foundVectorSize);
+       parent = parent->getParentOp()) {
+    auto layoutOp = dyn_cast<DataLayoutOpInterface>(parent);
+    if (!layoutOp)
+      continue;
+    DataLayoutSpecInterface spec = layoutOp.getDataLayoutSpec();
+    if (!spec)
+      continue;
+    for (DataLayoutEntryInterface entry : spec.getEntries()) {
+      auto key = entry.getKey().dyn_cast<StringAttr>();
+      if (!key)
+        continue;
+      if (!foundCacheSizes &&
+          key.getValue() == DLTIDialect::kDataLayoutCacheSizesKey) {
+        if (auto sizes = entry.getValue().dyn_cast<DenseI64ArrayAttr>()) {
+          model.cacheSizes.assign(sizes.asArrayRef().begin(),
+                                  sizes.asArrayRef().end());
+          foundCacheSizes = true;
+        }
+      } else if (!foundVectorSize &&
+                 key.getValue() == DLTIDialect::kDataLayoutVectorSizeKey) {
+        if (auto size = entry.getValue().dyn_cast<IntegerAttr>()) {
+          model.vectorSize = size.getInt();
+          foundVectorSize = true;
+        }
+      }
+    }
+  }
+  return model;
+}
+
+/// Returns the number of distinct values `expr` takes when every loop `d`
+/// spans `tileSizes[d]` consecutive iterations, or None if `expr` is not a
+/// linear combination of the loops with constant coefficients.
+static Optional<int64_t> getExtent(AffineExpr expr,
+                                   ArrayRef<int64_t> tileSizes) {
+  if (auto dim = expr.dyn_cast<AffineDimExpr>())
+    return tileSizes[dim.getPosition()];
+  if (expr.isa<AffineConstantExpr>())
+    return 1;
+  auto binary = expr.dyn_cast<AffineBinaryOpExpr>();
+  if (!binary)
+    return llvm::None;
+  Optional<int64_t> lhs = getExtent(binary.getLHS(), tileSizes);
+  if (!lhs)
+    return llvm::None;
+  if (expr.getKind() == AffineExprKind::Add) {
+    Optional<int64_t> rhs = getExtent(binary.getRHS(), tileSizes);
+    if (!rhs)
+      return llvm::None;
+    return *lhs + *rhs - 1;
+  }
+  // Multiplications by a constant are canonicalized to have the constant on
+  // the right hand side.
+  auto factor = binary.getRHS().dyn_cast<AffineConstantExpr>();
+  if (expr.getKind() != AffineExprKind::Mul || !factor)
+    return llvm::None;
+  return (*lhs - 1) * std::abs(factor.getValue()) + 1;
+}
+
+namespace {
+/// The data an op accesses in a tile of its iteration space.
+struct TileFootprint {
+  struct Operand {
+    AffineMap indexingMap;
+    int64_t elementSize;
+  };
+  SmallVector<Operand> operands;
+
+  /// Returns the number of bytes of all operand tiles.
+  int64_t getNumBytes(ArrayRef<int64_t> tileSizes) const {
+    int64_t numBytes = 0;
+    for (const Operand &operand : operands) {
+      int64_t numElements = 1;
+      for (AffineExpr expr : operand.indexingMap.getResults())
+        numElements *= *getExtent(expr, tileSizes);
+      numBytes += numElements * operand.elementSize;
+    }
+    return numBytes;
+  }
+};
+} // namespace
+
+/// Returns the number of iterations in a tile.
+static int64_t getNumIterations(ArrayRef<int64_t> tileSizes) {
+  int64_t numIterations = 1;
+  for (int64_t size : tileSizes)
+    numIterations *= size;
+  return numIterations;
+}
+
+/// Computes the innermost tile of `op`, see `LinalgCacheTileSizes`.
+static SmallVector<int64_t> computeVectorSizes(LinalgOp op,
+                                               ArrayRef<int64_t> loopRanges,
+                                               const TileFootprint &footprint,
+                                               const LinalgCacheModel &model) {
+  SmallVector<int64_t> vectorSizes(loopRanges.size(), 1);
+  SmallVector<utils::IteratorType> iteratorTypes = op.getIteratorTypesArray();
+  AffineMap outputMap = op.getMatchingIndexingMap(op.getDpsInitOperand(0));
+  if (outputMap.getNumResults() == 0)
+    return vectorSizes;
+
+  // Only the innermost dimension of the output is contiguous in memory, so it
+  // is the one to vectorize.
+  auto vectorDim = outputMap.getResults().back().dyn_cast<AffineDimExpr>();
+  if (!vectorDim || !isParallelIterator(iteratorTypes[vectorDim.getPosition()]))
+    return vectorSizes;
+  unsigned vectorLoop = vectorDim.getPosition();
+  int64_t elementSize = footprint.operands[op.getNumDpsInputs()].elementSize;
+  int64_t numLanes = std::max<int64_t>(model.vectorSize / elementSize, 1);
+  vectorSizes[vectorLoop] =
+      llvm::PowerOf2Floor(std::min(numLanes, loopRanges[vectorLoop]));
+
+  // Unroll the other parallel loops of the output round robin, as long as the
+  // accumulators fit in the vector registers.
+  SmallVector<unsigned> unrolledLoops;
+  for (AffineExpr expr : llvm::reverse(outputMap.getResults().drop_back())) {
+    auto dim = expr.dyn_cast<AffineDimExpr>();
+    if (dim && isParallelIterator(iteratorTypes[dim.getPosition()]))
+      unrolledLoops.push_back(dim.getPosition());
+  }
+  int64_t maxNumAccumulators = model.numVectorRegisters * numLanes;
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (unsigned loop : unrolledLoops) {
+      if (2 * vectorSizes[loop] > loopRanges[loop] ||
+          2 * getNumIterations(vectorSizes) > maxNumAccumulators)
+        continue;
+      vectorSizes[loop] *= 2;
+      changed = true;
+    }
+  }
+  return vectorSizes;
+}
+
+FailureOr<LinalgCacheTileSizes>
+mlir::linalg::computeCacheTileSizes(LinalgOp op,
+                                    const LinalgCacheModel &model) {
+  SmallVector<int64_t, 4> loopRanges = op.getStaticLoopRanges();
+  if (llvm::any_of(loopRanges, ShapedType::isDynamic))
+    return failure();
+
+  TileFootprint footprint;
+  DataLayout layout = DataLayout::closest(op);
+  SmallVector<int64_t> unitSizes(loopRanges.size(), 1);
+  for (OpOperand &operand : op->getOpOperands()) {
+    AffineMap map = op.getMatchingIndexingMap(&operand);
+    if (llvm::any_of(map.getResults(), [&](AffineExpr expr) {
+          return !getExtent(expr, unitSizes);
+        }))
+      return failure();
+    Type elementType = getElementTypeOrSelf(operand.get().getType());
+    footprint.operands.push_back(
+        {map, std::max<int64_t>(layout.getTypeSize(elementType), 1)});
+  }
+
+  LinalgCacheTileSizes result;
+  result.vectorSizes = computeVectorSizes(op, loopRanges, footprint, model);
+
+  // Grow the tile of each level from the tile of the level below, doubling
+  // the loop that gives the most iterations per byte of data.
+  SmallVector<int64_t> tileSizes = result.vectorSizes;
+  for (int64_t cacheSize : model.cacheSizes) {
+    auto capacity = static_cast<int64_t>(cacheSize * model.cacheUtilization);
+    while (true) {
+      SmallVector<int64_t> best;
+      double bestIntensity = 0.0;
+      for (unsigned loop = 0, e = loopRanges.size(); loop < e; ++loop) {
+        if (tileSizes[loop] == loopRanges[loop])
+          continue;
+        SmallVector<int64_t> candidate = tileSizes;
+        candidate[loop] = std::min(2 * tileSizes[loop], loopRanges[loop]);
+        int64_t numBytes = footprint.getNumBytes(candidate);
+        if (numBytes > capacity)
+          continue;
+        double intensity =
+            static_cast<double>(getNumIterations(candidate)) / numBytes;
+        // Prefer inner loops on ties, their data is contiguous.
+        if (intensity >= bestIntensity) {
+          best = std::move(candidate);
+          bestIntensity = intensity;
+        }
+      }
+      if (best.empty())
+        break;
+      tileSizes = std::move(best);
+    }
+
+    // Loops tiled by their full range are not tiled.
+    SmallVector<int64_t> levelTileSizes = tileSizes;
+    for (auto it : llvm::zip(levelTileSizes, loopRanges))
+      if (std::get<0>(it) == std::get<1>(it))
+        std::get<0>(it) = 0;
+    result.tileSizes.push_back(std::move(levelTileSizes));
+  }
+  std::reverse(result.tileSizes.begin(), result.tileSizes.end());
+  return result;
+}
@@ -17,7 +17,9 @@
 
 #include <atomic>
 #include <cassert>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <iostream>
 #include <mutex>
@@ -25,7 +27,7 @@
 #include <vector>
 
 #include "llvm/ADT/StringMap.h"
-#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
 
 using namespace mlir::runtime;
 
@@ -40,6 +42,187 @@ namespace {
 // Forward declare class defined below.
 class RefCounted;
 
+// -------------------------------------------------------------------------- //
+// A work stealing scheduler for the async tasks.
+//
+// Every worker thread owns a queue of tasks. Tasks scheduled from a worker
+// thread are pushed to the queue of that worker, and the worker runs its own
+// tasks in LIFO order, so that the continuations of `async-parallel-for` run
+// while their data is still in cache. Idle workers steal the oldest tasks from
+// the other queues. Tasks scheduled from outside of the scheduler are
+// distributed across the queues round robin.
+// -------------------------------------------------------------------------- //
+
+class WorkStealingScheduler {
+public:
+  using Task = std::function<void()>;
+
+  explicit WorkStealingScheduler(unsigned numThreads)
+      : numPendingTasks(0), numExecutedTasks(0), numStolenTasks(0),
+        idleTimeNs(0), nextQueue(0), shutdown(false) {
+    for (unsigned i = 0; i < numThreads; ++i)
+      queues.push_back(std::make_unique<Queue>());
+    for (unsigned i = 0; i < numThreads; ++i)
+      threads.emplace_back([this, i] { workerLoop(i); });
+  }
+
+  ~WorkStealingScheduler() {
+    wait();
+    {
+      std::unique_lock<std::mutex> lock(mu);
+      shutdown = true;
+    }
+    workAvailable.notify_all();
+    for (std::thread &thread : threads)
+      thread.join();
+  }
+
+  // Schedules the task for execution in one of the worker threads.
+  void schedule(Task task) {
+    numPendingTasks.fetch_add(1);
+    unsigned index = getCurrentWorkerIndex();
+    if (index == kNotAWorker)
+      index = nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+    {
+      std::unique_lock<std::mutex> lock(queues[index]->mu);
+      queues[index]->tasks.push_back(std::move(task));
+    }
+    // Take the lock to make sure that the notification is not lost between
+    // the check for work of an idle worker and its wait.
+    { std::unique_lock<std::mutex> lock(mu); }
+    workAvailable.notify_one();
+  }
+
+  // If called from a worker thread, runs one of the pending tasks and returns
+  // true. Returns false if there was nothing to run.
+  bool tryRunPendingTask() {
+    unsigned index = getCurrentWorkerIndex();
+    return index != kNotAWorker && tryRunTask(index);
+  }
+
+  // Blocks the caller thread until all scheduled tasks are completed.
+  void wait() {
+    std::unique_lock<std::mutex> lock(mu);
+    allTasksCompleted.wait(lock, [this] { return numPendingTasks == 0; });
+  }
+
+  unsigned getThreadCount() const { return threads.size(); }
+
+  int64_t getNumExecutedTasks() const { return numExecutedTasks.load(); }
+  int64_t getNumStolenTasks() const { return numStolenTasks.load(); }
+  int64_t getIdleTimeNs() const { return idleTimeNs.load(); }
+
+private:
+  static constexpr unsigned kNotAWorker = ~0u;
+
+  struct Queue {
+    std::mutex mu;
+    std::deque<Task> tasks;
+  };
+
+  // Returns the index of the worker running on the current thread, or
+  // `kNotAWorker` if the current thread does not belong to this scheduler.
+  unsigned getCurrentWorkerIndex() const {
+    return currentScheduler == this ? currentWorkerIndex : kNotAWorker;
+  }
+
+  // Pops the newest task of the given worker, or steals the oldest task of
+  // any other worker.
+  bool tryPopTask(unsigned index, Task &task) {
+    {
+      Queue &queue = *queues[index];
+      std::unique_lock<std::mutex> lock(queue.mu);
+      if (!queue.tasks.empty()) {
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+      }
+    }
+    for (unsigned i = 1, e = queues.size(); i < e; ++i) {
+      Queue &victim = *queues[(index + i) % e];
+      std::unique_lock<std::mutex> lock(victim.mu);
+      if (!victim.tasks.empty()) {
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        numStolenTasks.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool tryRunTask(unsigned index) {
+    Task task;
+    if (!tryPopTask(index, task))
+      return false;
+    task();
+    numExecutedTasks.fetch_add(1, std::memory_order_relaxed);
+    if (numPendingTasks.fetch_sub(1) == 1) {
+      { std::unique_lock<std::mutex> lock(mu); }
+      allTasksCompleted.notify_all();
+    }
+    return true;
+  }
+
+  bool hasPendingTasks() {
+    for (auto &queue : queues) {
+      std::unique_lock<std::mutex> lock(queue->mu);
+      if (!queue->tasks.empty())
+        return true;
+    }
+    return false;
+  }
+
+  void workerLoop(unsigned index) {
+    currentScheduler = this;
+    currentWorkerIndex = index;
+    while (true) {
+      if (tryRunTask(index))
+        continue;
+
+      std::unique_lock<std::mutex> lock(mu);
+      if (shutdown)
+        return;
+      if (hasPendingTasks())
+        continue;
+      auto idleStart = std::chrono::steady_clock::now();
+      workAvailable.wait(lock);
+      idleTimeNs.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               std::chrono::steady_clock::now() - idleStart)
+                               .count(),
+                           std::memory_order_relaxed);
+    }
+  }
+
+  static thread_local const WorkStealingScheduler *currentScheduler;
+  static thread_local unsigned currentWorkerIndex;
+
+  std::vector<std::unique_ptr<Queue>> queues;
+  std::vector<std::thread> threads;
+
+  // The number of scheduled tasks that are not completed yet.
+  std::atomic<int64_t> numPendingTasks;
+
+  // Scheduler statistics.
+  std::atomic<int64_t> numExecutedTasks;
+  std::atomic<int64_t> numStolenTasks;
+  std::atomic<int64_t> idleTimeNs;
+
+  // The queue that receives the next task scheduled from outside of the
+  // scheduler.
+  std::atomic<unsigned> nextQueue;
+
+  // Guards the sleeping and the wake up of the workers and of the `wait`ers.
+  std::mutex mu;
+  std::condition_variable workAvailable;
+  std::condition_variable allTasksCompleted;
+  bool shutdown;
+};
+
+thread_local const WorkStealingScheduler
+    *WorkStealingScheduler::currentScheduler = nullptr;
+thread_local unsigned WorkStealingScheduler::currentWorkerIndex = 0;
+
 // -------------------------------------------------------------------------- //
 // AsyncRuntime orchestrates all async operations and Async runtime API is built
 // on top of the default runtime instance.
@@ -47,10 +230,12 @@ class RefCounted;
 
 class AsyncRuntime {
 public:
-  AsyncRuntime() : numRefCountedObjects(0) {}
+  AsyncRuntime()
+      : numRefCountedObjects(0),
+        scheduler(llvm::hardware_concurrency().compute_thread_count()) {}
 
   ~AsyncRuntime() {
-    threadPool.wait(); // wait for the completion of all async tasks
+    scheduler.wait(); // wait for the completion of all async tasks
     assert(getNumRefCountedObjects() == 0 &&
            "all ref counted objects must be destroyed");
   }
@@ -59,7 +244,7 @@ public:
     return numRefCountedObjects.load(std::memory_order_relaxed);
   }
 
-  llvm::ThreadPool &getThreadPool() { return threadPool; }
+  WorkStealingScheduler &getScheduler() { return scheduler; }
 
 private:
   friend class RefCounted;
@@ -74,7 +259,7 @@ private:
   }
 
   std::atomic<int64_t> numRefCountedObjects;
-  llvm::ThreadPool threadPool;
+  WorkStealingScheduler scheduler;
 };
 
 // -------------------------------------------------------------------------- //
@@ -368,24 +553,42 @@ extern "C" bool mlirAsyncRuntimeIsGroupError(AsyncGroup *group) {
   return group->numErrors.load() > 0;
 }
 
+// Blocks the caller until `isReady` returns true. If the caller is a worker
+// thread of the runtime, it runs other pending tasks while it waits instead of
+// leaving the worker idle, and meanwhile checks `isReady` between the tasks.
+template <typename IsReady>
+static void awaitCooperatively(std::mutex &mu, std::condition_variable &cv,
+                               IsReady isReady) {
+  WorkStealingScheduler &scheduler = getDefaultAsyncRuntime()->getScheduler();
+  std::unique_lock<std::mutex> lock(mu);
+  while (!isReady()) {
+    lock.unlock();
+    bool ranTask = scheduler.tryRunPendingTask();
+    lock.lock();
+    // There was nothing to run (or we are not a worker thread), block until
+    // the awaited object becomes ready.
+    if (!ranTask) {
+      cv.wait(lock, isReady);
+      return;
+    }
+  }
+}
+
 extern "C" void mlirAsyncRuntimeAwaitToken(AsyncToken *token) {
-  std::unique_lock<std::mutex> lock(token->mu);
-  if (!State(token->state).isAvailableOrError())
-    token->cv.wait(
-        lock, [token] { return State(token->state).isAvailableOrError(); });
+  awaitCooperatively(token->mu, token->cv, [token] {
+    return State(token->state).isAvailableOrError();
+  });
 }
 
 extern "C" void mlirAsyncRuntimeAwaitValue(AsyncValue *value) {
-  std::unique_lock<std::mutex> lock(value->mu);
-  if (!State(value->state).isAvailableOrError())
-    value->cv.wait(
-        lock, [value] { return State(value->state).isAvailableOrError(); });
+  awaitCooperatively(value->mu, value->cv, [value] {
+    return State(value->state).isAvailableOrError();
+  });
 }
 
 extern "C" void mlirAsyncRuntimeAwaitAllInGroup(AsyncGroup *group) {
-  std::unique_lock<std::mutex> lock(group->mu);
-  if (group->pendingTokens != 0)
-    group->cv.wait(lock, [group] { return group->pendingTokens == 0; });
+  awaitCooperatively(group->mu, group->cv,
+                     [group] { return group->pendingTokens == 0; });
 }
 
 // Returns a pointer to the storage owned by the async value.
@@ -396,7 +599,7 @@ extern "C" ValueStorage mlirAsyncRuntimeGetValueStorage(AsyncValue *value) {
 
 extern "C" void mlirAsyncRuntimeExecute(CoroHandle handle, CoroResume resume) {
   auto *runtime = getDefaultAsyncRuntime();
-  runtime->getThreadPool().async([handle, resume]() { (*resume)(handle); });
+  runtime->getScheduler().schedule([handle, resume]() { (*resume)(handle); });
 }
 
 extern "C" void mlirAsyncRuntimeAwaitTokenAndExecute(AsyncToken *token,
@@ -439,7 +642,19 @@ extern "C" void mlirAsyncRuntimeAwaitAllInGroupAndExecute(AsyncGroup *group,
 }
 
 extern "C" int64_t mlirAsyncRuntimGetNumWorkerThreads() {
-  return getDefaultAsyncRuntime()->getThreadPool().getThreadCount();
+  return getDefaultAsyncRuntime()->getScheduler().getThreadCount();
+}
+
+extern "C" int64_t mlirAsyncRuntimeGetNumExecutedTasks() {
+  return getDefaultAsyncRuntime()->getScheduler().getNumExecutedTasks();
+}
+
+extern "C" int64_t mlirAsyncRuntimeGetNumStolenTasks() {
+  return getDefaultAsyncRuntime()->getScheduler().getNumStolenTasks();
+}
+
+extern "C" int64_t mlirAsyncRuntimeGetIdleTimeNs() {
+  return getDefaultAsyncRuntime()->getScheduler().getIdleTimeNs();
 }
 
 //===----------------------------------------------------------------------===//
@@ -451,6 +666,13 @@ extern "C" void mlirAsyncRuntimePrintCurrentThreadId() {
   std::cout << "Current thread id: " << thisId << std::endl;
 }
 
+extern "C" void mlirAsyncRuntimePrintStatistics() {
+  WorkStealingScheduler &scheduler = getDefaultAsyncRuntime()->getScheduler();
+  std::cout << "Executed tasks: " << scheduler.getNumExecutedTasks() << "\n"
+            << "Stolen tasks: " << scheduler.getNumStolenTasks() << "\n"
+            << "Idle time (ns): " << scheduler.getIdleTimeNs() << std::endl;
+}
+
 //===----------------------------------------------------------------------===//
 // MLIR Runner (JitRunner) dynamic library integration.
 //===----------------------------------------------------------------------===//
@@ -521,8 +743,16 @@ void __mlir_runner_init(llvm::StringMap<void *> &exportSymbols) {
                &mlir::runtime::mlirAsyncRuntimeAwaitAllInGroupAndExecute);
   exportSymbol("mlirAsyncRuntimGetNumWorkerThreads",
                &mlir::runtime::mlirAsyncRuntimGetNumWorkerThreads);
+  exportSymbol("mlirAsyncRuntimeGetNumExecutedTasks",
+               &mlir::runtime::mlirAsyncRuntimeGetNumExecutedTasks);
+  exportSymbol("mlirAsyncRuntimeGetNumStolenTasks",
+               &mlir::runtime::mlirAsyncRuntimeGetNumStolenTasks);
+  exportSymbol("mlirAsyncRuntimeGetIdleTimeNs",
+               &mlir::runtime::mlirAsyncRuntimeGetIdleTimeNs);
   exportSymbol("mlirAsyncRuntimePrintCurrentThreadId",
                &mlir::runtime::mlirAsyncRuntimePrintCurrentThreadId);
+  exportSymbol("mlirAsyncRuntimePrintStatistics",
+               &mlir::runtime::mlirAsyncRuntimePrintStatistics);
 }
 
 // NOLINTNEXTLINE(*-identifier-naming): externally called.
@@ -26,6 +26,7 @@
 #include "mlir/IR/OpImplementation.h"
 #include "mlir/IR/Operation.h"
 #include "mlir/IR/SubElementInterfaces.h"
+#include "mlir/IR/Threading.h"
 #include "mlir/IR/Verifier.h"
 #include "llvm/ADT/APFloat.h"
 #include "llvm/ADT/DenseMap.h"
@@ -45,6 +46,7 @@
 #include "llvm/Support/SaveAndRestore.h"
 #include "llvm/Support/Threading.h"
 
+#include <mutex>
 #include <tuple>
 
 using namespace mlir;
@@ -326,7 +328,9 @@ namespace mlir {
 class AsmPrinter::Impl {
 public:
   Impl(raw_ostream &os, AsmStateImpl &state);
-  explicit Impl(Impl &other) : Impl(other.os, other.state) {}
+  explicit Impl(Impl &other) : Impl(other.os, other.state) {
+    referencedResources = other.referencedResources;
+  }
 
   /// Returns the output stream of the printer.
   raw_ostream &getStream() { return os; }
@@ -438,6 +442,12 @@ protected:
 
   /// A tracker for the number of new lines emitted during printing.
   NewLineCounter newLine;
+
+  /// If set, dialect resources referenced while printing are appended here
+  /// instead of being registered with the state directly. This is used when
+  /// printing operations in parallel, so that the resources are registered in
+  /// a deterministic order.
+  SmallVectorImpl<AsmDialectResourceHandle> *referencedResources = nullptr;
 };
 } // namespace mlir
 
@@ -1092,6 +1102,10 @@ private:
   llvm::ScopedHashTable<StringRef, char> usedNames;
   llvm::BumpPtrAllocator usedNameAllocator;
 
+  /// Guards `usedNameAllocator` once numbering is done, as regions may be
+  /// shadowed while sibling operations are printed in parallel.
+  std::mutex shadowMutex;
+
   /// This is the next value ID to assign in numbering.
   unsigned nextValueID = 0;
   /// This is the next ID to assign to a region entry block argument.
@@ -1242,7 +1256,9 @@ void SSANameState::shadowRegionArgs(Region &region, ValueRange namesToUse) {
     // Use the name without the leading %.
     auto name = StringRef(nameStream.str()).drop_front();
 
-    // Overwrite the name.
+    // Overwrite the name. The entry already exists, so this does not
+    // invalidate concurrent lookups of other values.
+    std::lock_guard<std::mutex> lock(shadowMutex);
     valueNames[nameToReplace] = name.copy(usedNameAllocator);
   }
 }
@@ -1560,6 +1576,10 @@ public:
   /// Get the printer flags.
   const OpPrintingFlags &getPrinterFlags() const { return printerFlags; }
 
+  /// Returns true if operation locations within the printed buffer are being
+  /// recorded.
+  bool hasLocationMap() const { return locationMap; }
+
   /// Register the location, line and column, within the buffer that the given
   /// operation was printed at.
   void registerOperationLocation(Operation *op, unsigned line, unsigned col) {
@@ -1814,7 +1834,10 @@ void AsmPrinter::Impl::printResourceHandle(
     const AsmDialectResourceHandle &resource) {
   auto *interface = cast<OpAsmDialectInterface>(resource.getDialect());
   os << interface->getResourceKey(resource);
-  state.getDialectResources()[resource.getDialect()].insert(resource);
+  if (referencedResources)
+    referencedResources->push_back(resource);
+  else
+    state.getDialectResources()[resource.getDialect()].insert(resource);
 }
 
 /// Returns true if the given dialect symbol data is simple enough to print in
@@ -2418,6 +2441,7 @@ void AsmPrinter::Impl::printDialectAttribute(Attribute attr) {
   {
     llvm::raw_string_ostream attrNameStr(attrName);
     Impl subPrinter(attrNameStr, state);
+    subPrinter.referencedResources = referencedResources;
     DialectAsmPrinter printer(subPrinter);
     dialect.printAttribute(attr, printer);
   }
@@ -2432,6 +2456,7 @@ void AsmPrinter::Impl::printDialectType(Type type) {
   {
     llvm::raw_string_ostream typeNameStr(typeName);
     Impl subPrinter(typeNameStr, state);
+    subPrinter.referencedResources = referencedResources;
     DialectAsmPrinter printer(subPrinter);
     dialect.printType(type, printer);
   }
@@ -2752,6 +2777,14 @@ public:
   void print(Block *block, bool printBlockArgs = true,
              bool printBlockTerminator = true);
 
+  /// Returns true if the given operations of a block should be printed in
+  /// parallel.
+  bool shouldPrintInParallel(iterator_range<Block::iterator> ops) const;
+
+  /// Print the given operations of a block, each on its own line, by printing
+  /// them to separate buffers in parallel and emitting the buffers in order.
+  void printInParallel(iterator_range<Block::iterator> ops);
+
   /// Print the ID of the given value, optionally with its result number.
   void printValueID(Value value, bool printResultNo = true,
                     raw_ostream *streamOverride = nullptr) const;
@@ -3261,13 +3294,70 @@ void OperationPrinter::print(Block *block, bool printBlockArgs,
       block->begin(),
       std::prev(block->end(),
                 (!hasTerminator || printBlockTerminator) ? 0 : 1));
-  for (auto &op : range) {
-    printFullOpWithIndentAndLoc(&op);
-    os << newLine;
+  if (shouldPrintInParallel(range)) {
+    printInParallel(range);
+  } else {
+    for (auto &op : range) {
+      printFullOpWithIndentAndLoc(&op);
+      os << newLine;
+    }
   }
   currentIndent -= indentWidth;
 }
 
+bool OperationPrinter::shouldPrintInParallel(
+    iterator_range<Block::iterator> ops) const {
+  // The line numbers of the operations are only known once the buffers are
+  // joined, so the location map can't be populated from the workers.
+  if (state.hasLocationMap() || ops.empty() ||
+      !ops.begin()->getContext()->isMultithreadingEnabled())
+    return false;
+
+  // Only bother when there are several isolated bodies (e.g. functions) to
+  // print, which is where the bulk of the output comes from. Printing reads
+  // the SSA names and aliases computed up front, so the operations can be
+  // printed independently.
+  unsigned numIsolatedBodies = 0;
+  for (Operation &op : ops) {
+    if (op.getNumRegions() && op.hasTrait<OpTrait::IsIsolatedFromAbove>() &&
+        ++numIsolatedBodies == 2)
+      return true;
+  }
+  return false;
+}
+
+void OperationPrinter::printInParallel(iterator_range<Block::iterator> ops) {
+  struct PrintedOp {
+    Operation *op;
+    std::string text;
+    SmallVector<AsmDialectResourceHandle> resources;
+  };
+  std::vector<PrintedOp> printedOps;
+  for (Operation &op : ops)
+    printedOps.push_back({&op, {}, {}});
+
+  auto printFn = [&](PrintedOp &printed) {
+    llvm::raw_string_ostream printedOS(printed.text);
+    OperationPrinter printer(printedOS, state);
+    printer.printerFlags = printerFlags;
+    printer.referencedResources = &printed.resources;
+    printer.defaultDialectStack = defaultDialectStack;
+    printer.currentIndent = currentIndent;
+    printer.printFullOpWithIndentAndLoc(printed.op);
+  };
+  parallelForEach(ops.begin()->getContext(), printedOps, printFn);
+
+  for (PrintedOp &printed : printedOps) {
+    os << printed.text << newLine;
+    for (const AsmDialectResourceHandle &resource : printed.resources) {
+      if (referencedResources)
+        referencedResources->push_back(resource);
+      else
+        state.getDialectResources()[resource.getDialect()].insert(resource);
+    }
+  }
+}
+
 void OperationPrinter::printValueID(Value value, bool printResultNo,
                                     raw_ostream *streamOverride) const {
   state.getSSANameState().printValueID(value, printResultNo,
@@ -964,6 +964,67 @@ SymbolTable &SymbolTableCollection::getSymbolTable(Operation *op) {
   return *it.first->second;
 }
 
+void SymbolTableCollection::invalidateSymbolTable(Operation *op) {
+  symbolTables.erase(op);
+}
+
+//===----------------------------------------------------------------------===//
+// LockedSymbolTableCollection
+//===----------------------------------------------------------------------===//
+
+Operation *LockedSymbolTableCollection::lookupSymbolIn(Operation *symbolTableOp,
+                                                       StringAttr symbol) {
+  return getSymbolTable(symbolTableOp).lookup(symbol);
+}
+Operation *LockedSymbolTableCollection::lookupSymbolIn(Operation *symbolTableOp,
+                                                       SymbolRefAttr name) {
+  SmallVector<Operation *, 4> symbols;
+  if (failed(lookupSymbolIn(symbolTableOp, name, symbols)))
+    return nullptr;
+  return symbols.back();
+}
+LogicalResult LockedSymbolTableCollection::lookupSymbolIn(
+    Operation *symbolTableOp, SymbolRefAttr name,
+    SmallVectorImpl<Operation *> &symbols) {
+  auto lookupFn = [this](Operation *symbolTableOp, StringAttr symbol) {
+    return lookupSymbolIn(symbolTableOp, symbol);
+  };
+  return lookupSymbolInImpl(symbolTableOp, name, symbols, lookupFn);
+}
+Operation *
+LockedSymbolTableCollection::lookupNearestSymbolFrom(Operation *from,
+                                                     StringAttr symbol) {
+  Operation *symbolTableOp = SymbolTable::getNearestSymbolTable(from);
+  return symbolTableOp ? lookupSymbolIn(symbolTableOp, symbol) : nullptr;
+}
+Operation *
+LockedSymbolTableCollection::lookupNearestSymbolFrom(Operation *from,
+                                                     SymbolRefAttr symbol) {
+  Operation *symbolTableOp = SymbolTable::getNearestSymbolTable(from);
+  return symbolTableOp ? lookupSymbolIn(symbolTableOp, symbol) : nullptr;
+}
+
+SymbolTable &LockedSymbolTableCollection::getSymbolTable(Operation *op) {
+  // Once constructed, a table is only destroyed by `invalidateSymbolTable`, so
+  // it can be handed out under a shared lock. Tables cached in the collection
+  // before this view was created are only known to the view once they have
+  // been looked up under the exclusive lock.
+  {
+    llvm::sys::SmartScopedReader<true> lock(mutex);
+    if (constructedTables.contains(op))
+      return collection.getSymbolTable(op);
+  }
+  llvm::sys::SmartScopedWriter<true> lock(mutex);
+  constructedTables.insert(op);
+  return collection.getSymbolTable(op);
+}
+
+void LockedSymbolTableCollection::invalidateSymbolTable(Operation *op) {
+  llvm::sys::SmartScopedWriter<true> lock(mutex);
+  constructedTables.erase(op);
+  collection.invalidateSymbolTable(op);
+}
+
 //===----------------------------------------------------------------------===//
 // SymbolUserMap
 //===----------------------------------------------------------------------===//
@@ -31,6 +31,22 @@ LogicalResult mlir::parseSourceFile(const llvm::SourceMgr &sourceMgr,
   return parseAsmSourceFile(sourceMgr, block, config);
 }
 
+LogicalResult
+mlir::parseSourceFile(const std::shared_ptr<llvm::SourceMgr> &sourceMgr,
+                      Block *block, const ParserConfig &config,
+                      LocationAttr *sourceFileLoc) {
+  const auto *sourceBuf =
+      sourceMgr->getMemoryBuffer(sourceMgr->getMainFileID());
+  if (sourceFileLoc) {
+    *sourceFileLoc = FileLineColLoc::get(config.getContext(),
+                                         sourceBuf->getBufferIdentifier(),
+                                         /*line=*/0, /*column=*/0);
+  }
+  if (isBytecode(*sourceBuf))
+    return readBytecodeFile(sourceMgr, block, config);
+  return parseAsmSourceFile(*sourceMgr, block, config);
+}
+
 LogicalResult mlir::parseSourceFile(llvm::StringRef filename, Block *block,
                                     const ParserConfig &config,
                                     LocationAttr *sourceFileLoc) {
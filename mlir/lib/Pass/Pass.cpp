@@ -667,8 +667,9 @@ void OpToOpPassAdaptor::runOnOperationImpl(bool verifyPasses) {
 
         // Run the held pipeline over the current operation.
         unsigned initGeneration = mgr->impl->initializationGeneration;
-        if (failed(runPipeline(*mgr, &op, am.nest(&op), verifyPasses,
-                               initGeneration, instrumentor, &parentInfo)))
+        if (failed(runCachedPipeline(*mgr, &op, am.nest(&op), verifyPasses,
+                                     initGeneration, instrumentor,
+                                     &parentInfo)))
           return signalPassFailure();
       }
     }
@@ -746,7 +747,7 @@ void OpToOpPassAdaptor::runOnOperationAsyncImpl(bool verifyPasses) {
 
     // Get the pass manager for this operation and execute it.
     OpPassManager &pm = asyncExecutors[pmIndex][opInfo.passManagerIdx];
-    LogicalResult pipelineResult = runPipeline(
+    LogicalResult pipelineResult = runCachedPipeline(
         pm, opInfo.op, opInfo.am, verifyPasses,
         pm.impl->initializationGeneration, instrumentor, &parentInfo);
 
@@ -794,6 +795,11 @@ LogicalResult PassManager::run(Operation *op) {
   if (failed(getImpl().finalizePassList(context)))
     return failure();
 
+  // Let the nested pipelines, now merged into adaptors, use the cache.
+  for (Pass &pass : getPasses())
+    if (auto *adaptor = dyn_cast<OpToOpPassAdaptor>(&pass))
+      adaptor->setPipelineCache(pipelineCache);
+
   // Initialize all of the passes within the pass manager with a new generation.
   llvm::hash_code newInitKey = context->getRegistryHash();
   if (newInitKey != initializationKey) {
@@ -55,6 +55,9 @@ public:
   /// Returns the adaptor pass name.
   std::string getAdaptorName();
 
+  /// Set the cache used to reuse the results of the held pipelines.
+  void setPipelineCache(PassPipelineCache *cache) { pipelineCache = cache; }
+
 private:
   /// Run this pass adaptor synchronously.
   void runOnOperationImpl(bool verifyPasses);
@@ -78,9 +81,19 @@ private:
       unsigned parentInitGeneration, PassInstrumentor *instrumentor = nullptr,
       const PassInstrumentation::PipelineParentInfo *parentInfo = nullptr);
 
+  /// Run the given pass manager on `op` like `runPipeline`, unless the result
+  /// of running it on an identical operation is in the pipeline cache.
+  LogicalResult runCachedPipeline(
+      OpPassManager &pm, Operation *op, AnalysisManager am, bool verifyPasses,
+      unsigned parentInitGeneration, PassInstrumentor *instrumentor,
+      const PassInstrumentation::PipelineParentInfo *parentInfo);
+
   /// A set of adaptors to run.
   SmallVector<OpPassManager, 1> mgrs;
 
+  /// An optional cache of the results of the held pipelines.
+  PassPipelineCache *pipelineCache = nullptr;
+
   /// A set of executors, cloned from the main executor, that run asynchronously
   /// on different threads. This is used when threading is enabled.
   SmallVector<SmallVector<OpPassManager, 1>, 8> asyncExecutors;
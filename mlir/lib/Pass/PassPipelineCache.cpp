@@ -0,0 +1,158 @@
+//===- PassPipelineCache.cpp - Cache of nested pipeline results -----------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "PassDetail.h"
+#include "mlir/Bytecode/BytecodeReader.h"
+#include "mlir/Bytecode/BytecodeWriter.h"
+#include "mlir/IR/AsmState.h"
+#include "mlir/IR/Block.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_sha1_ostream.h"
+
+#include <atomic>
+#include <mutex>
+
+using namespace mlir;
+using namespace mlir::detail;
+
+//===----------------------------------------------------------------------===//
+// PassPipelineCache
+//===----------------------------------------------------------------------===//
+
+struct PassPipelineCache::Impl {
+  Impl(StringRef directory) : directory(directory), numHits(0), numMisses(0) {}
+
+  /// Returns the path of the file caching the result for `key`.
+  std::string getPath(StringRef key) const {
+    SmallString<128> path(directory);
+    llvm::sys::path::append(path, key + ".mlirbc");
+    return std::string(path);
+  }
+
+  /// The directory the results are written to, if any.
+  std::string directory;
+
+  /// The results in memory, guarded by `mutex`.
+  llvm::StringMap<std::string> entries;
+  std::mutex mutex;
+
+  std::atomic<unsigned> numHits, numMisses;
+};
+
+PassPipelineCache::PassPipelineCache(StringRef directory)
+    : impl(std::make_unique<Impl>(directory)) {}
+
+PassPipelineCache::~PassPipelineCache() = default;
+
+Optional<std::string> PassPipelineCache::lookup(StringRef key) {
+  {
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    auto it = impl->entries.find(key);
+    if (it != impl->entries.end()) {
+      ++impl->numHits;
+      return it->second;
+    }
+  }
+
+  if (!impl->directory.empty()) {
+    auto buffer = llvm::MemoryBuffer::getFile(impl->getPath(key));
+    if (buffer && isBytecode((*buffer)->getMemBufferRef())) {
+      std::string bytecode = (*buffer)->getBuffer().str();
+      std::lock_guard<std::mutex> lock(impl->mutex);
+      impl->entries.try_emplace(key, bytecode);
+      ++impl->numHits;
+      return bytecode;
+    }
+  }
+
+  ++impl->numMisses;
+  return llvm::None;
+}
+
+void PassPipelineCache::insert(StringRef key, std::string bytecode) {
+  // Write the file first, it is written to a temporary file and moved in
+  // place, so that other processes never read a partial result.
+  if (!impl->directory.empty()) {
+    llvm::consumeError(
+        llvm::writeToOutput(impl->getPath(key), [&](raw_ostream &os) {
+          os << bytecode;
+          return llvm::Error::success();
+        }));
+  }
+
+  std::lock_guard<std::mutex> lock(impl->mutex);
+  impl->entries.insert_or_assign(key, std::move(bytecode));
+}
+
+unsigned PassPipelineCache::getNumHits() const { return impl->numHits; }
+
+unsigned PassPipelineCache::getNumMisses() const { return impl->numMisses; }
+
+//===----------------------------------------------------------------------===//
+// OpToOpPassAdaptor
+//===----------------------------------------------------------------------===//
+
+/// Returns the key of the result of running `pm` on `op` in the cache.
+static std::string getPipelineCacheKey(OpPassManager &pm, Operation *op) {
+  llvm::raw_sha1_ostream os;
+  pm.printAsTextualPipeline(os);
+  os << '\0';
+  op->print(os, OpPrintingFlags()
+                    .enableDebugInfo(/*enable=*/true, /*prettyForm=*/false)
+                    .printGenericOpForm()
+                    .useLocalScope());
+  return llvm::toHex(os.sha1(), /*LowerCase=*/true);
+}
+
+/// Replaces the attributes, regions and location of `op` with those of the op
+/// in `bytecode`.
+static LogicalResult restoreCachedResult(Operation *op, StringRef bytecode) {
+  Block block;
+  ParserConfig config(op->getContext(), /*verifyAfterParse=*/false);
+  if (failed(readBytecodeFile(llvm::MemoryBufferRef(bytecode, "pipeline-cache"),
+                              &block, config)))
+    return failure();
+
+  Operation *result = llvm::hasSingleElement(block) ? &block.front() : nullptr;
+  if (!result || result->getName() != op->getName() ||
+      result->getNumRegions() != op->getNumRegions())
+    return op->emitOpError("found a mismatching result in the pipeline cache");
+
+  for (auto it : llvm::zip(op->getRegions(), result->getRegions()))
+    std::get<0>(it).takeBody(std::get<1>(it));
+  op->setAttrs(result->getAttrDictionary());
+  op->setLoc(result->getLoc());
+  return success();
+}
+
+LogicalResult OpToOpPassAdaptor::runCachedPipeline(
+    OpPassManager &pm, Operation *op, AnalysisManager am, bool verifyPasses,
+    unsigned parentInitGeneration, PassInstrumentor *instrumentor,
+    const PassInstrumentation::PipelineParentInfo *parentInfo) {
+  if (!pipelineCache)
+    return runPipeline(pm, op, am, verifyPasses, parentInitGeneration,
+                       instrumentor, parentInfo);
+
+  std::string key = getPipelineCacheKey(pm, op);
+  if (Optional<std::string> bytecode = pipelineCache->lookup(key))
+    return restoreCachedResult(op, *bytecode);
+
+  if (failed(runPipeline(pm, op, am, verifyPasses, parentInitGeneration,
+                         instrumentor, parentInfo)))
+    return failure();
+
+  std::string bytecode;
+  llvm::raw_string_ostream os(bytecode);
+  writeBytecodeToFile(op, os);
+  pipelineCache->insert(key, std::move(os.str()));
+  return success();
+}
@@ -155,14 +155,21 @@ enum OpCode : ByteCodeField {
   ReplaceOp,
   /// Compare an attribute with a set of constants.
   SwitchAttribute,
+  /// Compare an attribute with a large set of constants, using a lookup table.
+  SwitchAttributeTable,
   /// Compare the operand count of an operation with a set of constants.
   SwitchOperandCount,
   /// Compare the name of an operation with a set of constants.
   SwitchOperationName,
+  /// Compare the name of an operation with a large set of constants, using a
+  /// lookup table.
+  SwitchOperationNameTable,
   /// Compare the result count of an operation with a set of constants.
   SwitchResultCount,
   /// Compare a type with a set of constants.
   SwitchType,
+  /// Compare a type with a large set of constants, using a lookup table.
+  SwitchTypeTable,
   /// Compare a range of types with a set of constants.
   SwitchTypes,
 };
@@ -172,6 +179,12 @@ enum OpCode : ByteCodeField {
 static constexpr ByteCodeField kInferTypesMarker =
     std::numeric_limits<ByteCodeField>::max();
 
+/// The minimum number of cases of a switch for its cases to be looked up in a
+/// table, instead of being compared one after the other. The root of the
+/// matcher switches over the names of the root operations of all patterns, so
+/// large pattern sets hit this for every operation that is matched.
+static constexpr size_t kMinSwitchTableSize = 16;
+
 //===----------------------------------------------------------------------===//
 // ByteCode Generation
 //===----------------------------------------------------------------------===//
@@ -194,6 +207,7 @@ public:
             SmallVectorImpl<ByteCodeField> &matcherByteCode,
             SmallVectorImpl<ByteCodeField> &rewriterByteCode,
             SmallVectorImpl<PDLByteCodePattern> &patterns,
+            std::vector<PDLByteCodeSwitchTable> &switchTables,
             ByteCodeField &maxValueMemoryIndex,
             ByteCodeField &maxOpRangeMemoryIndex,
             ByteCodeField &maxTypeRangeMemoryIndex,
@@ -204,7 +218,7 @@ public:
             const DenseMap<Operation *, PDLPatternConfigSet *> &configMap)
       : ctx(ctx), uniquedData(uniquedData), matcherByteCode(matcherByteCode),
         rewriterByteCode(rewriterByteCode), patterns(patterns),
-        maxValueMemoryIndex(maxValueMemoryIndex),
+        switchTables(switchTables), maxValueMemoryIndex(maxValueMemoryIndex),
         maxOpRangeMemoryIndex(maxOpRangeMemoryIndex),
         maxTypeRangeMemoryIndex(maxTypeRangeMemoryIndex),
         maxValueRangeMemoryIndex(maxValueRangeMemoryIndex),
@@ -247,6 +261,21 @@ public:
     return it.first->second;
   }
 
+  /// Return the index of a new lookup table mapping each of the given cases to
+  /// the index of its successor, or None if the switch is small enough for a
+  /// linear scan of its cases to be faster.
+  template <typename RangeT>
+  Optional<ByteCodeField> getSwitchTableIndex(RangeT &&cases) {
+    if (size_t(llvm::size(cases)) < kMinSwitchTableSize)
+      return llvm::None;
+
+    // The first of duplicate cases wins, as it does in a linear scan.
+    PDLByteCodeSwitchTable &table = switchTables.emplace_back();
+    for (const auto &it : llvm::enumerate(cases))
+      table.try_emplace(it.value().getAsOpaquePointer(), it.index() + 1);
+    return switchTables.size() - 1;
+  }
+
 private:
   /// Allocate memory indices for the results of operations within the matcher
   /// and rewriters.
@@ -331,6 +360,7 @@ private:
   SmallVectorImpl<ByteCodeField> &matcherByteCode;
   SmallVectorImpl<ByteCodeField> &rewriterByteCode;
   SmallVectorImpl<PDLByteCodePattern> &patterns;
+  std::vector<PDLByteCodeSwitchTable> &switchTables;
   ByteCodeField &maxValueMemoryIndex;
   ByteCodeField &maxOpRangeMemoryIndex;
   ByteCodeField &maxTypeRangeMemoryIndex;
@@ -1004,6 +1034,11 @@ void Generator::generate(pdl_interp::ReplaceOp op, ByteCodeWriter &writer) {
 }
 void Generator::generate(pdl_interp::SwitchAttributeOp op,
                          ByteCodeWriter &writer) {
+  if (Optional<ByteCodeField> table =
+          getSwitchTableIndex(op.getCaseValuesAttr())) {
+    return writer.append(OpCode::SwitchAttributeTable, op.getAttribute(),
+                         *table, op.getSuccessors());
+  }
   writer.append(OpCode::SwitchAttribute, op.getAttribute(),
                 op.getCaseValuesAttr(), op.getSuccessors());
 }
@@ -1017,6 +1052,10 @@ void Generator::generate(pdl_interp::SwitchOperationNameOp op,
   auto cases = llvm::map_range(op.getCaseValuesAttr(), [&](Attribute attr) {
     return OperationName(attr.cast<StringAttr>().getValue(), ctx);
   });
+  if (Optional<ByteCodeField> table = getSwitchTableIndex(cases)) {
+    return writer.append(OpCode::SwitchOperationNameTable, op.getInputOp(),
+                         *table, op.getSuccessors());
+  }
   writer.append(OpCode::SwitchOperationName, op.getInputOp(), cases,
                 op.getSuccessors());
 }
@@ -1026,6 +1065,11 @@ void Generator::generate(pdl_interp::SwitchResultCountOp op,
                 op.getCaseValuesAttr(), op.getSuccessors());
 }
 void Generator::generate(pdl_interp::SwitchTypeOp op, ByteCodeWriter &writer) {
+  if (Optional<ByteCodeField> table = getSwitchTableIndex(
+          op.getCaseValuesAttr().getAsValueRange<TypeAttr>())) {
+    return writer.append(OpCode::SwitchTypeTable, op.getValue(), *table,
+                         op.getSuccessors());
+  }
   writer.append(OpCode::SwitchType, op.getValue(), op.getCaseValuesAttr(),
                 op.getSuccessors());
 }
@@ -1045,7 +1089,8 @@ PDLByteCode::PDLByteCode(
     llvm::StringMap<PDLRewriteFunction> rewriteFns)
     : configs(std::move(configs)) {
   Generator generator(module.getContext(), uniquedData, matcherByteCode,
-                      rewriterByteCode, patterns, maxValueMemoryIndex,
+                      rewriterByteCode, patterns, switchTables,
+                      maxValueMemoryIndex,
                       maxOpRangeCount, maxTypeRangeCount, maxValueRangeCount,
                       maxLoopLevel, constraintFns, rewriteFns, configMap);
   generator.generate(module);
@@ -1089,7 +1134,8 @@ public:
       ArrayRef<PatternBenefit> currentPatternBenefits,
       ArrayRef<PDLByteCodePattern> patterns,
       ArrayRef<PDLConstraintFunction> constraintFunctions,
-      ArrayRef<PDLRewriteFunction> rewriteFunctions)
+      ArrayRef<PDLRewriteFunction> rewriteFunctions,
+      ArrayRef<PDLByteCodeSwitchTable> switchTables)
       : curCodeIt(curCodeIt), memory(memory), opRangeMemory(opRangeMemory),
         typeRangeMemory(typeRangeMemory),
         allocatedTypeRangeMemory(allocatedTypeRangeMemory),
@@ -1098,7 +1144,7 @@ public:
         loopIndex(loopIndex), uniquedMemory(uniquedMemory), code(code),
         currentPatternBenefits(currentPatternBenefits), patterns(patterns),
         constraintFunctions(constraintFunctions),
-        rewriteFunctions(rewriteFunctions) {}
+        rewriteFunctions(rewriteFunctions), switchTables(switchTables) {}
 
   /// Start executing the code at the current bytecode index. `matches` is an
   /// optional field provided when this function is executed in a matching
@@ -1145,10 +1191,13 @@ private:
                           SmallVectorImpl<PDLByteCode::MatchResult> &matches);
   void executeReplaceOp(PatternRewriter &rewriter);
   void executeSwitchAttribute();
+  void executeSwitchAttributeTable();
   void executeSwitchOperandCount();
   void executeSwitchOperationName();
+  void executeSwitchOperationNameTable();
   void executeSwitchResultCount();
   void executeSwitchType();
+  void executeSwitchTypeTable();
   void executeSwitchTypes();
 
   /// Pushes a code iterator to the stack.
@@ -1248,6 +1297,18 @@ private:
     selectJump(size_t(0));
   }
 
+  /// Handle a switch operation with the provided value, whose cases are held
+  /// in a lookup table.
+  template <typename T>
+  void handleSwitchTable(const T &value) {
+    const PDLByteCodeSwitchTable &table = switchTables[read()];
+    LLVM_DEBUG(llvm::dbgs() << "  * Value: " << value << "\n"
+                            << "  * Cases: " << table.size() << "\n");
+
+    auto it = table.find(value.getAsOpaquePointer());
+    selectJump(size_t(it == table.end() ? 0 : it->second));
+  }
+
   /// Store a pointer to memory.
   void storeToMemory(unsigned index, const void *value) {
     memory[index] = value;
@@ -1378,6 +1439,7 @@ private:
   ArrayRef<PDLByteCodePattern> patterns;
   ArrayRef<PDLConstraintFunction> constraintFunctions;
   ArrayRef<PDLRewriteFunction> rewriteFunctions;
+  ArrayRef<PDLByteCodeSwitchTable> switchTables;
 };
 
 /// This class is an instantiation of the PDLResultList that provides access to
@@ -2038,6 +2100,11 @@ void ByteCodeExecutor::executeSwitchAttribute() {
   handleSwitch(value, cases);
 }
 
+void ByteCodeExecutor::executeSwitchAttributeTable() {
+  LLVM_DEBUG(llvm::dbgs() << "Executing SwitchAttributeTable:\n");
+  handleSwitchTable(read<Attribute>());
+}
+
 void ByteCodeExecutor::executeSwitchOperandCount() {
   LLVM_DEBUG(llvm::dbgs() << "Executing SwitchOperandCount:\n");
   Operation *op = read<Operation *>();
@@ -2077,6 +2144,11 @@ void ByteCodeExecutor::executeSwitchOperationName() {
   selectJump(size_t(0));
 }
 
+void ByteCodeExecutor::executeSwitchOperationNameTable() {
+  LLVM_DEBUG(llvm::dbgs() << "Executing SwitchOperationNameTable:\n");
+  handleSwitchTable(read<Operation *>()->getName());
+}
+
 void ByteCodeExecutor::executeSwitchResultCount() {
   LLVM_DEBUG(llvm::dbgs() << "Executing SwitchResultCount:\n");
   Operation *op = read<Operation *>();
@@ -2093,6 +2165,11 @@ void ByteCodeExecutor::executeSwitchType() {
   handleSwitch(value, cases);
 }
 
+void ByteCodeExecutor::executeSwitchTypeTable() {
+  LLVM_DEBUG(llvm::dbgs() << "Executing SwitchTypeTable:\n");
+  handleSwitchTable(read<Type>());
+}
+
 void ByteCodeExecutor::executeSwitchTypes() {
   LLVM_DEBUG(llvm::dbgs() << "Executing SwitchTypes:\n");
   TypeRange *value = read<TypeRange *>();
@@ -2242,18 +2319,27 @@ ByteCodeExecutor::execute(PatternRewriter &rewriter,
     case SwitchAttribute:
       executeSwitchAttribute();
       break;
+    case SwitchAttributeTable:
+      executeSwitchAttributeTable();
+      break;
     case SwitchOperandCount:
       executeSwitchOperandCount();
       break;
     case SwitchOperationName:
       executeSwitchOperationName();
       break;
+    case SwitchOperationNameTable:
+      executeSwitchOperationNameTable();
+      break;
     case SwitchResultCount:
       executeSwitchResultCount();
       break;
     case SwitchType:
       executeSwitchType();
       break;
+    case SwitchTypeTable:
+      executeSwitchTypeTable();
+      break;
     case SwitchTypes:
       executeSwitchTypes();
       break;
@@ -2274,7 +2360,7 @@ void PDLByteCode::match(Operation *op, PatternRewriter &rewriter,
       state.typeRangeMemory, state.allocatedTypeRangeMemory,
       state.valueRangeMemory, state.allocatedValueRangeMemory, state.loopIndex,
       uniquedData, matcherByteCode, state.currentPatternBenefits, patterns,
-      constraintFunctions, rewriteFunctions);
+      constraintFunctions, rewriteFunctions, switchTables);
   LogicalResult executeResult = executor.execute(rewriter, &matches);
   (void)executeResult;
   assert(succeeded(executeResult) && "unexpected matcher execution failure");
@@ -2303,7 +2389,7 @@ LogicalResult PDLByteCode::rewrite(PatternRewriter &rewriter,
       state.allocatedTypeRangeMemory, state.valueRangeMemory,
       state.allocatedValueRangeMemory, state.loopIndex, uniquedData,
       rewriterByteCode, state.currentPatternBenefits, patterns,
-      constraintFunctions, rewriteFunctions);
+      constraintFunctions, rewriteFunctions, switchTables);
   LogicalResult result =
       executor.execute(rewriter, /*matches=*/nullptr, match.location);
 
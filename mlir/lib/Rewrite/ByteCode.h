@@ -30,6 +30,10 @@ using ByteCodeField = uint16_t;
 using ByteCodeAddr = uint32_t;
 using OwningOpRange = llvm::OwningArrayRef<Operation *>;
 
+/// A lookup table of the cases of a switch, mapping the opaque value of each
+/// case to the index of its successor.
+using PDLByteCodeSwitchTable = DenseMap<const void *, unsigned>;
+
 //===----------------------------------------------------------------------===//
 // PDLByteCodePattern
 //===----------------------------------------------------------------------===//
@@ -209,6 +213,9 @@ private:
   std::vector<PDLConstraintFunction> constraintFunctions;
   std::vector<PDLRewriteFunction> rewriteFunctions;
 
+  /// The lookup tables of the switches with many cases.
+  std::vector<PDLByteCodeSwitchTable> switchTables;
+
   /// The maximum memory index used by a value.
   ByteCodeField maxValueMemoryIndex = 0;
 
@@ -12,6 +12,7 @@
 #include "mlir/Support/ThreadLocalCache.h"
 #include "mlir/Support/TypeID.h"
 #include "llvm/Support/RWMutex.h"
+#include "llvm/Support/Threading.h"
 
 using namespace mlir;
 using namespace mlir::detail;
@@ -113,11 +114,22 @@ private:
 
 public:
 #if LLVM_ENABLE_THREADS != 0
+  /// Return the default number of shards, which grows with the number of
+  /// hardware threads so that threads creating instances rarely contend on
+  /// the same shard. Shards are lazily allocated, so this is cheap for storage
+  /// types with few instances.
+  static size_t getDefaultNumShards() {
+    static const size_t numShards = std::clamp<size_t>(
+        llvm::PowerOf2Ceil(llvm::hardware_concurrency().compute_thread_count()),
+        8, 64);
+    return numShards;
+  }
+
   /// Initialize the storage uniquer with a given number of storage shards to
   /// use. The provided shard number is required to be a valid power of 2. The
   /// destructor function is used to destroy any allocated storage instances.
   ParametricStorageUniquer(function_ref<void(BaseStorage *)> destructorFn,
-                           size_t numShards = 8)
+                           size_t numShards = getDefaultNumShards())
       : shards(new std::atomic<Shard *>[numShards]), numShards(numShards),
         destructorFn(destructorFn) {
     assert(llvm::isPowerOf2_64(numShards) &&
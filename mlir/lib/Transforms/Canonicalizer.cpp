@@ -15,6 +15,7 @@
 
 #include "mlir/Pass/Pass.h"
 #include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+#include "llvm/Support/raw_ostream.h"
 
 namespace mlir {
 #define GEN_PASS_DEF_CANONICALIZER
@@ -33,6 +34,7 @@ struct Canonicalizer : public impl::CanonicalizerBase<Canonicalizer> {
     this->topDownProcessingEnabled = config.useTopDownTraversal;
     this->enableRegionSimplification = config.enableRegionSimplification;
     this->maxIterations = config.maxIterations;
+    this->useIncrementalWorklist = config.useIncrementalWorklist;
     this->disabledPatterns = disabledPatterns;
     this->enabledPatterns = enabledPatterns;
   }
@@ -55,7 +57,22 @@ struct Canonicalizer : public impl::CanonicalizerBase<Canonicalizer> {
     config.useTopDownTraversal = topDownProcessingEnabled;
     config.enableRegionSimplification = enableRegionSimplification;
     config.maxIterations = maxIterations;
+    config.useIncrementalWorklist = useIncrementalWorklist;
+    GreedyRewriteStatistics statistics;
+    if (printPatternStatistics)
+      config.statistics = &statistics;
     (void)applyPatternsAndFoldGreedily(getOperation(), patterns, config);
+
+    // Print the statistics at once, as the pass may run on several operations
+    // in parallel.
+    if (printPatternStatistics) {
+      std::string str;
+      llvm::raw_string_ostream os(str);
+      os << "Pattern statistics for '" << getOperation()->getName() << "' at "
+         << getOperation()->getLoc() << ":\n";
+      statistics.print(os);
+      llvm::errs() << os.str();
+    }
   }
 
   FrozenRewritePatternSet patterns;
@@ -16,6 +16,7 @@
 #include "mlir/Transforms/Passes.h"
 
 #include "mlir/Analysis/CallGraph.h"
+#include "mlir/Analysis/SymbolTableAnalysis.h"
 #include "mlir/IR/Threading.h"
 #include "mlir/Interfaces/CallInterfaces.h"
 #include "mlir/Interfaces/SideEffectInterfaces.h"
@@ -671,7 +672,8 @@ void InlinerPass::runOnOperation() {
   }
 
   // Run the inline transform in post-order over the SCCs in the callgraph.
-  SymbolTableCollection symbolTable;
+  SymbolTableCollection &symbolTable =
+      getAnalysis<SymbolTableAnalysis>().getSymbolTables();
   Inliner inliner(context, cg, symbolTable);
   CGUseList useList(getOperation(), cg, symbolTable);
   LogicalResult result = runTransformOnCGSCCs(cg, [&](CallGraphSCC &scc) {
@@ -13,6 +13,7 @@
 
 #include "mlir/Transforms/Passes.h"
 
+#include "mlir/Analysis/SymbolTableAnalysis.h"
 #include "mlir/IR/SymbolTable.h"
 
 namespace mlir {
@@ -56,13 +57,15 @@ void SymbolDCE::runOnOperation() {
 
   // Compute the set of live symbols within the symbol table.
   DenseSet<Operation *> liveSymbols;
-  SymbolTableCollection symbolTable;
+  SymbolTableCollection &symbolTable =
+      getAnalysis<SymbolTableAnalysis>().getSymbolTables();
   if (failed(computeLiveness(symbolTableOp, symbolTable, symbolTableIsHidden,
                              liveSymbols)))
     return signalPassFailure();
 
   // After computing the liveness, delete all of the symbols that were found to
   // be dead.
+  bool erasedSymbol = false;
   symbolTableOp->walk([&](Operation *nestedSymbolTable) {
     if (!nestedSymbolTable->hasTrait<OpTrait::SymbolTable>())
       return;
@@ -71,10 +74,16 @@ void SymbolDCE::runOnOperation() {
         if (isa<SymbolOpInterface>(&op) && !liveSymbols.count(&op)) {
           op.erase();
           ++numDCE;
+          erasedSymbol = true;
         }
       }
     }
   });
+
+  // If every symbol was live, the IR is untouched and the symbol tables built
+  // above can be reused by later passes.
+  if (!erasedSymbol)
+    markAllAnalysesPreserved();
 }
 
 /// Compute the liveness of the symbols within the given symbol table.
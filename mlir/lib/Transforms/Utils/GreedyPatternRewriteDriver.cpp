@@ -19,6 +19,7 @@
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/ScopedPrinter.h"
 #include "llvm/Support/raw_ostream.h"
 
@@ -26,6 +27,41 @@ using namespace mlir;
 
 #define DEBUG_TYPE "greedy-rewriter"
 
+//===----------------------------------------------------------------------===//
+// GreedyRewriteStatistics
+//===----------------------------------------------------------------------===//
+
+void GreedyRewriteStatistics::recordAttempt(const Pattern &pattern,
+                                            bool succeeded,
+                                            std::chrono::nanoseconds time) {
+  StringRef name = pattern.getDebugName();
+  PatternStatistics &stats = patterns[name.empty() ? "<unnamed>" : name];
+  ++stats.numAttempts;
+  stats.numSuccesses += succeeded;
+  stats.time += time;
+}
+
+void GreedyRewriteStatistics::print(raw_ostream &os) const {
+  std::vector<const llvm::StringMapEntry<PatternStatistics> *> entries;
+  for (const auto &it : patterns)
+    entries.push_back(&it);
+  llvm::sort(entries, [](const auto *lhs, const auto *rhs) {
+    if (lhs->second.time != rhs->second.time)
+      return lhs->second.time > rhs->second.time;
+    return lhs->first() < rhs->first();
+  });
+
+  os << "  Time (ms)   Successes / Attempts (Hit rate)  Pattern\n";
+  for (const auto *entry : entries) {
+    const PatternStatistics &stats = entry->second;
+    os << llvm::format("  %9.3f  %10u / %-8u (%6.2f%%)  ",
+                       stats.time.count() / 1e6, stats.numSuccesses,
+                       stats.numAttempts,
+                       100.0 * stats.numSuccesses / stats.numAttempts)
+       << entry->first() << "\n";
+  }
+}
+
 //===----------------------------------------------------------------------===//
 // GreedyPatternRewriteDriver
 //===----------------------------------------------------------------------===//
@@ -70,6 +106,11 @@ protected:
   // worklist anymore because we'd get dangling references to it.
   void notifyOperationRemoved(Operation *op) override;
 
+  /// When using an incremental worklist, add the operation that contains the
+  /// given operation to the worklist, as a change to its regions may allow it
+  /// to be simplified. The root operations of the rewrite are never added.
+  void addParentToWorklist(Operation *op);
+
   // When the root of a pattern is about to be replaced, it can trigger
   // simplifications to its users - make sure to add them to the worklist
   // before the root is changed.
@@ -96,6 +137,10 @@ protected:
   /// Non-pattern based folder for operations.
   OperationFolder folder;
 
+  /// The operations owning the regions being simplified, which are not
+  /// simplified themselves.
+  SmallVector<Operation *, 1> rootOps;
+
 private:
   /// Configuration information for how to simplify.
   GreedyRewriteConfig config;
@@ -146,6 +191,10 @@ bool GreedyPatternRewriteDriver::simplify(MutableArrayRef<Region> regions) {
     return false;
   };
 
+  rootOps.clear();
+  for (Region &region : regions)
+    rootOps.push_back(region.getParentOp());
+
   bool changed = false;
   unsigned iteration = 0;
   do {
@@ -250,7 +299,13 @@ bool GreedyPatternRewriteDriver::simplify(MutableArrayRef<Region> regions) {
       // Try to match one of the patterns. The rewriter is automatically
       // notified of any necessary changes, so there is nothing else to do
       // here.
-#ifndef NDEBUG
+      std::chrono::steady_clock::time_point patternStart;
+      auto recordAttempt = [&](const Pattern &pattern, bool succeeded) {
+        if (config.statistics)
+          config.statistics->recordAttempt(
+              pattern, succeeded,
+              std::chrono::steady_clock::now() - patternStart);
+      };
       auto canApply = [&](const Pattern &pattern) {
         LLVM_DEBUG({
           logger.getOStream() << "\n";
@@ -260,32 +315,52 @@ bool GreedyPatternRewriteDriver::simplify(MutableArrayRef<Region> regions) {
           logger.getOStream() << ")' {\n";
           logger.indent();
         });
+        if (config.statistics)
+          patternStart = std::chrono::steady_clock::now();
         return true;
       };
       auto onFailure = [&](const Pattern &pattern) {
         LLVM_DEBUG(logResult("failure", "pattern failed to match"));
+        recordAttempt(pattern, /*succeeded=*/false);
       };
       auto onSuccess = [&](const Pattern &pattern) {
         LLVM_DEBUG(logResult("success", "pattern applied successfully"));
+        recordAttempt(pattern, /*succeeded=*/true);
         return success();
       };
 
-      LogicalResult matchResult =
-          matcher.matchAndRewrite(op, *this, canApply, onFailure, onSuccess);
+      // The hooks are only needed for logging and statistics.
+      LogicalResult matchResult = failure();
+#ifndef NDEBUG
+      bool useHooks = true;
+#else
+      bool useHooks = config.statistics != nullptr;
+#endif
+      if (useHooks)
+        matchResult =
+            matcher.matchAndRewrite(op, *this, canApply, onFailure, onSuccess);
+      else
+        matchResult = matcher.matchAndRewrite(op, *this);
       if (succeeded(matchResult))
         LLVM_DEBUG(logResultWithLine("success", "pattern matched"));
       else
         LLVM_DEBUG(logResultWithLine("failure", "pattern failed to match"));
-#else
-      LogicalResult matchResult = matcher.matchAndRewrite(op, *this);
-#endif
       changed |= succeeded(matchResult);
     }
 
     // After applying patterns, make sure that the CFG of each of the regions
     // is kept up to date.
+    bool regionsChanged = false;
     if (config.enableRegionSimplification)
-      changed |= succeeded(simplifyRegions(*this, regions));
+      regionsChanged = succeeded(simplifyRegions(*this, regions));
+
+    // With an incremental worklist, the changes made by patterns were already
+    // processed, and only region simplification, which doesn't notify us of
+    // all of its changes, requires scanning the regions again.
+    if (config.useIncrementalWorklist)
+      changed = regionsChanged;
+    else
+      changed |= regionsChanged;
   } while (changed &&
            (iteration++ < config.maxIterations ||
             config.maxIterations == GreedyRewriteConfig::kNoIterationLimit));
@@ -328,6 +403,7 @@ void GreedyPatternRewriteDriver::notifyOperationInserted(Operation *op) {
                        << ")\n";
   });
   addToWorklist(op);
+  addParentToWorklist(op);
 }
 
 void GreedyPatternRewriteDriver::finalizeRootUpdate(Operation *op) {
@@ -336,6 +412,22 @@ void GreedyPatternRewriteDriver::finalizeRootUpdate(Operation *op) {
                        << ")\n";
   });
   addToWorklist(op);
+
+  // Patterns on the users of the operation may depend on the modified
+  // operation, e.g. on its attributes.
+  if (config.useIncrementalWorklist) {
+    for (Operation *user : op->getUsers())
+      addToWorklist(user);
+    addParentToWorklist(op);
+  }
+}
+
+void GreedyPatternRewriteDriver::addParentToWorklist(Operation *op) {
+  if (!config.useIncrementalWorklist)
+    return;
+  Operation *parentOp = op->getParentOp();
+  if (parentOp && !llvm::is_contained(rootOps, parentOp))
+    addToWorklist(parentOp);
 }
 
 void GreedyPatternRewriteDriver::addOperandsToWorklist(ValueRange operands) {
@@ -358,6 +450,7 @@ void GreedyPatternRewriteDriver::notifyOperationRemoved(Operation *op) {
     removeFromWorklist(operation);
     folder.notifyRemoval(operation);
   });
+  addParentToWorklist(op);
 }
 
 void GreedyPatternRewriteDriver::notifyRootReplaced(Operation *op,
@@ -113,6 +113,10 @@ struct TestLinalgTransforms
       *this, "test-erase-unused-operands-and-results",
       llvm::cl::desc("Test patterns to erase unused operands and results"),
       llvm::cl::init(false)};
+  Option<bool> testCacheTileSizes{
+      *this, "test-cache-tile-sizes",
+      llvm::cl::desc("Test the tile sizes picked by the cache model"),
+      llvm::cl::init(false)};
 };
 } // namespace
 
@@ -185,6 +189,22 @@ static void applyEraseUnusedOperandsAndResultsPatterns(func::FuncOp funcOp) {
   (void)applyPatternsAndFoldGreedily(funcOp, std::move(patterns));
 }
 
+/// Emits a remark with the tile sizes the cache model picks for each op.
+static void applyCacheTileSizes(func::FuncOp funcOp) {
+  LinalgCacheModel model = LinalgCacheModel::get(funcOp);
+  funcOp.walk([&](LinalgOp op) {
+    FailureOr<LinalgCacheTileSizes> sizes = computeCacheTileSizes(op, model);
+    if (failed(sizes)) {
+      op.emitRemark("no cache tile sizes");
+      return;
+    }
+    InFlightDiagnostic remark = op.emitRemark("tile sizes:");
+    for (ArrayRef<int64_t> levelSizes : sizes->tileSizes)
+      remark << " [" << levelSizes << "]";
+    remark << " vector sizes: [" << sizes->vectorSizes << "]";
+  });
+}
+
 /// Apply transformations specified as patterns.
 void TestLinalgTransforms::runOnOperation() {
   if (testPatterns)
@@ -205,6 +225,8 @@ void TestLinalgTransforms::runOnOperation() {
     return applySwapExtractSliceWithFillPattern(getOperation());
   if (testEraseUnusedOperandsAndResults)
     return applyEraseUnusedOperandsAndResultsPatterns(getOperation());
+  if (testCacheTileSizes)
+    return applyCacheTileSizes(getOperation());
 }
 
 namespace mlir {
@@ -0,0 +1,221 @@
+//===- BytecodeTest.cpp - MLIR bytecode reader and writer tests -----------===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Bytecode/BytecodeReader.h"
+#include "mlir/Bytecode/BytecodeWriter.h"
+#include "mlir/IR/BuiltinAttributes.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/BuiltinTypes.h"
+#include "mlir/IR/DialectResourceBlobManager.h"
+#include "mlir/IR/OwningOpRef.h"
+#include "mlir/Parser/Parser.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/MemoryBufferRef.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+using namespace mlir;
+
+static const char *const irText = R"mlir(
+module {
+  module @a {
+    "test.a"() : () -> ()
+  }
+  module @b {
+    module @c {
+      "test.c"() : () -> ()
+    }
+  }
+}
+)mlir";
+
+namespace {
+struct BytecodeTest : public ::testing::Test {
+  BytecodeTest() : config(&context) {
+    context.allowUnregisteredDialects();
+    module = parseSourceString<ModuleOp>(irText, config);
+    llvm::raw_string_ostream os(bytecode);
+    writeBytecodeToFile(*module, os);
+  }
+
+  /// Print the given operation in the generic form. Top-level operations are
+  /// printed with a trailing newline, which we drop for the comparisons.
+  static std::string print(Operation *op) {
+    std::string str;
+    llvm::raw_string_ostream os(str);
+    op->print(os, OpPrintingFlags().printGenericOpForm());
+    return StringRef(os.str()).rtrim().str();
+  }
+
+  /// Return the nested module with the given name.
+  static ModuleOp lookup(Block &block, StringRef name) {
+    ModuleOp result;
+    block.front().walk([&](ModuleOp op) {
+      if (op.getSymName() == name)
+        result = op;
+    });
+    return result;
+  }
+
+  MLIRContext context;
+  ParserConfig config;
+  OwningOpRef<ModuleOp> module;
+  std::string bytecode;
+};
+} // namespace
+
+TEST_F(BytecodeTest, ReadEagerly) {
+  ASSERT_TRUE(module);
+  Block block;
+  llvm::MemoryBufferRef buffer(bytecode, "bytecode");
+  ASSERT_TRUE(succeeded(readBytecodeFile(buffer, &block, config)));
+  EXPECT_EQ(print(*module), print(&block.front()));
+}
+
+TEST_F(BytecodeTest, LazilyMaterializeNamedModules) {
+  ASSERT_TRUE(module);
+  Block block;
+  llvm::MemoryBufferRef buffer(bytecode, "bytecode");
+  BytecodeReader reader(buffer, config, /*lazyLoad=*/true);
+  auto isNamedModule = [](Operation *op) {
+    auto moduleOp = dyn_cast<ModuleOp>(op);
+    return moduleOp && moduleOp.getSymName();
+  };
+  ASSERT_TRUE(succeeded(reader.readTopLevel(&block, isNamedModule)));
+
+  // Only the unnamed outer module was read.
+  EXPECT_EQ(reader.getNumOpsToMaterialize(), 2);
+  ModuleOp a = lookup(block, "a"), b = lookup(block, "b");
+  ASSERT_TRUE(a && b);
+  EXPECT_TRUE(reader.isMaterializable(a));
+  EXPECT_TRUE(a.getBodyRegion().empty());
+  EXPECT_FALSE(lookup(block, "c"));
+
+  ASSERT_TRUE(succeeded(reader.materialize(a)));
+  EXPECT_FALSE(reader.isMaterializable(a));
+  EXPECT_EQ(reader.getNumOpsToMaterialize(), 1);
+  EXPECT_EQ(a.getBody()->front().getName().getStringRef(), "test.a");
+
+  // Nested lazy operations can be deferred again.
+  ASSERT_TRUE(succeeded(reader.materialize(b, isNamedModule)));
+  EXPECT_EQ(reader.getNumOpsToMaterialize(), 1);
+  ModuleOp c = lookup(block, "c");
+  ASSERT_TRUE(c);
+  EXPECT_TRUE(reader.isMaterializable(c));
+
+  ASSERT_TRUE(succeeded(reader.finalize()));
+  EXPECT_EQ(reader.getNumOpsToMaterialize(), 0);
+  EXPECT_EQ(print(*module), print(&block.front()));
+}
+
+TEST_F(BytecodeTest, FinalizeWithoutMaterializing) {
+  ASSERT_TRUE(module);
+  Block block;
+  llvm::MemoryBufferRef buffer(bytecode, "bytecode");
+  BytecodeReader reader(buffer, config, /*lazyLoad=*/true);
+  ASSERT_TRUE(succeeded(reader.readTopLevel(&block, [](Operation *op) {
+    return isa<ModuleOp>(op) && cast<ModuleOp>(op).getSymName();
+  })));
+  ASSERT_TRUE(succeeded(reader.finalize([](Operation *) { return false; })));
+  EXPECT_EQ(reader.getNumOpsToMaterialize(), 0);
+  EXPECT_TRUE(lookup(block, "a").getBodyRegion().empty());
+  EXPECT_TRUE(lookup(block, "b").getBodyRegion().empty());
+}
+
+TEST(Bytecode, ParallelRoundTrip) {
+  // Generate a module with many isolated modules, whose values are used
+  // before they are defined.
+  std::string text;
+  llvm::raw_string_ostream os(text);
+  os << "module {\n";
+  for (unsigned i = 0; i < 64; ++i) {
+    os << "  module @m" << i << " {\n"
+       << "    %0 = \"test.use\"(%1) : (i32) -> i32\n"
+       << "    %1 = \"test.def\"() {value = " << i << " : i32} : () -> i32\n"
+       << "    module @nested {\n"
+       << "      \"test.region\"() ({\n"
+       << "      ^bb0(%arg0: i32):\n"
+       << "        \"test.br\"(%arg0)[^bb1] : (i32) -> ()\n"
+       << "      ^bb1:\n"
+       << "        \"test.end\"() : () -> ()\n"
+       << "      }) : () -> ()\n"
+       << "    }\n"
+       << "  }\n";
+  }
+  os << "}\n";
+
+  MLIRContext context;
+  context.allowUnregisteredDialects();
+  ASSERT_TRUE(context.isMultithreadingEnabled());
+  ParserConfig config(&context);
+  OwningOpRef<ModuleOp> module = parseSourceString<ModuleOp>(os.str(), config);
+  ASSERT_TRUE(module);
+
+  std::string bytecode;
+  llvm::raw_string_ostream bytecodeOS(bytecode);
+  writeBytecodeToFile(*module, bytecodeOS);
+
+  // The parallel writer and reader must produce the same IR as the serial
+  // ones.
+  std::string serialBytecode;
+  context.disableMultithreading();
+  llvm::raw_string_ostream serialOS(serialBytecode);
+  writeBytecodeToFile(*module, serialOS);
+  EXPECT_EQ(bytecodeOS.str(), serialOS.str());
+  context.enableMultithreading();
+
+  Block block;
+  llvm::MemoryBufferRef buffer(bytecodeOS.str(), "bytecode");
+  ASSERT_TRUE(succeeded(readBytecodeFile(buffer, &block, config)));
+  EXPECT_EQ(BytecodeTest::print(*module), BytecodeTest::print(&block.front()));
+}
+
+TEST(Bytecode, BlobsAliasSharedBuffer) {
+  // Write a module with a blob resource.
+  std::string bytecode;
+  {
+    MLIRContext context;
+    OwningOpRef<ModuleOp> module = ModuleOp::create(UnknownLoc::get(&context));
+    SmallVector<int64_t> values = {1, 2, 3, 4};
+    auto type = RankedTensorType::get({4}, IntegerType::get(&context, 64));
+    (*module)->setAttr(
+        "test.weights",
+        DenseI64ResourceElementsAttr::get(
+            type, "weights",
+            HeapAsmResourceBlob::allocateAndCopy(ArrayRef<int64_t>(values))));
+    llvm::raw_string_ostream os(bytecode);
+    writeBytecodeToFile(*module, os);
+  }
+
+  MLIRContext context;
+  ParserConfig config(&context);
+  auto sourceMgr = std::make_shared<llvm::SourceMgr>();
+  sourceMgr->AddNewSourceBuffer(
+      llvm::MemoryBuffer::getMemBufferCopy(bytecode, "bytecode"),
+      llvm::SMLoc());
+  StringRef buffer =
+      sourceMgr->getMemoryBuffer(sourceMgr->getMainFileID())->getBuffer();
+  Block block;
+  ASSERT_TRUE(succeeded(readBytecodeFile(sourceMgr, &block, config)));
+
+  // The blob refers to the data within the buffer, which it keeps alive.
+  sourceMgr.reset();
+  auto attr = block.front().getAttrOfType<DenseI64ResourceElementsAttr>(
+      "test.weights");
+  ASSERT_TRUE(attr);
+  const AsmResourceBlob *blob = attr.getRawHandle().getBlob();
+  ASSERT_TRUE(blob);
+  EXPECT_FALSE(blob->isMutable());
+  EXPECT_GE(blob->getData().data(), buffer.begin());
+  EXPECT_LE(blob->getData().end(), buffer.end());
+  EXPECT_EQ(blob->getDataAs<int64_t>(), ArrayRef<int64_t>({1, 2, 3, 4}));
+}
@@ -0,0 +1,58 @@
+//===- SymbolTableTest.cpp - SymbolTable unit tests -----------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/IR/SymbolTable.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "llvm/Support/ThreadPool.h"
+#include "gtest/gtest.h"
+
+using namespace mlir;
+
+namespace {
+TEST(SymbolTableTest, LockedCollectionLookups) {
+  MLIRContext context;
+  context.allowUnregisteredDialects();
+  OpBuilder builder(&context);
+  Location loc = builder.getUnknownLoc();
+
+  OwningOpRef<ModuleOp> module = ModuleOp::create(loc);
+  builder.setInsertionPointToEnd(module->getBody());
+  SmallVector<Operation *> symbols;
+  for (unsigned i = 0; i < 64; ++i) {
+    OperationState state(loc, "foo.symbol");
+    state.addAttribute(SymbolTable::getSymbolAttrName(),
+                       builder.getStringAttr("sym" + Twine(i)));
+    symbols.push_back(builder.create(state));
+  }
+
+  SymbolTableCollection symbolTables;
+  LockedSymbolTableCollection lockedSymbolTables(symbolTables);
+
+  // The first lookup of each thread may race with the construction of the
+  // table.
+  llvm::ThreadPool threadPool;
+  for (unsigned thread = 0; thread < 4; ++thread) {
+    threadPool.async([&] {
+      for (unsigned i = 0; i < symbols.size(); ++i) {
+        Operation *found = lockedSymbolTables.lookupSymbolIn(
+            *module, builder.getStringAttr("sym" + Twine(i)));
+        EXPECT_EQ(found, symbols[i]);
+      }
+    });
+  }
+  threadPool.wait();
+
+  // Lookups through the view and the underlying collection share the table.
+  EXPECT_EQ(&lockedSymbolTables.getSymbolTable(*module),
+            &symbolTables.getSymbolTable(*module));
+  EXPECT_EQ(lockedSymbolTables.lookupSymbolIn(*module,
+                                              builder.getStringAttr("none")),
+            nullptr);
+}
+} // namespace
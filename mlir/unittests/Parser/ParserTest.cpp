@@ -55,4 +55,49 @@ TEST(MLIRParser, ParseAtEnd) {
   EXPECT_EQ(block.front().getName().getStringRef(), "test.first");
   EXPECT_EQ(block.back().getName().getStringRef(), "test.second");
 }
+
+TEST(MLIRParser, PrintIsolatedOpsInParallel) {
+  std::string moduleStr = R"mlir(
+    module {
+      module @a {
+        %0 = "test.foo"() {name = "a"} : () -> i32
+        "test.bar"(%0) : (i32) -> ()
+      }
+      "test.between"() : () -> ()
+      module @b {
+        %0:2 = "test.foo"() : () -> (i32, i64)
+        "test.bar"(%0#1) ({
+        ^bb0(%arg0: i64):
+          "test.baz"(%arg0, %0#0) : (i64, i32) -> ()
+        }) : (i64) -> ()
+      }
+      module @c {
+        module @d {
+          %0 = "test.foo"() : () -> i32
+        }
+        module @e {
+        }
+      }
+    }
+  )mlir";
+
+  MLIRContext context;
+  context.allowUnregisteredDialects();
+  OwningOpRef<ModuleOp> module =
+      parseSourceString<ModuleOp>(moduleStr, &context);
+  ASSERT_TRUE(module);
+
+  // Printing the sibling modules in parallel must produce the same output as
+  // printing them one after the other.
+  auto print = [&] {
+    std::string str;
+    llvm::raw_string_ostream os(str);
+    module->print(os);
+    return str;
+  };
+  context.disableMultithreading();
+  std::string serialStr = print();
+  context.enableMultithreading();
+  EXPECT_EQ(print(), serialStr);
+}
 } // namespace
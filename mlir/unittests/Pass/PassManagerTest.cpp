@@ -13,6 +13,7 @@
 #include "mlir/Pass/Pass.h"
 #include "gtest/gtest.h"
 
+#include <atomic>
 #include <memory>
 
 using namespace mlir;
@@ -141,4 +142,52 @@ TEST(PassManagerTest, InvalidPass) {
   ASSERT_DEATH(pm.addPass(std::make_unique<InvalidPass>()), "");
 }
 
+
+namespace {
+/// Pass that counts its runs and annotates the operation it runs on.
+struct CountingPass
+    : public PassWrapper<CountingPass, OperationPass<ModuleOp>> {
+  MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(CountingPass)
+
+  CountingPass(std::atomic<unsigned> &numRuns) : numRuns(numRuns) {}
+  StringRef getArgument() const final { return "test-counting-pass"; }
+  void runOnOperation() override {
+    ++numRuns;
+    getOperation()->setAttr("test.visited", UnitAttr::get(&getContext()));
+  }
+
+  std::atomic<unsigned> &numRuns;
+};
+} // namespace
+
+TEST(PassManagerTest, PipelineCache) {
+  MLIRContext context;
+  PassPipelineCache cache;
+  std::atomic<unsigned> numRuns(0);
+
+  // Runs the counting pass on the nested modules `a` and `name`.
+  auto run = [&](StringRef name) {
+    OwningOpRef<ModuleOp> module(ModuleOp::create(UnknownLoc::get(&context)));
+    for (StringRef innerName : {StringRef("a"), name})
+      module->push_back(ModuleOp::create(UnknownLoc::get(&context), innerName));
+
+    PassManager pm(&context);
+    pm.enablePipelineCache(&cache);
+    pm.nest<ModuleOp>().addPass(std::make_unique<CountingPass>(numRuns));
+    EXPECT_TRUE(succeeded(pm.run(module.get())));
+    for (ModuleOp inner : module->getOps<ModuleOp>())
+      EXPECT_TRUE(inner->hasAttr("test.visited"));
+  };
+
+  run("b");
+  EXPECT_EQ(numRuns, 2u);
+  EXPECT_EQ(cache.getNumMisses(), 2u);
+
+  // Only `c` is new, the result for `a` is taken from the cache.
+  run("c");
+  EXPECT_EQ(numRuns, 3u);
+  EXPECT_EQ(cache.getNumHits(), 1u);
+  EXPECT_EQ(cache.getNumMisses(), 3u);
+}
+
 } // namespace
@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "mlir/Support/StorageUniquer.h"
+#include "llvm/Support/ThreadPool.h"
 #include "gmock/gmock.h"
 
 using namespace mlir;
@@ -58,3 +59,35 @@ TEST(StorageUniquerTest, NonTrivialDestructor) {
 
   EXPECT_TRUE(wasDestructed);
 }
+
+TEST(StorageUniquerTest, ParallelGet) {
+  struct IntStorage : public SimpleStorage<IntStorage, int> {
+    using Base::Base;
+  };
+
+  StorageUniquer uniquer;
+  uniquer.registerParametricStorageType<IntStorage>();
+
+  // Get the same instances from several threads, in a different order on
+  // each thread, and check that every thread got the same instances.
+  constexpr int numThreads = 4, numKeys = 2000;
+  std::vector<std::vector<IntStorage *>> instances(
+      numThreads, std::vector<IntStorage *>(numKeys));
+  {
+    llvm::ThreadPool pool(llvm::hardware_concurrency(numThreads));
+    for (int thread = 0; thread != numThreads; ++thread) {
+      pool.async([&, thread] {
+        for (int i = 0; i != numKeys; ++i) {
+          int key = (i * 7 + thread * 13) % numKeys;
+          instances[thread][key] = IntStorage::get(uniquer, key);
+        }
+      });
+    }
+  }
+
+  for (int key = 0; key != numKeys; ++key) {
+    EXPECT_EQ(std::get<0>(instances[0][key]->key), key);
+    for (int thread = 1; thread != numThreads; ++thread)
+      EXPECT_EQ(instances[thread][key], instances[0][key]);
+  }
+}
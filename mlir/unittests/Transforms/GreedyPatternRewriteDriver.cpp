@@ -0,0 +1,125 @@
+//===- GreedyPatternRewriteDriver.cpp - Greedy rewrite driver unit tests --===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Parser/Parser.h"
+#include "gtest/gtest.h"
+
+using namespace mlir;
+
+namespace {
+
+/// Erases "test.foo" operations without uses.
+struct EraseUnusedPattern : public RewritePattern {
+  EraseUnusedPattern(MLIRContext *context)
+      : RewritePattern("test.foo", /*benefit=*/1, context) {
+    setDebugName("EraseUnusedPattern");
+  }
+
+  LogicalResult matchAndRewrite(Operation *op,
+                                PatternRewriter &rewriter) const override {
+    if (!op->use_empty())
+      return failure();
+    rewriter.eraseOp(op);
+    return success();
+  }
+};
+
+/// Never matches "test.bar" operations.
+struct NeverMatchPattern : public RewritePattern {
+  NeverMatchPattern(MLIRContext *context)
+      : RewritePattern("test.bar", /*benefit=*/1, context) {
+    setDebugName("NeverMatchPattern");
+  }
+
+  LogicalResult matchAndRewrite(Operation *op,
+                                PatternRewriter &rewriter) const override {
+    return failure();
+  }
+};
+
+struct TestDialect : public Dialect {
+  MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(TestDialect)
+
+  static StringRef getDialectNamespace() { return "test"; }
+
+  TestDialect(MLIRContext *context)
+      : Dialect(getDialectNamespace(), context, TypeID::get<TestDialect>()) {
+    allowUnknownOperations();
+  }
+};
+
+const char *const code = R"mlir(
+  %0 = "test.foo"() : () -> i32
+  %1 = "test.foo"(%0) : (i32) -> i32
+  %2 = "test.foo"(%1) : (i32) -> i32
+  "test.bar"() : () -> ()
+)mlir";
+
+/// Applies the test patterns to `code` and returns the statistics.
+static GreedyRewriteStatistics runPatterns(bool useIncrementalWorklist) {
+  MLIRContext context;
+  context.getOrLoadDialect<TestDialect>();
+  OwningOpRef<ModuleOp> module = parseSourceString<ModuleOp>(code, &context);
+  EXPECT_TRUE(module);
+
+  RewritePatternSet patterns(&context);
+  patterns.add<EraseUnusedPattern, NeverMatchPattern>(&context);
+  FrozenRewritePatternSet frozenPatterns(std::move(patterns));
+
+  GreedyRewriteStatistics statistics;
+  GreedyRewriteConfig config;
+  config.useIncrementalWorklist = useIncrementalWorklist;
+  config.statistics = &statistics;
+  EXPECT_TRUE(
+      succeeded(applyPatternsAndFoldGreedily(*module, frozenPatterns, config)));
+
+  // Only "test.bar" remains.
+  Block *body = module->getBody();
+  EXPECT_EQ(body->getOperations().size(), 1u);
+  EXPECT_EQ(body->front().getName().getStringRef(), "test.bar");
+  return statistics;
+}
+
+TEST(GreedyPatternRewriteDriverTest, Statistics) {
+  GreedyRewriteStatistics statistics =
+      runPatterns(/*useIncrementalWorklist=*/false);
+  const auto &patterns = statistics.getPatternStatistics();
+  ASSERT_EQ(patterns.size(), 2u);
+
+  const auto &erase = patterns.lookup("EraseUnusedPattern");
+  EXPECT_EQ(erase.numSuccesses, 3u);
+  EXPECT_GE(erase.numAttempts, 3u);
+
+  // The IR is scanned once more after it changed, to check that it converged.
+  const auto &neverMatch = patterns.lookup("NeverMatchPattern");
+  EXPECT_EQ(neverMatch.numSuccesses, 0u);
+  EXPECT_EQ(neverMatch.numAttempts, 2u);
+
+  std::string str;
+  llvm::raw_string_ostream os(str);
+  statistics.print(os);
+  EXPECT_NE(os.str().find("EraseUnusedPattern"), std::string::npos);
+}
+
+TEST(GreedyPatternRewriteDriverTest, IncrementalWorklist) {
+  GreedyRewriteStatistics statistics =
+      runPatterns(/*useIncrementalWorklist=*/true);
+  const auto &patterns = statistics.getPatternStatistics();
+
+  EXPECT_EQ(patterns.lookup("EraseUnusedPattern").numSuccesses, 3u);
+
+  // "test.bar" is not affected by the erasures, so it is only visited once.
+  const auto &neverMatch = patterns.lookup("NeverMatchPattern");
+  EXPECT_EQ(neverMatch.numSuccesses, 0u);
+  EXPECT_EQ(neverMatch.numAttempts, 1u);
+}
+
+} // end anonymous namespace
@@ -15,7 +15,10 @@
 #include "omptarget.h"
 #include "omptargetplugin.h"
 
+#include "llvm/Support/MathExtras.h"
+
 #include <cstdint>
+#include <cstring>
 #include <limits>
 
 using namespace llvm;
@@ -131,6 +134,54 @@ uint64_t GenericKernelTy::getNumBlocks(GenericDeviceTy &GenericDevice,
   return std::min(PreferredNumBlocks, GenericDevice.getBlockLimit());
 }
 
+PinnedStagingTy::~PinnedStagingTy() {
+  for (char *Slab : AllSlabs)
+    if (Allocator.free(Slab, TARGET_ALLOC_HOST) != OFFLOAD_SUCCESS)
+      REPORT("Failure to free pinned staging memory %p\n", Slab);
+}
+
+void *PinnedStagingTy::stage(const void *HstPtr, size_t Size,
+                             __tgt_async_info *AsyncInfo) {
+  if (Size == 0 || Size > Threshold)
+    return nullptr;
+
+  std::lock_guard<std::mutex> Lock(Mutex);
+  auto &Slabs = InUse[AsyncInfo];
+  if (Slabs.empty() || Slabs.back().Used + Size > SlabSize) {
+    char *Slab = nullptr;
+    if (!FreeSlabs.empty()) {
+      Slab = FreeSlabs.pop_back_val();
+    } else {
+      Slab = reinterpret_cast<char *>(
+          Allocator.allocate(SlabSize, nullptr, TARGET_ALLOC_HOST));
+      if (!Slab) {
+        if (Slabs.empty())
+          InUse.erase(AsyncInfo);
+        return nullptr;
+      }
+      AllSlabs.push_back(Slab);
+    }
+    Slabs.push_back({Slab, 0});
+  }
+
+  SlabTy &Slab = Slabs.back();
+  char *Staged = Slab.Begin + Slab.Used;
+  std::memcpy(Staged, HstPtr, Size);
+  // Keep the staged copies aligned like the allocations they are copied to.
+  Slab.Used = alignTo(Slab.Used + Size, 16);
+  return Staged;
+}
+
+void PinnedStagingTy::release(__tgt_async_info *AsyncInfo) {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  auto It = InUse.find(AsyncInfo);
+  if (It == InUse.end())
+    return;
+  for (SlabTy &Slab : It->second)
+    FreeSlabs.push_back(Slab.Begin);
+  InUse.erase(It);
+}
+
 GenericDeviceTy::GenericDeviceTy(int32_t DeviceId, int32_t NumDevices,
                                  const llvm::omp::GV &OMPGridValues)
     : OMP_TeamLimit("OMP_TEAM_LIMIT"), OMP_NumTeams("OMP_NUM_TEAMS"),
@@ -140,8 +191,9 @@ GenericDeviceTy::GenericDeviceTy(int32_t DeviceId, int32_t NumDevices,
       // Do not initialize the following two envars since they depend on the
       // device initialization. These cannot be consulted until the device is
       // initialized correctly. We intialize them in GenericDeviceTy::init().
-      OMPX_TargetStackSize(), OMPX_TargetHeapSize(), MemoryManager(nullptr),
-      DeviceId(DeviceId), GridValues(OMPGridValues),
+      OMPX_TargetStackSize(), OMPX_TargetHeapSize(),
+      OMPX_StagingThreshold("LIBOMPTARGET_STAGING_THRESHOLD", 32 * 1024),
+      MemoryManager(nullptr), PinnedStaging(nullptr), DeviceId(DeviceId), GridValues(OMPGridValues),
       PeerAccesses(NumDevices, PeerAccessState::PENDING), PeerAccessesLock() {
   if (OMP_NumTeams > 0)
     GridValues.GV_Max_Teams =
@@ -180,16 +232,32 @@ Error GenericDeviceTy::init(GenericPluginTy &Plugin) {
   if (EnableMM)
     MemoryManager = new MemoryManagerTy(*this, ThresholdMM);
 
+  // Stage small transfers through pinned memory if the plugin supports it.
+  if (supportsPinnedStaging() && OMPX_StagingThreshold > 0)
+    PinnedStaging = new PinnedStagingTy(*this, OMPX_StagingThreshold);
+
   return Plugin::success();
 }
 
 Error GenericDeviceTy::deinit() {
   // Delete the memory manager before deinitilizing the device. Otherwise,
   // we may delete device allocations after the device is deinitialized.
-  if (MemoryManager)
+  if (MemoryManager) {
+    uint64_t Hits, Misses, Unmanaged;
+    MemoryManager->getStatistics(Hits, Misses, Unmanaged);
+    if (Hits + Misses)
+      INFO(OMP_INFOTYPE_DATA_TRANSFER, DeviceId,
+           "Memory manager served %" PRIu64 " of %" PRIu64
+           " allocations from its cache (%" PRIu64 " too large to cache)\n",
+           Hits, Hits + Misses, Unmanaged);
     delete MemoryManager;
+  }
   MemoryManager = nullptr;
 
+  if (PinnedStaging)
+    delete PinnedStaging;
+  PinnedStaging = nullptr;
+
   return deinitImpl();
 }
 
@@ -342,7 +410,13 @@ Error GenericDeviceTy::synchronize(__tgt_async_info *AsyncInfo) {
   if (!AsyncInfo || !AsyncInfo->Queue)
     return Plugin::error("Invalid async info queue");
 
-  return synchronizeImpl(*AsyncInfo);
+  auto Err = synchronizeImpl(*AsyncInfo);
+
+  // The staged transfers of this async info are complete, or failed.
+  if (PinnedStaging)
+    PinnedStaging->release(AsyncInfo);
+
+  return Err;
 }
 
 Expected<void *> GenericDeviceTy::dataAlloc(int64_t Size, void *HostPtr,
@@ -391,6 +465,12 @@ Error GenericDeviceTy::dataDelete(void *TgtPtr, TargetAllocTy Kind) {
 
 Error GenericDeviceTy::dataSubmit(void *TgtPtr, const void *HstPtr,
                                   int64_t Size, __tgt_async_info *AsyncInfo) {
+  // Asynchronous small transfers are issued from pinned memory, so the host
+  // does not wait for them.
+  if (PinnedStaging && AsyncInfo)
+    if (void *Staged = PinnedStaging->stage(HstPtr, Size, AsyncInfo))
+      HstPtr = Staged;
+
   auto Err = Plugin::success();
   AsyncInfoWrapperTy AsyncInfoWrapper(Err, *this, AsyncInfo);
   Err = dataSubmitImpl(TgtPtr, HstPtr, Size, AsyncInfoWrapper);
@@ -15,6 +15,7 @@
 #include <cstdint>
 #include <list>
 #include <map>
+#include <mutex>
 #include <vector>
 
 #include "Debug.h"
@@ -24,6 +25,7 @@
 #include "Utilities.h"
 #include "omptarget.h"
 
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/Frontend/OpenMP/OMPConstants.h"
 #include "llvm/Frontend/OpenMP/OMPGridValues.h"
@@ -240,6 +242,54 @@ protected:
   uint32_t MaxNumThreads;
 };
 
+/// Class staging small host to device transfers through pinned host memory.
+/// Copies from pageable memory are synchronous with the host in most device
+/// runtimes. That keeps the host thread from queuing the next transfers and
+/// prevents them from overlapping with kernels running on other queues.
+/// Copying the data into pinned memory first makes the transfer truly
+/// asynchronous. The pinned memory is handed out in slabs per async info
+/// object and recycled once that async info is synchronized.
+class PinnedStagingTy {
+  /// Size of the pinned slabs. Transfers larger than the threshold, which is
+  /// at most this size, are never staged.
+  static constexpr size_t SlabSize = 1U << 20;
+
+  struct SlabTy {
+    char *Begin;
+    size_t Used;
+  };
+
+  /// The device used to allocate pinned host memory.
+  DeviceAllocatorTy &Allocator;
+
+  /// Largest transfer that is staged.
+  const size_t Threshold;
+
+  /// Slabs not used by any async info and all slabs ever allocated.
+  llvm::SmallVector<char *> FreeSlabs;
+  llvm::SmallVector<char *> AllSlabs;
+
+  /// Slabs used by each async info with pending transfers.
+  llvm::DenseMap<__tgt_async_info *, llvm::SmallVector<SlabTy, 1>> InUse;
+
+  std::mutex Mutex;
+
+public:
+  PinnedStagingTy(DeviceAllocatorTy &Allocator, size_t Threshold)
+      : Allocator(Allocator), Threshold(std::min(Threshold, SlabSize)) {}
+
+  ~PinnedStagingTy();
+
+  /// Copy \p Size bytes at \p HstPtr into pinned memory that stays valid
+  /// until \p AsyncInfo is synchronized. Returns nullptr if the transfer should
+  /// be issued from \p HstPtr directly.
+  void *stage(const void *HstPtr, size_t Size, __tgt_async_info *AsyncInfo);
+
+  /// Recycle the pinned memory used by \p AsyncInfo. Must only be called
+  /// once all the transfers issued on it have completed.
+  void release(__tgt_async_info *AsyncInfo);
+};
+
 /// Class implementing common functionalities of offload devices. Each plugin
 /// should define the specific device class, derive from this generic one, and
 /// implement the necessary virtual function members.
@@ -398,6 +448,12 @@ private:
   /// setupDeviceEnvironment() function.
   virtual bool shouldSetupDeviceEnvironment() const { return true; }
 
+  /// Indicate whether small host to device transfers should be staged through
+  /// pinned host memory. Plugins returning true must allocate pinned memory
+  /// for TARGET_ALLOC_HOST and must set the queue of any asynchronous transfer,
+  /// so the async info is synchronized later.
+  virtual bool supportsPinnedStaging() const { return false; }
+
   /// Environment variables defined by the OpenMP standard.
   Int32Envar OMP_TeamLimit;
   Int32Envar OMP_NumTeams;
@@ -408,10 +464,14 @@ private:
   UInt32Envar OMPX_SharedMemorySize;
   UInt64Envar OMPX_TargetStackSize;
   UInt64Envar OMPX_TargetHeapSize;
+  UInt32Envar OMPX_StagingThreshold;
 
   /// Pointer to the memory manager or nullptr if not available.
   MemoryManagerTy *MemoryManager;
 
+  /// Pointer to the pinned staging memory or nullptr if not used.
+  PinnedStagingTy *PinnedStaging;
+
 protected:
   /// Array of images loaded into the device. Images are automatically
   /// deallocated by the allocator.
@@ -474,6 +474,10 @@ struct CUDADeviceTy : public GenericDeviceTy {
     return OFFLOAD_SUCCESS;
   }
 
+  /// Copies from pageable memory are synchronous, so stage small ones through
+  /// pinned memory. All asynchronous operations get a stream.
+  bool supportsPinnedStaging() const override { return true; }
+
   /// Synchronize current thread with the pending operations on the async info.
   Error synchronizeImpl(__tgt_async_info &AsyncInfo) override {
     CUstream Stream = reinterpret_cast<CUstream>(AsyncInfo.Queue);
@@ -13,6 +13,7 @@
 #ifndef LLVM_OPENMP_LIBOMPTARGET_PLUGINS_COMMON_MEMORYMANAGER_MEMORYMANAGER_H
 #define LLVM_OPENMP_LIBOMPTARGET_PLUGINS_COMMON_MEMORYMANAGER_MEMORYMANAGER_H
 
+#include <atomic>
 #include <cassert>
 #include <functional>
 #include <list>
@@ -132,6 +133,20 @@ class MemoryManagerTy {
   /// memory manager.
   size_t SizeThreshold = 1U << 13;
 
+  /// The maximum number of bytes kept in the free lists. A freed node that
+  /// would push the cache over this limit is returned to the device instead.
+  /// Zero means unlimited.
+  size_t CacheLimit = 0;
+
+  /// Number of bytes currently sitting in the free lists.
+  std::atomic<size_t> CachedBytes{0};
+
+  /// Allocation counters: requests served from the free lists, requests that
+  /// had to go to the device, and requests above \p SizeThreshold .
+  std::atomic<uint64_t> NumHits{0};
+  std::atomic<uint64_t> NumMisses{0};
+  std::atomic<uint64_t> NumUnmanaged{0};
+
   /// Request memory from target device
   void *allocateOnDevice(size_t Size, void *HstPtr) const {
     return DeviceAllocator.allocate(Size, HstPtr, TARGET_ALLOC_DEVICE);
@@ -158,6 +173,7 @@ class MemoryManagerTy {
       }
       FreeLists[I].clear();
     }
+    CachedBytes = 0;
 
     // Remove all nodes in the map table which have been released
     if (!RemoveList.empty()) {
@@ -199,6 +215,9 @@ public:
         DeviceAllocator(DeviceAllocator) {
     if (Threshold)
       SizeThreshold = Threshold;
+    if (const char *Env =
+            std::getenv("LIBOMPTARGET_MEMORY_MANAGER_CACHE_LIMIT"))
+      CacheLimit = std::stoul(Env);
   }
 
   /// Destructor
@@ -227,6 +246,7 @@ public:
       DP("%zu is greater than the threshold %zu. Allocate it directly from "
          "device\n",
          Size, SizeThreshold);
+      ++NumUnmanaged;
       void *TgtPtr = allocateOrFreeAndAllocateOnDevice(Size, HstPtr);
 
       DP("Got target pointer " DPxMOD ". Return directly.\n", DPxPTR(TgtPtr));
@@ -248,11 +268,16 @@ public:
       if (Itr != List.end()) {
         NodePtr = &Itr->get();
         List.erase(Itr);
+        CachedBytes -= NodePtr->Size;
       }
     }
 
-    if (NodePtr != nullptr)
+    if (NodePtr != nullptr) {
       DP("Find one node " DPxMOD " in the bucket.\n", DPxPTR(NodePtr));
+      ++NumHits;
+    } else {
+      ++NumMisses;
+    }
 
     // We cannot find a valid node in FreeLists. Let's allocate on device and
     // create a node for it.
@@ -303,6 +328,18 @@ public:
       return deleteOnDevice(TgtPtr);
     }
 
+    // Keep the cache bounded: past the limit the memory goes back to the
+    // device and the node is forgotten.
+    if (CacheLimit && CachedBytes + P->Size > CacheLimit) {
+      DP("Cache limit %zu reached. Delete " DPxMOD " on device.\n", CacheLimit,
+         DPxPTR(TgtPtr));
+      {
+        std::lock_guard<std::mutex> G(MapTableLock);
+        PtrToNodeTable.erase(TgtPtr);
+      }
+      return deleteOnDevice(TgtPtr);
+    }
+
     // Insert the node to the free list
     const int B = findBucket(P->Size);
 
@@ -312,10 +349,21 @@ public:
       std::lock_guard<std::mutex> G(FreeListLocks[B]);
       FreeLists[B].insert(*P);
     }
+    CachedBytes += P->Size;
 
     return OFFLOAD_SUCCESS;
   }
 
+  /// Return the number of allocations served from the free lists, the number
+  /// of managed allocations that went to the device, and the number of
+  /// allocations too large to be managed.
+  void getStatistics(uint64_t &Hits, uint64_t &Misses,
+                     uint64_t &Unmanaged) const {
+    Hits = NumHits;
+    Misses = NumMisses;
+    Unmanaged = NumUnmanaged;
+  }
+
   /// Get the size threshold from the environment variable
   /// \p LIBOMPTARGET_MEMORY_MANAGER_THRESHOLD . Returns a <tt>
   /// std::pair<size_t, bool> </tt> where the first element represents the
@@ -2287,6 +2287,7 @@ extern kmp_tasking_mode_t
     __kmp_tasking_mode; /* determines how/when to execute tasks */
 extern int __kmp_task_stealing_constraint;
 extern int __kmp_enable_task_throttling;
+extern int __kmp_task_steal_locality;
 extern kmp_int32 __kmp_default_device; // Set via OMP_DEFAULT_DEVICE if
 // specified, defaults to 0 otherwise
 // Set via OMP_MAX_TASK_PRIORITY if specified, defaults to 0 otherwise
@@ -2722,6 +2723,11 @@ typedef struct KMP_ALIGN_CACHE kmp_base_info {
   int th_new_place; /* place to bind to in par reg */
   int th_first_place; /* first place in partition */
   int th_last_place; /* last place in partition */
+  /* Index of the first hw thread of the NUMA domain (or package) and of the
+     last-level cache containing th_affin_mask, -1 if the mask spans several.
+     Used to prefer nearby victims when stealing tasks. */
+  int th_numa_domain;
+  int th_llc_domain;
 #endif
   int th_prev_level; /* previous level for affinity format */
   int th_prev_num_threads; /* previous num_threads for affinity format */
@@ -3123,6 +3129,7 @@ extern kmp_bar_pat_e __kmp_barrier_gather_pattern[bs_last_barrier];
 extern kmp_bar_pat_e __kmp_barrier_release_pattern[bs_last_barrier];
 extern char const *__kmp_barrier_branch_bit_env_name[bs_last_barrier];
 extern char const *__kmp_barrier_pattern_env_name[bs_last_barrier];
+extern int __kmp_hier_barrier_threshold;
 extern char const *__kmp_barrier_type_name[bs_last_barrier];
 extern char const *__kmp_barrier_pattern_name[bp_last_bar];
 
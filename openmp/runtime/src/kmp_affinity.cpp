@@ -4573,6 +4573,54 @@ static void __kmp_select_mask_by_gtid(int gtid, const kmp_affinity_t *affinity,
   *mask = KMP_CPU_INDEX(affinity->masks, *place);
 }
 
+// Return the index of the first hw thread of the topology unit at hw_level
+// containing hw threads first..last, or -1 if they are in different units.
+// Relies on hw threads being sorted by their ids.
+static int __kmp_affinity_domain_start(int first, int last, int hw_level) {
+  if (hw_level < 0)
+    return -1;
+  const kmp_hw_thread_t &hw_first = __kmp_topology->at(first);
+  for (int i = 0; i <= hw_level; ++i)
+    if (__kmp_topology->at(last).ids[i] != hw_first.ids[i])
+      return -1;
+  int start = first;
+  while (start > 0) {
+    const kmp_hw_thread_t &prev = __kmp_topology->at(start - 1);
+    int i = 0;
+    while (i <= hw_level && prev.ids[i] == hw_first.ids[i])
+      ++i;
+    if (i <= hw_level)
+      break;
+    --start;
+  }
+  return start;
+}
+
+// Set th_numa_domain and th_llc_domain from the current affinity mask.
+static void __kmp_affinity_set_locality(kmp_info_t *th) {
+  th->th.th_numa_domain = -1;
+  th->th.th_llc_domain = -1;
+  if (!__kmp_topology || th->th.th_affin_mask == NULL)
+    return;
+  int first = -1, last = -1;
+  int num_hw_threads = __kmp_topology->get_num_hw_threads();
+  for (int i = 0; i < num_hw_threads; ++i) {
+    if (KMP_CPU_ISSET(__kmp_topology->at(i).os_id, th->th.th_affin_mask)) {
+      if (first < 0)
+        first = i;
+      last = i;
+    }
+  }
+  if (first < 0)
+    return;
+  int numa_level = __kmp_topology->get_level(KMP_HW_NUMA);
+  if (numa_level < 0)
+    numa_level = __kmp_topology->get_level(KMP_HW_SOCKET);
+  th->th.th_numa_domain = __kmp_affinity_domain_start(first, last, numa_level);
+  th->th.th_llc_domain = __kmp_affinity_domain_start(
+      first, last, __kmp_topology->get_level(KMP_HW_LLC));
+}
+
 void __kmp_affinity_set_init_mask(int gtid, int isa_root) {
   if (!KMP_AFFINITY_CAPABLE()) {
     return;
@@ -4653,6 +4701,7 @@ void __kmp_affinity_set_init_mask(int gtid, int isa_root) {
   }
 
   KMP_CPU_COPY(th->th.th_affin_mask, mask);
+  __kmp_affinity_set_locality(th);
 
   /* to avoid duplicate printing (will be correctly printed on barrier) */
   if (affinity->flags.verbose &&
@@ -4707,6 +4756,7 @@ void __kmp_affinity_set_place(int gtid) {
       KMP_CPU_INDEX(__kmp_affinity.masks, th->th.th_new_place);
   KMP_CPU_COPY(th->th.th_affin_mask, mask);
   th->th.th_current_place = th->th.th_new_place;
+  __kmp_affinity_set_locality(th);
 
   if (__kmp_affinity.flags.verbose) {
     char buf[KMP_AFFIN_MASK_PRINT_LEN];
@@ -4771,6 +4821,7 @@ int __kmp_aux_set_affinity(void **mask) {
   retval = __kmp_set_system_affinity((kmp_affin_mask_t *)(*mask), FALSE);
   if (retval == 0) {
     KMP_CPU_COPY(th->th.th_affin_mask, (kmp_affin_mask_t *)(*mask));
+    __kmp_affinity_set_locality(th);
   }
 
   th->th.th_current_place = KMP_PLACE_UNDEFINED;
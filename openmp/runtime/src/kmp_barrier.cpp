@@ -1755,6 +1755,22 @@ template <> struct is_cancellable<false> {
   constexpr operator bool() const { return false; }
 };
 
+// Pattern actually used for barrier bt of team. Plain and reduction barriers
+// of teams with at least __kmp_hier_barrier_threshold threads use the
+// hierarchical barrier, whose tree follows the machine topology. The choice
+// only depends on the team size, so gather and release always agree. The
+// fork/join barrier keeps its pattern since workers waiting in the fork
+// barrier do not know their next team yet.
+static inline kmp_bar_pat_e __kmp_team_barrier_pattern(kmp_bar_pat_e pattern,
+                                                       enum barrier_type bt,
+                                                       kmp_team_t *team) {
+  if (__kmp_hier_barrier_threshold > 0 && bt != bs_forkjoin_barrier &&
+      pattern != bp_dist_bar &&
+      team->t.t_nproc >= __kmp_hier_barrier_threshold)
+    return bp_hierarchical_bar;
+  return pattern;
+}
+
 // Internal function to do a barrier.
 /* If is_split is true, do a split barrier, otherwise, do a plain barrier
    If reduce is non-NULL, do a split reduction barrier, otherwise, do a split
@@ -1865,7 +1881,8 @@ static int __kmp_barrier_template(enum barrier_type bt, int gtid, int is_split,
       cancelled = __kmp_linear_barrier_gather_cancellable(
           bt, this_thr, gtid, tid, reduce USE_ITT_BUILD_ARG(itt_sync_obj));
     } else {
-      switch (__kmp_barrier_gather_pattern[bt]) {
+      switch (__kmp_team_barrier_pattern(__kmp_barrier_gather_pattern[bt], bt,
+                                         team)) {
       case bp_dist_bar: {
         __kmp_dist_barrier_gather(bt, this_thr, gtid, tid,
                                   reduce USE_ITT_BUILD_ARG(itt_sync_obj));
@@ -1983,7 +2000,8 @@ static int __kmp_barrier_template(enum barrier_type bt, int gtid, int is_split,
         cancelled = __kmp_linear_barrier_release_cancellable(
             bt, this_thr, gtid, tid, FALSE USE_ITT_BUILD_ARG(itt_sync_obj));
       } else {
-        switch (__kmp_barrier_release_pattern[bt]) {
+        switch (__kmp_team_barrier_pattern(__kmp_barrier_release_pattern[bt],
+                                           bt, team)) {
         case bp_dist_bar: {
           KMP_ASSERT(__kmp_barrier_release_branch_bits[bt]);
           __kmp_dist_barrier_release(bt, this_thr, gtid, tid,
@@ -2120,7 +2138,8 @@ void __kmp_end_split_barrier(enum barrier_type bt, int gtid) {
 
   if (!team->t.t_serialized) {
     if (KMP_MASTER_GTID(gtid)) {
-      switch (__kmp_barrier_release_pattern[bt]) {
+      switch (__kmp_team_barrier_pattern(__kmp_barrier_release_pattern[bt], bt,
+                                         team)) {
       case bp_dist_bar: {
         __kmp_dist_barrier_release(bt, this_thr, gtid, tid,
                                    FALSE USE_ITT_BUILD_ARG(NULL));
@@ -113,6 +113,9 @@ char const *__kmp_barrier_type_name[bs_last_barrier] = {"plain", "forkjoin"
 };
 char const *__kmp_barrier_pattern_name[bp_last_bar] = {
     "linear", "tree", "hyper", "hierarchical", "dist"};
+/* Teams with at least this many threads use the hierarchical pattern for plain
+   and reduction barriers; 0 disables, -1 derives it from the topology. */
+int __kmp_hier_barrier_threshold = -1;
 
 int __kmp_allThreadsSpecified = 0;
 size_t __kmp_align_alloc = CACHE_LINE;
@@ -349,6 +352,9 @@ KMP_BUILD_ASSERT(sizeof(kmp_tasking_flags_t) == 4);
 
 int __kmp_task_stealing_constraint = 1; /* Constrain task stealing by default */
 int __kmp_enable_task_throttling = 1;
+/* Extra random picks a thief spends looking for a victim in its own cache or
+   NUMA domain before settling for any victim; 0 picks victims uniformly. */
+int __kmp_task_steal_locality = 4;
 
 #ifdef DEBUG_SUSPEND
 int __kmp_suspend_count = 0;
@@ -3921,6 +3921,8 @@ int __kmp_register_root(int initial_thread) {
   root_thread->th.th_new_place = KMP_PLACE_UNDEFINED;
   root_thread->th.th_first_place = KMP_PLACE_UNDEFINED;
   root_thread->th.th_last_place = KMP_PLACE_UNDEFINED;
+  root_thread->th.th_numa_domain = -1;
+  root_thread->th.th_llc_domain = -1;
 #endif /* KMP_AFFINITY_SUPPORTED */
   root_thread->th.th_def_allocator = __kmp_def_allocator;
   root_thread->th.th_prev_level = 0;
@@ -4571,6 +4573,8 @@ kmp_info_t *__kmp_allocate_thread(kmp_root_t *root, kmp_team_t *team,
   new_thr->th.th_new_place = KMP_PLACE_UNDEFINED;
   new_thr->th.th_first_place = KMP_PLACE_UNDEFINED;
   new_thr->th.th_last_place = KMP_PLACE_UNDEFINED;
+  new_thr->th.th_numa_domain = -1;
+  new_thr->th.th_llc_domain = -1;
 #endif
   new_thr->th.th_def_allocator = __kmp_def_allocator;
   new_thr->th.th_prev_level = 0;
@@ -7290,6 +7294,24 @@ static void __kmp_do_middle_initialize(void) {
     __kmp_avail_proc = __kmp_xproc;
   }
 
+  // Unless the user chose otherwise, switch plain and reduction barriers of
+  // teams that cannot fit into one package to the hierarchical barrier, whose
+  // tree follows the machine topology, so most of the barrier traffic stays
+  // within a package.
+  if (__kmp_hier_barrier_threshold < 0) {
+    __kmp_hier_barrier_threshold = 0;
+#if KMP_AFFINITY_SUPPORTED
+    if (__kmp_topology) {
+      int socket_level = __kmp_topology->get_level(KMP_HW_SOCKET);
+      if (socket_level >= 0) {
+        int num_sockets = __kmp_topology->get_count(socket_level);
+        if (num_sockets > 1)
+          __kmp_hier_barrier_threshold = __kmp_avail_proc / num_sockets + 1;
+      }
+    }
+#endif /* KMP_AFFINITY_SUPPORTED */
+  }
+
   // If there were empty places in num_threads list (OMP_NUM_THREADS=,,2,3),
   // correct them now
   j = 0;
@@ -1331,6 +1331,16 @@ static void __kmp_stg_print_task_stealing(kmp_str_buf_t *buffer,
   __kmp_stg_print_int(buffer, name, __kmp_task_stealing_constraint);
 } // __kmp_stg_print_task_stealing
 
+static void __kmp_stg_parse_task_steal_locality(char const *name,
+                                                char const *value, void *data) {
+  __kmp_stg_parse_int(name, value, 0, KMP_MAX_NTH, &__kmp_task_steal_locality);
+} // __kmp_stg_parse_task_steal_locality
+
+static void __kmp_stg_print_task_steal_locality(kmp_str_buf_t *buffer,
+                                                char const *name, void *data) {
+  __kmp_stg_print_int(buffer, name, __kmp_task_steal_locality);
+} // __kmp_stg_print_task_steal_locality
+
 static void __kmp_stg_parse_max_active_levels(char const *name,
                                               char const *value, void *data) {
   kmp_uint64 tmp_dflt = 0;
@@ -1780,6 +1790,10 @@ static void __kmp_stg_parse_barrier_pattern(char const *name, char const *value,
         __kmp_barrier_gather_pattern[i] = bp_dist_bar;
     }
   }
+  // An explicitly requested pattern is not overridden by the automatic
+  // hierarchical barrier selection unless KMP_HIER_BARRIER_THRESHOLD is set.
+  if (__kmp_hier_barrier_threshold < 0)
+    __kmp_hier_barrier_threshold = 0;
 } // __kmp_stg_parse_barrier_pattern
 
 static void __kmp_stg_print_barrier_pattern(kmp_str_buf_t *buffer,
@@ -1803,6 +1817,22 @@ static void __kmp_stg_print_barrier_pattern(kmp_str_buf_t *buffer,
   }
 } // __kmp_stg_print_barrier_pattern
 
+// -----------------------------------------------------------------------------
+// KMP_HIER_BARRIER_THRESHOLD
+
+static void __kmp_stg_parse_hier_barrier_threshold(char const *name,
+                                                   char const *value,
+                                                   void *data) {
+  __kmp_stg_parse_int(name, value, 0, KMP_MAX_NTH,
+                      &__kmp_hier_barrier_threshold);
+} // __kmp_stg_parse_hier_barrier_threshold
+
+static void __kmp_stg_print_hier_barrier_threshold(kmp_str_buf_t *buffer,
+                                                   char const *name,
+                                                   void *data) {
+  __kmp_stg_print_int(buffer, name, __kmp_hier_barrier_threshold);
+} // __kmp_stg_print_hier_barrier_threshold
+
 // -----------------------------------------------------------------------------
 // KMP_ABORT_DELAY
 
@@ -5384,6 +5414,8 @@ static kmp_setting_t __kmp_stg_table[] = {
      0},
     {"KMP_TASK_STEALING_CONSTRAINT", __kmp_stg_parse_task_stealing,
      __kmp_stg_print_task_stealing, NULL, 0, 0},
+    {"KMP_TASK_STEAL_LOCALITY", __kmp_stg_parse_task_steal_locality,
+     __kmp_stg_print_task_steal_locality, NULL, 0, 0},
     {"OMP_MAX_ACTIVE_LEVELS", __kmp_stg_parse_max_active_levels,
      __kmp_stg_print_max_active_levels, NULL, 0, 0},
     {"OMP_DEFAULT_DEVICE", __kmp_stg_parse_default_device,
@@ -5472,6 +5504,8 @@ static kmp_setting_t __kmp_stg_table[] = {
     {"KMP_REDUCTION_BARRIER_PATTERN", __kmp_stg_parse_barrier_pattern,
      __kmp_stg_print_barrier_pattern, NULL, 0, 0},
 #endif
+    {"KMP_HIER_BARRIER_THRESHOLD", __kmp_stg_parse_hier_barrier_threshold,
+     __kmp_stg_print_hier_barrier_threshold, NULL, 0, 0},
 
     {"KMP_ABORT_DELAY", __kmp_stg_parse_abort_delay,
      __kmp_stg_print_abort_delay, NULL, 0, 0},
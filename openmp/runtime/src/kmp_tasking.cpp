@@ -3033,6 +3033,7 @@ static kmp_task_t *__kmp_steal_task(kmp_info_t *victim_thr, kmp_int32 gtid,
 
   victim_tid = victim_thr->th.th_info.ds.ds_tid;
   victim_td = &threads_data[victim_tid];
+  KMP_COUNT_BLOCK(TASK_steal_attempted);
 
   KA_TRACE(10, ("__kmp_steal_task(enter): T#%d try to steal from T#%d: "
                 "task_team=%p ntasks=%d head=%u tail=%u\n",
@@ -3132,6 +3133,12 @@ static kmp_task_t *__kmp_steal_task(kmp_info_t *victim_thr, kmp_int32 gtid,
   __kmp_release_bootstrap_lock(&victim_td->td.td_deque_lock);
 
   KMP_COUNT_BLOCK(TASK_stolen);
+#if KMP_STATS_ENABLED && KMP_AFFINITY_SUPPORTED
+  if (victim_thr->th.th_numa_domain !=
+      __kmp_threads[gtid]->th.th_numa_domain) {
+    KMP_COUNT_BLOCK(TASK_stolen_remote);
+  }
+#endif
   KA_TRACE(10,
            ("__kmp_steal_task(exit #5): T#%d stole task %p from T#%d: "
             "task_team=%p ntasks=%d head=%u tail=%u\n",
@@ -3142,6 +3149,42 @@ static kmp_task_t *__kmp_steal_task(kmp_info_t *victim_thr, kmp_int32 gtid,
   return task;
 }
 
+// Pick a random thread of the task team other than tid.
+static inline kmp_int32 __kmp_random_victim(kmp_info_t *thread,
+                                            kmp_int32 nthreads, kmp_int32 tid) {
+  kmp_int32 victim_tid = __kmp_get_random(thread) % (nthreads - 1);
+  if (victim_tid >= tid) {
+    ++victim_tid; // Adjusts random distribution to exclude self
+  }
+  return victim_tid;
+}
+
+#if KMP_AFFINITY_SUPPORTED
+// Starting from a random victim, spend up to __kmp_task_steal_locality more
+// random picks looking for a victim that shares the thief's last-level cache.
+// Failing that, use the first pick from the thief's NUMA domain, and only then
+// the original victim. Nearby victims keep the stolen task's data close.
+static kmp_int32 __kmp_local_victim(kmp_info_t *thread,
+                                    kmp_thread_data_t *threads_data,
+                                    kmp_int32 nthreads, kmp_int32 tid,
+                                    kmp_int32 victim_tid) {
+  int llc = thread->th.th_llc_domain;
+  int numa = thread->th.th_numa_domain;
+  kmp_int32 numa_victim = -1;
+  kmp_int32 candidate = victim_tid;
+  for (int i = 0; i <= __kmp_task_steal_locality; ++i) {
+    if (i > 0)
+      candidate = __kmp_random_victim(thread, nthreads, tid);
+    kmp_info_t *other = threads_data[candidate].td.td_thr;
+    if (llc >= 0 && other->th.th_llc_domain == llc)
+      return candidate;
+    if (numa_victim < 0 && other->th.th_numa_domain == numa)
+      numa_victim = candidate;
+  }
+  return numa_victim >= 0 ? numa_victim : victim_tid;
+}
+#endif // KMP_AFFINITY_SUPPORTED
+
 // __kmp_execute_tasks_template: Choose and execute tasks until either the
 // condition is statisfied (return true) or there are none left (return false).
 //
@@ -3214,10 +3257,14 @@ static inline int __kmp_execute_tasks_template(
             // Pick a random thread. Initial plan was to cycle through all the
             // threads, and only return if we tried to steal from every thread,
             // and failed.  Arch says that's not such a great idea.
-            victim_tid = __kmp_get_random(thread) % (nthreads - 1);
-            if (victim_tid >= tid) {
-              ++victim_tid; // Adjusts random distribution to exclude self
-            }
+            victim_tid = __kmp_random_victim(thread, nthreads, tid);
+#if KMP_AFFINITY_SUPPORTED
+            // Prefer victims in the same cache or NUMA domain.
+            if (__kmp_task_steal_locality > 0 &&
+                thread->th.th_numa_domain >= 0)
+              victim_tid = __kmp_local_victim(thread, threads_data, nthreads,
+                                              tid, victim_tid);
+#endif
             // Found a potential victim
             other_thread = threads_data[victim_tid].td.td_thr;
             // There is a slight chance that __kmp_enable_tasking() did not wake
@@ -0,0 +1,132 @@
+// RUN: %libomp-compile-and-run
+// RUN: %libomp-compile && env KMP_HIER_BARRIER_THRESHOLD=0 %libomp-run
+// RUN: %libomp-compile && env KMP_HIER_BARRIER_THRESHOLD=3 %libomp-run
+// RUN: %libomp-compile && env KMP_BLOCKTIME=infinite KMP_HIER_BARRIER_THRESHOLD=3 %libomp-run
+// RUN: %libomp-compile && env KMP_HIER_BARRIER_THRESHOLD=3 KMP_PLAIN_BARRIER_PATTERN='tree,tree' %libomp-run
+
+// Teams of different sizes alternate between the configured barrier pattern
+// and the topology-derived hierarchical one. Barriers and reductions must stay
+// correct across the switches.
+//
+// Run with an argument to also print an EPCC-style barrier and reduction
+// overhead for every team size (time per construct minus the time of the
+// same delay loop run without it, in microseconds):
+//   ./a.out bench
+
+#include <stdio.h>
+#include <string.h>
+#include "omp_testsuite.h"
+
+#define MAX_THREADS 8
+#define INNER_REPS 1000
+#define DELAY_LENGTH 64
+
+static void delay(int length) {
+  volatile int a = 0;
+  int i;
+  for (i = 0; i < length; i++)
+    a += i;
+}
+
+int test_barrier(int nthreads) {
+  int counts[MAX_THREADS] = {0};
+  int errors = 0;
+  #pragma omp parallel num_threads(nthreads) shared(counts, errors)
+  {
+    int tid = omp_get_thread_num();
+    int nth = omp_get_num_threads();
+    int i, j;
+    for (i = 1; i <= REPETITIONS * 10; i++) {
+      counts[tid] = i;
+      #pragma omp barrier
+      for (j = 0; j < nth; j++) {
+        if (counts[j] != i) {
+          #pragma omp atomic
+          errors++;
+        }
+      }
+      #pragma omp barrier
+    }
+  }
+  return errors == 0;
+}
+
+int test_reduction(int nthreads) {
+  int errors = 0;
+  int i;
+  for (i = 0; i < REPETITIONS * 10; i++) {
+    int sum = 0;
+    int nth = 0;
+    #pragma omp parallel num_threads(nthreads) reduction(+ : sum)
+    {
+      #pragma omp single
+      nth = omp_get_num_threads();
+      sum += omp_get_thread_num() + i;
+    }
+    if (sum != nth * (nth - 1) / 2 + nth * i)
+      errors++;
+  }
+  return errors == 0;
+}
+
+static void bench(int nthreads) {
+  double start, reference, barrier, reduction;
+  int i;
+
+  start = omp_get_wtime();
+  for (i = 0; i < INNER_REPS; i++)
+    delay(DELAY_LENGTH);
+  reference = omp_get_wtime() - start;
+
+  #pragma omp parallel num_threads(nthreads) private(i)
+  {
+    #pragma omp master
+    start = omp_get_wtime();
+    for (i = 0; i < INNER_REPS; i++) {
+      delay(DELAY_LENGTH);
+      #pragma omp barrier
+    }
+    #pragma omp master
+    barrier = omp_get_wtime() - start;
+  }
+
+  start = omp_get_wtime();
+  for (i = 0; i < INNER_REPS; i++) {
+    int sum = 0;
+    #pragma omp parallel num_threads(nthreads) reduction(+ : sum)
+    {
+      delay(DELAY_LENGTH);
+      sum += 1;
+    }
+  }
+  reduction = omp_get_wtime() - start;
+
+  printf("threads %2d: barrier %8.3f us, reduction %8.3f us\n", nthreads,
+         (barrier - reference) * 1e6 / INNER_REPS,
+         (reduction - reference) * 1e6 / INNER_REPS);
+}
+
+int main(int argc, char **argv) {
+  int n;
+  int num_failed = 0;
+
+  omp_set_dynamic(0);
+  // Grow and shrink the team so that hot teams change size in place.
+  for (n = 1; n <= MAX_THREADS; n++) {
+    if (!test_barrier(n) || !test_reduction(n))
+      num_failed++;
+  }
+  for (n = MAX_THREADS; n >= 1; n--) {
+    if (!test_barrier(n) || !test_reduction(n))
+      num_failed++;
+  }
+
+  if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+    int max = omp_get_max_threads();
+    for (n = 1; n <= max; n *= 2)
+      bench(n);
+    if (max & (max - 1))
+      bench(max);
+  }
+  return num_failed;
+}
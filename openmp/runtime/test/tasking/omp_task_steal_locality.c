@@ -0,0 +1,36 @@
+// RUN: %libomp-compile && env OMP_PROC_BIND=close %libomp-run
+// RUN: %libomp-compile && env OMP_PROC_BIND=spread KMP_TASK_STEAL_LOCALITY=16 %libomp-run
+// RUN: %libomp-compile && env KMP_TASK_STEAL_LOCALITY=0 %libomp-run
+// RUN: %libomp-compile && env OMP_PROC_BIND=false %libomp-run
+
+// Recursive task trees must be computed correctly however thieves choose
+// their victims.
+
+#include <stdio.h>
+#include "omp_testsuite.h"
+
+static int fib(int n) {
+  int a, b;
+  if (n < 2)
+    return n;
+  #pragma omp task shared(a) if (n > 10)
+  a = fib(n - 1);
+  #pragma omp task shared(b) if (n > 10)
+  b = fib(n - 2);
+  #pragma omp taskwait
+  return a + b;
+}
+
+int main() {
+  int i;
+  int num_failed = 0;
+  for (i = 0; i < REPETITIONS; i++) {
+    int result = 0;
+    #pragma omp parallel
+    #pragma omp single
+    result = fib(25);
+    if (result != 75025)
+      num_failed++;
+  }
+  return num_failed;
+}
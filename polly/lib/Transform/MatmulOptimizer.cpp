@@ -1818,19 +1818,103 @@ static bool isTCPattern(isl::schedule_node Node, const Dependences *D,
   return false;
 }
 
+/// Return the last input dimension in @p Dimensions that belongs to
+/// @p IndexSet, or -1 if there is none.
+static int getInnermostIndex(ArrayRef<int> Dimensions,
+                             const SmallDenseSet<int> &IndexSet) {
+  for (int Dim : reverse(Dimensions))
+    if (IndexSet.count(Dim))
+      return Dim;
+  return -1;
+}
+
+/// Apply the BLIS macro and micro kernels to a TC-like kernel.
+///
+/// The TC-like kernel is treated as a matrix multiplication of the innermost
+/// free index of C from the bundle I, the innermost free index of C from the
+/// bundle J, and the last loop of the bundle P. These three dimensions are
+/// moved to the innermost positions of the band, in this order, while the
+/// remaining dimensions stay outside in their original order. This preserves
+/// the order of the loops from P. The three dimensions are then tiled for
+/// the cache hierarchy and the registers, like a matrix multiplication.
+///
+/// Packing of the operands is not applied, since the operands of a tensor
+/// contraction are not generally two-dimensional.
+///
+/// @param Node The band node of the TC-like kernel.
+/// @param TTI  Target Transform Info.
+/// @param TCI  Parameters of the tensor contraction operands.
+/// @return The optimized schedule node or a null node if the band is not
+///         the only band representing all dimensions of the statement.
+static isl::schedule_node optimizeTCPattern(isl::schedule_node Node,
+                                            const TargetTransformInfo *TTI,
+                                            TCInfoTy &TCI) {
+  assert(TTI && "The target transform info should be provided.");
+  isl::union_set Domain = Node.get_universe_domain();
+  unsigned DimOutNum = unsignedFromIslSize(
+      Node.as<isl::schedule_node_band>().n_member());
+  if (Node.get_schedule_depth().release() != 0 ||
+      unsignedFromIslSize(isl::set(Domain).tuple_dim()) != DimOutNum ||
+      !Node.child(0).isa<isl::schedule_node_leaf>())
+    return {};
+
+  int InnermostI = getInnermostIndex(TCI.CDimensions, TCI.I);
+  int InnermostJ = getInnermostIndex(TCI.CDimensions, TCI.J);
+  int LastP = *std::max_element(TCI.P.begin(), TCI.P.end());
+  if (InnermostI < 0 || InnermostJ < 0)
+    return {};
+
+  SmallVector<int, 8> NewOrder;
+  for (int Dim : seq<int>(0, DimOutNum))
+    if (Dim != InnermostI && Dim != InnermostJ && Dim != LastP)
+      NewOrder.push_back(Dim);
+  NewOrder.append({InnermostI, InnermostJ, LastP});
+
+  Node = getBandNodeWithOriginDimOrder(Node);
+  isl::multi_union_pw_aff PartialSchedule =
+      Node.as<isl::schedule_node_band>().get_partial_schedule();
+  isl::multi_union_pw_aff NewPartialSchedule = PartialSchedule;
+  for (unsigned Pos : seq<unsigned>(0, DimOutNum))
+    NewPartialSchedule =
+        NewPartialSchedule.set_at(Pos, PartialSchedule.at(NewOrder[Pos]));
+  Node = isl::manage(isl_schedule_node_delete(Node.release()));
+  Node = Node.insert_partial_schedule(NewPartialSchedule);
+
+  MatMulInfoTy MMI;
+  MMI.A = TCI.A;
+  MMI.B = TCI.B;
+  MMI.ReadFromC = TCI.ReadFromC;
+  MMI.WriteToC = TCI.WriteToC;
+  auto MicroKernelParams = getMicroKernelParams(TTI, MMI);
+  auto MacroKernelParams = getMacroKernelParams(TTI, MicroKernelParams, MMI);
+  Node = createMacroKernel(Node, MacroKernelParams);
+
+  // Create the micro kernel on the dimensions taken from I and J.
+  SmallVector<int, 8> RegisterTileSizes(DimOutNum, 1);
+  RegisterTileSizes[DimOutNum - 3] = MicroKernelParams.Mr;
+  RegisterTileSizes[DimOutNum - 2] = MicroKernelParams.Nr;
+  Node = applyRegisterTiling(Node, RegisterTileSizes, 1);
+  Node = Node.parent().parent();
+  return permuteBandNodeDimensions(Node, DimOutNum - 3, DimOutNum - 2)
+      .child(0)
+      .child(0);
+}
+
 } // namespace
 
 isl::schedule_node
 polly::tryOptimizeMatMulPattern(isl::schedule_node Node,
                                 const llvm::TargetTransformInfo *TTI,
                                 const Dependences *D) {
-  TCInfoTy TCI;
-  if (PMBasedTCOpts && isTCPattern(Node, D, TCI))
-    LLVM_DEBUG(dbgs() << "The tensor contraction pattern was detected\n");
   MatMulInfoTy MMI;
   if (PMBasedMMMOpts && isMatrMultPattern(Node, D, MMI)) {
     LLVM_DEBUG(dbgs() << "The matrix multiplication pattern was detected\n");
     return optimizeMatMulPattern(Node, TTI, MMI);
   }
+  TCInfoTy TCI;
+  if (PMBasedTCOpts && isTCPattern(Node, D, TCI)) {
+    LLVM_DEBUG(dbgs() << "The tensor contraction pattern was detected\n");
+    return optimizeTCPattern(Node, TTI, TCI);
+  }
   return {};
 }
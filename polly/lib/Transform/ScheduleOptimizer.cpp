@@ -52,6 +52,7 @@
 #include "polly/MatmulOptimizer.h"
 #include "polly/Options.h"
 #include "polly/ScheduleTreeTransform.h"
+#include "polly/Support/GICHelper.h"
 #include "polly/Support/ISLOStream.h"
 #include "polly/Support/ISLTools.h"
 #include "llvm/ADT/Sequence.h"
@@ -59,6 +60,8 @@
 #include "llvm/Analysis/OptimizationRemarkEmitter.h"
 #include "llvm/InitializePasses.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/Timer.h"
 #include "isl/options.h"
 
 using namespace llvm;
@@ -183,6 +186,13 @@ static cl::opt<bool>
                             "tiling (requires -polly-reschedule)"),
                    cl::init(true), cl::cat(PollyCategory));
 
+static cl::opt<unsigned long> ScheduleComputeOut(
+    "polly-schedule-computeout",
+    cl::desc("Bound the scheduler by a maximal amount of computational steps. "
+             "If exceeded, scheduling is retried with each strongly connected "
+             "component scheduled separately, then abandoned (0 = unlimited)"),
+    cl::Hidden, cl::init(300000), cl::cat(PollyCategory));
+
 static cl::opt<bool> OptimizedScops(
     "polly-optimized-scops",
     cl::desc("Polly - Dump polyhedral description of Scops optimized with "
@@ -192,6 +202,11 @@ static cl::opt<bool> OptimizedScops(
 
 STATISTIC(ScopsProcessed, "Number of scops processed");
 STATISTIC(ScopsRescheduled, "Number of scops rescheduled");
+STATISTIC(ScopsScheduleSerialized,
+          "Number of scops rescheduled with serialized SCCs due to the "
+          "computeout");
+STATISTIC(ScopsScheduleComputeOut,
+          "Number of scops not rescheduled due to the computeout");
 STATISTIC(ScopsOptimized, "Number of scops optimized");
 
 STATISTIC(NumAffineLoopsOptimized, "Number of affine loops optimized");
@@ -865,9 +880,65 @@ static void runIslScheduleOptimizer(
     SC = SC.set_proximity(Proximity);
     SC = SC.set_validity(Validity);
     SC = SC.set_coincidence(Validity);
-    Schedule = SC.compute_schedule();
+
+    // Compute the schedule in up to two tiers, each within the computeout.
+    // The first tier searches for a schedule that fuses across strongly
+    // connected components of the dependence graph. If that exceeds the
+    // quota, the much cheaper second tier schedules each component in
+    // isolation, forgoing fusion.
+    TimeRecord StartTime = TimeRecord::getCurrentTime(/*Start=*/true);
+    bool QuotaExceeded;
+    {
+      IslMaxOperationsGuard MaxOpGuard(Ctx, ScheduleComputeOut);
+      Schedule = SC.compute_schedule();
+      QuotaExceeded = MaxOpGuard.hasQuotaExceeded();
+    }
+    bool Serialized = false;
+    if (QuotaExceeded) {
+      LLVM_DEBUG(dbgs() << "Schedule optimizer calculation exceeds ISL quota; "
+                           "retrying with serialized SCCs\n");
+      int SerializeSCCs = isl_options_get_schedule_serialize_sccs(Ctx);
+      isl_options_set_schedule_serialize_sccs(Ctx, 1);
+      {
+        IslMaxOperationsGuard MaxOpGuard(Ctx, ScheduleComputeOut);
+        Schedule = SC.compute_schedule();
+        QuotaExceeded = MaxOpGuard.hasQuotaExceeded();
+      }
+      isl_options_set_schedule_serialize_sccs(Ctx, SerializeSCCs);
+      Serialized = !QuotaExceeded;
+    }
+    TimeRecord ElapsedTime = TimeRecord::getCurrentTime(/*Start=*/false);
+    ElapsedTime -= StartTime;
     isl_options_set_on_error(Ctx, OnErrorStatus);
 
+    if (ORE) {
+      BasicBlock *Entry = S.getEntry();
+      OptimizationRemarkAnalysis Remark(DEBUG_TYPE, "ScheduleComputed",
+                                        Entry->getTerminator()->getDebugLoc(),
+                                        Entry);
+      if (QuotaExceeded)
+        Remark << "Rescheduling abandoned after exceeding the computeout of "
+               << ore::NV("ComputeOut", ScheduleComputeOut)
+               << " operations twice";
+      else if (Serialized)
+        Remark << "Rescheduled without fusion after exceeding the computeout "
+                  "of "
+               << ore::NV("ComputeOut", ScheduleComputeOut) << " operations";
+      else
+        Remark << "Rescheduled";
+      std::string WallTime = formatv("{0:f3}", ElapsedTime.getWallTime());
+      Remark << " in " << ore::NV("WallTime", WallTime) << " seconds";
+      ORE->emit(Remark);
+    }
+
+    if (QuotaExceeded) {
+      ScopsScheduleComputeOut++;
+      LLVM_DEBUG(dbgs() << "Schedule optimizer calculation exceeds ISL quota; "
+                           "keeping the original schedule\n");
+      return;
+    }
+    if (Serialized)
+      ScopsScheduleSerialized++;
     ScopsRescheduled++;
     LLVM_DEBUG(printSchedule(dbgs(), Schedule, "After rescheduling"));
   }
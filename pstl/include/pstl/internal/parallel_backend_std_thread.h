@@ -0,0 +1,725 @@
+// -*- C++ -*-
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _PSTL_PARALLEL_BACKEND_STD_THREAD_H
+#define _PSTL_PARALLEL_BACKEND_STD_THREAD_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "parallel_backend_utils.h"
+#include "pstl_config.h"
+
+// A backend that only needs the standard library: the work is split into
+// tasks that are run by a pool of std::threads, which steal them from each
+// other's queues.
+
+_PSTL_HIDE_FROM_ABI_PUSH
+
+namespace __pstl
+{
+namespace __std_thread_backend
+{
+
+//------------------------------------------------------------------------
+// buffer
+//------------------------------------------------------------------------
+
+template <typename _Tp>
+class __buffer
+{
+    std::allocator<_Tp> __allocator_;
+    _Tp* __ptr_;
+    const std::size_t __buf_size_;
+    __buffer(const __buffer&) = delete;
+    void
+    operator=(const __buffer&) = delete;
+
+  public:
+    __buffer(std::size_t __n) : __allocator_(), __ptr_(__allocator_.allocate(__n)), __buf_size_(__n) {}
+
+    operator bool() const { return __ptr_ != nullptr; }
+    _Tp*
+    get() const
+    {
+        return __ptr_;
+    }
+    ~__buffer() { __allocator_.deallocate(__ptr_, __buf_size_); }
+};
+
+inline void
+__cancel_execution()
+{
+}
+
+//------------------------------------------------------------------------
+// thread pool
+//------------------------------------------------------------------------
+
+// A unit of work whose completion is awaited by the thread that submitted
+// it. Tasks live on the stack of that thread, so spawning one allocates
+// nothing.
+struct __task
+{
+    void (*__execute_)(__task*);
+    std::atomic<bool> __done_{false};
+    std::exception_ptr __exception_;
+
+    explicit __task(void (*__execute)(__task*)) : __execute_(__execute) {}
+};
+
+template <typename _Fp>
+struct __function_task : __task
+{
+    _Fp& __f_;
+
+    explicit __function_task(_Fp& __f) : __task(&__function_task::__run), __f_(__f) {}
+
+    static void
+    __run(__task* __t)
+    {
+        auto* __self = static_cast<__function_task*>(__t);
+        try
+        {
+            __self->__f_();
+        }
+        catch (...)
+        {
+            __self->__exception_ = std::current_exception();
+        }
+        __self->__done_.store(true, std::memory_order_release);
+    }
+};
+
+// The tasks submitted by one thread. The owner pushes and pops at the back,
+// the other threads steal the oldest tasks from the front.
+class __task_queue
+{
+    std::mutex __mutex_;
+    std::deque<__task*> __tasks_;
+
+  public:
+    void
+    __push(__task* __t)
+    {
+        std::lock_guard<std::mutex> __lock(__mutex_);
+        __tasks_.push_back(__t);
+    }
+
+    // Takes __t back if it is the newest task and nobody stole it yet.
+    bool
+    __pop(__task* __t)
+    {
+        std::lock_guard<std::mutex> __lock(__mutex_);
+        if (__tasks_.empty() || __tasks_.back() != __t)
+            return false;
+        __tasks_.pop_back();
+        return true;
+    }
+
+    __task*
+    __pop_newest()
+    {
+        std::lock_guard<std::mutex> __lock(__mutex_);
+        if (__tasks_.empty())
+            return nullptr;
+        __task* __t = __tasks_.back();
+        __tasks_.pop_back();
+        return __t;
+    }
+
+    __task*
+    __steal()
+    {
+        std::lock_guard<std::mutex> __lock(__mutex_);
+        if (__tasks_.empty())
+            return nullptr;
+        __task* __t = __tasks_.front();
+        __tasks_.pop_front();
+        return __t;
+    }
+};
+
+// Runs the tasks on std::thread::hardware_concurrency() - 1 workers and on
+// the threads that wait for them. Each worker has its own queue; the threads
+// that are not workers share the last one.
+//
+// There is a single pool per program, or per translation unit when the ABI is
+// hidden per translation unit.
+class __thread_pool
+{
+    std::size_t __num_workers_;
+    std::vector<std::unique_ptr<__task_queue>> __queues_;
+    std::vector<std::thread> __workers_;
+    // Number of tasks queued and not taken yet. This is only used to put the
+    // workers to sleep, so it may briefly be off.
+    std::atomic<std::ptrdiff_t> __pending_{0};
+    std::mutex __mutex_;
+    std::condition_variable __wake_;
+    bool __stop_ = false;
+
+    static std::size_t&
+    __worker_index()
+    {
+        static thread_local std::size_t __index = std::size_t(-1);
+        return __index;
+    }
+
+    __task_queue&
+    __this_queue()
+    {
+        std::size_t __index = __worker_index();
+        return __index < __num_workers_ ? *__queues_[__index] : *__queues_.back();
+    }
+
+    __task*
+    __find_task()
+    {
+        std::size_t __index = __worker_index();
+        std::size_t __first = 0;
+        if (__index < __num_workers_)
+        {
+            if (__task* __t = __queues_[__index]->__pop_newest())
+                return __t;
+            __first = __index + 1;
+        }
+        for (std::size_t __i = 0; __i != __queues_.size(); ++__i)
+            if (__task* __t = __queues_[(__first + __i) % __queues_.size()]->__steal())
+                return __t;
+        return nullptr;
+    }
+
+    void
+    __run(__task* __t)
+    {
+        __pending_.fetch_sub(1, std::memory_order_relaxed);
+        __t->__execute_(__t);
+    }
+
+    void
+    __work(std::size_t __index)
+    {
+        __worker_index() = __index;
+        for (;;)
+        {
+            if (__task* __t = __find_task())
+            {
+                __run(__t);
+                continue;
+            }
+            std::unique_lock<std::mutex> __lock(__mutex_);
+            __wake_.wait(__lock, [this] { return __stop_ || __pending_.load(std::memory_order_relaxed) > 0; });
+            if (__stop_)
+                return;
+        }
+    }
+
+    __thread_pool()
+    {
+        unsigned __threads = std::thread::hardware_concurrency();
+        __num_workers_ = __threads > 1 ? __threads - 1 : 0;
+        // The queues must all exist before the first worker looks into them.
+        for (std::size_t __i = 0; __i != __num_workers_ + 1; ++__i)
+            __queues_.push_back(std::make_unique<__task_queue>());
+        __workers_.reserve(__num_workers_);
+        for (std::size_t __i = 0; __i != __num_workers_; ++__i)
+            __workers_.emplace_back([this, __i] { __work(__i); });
+    }
+
+  public:
+    __thread_pool(const __thread_pool&) = delete;
+    __thread_pool&
+    operator=(const __thread_pool&) = delete;
+
+    ~__thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> __lock(__mutex_);
+            __stop_ = true;
+        }
+        __wake_.notify_all();
+        for (std::thread& __worker : __workers_)
+            __worker.join();
+    }
+
+    static __thread_pool&
+    __instance()
+    {
+        static __thread_pool __pool;
+        return __pool;
+    }
+
+    std::size_t
+    __concurrency() const
+    {
+        return __num_workers_ + 1;
+    }
+
+    void
+    __submit(__task* __t)
+    {
+        __this_queue().__push(__t);
+        __pending_.fetch_add(1, std::memory_order_relaxed);
+        // Taking the lock orders this with a worker that is about to sleep, so
+        // that it either sees the task or gets the notification.
+        {
+            std::lock_guard<std::mutex> __lock(__mutex_);
+        }
+        __wake_.notify_one();
+    }
+
+    // Returns once __t has run. If nobody took __t yet, it runs on this
+    // thread; otherwise this thread runs other tasks in the meantime.
+    void
+    __join(__task* __t)
+    {
+        if (__this_queue().__pop(__t))
+        {
+            __run(__t);
+            return;
+        }
+        while (!__t->__done_.load(std::memory_order_acquire))
+        {
+            if (__task* __other = __find_task())
+                __run(__other);
+            else
+                std::this_thread::yield();
+        }
+    }
+};
+
+inline std::size_t
+__concurrency()
+{
+    return __thread_pool::__instance().__concurrency();
+}
+
+//------------------------------------------------------------------------
+// parallel_invoke
+//------------------------------------------------------------------------
+
+template <typename _F1, typename _F2>
+void
+__parallel_invoke_body(_F1&& __f1, _F2&& __f2)
+{
+    __thread_pool& __pool = __thread_pool::__instance();
+    __function_task<_F2> __task(__f2);
+    __pool.__submit(&__task);
+    try
+    {
+        std::forward<_F1>(__f1)();
+    }
+    catch (...)
+    {
+        // __task refers to this frame, so it must be done before unwinding.
+        __pool.__join(&__task);
+        throw;
+    }
+    __pool.__join(&__task);
+    if (__task.__exception_)
+        std::rethrow_exception(__task.__exception_);
+}
+
+template <class _ExecutionPolicy, typename _F1, typename _F2>
+void
+__parallel_invoke(__pstl::__internal::__std_thread_backend_tag, _ExecutionPolicy&&, _F1&& __f1, _F2&& __f2)
+{
+    __std_thread_backend::__parallel_invoke_body(std::forward<_F1>(__f1), std::forward<_F2>(__f2));
+}
+
+//------------------------------------------------------------------------
+// chunks
+//------------------------------------------------------------------------
+
+constexpr std::size_t __default_chunk_size = 2048;
+
+// The chunks a range of __size_ elements is split into. Their sizes differ by
+// at most one element.
+template <typename _Index>
+struct __chunk_partitions
+{
+    _Index __size_;
+    _Index __count_;
+
+    _Index
+    __begin(_Index __chunk) const
+    {
+        return __size_ / __count_ * __chunk + std::min(__chunk, _Index(__size_ % __count_));
+    }
+
+    _Index
+    __end(_Index __chunk) const
+    {
+        return __begin(__chunk + 1);
+    }
+};
+
+// Below __default_chunk_size elements, spawning a task costs more than it
+// saves. A few chunks per thread balance the load when the elements do not
+// all cost the same, and leave something to steal.
+template <typename _Index>
+__chunk_partitions<_Index>
+__partition(_Index __size)
+{
+    const std::size_t __chunks_per_thread = 4;
+    std::size_t __count = std::min(std::size_t(__size) / __default_chunk_size,
+                                   __std_thread_backend::__concurrency() * __chunks_per_thread);
+    return {__size, _Index(std::max<std::size_t>(__count, 1))};
+}
+
+// Calls __f(__chunk) for every chunk in [__first, __last), splitting the
+// chunks in halves that are run in parallel.
+template <typename _Index, typename _Fp>
+void
+__for_each_chunk(_Index __first, _Index __last, _Fp& __f)
+{
+    if (__last - __first == 1)
+    {
+        __f(__first);
+        return;
+    }
+    _Index __middle = __first + (__last - __first) / 2;
+    __std_thread_backend::__parallel_invoke_body(
+        [&] { __std_thread_backend::__for_each_chunk(__first, __middle, __f); },
+        [&] { __std_thread_backend::__for_each_chunk(__middle, __last, __f); });
+}
+
+//------------------------------------------------------------------------
+// parallel_for
+//------------------------------------------------------------------------
+
+template <class _ExecutionPolicy, class _Index, class _Fp>
+void
+__parallel_for(__pstl::__internal::__std_thread_backend_tag, _ExecutionPolicy&&, _Index __first, _Index __last,
+               _Fp __f)
+{
+    auto __partitions = __std_thread_backend::__partition(__last - __first);
+    if (__partitions.__count_ == 1)
+    {
+        __f(__first, __last);
+        return;
+    }
+
+    auto __chunk = [&](auto __i) { __f(__first + __partitions.__begin(__i), __first + __partitions.__end(__i)); };
+    __std_thread_backend::__for_each_chunk(decltype(__partitions.__count_)(0), __partitions.__count_, __chunk);
+}
+
+//------------------------------------------------------------------------
+// parallel_reduce
+//------------------------------------------------------------------------
+
+template <class _ExecutionPolicy, class _Value, class _Index, typename _RealBody, typename _Reduction>
+_Value
+__parallel_reduce(__pstl::__internal::__std_thread_backend_tag, _ExecutionPolicy&&, _Index __first, _Index __last,
+                  const _Value& __identity, const _RealBody& __real_body, const _Reduction& __reduction)
+{
+    if (__first == __last)
+        return __identity;
+    auto __partitions = __std_thread_backend::__partition(__last - __first);
+    if (__partitions.__count_ == 1)
+        return __real_body(__first, __last, __identity);
+
+    std::vector<std::optional<_Value>> __results(__partitions.__count_);
+    auto __chunk = [&](auto __i) {
+        __results[__i].emplace(
+            __real_body(__first + __partitions.__begin(__i), __first + __partitions.__end(__i), __identity));
+    };
+    __std_thread_backend::__for_each_chunk(decltype(__partitions.__count_)(0), __partitions.__count_, __chunk);
+
+    _Value __result = std::move(*__results[0]);
+    for (std::size_t __i = 1; __i != __results.size(); ++__i)
+        __result = __reduction(std::move(__result), std::move(*__results[__i]));
+    return __result;
+}
+
+//------------------------------------------------------------------------
+// parallel_transform_reduce
+//
+// Notation:
+//      r(i,j,init) returns reduction of init with reduction over [i,j)
+//      u(i) returns f(i,i+1,identity) for a hypothetical left identity element
+//      of r c(x,y) combines values x and y that were the result of r or u
+//------------------------------------------------------------------------
+
+template <class _ExecutionPolicy, class _Index, class _UnaryOp, class _Tp, class _BinaryOp, class _Reduce>
+_Tp
+__parallel_transform_reduce(__pstl::__internal::__std_thread_backend_tag, _ExecutionPolicy&&, _Index __first,
+                            _Index __last, _UnaryOp __unary_op, _Tp __init, _BinaryOp __combiner, _Reduce __reduce)
+{
+    auto __partitions = __std_thread_backend::__partition(__last - __first);
+    if (__partitions.__count_ == 1)
+        return __reduce(__first, __last, __init);
+
+    // Only the first chunk starts from __init; the others start from their
+    // first element, as there is no identity element to start from.
+    std::vector<std::optional<_Tp>> __results(__partitions.__count_);
+    auto __chunk = [&](auto __i) {
+        _Index __chunk_first = __first + __partitions.__begin(__i);
+        _Index __chunk_last = __first + __partitions.__end(__i);
+        if (__i == 0)
+            __results[__i].emplace(__reduce(__chunk_first, __chunk_last, __init));
+        else
+            __results[__i].emplace(__reduce(__chunk_first + 1, __chunk_last, __unary_op(__chunk_first)));
+    };
+    __std_thread_backend::__for_each_chunk(decltype(__partitions.__count_)(0), __partitions.__count_, __chunk);
+
+    _Tp __result = std::move(*__results[0]);
+    for (std::size_t __i = 1; __i != __results.size(); ++__i)
+        __result = __combiner(std::move(__result), std::move(*__results[__i]));
+    return __result;
+}
+
+//------------------------------------------------------------------------
+// parallel_strict_scan
+//
+// The sums of the chunks are computed in parallel, turned into the carries
+// of the chunks that follow them on the calling thread, and the chunks are
+// then scanned in parallel.
+//------------------------------------------------------------------------
+
+template <class _ExecutionPolicy, typename _Index, typename _Tp, typename _Rp, typename _Cp, typename _Sp, typename _Ap>
+void
+__parallel_strict_scan(__pstl::__internal::__std_thread_backend_tag, _ExecutionPolicy&&, _Index __n, _Tp __initial,
+                       _Rp __reduce, _Cp __combine, _Sp __scan, _Ap __apex)
+{
+    auto __partitions = __std_thread_backend::__partition(__n);
+    if (__partitions.__count_ == 1)
+    {
+        _Tp __sum = __initial;
+        if (__n)
+            __sum = __combine(__sum, __reduce(_Index(0), __n));
+        __apex(__sum);
+        if (__n)
+            __scan(_Index(0), __n, __initial);
+        return;
+    }
+
+    using _Chunk = decltype(__partitions.__count_);
+    std::vector<std::optional<_Tp>> __carries(__partitions.__count_ + 1);
+    auto __reduce_chunk = [&](_Chunk __i) {
+        _Index __begin = __partitions.__begin(__i);
+        __carries[__i + 1].emplace(__reduce(__begin, _Index(__partitions.__end(__i) - __begin)));
+    };
+    __std_thread_backend::__for_each_chunk(_Chunk(0), __partitions.__count_, __reduce_chunk);
+
+    __carries[0].emplace(__initial);
+    for (std::size_t __i = 1; __i != __carries.size(); ++__i)
+        *__carries[__i] = __combine(*__carries[__i - 1], *__carries[__i]);
+    __apex(*__carries.back());
+
+    auto __scan_chunk = [&](_Chunk __i) {
+        _Index __begin = __partitions.__begin(__i);
+        __scan(__begin, _Index(__partitions.__end(__i) - __begin), *__carries[__i]);
+    };
+    __std_thread_backend::__for_each_chunk(_Chunk(0), __partitions.__count_, __scan_chunk);
+}
+
+//------------------------------------------------------------------------
+// parallel_transform_scan
+//------------------------------------------------------------------------
+
+template <class _ExecutionPolicy, class _Index, class _UnaryOp, class _Tp, class _BinaryOp, class _Reduce, class _Scan>
+_Tp
+__parallel_transform_scan(__pstl::__internal::__std_thread_backend_tag, _ExecutionPolicy&&, _Index __n,
+                          _UnaryOp __u, _Tp __init, _BinaryOp __combine, _Reduce __brick_reduce, _Scan __scan)
+{
+    auto __partitions = __std_thread_backend::__partition(__n);
+    if (__partitions.__count_ == 1)
+        return __scan(_Index(0), __n, __init);
+
+    // The last chunk does not need to be summed: its carry is the last one.
+    using _Chunk = decltype(__partitions.__count_);
+    std::vector<std::optional<_Tp>> __carries(__partitions.__count_);
+    auto __reduce_chunk = [&](_Chunk __i) {
+        _Index __begin = __partitions.__begin(__i);
+        __carries[__i + 1].emplace(__brick_reduce(__begin + 1, __partitions.__end(__i), __u(__begin)));
+    };
+    __std_thread_backend::__for_each_chunk(_Chunk(0), _Chunk(__partitions.__count_ - 1), __reduce_chunk);
+
+    __carries[0].emplace(__init);
+    for (std::size_t __i = 1; __i != __carries.size(); ++__i)
+        *__carries[__i] = __combine(*__carries[__i - 1], *__carries[__i]);
+
+    std::optional<_Tp> __result;
+    auto __scan_chunk = [&](_Chunk __i) {
+        _Tp __sum = __scan(__partitions.__begin(__i), __partitions.__end(__i), *__carries[__i]);
+        if (__i == __partitions.__count_ - 1)
+            __result.emplace(std::move(__sum));
+    };
+    __std_thread_backend::__for_each_chunk(_Chunk(0), __partitions.__count_, __scan_chunk);
+    return std::move(*__result);
+}
+
+//------------------------------------------------------------------------
+// parallel_merge
+//------------------------------------------------------------------------
+
+template <typename _RandomAccessIterator1, typename _RandomAccessIterator2, typename _RandomAccessIterator3,
+          typename _Compare, typename _LeafMerge>
+void
+__parallel_merge_body(std::size_t __size_x, std::size_t __size_y, _RandomAccessIterator1 __xs,
+                      _RandomAccessIterator1 __xe, _RandomAccessIterator2 __ys, _RandomAccessIterator2 __ye,
+                      _RandomAccessIterator3 __zs, _Compare __comp, _LeafMerge __leaf_merge)
+{
+    if (__size_x + __size_y <= __default_chunk_size)
+    {
+        __leaf_merge(__xs, __xe, __ys, __ye, __zs, __comp);
+        return;
+    }
+
+    _RandomAccessIterator1 __xm;
+    _RandomAccessIterator2 __ym;
+
+    if (__size_x < __size_y)
+    {
+        __ym = __ys + (__size_y / 2);
+        __xm = std::upper_bound(__xs, __xe, *__ym, __comp);
+    }
+    else
+    {
+        __xm = __xs + (__size_x / 2);
+        __ym = std::lower_bound(__ys, __ye, *__xm, __comp);
+    }
+
+    auto __zm = __zs + (__xm - __xs) + (__ym - __ys);
+
+    __std_thread_backend::__parallel_invoke_body(
+        [&] {
+            __std_thread_backend::__parallel_merge_body(__xm - __xs, __ym - __ys, __xs, __xm, __ys, __ym, __zs, __comp,
+                                                        __leaf_merge);
+        },
+        [&] {
+            __std_thread_backend::__parallel_merge_body(__xe - __xm, __ye - __ym, __xm, __xe, __ym, __ye, __zm, __comp,
+                                                        __leaf_merge);
+        });
+}
+
+template <class _ExecutionPolicy, typename _RandomAccessIterator1, typename _RandomAccessIterator2,
+          typename _RandomAccessIterator3, typename _Compare, typename _LeafMerge>
+void
+__parallel_merge(__pstl::__internal::__std_thread_backend_tag, _ExecutionPolicy&&, _RandomAccessIterator1 __xs,
+                 _RandomAccessIterator1 __xe, _RandomAccessIterator2 __ys, _RandomAccessIterator2 __ye,
+                 _RandomAccessIterator3 __zs, _Compare __comp, _LeafMerge __leaf_merge)
+{
+    __std_thread_backend::__parallel_merge_body(__xe - __xs, __ye - __ys, __xs, __xe, __ys, __ye, __zs, __comp,
+                                                __leaf_merge);
+}
+
+//------------------------------------------------------------------------
+// parallel_stable_sort
+//------------------------------------------------------------------------
+
+namespace __sort_details
+{
+struct __move_value
+{
+    template <typename _Iterator, typename _OutputIterator>
+    void
+    operator()(_Iterator __x, _OutputIterator __z) const
+    {
+        *__z = std::move(*__x);
+    }
+};
+
+template <typename _RandomAccessIterator, typename _OutputIterator>
+_OutputIterator
+__parallel_move_range(_RandomAccessIterator __first, _RandomAccessIterator __last, _OutputIterator __d_first)
+{
+    auto __partitions = __std_thread_backend::__partition(__last - __first);
+    if (__partitions.__count_ == 1)
+        return std::move(__first, __last, __d_first);
+
+    auto __chunk = [&](auto __i) {
+        std::move(__first + __partitions.__begin(__i), __first + __partitions.__end(__i),
+                  __d_first + __partitions.__begin(__i));
+    };
+    __std_thread_backend::__for_each_chunk(decltype(__partitions.__count_)(0), __partitions.__count_, __chunk);
+    return __d_first + (__last - __first);
+}
+
+struct __move_range
+{
+    template <typename _RandomAccessIterator, typename _OutputIterator>
+    _OutputIterator
+    operator()(_RandomAccessIterator __first, _RandomAccessIterator __last, _OutputIterator __d_first) const
+    {
+        return __sort_details::__parallel_move_range(__first, __last, __d_first);
+    }
+};
+} // namespace __sort_details
+
+template <typename _RandomAccessIterator, typename _Compare, typename _LeafSort>
+void
+__parallel_stable_sort_body(_RandomAccessIterator __xs, _RandomAccessIterator __xe, _Compare __comp,
+                            _LeafSort __leaf_sort)
+{
+    using _ValueType = typename std::iterator_traits<_RandomAccessIterator>::value_type;
+    using _VecType = typename std::vector<_ValueType>;
+    using _OutputIterator = typename _VecType::iterator;
+    using _MoveValue = __sort_details::__move_value;
+    using _MoveRange = __sort_details::__move_range;
+
+    std::size_t __size = __xe - __xs;
+    if (__size <= __default_chunk_size)
+    {
+        __leaf_sort(__xs, __xe, __comp);
+        return;
+    }
+
+    auto __mid = __xs + (__size / 2);
+    __std_thread_backend::__parallel_invoke_body(
+        [&] { __std_thread_backend::__parallel_stable_sort_body(__xs, __mid, __comp, __leaf_sort); },
+        [&] { __std_thread_backend::__parallel_stable_sort_body(__mid, __xe, __comp, __leaf_sort); });
+
+    // Merge the sorted halves into __output_data, and move them back.
+    _VecType __output_data(__size);
+    _MoveValue __move_value;
+    _MoveRange __move_range;
+    __utils::__serial_move_merge __merge(__size);
+    __std_thread_backend::__parallel_merge_body(
+        __mid - __xs, __xe - __mid, __xs, __mid, __mid, __xe, __output_data.begin(), __comp,
+        [&__merge, &__move_value, &__move_range](_RandomAccessIterator __as, _RandomAccessIterator __ae,
+                                                 _RandomAccessIterator __bs, _RandomAccessIterator __be,
+                                                 _OutputIterator __cs, _Compare __comp)
+        { __merge(__as, __ae, __bs, __be, __cs, __comp, __move_value, __move_value, __move_range, __move_range); });
+    __sort_details::__parallel_move_range(__output_data.begin(), __output_data.end(), __xs);
+}
+
+template <class _ExecutionPolicy, typename _RandomAccessIterator, typename _Compare, typename _LeafSort>
+void
+__parallel_stable_sort(__pstl::__internal::__std_thread_backend_tag, _ExecutionPolicy&&, _RandomAccessIterator __xs,
+                       _RandomAccessIterator __xe, _Compare __comp, _LeafSort __leaf_sort, std::size_t __nsort = 0)
+{
+    // Partial sorts are done serially, as in the OpenMP backend.
+    auto __count = static_cast<std::size_t>(__xe - __xs);
+    if (__count <= __default_chunk_size || __nsort < __count)
+    {
+        __leaf_sort(__xs, __xe, __comp);
+        return;
+    }
+    __std_thread_backend::__parallel_stable_sort_body(__xs, __xe, __comp, __leaf_sort);
+}
+
+} // namespace __std_thread_backend
+} // namespace __pstl
+
+_PSTL_HIDE_FROM_ABI_POP
+
+#endif /* _PSTL_PARALLEL_BACKEND_STD_THREAD_H */